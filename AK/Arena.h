@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Assertions.h>
+#include <AK/Noncopyable.h>
+#include <AK/Span.h>
+#include <AK/StdLibExtras.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+// An allocator for objects that all die together, like everything a parser creates for a single parse. Allocating is
+// mostly a pointer bump, and everything is freed at once when the arena is cleared or destroyed. Objects that need
+// their destructor to run are destroyed at that point too, in reverse order of creation.
+class Arena {
+    AK_MAKE_NONCOPYABLE(Arena);
+    AK_MAKE_NONMOVABLE(Arena);
+
+public:
+    Arena() = default;
+    ~Arena()
+    {
+        run_destructors();
+        if (auto* largest_chunk = free_chunks_except_largest())
+            kfree_sized(largest_chunk, largest_chunk->size);
+    }
+
+    [[nodiscard]] void* allocate(size_t size, size_t alignment)
+    {
+        VERIFY(is_power_of_two(alignment));
+        auto position = align_up_to(m_position, alignment);
+        if (!m_current_chunk || position + size > m_end) {
+            allocate_chunk(size + alignment);
+            position = align_up_to(m_position, alignment);
+        }
+        m_position = position + size;
+        return reinterpret_cast<void*>(position);
+    }
+
+    template<typename T, typename... Args>
+    T& make(Args&&... args)
+    {
+        auto* object = new (allocate(sizeof(T), alignof(T))) T(forward<Args>(args)...);
+        if constexpr (!IsTriviallyDestructible<T>)
+            register_destructor(object, 1, [](void* objects, size_t) { static_cast<T*>(objects)->~T(); });
+        return *object;
+    }
+
+    // Returns `count` value-initialized objects.
+    template<typename T>
+    Span<T> make_span(size_t count)
+    {
+        if (count == 0)
+            return {};
+        auto* objects = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        for (size_t i = 0; i < count; ++i)
+            new (&objects[i]) T();
+        if constexpr (!IsTriviallyDestructible<T>) {
+            register_destructor(objects, count, [](void* objects, size_t count) {
+                for (size_t i = count; i > 0; --i)
+                    static_cast<T*>(objects)[i - 1].~T();
+            });
+        }
+        return { objects, count };
+    }
+
+    // Copies the string into the arena, so it lives as long as everything else in it.
+    StringView copy_string(StringView string)
+    {
+        if (string.is_empty())
+            return {};
+        auto* characters = static_cast<char*>(allocate(string.length(), 1));
+        __builtin_memcpy(characters, string.characters_without_null_termination(), string.length());
+        return { characters, string.length() };
+    }
+
+    // Destroys everything that was made in the arena, and frees all of its memory but the largest chunk, which is
+    // reused for whatever is allocated next.
+    void clear()
+    {
+        run_destructors();
+        auto* largest_chunk = free_chunks_except_largest();
+        m_bytes_allocated = 0;
+        if (largest_chunk)
+            use_chunk(largest_chunk, nullptr);
+    }
+
+    // The number of bytes handed out since the arena was last cleared, including alignment padding.
+    size_t bytes_allocated() const { return m_bytes_allocated + (m_current_chunk ? m_position - chunk_start(m_current_chunk) : 0); }
+
+private:
+    struct Chunk {
+        Chunk* previous { nullptr };
+        size_t size { 0 };
+    };
+
+    struct Destructor {
+        void* objects { nullptr };
+        size_t count { 0 };
+        void (*destroy)(void*, size_t) { nullptr };
+        Destructor* previous { nullptr };
+    };
+
+    static constexpr size_t initial_chunk_size = 4 * KiB;
+    static constexpr size_t maximum_chunk_size = 1 * MiB;
+
+    static FlatPtr chunk_start(Chunk* chunk) { return reinterpret_cast<FlatPtr>(chunk) + sizeof(Chunk); }
+
+    void run_destructors()
+    {
+        for (auto* destructor = m_last_destructor; destructor; destructor = destructor->previous)
+            destructor->destroy(destructor->objects, destructor->count);
+        m_last_destructor = nullptr;
+    }
+
+    Chunk* free_chunks_except_largest()
+    {
+        Chunk* largest_chunk = nullptr;
+        for (auto* chunk = m_current_chunk; chunk;) {
+            auto* previous = chunk->previous;
+            if (!largest_chunk || chunk->size > largest_chunk->size)
+                swap(chunk, largest_chunk);
+            if (chunk)
+                kfree_sized(chunk, chunk->size);
+            chunk = previous;
+        }
+        m_current_chunk = nullptr;
+        m_position = 0;
+        m_end = 0;
+        return largest_chunk;
+    }
+
+    void register_destructor(void* objects, size_t count, void (*destroy)(void*, size_t))
+    {
+        // The records live in the arena as well, so registering a destructor doesn't cost a separate allocation.
+        auto* destructor = new (allocate(sizeof(Destructor), alignof(Destructor))) Destructor { objects, count, destroy, m_last_destructor };
+        m_last_destructor = destructor;
+    }
+
+    void allocate_chunk(size_t minimum_size)
+    {
+        // Chunks grow along with the arena, so large arenas don't end up with lots of small chunks.
+        auto size = m_current_chunk ? min(m_current_chunk->size * 2, maximum_chunk_size) : initial_chunk_size;
+        size = kmalloc_good_size(max(size, minimum_size + sizeof(Chunk)));
+        auto* memory = kmalloc(size);
+        VERIFY(memory);
+
+        if (m_current_chunk)
+            m_bytes_allocated += m_position - chunk_start(m_current_chunk);
+        use_chunk(new (memory) Chunk { nullptr, size }, m_current_chunk);
+    }
+
+    void use_chunk(Chunk* chunk, Chunk* previous)
+    {
+        chunk->previous = previous;
+        m_current_chunk = chunk;
+        m_position = chunk_start(chunk);
+        m_end = reinterpret_cast<FlatPtr>(chunk) + chunk->size;
+    }
+
+    Chunk* m_current_chunk { nullptr };
+    FlatPtr m_position { 0 };
+    FlatPtr m_end { 0 };
+    size_t m_bytes_allocated { 0 };
+    Destructor* m_last_destructor { nullptr };
+};
+
+// A growable array that lives in an arena. Growing leaves the old storage behind in the arena, which is only reclaimed
+// along with everything else in it. The elements are destroyed with the vector itself.
+template<typename T>
+class ArenaVector {
+    AK_MAKE_NONCOPYABLE(ArenaVector);
+
+public:
+    explicit ArenaVector(Arena& arena)
+        : m_arena(arena)
+    {
+    }
+
+    ArenaVector(ArenaVector&& other)
+        : m_arena(other.m_arena)
+        , m_elements(exchange(other.m_elements, nullptr))
+        , m_size(exchange(other.m_size, 0))
+        , m_capacity(exchange(other.m_capacity, 0))
+    {
+    }
+
+    ~ArenaVector()
+    {
+        clear();
+    }
+
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] bool is_empty() const { return m_size == 0; }
+
+    T& operator[](size_t index)
+    {
+        VERIFY(index < m_size);
+        return m_elements[index];
+    }
+    T const& operator[](size_t index) const
+    {
+        VERIFY(index < m_size);
+        return m_elements[index];
+    }
+
+    T& last() { return (*this)[m_size - 1]; }
+    T const& last() const { return (*this)[m_size - 1]; }
+
+    Span<T> span() { return { m_elements, m_size }; }
+    ReadonlySpan<T> span() const { return { m_elements, m_size }; }
+
+    T* begin() { return m_elements; }
+    T* end() { return m_elements + m_size; }
+    T const* begin() const { return m_elements; }
+    T const* end() const { return m_elements + m_size; }
+
+    template<typename... Args>
+    T& append(Args&&... args)
+    {
+        if (m_size == m_capacity)
+            grow(max<size_t>(m_capacity * 2, 4));
+        return *new (&m_elements[m_size++]) T(forward<Args>(args)...);
+    }
+
+    void ensure_capacity(size_t capacity)
+    {
+        if (capacity > m_capacity)
+            grow(capacity);
+    }
+
+    void clear()
+    {
+        if constexpr (!IsTriviallyDestructible<T>) {
+            for (size_t i = m_size; i > 0; --i)
+                m_elements[i - 1].~T();
+        }
+        m_size = 0;
+    }
+
+private:
+    void grow(size_t capacity)
+    {
+        auto* elements = static_cast<T*>(m_arena.allocate(sizeof(T) * capacity, alignof(T)));
+        for (size_t i = 0; i < m_size; ++i) {
+            new (&elements[i]) T(move(m_elements[i]));
+            m_elements[i].~T();
+        }
+        m_elements = elements;
+        m_capacity = capacity;
+    }
+
+    Arena& m_arena;
+    T* m_elements { nullptr };
+    size_t m_size { 0 };
+    size_t m_capacity { 0 };
+};
+
+// Builds a string in an arena, for strings that should live as long as the arena.
+class ArenaStringBuilder {
+public:
+    explicit ArenaStringBuilder(Arena& arena)
+        : m_characters(arena)
+    {
+    }
+
+    void append(char character) { m_characters.append(character); }
+    void append(StringView string)
+    {
+        m_characters.ensure_capacity(m_characters.size() + string.length());
+        for (auto character : string)
+            m_characters.append(character);
+    }
+
+    [[nodiscard]] size_t length() const { return m_characters.size(); }
+    [[nodiscard]] StringView string_view() const LIFETIME_BOUND { return { m_characters.begin(), m_characters.size() }; }
+
+private:
+    ArenaVector<char> m_characters;
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::Arena;
+using AK::ArenaStringBuilder;
+using AK::ArenaVector;
+#endif
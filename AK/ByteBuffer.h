@@ -10,6 +10,7 @@
 #include <AK/Assertions.h>
 #include <AK/Badge.h>
 #include <AK/Error.h>
+#include <AK/MemoryAccounting.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <AK/kmalloc.h>
@@ -42,8 +43,10 @@ public:
     ByteBuffer& operator=(ByteBuffer&& other)
     {
         if (this != &other) {
-            if (!m_inline)
+            if (!m_inline) {
+                MemoryAccounting::did_free(m_outline_capacity);
                 kfree_sized(m_outline_buffer, m_outline_capacity);
+            }
             move_from(move(other));
         }
         return *this;
@@ -173,6 +176,7 @@ public:
     void clear()
     {
         if (!m_inline) {
+            MemoryAccounting::did_free(m_outline_capacity);
             kfree_sized(m_outline_buffer, m_outline_capacity);
             m_inline = true;
         }
@@ -321,6 +325,9 @@ public:
         if (m_inline)
             return {};
 
+        // The buffer is freed by whoever takes it over, so it isn't accounted for here anymore.
+        MemoryAccounting::did_free(m_outline_capacity);
+
         auto buffer = bytes();
         m_inline = true;
         m_size = 0;
@@ -351,6 +358,7 @@ private:
         auto outline_capacity = m_outline_capacity;
         if (!may_discard_existing_data)
             __builtin_memcpy(m_inline_buffer, outline_buffer, size);
+        MemoryAccounting::did_free(outline_capacity);
         kfree_sized(outline_buffer, outline_capacity);
         m_inline = true;
     }
@@ -367,11 +375,13 @@ private:
         auto* new_buffer = static_cast<u8*>(kmalloc(new_capacity));
         if (!new_buffer)
             return Error::from_errno(ENOMEM);
+        MemoryAccounting::did_allocate(new_capacity);
 
         if (m_inline) {
             __builtin_memcpy(new_buffer, data(), m_size);
         } else if (m_outline_buffer) {
             __builtin_memcpy(new_buffer, m_outline_buffer, min(new_capacity, m_outline_capacity));
+            MemoryAccounting::did_free(m_outline_capacity);
             kfree_sized(m_outline_buffer, m_outline_capacity);
         }
 
@@ -279,7 +279,7 @@ public:
     template<typename... Parameters>
     [[nodiscard]] static ByteString formatted(CheckedFormatString<Parameters...>&& fmtstr, Parameters const&... parameters)
     {
-        VariadicFormatParams<AllowDebugOnlyFormatters::No, Parameters...> variadic_format_parameters { parameters... };
+        VariadicFormatParams<AllowDebugOnlyFormatters::No, Parameters...> variadic_format_parameters { fmtstr, parameters... };
         return vformatted(fmtstr.view(), variadic_format_parameters);
     }
 
@@ -34,6 +34,7 @@ NonnullRefPtr<ByteStringImpl const> ByteStringImpl::create_uninitialized(size_t
     VERIFY(length);
     void* slot = kmalloc(allocation_size_for_stringimpl(length));
     VERIFY(slot);
+    MemoryAccounting::did_allocate(allocation_size_for_stringimpl(length));
     auto new_stringimpl = adopt_ref(*new (slot) ByteStringImpl(ConstructWithInlineBuffer, length));
     buffer = const_cast<char*>(new_stringimpl->characters());
     buffer[length] = '\0';
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Badge.h>
+#include <AK/MemoryAccounting.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/Span.h>
@@ -31,7 +32,9 @@ public:
 
     void operator delete(void* ptr)
     {
-        kfree_sized(ptr, allocation_size_for_stringimpl(static_cast<ByteStringImpl*>(ptr)->m_length));
+        auto size = allocation_size_for_stringimpl(static_cast<ByteStringImpl*>(ptr)->m_length);
+        MemoryAccounting::did_free(size);
+        kfree_sized(ptr, size);
     }
 
     static ByteStringImpl& the_empty_stringimpl();
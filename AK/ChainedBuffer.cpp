@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ChainedBuffer.h>
+
+namespace AK {
+
+ErrorOr<void> ChainedBuffer::try_append(ReadonlyBytes bytes)
+{
+    if (!m_chunks.is_empty()) {
+        auto appended = m_chunks.last_chunk().append_in_place(bytes);
+        m_size += appended;
+        bytes = bytes.slice(appended);
+    }
+    if (bytes.is_empty())
+        return {};
+
+    // Large appends get a chunk of their own, so they don't have to be split up.
+    auto storage = TRY(Detail::ChainedBufferStorage::create(max(chunk_size, bytes.size())));
+    storage->append(bytes);
+    m_chunks.append({ move(storage), 0, bytes.size() });
+    m_size += bytes.size();
+    return {};
+}
+
+void ChainedBuffer::append(ChainedBuffer const& other)
+{
+    // Reserve first, as the other buffer may be this one.
+    auto other_chunks = other.m_chunks.individual_chunks();
+    m_chunks.ensure_capacity(chunk_count() + other_chunks.size());
+    for (size_t i = 0; i < other_chunks.size(); ++i)
+        m_chunks.append(Detail::ChainedBufferChunk { other_chunks[i] });
+    m_size += other.m_size;
+}
+
+ChainedBuffer ChainedBuffer::slice(size_t start, size_t length) const
+{
+    VERIFY(start + length <= m_size);
+
+    ChainedBuffer result;
+    for (auto const& chunk : m_chunks.individual_chunks()) {
+        if (length == 0)
+            break;
+        if (start >= chunk.size()) {
+            start -= chunk.size();
+            continue;
+        }
+
+        auto sliced_length = min(length, chunk.size() - start);
+        result.m_chunks.append(chunk.slice(start, sliced_length));
+        result.m_size += sliced_length;
+        start = 0;
+        length -= sliced_length;
+    }
+    return result;
+}
+
+void ChainedBuffer::discard(size_t count)
+{
+    VERIFY(count <= m_size);
+    m_size -= count;
+
+    auto chunks = m_chunks.individual_chunks();
+    size_t discarded_chunks = 0;
+    while (count > 0 && count >= chunks[discarded_chunks].size())
+        count -= chunks[discarded_chunks++].size();
+    if (count > 0)
+        chunks[discarded_chunks] = chunks[discarded_chunks].slice(count, chunks[discarded_chunks].size() - count);
+    m_chunks.remove_chunks(0, discarded_chunks);
+}
+
+void ChainedBuffer::clear()
+{
+    m_chunks.clear();
+    m_size = 0;
+}
+
+size_t ChainedBuffer::copy_to(Bytes bytes) const
+{
+    size_t copied = 0;
+    for (auto const& chunk : m_chunks.individual_chunks()) {
+        if (copied == bytes.size())
+            break;
+        copied += chunk.bytes().copy_trimmed_to(bytes.slice(copied));
+    }
+    return copied;
+}
+
+ErrorOr<ByteBuffer> ChainedBuffer::coalesce() const
+{
+    auto buffer = TRY(ByteBuffer::create_uninitialized(m_size));
+    copy_to(buffer);
+    return buffer;
+}
+
+ErrorOr<void> ChainedBuffer::write_to(Stream& stream) const
+{
+    for (auto const& chunk : m_chunks.individual_chunks())
+        TRY(stream.write_until_depleted(chunk.bytes()));
+    return {};
+}
+
+ErrorOr<Bytes> ChainedBufferStream::read_some(Bytes bytes)
+{
+    if (!m_is_open)
+        return Error::from_errno(EBADF);
+
+    auto count = m_buffer.copy_to(bytes);
+    m_buffer.discard(count);
+    return bytes.trim(count);
+}
+
+ErrorOr<size_t> ChainedBufferStream::write_some(ReadonlyBytes bytes)
+{
+    if (!m_is_open)
+        return Error::from_errno(EBADF);
+
+    TRY(m_buffer.try_append(bytes));
+    return bytes.size();
+}
+
+ErrorOr<void> ChainedBufferStream::discard(size_t count)
+{
+    if (count > m_buffer.size())
+        return Error::from_string_literal("Number of discarded bytes is higher than the number of buffered bytes");
+
+    m_buffer.discard(count);
+    return {};
+}
+
+bool ChainedBufferStream::is_eof() const
+{
+    return m_buffer.is_empty();
+}
+
+bool ChainedBufferStream::is_open() const
+{
+    return m_is_open;
+}
+
+void ChainedBufferStream::close()
+{
+    m_is_open = false;
+}
+
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/DisjointChunks.h>
+#include <AK/Error.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/Span.h>
+#include <AK/Stream.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+namespace Detail {
+
+// Memory that the chunks of one or more ChainedBuffers point into. Bytes are only ever added at the end, and the
+// storage never grows beyond its initial capacity, so bytes that some chunk points to never move or change.
+class ChainedBufferStorage : public RefCounted<ChainedBufferStorage> {
+public:
+    static ErrorOr<NonnullRefPtr<ChainedBufferStorage>> create(size_t capacity)
+    {
+        auto storage = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) ChainedBufferStorage));
+        TRY(storage->m_bytes.try_ensure_capacity(capacity));
+        return storage;
+    }
+
+    size_t size() const { return m_bytes.size(); }
+    size_t available_capacity() const { return m_bytes.capacity() - m_bytes.size(); }
+
+    u8* data() { return m_bytes.data(); }
+    u8 const* data() const { return m_bytes.data(); }
+
+    void append(ReadonlyBytes bytes)
+    {
+        VERIFY(bytes.size() <= available_capacity());
+        m_bytes.append(bytes);
+    }
+
+private:
+    ChainedBufferStorage() = default;
+
+    ByteBuffer<0> m_bytes;
+};
+
+// A range of bytes in a ChainedBufferStorage, as used by DisjointChunks.
+class ChainedBufferChunk {
+public:
+    ChainedBufferChunk() = default;
+    ChainedBufferChunk(NonnullRefPtr<ChainedBufferStorage> storage, size_t offset, size_t size)
+        : m_storage(move(storage))
+        , m_offset(offset)
+        , m_size(size)
+    {
+    }
+
+    size_t size() const { return m_size; }
+    bool is_empty() const { return m_size == 0; }
+
+    u8& at(size_t index)
+    {
+        VERIFY(index < m_size);
+        return m_storage->data()[m_offset + index];
+    }
+
+    ReadonlyBytes bytes() const { return { m_storage->data() + m_offset, m_size }; }
+
+    ChainedBufferChunk slice(size_t start, size_t length) const
+    {
+        VERIFY(start + length <= m_size);
+        return { *m_storage, m_offset + start, length };
+    }
+
+    // Appends as many of the bytes as fit into the storage, unless something else has been appended to it after this
+    // chunk. Returns how many bytes were appended.
+    size_t append_in_place(ReadonlyBytes bytes)
+    {
+        if (!m_storage || m_offset + m_size != m_storage->size())
+            return 0;
+        auto count = min(bytes.size(), m_storage->available_capacity());
+        m_storage->append(bytes.trim(count));
+        m_size += count;
+        return count;
+    }
+
+private:
+    RefPtr<ChainedBufferStorage> m_storage;
+    size_t m_offset { 0 };
+    size_t m_size { 0 };
+};
+
+}
+
+// A byte buffer made of a chain of chunks, for data that is produced piece by piece. Unlike ByteBuffer, appending never
+// moves the bytes that are already in it, and copies of the buffer and slices of it share the chunks instead of copying
+// them. Use coalesce() to get the bytes in one contiguous buffer once they are actually needed that way.
+class ChainedBuffer {
+public:
+    static constexpr size_t chunk_size = 16 * KiB;
+
+    ChainedBuffer() = default;
+
+    size_t size() const { return m_size; }
+    bool is_empty() const { return m_size == 0; }
+
+    u8 operator[](size_t index) const { return const_cast<ChainedBuffer&>(*this).m_chunks.at(index); }
+
+    ErrorOr<void> try_append(ReadonlyBytes);
+    void append(ReadonlyBytes bytes) { MUST(try_append(bytes)); }
+
+    // Appends the bytes of the other buffer by sharing its chunks.
+    void append(ChainedBuffer const&);
+
+    // Returns the given range of this buffer, sharing its chunks.
+    ChainedBuffer slice(size_t start, size_t length) const;
+    ChainedBuffer slice(size_t start) const { return slice(start, size() - start); }
+
+    // Removes the given number of bytes from the front of the buffer.
+    void discard(size_t count);
+    void clear();
+
+    // Copies bytes from the front of the buffer into the given span, and returns how many bytes were copied.
+    size_t copy_to(Bytes) const;
+    ErrorOr<ByteBuffer> coalesce() const;
+    ErrorOr<void> write_to(Stream&) const;
+
+    template<typename Callback>
+    void for_each_chunk(Callback callback) const
+    {
+        for (auto const& chunk : m_chunks.individual_chunks())
+            callback(chunk.bytes());
+    }
+
+    size_t chunk_count() const { return m_chunks.individual_chunks().size(); }
+
+private:
+    DisjointChunks<u8, Detail::ChainedBufferChunk> m_chunks;
+    size_t m_size { 0 };
+};
+
+// A stream that writes to the end of a ChainedBuffer, and reads from its front.
+class ChainedBufferStream final : public Stream {
+public:
+    ChainedBufferStream() = default;
+    explicit ChainedBufferStream(ChainedBuffer buffer)
+        : m_buffer(move(buffer))
+    {
+    }
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual ErrorOr<void> discard(size_t) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+
+    ChainedBuffer const& buffer() const { return m_buffer; }
+    ChainedBuffer release_buffer() { return move(m_buffer); }
+
+private:
+    ChainedBuffer m_buffer;
+    bool m_is_open { true };
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::ChainedBuffer;
+using AK::ChainedBufferStream;
+#endif
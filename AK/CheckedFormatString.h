@@ -133,6 +133,83 @@ consteval auto count_fmt_params(char const (&fmt)[N])
 
 namespace AK::Format::Detail {
 
+// A literal piece of a format string and the replacement field following it, as split up at compile time. Positions
+// are offsets into the format string.
+struct FormatSegment {
+    static constexpr u16 use_next_index = 0xffff;
+
+    u16 literal_start { 0 };
+    u16 literal_length { 0 };
+    u16 flags_start { 0 };
+    u16 flags_length { 0 };
+    u16 index { use_next_index };
+    bool literal_has_escapes { false };
+    // Only the last segment has no replacement field.
+    bool has_parameter { false };
+};
+
+// Splits a format string the same way FormatParser does at runtime. Returns 0 if the format string is malformed or
+// doesn't fit into the given segments, in which case it is left to be parsed at runtime.
+template<size_t N, size_t Capacity>
+consteval size_t split_into_segments(char const (&fmt)[N], FormatSegment (&segments)[Capacity])
+{
+    constexpr size_t length = N - 1;
+    if constexpr (length >= 0xffff)
+        return 0;
+
+    size_t count = 0;
+    size_t i = 0;
+    while (true) {
+        if (count == Capacity)
+            return 0;
+        auto& segment = segments[count++];
+
+        segment.literal_start = i;
+        while (i < length && fmt[i] != '{' && fmt[i] != '}')
+            ++i;
+        while (i + 1 < length && (fmt[i] == '{' || fmt[i] == '}') && fmt[i + 1] == fmt[i]) {
+            segment.literal_has_escapes = true;
+            for (i += 2; i < length && fmt[i] != '{' && fmt[i] != '}'; ++i)
+                ;
+        }
+        segment.literal_length = i - segment.literal_start;
+
+        if (i == length)
+            return count;
+        if (fmt[i] == '}')
+            return 0;
+        ++i;
+
+        if (i < length && fmt[i] >= '0' && fmt[i] <= '9') {
+            size_t index = 0;
+            for (; i < length && fmt[i] >= '0' && fmt[i] <= '9'; ++i) {
+                index = index * 10 + (fmt[i] - '0');
+                if (index >= FormatSegment::use_next_index)
+                    return 0;
+            }
+            segment.index = index;
+        }
+
+        if (i < length && fmt[i] == ':') {
+            segment.flags_start = ++i;
+            for (size_t level = 1; level > 0; ++i) {
+                if (i == length)
+                    return 0;
+                if (fmt[i] == '{')
+                    ++level;
+                else if (fmt[i] == '}')
+                    --level;
+            }
+            segment.flags_length = i - segment.flags_start - 1;
+        } else {
+            if (i == length || fmt[i] != '}')
+                return 0;
+            segment.flags_start = ++i;
+        }
+        segment.has_parameter = true;
+    }
+}
+
 template<typename... Args>
 struct CheckedFormatString {
     template<size_t N>
@@ -142,6 +219,7 @@ struct CheckedFormatString {
 #ifdef ENABLE_COMPILETIME_FORMAT_CHECK
         check_format_parameter_consistency<N, sizeof...(Args)>(fmt);
 #endif
+        m_segment_count = split_into_segments<N>(fmt, m_segments);
     }
 
     template<typename T>
@@ -153,6 +231,9 @@ struct CheckedFormatString {
 
     auto view() const { return m_string; }
 
+    // Empty if the format string was only known at runtime.
+    ReadonlySpan<FormatSegment> segments() const { return { m_segments, m_segment_count }; }
+
 private:
 #ifdef ENABLE_COMPILETIME_FORMAT_CHECK
     template<size_t N, size_t param_count>
@@ -207,6 +288,10 @@ private:
 #endif
 
     StringView m_string;
+    // One segment per argument plus the trailing literal covers every format string that doesn't reference arguments
+    // more than once.
+    FormatSegment m_segments[sizeof...(Args) + 1] {};
+    size_t m_segment_count { 0 };
 };
 
 }
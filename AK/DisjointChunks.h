@@ -262,6 +262,11 @@ public:
     void extend(DisjointChunks&& chunks) { m_chunks.extend(move(chunks.m_chunks)); }
     void extend(DisjointChunks const& chunks) { m_chunks.extend(chunks.m_chunks); }
 
+    Span<ChunkType> individual_chunks() { return m_chunks.span(); }
+    ReadonlySpan<ChunkType> individual_chunks() const { return m_chunks.span(); }
+
+    void remove_chunks(size_t index, size_t count) { m_chunks.remove(index, count); }
+
     ChunkType& first_chunk() { return m_chunks.first(); }
     ChunkType& last_chunk() { return m_chunks.last(); }
     ChunkType const& first_chunk() const { return m_chunks.first(); }
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlatHashTable.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <initializer_list>
+
+namespace AK {
+
+// A map datastructure, mapping keys K to values V, based on FlatHashTable. It has the same interface as HashMap, minus
+// ordered iteration, and is faster to look keys up in once the map grows beyond a few dozen entries.
+template<typename K, typename V, typename KeyTraits, typename ValueTraits>
+class FlatHashMap {
+private:
+    struct Entry {
+        K key;
+        V value;
+    };
+
+    struct EntryTraits {
+        static unsigned hash(Entry const& entry) { return KeyTraits::hash(entry.key); }
+        static bool equals(Entry const& a, Entry const& b) { return KeyTraits::equals(a.key, b.key); }
+    };
+
+public:
+    using KeyType = K;
+    using ValueType = V;
+
+    FlatHashMap() = default;
+
+    FlatHashMap(std::initializer_list<Entry> list)
+    {
+        MUST(try_ensure_capacity(list.size()));
+        for (auto& [key, value] : list)
+            set(key, value);
+    }
+
+    [[nodiscard]] bool is_empty() const { return m_table.is_empty(); }
+    [[nodiscard]] size_t size() const { return m_table.size(); }
+    [[nodiscard]] size_t capacity() const { return m_table.capacity(); }
+    void clear() { m_table.clear(); }
+    void clear_with_capacity() { m_table.clear_with_capacity(); }
+
+    HashSetResult set(K const& key, V const& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace) { return m_table.set(Entry { key, value }, existing_entry_behavior); }
+    HashSetResult set(K const& key, V&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace) { return m_table.set(Entry { key, move(value) }, existing_entry_behavior); }
+    HashSetResult set(K&& key, V&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace) { return m_table.set(Entry { move(key), move(value) }, existing_entry_behavior); }
+    ErrorOr<HashSetResult> try_set(K const& key, V const& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace) { return m_table.try_set(Entry { key, value }, existing_entry_behavior); }
+    ErrorOr<HashSetResult> try_set(K const& key, V&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace) { return m_table.try_set(Entry { key, move(value) }, existing_entry_behavior); }
+    ErrorOr<HashSetResult> try_set(K&& key, V&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace) { return m_table.try_set(Entry { move(key), move(value) }, existing_entry_behavior); }
+
+    bool remove(K const& key)
+    {
+        auto it = find(key);
+        if (it == end())
+            return false;
+        m_table.remove(it);
+        return true;
+    }
+
+    template<Concepts::HashCompatible<K> Key>
+    requires(IsSame<KeyTraits, Traits<K>>) bool remove(Key const& key)
+    {
+        auto it = find(key);
+        if (it == end())
+            return false;
+        m_table.remove(it);
+        return true;
+    }
+
+    template<typename TUnaryPredicate>
+    bool remove_all_matching(TUnaryPredicate const& predicate)
+    {
+        return m_table.remove_all_matching([&](auto& entry) {
+            return predicate(entry.key, entry.value);
+        });
+    }
+
+    using HashTableType = FlatHashTable<Entry, EntryTraits>;
+    using IteratorType = typename HashTableType::Iterator;
+    using ConstIteratorType = typename HashTableType::ConstIterator;
+
+    [[nodiscard]] IteratorType begin() { return m_table.begin(); }
+    [[nodiscard]] IteratorType end() { return m_table.end(); }
+    [[nodiscard]] ConstIteratorType begin() const { return m_table.begin(); }
+    [[nodiscard]] ConstIteratorType end() const { return m_table.end(); }
+
+    [[nodiscard]] IteratorType find(K const& key)
+    {
+        return m_table.find(KeyTraits::hash(key), [&](auto& entry) { return KeyTraits::equals(entry.key, key); });
+    }
+
+    [[nodiscard]] ConstIteratorType find(K const& key) const
+    {
+        return m_table.find(KeyTraits::hash(key), [&](auto& entry) { return KeyTraits::equals(entry.key, key); });
+    }
+
+    template<Concepts::HashCompatible<K> Key>
+    requires(IsSame<KeyTraits, Traits<K>>) [[nodiscard]] IteratorType find(Key const& key)
+    {
+        return m_table.find(Traits<Key>::hash(key), [&](auto& entry) { return Traits<K>::equals(entry.key, key); });
+    }
+
+    template<Concepts::HashCompatible<K> Key>
+    requires(IsSame<KeyTraits, Traits<K>>) [[nodiscard]] ConstIteratorType find(Key const& key) const
+    {
+        return m_table.find(Traits<Key>::hash(key), [&](auto& entry) { return Traits<K>::equals(entry.key, key); });
+    }
+
+    ErrorOr<void> try_ensure_capacity(size_t capacity) { return m_table.try_ensure_capacity(capacity); }
+    void ensure_capacity(size_t capacity) { m_table.ensure_capacity(capacity); }
+
+    Optional<typename ValueTraits::ConstPeekType> get(K const& key) const
+    {
+        auto it = find(key);
+        if (it == end())
+            return {};
+        return it->value;
+    }
+
+    Optional<typename ValueTraits::PeekType> get(K const& key)
+    requires(!IsConst<typename ValueTraits::PeekType>)
+    {
+        auto it = find(key);
+        if (it == end())
+            return {};
+        return it->value;
+    }
+
+    template<Concepts::HashCompatible<K> Key>
+    requires(IsSame<KeyTraits, Traits<K>>) Optional<typename ValueTraits::ConstPeekType> get(Key const& key) const
+    {
+        auto it = find(key);
+        if (it == end())
+            return {};
+        return it->value;
+    }
+
+    template<Concepts::HashCompatible<K> Key>
+    requires(IsSame<KeyTraits, Traits<K>>) Optional<typename ValueTraits::PeekType> get(Key const& key)
+    requires(!IsConst<typename ValueTraits::PeekType>)
+    {
+        auto it = find(key);
+        if (it == end())
+            return {};
+        return it->value;
+    }
+
+    [[nodiscard]] bool contains(K const& key) const
+    {
+        return find(key) != end();
+    }
+
+    template<Concepts::HashCompatible<K> Key>
+    requires(IsSame<KeyTraits, Traits<K>>) [[nodiscard]] bool contains(Key const& key) const
+    {
+        return find(key) != end();
+    }
+
+    void remove(IteratorType it)
+    {
+        m_table.remove(it);
+    }
+
+    Optional<V> take(K const& key)
+    {
+        auto it = find(key);
+        if (it == end())
+            return {};
+        auto value = move(it->value);
+        m_table.remove(it);
+        return value;
+    }
+
+    V& ensure(K const& key)
+    {
+        return ensure(key, [] { return V(); });
+    }
+
+    template<typename Callback>
+    V& ensure(K const& key, Callback initialization_callback)
+    {
+        return m_table.ensure(KeyTraits::hash(key), [&](auto& entry) { return KeyTraits::equals(entry.key, key); }, [&] -> Entry { return { key, initialization_callback() }; }).value;
+    }
+
+    [[nodiscard]] Vector<K> keys() const
+    {
+        Vector<K> list;
+        list.ensure_capacity(size());
+        for (auto const& [key, _] : *this)
+            list.unchecked_append(key);
+        return list;
+    }
+
+private:
+    HashTableType m_table;
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::FlatHashMap;
+#endif
@@ -0,0 +1,488 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/Concepts.h>
+#include <AK/Error.h>
+#include <AK/HashTable.h>
+#include <AK/Optional.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Traits.h>
+#include <AK/Types.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+namespace Detail {
+
+// A group of 16 control bytes, one per slot, which are all probed at once.
+// - Empty slots have the control byte 0b10000000, deleted ones 0b11111110.
+// - Used slots store the top 7 bits of the hash of their value (the "H2 tag"), so comparing values is mostly limited
+//   to values that very likely are equal.
+class FlatHashTableGroup {
+public:
+    static constexpr size_t width = 16;
+    static constexpr i8 empty = -128;
+    static constexpr i8 deleted = -2;
+
+    explicit FlatHashTableGroup(i8 const* control)
+        : m_control(SIMD::load_unaligned<SIMD::i8x16>(control))
+    {
+    }
+
+    // The returned masks have bit N set if the Nth slot of the group matches.
+    u32 match(u8 tag) const { return mask_of(m_control == static_cast<i8>(tag)); }
+    u32 match_empty() const { return mask_of(m_control == empty); }
+    u32 match_empty_or_deleted() const { return mask_of(m_control < static_cast<i8>(-1)); }
+
+private:
+    static u32 mask_of(SIMD::i8x16 mask) { return SIMD::maskbits(mask); }
+
+    SIMD::i8x16 m_control;
+};
+
+}
+
+template<typename HashTableType, typename T>
+class FlatHashTableIterator {
+    friend HashTableType;
+
+public:
+    bool operator==(FlatHashTableIterator const& other) const { return m_control == other.m_control; }
+    bool operator!=(FlatHashTableIterator const& other) const { return m_control != other.m_control; }
+    T& operator*() { return *m_slot; }
+    T* operator->() { return m_slot; }
+    void operator++()
+    {
+        ++m_control;
+        ++m_slot;
+        skip_to_used();
+    }
+
+private:
+    FlatHashTableIterator(i8 const* control, T* slot, i8 const* end)
+        : m_control(control)
+        , m_slot(slot)
+        , m_end(end)
+    {
+        skip_to_used();
+    }
+
+    void skip_to_used()
+    {
+        while (m_control != m_end && *m_control < 0) {
+            ++m_control;
+            ++m_slot;
+        }
+    }
+
+    i8 const* m_control { nullptr };
+    T* m_slot { nullptr };
+    i8 const* m_end { nullptr };
+};
+
+// A set datastructure based on a "Swiss table": an open addressing hash table that probes 16 slots at a time, by
+// comparing their control bytes with SIMD instructions. Compared to HashTable, lookups touch far fewer values, which
+// makes it faster for large tables and for values with slow equality checks. Iteration order is unspecified.
+// Deleted slots are only kept as tombstones if a probe may have passed over them, and tables that fill up with
+// tombstones are rehashed in place instead of growing.
+// For a map datastructure with key-value entries, see FlatHashMap.
+template<typename T, typename TraitsForT>
+class FlatHashTable {
+    using Group = Detail::FlatHashTableGroup;
+
+    static constexpr size_t minimum_capacity = Group::width;
+
+public:
+    using Iterator = FlatHashTableIterator<FlatHashTable, T>;
+    using ConstIterator = FlatHashTableIterator<FlatHashTable const, T const>;
+
+    FlatHashTable() = default;
+
+    explicit FlatHashTable(size_t capacity)
+    {
+        ensure_capacity(capacity);
+    }
+
+    ~FlatHashTable()
+    {
+        destroy_all();
+        free_storage(m_control, m_capacity);
+    }
+
+    FlatHashTable(FlatHashTable const& other)
+    {
+        ensure_capacity(other.size());
+        for (auto const& value : other)
+            set(value);
+    }
+
+    FlatHashTable& operator=(FlatHashTable const& other)
+    {
+        FlatHashTable temporary(other);
+        swap(*this, temporary);
+        return *this;
+    }
+
+    FlatHashTable(FlatHashTable&& other) noexcept
+        : m_control(exchange(other.m_control, nullptr))
+        , m_slots(exchange(other.m_slots, nullptr))
+        , m_capacity(exchange(other.m_capacity, 0))
+        , m_size(exchange(other.m_size, 0))
+        , m_growth_left(exchange(other.m_growth_left, 0))
+    {
+    }
+
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept
+    {
+        FlatHashTable temporary { move(other) };
+        swap(*this, temporary);
+        return *this;
+    }
+
+    friend void swap(FlatHashTable& a, FlatHashTable& b) noexcept
+    {
+        swap(a.m_control, b.m_control);
+        swap(a.m_slots, b.m_slots);
+        swap(a.m_capacity, b.m_capacity);
+        swap(a.m_size, b.m_size);
+        swap(a.m_growth_left, b.m_growth_left);
+    }
+
+    [[nodiscard]] bool is_empty() const { return m_size == 0; }
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] size_t capacity() const { return m_capacity; }
+
+    ErrorOr<void> try_ensure_capacity(size_t capacity)
+    {
+        if (capacity <= m_size + m_growth_left)
+            return {};
+        return try_rehash(capacity_for(capacity));
+    }
+    void ensure_capacity(size_t capacity)
+    {
+        MUST(try_ensure_capacity(capacity));
+    }
+
+    void clear()
+    {
+        destroy_all();
+        free_storage(m_control, m_capacity);
+        m_control = nullptr;
+        m_slots = nullptr;
+        m_capacity = 0;
+        m_size = 0;
+        m_growth_left = 0;
+    }
+
+    void clear_with_capacity()
+    {
+        destroy_all();
+        if (m_capacity != 0)
+            __builtin_memset(m_control, Group::empty, m_capacity + Group::width);
+        m_size = 0;
+        m_growth_left = growth_for(m_capacity);
+    }
+
+    [[nodiscard]] Iterator begin() { return Iterator(m_control, m_slots, m_control + m_capacity); }
+    [[nodiscard]] Iterator end() { return Iterator(m_control + m_capacity, m_slots + m_capacity, m_control + m_capacity); }
+    [[nodiscard]] ConstIterator begin() const { return ConstIterator(m_control, m_slots, m_control + m_capacity); }
+    [[nodiscard]] ConstIterator end() const { return ConstIterator(m_control + m_capacity, m_slots + m_capacity, m_control + m_capacity); }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] Iterator find(unsigned hash, TUnaryPredicate predicate)
+    {
+        auto index = find_index(hash, predicate);
+        if (!index.has_value())
+            return end();
+        return iterator_at(*index);
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] ConstIterator find(unsigned hash, TUnaryPredicate predicate) const
+    {
+        auto index = find_index(hash, predicate);
+        if (!index.has_value())
+            return end();
+        return ConstIterator(m_control + *index, m_slots + *index, m_control + m_capacity);
+    }
+
+    [[nodiscard]] Iterator find(T const& value)
+    {
+        return find(TraitsForT::hash(value), [&](auto& other) { return TraitsForT::equals(value, other); });
+    }
+
+    [[nodiscard]] ConstIterator find(T const& value) const
+    {
+        return find(TraitsForT::hash(value), [&](auto& other) { return TraitsForT::equals(value, other); });
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] Iterator find(K const& value)
+    {
+        return find(Traits<K>::hash(value), [&](auto& other) { return Traits<T>::equals(other, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] ConstIterator find(K const& value) const
+    {
+        return find(Traits<K>::hash(value), [&](auto& other) { return Traits<T>::equals(other, value); });
+    }
+
+    [[nodiscard]] bool contains(T const& value) const
+    {
+        return find(value) != end();
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] bool contains(K const& value) const
+    {
+        return find(value) != end();
+    }
+
+    template<typename U = T>
+    ErrorOr<HashSetResult> try_set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+    {
+        auto hash = TraitsForT::hash(value);
+        if (auto index = find_index(hash, [&](auto& other) { return TraitsForT::equals(value, other); }); index.has_value()) {
+            if (existing_entry_behavior == HashSetExistingEntryBehavior::Keep)
+                return HashSetResult::KeptExistingEntry;
+            m_slots[*index] = forward<U>(value);
+            return HashSetResult::ReplacedExistingEntry;
+        }
+
+        auto index = TRY(prepare_insert(hash));
+        new (&m_slots[index]) T(forward<U>(value));
+        return HashSetResult::InsertedNewEntry;
+    }
+
+    template<typename U = T>
+    HashSetResult set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+    {
+        return MUST(try_set(forward<U>(value), existing_entry_behavior));
+    }
+
+    template<typename TUnaryPredicate, typename InitializationCallback>
+    T& ensure(unsigned hash, TUnaryPredicate predicate, InitializationCallback initialization_callback)
+    {
+        if (auto index = find_index(hash, predicate); index.has_value())
+            return m_slots[*index];
+
+        // The callback may have side effects on this table, so only look for a slot once it has run.
+        auto value = initialization_callback();
+        auto index = MUST(prepare_insert(hash));
+        return *new (&m_slots[index]) T(move(value));
+    }
+
+    bool remove(T const& value)
+    {
+        auto it = find(value);
+        if (it == end())
+            return false;
+        remove(it);
+        return true;
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) bool remove(K const& value)
+    {
+        auto it = find(value);
+        if (it == end())
+            return false;
+        remove(it);
+        return true;
+    }
+
+    void remove(Iterator iterator)
+    {
+        VERIFY(iterator != end());
+        erase_at(static_cast<size_t>(iterator.m_control - m_control));
+    }
+
+    template<typename TUnaryPredicate>
+    bool remove_all_matching(TUnaryPredicate const& predicate)
+    {
+        bool removed_anything = false;
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (m_control[i] >= 0 && predicate(m_slots[i])) {
+                erase_at(i);
+                removed_anything = true;
+            }
+        }
+        return removed_anything;
+    }
+
+    Optional<T> take(T const& value)
+    {
+        auto it = find(value);
+        if (it == end())
+            return {};
+        auto taken = move(*it);
+        remove(it);
+        return taken;
+    }
+
+private:
+    static constexpr u8 tag_of(unsigned hash) { return hash >> 25; }
+
+    // Tables are kept at most 7/8 full, so that probe sequences stay short.
+    static constexpr size_t growth_for(size_t capacity) { return capacity - capacity / 8; }
+
+    static size_t capacity_for(size_t size)
+    {
+        size_t capacity = minimum_capacity;
+        while (growth_for(capacity) < size)
+            capacity *= 2;
+        return capacity;
+    }
+
+    static size_t slots_offset(size_t capacity) { return align_up_to(capacity + Group::width, alignof(T)); }
+    static size_t size_in_bytes(size_t capacity) { return slots_offset(capacity) + capacity * sizeof(T); }
+
+    static void free_storage(i8* control, size_t capacity)
+    {
+        if (control)
+            kfree_sized(control, size_in_bytes(capacity));
+    }
+
+    Iterator iterator_at(size_t index) { return Iterator(m_control + index, m_slots + index, m_control + m_capacity); }
+
+    void set_control(size_t index, i8 control)
+    {
+        m_control[index] = control;
+        // The control bytes of the first group are mirrored after the last slot, so that groups can be loaded from
+        // any slot without wrapping around.
+        if (index < Group::width - 1)
+            m_control[m_capacity + index] = control;
+    }
+
+    template<typename TUnaryPredicate>
+    Optional<size_t> find_index(unsigned hash, TUnaryPredicate const& predicate) const
+    {
+        if (m_capacity == 0)
+            return {};
+
+        auto mask = m_capacity - 1;
+        auto tag = tag_of(hash);
+        auto position = hash & mask;
+        for (size_t probe_distance = Group::width;; probe_distance += Group::width) {
+            Group group { m_control + position };
+            for (auto matches = group.match(tag); matches != 0; matches &= matches - 1) {
+                auto index = (position + count_trailing_zeroes(matches)) & mask;
+                if (predicate(m_slots[index]))
+                    return index;
+            }
+            if (group.match_empty() != 0)
+                return {};
+            position = (position + probe_distance) & mask;
+        }
+    }
+
+    size_t find_first_non_used(unsigned hash) const
+    {
+        auto mask = m_capacity - 1;
+        auto position = hash & mask;
+        for (size_t probe_distance = Group::width;; probe_distance += Group::width) {
+            if (auto matches = Group { m_control + position }.match_empty_or_deleted(); matches != 0)
+                return (position + count_trailing_zeroes(matches)) & mask;
+            position = (position + probe_distance) & mask;
+        }
+    }
+
+    // Returns the index of the slot to construct a new value with the given hash in.
+    ErrorOr<size_t> prepare_insert(unsigned hash)
+    {
+        if (m_capacity == 0)
+            TRY(try_rehash(minimum_capacity));
+
+        auto index = find_first_non_used(hash);
+        if (m_growth_left == 0 && m_control[index] != Group::deleted) {
+            // If most of the used up room is taken by tombstones, get rid of them instead of growing.
+            auto new_capacity = m_size * 32 <= m_capacity * 25 ? m_capacity : m_capacity * 2;
+            TRY(try_rehash(new_capacity));
+            index = find_first_non_used(hash);
+        }
+
+        if (m_control[index] == Group::empty)
+            --m_growth_left;
+        set_control(index, static_cast<i8>(tag_of(hash)));
+        ++m_size;
+        return index;
+    }
+
+    void erase_at(size_t index)
+    {
+        m_slots[index].~T();
+        --m_size;
+
+        // If there is an empty slot in every group containing this slot, no probe has ever gone past it, so it can be
+        // made empty again instead of leaving a tombstone.
+        auto mask = m_capacity - 1;
+        auto empty_after = Group { m_control + index }.match_empty();
+        auto empty_before = Group { m_control + ((index - Group::width) & mask) }.match_empty();
+        auto was_never_full = empty_before != 0 && empty_after != 0
+            && static_cast<size_t>(count_trailing_zeroes(empty_after) + count_leading_zeroes(empty_before << 16)) < Group::width;
+
+        set_control(index, was_never_full ? Group::empty : Group::deleted);
+        if (was_never_full)
+            ++m_growth_left;
+    }
+
+    void destroy_all()
+    {
+        if constexpr (!IsTriviallyDestructible<T>) {
+            for (size_t i = 0; i < m_capacity; ++i) {
+                if (m_control[i] >= 0)
+                    m_slots[i].~T();
+            }
+        }
+    }
+
+    ErrorOr<void> try_rehash(size_t new_capacity)
+    {
+        VERIFY(is_power_of_two(new_capacity) && new_capacity >= minimum_capacity);
+
+        auto* new_control = static_cast<i8*>(kmalloc(size_in_bytes(new_capacity)));
+        if (!new_control)
+            return Error::from_errno(ENOMEM);
+        __builtin_memset(new_control, Group::empty, new_capacity + Group::width);
+
+        auto* old_control = exchange(m_control, new_control);
+        auto* old_slots = exchange(m_slots, reinterpret_cast<T*>(reinterpret_cast<u8*>(new_control) + slots_offset(new_capacity)));
+        auto old_capacity = exchange(m_capacity, new_capacity);
+        m_growth_left = growth_for(new_capacity) - m_size;
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_control[i] < 0)
+                continue;
+            auto hash = TraitsForT::hash(old_slots[i]);
+            auto index = find_first_non_used(hash);
+            set_control(index, static_cast<i8>(tag_of(hash)));
+            new (&m_slots[index]) T(move(old_slots[i]));
+            old_slots[i].~T();
+        }
+
+        free_storage(old_control, old_capacity);
+        return {};
+    }
+
+    i8* m_control { nullptr };
+    T* m_slots { nullptr };
+    size_t m_capacity { 0 };
+    size_t m_size { 0 };
+    size_t m_growth_left { 0 };
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::FlatHashSet;
+using AK::FlatHashTable;
+#endif
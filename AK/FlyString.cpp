@@ -5,7 +5,7 @@
  */
 
 #include <AK/FlyString.h>
-#include <AK/HashTable.h>
+#include <AK/FlyStringTable.h>
 #include <AK/Singleton.h>
 #include <AK/String.h>
 #include <AK/StringData.h>
@@ -14,14 +14,9 @@
 
 namespace AK {
 
-struct FlyStringTableHashTraits : public Traits<Detail::StringData const*> {
-    static u32 hash(Detail::StringData const* string) { return string->hash(); }
-    static bool equals(Detail::StringData const* a, Detail::StringData const* b) { return *a == *b; }
-};
-
 static auto& all_fly_strings()
 {
-    static Singleton<HashTable<Detail::StringData const*, FlyStringTableHashTraits>> table;
+    static Singleton<Detail::FlyStringTable<Detail::StringData>> table;
     return *table;
 }
 
@@ -31,8 +26,8 @@ ErrorOr<FlyString> FlyString::from_utf8(StringView string)
         return FlyString {};
     if (string.length() <= Detail::MAX_SHORT_STRING_BYTE_COUNT)
         return FlyString { TRY(String::from_utf8(string)) };
-    if (auto it = all_fly_strings().find(string.hash(), [&](auto& entry) { return entry->bytes_as_string_view() == string; }); it != all_fly_strings().end())
-        return FlyString { Detail::StringBase(**it) };
+    if (auto const* data = all_fly_strings().find(string.hash(), [&](auto& entry) { return entry.bytes_as_string_view() == string; }))
+        return FlyString { Detail::StringBase(adopt_ref(*data)) };
     return FlyString { TRY(String::from_utf8(string)) };
 }
 
@@ -42,8 +37,8 @@ FlyString FlyString::from_utf8_without_validation(ReadonlyBytes string)
         return FlyString {};
     if (string.size() <= Detail::MAX_SHORT_STRING_BYTE_COUNT)
         return FlyString { String::from_utf8_without_validation(string) };
-    if (auto it = all_fly_strings().find(StringView(string).hash(), [&](auto& entry) { return entry->bytes_as_string_view() == string; }); it != all_fly_strings().end())
-        return FlyString { Detail::StringBase(**it) };
+    if (auto const* data = all_fly_strings().find(StringView(string).hash(), [&](auto& entry) { return entry.bytes_as_string_view() == string; }))
+        return FlyString { Detail::StringBase(adopt_ref(*data)) };
     return FlyString { String::from_utf8_without_validation(string) };
 }
 
@@ -61,15 +56,7 @@ FlyString::FlyString(String const& string)
         return;
     }
 
-    auto it = all_fly_strings().find(string.m_impl.data);
-    if (it == all_fly_strings().end()) {
-        m_data = string;
-        all_fly_strings().set(string.m_impl.data);
-        string.m_impl.data->set_fly_string(true);
-    } else {
-        m_data.m_impl.data = *it;
-        m_data.m_impl.data->ref();
-    }
+    m_data.m_impl.data = &all_fly_strings().intern(*string.m_impl.data, [](auto& data) { data.set_fly_string(true); });
 }
 
 FlyString& FlyString::operator=(String const& string)
@@ -208,7 +195,7 @@ namespace Detail {
 
 void did_destroy_fly_string_data(Badge<Detail::StringData>, Detail::StringData const& string_data)
 {
-    all_fly_strings().remove(&string_data);
+    all_fly_strings().remove(string_data);
 }
 
 }
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/HashTable.h>
+#include <AK/ScopeGuard.h>
+#include <AK/Traits.h>
+
+#ifdef AK_OS_WINDOWS
+// Forward declare to avoid pulling Windows.h into every file in existence.
+extern "C" __declspec(dllimport) void __stdcall Sleep(unsigned long);
+#else
+#    include <sched.h>
+#endif
+
+namespace AK::Detail {
+
+// The set of interned strings behind FlyString and Utf16FlyString, which can be used from any thread.
+//
+// Strings are spread over shards by their hash, each with its own lock, so threads interning different strings rarely
+// wait on each other. The locks are only held for a single hash table operation, so they simply spin.
+//
+// An interned string may be in the middle of being destroyed on another thread, having dropped its last reference
+// but not yet removed itself. Lookups therefore only hand out strings they can still take a reference to.
+template<typename StringDataType>
+class FlyStringTable {
+public:
+    // Returns the interned string matching the predicate with a new reference taken, or null if there is none.
+    template<typename Predicate>
+    StringDataType const* find(unsigned hash, Predicate const& predicate)
+    {
+        auto& shard = shard_for(hash);
+        shard.lock();
+        ScopeGuard unlock_guard = [&] { shard.unlock(); };
+
+        auto it = shard.strings.find(hash, [&](auto const* entry) { return predicate(*entry); });
+        if (it == shard.strings.end() || !(*it)->try_ref())
+            return nullptr;
+        return *it;
+    }
+
+    // Interns the given string, unless an equal string is interned already. Either way, returns the interned string
+    // with a new reference taken. The callback marks a newly interned string as such.
+    template<typename Callback>
+    StringDataType const& intern(StringDataType const& data, Callback mark_as_interned)
+    {
+        auto hash = data.hash();
+        auto& shard = shard_for(hash);
+        shard.lock();
+        ScopeGuard unlock_guard = [&] { shard.unlock(); };
+
+        if (auto it = shard.strings.find(hash, [&](auto const* entry) { return *entry == data; }); it != shard.strings.end()) {
+            if ((*it)->try_ref())
+                return **it;
+            // The string that is being destroyed won't find itself here anymore, which is fine.
+            shard.strings.remove(it);
+        }
+
+        shard.strings.set(&data);
+        mark_as_interned(data);
+        data.ref();
+        return data;
+    }
+
+    void remove(StringDataType const& data)
+    {
+        auto& shard = shard_for(data.hash());
+        shard.lock();
+        ScopeGuard unlock_guard = [&] { shard.unlock(); };
+
+        if (auto it = shard.strings.find(data.hash(), [&](auto const* entry) { return entry == &data; }); it != shard.strings.end())
+            shard.strings.remove(it);
+    }
+
+    size_t size()
+    {
+        size_t size = 0;
+        for (auto& shard : m_shards) {
+            shard.lock();
+            size += shard.strings.size();
+            shard.unlock();
+        }
+        return size;
+    }
+
+private:
+    static constexpr size_t shard_count = 32;
+
+    struct EntryTraits : public Traits<StringDataType const*> {
+        static unsigned hash(StringDataType const* string) { return string->hash(); }
+        static bool equals(StringDataType const* a, StringDataType const* b) { return *a == *b; }
+    };
+
+    struct alignas(64) Shard {
+        void lock()
+        {
+            while (is_locked.exchange(true, AK::memory_order_acquire)) {
+                while (is_locked.load(AK::memory_order_relaxed)) {
+#if defined(AK_OS_WINDOWS)
+                    Sleep(0);
+#else
+                    sched_yield();
+#endif
+                }
+            }
+        }
+
+        void unlock() { is_locked.store(false, AK::memory_order_release); }
+
+        Atomic<bool> is_locked { false };
+        HashTable<StringDataType const*, EntryTraits> strings;
+    };
+
+    // The hash tables pick buckets by the low bits of the hash, so use the high bits to pick a shard.
+    Shard& shard_for(unsigned hash) { return m_shards[(hash >> 27) % shard_count]; }
+
+    Shard m_shards[shard_count];
+};
+
+}
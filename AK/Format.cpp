@@ -89,6 +89,23 @@ static constexpr size_t convert_unsigned_to_string(u64 value, Array<u8, 128>& bu
     return used;
 }
 
+ErrorOr<void> format_parameter(TypeErasedFormatParams& params, FormatBuilder& builder, size_t index, StringView flags)
+{
+    if (index == use_next_index)
+        index = params.take_next_index();
+
+    auto& parameter = params.parameters().at(index);
+
+    FormatParser argparser { flags };
+    return parameter.visit([&]<typename T>(T const& value) {
+        if constexpr (IsSame<T, TypeErasedParameter::CustomType>) {
+            return value.formatter(params, builder, argparser, value.value);
+        } else {
+            return __format_value<T>(params, builder, argparser, &value);
+        }
+    });
+}
+
 ErrorOr<void> vformat_impl(TypeErasedFormatParams& params, FormatBuilder& builder, FormatParser& parser)
 {
     auto const literal = parser.consume_literal();
@@ -100,20 +117,26 @@ ErrorOr<void> vformat_impl(TypeErasedFormatParams& params, FormatBuilder& builde
         return {};
     }
 
-    if (specifier.index == use_next_index)
-        specifier.index = params.take_next_index();
+    TRY(format_parameter(params, builder, specifier.index, specifier.flags));
+    TRY(vformat_impl(params, builder, parser));
+    return {};
+}
 
-    auto& parameter = params.parameters().at(specifier.index);
+ErrorOr<void> vformat_segments(TypeErasedFormatParams& params, FormatBuilder& builder, StringView fmtstr, ReadonlySpan<Format::Detail::FormatSegment> segments)
+{
+    for (auto const& segment : segments) {
+        auto literal = fmtstr.substring_view(segment.literal_start, segment.literal_length);
+        if (segment.literal_has_escapes)
+            TRY(builder.put_literal(literal));
+        else
+            TRY(builder.builder().try_append(literal));
 
-    FormatParser argparser { specifier.flags };
-    TRY(parameter.visit([&]<typename T>(T const& value) {
-        if constexpr (IsSame<T, TypeErasedParameter::CustomType>) {
-            return value.formatter(params, builder, argparser, value.value);
-        } else {
-            return __format_value<T>(params, builder, argparser, &value);
-        }
-    }));
-    TRY(vformat_impl(params, builder, parser));
+        if (!segment.has_parameter)
+            break;
+
+        auto index = segment.index == Format::Detail::FormatSegment::use_next_index ? use_next_index : segment.index;
+        TRY(format_parameter(params, builder, index, fmtstr.substring_view(segment.flags_start, segment.flags_length)));
+    }
     return {};
 }
 
@@ -811,8 +834,11 @@ ErrorOr<void> FormatBuilder::put_hexdump(ReadonlyBytes bytes, size_t width, char
 ErrorOr<void> vformat(StringBuilder& builder, StringView fmtstr, TypeErasedFormatParams& params)
 {
     FormatBuilder fmtbuilder { builder };
-    FormatParser parser { fmtstr };
 
+    if (auto segments = params.segments_for(fmtstr); !segments.is_empty())
+        return vformat_segments(params, fmtbuilder, fmtstr, segments);
+
+    FormatParser parser { fmtstr };
     TRY(vformat_impl(params, fmtbuilder, parser));
     return {};
 }
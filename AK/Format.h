@@ -340,7 +340,25 @@ public:
 
     size_t take_next_index() { return m_next_index++; }
 
+    // The segments the given format string was split into at compile time, if any.
+    ReadonlySpan<Format::Detail::FormatSegment> segments_for(StringView fmtstr) const
+    {
+        if (fmtstr.characters_without_null_termination() != m_format_string.characters_without_null_termination() || fmtstr.length() != m_format_string.length())
+            return {};
+        return m_segments;
+    }
+
+protected:
+    template<typename... Parameters>
+    void set_format_string(CheckedFormatString<Parameters...> const& fmtstr)
+    {
+        m_format_string = fmtstr.view();
+        m_segments = fmtstr.segments();
+    }
+
 private:
+    StringView m_format_string;
+    ReadonlySpan<Format::Detail::FormatSegment> m_segments;
     u32 m_size { 0 };
     u32 m_next_index { 0 };
     TypeErasedParameter m_parameters[0];
@@ -360,6 +378,13 @@ public:
             "You are attempting to use a debug-only formatter outside of a debug log! Maybe one of your format values is an ErrorOr<T>?");
     }
 
+    // Lets formatting skip parsing the format string if it was split up at compile time.
+    VariadicFormatParams(CheckedFormatString<Parameters...> const& fmtstr, Parameters const&... parameters)
+        : VariadicFormatParams(parameters...)
+    {
+        set_format_string(fmtstr);
+    }
+
 private:
     TypeErasedParameter m_parameter_storage[sizeof...(Parameters)];
 };
@@ -624,14 +649,14 @@ void vout(FILE*, StringView fmtstr, TypeErasedFormatParams&, bool newline = fals
 template<typename... Parameters>
 void out(FILE* file, CheckedFormatString<Parameters...>&& fmtstr, Parameters const&... parameters)
 {
-    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { parameters... };
+    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { fmtstr, parameters... };
     vout(file, fmtstr.view(), variadic_format_params);
 }
 
 template<typename... Parameters>
 void outln(FILE* file, CheckedFormatString<Parameters...>&& fmtstr, Parameters const&... parameters)
 {
-    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { parameters... };
+    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { fmtstr, parameters... };
     vout(file, fmtstr.view(), variadic_format_params, true);
 }
 
@@ -671,14 +696,14 @@ void vout(LogLevel, StringView fmtstr, TypeErasedFormatParams&, bool newline = f
 template<typename... Parameters>
 void out(CheckedFormatString<Parameters...>&& fmtstr, Parameters const&... parameters)
 {
-    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { parameters... };
+    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { fmtstr, parameters... };
     vout(LogLevel::Info, fmtstr.view(), variadic_format_params);
 }
 
 template<typename... Parameters>
 void outln(CheckedFormatString<Parameters...>&& fmtstr, Parameters const&... parameters)
 {
-    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { parameters... };
+    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { fmtstr, parameters... };
     vout(LogLevel::Info, fmtstr.view(), variadic_format_params, true);
 }
 
@@ -687,14 +712,14 @@ inline void outln() { outln(""); }
 template<typename... Parameters>
 void warn(CheckedFormatString<Parameters...>&& fmtstr, Parameters const&... parameters)
 {
-    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { parameters... };
+    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { fmtstr, parameters... };
     vout(LogLevel::Warning, fmtstr.view(), variadic_format_params);
 }
 
 template<typename... Parameters>
 void warnln(CheckedFormatString<Parameters...>&& fmtstr, Parameters const&... parameters)
 {
-    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { parameters... };
+    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { fmtstr, parameters... };
     vout(LogLevel::Warning, fmtstr.view(), variadic_format_params, true);
 }
 
@@ -731,14 +756,14 @@ void vdbg(StringView fmtstr, TypeErasedFormatParams&, bool newline = false);
 template<typename... Parameters>
 void dbg(CheckedFormatString<Parameters...>&& fmtstr, Parameters const&... parameters)
 {
-    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { parameters... };
+    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { fmtstr, parameters... };
     vdbg(fmtstr.view(), variadic_format_params, false);
 }
 
 template<typename... Parameters>
 void dbgln(CheckedFormatString<Parameters...>&& fmtstr, Parameters const&... parameters)
 {
-    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { parameters... };
+    VariadicFormatParams<AllowDebugOnlyFormatters::Yes, Parameters...> variadic_format_params { fmtstr, parameters... };
     vdbg(fmtstr.view(), variadic_format_params, true);
 }
 
@@ -42,6 +42,7 @@ class FlyString;
 class IPv4Address;
 class IPv6Address;
 class JsonArray;
+class JsonCursor;
 class JsonObject;
 class JsonValue;
 class LexicalPath;
@@ -110,6 +111,15 @@ class HashMap;
 template<typename K, typename V, typename KeyTraits = Traits<K>, typename ValueTraits = Traits<V>>
 using OrderedHashMap = HashMap<K, V, KeyTraits, ValueTraits, true>;
 
+template<typename T, typename TraitsForT = Traits<T>>
+class FlatHashTable;
+
+template<typename T, typename TraitsForT = Traits<T>>
+using FlatHashSet = FlatHashTable<T, TraitsForT>;
+
+template<typename K, typename V, typename KeyTraits = Traits<K>, typename ValueTraits = Traits<V>>
+class FlatHashMap;
+
 template<typename T>
 class Badge;
 
@@ -119,11 +129,20 @@ class FixedArray;
 template<size_t precision, typename Underlying = i32>
 class FixedPoint;
 
-template<typename>
+// Empirically determined to fit most lambdas and functions.
+inline constexpr size_t default_function_inline_capacity = 4 * sizeof(void*);
+
+template<typename, size_t inline_capacity = default_function_inline_capacity>
 class Function;
 
+template<typename Out, size_t inline_capacity, typename... In>
+class Function<Out(In...), inline_capacity>;
+
+template<typename>
+class FunctionRef;
+
 template<typename Out, typename... In>
-class Function<Out(In...)>;
+class FunctionRef<Out(In...)>;
 
 template<typename T>
 class NonnullRefPtr;
@@ -180,14 +199,19 @@ using AK::Error;
 using AK::ErrorOr;
 using AK::FastLastAccess;
 using AK::FixedArray;
+using AK::FlatHashMap;
+using AK::FlatHashSet;
+using AK::FlatHashTable;
 using AK::FlyString;
 using AK::Function;
+using AK::FunctionRef;
 using AK::GenericLexer;
 using AK::HashMap;
 using AK::HashTable;
 using AK::IPv4Address;
 using AK::IPv6Address;
 using AK::JsonArray;
+using AK::JsonCursor;
 using AK::JsonObject;
 using AK::JsonValue;
 using AK::LexicalPath;
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/Format.h>
+#include <AK/Function.h>
+
+namespace AK::Detail {
+
+static Atomic<size_t> s_outline_function_count;
+
+void did_allocate_outline_function(char const* function_signature, size_t size)
+{
+    auto count = s_outline_function_count.fetch_add(1, AK::memory_order_relaxed) + 1;
+    dbgln("Function #{}: Allocating {} bytes on the heap in {}", count, size, function_signature);
+}
+
+}
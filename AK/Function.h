@@ -31,6 +31,8 @@
 #include <AK/Assertions.h>
 #include <AK/Atomic.h>
 #include <AK/BitCast.h>
+#include <AK/Debug.h>
+#include <AK/Forward.h>
 #include <AK/Noncopyable.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Span.h>
@@ -67,10 +69,10 @@ inline constexpr bool HaveObjcArc = false;
 // validated in TestFunction.mm
 inline constexpr size_t block_layout_size = 32;
 
-}
+// Called for every callable that doesn't fit into a Function's inline storage, when FUNCTION_DEBUG is enabled.
+void did_allocate_outline_function(char const* function_signature, size_t size);
 
-template<typename>
-class Function;
+}
 
 template<typename F>
 inline constexpr bool IsFunctionPointer = (IsPointer<F> && IsFunction<RemovePointer<F>>);
@@ -79,8 +81,11 @@ inline constexpr bool IsFunctionPointer = (IsPointer<F> && IsFunction<RemovePoin
 template<typename F>
 inline constexpr bool IsFunctionObject = (!IsFunctionPointer<F> && IsRvalueReference<F&&>);
 
-template<typename Out, typename... In>
-class Function<Out(In...)> {
+// Stores any callable object. Callables that fit into `inline_capacity` bytes (including a vtable pointer) are stored
+// inline, larger ones are allocated on the heap. Functions that are created a lot with larger captures can be given
+// more inline capacity.
+template<typename Out, size_t inline_capacity, typename... In>
+class Function<Out(In...), inline_capacity> {
     AK_MAKE_NONCOPYABLE(Function);
 
 public:
@@ -331,6 +336,8 @@ private:
         if constexpr (alignof(Callable) > inline_alignment || sizeof(WrapperType) > inline_capacity) {
             *bit_cast<CallableWrapperBase**>(&m_storage) = new WrapperType(forward<Callable>(callable));
             m_kind = FunctionKind::Outline;
+            if constexpr (FUNCTION_DEBUG)
+                Detail::did_allocate_outline_function(__PRETTY_FUNCTION__, sizeof(WrapperType));
         } else {
             static_assert(sizeof(WrapperType) <= inline_capacity);
             if constexpr (IsBlockClosure<Callable>) {
@@ -376,8 +383,7 @@ private:
     mutable Atomic<u16> m_call_nesting_level { 0 };
 
     static constexpr size_t inline_alignment = max(alignof(CallableWrapperBase), alignof(CallableWrapperBase*));
-    // Empirically determined to fit most lambdas and functions.
-    static constexpr size_t inline_capacity = 4 * sizeof(void*);
+    static_assert(inline_capacity >= sizeof(CallableWrapperBase*));
 
     alignas(inline_alignment) u8 m_storage[inline_capacity];
 } SWIFT_UNSAFE_REFERENCE;
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Concepts.h>
+#include <AK/Forward.h>
+#include <AK/StdLibExtras.h>
+
+namespace AK {
+
+// A non-owning reference to a callable object, for callbacks that are only called before the function taking them
+// returns, like the ones passed to for_each_*() functions. Unlike Function, it never allocates and never moves the
+// callable, but it must not outlive it either.
+template<typename Out, typename... In>
+class FunctionRef<Out(In...)> {
+public:
+    template<typename CallableType>
+    FunctionRef(CallableType&& callable LIFETIME_BOUND)
+    requires(IsCallableWithArguments<CallableType, Out, In...> && !IsFunction<RemoveCVReference<CallableType>> && !IsSame<RemoveCVReference<CallableType>, FunctionRef>)
+        : m_callable(const_cast<void*>(static_cast<void const*>(&callable)))
+        , m_call([](void* callable, In... in) -> Out {
+            return (*static_cast<RemoveReference<CallableType>*>(callable))(forward<In>(in)...);
+        })
+    {
+    }
+
+    FunctionRef(FunctionRef const&) = default;
+    FunctionRef& operator=(FunctionRef const&) = default;
+
+    Out operator()(In... in) const
+    {
+        return m_call(m_callable, forward<In>(in)...);
+    }
+
+private:
+    void* m_callable { nullptr };
+    Out (*m_call)(void*, In...) { nullptr };
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::FunctionRef;
+#endif
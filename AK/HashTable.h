@@ -9,6 +9,7 @@
 
 #include <AK/Concepts.h>
 #include <AK/Error.h>
+#include <AK/MemoryAccounting.h>
 #include <AK/ReverseIterator.h>
 #include <AK/StdLibExtras.h>
 #include <AK/Traits.h>
@@ -189,6 +190,7 @@ public:
             }
         }
 
+        MemoryAccounting::did_free(size_in_bytes(m_capacity));
         kfree_sized(m_buckets, size_in_bytes(m_capacity));
     }
 
@@ -603,6 +605,7 @@ private:
         auto* new_buckets = kcalloc(1, size_in_bytes(new_capacity));
         if (!new_buckets)
             return Error::from_errno(ENOMEM);
+        MemoryAccounting::did_allocate(size_in_bytes(new_capacity));
 
         m_buckets = static_cast<BucketType*>(new_buckets);
         m_capacity = new_capacity;
@@ -619,6 +622,7 @@ private:
             it->~T();
         }
 
+        MemoryAccounting::did_free(old_buckets_size);
         kfree_sized(old_buckets, old_buckets_size);
         return {};
     }
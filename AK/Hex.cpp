@@ -6,20 +6,69 @@
  */
 
 #include <AK/Hex.h>
-#include <AK/StringBuilder.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Types.h>
-#include <AK/Vector.h>
 
 namespace AK {
 
+// Turns 32 hex digits into 16 bytes. Returns false if any of the characters is not a hex digit.
+static ALWAYS_INLINE bool decode_32_hex_digits(u8 const* input, u8* output)
+{
+    auto to_nibbles = [](SIMD::u8x16 characters, SIMD::u8x16& nibbles) {
+        auto digits = characters - '0';
+        auto letters = (characters | 0x20) - 'a';
+        auto is_digit = (SIMD::u8x16)(digits < 10);
+        auto is_letter = (SIMD::u8x16)(letters < 6);
+        nibbles = (digits & is_digit) | ((letters + 10) & is_letter);
+        return (SIMD::i8x16)(is_digit | is_letter);
+    };
+
+    SIMD::u8x16 first;
+    SIMD::u8x16 second;
+    auto valid = to_nibbles(SIMD::load_unaligned<SIMD::u8x16>(input), first)
+        & to_nibbles(SIMD::load_unaligned<SIMD::u8x16>(input + 16), second);
+    if (SIMD::maskbits(valid) != 0xffff)
+        return false;
+
+    SIMD::u8x16 high = __builtin_shufflevector(first, second, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    SIMD::u8x16 low = __builtin_shufflevector(first, second, 1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+    SIMD::store_unaligned(output, (high << 4) | low);
+    return true;
+}
+
+// Turns 16 bytes into 32 lowercase hex digits.
+static ALWAYS_INLINE void encode_16_bytes_as_hex(u8 const* input, u8* output)
+{
+    auto to_digits = [](SIMD::u8x16 nibbles) {
+        return nibbles + '0' + ((SIMD::u8x16)(nibbles > 9) & ('a' - '0' - 10));
+    };
+
+    auto bytes = SIMD::load_unaligned<SIMD::u8x16>(input);
+    auto high = to_digits(bytes >> 4);
+    auto low = to_digits(bytes & 0xf);
+
+    SIMD::u8x16 first = __builtin_shufflevector(high, low, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+    SIMD::u8x16 second = __builtin_shufflevector(high, low, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+    SIMD::store_unaligned(output, first);
+    SIMD::store_unaligned(output + 16, second);
+}
+
 ErrorOr<ByteBuffer> decode_hex(StringView input)
 {
     if ((input.length() % 2) != 0)
         return Error::from_string_literal("Hex string was not an even length");
 
-    auto output = TRY(ByteBuffer::create_zeroed(input.length() / 2));
+    auto output = TRY(ByteBuffer::create_uninitialized(input.length() / 2));
+    auto const* characters = reinterpret_cast<u8 const*>(input.characters_without_null_termination());
+
+    size_t i = 0;
+    for (; i + 16 <= output.size(); i += 16) {
+        if (!decode_32_hex_digits(characters + i * 2, output.data() + i))
+            return Error::from_string_literal("Hex string contains invalid digit");
+    }
 
-    for (size_t i = 0; i < input.length() / 2; ++i) {
+    for (; i < output.size(); ++i) {
         auto const c1 = decode_hex_digit(input[i * 2]);
         if (c1 >= 16)
             return Error::from_string_literal("Hex string contains invalid digit");
@@ -36,12 +85,18 @@ ErrorOr<ByteBuffer> decode_hex(StringView input)
 
 ByteString encode_hex(ReadonlyBytes const input)
 {
-    StringBuilder output(input.size() * 2);
+    static constexpr auto digits = "0123456789abcdef";
 
-    for (auto ch : input)
-        output.appendff("{:02x}", ch);
+    return ByteString::create_and_overwrite(input.size() * 2, [&](Bytes output) {
+        size_t i = 0;
+        for (; i + 16 <= input.size(); i += 16)
+            encode_16_bytes_as_hex(input.data() + i, output.data() + i * 2);
 
-    return output.to_byte_string();
+        for (; i < input.size(); ++i) {
+            output[i * 2] = digits[input[i] >> 4];
+            output[i * 2 + 1] = digits[input[i] & 0xf];
+        }
+    });
 }
 
 }
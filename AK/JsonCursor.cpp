@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AnyOf.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/CharacterTypes.h>
+#include <AK/JsonCursor.h>
+#include <AK/JsonParser.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+static constexpr bool is_space(char ch)
+{
+    return ch == '\t' || ch == '\n' || ch == '\r' || ch == ' ';
+}
+
+static void skip_spaces(StringView input, size_t& offset)
+{
+    while (offset < input.length() && is_space(input[offset]))
+        ++offset;
+}
+
+// Returns the offset of the first of the given characters at or after `offset`, or the length of the input if there
+// is none. Most of a document is skipped over this way, so it looks at 16 bytes at a time.
+template<char... characters>
+static size_t find_first_of(StringView input, size_t offset)
+{
+    auto const* data = reinterpret_cast<u8 const*>(input.characters_without_null_termination());
+    for (; offset + 16 <= input.length(); offset += 16) {
+        auto chunk = SIMD::load_unaligned<SIMD::u8x16>(data + offset);
+        if (auto matches = SIMD::maskbits(((chunk == static_cast<u8>(characters)) | ...)); matches != 0)
+            return offset + count_trailing_zeroes(matches);
+    }
+    for (; offset < input.length(); ++offset) {
+        if (((data[offset] == static_cast<u8>(characters)) || ...))
+            return offset;
+    }
+    return input.length();
+}
+
+// Returns the offset right after the closing quote of the string whose contents start at `offset`.
+static ErrorOr<size_t> skip_string(StringView input, size_t offset, bool& has_escapes)
+{
+    for (;;) {
+        offset = find_first_of<'"', '\\'>(input, offset);
+        if (offset >= input.length())
+            return Error::from_string_literal("JsonCursor: EOF while parsing String");
+        if (input[offset] == '"')
+            return offset + 1;
+        has_escapes = true;
+        offset += 2;
+    }
+}
+
+// Returns the offset right after the bracket closing the array or object that starts at `offset`.
+static ErrorOr<size_t> skip_container(StringView input, size_t offset)
+{
+    Vector<char, 32> closing_brackets;
+    for (;;) {
+        offset = find_first_of<'"', '{', '}', '[', ']'>(input, offset);
+        if (offset == input.length())
+            return Error::from_string_literal("JsonCursor: EOF while parsing Array or Object");
+
+        auto ch = input[offset];
+        if (ch == '"') {
+            bool has_escapes = false;
+            offset = TRY(skip_string(input, offset + 1, has_escapes));
+            continue;
+        }
+        ++offset;
+        if (ch == '{' || ch == '[') {
+            closing_brackets.append(ch == '{' ? '}' : ']');
+            continue;
+        }
+        if (closing_brackets.is_empty() || closing_brackets.take_last() != ch)
+            return Error::from_string_literal("JsonCursor: Mismatched brackets");
+        if (closing_brackets.is_empty())
+            return offset;
+    }
+}
+
+ErrorOr<JsonCursor> JsonCursor::consume_value(StringView input, size_t& offset)
+{
+    skip_spaces(input, offset);
+    if (offset == input.length())
+        return Error::from_string_literal("JsonCursor: Unexpected EOF");
+
+    auto start = offset;
+    auto type = Type::Null;
+    bool has_escapes = false;
+    switch (input[offset]) {
+    case '{':
+    case '[':
+        type = input[offset] == '{' ? Type::Object : Type::Array;
+        offset = TRY(skip_container(input, offset));
+        break;
+    case '"':
+        type = Type::String;
+        offset = TRY(skip_string(input, offset + 1, has_escapes));
+        break;
+    case 't':
+    case 'f':
+    case 'n':
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9': {
+        while (offset < input.length() && !is_space(input[offset]) && !"{}[],:\""sv.contains(input[offset]))
+            ++offset;
+        auto literal = input.substring_view(start, offset - start);
+        if (literal == "true"sv || literal == "false"sv)
+            type = Type::Bool;
+        else if (literal == "null"sv)
+            type = Type::Null;
+        else if (literal[0] == '-' || is_ascii_digit(literal[0]))
+            type = Type::Number;
+        else
+            return Error::from_string_literal("JsonCursor: Unexpected literal");
+        break;
+    }
+    default:
+        return Error::from_string_literal("JsonCursor: Unexpected character");
+    }
+
+    return JsonCursor { input.substring_view(start, offset - start), type, has_escapes };
+}
+
+ErrorOr<JsonCursor> JsonCursor::create(StringView input)
+{
+    size_t offset = 0;
+    auto cursor = TRY(consume_value(input, offset));
+    skip_spaces(input, offset);
+    if (offset != input.length())
+        return Error::from_string_literal("JsonCursor: Didn't consume all input");
+    return cursor;
+}
+
+ErrorOr<void> JsonCursor::for_each_member(Function<IterationDecision(JsonCursor const& key, JsonCursor const& value)> const& callback) const
+{
+    if (m_type != Type::Object)
+        return Error::from_string_literal("JsonCursor: Expected an object");
+
+    // The raw text ends in the closing brace, which stops every value inside, so none of this can run past its end.
+    size_t offset = 1;
+    skip_spaces(m_raw, offset);
+    if (m_raw[offset] == '}')
+        return {};
+
+    for (;;) {
+        auto key = TRY(consume_value(m_raw, offset));
+        if (!key.is_string())
+            return Error::from_string_literal("JsonCursor: Expected a string as key");
+        skip_spaces(m_raw, offset);
+        if (m_raw[offset] != ':')
+            return Error::from_string_literal("JsonCursor: Expected ':'");
+        ++offset;
+
+        auto value = TRY(consume_value(m_raw, offset));
+        if (callback(key, value) == IterationDecision::Break)
+            return {};
+
+        skip_spaces(m_raw, offset);
+        if (m_raw[offset] == '}')
+            return {};
+        if (m_raw[offset] != ',')
+            return Error::from_string_literal("JsonCursor: Expected ','");
+        ++offset;
+    }
+}
+
+ErrorOr<Optional<JsonCursor>> JsonCursor::get(StringView key) const
+{
+    Optional<JsonCursor> result;
+    Optional<Error> error;
+    TRY(for_each_member([&](auto const& member_key, auto const& value) {
+        if (auto view = member_key.as_string_view(); view.has_value()) {
+            if (*view != key)
+                return IterationDecision::Continue;
+        } else {
+            auto unescaped = member_key.to_string();
+            if (unescaped.is_error()) {
+                error = unescaped.release_error();
+                return IterationDecision::Break;
+            }
+            if (unescaped.value() != key)
+                return IterationDecision::Continue;
+        }
+        result = value;
+        return IterationDecision::Break;
+    }));
+    if (error.has_value())
+        return error.release_value();
+    return result;
+}
+
+ErrorOr<void> JsonCursor::for_each_element(Function<IterationDecision(JsonCursor const&)> const& callback) const
+{
+    if (m_type != Type::Array)
+        return Error::from_string_literal("JsonCursor: Expected an array");
+
+    size_t offset = 1;
+    skip_spaces(m_raw, offset);
+    if (m_raw[offset] == ']')
+        return {};
+
+    for (;;) {
+        auto element = TRY(consume_value(m_raw, offset));
+        if (callback(element) == IterationDecision::Break)
+            return {};
+
+        skip_spaces(m_raw, offset);
+        if (m_raw[offset] == ']')
+            return {};
+        if (m_raw[offset] != ',')
+            return Error::from_string_literal("JsonCursor: Expected ','");
+        ++offset;
+    }
+}
+
+ErrorOr<Optional<JsonCursor>> JsonCursor::at(size_t index) const
+{
+    Optional<JsonCursor> result;
+    size_t current_index = 0;
+    TRY(for_each_element([&](auto const& element) {
+        if (current_index++ != index)
+            return IterationDecision::Continue;
+        result = element;
+        return IterationDecision::Break;
+    }));
+    return result;
+}
+
+ErrorOr<size_t> JsonCursor::size() const
+{
+    size_t size = 0;
+    if (m_type == Type::Object) {
+        TRY(for_each_member([&](auto const&, auto const&) {
+            ++size;
+            return IterationDecision::Continue;
+        }));
+    } else {
+        TRY(for_each_element([&](auto const&) {
+            ++size;
+            return IterationDecision::Continue;
+        }));
+    }
+    return size;
+}
+
+Optional<StringView> JsonCursor::as_string_view() const
+{
+    if (m_type != Type::String || m_string_has_escapes)
+        return {};
+    return m_raw.substring_view(1, m_raw.length() - 2);
+}
+
+ErrorOr<String> JsonCursor::to_string() const
+{
+    if (m_type != Type::String)
+        return Error::from_string_literal("JsonCursor: Expected a string");
+    if (!m_string_has_escapes && !any_of(m_raw, [](char ch) { return is_ascii_c0_control(ch); }))
+        return String::from_utf8(*as_string_view());
+    auto value = TRY(materialize());
+    return value.as_string();
+}
+
+ErrorOr<bool> JsonCursor::to_bool() const
+{
+    if (m_type != Type::Bool)
+        return Error::from_string_literal("JsonCursor: Expected a boolean");
+    return m_raw == "true"sv;
+}
+
+ErrorOr<double> JsonCursor::to_double() const
+{
+    if (m_type != Type::Number)
+        return Error::from_string_literal("JsonCursor: Expected a number");
+    auto value = TRY(materialize());
+    return value.get_double_with_precision_loss().value();
+}
+
+ErrorOr<JsonValue> JsonCursor::materialize() const
+{
+    return JsonParser::parse(m_raw);
+}
+
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Function.h>
+#include <AK/IterationDecision.h>
+#include <AK/JsonValue.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/StringView.h>
+
+namespace AK {
+
+// A cursor onto a single value in a JSON document, which only parses as much of the document as is accessed, and
+// doesn't allocate while doing so. Values that are skipped over are only checked for balanced brackets and
+// terminated strings, so errors inside them surface once they are accessed. Use JsonParser to validate and load a
+// whole document instead.
+class JsonCursor {
+public:
+    enum class Type : u8 {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object,
+    };
+
+    static ErrorOr<JsonCursor> create(StringView input);
+
+    Type type() const { return m_type; }
+    bool is_null() const { return m_type == Type::Null; }
+    bool is_bool() const { return m_type == Type::Bool; }
+    bool is_number() const { return m_type == Type::Number; }
+    bool is_string() const { return m_type == Type::String; }
+    bool is_array() const { return m_type == Type::Array; }
+    bool is_object() const { return m_type == Type::Object; }
+
+    // The source text of this value.
+    StringView raw() const { return m_raw; }
+
+    ErrorOr<Optional<JsonCursor>> get(StringView key) const;
+    ErrorOr<void> for_each_member(Function<IterationDecision(JsonCursor const& key, JsonCursor const& value)> const&) const;
+
+    ErrorOr<Optional<JsonCursor>> at(size_t index) const;
+    ErrorOr<size_t> size() const;
+    ErrorOr<void> for_each_element(Function<IterationDecision(JsonCursor const&)> const&) const;
+
+    // Returns the contents of a string without copying them, unless they have to be unescaped.
+    Optional<StringView> as_string_view() const;
+    ErrorOr<String> to_string() const;
+
+    ErrorOr<bool> to_bool() const;
+    ErrorOr<double> to_double() const;
+
+    template<Integral T>
+    ErrorOr<T> to_integer() const
+    {
+        auto value = TRY(materialize());
+        if (auto integer = value.get_integer<T>(); integer.has_value())
+            return *integer;
+        return Error::from_string_literal("JsonCursor: Expected an integer");
+    }
+
+    // Parses this value and everything in it.
+    ErrorOr<JsonValue> materialize() const;
+
+private:
+    JsonCursor(StringView raw, Type type, bool string_has_escapes)
+        : m_raw(raw)
+        , m_type(type)
+        , m_string_has_escapes(string_has_escapes)
+    {
+    }
+
+    static ErrorOr<JsonCursor> consume_value(StringView input, size_t& offset);
+
+    StringView m_raw;
+    Type m_type { Type::Null };
+    bool m_string_has_escapes { false };
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::JsonCursor;
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/MemoryAccounting.h>
+#include <AK/StdLibExtras.h>
+#include <AK/StringView.h>
+
+namespace AK::MemoryAccounting {
+
+StringView category_name(Category category)
+{
+    switch (category) {
+    case Category::Uncategorized:
+        return "Uncategorized"sv;
+    case Category::Style:
+        return "Style"sv;
+    case Category::Layout:
+        return "Layout"sv;
+    case Category::Paint:
+        return "Paint"sv;
+    case Category::JSHeapExternal:
+        return "JS heap (external)"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+#ifdef AK_ENABLE_MEMORY_ACCOUNTING
+
+static thread_local Category s_current_category { Category::Uncategorized };
+
+struct alignas(64) Counters {
+    Atomic<i64> live_bytes { 0 };
+    Atomic<u64> allocation_count { 0 };
+};
+
+static Counters s_counters[category_count];
+
+Category current_category()
+{
+    return s_current_category;
+}
+
+void set_current_category(Category category)
+{
+    s_current_category = category;
+}
+
+void did_allocate(size_t size)
+{
+    auto& counters = s_counters[to_underlying(s_current_category)];
+    counters.live_bytes.fetch_add(static_cast<i64>(size), AK::memory_order_relaxed);
+    counters.allocation_count.fetch_add(1, AK::memory_order_relaxed);
+}
+
+void did_free(size_t size)
+{
+    s_counters[to_underlying(s_current_category)].live_bytes.fetch_sub(static_cast<i64>(size), AK::memory_order_relaxed);
+}
+
+Usage usage(Category category)
+{
+    auto const& counters = s_counters[to_underlying(category)];
+    return {
+        .live_bytes = counters.live_bytes.load(AK::memory_order_relaxed),
+        .allocation_count = counters.allocation_count.load(AK::memory_order_relaxed),
+    };
+}
+
+#endif
+
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Forward.h>
+#include <AK/Noncopyable.h>
+#include <AK/Platform.h>
+#include <AK/Types.h>
+
+// Attributes the memory used by AK containers (Vector, HashTable, ByteBuffer and ByteString) to the subsystem that
+// allocated it. This is only compiled in with ENABLE_MEMORY_ACCOUNTING, and costs nothing otherwise.
+//
+// Allocations are attributed to the category that is current on the allocating thread, and frees to the category
+// that is current on the freeing thread. Memory that is allocated during one phase and freed during another is
+// therefore attributed to the first one while it's alive, and subtracted from the second one when it's freed. The
+// live bytes of a category are best read as "how much memory did this category leave behind".
+namespace AK::MemoryAccounting {
+
+enum class Category : u8 {
+    Uncategorized,
+    Style,
+    Layout,
+    Paint,
+    JSHeapExternal,
+};
+
+static constexpr size_t category_count = 5;
+
+StringView category_name(Category);
+
+struct Usage {
+    i64 live_bytes { 0 };
+    u64 allocation_count { 0 };
+};
+
+#ifdef AK_ENABLE_MEMORY_ACCOUNTING
+static constexpr bool is_enabled = true;
+
+Category current_category();
+void set_current_category(Category);
+
+void did_allocate(size_t size);
+void did_free(size_t size);
+
+Usage usage(Category);
+#else
+static constexpr bool is_enabled = false;
+
+ALWAYS_INLINE Category current_category() { return Category::Uncategorized; }
+ALWAYS_INLINE void set_current_category(Category) { }
+
+ALWAYS_INLINE void did_allocate(size_t) { }
+ALWAYS_INLINE void did_free(size_t) { }
+
+ALWAYS_INLINE Usage usage(Category) { return {}; }
+#endif
+
+// Makes the given category the current one for the calling thread until it goes out of scope.
+class ScopedCategory {
+    AK_MAKE_NONCOPYABLE(ScopedCategory);
+    AK_MAKE_NONMOVABLE(ScopedCategory);
+
+public:
+    explicit ScopedCategory(Category category)
+        : m_previous_category(current_category())
+    {
+        set_current_category(category);
+    }
+
+    ~ScopedCategory()
+    {
+        set_current_category(m_previous_category);
+    }
+
+private:
+    Category m_previous_category { Category::Uncategorized };
+};
+
+}
@@ -79,6 +79,18 @@ ALWAYS_INLINE static i32 maskbits(i32x4 mask)
 #endif
 }
 
+ALWAYS_INLINE static u32 maskbits(i8x16 mask)
+{
+#if defined(__SSE2__)
+    return static_cast<u16>(__builtin_ia32_pmovmskb128(bit_cast<c8x16>(mask)));
+#else
+    u32 bits = 0;
+    for (size_t i = 0; i < 16; ++i)
+        bits |= static_cast<u32>(static_cast<u8>(mask[i]) >> 7) << i;
+    return bits;
+#endif
+}
+
 ALWAYS_INLINE static bool all(i32x4 mask)
 {
     return maskbits(mask) == 15;
@@ -617,8 +617,8 @@ using InvokeResult = typename __InvokeResult<F, Args...>::type;
 template<typename Callable>
 struct EquivalentFunctionTypeImpl;
 
-template<template<typename> class Function, typename T, typename... Args>
-struct EquivalentFunctionTypeImpl<Function<T(Args...)>> {
+template<template<typename, auto...> class Function, typename T, typename... Args, auto... Parameters>
+struct EquivalentFunctionTypeImpl<Function<T(Args...), Parameters...>> {
     using Type = T(Args...);
 };
 
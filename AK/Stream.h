@@ -108,7 +108,7 @@ public:
     template<typename... Parameters>
     ErrorOr<void> write_formatted(CheckedFormatString<Parameters...>&& fmtstr, Parameters const&... parameters)
     {
-        VariadicFormatParams<AllowDebugOnlyFormatters::No, Parameters...> variadic_format_params { parameters... };
+        VariadicFormatParams<AllowDebugOnlyFormatters::No, Parameters...> variadic_format_params { fmtstr, parameters... };
         TRY(write_formatted_impl(fmtstr.view(), variadic_format_params));
         return {};
     }
@@ -6,9 +6,9 @@
 
 #pragma once
 
+#include <AK/AtomicRefCounted.h>
 #include <AK/Error.h>
 #include <AK/NonnullRefPtr.h>
-#include <AK/RefCounted.h>
 #include <AK/StringBuilder.h>
 
 namespace AK::Detail {
@@ -19,7 +19,8 @@ class StringData;
 
 void did_destroy_fly_string_data(Badge<StringData>, StringData const&);
 
-class StringData final : public RefCounted<StringData> {
+// The reference count is atomic since fly strings share their data across threads.
+class StringData final : public AtomicRefCounted<StringData> {
 public:
     static ErrorOr<NonnullRefPtr<StringData>> create_uninitialized(size_t byte_count, u8*& buffer)
     {
@@ -71,10 +72,12 @@ public:
 
     ~StringData()
     {
-        if (m_substring)
-            substring_data().superstring->unref();
+        // Lookups on other threads may still compare against this string until it's removed from the fly string table,
+        // so it has to keep its bytes until then.
         if (m_is_fly_string)
             Detail::did_destroy_fly_string_data({}, *this);
+        if (m_substring)
+            substring_data().superstring->unref();
     }
 
     SubstringData const& substring_data() const
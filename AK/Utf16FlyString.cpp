@@ -4,20 +4,15 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/HashTable.h>
+#include <AK/FlyStringTable.h>
 #include <AK/Singleton.h>
 #include <AK/Utf16FlyString.h>
 
 namespace AK {
 
-struct Utf16FlyStringTableHashTraits : public Traits<Detail::Utf16StringData const*> {
-    static u32 hash(Detail::Utf16StringData const* string) { return string->hash(); }
-    static bool equals(Detail::Utf16StringData const* a, Detail::Utf16StringData const* b) { return *a == *b; }
-};
-
 static auto& all_utf16_fly_strings()
 {
-    static Singleton<HashTable<Detail::Utf16StringData const*, Utf16FlyStringTableHashTraits>> table;
+    static Singleton<Detail::FlyStringTable<Detail::Utf16StringData>> table;
     return *table;
 }
 
@@ -25,7 +20,7 @@ namespace Detail {
 
 void did_destroy_utf16_fly_string_data(Badge<Detail::Utf16StringData>, Detail::Utf16StringData const& data)
 {
-    all_utf16_fly_strings().remove(&data);
+    all_utf16_fly_strings().remove(data);
 }
 
 }
@@ -44,8 +39,8 @@ Optional<Utf16FlyString> Utf16FlyString::create_fly_string_from_cache(ViewType c
             return Utf16String::from_utf16(string);
     }
 
-    if (auto it = all_utf16_fly_strings().find(string.hash(), [&](auto const& entry) { return *entry == string; }); it != all_utf16_fly_strings().end())
-        return Utf16FlyString { Detail::Utf16StringBase(**it) };
+    if (auto const* data = all_utf16_fly_strings().find(string.hash(), [&](auto const& entry) { return entry == string; }))
+        return Utf16FlyString { Detail::Utf16StringBase(adopt_ref(*data)) };
 
     return {};
 }
@@ -85,14 +80,9 @@ Utf16FlyString::Utf16FlyString(Utf16String const& string)
         return;
     }
 
-    if (auto it = all_utf16_fly_strings().find(data); it == all_utf16_fly_strings().end()) {
-        m_data = string;
-
-        all_utf16_fly_strings().set(data);
-        data->mark_as_fly_string({});
-    } else {
-        m_data.set_data({}, *it);
-    }
+    auto const& interned = all_utf16_fly_strings().intern(*data, [](auto const& data) { data.mark_as_fly_string(Badge<Utf16FlyString> {}); });
+    m_data.set_data({}, &interned);
+    interned.unref();
 }
 
 size_t Utf16FlyString::number_of_utf16_fly_strings()
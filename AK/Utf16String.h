@@ -98,7 +98,7 @@ public:
     {
         StringBuilder builder(StringBuilder::Mode::UTF16);
 
-        VariadicFormatParams<AllowDebugOnlyFormatters::No, Parameters...> variadic_format_parameters { parameters... };
+        VariadicFormatParams<AllowDebugOnlyFormatters::No, Parameters...> variadic_format_parameters { format, parameters... };
         MUST(vformat(builder, format.view(), variadic_format_parameters));
 
         return builder.to_utf16_string();
@@ -6,9 +6,9 @@
 
 #pragma once
 
+#include <AK/AtomicRefCounted.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/NumericLimits.h>
-#include <AK/RefCounted.h>
 #include <AK/Span.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
@@ -18,7 +18,8 @@ namespace AK::Detail {
 
 void did_destroy_utf16_fly_string_data(Badge<Detail::Utf16StringData>, Detail::Utf16StringData const&);
 
-class Utf16StringData final : public RefCounted<Utf16StringData> {
+// The reference count is atomic since fly strings share their data across threads.
+class Utf16StringData final : public AtomicRefCounted<Utf16StringData> {
 public:
     enum class StorageType : u8 {
         ASCII,
@@ -12,6 +12,7 @@
 #include <AK/Find.h>
 #include <AK/Forward.h>
 #include <AK/Iterator.h>
+#include <AK/MemoryAccounting.h>
 #include <AK/Optional.h>
 #include <AK/ReverseIterator.h>
 #include <AK/Span.h>
@@ -452,6 +453,7 @@ public:
     {
         clear_with_capacity();
         if (m_metadata.outline_buffer) {
+            MemoryAccounting::did_free(m_capacity * sizeof(StorageType));
             kfree_sized(m_metadata.outline_buffer, m_capacity * sizeof(StorageType));
             m_metadata.outline_buffer = nullptr;
         }
@@ -812,6 +814,7 @@ public:
         auto* new_buffer = static_cast<StorageType*>(kmalloc_array(new_capacity, sizeof(StorageType)));
         if (new_buffer == nullptr)
             return Error::from_errno(ENOMEM);
+        MemoryAccounting::did_allocate(new_capacity * sizeof(StorageType));
 
         if constexpr (Traits<StorageType>::is_trivial()) {
             TypedTransfer<StorageType>::copy(new_buffer, data(), m_size);
@@ -821,8 +824,10 @@ public:
                 at(i).~StorageType();
             }
         }
-        if (m_metadata.outline_buffer)
+        if (m_metadata.outline_buffer) {
+            MemoryAccounting::did_free(m_capacity * sizeof(StorageType));
             kfree_sized(m_metadata.outline_buffer, m_capacity * sizeof(StorageType));
+        }
         m_metadata.outline_buffer = new_buffer;
         m_capacity = new_capacity;
         update_metadata(); // We have *some* space, we just allocated it.
@@ -7,6 +7,7 @@
  */
 
 #include <AK/BinarySearch.h>
+#include <AK/BuiltinWrappers.h>
 #include <LibCompress/Deflate.h>
 #include <LibCompress/DeflateTables.h>
 
@@ -56,7 +57,7 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
     }
 
     if (non_zero_symbols == 1) { // special case - only 1 symbol
-        code.m_prefix_table[0] = PrefixTableEntry { static_cast<u16>(last_non_zero), 1u };
+        code.m_prefix_table[0] = PrefixTableEntry { static_cast<u16>(last_non_zero), 1 };
         code.m_prefix_table[1] = code.m_prefix_table[0];
         code.m_max_prefixed_code_length = 1;
 
@@ -128,22 +129,101 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
 
         for (size_t j = 0; j < (1u << shift); ++j) {
             auto index = fast_reverse16(symbol_code + j, code.m_max_prefixed_code_length);
-            code.m_prefix_table[index] = PrefixTableEntry { symbol_value, code_length };
+            code.m_prefix_table[index] = PrefixTableEntry { symbol_value, static_cast<u8>(code_length) };
         }
     }
 
+    TRY(code.build_subtables());
+
     return code;
 }
 
+// Groups the codes that are longer than the prefix table by their first bits, and gives each group of codes that share
+// these bits a subtable that is just large enough to hold the longest of them. This way, every symbol is decoded with
+// at most two table lookups, instead of searching for the code one bit at a time.
+ErrorOr<void> CanonicalCode::build_subtables()
+{
+    if (m_symbol_codes.is_empty())
+        return {};
+
+    auto prefix_length = m_max_prefixed_code_length;
+
+    // The codes are stored most significant bit first, behind a marker bit that gives away their length.
+    auto code_length_of = [](u16 marked_code) { return static_cast<size_t>(15 - count_leading_zeroes(marked_code)); };
+    auto prefix_index_of = [&](u16 marked_code) {
+        auto code_length = code_length_of(marked_code);
+        auto code = marked_code & ((1u << code_length) - 1);
+        return fast_reverse16(code >> (code_length - prefix_length), prefix_length);
+    };
+
+    Array<u8, 1 << max_allowed_prefixed_code_length> subtable_bits {};
+    for (auto marked_code : m_symbol_codes) {
+        auto& bits = subtable_bits[prefix_index_of(marked_code)];
+        bits = max(bits, static_cast<u8>(code_length_of(marked_code) - prefix_length));
+    }
+
+    size_t subtables_size = 0;
+    for (auto bits : subtable_bits)
+        subtables_size += bits == 0 ? 0 : 1uz << bits;
+
+    // A short prefix followed by very long codes would need huge subtables, which isn't worth it for such unusual codes.
+    // Their symbols are looked up one bit at a time instead.
+    if (subtables_size > max_subtables_size)
+        return {};
+
+    TRY(m_subtables.try_resize(subtables_size));
+
+    size_t offset = 0;
+    for (size_t index = 0; index < subtable_bits.size(); ++index) {
+        if (subtable_bits[index] == 0)
+            continue;
+        m_prefix_table[index] = PrefixTableEntry { static_cast<u16>(offset), 0, subtable_bits[index] };
+        offset += 1uz << subtable_bits[index];
+    }
+
+    for (size_t i = 0; i < m_symbol_codes.size(); ++i) {
+        auto marked_code = m_symbol_codes[i];
+        auto code_length = code_length_of(marked_code);
+        auto const& link = m_prefix_table[prefix_index_of(marked_code)];
+
+        // The bits after the prefix are read least significant bit first, so they index the subtable in reverse.
+        auto suffix_length = code_length - prefix_length;
+        auto suffix = fast_reverse16(marked_code & ((1u << suffix_length) - 1), suffix_length);
+        for (size_t j = 0; j < (1u << (link.subtable_bits - suffix_length)); ++j)
+            m_subtables[link.symbol_value + (suffix | (j << suffix_length))] = PrefixTableEntry { m_symbol_values[i], static_cast<u8>(code_length) };
+    }
+
+    return {};
+}
+
 ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) const
 {
     auto prefix = TRY(stream.peek_bits<size_t>(m_max_prefixed_code_length));
 
-    if (auto [symbol_value, code_length] = m_prefix_table[prefix]; code_length != 0) {
-        stream.discard_previously_peeked_bits(code_length);
-        return symbol_value;
+    auto const& entry = m_prefix_table[prefix];
+    if (entry.code_length != 0) {
+        stream.discard_previously_peeked_bits(entry.code_length);
+        return entry.symbol_value;
     }
 
+    if (entry.subtable_bits == 0) [[unlikely]]
+        return read_long_symbol_bit_by_bit(stream);
+
+    // The subtable is indexed by as many bits as the longest code in it, which may be more than are left in the stream.
+    auto bits_or_error = stream.peek_bits<size_t>(m_max_prefixed_code_length + entry.subtable_bits);
+    if (bits_or_error.is_error()) [[unlikely]]
+        return read_long_symbol_bit_by_bit(stream);
+
+    auto const& subtable_entry = m_subtables[entry.symbol_value + (bits_or_error.value() >> m_max_prefixed_code_length)];
+    if (subtable_entry.code_length == 0)
+        return Error::from_string_literal("Symbol exceeds maximum symbol number");
+
+    stream.discard_previously_peeked_bits(subtable_entry.code_length);
+    return subtable_entry.symbol_value;
+}
+
+ErrorOr<u32> CanonicalCode::read_long_symbol_bit_by_bit(LittleEndianInputBitStream& stream) const
+{
     auto code_bits = TRY(stream.read_bits<u16>(m_max_prefixed_code_length));
     code_bits = fast_reverse16(code_bits, m_max_prefixed_code_length);
     code_bits |= 1 << m_max_prefixed_code_length;
@@ -174,8 +254,8 @@ ErrorOr<ByteBuffer> DeflateDecompressor::decompress_all(ReadonlyBytes bytes)
 ErrorOr<NonnullOwnPtr<DeflateCompressor>> DeflateCompressor::create(MaybeOwned<Stream> stream, GenericZlibCompressionLevel compression_level)
 {
     auto buffer = TRY(AK::FixedArray<u8>::create(16 * 1024));
-    auto zstream = TRY(GenericZlibCompressor::new_z_stream(-MAX_WBITS, compression_level));
-    return adopt_nonnull_own_or_enomem(new (nothrow) DeflateCompressor(move(buffer), move(stream), zstream));
+    auto zstream = TRY(GenericZlibCompressor::new_z_stream(compression_level));
+    return adopt_nonnull_own_or_enomem(new (nothrow) DeflateCompressor(move(buffer), move(stream), zstream, compression_level));
 }
 
 ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, GenericZlibCompressionLevel compression_level)
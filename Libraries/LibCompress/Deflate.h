@@ -27,18 +27,26 @@ public:
 
 private:
     static constexpr size_t max_allowed_prefixed_code_length = 8;
+    static constexpr size_t max_subtables_size = 4096;
 
+    // An entry with a code length of 0 links codes that are longer than the prefix to a subtable, which starts at
+    // symbol_value in m_subtables and is indexed by the next subtable_bits bits.
     struct PrefixTableEntry {
         u16 symbol_value { 0 };
-        u16 code_length { 0 };
+        u8 code_length { 0 };
+        u8 subtable_bits { 0 };
     };
 
+    ErrorOr<void> build_subtables();
+    ErrorOr<u32> read_long_symbol_bit_by_bit(LittleEndianInputBitStream&) const;
+
     // Decompression - indexed by code
     Vector<u16, 286> m_symbol_codes;
     Vector<u16, 286> m_symbol_values;
 
     Array<PrefixTableEntry, 1 << max_allowed_prefixed_code_length> m_prefix_table {};
     size_t m_max_prefixed_code_length { 0 };
+    Vector<PrefixTableEntry> m_subtables;
 
     // Compression - indexed by symbol
     // Deflate uses a maximum of 288 symbols (maximum of 32 for distances),
@@ -73,8 +81,8 @@ public:
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes, GenericZlibCompressionLevel = GenericZlibCompressionLevel::Default);
 
 private:
-    DeflateCompressor(AK::FixedArray<u8> buffer, MaybeOwned<Stream> stream, z_stream* zstream)
-        : GenericZlibCompressor(move(buffer), move(stream), zstream)
+    DeflateCompressor(AK::FixedArray<u8> buffer, MaybeOwned<Stream> stream, z_stream* zstream, GenericZlibCompressionLevel compression_level)
+        : GenericZlibCompressor(move(buffer), move(stream), zstream, Container::Raw, compression_level)
     {
     }
 };
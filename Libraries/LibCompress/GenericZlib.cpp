@@ -4,7 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Endian.h>
+#include <AK/ScopeGuard.h>
 #include <LibCompress/GenericZlib.h>
+#include <LibThreading/Parallel.h>
 
 #include <zlib.h>
 
@@ -116,40 +119,64 @@ void GenericZlibDecompressor::close()
 {
 }
 
-GenericZlibCompressor::GenericZlibCompressor(AK::FixedArray<u8> buffer, MaybeOwned<Stream> stream, z_stream* zstream)
+GenericZlibCompressor::GenericZlibCompressor(AK::FixedArray<u8> buffer, MaybeOwned<Stream> stream, z_stream* zstream, Container container, GenericZlibCompressionLevel compression_level)
     : m_stream(move(stream))
     , m_zstream(zstream)
+    , m_container(container)
+    , m_compression_level(compression_level)
     , m_buffer(move(buffer))
 {
+    if (m_container == Container::Zlib)
+        m_checksum = adler32(0, nullptr, 0);
+    else if (m_container == Container::Gzip)
+        m_checksum = crc32(0, nullptr, 0);
 }
 
-ErrorOr<z_stream*> GenericZlibCompressor::new_z_stream(int window_bits, GenericZlibCompressionLevel compression_level)
+struct ZlibParameters {
+    int level { Z_DEFAULT_COMPRESSION };
+    int strategy { Z_DEFAULT_STRATEGY };
+};
+
+static ZlibParameters zlib_parameters(GenericZlibCompressionLevel compression_level)
 {
-    auto zstream = new (nothrow) z_stream {};
-    if (!zstream)
-        return Error::from_errno(ENOMEM);
+    switch (compression_level) {
+    case GenericZlibCompressionLevel::VeryFast:
+        return { Z_BEST_SPEED, Z_RLE };
+    case GenericZlibCompressionLevel::Fastest:
+        return { Z_BEST_SPEED, Z_DEFAULT_STRATEGY };
+    case GenericZlibCompressionLevel::Default:
+        return { Z_DEFAULT_COMPRESSION, Z_DEFAULT_STRATEGY };
+    case GenericZlibCompressionLevel::Best:
+        return { Z_BEST_COMPRESSION, Z_DEFAULT_STRATEGY };
+    }
+    VERIFY_NOT_REACHED();
+}
 
+static ErrorOr<void> init_raw_deflate(z_stream& zstream, GenericZlibCompressionLevel compression_level)
+{
     // The fields zalloc, zfree and opaque must be initialized before by the caller.
-    zstream->zalloc = nullptr;
-    zstream->zfree = nullptr;
-    zstream->opaque = nullptr;
+    zstream.zalloc = nullptr;
+    zstream.zfree = nullptr;
+    zstream.opaque = nullptr;
 
-    int level = [&] {
-        switch (compression_level) {
-        case GenericZlibCompressionLevel::Fastest:
-            return Z_BEST_SPEED;
-        case GenericZlibCompressionLevel::Default:
-            return Z_DEFAULT_COMPRESSION;
-        case GenericZlibCompressionLevel::Best:
-            return Z_BEST_COMPRESSION;
-        default:
-            VERIFY_NOT_REACHED();
-        }
-    }();
-
-    if (auto ret = deflateInit2(zstream, level, Z_DEFLATED, window_bits, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY); ret != Z_OK)
+    auto [level, strategy] = zlib_parameters(compression_level);
+    if (auto ret = deflateInit2(&zstream, level, Z_DEFLATED, -MAX_WBITS, MAX_MEM_LEVEL, strategy); ret != Z_OK)
         return handle_zlib_error(ret);
 
+    return {};
+}
+
+ErrorOr<z_stream*> GenericZlibCompressor::new_z_stream(GenericZlibCompressionLevel compression_level)
+{
+    auto zstream = new (nothrow) z_stream {};
+    if (!zstream)
+        return Error::from_errno(ENOMEM);
+
+    if (auto result = init_raw_deflate(*zstream, compression_level); result.is_error()) {
+        delete zstream;
+        return result.release_error();
+    }
+
     return zstream;
 }
 
@@ -166,16 +193,33 @@ ErrorOr<Bytes> GenericZlibCompressor::read_some(Bytes)
 
 ErrorOr<size_t> GenericZlibCompressor::write_some(ReadonlyBytes bytes)
 {
+    TRY(write_header_if_needed());
+
+    if (bytes.size() >= parallel_compression_threshold) {
+        TRY(compress_in_parallel(bytes));
+        return bytes.size();
+    }
+
+    m_checksum = checksum(m_checksum, bytes);
+    m_uncompressed_size += bytes.size();
+
     m_zstream->avail_in = bytes.size();
     m_zstream->next_in = const_cast<u8*>(bytes.data());
+    TRY(deflate_and_write(Z_NO_FLUSH));
+
+    VERIFY(m_zstream->avail_in == 0);
+    return bytes.size();
+}
 
+ErrorOr<void> GenericZlibCompressor::deflate_and_write(int flush)
+{
     // If deflate returns with avail_out == 0, this function must be called again with the same value of the flush parameter
     // and more output space (updated avail_out), until the flush is complete (deflate returns with non-zero avail_out).
     do {
         m_zstream->avail_out = m_buffer.size();
         m_zstream->next_out = m_buffer.data();
 
-        auto ret = deflate(m_zstream, Z_NO_FLUSH);
+        auto ret = deflate(m_zstream, flush);
         if (ret != Z_OK && ret != Z_BUF_ERROR)
             return handle_zlib_error(ret);
 
@@ -183,8 +227,183 @@ ErrorOr<size_t> GenericZlibCompressor::write_some(ReadonlyBytes bytes)
         TRY(m_stream->write_until_depleted(m_buffer.span().slice(0, have)));
     } while (m_zstream->avail_out == 0);
 
-    VERIFY(m_zstream->avail_in == 0);
-    return bytes.size();
+    return {};
+}
+
+// Compresses a block of input into raw deflate data that ends on a byte boundary, without marking its last deflate block
+// as final, so that blocks which were compressed independently can be concatenated into a single stream.
+static ErrorOr<ByteBuffer> compress_block(ReadonlyBytes dictionary, ReadonlyBytes block, GenericZlibCompressionLevel compression_level)
+{
+    z_stream zstream {};
+    TRY(init_raw_deflate(zstream, compression_level));
+    ScopeGuard end_stream = [&] { deflateEnd(&zstream); };
+
+    // Priming the block with the input in front of it lets matches reach back across the block boundary, so splitting
+    // the input costs almost nothing in compression ratio.
+    if (!dictionary.is_empty()) {
+        if (auto ret = deflateSetDictionary(&zstream, dictionary.data(), dictionary.size()); ret != Z_OK)
+            return handle_zlib_error(ret);
+    }
+
+    auto output = TRY(ByteBuffer::create_uninitialized(deflateBound(&zstream, block.size())));
+    zstream.next_in = const_cast<u8*>(block.data());
+    zstream.avail_in = block.size();
+
+    size_t output_size = 0;
+    while (true) {
+        zstream.next_out = output.data() + output_size;
+        zstream.avail_out = output.size() - output_size;
+
+        // Z_SYNC_FLUSH ends the output with an empty stored block, which aligns it to a byte boundary.
+        auto ret = deflate(&zstream, Z_SYNC_FLUSH);
+        if (ret != Z_OK && ret != Z_BUF_ERROR)
+            return handle_zlib_error(ret);
+
+        output_size = output.size() - zstream.avail_out;
+        if (zstream.avail_out != 0)
+            break;
+        TRY(output.try_resize(output.size() * 2));
+    }
+
+    VERIFY(zstream.avail_in == 0);
+    output.trim(output_size, false);
+    return output;
+}
+
+// Large inputs are compressed like pigz does it: the input is split into blocks that are compressed independently on the
+// thread pool, and their outputs are concatenated in order. Afterwards, the stream continues from the end of the input
+// as if it had compressed all of it itself.
+ErrorOr<void> GenericZlibCompressor::compress_in_parallel(ReadonlyBytes bytes)
+{
+    static constexpr size_t window_size = 1 << MAX_WBITS;
+
+    // Bring what the stream has compressed so far to a byte boundary, so that the blocks can follow it.
+    if (m_zstream->total_in != 0)
+        TRY(deflate_and_write(Z_SYNC_FLUSH));
+
+    // The first block is primed with the end of the input that the stream has seen so far.
+    auto previous_window = TRY(ByteBuffer::create_uninitialized(window_size));
+    uInt previous_window_size = 0;
+    if (auto ret = deflateGetDictionary(m_zstream, previous_window.data(), &previous_window_size); ret != Z_OK)
+        return handle_zlib_error(ret);
+    previous_window.trim(previous_window_size, false);
+
+    auto block_count = ceil_div(bytes.size(), parallel_compression_block_size);
+
+    Vector<ErrorOr<ByteBuffer>> compressed_blocks;
+    TRY(compressed_blocks.try_ensure_capacity(block_count));
+    for (size_t i = 0; i < block_count; ++i)
+        compressed_blocks.unchecked_append(ByteBuffer {});
+
+    Vector<u32> block_checksums;
+    TRY(block_checksums.try_resize(block_count));
+
+    Threading::parallel_for(0, bytes.size(), parallel_compression_block_size, [&](size_t block_start, size_t block_end) {
+        auto index = block_start / parallel_compression_block_size;
+        auto block = bytes.slice(block_start, block_end - block_start);
+
+        ReadonlyBytes dictionary = previous_window.bytes();
+        if (block_start != 0) {
+            auto dictionary_start = block_start - min(block_start, window_size);
+            dictionary = bytes.slice(dictionary_start, block_start - dictionary_start);
+        }
+
+        compressed_blocks[index] = compress_block(dictionary, block, m_compression_level);
+        block_checksums[index] = checksum(m_container == Container::Zlib ? adler32(0, nullptr, 0) : crc32(0, nullptr, 0), block);
+    });
+
+    for (size_t i = 0; i < block_count; ++i) {
+        auto compressed_block = TRY(move(compressed_blocks[i]));
+        TRY(m_stream->write_until_depleted(compressed_block.bytes()));
+
+        auto block_size = min(parallel_compression_block_size, bytes.size() - (i * parallel_compression_block_size));
+        if (m_container == Container::Zlib)
+            m_checksum = adler32_combine(m_checksum, block_checksums[i], block_size);
+        else if (m_container == Container::Gzip)
+            m_checksum = crc32_combine(m_checksum, block_checksums[i], block_size);
+    }
+    m_uncompressed_size += bytes.size();
+
+    // Continue with the end of the input as the window of the stream, as if it had compressed the input itself.
+    if (auto ret = deflateReset(m_zstream); ret != Z_OK)
+        return handle_zlib_error(ret);
+
+    auto window = bytes.slice_from_end(min(bytes.size(), window_size));
+    if (auto ret = deflateSetDictionary(m_zstream, window.data(), window.size()); ret != Z_OK)
+        return handle_zlib_error(ret);
+
+    return {};
+}
+
+u32 GenericZlibCompressor::checksum(u32 checksum, ReadonlyBytes bytes) const
+{
+    switch (m_container) {
+    case Container::Raw:
+        return checksum;
+    case Container::Zlib:
+        return adler32_z(checksum, bytes.data(), bytes.size());
+    case Container::Gzip:
+        return crc32_z(checksum, bytes.data(), bytes.size());
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ErrorOr<void> GenericZlibCompressor::write_header_if_needed()
+{
+    if (m_has_written_header)
+        return {};
+    m_has_written_header = true;
+
+    auto [level, strategy] = zlib_parameters(m_compression_level);
+    if (level == Z_DEFAULT_COMPRESSION)
+        level = 6;
+
+    switch (m_container) {
+    case Container::Raw:
+        return {};
+    case Container::Zlib: {
+        // https://datatracker.ietf.org/doc/html/rfc1950#section-2.2
+        // CM = 8 (deflate), CINFO = 7 (32K window), and FLEVEL as zlib chooses it.
+        u8 compression_level = 3;
+        if (strategy >= Z_HUFFMAN_ONLY || level < 2)
+            compression_level = 0;
+        else if (level < 6)
+            compression_level = 1;
+        else if (level == 6)
+            compression_level = 2;
+
+        u16 header = (0x78 << 8) | (compression_level << 6);
+        header += 31 - (header % 31);
+        return m_stream->write_value<BigEndian<u16>>(header);
+    }
+    case Container::Gzip: {
+        // https://datatracker.ietf.org/doc/html/rfc1952#section-2.3
+        // No flags and no modification time, XFL for the fastest or best compression, and an unknown OS.
+        u8 extra_flags = 0;
+        if (level == Z_BEST_COMPRESSION)
+            extra_flags = 2;
+        else if (strategy >= Z_HUFFMAN_ONLY || level < 2)
+            extra_flags = 4;
+
+        Array<u8, 10> const header { 0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, extra_flags, 0xff };
+        return m_stream->write_until_depleted(header);
+    }
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ErrorOr<void> GenericZlibCompressor::write_trailer()
+{
+    switch (m_container) {
+    case Container::Raw:
+        return {};
+    case Container::Zlib:
+        return m_stream->write_value<BigEndian<u32>>(m_checksum);
+    case Container::Gzip:
+        TRY(m_stream->write_value<LittleEndian<u32>>(m_checksum));
+        return m_stream->write_value<LittleEndian<u32>>(m_uncompressed_size);
+    }
+    VERIFY_NOT_REACHED();
 }
 
 bool GenericZlibCompressor::is_eof() const
@@ -205,6 +424,8 @@ ErrorOr<void> GenericZlibCompressor::finish()
 {
     VERIFY(m_zstream->avail_in == 0);
 
+    TRY(write_header_if_needed());
+
     // If the parameter flush is set to Z_FINISH, pending input is processed, pending output is flushed and deflate returns with Z_STREAM_END
     // if there was enough output space. If deflate returns with Z_OK or Z_BUF_ERROR, this function must be called again with Z_FINISH
     // and more output space (updated avail_out) but no more input data, until it returns with Z_STREAM_END or an error.
@@ -218,7 +439,7 @@ ErrorOr<void> GenericZlibCompressor::finish()
             TRY(m_stream->write_until_depleted(m_buffer.span().slice(0, have)));
 
             if (ret == Z_STREAM_END)
-                return {};
+                return write_trailer();
         } else {
             return handle_zlib_error(ret);
         }
@@ -19,6 +19,9 @@ typedef struct z_stream_s z_stream;
 namespace Compress {
 
 enum class GenericZlibCompressionLevel : u8 {
+    // Only looks for runs of repeated bytes, which is a lot faster than Fastest, but compresses worse unless the input
+    // is made up of such runs, like the filtered rows of many images.
+    VeryFast,
     Fastest,
     Default,
     Best,
@@ -64,14 +67,38 @@ public:
     ErrorOr<void> finish();
 
 protected:
-    GenericZlibCompressor(AK::FixedArray<u8>, MaybeOwned<Stream>, z_stream*);
+    enum class Container : u8 {
+        Raw,
+        Zlib,
+        Gzip,
+    };
 
-    static ErrorOr<z_stream*> new_z_stream(int window_bits, GenericZlibCompressionLevel compression_level);
+    GenericZlibCompressor(AK::FixedArray<u8>, MaybeOwned<Stream>, z_stream*, Container, GenericZlibCompressionLevel);
+
+    // The stream always produces raw deflate data, the header and trailer of the container are written separately, so
+    // that parts of the input can be compressed independently of the stream.
+    static ErrorOr<z_stream*> new_z_stream(GenericZlibCompressionLevel compression_level);
 
 private:
+    // Writes of at least this size are split into blocks that are compressed in parallel.
+    static constexpr size_t parallel_compression_threshold = 1 * MiB;
+    static constexpr size_t parallel_compression_block_size = 128 * KiB;
+
+    ErrorOr<void> write_header_if_needed();
+    ErrorOr<void> write_trailer();
+    ErrorOr<void> deflate_and_write(int flush);
+    ErrorOr<void> compress_in_parallel(ReadonlyBytes);
+    u32 checksum(u32 checksum, ReadonlyBytes) const;
+
     MaybeOwned<Stream> m_stream;
     z_stream* m_zstream;
 
+    Container m_container { Container::Raw };
+    GenericZlibCompressionLevel m_compression_level { GenericZlibCompressionLevel::Default };
+    bool m_has_written_header { false };
+    u32 m_checksum { 0 };
+    u32 m_uncompressed_size { 0 };
+
     AK::FixedArray<u8> m_buffer;
 };
 
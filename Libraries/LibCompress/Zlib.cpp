@@ -26,8 +26,8 @@ ErrorOr<ByteBuffer> ZlibDecompressor::decompress_all(ReadonlyBytes bytes)
 ErrorOr<NonnullOwnPtr<ZlibCompressor>> ZlibCompressor::create(MaybeOwned<Stream> stream, GenericZlibCompressionLevel compression_level)
 {
     auto buffer = TRY(AK::FixedArray<u8>::create(16 * 1024));
-    auto zstream = TRY(GenericZlibCompressor::new_z_stream(MAX_WBITS, compression_level));
-    return adopt_nonnull_own_or_enomem(new (nothrow) ZlibCompressor(move(buffer), move(stream), zstream));
+    auto zstream = TRY(GenericZlibCompressor::new_z_stream(compression_level));
+    return adopt_nonnull_own_or_enomem(new (nothrow) ZlibCompressor(move(buffer), move(stream), zstream, compression_level));
 }
 
 ErrorOr<ByteBuffer> ZlibCompressor::compress_all(ReadonlyBytes bytes, GenericZlibCompressionLevel compression_level)
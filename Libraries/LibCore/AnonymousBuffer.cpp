@@ -26,6 +26,14 @@ ErrorOr<NonnullRefPtr<AnonymousBufferImpl>> AnonymousBufferImpl::create(int fd,
     return AK::adopt_nonnull_ref_or_enomem(new (nothrow) AnonymousBufferImpl(fd, size, data));
 }
 
+ErrorOr<NonnullRefPtr<AnonymousBufferImpl>> AnonymousBufferImpl::create_read_only(int fd, size_t size)
+{
+    auto* data = mmap(nullptr, round_up_to_power_of_two(size, PAGE_SIZE), PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED)
+        return Error::from_errno(errno);
+    return AK::adopt_nonnull_ref_or_enomem(new (nothrow) AnonymousBufferImpl(fd, size, data));
+}
+
 AnonymousBufferImpl::~AnonymousBufferImpl()
 {
     if (m_fd != -1) {
@@ -42,6 +50,12 @@ ErrorOr<AnonymousBuffer> AnonymousBuffer::create_from_anon_fd(int fd, size_t siz
     return AnonymousBuffer(move(impl));
 }
 
+ErrorOr<AnonymousBuffer> AnonymousBuffer::create_read_only_from_anon_fd(int fd, size_t size)
+{
+    auto impl = TRY(AnonymousBufferImpl::create_read_only(fd, size));
+    return AnonymousBuffer(move(impl));
+}
+
 AnonymousBufferImpl::AnonymousBufferImpl(int fd, size_t size, void* data)
     : m_fd(fd)
     , m_size(size)
@@ -19,6 +19,7 @@ class AnonymousBufferImpl final : public RefCounted<AnonymousBufferImpl> {
 public:
     static ErrorOr<NonnullRefPtr<AnonymousBufferImpl>> create(size_t);
     static ErrorOr<NonnullRefPtr<AnonymousBufferImpl>> create(int fd, size_t);
+    static ErrorOr<NonnullRefPtr<AnonymousBufferImpl>> create_read_only(int fd, size_t);
     ~AnonymousBufferImpl();
 
     int fd() const { return m_fd; }
@@ -39,6 +40,9 @@ public:
     static ErrorOr<AnonymousBuffer> create_with_size(size_t);
     static ErrorOr<AnonymousBuffer> create_from_anon_fd(int fd, size_t);
 
+    // Maps the buffer without write access, so that writing to it faults instead of changing what other processes see.
+    static ErrorOr<AnonymousBuffer> create_read_only_from_anon_fd(int fd, size_t);
+
     AnonymousBuffer() = default;
 
     bool is_valid() const { return m_impl; }
@@ -46,6 +46,15 @@ ErrorOr<NonnullRefPtr<AnonymousBufferImpl>> AnonymousBufferImpl::create(int fd,
     return adopt_ref(*new AnonymousBufferImpl(fd, size, ptr));
 }
 
+ErrorOr<NonnullRefPtr<AnonymousBufferImpl>> AnonymousBufferImpl::create_read_only(int fd, size_t size)
+{
+    void* ptr = MapViewOfFile(to_handle(fd), FILE_MAP_READ, 0, 0, size);
+    if (!ptr)
+        return Error::from_windows_error();
+
+    return adopt_ref(*new AnonymousBufferImpl(fd, size, ptr));
+}
+
 ErrorOr<AnonymousBuffer> AnonymousBuffer::create_with_size(size_t size)
 {
     auto impl = TRY(AnonymousBufferImpl::create(size));
@@ -58,4 +67,10 @@ ErrorOr<AnonymousBuffer> AnonymousBuffer::create_from_anon_fd(int fd, size_t siz
     return AnonymousBuffer(move(impl));
 }
 
+ErrorOr<AnonymousBuffer> AnonymousBuffer::create_read_only_from_anon_fd(int fd, size_t size)
+{
+    auto impl = TRY(AnonymousBufferImpl::create_read_only(fd, size));
+    return AnonymousBuffer(move(impl));
+}
+
 }
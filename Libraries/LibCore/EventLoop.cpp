@@ -132,6 +132,16 @@ void EventLoop::unregister_timer(intptr_t timer_id)
     EventLoopManager::the().unregister_timer(timer_id);
 }
 
+void EventLoop::set_timer_slack(AK::Duration slack)
+{
+    EventLoopManager::the().set_timer_slack(slack);
+}
+
+EventLoopTimerStatistics EventLoop::timer_statistics()
+{
+    return EventLoopManager::the().timer_statistics();
+}
+
 void EventLoop::register_notifier(Badge<Notifier>, Notifier& notifier)
 {
     EventLoopManager::the().register_notifier(notifier);
@@ -84,6 +84,9 @@ public:
     static intptr_t register_timer(EventReceiver&, int milliseconds, bool should_reload);
     static void unregister_timer(intptr_t timer_id);
 
+    static void set_timer_slack(AK::Duration);
+    static EventLoopTimerStatistics timer_statistics();
+
     static void register_notifier(Badge<Notifier>, Notifier&);
     static void unregister_notifier(Badge<Notifier>, Notifier&);
 
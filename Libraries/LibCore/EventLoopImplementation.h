@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Function.h>
+#include <AK/Time.h>
 #include <LibCore/Forward.h>
 
 namespace Core {
@@ -14,6 +15,14 @@ namespace Core {
 class EventLoopImplementation;
 class ThreadEventQueue;
 
+struct EventLoopTimerStatistics {
+    // The number of timers that are currently scheduled on this thread.
+    size_t timer_count { 0 };
+    // How often the thread woke up from waiting for events, and how many timers fired in total.
+    u64 wakeup_count { 0 };
+    u64 fired_timer_count { 0 };
+};
+
 class EventLoopManager {
 public:
     static EventLoopManager& the();
@@ -26,6 +35,11 @@ public:
     virtual intptr_t register_timer(EventReceiver&, int milliseconds, bool should_reload) = 0;
     virtual void unregister_timer(intptr_t timer_id) = 0;
 
+    // Allows timers of the current thread to fire up to this much later than requested, so that timers that expire
+    // close to each other fire together.
+    virtual void set_timer_slack(AK::Duration) { }
+    virtual EventLoopTimerStatistics timer_statistics() const { return {}; }
+
     virtual void register_notifier(Notifier&) = 0;
     virtual void unregister_notifier(Notifier&) = 0;
 
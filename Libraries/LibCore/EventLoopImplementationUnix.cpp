@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/BinaryHeap.h>
 #include <AK/Singleton.h>
 #include <AK/TemporaryChange.h>
@@ -20,6 +21,13 @@
 #include <sys/select.h>
 #include <unistd.h>
 
+// On Linux, notifiers are watched with epoll, so that the cost of waiting for events doesn't grow with the number of
+// notifiers that are registered. Everywhere else, we rebuild the list of file descriptors to poll() instead.
+#if defined(AK_OS_LINUX) && !defined(AK_OS_ANDROID)
+#    define EVENT_LOOP_USES_EPOLL
+#    include <sys/epoll.h>
+#endif
+
 namespace Core {
 
 namespace {
@@ -34,6 +42,7 @@ static pthread_rwlock_t* s_thread_data_lock = nullptr;
 thread_local pthread_t s_thread_id;
 thread_local OwnPtr<ThreadData> s_this_thread_data;
 
+#if !defined(EVENT_LOOP_USES_EPOLL)
 short notification_type_to_poll_events(NotificationType type)
 {
     short events = 0;
@@ -43,12 +52,39 @@ short notification_type_to_poll_events(NotificationType type)
         events |= POLLOUT;
     return events;
 }
+#endif
 
 bool has_flag(int value, int flag)
 {
     return (value & flag) == flag;
 }
 
+#if defined(EVENT_LOOP_USES_EPOLL)
+u32 notification_type_to_epoll_events(NotificationType type)
+{
+    u32 events = 0;
+    if (has_flag(type, NotificationType::Read))
+        events |= EPOLLIN;
+    if (has_flag(type, NotificationType::Write))
+        events |= EPOLLOUT;
+    return events;
+}
+
+NotificationType epoll_events_to_notification_type(u32 events)
+{
+    NotificationType type = NotificationType::None;
+    if (has_flag(events, EPOLLIN))
+        type |= NotificationType::Read;
+    if (has_flag(events, EPOLLOUT))
+        type |= NotificationType::Write;
+    if (has_flag(events, EPOLLHUP))
+        type |= NotificationType::Read | NotificationType::HangUp;
+    if (has_flag(events, EPOLLERR))
+        type |= NotificationType::Error;
+    return type;
+}
+#endif
+
 class EventLoopTimeout {
 public:
     static constexpr ssize_t INVALID_INDEX = NumericLimits<ssize_t>::max();
@@ -152,6 +188,8 @@ public:
         timeout->set_index({}, EventLoopTimeout::INVALID_INDEX);
     }
 
+    size_t size() const { return m_heap.size() + m_scheduled_timeouts.size(); }
+
     void clear()
     {
         for (auto* timeout : m_heap.nodes_in_arbitrary_order())
@@ -267,24 +305,106 @@ struct ThreadData {
 
         wake_pipe_fds = result.release_value();
 
+#if defined(EVENT_LOOP_USES_EPOLL)
+        epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd < 0) {
+            perror("epoll_create1");
+            VERIFY_NOT_REACHED();
+        }
+
+        // The wake pipe informs us of POSIX signals as well as manual calls to wake()
+        epoll_event event { .events = EPOLLIN, .data = { .fd = wake_pipe_fds[0] } };
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_pipe_fds[0], &event) < 0) {
+            perror("epoll_ctl");
+            VERIFY_NOT_REACHED();
+        }
+#else
         // The wake pipe informs us of POSIX signals as well as manual calls to wake()
         poll_fds.append({ .fd = wake_pipe_fds[0], .events = POLLIN, .revents = 0 });
         notifiers.append(nullptr);
+#endif
     }
 
     ~ThreadData()
     {
+#if defined(EVENT_LOOP_USES_EPOLL)
+        close(epoll_fd);
+#endif
+
         pthread_rwlock_wrlock(&*s_thread_data_lock);
         s_thread_data.remove(s_thread_id);
         pthread_rwlock_unlock(&*s_thread_data_lock);
     }
 
+#if defined(EVENT_LOOP_USES_EPOLL)
+    // Brings the epoll interest list in line with the notifiers that are registered for the given file descriptor.
+    void update_epoll_interest(int fd)
+    {
+        auto it = epoll_interests.find(fd);
+        VERIFY(it != epoll_interests.end());
+        auto& interest = it->value;
+
+        if (interest.notifiers.is_empty()) {
+            // NOTE: If the file descriptor has been closed already, the kernel has dropped it from the interest list
+            //       by itself, and this fails. That's fine.
+            if (interest.is_in_epoll_set)
+                (void)epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            always_ready_fds.remove(fd);
+            epoll_interests.remove(it);
+            return;
+        }
+
+        if (always_ready_fds.contains(fd))
+            return;
+
+        u32 events = 0;
+        for (auto* notifier : interest.notifiers)
+            events |= notification_type_to_epoll_events(notifier->type());
+
+        epoll_event event { .events = events, .data = { .fd = fd } };
+        if (interest.is_in_epoll_set) {
+            if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event) == 0)
+                return;
+
+            // NOTE: The file descriptor may have been closed and reused since we added it, in which case the kernel has
+            //       dropped it from the interest list, and we have to add it again.
+            if (errno != ENOENT)
+                return;
+        }
+
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0) {
+            interest.is_in_epoll_set = true;
+            return;
+        }
+
+        // NOTE: epoll refuses regular files and directories, which poll() always reports as ready.
+        //       We keep treating them that way.
+        if (errno == EPERM)
+            always_ready_fds.set(fd);
+    }
+#endif
+
     // Each thread has its own timers, notifiers and a wake pipe.
     TimeoutSet timeouts;
+    AK::Duration timer_slack;
+    u64 wakeup_count { 0 };
+    u64 fired_timer_count { 0 };
+
+#if defined(EVENT_LOOP_USES_EPOLL)
+    // NOTE: A file descriptor can only be in the epoll interest list once, but may have several notifiers.
+    struct EpollInterest {
+        Vector<Notifier*, 1> notifiers;
+        bool is_in_epoll_set { false };
+    };
 
+    int epoll_fd { -1 };
+    HashMap<int, EpollInterest> epoll_interests;
+    HashTable<int> always_ready_fds;
+#else
     HashMap<Notifier*, size_t> notifier_to_index;
     Vector<Notifier*, 32> notifiers;
     Vector<pollfd, 32> poll_fds;
+#endif
 
     // The wake pipe is used to notify another event loop that someone has called wake(), or a signal has been received.
     // wake() writes 0i32 into the pipe, signals write the signal number (guaranteed non-zero).
@@ -326,8 +446,8 @@ void EventLoopImplementationUnix::quit(int code)
 
 void EventLoopImplementationUnix::post_event(EventReceiver& receiver, NonnullOwnPtr<Event>&& event)
 {
-    m_thread_event_queue.post_event(receiver, move(event));
-    if (&m_thread_event_queue != &ThreadEventQueue::current())
+    auto should_wake = m_thread_event_queue.post_event(receiver, move(event));
+    if (should_wake == ThreadEventQueue::ShouldWake::Yes && &m_thread_event_queue != &ThreadEventQueue::current())
         wake();
 }
 
@@ -354,6 +474,13 @@ retry:
     if (mode == EventLoopImplementation::PumpMode::WaitForEvents && !has_pending_events) {
         auto next_timer_expiration = thread_data.timeouts.next_timer_expiration();
         if (next_timer_expiration.has_value()) {
+            // Wake up at the next multiple of the timer slack instead, which all timers that expire until then share.
+            if (auto slack = thread_data.timer_slack.to_nanoseconds(); slack > 0) {
+                auto remainder = next_timer_expiration->nanoseconds() % slack;
+                if (remainder != 0)
+                    *next_timer_expiration += AK::Duration::from_nanoseconds(slack - remainder);
+            }
+
             auto computed_timeout = next_timer_expiration.value() - time_at_iteration_start;
             if (computed_timeout.is_negative())
                 computed_timeout = AK::Duration::zero();
@@ -364,10 +491,40 @@ retry:
         }
     }
 
+#if defined(EVENT_LOOP_USES_EPOLL)
+    // Files that epoll can't watch are always ready, so there is no waiting while we have any.
+    if (!thread_data.always_ready_fds.is_empty()) {
+        timeout = 0;
+        should_wait_forever = false;
+    }
+
+    Array<epoll_event, 64> epoll_events;
+    int marked_fd_count = 0;
+
+try_select_again:
+    // Wait for file system events, calls to wake(), POSIX signals, or timer expirations.
+    marked_fd_count = epoll_wait(thread_data.epoll_fd, epoll_events.data(), static_cast<int>(epoll_events.size()), should_wait_forever ? -1 : timeout);
+    auto time_after_poll = MonotonicTime::now_coarse();
+    ++thread_data.wakeup_count;
+    // Because POSIX, we might spuriously return from epoll_wait() with EINTR; just wait again.
+    if (marked_fd_count < 0) {
+        if (errno == EINTR)
+            goto try_select_again;
+        perror("EventLoopImplementationUnix::wait_for_events: epoll_wait");
+        VERIFY_NOT_REACHED();
+    }
+
+    // NOTE: Any events past the ones that fit into our buffer are level-triggered, so we get them on the next iteration.
+    auto marked_fds = epoll_events.span().trim(static_cast<size_t>(marked_fd_count));
+    bool wake_pipe_is_readable = any_of(marked_fds, [&](auto const& event) {
+        return event.data.fd == thread_data.wake_pipe_fds[0] && has_flag(event.events, EPOLLIN);
+    });
+#else
 try_select_again:
     // select() and wait for file system events, calls to wake(), POSIX signals, or timer expirations.
     auto error_or_marked_fd_count = System::poll(thread_data.poll_fds, should_wait_forever ? -1 : timeout);
     auto time_after_poll = MonotonicTime::now_coarse();
+    ++thread_data.wakeup_count;
     // Because POSIX, we might spuriously return from select() with EINTR; just select again.
     if (error_or_marked_fd_count.is_error()) {
         if (error_or_marked_fd_count.error().code() == EINTR)
@@ -376,9 +533,12 @@ try_select_again:
         VERIFY_NOT_REACHED();
     }
 
+    bool wake_pipe_is_readable = has_flag(thread_data.poll_fds[0].revents, POLLIN);
+#endif
+
     // We woke up due to a call to wake() or a POSIX signal.
     // Handle signals and see whether we need to handle events as well.
-    if (has_flag(thread_data.poll_fds[0].revents, POLLIN)) {
+    if (wake_pipe_is_readable) {
         int wake_events[8];
         ssize_t nread;
         // We might receive another signal while read()ing here. The signal will go to the handle_signal properly,
@@ -407,6 +567,28 @@ try_select_again:
             goto retry;
     }
 
+#if defined(EVENT_LOOP_USES_EPOLL)
+    // Handle file system notifiers by making them normal events.
+    auto post_activation_events = [](Vector<Notifier*, 1> const& notifiers, NotificationType type) {
+        for (auto* notifier : notifiers) {
+            auto notifier_type = type & notifier->type();
+            if (notifier_type != NotificationType::None)
+                ThreadEventQueue::current().post_event(*notifier, make<NotifierActivationEvent>(notifier->fd(), notifier_type));
+        }
+    };
+
+    for (auto const& event : marked_fds) {
+        if (event.data.fd == thread_data.wake_pipe_fds[0])
+            continue;
+        if (auto interest = thread_data.epoll_interests.get(event.data.fd); interest.has_value())
+            post_activation_events(interest->notifiers, epoll_events_to_notification_type(event.events));
+    }
+
+    for (auto fd : thread_data.always_ready_fds) {
+        if (auto interest = thread_data.epoll_interests.get(fd); interest.has_value())
+            post_activation_events(interest->notifiers, NotificationType::Read | NotificationType::Write);
+    }
+#else
     if (error_or_marked_fd_count.value() != 0) {
         // Handle file system notifiers by making them normal events.
         for (size_t i = 1; i < thread_data.poll_fds.size(); ++i) {
@@ -435,9 +617,10 @@ try_select_again:
 #endif
         }
     }
+#endif
 
     // Handle expired timers.
-    thread_data.timeouts.fire_expired(time_after_poll);
+    thread_data.fired_timer_count += thread_data.timeouts.fire_expired(time_after_poll);
 }
 
 class SignalHandlers : public RefCounted<SignalHandlers> {
@@ -649,15 +832,35 @@ void EventLoopManagerUnix::unregister_timer(intptr_t timer_id)
     }
 }
 
+void EventLoopManagerUnix::set_timer_slack(AK::Duration slack)
+{
+    ThreadData::the().timer_slack = slack;
+}
+
+EventLoopTimerStatistics EventLoopManagerUnix::timer_statistics() const
+{
+    auto& thread_data = ThreadData::the();
+    return {
+        .timer_count = thread_data.timeouts.size(),
+        .wakeup_count = thread_data.wakeup_count,
+        .fired_timer_count = thread_data.fired_timer_count,
+    };
+}
+
 void EventLoopManagerUnix::register_notifier(Notifier& notifier)
 {
     auto& thread_data = ThreadData::the();
 
+#if defined(EVENT_LOOP_USES_EPOLL)
+    thread_data.epoll_interests.ensure(notifier.fd()).notifiers.append(&notifier);
+    thread_data.update_epoll_interest(notifier.fd());
+#else
     thread_data.notifier_to_index.set(&notifier, thread_data.poll_fds.size());
     thread_data.notifiers.append(&notifier);
 
     auto events = notification_type_to_poll_events(notifier.type());
     thread_data.poll_fds.append({ .fd = notifier.fd(), .events = events, .revents = 0 });
+#endif
 
     notifier.set_owner_thread(s_thread_id);
 }
@@ -668,6 +871,11 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
     if (!thread_data)
         return;
 
+#if defined(EVENT_LOOP_USES_EPOLL)
+    auto& interest = thread_data->epoll_interests.find(notifier.fd())->value;
+    interest.notifiers.remove_first_matching([&](auto* registered_notifier) { return registered_notifier == &notifier; });
+    thread_data->update_epoll_interest(notifier.fd());
+#else
     auto notifier_index = thread_data->notifier_to_index.take(&notifier).release_value();
 
     if (notifier_index + 1 < thread_data->poll_fds.size()) {
@@ -680,6 +888,7 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
 
     thread_data->notifiers.take_last();
     thread_data->poll_fds.take_last();
+#endif
 }
 
 void EventLoopManagerUnix::did_post_event()
@@ -20,6 +20,9 @@ public:
     virtual intptr_t register_timer(EventReceiver&, int milliseconds, bool should_reload) override;
     virtual void unregister_timer(intptr_t timer_id) override;
 
+    virtual void set_timer_slack(AK::Duration) override;
+    virtual EventLoopTimerStatistics timer_statistics() const override;
+
     virtual void register_notifier(Notifier&) override;
     virtual void unregister_notifier(Notifier&) override;
 
@@ -153,8 +153,8 @@ void EventLoopImplementationWindows::quit(int code)
 
 void EventLoopImplementationWindows::post_event(EventReceiver& receiver, NonnullOwnPtr<Event>&& event)
 {
-    m_thread_event_queue.post_event(receiver, move(event));
-    if (&m_thread_event_queue != &ThreadEventQueue::current())
+    auto should_wake = m_thread_event_queue.post_event(receiver, move(event));
+    if (should_wake == ThreadEventQueue::ShouldWake::Yes && &m_thread_event_queue != &ThreadEventQueue::current())
         wake();
 }
 
@@ -32,7 +32,16 @@ ErrorOr<NonnullRefPtr<Resource>> ResourceImplementationFile::load_from_resource_
     if (S_ISDIR(st.st_mode))
         return make_directory_resource(move(path), st.st_mtime);
 
-    return make_resource(path, TRY(MappedFile::map(full_path)), st.st_mtime);
+    Threading::MutexLocker locker(m_mapped_resources_mutex);
+
+    if (auto it = m_mapped_resources.find(full_path); it != m_mapped_resources.end()) {
+        if (it->value.modified_time == st.st_mtime && it->value.size == st.st_size)
+            return it->value.resource;
+    }
+
+    auto resource = make_resource(path, TRY(MappedFile::map(full_path)), st.st_mtime);
+    m_mapped_resources.set(move(full_path), { .resource = resource, .modified_time = st.st_mtime, .size = st.st_size });
+    return resource;
 }
 
 Vector<String> ResourceImplementationFile::child_names_for_resource_scheme(Resource const& resource)
@@ -6,10 +6,12 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <AK/RefPtr.h>
 #include <AK/StringView.h>
 #include <LibCore/Resource.h>
 #include <LibCore/ResourceImplementation.h>
+#include <LibThreading/Mutex.h>
 
 namespace Core {
 
@@ -23,6 +25,17 @@ public:
 
 private:
     String m_base_directory;
+
+    // Files are mapped once per process and then handed out again for as long as they don't change on disk. The
+    // mappings are read-only and shared, so their pages are only read in once touched, and they live in the page
+    // cache that every process mapping the same file shares.
+    struct MappedResource {
+        NonnullRefPtr<Resource> resource;
+        time_t modified_time { 0 };
+        off_t size { 0 };
+    };
+    Threading::Mutex m_mapped_resources_mutex;
+    HashMap<String, MappedResource> m_mapped_resources;
 };
 
 }
@@ -880,6 +880,10 @@ ErrorOr<size_t> transfer_file_through_pipe(int source_fd, int target_fd, size_t
 #else
     static auto page_size = PAGE_SIZE;
 
+    // NOTE: A pipe accepts a limited amount of data at once, so we don't map more of the file than we can hope to write.
+    static constexpr size_t maximum_transfer_size = 256 * KiB;
+    source_length = min(source_length, maximum_transfer_size);
+
     // mmap requires the offset to be page-aligned, so we must handle that here.
     auto aligned_source_offset = (source_offset / page_size) * page_size;
     auto offset_adjustment = source_offset - aligned_source_offset;
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/Vector.h>
 #include <LibCore/DeferredInvocationContext.h>
 #include <LibCore/EventLoopImplementation.h>
@@ -19,7 +20,7 @@ namespace Core {
 struct ThreadEventQueue::Private {
     struct QueuedEvent {
         AK_MAKE_NONCOPYABLE(QueuedEvent);
-        AK_MAKE_DEFAULT_MOVABLE(QueuedEvent);
+        AK_MAKE_NONMOVABLE(QueuedEvent);
 
     public:
         QueuedEvent(EventReceiver& receiver, NonnullOwnPtr<Event> event)
@@ -32,10 +33,15 @@ struct ThreadEventQueue::Private {
 
         WeakPtr<EventReceiver> receiver;
         NonnullOwnPtr<Event> event;
+        QueuedEvent* next { nullptr };
     };
 
+    // Events are posted from any thread, but only processed by the thread that owns the queue. Posting threads push
+    // onto this list without taking a lock, and the owning thread takes the whole list at once. As the list is built
+    // by pushing to its front, it holds the events in reverse order.
+    Atomic<QueuedEvent*> newest_queued_event { nullptr };
+
     Threading::Mutex mutex;
-    Vector<QueuedEvent> queued_events;
     Vector<NonnullRefPtr<Promise<NonnullRefPtr<EventReceiver>>>, 16> pending_promises;
     bool warned_promise_count { false };
 };
@@ -65,15 +71,29 @@ ThreadEventQueue::ThreadEventQueue()
 {
 }
 
-ThreadEventQueue::~ThreadEventQueue() = default;
+ThreadEventQueue::~ThreadEventQueue()
+{
+    auto* queued_event = m_private->newest_queued_event.exchange(nullptr, AK::MemoryOrder::memory_order_acquire);
+    while (queued_event)
+        delete exchange(queued_event, queued_event->next);
+}
 
-void ThreadEventQueue::post_event(Core::EventReceiver& receiver, NonnullOwnPtr<Core::Event> event)
+ThreadEventQueue::ShouldWake ThreadEventQueue::post_event(Core::EventReceiver& receiver, NonnullOwnPtr<Core::Event> event)
 {
-    {
-        Threading::MutexLocker lock(m_private->mutex);
-        m_private->queued_events.empend(receiver, move(event));
-    }
+    auto* queued_event = new Private::QueuedEvent(receiver, move(event));
+
+    auto* newest_queued_event = m_private->newest_queued_event.load(AK::MemoryOrder::memory_order_relaxed);
+    do {
+        queued_event->next = newest_queued_event;
+    } while (!m_private->newest_queued_event.compare_exchange_strong(newest_queued_event, queued_event, AK::MemoryOrder::memory_order_release));
+
+    // NOTE: If the queue wasn't empty, whoever posted to the empty queue has already woken the owning thread up, and
+    //       that thread will see our event when it processes the queue. A burst of posts thus only wakes it up once.
+    if (newest_queued_event)
+        return ShouldWake::No;
+
     Core::EventLoopManager::the().did_post_event();
+    return ShouldWake::Yes;
 }
 
 void ThreadEventQueue::add_job(NonnullRefPtr<Promise<NonnullRefPtr<EventReceiver>>> promise)
@@ -93,18 +113,26 @@ void ThreadEventQueue::cancel_all_pending_jobs()
 
 size_t ThreadEventQueue::process()
 {
-    decltype(m_private->queued_events) events;
     {
         Threading::MutexLocker locker(m_private->mutex);
-        events = move(m_private->queued_events);
         m_private->pending_promises.remove_all_matching([](auto& job) { return job->is_resolved() || job->is_rejected(); });
     }
 
+    // Take all events posted so far, and put them back into the order in which they were posted.
+    Private::QueuedEvent* oldest_queued_event = nullptr;
+    auto* queued_event = m_private->newest_queued_event.exchange(nullptr, AK::MemoryOrder::memory_order_acquire);
+    while (queued_event) {
+        auto* next_queued_event = queued_event->next;
+        queued_event->next = oldest_queued_event;
+        oldest_queued_event = queued_event;
+        queued_event = next_queued_event;
+    }
+
     size_t processed_events = 0;
-    for (size_t i = 0; i < events.size(); ++i) {
-        auto& queued_event = events.at(i);
-        auto receiver = queued_event.receiver.strong_ref();
-        auto& event = *queued_event.event;
+    while (oldest_queued_event) {
+        auto owned_queued_event = adopt_own(*exchange(oldest_queued_event, oldest_queued_event->next));
+        auto receiver = owned_queued_event->receiver.strong_ref();
+        auto& event = *owned_queued_event->event;
 
         if (!receiver) {
             switch (event.type()) {
@@ -135,8 +163,7 @@ size_t ThreadEventQueue::process()
 
 bool ThreadEventQueue::has_pending_events() const
 {
-    Threading::MutexLocker locker(m_private->mutex);
-    return !m_private->queued_events.is_empty();
+    return m_private->newest_queued_event.load(AK::MemoryOrder::memory_order_relaxed) != nullptr;
 }
 
 }
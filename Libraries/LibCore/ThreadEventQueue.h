@@ -24,8 +24,14 @@ public:
     // Process all queued events. Returns the number of events that were processed.
     size_t process();
 
-    // Posts an event to the event queue.
-    void post_event(EventReceiver& receiver, NonnullOwnPtr<Event>);
+    enum class ShouldWake {
+        No,
+        Yes,
+    };
+
+    // Posts an event to the event queue. This never blocks, and may be called from any thread. Returns whether the
+    // owning thread has to be woken up, which is only the case for the first event posted to an empty queue.
+    ShouldWake post_event(EventReceiver& receiver, NonnullOwnPtr<Event>);
 
     // Used by Threading::BackgroundAction.
     void add_job(NonnullRefPtr<Promise<NonnullRefPtr<EventReceiver>>>);
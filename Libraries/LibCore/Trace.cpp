@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/LexicalPath.h>
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
+#include <LibCore/Environment.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibCore/Trace.h>
+#include <LibThreading/Mutex.h>
+
+namespace Core {
+
+static constexpr size_t events_per_buffer = 4096;
+static constexpr i64 maximum_buffered_event_age_in_microseconds = 1'000'000;
+
+static i64 to_trace_timestamp(MonotonicTime time)
+{
+    return time.nanoseconds() / 1000;
+}
+
+struct TraceEvent {
+    enum class Type : u8 {
+        Span,
+        Counter,
+        FlowStart,
+        FlowEnd,
+        ThreadName,
+    };
+
+    Type type { Type::Span };
+    StringView name;
+    i64 timestamp { 0 };
+
+    // The duration of spans in microseconds, the value of counters, or the id of flows.
+    i64 value { 0 };
+
+    JsonObject arguments;
+};
+
+// The file that the trace of the current process is written to, shared by the buffers of all of its threads.
+class ProcessTrace {
+    AK_MAKE_NONCOPYABLE(ProcessTrace);
+    AK_MAKE_NONMOVABLE(ProcessTrace);
+
+public:
+    static ProcessTrace* the();
+
+    pid_t pid() const { return m_pid; }
+    u32 allocate_thread_id() { return m_next_thread_id.fetch_add(1, AK::MemoryOrder::memory_order_relaxed); }
+
+    void write_events(StringView serialized_events);
+
+private:
+    ProcessTrace(NonnullOwnPtr<File>, pid_t);
+
+    Threading::Mutex m_mutex;
+    NonnullOwnPtr<File> m_file;
+    bool m_has_written_events { false };
+
+    pid_t m_pid { 0 };
+    Atomic<u32> m_next_thread_id { 1 };
+};
+
+ProcessTrace* ProcessTrace::the()
+{
+    static OwnPtr<ProcessTrace> s_the = []() -> OwnPtr<ProcessTrace> {
+        if (!Trace::path().has_value())
+            return nullptr;
+
+        auto pid = System::getpid();
+
+        auto file_or_error = File::open(Trace::path_for_process(pid), File::OpenMode::Write | File::OpenMode::Truncate);
+        if (file_or_error.is_error()) {
+            dbgln("Unable to open trace file: {}", file_or_error.error());
+            return nullptr;
+        }
+
+        return adopt_own(*new ProcessTrace(file_or_error.release_value(), pid));
+    }();
+    return s_the.ptr();
+}
+
+ProcessTrace::ProcessTrace(NonnullOwnPtr<File> file, pid_t pid)
+    : m_file(move(file))
+    , m_pid(pid)
+{
+    JsonObject arguments;
+    if (auto executable_path = System::current_executable_path(); !executable_path.is_error())
+        arguments.set("name"sv, LexicalPath::basename(executable_path.value()));
+
+    JsonObject event;
+    event.set("name"sv, "process_name"sv);
+    event.set("ph"sv, "M"sv);
+    event.set("pid"sv, m_pid);
+    event.set("args"sv, move(arguments));
+
+    // NOTE: The trace event format allows leaving out the closing bracket, so the file stays valid if we get killed.
+    if (auto result = m_file->write_formatted("[\n{}", event.serialized()); result.is_error())
+        dbgln("Unable to write to trace file: {}", result.error());
+    m_has_written_events = true;
+}
+
+void ProcessTrace::write_events(StringView serialized_events)
+{
+    Threading::MutexLocker const locker { m_mutex };
+
+    auto result = m_file->write_formatted("{}{}", m_has_written_events ? ",\n"sv : ""sv, serialized_events);
+    if (result.is_error())
+        dbgln("Unable to write to trace file: {}", result.error());
+    m_has_written_events = true;
+}
+
+// The events of one thread that have not been written out yet.
+class ThreadTraceBuffer {
+    AK_MAKE_NONCOPYABLE(ThreadTraceBuffer);
+    AK_MAKE_NONMOVABLE(ThreadTraceBuffer);
+
+public:
+    explicit ThreadTraceBuffer(ProcessTrace& process_trace)
+        : m_process_trace(process_trace)
+        , m_thread_id(process_trace.allocate_thread_id())
+    {
+        m_events.ensure_capacity(events_per_buffer);
+    }
+
+    ~ThreadTraceBuffer()
+    {
+        flush();
+    }
+
+    void append(TraceEvent event)
+    {
+        m_events.unchecked_append(move(event));
+
+        if (m_events.size() == events_per_buffer || m_events.last().timestamp - m_events.first().timestamp > maximum_buffered_event_age_in_microseconds)
+            flush();
+    }
+
+    void flush();
+
+private:
+    void serialize_event(StringBuilder&, TraceEvent&) const;
+
+    ProcessTrace& m_process_trace;
+    u32 m_thread_id { 0 };
+    Vector<TraceEvent> m_events;
+};
+
+void ThreadTraceBuffer::serialize_event(StringBuilder& builder, TraceEvent& event) const
+{
+    JsonObject object;
+    object.set("pid"sv, m_process_trace.pid());
+    object.set("tid"sv, m_thread_id);
+    object.set("ts"sv, event.timestamp);
+
+    switch (event.type) {
+    case TraceEvent::Type::Span:
+        object.set("name"sv, event.name);
+        object.set("ph"sv, "X"sv);
+        object.set("dur"sv, event.value);
+        break;
+    case TraceEvent::Type::Counter:
+        object.set("name"sv, event.name);
+        object.set("ph"sv, "C"sv);
+        event.arguments.set("value"sv, event.value);
+        break;
+    case TraceEvent::Type::FlowStart:
+    case TraceEvent::Type::FlowEnd:
+        object.set("name"sv, event.name);
+        object.set("cat"sv, "flow"sv);
+        object.set("ph"sv, event.type == TraceEvent::Type::FlowStart ? "s"sv : "f"sv);
+        object.set("id"sv, ByteString::formatted("{:#x}", static_cast<u64>(event.value)));
+        // Bind the end of the flow to the span that encloses it, rather than to the next span that starts after it.
+        if (event.type == TraceEvent::Type::FlowEnd)
+            object.set("bp"sv, "e"sv);
+        break;
+    case TraceEvent::Type::ThreadName:
+        object.set("name"sv, "thread_name"sv);
+        object.set("ph"sv, "M"sv);
+        break;
+    }
+
+    if (!event.arguments.is_empty())
+        object.set("args"sv, move(event.arguments));
+
+    object.serialize(builder);
+}
+
+void ThreadTraceBuffer::flush()
+{
+    if (m_events.is_empty())
+        return;
+
+    StringBuilder builder;
+    for (size_t i = 0; i < m_events.size(); ++i) {
+        if (i != 0)
+            builder.append(",\n"sv);
+        serialize_event(builder, m_events[i]);
+    }
+    m_events.clear_with_capacity();
+
+    m_process_trace.write_events(builder.string_view());
+}
+
+static thread_local OwnPtr<ThreadTraceBuffer> s_thread_buffer;
+
+static ThreadTraceBuffer* thread_buffer()
+{
+    if (!s_thread_buffer) {
+        auto* process_trace = ProcessTrace::the();
+        if (!process_trace)
+            return nullptr;
+        s_thread_buffer = make<ThreadTraceBuffer>(*process_trace);
+    }
+    return s_thread_buffer.ptr();
+}
+
+Optional<ByteString> const& Trace::path()
+{
+    static Optional<ByteString> s_path = []() -> Optional<ByteString> {
+        auto path = Environment::get("LADYBIRD_TRACE"sv);
+        if (!path.has_value() || path->is_empty())
+            return {};
+        return ByteString { *path };
+    }();
+    return s_path;
+}
+
+ByteString Trace::path_for_process(pid_t pid)
+{
+    VERIFY(path().has_value());
+    return ByteString::formatted("{}.{}", *path(), pid);
+}
+
+bool Trace::is_enabled()
+{
+    return ProcessTrace::the() != nullptr;
+}
+
+void Trace::add_span(StringView name, MonotonicTime start, MonotonicTime end, JsonObject arguments)
+{
+    if (auto* buffer = thread_buffer()) {
+        auto start_timestamp = to_trace_timestamp(start);
+        buffer->append({ TraceEvent::Type::Span, name, start_timestamp, to_trace_timestamp(end) - start_timestamp, move(arguments) });
+    }
+}
+
+void Trace::add_counter(StringView name, i64 value)
+{
+    if (auto* buffer = thread_buffer())
+        buffer->append({ TraceEvent::Type::Counter, name, to_trace_timestamp(MonotonicTime::now()), value, {} });
+}
+
+void Trace::add_flow_start(StringView name, u64 id)
+{
+    if (auto* buffer = thread_buffer())
+        buffer->append({ TraceEvent::Type::FlowStart, name, to_trace_timestamp(MonotonicTime::now()), static_cast<i64>(id), {} });
+}
+
+void Trace::add_flow_end(StringView name, u64 id)
+{
+    if (auto* buffer = thread_buffer())
+        buffer->append({ TraceEvent::Type::FlowEnd, name, to_trace_timestamp(MonotonicTime::now()), static_cast<i64>(id), {} });
+}
+
+void Trace::set_thread_name(StringView thread_name)
+{
+    if (auto* buffer = thread_buffer()) {
+        JsonObject arguments;
+        arguments.set("name"sv, thread_name);
+        buffer->append({ TraceEvent::Type::ThreadName, {}, 0, 0, move(arguments) });
+    }
+}
+
+void Trace::flush()
+{
+    if (s_thread_buffer)
+        s_thread_buffer->flush();
+}
+
+ErrorOr<void> Trace::merge_process_traces(ReadonlySpan<pid_t> pids)
+{
+    VERIFY(path().has_value());
+
+    auto merged_file = TRY(File::open(*path(), File::OpenMode::Write | File::OpenMode::Truncate));
+    TRY(merged_file->write_until_depleted("[\n"sv));
+
+    bool has_written_events = false;
+
+    for (auto pid : pids) {
+        auto process_path = path_for_process(pid);
+
+        auto file_or_error = File::open(process_path, File::OpenMode::Read);
+        if (file_or_error.is_error())
+            continue;
+
+        auto contents = TRY(file_or_error.value()->read_until_eof());
+
+        // Each file holds a JSON array of events, which may be missing its closing bracket.
+        auto events = StringView { contents }.trim_whitespace();
+        if (events.starts_with('['))
+            events = events.substring_view(1);
+        if (events.ends_with(']'))
+            events = events.substring_view(0, events.length() - 1);
+        events = events.trim_whitespace();
+
+        if (!events.is_empty()) {
+            TRY(merged_file->write_formatted("{}{}", has_written_events ? ",\n"sv : ""sv, events));
+            has_written_events = true;
+        }
+
+        TRY(System::unlink(process_path));
+    }
+
+    TRY(merged_file->write_until_depleted("\n]\n"sv));
+    return {};
+}
+
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/JsonObject.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/Span.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+
+namespace Core {
+
+// Records trace events in the Chrome trace event format, so that they can be loaded into Perfetto or chrome://tracing.
+// It is only active when LADYBIRD_TRACE is set to a file path. Every process writes its events to that path with its id
+// appended, and the browser merges the files of all of its processes into one at that path when it exits.
+//
+// Events are appended to a buffer of the current thread without taking any locks. A buffer is only written out once it
+// is full, once its oldest event is more than a second old, or when its thread exits. All timestamps come from the
+// monotonic clock, which is shared by all processes, so the events of different processes line up in the merged trace.
+//
+// NOTE: Event names are not copied, so they have to outlive the process, like string literals do.
+class Trace {
+public:
+    static bool is_enabled();
+
+    // The path that the trace of the whole browser is written to, if tracing is enabled.
+    static Optional<ByteString> const& path();
+    static ByteString path_for_process(pid_t);
+
+    static void add_span(StringView name, MonotonicTime start, MonotonicTime end, JsonObject arguments = {});
+    static void add_counter(StringView name, i64 value);
+
+    // Flows draw an arrow from the span that encloses their start to the span that encloses their end, which may be in
+    // another thread or process. The id has to be unique across all processes.
+    static void add_flow_start(StringView name, u64 id);
+    static void add_flow_end(StringView name, u64 id);
+
+    static void set_thread_name(StringView);
+
+    // Writes out the buffered events of the current thread.
+    static void flush();
+
+    // Merges the traces of the given processes into the trace at path(), and removes them.
+    static ErrorOr<void> merge_process_traces(ReadonlySpan<pid_t>);
+};
+
+// Adds a span covering its lifetime to the trace, if it is enabled.
+class TraceScope {
+    AK_MAKE_NONCOPYABLE(TraceScope);
+    AK_MAKE_NONMOVABLE(TraceScope);
+
+public:
+    explicit TraceScope(StringView name)
+        : m_name(name)
+    {
+        if (Trace::is_enabled())
+            m_start = MonotonicTime::now();
+    }
+
+    ~TraceScope()
+    {
+        if (m_start.has_value())
+            Trace::add_span(m_name, *m_start, MonotonicTime::now(), move(m_arguments));
+    }
+
+    bool is_enabled() const { return m_start.has_value(); }
+    JsonObject& arguments() { return m_arguments; }
+
+private:
+    StringView m_name;
+    Optional<MonotonicTime> m_start;
+    JsonObject m_arguments;
+};
+
+}
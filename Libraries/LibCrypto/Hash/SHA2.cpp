@@ -4,10 +4,17 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/Endian.h>
+#include <AK/OwnPtr.h>
+#include <AK/SIMD.h>
 #include <LibCrypto/Hash/SHA2.h>
 
 #include <openssl/evp.h>
 
+// See the comment in AK/SIMDMath.h for why this is needed.
+#pragma GCC diagnostic ignored "-Wpsabi"
+
 namespace Crypto::Hash {
 
 SHA256::SHA256(EVP_MD_CTX* context)
@@ -25,4 +32,195 @@ SHA512::SHA512(EVP_MD_CTX* context)
 {
 }
 
+using AK::SIMD::u32x8;
+
+// The multi-buffer path computes eight SHA-256 digests at once, with each lane of a vector holding the state of one
+// input. Large inputs are better served by OpenSSL, which uses the dedicated SHA instructions where available.
+static constexpr size_t multi_buffer_lane_count = 8;
+static constexpr size_t multi_buffer_max_input_size = 1 * KiB;
+
+static constexpr u32 sha256_round_constants[64] {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static constexpr u32 sha256_initial_state[8] {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+template<u32 bits>
+ALWAYS_INLINE static u32x8 rotate_right(u32x8 value)
+{
+    return (value >> bits) | (value << (32 - bits));
+}
+
+// One input assigned to a lane, along with the padded copy of its final one or two blocks.
+struct MultiBufferLane {
+    ReadonlyBytes input;
+    size_t block_count { 0 };
+    size_t full_block_count { 0 };
+    Array<u8, 128> padded_tail {};
+
+    void set_input(ReadonlyBytes new_input)
+    {
+        input = new_input;
+        full_block_count = input.size() / 64;
+        // The message is followed by a 0x80 byte and its length in bits as a 64-bit big-endian integer.
+        block_count = (input.size() + 1 + 8 + 63) / 64;
+
+        padded_tail.fill(0);
+        auto remainder = input.slice(full_block_count * 64);
+        remainder.copy_to(padded_tail);
+        padded_tail[remainder.size()] = 0x80;
+
+        auto tail_size = (block_count - full_block_count) * 64;
+        u64 bit_length = static_cast<u64>(input.size()) * 8;
+        for (size_t i = 0; i < 8; ++i)
+            padded_tail[tail_size - 1 - i] = static_cast<u8>(bit_length >> (i * 8));
+    }
+
+    u8 const* block(size_t index) const
+    {
+        if (index < full_block_count)
+            return input.data() + index * 64;
+        return padded_tail.data() + (index - full_block_count) * 64;
+    }
+};
+
+static void compress_blocks(ReadonlySpan<MultiBufferLane> lanes, Span<SHA256::DigestType> digests)
+{
+    // NOTE: Plain arrays are used for the state and message schedule, to avoid bounds checks in the rounds.
+    u32x8 state[8];
+    for (size_t i = 0; i < 8; ++i)
+        state[i] = u32x8 {} + sha256_initial_state[i];
+
+    size_t max_block_count = 0;
+    for (auto const& lane : lanes)
+        max_block_count = max(max_block_count, lane.block_count);
+
+    // Lanes that have already finished, or that have no input, keep hashing a block of zeroes which is discarded below.
+    static constexpr u8 zero_block[64] {};
+
+    u32x8 schedule[64];
+    for (size_t block = 0; block < max_block_count; ++block) {
+        u8 const* blocks[multi_buffer_lane_count];
+        u32x8 active_mask {};
+        for (size_t lane = 0; lane < multi_buffer_lane_count; ++lane) {
+            if (lane < lanes.size() && block < lanes[lane].block_count) {
+                blocks[lane] = lanes[lane].block(block);
+                active_mask[lane] = NumericLimits<u32>::max();
+            } else {
+                blocks[lane] = zero_block;
+            }
+        }
+
+        for (size_t word = 0; word < 16; ++word) {
+            u32x8 value;
+            for (size_t lane = 0; lane < multi_buffer_lane_count; ++lane) {
+                u32 big_endian_word;
+                __builtin_memcpy(&big_endian_word, blocks[lane] + word * 4, sizeof(big_endian_word));
+                value[lane] = AK::convert_between_host_and_big_endian(big_endian_word);
+            }
+            schedule[word] = value;
+        }
+
+        for (size_t t = 16; t < 64; ++t) {
+            auto s0 = rotate_right<7>(schedule[t - 15]) ^ rotate_right<18>(schedule[t - 15]) ^ (schedule[t - 15] >> 3);
+            auto s1 = rotate_right<17>(schedule[t - 2]) ^ rotate_right<19>(schedule[t - 2]) ^ (schedule[t - 2] >> 10);
+            schedule[t] = schedule[t - 16] + s0 + schedule[t - 7] + s1;
+        }
+
+        auto a = state[0], b = state[1], c = state[2], d = state[3];
+        auto e = state[4], f = state[5], g = state[6], h = state[7];
+        for (size_t t = 0; t < 64; ++t) {
+            auto s1 = rotate_right<6>(e) ^ rotate_right<11>(e) ^ rotate_right<25>(e);
+            auto choice = (e & f) ^ (~e & g);
+            auto temp1 = h + s1 + choice + sha256_round_constants[t] + schedule[t];
+            auto s0 = rotate_right<2>(a) ^ rotate_right<13>(a) ^ rotate_right<22>(a);
+            auto majority = (a & b) ^ (a & c) ^ (b & c);
+            auto temp2 = s0 + majority;
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+
+        state[0] += a & active_mask;
+        state[1] += b & active_mask;
+        state[2] += c & active_mask;
+        state[3] += d & active_mask;
+        state[4] += e & active_mask;
+        state[5] += f & active_mask;
+        state[6] += g & active_mask;
+        state[7] += h & active_mask;
+    }
+
+    for (size_t lane = 0; lane < lanes.size(); ++lane) {
+        auto& digest = digests[lane];
+        for (size_t i = 0; i < 8; ++i) {
+            u32 big_endian_word = AK::convert_between_host_and_big_endian(static_cast<u32>(state[i][lane]));
+            __builtin_memcpy(digest.data + i * 4, &big_endian_word, sizeof(big_endian_word));
+        }
+    }
+}
+
+Vector<SHA256::DigestType> SHA256::hash_many(ReadonlySpan<ReadonlyBytes> inputs)
+{
+    Vector<DigestType> digests;
+    digests.resize(inputs.size());
+
+    // Lanes that finish early do wasted work until the longest input of their group is done, so small inputs are grouped
+    // by their number of blocks. Large inputs are hashed one at a time, reusing a single context.
+    static constexpr size_t max_block_count = (multi_buffer_max_input_size + 1 + 8 + 63) / 64;
+    Array<Vector<size_t>, max_block_count + 1> inputs_by_block_count;
+    OwnPtr<SHA256> hasher;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (inputs[i].size() <= multi_buffer_max_input_size) {
+            inputs_by_block_count[(inputs[i].size() + 1 + 8 + 63) / 64].append(i);
+            continue;
+        }
+        if (!hasher)
+            hasher = create();
+        hasher->update(inputs[i]);
+        digests[i] = hasher->digest();
+    }
+
+    Array<MultiBufferLane, multi_buffer_lane_count> lanes;
+    Array<DigestType, multi_buffer_lane_count> lane_digests;
+    size_t lane_count = 0;
+    Array<size_t, multi_buffer_lane_count> lane_inputs;
+
+    auto flush_lanes = [&] {
+        compress_blocks(lanes.span().trim(lane_count), lane_digests.span());
+        for (size_t lane = 0; lane < lane_count; ++lane)
+            digests[lane_inputs[lane]] = lane_digests[lane];
+        lane_count = 0;
+    };
+
+    // Groups may straddle two block counts, which costs at most one partially wasted group per block count.
+    for (auto const& indices : inputs_by_block_count) {
+        for (auto index : indices) {
+            lanes[lane_count].set_input(inputs[index]);
+            lane_inputs[lane_count] = index;
+            if (++lane_count == multi_buffer_lane_count)
+                flush_lanes();
+        }
+    }
+    if (lane_count > 0)
+        flush_lanes();
+
+    return digests;
+}
+
 }
@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <AK/AllOf.h>
+#include <AK/AnyOf.h>
+#include <AK/Atomic.h>
 #include <AK/AtomicRefCounted.h>
 #include <AK/CountingStream.h>
 #include <AK/HashTable.h>
@@ -61,6 +64,9 @@ class Resolver;
 class LookupResult : public AtomicRefCounted<LookupResult>
     , public Weakable<LookupResult> {
 public:
+    // Expired records are kept around for this long, so that they can be served while the name is looked up again.
+    static constexpr auto STALE_RECORD_LIFETIME = AK::Duration::from_seconds(10 * 60);
+
     explicit LookupResult(Messages::DomainName name)
         : m_name(move(name))
     {
@@ -89,9 +95,13 @@ public:
             return;
 
         auto now = AK::UnixDateTime::now();
+
+        // NOTE: Records that have been validated with DNSSEC are not served once they expire.
+        auto stale_record_lifetime = m_dnssec_validated ? AK::Duration::zero() : STALE_RECORD_LIFETIME;
+
         for (size_t i = 0; i < m_cached_records.size();) {
             auto& record = m_cached_records[i];
-            if (record.expiration.has_value() && record.expiration.value() < now) {
+            if (record.expiration.has_value() && record.expiration.value() + stale_record_lifetime < now) {
                 dbgln_if(DNS_DEBUG, "DNS: Removing expired record for {}", m_name.to_string());
                 m_cached_records.remove(i);
             } else {
@@ -101,10 +111,36 @@ public:
             }
         }
 
-        if (m_cached_records.is_empty() && m_request_done)
+        if (m_negative_expiration.has_value() && m_negative_expiration.value() < now)
+            m_negative_expiration.clear();
+
+        if (m_cached_records.is_empty() && !m_negative_expiration.has_value() && m_request_done)
             m_valid = false;
     }
 
+    bool is_stale() const
+    {
+        auto now = AK::UnixDateTime::now();
+        return any_of(m_cached_records, [&](auto const& record) {
+            return record.expiration.has_value() && record.expiration.value() < now;
+        });
+    }
+
+    // A negative result remembers that the name has no records of the types that were asked for.
+    // https://www.rfc-editor.org/rfc/rfc2308#section-5
+    void set_negative_ttl(u32 ttl)
+    {
+        m_valid = true;
+        m_negative_expiration = AK::UnixDateTime::now() + AK::Duration::from_seconds(ttl);
+    }
+
+    bool is_negative_for(Span<Messages::ResourceType const> types) const
+    {
+        if (!m_negative_expiration.has_value() || !m_cached_records.is_empty())
+            return false;
+        return all_of(types, [&](auto type) { return m_desired_types.contains(type); });
+    }
+
     void add_record(Messages::ResourceRecord record)
     {
         m_valid = true;
@@ -197,6 +233,7 @@ private:
     };
 
     Vector<RecordWithExpiration> m_cached_records;
+    Optional<AK::UnixDateTime> m_negative_expiration;
     HashTable<Messages::ResourceType> m_desired_types;
     Vector<Messages::Records::DNSKEY> m_used_dnskeys {};
     HashTable<u16> m_seen_key_tags;
@@ -232,6 +269,14 @@ public:
         ConnectionMode mode;
     };
 
+    struct CacheStatistics {
+        u64 hits { 0 };
+        u64 stale_hits { 0 };
+        u64 negative_hits { 0 };
+        u64 misses { 0 };
+        size_t entry_count { 0 };
+    };
+
     Resolver(Function<ErrorOr<SocketResult>()> create_socket)
         : m_pending_lookups(make<RedBlackTree<u16, PendingLookup>>())
         , m_create_socket(move(create_socket))
@@ -299,6 +344,9 @@ public:
                 return {};
 
             auto& result = *it->value;
+            if (result.is_negative_for(desired_types))
+                return result;
+
             for (auto const& type : desired_types) {
                 if (!result.has_record_of_type(type))
                     return {};
@@ -308,6 +356,17 @@ public:
         });
     }
 
+    CacheStatistics cache_statistics() const
+    {
+        return {
+            .hits = m_cache_hits.load(),
+            .stale_hits = m_stale_cache_hits.load(),
+            .negative_hits = m_negative_cache_hits.load(),
+            .misses = m_cache_misses.load(),
+            .entry_count = m_cache.with_read_locked([](auto const& cache) { return cache.size(); }),
+        };
+    }
+
     NonnullRefPtr<Core::Promise<NonnullRefPtr<LookupResult const>>> lookup(ByteString name, Messages::Class class_, Vector<Vector<Messages::ResourceType>> desired_types, LookupOptions options = LookupOptions::default_())
     {
         using ResultPromise = Core::Promise<NonnullRefPtr<LookupResult const>>;
@@ -386,12 +445,31 @@ public:
             dbgln_if(DNS_DEBUG, "DNS: Resolving {} from cache...", name);
             if (!options.validate_dnssec_locally || result->is_dnssec_validated()) {
                 dbgln_if(DNS_DEBUG, "DNS: Resolved {} from cache", name);
+
+                if (result->is_negative_for(desired_types)) {
+                    ++m_negative_cache_hits;
+                } else if (result->is_stale()) {
+                    ++m_stale_cache_hits;
+                    refresh_stale_result(name, class_, desired_types, *result);
+                } else {
+                    ++m_cache_hits;
+                }
+
                 promise->resolve(result.release_nonnull());
                 return promise;
             }
             dbgln_if(DNS_DEBUG, "DNS: Cache entry for {} is not DNSSEC validated (and we expect that), re-resolving", name);
         }
 
+        if (!options.validate_dnssec_locally) {
+            if (auto result = lookup_in_stale_results(name, desired_types)) {
+                dbgln_if(DNS_DEBUG, "DNS: Resolved {} from stale cache entry while it is being refreshed", name);
+                ++m_stale_cache_hits;
+                promise->resolve(result.release_nonnull());
+                return promise;
+            }
+        }
+
         auto domain_name = Messages::DomainName::from_string(name);
 
         if (!has_connection()) {
@@ -456,6 +534,8 @@ public:
             }
 
             dbgln_if(DNS_DEBUG, "DNS: Adding {} to cache", name);
+            ++m_cache_misses;
+
             auto ptr = make_ref_counted<LookupResult>(domain_name);
             if (!ptr->is_dnssec_validated())
                 ptr->set_dnssec_validated(options.validate_dnssec_locally);
@@ -481,6 +561,11 @@ public:
             // Something has gone wrong if there are no pending lookups but the result isn't done.
             // Continue on and hope that we eventually resolve or timeout in that case.
             if (result->is_done()) {
+                if (result->is_negative_for(desired_types))
+                    ++m_negative_cache_hits;
+                else
+                    ++m_cache_hits;
+
                 promise->resolve(*result);
                 return promise;
             }
@@ -675,6 +760,11 @@ private:
                 for (auto& record : message.answers)
                     result->add_record(move(record));
 
+                if (result->is_empty()) {
+                    if (auto ttl = negative_caching_ttl(message); ttl.has_value())
+                        result->set_negative_ttl(*ttl);
+                }
+
                 result->finished_request();
                 lookup->promise->resolve(*result);
                 lookups->remove(message.header.id);
@@ -685,6 +775,79 @@ private:
         }
     }
 
+    // https://www.rfc-editor.org/rfc/rfc2308#section-5
+    static Optional<u32> negative_caching_ttl(Messages::Message const& message)
+    {
+        static constexpr u32 MAXIMUM_NEGATIVE_CACHING_TTL = 15 * 60;
+
+        auto response_code = message.header.options.response_code();
+        if (response_code != Messages::Options::ResponseCode::NoError && response_code != Messages::Options::ResponseCode::NameError)
+            return {};
+
+        // "Negative responses without SOA records SHOULD NOT be cached as there is no way to prevent the negative
+        //  responses looping forever between a pair of servers even with a short TTL."
+        for (auto const& record : message.authorities) {
+            if (record.type != Messages::ResourceType::SOA)
+                continue;
+
+            // "The TTL of this record is set from the minimum of the MINIMUM field of the SOA record and the TTL of the
+            //  SOA itself, and indicates how long a resolver may cache the negative answer."
+            auto const& soa = record.record.get<Messages::Records::SOA>();
+            return min(min(record.ttl, soa.minimum), MAXIMUM_NEGATIVE_CACHING_TTL);
+        }
+
+        return {};
+    }
+
+    // Looks the name up again while the stale result keeps being served to everyone asking for it in the meantime.
+    void refresh_stale_result(ByteString const& name, Messages::Class class_, Vector<Messages::ResourceType> const& desired_types, LookupResult const& stale_result)
+    {
+        if (!has_connection(false))
+            return;
+
+        auto result = m_cache.with_write_locked([&](auto& cache) -> RefPtr<LookupResult> {
+            auto it = cache.find(name);
+            if (it == cache.end() || it->value.ptr() != &stale_result)
+                return {};
+
+            auto result = it->value;
+            cache.remove(it);
+            return result;
+        });
+        if (!result)
+            return;
+
+        dbgln_if(DNS_DEBUG, "DNS: Refreshing stale cache entry for {}", name);
+        m_stale_results.with_write_locked([&](auto& stale_results) { stale_results.set(name, result.release_nonnull()); });
+
+        lookup(name, class_, desired_types)
+            ->when_resolved([this, name](auto const&) {
+                m_stale_results.with_write_locked([&](auto& stale_results) { stale_results.remove(name); });
+            })
+            .when_rejected([this, name](auto const&) {
+                m_stale_results.with_write_locked([&](auto& stale_results) { stale_results.remove(name); });
+            });
+    }
+
+    RefPtr<LookupResult const> lookup_in_stale_results(StringView name, Span<Messages::ResourceType const> desired_types)
+    {
+        return m_stale_results.with_write_locked([&](auto& stale_results) -> RefPtr<LookupResult const> {
+            auto it = stale_results.find(name);
+            if (it == stale_results.end())
+                return {};
+
+            auto& result = *it->value;
+            result.check_expiration();
+
+            for (auto const& type : desired_types) {
+                if (!result.has_record_of_type(type))
+                    return {};
+            }
+
+            return result;
+        });
+    }
+
     using RRSet = Vector<Messages::ResourceRecord>;
     struct CanonicalizedRRSetWithRRSIG {
         RRSet rrset;
@@ -1202,6 +1365,14 @@ private:
     }
 
     Threading::RWLockProtected<HashMap<ByteString, NonnullRefPtr<LookupResult>>> m_cache;
+
+    // Expired results that are still being served while they are being looked up again.
+    Threading::RWLockProtected<HashMap<ByteString, NonnullRefPtr<LookupResult>>> m_stale_results;
+
+    Atomic<u64> m_cache_hits { 0 };
+    Atomic<u64> m_stale_cache_hits { 0 };
+    Atomic<u64> m_negative_cache_hits { 0 };
+    Atomic<u64> m_cache_misses { 0 };
     Threading::RWLockProtected<NonnullOwnPtr<RedBlackTree<u16, PendingLookup>>> m_pending_lookups;
     Threading::RWLockProtected<Optional<MaybeOwned<Core::Socket>>> m_socket;
     Function<ErrorOr<SocketResult>()> m_create_socket;
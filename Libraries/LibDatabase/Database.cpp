@@ -4,11 +4,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteBuffer.h>
 #include <AK/ByteString.h>
+#include <AK/Queue.h>
 #include <AK/String.h>
 #include <AK/Time.h>
 #include <LibCore/Directory.h>
 #include <LibDatabase/Database.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
 
 #include <sqlite3.h>
 
@@ -40,6 +45,7 @@ static constexpr StringView sql_error(int error_code)
 
 #define ENUMERATE_SQL_TYPES              \
     __ENUMERATE_TYPE(String)             \
+    __ENUMERATE_TYPE(ByteBuffer)         \
     __ENUMERATE_TYPE(UnixDateTime)       \
     __ENUMERATE_TYPE(i8)                 \
     __ENUMERATE_TYPE(i16)                \
@@ -53,7 +59,17 @@ static constexpr StringView sql_error(int error_code)
     __ENUMERATE_TYPE(unsigned long long) \
     __ENUMERATE_TYPE(bool)
 
-ErrorOr<NonnullRefPtr<Database>> Database::create(ByteString const& directory, StringView name)
+struct Database::StatementQueue {
+    Threading::Mutex mutex;
+    Threading::ConditionVariable condition { mutex };
+    Queue<Function<void()>> statements;
+    bool is_executing { false };
+    bool should_stop { false };
+
+    RefPtr<Threading::Thread> thread;
+};
+
+ErrorOr<NonnullRefPtr<Database>> Database::create(ByteString const& directory, StringView name, ExecutionMode execution_mode)
 {
     TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes));
     auto database_file = ByteString::formatted("{}/{}.db", directory, name);
@@ -61,17 +77,70 @@ ErrorOr<NonnullRefPtr<Database>> Database::create(ByteString const& directory, S
     sqlite3* m_database { nullptr };
     SQL_TRY(sqlite3_open(database_file.characters(), &m_database));
 
-    return adopt_nonnull_ref_or_enomem(new (nothrow) Database(m_database));
+    // With a write-ahead log, committing a transaction only appends to the log, and readers don't block writers. Together
+    // with synchronous=NORMAL, the log is only synced to disk when it is checkpointed into the database. A committed
+    // transaction may then be lost on power loss, but the database can't become corrupt.
+    SQL_TRY(sqlite3_exec(m_database, "PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL;", nullptr, nullptr, nullptr));
+
+    auto database = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) Database(m_database, execution_mode)));
+    database->m_begin_transaction_statement = TRY(database->prepare_statement("BEGIN TRANSACTION;"sv));
+    database->m_commit_transaction_statement = TRY(database->prepare_statement("COMMIT;"sv));
+
+    if (execution_mode == ExecutionMode::Asynchronous) {
+        auto& queue = *database->m_statement_queue;
+
+        queue.thread = Threading::Thread::construct([&queue]() -> intptr_t {
+            while (true) {
+                queue.mutex.lock();
+                while (queue.statements.is_empty() && !queue.should_stop)
+                    queue.condition.wait();
+
+                if (queue.statements.is_empty()) {
+                    queue.mutex.unlock();
+                    return 0;
+                }
+
+                auto statement = queue.statements.dequeue();
+                queue.is_executing = true;
+                queue.mutex.unlock();
+
+                statement();
+
+                queue.mutex.lock();
+                queue.is_executing = false;
+                queue.condition.broadcast();
+                queue.mutex.unlock();
+            }
+        },
+            "Database"sv);
+        queue.thread->start();
+    }
+
+    return database;
 }
 
-Database::Database(sqlite3* database)
+Database::Database(sqlite3* database, ExecutionMode execution_mode)
     : m_database(database)
+    , m_execution_mode(execution_mode)
 {
     VERIFY(m_database);
+
+    if (m_execution_mode == ExecutionMode::Asynchronous)
+        m_statement_queue = make<StatementQueue>();
 }
 
 Database::~Database()
 {
+    if (m_statement_queue && m_statement_queue->thread) {
+        m_statement_queue->mutex.lock();
+        m_statement_queue->should_stop = true;
+        m_statement_queue->condition.broadcast();
+        m_statement_queue->mutex.unlock();
+
+        // The thread executes all statements that are still queued before it exits.
+        (void)m_statement_queue->thread->join();
+    }
+
     for (auto* prepared_statement : m_prepared_statements)
         sqlite3_finalize(prepared_statement);
 
@@ -80,16 +149,73 @@ Database::~Database()
 
 ErrorOr<StatementID> Database::prepare_statement(StringView statement)
 {
+    ByteString statement_text { statement };
+    if (auto statement_id = m_statement_ids.get(statement_text); statement_id.has_value())
+        return *statement_id;
+
+    // Queued statements may create the tables that this statement refers to, and SQLite connections must not be used by
+    // multiple threads at once.
+    wait_for_queued_statements();
+
     sqlite3_stmt* prepared_statement { nullptr };
     SQL_TRY(sqlite3_prepare_v2(m_database, statement.characters_without_null_termination(), static_cast<int>(statement.length()), &prepared_statement, nullptr));
 
     auto statement_id = m_prepared_statements.size();
     m_prepared_statements.append(prepared_statement);
+    m_statement_ids.set(move(statement_text), statement_id);
 
     return statement_id;
 }
 
 void Database::execute_statement(StatementID statement_id, OnResult on_result)
+{
+    if (!on_result && m_execution_mode == ExecutionMode::Asynchronous) {
+        enqueue_statement([this, statement_id]() {
+            execute_prepared_statement(statement_id, {});
+        });
+        return;
+    }
+
+    wait_for_queued_statements();
+    execute_prepared_statement(statement_id, on_result);
+}
+
+void Database::begin_transaction()
+{
+    if (m_transaction_depth++ == 0)
+        execute_statement(m_begin_transaction_statement, {});
+}
+
+void Database::commit_transaction()
+{
+    VERIFY(m_transaction_depth > 0);
+
+    if (--m_transaction_depth == 0)
+        execute_statement(m_commit_transaction_statement, {});
+}
+
+void Database::enqueue_statement(Function<void()> statement)
+{
+    VERIFY(m_statement_queue);
+
+    m_statement_queue->mutex.lock();
+    m_statement_queue->statements.enqueue(move(statement));
+    m_statement_queue->condition.broadcast();
+    m_statement_queue->mutex.unlock();
+}
+
+void Database::wait_for_queued_statements()
+{
+    if (!m_statement_queue)
+        return;
+
+    m_statement_queue->mutex.lock();
+    while (!m_statement_queue->statements.is_empty() || m_statement_queue->is_executing)
+        m_statement_queue->condition.wait();
+    m_statement_queue->mutex.unlock();
+}
+
+void Database::execute_prepared_statement(StatementID statement_id, OnResult const& on_result)
 {
     auto* statement = prepared_statement(statement_id);
 
@@ -121,6 +247,12 @@ void Database::apply_placeholder(StatementID statement_id, int index, ValueType
     if constexpr (IsSame<ValueType, String>) {
         StringView string { value };
         SQL_MUST(sqlite3_bind_text(statement, index, string.characters_without_null_termination(), static_cast<int>(string.length()), SQLITE_TRANSIENT));
+    } else if constexpr (IsSame<ValueType, ByteBuffer>) {
+        // SQLite would bind a null pointer as NULL rather than as an empty blob.
+        if (value.is_empty())
+            SQL_MUST(sqlite3_bind_zeroblob(statement, index, 0));
+        else
+            SQL_MUST(sqlite3_bind_blob(statement, index, value.data(), static_cast<int>(value.size()), SQLITE_TRANSIENT));
     } else if constexpr (IsSame<ValueType, UnixDateTime>) {
         apply_placeholder(statement_id, index, value.offset_to_epoch().to_milliseconds());
     } else if constexpr (IsIntegral<ValueType>) {
@@ -146,6 +278,10 @@ ValueType Database::result_column(StatementID statement_id, int column)
     if constexpr (IsSame<ValueType, String>) {
         auto const* text = reinterpret_cast<char const*>(sqlite3_column_text(statement, column));
         return MUST(String::from_utf8(StringView { text, strlen(text) }));
+    } else if constexpr (IsSame<ValueType, ByteBuffer>) {
+        auto const* data = static_cast<u8 const*>(sqlite3_column_blob(statement, column));
+        auto size = static_cast<size_t>(sqlite3_column_bytes(statement, column));
+        return MUST(ByteBuffer::copy(ReadonlyBytes { data, size }));
     } else if constexpr (IsSame<ValueType, UnixDateTime>) {
         auto milliseconds = result_column<sqlite3_int64>(statement_id, column);
         return UnixDateTime::from_milliseconds_since_epoch(milliseconds);
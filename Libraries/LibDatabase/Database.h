@@ -7,9 +7,12 @@
 
 #pragma once
 
+#include <AK/ByteString.h>
 #include <AK/Error.h>
 #include <AK/Function.h>
+#include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/StringView.h>
 #include <AK/Vector.h>
@@ -20,30 +23,68 @@ struct sqlite3_stmt;
 
 namespace Database {
 
+enum class ExecutionMode {
+    // Every statement is executed on the calling thread.
+    Synchronous,
+
+    // Statements without a result callback are queued, and executed in order on a thread of the database's own, so that
+    // the calling thread doesn't block on disk. Statements with a result callback, and the preparation of statements,
+    // first wait for all queued statements to be executed.
+    Asynchronous,
+};
+
 class DATABASE_API Database : public RefCounted<Database> {
 public:
-    static ErrorOr<NonnullRefPtr<Database>> create(ByteString const& directory, StringView name);
+    static ErrorOr<NonnullRefPtr<Database>> create(ByteString const& directory, StringView name, ExecutionMode = ExecutionMode::Synchronous);
     ~Database();
 
     using OnResult = Function<void(StatementID)>;
 
+    // Statements are cached by their text, so preparing the same statement again returns the same ID.
     ErrorOr<StatementID> prepare_statement(StringView statement);
     void execute_statement(StatementID, OnResult on_result);
 
     template<typename... PlaceholderValues>
     void execute_statement(StatementID statement_id, OnResult on_result, PlaceholderValues&&... placeholder_values)
     {
+        if (!on_result && m_execution_mode == ExecutionMode::Asynchronous) {
+            // The placeholder values are only bound once the statement is executed, as an earlier execution of the same
+            // statement may still be queued.
+            enqueue_statement([this, statement_id, ... placeholder_values = RemoveCVReference<PlaceholderValues>(forward<PlaceholderValues>(placeholder_values))]() {
+                int index = 1;
+                (apply_placeholder(statement_id, index++, placeholder_values), ...);
+
+                execute_prepared_statement(statement_id, {});
+            });
+            return;
+        }
+
+        wait_for_queued_statements();
+
         int index = 1;
         (apply_placeholder(statement_id, index++, forward<PlaceholderValues>(placeholder_values)), ...);
 
-        execute_statement(statement_id, move(on_result));
+        execute_prepared_statement(statement_id, move(on_result));
     }
 
     template<typename ValueType>
     ValueType result_column(StatementID, int column);
 
+    // Groups all statements executed until the matching commit_transaction() into a single transaction, which is much
+    // cheaper than committing each of them on its own. Transactions may be nested, only the outermost one is committed.
+    void begin_transaction();
+    void commit_transaction();
+
+    // Blocks until all statements that were queued in the asynchronous execution mode have been executed.
+    void wait_for_queued_statements();
+
 private:
-    explicit Database(sqlite3*);
+    struct StatementQueue;
+
+    Database(sqlite3*, ExecutionMode);
+
+    void execute_prepared_statement(StatementID, OnResult const& on_result);
+    void enqueue_statement(Function<void()>);
 
     template<typename ValueType>
     void apply_placeholder(StatementID statement_id, int index, ValueType const& value);
@@ -56,6 +97,14 @@ private:
 
     sqlite3* m_database { nullptr };
     Vector<sqlite3_stmt*> m_prepared_statements;
+    HashMap<ByteString, StatementID> m_statement_ids;
+
+    ExecutionMode m_execution_mode { ExecutionMode::Synchronous };
+    OwnPtr<StatementQueue> m_statement_queue;
+
+    StatementID m_begin_transaction_statement { 0 };
+    StatementID m_commit_transaction_statement { 0 };
+    size_t m_transaction_depth { 0 };
 };
 
 }
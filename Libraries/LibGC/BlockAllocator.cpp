@@ -34,18 +34,23 @@ BlockAllocator::~BlockAllocator()
 {
     for (auto* block : m_blocks) {
         ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
+        unmap_block(block);
+    }
+}
+
+void BlockAllocator::unmap_block(void* block)
+{
 #if !defined(AK_OS_WINDOWS)
-        if (munmap(block, HeapBlock::block_size) < 0) {
-            perror("munmap");
-            VERIFY_NOT_REACHED();
-        }
+    if (munmap(block, HeapBlock::block_size) < 0) {
+        perror("munmap");
+        VERIFY_NOT_REACHED();
+    }
 #else
-        if (!VirtualFree(block, 0, MEM_RELEASE)) {
-            warnln("{}", Error::from_windows_error());
-            VERIFY_NOT_REACHED();
-        }
-#endif
+    if (!VirtualFree(block, 0, MEM_RELEASE)) {
+        warnln("{}", Error::from_windows_error());
+        VERIFY_NOT_REACHED();
     }
+#endif
 }
 
 void* BlockAllocator::allocate_block([[maybe_unused]] char const* name)
@@ -74,6 +79,14 @@ void BlockAllocator::deallocate_block(void* block)
 {
     VERIFY(block);
 
+    // After a heavy phase, a single allocator can end up with a lot of empty blocks. Keeping all of them cached would
+    // pin their address space and page tables forever, so we only hold on to a bounded number.
+    if (m_blocks.size() >= max_cached_blocks) {
+        LSAN_UNREGISTER_ROOT_REGION(block, HeapBlock::block_size);
+        unmap_block(block);
+        return;
+    }
+
 #if defined(AK_OS_WINDOWS)
     DWORD ret = DiscardVirtualMemory(block, HeapBlock::block_size);
     if (ret != ERROR_SUCCESS) {
@@ -19,7 +19,14 @@ public:
     void* allocate_block(char const* name);
     void deallocate_block(void*);
 
+    size_t cached_block_count() const { return m_blocks.size(); }
+
 private:
+    // Freed blocks beyond this many are unmapped instead of being kept around for reuse.
+    static constexpr size_t max_cached_blocks = 64;
+
+    static void unmap_block(void*);
+
     Vector<void*> m_blocks;
 };
 
@@ -47,6 +47,10 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
+    // Cells start out young and become old once they survive their first garbage collection.
+    bool is_young() const { return m_young; }
+    void set_young(bool b) { m_young = b; }
+
     enum class State : bool {
         Live,
         Dead,
@@ -190,6 +194,7 @@ protected:
 private:
     bool m_mark { false };
     bool m_overrides_must_survive_garbage_collection { false };
+    bool m_young { true };
     State m_state { State::Live };
 } SWIFT_UNSAFE_REFERENCE;
 
@@ -12,6 +12,7 @@
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
 #include <AK/StackInfo.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/ElapsedTimer.h>
@@ -23,6 +24,7 @@
 #include <LibGC/Weak.h>
 #include <LibGC/WeakInlines.h>
 #include <setjmp.h>
+#include <string.h>
 
 #ifdef HAS_ADDRESS_SANITIZER
 #    include <sanitizer/asan_interface.h>
@@ -62,30 +64,31 @@ void Heap::will_allocate(size_t size)
     m_allocated_bytes_since_last_gc += size;
 }
 
-static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
+static ALWAYS_INLINE FlatPtr possible_pointer_from_data(FlatPtr data)
 {
     if constexpr (sizeof(FlatPtr*) == sizeof(NanBoxedValue)) {
         // Because NanBoxedValue stores pointers in non-canonical form we have to check if the top bytes
         // match any pointer-backed tag, in that case we have to extract the pointer to its
         // canonical form and add that as a possible pointer.
-        FlatPtr possible_pointer;
         if ((data & SHIFTED_IS_CELL_PATTERN) == SHIFTED_IS_CELL_PATTERN)
-            possible_pointer = NanBoxedValue::extract_pointer_bits(data);
-        else
-            possible_pointer = data;
-        if (possible_pointer < min_block_address || possible_pointer > max_block_address)
-            return;
-        possible_pointers.set(possible_pointer, move(origin));
+            return NanBoxedValue::extract_pointer_bits(data);
+        return data;
     } else {
         static_assert((sizeof(NanBoxedValue) % sizeof(FlatPtr*)) == 0);
-        if (data < min_block_address || data > max_block_address)
-            return;
         // In the 32-bit case we will look at the top and bottom part of NanBoxedValue separately we just
         // add both the upper and lower bytes as possible pointers.
-        possible_pointers.set(data, move(origin));
+        return data;
     }
 }
 
+static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
+{
+    auto possible_pointer = possible_pointer_from_data(data);
+    if (possible_pointer < min_block_address || possible_pointer > max_block_address)
+        return;
+    possible_pointers.set(possible_pointer, move(origin));
+}
+
 void Heap::find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address)
 {
     min_address = explode_byte(0xff);
@@ -111,6 +114,29 @@ static void for_each_cell_among_possible_pointers(HashTable<HeapBlock*> const& a
     }
 }
 
+static String describe_heap_root(HeapRoot const& root)
+{
+    switch (root.type) {
+    case HeapRoot::Type::HeapFunctionCapturedPointer:
+        return "HeapFunctionCapturedPointer"_string;
+    case HeapRoot::Type::Root:
+        return MUST(String::formatted("Root {} {}:{}", root.location->function_name(), root.location->filename(), root.location->line_number()));
+    case HeapRoot::Type::RootVector:
+        return "RootVector"_string;
+    case HeapRoot::Type::RootHashMap:
+        return "RootHashMap"_string;
+    case HeapRoot::Type::ConservativeVector:
+        return "ConservativeVector"_string;
+    case HeapRoot::Type::RegisterPointer:
+        return "RegisterPointer"_string;
+    case HeapRoot::Type::StackPointer:
+        return "StackPointer"_string;
+    case HeapRoot::Type::VM:
+        return "VM"_string;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 class GraphConstructorVisitor final : public Cell::Visitor {
 public:
     explicit GraphConstructorVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
@@ -126,6 +152,7 @@ public:
         for (auto& [root, root_origin] : roots) {
             auto& graph_node = m_graph.ensure(bit_cast<FlatPtr>(root));
             graph_node.class_name = root->class_name();
+            graph_node.cell_size = HeapBlock::from_cell(root)->cell_size();
             graph_node.root_origin = root_origin;
 
             m_work_queue.append(*root);
@@ -167,6 +194,7 @@ public:
             auto cell = m_work_queue.take_last();
             m_node_being_visited = &m_graph.ensure(bit_cast<FlatPtr>(cell.ptr()));
             m_node_being_visited->class_name = cell->class_name();
+            m_node_being_visited->cell_size = HeapBlock::from_cell(cell.ptr())->cell_size();
             cell->visit_edges(*this);
             m_node_being_visited = nullptr;
         }
@@ -182,29 +210,8 @@ public:
             }
 
             auto node = AK::JsonObject();
-            if (it.value.root_origin.has_value()) {
-                auto type = it.value.root_origin->type;
-                auto location = it.value.root_origin->location;
-                switch (type) {
-                case HeapRoot::Type::Root:
-                    node.set("root"sv, MUST(String::formatted("Root {} {}:{}", location->function_name(), location->filename(), location->line_number())));
-                    break;
-                case HeapRoot::Type::RootVector:
-                    node.set("root"sv, "RootVector"sv);
-                    break;
-                case HeapRoot::Type::RegisterPointer:
-                    node.set("root"sv, "RegisterPointer"sv);
-                    break;
-                case HeapRoot::Type::StackPointer:
-                    node.set("root"sv, "StackPointer"sv);
-                    break;
-                case HeapRoot::Type::VM:
-                    node.set("root"sv, "VM"sv);
-                    break;
-                default:
-                    VERIFY_NOT_REACHED();
-                }
-            }
+            if (it.value.root_origin.has_value())
+                node.set("root"sv, describe_heap_root(*it.value.root_origin));
             node.set("class_name"sv, it.value.class_name);
             node.set("edges"sv, edges);
             graph.set(ByteString::number(it.key), node);
@@ -213,10 +220,135 @@ public:
         return graph;
     }
 
+    // Serializes the graph in the .heapsnapshot format used by V8, so that it can be loaded into existing heap snapshot
+    // viewers (e.g. the Memory panel of Chromium's developer tools). Viewers compute retained sizes themselves.
+    AK::JsonObject dump_heap_snapshot()
+    {
+        static constexpr size_t node_field_count = 7;
+        static constexpr size_t node_type_native = 8;
+        static constexpr size_t node_type_synthetic = 9;
+        static constexpr size_t edge_type_element = 1;
+        static constexpr size_t edge_type_internal = 3;
+
+        Vector<String> strings;
+        HashMap<String, size_t> string_indices;
+        auto string_index = [&](String const& string) -> size_t {
+            return string_indices.ensure(string, [&] {
+                strings.append(string);
+                return strings.size() - 1;
+            });
+        };
+        (void)string_index(String {});
+
+        // Node 0 is a synthetic root that holds an edge to every GC root.
+        Vector<FlatPtr> cells;
+        HashMap<FlatPtr, size_t> node_indices;
+        cells.ensure_capacity(m_graph.size());
+        for (auto& it : m_graph) {
+            node_indices.set(it.key, cells.size() + 1);
+            cells.append(it.key);
+        }
+
+        AK::JsonArray nodes;
+        AK::JsonArray edges;
+        size_t edge_count = 0;
+
+        auto append_node = [&](size_t type, String const& name, size_t id, size_t self_size, size_t node_edge_count) {
+            nodes.must_append(type);
+            nodes.must_append(string_index(name));
+            nodes.must_append(id);
+            nodes.must_append(self_size);
+            nodes.must_append(node_edge_count);
+            nodes.must_append(0); // trace_node_id
+            nodes.must_append(0); // detachedness
+        };
+
+        auto append_edge = [&](size_t type, size_t name_or_index, size_t to_node_index) {
+            edges.must_append(type);
+            edges.must_append(name_or_index);
+            edges.must_append(to_node_index * node_field_count);
+            ++edge_count;
+        };
+
+        size_t root_count = 0;
+        for (auto cell : cells) {
+            if (m_graph.get(cell)->root_origin.has_value())
+                ++root_count;
+        }
+
+        append_node(node_type_synthetic, "(GC roots)"_string, 1, 0, root_count);
+        for (auto cell : cells) {
+            auto const& graph_node = *m_graph.get(cell);
+            if (graph_node.root_origin.has_value())
+                append_edge(edge_type_internal, string_index(describe_heap_root(*graph_node.root_origin)), *node_indices.get(cell));
+        }
+
+        for (size_t i = 0; i < cells.size(); ++i) {
+            auto const& graph_node = *m_graph.get(cells[i]);
+
+            size_t node_edge_count = 0;
+            for (auto target : graph_node.edges) {
+                if (auto target_index = node_indices.get(target); target_index.has_value())
+                    append_edge(edge_type_element, node_edge_count++, *target_index);
+            }
+
+            append_node(node_type_native, MUST(String::from_utf8(graph_node.class_name)), (i + 1) * 2 + 1, graph_node.cell_size, node_edge_count);
+        }
+
+        auto string_array = [](std::initializer_list<StringView> values) {
+            AK::JsonArray array;
+            for (auto value : values)
+                array.must_append(value);
+            return array;
+        };
+
+        AK::JsonArray node_types;
+        node_types.must_append(string_array({ "hidden"sv, "array"sv, "string"sv, "object"sv, "code"sv, "closure"sv, "regexp"sv, "number"sv, "native"sv, "synthetic"sv, "concatenated string"sv, "sliced string"sv, "symbol"sv, "bigint"sv, "object shape"sv }));
+        for (auto type : { "string"sv, "number"sv, "number"sv, "number"sv, "number"sv, "number"sv })
+            node_types.must_append(type);
+
+        AK::JsonArray edge_types;
+        edge_types.must_append(string_array({ "context"sv, "element"sv, "property"sv, "internal"sv, "hidden"sv, "shortcut"sv, "weak"sv }));
+        edge_types.must_append("string_or_number"sv);
+        edge_types.must_append("node"sv);
+
+        AK::JsonObject meta;
+        meta.set("node_fields"sv, string_array({ "type"sv, "name"sv, "id"sv, "self_size"sv, "edge_count"sv, "trace_node_id"sv, "detachedness"sv }));
+        meta.set("node_types"sv, move(node_types));
+        meta.set("edge_fields"sv, string_array({ "type"sv, "name_or_index"sv, "to_node"sv }));
+        meta.set("edge_types"sv, move(edge_types));
+        meta.set("trace_function_info_fields"sv, string_array({ "function_id"sv, "name"sv, "script_name"sv, "script_id"sv, "line"sv, "column"sv }));
+        meta.set("trace_node_fields"sv, string_array({ "id"sv, "function_info_index"sv, "count"sv, "size"sv, "children"sv }));
+        meta.set("sample_fields"sv, string_array({ "timestamp_us"sv, "last_assigned_id"sv }));
+        meta.set("location_fields"sv, string_array({ "object_index"sv, "script_id"sv, "line"sv, "column"sv }));
+
+        AK::JsonObject snapshot_info;
+        snapshot_info.set("meta"sv, move(meta));
+        snapshot_info.set("node_count"sv, cells.size() + 1);
+        snapshot_info.set("edge_count"sv, edge_count);
+        snapshot_info.set("trace_function_count"sv, 0);
+
+        AK::JsonArray string_table;
+        for (auto& string : strings)
+            string_table.must_append(string);
+
+        AK::JsonObject snapshot;
+        snapshot.set("snapshot"sv, move(snapshot_info));
+        snapshot.set("nodes"sv, move(nodes));
+        snapshot.set("edges"sv, move(edges));
+        snapshot.set("trace_function_infos"sv, AK::JsonArray {});
+        snapshot.set("trace_tree"sv, AK::JsonArray {});
+        snapshot.set("samples"sv, AK::JsonArray {});
+        snapshot.set("locations"sv, AK::JsonArray {});
+        snapshot.set("strings"sv, move(string_table));
+        return snapshot;
+    }
+
 private:
     struct GraphNode {
         Optional<HeapRoot> root_origin;
         StringView class_name;
+        size_t cell_size { 0 };
         HashTable<FlatPtr> edges {};
     };
 
@@ -239,6 +371,62 @@ AK::JsonObject Heap::dump_graph()
     return visitor.dump();
 }
 
+AK::JsonObject Heap::dump_heap_snapshot()
+{
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+    GraphConstructorVisitor visitor(*this, roots);
+    visitor.visit_all_cells();
+    return visitor.dump_heap_snapshot();
+}
+
+AK::JsonObject Heap::dump_statistics()
+{
+    AK::JsonArray cell_allocators;
+    size_t total_live_cell_bytes = 0;
+    size_t total_block_count = 0;
+
+    for (auto& allocator : m_all_cell_allocators) {
+        size_t block_count = 0;
+        size_t live_cells = 0;
+        size_t total_cells = 0;
+        allocator.for_each_block([&](auto& block) {
+            ++block_count;
+            total_cells += block.cell_count();
+            block.template for_each_cell_in_state<Cell::State::Live>([&](Cell*) {
+                ++live_cells;
+            });
+            return IterationDecision::Continue;
+        });
+
+        auto free_cells = total_cells - live_cells;
+
+        AK::JsonObject entry;
+        if (allocator.class_name())
+            entry.set("class_name"sv, StringView { allocator.class_name(), strlen(allocator.class_name()) });
+        entry.set("cell_size"sv, allocator.cell_size());
+        entry.set("blocks"sv, block_count);
+        entry.set("cached_blocks"sv, allocator.block_allocator().cached_block_count());
+        entry.set("live_cells"sv, live_cells);
+        entry.set("free_cells"sv, free_cells);
+        entry.set("live_bytes"sv, live_cells * allocator.cell_size());
+        entry.set("fragmentation_percent"sv, total_cells ? free_cells * 100 / total_cells : 0);
+        cell_allocators.must_append(move(entry));
+
+        total_live_cell_bytes += live_cells * allocator.cell_size();
+        total_block_count += block_count;
+    }
+
+    AK::JsonObject statistics;
+    statistics.set("block_size"sv, HeapBlock::block_size);
+    statistics.set("blocks"sv, total_block_count);
+    statistics.set("live_bytes"sv, total_live_cell_bytes);
+    statistics.set("bytes_allocated_since_last_gc"sv, m_allocated_bytes_since_last_gc);
+    statistics.set("gc_bytes_threshold"sv, m_gc_bytes_threshold);
+    statistics.set("cell_allocators"sv, move(cell_allocators));
+    return statistics;
+}
+
 void Heap::collect_garbage(CollectionType collection_type, bool print_report)
 {
     VERIFY(!m_collecting_garbage);
@@ -247,8 +435,18 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
         TemporaryChange change(m_collecting_garbage, true);
 
         Core::ElapsedTimer collection_measurement_timer;
+        Core::ElapsedTimer phase_measurement_timer;
+        PhaseTimings phase_timings;
+        collection_measurement_timer.start();
         if (print_report)
-            collection_measurement_timer.start();
+            phase_measurement_timer.start();
+
+        auto finish_phase = [&](AK::Duration& duration) {
+            if (!print_report)
+                return;
+            duration = phase_measurement_timer.elapsed_time();
+            phase_measurement_timer.start();
+        };
 
         if (collection_type == CollectionType::CollectGarbage) {
             if (m_gc_deferrals) {
@@ -257,11 +455,17 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
             }
             HashMap<Cell*, HeapRoot> roots;
             gather_roots(roots);
+            finish_phase(phase_timings.gather_roots);
             mark_live_cells(roots);
+            finish_phase(phase_timings.mark);
         }
         finalize_unmarked_cells();
+        finish_phase(phase_timings.finalize);
         sweep_weak_blocks();
-        sweep_dead_cells(print_report, collection_measurement_timer);
+        sweep_dead_cells(print_report, collection_measurement_timer, phase_timings);
+
+        ++m_collection_statistics.collection_count;
+        m_collection_statistics.total_pause_time += collection_measurement_timer.elapsed_time();
     }
 
     auto tasks = move(m_post_gc_tasks);
@@ -338,7 +542,32 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
 
     auto stack_reference = bit_cast<FlatPtr>(&dummy);
 
+    // Find the parts of the stack that the embedder visits precisely, ordered by address so we can skip over them below.
+    PreciselyVisitedStackRanges precisely_visited_stack_ranges;
+    if (m_gather_precisely_visited_stack_ranges) {
+        m_gather_precisely_visited_stack_ranges(precisely_visited_stack_ranges);
+        precisely_visited_stack_ranges.remove_all_matching([&](ReadonlyBytes range) {
+            auto start = bit_cast<FlatPtr>(range.data());
+            return range.is_empty() || start < stack_reference || start + range.size() > m_stack_info.top();
+        });
+        quick_sort(precisely_visited_stack_ranges, [](ReadonlyBytes a, ReadonlyBytes b) { return a.data() < b.data(); });
+    }
+    size_t next_precisely_visited_stack_range = 0;
+
     for (FlatPtr stack_address = stack_reference; stack_address < m_stack_info.top(); stack_address += sizeof(FlatPtr)) {
+        while (next_precisely_visited_stack_range < precisely_visited_stack_ranges.size()) {
+            auto range = precisely_visited_stack_ranges[next_precisely_visited_stack_range];
+            auto range_start = bit_cast<FlatPtr>(range.data());
+            auto range_end = range_start + range.size();
+            if (stack_address < range_start)
+                break;
+            ++next_precisely_visited_stack_range;
+            if (stack_address < range_end)
+                stack_address = align_up_to(range_end, sizeof(FlatPtr));
+        }
+        if (stack_address >= m_stack_info.top())
+            break;
+
         auto data = *reinterpret_cast<FlatPtr*>(stack_address);
         add_possible_value(possible_pointers, data, HeapRoot { .type = HeapRoot::Type::StackPointer }, min_block_address, max_block_address);
         gather_asan_fake_stack_roots(possible_pointers, data, min_block_address, max_block_address);
@@ -394,20 +623,25 @@ public:
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
     {
-        HashMap<FlatPtr, HeapRoot> possible_pointers;
-
+        // OPTIMIZATION: Unlike root gathering, marking doesn't care where a possible pointer came from, so we check each
+        //               word directly instead of collecting them into a HashMap first. Duplicates are filtered out by
+        //               the mark bit.
         auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
-        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
-            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
+        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i) {
+            auto possible_pointer = possible_pointer_from_data(raw_pointer_sized_values[i]);
+            if (!possible_pointer || possible_pointer < m_min_block_address || possible_pointer > m_max_block_address)
+                continue;
 
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
-            if (cell->is_marked())
-                return;
-            if (cell->state() != Cell::State::Live)
-                return;
+            auto* possible_heap_block = HeapBlock::from_cell(reinterpret_cast<Cell const*>(possible_pointer));
+            if (!m_all_live_heap_blocks.contains(possible_heap_block))
+                continue;
+
+            auto* cell = possible_heap_block->cell_from_possible_pointer(possible_pointer);
+            if (!cell || cell->is_marked() || cell->state() != Cell::State::Live)
+                continue;
             cell->set_marked(true);
             m_work_queue.append(*cell);
-        });
+        }
     }
 
     void mark_all_live_cells()
@@ -481,7 +715,7 @@ void Heap::sweep_weak_blocks()
     }
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer, PhaseTimings const& phase_timings)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
@@ -491,18 +725,45 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
     size_t live_cells = 0;
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
+    size_t collected_young_cells = 0;
+    size_t surviving_young_cells = 0;
 
     for_each_block([&](auto& block) {
+        // OPTIMIZATION: If nothing in the block survived, the whole block is about to be handed back to the BlockAllocator,
+        //               so there's no point in threading each dead cell onto the block's freelist first.
+        bool block_has_marked_cells = false;
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            block_has_marked_cells |= cell->is_marked();
+        });
+        if (!block_has_marked_cells) {
+            block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+                dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+                if (cell->is_young())
+                    ++collected_young_cells;
+                block.destroy_cell_in_dying_block(cell);
+                ++collected_cells;
+                collected_cell_bytes += block.cell_size();
+            });
+            empty_blocks.append(&block);
+            return IterationDecision::Continue;
+        }
+
         bool block_has_live_cells = false;
         bool block_was_full = block.is_full();
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
             if (!cell->is_marked()) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+                if (cell->is_young())
+                    ++collected_young_cells;
                 block.deallocate(cell);
                 ++collected_cells;
                 collected_cell_bytes += block.cell_size();
             } else {
                 cell->set_marked(false);
+                if (cell->is_young()) {
+                    cell->set_young(false);
+                    ++surviving_young_cells;
+                }
                 block_has_live_cells = true;
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
@@ -545,11 +806,17 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
             return IterationDecision::Continue;
         });
 
+        auto young_cells = collected_young_cells + surviving_young_cells;
         dbgln("Garbage collection report");
         dbgln("=============================================");
         dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
+        dbgln("  Gather roots:  {} ms", phase_timings.gather_roots.to_milliseconds());
+        dbgln("  Mark:          {} ms", phase_timings.mark.to_milliseconds());
+        dbgln("  Finalize:      {} ms", phase_timings.finalize.to_milliseconds());
+        dbgln("  Sweep:         {} ms", (time_spent - phase_timings.gather_roots - phase_timings.mark - phase_timings.finalize).to_milliseconds());
         dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
+        dbgln("    Young cells: {} allocated since last collection, {} survived ({}%)", young_cells, surviving_young_cells, young_cells ? surviving_young_cells * 100 / young_cells : 0);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
         dbgln("=============================================");
@@ -13,6 +13,7 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/StackInfo.h>
 #include <AK/Swift.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -55,6 +56,19 @@ public:
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
     AK::JsonObject dump_graph();
+    AK::JsonObject dump_heap_snapshot();
+    AK::JsonObject dump_statistics();
+
+    struct CollectionStatistics {
+        size_t collection_count { 0 };
+        AK::Duration total_pause_time;
+    };
+    CollectionStatistics const& collection_statistics() const { return m_collection_statistics; }
+
+    // The embedder can report regions of the native stack that it already visits precisely while gathering roots
+    // (e.g. interpreter register files), so that conservative stack scanning can skip over them.
+    using PreciselyVisitedStackRanges = Vector<ReadonlyBytes, 32>;
+    void set_gather_precisely_visited_stack_ranges(AK::Function<void(PreciselyVisitedStackRanges&)> callback) { m_gather_precisely_visited_stack_ranges = move(callback); }
 
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
@@ -115,7 +129,13 @@ private:
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
     void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
     void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+
+    struct PhaseTimings {
+        AK::Duration gather_roots;
+        AK::Duration mark;
+        AK::Duration finalize;
+    };
+    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&, PhaseTimings const&);
     void sweep_weak_blocks();
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
@@ -159,8 +179,10 @@ private:
     bool m_should_gc_when_deferral_ends { false };
 
     bool m_collecting_garbage { false };
+    CollectionStatistics m_collection_statistics;
     StackInfo m_stack_info;
     AK::Function<void(HashMap<Cell*, GC::HeapRoot>&)> m_gather_embedder_roots;
+    AK::Function<void(PreciselyVisitedStackRanges&)> m_gather_precisely_visited_stack_ranges;
 
     Vector<AK::Function<void()>> m_post_gc_tasks;
 
@@ -61,4 +61,15 @@ void HeapBlock::deallocate(Cell* cell)
 #endif
 }
 
+void HeapBlock::destroy_cell_in_dying_block(Cell* cell)
+{
+    VERIFY(cell->state() == Cell::State::Live);
+    VERIFY(!cell->is_marked());
+
+    cell->~Cell();
+    // NOTE: Weak containers still look at the state of cells they point to before the block is released.
+    auto* freelist_entry = new (cell) FreelistEntry();
+    freelist_entry->set_state(Cell::State::Dead);
+}
+
 }
@@ -50,6 +50,10 @@ public:
 
     void deallocate(Cell*);
 
+    // Destroys a dead cell in a block that is about to be returned to the BlockAllocator as a whole.
+    // Unlike deallocate(), this doesn't put the cell on the freelist or poison it.
+    void destroy_cell_in_dying_block(Cell*);
+
     template<typename Callback>
     void for_each_cell(Callback callback)
     {
@@ -9,6 +9,7 @@
 #include <AK/Bitmap.h>
 #include <AK/Checked.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/PixelConversion.h>
 #include <LibGfx/ShareableBitmap.h>
 #include <LibGfx/SkiaUtils.h>
 
@@ -353,19 +354,15 @@ void Bitmap::set_alpha_type_destructive(AlphaType alpha_type)
     }
     VERIFY(err == kvImageNoError);
 #else
-    // FIXME: Make this fast on other platforms too.
-    if (m_alpha_type == AlphaType::Unpremultiplied) {
-        for (auto y = 0; y < height(); ++y) {
-            for (auto x = 0; x < width(); ++x)
-                set_pixel(x, y, get_pixel(x, y).to_premultiplied());
-        }
-    } else if (m_alpha_type == AlphaType::Premultiplied) {
+    // Formats without alpha are opaque, which looks the same either way.
+    if (has_alpha_channel()) {
         for (auto y = 0; y < height(); ++y) {
-            for (auto x = 0; x < width(); ++x)
-                set_pixel(x, y, get_pixel(x, y).to_unpremultiplied());
+            Span<ARGB32> pixels { scanline(y), static_cast<size_t>(width()) };
+            if (m_alpha_type == AlphaType::Unpremultiplied)
+                premultiply_alpha(pixels);
+            else
+                unpremultiply_alpha(pixels);
         }
-    } else {
-        VERIFY_NOT_REACHED();
     }
 #endif
     m_alpha_type = alpha_type;
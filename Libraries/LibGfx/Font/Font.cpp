@@ -6,12 +6,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/NeverDestroyed.h>
 #include <AK/TypeCasts.h>
 #include <AK/Utf16String.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/TypefaceSkia.h>
 #include <LibGfx/TextLayout.h>
+#include <LibThreading/Mutex.h>
 
 #include <core/SkFont.h>
 #include <core/SkFontMetrics.h>
@@ -21,6 +23,22 @@
 
 namespace Gfx {
 
+// Fonts may outlive other statics, so neither of these are ever destroyed.
+static NeverDestroyed<Threading::Mutex> s_all_fonts_mutex;
+
+Font::List& Font::all_fonts()
+{
+    static NeverDestroyed<Font::List> fonts;
+    return *fonts;
+}
+
+void Font::clear_all_shaping_caches()
+{
+    Threading::MutexLocker locker(*s_all_fonts_mutex);
+    for (auto& font : all_fonts())
+        font.m_shaping_cache.clear();
+}
+
 Font::Font(NonnullRefPtr<Typeface const> typeface, float point_width, float point_height, unsigned dpi_x, unsigned dpi_y)
     : m_typeface(move(typeface))
     , m_point_width(point_width)
@@ -47,6 +65,9 @@ Font::Font(NonnullRefPtr<Typeface const> typeface, float point_width, float poin
     metrics.line_gap = skMetrics.fLeading;
 
     m_pixel_metrics = metrics;
+
+    Threading::MutexLocker locker(*s_all_fonts_mutex);
+    all_fonts().append(*this);
 }
 
 ScaledFontMetrics Font::metrics() const
@@ -94,6 +115,11 @@ float Font::point_size() const
 
 Font::~Font()
 {
+    {
+        Threading::MutexLocker locker(*s_all_fonts_mutex);
+        all_fonts().remove(*this);
+    }
+
     if (m_harfbuzz_font)
         hb_font_destroy(m_harfbuzz_font);
 }
@@ -131,12 +157,49 @@ Font::ShapingCache::~ShapingCache()
     clear();
 }
 
+hb_buffer_t* Font::ShapingCache::find(Utf16View const& string)
+{
+    auto it = map.find(string.hash(), [&](auto& candidate) { return candidate.key == string; });
+    if (it == map.end()) {
+        ++miss_count;
+        return nullptr;
+    }
+    ++hit_count;
+    lru_list.prepend(*it->value);
+    return it->value->buffer;
+}
+
+void Font::ShapingCache::insert(Utf16View const& string, hb_buffer_t* buffer)
+{
+    auto entry_size_in_bytes = string.length_in_code_units() * sizeof(char16_t)
+        + hb_buffer_get_length(buffer) * (sizeof(hb_glyph_info_t) + sizeof(hb_glyph_position_t));
+
+    while (!lru_list.is_empty() && size_in_bytes + entry_size_in_bytes > max_size_in_bytes) {
+        auto* least_recently_used = lru_list.last();
+        least_recently_used->lru_list_node.remove();
+        size_in_bytes -= least_recently_used->size_in_bytes;
+        hb_buffer_destroy(least_recently_used->buffer);
+        map.remove(map.find(least_recently_used->text));
+    }
+
+    auto entry = make<Entry>();
+    entry->text = Utf16String::from_utf16(string);
+    entry->buffer = buffer;
+    entry->size_in_bytes = entry_size_in_bytes;
+    lru_list.prepend(*entry);
+    size_in_bytes += entry_size_in_bytes;
+    auto text = entry->text;
+    map.set(move(text), move(entry));
+}
+
 void Font::ShapingCache::clear()
 {
+    lru_list.clear();
     for (auto& it : map) {
-        hb_buffer_destroy(it.value);
+        hb_buffer_destroy(it.value->buffer);
     }
     map.clear();
+    size_in_bytes = 0;
     for (auto& buffer : single_ascii_character_map) {
         if (buffer) {
             hb_buffer_destroy(buffer);
@@ -10,6 +10,8 @@
 #pragma once
 
 #include <AK/FlyString.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/Utf16String.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/Typeface.h>
@@ -87,15 +89,40 @@ public:
         // Before using the cache, make sure the features match! If they don't, clear the cache.
         ShapeFeatures features;
 
-        HashMap<Utf16String, hb_buffer_t*> map;
+        struct Entry {
+            Utf16String text;
+            hb_buffer_t* buffer { nullptr };
+            size_t size_in_bytes { 0 };
+            IntrusiveListNode<Entry> lru_list_node;
+        };
+
+        // Cached buffers are evicted in least-recently-used order once their combined size exceeds this limit.
+        static constexpr size_t max_size_in_bytes = 1 * MiB;
+
+        hb_buffer_t* find(Utf16View const&);
+        void insert(Utf16View const&, hb_buffer_t*);
+
+        HashMap<Utf16String, NonnullOwnPtr<Entry>> map;
+        IntrusiveList<&Entry::lru_list_node> lru_list;
+        size_t size_in_bytes { 0 };
         hb_buffer_t* single_ascii_character_map[128] { nullptr };
 
+        u64 hit_count { 0 };
+        u64 miss_count { 0 };
+
         ~ShapingCache();
         void clear();
     };
     ShapingCache& shaping_cache() const { return m_shaping_cache; }
 
+    // Drops the shaped text of every live font, to give memory back when the system is running low.
+    static void clear_all_shaping_caches();
+
 private:
+    IntrusiveListNode<Font> m_all_fonts_list_node;
+    using List = IntrusiveList<&Font::m_all_fonts_list_node>;
+    static List& all_fonts();
+
     mutable RefPtr<Font const> m_bold_variant;
     mutable hb_font_t* m_harfbuzz_font { nullptr };
 
@@ -45,7 +45,19 @@ FontDatabase::FontDatabase() = default;
 
 RefPtr<Gfx::Font> FontDatabase::get(FlyString const& family, float point_size, unsigned weight, unsigned width, unsigned slope)
 {
-    return m_system_font_provider->get_font(family, point_size, weight, width, slope);
+    // Computing styles asks for the same few fonts over and over, so we remember the answers, including the ones where
+    // there is no such font.
+    FontKey key { family, point_size, weight, width, slope };
+    if (auto it = m_fonts.find(key); it != m_fonts.end())
+        return it->value;
+
+    constexpr size_t max_cached_font_count = 1024;
+    if (m_fonts.size() >= max_cached_font_count)
+        m_fonts.clear();
+
+    auto font = m_system_font_provider->get_font(family, point_size, weight, width, slope);
+    m_fonts.set(move(key), font);
+    return font;
 }
 
 void FontDatabase::for_each_typeface_with_family_name(FlyString const& family_name, Function<void(Typeface const&)> callback)
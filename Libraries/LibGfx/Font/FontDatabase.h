@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <AK/BitCast.h>
 #include <AK/FlyString.h>
 #include <AK/Function.h>
+#include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <LibGfx/Font/Typeface.h>
 #include <LibGfx/Forward.h>
@@ -39,6 +41,26 @@ private:
     ~FontDatabase() = default;
 
     OwnPtr<SystemFontProvider> m_system_font_provider;
+
+    struct FontKey {
+        FlyString family;
+        float point_size { 0 };
+        unsigned weight { 0 };
+        unsigned width { 0 };
+        unsigned slope { 0 };
+
+        bool operator==(FontKey const&) const = default;
+    };
+    struct FontKeyTraits : public DefaultTraits<FontKey> {
+        static unsigned hash(FontKey const& key)
+        {
+            auto hash = pair_int_hash(key.family.hash(), bit_cast<u32>(key.point_size));
+            hash = pair_int_hash(hash, key.weight);
+            hash = pair_int_hash(hash, key.width);
+            return pair_int_hash(hash, key.slope);
+        }
+    };
+    HashMap<FontKey, RefPtr<Gfx::Font>, FontKeyTraits> m_fonts;
 };
 
 }
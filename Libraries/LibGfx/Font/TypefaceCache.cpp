@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteReader.h>
+#include <AK/NeverDestroyed.h>
+#include <LibGfx/Font/TypefaceCache.h>
+
+namespace Gfx {
+
+TypefaceCache& TypefaceCache::the()
+{
+    static NeverDestroyed<TypefaceCache> s_the;
+    return *s_the;
+}
+
+static u32 cache_key(Crypto::Hash::SHA256::DigestType const& content_hash, unsigned ttc_index)
+{
+    return pair_int_hash(ByteReader::load64(content_hash.immutable_data()), ttc_index);
+}
+
+ErrorOr<NonnullRefPtr<Typeface>> TypefaceCache::ensure(ReadonlyBytes font_file, unsigned ttc_index, Function<ErrorOr<NonnullRefPtr<Typeface>>()> const& load)
+{
+    auto content_hash = Crypto::Hash::SHA256::hash(font_file);
+    auto key = cache_key(content_hash, ttc_index);
+
+    if (auto entry = m_entries.get(key); entry.has_value()) {
+        if ((*entry)->content_hash == content_hash && (*entry)->ttc_index == ttc_index) {
+            m_lru_list.remove(**entry);
+            m_lru_list.append(**entry);
+            ++m_statistics.hits;
+            return (*entry)->typeface;
+        }
+        m_lru_list.remove(**entry);
+        m_entries.remove(key);
+    }
+    ++m_statistics.misses;
+
+    auto typeface = TRY(load());
+
+    if (m_entries.size() >= MAXIMUM_ENTRY_COUNT) {
+        auto& least_recently_used = *m_lru_list.take_first();
+        m_entries.remove(cache_key(least_recently_used.content_hash, least_recently_used.ttc_index));
+        ++m_statistics.evictions;
+    }
+
+    auto entry = adopt_own(*new Entry { content_hash, ttc_index, typeface, {} });
+    m_lru_list.append(*entry);
+    m_entries.set(key, move(entry));
+    return typeface;
+}
+
+}
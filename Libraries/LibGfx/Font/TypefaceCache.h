@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/Noncopyable.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibGfx/Font/Typeface.h>
+
+namespace Gfx {
+
+// Typefaces decompressed from WOFF and WOFF2 files, keyed by a hash of the file's contents. Sites tend to serve the same
+// web fonts to every one of their documents and frames, and decompressing them (WOFF2 in particular) is expensive.
+class TypefaceCache {
+    AK_MAKE_NONCOPYABLE(TypefaceCache);
+    AK_MAKE_NONMOVABLE(TypefaceCache);
+
+public:
+    static constexpr size_t MAXIMUM_ENTRY_COUNT = 64;
+
+    struct Statistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+    };
+
+    static TypefaceCache& the();
+
+    // Returns the typeface that was loaded from the same font file before, or loads it and remembers it.
+    ErrorOr<NonnullRefPtr<Typeface>> ensure(ReadonlyBytes font_file, unsigned ttc_index, Function<ErrorOr<NonnullRefPtr<Typeface>>()> const& load);
+
+    Statistics const& statistics() const { return m_statistics; }
+
+private:
+    TypefaceCache() = default;
+
+    struct Entry {
+        Crypto::Hash::SHA256::DigestType content_hash;
+        unsigned ttc_index { 0 };
+        NonnullRefPtr<Typeface> typeface;
+        IntrusiveListNode<Entry> list_node;
+    };
+
+    HashMap<u32, NonnullOwnPtr<Entry>> m_entries;
+    IntrusiveList<&Entry::list_node> m_lru_list;
+
+    Statistics m_statistics;
+};
+
+}
@@ -9,6 +9,7 @@
 #include <AK/IntegralMath.h>
 #include <LibCompress/Zlib.h>
 #include <LibCore/Resource.h>
+#include <LibGfx/Font/TypefaceCache.h>
 #include <LibGfx/Font/WOFF/Loader.h>
 #include <LibGfx/FourCC.h>
 
@@ -68,9 +69,12 @@ static u16 pow_2_less_than_or_equal(u16 x)
     return 1 << (sizeof(u16) * 8 - count_leading_zeroes_safe<u16>(x - 1));
 }
 
+static ErrorOr<NonnullRefPtr<Gfx::Typeface>> decompress_and_load(ReadonlyBytes buffer, unsigned index);
+
 ErrorOr<NonnullRefPtr<Gfx::Typeface>> try_load_from_resource(Core::Resource const& resource, unsigned index)
 {
-    return try_load_from_bytes(resource.data(), index);
+    // Resources are installed fonts, which are only loaded once.
+    return decompress_and_load(resource.data(), index);
 }
 
 using Uint8 = u8;
@@ -102,7 +106,12 @@ struct [[gnu::packed]] TableRecord {
 };
 static_assert(AssertSize<TableRecord, 16>());
 
-ErrorOr<NonnullRefPtr<Gfx::Typeface>> try_load_from_bytes(ReadonlyBytes buffer, unsigned int index)
+ErrorOr<NonnullRefPtr<Gfx::Typeface>> try_load_from_bytes(ReadonlyBytes buffer, unsigned index)
+{
+    return Gfx::TypefaceCache::the().ensure(buffer, index, [&] { return decompress_and_load(buffer, index); });
+}
+
+static ErrorOr<NonnullRefPtr<Gfx::Typeface>> decompress_and_load(ReadonlyBytes buffer, unsigned index)
 {
     FixedMemoryStream stream(buffer);
     auto header = TRY(stream.read_value<Header>());
@@ -5,6 +5,7 @@
  */
 
 #include <LibGfx/Font/Typeface.h>
+#include <LibGfx/Font/TypefaceCache.h>
 #include <LibGfx/Font/WOFF2/Loader.h>
 #include <woff2/decode.h>
 
@@ -53,7 +54,7 @@ private:
     ByteBuffer& m_buffer;
 };
 
-ErrorOr<NonnullRefPtr<Gfx::Typeface>> try_load_from_bytes(ReadonlyBytes bytes)
+static ErrorOr<NonnullRefPtr<Gfx::Typeface>> decompress_and_load(ReadonlyBytes bytes)
 {
     auto ttf_buffer = TRY(ByteBuffer::create_uninitialized(0));
     auto output = WOFF2ByteBufferOut { ttf_buffer };
@@ -67,4 +68,9 @@ ErrorOr<NonnullRefPtr<Gfx::Typeface>> try_load_from_bytes(ReadonlyBytes bytes)
     return input_font;
 }
 
+ErrorOr<NonnullRefPtr<Gfx::Typeface>> try_load_from_bytes(ReadonlyBytes bytes)
+{
+    return Gfx::TypefaceCache::the().ensure(bytes, 0, [&] { return decompress_and_load(bytes); });
+}
+
 }
@@ -11,10 +11,12 @@ namespace Gfx {
 void FontCascadeList::add(NonnullRefPtr<Font const> font)
 {
     m_fonts.append({ move(font), {} });
+    m_font_for_code_point_cache = nullptr;
 }
 
 void FontCascadeList::add(NonnullRefPtr<Font const> font, Vector<UnicodeRange> unicode_ranges)
 {
+    m_font_for_code_point_cache = nullptr;
     if (unicode_ranges.is_empty()) {
         m_fonts.append({ move(font), {} });
         return;
@@ -37,9 +39,23 @@ void FontCascadeList::add(NonnullRefPtr<Font const> font, Vector<UnicodeRange> u
 void FontCascadeList::extend(FontCascadeList const& other)
 {
     m_fonts.extend(other.m_fonts);
+    m_font_for_code_point_cache = nullptr;
 }
 
 Gfx::Font const& FontCascadeList::font_for_code_point(u32 code_point) const
+{
+    if (!m_font_for_code_point_cache)
+        m_font_for_code_point_cache = make<Array<CachedFont, font_for_code_point_cache_size>>();
+
+    auto& cached_font = (*m_font_for_code_point_cache)[code_point % font_for_code_point_cache_size];
+    if (cached_font.code_point != code_point) {
+        cached_font.code_point = code_point;
+        cached_font.font = &find_font_for_code_point(code_point);
+    }
+    return *cached_font.font;
+}
+
+Gfx::Font const& FontCascadeList::find_font_for_code_point(u32 code_point) const
 {
     for (auto const& entry : m_fonts) {
         if (entry.range_data.has_value()) {
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/OwnPtr.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/UnicodeRange.h>
 
@@ -49,11 +51,26 @@ public:
         Optional<RangeData> range_data;
     };
 
-    void set_last_resort_font(NonnullRefPtr<Font> font) { m_last_resort_font = move(font); }
+    void set_last_resort_font(NonnullRefPtr<Font> font)
+    {
+        m_last_resort_font = move(font);
+        m_font_for_code_point_cache = nullptr;
+    }
 
 private:
+    Gfx::Font const& find_font_for_code_point(u32 code_point) const;
+
     RefPtr<Font const> m_last_resort_font;
     Vector<Entry> m_fonts;
+
+    // Finding the font for a code point means asking every font in turn whether it has a glyph for it, and text tends
+    // to repeat the code points of a few small ranges. So we remember the last font found for each slot of code points.
+    struct CachedFont {
+        u32 code_point { 0xFFFFFFFF };
+        Font const* font { nullptr };
+    };
+    static constexpr size_t font_for_code_point_cache_size = 128;
+    mutable OwnPtr<Array<CachedFont, font_for_code_point_cache_size>> m_font_for_code_point_cache;
 };
 
 }
@@ -30,6 +30,7 @@ class Path;
 class ShareableBitmap;
 class SkiaBackendContext;
 struct SystemTheme;
+class YUVData;
 
 template<typename T>
 class Triangle;
@@ -39,6 +39,44 @@ public:
         m_bitmap->scanline(new_position.y())[new_position.x()] = color;
     }
 
+    // Same as calling set_pixel() for every pixel of the source, but without working out where each of them goes.
+    void set_pixels(Bitmap const& source)
+    requires(SameAs<BitmapLike, Bitmap>)
+    {
+        VERIFY(source.size() == IntSize(m_width, m_height));
+
+        // Every orientation moves a pixel by a fixed distance in the bitmap when it moves by one row or column.
+        auto* destination = m_bitmap->scanline(0);
+        auto const destination_pitch = static_cast<ptrdiff_t>(m_bitmap->pitch() / sizeof(ARGB32));
+        auto const offset_of = [&](IntPoint point) {
+            return point.y() * destination_pitch + point.x();
+        };
+        auto const origin_offset = offset_of(oriented_position({ 0, 0 }));
+        auto const column_step = offset_of(oriented_position({ 1, 0 })) - origin_offset;
+        auto const row_step = offset_of(oriented_position({ 0, 1 })) - origin_offset;
+
+        if (column_step == 1) {
+            for (u32 y = 0; y < m_height; ++y)
+                memcpy(destination + origin_offset + y * row_step, source.scanline(y), m_width * sizeof(ARGB32));
+            return;
+        }
+
+        // Rows that end up as columns are copied in tiles, so that we don't touch a new cache line for every pixel.
+        static constexpr u32 tile_size = 32;
+        for (u32 tile_y = 0; tile_y < m_height; tile_y += tile_size) {
+            for (u32 tile_x = 0; tile_x < m_width; tile_x += tile_size) {
+                auto const tile_height = min(tile_size, m_height - tile_y);
+                auto const tile_width = min(tile_size, m_width - tile_x);
+                for (u32 y = tile_y; y < tile_y + tile_height; ++y) {
+                    auto const* input = source.scanline(y) + tile_x;
+                    auto* output = destination + origin_offset + y * row_step + tile_x * column_step;
+                    for (u32 x = 0; x < tile_width; ++x, output += column_step)
+                        *output = input[x];
+                }
+            }
+        }
+    }
+
     NonnullRefPtr<BitmapLike>& bitmap()
     {
         return m_bitmap;
@@ -47,6 +47,38 @@ static ErrorOr<OwnPtr<ImageDecoderPlugin>> probe_and_sniff_for_appropriate_plugi
     return OwnPtr<ImageDecoderPlugin> {};
 }
 
+IntSize downscaled_size_for_ideal_size(IntSize image_size, Optional<IntSize> ideal_size)
+{
+    if (!ideal_size.has_value() || ideal_size->is_empty() || image_size.is_empty())
+        return image_size;
+    if (ideal_size->width() >= image_size.width() || ideal_size->height() >= image_size.height())
+        return image_size;
+
+    i64 width = image_size.width();
+    i64 height = image_size.height();
+    i64 ideal_width = ideal_size->width();
+    i64 ideal_height = ideal_size->height();
+
+    // Scale by whichever of the two ratios is larger, rounding the other dimension up.
+    if (ideal_width * height >= ideal_height * width)
+        return { ideal_width, ceil_div(height * ideal_width, width) };
+    return { ceil_div(width * ideal_height, height), ideal_height };
+}
+
+ErrorOr<ImageFrameDescriptor> ImageDecoder::frame(size_t index, Optional<IntSize> ideal_size) const
+{
+    auto frame = TRY(m_plugin->frame(index, ideal_size));
+    if (!ideal_size.has_value() || m_plugin->natural_frame_format() == NaturalFrameFormat::Vector)
+        return frame;
+
+    // Plugins that can decode at a reduced size do so, but may still return something larger than needed (e.g. JPEG
+    // can only scale by powers of two). Box-sample whatever is left down to the size it will be displayed at.
+    auto target_size = downscaled_size_for_ideal_size(frame.image->size(), ideal_size);
+    if (target_size != frame.image->size())
+        frame.image = TRY(frame.image->scaled(target_size.width(), target_size.height(), ScalingMode::BoxSampling));
+    return frame;
+}
+
 ErrorOr<ColorSpace> ImageDecoder::color_space()
 {
     auto maybe_cicp = TRY(m_plugin->cicp());
@@ -67,6 +99,20 @@ ErrorOr<RefPtr<ImageDecoder>> ImageDecoder::try_create_for_raw_bytes(ReadonlyByt
     return RefPtr<ImageDecoder> {};
 }
 
+ErrorOr<OwnPtr<IncrementalImageDecoderPlugin>> ImageDecoder::try_create_incremental_for_initial_bytes(ReadonlyBytes bytes)
+{
+    if (bytes.size() < INCREMENTAL_SNIFF_BYTES)
+        return OwnPtr<IncrementalImageDecoderPlugin> {};
+
+    if (JPEGImageDecoderPlugin::sniff(bytes))
+        return TRY(JPEGImageDecoderPlugin::create_incremental());
+    if (PNGImageDecoderPlugin::sniff(bytes))
+        return TRY(PNGImageDecoderPlugin::create_incremental());
+    if (WebPImageDecoderPlugin::sniff_riff_header(bytes))
+        return TRY(WebPImageDecoderPlugin::create_incremental());
+    return OwnPtr<IncrementalImageDecoderPlugin> {};
+}
+
 ImageDecoder::ImageDecoder(NonnullOwnPtr<ImageDecoderPlugin> plugin)
     : m_plugin(move(plugin))
 {
@@ -61,6 +61,9 @@ enum class NaturalFrameFormat {
     Vector,
 };
 
+// Returns the smallest size, keeping the aspect ratio of image_size, that covers ideal_size. Images are never upscaled.
+IntSize downscaled_size_for_ideal_size(IntSize image_size, Optional<IntSize> ideal_size);
+
 class ImageDecoderPlugin {
 public:
     virtual ~ImageDecoderPlugin() = default;
@@ -83,6 +86,8 @@ public:
     virtual size_t frame_count() { return 1; }
     virtual size_t first_animated_frame_index() { return 0; }
 
+    // If ideal_size is given, a raster plugin may return a smaller bitmap than size(), as long as it is not smaller
+    // than ideal_size in either dimension. Vector plugins render at ideal_size instead.
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) = 0;
 
     virtual Optional<Metadata const&> metadata() { return OptionalNone {}; }
@@ -98,9 +103,37 @@ protected:
     ImageDecoderPlugin() = default;
 };
 
+// Decodes a still image while its data is still arriving, so that something can be displayed before it is complete.
+// It is only meant for previews: once all data is there, the image should be decoded again with an ImageDecoder.
+class IncrementalImageDecoderPlugin {
+public:
+    virtual ~IncrementalImageDecoderPlugin() = default;
+
+    // Fails if the data can't be decoded, e.g. because it turns out to be an animation. Data that simply isn't
+    // complete yet is not an error.
+    virtual ErrorOr<void> append(ReadonlyBytes) = 0;
+
+    // How far decoding has come, e.g. the number of rows or scans that have been decoded. partial_bitmap() only has
+    // something new to show after this has increased.
+    virtual size_t progress() const = 0;
+
+    // A copy of the image at its full size, with the parts that have not been decoded yet left transparent. Returns
+    // nullptr until the header of the image has been decoded.
+    virtual ErrorOr<RefPtr<Bitmap>> partial_bitmap() const = 0;
+
+protected:
+    IncrementalImageDecoderPlugin() = default;
+};
+
 class ImageDecoder : public RefCounted<ImageDecoder> {
 public:
     static ErrorOr<RefPtr<ImageDecoder>> try_create_for_raw_bytes(ReadonlyBytes, Optional<ByteString> mime_type = {});
+
+    // Supports progressive and baseline JPEG, interlaced and non-interlaced PNG, and still WebP. The initial bytes
+    // are only used to pick the format, and must be passed to append() as well. Returns nullptr for other formats.
+    static ErrorOr<OwnPtr<IncrementalImageDecoderPlugin>> try_create_incremental_for_initial_bytes(ReadonlyBytes);
+    static constexpr size_t INCREMENTAL_SNIFF_BYTES = 16;
+
     ~ImageDecoder() = default;
 
     IntSize size() const { return m_plugin->size(); }
@@ -111,7 +144,8 @@ public:
     size_t frame_count() const { return m_plugin->frame_count(); }
     size_t first_animated_frame_index() const { return m_plugin->first_animated_frame_index(); }
 
-    ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) const { return m_plugin->frame(index, ideal_size); }
+    // Raster frames are never larger than needed to display them at ideal_size, see downscaled_size_for_ideal_size().
+    ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) const;
 
     Optional<Metadata const&> metadata() const { return m_plugin->metadata(); }
     ErrorOr<ColorSpace> color_space();
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteBuffer.h>
 #include <LibGfx/CMYKBitmap.h>
 #include <LibGfx/ImageFormats/JPEGLoader.h>
 #include <jpeglib.h>
@@ -26,19 +27,42 @@ struct JPEGLoadingContext {
     ReadonlyBytes data;
     Vector<u8> icc_data;
 
+    // The bitmaps may have been decoded at a reduced size, see decode().
+    IntSize natural_size;
+    unsigned scale_denominator { 1 };
+
     JPEGLoadingContext(ReadonlyBytes data)
         : data(data)
     {
     }
 
-    ErrorOr<void> decode();
+    ErrorOr<void> decode(Optional<IntSize> ideal_size);
+    bool decoded_bitmap_covers(Optional<IntSize> ideal_size) const;
 };
 
 struct JPEGErrorManager : jpeg_error_mgr {
     jmp_buf setjmp_buffer {};
 };
 
-ErrorOr<void> JPEGLoadingContext::decode()
+static void jpeg_error_exit(j_common_ptr cinfo)
+{
+    char buffer[JMSG_LENGTH_MAX];
+    (*cinfo->err->format_message)(cinfo, buffer);
+    dbgln("JPEG error: {}", buffer);
+    longjmp(static_cast<JPEGErrorManager*>(cinfo->err)->setjmp_buffer, 1);
+}
+
+bool JPEGLoadingContext::decoded_bitmap_covers(Optional<IntSize> ideal_size) const
+{
+    if (scale_denominator == 1)
+        return true;
+    if (!ideal_size.has_value())
+        return false;
+    auto decoded_size = rgb_bitmap->size();
+    return decoded_size.width() >= ideal_size->width() && decoded_size.height() >= ideal_size->height();
+}
+
+ErrorOr<void> JPEGLoadingContext::decode(Optional<IntSize> ideal_size)
 {
     struct jpeg_decompress_struct cinfo;
     ScopeGuard guard { [&]() { jpeg_destroy_decompress(&cinfo); } };
@@ -51,12 +75,7 @@ ErrorOr<void> JPEGLoadingContext::decode()
     if (setjmp(jerr.setjmp_buffer))
         return Error::from_string_literal("Failed to decode JPEG");
 
-    jerr.error_exit = [](j_common_ptr cinfo) {
-        char buffer[JMSG_LENGTH_MAX];
-        (*cinfo->err->format_message)(cinfo, buffer);
-        dbgln("JPEG error: {}", buffer);
-        longjmp(static_cast<JPEGErrorManager*>(cinfo->err)->setjmp_buffer, 1);
-    };
+    jerr.error_exit = jpeg_error_exit;
 
     jpeg_create_decompress(&cinfo);
 
@@ -81,6 +100,24 @@ ErrorOr<void> JPEGLoadingContext::decode()
     if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK)
         return Error::from_string_literal("Failed to read JPEG header");
 
+    natural_size = { static_cast<int>(cinfo.image_width), static_cast<int>(cinfo.image_height) };
+
+    // libjpeg can skip most of the IDCT work by decoding at 1/2, 1/4 or 1/8 of the size. Pick the smallest of those
+    // that still covers the ideal size; ImageDecoder takes care of scaling the rest of the way.
+    scale_denominator = 1;
+    if (ideal_size.has_value() && !ideal_size->is_empty()) {
+        for (unsigned denominator : { 8u, 4u, 2u }) {
+            auto scaled_width = ceil_div(cinfo.image_width, denominator);
+            auto scaled_height = ceil_div(cinfo.image_height, denominator);
+            if (scaled_width >= static_cast<unsigned>(ideal_size->width()) && scaled_height >= static_cast<unsigned>(ideal_size->height())) {
+                scale_denominator = denominator;
+                break;
+            }
+        }
+    }
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = scale_denominator;
+
     if (cinfo.jpeg_color_space == JCS_CMYK) {
         cinfo.out_color_space = JCS_CMYK;
     } else if (cinfo.jpeg_color_space == JCS_YCCK) {
@@ -170,6 +207,7 @@ ErrorOr<void> JPEGLoadingContext::decode()
 
     JOCTET* icc_data_ptr = nullptr;
     unsigned int icc_data_length = 0;
+    icc_data.clear();
     if (jpeg_read_icc_profile(&cinfo, &icc_data_ptr, &icc_data_length)) {
         icc_data.resize(icc_data_length);
         memcpy(icc_data.data(), icc_data_ptr, icc_data_length);
@@ -187,6 +225,177 @@ ErrorOr<void> JPEGLoadingContext::decode()
     return {};
 }
 
+// Uses libjpeg's suspending data source: whenever it runs out of data, libjpeg backs up to a point it can resume from,
+// and we try again once more data has been appended.
+class JPEGIncrementalDecoder final : public IncrementalImageDecoderPlugin {
+public:
+    static ErrorOr<NonnullOwnPtr<JPEGIncrementalDecoder>> create()
+    {
+        auto decoder = adopt_own(*new JPEGIncrementalDecoder);
+        decoder->m_cinfo.err = jpeg_std_error(&decoder->m_error_manager);
+        decoder->m_error_manager.error_exit = jpeg_error_exit;
+
+        if (setjmp(decoder->m_error_manager.setjmp_buffer))
+            return Error::from_string_literal("Failed to create JPEG decoder");
+        jpeg_create_decompress(&decoder->m_cinfo);
+        decoder->m_is_created = true;
+
+        auto& source = decoder->m_source;
+        source.init_source = [](j_decompress_ptr) { };
+        source.fill_input_buffer = [](j_decompress_ptr) -> boolean { return FALSE; };
+        source.skip_input_data = [](j_decompress_ptr context, long num_bytes) {
+            auto& source = *static_cast<SuspendingSource*>(context->src);
+            if (num_bytes <= 0)
+                return;
+            if (static_cast<size_t>(num_bytes) > source.bytes_in_buffer) {
+                // Skip the rest once it arrives.
+                source.bytes_to_skip += num_bytes - source.bytes_in_buffer;
+                source.next_input_byte += source.bytes_in_buffer;
+                source.bytes_in_buffer = 0;
+                return;
+            }
+            source.next_input_byte += num_bytes;
+            source.bytes_in_buffer -= num_bytes;
+        };
+        source.resync_to_restart = jpeg_resync_to_restart;
+        source.term_source = [](j_decompress_ptr) { };
+        decoder->m_cinfo.src = &source;
+
+        return decoder;
+    }
+
+    virtual ~JPEGIncrementalDecoder() override
+    {
+        if (m_is_created)
+            jpeg_destroy_decompress(&m_cinfo);
+    }
+
+    virtual ErrorOr<void> append(ReadonlyBytes bytes) override
+    {
+        if (m_state == State::Error)
+            return Error::from_string_literal("Failed to decode JPEG");
+        if (m_state == State::Done)
+            return {};
+
+        // Drop what libjpeg has consumed, it never backs up past that.
+        if (m_consumed > 0) {
+            memmove(m_data.data(), m_data.data() + m_consumed, m_data.size() - m_consumed);
+            m_data.resize(m_data.size() - m_consumed);
+            m_consumed = 0;
+        }
+        TRY(m_data.try_append(bytes));
+
+        auto skipped = min(m_source.bytes_to_skip, m_data.size());
+        m_source.bytes_to_skip -= skipped;
+        m_source.next_input_byte = m_data.data() + skipped;
+        m_source.bytes_in_buffer = m_data.size() - skipped;
+
+        auto result = decode_available_data();
+        m_consumed = m_source.next_input_byte - m_data.data();
+        if (result.is_error())
+            m_state = State::Error;
+        return result;
+    }
+
+    virtual size_t progress() const override { return m_progress; }
+
+    virtual ErrorOr<RefPtr<Bitmap>> partial_bitmap() const override
+    {
+        if (!m_bitmap)
+            return RefPtr<Bitmap> {};
+        return TRY(m_bitmap->clone());
+    }
+
+private:
+    struct SuspendingSource : jpeg_source_mgr {
+        size_t bytes_to_skip { 0 };
+    };
+
+    enum class State {
+        ReadingHeader,
+        StartingDecompress,
+        ReadingScanlines,
+        ReadingScans,
+        Done,
+        Error,
+    };
+
+    JPEGIncrementalDecoder() = default;
+
+    ErrorOr<void> decode_available_data()
+    {
+        if (setjmp(m_error_manager.setjmp_buffer))
+            return Error::from_string_literal("Failed to decode JPEG");
+
+        if (m_state == State::ReadingHeader) {
+            if (jpeg_read_header(&m_cinfo, TRUE) == JPEG_SUSPENDED)
+                return {};
+            if (m_cinfo.jpeg_color_space == JCS_CMYK || m_cinfo.jpeg_color_space == JCS_YCCK)
+                return Error::from_string_literal("Incremental decoding of CMYK JPEGs is not supported");
+
+            m_cinfo.out_color_space = JCS_EXT_BGRA;
+            m_cinfo.buffered_image = jpeg_has_multiple_scans(&m_cinfo);
+            m_state = State::StartingDecompress;
+        }
+
+        if (m_state == State::StartingDecompress) {
+            if (!jpeg_start_decompress(&m_cinfo))
+                return {};
+            m_bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, AlphaType::Premultiplied, { static_cast<int>(m_cinfo.output_width), static_cast<int>(m_cinfo.output_height) }));
+            m_state = m_cinfo.buffered_image ? State::ReadingScans : State::ReadingScanlines;
+        }
+
+        if (m_state == State::ReadingScanlines) {
+            while (m_cinfo.output_scanline < m_cinfo.output_height) {
+                auto* row = m_bitmap->scanline_u8(m_cinfo.output_scanline);
+                if (jpeg_read_scanlines(&m_cinfo, &row, 1) == 0)
+                    return {};
+                ++m_progress;
+            }
+            m_state = State::Done;
+        }
+
+        if (m_state == State::ReadingScans) {
+            int status;
+            do {
+                status = jpeg_consume_input(&m_cinfo);
+            } while (status != JPEG_SUSPENDED && status != JPEG_REACHED_EOI);
+
+            // Only output scans that have been received in full, so that outputting them never has to wait for data.
+            auto last_complete_scan = jpeg_input_complete(&m_cinfo) ? m_cinfo.input_scan_number : m_cinfo.input_scan_number - 1;
+            if (last_complete_scan > m_output_scan) {
+                jpeg_start_output(&m_cinfo, last_complete_scan);
+                while (m_cinfo.output_scanline < m_cinfo.output_height) {
+                    auto* row = m_bitmap->scanline_u8(m_cinfo.output_scanline);
+                    jpeg_read_scanlines(&m_cinfo, &row, 1);
+                }
+                jpeg_finish_output(&m_cinfo);
+                m_output_scan = last_complete_scan;
+                ++m_progress;
+            }
+            if (jpeg_input_complete(&m_cinfo) && m_output_scan == m_cinfo.input_scan_number)
+                m_state = State::Done;
+        }
+
+        return {};
+    }
+
+    jpeg_decompress_struct m_cinfo {};
+    JPEGErrorManager m_error_manager {};
+    SuspendingSource m_source {};
+    bool m_is_created { false };
+
+    State m_state { State::ReadingHeader };
+
+    // The data that libjpeg has not consumed yet, starting at m_consumed.
+    ByteBuffer m_data;
+    size_t m_consumed { 0 };
+
+    RefPtr<Bitmap> m_bitmap;
+    size_t m_progress { 0 };
+    int m_output_scan { 0 };
+};
+
 JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext> context)
     : m_context(move(context))
 {
@@ -201,11 +410,7 @@ IntSize JPEGImageDecoderPlugin::size()
 
     if (m_context->state == JPEGLoadingContext::State::Error)
         return {};
-    if (m_context->rgb_bitmap)
-        return m_context->rgb_bitmap->size();
-    if (m_context->cmyk_bitmap)
-        return m_context->cmyk_bitmap->size();
-    return {};
+    return m_context->natural_size;
 }
 
 bool JPEGImageDecoderPlugin::sniff(ReadonlyBytes data)
@@ -221,7 +426,12 @@ ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create(Readon
     return adopt_own(*new JPEGImageDecoderPlugin(make<JPEGLoadingContext>(data)));
 }
 
-ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<NonnullOwnPtr<IncrementalImageDecoderPlugin>> JPEGImageDecoderPlugin::create_incremental()
+{
+    return TRY(JPEGIncrementalDecoder::create());
+}
+
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index > 0)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
@@ -229,8 +439,15 @@ ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Option
     if (m_context->state == JPEGLoadingContext::State::Error)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
 
+    // A bitmap that was decoded at a reduced size for an earlier request may be too small for this one.
+    if (m_context->state == JPEGLoadingContext::State::Decoded && !m_context->decoded_bitmap_covers(ideal_size)) {
+        m_context->rgb_bitmap = nullptr;
+        m_context->cmyk_bitmap = nullptr;
+        m_context->state = JPEGLoadingContext::State::NotDecoded;
+    }
+
     if (m_context->state < JPEGLoadingContext::State::Decoded) {
-        if (auto result = m_context->decode(); result.is_error()) {
+        if (auto result = m_context->decode(ideal_size); result.is_error()) {
             m_context->state = JPEGLoadingContext::State::Error;
             return result.release_error();
         }
@@ -268,8 +485,8 @@ NaturalFrameFormat JPEGImageDecoderPlugin::natural_frame_format() const
 
 ErrorOr<NonnullRefPtr<CMYKBitmap>> JPEGImageDecoderPlugin::cmyk_frame()
 {
-    if (m_context->state == JPEGLoadingContext::State::NotDecoded)
-        (void)frame(0);
+    // This also makes sure that we have the full-size bitmap.
+    (void)frame(0);
 
     if (m_context->state == JPEGLoadingContext::State::Error)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
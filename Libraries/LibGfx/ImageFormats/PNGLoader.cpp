@@ -230,13 +230,7 @@ ErrorOr<void> PNGLoadingContext::apply_exif_orientation()
     for (auto& img_frame_descriptor : frame_descriptors) {
         auto& img = img_frame_descriptor.image;
         auto oriented_bmp = TRY(ExifOrientedBitmap::create(orientation, img->size(), img->format()));
-
-        for (int y = 0; y < img->size().height(); ++y) {
-            for (int x = 0; x < img->size().width(); ++x) {
-                auto pixel = img->get_pixel(x, y);
-                oriented_bmp.set_pixel(x, y, pixel.value());
-            }
-        }
+        oriented_bmp.set_pixels(*img);
 
         img_frame_descriptor.image = oriented_bmp.bitmap();
     }
@@ -362,6 +356,136 @@ ErrorOr<size_t> PNGLoadingContext::read_frames(png_structp png_ptr, png_infop in
 
 PNGImageDecoderPlugin::~PNGImageDecoderPlugin() = default;
 
+// Uses libpng's progressive reader, which hands us each row as soon as it has been decoded. For interlaced images, the
+// rows of each pass are combined with the ones of the previous passes.
+class PNGIncrementalDecoder final : public IncrementalImageDecoderPlugin {
+public:
+    static ErrorOr<NonnullOwnPtr<PNGIncrementalDecoder>> create()
+    {
+        auto decoder = adopt_own(*new PNGIncrementalDecoder);
+        decoder->m_png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, log_png_error, log_png_warning);
+        if (!decoder->m_png_ptr)
+            return Error::from_string_view("Failed to allocate read struct"sv);
+        decoder->m_info_ptr = png_create_info_struct(decoder->m_png_ptr);
+        if (!decoder->m_info_ptr)
+            return Error::from_string_view("Failed to allocate info struct"sv);
+
+        png_set_progressive_read_fn(decoder->m_png_ptr, decoder.ptr(), did_read_info, did_read_row, nullptr);
+        return decoder;
+    }
+
+    virtual ~PNGIncrementalDecoder() override
+    {
+        png_destroy_read_struct(&m_png_ptr, &m_info_ptr, nullptr);
+    }
+
+    virtual ErrorOr<void> append(ReadonlyBytes bytes) override
+    {
+        if (m_error.has_value())
+            return Error::copy(*m_error);
+
+        // NOTE: We need to setjmp() here because libpng uses longjmp() for error handling.
+        if (auto error_value = setjmp(png_jmpbuf(m_png_ptr)); error_value) {
+            m_error = Error::from_errno(error_value);
+            return Error::copy(*m_error);
+        }
+        png_process_data(m_png_ptr, m_info_ptr, const_cast<u8*>(bytes.data()), bytes.size());
+
+        if (m_error.has_value())
+            return Error::copy(*m_error);
+        return {};
+    }
+
+    virtual size_t progress() const override { return m_progress; }
+
+    virtual ErrorOr<RefPtr<Bitmap>> partial_bitmap() const override
+    {
+        if (!m_bitmap)
+            return RefPtr<Bitmap> {};
+        return TRY(m_bitmap->clone());
+    }
+
+private:
+    PNGIncrementalDecoder() = default;
+
+    // NOTE: These are called from within png_process_data(), so they must not longjmp() past our C++ objects. Errors
+    //       are recorded instead, and rows are ignored from then on.
+    static void did_read_info(png_structp png_ptr, png_infop info_ptr)
+    {
+        auto& decoder = *static_cast<PNGIncrementalDecoder*>(png_get_progressive_ptr(png_ptr));
+
+        if (png_get_valid(png_ptr, info_ptr, PNG_INFO_acTL)) {
+            decoder.m_error = Error::from_string_literal("Incremental decoding of APNGs is not supported");
+            return;
+        }
+        // The orientation is only applied once the complete image is decoded.
+        if (png_get_valid(png_ptr, info_ptr, PNG_INFO_eXIf)) {
+            decoder.m_error = Error::from_string_literal("Incremental decoding of PNGs with Exif metadata is not supported");
+            return;
+        }
+
+        u32 width = 0;
+        u32 height = 0;
+        int bit_depth = 0;
+        int color_type = 0;
+        int interlace_type = 0;
+        png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, &interlace_type, nullptr, nullptr);
+
+        if (color_type == PNG_COLOR_TYPE_PALETTE)
+            png_set_palette_to_rgb(png_ptr);
+
+        if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8)
+            png_set_expand_gray_1_2_4_to_8(png_ptr);
+
+        if (png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS))
+            png_set_tRNS_to_alpha(png_ptr);
+
+        if (bit_depth == 16)
+            png_set_strip_16(png_ptr);
+
+        if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
+            png_set_gray_to_rgb(png_ptr);
+
+        if (interlace_type != PNG_INTERLACE_NONE)
+            png_set_interlace_handling(png_ptr);
+
+        png_set_filler(png_ptr, 0xFF, PNG_FILLER_AFTER);
+        png_set_bgr(png_ptr);
+
+        png_read_update_info(png_ptr, info_ptr);
+
+        auto bitmap_or_error = Bitmap::create(BitmapFormat::BGRA8888, AlphaType::Unpremultiplied, { static_cast<int>(width), static_cast<int>(height) });
+        if (bitmap_or_error.is_error()) {
+            decoder.m_error = bitmap_or_error.release_error();
+            return;
+        }
+        decoder.m_bitmap = bitmap_or_error.release_value();
+    }
+
+    static void did_read_row(png_structp png_ptr, png_bytep new_row, png_uint_32 row_index, int)
+    {
+        auto& decoder = *static_cast<PNGIncrementalDecoder*>(png_get_progressive_ptr(png_ptr));
+
+        // libpng passes no row for the rows of an interlaced image that did not change in this pass.
+        if (!decoder.m_bitmap || !new_row || row_index >= static_cast<png_uint_32>(decoder.m_bitmap->height()))
+            return;
+        png_progressive_combine_row(png_ptr, decoder.m_bitmap->scanline_u8(row_index), new_row);
+        ++decoder.m_progress;
+    }
+
+    png_structp m_png_ptr { nullptr };
+    png_infop m_info_ptr { nullptr };
+
+    RefPtr<Bitmap> m_bitmap;
+    size_t m_progress { 0 };
+    Optional<Error> m_error;
+};
+
+ErrorOr<NonnullOwnPtr<IncrementalImageDecoderPlugin>> PNGImageDecoderPlugin::create_incremental()
+{
+    return TRY(PNGIncrementalDecoder::create());
+}
+
 bool PNGImageDecoderPlugin::sniff(ReadonlyBytes data)
 {
     auto constexpr png_signature_size_in_bytes = 8;
@@ -9,6 +9,7 @@
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/PNGWriter.h>
 #include <png.h>
+#include <zlib.h>
 
 namespace Gfx {
 
@@ -53,6 +54,23 @@ ErrorOr<ByteBuffer> PNGWriter::encode(Gfx::Bitmap const& bitmap, Options options
 
     png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_RGBA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
 
+    switch (options.compression_level) {
+    case Compress::GenericZlibCompressionLevel::VeryFast:
+        // The Sub filter turns runs of similar pixels into runs of zeroes, which is all that run-length matching finds.
+        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
+        png_set_compression_level(png_ptr, Z_BEST_SPEED);
+        png_set_compression_strategy(png_ptr, Z_RLE);
+        break;
+    case Compress::GenericZlibCompressionLevel::Fastest:
+        png_set_compression_level(png_ptr, Z_BEST_SPEED);
+        break;
+    case Compress::GenericZlibCompressionLevel::Default:
+        break;
+    case Compress::GenericZlibCompressionLevel::Best:
+        png_set_compression_level(png_ptr, Z_BEST_COMPRESSION);
+        break;
+    }
+
     context->row_pointers.resize(height);
     for (int y = 0; y < height; ++y) {
         context->row_pointers[y] = const_cast<u8*>(bitmap.scanline_u8(y));
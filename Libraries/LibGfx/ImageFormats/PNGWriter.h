@@ -9,6 +9,7 @@
 #include <AK/Forward.h>
 #include <AK/Optional.h>
 #include <AK/Span.h>
+#include <LibCompress/GenericZlib.h>
 #include <LibGfx/Forward.h>
 
 namespace Gfx {
@@ -18,6 +19,9 @@ struct PNGWriterOptions {
     // Data for the iCCP chunk.
     // FIXME: Allow writing cICP, sRGB, or gAMA instead too.
     Optional<ReadonlyBytes> icc_data;
+
+    // VeryFast also skips trying out the different row filters, for images that are only written to be read back soon.
+    Compress::GenericZlibCompressionLevel compression_level { Compress::GenericZlibCompressionLevel::Default };
 };
 
 class PNGWriter {
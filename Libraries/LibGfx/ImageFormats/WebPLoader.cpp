@@ -115,7 +115,37 @@ static ErrorOr<void> decode_webp_header(WebPLoadingContext& context)
     return {};
 }
 
-static ErrorOr<void> decode_webp_image(WebPLoadingContext& context)
+static ErrorOr<NonnullRefPtr<Bitmap>> decode_webp_still_image(WebPLoadingContext& context, Optional<IntSize> ideal_size)
+{
+    WebPDecoderConfig config;
+    if (!WebPInitDecoderConfig(&config))
+        return Error::from_string_literal("Failed to initialize WebP decoder config");
+
+    // libwebp can scale while decoding, which is a lot cheaper than decoding at full size and scaling afterwards.
+    auto size = downscaled_size_for_ideal_size(context.size, ideal_size);
+    if (size != context.size) {
+        config.options.use_scaling = 1;
+        config.options.scaled_width = size.width();
+        config.options.scaled_height = size.height();
+    }
+
+    auto bitmap_format = context.has_alpha ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888;
+    auto bitmap = TRY(Bitmap::create(bitmap_format, Gfx::AlphaType::Unpremultiplied, size));
+
+    config.output.colorspace = MODE_BGRA;
+    config.output.is_external_memory = 1;
+    config.output.u.RGBA.rgba = bitmap->scanline_u8(0);
+    config.output.u.RGBA.stride = bitmap->pitch();
+    config.output.u.RGBA.size = bitmap->data_size();
+    ScopeGuard guard { [&] { WebPFreeDecBuffer(&config.output); } };
+
+    if (WebPDecode(context.data.data(), context.data.size(), &config) != VP8_STATUS_OK)
+        return Error::from_string_literal("Failed to decode webp image into bitmap");
+
+    return bitmap;
+}
+
+static ErrorOr<void> decode_webp_image(WebPLoadingContext& context, Optional<IntSize> ideal_size)
 {
     VERIFY(context.state >= WebPLoadingContext::State::HeaderDecoded);
 
@@ -149,12 +179,7 @@ static ErrorOr<void> decode_webp_image(WebPLoadingContext& context)
             context.frame_descriptors.append(ImageFrameDescriptor { bitmap, duration });
         }
     } else {
-        auto bitmap_format = context.has_alpha ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888;
-        auto bitmap = TRY(Bitmap::create(bitmap_format, Gfx::AlphaType::Unpremultiplied, context.size));
-
-        auto image_data = WebPDecodeBGRAInto(context.data.data(), context.data.size(), bitmap->scanline_u8(0), bitmap->data_size(), bitmap->pitch());
-        if (image_data == nullptr)
-            return Error::from_string_literal("Failed to decode webp image into bitmap");
+        auto bitmap = TRY(decode_webp_still_image(context, ideal_size));
 
         auto duration = 0;
         context.frame_descriptors.append(ImageFrameDescriptor { bitmap, duration });
@@ -170,6 +195,78 @@ bool WebPImageDecoderPlugin::sniff(ReadonlyBytes data)
     return !decode_webp_header(context).is_error();
 }
 
+bool WebPImageDecoderPlugin::sniff_riff_header(ReadonlyBytes data)
+{
+    return data.size() >= 12
+        && data.slice(0, 4) == "RIFF"sv.bytes()
+        && data.slice(8, 4) == "WEBP"sv.bytes();
+}
+
+// Uses libwebp's incremental decoder, which decodes straight into our bitmap as data arrives.
+class WebPIncrementalDecoder final : public IncrementalImageDecoderPlugin {
+public:
+    virtual ~WebPIncrementalDecoder() override
+    {
+        if (m_decoder)
+            WebPIDelete(m_decoder);
+    }
+
+    virtual ErrorOr<void> append(ReadonlyBytes bytes) override
+    {
+        if (!m_decoder) {
+            // We need to know the size before we can create the bitmap to decode into.
+            TRY(m_header_data.try_append(bytes));
+
+            WebPBitstreamFeatures features {};
+            auto status = WebPGetFeatures(m_header_data.data(), m_header_data.size(), &features);
+            if (status == VP8_STATUS_NOT_ENOUGH_DATA)
+                return {};
+            if (status != VP8_STATUS_OK)
+                return Error::from_string_literal("Failed to get WebP bitstream features");
+            if (features.has_animation)
+                return Error::from_string_literal("Incremental decoding of animated WebPs is not supported");
+
+            m_bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, AlphaType::Unpremultiplied, { features.width, features.height }));
+            m_decoder = WebPINewRGB(MODE_BGRA, m_bitmap->scanline_u8(0), m_bitmap->data_size(), m_bitmap->pitch());
+            if (!m_decoder)
+                return Error::from_string_literal("Failed to create WebP incremental decoder");
+
+            bytes = m_header_data.bytes();
+        }
+
+        auto status = WebPIAppend(m_decoder, bytes.data(), bytes.size());
+        m_header_data.clear();
+        if (status != VP8_STATUS_OK && status != VP8_STATUS_SUSPENDED)
+            return Error::from_string_literal("Failed to decode webp image into bitmap");
+
+        int last_row = 0;
+        if (WebPIDecGetRGB(m_decoder, &last_row, nullptr, nullptr, nullptr))
+            m_progress = last_row;
+        return {};
+    }
+
+    virtual size_t progress() const override { return m_progress; }
+
+    virtual ErrorOr<RefPtr<Bitmap>> partial_bitmap() const override
+    {
+        if (!m_bitmap)
+            return RefPtr<Bitmap> {};
+        return TRY(m_bitmap->clone());
+    }
+
+private:
+    WebPIDecoder* m_decoder { nullptr };
+    ByteBuffer m_header_data;
+
+    RefPtr<Bitmap> m_bitmap;
+    size_t m_progress { 0 };
+};
+
+ErrorOr<NonnullOwnPtr<IncrementalImageDecoderPlugin>> WebPImageDecoderPlugin::create_incremental()
+{
+    return TRY(adopt_nonnull_own_or_enomem(new (nothrow) WebPIncrementalDecoder));
+}
+
 ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> WebPImageDecoderPlugin::create(ReadonlyBytes data)
 {
     auto context = TRY(try_make<WebPLoadingContext>());
@@ -204,7 +301,7 @@ size_t WebPImageDecoderPlugin::first_animated_frame_index()
     return 0;
 }
 
-ErrorOr<ImageFrameDescriptor> WebPImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+ErrorOr<ImageFrameDescriptor> WebPImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index >= frame_count())
         return Error::from_string_literal("WebPImageDecoderPlugin: Invalid frame index");
@@ -212,8 +309,18 @@ ErrorOr<ImageFrameDescriptor> WebPImageDecoderPlugin::frame(size_t index, Option
     if (m_context->state == WebPLoadingContext::State::Error)
         return Error::from_string_literal("WebPImageDecoderPlugin: Decoding failed");
 
+    // A still image that was decoded at a reduced size for an earlier request may be too small for this one.
+    if (m_context->state == WebPLoadingContext::State::BitmapDecoded && !m_context->has_animation) {
+        auto decoded_size = m_context->frame_descriptors.first().image->size();
+        auto needed_size = downscaled_size_for_ideal_size(m_context->size, ideal_size);
+        if (decoded_size.width() < needed_size.width() || decoded_size.height() < needed_size.height()) {
+            m_context->frame_descriptors.clear();
+            m_context->state = WebPLoadingContext::State::HeaderDecoded;
+        }
+    }
+
     if (m_context->state < WebPLoadingContext::State::BitmapDecoded) {
-        TRY(decode_webp_image(*m_context));
+        TRY(decode_webp_image(*m_context, ideal_size));
         m_context->state = WebPLoadingContext::State::BitmapDecoded;
     }
 
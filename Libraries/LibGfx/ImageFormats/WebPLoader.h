@@ -17,6 +17,10 @@ public:
     static bool sniff(ReadonlyBytes);
     static ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> create(ReadonlyBytes);
 
+    // Only checks the RIFF container, so it works on the first few bytes of a file.
+    static bool sniff_riff_header(ReadonlyBytes);
+    static ErrorOr<NonnullOwnPtr<IncrementalImageDecoderPlugin>> create_incremental();
+
     virtual ~WebPImageDecoderPlugin() override;
 
     virtual IntSize size() override;
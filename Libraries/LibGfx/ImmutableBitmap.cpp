@@ -4,20 +4,28 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <LibGfx/ImmutableBitmap.h>
 #include <LibGfx/PaintingSurface.h>
 #include <LibGfx/SkiaUtils.h>
+#include <LibGfx/YUVData.h>
 
 #include <core/SkBitmap.h>
+#include <core/SkCanvas.h>
 #include <core/SkColorSpace.h>
+#include <core/SkData.h>
 #include <core/SkImage.h>
+#include <core/SkM44.h>
+#include <core/SkPicture.h>
+#include <core/SkPictureRecorder.h>
+#include <effects/SkRuntimeEffect.h>
 
 namespace Gfx {
 
 struct ImmutableBitmapImpl {
     sk_sp<SkImage> sk_image;
     SkBitmap sk_bitmap;
-    Variant<NonnullRefPtr<Gfx::Bitmap>, NonnullRefPtr<Gfx::PaintingSurface>, Empty> source;
+    Variant<NonnullRefPtr<Gfx::Bitmap>, NonnullRefPtr<Gfx::PaintingSurface>, NonnullRefPtr<Gfx::YUVData>, Empty> source;
     ColorSpace color_space;
 };
 
@@ -51,15 +59,28 @@ SkImage const* ImmutableBitmap::sk_image() const
     return m_impl->sk_image.get();
 }
 
+static ErrorOr<NonnullRefPtr<Gfx::Bitmap>> rasterize(SkImage const& image, IntRect rect)
+{
+    auto bitmap = TRY(Gfx::Bitmap::create(BitmapFormat::BGRA8888, AlphaType::Premultiplied, rect.size()));
+    auto info = SkImageInfo::Make(rect.width(), rect.height(), kBGRA_8888_SkColorType, kPremul_SkAlphaType, SkColorSpace::MakeSRGB());
+    if (!image.readPixels(info, bitmap->scanline(0), bitmap->pitch(), rect.x(), rect.y()))
+        return Error::from_string_literal("Failed to rasterize image");
+    return bitmap;
+}
+
 RefPtr<Gfx::Bitmap const> ImmutableBitmap::bitmap() const
 {
     // FIXME: Implement for PaintingSurface
+    if (m_impl->source.has<NonnullRefPtr<Gfx::YUVData>>())
+        return MUST(rasterize(*m_impl->sk_image, rect()));
     return m_impl->source.get<NonnullRefPtr<Gfx::Bitmap>>();
 }
 
 Color ImmutableBitmap::get_pixel(int x, int y) const
 {
     // FIXME: Implement for PaintingSurface
+    if (m_impl->source.has<NonnullRefPtr<Gfx::YUVData>>())
+        return MUST(rasterize(*m_impl->sk_image, { x, y, 1, 1 }))->get_pixel(0, 0);
     return m_impl->source.get<NonnullRefPtr<Gfx::Bitmap>>()->get_pixel(x, y);
 }
 
@@ -108,6 +129,144 @@ NonnullRefPtr<ImmutableBitmap> ImmutableBitmap::create_snapshot_from_painting_su
     return adopt_ref(*new ImmutableBitmap(make<ImmutableBitmapImpl>(impl)));
 }
 
+struct LumaCoefficients {
+    float red;
+    float blue;
+};
+
+static ErrorOr<LumaCoefficients> luma_coefficients(Media::MatrixCoefficients matrix_coefficients)
+{
+    switch (matrix_coefficients) {
+    case Media::MatrixCoefficients::BT470BG:
+    case Media::MatrixCoefficients::BT601:
+        return LumaCoefficients { 0.299f, 0.114f };
+    case Media::MatrixCoefficients::BT709:
+        return LumaCoefficients { 0.2126f, 0.0722f };
+    case Media::MatrixCoefficients::BT2020NonConstantLuminance:
+        return LumaCoefficients { 0.2627f, 0.0593f };
+    default:
+        return Error::from_string_literal("Unsupported matrix coefficients for Y'CbCr conversion");
+    }
+}
+
+static sk_sp<SkRuntimeEffect> const& yuv_to_rgb_effect()
+{
+    static sk_sp<SkRuntimeEffect> effect = [] {
+        auto [effect, error] = SkRuntimeEffect::MakeForShader(SkString(R"(
+            uniform shader y_plane;
+            uniform shader u_plane;
+            uniform shader v_plane;
+            uniform float2 chroma_scale;
+            uniform float3 sample_scale;
+            uniform float3 sample_offset;
+            uniform float3x3 yuv_to_rgb;
+
+            half4 main(float2 coord) {
+                float2 chroma_coord = coord * chroma_scale;
+                float3 yuv = float3(y_plane.eval(coord).a, u_plane.eval(chroma_coord).a, v_plane.eval(chroma_coord).a);
+                return half4(saturate(yuv_to_rgb * (yuv * sample_scale + sample_offset)), 1.0);
+            }
+        )"));
+        if (!effect) {
+            dbgln("SkSL error: {}", error.c_str());
+            VERIFY_NOT_REACHED();
+        }
+        return effect;
+    }();
+    return effect;
+}
+
+ErrorOr<NonnullRefPtr<ImmutableBitmap>> ImmutableBitmap::create_from_yuv(NonnullRefPtr<YUVData> yuv_data)
+{
+    auto cicp = yuv_data->cicp();
+    auto [kr, kb] = TRY(luma_coefficients(cicp.matrix_coefficients()));
+
+    // HDR content has to be tone mapped, which only the software conversion does.
+    if (cicp.transfer_characteristics() == Media::TransferCharacteristics::SMPTE2084 || cicp.transfer_characteristics() == Media::TransferCharacteristics::HLG)
+        return Error::from_string_literal("Y'CbCr conversion of HDR content is not supported");
+
+    // The shader only undoes the matrix coefficients and range, so its output is in the frame's RGB color space.
+    auto rgb_cicp = cicp;
+    rgb_cicp.set_matrix_coefficients(Media::MatrixCoefficients::Identity);
+    rgb_cicp.set_video_full_range_flag(Media::VideoFullRangeFlag::Full);
+    auto color_space = TRY(ColorSpace::from_cicp(rgb_cicp));
+    auto sk_color_space = color_space.color_space<sk_sp<SkColorSpace>>();
+
+    // Each plane is sampled as an alpha-only image. Skia reads the planes in place, and holds a reference to the
+    // frame for as long as it does.
+    auto color_type = yuv_data->component_size() == 1 ? kAlpha_8_SkColorType : kA16_unorm_SkColorType;
+    Array<sk_sp<SkImage>, 3> plane_images;
+    for (size_t plane = 0; plane < 3; ++plane) {
+        auto plane_size = yuv_data->plane_size(plane);
+        auto plane_data = yuv_data->plane_data(plane);
+        yuv_data->ref();
+        auto data = SkData::MakeWithProc(plane_data.data(), plane_data.size(), [](void const*, void* context) { static_cast<YUVData*>(context)->unref(); }, yuv_data.ptr());
+        auto info = SkImageInfo::Make(plane_size.width(), plane_size.height(), color_type, kPremul_SkAlphaType);
+        plane_images[plane] = SkImages::RasterFromData(info, move(data), yuv_data->plane_pitch(plane));
+        if (!plane_images[plane])
+            return Error::from_string_literal("Failed to create Y'CbCr plane image");
+    }
+
+    // Samples are read normalized to the range of their storage type, and have to be scaled to 0..1 for Y' and
+    // -0.5..0.5 for Cb and Cr according to the bit depth and range of the frame.
+    auto bit_depth = yuv_data->bit_depth();
+    float storage_maximum = yuv_data->component_size() == 1 ? 255.0f : 65535.0f;
+    float y_scale;
+    float y_offset;
+    float uv_scale;
+    float uv_offset;
+    if (cicp.video_full_range_flag() == Media::VideoFullRangeFlag::Studio) {
+        float range_multiplier = static_cast<float>(1u << bit_depth) / 256.0f;
+        y_scale = storage_maximum / (219.0f * range_multiplier);
+        y_offset = -16.0f / 219.0f;
+        uv_scale = storage_maximum / (224.0f * range_multiplier);
+        uv_offset = -128.0f / 224.0f;
+    } else {
+        float sample_maximum = static_cast<float>((1u << bit_depth) - 1);
+        y_scale = storage_maximum / sample_maximum;
+        y_offset = 0.0f;
+        uv_scale = y_scale;
+        uv_offset = -static_cast<float>(1u << (bit_depth - 1)) / sample_maximum;
+    }
+
+    // https://kdashg.github.io/misc/colors/from-coeffs.html
+    float kg = 1.0f - kr - kb;
+    float yuv_to_rgb[9] = {
+        1.0f, 1.0f, 1.0f,                                          // y
+        0.0f, -2.0f * kb * (1.0f - kb) / kg, 2.0f * (1.0f - kb), // u
+        2.0f * (1.0f - kr), -2.0f * kr * (1.0f - kr) / kg, 0.0f, // v
+    };
+
+    auto luma_size = yuv_data->plane_size(0);
+    auto chroma_size = yuv_data->plane_size(1);
+
+    SkRuntimeShaderBuilder builder(yuv_to_rgb_effect());
+    builder.child("y_plane") = plane_images[0]->makeShader(SkTileMode::kClamp, SkTileMode::kClamp, SkSamplingOptions(SkFilterMode::kNearest));
+    builder.child("u_plane") = plane_images[1]->makeShader(SkTileMode::kClamp, SkTileMode::kClamp, SkSamplingOptions(SkFilterMode::kLinear));
+    builder.child("v_plane") = plane_images[2]->makeShader(SkTileMode::kClamp, SkTileMode::kClamp, SkSamplingOptions(SkFilterMode::kLinear));
+    builder.uniform("chroma_scale") = SkV2 { static_cast<float>(chroma_size.width()) / luma_size.width(), static_cast<float>(chroma_size.height()) / luma_size.height() };
+    builder.uniform("sample_scale") = SkV3 { y_scale, uv_scale, uv_scale };
+    builder.uniform("sample_offset") = SkV3 { y_offset, uv_offset, uv_offset };
+    builder.uniform("yuv_to_rgb").set(yuv_to_rgb, 9);
+
+    // Record the conversion into a picture, so that it runs on whichever backend the image is drawn with. The texture
+    // cache of a GPU backend renders it into a texture once per frame.
+    SkPictureRecorder recorder;
+    auto* canvas = recorder.beginRecording(SkRect::MakeIWH(luma_size.width(), luma_size.height()));
+    SkPaint paint;
+    paint.setShader(builder.makeShader()->makeWithWorkingColorSpace(sk_color_space));
+    paint.setBlendMode(SkBlendMode::kSrc);
+    canvas->drawPaint(paint);
+
+    ImmutableBitmapImpl impl;
+    impl.sk_image = SkImages::DeferredFromPicture(recorder.finishRecordingAsPicture(), SkISize::Make(luma_size.width(), luma_size.height()), nullptr, nullptr, SkImages::BitDepth::kU8, sk_color_space);
+    if (!impl.sk_image)
+        return Error::from_string_literal("Failed to create Y'CbCr image");
+    impl.source = move(yuv_data);
+    impl.color_space = move(color_space);
+    return adopt_ref(*new ImmutableBitmap(make<ImmutableBitmapImpl>(move(impl))));
+}
+
 ImmutableBitmap::ImmutableBitmap(NonnullOwnPtr<ImmutableBitmapImpl> impl)
     : m_impl(move(impl))
 {
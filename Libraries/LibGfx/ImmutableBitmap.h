@@ -26,6 +26,11 @@ public:
     static NonnullRefPtr<ImmutableBitmap> create(NonnullRefPtr<Bitmap> bitmap, AlphaType, ColorSpace color_space = {});
     static NonnullRefPtr<ImmutableBitmap> create_snapshot_from_painting_surface(NonnullRefPtr<PaintingSurface>);
 
+    // Creates a bitmap that is converted from Y'CbCr to RGB by a shader whenever it is drawn, which runs on the GPU when
+    // painting with a GPU backend. This fails for frames that can't be converted that way, which have to be converted
+    // to a Bitmap instead.
+    static ErrorOr<NonnullRefPtr<ImmutableBitmap>> create_from_yuv(NonnullRefPtr<YUVData>);
+
     ~ImmutableBitmap();
 
     int width() const;
@@ -173,6 +173,11 @@ void PaintingSurface::write_from_bitmap(Bitmap const& bitmap)
     m_impl->surface->writePixels(pixmap, 0, 0);
 }
 
+Bitmap* PaintingSurface::bitmap() const
+{
+    return m_impl->bitmap;
+}
+
 IntSize PaintingSurface::size() const
 {
     return m_impl->size;
@@ -54,6 +54,9 @@ public:
     SkCanvas& canvas() const;
     SkSurface& sk_surface() const;
 
+    // The bitmap this surface paints into, if it's not backed by the GPU.
+    Bitmap* bitmap() const;
+
     template<typename T>
     T sk_image_snapshot() const;
 
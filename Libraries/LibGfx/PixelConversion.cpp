@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/SIMDExtras.h>
+#include <LibGfx/PixelConversion.h>
+
+namespace Gfx {
+
+using AK::SIMD::expand4;
+using AK::SIMD::load_unaligned;
+using AK::SIMD::store_unaligned;
+using AK::SIMD::u32x4;
+
+static constexpr size_t pixels_per_vector = AK::SIMD::vector_length<u32x4>;
+
+// Same as x / 255 for all x < 65535, without a division.
+ALWAYS_INLINE static u32x4 divide_by_255(u32x4 x)
+{
+    return (x + 1 + (x >> 8)) >> 8;
+}
+
+ALWAYS_INLINE static u32x4 channel(u32x4 pixels, u32 shift)
+{
+    return (pixels >> shift) & 0xff;
+}
+
+ALWAYS_INLINE static bool all_opaque(u32x4 pixels)
+{
+    auto alpha = pixels >> 24;
+    return (alpha[0] & alpha[1] & alpha[2] & alpha[3]) == 0xff;
+}
+
+void premultiply_alpha(Span<ARGB32> pixels)
+{
+    size_t i = 0;
+    for (; i + pixels_per_vector <= pixels.size(); i += pixels_per_vector) {
+        auto vector = load_unaligned<u32x4>(&pixels[i]);
+        if (all_opaque(vector))
+            continue;
+
+        // Matches Color::to_premultiplied(), which rounds to nearest.
+        auto alpha = vector >> 24;
+        auto premultiply = [&](u32 shift) { return divide_by_255(channel(vector, shift) * alpha + 127) << shift; };
+        store_unaligned(&pixels[i], (alpha << 24) | premultiply(16) | premultiply(8) | premultiply(0));
+    }
+
+    for (; i < pixels.size(); ++i)
+        pixels[i] = Color::from_argb(pixels[i]).to_premultiplied().value();
+}
+
+// Reciprocals of every alpha value, with 24 bits of fraction, so that unpremultiplying takes a multiplication rather than
+// a division. They are rounded up, which makes the quotients exact for every value Color::to_unpremultiplied() divides.
+static constexpr auto s_alpha_reciprocals = [] {
+    Array<u64, 256> reciprocals {};
+    for (u64 alpha = 1; alpha < 256; ++alpha)
+        reciprocals[alpha] = (1ull << 24) / alpha + 1;
+    return reciprocals;
+}();
+
+void unpremultiply_alpha(Span<ARGB32> pixels)
+{
+    auto unpremultiply = [](ARGB32 pixel) -> ARGB32 {
+        u32 alpha = pixel >> 24;
+        if (alpha == 0)
+            return 0;
+        if (alpha == 0xff)
+            return pixel;
+
+        // Matches Color::to_unpremultiplied(), which rounds to nearest.
+        auto reciprocal = s_alpha_reciprocals[alpha];
+        auto unpremultiply_channel = [&](u32 shift) -> u32 {
+            u64 dividend = ((pixel >> shift) & 0xff) * 255u + alpha / 2;
+            return min<u32>(255u, (dividend * reciprocal) >> 24) << shift;
+        };
+        return (alpha << 24) | unpremultiply_channel(16) | unpremultiply_channel(8) | unpremultiply_channel(0);
+    };
+
+    size_t i = 0;
+    for (; i + pixels_per_vector <= pixels.size(); i += pixels_per_vector) {
+        // Most pixels of most images are opaque, and those stay as they are.
+        if (all_opaque(load_unaligned<u32x4>(&pixels[i])))
+            continue;
+        for (size_t j = i; j < i + pixels_per_vector; ++j)
+            pixels[j] = unpremultiply(pixels[j]);
+    }
+
+    for (; i < pixels.size(); ++i)
+        pixels[i] = unpremultiply(pixels[i]);
+}
+
+void convert_cmyk_to_bgrx(ReadonlySpan<CMYK> cmyk_pixels, Span<ARGB32> pixels)
+{
+    static_assert(sizeof(CMYK) == sizeof(u32));
+    VERIFY(cmyk_pixels.size() == pixels.size());
+
+    size_t i = 0;
+    for (; i + pixels_per_vector <= pixels.size(); i += pixels_per_vector) {
+        // Each lane holds one CMYK pixel, with cyan in its lowest byte.
+        auto vector = load_unaligned<u32x4>(&cmyk_pixels[i]);
+        auto black = expand4(255u) - channel(vector, 24);
+        auto convert = [&](u32 shift) { return divide_by_255((expand4(255u) - channel(vector, shift)) * black); };
+        store_unaligned(&pixels[i], expand4(0xff000000u) | (convert(0) << 16) | (convert(8) << 8) | convert(16));
+    }
+
+    for (; i < pixels.size(); ++i) {
+        auto const& cmyk = cmyk_pixels[i];
+        u8 k = 255 - cmyk.k;
+        pixels[i] = Color((255 - cmyk.c) * k / 255, (255 - cmyk.m) * k / 255, (255 - cmyk.y) * k / 255).value();
+    }
+}
+
+}
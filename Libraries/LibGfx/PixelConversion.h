@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <LibGfx/CMYKBitmap.h>
+#include <LibGfx/Color.h>
+
+namespace Gfx {
+
+// Conversions of whole rows of pixels, for decoders and bitmaps that would otherwise convert them one at a time. They
+// work on several pixels at once, and give the same results as the corresponding Color methods.
+
+// Alpha is in the top byte of both BGRA8888 and RGBA8888 pixels, so these work for either.
+void premultiply_alpha(Span<ARGB32>);
+void unpremultiply_alpha(Span<ARGB32>);
+
+// Same as CMYKBitmap::to_low_quality_rgb().
+void convert_cmyk_to_bgrx(ReadonlySpan<CMYK>, Span<ARGB32>);
+
+}
@@ -13,8 +13,9 @@
 
 namespace Gfx {
 
-ShareableBitmap::ShareableBitmap(NonnullRefPtr<Bitmap> bitmap, Tag)
+ShareableBitmap::ShareableBitmap(NonnullRefPtr<Bitmap> bitmap, Tag, Access access)
     : m_bitmap(move(bitmap))
+    , m_access(access)
 {
 }
 
@@ -34,6 +35,7 @@ ErrorOr<void> encode(Encoder& encoder, Gfx::ShareableBitmap const& shareable_bit
     TRY(encoder.encode(bitmap.size()));
     TRY(encoder.encode(static_cast<u32>(bitmap.format())));
     TRY(encoder.encode(static_cast<u32>(bitmap.alpha_type())));
+    TRY(encoder.encode(shareable_bitmap.access() == Gfx::ShareableBitmap::Access::ReadOnly));
     return {};
 }
 
@@ -56,10 +58,16 @@ ErrorOr<Gfx::ShareableBitmap> decode(Decoder& decoder)
         return Error::from_string_literal("IPC: Invalid Gfx::ShareableBitmap alpha type");
     auto alpha_type = static_cast<Gfx::AlphaType>(raw_alpha_type);
 
-    auto buffer = TRY(Core::AnonymousBuffer::create_from_anon_fd(anon_file.take_fd(), Gfx::Bitmap::size_in_bytes(Gfx::Bitmap::minimum_pitch(size.width(), bitmap_format), size.height())));
+    auto is_read_only = TRY(decoder.decode<bool>());
+    auto access = is_read_only ? Gfx::ShareableBitmap::Access::ReadOnly : Gfx::ShareableBitmap::Access::ReadWrite;
+
+    auto buffer_size = Gfx::Bitmap::size_in_bytes(Gfx::Bitmap::minimum_pitch(size.width(), bitmap_format), size.height());
+    auto buffer = is_read_only
+        ? TRY(Core::AnonymousBuffer::create_read_only_from_anon_fd(anon_file.take_fd(), buffer_size))
+        : TRY(Core::AnonymousBuffer::create_from_anon_fd(anon_file.take_fd(), buffer_size));
     auto bitmap = TRY(Gfx::Bitmap::create_with_anonymous_buffer(bitmap_format, alpha_type, move(buffer), size));
 
-    return Gfx::ShareableBitmap { move(bitmap), Gfx::ShareableBitmap::ConstructWithKnownGoodBitmap };
+    return Gfx::ShareableBitmap { move(bitmap), Gfx::ShareableBitmap::ConstructWithKnownGoodBitmap, access };
 }
 
 }
@@ -17,9 +17,17 @@ public:
     ShareableBitmap() = default;
 
     enum Tag { ConstructWithKnownGoodBitmap };
-    ShareableBitmap(NonnullRefPtr<Gfx::Bitmap>, Tag);
+
+    // Bitmaps that are shared with more than one process are mapped read-only by the receiver.
+    enum class Access {
+        ReadWrite,
+        ReadOnly,
+    };
+
+    ShareableBitmap(NonnullRefPtr<Gfx::Bitmap>, Tag, Access = Access::ReadWrite);
 
     bool is_valid() const { return m_bitmap; }
+    Access access() const { return m_access; }
 
     Bitmap const* bitmap() const { return m_bitmap; }
     Bitmap* bitmap() { return m_bitmap; }
@@ -28,6 +36,7 @@ private:
     friend class Bitmap;
 
     RefPtr<Bitmap> m_bitmap;
+    Access m_access { Access::ReadWrite };
 };
 
 }
@@ -4,13 +4,19 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/RefPtr.h>
+#include <AK/Vector.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/ImmutableBitmap.h>
 #include <LibGfx/SkiaBackendContext.h>
 
+#include <core/SkImage.h>
 #include <core/SkSurface.h>
 #include <gpu/GrDirectContext.h>
+#include <gpu/ganesh/SkImageGanesh.h>
 
 #ifdef USE_VULKAN
 #    include <gpu/ganesh/vk/GrVkDirectContext.h>
@@ -27,6 +33,114 @@
 
 namespace Gfx {
 
+struct SkiaBackendContext::TextureCache {
+    static constexpr size_t MAXIMUM_ENTRY_SIZE = 32 * MiB;
+    static constexpr size_t MAXIMUM_SIZE = 256 * MiB;
+
+    struct Entry {
+        sk_sp<SkImage> texture;
+        size_t size_in_bytes { 0 };
+        u32 image_id { 0 };
+        IntrusiveListNode<Entry> list_node;
+    };
+
+    // Keyed by the unique id of the raster image of an ImmutableBitmap, which is never reused within a process. Entries
+    // of bitmaps that are gone are never used again, and make their way to the front of the list to be evicted.
+    HashMap<u32, NonnullOwnPtr<Entry>> entries;
+    IntrusiveList<&Entry::list_node> lru_list;
+    size_t size { 0 };
+    TextureCacheStatistics statistics;
+
+    Threading::Mutex prepared_bitmaps_mutex;
+    Vector<NonnullRefPtr<ImmutableBitmap const>> prepared_bitmaps;
+
+    void remove_entry(Entry& entry)
+    {
+        lru_list.remove(entry);
+        size -= entry.size_in_bytes;
+        entries.remove(entry.image_id);
+    }
+};
+
+SkiaBackendContext::SkiaBackendContext()
+    : m_texture_cache(make<TextureCache>())
+{
+}
+
+SkiaBackendContext::~SkiaBackendContext() = default;
+
+SkImage const* SkiaBackendContext::texture_for_bitmap(ImmutableBitmap const& bitmap)
+{
+    auto const* image = bitmap.sk_image();
+    if (image->isTextureBacked())
+        return image;
+
+    auto& cache = *m_texture_cache;
+    if (auto entry = cache.entries.get(image->uniqueID()); entry.has_value()) {
+        cache.lru_list.remove(**entry);
+        cache.lru_list.append(**entry);
+        ++cache.statistics.hits;
+        return (*entry)->texture.get();
+    }
+    ++cache.statistics.misses;
+
+    auto size_in_bytes = image->imageInfo().computeMinByteSize();
+    if (size_in_bytes > TextureCache::MAXIMUM_ENTRY_SIZE)
+        return image;
+
+    auto texture = SkImages::TextureFromImage(sk_context(), image, skgpu::Mipmapped::kNo, skgpu::Budgeted::kNo);
+    if (!texture)
+        return image;
+
+    while (cache.size + size_in_bytes > TextureCache::MAXIMUM_SIZE) {
+        cache.remove_entry(*cache.lru_list.first());
+        ++cache.statistics.evictions;
+    }
+
+    auto entry = make<TextureCache::Entry>();
+    entry->texture = move(texture);
+    entry->size_in_bytes = size_in_bytes;
+    entry->image_id = image->uniqueID();
+
+    auto const* result = entry->texture.get();
+    cache.size += size_in_bytes;
+    cache.lru_list.append(*entry);
+    cache.entries.set(entry->image_id, move(entry));
+    return result;
+}
+
+void SkiaBackendContext::prepare_texture_for_bitmap(ImmutableBitmap const& bitmap)
+{
+    Threading::MutexLocker locker(m_texture_cache->prepared_bitmaps_mutex);
+    m_texture_cache->prepared_bitmaps.append(bitmap);
+}
+
+void SkiaBackendContext::upload_prepared_textures()
+{
+    Vector<NonnullRefPtr<ImmutableBitmap const>> prepared_bitmaps;
+    {
+        Threading::MutexLocker locker(m_texture_cache->prepared_bitmaps_mutex);
+        prepared_bitmaps = move(m_texture_cache->prepared_bitmaps);
+    }
+
+    // Uploading only counts as a use once the bitmap is actually drawn.
+    auto statistics = m_texture_cache->statistics;
+    for (auto const& bitmap : prepared_bitmaps)
+        (void)texture_for_bitmap(bitmap);
+    statistics.evictions = m_texture_cache->statistics.evictions;
+    m_texture_cache->statistics = statistics;
+}
+
+SkiaBackendContext::TextureCacheStatistics SkiaBackendContext::texture_cache_statistics()
+{
+    Threading::MutexLocker locker(m_mutex);
+
+    auto statistics = m_texture_cache->statistics;
+    statistics.entry_count = m_texture_cache->entries.size();
+    statistics.size_in_bytes = m_texture_cache->size;
+    return statistics;
+}
+
 #ifdef USE_VULKAN
 class SkiaVulkanBackendContext final : public SkiaBackendContext {
     AK_MAKE_NONCOPYABLE(SkiaVulkanBackendContext);
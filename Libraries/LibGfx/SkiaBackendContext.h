@@ -8,6 +8,8 @@
 
 #include <AK/AtomicRefCounted.h>
 #include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <LibGfx/Forward.h>
 #include <LibThreading/Mutex.h>
 
 #ifdef USE_VULKAN
@@ -19,6 +21,7 @@
 #endif
 
 class GrDirectContext;
+class SkImage;
 class SkSurface;
 
 namespace Gfx {
@@ -39,8 +42,8 @@ public:
     static RefPtr<SkiaBackendContext> create_metal_context(NonnullRefPtr<MetalContext>);
 #endif
 
-    SkiaBackendContext() { }
-    virtual ~SkiaBackendContext() { }
+    SkiaBackendContext();
+    virtual ~SkiaBackendContext();
 
     virtual void flush_and_submit(SkSurface*) { }
     virtual GrDirectContext* sk_context() const = 0;
@@ -51,8 +54,30 @@ public:
     void lock() { m_mutex.lock(); }
     void unlock() { m_mutex.unlock(); }
 
+    // Skia drops the GPU copies of raster images whenever its own resource cache is full, and uploads them again the
+    // next time they are drawn. We keep the most recently drawn bitmaps on the GPU ourselves, within a fixed budget.
+    // These must only be called while the context is locked.
+    SkImage const* texture_for_bitmap(ImmutableBitmap const&);
+    void upload_prepared_textures();
+
+    // Queues the bitmap for upload at the end of the next frame, so that the frame that first draws it doesn't have to.
+    // This may be called from any thread.
+    void prepare_texture_for_bitmap(ImmutableBitmap const&);
+
+    struct TextureCacheStatistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+        u64 entry_count { 0 };
+        u64 size_in_bytes { 0 };
+    };
+    TextureCacheStatistics texture_cache_statistics();
+
 private:
     Threading::Mutex m_mutex;
+
+    struct TextureCache;
+    NonnullOwnPtr<TextureCache> m_texture_cache;
 };
 
 }
@@ -10,11 +10,48 @@
 #include <AK/Utf16String.h>
 #include <AK/Utf16View.h>
 #include <LibGfx/Point.h>
+#include <LibGfx/SkiaUtils.h>
 #include <LibGfx/TextLayout.h>
+#include <core/SkTextBlob.h>
 #include <harfbuzz/hb.h>
 
 namespace Gfx {
 
+struct GlyphRun::CachedTextBlob {
+    float scale { 1 };
+    sk_sp<SkTextBlob> text_blob;
+};
+
+GlyphRun::~GlyphRun()
+{
+    delete m_cached_text_blob.load();
+}
+
+SkTextBlob* GlyphRun::cached_text_blob(float scale) const
+{
+    if (auto* cached_text_blob = m_cached_text_blob.load(AK::memory_order_acquire))
+        return cached_text_blob->scale == scale ? cached_text_blob->text_blob.get() : nullptr;
+
+    auto sk_font = m_font->skia_font(scale);
+    auto font_ascent = m_font->pixel_metrics().ascent;
+
+    SkTextBlobBuilder builder;
+    auto const& run_buffer = builder.allocRunPos(sk_font, static_cast<int>(m_glyphs.size()));
+    for (size_t i = 0; i < m_glyphs.size(); ++i) {
+        auto const& glyph = m_glyphs[i];
+        Gfx::FloatPoint position { glyph.position.x(), glyph.position.y() + font_ascent };
+        run_buffer.glyphs[i] = glyph.glyph_id;
+        run_buffer.points()[i] = to_skia_point(position.scaled(scale));
+    }
+
+    auto new_cached_text_blob = make<CachedTextBlob>(scale, builder.make());
+    CachedTextBlob* expected = nullptr;
+    // Another thread may have raced us to it, in which case we use theirs.
+    if (!m_cached_text_blob.compare_exchange_strong(expected, new_cached_text_blob.ptr(), AK::memory_order_acq_rel))
+        return expected->scale == scale ? expected->text_blob.get() : nullptr;
+    return new_cached_text_blob.leak_ptr()->text_blob.get();
+}
+
 FloatRect GlyphRun::bounding_rect() const
 {
     if (glyphs().is_empty())
@@ -110,7 +147,6 @@ NonnullRefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spaci
         shaping_cache.features = features;
     }
 
-    // FIXME: The cache currently grows unbounded. We should have some limit and LRU mechanism.
     auto get_or_create_buffer = [&] -> hb_buffer_t* {
         if (string.length_in_code_units() == 1) {
             auto code_unit = string.code_unit_at(0);
@@ -122,13 +158,10 @@ NonnullRefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spaci
                 return cache_slot;
             }
         }
-        if (auto it = shaping_cache.map.find(
-                string.hash(), [&](auto& candidate) { return candidate.key == string; });
-            it != shaping_cache.map.end()) {
-            return it->value;
-        }
+        if (auto* buffer = shaping_cache.find(string))
+            return buffer;
         auto* buffer = setup_text_shaping(string, font, features);
-        shaping_cache.map.set(Utf16String::from_utf16(string), buffer);
+        shaping_cache.insert(string, buffer);
         return buffer;
     };
 
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/AtomicRefCounted.h>
 #include <AK/Forward.h>
 #include <AK/Vector.h>
@@ -18,6 +19,8 @@
 #include <LibGfx/Rect.h>
 #include <LibGfx/ShapeFeature.h>
 
+class SkTextBlob;
+
 namespace Gfx {
 
 struct DrawGlyph {
@@ -45,6 +48,7 @@ public:
         , m_line_height(line_height)
     {
     }
+    ~GlyphRun();
 
     [[nodiscard]] Font const& font() const { return m_font; }
     [[nodiscard]] TextType text_type() const { return m_text_type; }
@@ -54,12 +58,21 @@ public:
     [[nodiscard]] float width() const { return m_width; }
     [[nodiscard]] FloatRect bounding_rect() const;
 
+    // Returns the glyphs as a Skia text blob, positioned relative to the run's baseline at the given scale. The blob
+    // is created the first time it is needed and kept for the first scale asked for; null is returned for others.
+    // Since glyph runs are shared by all display lists that draw them, Skia's caches for the blob keep working
+    // across frames. The glyphs must not be changed anymore once this has been called.
+    [[nodiscard]] SkTextBlob* cached_text_blob(float scale) const;
+
 private:
+    struct CachedTextBlob;
+
     Vector<DrawGlyph> m_glyphs;
     NonnullRefPtr<Font const> m_font;
     TextType m_text_type;
     float m_width { 0 };
     float m_line_height { 0 };
+    mutable Atomic<CachedTextBlob*> m_cached_text_blob { nullptr };
 };
 
 NonnullRefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spacing, Utf16View const&, Gfx::Font const& font, GlyphRun::TextType, ShapeFeatures const& features);
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/YUVData.h>
+
+namespace Gfx {
+
+ErrorOr<NonnullRefPtr<YUVData>> YUVData::create(IntSize size, u8 bit_depth, Media::Subsampling subsampling, Media::CodingIndependentCodePoints cicp)
+{
+    if (size.is_empty())
+        return Error::from_string_literal("YUVData: Frame size is empty");
+    if (bit_depth == 0 || bit_depth > 16)
+        return Error::from_string_literal("YUVData: Unsupported bit depth");
+
+    auto data = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) YUVData(size, bit_depth, subsampling, cicp)));
+    for (size_t plane = 0; plane < 3; ++plane) {
+        auto plane_size = data->plane_size(plane);
+        data->m_planes[plane] = TRY(FixedArray<u8>::create(plane_size.to_type<size_t>().area() * data->component_size()));
+    }
+    return data;
+}
+
+IntSize YUVData::plane_size(size_t plane) const
+{
+    VERIFY(plane < 3);
+    if (plane == 0)
+        return m_size;
+    return m_subsampling.subsampled_size(m_size.to_type<u32>()).to_type<int>();
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/Error.h>
+#include <AK/FixedArray.h>
+#include <AK/NonnullRefPtr.h>
+#include <LibGfx/Size.h>
+#include <LibMedia/Color/CodingIndependentCodePoints.h>
+#include <LibMedia/Subsampling.h>
+
+namespace Gfx {
+
+// The planes of a decoded Y'CbCr video frame, before conversion to RGB. An ImmutableBitmap created from this converts
+// it to RGB in a shader while it is drawn, and keeps a reference to it until then.
+class YUVData final : public AtomicRefCounted<YUVData> {
+public:
+    static ErrorOr<NonnullRefPtr<YUVData>> create(IntSize size, u8 bit_depth, Media::Subsampling, Media::CodingIndependentCodePoints);
+
+    IntSize size() const { return m_size; }
+    u8 bit_depth() const { return m_bit_depth; }
+    Media::Subsampling subsampling() const { return m_subsampling; }
+
+    Media::CodingIndependentCodePoints const& cicp() const { return m_cicp; }
+    void set_cicp(Media::CodingIndependentCodePoints cicp) { m_cicp = cicp; }
+
+    // Samples with more than 8 bits are stored in 16-bit integers, in native byte order.
+    size_t component_size() const { return m_bit_depth > 8 ? sizeof(u16) : sizeof(u8); }
+
+    // Plane 0 holds Y', plane 1 Cb and plane 2 Cr. Rows are tightly packed.
+    IntSize plane_size(size_t plane) const;
+    size_t plane_pitch(size_t plane) const { return static_cast<size_t>(plane_size(plane).width()) * component_size(); }
+    Bytes plane_data(size_t plane) { return m_planes[plane].span(); }
+    ReadonlyBytes plane_data(size_t plane) const { return m_planes[plane].span(); }
+
+    // Whether this can hold a frame of the given format, so that its memory can be reused for it.
+    bool has_format(IntSize size, u8 bit_depth, Media::Subsampling subsampling) const
+    {
+        return m_size == size && m_bit_depth == bit_depth && m_subsampling.x() == subsampling.x() && m_subsampling.y() == subsampling.y();
+    }
+
+private:
+    YUVData(IntSize size, u8 bit_depth, Media::Subsampling subsampling, Media::CodingIndependentCodePoints cicp)
+        : m_size(size)
+        , m_bit_depth(bit_depth)
+        , m_subsampling(subsampling)
+        , m_cicp(cicp)
+    {
+    }
+
+    IntSize m_size;
+    u8 m_bit_depth { 8 };
+    Media::Subsampling m_subsampling;
+    Media::CodingIndependentCodePoints m_cicp;
+    FixedArray<u8> m_planes[3];
+};
+
+}
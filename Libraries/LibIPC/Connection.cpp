@@ -8,8 +8,10 @@
 
 #include <AK/Vector.h>
 #include <LibCore/Socket.h>
+#include <LibCore/Trace.h>
 #include <LibIPC/Connection.h>
 #include <LibIPC/Message.h>
+#include <LibIPC/Statistics.h>
 #include <LibIPC/Stub.h>
 
 namespace IPC {
@@ -19,6 +21,9 @@ ConnectionBase::ConnectionBase(IPC::Stub& local_stub, NonnullOwnPtr<Transport> t
     , m_transport(move(transport))
     , m_local_endpoint_magic(local_endpoint_magic)
 {
+    // NOTE: This makes sure that statistics are set up on a thread with an event loop, as they are dumped from there.
+    (void)Statistics::the();
+
     m_transport->set_up_read_hook([this] {
         NonnullRefPtr protect = *this;
         drain_messages_from_peer();
@@ -45,6 +50,18 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer)
     if (!m_transport->is_open())
         return Error::from_string_literal("Trying to post_message during IPC shutdown");
 
+    if (auto* statistics = Statistics::the()) {
+        if (auto key = Statistics::key_for_encoded_message(buffer.data()); key.has_value())
+            statistics->did_send_message(*key, message_name(key->endpoint_magic, key->message_id), buffer.data().size(), buffer.fds().size());
+    }
+
+    // NOTE: The transport starts the flow to the handler of the message in the peer from within this span.
+    Optional<Core::TraceScope> trace_scope;
+    if (Core::Trace::is_enabled()) {
+        if (auto key = Statistics::key_for_encoded_message(buffer.data()); key.has_value())
+            trace_scope.emplace(message_name(key->endpoint_magic, key->message_id));
+    }
+
     MUST(buffer.transfer_message(*m_transport));
 
     return {};
@@ -72,7 +89,24 @@ void ConnectionBase::handle_messages()
         if (!is_open())
             dbgln("Handling message while connection closed: {}", message->message_name());
 
+        Optional<MonotonicTime> handler_start_time;
+        Statistics::MessageKey key { message->endpoint_magic(), message->message_id() };
+        auto* statistics = Statistics::the();
+        if (statistics)
+            handler_start_time = MonotonicTime::now();
+
+        Optional<Core::TraceScope> trace_scope;
+        if (Core::Trace::is_enabled()) {
+            trace_scope.emplace(StringView { message->message_name(), strlen(message->message_name()) });
+            if (auto trace_flow_id = message->trace_flow_id(); trace_flow_id != 0)
+                Core::Trace::add_flow_end("IPC"sv, trace_flow_id);
+        }
+
         auto handler_result = m_local_stub.handle(move(message));
+
+        if (statistics)
+            statistics->did_handle_message(key, MonotonicTime::now() - *handler_start_time);
+
         if (handler_result.is_error()) {
             dbgln("IPC::ConnectionBase::handle_messages: {}", handler_result.error());
             continue;
@@ -96,7 +130,16 @@ void ConnectionBase::wait_for_transport_to_become_readable()
 ConnectionBase::PeerEOF ConnectionBase::drain_messages_from_peer()
 {
     auto schedule_shutdown = m_transport->read_as_many_messages_as_possible_without_blocking([&](auto&& raw_message) {
+        auto fd_count = raw_message.fds.size();
         if (auto message = try_parse_message(raw_message.bytes, raw_message.fds)) {
+            message->set_trace_flow_id(raw_message.trace_flow_id);
+            if (auto* statistics = Statistics::the())
+                statistics->did_receive_message({ message->endpoint_magic(), message->message_id() }, message->message_name(), raw_message.bytes.size(), fd_count);
+            if (message->is_coalescable()) {
+                m_unprocessed_messages.remove_first_matching([&](auto const& unprocessed_message) {
+                    return message->supersedes(*unprocessed_message);
+                });
+            }
             m_unprocessed_messages.append(message.release_nonnull());
         } else {
             dbgln("Failed to parse IPC message {:hex-dump}", raw_message.bytes);
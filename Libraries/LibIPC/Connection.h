@@ -38,6 +38,7 @@ protected:
 
     virtual void shutdown_with_error(Error const&);
     virtual OwnPtr<Message> try_parse_message(ReadonlyBytes, Queue<File>&) = 0;
+    virtual StringView message_name(u32 endpoint_magic, i32 message_id) const = 0;
 
     OwnPtr<IPC::Message> wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id);
     void wait_for_transport_to_become_readable();
@@ -104,6 +105,15 @@ protected:
 
         return nullptr;
     }
+
+    virtual StringView message_name(u32 endpoint_magic, i32 message_id) const override
+    {
+        if (endpoint_magic == LocalEndpoint::static_magic())
+            return LocalEndpoint::message_name(message_id);
+        if (endpoint_magic == PeerEndpoint::static_magic())
+            return PeerEndpoint::message_name(message_id);
+        return {};
+    }
 };
 
 }
@@ -11,6 +11,7 @@
 #include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Proxy.h>
 #include <LibCore/Socket.h>
+#include <LibCore/System.h>
 #include <LibIPC/Decoder.h>
 #include <LibIPC/File.h>
 #include <LibURL/Parser.h>
@@ -62,7 +63,22 @@ ErrorOr<ByteBuffer> decode(Decoder& decoder)
     auto buffer = TRY(ByteBuffer::create_uninitialized(length));
     auto bytes = buffer.bytes();
 
-    TRY(decoder.decode_into(bytes));
+    if (length < OUT_OF_LINE_PAYLOAD_THRESHOLD) {
+        TRY(decoder.decode_into(bytes));
+        return buffer;
+    }
+
+    auto anon_file = TRY(decoder.decode<IPC::File>());
+
+    // The peer decides how large the shared memory actually is, so make sure it covers the whole payload before
+    // touching it. Reading past the end of the mapping would fault instead of failing.
+    auto stat = TRY(Core::System::fstat(anon_file.fd()));
+    if (stat.st_size < 0 || static_cast<u64>(stat.st_size) < static_cast<u64>(length))
+        return Error::from_string_literal("Out-of-line payload is smaller than its declared size");
+
+    auto shared_buffer = TRY(Core::AnonymousBuffer::create_from_anon_fd(anon_file.take_fd(), length));
+    bytes.overwrite(0, shared_buffer.data<void>(), length);
+
     return buffer;
 }
 
@@ -89,7 +89,16 @@ template<>
 ErrorOr<void> encode(Encoder& encoder, ByteBuffer const& value)
 {
     TRY(encoder.encode_size(value.size()));
-    TRY(encoder.append(value.data(), value.size()));
+
+    if (value.size() < OUT_OF_LINE_PAYLOAD_THRESHOLD) {
+        TRY(encoder.append(value.data(), value.size()));
+        return {};
+    }
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(value.size()));
+    memcpy(buffer.data<void>(), value.data(), value.size());
+
+    TRY(encoder.encode(TRY(IPC::File::clone_fd(buffer.fd()))));
     return {};
 }
 
@@ -15,6 +15,10 @@
 
 namespace IPC {
 
+// Byte buffers at least this large are not copied into the message. They are placed in shared memory instead, and
+// only its file descriptor is sent along with the message.
+static constexpr size_t OUT_OF_LINE_PAYLOAD_THRESHOLD = 64 * KiB;
+
 class MessageBuffer {
 public:
     MessageBuffer();
@@ -64,8 +68,20 @@ public:
     virtual char const* message_name() const = 0;
     virtual ErrorOr<MessageBuffer> encode() const = 0;
 
+    // Messages with parameters marked [CoalescingKey] only describe the latest state of something. If a newer message
+    // with the same key arrives before an older one has been handled, only the newer one is handled.
+    virtual bool is_coalescable() const { return false; }
+    virtual bool supersedes(Message const&) const { return false; }
+
+    // Links the trace events for sending and handling this message, or zero if it isn't traced.
+    u64 trace_flow_id() const { return m_trace_flow_id; }
+    void set_trace_flow_id(u64 trace_flow_id) { m_trace_flow_id = trace_flow_id; }
+
 protected:
     Message() = default;
+
+private:
+    u64 m_trace_flow_id { 0 };
 };
 
 }
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/OwnPtr.h>
+#include <LibCore/Environment.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/Process.h>
+#include <LibCore/System.h>
+#include <LibIPC/Statistics.h>
+#include <signal.h>
+
+namespace IPC {
+
+Statistics* Statistics::the()
+{
+    static OwnPtr<Statistics> s_the = []() -> OwnPtr<Statistics> {
+        auto path = Core::Environment::get("LADYBIRD_IPC_STATISTICS"sv);
+        if (!path.has_value() || path->is_empty())
+            return nullptr;
+
+        auto statistics = adopt_own(*new Statistics(ByteString::formatted("{}.{}", *path, Core::System::getpid())));
+
+#if !defined(AK_OS_WINDOWS)
+        Core::EventLoop::register_signal(SIGUSR2, [statistics = statistics.ptr()](int) {
+            if (auto result = statistics->dump(); result.is_error())
+                dbgln("Unable to dump IPC statistics: {}", result.error());
+        });
+#endif
+
+        return statistics;
+    }();
+    return s_the.ptr();
+}
+
+Statistics::Statistics(ByteString path)
+    : m_path(move(path))
+{
+}
+
+Optional<Statistics::MessageKey> Statistics::key_for_encoded_message(ReadonlyBytes bytes)
+{
+    // NOTE: Every message starts with the magic of its endpoint, followed by its id.
+    MessageKey key;
+    if (bytes.size() < sizeof(key.endpoint_magic) + sizeof(key.message_id))
+        return {};
+
+    memcpy(&key.endpoint_magic, bytes.data(), sizeof(key.endpoint_magic));
+    memcpy(&key.message_id, bytes.data() + sizeof(key.endpoint_magic), sizeof(key.message_id));
+    return key;
+}
+
+void Statistics::Timing::add(AK::Duration duration)
+{
+    total += duration;
+    if (duration > max)
+        max = duration;
+}
+
+Statistics::MessageStatistics& Statistics::ensure_message(MessageKey key, StringView message_name)
+{
+    auto hash_key = (static_cast<u64>(key.endpoint_magic) << 32) | static_cast<u32>(key.message_id);
+    auto& statistics = m_messages.ensure(hash_key, [&] {
+        return MessageStatistics { .endpoint_magic = key.endpoint_magic, .message_id = key.message_id };
+    });
+    if (statistics.name.is_empty() && !message_name.is_empty())
+        statistics.name = message_name;
+    return statistics;
+}
+
+void Statistics::did_send_message(MessageKey key, StringView message_name, size_t byte_count, size_t fd_count)
+{
+    Threading::MutexLocker locker(m_mutex);
+    auto& sent = ensure_message(key, message_name).sent;
+    ++sent.count;
+    sent.bytes += byte_count;
+    sent.fds += fd_count;
+}
+
+void Statistics::did_wait_in_send_queue(MessageKey key, AK::Duration duration)
+{
+    Threading::MutexLocker locker(m_mutex);
+    ensure_message(key).time_in_send_queue.add(duration);
+}
+
+void Statistics::did_receive_message(MessageKey key, StringView message_name, size_t byte_count, size_t fd_count)
+{
+    Threading::MutexLocker locker(m_mutex);
+    auto& received = ensure_message(key, message_name).received;
+    ++received.count;
+    received.bytes += byte_count;
+    received.fds += fd_count;
+}
+
+void Statistics::did_handle_message(MessageKey key, AK::Duration duration)
+{
+    Threading::MutexLocker locker(m_mutex);
+    ensure_message(key).time_in_handler.add(duration);
+}
+
+JsonObject Statistics::to_json() const
+{
+    auto counts_to_json = [](Counts const& counts) {
+        JsonObject object;
+        object.set("count"sv, counts.count);
+        object.set("bytes"sv, counts.bytes);
+        object.set("fds"sv, counts.fds);
+        return object;
+    };
+    auto timing_to_json = [](Timing const& timing) {
+        JsonObject object;
+        object.set("total_us"sv, timing.total.to_microseconds());
+        object.set("max_us"sv, timing.max.to_microseconds());
+        return object;
+    };
+
+    JsonArray messages;
+    {
+        Threading::MutexLocker locker(m_mutex);
+        for (auto const& [_, statistics] : m_messages) {
+            JsonObject message;
+            message.set("name"sv, statistics.name.view());
+            message.set("endpoint_magic"sv, statistics.endpoint_magic);
+            message.set("message_id"sv, statistics.message_id);
+            message.set("sent"sv, counts_to_json(statistics.sent));
+            message.set("received"sv, counts_to_json(statistics.received));
+            message.set("time_in_send_queue"sv, timing_to_json(statistics.time_in_send_queue));
+            message.set("time_in_handler"sv, timing_to_json(statistics.time_in_handler));
+            messages.must_append(move(message));
+        }
+    }
+
+    JsonObject object;
+    object.set("timestamp_ms"sv, UnixDateTime::now().milliseconds_since_epoch());
+    object.set("pid"sv, Core::System::getpid());
+    if (auto process_name = Core::Process::get_name(); !process_name.is_error())
+        object.set("process"sv, process_name.release_value());
+    object.set("messages"sv, move(messages));
+    return object;
+}
+
+ErrorOr<void> Statistics::dump()
+{
+    auto file = TRY(Core::File::open(m_path, Core::File::OpenMode::Write | Core::File::OpenMode::Append));
+    TRY(file->write_until_depleted(ByteString::formatted("{}\n", to_json().serialized())));
+    return {};
+}
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/JsonObject.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <LibThreading/Mutex.h>
+
+namespace IPC {
+
+// Opt-in instrumentation of the IPC traffic of the current process. It is only active when LADYBIRD_IPC_STATISTICS is
+// set to a file path, to which the id of the current process is appended. Each dump appends one line of JSON to that
+// file, so that dumps from many processes and machines can be aggregated by message name.
+class Statistics {
+    AK_MAKE_NONCOPYABLE(Statistics);
+    AK_MAKE_NONMOVABLE(Statistics);
+
+public:
+    // Returns nullptr when statistics are disabled.
+    static Statistics* the();
+
+    struct MessageKey {
+        u32 endpoint_magic { 0 };
+        i32 message_id { 0 };
+    };
+    static Optional<MessageKey> key_for_encoded_message(ReadonlyBytes);
+
+    void did_send_message(MessageKey, StringView message_name, size_t byte_count, size_t fd_count);
+    void did_wait_in_send_queue(MessageKey, AK::Duration);
+    void did_receive_message(MessageKey, StringView message_name, size_t byte_count, size_t fd_count);
+    void did_handle_message(MessageKey, AK::Duration);
+
+    JsonObject to_json() const;
+
+    // Also happens when the process receives SIGUSR2.
+    ErrorOr<void> dump();
+
+private:
+    explicit Statistics(ByteString path);
+
+    struct Counts {
+        u64 count { 0 };
+        u64 bytes { 0 };
+        u64 fds { 0 };
+    };
+
+    struct Timing {
+        AK::Duration total;
+        AK::Duration max;
+
+        void add(AK::Duration);
+    };
+
+    struct MessageStatistics {
+        u32 endpoint_magic { 0 };
+        i32 message_id { 0 };
+        ByteString name;
+        Counts sent;
+        Counts received;
+        Timing time_in_send_queue;
+        Timing time_in_handler;
+    };
+
+    MessageStatistics& ensure_message(MessageKey, StringView message_name = {});
+
+    ByteString m_path;
+
+    mutable Threading::Mutex m_mutex;
+    HashMap<u64, MessageStatistics> m_messages;
+};
+
+}
@@ -5,18 +5,25 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Random.h>
+#include <AK/ScopeGuard.h>
 #include <LibCore/Socket.h>
 #include <LibCore/System.h>
+#include <LibCore/Trace.h>
 #include <LibIPC/TransportSocket.h>
 #include <LibThreading/Thread.h>
 
 namespace IPC {
 
-void SendQueue::enqueue_message(Vector<u8>&& bytes, Vector<int>&& fds)
+void SendQueue::enqueue_message(Vector<u8>&& bytes, Vector<int>&& fds, Optional<Statistics::MessageKey> key)
 {
     Threading::MutexLocker locker(m_mutex);
     VERIFY(MUST(m_stream.write_some(bytes.span())) == bytes.size());
+    m_enqueued_byte_count += bytes.size();
+    if (key.has_value())
+        m_pending_messages.enqueue({ .end_offset = m_enqueued_byte_count, .enqueue_time = MonotonicTime::now(), .key = *key });
     m_fds.append(fds.data(), fds.size());
     m_condition.signal();
 }
@@ -50,6 +57,16 @@ void SendQueue::discard(size_t bytes_count, size_t fds_count)
     Threading::MutexLocker locker(m_mutex);
     MUST(m_stream.discard(bytes_count));
     m_fds.remove(0, fds_count);
+
+    m_discarded_byte_count += bytes_count;
+    if (!m_pending_messages.is_empty()) {
+        auto now = MonotonicTime::now();
+        auto* statistics = Statistics::the();
+        while (!m_pending_messages.is_empty() && m_pending_messages.head().end_offset <= m_discarded_byte_count) {
+            auto message = m_pending_messages.dequeue();
+            statistics->did_wait_in_send_queue(message.key, now - message.enqueue_time);
+        }
+    }
 }
 
 void SendQueue::stop()
@@ -59,6 +76,146 @@ void SendQueue::stop()
     m_condition.signal();
 }
 
+// NOTE: The offsets only ever grow, and are taken modulo the capacity to find the position in the data. Each of them
+//       lives in its own cache line, as the sender and the receiver update them concurrently.
+struct SharedMemoryRing::Header {
+    alignas(64) Atomic<u64> write_offset { 0 };
+    alignas(64) Atomic<u64> read_offset { 0 };
+    alignas(64) Atomic<u32> receiver_is_waiting { 0 };
+};
+
+struct SharedMemoryRingMessageHeader {
+    u32 sequence_number { 0 };
+    u32 payload_size { 0 };
+};
+
+size_t SharedMemoryRing::sizeof_header()
+{
+    return sizeof(Header);
+}
+
+ErrorOr<NonnullOwnPtr<SharedMemoryRing>> SharedMemoryRing::create(size_t size)
+{
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(size));
+    new (buffer.data<void>()) Header;
+    return adopt_nonnull_own_or_enomem(new (nothrow) SharedMemoryRing(move(buffer)));
+}
+
+ErrorOr<NonnullOwnPtr<SharedMemoryRing>> SharedMemoryRing::create_from_fd(int fd, size_t size)
+{
+    ArmedScopeGuard close_fd = [&] { (void)Core::System::close(fd); };
+
+    if (size <= sizeof(Header) + sizeof(SharedMemoryRingMessageHeader))
+        return Error::from_string_literal("Shared memory ring is too small");
+
+    // NOTE: Touching memory past the end of the file would crash us, so we can't take the peer's word for the size.
+    auto stat = TRY(Core::System::fstat(fd));
+    if (stat.st_size < 0 || static_cast<u64>(stat.st_size) < size)
+        return Error::from_string_literal("Shared memory ring is larger than its file");
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_from_anon_fd(fd, size));
+    close_fd.disarm();
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) SharedMemoryRing(move(buffer)));
+}
+
+SharedMemoryRing::SharedMemoryRing(Core::AnonymousBuffer buffer)
+    : m_buffer(move(buffer))
+{
+}
+
+SharedMemoryRing::Header& SharedMemoryRing::header()
+{
+    return *reinterpret_cast<Header*>(m_buffer.data<void>());
+}
+
+u8* SharedMemoryRing::data()
+{
+    return m_buffer.data<u8>() + sizeof(Header);
+}
+
+void SharedMemoryRing::copy_in(u64 offset, ReadonlyBytes bytes)
+{
+    auto position = offset % capacity();
+    auto first_part_size = min(bytes.size(), capacity() - position);
+
+    memcpy(data() + position, bytes.data(), first_part_size);
+    memcpy(data(), bytes.data() + first_part_size, bytes.size() - first_part_size);
+}
+
+void SharedMemoryRing::copy_out(u64 offset, Bytes bytes)
+{
+    auto position = offset % capacity();
+    auto first_part_size = min(bytes.size(), capacity() - position);
+
+    memcpy(bytes.data(), data() + position, first_part_size);
+    memcpy(bytes.data() + first_part_size, data(), bytes.size() - first_part_size);
+}
+
+bool SharedMemoryRing::try_write(u32 sequence_number, ReadonlyBytes payload)
+{
+    auto message_size = sizeof(SharedMemoryRingMessageHeader) + payload.size();
+
+    auto write_offset = header().write_offset.load(AK::MemoryOrder::memory_order_relaxed);
+    auto read_offset = header().read_offset.load(AK::MemoryOrder::memory_order_acquire);
+    if (capacity() - (write_offset - read_offset) < message_size)
+        return false;
+
+    SharedMemoryRingMessageHeader message_header { .sequence_number = sequence_number, .payload_size = static_cast<u32>(payload.size()) };
+    copy_in(write_offset, { &message_header, sizeof(message_header) });
+    copy_in(write_offset + sizeof(message_header), payload);
+
+    // NOTE: This has to be ordered before the check in receiver_needs_wakeup(), which pairs with the one in
+    //       prepare_to_wait_for_messages(). That way, either we see that the receiver is waiting, or it sees our message.
+    header().write_offset.store(write_offset + message_size, AK::MemoryOrder::memory_order_seq_cst);
+    return true;
+}
+
+bool SharedMemoryRing::receiver_needs_wakeup()
+{
+    return header().receiver_is_waiting.exchange(0, AK::MemoryOrder::memory_order_seq_cst) != 0;
+}
+
+ErrorOr<void> SharedMemoryRing::read_all(Function<void(Message&&)> const& callback)
+{
+    // NOTE: The sender may be compromised, so nothing it wrote is trusted until it has been checked and copied out.
+    auto write_offset = header().write_offset.load(AK::MemoryOrder::memory_order_acquire);
+    auto read_offset = header().read_offset.load(AK::MemoryOrder::memory_order_relaxed);
+    if (write_offset - read_offset > capacity())
+        return Error::from_string_literal("Shared memory ring holds more than its capacity");
+
+    while (read_offset != write_offset) {
+        auto available = write_offset - read_offset;
+
+        SharedMemoryRingMessageHeader message_header;
+        if (available < sizeof(message_header))
+            return Error::from_string_literal("Shared memory ring holds a truncated message header");
+        copy_out(read_offset, { &message_header, sizeof(message_header) });
+
+        if (message_header.payload_size > available - sizeof(message_header))
+            return Error::from_string_literal("Shared memory ring holds a truncated message");
+
+        Message message { .sequence_number = message_header.sequence_number, .bytes = {} };
+        TRY(message.bytes.try_resize(message_header.payload_size));
+        copy_out(read_offset + sizeof(message_header), message.bytes);
+
+        read_offset += sizeof(message_header) + message_header.payload_size;
+        callback(move(message));
+    }
+
+    header().read_offset.store(read_offset, AK::MemoryOrder::memory_order_release);
+    return {};
+}
+
+bool SharedMemoryRing::prepare_to_wait_for_messages()
+{
+    header().receiver_is_waiting.store(1, AK::MemoryOrder::memory_order_seq_cst);
+
+    auto write_offset = header().write_offset.load(AK::MemoryOrder::memory_order_seq_cst);
+    auto read_offset = header().read_offset.load(AK::MemoryOrder::memory_order_relaxed);
+    return write_offset == read_offset;
+}
+
 TransportSocket::TransportSocket(NonnullOwnPtr<Core::LocalSocket> socket)
     : m_socket(move(socket))
 {
@@ -82,6 +239,12 @@ TransportSocket::TransportSocket(NonnullOwnPtr<Core::LocalSocket> socket)
 
     (void)Core::System::setsockopt(m_socket->fd().value(), SOL_SOCKET, SO_SNDBUF, &SOCKET_BUFFER_SIZE, sizeof(SOCKET_BUFFER_SIZE));
     (void)Core::System::setsockopt(m_socket->fd().value(), SOL_SOCKET, SO_RCVBUF, &SOCKET_BUFFER_SIZE, sizeof(SOCKET_BUFFER_SIZE));
+
+    if (Core::Trace::is_enabled()) {
+        // NOTE: The low bits are left clear for the sequence numbers of our messages.
+        m_trace_connection_id = static_cast<u64>(get_random<u32>() | 1) << 32;
+        m_send_queue->enqueue_message(MessageHeader::encode_with_payload({ .type = MessageHeader::Type::TraceConnectionID, .payload_size = sizeof(m_trace_connection_id) }, { &m_trace_connection_id, sizeof(m_trace_connection_id) }), {});
+    }
 }
 
 TransportSocket::~TransportSocket()
@@ -133,6 +296,10 @@ void TransportSocket::close_after_sending_all_pending_messages()
 
 void TransportSocket::wait_until_readable()
 {
+    // NOTE: Messages may be waiting for us in shared memory already, in which case the socket never becomes readable.
+    if (m_incoming_ring && !m_incoming_ring->prepare_to_wait_for_messages())
+        return;
+
     Threading::RWLockLocker<Threading::LockMode::Read> lock(m_socket_rw_lock);
     auto maybe_did_become_readable = m_socket->can_read_without_blocking(-1);
     if (maybe_did_become_readable.is_error()) {
@@ -148,30 +315,53 @@ struct MessageHeader {
     enum class Type : u8 {
         Payload = 0,
         FileDescriptorAcknowledgement = 1,
+        SharedMemoryRingSetup = 2,
+        Wakeup = 3,
+        TraceConnectionID = 4,
     };
     Type type { Type::Payload };
     u32 payload_size { 0 };
     u32 fd_count { 0 };
+    u32 sequence_number { 0 };
 
     static Vector<u8> encode_with_payload(MessageHeader header, ReadonlyBytes payload)
     {
         Vector<u8> message_buffer;
         message_buffer.resize(sizeof(MessageHeader) + payload.size());
         memcpy(message_buffer.data(), &header, sizeof(MessageHeader));
-        memcpy(message_buffer.data() + sizeof(MessageHeader), payload.data(), payload.size());
+        if (!payload.is_empty())
+            memcpy(message_buffer.data() + sizeof(MessageHeader), payload.data(), payload.size());
         return message_buffer;
     }
 };
 
+static u64 trace_flow_id(u64 trace_connection_id, u32 sequence_number)
+{
+    return trace_connection_id | sequence_number;
+}
+
 void TransportSocket::post_message(Vector<u8> const& bytes_to_write, Vector<NonnullRefPtr<AutoCloseFileDescriptor>> const& fds)
 {
+    Threading::MutexLocker locker(m_post_mutex);
+
+    auto sequence_number = m_next_outgoing_sequence_number++;
     auto num_fds_to_transfer = fds.size();
 
+    if (m_trace_connection_id != 0)
+        Core::Trace::add_flow_start("IPC"sv, trace_flow_id(m_trace_connection_id, sequence_number));
+
+    if (num_fds_to_transfer == 0 && m_outgoing_ring && m_outgoing_ring->try_write(sequence_number, bytes_to_write)) {
+        if (m_outgoing_ring->receiver_needs_wakeup())
+            m_send_queue->enqueue_message(MessageHeader::encode_with_payload({ .type = MessageHeader::Type::Wakeup }, {}), {});
+        return;
+    }
+
     auto message_buffer = MessageHeader::encode_with_payload(
         {
             .type = MessageHeader::Type::Payload,
             .payload_size = static_cast<u32>(bytes_to_write.size()),
             .fd_count = static_cast<u32>(num_fds_to_transfer),
+            .sequence_number = sequence_number,
         },
         bytes_to_write);
 
@@ -186,7 +376,36 @@ void TransportSocket::post_message(Vector<u8> const& bytes_to_write, Vector<Nonn
         }
     }
 
-    m_send_queue->enqueue_message(move(message_buffer), move(raw_fds));
+    Optional<Statistics::MessageKey> statistics_key;
+    if (Statistics::the())
+        statistics_key = Statistics::key_for_encoded_message(bytes_to_write);
+
+    m_send_queue->enqueue_message(move(message_buffer), move(raw_fds), statistics_key);
+}
+
+ErrorOr<void> TransportSocket::send_messages_through_shared_memory()
+{
+    Threading::MutexLocker locker(m_post_mutex);
+    if (m_outgoing_ring)
+        return {};
+
+    auto ring = TRY(SharedMemoryRing::create());
+    auto ring_fd = adopt_ref(*new AutoCloseFileDescriptor(TRY(Core::System::dup(ring->buffer().fd()))));
+
+    u64 ring_size = ring->buffer().size();
+    auto message_buffer = MessageHeader::encode_with_payload(
+        {
+            .type = MessageHeader::Type::SharedMemoryRingSetup,
+            .payload_size = sizeof(ring_size),
+            .fd_count = 1,
+        },
+        { &ring_size, sizeof(ring_size) });
+
+    m_fds_retained_until_received_by_peer.enqueue(ring_fd);
+    m_send_queue->enqueue_message(move(message_buffer), { ring_fd->value() });
+
+    m_outgoing_ring = move(ring);
+    return {};
 }
 
 ErrorOr<void> TransportSocket::send_message(Core::LocalSocket& socket, ReadonlyBytes& bytes_to_write, Vector<int>& unowned_fds)
@@ -304,21 +523,66 @@ TransportSocket::ShouldShutdown TransportSocket::read_as_many_messages_as_possib
                 break;
             if (header.fd_count > m_unprocessed_fds.size())
                 break;
-            Message message;
+            auto message = make<Message>();
             received_fd_count += header.fd_count;
             for (size_t i = 0; i < header.fd_count; ++i)
-                message.fds.enqueue(m_unprocessed_fds.dequeue());
-            message.bytes.append(m_unprocessed_bytes.data() + index + sizeof(MessageHeader), header.payload_size);
-            callback(move(message));
+                message->fds.enqueue(m_unprocessed_fds.dequeue());
+            message->bytes.append(m_unprocessed_bytes.data() + index + sizeof(MessageHeader), header.payload_size);
+            m_messages_from_socket.enqueue(SequencedMessage { .sequence_number = header.sequence_number, .message = move(message) });
         } else if (header.type == MessageHeader::Type::FileDescriptorAcknowledgement) {
             VERIFY(header.payload_size == 0);
             acknowledged_fd_count += header.fd_count;
+        } else if (header.type == MessageHeader::Type::SharedMemoryRingSetup) {
+            u64 ring_size = 0;
+            VERIFY(header.payload_size == sizeof(ring_size));
+            VERIFY(header.fd_count == 1);
+            if (header.payload_size + sizeof(MessageHeader) > m_unprocessed_bytes.size() - index)
+                break;
+            if (m_unprocessed_fds.is_empty())
+                break;
+            memcpy(&ring_size, m_unprocessed_bytes.data() + index + sizeof(MessageHeader), sizeof(ring_size));
+
+            received_fd_count += 1;
+            auto ring_fd = m_unprocessed_fds.dequeue();
+
+            auto ring = SharedMemoryRing::create_from_fd(ring_fd.take_fd(), ring_size);
+            if (ring.is_error() || m_incoming_ring) {
+                dbgln("TransportSocket::read_as_much_as_possible_without_blocking: Invalid shared memory ring from peer");
+                should_shutdown = true;
+                break;
+            }
+            m_incoming_ring = ring.release_value();
+        } else if (header.type == MessageHeader::Type::TraceConnectionID) {
+            if (header.payload_size + sizeof(MessageHeader) > m_unprocessed_bytes.size() - index)
+                break;
+            if (header.payload_size == sizeof(m_peer_trace_connection_id) && Core::Trace::is_enabled())
+                memcpy(&m_peer_trace_connection_id, m_unprocessed_bytes.data() + index + sizeof(MessageHeader), sizeof(m_peer_trace_connection_id));
+        } else if (header.type == MessageHeader::Type::Wakeup) {
+            // NOTE: This only exists to make the socket readable, the messages themselves are in shared memory.
+            VERIFY(header.payload_size == 0);
         } else {
             VERIFY_NOT_REACHED();
         }
         index += header.payload_size + sizeof(MessageHeader);
     }
 
+    if (m_incoming_ring && !should_shutdown) {
+        do {
+            auto result = m_incoming_ring->read_all([&](auto&& ring_message) {
+                auto message = make<Message>();
+                message->bytes = move(ring_message.bytes);
+                m_messages_from_ring.enqueue(SequencedMessage { .sequence_number = ring_message.sequence_number, .message = move(message) });
+            });
+            if (result.is_error()) {
+                dbgln("TransportSocket::read_as_much_as_possible_without_blocking: {}", result.error());
+                should_shutdown = true;
+                break;
+            }
+        } while (!m_incoming_ring->prepare_to_wait_for_messages());
+    }
+
+    deliver_messages_in_order(callback);
+
     if (should_shutdown)
         return ShouldShutdown::Yes;
 
@@ -350,6 +614,25 @@ TransportSocket::ShouldShutdown TransportSocket::read_as_many_messages_as_possib
     return ShouldShutdown::No;
 }
 
+void TransportSocket::deliver_messages_in_order(Function<void(Message&&)> const& callback)
+{
+    for (;;) {
+        OwnPtr<Message> message;
+        if (!m_messages_from_socket.is_empty() && m_messages_from_socket.head().sequence_number == m_next_incoming_sequence_number)
+            message = m_messages_from_socket.dequeue().message;
+        else if (!m_messages_from_ring.is_empty() && m_messages_from_ring.head().sequence_number == m_next_incoming_sequence_number)
+            message = m_messages_from_ring.dequeue().message;
+        else
+            break;
+
+        if (m_peer_trace_connection_id != 0)
+            message->trace_flow_id = trace_flow_id(m_peer_trace_connection_id, m_next_incoming_sequence_number);
+        callback(move(*message));
+
+        ++m_next_incoming_sequence_number;
+    }
+}
+
 ErrorOr<int> TransportSocket::release_underlying_transport_for_transfer()
 {
     Threading::RWLockLocker<Threading::LockMode::Write> lock(m_socket_rw_lock);
@@ -9,9 +9,11 @@
 
 #include <AK/MemoryStream.h>
 #include <AK/Queue.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Socket.h>
 #include <LibIPC/AutoCloseFileDescriptor.h>
 #include <LibIPC/File.h>
+#include <LibIPC/Statistics.h>
 #include <LibThreading/ConditionVariable.h>
 #include <LibThreading/Forward.h>
 #include <LibThreading/MutexProtected.h>
@@ -28,7 +30,8 @@ public:
     Running block_until_message_enqueued();
     void stop();
 
-    void enqueue_message(Vector<u8>&& bytes, Vector<int>&& fds);
+    // The key is only used to measure how long the message waits before it has been sent, for statistics.
+    void enqueue_message(Vector<u8>&& bytes, Vector<int>&& fds, Optional<Statistics::MessageKey> = {});
     struct BytesAndFds {
         Vector<u8> bytes;
         Vector<int> fds;
@@ -39,11 +42,68 @@ public:
 private:
     AllocatingMemoryStream m_stream;
     Vector<int> m_fds;
+
+    struct PendingMessage {
+        u64 end_offset { 0 };
+        MonotonicTime enqueue_time;
+        Statistics::MessageKey key;
+    };
+    Queue<PendingMessage> m_pending_messages;
+    u64 m_enqueued_byte_count { 0 };
+    u64 m_discarded_byte_count { 0 };
+
     Threading::Mutex m_mutex;
     Threading::ConditionVariable m_condition { m_mutex };
     bool m_running { true };
 };
 
+// A single-producer, single-consumer queue of messages in memory that is shared with the peer. Only the sender writes
+// messages, and only the receiver reads them, so the two only have to agree on how far each of them has gotten.
+class SharedMemoryRing {
+    AK_MAKE_NONCOPYABLE(SharedMemoryRing);
+    AK_MAKE_NONMOVABLE(SharedMemoryRing);
+
+public:
+    static constexpr size_t DEFAULT_SIZE = 256 * KiB;
+
+    static ErrorOr<NonnullOwnPtr<SharedMemoryRing>> create(size_t size = DEFAULT_SIZE);
+    static ErrorOr<NonnullOwnPtr<SharedMemoryRing>> create_from_fd(int fd, size_t size);
+
+    Core::AnonymousBuffer const& buffer() const { return m_buffer; }
+
+    // Returns false if there is not enough room for the message right now.
+    [[nodiscard]] bool try_write(u32 sequence_number, ReadonlyBytes payload);
+
+    // Returns whether the receiver has to be woken up to see the messages written since the last call. This is the
+    // case if it has run out of messages since then.
+    [[nodiscard]] bool receiver_needs_wakeup();
+
+    struct Message {
+        u32 sequence_number { 0 };
+        Vector<u8> bytes;
+    };
+    ErrorOr<void> read_all(Function<void(Message&&)> const&);
+
+    // Asks the sender to wake us up for the next message. Returns false if messages have arrived in the meantime, which
+    // then need to be read first, as no wakeup will be sent for them.
+    [[nodiscard]] bool prepare_to_wait_for_messages();
+
+private:
+    struct Header;
+
+    explicit SharedMemoryRing(Core::AnonymousBuffer);
+
+    Header& header();
+    u8* data();
+    size_t capacity() const { return m_buffer.size() - sizeof_header(); }
+    static size_t sizeof_header();
+
+    void copy_in(u64 offset, ReadonlyBytes);
+    void copy_out(u64 offset, Bytes);
+
+    Core::AnonymousBuffer m_buffer;
+};
+
 class TransportSocket {
     AK_MAKE_NONCOPYABLE(TransportSocket);
     AK_MAKE_NONMOVABLE(TransportSocket);
@@ -64,6 +124,11 @@ public:
 
     void post_message(Vector<u8> const&, Vector<NonnullRefPtr<AutoCloseFileDescriptor>> const&);
 
+    // From now on, messages without file descriptors are sent through memory that is shared with the peer, and the
+    // socket is only used to pass file descriptors and to wake the peer up. This must not be used if the socket will
+    // be transferred to another process, as the shared memory can't move along with it.
+    ErrorOr<void> send_messages_through_shared_memory();
+
     enum class ShouldShutdown {
         No,
         Yes,
@@ -71,6 +136,8 @@ public:
     struct Message {
         Vector<u8> bytes;
         Queue<File> fds;
+        // Identifies the message in the trace of both processes, or zero if either of them isn't tracing.
+        u64 trace_flow_id { 0 };
     };
     ShouldShutdown read_as_many_messages_as_possible_without_blocking(Function<void(Message&&)>&&);
 
@@ -90,6 +157,12 @@ private:
 
     void stop_send_thread();
 
+    struct SequencedMessage {
+        u32 sequence_number { 0 };
+        NonnullOwnPtr<Message> message;
+    };
+    void deliver_messages_in_order(Function<void(Message&&)> const&);
+
     NonnullOwnPtr<Core::LocalSocket> m_socket;
     mutable Threading::RWLock m_socket_rw_lock;
     ByteBuffer m_unprocessed_bytes;
@@ -102,6 +175,22 @@ private:
 
     RefPtr<Threading::Thread> m_send_thread;
     RefPtr<SendQueue> m_send_queue;
+
+    // Messages are numbered as they are posted, so that the peer can put the ones that it receives through the socket
+    // and the ones that it receives through shared memory back into order.
+    Threading::Mutex m_post_mutex;
+    u32 m_next_outgoing_sequence_number { 0 };
+    OwnPtr<SharedMemoryRing> m_outgoing_ring;
+
+    // When tracing, each side picks a random id that it tells its peer about. Together with the sequence number of a
+    // message, it links the trace events for sending and handling the message in the two processes.
+    u64 m_trace_connection_id { 0 };
+    u64 m_peer_trace_connection_id { 0 };
+
+    u32 m_next_incoming_sequence_number { 0 };
+    OwnPtr<SharedMemoryRing> m_incoming_ring;
+    Queue<SequencedMessage> m_messages_from_socket;
+    Queue<SequencedMessage> m_messages_from_ring;
 };
 
 }
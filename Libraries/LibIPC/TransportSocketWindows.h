@@ -37,9 +37,13 @@ public:
     struct Message {
         Vector<u8> bytes;
         Queue<File> fds; // always empty, present to avoid OS #ifdefs in Connection.cpp
+        u64 trace_flow_id { 0 }; // always zero, as messages aren't linked across processes in traces on Windows yet
     };
     ShouldShutdown read_as_many_messages_as_possible_without_blocking(Function<void(Message&&)>&&);
 
+    // FIXME: Implement this with a shared memory ring like TransportSocket does.
+    ErrorOr<void> send_messages_through_shared_memory() { return {}; }
+
     // Obnoxious name to make it clear that this is a dangerous operation.
     ErrorOr<int> release_underlying_transport_for_transfer();
 
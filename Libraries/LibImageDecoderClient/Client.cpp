@@ -20,9 +20,11 @@ void Client::die()
         promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
     }
     m_pending_decoded_images.clear();
+    m_pending_animation_frames.clear();
+    m_incremental_decodes.clear();
 }
 
-NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, AnimationFrameDecoding animation_frame_decoding, Threading::TaskPriority priority)
 {
     auto promise = Core::Promise<DecodedImage>::construct();
     if (on_resolved)
@@ -45,7 +47,7 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
 
     memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
 
-    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::DecodeImage>(move(encoded_buffer), ideal_size, mime_type);
+    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::DecodeImage>(move(encoded_buffer), ideal_size, mime_type, animation_frame_decoding == AnimationFrameDecoding::OnDemand, priority);
     if (!response) {
         dbgln("ImageDecoder disconnected trying to decode image");
         promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
@@ -57,7 +59,7 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
     return promise;
 }
 
-void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::ColorSpace color_space)
+void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::ColorSpace color_space)
 {
     auto bitmaps = move(bitmap_sequence.bitmaps);
     VERIFY(!bitmaps.is_empty());
@@ -72,7 +74,10 @@ void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gf
     DecodedImage image;
     image.is_animated = is_animated;
     image.loop_count = loop_count;
+    image.frame_count = frame_count;
     image.scale = scale;
+    if (bitmaps.size() < frame_count)
+        image.animation_id = image_id;
     image.frames.ensure_capacity(bitmaps.size());
     image.color_space = move(color_space);
     for (size_t i = 0; i < bitmaps.size(); ++i) {
@@ -88,6 +93,102 @@ void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gf
     promise->resolve(move(image));
 }
 
+void Client::did_decode_still_image(i64 image_id, Gfx::ShareableBitmap bitmap, Gfx::FloatPoint scale, Gfx::ColorSpace color_space)
+{
+    auto maybe_promise = m_pending_decoded_images.take(image_id);
+    if (!maybe_promise.has_value()) {
+        dbgln("ImageDecoderClient: No pending image with ID {}", image_id);
+        return;
+    }
+    auto promise = maybe_promise.release_value();
+
+    if (!bitmap.is_valid()) {
+        dbgln("ImageDecoderClient: Invalid bitmap for request {}", image_id);
+        promise->reject(Error::from_string_literal("Invalid bitmap"));
+        return;
+    }
+
+    // NOTE: The bitmap is mapped read-only, as other clients may be showing the same one.
+    DecodedImage image;
+    image.frame_count = 1;
+    image.scale = scale;
+    image.color_space = move(color_space);
+    image.frames.empend(*bitmap.bitmap(), 0);
+
+    promise->resolve(move(image));
+}
+
+void Client::request_animation_frames(i64 animation_id, u32 first_frame_index, u32 count, Function<void(u32, Vector<Frame>)> on_frames_decoded)
+{
+    VERIFY(!m_pending_animation_frames.contains(animation_id));
+    m_pending_animation_frames.set(animation_id, move(on_frames_decoded));
+    async_request_animation_frames(animation_id, first_frame_index, count);
+}
+
+void Client::release_animation(i64 animation_id)
+{
+    m_pending_animation_frames.remove(animation_id);
+    async_release_animation(animation_id);
+}
+
+void Client::did_decode_animation_frames(i64 image_id, u32 first_frame_index, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations)
+{
+    auto on_frames_decoded = m_pending_animation_frames.take(image_id);
+    if (!on_frames_decoded.has_value())
+        return;
+
+    Vector<Frame> frames;
+    frames.ensure_capacity(bitmap_sequence.bitmaps.size());
+    for (size_t i = 0; i < bitmap_sequence.bitmaps.size(); ++i) {
+        // Frames after one that failed to decode are useless too, as they would be shown at the wrong index.
+        if (!bitmap_sequence.bitmaps[i])
+            break;
+        frames.unchecked_empend(bitmap_sequence.bitmaps[i].release_nonnull(), durations[i]);
+    }
+
+    on_frames_decoded.value()(first_frame_index, move(frames));
+}
+
+Optional<i64> Client::begin_incremental_decode(Threading::TaskPriority priority, Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image)
+{
+    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::BeginIncrementalDecode>(priority);
+    if (!response) {
+        dbgln("ImageDecoder disconnected trying to begin incremental decode");
+        return {};
+    }
+
+    m_incremental_decodes.set(response->image_id(), move(on_partial_image));
+    return response->image_id();
+}
+
+void Client::append_incremental_decode_data(i64 image_id, ReadonlyBytes data)
+{
+    if (!m_incremental_decodes.contains(image_id))
+        return;
+
+    auto buffer_or_error = ByteBuffer::copy(data);
+    if (buffer_or_error.is_error()) {
+        end_incremental_decode(image_id);
+        return;
+    }
+    async_append_incremental_decode_data(image_id, buffer_or_error.release_value());
+}
+
+void Client::end_incremental_decode(i64 image_id)
+{
+    if (m_incremental_decodes.remove(image_id))
+        async_end_incremental_decode(image_id);
+}
+
+void Client::did_decode_partial_image(i64 image_id, Gfx::BitmapSequence bitmap_sequence)
+{
+    auto on_partial_image = m_incremental_decodes.get(image_id);
+    if (!on_partial_image.has_value() || bitmap_sequence.bitmaps.is_empty() || !bitmap_sequence.bitmaps.first())
+        return;
+
+    (*on_partial_image)(bitmap_sequence.bitmaps.first().release_nonnull());
+}
+
 void Client::did_fail_to_decode_image(i64 image_id, String error_message)
 {
     auto maybe_promise = m_pending_decoded_images.take(image_id);
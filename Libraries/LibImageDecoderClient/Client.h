@@ -12,6 +12,7 @@
 #include <LibCore/Promise.h>
 #include <LibGfx/ColorSpace.h>
 #include <LibIPC/ConnectionToServer.h>
+#include <LibThreading/ThreadPool.h>
 
 namespace ImageDecoderClient {
 
@@ -24,8 +25,17 @@ struct DecodedImage {
     bool is_animated { false };
     Gfx::FloatPoint scale { 1, 1 };
     u32 loop_count { 0 };
+    u32 frame_count { 0 };
     Vector<Frame> frames;
     Gfx::ColorSpace color_space;
+
+    // Set if only the first frames were decoded, see Client::request_animation_frames().
+    Optional<i64> animation_id;
+};
+
+enum class AnimationFrameDecoding {
+    AllUpFront,
+    OnDemand,
 };
 
 class Client final
@@ -38,17 +48,33 @@ public:
 
     Client(NonnullOwnPtr<IPC::Transport>);
 
-    NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
+    NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {}, AnimationFrameDecoding = AnimationFrameDecoding::AllUpFront, Threading::TaskPriority = Threading::TaskPriority::Default);
+
+    // on_frames_decoded receives fewer than count frames if the animation ends or a frame fails to decode. Only one
+    // request per animation may be in flight at a time.
+    void request_animation_frames(i64 animation_id, u32 first_frame_index, u32 count, Function<void(u32 first_frame_index, Vector<Frame>)> on_frames_decoded);
+    void release_animation(i64 animation_id);
+
+    // Decodes an image while its data is still arriving, and calls on_partial_image with what has been decoded so far.
+    // This is only for showing the image early; the complete image should still be decoded with decode_image().
+    Optional<i64> begin_incremental_decode(Threading::TaskPriority, Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image);
+    void append_incremental_decode_data(i64 image_id, ReadonlyBytes);
+    void end_incremental_decode(i64 image_id);
 
     Function<void()> on_death;
 
 private:
     virtual void die() override;
 
-    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::ColorSpace color_space) override;
+    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::ColorSpace color_space) override;
+    virtual void did_decode_still_image(i64 image_id, Gfx::ShareableBitmap bitmap, Gfx::FloatPoint scale, Gfx::ColorSpace color_space) override;
+    virtual void did_decode_partial_image(i64 image_id, Gfx::BitmapSequence bitmap_sequence) override;
     virtual void did_fail_to_decode_image(i64 image_id, String error_message) override;
+    virtual void did_decode_animation_frames(i64 image_id, u32 first_frame_index, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations) override;
 
     HashMap<i64, NonnullRefPtr<Core::Promise<DecodedImage>>> m_pending_decoded_images;
+    HashMap<i64, Function<void(u32, Vector<Frame>)>> m_pending_animation_frames;
+    HashMap<i64, Function<void(NonnullRefPtr<Gfx::Bitmap>)>> m_incremental_decodes;
 };
 
 }
@@ -471,6 +471,8 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> Identifier::generate_by
             }
             generator.emit<Bytecode::Op::ThrowIfTDZ>(local);
         }
+        if (generator.is_lazily_created_arguments_object(*this))
+            generator.emit_create_lazy_arguments_object();
         return local;
     }
 
@@ -1259,9 +1261,37 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> ArrayExpression::genera
     return dst;
 }
 
+// Returns true if evaluating the expression can't assign to a local variable.
+static bool cannot_assign_to_locals(Expression const& expression)
+{
+    if (is<Identifier>(expression) || is<NumericLiteral>(expression) || is<StringLiteral>(expression))
+        return true;
+    if (is<BinaryExpression>(expression)) {
+        auto const& binary_expression = static_cast<BinaryExpression const&>(expression);
+        return cannot_assign_to_locals(binary_expression.lhs()) && cannot_assign_to_locals(binary_expression.rhs());
+    }
+    return false;
+}
+
 Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> MemberExpression::generate_bytecode(Bytecode::Generator& generator, Optional<ScopedOperand> preferred_dst) const
 {
     Bytecode::Generator::SourceLocationScope scope(generator, *this);
+
+    if (generator.is_lazily_created_arguments_object(object())) {
+        if (!is_computed() && property().is_identifier() && as<Identifier>(property()).string() == "length"sv) {
+            auto dst = choose_dst(generator, preferred_dst);
+            generator.emit<Bytecode::Op::GetArgumentsLength>(dst, generator.lazy_arguments_object());
+            return dst;
+        }
+        // NOTE: The arguments object is read when the lookup happens, so the property expression must not reassign it.
+        if (is_computed() && cannot_assign_to_locals(property())) {
+            auto property = TRY(this->property().generate_bytecode(generator)).value();
+            auto dst = choose_dst(generator, preferred_dst);
+            generator.emit<Bytecode::Op::GetArgumentByValue>(dst, generator.lazy_arguments_object(), property, generator.lazy_arguments_object_kind());
+            return dst;
+        }
+    }
+
     auto reference = TRY(generator.emit_load_from_reference(*this, preferred_dst));
     return reference.loaded_value;
 }
@@ -1747,6 +1777,8 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> CallExpression::generat
             if (!generator.is_local_initialized(local.operand().index())) {
                 generator.emit<Bytecode::Op::ThrowIfTDZ>(local);
             }
+            if (generator.is_lazily_created_arguments_object(identifier))
+                generator.emit_create_lazy_arguments_object();
             original_callee = local;
         } else if (identifier.is_global()) {
             original_callee = m_callee->generate_bytecode(generator).value();
@@ -1824,6 +1856,7 @@ Bytecode::CodeGenerationErrorOr<Optional<ScopedOperand>> CallExpression::generat
                 callee,
                 this_value,
                 argument_operands,
+                generator.next_call_site_cache(),
                 expression_string_index);
         }
     }
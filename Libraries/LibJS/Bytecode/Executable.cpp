@@ -24,6 +24,7 @@ Executable::Executable(
     NonnullRefPtr<SourceCode const> source_code,
     size_t number_of_property_lookup_caches,
     size_t number_of_global_variable_caches,
+    size_t number_of_call_site_caches,
     size_t number_of_registers,
     bool is_strict_mode)
     : bytecode(move(bytecode))
@@ -37,6 +38,7 @@ Executable::Executable(
 {
     property_lookup_caches.resize(number_of_property_lookup_caches);
     global_variable_caches.resize(number_of_global_variable_caches);
+    call_site_caches.resize(number_of_call_site_caches);
 }
 
 Executable::~Executable() = default;
@@ -99,6 +101,16 @@ Optional<Executable::ExceptionHandlers const&> Executable::exception_handlers_fo
     return {};
 }
 
+size_t Executable::number_of_megamorphic_property_lookup_caches() const
+{
+    size_t count = 0;
+    for (auto const& cache : property_lookup_caches) {
+        if (cache.is_megamorphic)
+            ++count;
+    }
+    return count;
+}
+
 UnrealizedSourceRange Executable::source_range_at(size_t offset) const
 {
     if (offset >= bytecode.size())
@@ -46,6 +46,39 @@ struct PropertyLookupCache {
         Optional<u32> shape_dictionary_generation;
     };
     AK::Array<Entry, max_number_of_shapes_to_remember> entries;
+
+    // Set once this cache had to evict a live entry. From then on, misses also consult the MegamorphicPropertyLookupCache.
+    bool is_megamorphic { false };
+
+    void note_eviction()
+    {
+        if (entries.last().shape)
+            is_megamorphic = true;
+    }
+};
+
+// A fixed-size, direct-mapped cache keyed by (Shape, property name). It is shared by all
+// property lookup sites that have seen more shapes than their own PropertyLookupCache can hold.
+struct MegamorphicPropertyLookupCache {
+    static constexpr size_t number_of_entries = 1024;
+    static_assert(is_power_of_two(number_of_entries));
+
+    struct Entry {
+        PropertyLookupCache::Entry::Type type { PropertyLookupCache::Entry::Type::Empty };
+        GC::Weak<Shape> shape;
+        Utf16FlyString property_name;
+        u32 property_offset { 0 };
+        GC::Weak<Object> prototype;
+        GC::Weak<PrototypeChainValidity> prototype_chain_validity;
+    };
+
+    Entry& entry_for(Shape const& shape, Utf16FlyString const& property_name)
+    {
+        auto hash = pair_int_hash(ptr_hash(&shape), property_name.hash());
+        return entries[hash & (number_of_entries - 1)];
+    }
+
+    AK::Array<Entry, number_of_entries> entries;
 };
 
 struct GlobalVariableCache : public PropertyLookupCache {
@@ -55,6 +88,13 @@ struct GlobalVariableCache : public PropertyLookupCache {
     bool in_module_environment { false };
 };
 
+// Remembers the last ECMAScript function called from a Call instruction, along with its stack frame size.
+struct CallSiteCache {
+    GC::Weak<ECMAScriptFunctionObject> callee;
+    u32 registers_and_constants_and_locals_count { 0 };
+    u32 formal_parameter_count { 0 };
+};
+
 struct SourceRecord {
     u32 source_start_offset {};
     u32 source_end_offset {};
@@ -74,6 +114,7 @@ public:
         NonnullRefPtr<SourceCode const>,
         size_t number_of_property_lookup_caches,
         size_t number_of_global_variable_caches,
+        size_t number_of_call_site_caches,
         size_t number_of_registers,
         bool is_strict_mode);
 
@@ -83,6 +124,7 @@ public:
     Vector<u8> bytecode;
     Vector<PropertyLookupCache> property_lookup_caches;
     Vector<GlobalVariableCache> global_variable_caches;
+    Vector<CallSiteCache> call_site_caches;
     NonnullOwnPtr<StringTable> string_table;
     NonnullOwnPtr<IdentifierTable> identifier_table;
     NonnullOwnPtr<RegexTable> regex_table;
@@ -110,6 +152,15 @@ public:
 
     Optional<IdentifierTableIndex> length_identifier;
 
+    // Profiling counters used to decide when an executable is hot enough to tier up.
+    // NOTE: Only the interpreter tier exists right now, so these are informational.
+    static constexpr u64 tier_up_entry_threshold = 1000;
+    static constexpr u64 tier_up_back_edge_threshold = 10000;
+    u64 entry_count { 0 };
+    u64 back_edge_count { 0 };
+
+    [[nodiscard]] bool is_hot() const { return entry_count >= tier_up_entry_threshold || back_edge_count >= tier_up_back_edge_threshold; }
+
     Utf16String const& get_string(StringTableIndex index) const { return string_table->get(index); }
     Utf16FlyString const& get_identifier(IdentifierTableIndex index) const { return identifier_table->get(index); }
 
@@ -122,6 +173,8 @@ public:
 
     [[nodiscard]] Optional<ExceptionHandlers const&> exception_handlers_for_offset(size_t offset) const;
 
+    [[nodiscard]] size_t number_of_megamorphic_property_lookup_caches() const;
+
     [[nodiscard]] UnrealizedSourceRange source_range_at(size_t offset) const;
 
     void dump() const;
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BinaryHeap.h>
 #include <AK/QuickSort.h>
 #include <AK/TemporaryChange.h>
 #include <LibJS/AST.h>
@@ -60,10 +61,21 @@ CodeGenerationErrorOr<void> Generator::emit_function_declaration_instantiation(E
         if (local_var_index.has_value())
             dst = local(Identifier::Local::variable(local_var_index.value()));
 
-        if (function.is_strict_mode() || !function.has_simple_parameter_list()) {
-            emit<Op::CreateArguments>(dst, Op::CreateArguments::Kind::Unmapped, function.is_strict_mode());
+        auto kind = (function.is_strict_mode() || !function.has_simple_parameter_list())
+            ? Op::CreateArguments::Kind::Unmapped
+            : Op::CreateArguments::Kind::Mapped;
+
+        // NOTE: Without formal parameters there is nothing for a mapped arguments object to alias, so if the object
+        //       doesn't escape into an environment, we can defer creating it until something observes it as an object.
+        //       Until then, `arguments.length` and `arguments[i]` read the passed arguments directly.
+        if (local_var_index.has_value() && function.formal_parameters().size() == 0) {
+            m_lazy_arguments_object = LazyArgumentsObject {
+                .local_index = static_cast<u32>(local_var_index.value()),
+                .kind = kind,
+                .is_strict = function.is_strict_mode(),
+            };
         } else {
-            emit<Op::CreateArguments>(dst, Op::CreateArguments::Kind::Mapped, function.is_strict_mode());
+            emit<Op::CreateArguments>(dst, kind, function.is_strict_mode());
         }
 
         if (local_var_index.has_value())
@@ -215,6 +227,147 @@ CodeGenerationErrorOr<void> Generator::emit_function_declaration_instantiation(E
     return {};
 }
 
+// Renumbers the registers used by the reachable blocks so that registers whose live ranges don't overlap share a
+// slot in the register file. Returns the number of registers the executable needs afterwards.
+static u32 compact_registers(Vector<NonnullOwnPtr<BasicBlock>>& basic_blocks, Vector<bool> const& block_is_reachable, u32 number_of_registers)
+{
+    // NOTE: A finally block continues with a scheduled jump whose target is only visible on the ScheduleJump
+    //       instruction that preceded it, not on the instruction that actually performs the jump. Since that
+    //       control flow can't be recovered from labels, we leave executables with finalizers alone.
+    for (size_t i = 0; i < basic_blocks.size(); ++i) {
+        if (block_is_reachable[i] && basic_blocks[i]->finalizer())
+            return number_of_registers;
+    }
+
+    struct LiveRange {
+        size_t start { NumericLimits<size_t>::max() };
+        size_t end { 0 };
+
+        bool is_empty() const { return start > end; }
+        bool overlaps(LiveRange const& other) const { return start <= other.end && other.start <= end; }
+    };
+
+    Vector<LiveRange> live_ranges;
+    live_ranges.resize(number_of_registers);
+
+    struct Edge {
+        size_t from;
+        size_t to_block_index;
+    };
+    Vector<Edge> edges;
+    Vector<size_t> block_start_positions;
+    block_start_positions.resize(basic_blocks.size());
+
+    // Number the instructions in the order they will be emitted, and record the first and last mention of each register.
+    size_t position = 0;
+    for (auto& block : basic_blocks) {
+        if (!block_is_reachable[block->index()])
+            continue;
+        block_start_positions[block->index()] = position;
+
+        InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            instruction.visit_operands([&](Operand& operand) {
+                if (!operand.is_register() || operand.index() < Register::reserved_register_count)
+                    return;
+                auto& live_range = live_ranges[operand.index()];
+                live_range.start = min(live_range.start, position);
+                live_range.end = max(live_range.end, position);
+            });
+            instruction.visit_labels([&](Label& label) {
+                edges.append({ position, label.basic_block_index() });
+            });
+            ++position;
+            ++it;
+        }
+
+        // NOTE: An exception can move control from anywhere in the block to its handler. If the handler is laid out
+        //       before the block, the edge from the end of the block is the one that covers all the others.
+        if (block->handler())
+            edges.append({ position, block->handler()->index() });
+
+        // Leave a gap between blocks for the End instruction that may be appended to unterminated blocks.
+        ++position;
+    }
+
+    // A value that is live across a backward edge is live throughout the whole range that edge spans, since
+    // control can go around it again. Code generation always writes a register before reading it, so extending
+    // over backward edges until nothing changes gives us a conservative live range for every register.
+    Vector<LiveRange> backward_edge_ranges;
+    for (auto const& edge : edges) {
+        auto target_position = block_start_positions[edge.to_block_index];
+        if (target_position <= edge.from)
+            backward_edge_ranges.append({ target_position, edge.from });
+    }
+
+    for (auto& live_range : live_ranges) {
+        if (live_range.is_empty())
+            continue;
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (auto const& edge_range : backward_edge_ranges) {
+                if (!live_range.overlaps(edge_range))
+                    continue;
+                if (edge_range.start < live_range.start) {
+                    live_range.start = edge_range.start;
+                    changed = true;
+                }
+                if (edge_range.end > live_range.end) {
+                    live_range.end = edge_range.end;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // Linear scan: hand out slots in order of live range start, reclaiming slots whose occupant died strictly
+    // before the new range starts. A register is never shared within a single instruction, since the interpreter
+    // doesn't guarantee that all of an instruction's inputs are read before its output is written.
+    Vector<u32> registers_by_start;
+    for (u32 i = Register::reserved_register_count; i < number_of_registers; ++i) {
+        if (!live_ranges[i].is_empty())
+            registers_by_start.append(i);
+    }
+    quick_sort(registers_by_start, [&](u32 a, u32 b) {
+        return live_ranges[a].start < live_ranges[b].start;
+    });
+
+    Vector<u32> new_register_index;
+    new_register_index.resize(number_of_registers);
+    BinaryHeap<size_t, u32, 16> occupied_slots;
+    Vector<u32> free_slots;
+    u32 next_slot = Register::reserved_register_count;
+
+    for (auto register_index : registers_by_start) {
+        auto const& live_range = live_ranges[register_index];
+        while (!occupied_slots.is_empty() && occupied_slots.peek_min_key() < live_range.start)
+            free_slots.append(occupied_slots.pop_min());
+
+        auto slot = free_slots.is_empty() ? next_slot++ : free_slots.take_last();
+        occupied_slots.insert(live_range.end, slot);
+        new_register_index[register_index] = slot;
+    }
+
+    if (next_slot >= number_of_registers)
+        return number_of_registers;
+
+    for (auto& block : basic_blocks) {
+        if (!block_is_reachable[block->index()])
+            continue;
+        InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            const_cast<Instruction&>(*it).visit_operands([&](Operand& operand) {
+                if (operand.is_register() && operand.index() >= Register::reserved_register_count)
+                    operand = Operand { Register { new_register_index[operand.index()] } };
+            });
+            ++it;
+        }
+    }
+
+    return next_slot;
+}
+
 CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode const& node, FunctionKind enclosing_function_kind, GC::Ptr<ECMAScriptFunctionObject const> function, MustPropagateCompletion must_propagate_completion, Vector<LocalVariable> local_variable_names)
 {
     Generator generator(vm, function, must_propagate_completion);
@@ -304,7 +457,75 @@ CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode co
         }
     }
 
-    auto number_of_registers = generator.m_next_register;
+    // Pass: Thread jumps through blocks that contain nothing but an unconditional jump.
+    auto resolve_jump_target = [&](size_t block_index) {
+        // NOTE: The iteration count is bounded so that we don't spin forever on empty infinite loops.
+        for (size_t i = 0; i < generator.m_root_basic_blocks.size(); ++i) {
+            auto const& target_block = *generator.m_root_basic_blocks[block_index];
+            if (!target_block.is_terminated())
+                break;
+            InstructionStreamIterator it(target_block.instruction_stream());
+            if (it.at_end() || (*it).type() != Instruction::Type::Jump)
+                break;
+            auto next_block_index = static_cast<Op::Jump const&>(*it).target().basic_block_index();
+            ++it;
+            if (!it.at_end())
+                break;
+            block_index = next_block_index;
+        }
+        return block_index;
+    };
+    for (auto& block : generator.m_root_basic_blocks) {
+        InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                label = Label { static_cast<u32>(resolve_jump_target(label.basic_block_index())) };
+            });
+            ++it;
+        }
+    }
+
+    // Pass: Find the blocks that can be reached from the entry block, so we can skip emitting the rest.
+    Vector<bool> block_is_reachable;
+    block_is_reachable.resize(generator.m_root_basic_blocks.size());
+    {
+        Vector<size_t> blocks_to_visit { 0 };
+        while (!blocks_to_visit.is_empty()) {
+            auto block_index = blocks_to_visit.take_last();
+            if (block_is_reachable[block_index])
+                continue;
+            block_is_reachable[block_index] = true;
+
+            auto const& block = *generator.m_root_basic_blocks[block_index];
+            if (block.handler())
+                blocks_to_visit.append(block.handler()->index());
+            if (block.finalizer())
+                blocks_to_visit.append(block.finalizer()->index());
+
+            InstructionStreamIterator it(block.instruction_stream());
+            while (!it.at_end()) {
+                const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                    blocks_to_visit.append(label.basic_block_index());
+                });
+                ++it;
+            }
+        }
+    }
+
+    // The block that will be laid out directly after each block, taking skipped blocks into account.
+    Vector<size_t> next_emitted_block_index;
+    next_emitted_block_index.resize(generator.m_root_basic_blocks.size());
+    {
+        size_t next_index = generator.m_root_basic_blocks.size();
+        for (size_t i = generator.m_root_basic_blocks.size(); i > 0; --i) {
+            next_emitted_block_index[i - 1] = next_index;
+            if (block_is_reachable[i - 1])
+                next_index = i - 1;
+        }
+    }
+
+    // Pass: Let registers whose live ranges don't overlap share a slot, so that call frames stay small.
+    auto number_of_registers = compact_registers(generator.m_root_basic_blocks, block_is_reachable, generator.m_next_register);
     auto number_of_constants = generator.m_constants.size();
     auto number_of_locals = function ? function->local_variables_names().size() : 0;
 
@@ -341,6 +562,11 @@ CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode co
         undefined_constant.value().operand().offset_index_by(number_of_registers);
 
     for (auto& block : generator.m_root_basic_blocks) {
+        if (!block_is_reachable[block->index()])
+            continue;
+
+        auto next_block_index = next_emitted_block_index[block->index()];
+
         basic_block_start_offsets.append(bytecode.size());
         if (block->handler() || block->finalizer()) {
             unlinked_exception_handlers.append({
@@ -365,7 +591,7 @@ CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode co
                 auto& jump = static_cast<Bytecode::Op::Jump&>(instruction);
 
                 // OPTIMIZATION: Don't emit jumps that just jump to the next block.
-                if (jump.target().basic_block_index() == block->index() + 1) {
+                if (jump.target().basic_block_index() == next_block_index) {
                     if (basic_block_start_offsets.last() == bytecode.size()) {
                         // This block is empty, just skip it.
                         basic_block_start_offsets.take_last();
@@ -402,7 +628,7 @@ CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode co
             //               we can emit a `JumpTrue` or `JumpFalse` (to the other block) instead.
             if (instruction.type() == Instruction::Type::JumpIf) {
                 auto& jump = static_cast<Bytecode::Op::JumpIf&>(instruction);
-                if (jump.true_target().basic_block_index() == block->index() + 1) {
+                if (jump.true_target().basic_block_index() == next_block_index) {
                     Op::JumpFalse jump_false(jump.condition(), Label { jump.false_target() });
                     auto& label = jump_false.target();
                     size_t label_offset = bytecode.size() + (bit_cast<FlatPtr>(&label) - bit_cast<FlatPtr>(&jump_false));
@@ -411,7 +637,7 @@ CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode co
                     ++it;
                     continue;
                 }
-                if (jump.false_target().basic_block_index() == block->index() + 1) {
+                if (jump.false_target().basic_block_index() == next_block_index) {
                     Op::JumpTrue jump_true(jump.condition(), Label { jump.true_target() });
                     auto& label = jump_true.target();
                     size_t label_offset = bytecode.size() + (bit_cast<FlatPtr>(&label) - bit_cast<FlatPtr>(&jump_true));
@@ -452,7 +678,8 @@ CodeGenerationErrorOr<GC::Ref<Executable>> Generator::compile(VM& vm, ASTNode co
         node.source_code(),
         generator.m_next_property_lookup_cache,
         generator.m_next_global_variable_cache,
-        generator.m_next_register,
+        generator.m_next_call_site_cache,
+        number_of_registers,
         is_strict_mode);
 
     Vector<Executable::ExceptionHandlers> linked_exception_handlers;
@@ -1129,6 +1356,26 @@ void Generator::emit_get_by_id_with_this(ScopedOperand dst, ScopedOperand base,
     emit<Op::GetByIdWithThis>(dst, base, id, this_value, m_next_property_lookup_cache++);
 }
 
+bool Generator::is_lazily_created_arguments_object(Expression const& expression) const
+{
+    if (!m_lazy_arguments_object.has_value() || !is<Identifier>(expression))
+        return false;
+    auto const& identifier = static_cast<Identifier const&>(expression);
+    return identifier.is_local() && identifier.local_index().is_variable() && identifier.local_index().index == m_lazy_arguments_object->local_index;
+}
+
+void Generator::emit_create_lazy_arguments_object()
+{
+    VERIFY(m_lazy_arguments_object.has_value());
+    emit<Op::CreateArguments>(lazy_arguments_object(), m_lazy_arguments_object->kind, m_lazy_arguments_object->is_strict);
+}
+
+ScopedOperand Generator::lazy_arguments_object()
+{
+    VERIFY(m_lazy_arguments_object.has_value());
+    return local(Identifier::Local::variable(m_lazy_arguments_object->local_index));
+}
+
 void Generator::emit_get_by_value(ScopedOperand dst, ScopedOperand base, ScopedOperand property, Optional<IdentifierTableIndex> base_identifier)
 {
     if (property.operand().is_constant() && get_constant(property).is_string()) {
@@ -327,6 +327,11 @@ public:
     void emit_get_by_id_with_this(ScopedOperand dst, ScopedOperand base, IdentifierTableIndex, ScopedOperand this_value);
 
     void emit_get_by_value(ScopedOperand dst, ScopedOperand base, ScopedOperand property, Optional<IdentifierTableIndex> base_identifier = {});
+
+    [[nodiscard]] bool is_lazily_created_arguments_object(Expression const&) const;
+    [[nodiscard]] Op::CreateArguments::Kind lazy_arguments_object_kind() const { return m_lazy_arguments_object->kind; }
+    [[nodiscard]] ScopedOperand lazy_arguments_object();
+    void emit_create_lazy_arguments_object();
     void emit_get_by_value_with_this(ScopedOperand dst, ScopedOperand base, ScopedOperand property, ScopedOperand this_value);
 
     void emit_put_by_id(Operand base, IdentifierTableIndex property, Operand src, PutKind kind, u32 cache_index, Optional<IdentifierTableIndex> base_identifier = {});
@@ -338,6 +343,7 @@ public:
     void emit_iterator_complete(ScopedOperand dst, ScopedOperand result);
 
     [[nodiscard]] size_t next_global_variable_cache() { return m_next_global_variable_cache++; }
+    [[nodiscard]] size_t next_call_site_cache() { return m_next_call_site_cache++; }
     [[nodiscard]] size_t next_property_lookup_cache() { return m_next_property_lookup_cache++; }
 
     enum class DeduplicateConstant {
@@ -409,6 +415,7 @@ private:
     u32 m_next_block { 1 };
     u32 m_next_property_lookup_cache { 0 };
     u32 m_next_global_variable_cache { 0 };
+    u32 m_next_call_site_cache { 0 };
     FunctionKind m_enclosing_function_kind { FunctionKind::Normal };
     Vector<LabelableScope> m_continuable_scopes;
     Vector<LabelableScope> m_breakable_scopes;
@@ -419,6 +426,13 @@ private:
     HashTable<u32> m_initialized_arguments;
     Vector<LocalVariable> m_local_variables;
 
+    struct LazyArgumentsObject {
+        u32 local_index { 0 };
+        Op::CreateArguments::Kind kind { Op::CreateArguments::Kind::Mapped };
+        bool is_strict { false };
+    };
+    Optional<LazyArgumentsObject> m_lazy_arguments_object;
+
     bool m_finished { false };
     bool m_must_propagate_completion { true };
 
@@ -54,6 +54,8 @@
     O(EnterObjectEnvironment)          \
     O(EnterUnwindContext)              \
     O(Exp)                             \
+    O(GetArgumentByValue)              \
+    O(GetArgumentsLength)              \
     O(GetById)                         \
     O(GetByIdWithThis)                 \
     O(GetByValue)                      \
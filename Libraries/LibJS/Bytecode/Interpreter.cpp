@@ -7,6 +7,7 @@
 
 #include <AK/Debug.h>
 #include <AK/HashTable.h>
+#include <AK/MemoryAccounting.h>
 #include <AK/TemporaryChange.h>
 #include <LibGC/RootHashMap.h>
 #include <LibJS/AST.h>
@@ -46,6 +47,7 @@
 namespace JS::Bytecode {
 
 bool g_dump_bytecode = false;
+Statistics g_statistics;
 
 static ByteString format_operand(StringView name, Operand operand, Bytecode::Executable const& executable)
 {
@@ -371,6 +373,8 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             program_counter += instruction.length();                                                \
         else                                                                                        \
             program_counter += sizeof(Op::name);                                                    \
+        if constexpr (JS_BYTECODE_STATISTICS_DEBUG)                                                 \
+            ++g_statistics.executed_instructions;                                                   \
         auto& next_instruction = *reinterpret_cast<Instruction const*>(&bytecode[program_counter]); \
         goto* bytecode_dispatch_table[static_cast<size_t>(next_instruction.type())];                \
     } while (0)
@@ -378,6 +382,8 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
     for (;;) {
     start:
         for (;;) {
+            if constexpr (JS_BYTECODE_STATISTICS_DEBUG)
+                ++g_statistics.executed_instructions;
             goto* bytecode_dispatch_table[static_cast<size_t>((*reinterpret_cast<Instruction const*>(&bytecode[program_counter])).type())];
 
         handle_Mov: {
@@ -394,6 +400,11 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
         handle_Jump: {
             auto& instruction = *reinterpret_cast<Op::Jump const*>(&bytecode[program_counter]);
+            if (instruction.target().address() <= program_counter) {
+                ++executable.back_edge_count;
+                if (auto* profiler = vm().sampling_profiler()) [[unlikely]]
+                    profiler->tick(vm());
+            }
             program_counter = instruction.target().address();
             goto start;
         }
@@ -585,6 +596,8 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             HANDLE_INSTRUCTION_WITHOUT_EXCEPTION_CHECK(Dump);
             HANDLE_INSTRUCTION(EnterObjectEnvironment);
             HANDLE_INSTRUCTION(Exp);
+            HANDLE_INSTRUCTION(GetArgumentByValue);
+            HANDLE_INSTRUCTION(GetArgumentsLength);
             HANDLE_INSTRUCTION(GetById);
             HANDLE_INSTRUCTION(GetByIdWithThis);
             HANDLE_INSTRUCTION(GetByValue);
@@ -713,6 +726,9 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
 {
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter will run unit {:p}", &executable);
 
+    // Containers that JS objects own live outside of the GC heap, so we account for them separately.
+    AK::MemoryAccounting::ScopedCategory memory_accounting_category { AK::MemoryAccounting::Category::JSHeapExternal };
+
     TemporaryChange restore_executable { m_current_executable, GC::Ptr { executable } };
     TemporaryChange restore_saved_jump { m_scheduled_jump, Optional<size_t> {} };
     TemporaryChange restore_realm { m_realm, GC::Ptr { vm().current_realm() } };
@@ -738,6 +754,9 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
         reg(Register::this_value()) = running_execution_context.this_value.value_or(js_special_empty_value());
 
     running_execution_context.executable = &executable;
+    ++executable.entry_count;
+    if (auto* profiler = vm().sampling_profiler()) [[unlikely]]
+        profiler->tick(vm());
 
     auto* registers_and_constants_and_locals_and_arguments = running_execution_context.registers_and_constants_and_locals_and_arguments();
     for (size_t i = 0; i < executable.constants.size(); ++i) {
@@ -1214,10 +1233,28 @@ ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value this_value
             }
         }
 
+        // OPTIMIZATION: Sites that have seen too many shapes fall back to the VM-wide megamorphic cache before taking the slow path.
+        MegamorphicPropertyLookupCache::Entry* megamorphic_entry = nullptr;
+        if (caches && caches->is_megamorphic && name.is_string() && !object->shape().is_dictionary()) {
+            megamorphic_entry = &vm.bytecode_interpreter().megamorphic_property_lookup_cache().entry_for(object->shape(), name.as_string());
+            if (megamorphic_entry->type == PropertyLookupCache::Entry::Type::ChangeOwnProperty
+                && &object->shape() == megamorphic_entry->shape
+                && megamorphic_entry->property_name == name.as_string()) {
+                auto value_in_object = object->get_direct(megamorphic_entry->property_offset);
+                if (value_in_object.is_accessor()) [[unlikely]] {
+                    (void)TRY(call(vm, value_in_object.as_accessor().setter(), this_value, value));
+                } else {
+                    object->put_direct(megamorphic_entry->property_offset, value);
+                }
+                return {};
+            }
+        }
+
         CacheableSetPropertyMetadata cacheable_metadata;
         bool succeeded = TRY(object->internal_set(name, value, this_value, &cacheable_metadata));
 
         auto get_cache_slot = [&] -> PropertyLookupCache::Entry& {
+            caches->note_eviction();
             for (size_t i = caches->entries.size() - 1; i >= 1; --i) {
                 caches->entries[i] = caches->entries[i - 1];
             }
@@ -1257,6 +1294,14 @@ ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value this_value
                 if (cache.shape->is_dictionary()) {
                     cache.shape_dictionary_generation = cache.shape->dictionary_generation();
                 }
+
+                if (megamorphic_entry) {
+                    *megamorphic_entry = {};
+                    megamorphic_entry->type = PropertyLookupCache::Entry::Type::ChangeOwnProperty;
+                    megamorphic_entry->shape = object->shape();
+                    megamorphic_entry->property_name = name.as_string();
+                    megamorphic_entry->property_offset = cacheable_metadata.property_offset.value();
+                }
                 break;
             case CacheableSetPropertyMetadata::Type::ChangePropertyInPrototypeChain:
                 cache.type = PropertyLookupCache::Entry::Type::ChangePropertyInPrototypeChain;
@@ -2489,25 +2534,31 @@ void CreateRestParams::execute_impl(Bytecode::Interpreter& interpreter) const
     interpreter.set(m_dst, array);
 }
 
-void CreateArguments::execute_impl(Bytecode::Interpreter& interpreter) const
+static Object* create_arguments_object(Bytecode::Interpreter& interpreter, CreateArguments::Kind kind)
 {
     auto const& function = interpreter.running_execution_context().function;
     auto const arguments = interpreter.running_execution_context().arguments;
     auto const& environment = interpreter.running_execution_context().lexical_environment;
 
     auto passed_arguments = ReadonlySpan<Value> { arguments.data(), interpreter.running_execution_context().passed_argument_count };
-    Object* arguments_object;
-    if (m_kind == Kind::Mapped) {
-        arguments_object = create_mapped_arguments_object(interpreter.vm(), *function, function->formal_parameters(), passed_arguments, *environment);
-    } else {
-        arguments_object = create_unmapped_arguments_object(interpreter.vm(), passed_arguments);
-    }
+    if (kind == CreateArguments::Kind::Mapped)
+        return create_mapped_arguments_object(interpreter.vm(), *function, function->formal_parameters(), passed_arguments, *environment);
+    return create_unmapped_arguments_object(interpreter.vm(), passed_arguments);
+}
 
+void CreateArguments::execute_impl(Bytecode::Interpreter& interpreter) const
+{
     if (m_dst.has_value()) {
-        interpreter.set(*m_dst, arguments_object);
+        // NOTE: A lazily created arguments object is only created the first time it's needed.
+        if (!interpreter.get(*m_dst).is_special_empty_value())
+            return;
+        interpreter.set(*m_dst, create_arguments_object(interpreter, m_kind));
         return;
     }
 
+    auto* arguments_object = create_arguments_object(interpreter, m_kind);
+    auto const& environment = interpreter.running_execution_context().lexical_environment;
+
     if (m_is_immutable) {
         MUST(environment->create_immutable_binding(interpreter.vm(), interpreter.vm().names.arguments.as_string(), false));
     } else {
@@ -2588,6 +2639,41 @@ ThrowCompletionOr<void> GetByIdWithThis::execute_impl(Bytecode::Interpreter& int
     return {};
 }
 
+ThrowCompletionOr<void> GetArgumentsLength::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    auto arguments_object = interpreter.get(m_arguments_object);
+    if (arguments_object.is_special_empty_value()) {
+        interpreter.set(m_dst, Value(interpreter.running_execution_context().passed_argument_count));
+        return {};
+    }
+
+    auto& vm = interpreter.vm();
+    interpreter.set(m_dst, TRY(arguments_object.get(vm, vm.names.length)));
+    return {};
+}
+
+ThrowCompletionOr<void> GetArgumentByValue::execute_impl(Bytecode::Interpreter& interpreter) const
+{
+    auto arguments_object = interpreter.get(m_arguments_object);
+    auto property = interpreter.get(m_property);
+
+    if (arguments_object.is_special_empty_value()) {
+        // Passed arguments are own data properties of a fresh arguments object, so reading them can't be observed.
+        auto const& execution_context = interpreter.running_execution_context();
+        if (property.is_int32() && property.as_i32() >= 0 && static_cast<u32>(property.as_i32()) < execution_context.passed_argument_count) {
+            interpreter.set(m_dst, execution_context.arguments[property.as_i32()]);
+            return {};
+        }
+
+        // Anything else may hit the prototype chain or a non-index property, so we need the real object after all.
+        arguments_object = create_arguments_object(interpreter, m_kind);
+        interpreter.set(m_arguments_object, arguments_object);
+    }
+
+    interpreter.set(m_dst, TRY(get_by_value(interpreter.vm(), {}, arguments_object, property, interpreter.current_executable())));
+    return {};
+}
+
 ThrowCompletionOr<void> GetLength::execute_impl(Bytecode::Interpreter& interpreter) const
 {
     auto base_value = interpreter.get(base());
@@ -2893,7 +2979,41 @@ static ThrowCompletionOr<void> execute_call(
 
 ThrowCompletionOr<void> Call::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    return execute_call<CallType::Call>(interpreter, interpreter.get(m_callee), interpreter.get(m_this_value), { m_arguments, m_argument_count }, m_dst, m_expression_string);
+    auto callee = interpreter.get(m_callee);
+    auto& cache = interpreter.current_executable().call_site_caches[m_cache_index];
+
+    // OPTIMIZATION: If this site is calling the same ECMAScript function as last time, we already know its stack frame size
+    //               and can skip the generic callability check and virtual dispatch.
+    if (callee.is_object() && &callee.as_object() == cache.callee.ptr()) [[likely]] {
+        auto& function = static_cast<ECMAScriptFunctionObject&>(callee.as_object());
+
+        ExecutionContext* callee_context = nullptr;
+        size_t const argument_count = max<size_t>(m_argument_count, cache.formal_parameter_count);
+        ALLOCATE_EXECUTION_CONTEXT_ON_NATIVE_STACK_WITHOUT_CLEARING_ARGS(callee_context, cache.registers_and_constants_and_locals_count, argument_count);
+
+        auto* callee_context_argument_values = callee_context->arguments.data();
+        for (size_t i = 0; i < m_argument_count; ++i)
+            callee_context_argument_values[i] = interpreter.get(m_arguments[i]);
+        for (size_t i = m_argument_count; i < argument_count; ++i)
+            callee_context_argument_values[i] = js_undefined();
+        callee_context->passed_argument_count = m_argument_count;
+
+        interpreter.set(m_dst, TRY(function.ECMAScriptFunctionObject::internal_call(*callee_context, interpreter.get(m_this_value))));
+        return {};
+    }
+
+    TRY(execute_call<CallType::Call>(interpreter, callee, interpreter.get(m_this_value), { m_arguments, m_argument_count }, m_dst, m_expression_string));
+
+    // NOTE: The callee has been compiled by now, so its stack frame size is fixed for the lifetime of the function object.
+    if (callee.is_object() && is<ECMAScriptFunctionObject>(callee.as_object())) {
+        auto& function = static_cast<ECMAScriptFunctionObject&>(callee.as_object());
+        if (auto const& executable = function.bytecode_executable(); executable && !function.is_class_constructor()) {
+            cache.callee = function;
+            cache.registers_and_constants_and_locals_count = executable->number_of_registers + executable->constants.size() + executable->local_variable_names.size();
+            cache.formal_parameter_count = function.formal_parameters().size();
+        }
+    }
+    return {};
 }
 
 NEVER_INLINE ThrowCompletionOr<void> CallConstruct::execute_impl(Bytecode::Interpreter& interpreter) const
@@ -3367,6 +3487,23 @@ ThrowCompletionOr<void> IteratorNextUnpack::execute_impl(Bytecode::Interpreter&
 {
     auto& vm = interpreter.vm();
     auto& iterator_record = static_cast<IteratorRecord&>(interpreter.get(m_iterator_record).as_cell());
+
+    // OPTIMIZATION: Built-in iterators whose "next" hasn't been replaced are stepped directly, without going through
+    //               IteratorStep and its IterationResult bookkeeping.
+    if (auto* builtin_iterator = iterator_record.iterator->as_builtin_iterator_if_next_is_not_redefined(iterator_record)) {
+        Value value;
+        bool done = false;
+        TRY(builtin_iterator->next(vm, done, value));
+        if (done) {
+            iterator_record.done = true;
+            interpreter.set(dst_done(), Value(true));
+            return {};
+        }
+        interpreter.set(dst_done(), Value(false));
+        interpreter.set(dst_value(), value);
+        return {};
+    }
+
     auto iteration_result_or_done = TRY(iterator_step(vm, iterator_record));
     if (iteration_result_or_done.has<IterationDone>()) {
         interpreter.set(dst_done(), Value(true));
@@ -3668,6 +3805,22 @@ ByteString GetByIdWithThis::to_byte_string_impl(Bytecode::Executable const& exec
         format_operand("this"sv, m_this_value, executable));
 }
 
+ByteString GetArgumentsLength::to_byte_string_impl(Bytecode::Executable const& executable) const
+{
+    return ByteString::formatted("GetArgumentsLength {}, {}",
+        format_operand("dst"sv, m_dst, executable),
+        format_operand("arguments"sv, m_arguments_object, executable));
+}
+
+ByteString GetArgumentByValue::to_byte_string_impl(Bytecode::Executable const& executable) const
+{
+    return ByteString::formatted("GetArgumentByValue {}, {}, {}, {}",
+        format_operand("dst"sv, m_dst, executable),
+        format_operand("arguments"sv, m_arguments_object, executable),
+        format_operand("property"sv, m_property, executable),
+        m_kind == CreateArguments::Kind::Mapped ? "mapped"sv : "unmapped"sv);
+}
+
 ByteString GetLength::to_byte_string_impl(Bytecode::Executable const& executable) const
 {
     return ByteString::formatted("GetLength {}, {}",
@@ -80,6 +80,8 @@ public:
 
     ExecutionContext& running_execution_context() { return *m_running_execution_context; }
 
+    MegamorphicPropertyLookupCache& megamorphic_property_lookup_cache() { return m_megamorphic_property_lookup_cache; }
+
     [[nodiscard]] Utf16FlyString const& get_identifier(IdentifierTableIndex) const;
     [[nodiscard]] Optional<Utf16FlyString const&> get_identifier(Optional<IdentifierTableIndex> index) const
     {
@@ -106,10 +108,21 @@ private:
     Span<Value> m_registers_and_constants_and_locals_arguments;
     ExecutionContext* m_running_execution_context { nullptr };
     ReadonlySpan<Utf16FlyString> m_identifier_table;
+    MegamorphicPropertyLookupCache m_megamorphic_property_lookup_cache;
 };
 
 JS_API extern bool g_dump_bytecode;
 
+// What the interpreter did since the process started. This is only gathered when built with JS_BYTECODE_STATISTICS_DEBUG,
+// as counting slows down the dispatch loop.
+struct Statistics {
+    u64 executed_instructions { 0 };
+    u64 property_lookup_cache_hits { 0 };
+    u64 megamorphic_property_lookup_cache_hits { 0 };
+    u64 property_lookup_cache_misses { 0 };
+};
+JS_API extern Statistics g_statistics;
+
 ThrowCompletionOr<GC::Ref<Bytecode::Executable>> compile(VM&, ASTNode const&, JS::FunctionKind kind, Utf16FlyString const& name);
 ThrowCompletionOr<GC::Ref<Bytecode::Executable>> compile(VM&, ECMAScriptFunctionObject const&);
 
@@ -84,6 +84,57 @@ private:
     bool m_is_immutable { false };
 };
 
+// NOTE: These read from a lazily created arguments object. As long as the object hasn't been created, they read
+//       the passed arguments directly.
+class GetArgumentsLength final : public Instruction {
+public:
+    GetArgumentsLength(Operand dst, Operand arguments_object)
+        : Instruction(Type::GetArgumentsLength)
+        , m_dst(dst)
+        , m_arguments_object(arguments_object)
+    {
+    }
+
+    ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
+    ByteString to_byte_string_impl(Bytecode::Executable const&) const;
+    void visit_operands_impl(Function<void(Operand&)> visitor)
+    {
+        visitor(m_dst);
+        visitor(m_arguments_object);
+    }
+
+private:
+    Operand m_dst;
+    Operand m_arguments_object;
+};
+
+class GetArgumentByValue final : public Instruction {
+public:
+    GetArgumentByValue(Operand dst, Operand arguments_object, Operand property, CreateArguments::Kind kind)
+        : Instruction(Type::GetArgumentByValue)
+        , m_dst(dst)
+        , m_arguments_object(arguments_object)
+        , m_property(property)
+        , m_kind(kind)
+    {
+    }
+
+    ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
+    ByteString to_byte_string_impl(Bytecode::Executable const&) const;
+    void visit_operands_impl(Function<void(Operand&)> visitor)
+    {
+        visitor(m_dst);
+        visitor(m_arguments_object);
+        visitor(m_property);
+    }
+
+private:
+    Operand m_dst;
+    Operand m_arguments_object;
+    Operand m_property;
+    CreateArguments::Kind m_kind;
+};
+
 class Mov final : public Instruction {
 public:
     Mov(Operand dst, Operand src)
@@ -1877,12 +1928,13 @@ class Call final : public Instruction {
 public:
     static constexpr bool IsVariableLength = true;
 
-    Call(Operand dst, Operand callee, Operand this_value, ReadonlySpan<ScopedOperand> arguments, Optional<StringTableIndex> expression_string = {})
+    Call(Operand dst, Operand callee, Operand this_value, ReadonlySpan<ScopedOperand> arguments, u32 cache_index, Optional<StringTableIndex> expression_string = {})
         : Instruction(Type::Call)
         , m_dst(dst)
         , m_callee(callee)
         , m_this_value(this_value)
         , m_argument_count(arguments.size())
+        , m_cache_index(cache_index)
         , m_expression_string(expression_string)
     {
         for (size_t i = 0; i < arguments.size(); ++i)
@@ -1901,6 +1953,7 @@ public:
     Optional<StringTableIndex> const& expression_string() const { return m_expression_string; }
 
     u32 argument_count() const { return m_argument_count; }
+    u32 cache_index() const { return m_cache_index; }
 
     ThrowCompletionOr<void> execute_impl(Bytecode::Interpreter&) const;
     ByteString to_byte_string_impl(Bytecode::Executable const&) const;
@@ -1918,6 +1971,7 @@ private:
     Operand m_callee;
     Operand m_this_value;
     u32 m_argument_count { 0 };
+    u32 m_cache_index { 0 };
     Optional<StringTableIndex> m_expression_string;
     Operand m_arguments[];
 };
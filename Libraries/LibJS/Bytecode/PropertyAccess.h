@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <AK/Debug.h>
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/IdentifierTable.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Completion.h>
@@ -114,6 +116,8 @@ ALWAYS_INLINE ThrowCompletionOr<Value> get_by_id(VM& vm, GetBaseIdentifier get_b
                 return true;
             }();
             if (can_use_cache) [[likely]] {
+                if constexpr (JS_BYTECODE_STATISTICS_DEBUG)
+                    ++g_statistics.property_lookup_cache_hits;
                 auto value = cached_prototype->get_direct(cache_entry.property_offset.value());
                 if (value.is_accessor())
                     return TRY(call(vm, value.as_accessor().getter(), this_value));
@@ -130,6 +134,8 @@ ALWAYS_INLINE ThrowCompletionOr<Value> get_by_id(VM& vm, GetBaseIdentifier get_b
             }
 
             if (can_use_cache) [[likely]] {
+                if constexpr (JS_BYTECODE_STATISTICS_DEBUG)
+                    ++g_statistics.property_lookup_cache_hits;
                 auto value = base_obj->get_direct(cache_entry.property_offset.value());
                 if (value.is_accessor()) {
                     return TRY(call(vm, value.as_accessor().getter(), this_value));
@@ -139,6 +145,41 @@ ALWAYS_INLINE ThrowCompletionOr<Value> get_by_id(VM& vm, GetBaseIdentifier get_b
         }
     }
 
+    // OPTIMIZATION: Sites that have seen too many shapes fall back to the VM-wide megamorphic cache before taking the slow path.
+    MegamorphicPropertyLookupCache::Entry* megamorphic_entry = nullptr;
+    if (cache.is_megamorphic && !shape.is_dictionary()) {
+        auto const& property_name = get_property_name();
+        megamorphic_entry = &vm.bytecode_interpreter().megamorphic_property_lookup_cache().entry_for(shape, property_name);
+        if (&shape == megamorphic_entry->shape && megamorphic_entry->property_name == property_name) {
+            Optional<Value> value;
+            switch (megamorphic_entry->type) {
+            case PropertyLookupCache::Entry::Type::GetOwnProperty:
+            case PropertyLookupCache::Entry::Type::ChangeOwnProperty:
+                value = base_obj->get_direct(megamorphic_entry->property_offset);
+                break;
+            case PropertyLookupCache::Entry::Type::GetPropertyInPrototypeChain: {
+                auto cached_prototype = megamorphic_entry->prototype.ptr();
+                auto cached_prototype_chain_validity = megamorphic_entry->prototype_chain_validity.ptr();
+                if (cached_prototype && cached_prototype_chain_validity && cached_prototype_chain_validity->is_valid())
+                    value = cached_prototype->get_direct(megamorphic_entry->property_offset);
+                break;
+            }
+            default:
+                break;
+            }
+            if (value.has_value()) [[likely]] {
+                if constexpr (JS_BYTECODE_STATISTICS_DEBUG)
+                    ++g_statistics.megamorphic_property_lookup_cache_hits;
+                if (value->is_accessor())
+                    return TRY(call(vm, value->as_accessor().getter(), this_value));
+                return *value;
+            }
+        }
+    }
+
+    if constexpr (JS_BYTECODE_STATISTICS_DEBUG)
+        ++g_statistics.property_lookup_cache_misses;
+
     CacheableGetPropertyMetadata cacheable_metadata;
     auto value = TRY(base_obj->internal_get(get_property_name(), this_value, &cacheable_metadata));
 
@@ -147,6 +188,7 @@ ALWAYS_INLINE ThrowCompletionOr<Value> get_by_id(VM& vm, GetBaseIdentifier get_b
     // property with the same name into the object itself.
     if (&shape == &base_obj->shape()) {
         auto get_cache_slot = [&] -> PropertyLookupCache::Entry& {
+            cache.note_eviction();
             for (size_t i = cache.entries.size() - 1; i >= 1; --i) {
                 cache.entries[i] = cache.entries[i - 1];
             }
@@ -172,6 +214,20 @@ ALWAYS_INLINE ThrowCompletionOr<Value> get_by_id(VM& vm, GetBaseIdentifier get_b
                 entry.shape_dictionary_generation = shape.dictionary_generation();
             }
         }
+
+        if (megamorphic_entry && cacheable_metadata.type != CacheableGetPropertyMetadata::Type::NotCacheable) {
+            *megamorphic_entry = {};
+            megamorphic_entry->shape = shape;
+            megamorphic_entry->property_name = get_property_name();
+            megamorphic_entry->property_offset = cacheable_metadata.property_offset.value();
+            if (cacheable_metadata.type == CacheableGetPropertyMetadata::Type::GetOwnProperty) {
+                megamorphic_entry->type = PropertyLookupCache::Entry::Type::GetOwnProperty;
+            } else {
+                megamorphic_entry->type = PropertyLookupCache::Entry::Type::GetPropertyInPrototypeChain;
+                megamorphic_entry->prototype = *cacheable_metadata.prototype;
+                megamorphic_entry->prototype_chain_validity = *prototype_chain_validity;
+            }
+        }
     }
 
     return value;
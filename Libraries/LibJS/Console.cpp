@@ -694,6 +694,58 @@ ThrowCompletionOr<Value> Console::time_end()
     return js_undefined();
 }
 
+// Non-standard: console.profile(label)
+ThrowCompletionOr<Value> Console::profile()
+{
+    auto& vm = realm().vm();
+    auto label = TRY(label_or_fallback(vm, "default"sv));
+
+    // NOTE: The VM only runs one sampling profiler at a time, so nested profiles aren't supported.
+    if (!vm.start_sampling_profiler()) {
+        if (m_client) {
+            GC::RootVector<Value> profile_already_running_warning_message_as_vector { vm.heap() };
+
+            auto message = TRY_OR_THROW_OOM(vm, String::formatted("Profile '{}' could not be started, another profile is already running.", label));
+            profile_already_running_warning_message_as_vector.append(PrimitiveString::create(vm, move(message)));
+
+            TRY(m_client->printer(LogLevel::Warn, move(profile_already_running_warning_message_as_vector)));
+        }
+        return js_undefined();
+    }
+
+    m_profile_label = move(label);
+    return js_undefined();
+}
+
+// Non-standard: console.profileEnd(label)
+ThrowCompletionOr<Value> Console::profile_end()
+{
+    auto& vm = realm().vm();
+
+    if (!m_profile_label.has_value()) {
+        if (m_client) {
+            GC::RootVector<Value> no_profile_running_warning_message_as_vector { vm.heap() };
+            no_profile_running_warning_message_as_vector.append(PrimitiveString::create(vm, "No profile is running."_string));
+            TRY(m_client->printer(LogLevel::Warn, move(no_profile_running_warning_message_as_vector)));
+        }
+        return js_undefined();
+    }
+
+    auto label = m_profile_label.release_value();
+    auto folded_stacks = vm.stop_sampling_profiler().value_or({});
+
+    // The profile is printed as folded stacks, which can be fed straight into flamegraph tools.
+    if (m_client) {
+        GC::RootVector<Value> profile_as_vector { vm.heap() };
+
+        auto message = TRY_OR_THROW_OOM(vm, String::formatted("Profile '{}' finished:\n{}", label, folded_stacks));
+        profile_as_vector.append(PrimitiveString::create(vm, move(message)));
+
+        TRY(m_client->printer(LogLevel::Info, move(profile_as_vector)));
+    }
+    return js_undefined();
+}
+
 GC::RootVector<Value> Console::vm_arguments()
 {
     auto& vm = realm().vm();
@@ -88,6 +88,8 @@ public:
     ThrowCompletionOr<Value> time();
     ThrowCompletionOr<Value> time_log();
     ThrowCompletionOr<Value> time_end();
+    ThrowCompletionOr<Value> profile();
+    ThrowCompletionOr<Value> profile_end();
 
     void output_debug_message(LogLevel log_level, StringView output) const;
     void report_exception(JS::Error const&, bool) const;
@@ -104,6 +106,7 @@ private:
 
     HashMap<String, unsigned> m_counters;
     HashMap<String, Core::ElapsedTimer> m_timer_table;
+    Optional<String> m_profile_label;
     Vector<Group> m_group_stack;
 };
 
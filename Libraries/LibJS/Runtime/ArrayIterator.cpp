@@ -75,6 +75,26 @@ ThrowCompletionOr<void> ArrayIterator::next(VM& vm, bool& done, Value& value)
     // 7. Let kind be O.[[ArrayLikeIterationKind]].
     auto kind = m_iteration_kind;
 
+    // OPTIMIZATION: Arrays keep "length" in sync with their indexed storage, so as long as nothing can intercept indexed
+    //               property access, the values of a simple storage can be read directly without any property lookups.
+    if (kind == PropertyKind::Value && array.has_magical_length_property() && !array.may_interfere_with_indexed_property_access()) {
+        if (auto* storage = array.indexed_properties().storage(); storage && storage->is_simple_storage()) {
+            auto const& simple_storage = static_cast<SimpleIndexedPropertyStorage const&>(*storage);
+            if (index >= simple_storage.array_like_size()) {
+                m_array = js_undefined();
+                value = js_undefined();
+                done = true;
+                return {};
+            }
+            // NOTE: Holes have to be looked up on the prototype chain, so they take the generic path below.
+            if (auto element = simple_storage.inline_get(index); element.has_value()) {
+                m_index++;
+                value = element->value;
+                return {};
+            }
+        }
+    }
+
     size_t length = 0;
 
     // 8. If array has a [[TypedArrayName]] internal slot, then
@@ -31,6 +31,22 @@ GC_DEFINE_ALLOCATOR(ArrayPrototype);
 
 static HashTable<GC::Ref<Object>> s_array_join_seen_objects;
 
+// OPTIMIZATION: If the object has a simple indexed storage without holes and doesn't interfere with indexed property access,
+//               every element in [0, length) is a plain data property, so reads and writes of those elements are not
+//               observable and can go straight to the storage.
+static SimpleIndexedPropertyStorage* packed_storage_covering_length(Object& object, size_t length)
+{
+    if (object.may_interfere_with_indexed_property_access())
+        return nullptr;
+    auto* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return nullptr;
+    auto* simple_storage = static_cast<SimpleIndexedPropertyStorage*>(storage);
+    if (simple_storage->has_empty_elements() || simple_storage->array_like_size() < length || simple_storage->elements().size() < length)
+        return nullptr;
+    return simple_storage;
+}
+
 ArrayPrototype::ArrayPrototype(Realm& realm)
     : Array(realm, realm.intrinsics().object_prototype())
 {
@@ -381,6 +397,12 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::fill)
     else
         to = min(relative_end, length);
 
+    if (auto* storage = packed_storage_covering_length(this_object, to)) {
+        for (u64 i = from; i < to; i++)
+            storage->put(i, vm.argument(0));
+        return this_object;
+    }
+
     for (u64 i = from; i < to; i++)
         TRY(this_object->set(i, vm.argument(0), Object::ShouldThrowExceptions::Yes));
 
@@ -744,6 +766,16 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+
+    if (auto* storage = packed_storage_covering_length(this_object, length)) {
+        auto elements = storage->elements().span().slice(0, length);
+        for (u64 i = from_index; i < length; ++i) {
+            if (same_value_zero(elements[i], value_to_find))
+                return Value(true);
+        }
+        return Value(false);
+    }
+
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -797,6 +829,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    if (auto* storage = packed_storage_covering_length(object, length)) {
+        auto elements = storage->elements().span().slice(0, length);
+        for (; k < length; ++k) {
+            if (is_strictly_equal(search_element, elements[k]))
+                return Value(k);
+        }
+        return Value(-1);
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -908,6 +949,15 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::last_index_of)
         k = (double)length + n;
     }
 
+    if (auto* storage = packed_storage_covering_length(object, length)) {
+        auto elements = storage->elements().span().slice(0, length);
+        for (; k >= 0; --k) {
+            if (is_strictly_equal(search_element, elements[k]))
+                return Value((size_t)k);
+        }
+        return Value(-1);
+    }
+
     // 8. Repeat, while k ≥ 0,
     for (; k >= 0; --k) {
         auto property_key = PropertyKey { k };
@@ -398,6 +398,8 @@ namespace JS {
     P(POSITIVE_INFINITY)                     \
     P(pow)                                   \
     P(preventExtensions)                     \
+    P(profile)                               \
+    P(profileEnd)                            \
     P(promise)                               \
     P(propertyIsEnumerable)                  \
     P(prototype)                             \
@@ -10,6 +10,7 @@
 #include <AK/Time.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Date.h>
+#include <LibJS/Runtime/DateConstructor.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/Intl/AbstractOperations.h>
 #include <LibJS/Runtime/Temporal/ISO8601.h>
@@ -472,6 +473,7 @@ String system_time_zone_identifier()
 void clear_system_time_zone_cache()
 {
     cached_system_time_zone_identifier.clear();
+    clear_parsed_date_string_cache();
 }
 
 // 21.4.1.25 LocalTime ( t ), https://tc39.es/ecma262/#sec-localtime
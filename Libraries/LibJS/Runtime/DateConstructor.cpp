@@ -8,6 +8,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashMap.h>
 #include <AK/Time.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Date.h>
@@ -23,9 +24,34 @@ namespace JS {
 
 GC_DEFINE_ALLOCATOR(DateConstructor);
 
+// OPTIMIZATION: Pages often parse the same few date strings over and over (e.g. when rendering a table of dates), so
+//               we remember recent results. Parsing a date-time without an offset depends on the system time zone, so
+//               this is cleared along with the rest of our time zone caches.
+static HashMap<String, double> s_parsed_date_strings;
+static constexpr size_t MAX_CACHED_PARSED_DATE_STRING_LENGTH = 64;
+static constexpr size_t MAX_CACHED_PARSED_DATE_STRINGS = 1024;
+
+void clear_parsed_date_string_cache()
+{
+    s_parsed_date_strings.clear();
+}
+
 static double parse_date_string(VM& vm, StringView date_string)
 {
-    double result = DateParser::parse(date_string);
+    double result = 0;
+
+    if (auto cached_result = s_parsed_date_strings.get(date_string); cached_result.has_value()) {
+        result = *cached_result;
+    } else {
+        result = DateParser::parse(date_string);
+
+        if (date_string.length() <= MAX_CACHED_PARSED_DATE_STRING_LENGTH) {
+            if (s_parsed_date_strings.size() >= MAX_CACHED_PARSED_DATE_STRINGS)
+                s_parsed_date_strings.clear();
+            s_parsed_date_strings.set(MUST(String::from_utf8(date_string)), result);
+        }
+    }
+
     if (result == NAN)
         vm.host_unrecognized_date_string(date_string);
 
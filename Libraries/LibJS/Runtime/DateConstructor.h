@@ -31,4 +31,6 @@ private:
     JS_DECLARE_NATIVE_FUNCTION(utc);
 };
 
+void clear_parsed_date_string_cache();
+
 }
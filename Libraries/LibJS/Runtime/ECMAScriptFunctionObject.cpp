@@ -128,7 +128,7 @@ GC::Ref<ECMAScriptFunctionObject> ECMAScriptFunctionObject::create_from_function
             function_node.function_length(),
             function_node.parameters(),
             *function_node.body_ptr(),
-            function_node.source_text(),
+            MUST(function_node.source_text().to_byte_string()),
             function_node.is_strict_mode(),
             function_node.is_arrow_function(),
             function_node.parsing_insights(),
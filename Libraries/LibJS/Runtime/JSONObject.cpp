@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/CharacterTypes.h>
 #include <AK/Function.h>
+#include <AK/HashMap.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonParser.h>
@@ -239,19 +241,33 @@ ThrowCompletionOr<String> JSONObject::serialize_json_object(VM& vm, StringifySta
     state.seen_objects.set(&object);
     String previous_indent = state.indent;
     state.indent = MUST(String::formatted("{}{}", state.indent, state.gap));
-    Vector<String> property_strings;
+
+    // OPTIMIZATION: Members are written straight into the result as they are serialized, instead of collecting them
+    //               as separately allocated strings first and joining them afterwards.
+    StringBuilder builder;
+    builder.append('{');
+    bool first = true;
 
     auto process_property = [&](PropertyKey const& key) -> ThrowCompletionOr<void> {
         if (key.is_symbol())
             return {};
         auto serialized_property_string = TRY(serialize_json_property(vm, state, key, &object));
-        if (serialized_property_string.has_value()) {
-            property_strings.append(MUST(String::formatted(
-                "{}:{}{}",
-                quote_json_string(key.to_string()),
-                state.gap.is_empty() ? "" : " ",
-                serialized_property_string)));
+        if (!serialized_property_string.has_value())
+            return {};
+
+        if (!first)
+            builder.append(',');
+        if (!state.gap.is_empty()) {
+            builder.append('\n');
+            builder.append(state.indent);
         }
+        first = false;
+
+        quote_json_string(builder, key.to_string());
+        builder.append(':');
+        if (!state.gap.is_empty())
+            builder.append(' ');
+        builder.append(*serialized_property_string);
         return {};
     };
 
@@ -264,34 +280,12 @@ ThrowCompletionOr<String> JSONObject::serialize_json_object(VM& vm, StringifySta
         for (auto& property : property_list)
             TRY(process_property(property.as_string().utf16_string()));
     }
-    StringBuilder builder;
-    if (property_strings.is_empty()) {
-        builder.append("{}"sv);
-    } else {
-        bool first = true;
-        builder.append('{');
-        if (state.gap.is_empty()) {
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(',');
-                first = false;
-                builder.append(property_string);
-            }
-        } else {
-            builder.append('\n');
-            builder.append(state.indent);
-            auto separator = MUST(String::formatted(",\n{}", state.indent));
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(separator);
-                first = false;
-                builder.append(property_string);
-            }
-            builder.append('\n');
-            builder.append(previous_indent);
-        }
-        builder.append('}');
+
+    if (!first && !state.gap.is_empty()) {
+        builder.append('\n');
+        builder.append(previous_indent);
     }
+    builder.append('}');
 
     state.seen_objects.remove(&object);
     state.indent = previous_indent;
@@ -307,52 +301,33 @@ ThrowCompletionOr<String> JSONObject::serialize_json_array(VM& vm, StringifyStat
     state.seen_objects.set(&object);
     String previous_indent = state.indent;
     state.indent = MUST(String::formatted("{}{}", state.indent, state.gap));
-    Vector<String> property_strings;
 
     auto length = TRY(length_of_array_like(vm, object));
 
-    // Optimization
-    property_strings.ensure_capacity(length);
+    // OPTIMIZATION: Elements are written straight into the result as they are serialized, see SerializeJSONObject.
+    StringBuilder builder;
+    builder.append('[');
 
     for (size_t i = 0; i < length; ++i) {
-        auto serialized_property_string = TRY(serialize_json_property(vm, state, i, &object));
-        if (!serialized_property_string.has_value()) {
-            property_strings.append("null"_string);
-        } else {
-            property_strings.append(serialized_property_string.release_value());
+        if (i != 0)
+            builder.append(',');
+        if (!state.gap.is_empty()) {
+            builder.append('\n');
+            builder.append(state.indent);
         }
+
+        auto serialized_property_string = TRY(serialize_json_property(vm, state, i, &object));
+        if (!serialized_property_string.has_value())
+            builder.append("null"sv);
+        else
+            builder.append(*serialized_property_string);
     }
 
-    StringBuilder builder;
-    if (property_strings.is_empty()) {
-        builder.append("[]"sv);
-    } else {
-        if (state.gap.is_empty()) {
-            builder.append('[');
-            bool first = true;
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(',');
-                first = false;
-                builder.append(property_string);
-            }
-            builder.append(']');
-        } else {
-            builder.append("[\n"sv);
-            builder.append(state.indent);
-            auto separator = MUST(String::formatted(",\n{}", state.indent));
-            bool first = true;
-            for (auto& property_string : property_strings) {
-                if (!first)
-                    builder.append(separator);
-                first = false;
-                builder.append(property_string);
-            }
-            builder.append('\n');
-            builder.append(previous_indent);
-            builder.append(']');
-        }
+    if (length != 0 && !state.gap.is_empty()) {
+        builder.append('\n');
+        builder.append(previous_indent);
     }
+    builder.append(']');
 
     state.seen_objects.remove(&object);
     state.indent = previous_indent;
@@ -362,8 +337,14 @@ ThrowCompletionOr<String> JSONObject::serialize_json_array(VM& vm, StringifyStat
 // 25.5.2.2 QuoteJSONString ( value ), https://tc39.es/ecma262/#sec-quotejsonstring
 String JSONObject::quote_json_string(Utf16View const& string)
 {
-    // 1. Let product be the String value consisting solely of the code unit 0x0022 (QUOTATION MARK).
     StringBuilder builder;
+    quote_json_string(builder, string);
+    return builder.to_string_without_validation();
+}
+
+void JSONObject::quote_json_string(StringBuilder& builder, Utf16View const& string)
+{
+    // 1. Let product be the String value consisting solely of the code unit 0x0022 (QUOTATION MARK).
     builder.append('"');
 
     // 2. For each code point C of StringToCodePoints(value), do
@@ -411,7 +392,6 @@ String JSONObject::quote_json_string(Utf16View const& string)
     builder.append('"');
 
     // 4. Return product.
-    return builder.to_string_without_validation();
 }
 
 // 25.5.1 JSON.parse ( text [ , reviver ] ), https://tc39.es/ecma262/#sec-json.parse
@@ -447,27 +427,348 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
     return unfiltered;
 }
 
+// OPTIMIZATION: Rather than building an intermediate JsonValue tree with AK::JsonParser and converting that into JS values
+//               afterwards, JSON.parse() creates the JS values directly in a single pass over the text. Objects are created
+//               with %Object.prototype%'s initial shape, so objects with the same keys in the same order (as is typical for
+//               arrays of records) end up sharing the same cached shape transitions.
+class JSONTextParser {
+public:
+    JSONTextParser(VM& vm, StringView text)
+        : m_vm(vm)
+        , m_realm(*vm.current_realm())
+        , m_text(text)
+    {
+    }
+
+    ThrowCompletionOr<Value> parse()
+    {
+        skip_whitespace();
+        auto value = TRY(parse_value());
+        skip_whitespace();
+        if (!at_end())
+            return malformed();
+        return value;
+    }
+
+private:
+    bool at_end() const { return m_position >= m_text.length(); }
+    char peek() const { return at_end() ? '\0' : m_text[m_position]; }
+
+    ThrowCompletionOr<void> consume_specific(char expected)
+    {
+        if (peek() != expected)
+            return malformed();
+        ++m_position;
+        return {};
+    }
+
+    void skip_whitespace()
+    {
+        while (!at_end()) {
+            auto ch = m_text[m_position];
+            if (ch != ' ' && ch != '\t' && ch != '\n' && ch != '\r')
+                break;
+            ++m_position;
+        }
+    }
+
+    ThrowCompletionOr<Value> parse_value()
+    {
+        switch (peek()) {
+        case '{':
+            return parse_object();
+        case '[':
+            return parse_array();
+        case '"': {
+            auto string = TRY(consume_string());
+            if (string.contains_escapes)
+                return PrimitiveString::create(m_vm, unescape(string.raw));
+            return PrimitiveString::create(m_vm, String::from_utf8_without_validation(string.raw.bytes()));
+        }
+        case 't':
+            return parse_literal("true"sv, Value(true));
+        case 'f':
+            return parse_literal("false"sv, Value(false));
+        case 'n':
+            return parse_literal("null"sv, js_null());
+        default:
+            return parse_number();
+        }
+    }
+
+    ThrowCompletionOr<Value> parse_literal(StringView literal, Value value)
+    {
+        if (!m_text.substring_view(m_position).starts_with(literal))
+            return malformed();
+        m_position += literal.length();
+        return value;
+    }
+
+    ThrowCompletionOr<Value> parse_object()
+    {
+        if (m_vm.did_reach_stack_space_limit())
+            return m_vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded);
+
+        TRY(consume_specific('{'));
+        auto object = Object::create(m_realm, m_realm.intrinsics().object_prototype());
+
+        skip_whitespace();
+        if (peek() == '}') {
+            ++m_position;
+            return object;
+        }
+
+        for (;;) {
+            skip_whitespace();
+            auto key = TRY(parse_property_key());
+            skip_whitespace();
+            TRY(consume_specific(':'));
+            skip_whitespace();
+            auto value = TRY(parse_value());
+            object->define_direct_property(key, value, default_attributes);
+            skip_whitespace();
+            if (peek() == ',') {
+                ++m_position;
+                continue;
+            }
+            TRY(consume_specific('}'));
+            return object;
+        }
+    }
+
+    ThrowCompletionOr<Value> parse_array()
+    {
+        if (m_vm.did_reach_stack_space_limit())
+            return m_vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded);
+
+        TRY(consume_specific('['));
+        auto array = MUST(Array::create(m_realm, 0));
+
+        skip_whitespace();
+        if (peek() == ']') {
+            ++m_position;
+            return array;
+        }
+
+        for (u32 index = 0;; ++index) {
+            skip_whitespace();
+            auto value = TRY(parse_value());
+            array->define_direct_property(index, value, default_attributes);
+            skip_whitespace();
+            if (peek() == ',') {
+                ++m_position;
+                continue;
+            }
+            TRY(consume_specific(']'));
+            return array;
+        }
+    }
+
+    ThrowCompletionOr<PropertyKey> parse_property_key()
+    {
+        auto string = TRY(consume_string());
+        if (string.contains_escapes)
+            return PropertyKey { unescape(string.raw) };
+
+        // OPTIMIZATION: Keys tend to repeat a lot within a single JSON text, so we avoid converting the same key over and over.
+        return m_property_key_cache.ensure(string.raw, [&] {
+            return PropertyKey { Utf16String::from_utf8_without_validation(string.raw) };
+        });
+    }
+
+    struct RawString {
+        StringView raw;
+        bool contains_escapes { false };
+    };
+
+    ThrowCompletionOr<RawString> consume_string()
+    {
+        TRY(consume_specific('"'));
+
+        auto start = m_position;
+        bool contains_escapes = false;
+
+        for (;;) {
+            if (at_end())
+                return malformed();
+
+            auto ch = static_cast<u8>(m_text[m_position]);
+            if (ch == '"')
+                break;
+            if (ch < 0x20)
+                return malformed();
+
+            if (ch != '\\') {
+                ++m_position;
+                continue;
+            }
+
+            contains_escapes = true;
+            ++m_position;
+
+            switch (peek()) {
+            case '"':
+            case '\\':
+            case '/':
+            case 'b':
+            case 'f':
+            case 'n':
+            case 'r':
+            case 't':
+                ++m_position;
+                break;
+            case 'u':
+                ++m_position;
+                for (size_t i = 0; i < 4; ++i) {
+                    if (!is_ascii_hex_digit(peek()))
+                        return malformed();
+                    ++m_position;
+                }
+                break;
+            default:
+                return malformed();
+            }
+        }
+
+        auto raw = m_text.substring_view(start, m_position - start);
+        ++m_position;
+        return RawString { raw, contains_escapes };
+    }
+
+    // NOTE: The string has already been validated by consume_string().
+    static Utf16String unescape(StringView raw)
+    {
+        StringBuilder builder(StringBuilder::Mode::UTF16, raw.length());
+
+        for (size_t i = 0; i < raw.length();) {
+            auto next_escape = raw.find('\\', i).value_or(raw.length());
+            if (next_escape != i) {
+                builder.append(raw.substring_view(i, next_escape - i));
+                i = next_escape;
+                continue;
+            }
+
+            auto escape = raw[i + 1];
+            i += 2;
+
+            switch (escape) {
+            case 'b':
+                builder.append_code_unit('\b');
+                break;
+            case 'f':
+                builder.append_code_unit('\f');
+                break;
+            case 'n':
+                builder.append_code_unit('\n');
+                break;
+            case 'r':
+                builder.append_code_unit('\r');
+                break;
+            case 't':
+                builder.append_code_unit('\t');
+                break;
+            case 'u': {
+                char16_t code_unit = 0;
+                for (size_t j = 0; j < 4; ++j)
+                    code_unit = (code_unit << 4) | parse_ascii_hex_digit(raw[i + j]);
+                builder.append_code_unit(code_unit);
+                i += 4;
+                break;
+            }
+            default:
+                builder.append_code_unit(escape);
+                break;
+            }
+        }
+
+        return builder.to_utf16_string();
+    }
+
+    ThrowCompletionOr<Value> parse_number()
+    {
+        auto start = m_position;
+
+        bool is_negative = peek() == '-';
+        if (is_negative)
+            ++m_position;
+
+        // The integer part is either a single 0, or a sequence of digits not starting with 0.
+        if (peek() == '0') {
+            ++m_position;
+        } else if (is_ascii_digit(peek())) {
+            while (is_ascii_digit(peek()))
+                ++m_position;
+        } else {
+            return malformed();
+        }
+
+        auto integer_digits = m_position - start - (is_negative ? 1 : 0);
+        bool is_integer = true;
+
+        if (peek() == '.') {
+            is_integer = false;
+            ++m_position;
+            if (!is_ascii_digit(peek()))
+                return malformed();
+            while (is_ascii_digit(peek()))
+                ++m_position;
+        }
+
+        if (peek() == 'e' || peek() == 'E') {
+            is_integer = false;
+            ++m_position;
+            if (peek() == '+' || peek() == '-')
+                ++m_position;
+            if (!is_ascii_digit(peek()))
+                return malformed();
+            while (is_ascii_digit(peek()))
+                ++m_position;
+        }
+
+        auto number_text = m_text.substring_view(start, m_position - start);
+
+        // OPTIMIZATION: Integers with at most 15 digits are exactly representable as doubles, so we can skip the
+        //               general floating point parser for them.
+        if (is_integer && integer_digits <= 15) {
+            i64 value = 0;
+            for (auto ch : number_text.substring_view(is_negative ? 1 : 0))
+                value = value * 10 + parse_ascii_digit(ch);
+            if (is_negative)
+                return Value(value == 0 ? -0.0 : -static_cast<double>(value));
+            return Value(static_cast<double>(value));
+        }
+
+        auto value = number_text.to_number<double>(TrimWhitespace::No);
+        if (!value.has_value())
+            return malformed();
+        return Value(*value);
+    }
+
+    Completion malformed() const
+    {
+        return m_vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+    }
+
+    VM& m_vm;
+    Realm& m_realm;
+    StringView m_text;
+    size_t m_position { 0 };
+    HashMap<StringView, PropertyKey> m_property_key_cache;
+};
+
 // 25.5.1.1 ParseJSON ( text ), https://tc39.es/ecma262/#sec-ParseJSON
 ThrowCompletionOr<Value> JSONObject::parse_json(VM& vm, StringView text)
 {
-    auto json = JsonValue::from_string(text);
-
     // 1. If StringToCodePoints(text) is not a valid JSON text as specified in ECMA-404, throw a SyntaxError exception.
-    if (json.is_error())
-        return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
-
     // 2. Let scriptString be the string-concatenation of "(", text, and ");".
     // 3. Let script be ParseText(scriptString, Script).
     // 4. NOTE: The early error rules defined in 13.2.5.1 have special handling for the above invocation of ParseText.
     // 5. Assert: script is a Parse Node.
     // 6. Let result be ! Evaluation of script.
-    auto result = JSONObject::parse_json_value(vm, json.value());
-
     // 7. NOTE: The PropertyDefinitionEvaluation semantics defined in 13.2.5.5 have special handling for the above evaluation.
     // 8. Assert: result is either a String, a Number, a Boolean, an Object that is defined by either an ArrayLiteral or an ObjectLiteral, or null.
-
     // 9. Return result.
-    return result;
+    return JSONTextParser { vm, text }.parse();
 }
 
 Value JSONObject::parse_json_value(VM& vm, JsonValue const& value)
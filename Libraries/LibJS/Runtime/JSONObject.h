@@ -42,6 +42,7 @@ private:
     static ThrowCompletionOr<String> serialize_json_object(VM&, StringifyState&, Object&);
     static ThrowCompletionOr<String> serialize_json_array(VM&, StringifyState&, Object&);
     static String quote_json_string(Utf16View const&);
+    static void quote_json_string(StringBuilder&, Utf16View const&);
 
     // Parse helpers
     static Object* parse_json_object(VM&, JsonObject const&);
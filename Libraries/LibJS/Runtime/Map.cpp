@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/IntegralMath.h>
 #include <LibJS/Runtime/Map.h>
 
 namespace JS {
@@ -23,71 +24,172 @@ Map::Map(Object& prototype)
 // 24.1.3.1 Map.prototype.clear ( ), https://tc39.es/ecma262/#sec-map.prototype.clear
 void Map::map_clear()
 {
-    m_keys.clear();
+    // NOTE: Insertion ids keep counting up, so iterators that are still live will pick up entries added after this.
     m_entries.clear();
+    m_buckets.clear();
+    m_size = 0;
+    ++m_generation;
 }
 
 // 24.1.3.3 Map.prototype.delete ( key ), https://tc39.es/ecma262/#sec-map.prototype.delete
 bool Map::map_remove(Value const& key)
 {
-    Optional<size_t> index;
+    if (m_buckets.is_empty())
+        return false;
 
-    for (auto it = m_keys.begin(); !it.is_end(); ++it) {
-        if (ValueTraits::equals(*it, key)) {
-            index = it.key();
-            break;
+    auto hash = ValueTraits::hash(key);
+    auto* link = &m_buckets[hash & (m_buckets.size() - 1)];
+    while (*link != no_entry) {
+        auto& stored_entry = m_entries[*link];
+        if (stored_entry.hash == hash && ValueTraits::equals(stored_entry.entry.key, key)) {
+            *link = stored_entry.next_in_bucket;
+            stored_entry.entry = { js_special_empty_value(), js_undefined() };
+            stored_entry.next_in_bucket = no_entry;
+            --m_size;
+
+            // Don't let tombstones dominate the table, as iteration has to step over all of them.
+            if (m_entries.size() > minimum_bucket_count && m_size < m_entries.size() / 4)
+                rehash(max(minimum_bucket_count, size_t { 1 } << AK::ceil_log2(m_size * 2)));
+            return true;
         }
+        link = &stored_entry.next_in_bucket;
     }
-
-    if (!index.has_value())
-        return false;
-
-    m_keys.remove(*index);
-    m_entries.remove(key);
-    return true;
+    return false;
 }
 
 // 24.1.3.6 Map.prototype.get ( key ), https://tc39.es/ecma262/#sec-map.prototype.get
 Optional<Value> Map::map_get(Value const& key) const
 {
-    if (auto it = m_entries.find(key); it != m_entries.end())
-        return it->value;
+    if (auto position = find_position(key); position.has_value())
+        return m_entries[*position].entry.value;
     return {};
 }
 
 // 24.1.3.7 Map.prototype.has ( key ), https://tc39.es/ecma262/#sec-map.prototype.has
 bool Map::map_has(Value const& key) const
 {
-    return m_entries.contains(key);
+    return find_position(key).has_value();
 }
 
 // 24.1.3.9 Map.prototype.set ( key, value ), https://tc39.es/ecma262/#sec-map.prototype.set
 void Map::map_set(Value const& key, Value value)
 {
-    auto it = m_entries.find(key);
-    if (it != m_entries.end()) {
-        it->value = value;
-    } else {
-        auto index = m_next_insertion_id++;
-        m_keys.insert(index, key);
-        m_entries.set(key, value);
+    auto hash = ValueTraits::hash(key);
+
+    if (!m_buckets.is_empty()) {
+        for (auto index = m_buckets[hash & (m_buckets.size() - 1)]; index != no_entry; index = m_entries[index].next_in_bucket) {
+            auto& stored_entry = m_entries[index];
+            if (stored_entry.hash == hash && ValueTraits::equals(stored_entry.entry.key, key)) {
+                stored_entry.entry.value = value;
+                return;
+            }
+        }
+    }
+
+    // The entries array is allowed to grow to as many entries (live or not) as there are buckets. When it's full,
+    // we compact away the tombstones, and only grow the table if that wouldn't leave enough room.
+    if (m_entries.size() >= m_buckets.size()) {
+        auto bucket_count = max(minimum_bucket_count, m_buckets.size());
+        if (m_size >= bucket_count / 2)
+            bucket_count *= 2;
+        rehash(bucket_count);
     }
+
+    VERIFY(m_entries.size() < no_entry);
+    auto& bucket = m_buckets[hash & (m_buckets.size() - 1)];
+    m_entries.append({
+        .entry = { key, value },
+        .insertion_id = m_next_insertion_id++,
+        .hash = hash,
+        .next_in_bucket = bucket,
+    });
+    bucket = static_cast<u32>(m_entries.size() - 1);
+    ++m_size;
 }
 
 size_t Map::map_size() const
 {
-    return m_keys.size();
+    return m_size;
+}
+
+void Map::copy_entries_from(Map const& other)
+{
+    VERIFY(m_entries.is_empty());
+    m_entries = other.m_entries;
+    m_buckets = other.m_buckets;
+    m_size = other.m_size;
+    m_next_insertion_id = other.m_next_insertion_id;
+}
+
+Optional<size_t> Map::find_position(Value const& key) const
+{
+    if (m_buckets.is_empty())
+        return {};
+
+    auto hash = ValueTraits::hash(key);
+    for (auto index = m_buckets[hash & (m_buckets.size() - 1)]; index != no_entry; index = m_entries[index].next_in_bucket) {
+        auto const& stored_entry = m_entries[index];
+        if (stored_entry.hash == hash && ValueTraits::equals(stored_entry.entry.key, key))
+            return index;
+    }
+    return {};
+}
+
+size_t Map::position_of_first_entry_not_inserted_before(size_t insertion_id) const
+{
+    // NOTE: Compaction preserves insertion order, so the entries are always sorted by insertion id.
+    size_t low = 0;
+    size_t high = m_entries.size();
+    while (low < high) {
+        auto middle = low + (high - low) / 2;
+        if (m_entries[middle].insertion_id < insertion_id)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+void Map::rehash(size_t bucket_count)
+{
+    VERIFY(is_power_of_two(bucket_count));
+
+    // Compact the live entries towards the front in place, keeping them in insertion order.
+    if (m_size != m_entries.size()) {
+        size_t live_entries = 0;
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            if (m_entries[i].is_deleted())
+                continue;
+            if (i != live_entries)
+                m_entries[live_entries] = m_entries[i];
+            ++live_entries;
+        }
+        VERIFY(live_entries == m_size);
+        m_entries.shrink(live_entries);
+        ++m_generation;
+    }
+
+    m_buckets.resize(bucket_count);
+    m_buckets.fill(no_entry);
+    m_entries.ensure_capacity(bucket_count);
+
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        auto& stored_entry = m_entries[i];
+        auto& bucket = m_buckets[stored_entry.hash & (bucket_count - 1)];
+        stored_entry.next_in_bucket = bucket;
+        bucket = static_cast<u32>(i);
+    }
 }
 
 void Map::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
-    for (auto& value : m_entries) {
-        visitor.visit(value.key);
-        visitor.visit(value.value);
+    for (auto const& stored_entry : m_entries) {
+        if (stored_entry.is_deleted())
+            continue;
+        visitor.visit(stored_entry.entry.key);
+        visitor.visit(stored_entry.entry.value);
     }
-    // NOTE: The entries in m_keys are already visited by the walk over m_entries above.
-    visitor.ignore(m_keys);
 }
 
 }
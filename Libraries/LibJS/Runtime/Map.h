@@ -6,8 +6,7 @@
 
 #pragma once
 
-#include <AK/HashMap.h>
-#include <AK/RedBlackTree.h>
+#include <AK/Vector.h>
 #include <LibJS/Export.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/Object.h>
@@ -34,36 +33,44 @@ public:
     void map_set(Value const&, Value);
     size_t map_size() const;
 
+    struct Entry {
+        Value key;
+        Value value;
+    };
+
     struct EndIterator {
     };
 
+    // NOTE: Iterators remember the insertion id of the next entry they will look at, so they keep their place even
+    //       when the map compacts its entries. As long as no compaction happened, the cached position is used as-is.
     template<bool IsConst>
     struct IteratorImpl {
-        bool is_end() const
-        {
-            return m_map->m_keys.begin_from(m_index).is_end()
-                && m_map->m_keys.find_smallest_not_below_iterator(m_index).is_end();
-        }
+        bool is_end() const { return position() >= m_map->m_entries.size(); }
 
         IteratorImpl& operator++()
         {
-            ++m_index;
+            auto current_position = position();
+            VERIFY(current_position < m_map->m_entries.size());
+            m_insertion_id = m_map->m_entries[current_position].insertion_id + 1;
+            m_position = current_position + 1;
             return *this;
         }
 
         decltype(auto) operator*()
         {
-            ensure_next_element();
-            return *m_map->m_entries.find(*m_map->m_keys.begin_from(m_index));
+            auto& entry = m_map->m_entries[position()].entry;
+            if constexpr (IsConst)
+                return static_cast<Entry const&>(entry);
+            else
+                return static_cast<Entry&>(entry);
         }
 
         decltype(auto) operator*() const
         {
-            ensure_next_element();
-            return *m_map->m_entries.find(*m_map->m_keys.begin_from(m_index));
+            return static_cast<Entry const&>(m_map->m_entries[position()].entry);
         }
 
-        bool operator==(IteratorImpl const& other) const { return m_index == other.m_index && &m_map == &other.m_map; }
+        bool operator==(IteratorImpl const& other) const { return position() == other.position() && m_map.ptr() == other.m_map.ptr(); }
         bool operator==(EndIterator const&) const { return is_end(); }
 
     private:
@@ -71,35 +78,35 @@ public:
         IteratorImpl(Map const& map)
         requires(IsConst)
             : m_map(map)
+            , m_generation(map.m_generation)
         {
-            ensure_index();
         }
 
         IteratorImpl(Map& map)
         requires(!IsConst)
             : m_map(map)
+            , m_generation(map.m_generation)
         {
-            ensure_index();
         }
 
-        void ensure_index() const
+        size_t position() const
         {
-            if (m_map->m_keys.is_empty())
-                m_index = m_map->m_next_insertion_id;
-            else
-                m_index = m_map->m_keys.begin().key();
-        }
-
-        void ensure_next_element() const
-        {
-            if (auto it = m_map->m_keys.find_smallest_not_below_iterator(m_index); it.is_end())
-                m_index = m_map->m_next_insertion_id;
-            else
-                m_index = it.key();
+            auto const& entries = m_map->m_entries;
+            if (m_generation != m_map->m_generation) {
+                m_position = m_map->position_of_first_entry_not_inserted_before(m_insertion_id);
+                m_generation = m_map->m_generation;
+            }
+            while (m_position < entries.size() && entries[m_position].is_deleted())
+                ++m_position;
+            if (m_position < entries.size())
+                m_insertion_id = entries[m_position].insertion_id;
+            return m_position;
         }
 
         Conditional<IsConst, GC::Ref<Map const>, GC::Ref<Map>> m_map;
-        mutable size_t m_index { 0 };
+        mutable size_t m_insertion_id { 0 };
+        mutable size_t m_position { 0 };
+        mutable u32 m_generation { 0 };
     };
 
     using Iterator = IteratorImpl<false>;
@@ -109,13 +116,38 @@ public:
     Iterator begin() { return { *this }; }
     EndIterator end() const { return {}; }
 
+    void copy_entries_from(Map const&);
+
 private:
     explicit Map(Object& prototype);
     virtual void visit_edges(Visitor& visitor) override;
 
+    static constexpr u32 no_entry = NumericLimits<u32>::max();
+    static constexpr size_t minimum_bucket_count = 8;
+
+    // The map is laid out as a deterministic hash table: all entries live in a single array in insertion order, and
+    // each bucket holds the index of the most recently inserted entry with that hash, chained through the entries.
+    // Removed entries stay behind as tombstones until the table is compacted, which keeps iteration order stable.
+    struct StoredEntry {
+        Entry entry;
+        size_t insertion_id { 0 };
+        u32 hash { 0 };
+        u32 next_in_bucket { no_entry };
+
+        bool is_deleted() const { return entry.key.is_special_empty_value(); }
+    };
+
+    Optional<size_t> find_position(Value const& key) const;
+    size_t position_of_first_entry_not_inserted_before(size_t insertion_id) const;
+    void rehash(size_t bucket_count);
+
+    Vector<StoredEntry> m_entries;
+    Vector<u32> m_buckets;
+    size_t m_size { 0 };
     size_t m_next_insertion_id { 0 };
-    RedBlackTree<size_t, Value> m_keys;
-    HashMap<Value, Value, ValueTraits> m_entries;
+
+    // Incremented whenever entries move to a different position, so that iterators know to find their place again.
+    u32 m_generation { 0 };
 };
 
 template<>
@@ -24,6 +24,13 @@ namespace JS {
 GC_DEFINE_ALLOCATOR(PrimitiveString);
 GC_DEFINE_ALLOCATOR(RopeString);
 
+// Concatenations whose combined length is below this are copied right away, as a rope node would cost more than the copy.
+static constexpr size_t minimum_rope_length = 13;
+
+// Ropes deeper than this are flattened eagerly, so that a long chain of `+=` doesn't build an arbitrarily deep tree
+// that has to be walked in its entirety the first time the string is inspected.
+static constexpr u32 maximum_rope_depth = 1024;
+
 GC::Ref<PrimitiveString> PrimitiveString::create(VM& vm, Utf16String const& string)
 {
     if (string.is_empty())
@@ -110,7 +117,34 @@ GC::Ref<PrimitiveString> PrimitiveString::create(VM& vm, PrimitiveString& lhs, P
     if (rhs_empty)
         return lhs;
 
-    return vm.heap().allocate<RopeString>(lhs, rhs);
+    // OPTIMIZATION: Short flat strings are concatenated eagerly instead of creating a rope.
+    if (!lhs.m_is_rope && !rhs.m_is_rope && lhs.approximate_flat_length() + rhs.approximate_flat_length() < minimum_rope_length) {
+        StringBuilder builder(StringBuilder::Mode::UTF16, minimum_rope_length);
+        for (auto const* piece : { &lhs, &rhs }) {
+            if (piece->has_utf16_string())
+                builder.append(piece->utf16_string_view());
+            else
+                builder.append(piece->utf8_string_view());
+        }
+        return create(vm, builder.to_utf16_string());
+    }
+
+    // OPTIMIZATION: When appending a short flat string to a rope that itself ends in a short flat string (the typical
+    //               shape of `s += "..."` in a loop), merge the two tails instead of growing the rope by another level.
+    if (lhs.m_is_rope && !rhs.m_is_rope) {
+        auto& lhs_rope = static_cast<RopeString&>(lhs);
+        auto& lhs_tail = *lhs_rope.m_rhs;
+        if (!lhs_tail.m_is_rope && lhs_tail.approximate_flat_length() + rhs.approximate_flat_length() < minimum_rope_length)
+            return vm.heap().allocate<RopeString>(*lhs_rope.m_lhs, create(vm, lhs_tail, rhs));
+    }
+
+    auto rope = vm.heap().allocate<RopeString>(lhs, rhs);
+
+    // OPTIMIZATION: Flatten overly deep ropes right away, so the next concatenation starts from a single leaf.
+    if (rope->m_depth > maximum_rope_depth)
+        rope->resolve(EncodingPreference::UTF16);
+
+    return rope;
 }
 
 PrimitiveString::PrimitiveString(Utf16String string)
@@ -221,6 +255,22 @@ ThrowCompletionOr<Optional<Value>> PrimitiveString::get(VM& vm, PropertyKey cons
     return create(vm, string.substring_view(index.as_index(), 1));
 }
 
+size_t PrimitiveString::approximate_flat_length() const
+{
+    VERIFY(!m_is_rope);
+
+    if (has_utf16_string())
+        return m_utf16_string->length_in_code_units();
+    return m_utf8_string->bytes_as_string_view().length();
+}
+
+u32 PrimitiveString::rope_depth() const
+{
+    if (!m_is_rope)
+        return 0;
+    return static_cast<RopeString const&>(*this).m_depth;
+}
+
 void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) const
 {
     if (!m_is_rope)
@@ -351,6 +401,7 @@ RopeString::RopeString(GC::Ref<PrimitiveString> lhs, GC::Ref<PrimitiveString> rh
     : PrimitiveString(RopeTag::Rope)
     , m_lhs(lhs)
     , m_rhs(rhs)
+    , m_depth(max(lhs->rope_depth(), rhs->rope_depth()) + 1)
 {
 }
 
@@ -82,6 +82,9 @@ private:
     explicit PrimitiveString(String);
 
     void resolve_rope_if_needed(EncodingPreference) const;
+
+    size_t approximate_flat_length() const;
+    u32 rope_depth() const;
 };
 
 class RopeString final : public PrimitiveString {
@@ -102,6 +105,7 @@ private:
 
     mutable GC::Ptr<PrimitiveString> m_lhs;
     mutable GC::Ptr<PrimitiveString> m_rhs;
+    u32 m_depth { 0 };
 };
 
 }
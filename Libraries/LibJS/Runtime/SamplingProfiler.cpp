@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <LibJS/Runtime/ExecutionContext.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
+#include <LibJS/Runtime/VM.h>
+
+namespace JS {
+
+SamplingProfiler::SamplingProfiler(AK::Duration interval)
+    : m_interval(interval)
+    , m_last_sample_time(MonotonicTime::now())
+{
+}
+
+void SamplingProfiler::maybe_take_sample(VM& vm)
+{
+    auto now = MonotonicTime::now();
+    auto elapsed = now - m_last_sample_time;
+    if (elapsed < m_interval)
+        return;
+    m_last_sample_time = now;
+
+    // A sample stands in for all the intervals that passed since the previous one, so that long stretches
+    // between ticks (e.g. inside native code) are not under-represented.
+    auto weight = static_cast<size_t>(elapsed.to_nanoseconds() / max<i64>(m_interval.to_nanoseconds(), 1));
+    record_sample(vm, {}, weight);
+}
+
+void SamplingProfiler::add_sample(VM& vm, StringView innermost_frames, size_t weight)
+{
+    m_last_sample_time = MonotonicTime::now();
+    m_ticks_since_last_clock_check = 0;
+    record_sample(vm, innermost_frames, weight);
+}
+
+void SamplingProfiler::record_sample(VM& vm, StringView innermost_frames, size_t weight)
+{
+    StringBuilder builder;
+    bool first = true;
+    for (auto const* execution_context : vm.execution_context_stack()) {
+        if (!first)
+            builder.append(';');
+        first = false;
+
+        if (execution_context->function_name)
+            builder.append(execution_context->function_name->utf8_string_view());
+        else if (execution_context->function)
+            builder.append("(anonymous)"sv);
+        else
+            builder.append("(program)"sv);
+    }
+    if (!innermost_frames.is_empty()) {
+        if (!first)
+            builder.append(';');
+        first = false;
+        builder.append(innermost_frames);
+    }
+    if (first)
+        builder.append("(idle)"sv);
+
+    m_folded_stacks.ensure(builder.to_string_without_validation(), [] { return 0; }) += weight;
+    m_sample_count += weight;
+}
+
+String SamplingProfiler::folded_stacks() const
+{
+    Vector<String const*> stacks;
+    stacks.ensure_capacity(m_folded_stacks.size());
+    for (auto const& it : m_folded_stacks)
+        stacks.append(&it.key);
+    quick_sort(stacks, [](auto const* a, auto const* b) { return a->bytes_as_string_view() < b->bytes_as_string_view(); });
+
+    StringBuilder builder;
+    for (auto const* stack : stacks)
+        builder.appendff("{} {}\n", *stack, *m_folded_stacks.get(*stack));
+    return builder.to_string_without_validation();
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <LibJS/Export.h>
+#include <LibJS/Forward.h>
+
+namespace JS {
+
+// A low-overhead sampling profiler for the bytecode interpreter.
+//
+// Instead of interrupting the interpreter from a signal handler or another thread (which would have to inspect the
+// execution context stack while it's being mutated), the interpreter ticks the profiler at function entries and loop
+// back-edges. Only every few ticks is the clock consulted, and a sample of the execution context stack is taken once
+// the sampling interval has elapsed. Samples are aggregated as folded stacks, which is the input format of flamegraph
+// tools (e.g. flamegraph.pl, inferno or speedscope).
+class JS_API SamplingProfiler {
+    AK_MAKE_NONCOPYABLE(SamplingProfiler);
+    AK_MAKE_NONMOVABLE(SamplingProfiler);
+
+public:
+    explicit SamplingProfiler(AK::Duration interval);
+
+    ALWAYS_INLINE void tick(VM& vm)
+    {
+        if (++m_ticks_since_last_clock_check < ticks_per_clock_check)
+            return;
+        m_ticks_since_last_clock_check = 0;
+        maybe_take_sample(vm);
+    }
+
+    // Records a sample of frames the VM doesn't know about (e.g. WebAssembly functions), on top of the current stack of
+    // execution contexts. The frames are folded from outermost to innermost, and the sample stands in for `weight`
+    // sampling intervals. This also counts as the profiler's latest sample, so the time isn't attributed twice.
+    void add_sample(VM&, StringView innermost_frames, size_t weight);
+
+    size_t sample_count() const { return m_sample_count; }
+
+    // Returns one line per distinct stack, in the form "outermost;...;innermost <sample count>".
+    String folded_stacks() const;
+
+private:
+    static constexpr u32 ticks_per_clock_check = 64;
+
+    void maybe_take_sample(VM&);
+    void record_sample(VM&, StringView innermost_frames, size_t weight);
+
+    AK::Duration m_interval;
+    MonotonicTime m_last_sample_time;
+    u32 m_ticks_since_last_clock_check { 0 };
+
+    size_t m_sample_count { 0 };
+    HashMap<String, size_t> m_folded_stacks;
+};
+
+}
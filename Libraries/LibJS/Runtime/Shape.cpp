@@ -329,7 +329,9 @@ GC::Ref<Shape> Shape::clone_for_prototype()
     auto new_shape = heap().allocate<Shape>(m_realm);
     s_all_prototype_shapes.set(new_shape);
     new_shape->m_is_prototype_shape = true;
+    new_shape->m_is_in_prototype_chain_of_prototype_shape = m_is_in_prototype_chain_of_prototype_shape;
     new_shape->m_prototype = m_prototype;
+    new_shape->mark_prototype_as_in_prototype_chain_of_prototype_shape();
     ensure_property_table();
     new_shape->ensure_property_table();
     (*new_shape->m_property_table) = *m_property_table;
@@ -343,6 +345,8 @@ void Shape::set_prototype_without_transition(Object* new_prototype)
     VERIFY(new_prototype);
     new_prototype->convert_to_prototype_if_needed();
     m_prototype = new_prototype;
+    if (m_is_prototype_shape)
+        mark_prototype_as_in_prototype_chain_of_prototype_shape();
 }
 
 void Shape::set_prototype_shape()
@@ -351,12 +355,21 @@ void Shape::set_prototype_shape()
     s_all_prototype_shapes.set(this);
     m_is_prototype_shape = true;
     m_prototype_chain_validity = heap().allocate<PrototypeChainValidity>();
+    mark_prototype_as_in_prototype_chain_of_prototype_shape();
+}
+
+void Shape::mark_prototype_as_in_prototype_chain_of_prototype_shape()
+{
+    VERIFY(m_is_prototype_shape);
+    if (m_prototype)
+        m_prototype->shape().m_is_in_prototype_chain_of_prototype_shape = true;
 }
 
 void Shape::invalidate_prototype_if_needed_for_new_prototype(GC::Ref<Shape> new_prototype_shape)
 {
     if (!m_is_prototype_shape)
         return;
+    new_prototype_shape->m_is_in_prototype_chain_of_prototype_shape = m_is_in_prototype_chain_of_prototype_shape;
     new_prototype_shape->set_prototype_shape();
     m_prototype_chain_validity->set_valid(false);
 
@@ -375,6 +388,12 @@ void Shape::invalidate_prototype_if_needed_for_change_without_transition()
 
 void Shape::invalidate_all_prototype_chains_leading_to_this()
 {
+    // OPTIMIZATION: Every prototype chain that leads to this shape's object passes through a prototype shape whose
+    //               prototype is that object, which would have marked this shape. So if it isn't marked, we can avoid
+    //               looking at every prototype shape in the process.
+    if (!m_is_in_prototype_chain_of_prototype_shape)
+        return;
+
     HashTable<Shape*> shapes_to_invalidate;
     for (auto& candidate : s_all_prototype_shapes) {
         if (!candidate->m_prototype)
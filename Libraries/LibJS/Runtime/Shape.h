@@ -116,6 +116,7 @@ private:
     void invalidate_prototype_if_needed_for_new_prototype(GC::Ref<Shape> new_prototype_shape);
     void invalidate_prototype_if_needed_for_change_without_transition();
     void invalidate_all_prototype_chains_leading_to_this();
+    void mark_prototype_as_in_prototype_chain_of_prototype_shape();
 
     virtual void visit_edges(Visitor&) override;
 
@@ -147,6 +148,12 @@ private:
     bool m_dictionary : 1 { false };
     bool m_cacheable : 1 { true };
     bool m_is_prototype_shape : 1 { false };
+
+    // Set on the shapes of objects that are the prototype of a prototype shape, and inherited by the shapes they
+    // transition to. If this isn't set, no prototype chain leads to the object, so changing it doesn't have to look
+    // for chains to invalidate. This matters while a realm sets up its intrinsics, which adds hundreds of properties
+    // to prototypes that nothing inherits from yet.
+    bool m_is_in_prototype_chain_of_prototype_shape : 1 { false };
 };
 
 }
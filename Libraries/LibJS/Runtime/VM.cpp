@@ -71,6 +71,20 @@ VM::VM(ErrorMessages error_messages)
 {
     m_bytecode_interpreter = make<Bytecode::Interpreter>(*this);
 
+    // Register files of execution contexts on the execution context stack are visited precisely by gather_roots(),
+    // so the heap doesn't need to scan them conservatively when they live on the native stack.
+    m_heap.set_gather_precisely_visited_stack_ranges([this](GC::Heap::PreciselyVisitedStackRanges& ranges) {
+        auto add_ranges_from_execution_context_stack = [&ranges](Vector<ExecutionContext*> const& stack) {
+            for (auto* execution_context : stack) {
+                auto values = execution_context->registers_and_constants_and_locals_and_arguments_span();
+                ranges.append({ values.data(), values.size() * sizeof(Value) });
+            }
+        };
+        add_ranges_from_execution_context_stack(m_execution_context_stack);
+        for (auto& saved_stack : m_saved_execution_context_stacks)
+            add_ranges_from_execution_context_stack(saved_stack);
+    });
+
     m_empty_string = m_heap.allocate<PrimitiveString>(String {});
 
     cached_strings = {
@@ -768,6 +782,22 @@ static RefPtr<CachedSourceRange> get_source_range(ExecutionContext const* contex
     return context->cached_source_range;
 }
 
+bool VM::start_sampling_profiler(AK::Duration interval)
+{
+    if (m_sampling_profiler)
+        return false;
+    m_sampling_profiler = make<SamplingProfiler>(interval);
+    return true;
+}
+
+Optional<String> VM::stop_sampling_profiler()
+{
+    if (!m_sampling_profiler)
+        return {};
+    auto profiler = m_sampling_profiler.release_nonnull();
+    return profiler->folded_stacks();
+}
+
 Vector<StackTraceElement> VM::stack_trace() const
 {
     Vector<StackTraceElement> stack_trace;
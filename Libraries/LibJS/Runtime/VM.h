@@ -29,6 +29,7 @@
 #include <LibJS/Runtime/ErrorTypes.h>
 #include <LibJS/Runtime/ExecutionContext.h>
 #include <LibJS/Runtime/Promise.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibJS/Runtime/Value.h>
 
 namespace JS {
@@ -155,6 +156,11 @@ public:
 
     // https://tc39.es/ecma262/#execution-context-stack
     // The execution context stack is used to track execution contexts.
+    // Only non-null while the sampling profiler is running.
+    SamplingProfiler* sampling_profiler() { return m_sampling_profiler.ptr(); }
+    bool start_sampling_profiler(AK::Duration interval = AK::Duration::from_milliseconds(1));
+    Optional<String> stop_sampling_profiler();
+
     Vector<ExecutionContext*> const& execution_context_stack() const { return m_execution_context_stack; }
     Vector<ExecutionContext*>& execution_context_stack() { return m_execution_context_stack; }
 
@@ -335,6 +341,8 @@ private:
 
     Vector<Vector<ExecutionContext*>> m_saved_execution_context_stacks;
 
+    OwnPtr<SamplingProfiler> m_sampling_profiler;
+
     StackInfo m_stack_info;
 
     // GlobalSymbolRegistry, https://tc39.es/ecma262/#table-globalsymbolregistry-record-fields
@@ -18,8 +18,22 @@ struct ValueTraits : public Traits<Value> {
     static unsigned hash(Value value)
     {
         VERIFY(!value.is_special_empty_value());
-        if (value.is_string())
-            return value.as_string().utf8_string().hash();
+
+        // NOTE: Numbers that fit in an i32 are always stored as such, so this can't disagree with the encoded hash below.
+        if (value.is_int32())
+            return int_hash(static_cast<u32>(value.as_i32()));
+
+        if (value.is_string()) {
+            auto const& string = value.as_string();
+
+            // OPTIMIZATION: ASCII strings hash the same in UTF-8 and UTF-16 form, so we don't need to create a UTF-8
+            //               copy of strings that we only have in UTF-16 form.
+            if (!string.has_utf8_string() && string.has_utf16_string()) {
+                if (auto view = string.utf16_string_view(); view.has_ascii_storage())
+                    return view.hash();
+            }
+            return string.utf8_string().hash();
+        }
 
         if (value.is_bigint())
             return value.as_bigint().big_integer().hash();
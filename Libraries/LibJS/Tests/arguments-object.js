@@ -13,3 +13,50 @@ test("basic arguments object", () => {
     expect(bar("hello", "friends", ":^)")).toBe("friends");
     expect(bar("hello")).toBe(undefined);
 });
+
+test("arguments object reads before and after it is observed as an object", () => {
+    function sum() {
+        let total = 0;
+        for (let i = 0; i < arguments.length; ++i) total += arguments[i];
+        return total;
+    }
+    expect(sum()).toBe(0);
+    expect(sum(1, 2, 3)).toBe(6);
+
+    function outOfRange() {
+        return [arguments[-1], arguments[3], arguments["0"], arguments[0.5]];
+    }
+    expect(outOfRange("a", "b", "c")).toEqual([undefined, undefined, "a", undefined]);
+
+    function writeThenRead() {
+        arguments[0] = "changed";
+        arguments[5] = "added";
+        return [arguments[0], arguments[5], arguments.length];
+    }
+    expect(writeThenRead("original")).toEqual(["changed", "added", 1]);
+
+    function reassigned() {
+        const before = arguments.length;
+        arguments = { length: 42, 0: "replaced" };
+        return [before, arguments.length, arguments[0]];
+    }
+    expect(reassigned(1, 2)).toEqual([2, 42, "replaced"]);
+
+    function escapes() {
+        const object = arguments;
+        object.length = 10;
+        return [arguments.length, object === arguments];
+    }
+    expect(escapes(1)).toEqual([10, true]);
+
+    Object.prototype[3] = "from prototype";
+    try {
+        function fromPrototype() {
+            return arguments[3];
+        }
+        expect(fromPrototype(1)).toBe("from prototype");
+        expect(fromPrototype(1, 2, 3, 4)).toBe(4);
+    } finally {
+        delete Object.prototype[3];
+    }
+});
@@ -28,3 +28,19 @@ test("is unscopable", () => {
         }).toThrowWithMessage(ReferenceError, "'fill' is not defined");
     }
 });
+
+test("frozen and setter-bearing arrays", () => {
+    expect(() => Object.freeze([1, 2, 3]).fill(0)).toThrow(TypeError);
+
+    const array = [1, 2, 3];
+    let setterValue;
+    Object.defineProperty(array, 1, {
+        set(value) {
+            setterValue = value;
+        },
+    });
+    array.fill(7);
+    expect(array[0]).toBe(7);
+    expect(setterValue).toBe(7);
+    expect(array[2]).toBe(7);
+});
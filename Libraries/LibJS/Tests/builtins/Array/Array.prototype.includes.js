@@ -26,3 +26,25 @@ test("is unscopable", () => {
         }).toThrowWithMessage(ReferenceError, "'includes' is not defined");
     }
 });
+
+test("holes and prototype elements", () => {
+    const array = [1, , 3];
+    expect(array.includes(undefined)).toBeTrue();
+    Array.prototype[1] = 2;
+    try {
+        expect(array.includes(2)).toBeTrue();
+    } finally {
+        delete Array.prototype[1];
+    }
+});
+
+test("array shrunk by fromIndex conversion", () => {
+    const array = [1, 2, 3, 4];
+    const fromIndex = {
+        valueOf() {
+            array.length = 1;
+            return 0;
+        },
+    };
+    expect(array.includes(undefined, fromIndex)).toBeTrue();
+});
@@ -23,3 +23,28 @@ test("basic functionality", () => {
     expect([].indexOf()).toBe(-1);
     expect([undefined].indexOf()).toBe(0);
 });
+
+test("array grown or shrunk by fromIndex conversion", () => {
+    const array = [1, 2, 3, 4];
+    const fromIndex = {
+        valueOf() {
+            array.length = 1;
+            return 0;
+        },
+    };
+    expect(array.indexOf(4, fromIndex)).toBe(-1);
+    expect(array.lastIndexOf(1, { valueOf: () => 3 })).toBe(0);
+});
+
+test("getters on elements are observed", () => {
+    const array = [1, 2, 3];
+    let calls = 0;
+    Object.defineProperty(array, 1, {
+        get() {
+            ++calls;
+            return 5;
+        },
+    });
+    expect(array.indexOf(5)).toBe(1);
+    expect(calls).toBe(1);
+});
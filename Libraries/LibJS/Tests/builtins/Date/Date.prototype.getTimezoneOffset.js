@@ -27,4 +27,27 @@ describe("correct behavior", () => {
         const offset1 = d1.getTimezoneOffset();
         expect(offset0).toBe(offset1);
     });
+
+    test("around time zone transitions", () => {
+        const originalTimeZone = setTimeZone("America/New_York");
+
+        const beforeSpringForward = Date.UTC(2023, 2, 12, 6, 59, 59, 999);
+        const afterSpringForward = Date.UTC(2023, 2, 12, 7);
+        const beforeFallBack = Date.UTC(2023, 10, 5, 5, 59, 59, 999);
+        const afterFallBack = Date.UTC(2023, 10, 5, 6);
+
+        // Query each side of the transitions repeatedly and out of order, so that later lookups hit offsets that
+        // have been computed before.
+        for (let i = 0; i < 2; ++i) {
+            expect(new Date(afterFallBack).getTimezoneOffset()).toBe(300);
+            expect(new Date(beforeSpringForward).getTimezoneOffset()).toBe(300);
+            expect(new Date(afterSpringForward).getTimezoneOffset()).toBe(240);
+            expect(new Date(beforeFallBack).getTimezoneOffset()).toBe(240);
+        }
+
+        setTimeZone("Australia/Perth");
+        expect(new Date(afterSpringForward).getTimezoneOffset()).toBe(-480);
+
+        setTimeZone(originalTimeZone);
+    });
 });
@@ -74,3 +74,32 @@ test("does not truncate large integers", () => {
     expect(JSON.parse("18446744073709551616")).toEqual(18446744073709551616);
     expect(JSON.parse("18446744073709551617")).toEqual(18446744073709551617);
 });
+
+test("negative zero and exponents", () => {
+    expect(JSON.parse("-0")).toBe(-0);
+    expect(JSON.parse("-0.0")).toBe(-0);
+    expect(JSON.parse("1e3")).toBe(1000);
+    expect(JSON.parse("-1.5E-2")).toBe(-0.015);
+    expect(JSON.parse("1e400")).toBe(Infinity);
+});
+
+test("escapes and lone surrogates", () => {
+    expect(JSON.parse('"\\u0041\\n\\/\\\\"')).toBe("A\n/\\");
+    expect(JSON.parse('"\\ud834"')).toBe("\ud834");
+    expect(JSON.parse('"\\ud834\\udf06"')).toBe("𝌆");
+    expect(JSON.parse('{"\\u0061": 1}')).toEqual({ a: 1 });
+});
+
+test("repeated and duplicate keys", () => {
+    const result = JSON.parse('[{"a":1,"b":2},{"a":3,"b":4},{"b":5,"a":6,"b":7}]');
+    expect(result[1].a).toBe(3);
+    expect(Object.keys(result[2])).toEqual(["b", "a"]);
+    expect(result[2].b).toBe(7);
+    expect(JSON.parse('{"0": 1, "__proto__": 2}')).toEqual({ 0: 1, ["__proto__"]: 2 });
+});
+
+test("rejects malformed text", () => {
+    ["01", "1.", ".1", "-", "+1", '"\t"', '"\\x"', "[1,]", '{"a":1,}', "tru", "[] x", '"\\u12g4"'].forEach(text => {
+        expect(() => JSON.parse(text)).toThrow(SyntaxError);
+    });
+});
@@ -82,4 +82,52 @@ describe("modification with active iterators", () => {
         expect(iterator.next()).toBeIteratorResultDone();
         expect(iterator.next()).toBeIteratorResultDone();
     });
+
+    test("iterators keep their place when deletions compact the map", () => {
+        const map = new Map();
+        for (let i = 0; i < 1000; ++i) map.set(i, i);
+
+        const iterator = map.keys();
+        for (let i = 0; i < 500; ++i) expect(iterator.next()).toBeIteratorResultWithValue(i);
+
+        for (let i = 0; i < 1000; ++i) {
+            if (i % 100 !== 0 && i !== 500) map.delete(i);
+        }
+        expect(map).toHaveSize(11);
+
+        expect(iterator.next()).toBeIteratorResultWithValue(500);
+        expect(iterator.next()).toBeIteratorResultWithValue(600);
+        map.set("new", 1);
+        for (const expected of [700, 800, 900, "new"]) expect(iterator.next()).toBeIteratorResultWithValue(expected);
+        expect(iterator.next()).toBeIteratorResultDone();
+    });
+
+    test("entries added after clear are visited by live iterators", () => {
+        const map = new Map([
+            [1, 2],
+            [3, 4],
+        ]);
+        const iterator = map.keys();
+        expect(iterator.next()).toBeIteratorResultWithValue(1);
+
+        map.clear();
+        map.set(1, 2);
+        map.set(5, 6);
+
+        expect(iterator.next()).toBeIteratorResultWithValue(1);
+        expect(iterator.next()).toBeIteratorResultWithValue(5);
+        expect(iterator.next()).toBeIteratorResultDone();
+    });
+
+    test("re-adding a deleted key moves it to the end", () => {
+        const map = new Map([
+            ["a", 1],
+            ["b", 2],
+            ["c", 3],
+        ]);
+        map.delete("a");
+        map.set("a", 4);
+        expect(Array.from(map.keys())).toEqual(["b", "c", "a"]);
+        expect(map.get("a")).toBe(4);
+    });
 });
@@ -0,0 +1,55 @@
+test("repeated calls from the same site see the current callee", () => {
+    function one() {
+        return 1;
+    }
+    function two() {
+        return 2;
+    }
+
+    const callees = [one, one, two, one, two, two];
+    const results = [];
+    for (const callee of callees) results.push(callee());
+
+    expect(results).toEqual([1, 1, 2, 1, 2, 2]);
+});
+
+test("cached callee receives correct arguments and this value", () => {
+    function f(a, b, c) {
+        "use strict";
+        return [this, a, b, c, arguments.length];
+    }
+
+    const receiver = {};
+    const results = [];
+    for (let i = 0; i < 3; ++i) {
+        results.push(f.call(receiver, i));
+        results.push(f(i, i + 1, i + 2, i + 3));
+    }
+
+    expect(results[0]).toEqual([receiver, 0, undefined, undefined, 1]);
+    expect(results[5]).toEqual([undefined, 2, 3, 4, 4]);
+});
+
+test("class constructor called without new still throws after a cached call", () => {
+    function plain() {
+        return "plain";
+    }
+    class C {}
+
+    const callees = [plain, plain, C];
+    expect(() => {
+        for (const callee of callees) callee();
+    }).toThrowWithMessage(TypeError, "Class constructor C must be called with 'new'");
+});
+
+test("exceptions thrown by a cached callee propagate", () => {
+    let shouldThrow = false;
+    function f() {
+        if (shouldThrow) throw new Error("boom");
+        return 42;
+    }
+
+    for (let i = 0; i < 3; ++i) expect(f()).toBe(42);
+    shouldThrow = true;
+    expect(() => f()).toThrowWithMessage(Error, "boom");
+});
@@ -16,3 +16,53 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Megamorphic property access sites observe prototype chain and own property changes", () => {
+    function get(o) {
+        return o.value;
+    }
+
+    function set(o, value) {
+        o.value = value;
+    }
+
+    let prototype = { value: "from prototype" };
+    let objects = [];
+    for (let i = 0; i < 16; ++i) {
+        let o = Object.create(prototype);
+        o["unique" + i] = i;
+        objects.push(o);
+    }
+
+    for (let round = 0; round < 3; ++round) {
+        for (let o of objects) expect(get(o)).toBe("from prototype");
+    }
+
+    prototype.value = "changed";
+    for (let o of objects) expect(get(o)).toBe("changed");
+
+    Object.defineProperty(prototype, "value", { get: () => "getter" });
+    for (let o of objects) expect(get(o)).toBe("getter");
+
+    let ownObjects = [];
+    for (let i = 0; i < 16; ++i) {
+        let o = { value: 0 };
+        o["unique" + i] = i;
+        ownObjects.push(o);
+    }
+
+    for (let round = 0; round < 3; ++round) {
+        for (let o of ownObjects) set(o, round);
+    }
+    for (let o of ownObjects) expect(get(o)).toBe(2);
+
+    let setterCalls = 0;
+    let withSetter = {
+        set value(v) {
+            ++setterCalls;
+        },
+    };
+    set(withSetter, 1);
+    set(withSetter, 2);
+    expect(setterCalls).toBe(2);
+});
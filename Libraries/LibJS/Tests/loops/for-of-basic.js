@@ -153,3 +153,51 @@ describe("special left hand sides", () => {
         expect(vals).toEqual([1, 2]);
     });
 });
+
+describe("built-in iterator fast paths", () => {
+    test("array growing and shrinking during iteration", () => {
+        const array = [1, 2, 3];
+        const seen = [];
+        for (const value of array) {
+            seen.push(value);
+            if (value === 1) array.push(4);
+            if (value === 3) array.length = 3;
+        }
+        expect(seen).toEqual([1, 2, 3]);
+    });
+
+    test("holes are looked up on the prototype", () => {
+        Array.prototype[1] = "from prototype";
+        try {
+            const seen = [];
+            for (const value of [0, , 2]) seen.push(value);
+            expect(seen).toEqual([0, "from prototype", 2]);
+        } finally {
+            delete Array.prototype[1];
+        }
+    });
+
+    test("patched %ArrayIteratorPrototype%.next is respected", () => {
+        const arrayIteratorPrototype = Object.getPrototypeOf([][Symbol.iterator]());
+        const originalNext = arrayIteratorPrototype.next;
+        arrayIteratorPrototype.next = function () {
+            const result = originalNext.call(this);
+            if (!result.done) result.value *= 10;
+            return result;
+        };
+        try {
+            const seen = [];
+            for (const value of [1, 2]) seen.push(value);
+            expect(seen).toEqual([10, 20]);
+        } finally {
+            arrayIteratorPrototype.next = originalNext;
+        }
+    });
+
+    test("Map and Set", () => {
+        const seen = [];
+        for (const [key, value] of new Map([["a", 1], ["b", 2]])) seen.push(key + value);
+        for (const value of new Set([3, 4])) seen.push(value);
+        expect(seen).toEqual(["a1", "b2", 3, 4]);
+    });
+});
@@ -0,0 +1,52 @@
+test("values computed before a loop survive every iteration", () => {
+    const values = [1, 2, 3];
+    let sum = 0;
+    const offset = values.length * 10;
+    for (let i = 0; i < values.length; ++i) {
+        const scaled = values[i] * 2;
+        sum += scaled + offset;
+    }
+    expect(sum).toBe(12 + 3 * 30);
+});
+
+test("nested loops with many short-lived temporaries", () => {
+    const rows = [];
+    for (let i = 0; i < 4; ++i) {
+        const row = [];
+        for (let j = 0; j < 4; ++j) {
+            row.push(`${i}:${j}`.length + (i * j) + [i, j].indexOf(j));
+        }
+        rows.push(row.join(","));
+    }
+    expect(rows).toEqual(["3,4,5,6", "3,5,7,9", "3,6,9,12", "3,7,11,15"]);
+});
+
+test("temporaries live across a catch handler", () => {
+    const results = [];
+    for (let i = 0; i < 3; ++i) {
+        const before = { i };
+        try {
+            if (i === 1) throw new Error("boom");
+            results.push(before.i);
+        } catch (e) {
+            results.push(`${e.message}${before.i}`);
+        }
+    }
+    expect(results).toEqual([0, "boom1", 2]);
+});
+
+test("temporaries live across yield", () => {
+    function* generator() {
+        const base = [10, 20];
+        for (let i = 0; i < base.length; ++i) {
+            const received = yield base[i] + i;
+            base.push(received);
+            if (base.length > 3) break;
+        }
+        return base.join("-");
+    }
+    const iterator = generator();
+    expect(iterator.next().value).toBe(10);
+    expect(iterator.next(1).value).toBe(21);
+    expect(iterator.next(2)).toEqual({ value: "10-20-1-2", done: true });
+});
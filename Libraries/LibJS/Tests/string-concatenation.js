@@ -28,3 +28,19 @@ test("adding strings with dangling surrogates", () => {
     expect("\ud834a" + "\udf06").toBe("\ud834a\udf06");
     expect("\ud834" + "a\udf06").toBe("\ud834a\udf06");
 });
+
+test("long chains of small appends", () => {
+    let s = "";
+    for (let i = 0; i < 5000; ++i) s += i % 10;
+    expect(s.length).toBe(5000);
+    expect(s.charAt(4321)).toBe("1");
+    expect(s.slice(0, 12)).toBe("012345678901");
+    expect(s === "0123456789".repeat(500)).toBeTrue();
+});
+
+test("appending dangling surrogates to long strings", () => {
+    let s = "x".repeat(20) + "\ud834";
+    s += "\udf06";
+    expect(s.length).toBe(22);
+    expect(s.codePointAt(20)).toBe(0x1d306);
+});
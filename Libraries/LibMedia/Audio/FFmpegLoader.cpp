@@ -5,8 +5,8 @@
  */
 
 #include "FFmpegLoader.h"
+#include <AK/Array.h>
 #include <AK/MemoryStream.h>
-#include <AK/NumericLimits.h>
 #include <LibCore/System.h>
 
 #if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(59, 24, 100)
@@ -227,6 +227,24 @@ bool FFmpegLoaderPlugin::sniff(SeekableStream& stream)
     return score > 0;
 }
 
+static Optional<PcmSampleFormat> pcm_format_for_sample_format(AVSampleFormat format)
+{
+    switch (av_get_packed_sample_fmt(format)) {
+    case AV_SAMPLE_FMT_U8:
+        return PcmSampleFormat::Uint8;
+    case AV_SAMPLE_FMT_S16:
+        return PcmSampleFormat::Int16;
+    case AV_SAMPLE_FMT_S32:
+        return PcmSampleFormat::Int32;
+    case AV_SAMPLE_FMT_FLT:
+        return PcmSampleFormat::Float32;
+    case AV_SAMPLE_FMT_DBL:
+        return PcmSampleFormat::Float64;
+    default:
+        return {};
+    }
+}
+
 static ErrorOr<FixedArray<Sample>> extract_samples_from_frame(AVFrame& frame)
 {
     size_t number_of_samples = frame.nb_samples;
@@ -238,55 +256,38 @@ static ErrorOr<FixedArray<Sample>> extract_samples_from_frame(AVFrame& frame)
     size_t number_of_channels = frame.channels;
 #endif
     auto format = static_cast<AVSampleFormat>(frame.format);
-    auto packed_format = av_get_packed_sample_fmt(format);
     auto is_planar = av_sample_fmt_is_planar(format) == 1;
 
     // FIXME: handle number_of_channels > 2
     if (number_of_channels != 1 && number_of_channels != 2)
         return Error::from_string_view("Unsupported number of channels"sv);
 
-    switch (format) {
-    case AV_SAMPLE_FMT_FLTP:
-    case AV_SAMPLE_FMT_S16:
-    case AV_SAMPLE_FMT_S32:
-        break;
-    default:
-        // FIXME: handle other formats
+    auto pcm_format = pcm_format_for_sample_format(format);
+    if (!pcm_format.has_value())
         return Error::from_string_view("Unsupported sample format"sv);
-    }
-
-    auto get_plane_pointer = [&](size_t channel_index) -> uint8_t* {
-        return is_planar ? frame.extended_data[channel_index] : frame.extended_data[0];
-    };
-    auto index_in_plane = [&](size_t sample_index, size_t channel_index) {
-        if (is_planar)
-            return sample_index;
-        return sample_index * number_of_channels + channel_index;
-    };
-    auto read_sample = [&](uint8_t* data, size_t index) -> float {
-        switch (packed_format) {
-        case AV_SAMPLE_FMT_FLT:
-            return reinterpret_cast<float*>(data)[index];
-        case AV_SAMPLE_FMT_S16:
-            return reinterpret_cast<i16*>(data)[index] / static_cast<float>(NumericLimits<i16>::max());
-        case AV_SAMPLE_FMT_S32:
-            return reinterpret_cast<i32*>(data)[index] / static_cast<float>(NumericLimits<i32>::max());
-        default:
-            VERIFY_NOT_REACHED();
-        }
-    };
+    auto bytes_per_sample = pcm_bits_per_sample(*pcm_format) / 8;
 
+    // Samples are pairs of floats, so they can be written to as interleaved stereo.
+    static_assert(sizeof(Sample) == 2 * sizeof(float));
     auto samples = TRY(FixedArray<Sample>::create(number_of_samples));
-    for (size_t sample = 0; sample < number_of_samples; ++sample) {
-        if (number_of_channels == 1) {
-            samples.unchecked_at(sample) = Sample { read_sample(get_plane_pointer(0), index_in_plane(sample, 0)) };
-        } else {
-            samples.unchecked_at(sample) = Sample {
-                read_sample(get_plane_pointer(0), index_in_plane(sample, 0)),
-                read_sample(get_plane_pointer(1), index_in_plane(sample, 1)),
-            };
-        }
+    Span<float> interleaved_output { reinterpret_cast<float*>(samples.data()), number_of_samples * 2 };
+
+    if (number_of_channels == 2 && !is_planar) {
+        convert_samples_to_float(*pcm_format, { frame.extended_data[0], number_of_samples * 2 * bytes_per_sample }, interleaved_output);
+        return samples;
+    }
+
+    // Otherwise, each channel has its own plane, which is converted separately before they are interleaved.
+    auto channel_samples = TRY(FixedArray<float>::create(number_of_samples * number_of_channels));
+    for (size_t channel = 0; channel < number_of_channels; ++channel) {
+        auto plane = ReadonlyBytes { frame.extended_data[channel], number_of_samples * bytes_per_sample };
+        convert_samples_to_float(*pcm_format, plane, channel_samples.span().slice(channel * number_of_samples, number_of_samples));
     }
+
+    auto left = channel_samples.span().trim(number_of_samples);
+    auto right = number_of_channels == 2 ? channel_samples.span().slice(number_of_samples) : left;
+    Array<ReadonlySpan<float>, 2> channels { left, right };
+    interleave_samples(channels, interleaved_output);
     return samples;
 }
 
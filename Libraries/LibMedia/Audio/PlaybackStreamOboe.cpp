@@ -5,8 +5,11 @@
  */
 
 #include "PlaybackStreamOboe.h"
+#include "Resampler.h"
 #include <AK/Atomic.h>
+#include <AK/OwnPtr.h>
 #include <AK/SourceLocation.h>
+#include <AK/Vector.h>
 #include <LibCore/SharedCircularQueue.h>
 #include <LibCore/ThreadedPromise.h>
 #include <memory>
@@ -19,12 +22,8 @@ class OboeCallback : public oboe::AudioStreamDataCallback {
 public:
     virtual oboe::DataCallbackResult onAudioReady(oboe::AudioStream* oboeStream, void* audioData, int32_t numFrames) override
     {
-        Bytes output_buffer {
-            reinterpret_cast<u8*>(audioData),
-            static_cast<size_t>(numFrames * oboeStream->getChannelCount() * sizeof(float))
-        };
-        auto written_bytes = m_data_request_callback(output_buffer, PcmSampleFormat::Float32, numFrames);
-        if (written_bytes.is_empty())
+        Span<float> output { reinterpret_cast<float*>(audioData), static_cast<size_t>(numFrames * oboeStream->getChannelCount()) };
+        if (!request_audio_data(output, numFrames))
             return oboe::DataCallbackResult::Stop;
 
         auto timestamp = oboeStream->getTimestamp(CLOCK_MONOTONIC);
@@ -37,12 +36,7 @@ public:
         auto last_sample_time = static_cast<i64>(m_number_of_samples_enqueued / oboeStream->getSampleRate());
         m_last_sample_time.store(last_sample_time);
 
-        float* output = (float*)audioData;
-        for (int frames = 0; frames < numFrames; frames++) {
-            for (int channels = 0; channels < oboeStream->getChannelCount(); channels++) {
-                *output++ *= m_volume.load();
-            }
-        }
+        scale_samples(output, m_volume.load());
         return oboe::DataCallbackResult::Continue;
     }
     OboeCallback(PlaybackStream::AudioDataRequestCallback data_request_callback)
@@ -57,9 +51,38 @@ public:
     {
         m_volume.store(volume);
     }
+    // Must be called before the stream is started.
+    void set_resampler(OwnPtr<Resampler> resampler)
+    {
+        m_resampler = move(resampler);
+    }
 
 private:
+    bool request_audio_data(Span<float> output, size_t frame_count)
+    {
+        if (!m_resampler) {
+            auto written_bytes = m_data_request_callback(to_bytes(output), PcmSampleFormat::Float32, frame_count);
+            return !written_bytes.is_empty();
+        }
+
+        // The device runs at a different rate than the stream, so request as many frames at the stream's rate as
+        // the resampler needs to produce the device's frames.
+        auto input_frame_count = m_resampler->input_frames_needed(frame_count);
+        if (m_resampler_input.try_resize(input_frame_count * m_resampler->channel_count()).is_error())
+            return false;
+
+        auto written_bytes = m_data_request_callback(to_bytes(m_resampler_input.span()), PcmSampleFormat::Float32, input_frame_count);
+        if (written_bytes.is_empty())
+            return false;
+
+        // The end of the stream is resampled as silence.
+        m_resampler_input.span().slice(written_bytes.size() / sizeof(float)).fill(0);
+        return !m_resampler->process(m_resampler_input, output).is_error();
+    }
+
     PlaybackStream::AudioDataRequestCallback m_data_request_callback;
+    OwnPtr<Resampler> m_resampler;
+    Vector<float> m_resampler_input;
     Atomic<i64> m_last_sample_time { 0 };
     size_t m_number_of_samples_enqueued { 0 };
     Atomic<float> m_volume { 1.0 };
@@ -90,17 +113,21 @@ ErrorOr<NonnullRefPtr<PlaybackStream>> PlaybackStreamOboe::create(OutputState in
     std::shared_ptr<oboe::AudioStream> stream;
     auto oboe_callback = std::make_shared<OboeCallback>(move(data_request_callback));
     oboe::AudioStreamBuilder builder;
+    // The sample rate is left for the device to choose, as the low latency path is only available at its native rate.
     auto result = builder.setSharingMode(oboe::SharingMode::Shared)
                       ->setPerformanceMode(oboe::PerformanceMode::LowLatency)
                       ->setFormat(oboe::AudioFormat::Float)
                       ->setDataCallback(oboe_callback)
                       ->setChannelCount(channels)
-                      ->setSampleRate(sample_rate)
                       ->openStream(stream);
 
     if (result != oboe::Result::OK)
         return Error::from_string_literal("Oboe failed to start");
 
+    auto device_sample_rate = static_cast<u32>(stream->getSampleRate());
+    if (device_sample_rate != sample_rate)
+        oboe_callback->set_resampler(TRY(Resampler::create(sample_rate, device_sample_rate, channels)));
+
     if (initial_output_state == OutputState::Playing)
         stream->requestStart();
 
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <AK/IntegralMath.h>
+#include <AK/SIMDExtras.h>
+#include <LibMedia/Audio/Resampler.h>
+#include <LibMedia/Audio/SampleFormats.h>
+
+// See the comment in AK/SIMDMath.h for why this is needed.
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace Audio {
+
+using AK::SIMD::f32x4;
+using AK::SIMD::load_unaligned;
+
+// With this many taps, the Kaiser window below gives a transition band of about 8% of the sample rate, with about 80dB
+// of attenuation past it.
+static constexpr size_t minimum_taps_per_phase = 64;
+static constexpr size_t maximum_taps_per_phase = 1024;
+static constexpr double kaiser_beta = 8;
+
+// The cutoff is placed just below the Nyquist frequency, so that the transition band ends close to it.
+static constexpr double cutoff_ratio = 0.92;
+
+static constexpr size_t maximum_phase_count = 512;
+
+// The zeroth-order modified Bessel function of the first kind, which the Kaiser window is defined with.
+static double bessel_i0(double x)
+{
+    double sum = 1;
+    double term = 1;
+    for (int k = 1; k < 32; ++k) {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+static double kaiser_window(double position)
+{
+    if (position <= -1 || position >= 1)
+        return 0;
+    return bessel_i0(kaiser_beta * AK::sqrt(1 - (position * position))) / bessel_i0(kaiser_beta);
+}
+
+static double sinc(double x)
+{
+    if (x == 0)
+        return 1;
+    return AK::sin(AK::Pi<double> * x) / (AK::Pi<double> * x);
+}
+
+ErrorOr<NonnullOwnPtr<Resampler>> Resampler::create(u32 input_sample_rate, u32 output_sample_rate, u8 channel_count)
+{
+    if (input_sample_rate == 0 || output_sample_rate == 0)
+        return Error::from_string_literal("Resampler: Sample rate is zero");
+    if (channel_count == 0)
+        return Error::from_string_literal("Resampler: Channel count is zero");
+
+    auto divisor = AK::gcd(input_sample_rate, output_sample_rate);
+    auto step = input_sample_rate / divisor;
+    auto phase_denominator = output_sample_rate / divisor;
+    auto phase_count = min<size_t>(phase_denominator, maximum_phase_count);
+
+    // When reducing the sample rate, the filter has to cut off below the new Nyquist frequency, which takes a
+    // proportionally longer filter.
+    auto downsampling_ratio = max(1.0, static_cast<double>(input_sample_rate) / output_sample_rate);
+    auto taps_per_phase = min(align_up_to(static_cast<size_t>(AK::ceil(minimum_taps_per_phase * downsampling_ratio)), 4), maximum_taps_per_phase);
+    auto cutoff = cutoff_ratio / downsampling_ratio;
+
+    auto coefficients = TRY(FixedArray<float>::create(phase_count * taps_per_phase));
+    auto half_length = static_cast<double>(taps_per_phase / 2);
+    for (size_t phase = 0; phase < phase_count; ++phase) {
+        auto taps = coefficients.span().slice(phase * taps_per_phase, taps_per_phase);
+        auto fraction = static_cast<double>(phase) / static_cast<double>(phase_count);
+
+        // The output frame lies between the two taps in the middle of the filter.
+        double sum = 0;
+        for (size_t tap = 0; tap < taps_per_phase; ++tap) {
+            auto distance = (half_length - 1 + fraction) - static_cast<double>(tap);
+            auto value = cutoff * sinc(cutoff * distance) * kaiser_window(distance / half_length);
+            taps[tap] = static_cast<float>(value);
+            sum += value;
+        }
+
+        // Normalize each phase separately, so that a constant signal stays constant.
+        for (auto& tap : taps)
+            tap = static_cast<float>(tap / sum);
+    }
+
+    Vector<Vector<float>> channels;
+    TRY(channels.try_resize(channel_count));
+
+    auto resampler = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Resampler(input_sample_rate, output_sample_rate, channel_count, step, phase_denominator, taps_per_phase, phase_count, move(coefficients), move(channels))));
+    resampler->reset();
+    return resampler;
+}
+
+Resampler::Resampler(u32 input_sample_rate, u32 output_sample_rate, u8 channel_count, u32 step, u32 phase_denominator, size_t taps_per_phase, size_t phase_count, FixedArray<float> coefficients, Vector<Vector<float>> channels)
+    : m_input_sample_rate(input_sample_rate)
+    , m_output_sample_rate(output_sample_rate)
+    , m_channel_count(channel_count)
+    , m_step(step)
+    , m_phase_denominator(phase_denominator)
+    , m_taps_per_phase(taps_per_phase)
+    , m_phase_count(phase_count)
+    , m_coefficients(move(coefficients))
+    , m_channels(move(channels))
+{
+}
+
+void Resampler::reset()
+{
+    // The first output frame lies on the first input frame, so the input before it is treated as silence.
+    for (auto& channel : m_channels) {
+        channel.clear_with_capacity();
+        channel.resize(m_taps_per_phase / 2 - 1);
+    }
+    m_position = 0;
+    m_phase = 0;
+}
+
+namespace {
+
+struct FilterPosition {
+    size_t start { 0 };
+    size_t phase { 0 };
+};
+
+}
+
+// Returns the first input frame and the phase of the filter for the output frame at the given position.
+static FilterPosition filter_position(size_t position, u64 phase, u32 phase_denominator, size_t phase_count)
+{
+    position += phase / phase_denominator;
+    phase %= phase_denominator;
+
+    if (phase_count == phase_denominator)
+        return { position, static_cast<size_t>(phase) };
+
+    auto rounded_phase = static_cast<size_t>(((phase * phase_count) + (phase_denominator / 2)) / phase_denominator);
+    if (rounded_phase == phase_count)
+        return { position + 1, 0 };
+    return { position, rounded_phase };
+}
+
+size_t Resampler::input_frames_needed(size_t output_frame_count) const
+{
+    if (output_frame_count == 0)
+        return 0;
+
+    auto last_phase = m_phase + (static_cast<u64>(output_frame_count - 1) * m_step);
+    auto last_position = filter_position(m_position, last_phase, m_phase_denominator, m_phase_count);
+
+    auto frames_needed = last_position.start + m_taps_per_phase;
+    auto frames_buffered = m_channels[0].size();
+    return frames_needed > frames_buffered ? frames_needed - frames_buffered : 0;
+}
+
+static float dot_product(ReadonlySpan<float> coefficients, ReadonlySpan<float> samples)
+{
+    f32x4 sum {};
+    for (size_t i = 0; i < coefficients.size(); i += 4)
+        sum += load_unaligned<f32x4>(coefficients.data() + i) * load_unaligned<f32x4>(samples.data() + i);
+    return sum[0] + sum[1] + sum[2] + sum[3];
+}
+
+ErrorOr<void> Resampler::process(ReadonlySpan<float> input, Span<float> output)
+{
+    auto output_frame_count = output.size() / m_channel_count;
+    auto input_frame_count = input.size() / m_channel_count;
+    VERIFY(input_frame_count == input_frames_needed(output_frame_count));
+
+    Vector<Span<float>, 8> new_samples;
+    TRY(new_samples.try_ensure_capacity(m_channel_count));
+    for (auto& channel : m_channels) {
+        auto buffered_frame_count = channel.size();
+        TRY(channel.try_resize(buffered_frame_count + input_frame_count));
+        new_samples.unchecked_append(channel.span().slice(buffered_frame_count));
+    }
+    deinterleave_samples(input, new_samples);
+
+    for (size_t frame = 0; frame < output_frame_count; ++frame) {
+        auto position = filter_position(m_position, m_phase, m_phase_denominator, m_phase_count);
+        auto coefficients = m_coefficients.span().slice(position.phase * m_taps_per_phase, m_taps_per_phase);
+
+        for (size_t channel = 0; channel < m_channel_count; ++channel)
+            output[(frame * m_channel_count) + channel] = dot_product(coefficients, m_channels[channel].span().slice(position.start, m_taps_per_phase));
+
+        m_phase += m_step;
+        m_position += m_phase / m_phase_denominator;
+        m_phase %= m_phase_denominator;
+    }
+
+    // Drop the input that no later output frame will be computed from.
+    for (auto& channel : m_channels)
+        channel.remove(0, m_position);
+    m_position = 0;
+
+    return {};
+}
+
+}
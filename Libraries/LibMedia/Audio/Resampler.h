@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/FixedArray.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibMedia/Export.h>
+
+namespace Audio {
+
+// Converts interleaved float samples from one sample rate to another with a polyphase windowed-sinc filter.
+//
+// Every output frame lies at some fraction of the way between two input frames. The filter taps for each of these
+// fractions (or phases) are computed up front, so producing a sample only takes a single dot product over the input
+// frames around it. Rates whose ratio only reduces to a large denominator have their positions rounded to the nearest
+// one of a limited number of phases.
+class MEDIA_API Resampler {
+public:
+    static ErrorOr<NonnullOwnPtr<Resampler>> create(u32 input_sample_rate, u32 output_sample_rate, u8 channel_count);
+
+    u32 input_sample_rate() const { return m_input_sample_rate; }
+    u32 output_sample_rate() const { return m_output_sample_rate; }
+    u8 channel_count() const { return m_channel_count; }
+
+    // Returns the number of input frames that the next call to process() needs to produce the given number of frames.
+    size_t input_frames_needed(size_t output_frame_count) const;
+
+    // Resamples the input into the output. The input has to contain exactly as many frames as input_frames_needed()
+    // returns for the number of frames in the output.
+    ErrorOr<void> process(ReadonlySpan<float> input, Span<float> output);
+
+    // Forgets all of the input that has been passed in so far, to start over with a new stream.
+    void reset();
+
+private:
+    Resampler(u32 input_sample_rate, u32 output_sample_rate, u8 channel_count, u32 step, u32 phase_denominator, size_t taps_per_phase, size_t phase_count, FixedArray<float> coefficients, Vector<Vector<float>> channels);
+
+    u32 m_input_sample_rate { 0 };
+    u32 m_output_sample_rate { 0 };
+    u8 m_channel_count { 0 };
+
+    // Each output frame advances the position in the input by step / phase_denominator frames.
+    u32 m_step { 0 };
+    u32 m_phase_denominator { 0 };
+
+    size_t m_taps_per_phase { 0 };
+    size_t m_phase_count { 0 };
+    FixedArray<float> m_coefficients;
+
+    // The input frames that the next output frames are computed from, for each channel. The filter for the next output
+    // frame starts at m_position, and the output lies m_phase / m_phase_denominator frames past its center.
+    Vector<Vector<float>> m_channels;
+    size_t m_position { 0 };
+    u32 m_phase { 0 };
+};
+
+}
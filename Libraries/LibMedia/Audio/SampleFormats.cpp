@@ -6,9 +6,24 @@
 
 #include "SampleFormats.h"
 #include <AK/Assertions.h>
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
+
+// See the comment in AK/SIMDMath.h for why this is needed.
+#pragma GCC diagnostic ignored "-Wpsabi"
 
 namespace Audio {
 
+using AK::SIMD::expand4;
+using AK::SIMD::f32x4;
+using AK::SIMD::i16x8;
+using AK::SIMD::i32x4;
+using AK::SIMD::load_unaligned;
+using AK::SIMD::store_unaligned;
+using AK::SIMD::to_f32x4;
+using AK::SIMD::to_i32x4;
+using AK::SIMD::u8x16;
+
 u16 pcm_bits_per_sample(PcmSampleFormat format)
 {
     switch (format) {
@@ -28,4 +43,236 @@ u16 pcm_bits_per_sample(PcmSampleFormat format)
     }
 }
 
+static constexpr float int16_scale = 1.0f / 32768.0f;
+static constexpr float int32_scale = 1.0f / 2147483648.0f;
+
+template<typename T>
+static T read_sample(u8 const* data)
+{
+    T value;
+    __builtin_memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+// Reads a 24-bit sample into the top bytes of a 32-bit integer, which keeps its sign.
+static i32 read_int24_sample(u8 const* data)
+{
+    return static_cast<i32>((static_cast<u32>(data[0]) << 8) | (static_cast<u32>(data[1]) << 16) | (static_cast<u32>(data[2]) << 24));
+}
+
+void convert_samples_to_float(PcmSampleFormat format, ReadonlyBytes input, Span<float> output)
+{
+    auto bytes_per_sample = pcm_bits_per_sample(format) / 8;
+    VERIFY(input.size() >= output.size() * bytes_per_sample);
+
+    auto const* source = input.data();
+    auto* destination = output.data();
+    auto count = output.size();
+    size_t i = 0;
+
+    switch (format) {
+    case PcmSampleFormat::Uint8:
+        for (; i < count; ++i)
+            destination[i] = (static_cast<float>(source[i]) - 128.0f) / 128.0f;
+        break;
+    case PcmSampleFormat::Int16:
+        for (; i + 8 <= count; i += 8) {
+            auto samples = load_unaligned<i16x8>(source + (i * 2));
+            auto low = to_f32x4(__builtin_shufflevector(samples, samples, 0, 1, 2, 3));
+            auto high = to_f32x4(__builtin_shufflevector(samples, samples, 4, 5, 6, 7));
+            store_unaligned(destination + i, low * int16_scale);
+            store_unaligned(destination + i + 4, high * int16_scale);
+        }
+        for (; i < count; ++i)
+            destination[i] = read_sample<i16>(source + (i * 2)) * int16_scale;
+        break;
+    case PcmSampleFormat::Int24:
+        // Four samples take up 12 bytes, but are loaded 16 bytes at a time, so the last few are converted one by one.
+        for (; i + 6 <= count; i += 4) {
+            auto bytes = load_unaligned<u8x16>(source + (i * 3));
+            auto shifted = __builtin_shufflevector(bytes, u8x16 {}, 16, 0, 1, 2, 16, 3, 4, 5, 16, 6, 7, 8, 16, 9, 10, 11);
+            store_unaligned(destination + i, to_f32x4(bit_cast<i32x4>(shifted)) * int32_scale);
+        }
+        for (; i < count; ++i)
+            destination[i] = read_int24_sample(source + (i * 3)) * int32_scale;
+        break;
+    case PcmSampleFormat::Int32:
+        for (; i + 4 <= count; i += 4)
+            store_unaligned(destination + i, to_f32x4(load_unaligned<i32x4>(source + (i * 4))) * int32_scale);
+        for (; i < count; ++i)
+            destination[i] = read_sample<i32>(source + (i * 4)) * int32_scale;
+        break;
+    case PcmSampleFormat::Float32:
+        __builtin_memcpy(destination, source, count * sizeof(float));
+        break;
+    case PcmSampleFormat::Float64:
+        for (; i < count; ++i)
+            destination[i] = static_cast<float>(read_sample<double>(source + (i * 8)));
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+// Scales samples to integers with the given maximum, rounding them to the nearest one. Converting a float to an integer
+// truncates it, so half is added away from zero first.
+static i32x4 float_to_int(f32x4 samples, float maximum)
+{
+    samples = AK::SIMD::clamp(samples, -1.0f, 1.0f) * maximum;
+    auto sign_bits = bit_cast<i32x4>(samples) & NumericLimits<i32>::min();
+    auto half = bit_cast<f32x4>(bit_cast<i32x4>(expand4(0.5f)) | sign_bits);
+    return to_i32x4(samples + half);
+}
+
+static i32 float_to_int(float sample, float maximum)
+{
+    sample = clamp(sample, -1.0f, 1.0f) * maximum;
+    return static_cast<i32>(sample + (sample < 0 ? -0.5f : 0.5f));
+}
+
+template<typename T>
+static void write_sample(u8* data, T value)
+{
+    __builtin_memcpy(data, &value, sizeof(T));
+}
+
+void convert_samples_from_float(ReadonlySpan<float> input, PcmSampleFormat format, Bytes output)
+{
+    auto bytes_per_sample = pcm_bits_per_sample(format) / 8;
+    VERIFY(output.size() >= input.size() * bytes_per_sample);
+
+    auto const* source = input.data();
+    auto* destination = output.data();
+    auto count = input.size();
+    size_t i = 0;
+
+    switch (format) {
+    case PcmSampleFormat::Uint8:
+        for (; i < count; ++i)
+            destination[i] = static_cast<u8>(float_to_int(source[i], 127.0f) + 128);
+        break;
+    case PcmSampleFormat::Int16:
+        for (; i + 8 <= count; i += 8) {
+            auto low = float_to_int(load_unaligned<f32x4>(source + i), 32767.0f);
+            auto high = float_to_int(load_unaligned<f32x4>(source + i + 4), 32767.0f);
+            auto samples = __builtin_convertvector(__builtin_shufflevector(low, high, 0, 1, 2, 3, 4, 5, 6, 7), i16x8);
+            store_unaligned(destination + (i * 2), samples);
+        }
+        for (; i < count; ++i)
+            write_sample(destination + (i * 2), static_cast<i16>(float_to_int(source[i], 32767.0f)));
+        break;
+    case PcmSampleFormat::Int24:
+        // Only the 12 bytes of four samples are stored, so the vector is stored to a temporary buffer first.
+        for (; i + 4 <= count; i += 4) {
+            auto samples = float_to_int(load_unaligned<f32x4>(source + i), 8388607.0f);
+            auto bytes = bit_cast<u8x16>(samples);
+            u8x16 packed = __builtin_shufflevector(bytes, bytes, 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 15, 15, 15, 15);
+            __builtin_memcpy(destination + (i * 3), &packed, 12);
+        }
+        for (; i < count; ++i) {
+            auto sample = float_to_int(source[i], 8388607.0f);
+            destination[(i * 3) + 0] = static_cast<u8>(sample);
+            destination[(i * 3) + 1] = static_cast<u8>(sample >> 8);
+            destination[(i * 3) + 2] = static_cast<u8>(sample >> 16);
+        }
+        break;
+    case PcmSampleFormat::Int32:
+        // Floats can't hold the maximum 32-bit integer exactly, so the conversion is done with doubles to avoid overflow.
+        for (; i < count; ++i) {
+            auto sample = clamp(static_cast<double>(source[i]), -1.0, 1.0);
+            write_sample(destination + (i * 4), static_cast<i32>(AK::round(sample * 2147483647.0)));
+        }
+        break;
+    case PcmSampleFormat::Float32:
+        __builtin_memcpy(destination, source, count * sizeof(float));
+        break;
+    case PcmSampleFormat::Float64:
+        for (; i < count; ++i)
+            write_sample(destination + (i * 8), static_cast<double>(source[i]));
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+void interleave_samples(ReadonlySpan<ReadonlySpan<float>> channels, Span<float> output)
+{
+    auto channel_count = channels.size();
+    if (channel_count == 0)
+        return;
+
+    auto frame_count = NumericLimits<size_t>::max();
+    for (auto const& channel : channels)
+        frame_count = min(frame_count, channel.size());
+    VERIFY(output.size() >= frame_count * channel_count);
+
+    if (channel_count == 1) {
+        channels[0].trim(frame_count).copy_to(output);
+        return;
+    }
+
+    size_t frame = 0;
+    if (channel_count == 2) {
+        auto const* left = channels[0].data();
+        auto const* right = channels[1].data();
+        auto* destination = output.data();
+        for (; frame + 4 <= frame_count; frame += 4) {
+            auto left_samples = load_unaligned<f32x4>(left + frame);
+            auto right_samples = load_unaligned<f32x4>(right + frame);
+            store_unaligned(destination + (frame * 2), __builtin_shufflevector(left_samples, right_samples, 0, 4, 1, 5));
+            store_unaligned(destination + (frame * 2) + 4, __builtin_shufflevector(left_samples, right_samples, 2, 6, 3, 7));
+        }
+    }
+
+    for (; frame < frame_count; ++frame) {
+        for (size_t channel = 0; channel < channel_count; ++channel)
+            output[(frame * channel_count) + channel] = channels[channel][frame];
+    }
+}
+
+void deinterleave_samples(ReadonlySpan<float> input, ReadonlySpan<Span<float>> channels)
+{
+    auto channel_count = channels.size();
+    if (channel_count == 0)
+        return;
+
+    auto frame_count = input.size() / channel_count;
+    for (auto const& channel : channels)
+        VERIFY(channel.size() >= frame_count);
+
+    if (channel_count == 1) {
+        input.trim(frame_count).copy_to(channels[0]);
+        return;
+    }
+
+    size_t frame = 0;
+    if (channel_count == 2) {
+        auto const* source = input.data();
+        Span<float> left = channels[0];
+        Span<float> right = channels[1];
+        for (; frame + 4 <= frame_count; frame += 4) {
+            auto first = load_unaligned<f32x4>(source + (frame * 2));
+            auto second = load_unaligned<f32x4>(source + (frame * 2) + 4);
+            store_unaligned(left.data() + frame, __builtin_shufflevector(first, second, 0, 2, 4, 6));
+            store_unaligned(right.data() + frame, __builtin_shufflevector(first, second, 1, 3, 5, 7));
+        }
+    }
+
+    for (size_t channel = 0; channel < channel_count; ++channel) {
+        Span<float> samples = channels[channel];
+        for (auto channel_frame = frame; channel_frame < frame_count; ++channel_frame)
+            samples[channel_frame] = input[(channel_frame * channel_count) + channel];
+    }
+}
+
+void scale_samples(Span<float> samples, float gain)
+{
+    auto* data = samples.data();
+    size_t i = 0;
+    for (; i + 4 <= samples.size(); i += 4)
+        store_unaligned(data + i, load_unaligned<f32x4>(data + i) * gain);
+    for (; i < samples.size(); ++i)
+        data[i] *= gain;
+}
+
 }
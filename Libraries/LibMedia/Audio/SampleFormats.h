@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Span.h>
 #include <AK/Types.h>
 #include <LibMedia/Export.h>
 
@@ -24,4 +25,23 @@ enum class PcmSampleFormat : u8 {
 // Most of the read code only cares about how many bits to read or write
 MEDIA_API u16 pcm_bits_per_sample(PcmSampleFormat format);
 
+// Converts output.size() little-endian samples of the given format to floats in the range [-1, 1]. Integer samples are
+// scaled by their full range, so that the most negative value maps to exactly -1. The order of the samples is kept, so
+// interleaved input results in interleaved output.
+MEDIA_API void convert_samples_to_float(PcmSampleFormat, ReadonlyBytes input, Span<float> output);
+
+// Converts input.size() floats to little-endian samples of the given format. Samples outside of [-1, 1] are clipped when
+// converting to an integer format.
+MEDIA_API void convert_samples_from_float(ReadonlySpan<float> input, PcmSampleFormat, Bytes output);
+
+// Interleaves the samples of each channel into output, which must hold as many frames as the shortest channel.
+MEDIA_API void interleave_samples(ReadonlySpan<ReadonlySpan<float>> channels, Span<float> output);
+
+// Splits interleaved input into the samples of each channel. Each channel must hold as many samples as there are
+// frames in the input.
+MEDIA_API void deinterleave_samples(ReadonlySpan<float> input, ReadonlySpan<Span<float>> channels);
+
+// Multiplies all samples by the given gain.
+MEDIA_API void scale_samples(Span<float>, float gain);
+
 }
@@ -696,8 +696,20 @@ DecoderErrorOr<SampleIterator> Reader::create_sample_iterator(u64 track_number)
     // We need to have the element ID included so that the iterator knows where it is.
     auto position = optional_position.value() - get_element_id_size(CLUSTER_ELEMENT_ID) - m_segment_contents_position;
 
+    // Tracks without cues get seeked using the keyframes that their iterators find while reading.
+    RefPtr<KeyframeIndex> keyframe_index;
+    if (!TRY(has_cues_for_track(track_number))) {
+        if (auto existing_index = m_keyframe_indices.get(track_number); existing_index.has_value()) {
+            keyframe_index = existing_index.value();
+        } else {
+            keyframe_index = DECODER_TRY_ALLOC(adopt_nonnull_ref_or_enomem(new (nothrow) KeyframeIndex));
+            keyframe_index->indexed_position = position;
+            DECODER_TRY_ALLOC(m_keyframe_indices.try_set(track_number, *keyframe_index));
+        }
+    }
+
     dbgln_if(MATROSKA_DEBUG, "Creating sample iterator starting at {} relative to segment at {}", position, m_segment_contents_position);
-    return SampleIterator(this->m_mapped_file, segment_view, TRY(track_for_track_number(track_number)), TRY(segment_information()).timestamp_scale(), position);
+    return SampleIterator(this->m_mapped_file, segment_view, TRY(track_for_track_number(track_number)), TRY(segment_information()).timestamp_scale(), position, move(keyframe_index));
 }
 
 static DecoderErrorOr<CueTrackPosition> parse_cue_track_position(Streamer& streamer)
@@ -824,8 +836,11 @@ DecoderErrorOr<void> Reader::ensure_cues_are_parsed()
     if (m_cues_have_been_parsed)
         return {};
     auto position = TRY(find_first_top_level_element_with_id("Cues"sv, CUES_ID));
-    if (!position.has_value())
-        return DecoderError::corrupted("No Tracks element found"sv);
+    if (!position.has_value()) {
+        // Cues are optional, so remember that there are none instead of looking for them again on every seek.
+        m_cues_have_been_parsed = true;
+        return {};
+    }
     Streamer streamer { m_data };
     TRY_READ(streamer.seek_to_position(position.release_value()));
     TRY(parse_cues(streamer));
@@ -922,6 +937,25 @@ DecoderErrorOr<SampleIterator> Reader::seek_to_random_access_point(SampleIterato
         return iterator;
     }
 
+    // Jump to the closest keyframe that was found while reading earlier. If the index extends up to the timestamp, that
+    // keyframe is the one we're looking for, otherwise we only have to search onwards from it.
+    if (iterator.m_keyframe_index) {
+        auto const& index = *iterator.m_keyframe_index;
+        if (auto const* keyframe = index.last_keyframe_at_or_before(timestamp)) {
+            if (index.last_indexed_timestamp.has_value() && index.last_indexed_timestamp.value() >= timestamp) {
+                dbgln_if(MATROSKA_DEBUG, "Seeking to indexed keyframe at {}ms", keyframe->timestamp.to_milliseconds());
+                TRY(iterator.seek_to_track_position(keyframe->position, keyframe->timestamp));
+                return iterator;
+            }
+
+            auto const& last_timestamp = iterator.last_timestamp();
+            if (!last_timestamp.has_value() || last_timestamp.value() < keyframe->timestamp || last_timestamp.value() > timestamp)
+                TRY(iterator.seek_to_track_position(keyframe->position, keyframe->timestamp));
+            TRY(search_clusters_for_keyframe_before_timestamp(iterator, timestamp));
+            return iterator;
+        }
+    }
+
     if (!iterator.last_timestamp().has_value() || timestamp < iterator.last_timestamp().value()) {
         // If the timestamp is before the iterator's current position, then we need to start from the beginning of the Segment.
         iterator = TRY(create_sample_iterator(iterator.m_track->track_number()));
@@ -950,28 +984,42 @@ DecoderErrorOr<Block> SampleIterator::next_block()
     Optional<Block> block;
 
     while (streamer.has_octet()) {
-#if MATROSKA_TRACE_DEBUG
         auto element_position = streamer.position();
-#endif
         auto element_id = TRY_READ(streamer.read_variable_size_integer(false));
-#if MATROSKA_TRACE_DEBUG
-        dbgln("Iterator found element with ID {:#010x} at offset {} within the segment.", element_id, element_position);
-#endif
+        dbgln_if(MATROSKA_TRACE_DEBUG, "Iterator found element with ID {:#010x} at offset {} within the segment.", element_id, element_position);
+
+        // Only an iterator that reads on from exactly where the index ends can extend it without leaving a gap.
+        bool extends_keyframe_index = m_keyframe_index && m_keyframe_index->indexed_position == element_position;
 
         if (element_id == CLUSTER_ELEMENT_ID) {
             dbgln_if(MATROSKA_DEBUG, "  Iterator is parsing new cluster.");
             m_current_cluster = TRY(parse_cluster(streamer, m_segment_timestamp_scale));
+            m_current_cluster_position = element_position;
+            m_current_cluster_data_position = streamer.position();
         } else if (element_id == SIMPLE_BLOCK_ID) {
             dbgln_if(MATROSKA_TRACE_DEBUG, "  Iterator is parsing new block.");
             auto candidate_block = TRY(parse_simple_block(streamer, m_current_cluster->timestamp(), m_segment_timestamp_scale, m_track));
-            if (candidate_block.track_number() == m_track->track_number())
+            if (candidate_block.track_number() == m_track->track_number()) {
+                if (extends_keyframe_index && candidate_block.only_keyframes()) {
+                    CueTrackPosition position;
+                    position.set_track_number(m_track->track_number());
+                    position.set_cluster_position(m_current_cluster_position);
+                    position.set_block_offset(element_position - m_current_cluster_data_position);
+                    m_keyframe_index->add_keyframe({ candidate_block.timestamp(), position });
+                }
                 block = move(candidate_block);
+            }
         } else {
             dbgln_if(MATROSKA_TRACE_DEBUG, "  Iterator is skipping unknown element with ID {:#010x}.", element_id);
             TRY_READ(streamer.read_unknown_element());
         }
 
         m_position = streamer.position();
+        if (extends_keyframe_index) {
+            m_keyframe_index->indexed_position = m_position;
+            if (block.has_value())
+                m_keyframe_index->last_indexed_timestamp = block->timestamp();
+        }
         if (block.has_value()) {
             m_last_timestamp = block->timestamp();
             return block.release_value();
@@ -986,6 +1034,11 @@ DecoderErrorOr<void> SampleIterator::seek_to_cue_point(CuePoint const& cue_point
 {
     // This is a private function. The position getter can return optional, but the caller should already know that this track has a position.
     auto const& cue_position = cue_point.position_for_track(m_track->track_number()).release_value();
+    return seek_to_track_position(cue_position, cue_point.timestamp());
+}
+
+DecoderErrorOr<void> SampleIterator::seek_to_track_position(CueTrackPosition const& cue_position, AK::Duration timestamp)
+{
     Streamer streamer { m_data };
     TRY_READ(streamer.seek_to_position(cue_position.cluster_position()));
 
@@ -994,13 +1047,41 @@ DecoderErrorOr<void> SampleIterator::seek_to_cue_point(CuePoint const& cue_point
         return DecoderError::corrupted("Cue point's cluster position didn't point to a cluster"sv);
 
     m_current_cluster = TRY(parse_cluster(streamer, m_segment_timestamp_scale));
+    m_current_cluster_position = cue_position.cluster_position();
+    m_current_cluster_data_position = streamer.position();
     dbgln_if(MATROSKA_DEBUG, "SampleIterator set to cue point at timestamp {}ms", m_current_cluster->timestamp().to_milliseconds());
 
     m_position = streamer.position() + cue_position.block_offset();
-    m_last_timestamp = cue_point.timestamp();
+    m_last_timestamp = timestamp;
     return {};
 }
 
+KeyframeIndex::Keyframe const* KeyframeIndex::last_keyframe_at_or_before(AK::Duration timestamp) const
+{
+    // Find the first keyframe after the timestamp, the one before it is the one we want.
+    size_t low = 0;
+    size_t high = keyframes.size();
+    while (low < high) {
+        auto middle = low + (high - low) / 2;
+        if (keyframes[middle].timestamp <= timestamp)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low == 0)
+        return nullptr;
+    return &keyframes[low - 1];
+}
+
+void KeyframeIndex::add_keyframe(Keyframe keyframe)
+{
+    // Keyframes are almost always found in order, so look for the insertion point from the back.
+    auto index = keyframes.size();
+    while (index > 0 && keyframes[index - 1].timestamp > keyframe.timestamp)
+        --index;
+    keyframes.insert(index, keyframe);
+}
+
 ErrorOr<ByteString> Streamer::read_string()
 {
     auto string_length = TRY(read_variable_size_integer());
@@ -10,6 +10,7 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/Optional.h>
+#include <AK/RefCounted.h>
 #include <LibCore/MappedFile.h>
 #include <LibMedia/DecoderError.h>
 #include <LibMedia/Export.h>
@@ -21,6 +22,25 @@ namespace Media::Matroska {
 class SampleIterator;
 class Streamer;
 
+// The keyframes of a track that sample iterators have come across while reading, which allows seeking in files without
+// Cues. The index covers the segment without gaps from its first cluster up to the indexed position, so it is complete
+// for any timestamp up to the last indexed one.
+struct KeyframeIndex : public RefCounted<KeyframeIndex> {
+    struct Keyframe {
+        AK::Duration timestamp;
+        CueTrackPosition position;
+    };
+
+    Keyframe const* last_keyframe_at_or_before(AK::Duration timestamp) const;
+    void add_keyframe(Keyframe);
+
+    // Sorted by timestamp.
+    Vector<Keyframe> keyframes;
+    // The position in the segment of the element after the last one that was indexed.
+    size_t indexed_position { 0 };
+    Optional<AK::Duration> last_indexed_timestamp;
+};
+
 class MEDIA_API Reader {
 public:
     typedef Function<DecoderErrorOr<IterationDecision>(TrackEntry const&)> TrackEntryCallback;
@@ -79,6 +99,9 @@ private:
     // The vectors must be sorted by timestamp at all times.
     HashMap<u64, Vector<CuePoint>> m_cues;
     bool m_cues_have_been_parsed { false };
+
+    // Only used for tracks without cues.
+    HashMap<u64, NonnullRefPtr<KeyframeIndex>> m_keyframe_indices;
 };
 
 class MEDIA_API SampleIterator {
@@ -91,20 +114,23 @@ public:
 private:
     friend class Reader;
 
-    SampleIterator(RefPtr<Core::SharedMappedFile> file, ReadonlyBytes data, TrackEntry& track, u64 timestamp_scale, size_t position)
+    SampleIterator(RefPtr<Core::SharedMappedFile> file, ReadonlyBytes data, TrackEntry& track, u64 timestamp_scale, size_t position, RefPtr<KeyframeIndex> keyframe_index)
         : m_file(move(file))
         , m_data(data)
         , m_track(track)
+        , m_keyframe_index(move(keyframe_index))
         , m_segment_timestamp_scale(timestamp_scale)
         , m_position(position)
     {
     }
 
     DecoderErrorOr<void> seek_to_cue_point(CuePoint const& cue_point);
+    DecoderErrorOr<void> seek_to_track_position(CueTrackPosition const&, AK::Duration timestamp);
 
     RefPtr<Core::SharedMappedFile> m_file;
     ReadonlyBytes m_data;
     NonnullRefPtr<TrackEntry> m_track;
+    RefPtr<KeyframeIndex> m_keyframe_index;
     u64 m_segment_timestamp_scale { 0 };
 
     // Must always point to an element ID or the end of the stream.
@@ -113,6 +139,9 @@ private:
     Optional<AK::Duration> m_last_timestamp;
 
     Optional<Cluster> m_current_cluster;
+    // The positions of the current cluster's element ID and of its first child element.
+    size_t m_current_cluster_position { 0 };
+    size_t m_current_cluster_data_position { 0 };
 };
 
 class Streamer {
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <LibCore/System.h>
 #include <LibMedia/VideoFrame.h>
 #include <cstring>
@@ -11,10 +12,47 @@
 #include "FFmpegHelpers.h"
 #include "FFmpegVideoDecoder.h"
 
+extern "C" {
+#include <libavutil/hwcontext.h>
+}
+
 namespace Media::FFmpeg {
 
-static AVPixelFormat negotiate_output_format(AVCodecContext*, AVPixelFormat const* formats)
+// The hardware decoding APIs to try, in order of preference.
+static constexpr AVHWDeviceType hardware_device_types[] = {
+#if defined(AK_OS_MACOS)
+    AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
+#elif defined(AK_OS_WINDOWS)
+    AV_HWDEVICE_TYPE_D3D11VA,
+#else
+    AV_HWDEVICE_TYPE_VAAPI,
+#endif
+};
+
+static AVPixelFormat hardware_pixel_format_for_device_type(AVCodec const* codec, AVHWDeviceType device_type)
+{
+    for (int i = 0;; i++) {
+        auto const* config = avcodec_get_hw_config(codec, i);
+        if (!config)
+            return AV_PIX_FMT_NONE;
+        if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) != 0 && config->device_type == device_type)
+            return config->pix_fmt;
+    }
+}
+
+static AVPixelFormat negotiate_output_format(AVCodecContext* codec_context, AVPixelFormat const* formats)
 {
+    // If the hardware can't decode this stream, FFmpeg leaves the hardware format out, and we fall back to software.
+    if (codec_context->hw_device_ctx) {
+        auto device_type = reinterpret_cast<AVHWDeviceContext const*>(codec_context->hw_device_ctx->data)->type;
+        auto hardware_pixel_format = hardware_pixel_format_for_device_type(codec_context->codec, device_type);
+        for (auto const* format = formats; *format >= 0; format++) {
+            if (*format == hardware_pixel_format)
+                return hardware_pixel_format;
+        }
+        dbgln_if(PLAYBACK_MANAGER_DEBUG, "FFmpegVideoDecoder: Hardware decoding is not supported for this stream, falling back to software");
+    }
+
     while (*formats >= 0) {
         switch (*formats) {
         case AV_PIX_FMT_YUV420P:
@@ -38,16 +76,93 @@ static AVPixelFormat negotiate_output_format(AVCodecContext*, AVPixelFormat cons
     return AV_PIX_FMT_NONE;
 }
 
-DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> FFmpegVideoDecoder::try_create(CodecID codec_id, ReadonlyBytes codec_initialization_data)
+// Sets up the first hardware device that can decode the codec, and returns the pixel format of the frames it decodes.
+static AVPixelFormat set_up_hardware_decoding(AVCodecContext* codec_context, AVCodec const* codec)
+{
+    for (auto device_type : hardware_device_types) {
+        auto hardware_pixel_format = hardware_pixel_format_for_device_type(codec, device_type);
+        if (hardware_pixel_format == AV_PIX_FMT_NONE)
+            continue;
+
+        AVBufferRef* device_context = nullptr;
+        if (auto result = av_hwdevice_ctx_create(&device_context, device_type, nullptr, nullptr, 0); result < 0) {
+            dbgln_if(PLAYBACK_MANAGER_DEBUG, "FFmpegVideoDecoder: Failed to create {} device: {}", av_hwdevice_get_type_name(device_type), result);
+            continue;
+        }
+
+        codec_context->hw_device_ctx = device_context;
+        dbgln_if(PLAYBACK_MANAGER_DEBUG, "FFmpegVideoDecoder: Using {} for hardware decoding", av_hwdevice_get_type_name(device_type));
+        return hardware_pixel_format;
+    }
+    return AV_PIX_FMT_NONE;
+}
+
+// Hardware decoders output NV12 or P010 frames, which store both chroma planes interleaved in a single plane. P010 also
+// stores its samples in the high bits of each 16-bit component, where we expect them in the low bits.
+static DecoderErrorOr<void> copy_semi_planar_frame(AVFrame const& source_frame, SubsampledYUVFrame& frame, Gfx::Size<u32> chroma_size, size_t bit_depth)
+{
+    if (source_frame.linesize[0] < 0 || source_frame.linesize[1] < 0)
+        return DecoderError::with_description(DecoderErrorCategory::NotImplemented, "Reversed scanlines are not supported"sv);
+
+    auto component_size = (bit_depth + 7) / 8;
+    auto shift = component_size == 2 ? 16 - bit_depth : 0;
+    auto read_component = [&](u8 const* source) -> u16 {
+        if (component_size == 1)
+            return *source;
+        u16 value;
+        memcpy(&value, source, sizeof(value));
+        return value >> shift;
+    };
+    auto write_component = [&](u8* destination, u16 value) {
+        if (component_size == 1)
+            *destination = static_cast<u8>(value);
+        else
+            memcpy(destination, &value, sizeof(value));
+    };
+
+    auto const* luma_source = source_frame.data[0];
+    auto* luma_destination = frame.get_raw_plane_data(0);
+    auto luma_line_size = static_cast<size_t>(source_frame.width) * component_size;
+    for (int row = 0; row < source_frame.height; row++) {
+        if (shift == 0) {
+            memcpy(luma_destination, luma_source, luma_line_size);
+        } else {
+            for (size_t offset = 0; offset < luma_line_size; offset += component_size)
+                write_component(luma_destination + offset, read_component(luma_source + offset));
+        }
+        luma_source += source_frame.linesize[0];
+        luma_destination += luma_line_size;
+    }
+
+    auto const* chroma_source = source_frame.data[1];
+    auto* u_destination = frame.get_raw_plane_data(1);
+    auto* v_destination = frame.get_raw_plane_data(2);
+    for (u32 row = 0; row < chroma_size.height(); row++) {
+        for (u32 column = 0; column < chroma_size.width(); column++) {
+            auto const* source = chroma_source + (column * 2 * component_size);
+            write_component(u_destination, read_component(source));
+            write_component(v_destination, read_component(source + component_size));
+            u_destination += component_size;
+            v_destination += component_size;
+        }
+        chroma_source += source_frame.linesize[1];
+    }
+
+    return {};
+}
+
+DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> FFmpegVideoDecoder::try_create(CodecID codec_id, ReadonlyBytes codec_initialization_data, HardwareAcceleration hardware_acceleration)
 {
     AVCodecContext* codec_context = nullptr;
     AVPacket* packet = nullptr;
     AVFrame* frame = nullptr;
+    AVFrame* software_frame = nullptr;
     ArmedScopeGuard memory_guard {
         [&] {
             avcodec_free_context(&codec_context);
             av_packet_free(&packet);
             av_frame_free(&frame);
+            av_frame_free(&software_frame);
         }
     };
 
@@ -62,6 +177,10 @@ DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> FFmpegVideoDecoder::try_create
 
     codec_context->get_format = negotiate_output_format;
 
+    auto hardware_pixel_format = AV_PIX_FMT_NONE;
+    if (hardware_acceleration == HardwareAcceleration::Preferred)
+        hardware_pixel_format = set_up_hardware_decoding(codec_context, codec);
+
     codec_context->thread_count = static_cast<int>(min(Core::System::hardware_concurrency(), 4));
 
     if (!codec_initialization_data.is_empty()) {
@@ -78,8 +197,13 @@ DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> FFmpegVideoDecoder::try_create
         codec_context->extradata_size = static_cast<int>(codec_initialization_data.size());
     }
 
-    if (avcodec_open2(codec_context, codec, nullptr) < 0)
-        return DecoderError::format(DecoderErrorCategory::Unknown, "Unknown error occurred when opening FFmpeg codec {}", codec_id);
+    if (avcodec_open2(codec_context, codec, nullptr) < 0) {
+        if (hardware_pixel_format == AV_PIX_FMT_NONE)
+            return DecoderError::format(DecoderErrorCategory::Unknown, "Unknown error occurred when opening FFmpeg codec {}", codec_id);
+
+        dbgln_if(PLAYBACK_MANAGER_DEBUG, "FFmpegVideoDecoder: Failed to open codec {} with hardware decoding, falling back to software", codec_id);
+        return try_create(codec_id, codec_initialization_data, HardwareAcceleration::Disabled);
+    }
 
     packet = av_packet_alloc();
     if (!packet)
@@ -89,14 +213,20 @@ DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> FFmpegVideoDecoder::try_create
     if (!frame)
         return DecoderError::with_description(DecoderErrorCategory::Memory, "Failed to allocate FFmpeg frame"sv);
 
+    software_frame = av_frame_alloc();
+    if (!software_frame)
+        return DecoderError::with_description(DecoderErrorCategory::Memory, "Failed to allocate FFmpeg frame"sv);
+
     memory_guard.disarm();
-    return DECODER_TRY_ALLOC(try_make<FFmpegVideoDecoder>(codec_context, packet, frame));
+    return DECODER_TRY_ALLOC(try_make<FFmpegVideoDecoder>(codec_context, packet, frame, software_frame, hardware_pixel_format));
 }
 
-FFmpegVideoDecoder::FFmpegVideoDecoder(AVCodecContext* codec_context, AVPacket* packet, AVFrame* frame)
+FFmpegVideoDecoder::FFmpegVideoDecoder(AVCodecContext* codec_context, AVPacket* packet, AVFrame* frame, AVFrame* software_frame, int hardware_pixel_format)
     : m_codec_context(codec_context)
     , m_packet(packet)
     , m_frame(frame)
+    , m_software_frame(software_frame)
+    , m_hardware_pixel_format(hardware_pixel_format)
 {
 }
 
@@ -104,6 +234,7 @@ FFmpegVideoDecoder::~FFmpegVideoDecoder()
 {
     av_packet_free(&m_packet);
     av_frame_free(&m_frame);
+    av_frame_free(&m_software_frame);
     avcodec_free_context(&m_codec_context);
 }
 
@@ -144,11 +275,24 @@ DecoderErrorOr<NonnullOwnPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
 
     switch (result) {
     case 0: {
-        auto color_primaries = static_cast<ColorPrimaries>(m_frame->color_primaries);
-        auto transfer_characteristics = static_cast<TransferCharacteristics>(m_frame->color_trc);
-        auto matrix_coefficients = static_cast<MatrixCoefficients>(m_frame->colorspace);
+        auto const* decoded_frame = m_frame;
+        bool is_hardware_frame = m_frame->format == m_hardware_pixel_format;
+        m_is_hardware_accelerated.store(is_hardware_frame, AK::memory_order_relaxed);
+        if (is_hardware_frame) {
+            // FIXME: Convert hardware frames to RGB on the GPU instead of copying them back to memory.
+            av_frame_unref(m_software_frame);
+            if (auto transfer_result = av_hwframe_transfer_data(m_software_frame, m_frame, 0); transfer_result < 0)
+                return DecoderError::format(DecoderErrorCategory::Unknown, "Failed to transfer hardware frame to memory with code {:x}", transfer_result);
+            if (auto copy_result = av_frame_copy_props(m_software_frame, m_frame); copy_result < 0)
+                return DecoderError::format(DecoderErrorCategory::Unknown, "Failed to copy hardware frame properties with code {:x}", copy_result);
+            decoded_frame = m_software_frame;
+        }
+
+        auto color_primaries = static_cast<ColorPrimaries>(decoded_frame->color_primaries);
+        auto transfer_characteristics = static_cast<TransferCharacteristics>(decoded_frame->color_trc);
+        auto matrix_coefficients = static_cast<MatrixCoefficients>(decoded_frame->colorspace);
         auto color_range = [&] {
-            switch (m_frame->color_range) {
+            switch (decoded_frame->color_range) {
             case AVColorRange::AVCOL_RANGE_MPEG:
                 return VideoFullRangeFlag::Studio;
             case AVColorRange::AVCOL_RANGE_JPEG:
@@ -160,7 +304,8 @@ DecoderErrorOr<NonnullOwnPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
         auto cicp = CodingIndependentCodePoints { color_primaries, transfer_characteristics, matrix_coefficients, color_range };
 
         size_t bit_depth = [&] {
-            switch (m_frame->format) {
+            switch (decoded_frame->format) {
+            case AV_PIX_FMT_NV12:
             case AV_PIX_FMT_YUV420P:
             case AV_PIX_FMT_YUV422P:
             case AV_PIX_FMT_YUV444P:
@@ -168,6 +313,7 @@ DecoderErrorOr<NonnullOwnPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
             case AV_PIX_FMT_YUVJ422P:
             case AV_PIX_FMT_YUVJ444P:
                 return 8;
+            case AV_PIX_FMT_P010:
             case AV_PIX_FMT_YUV420P10:
             case AV_PIX_FMT_YUV422P10:
             case AV_PIX_FMT_YUV444P10:
@@ -177,13 +323,17 @@ DecoderErrorOr<NonnullOwnPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
             case AV_PIX_FMT_YUV444P12:
                 return 12;
             default:
-                VERIFY_NOT_REACHED();
+                return 0;
             }
         }();
+        if (bit_depth == 0)
+            return DecoderError::format(DecoderErrorCategory::NotImplemented, "Unsupported pixel format {}", decoded_frame->format);
         size_t component_size = (bit_depth + 7) / 8;
 
         auto subsampling = [&]() -> Subsampling {
-            switch (m_frame->format) {
+            switch (decoded_frame->format) {
+            case AV_PIX_FMT_NV12:
+            case AV_PIX_FMT_P010:
             case AV_PIX_FMT_YUV420P:
             case AV_PIX_FMT_YUV420P10:
             case AV_PIX_FMT_YUV420P12:
@@ -204,30 +354,35 @@ DecoderErrorOr<NonnullOwnPtr<VideoFrame>> FFmpegVideoDecoder::get_decoded_frame(
             }
         }();
 
-        auto size = Gfx::Size<u32> { m_frame->width, m_frame->height };
+        auto size = Gfx::Size<u32> { decoded_frame->width, decoded_frame->height };
 
-        auto timestamp = AK::Duration::from_microseconds(m_frame->pts);
+        auto timestamp = AK::Duration::from_microseconds(decoded_frame->pts);
         auto frame = DECODER_TRY_ALLOC(SubsampledYUVFrame::try_create(timestamp, size, bit_depth, cicp, subsampling));
 
+        if (decoded_frame->format == AV_PIX_FMT_NV12 || decoded_frame->format == AV_PIX_FMT_P010) {
+            TRY(copy_semi_planar_frame(*decoded_frame, *frame, subsampling.subsampled_size(size), bit_depth));
+            return frame;
+        }
+
         for (u32 plane = 0; plane < 3; plane++) {
-            VERIFY(m_frame->linesize[plane] != 0);
-            if (m_frame->linesize[plane] < 0)
+            VERIFY(decoded_frame->linesize[plane] != 0);
+            if (decoded_frame->linesize[plane] < 0)
                 return DecoderError::with_description(DecoderErrorCategory::NotImplemented, "Reversed scanlines are not supported"sv);
 
             bool const use_subsampling = plane > 0;
             auto plane_size = (use_subsampling ? subsampling.subsampled_size(size) : size).to_type<size_t>();
 
             auto output_line_size = plane_size.width() * component_size;
-            VERIFY(output_line_size <= static_cast<size_t>(m_frame->linesize[plane]));
+            VERIFY(output_line_size <= static_cast<size_t>(decoded_frame->linesize[plane]));
 
-            auto const* source = m_frame->data[plane];
+            auto const* source = decoded_frame->data[plane];
             VERIFY(source != nullptr);
             auto* destination = frame->get_raw_plane_data(plane);
             VERIFY(destination != nullptr);
 
             for (size_t row = 0; row < plane_size.height(); row++) {
                 memcpy(destination, source, output_line_size);
-                source += m_frame->linesize[plane];
+                source += decoded_frame->linesize[plane];
                 destination += output_line_size;
             }
         }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <LibMedia/CodecID.h>
 #include <LibMedia/Export.h>
 #include <LibMedia/VideoDecoder.h>
@@ -16,8 +17,8 @@ namespace Media::FFmpeg {
 
 class MEDIA_API FFmpegVideoDecoder final : public VideoDecoder {
 public:
-    static DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> try_create(CodecID, ReadonlyBytes codec_initialization_data);
-    FFmpegVideoDecoder(AVCodecContext* codec_context, AVPacket* packet, AVFrame* frame);
+    static DecoderErrorOr<NonnullOwnPtr<FFmpegVideoDecoder>> try_create(CodecID, ReadonlyBytes codec_initialization_data, HardwareAcceleration = HardwareAcceleration::Preferred);
+    FFmpegVideoDecoder(AVCodecContext* codec_context, AVPacket* packet, AVFrame* frame, AVFrame* software_frame, int hardware_pixel_format);
     virtual ~FFmpegVideoDecoder() override;
 
     virtual DecoderErrorOr<void> receive_coded_data(AK::Duration timestamp, ReadonlyBytes coded_data) override;
@@ -25,10 +26,18 @@ public:
 
     virtual void flush() override;
 
+    virtual bool is_hardware_accelerated() const override { return m_is_hardware_accelerated.load(AK::memory_order_relaxed); }
+
 private:
     AVCodecContext* m_codec_context;
     AVPacket* m_packet;
     AVFrame* m_frame;
+
+    // Frames decoded in hardware are transferred into this frame before they are copied out.
+    AVFrame* m_software_frame;
+    // The AVPixelFormat of frames decoded in hardware, or AV_PIX_FMT_NONE if no hardware device is in use.
+    int m_hardware_pixel_format;
+    Atomic<bool> m_is_hardware_accelerated { false };
 };
 
 }
@@ -27,26 +27,26 @@ namespace Media {
         _fatal_expression.release_value();                                                           \
     })
 
-DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::from_data(ReadonlyBytes data)
+DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::from_data(ReadonlyBytes data, HardwareAcceleration hardware_acceleration)
 {
     auto stream = make<FixedMemoryStream>(data);
-    return from_stream(move(stream));
+    return from_stream(move(stream), hardware_acceleration);
 }
 
-DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::from_stream(NonnullOwnPtr<SeekableStream> stream)
+DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::from_stream(NonnullOwnPtr<SeekableStream> stream, HardwareAcceleration hardware_acceleration)
 {
     auto demuxer_or_error = FFmpeg::FFmpegDemuxer::create(move(stream));
     if (demuxer_or_error.is_error())
         return DecoderError::format(DecoderErrorCategory::Unknown, "{}", demuxer_or_error.error());
-    return create(demuxer_or_error.release_value());
+    return create(demuxer_or_error.release_value(), hardware_acceleration);
 }
 
-DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::from_url(StringView url)
+DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::from_url(StringView url, HardwareAcceleration hardware_acceleration)
 {
     auto demuxer_or_error = FFmpeg::FFmpegDemuxer::create_from_url(url);
     if (demuxer_or_error.is_error())
         return DecoderError::format(DecoderErrorCategory::Unknown, "{}", demuxer_or_error.error());
-    return create(demuxer_or_error.release_value());
+    return create(demuxer_or_error.release_value(), hardware_acceleration);
 }
 
 PlaybackManager::PlaybackManager(NonnullOwnPtr<Demuxer>& demuxer, Track video_track, NonnullOwnPtr<VideoDecoder>&& decoder, VideoFrameQueue&& frame_queue)
@@ -137,7 +137,7 @@ void PlaybackManager::dispatch_decoder_error(DecoderError error)
     }
 }
 
-void PlaybackManager::dispatch_new_frame(RefPtr<Gfx::Bitmap> frame)
+void PlaybackManager::dispatch_new_frame(RefPtr<Gfx::ImmutableBitmap> frame)
 {
     if (on_video_frame)
         on_video_frame(move(frame));
@@ -201,6 +201,42 @@ void PlaybackManager::restart_playback()
     seek_to_timestamp(AK::Duration::zero());
 }
 
+DecoderErrorOr<NonnullRefPtr<Gfx::ImmutableBitmap>> PlaybackManager::convert_frame_for_display(VideoFrame& frame)
+{
+    // Hand the Y'CbCr planes to the painter as they are where we can, so that the conversion to RGB happens in a shader
+    // while painting. The planes of a frame that is neither queued nor displayed anymore are reused for the new one.
+    Optional<size_t> reusable_index;
+    RefPtr<Gfx::YUVData> reusable_data;
+    for (size_t i = 0; i < m_frame_buffer_pool.size(); ++i) {
+        if (m_frame_buffer_pool[i]->ref_count() == 1) {
+            // Synchronize with the thread that dropped the last other reference, which may have been reading the planes.
+            AK::atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
+            reusable_index = i;
+            reusable_data = m_frame_buffer_pool[i];
+            break;
+        }
+    }
+
+    auto yuv_data_or_error = frame.to_yuv_data(reusable_data);
+    if (!yuv_data_or_error.is_error()) {
+        auto yuv_data = yuv_data_or_error.release_value();
+        if (yuv_data.ptr() != reusable_data.ptr()) {
+            if (reusable_index.has_value())
+                m_frame_buffer_pool[*reusable_index] = yuv_data;
+            else if (m_frame_buffer_pool.size() < maximum_frame_buffer_pool_size)
+                m_frame_buffer_pool.append(yuv_data);
+        }
+
+        auto bitmap_or_error = Gfx::ImmutableBitmap::create_from_yuv(move(yuv_data));
+        if (!bitmap_or_error.is_error())
+            return bitmap_or_error.release_value();
+        dbgln_if(PLAYBACK_MANAGER_DEBUG, "Converting frame in software: {}", bitmap_or_error.error());
+    }
+
+    auto bitmap = TRY(frame.to_bitmap());
+    return Gfx::ImmutableBitmap::create(move(bitmap));
+}
+
 void PlaybackManager::decode_and_queue_one_sample()
 {
 #if PLAYBACK_MANAGER_DEBUG
@@ -272,7 +308,7 @@ void PlaybackManager::decode_and_queue_one_sample()
                 break;
             }
 
-            auto bitmap_result = decoded_frame->to_bitmap();
+            auto bitmap_result = convert_frame_for_display(*decoded_frame);
 
             if (bitmap_result.is_error())
                 item_to_enqueue = FrameQueueItem::error_marker(bitmap_result.release_error(), decoded_frame->timestamp());
@@ -421,19 +457,25 @@ private:
 
     AK::Duration current_time() const override
     {
+        if (manager().m_unthrottled_presentation)
+            return manager().m_last_present_in_media_time;
         return manager().m_last_present_in_media_time + (MonotonicTime::now() - m_last_present_in_real_time);
     }
 
     ErrorOr<void> do_timed_state_update() override
     {
         auto set_presentation_timer = [&]() {
+            if (manager().m_unthrottled_presentation) {
+                manager().set_state_update_timer(0);
+                return;
+            }
             auto frame_time_ms = (manager().m_next_frame->timestamp() - current_time()).to_milliseconds();
             VERIFY(frame_time_ms <= NumericLimits<int>::max());
             dbgln_if(PLAYBACK_MANAGER_DEBUG, "Time until next frame is {}ms", frame_time_ms);
             manager().set_state_update_timer(max(static_cast<int>(frame_time_ms), 0));
         };
 
-        if (manager().m_next_frame.has_value() && current_time() < manager().m_next_frame->timestamp()) {
+        if (!manager().m_unthrottled_presentation && manager().m_next_frame.has_value() && current_time() < manager().m_next_frame->timestamp()) {
             dbgln_if(PLAYBACK_MANAGER_DEBUG, "Current time {}ms is too early to present the next frame at {}ms, delaying", current_time().to_milliseconds(), manager().m_next_frame->timestamp().to_milliseconds());
             set_presentation_timer();
             return {};
@@ -484,6 +526,11 @@ private:
                 }
                 manager().m_next_frame.emplace(future_frame_item.release_value());
             }
+            // Waiting for the whole buffer to fill up again would hold back a decoder that only just keeps up.
+            if (manager().m_unthrottled_presentation) {
+                manager().set_state_update_timer(1);
+                return {};
+            }
             TRY(buffer());
             return {};
         }
@@ -491,7 +538,10 @@ private:
         // If we have a frame, send it for presentation.
         if (should_present_frame) {
             auto now = MonotonicTime::now();
-            manager().m_last_present_in_media_time += now - m_last_present_in_real_time;
+            if (manager().m_unthrottled_presentation)
+                manager().m_last_present_in_media_time = max(manager().m_last_present_in_media_time, manager().m_next_frame->timestamp());
+            else
+                manager().m_last_present_in_media_time += now - m_last_present_in_real_time;
             m_last_present_in_real_time = now;
 
             if (manager().dispatch_frame_queue_item(manager().m_next_frame.release_value()))
@@ -704,7 +754,7 @@ private:
     PlaybackState get_state() const override { return PlaybackState::Stopped; }
 };
 
-DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::create(NonnullOwnPtr<Demuxer> demuxer)
+DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::create(NonnullOwnPtr<Demuxer> demuxer, HardwareAcceleration hardware_acceleration)
 {
     auto optional_track = TRY(demuxer->get_preferred_track_for_type(TrackType::Video));
     if (!optional_track.has_value()) {
@@ -716,7 +766,7 @@ DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> PlaybackManager::create(NonnullOw
 
     auto codec_id = TRY(demuxer->get_codec_id_for_track(track));
     auto codec_initialization_data = TRY(demuxer->get_codec_initialization_data_for_track(track));
-    NonnullOwnPtr<VideoDecoder> decoder = TRY(FFmpeg::FFmpegVideoDecoder::try_create(codec_id, codec_initialization_data));
+    NonnullOwnPtr<VideoDecoder> decoder = TRY(FFmpeg::FFmpegVideoDecoder::try_create(codec_id, codec_initialization_data, hardware_acceleration));
     auto frame_queue = DECODER_TRY_ALLOC(VideoFrameQueue::create());
     auto playback_manager = DECODER_TRY_ALLOC(try_make<PlaybackManager>(demuxer, track, move(decoder), move(frame_queue)));
 
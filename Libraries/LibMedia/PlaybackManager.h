@@ -12,7 +12,8 @@
 #include <AK/Queue.h>
 #include <AK/Time.h>
 #include <LibCore/SharedCircularQueue.h>
-#include <LibGfx/Bitmap.h>
+#include <LibGfx/ImmutableBitmap.h>
+#include <LibGfx/YUVData.h>
 #include <LibMedia/Demuxer.h>
 #include <LibMedia/Export.h>
 #include <LibThreading/ConditionVariable.h>
@@ -38,7 +39,7 @@ public:
         Error,
     };
 
-    static FrameQueueItem frame(RefPtr<Gfx::Bitmap> bitmap, AK::Duration timestamp)
+    static FrameQueueItem frame(RefPtr<Gfx::ImmutableBitmap> bitmap, AK::Duration timestamp)
     {
         return FrameQueueItem(move(bitmap), timestamp);
     }
@@ -48,8 +49,8 @@ public:
         return FrameQueueItem(move(error), timestamp);
     }
 
-    bool is_frame() const { return m_data.has<RefPtr<Gfx::Bitmap>>(); }
-    RefPtr<Gfx::Bitmap> bitmap() const { return m_data.get<RefPtr<Gfx::Bitmap>>(); }
+    bool is_frame() const { return m_data.has<RefPtr<Gfx::ImmutableBitmap>>(); }
+    RefPtr<Gfx::ImmutableBitmap> bitmap() const { return m_data.get<RefPtr<Gfx::ImmutableBitmap>>(); }
     AK::Duration timestamp() const { return m_timestamp; }
 
     bool is_error() const { return m_data.has<DecoderError>(); }
@@ -71,7 +72,7 @@ public:
     }
 
 private:
-    FrameQueueItem(RefPtr<Gfx::Bitmap> bitmap, AK::Duration timestamp)
+    FrameQueueItem(RefPtr<Gfx::ImmutableBitmap> bitmap, AK::Duration timestamp)
         : m_data(move(bitmap))
         , m_timestamp(timestamp)
     {
@@ -84,7 +85,7 @@ private:
     {
     }
 
-    Variant<Empty, RefPtr<Gfx::Bitmap>, DecoderError> m_data { Empty() };
+    Variant<Empty, RefPtr<Gfx::ImmutableBitmap>, DecoderError> m_data { Empty() };
     AK::Duration m_timestamp { no_timestamp };
 };
 
@@ -111,9 +112,9 @@ public:
 
     static constexpr SeekMode DEFAULT_SEEK_MODE = SeekMode::Accurate;
 
-    static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> from_data(ReadonlyBytes data);
-    static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> from_stream(NonnullOwnPtr<SeekableStream> stream);
-    static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> from_url(StringView url);
+    static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> from_data(ReadonlyBytes data, HardwareAcceleration = HardwareAcceleration::Preferred);
+    static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> from_stream(NonnullOwnPtr<SeekableStream> stream, HardwareAcceleration = HardwareAcceleration::Preferred);
+    static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> from_url(StringView url, HardwareAcceleration = HardwareAcceleration::Preferred);
 
     PlaybackManager(NonnullOwnPtr<Demuxer>& demuxer, Track video_track, NonnullOwnPtr<VideoDecoder>&& decoder, VideoFrameQueue&& frame_queue);
     ~PlaybackManager();
@@ -134,10 +135,15 @@ public:
 
     u64 number_of_skipped_frames() const { return m_skipped_frames; }
 
+    // Presents every frame as soon as it has been decoded instead of at its timestamp, and never skips frames. This lets
+    // benchmarks measure how fast the decoding pipeline is.
+    void set_unthrottled_presentation(bool unthrottled) { m_unthrottled_presentation = unthrottled; }
+    bool is_using_hardware_decoding() const { return m_decoder->is_hardware_accelerated(); }
+
     AK::Duration current_playback_time();
     AK::Duration duration();
 
-    Function<void(RefPtr<Gfx::Bitmap>)> on_video_frame;
+    Function<void(RefPtr<Gfx::ImmutableBitmap>)> on_video_frame;
     Function<void()> on_playback_state_change;
     Function<void(DecoderError)> on_decoder_error;
     Function<void(Error)> on_fatal_playback_error;
@@ -154,7 +160,7 @@ private:
     class SeekingStateHandler;
     class StoppedStateHandler;
 
-    static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> create(NonnullOwnPtr<Demuxer> demuxer);
+    static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> create(NonnullOwnPtr<Demuxer> demuxer, HardwareAcceleration);
 
     void timer_callback();
     // This must be called with m_demuxer_mutex locked!
@@ -164,9 +170,10 @@ private:
     void set_state_update_timer(int delay_ms);
 
     void decode_and_queue_one_sample();
+    DecoderErrorOr<NonnullRefPtr<Gfx::ImmutableBitmap>> convert_frame_for_display(VideoFrame&);
 
     void dispatch_decoder_error(DecoderError error);
-    void dispatch_new_frame(RefPtr<Gfx::Bitmap> frame);
+    void dispatch_new_frame(RefPtr<Gfx::ImmutableBitmap> frame);
     // Returns whether we changed playback states. If so, any PlaybackStateHandler processing must cease.
     [[nodiscard]] bool dispatch_frame_queue_item(FrameQueueItem&&);
     void dispatch_state_change();
@@ -189,10 +196,16 @@ private:
     Threading::ConditionVariable m_decode_wait_condition;
     Atomic<bool> m_buffer_is_full { false };
 
+    // The planes of decoded frames, which are reused once the frames are no longer queued or displayed, so that steady
+    // playback doesn't allocate memory for every frame. This is only used by the decode thread.
+    static constexpr size_t maximum_frame_buffer_pool_size = frame_buffer_count + 2;
+    Vector<NonnullRefPtr<Gfx::YUVData>, maximum_frame_buffer_pool_size> m_frame_buffer_pool;
+
     OwnPtr<PlaybackStateHandler> m_playback_handler;
     Optional<FrameQueueItem> m_next_frame;
 
     u64 m_skipped_frames { 0 };
+    bool m_unthrottled_presentation { false };
 
     // This is a nested class to allow private access.
     class PlaybackStateHandler {
@@ -14,6 +14,12 @@
 
 namespace Media {
 
+enum class HardwareAcceleration : u8 {
+    Disabled,
+    // Decode on the GPU if the platform supports it for the codec, and in software otherwise.
+    Preferred,
+};
+
 class VideoDecoder {
 public:
     virtual ~VideoDecoder() { }
@@ -23,6 +29,9 @@ public:
     virtual DecoderErrorOr<NonnullOwnPtr<VideoFrame>> get_decoded_frame() = 0;
 
     virtual void flush() = 0;
+
+    // Whether the most recently decoded frame was decoded in hardware.
+    virtual bool is_hardware_accelerated() const { return false; }
 };
 
 }
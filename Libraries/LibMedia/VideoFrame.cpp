@@ -237,4 +237,20 @@ DecoderErrorOr<void> SubsampledYUVFrame::output_to_bitmap(Gfx::Bitmap& bitmap)
     return convert_to_bitmap_selecting_subsampling(m_subsampling, cicp(), bit_depth(), width(), height(), m_y_buffer, m_u_buffer, m_v_buffer, bitmap);
 }
 
+DecoderErrorOr<NonnullRefPtr<Gfx::YUVData>> SubsampledYUVFrame::to_yuv_data(RefPtr<Gfx::YUVData> reusable_data)
+{
+    auto size = this->size().to_type<int>();
+    auto data = move(reusable_data);
+    if (data && data->has_format(size, bit_depth(), m_subsampling))
+        data->set_cicp(cicp());
+    else
+        data = DECODER_TRY_ALLOC(Gfx::YUVData::create(size, bit_depth(), m_subsampling, cicp()));
+
+    for (u32 plane = 0; plane < 3; ++plane) {
+        auto destination = data->plane_data(plane);
+        ReadonlyBytes { get_raw_plane_data(plane), destination.size() }.copy_to(destination);
+    }
+    return data.release_nonnull();
+}
+
 }
@@ -9,6 +9,7 @@
 #include <AK/Time.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Size.h>
+#include <LibGfx/YUVData.h>
 #include <LibMedia/Color/CodingIndependentCodePoints.h>
 
 #include "DecoderError.h"
@@ -29,6 +30,13 @@ public:
         return bitmap;
     }
 
+    // Copies the Y'CbCr planes of the frame without converting them to RGB. The data passed in is reused if it has the
+    // right format, so that callers can recycle the data of frames that are no longer displayed.
+    virtual DecoderErrorOr<NonnullRefPtr<Gfx::YUVData>> to_yuv_data(RefPtr<Gfx::YUVData>)
+    {
+        return DecoderError::not_implemented();
+    }
+
     inline AK::Duration timestamp() const { return m_timestamp; }
 
     inline Gfx::Size<u32> size() const { return m_size; }
@@ -91,6 +99,7 @@ public:
     ~SubsampledYUVFrame();
 
     DecoderErrorOr<void> output_to_bitmap(Gfx::Bitmap& bitmap) override;
+    DecoderErrorOr<NonnullRefPtr<Gfx::YUVData>> to_yuv_data(RefPtr<Gfx::YUVData> reusable_data) override;
 
     u8* get_raw_plane_data(u32 plane)
     {
@@ -0,0 +1,441 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/HashTable.h>
+#include <AK/QuickSort.h>
+#include <LibRegex/RegexAutomaton.h>
+
+namespace regex {
+
+// U+2028 LINE SEPARATOR
+constexpr static u32 const LineSeparator { 0x2028 };
+// U+2029 PARAGRAPH SEPARATOR
+constexpr static u32 const ParagraphSeparator { 0x2029 };
+
+// Everything about a position that assertions look at, besides the code point before it.
+enum Context : u8 {
+    AtEnd = 1 << 0,
+    NextIsWord = 1 << 1,
+    PreviousIsWord = 1 << 2,
+    NextIsLineTerminator = 1 << 3,
+    PreviousIsLineTerminator = 1 << 4,
+};
+
+enum class Captures {
+    Keep,
+    Skip,
+};
+
+static void combine_hash(u64& hash, u64 value)
+{
+    hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+}
+
+// Threads at the same instruction with the same repetition counts, and with the same checkpoints passed at the current
+// position, can only go where the first of them goes.
+static u64 thread_key(MatchState const& state)
+{
+    u64 hash = 0xcbf29ce484222325;
+    combine_hash(hash, state.instruction_position);
+    for (auto mark : state.repetition_marks)
+        combine_hash(hash, mark);
+    combine_hash(hash, 0xfacefacefaceface);
+    for (size_t id = 0; id < state.checkpoints.size(); ++id) {
+        if (state.checkpoints[id] == 0)
+            continue;
+        combine_hash(hash, id);
+        // JumpNonEmpty only looks at whether the checkpoint was passed at the current position.
+        combine_hash(hash, state.checkpoints[id] == state.string_position + 1 ? 1 : 2);
+    }
+    return hash;
+}
+
+// Runs a thread through every instruction that doesn't consume input, and parks all the threads that come out of it at
+// the comparison they wait on, in the order the backtracking matcher would try them in. Threads that match are parked
+// at the Exit that they matched on.
+static void follow_epsilon_transitions(ByteCode const& bytecode, MatchInput const& input, MatchState&& thread, Captures captures, HashTable<u64>& visited, Vector<MatchState>& parked_threads, size_t& operations)
+{
+    Vector<MatchState> alternatives;
+    alternatives.append(move(thread));
+
+    while (!alternatives.is_empty()) {
+        auto state = alternatives.take_last();
+        for (;;) {
+            if (visited.set(thread_key(state)) != HashSetResult::InsertedNewEntry)
+                break;
+
+            auto& opcode = bytecode.get_opcode(state);
+            auto opcode_id = opcode.opcode_id();
+            if (opcode_id == OpCodeId::Compare) {
+                parked_threads.append(move(state));
+                break;
+            }
+
+            auto size = opcode.size();
+            if (captures == Captures::Skip
+                && (opcode_id == OpCodeId::SaveLeftCaptureGroup || opcode_id == OpCodeId::SaveRightCaptureGroup
+                    || opcode_id == OpCodeId::SaveRightNamedCaptureGroup || opcode_id == OpCodeId::ClearCaptureGroup)) {
+                state.instruction_position += size;
+                continue;
+            }
+
+            ++operations;
+            auto result = opcode.execute(input, state);
+            // All threads stay alive until they fail, so there are no earlier forks to replace.
+            input.fork_to_replace.clear();
+            state.instruction_position += size;
+
+            switch (result) {
+            case ExecutionResult::Continue:
+                continue;
+            case ExecutionResult::Fork_PrioHigh:
+                // The fork's target goes first, and the instruction after the fork is only tried if that fails.
+                alternatives.append(state);
+                state.instruction_position = state.fork_at_position;
+                continue;
+            case ExecutionResult::Fork_PrioLow:
+                alternatives.append(state);
+                alternatives.last().instruction_position = state.fork_at_position;
+                continue;
+            case ExecutionResult::Succeeded:
+                state.instruction_position -= size;
+                parked_threads.append(move(state));
+                break;
+            case ExecutionResult::Failed:
+            case ExecutionResult::Failed_ExecuteLowPrioForks:
+                break;
+            }
+            break;
+        }
+    }
+}
+
+OwnPtr<Automaton> Automaton::try_create(ByteCode const& bytecode)
+{
+    bool has_word_boundaries = false;
+    bool has_line_assertions = false;
+
+    auto state = MatchState::only_for_enumeration();
+    auto bytecode_size = bytecode.size();
+    while (state.instruction_position < bytecode_size) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+        case OpCodeId::PopSaved:
+            // Lookarounds keep their saved positions in the MatchInput, which all threads would share.
+            return nullptr;
+        case OpCodeId::Compare:
+            for (auto const& compare : static_cast<OpCode_Compare const&>(opcode).flat_compares()) {
+                if (compare.type == CharacterCompareType::Reference || compare.type == CharacterCompareType::NamedReference)
+                    return nullptr;
+            }
+            break;
+        case OpCodeId::CheckBoundary:
+            has_word_boundaries = true;
+            break;
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+            has_line_assertions = true;
+            break;
+        default:
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+
+    return adopt_own(*new Automaton(has_word_boundaries, has_line_assertions));
+}
+
+Automaton::SearchResult Automaton::search(ByteCode const& bytecode, MatchInput const& input, MatchState& state, bool anchored, Function<bool(size_t)> const& can_start_at, size_t& match_start, size_t& operations)
+{
+    if (anchored && !can_start_at(state.string_position))
+        return SearchResult::NoMatch;
+
+    if (!m_dfa_disabled && run_dfa(bytecode, input, state, anchored, operations) == SearchResult::NoMatch)
+        return SearchResult::NoMatch;
+
+    return run_pike_vm(bytecode, input, state, anchored, can_start_at, match_start, operations);
+}
+
+u8 Automaton::context_at(MatchInput const& input, size_t position, size_t position_in_code_units) const
+{
+    auto const& view = input.view;
+    auto length = view.length();
+
+    u8 context = 0;
+    if (position == length)
+        context |= Context::AtEnd;
+
+    if (m_has_word_boundaries) {
+        auto is_word = [](u32 ch) { return is_ascii_alphanumeric(ch) || ch == '_'; };
+        if (position < length && is_word(view.code_point_at(position_in_code_units)))
+            context |= Context::NextIsWord;
+        if (position > 0 && is_word(view.code_point_at(position_in_code_units - 1)))
+            context |= Context::PreviousIsWord;
+    }
+
+    if (m_has_line_assertions && input.regex_options.has_flag_set(AllFlags::Multiline) && input.regex_options.has_flag_set(AllFlags::Internal_ConsiderNewline)) {
+        auto is_line_terminator = [](u32 ch) { return ch == '\r' || ch == '\n' || ch == LineSeparator || ch == ParagraphSeparator; };
+        if (position < length && is_line_terminator(view.substring_view(position, 1).code_point_at(0)))
+            context |= Context::NextIsLineTerminator;
+        if (position > 0 && is_line_terminator(view.substring_view(position - 1, 1).code_point_at(0)))
+            context |= Context::PreviousIsLineTerminator;
+    }
+
+    return context;
+}
+
+Optional<u32> Automaton::dfa_state_for(ByteCode const& bytecode, DFA& dfa, Vector<MatchState>& parked_threads)
+{
+    auto state = make<DFAState>();
+    state->ascii_transitions.fill(unknown_transition);
+
+    for (auto& parked_thread : parked_threads) {
+        if (bytecode.get_opcode(parked_thread).opcode_id() != OpCodeId::Compare) {
+            state->is_match = true;
+            continue;
+        }
+
+        DFAThread thread { parked_thread.instruction_position, move(parked_thread.repetition_marks), {}, 0xcbf29ce484222325 };
+        combine_hash(thread.hash, thread.instruction_position);
+        for (auto mark : thread.repetition_marks)
+            combine_hash(thread.hash, mark);
+        combine_hash(thread.hash, 0xfacefacefaceface);
+        for (size_t id = 0; id < parked_thread.checkpoints.size(); ++id) {
+            if (parked_thread.checkpoints[id] == 0)
+                continue;
+            thread.set_checkpoints.append(id);
+            combine_hash(thread.hash, id);
+        }
+        state->threads.append(move(thread));
+    }
+
+    // The DFA only tells whether there is a match at all, so the order of the threads doesn't matter.
+    quick_sort(state->threads, [](auto const& a, auto const& b) { return a.hash < b.hash; });
+    u64 hash = state->is_match;
+    for (size_t i = 0; i < state->threads.size(); ++i) {
+        if (i > 0 && state->threads[i].hash == state->threads[i - 1].hash) {
+            state->threads.remove(i--);
+            continue;
+        }
+        combine_hash(hash, state->threads[i].hash);
+    }
+
+    if (auto id = dfa.state_ids.get(hash); id.has_value())
+        return *id;
+
+    if (dfa.states.size() >= max_dfa_states) {
+        // Patterns that keep blowing the cache are better served by the Pike VM alone.
+        if (++dfa.flushes > max_dfa_cache_flushes)
+            return {};
+        dfa.states.clear();
+        dfa.state_ids.clear();
+    }
+
+    u32 id = dfa.states.size();
+    dfa.states.append(move(state));
+    dfa.state_ids.set(hash, id);
+    return id;
+}
+
+Automaton::SearchResult Automaton::run_dfa(ByteCode const& bytecode, MatchInput const& input, MatchState const& start_state, bool anchored, size_t& operations)
+{
+    auto give_up = [&] {
+        m_dfa_disabled = true;
+        m_dfas[0] = {};
+        m_dfas[1] = {};
+        return SearchResult::GaveUp;
+    };
+
+    // Comparisons and assertions depend on the options, so states can't be shared between calls with different ones.
+    auto& dfa = m_dfas[anchored ? 1 : 0];
+    auto options = (static_cast<u64>(to_underlying(input.regex_options.value())) << 1) | input.view.unicode();
+    if (dfa.options != options) {
+        dfa = {};
+        dfa.options = options;
+    }
+
+    auto const& view = input.view;
+    auto length = view.length();
+    auto position = start_state.string_position;
+    auto position_in_code_units = start_state.string_position_in_code_units;
+
+    auto thread_at = [](size_t position, size_t position_in_code_units) {
+        MatchState thread { 0 };
+        thread.string_position = position;
+        thread.string_position_in_code_units = position_in_code_units;
+        return thread;
+    };
+
+    Vector<MatchState> parked_threads;
+    HashTable<u64> visited;
+    follow_epsilon_transitions(bytecode, input, thread_at(position, position_in_code_units), Captures::Skip, visited, parked_threads, operations);
+    auto state_id = dfa_state_for(bytecode, dfa, parked_threads);
+    if (!state_id.has_value())
+        return give_up();
+
+    for (;;) {
+        auto& state = *dfa.states[*state_id];
+        if (state.is_match)
+            return SearchResult::Match;
+        if (position >= length || (anchored && state.threads.is_empty()))
+            return SearchResult::NoMatch;
+
+        auto code_point = view.unicode_aware_code_point_at(position_in_code_units);
+        auto next_position_in_code_units = position_in_code_units + (view.unicode() ? view.length_of_code_point(code_point) : 1);
+        auto next_context = context_at(input, position + 1, next_position_in_code_units);
+        auto transition_key = (static_cast<u64>(code_point) << 8) | next_context;
+        auto use_ascii_transitions = code_point < state.ascii_transitions.size() && next_context == 0;
+
+        auto next_state_id = unknown_transition;
+        if (use_ascii_transitions)
+            next_state_id = state.ascii_transitions[code_point];
+        else if (auto transition = state.transitions.get(transition_key); transition.has_value())
+            next_state_id = *transition;
+
+        if (next_state_id == unknown_transition) {
+            parked_threads.clear_with_capacity();
+            visited.clear_with_capacity();
+
+            for (auto const& dfa_thread : state.threads) {
+                auto thread = thread_at(position, position_in_code_units);
+                thread.instruction_position = dfa_thread.instruction_position;
+                thread.repetition_marks = dfa_thread.repetition_marks;
+                for (auto id : dfa_thread.set_checkpoints) {
+                    if (id >= thread.checkpoints.size())
+                        thread.checkpoints.resize(id + 1);
+                    // Once past this position, any checkpoint passed at or before it reads the same.
+                    thread.checkpoints[id] = position + 1;
+                }
+
+                auto& opcode = bytecode.get_opcode(thread);
+                auto size = opcode.size();
+                ++operations;
+                if (opcode.execute(input, thread) != ExecutionResult::Continue)
+                    continue;
+                // Transitions are per code point, so every comparison has to consume exactly one.
+                if (thread.string_position != position + 1)
+                    return give_up();
+                thread.instruction_position += size;
+                follow_epsilon_transitions(bytecode, input, move(thread), Captures::Skip, visited, parked_threads, operations);
+            }
+            if (!anchored)
+                follow_epsilon_transitions(bytecode, input, thread_at(position + 1, next_position_in_code_units), Captures::Skip, visited, parked_threads, operations);
+
+            auto flushes = dfa.flushes;
+            auto next_state = dfa_state_for(bytecode, dfa, parked_threads);
+            if (!next_state.has_value())
+                return give_up();
+            next_state_id = *next_state;
+
+            // A flush frees the state we came from, along with all of its transitions.
+            if (dfa.flushes == flushes) {
+                if (use_ascii_transitions)
+                    state.ascii_transitions[code_point] = next_state_id;
+                else
+                    state.transitions.set(transition_key, next_state_id);
+            }
+        }
+
+        state_id = next_state_id;
+        position_in_code_units = next_position_in_code_units;
+        ++position;
+    }
+}
+
+Automaton::SearchResult Automaton::run_pike_vm(ByteCode const& bytecode, MatchInput const& input, MatchState& state, bool anchored, Function<bool(size_t)> const& can_start_at, size_t& match_start, size_t& operations)
+{
+    struct Thread {
+        MatchState state;
+        size_t start { 0 };
+    };
+
+    auto const& view = input.view;
+    auto length = view.length();
+    auto position = state.string_position;
+    auto position_in_code_units = state.string_position_in_code_units;
+
+    Vector<Thread> threads;
+    Vector<Thread> next_threads;
+    Vector<MatchState> parked_threads;
+    HashTable<u64> visited;
+    Optional<Thread> match;
+    bool may_start_more = true;
+
+    for (;;) {
+        // Threads that start here are only tried once all of those that started earlier have failed.
+        if (may_start_more && can_start_at(position)) {
+            auto thread = state;
+            thread.string_position = position;
+            thread.string_position_in_code_units = position_in_code_units;
+            thread.instruction_position = 0;
+            thread.repetition_marks.clear();
+            thread.checkpoints.clear();
+            threads.append({ move(thread), position });
+        }
+        if (anchored)
+            may_start_more = false;
+
+        visited.clear_with_capacity();
+        for (auto& thread : threads) {
+            // Threads that compared a whole string at once wait here for the others to catch up.
+            if (thread.state.string_position > position) {
+                next_threads.append(move(thread));
+                continue;
+            }
+
+            parked_threads.clear_with_capacity();
+            follow_epsilon_transitions(bytecode, input, move(thread.state), Captures::Keep, visited, parked_threads, operations);
+
+            bool matched = false;
+            for (auto& parked_thread : parked_threads) {
+                auto& opcode = bytecode.get_opcode(parked_thread);
+                if (opcode.opcode_id() != OpCodeId::Compare) {
+                    match = Thread { move(parked_thread), thread.start };
+                    matched = true;
+                    break;
+                }
+
+                auto size = opcode.size();
+                ++operations;
+                if (opcode.execute(input, parked_thread) != ExecutionResult::Continue)
+                    continue;
+                // A comparison that matched without consuming anything would have to be followed at this position.
+                if (parked_thread.string_position == position)
+                    return SearchResult::GaveUp;
+                parked_thread.instruction_position += size;
+                next_threads.append({ move(parked_thread), thread.start });
+            }
+
+            // The backtracking matcher would only have tried the threads after a match if it had failed.
+            if (matched) {
+                may_start_more = false;
+                break;
+            }
+        }
+
+        swap(threads, next_threads);
+        next_threads.clear_with_capacity();
+        if (position >= length || (threads.is_empty() && !may_start_more))
+            break;
+
+        position_in_code_units += view.unicode() ? view.length_of_code_point(view.code_point_at(position_in_code_units)) : 1;
+        ++position;
+    }
+
+    if (!match.has_value())
+        return SearchResult::NoMatch;
+
+    match_start = match->start;
+    state = move(match->state);
+    return SearchResult::Match;
+}
+
+}
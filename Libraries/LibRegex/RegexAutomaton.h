@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+
+#include <AK/Array.h>
+#include <AK/COWVector.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// Matches bytecode without backreferences or lookarounds in time linear in the length of the input, instead of by
+// backtracking.
+//
+// A lazily built DFA first works out whether there is a match at all, which is all that's needed for most inputs when
+// searching for something rare. If there is one, a Pike VM runs every thread the backtracking matcher would try in
+// lockstep, ordered by the priority the backtracking matcher would try them in, so it finds the same match with the
+// same captures. Both run the bytecode's own opcodes, on one MatchState per thread.
+class REGEX_API Automaton {
+public:
+    // Returns null if the bytecode needs the backtracking matcher.
+    static OwnPtr<Automaton> try_create(ByteCode const&);
+
+    enum class SearchResult : u8 {
+        Match,
+        NoMatch,
+        GaveUp,
+    };
+
+    // Finds the match the backtracking matcher would find when trying the start positions from `state`'s string
+    // position onwards that pass `can_start_at` one by one, or only the first one if `anchored` is set. On a match,
+    // `state` is left as the backtracking matcher would leave it and `match_start` is set. If the bytecode turns out
+    // to need backtracking after all, this gives up and leaves `state` untouched.
+    SearchResult search(ByteCode const&, MatchInput const&, MatchState& state, bool anchored, Function<bool(size_t)> const& can_start_at, size_t& match_start, size_t& operations);
+
+private:
+    Automaton(bool has_word_boundaries, bool has_line_assertions)
+        : m_has_word_boundaries(has_word_boundaries)
+        , m_has_line_assertions(has_line_assertions)
+    {
+    }
+
+    static constexpr size_t max_dfa_states = 2048;
+    static constexpr size_t max_dfa_cache_flushes = 8;
+    static constexpr u32 unknown_transition = NumericLimits<u32>::max();
+
+    struct DFAThread {
+        size_t instruction_position { 0 };
+        COWVector<u64> repetition_marks;
+        Vector<u64> set_checkpoints;
+        u64 hash { 0 };
+    };
+
+    struct DFAState {
+        Vector<DFAThread> threads;
+        bool is_match { false };
+        // Transitions on ASCII code points not followed by anything the bytecode asserts on; all others are hashed.
+        Array<u32, 128> ascii_transitions;
+        HashMap<u64, u32> transitions;
+    };
+
+    struct DFA {
+        Optional<u64> options;
+        Vector<NonnullOwnPtr<DFAState>> states;
+        HashMap<u64, u32> state_ids;
+        size_t flushes { 0 };
+    };
+
+    SearchResult run_dfa(ByteCode const&, MatchInput const&, MatchState const&, bool anchored, size_t& operations);
+    SearchResult run_pike_vm(ByteCode const&, MatchInput const&, MatchState&, bool anchored, Function<bool(size_t)> const& can_start_at, size_t& match_start, size_t& operations);
+
+    Optional<u32> dfa_state_for(ByteCode const&, DFA&, Vector<MatchState>& parked_threads);
+    u8 context_at(MatchInput const&, size_t position, size_t position_in_code_units) const;
+
+    bool m_has_word_boundaries { false };
+    bool m_has_line_assertions { false };
+    bool m_dfa_disabled { false };
+    DFA m_dfas[2];
+};
+
+}
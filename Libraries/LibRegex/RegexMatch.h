@@ -9,6 +9,7 @@
 #include "Forward.h"
 #include "RegexOptions.h"
 
+#include <AK/AnyOf.h>
 #include <AK/ByteString.h>
 #include <AK/COWVector.h>
 #include <AK/Error.h>
@@ -16,6 +17,7 @@
 #include <AK/MemMem.h>
 #include <AK/StringBuilder.h>
 #include <AK/StringView.h>
+#include <AK/UnicodeUtils.h>
 #include <AK/Utf16String.h>
 #include <AK/Utf16View.h>
 #include <AK/Utf32View.h>
@@ -288,6 +290,58 @@ public:
             [](auto&) -> bool { TODO(); });
     }
 
+    // Returns the code unit offset of the first occurrence of the code points at or after the given code unit offset,
+    // with the code points compared the way the Compare opcode compares them. Candidates are found by looking for the
+    // first code unit with a vectorized search, which makes this fast enough to skip ahead through large inputs.
+    Optional<size_t> find_code_points(ReadonlySpan<u32> code_points, size_t code_unit_offset) const
+    {
+        Vector<u32, 32> code_units;
+        if (!unicode()) {
+            code_units.append(code_points.data(), code_points.size());
+        } else {
+            for (auto code_point : code_points) {
+                m_view.visit(
+                    [&](StringView) { (void)AK::UnicodeUtils::code_point_to_utf8(code_point, [&](char unit) { code_units.append(static_cast<u8>(unit)); }); },
+                    [&](Utf16View const&) { (void)AK::UnicodeUtils::code_point_to_utf16(code_point, [&](char16_t unit) { code_units.append(unit); }); });
+            }
+        }
+
+        if (code_units.is_empty())
+            return code_unit_offset;
+
+        return m_view.visit(
+            [&](StringView view) -> Optional<size_t> {
+                if (any_of(code_units, [](auto unit) { return unit > 0xff; }))
+                    return {};
+                auto first = static_cast<char>(code_units.first());
+                for (auto offset = view.find(first, code_unit_offset); offset.has_value(); offset = view.find(first, *offset + 1)) {
+                    if (*offset + code_units.size() > view.length())
+                        return {};
+                    auto matches = true;
+                    for (size_t i = 1; matches && i < code_units.size(); ++i)
+                        matches = static_cast<u8>(view[*offset + i]) == code_units[i];
+                    if (matches)
+                        return offset;
+                }
+                return {};
+            },
+            [&](Utf16View const& view) -> Optional<size_t> {
+                if (any_of(code_units, [](auto unit) { return unit > 0xffff; }))
+                    return {};
+                auto first = static_cast<char16_t>(code_units.first());
+                for (auto offset = view.find_code_unit_offset(first, code_unit_offset); offset.has_value(); offset = view.find_code_unit_offset(first, *offset + 1)) {
+                    if (*offset + code_units.size() > view.length_in_code_units())
+                        return {};
+                    auto matches = true;
+                    for (size_t i = 1; matches && i < code_units.size(); ++i)
+                        matches = view.code_unit_at(*offset + i) == code_units[i];
+                    if (matches)
+                        return offset;
+                }
+                return {};
+            });
+    }
+
     bool starts_with(StringView str) const
     {
         return m_view.visit(
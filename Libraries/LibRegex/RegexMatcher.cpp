@@ -47,6 +47,9 @@ static OrderedHashMap<CacheKey<Parser>, regex::Parser::Result> s_parser_cache;
 template<class Parser>
 static size_t s_cached_bytecode_size = 0;
 
+template<class Parser>
+static typename Regex<Parser>::CacheStatistics s_cache_statistics;
+
 static constexpr auto MaxRegexCachedBytecodeSize = 1 * MiB;
 
 template<class Parser>
@@ -63,12 +66,33 @@ static void cache_parse_result(regex::Parser::Result const& result, CacheKey<Par
     s_cached_bytecode_size<Parser> += bytecode_size;
 }
 
+template<class Parser>
+static Optional<regex::Parser::Result> cached_parse_result(CacheKey<Parser> const& key)
+{
+    auto result = s_parser_cache<Parser>.take(key);
+    if (!result.has_value()) {
+        ++s_cache_statistics<Parser>.misses;
+        return {};
+    }
+
+    // Move the entry to the back, so that the least recently used entries are evicted first.
+    s_parser_cache<Parser>.set(key, *result);
+    ++s_cache_statistics<Parser>.hits;
+    return result;
+}
+
+template<class Parser>
+typename Regex<Parser>::CacheStatistics Regex<Parser>::cache_statistics()
+{
+    return s_cache_statistics<Parser>;
+}
+
 template<class Parser>
 Regex<Parser>::Regex(ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options)
     : pattern_value(move(pattern))
 {
-    if (auto cache_entry = s_parser_cache<Parser>.get({ pattern_value, regex_options }); cache_entry.has_value()) {
-        parser_result = cache_entry.value();
+    if (auto cache_entry = cached_parse_result<Parser>({ pattern_value, regex_options }); cache_entry.has_value()) {
+        parser_result = cache_entry.release_value();
     } else {
         regex::Lexer lexer(pattern_value);
 
@@ -91,8 +115,18 @@ Regex<Parser>::Regex(regex::Parser::Result parse_result, ByteString pattern, typ
     : pattern_value(move(pattern))
     , parser_result(move(parse_result))
 {
-    parser_result.bytecode.flatten();
-    run_optimization_passes();
+    // The same pattern is usually parsed the same way every time (e.g. a regex literal evaluated in a loop), so the
+    // optimized bytecode from the last time can be reused.
+    if (auto cache_entry = cached_parse_result<Parser>({ pattern_value, regex_options }); cache_entry.has_value()) {
+        parser_result = cache_entry.release_value();
+    } else {
+        parser_result.bytecode.flatten();
+        run_optimization_passes();
+
+        if (parser_result.error == regex::Error::NoError)
+            cache_parse_result<Parser>(parser_result, { pattern_value, regex_options });
+    }
+
     if (parser_result.error == regex::Error::NoError)
         matcher = make<Matcher<Parser>>(this, regex_options | static_cast<decltype(regex_options.value())>(parser_result.options.value()));
 }
@@ -279,7 +313,53 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             }
         }
 
-        for (; view_index <= view_length; ++view_index) {
+        auto const match_length_minimum = m_pattern->parser_result.match_length_minimum;
+
+        // Skip ahead to where the literal every match starts with (or contains) occurs. Positions are only code unit
+        // offsets if the view isn't unicode-aware, otherwise this only checks whether the view can match at all.
+        auto const& literal_prefix = m_pattern->parser_result.optimization_data.literal_prefix;
+        auto const& required_literal = m_pattern->parser_result.optimization_data.required_literal;
+        auto const& literal = literal_prefix.is_empty() ? required_literal : literal_prefix;
+        auto const use_literal = !literal.is_empty() && !input.regex_options.has_flag_set(AllFlags::Insensitive);
+        auto const skip_to_literal_prefix = use_literal && !literal_prefix.is_empty() && !view.unicode();
+        auto const can_match_in_view = !use_literal || view.find_code_points(literal, state.string_position_in_code_units).has_value();
+
+        // The last search result stays valid for positions from where it was searched from up to where it was found.
+        Optional<size_t> next_literal_prefix;
+        size_t literal_prefix_searched_from = NumericLimits<size_t>::max();
+        auto find_literal_prefix = [&](size_t view_index) {
+            if (view_index < literal_prefix_searched_from || (next_literal_prefix.has_value() && *next_literal_prefix < view_index)) {
+                next_literal_prefix = view.find_code_points(literal_prefix, view_index);
+                literal_prefix_searched_from = view_index;
+            }
+            return next_literal_prefix;
+        };
+        auto matches_starting_ranges = [&](size_t view_index) {
+            auto const& starting_ranges = m_pattern->parser_result.optimization_data.starting_ranges;
+            if (starting_ranges.is_empty())
+                return true;
+            if (view_index >= view_length)
+                return false;
+
+            auto const insensitive = input.regex_options.has_flag_set(AllFlags::Insensitive);
+            auto ranges = insensitive ? m_pattern->parser_result.optimization_data.starting_ranges_insensitive.span() : starting_ranges.span();
+            auto ch = input.view.unicode_aware_code_point_at(view_index);
+            if (insensitive)
+                ch = to_ascii_lowercase(ch);
+
+            return binary_search(ranges, ch, nullptr, compare_range) != nullptr;
+        };
+        Function<bool(size_t)> can_start_at = [&](size_t view_index) {
+            if (view_index == view_length && input.regex_options.has_flag_set(AllFlags::Multiline))
+                return false;
+            if (match_length_minimum && match_length_minimum > view_length - view_index)
+                return false;
+            if (skip_to_literal_prefix && find_literal_prefix(view_index) != view_index)
+                return false;
+            return matches_starting_ranges(view_index);
+        };
+
+        for (; can_match_in_view && view_index <= view_length; ++view_index) {
             if (view_index == view_length) {
                 if (input.regex_options.has_flag_set(AllFlags::Multiline))
                     break;
@@ -291,37 +371,63 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             //        the remaining string length from the current path. The value though
             //        has to be filled in reverse. That implies a second run over bytecode
             //        after generation has finished.
-            auto const match_length_minimum = m_pattern->parser_result.match_length_minimum;
             if (match_length_minimum && match_length_minimum > view_length - view_index)
                 break;
 
-            auto const insensitive = input.regex_options.has_flag_set(AllFlags::Insensitive);
-            if (auto& starting_ranges = m_pattern->parser_result.optimization_data.starting_ranges; !starting_ranges.is_empty()) {
-                auto ranges = insensitive ? m_pattern->parser_result.optimization_data.starting_ranges_insensitive.span() : starting_ranges.span();
-                auto ch = input.view.unicode_aware_code_point_at(view_index);
-                if (insensitive)
-                    ch = to_ascii_lowercase(ch);
-
-                if (!binary_search(ranges, ch, nullptr, compare_range))
-                    goto done_matching;
+            if (skip_to_literal_prefix) {
+                auto literal_prefix_index = find_literal_prefix(view_index);
+                if (!literal_prefix_index.has_value())
+                    break;
+                if (*literal_prefix_index != view_index) {
+                    if (!continue_search || only_start_of_line)
+                        break;
+                    view_index = *literal_prefix_index;
+                }
             }
 
             input.column = match_count;
             input.match_index = match_count;
 
-            state.string_position = view_index;
-            if (input.view.unicode()) {
-                if (view_index < view_length)
-                    state.string_position_in_code_units = input.view.code_unit_offset_of(view_index);
-                else
-                    state.string_position_in_code_units = input.view.length_in_code_units();
-            } else {
-                state.string_position_in_code_units = view_index;
+            auto set_string_position = [&] {
+                state.string_position = view_index;
+                if (input.view.unicode()) {
+                    if (view_index < view_length)
+                        state.string_position_in_code_units = input.view.code_unit_offset_of(view_index);
+                    else
+                        state.string_position_in_code_units = input.view.length_in_code_units();
+                } else {
+                    state.string_position_in_code_units = view_index;
+                }
+            };
+
+            // The automaton looks for the match at all the remaining start positions at once, and finds the same one
+            // that trying them one by one with the backtracking matcher below would.
+            bool matched = false;
+            auto automaton_result = Automaton::SearchResult::GaveUp;
+            if (m_automaton) {
+                set_string_position();
+                size_t match_start = view_index;
+                auto anchored = !continue_search || only_start_of_line;
+                automaton_result = m_automaton->search(m_pattern->parser_result.bytecode, input, state, anchored, can_start_at, match_start, operations);
+                if (automaton_result == Automaton::SearchResult::NoMatch)
+                    break;
+                if (automaton_result == Automaton::SearchResult::Match) {
+                    view_index = match_start;
+                    matched = true;
+                }
+            }
+
+            if (automaton_result == Automaton::SearchResult::GaveUp) {
+                if (!matches_starting_ranges(view_index))
+                    goto done_matching;
+
+                set_string_position();
+                state.instruction_position = 0;
+                state.repetition_marks.clear();
+                matched = execute(input, state, operations);
             }
-            state.instruction_position = 0;
-            state.repetition_marks.clear();
 
-            if (execute(input, state, operations)) {
+            if (matched) {
                 succeeded = true;
 
                 if (input.regex_options.has_flag_set(AllFlags::MatchNotEndOfLine) && state.string_position == input.view.length()) {
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "RegexAutomaton.h"
 #include "RegexByteCode.h"
 #include "RegexMatch.h"
 #include "RegexOptions.h"
@@ -53,6 +54,7 @@ public:
     Matcher(Regex<Parser> const* pattern, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {})
         : m_pattern(pattern)
         , m_regex_options(regex_options.value_or({}))
+        , m_automaton(Automaton::try_create(pattern->parser_result.bytecode))
     {
     }
     ~Matcher() = default;
@@ -75,6 +77,9 @@ private:
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+
+    // Used instead of backtracking whenever the pattern allows it.
+    OwnPtr<Automaton> m_automaton;
 };
 
 template<class Parser>
@@ -93,6 +98,13 @@ public:
     Regex(Regex&&);
     Regex& operator=(Regex&&);
 
+    // Compiled patterns are cached by pattern and options, and evicted least recently used first.
+    struct CacheStatistics {
+        size_t hits { 0 };
+        size_t misses { 0 };
+    };
+    static CacheStatistics cache_statistics();
+
     typename ParserTraits<Parser>::OptionsType options() const;
     ByteString error_string(Optional<ByteString> message = {}) const;
 
@@ -232,6 +244,7 @@ private:
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
     bool attempt_rewrite_entire_match_as_substring_search(BasicBlockList const&);
     void fill_optimization_data(BasicBlockList const&);
+    void fill_literal_optimization_data();
 };
 
 // free standing functions for match, search and has_match
@@ -31,14 +31,17 @@ void Regex<Parser>::run_optimization_passes()
     rewrite_with_useless_jumps_removed();
 
     auto blocks = split_basic_blocks(parser_result.bytecode);
-    if (attempt_rewrite_entire_match_as_substring_search(blocks))
+    if (attempt_rewrite_entire_match_as_substring_search(blocks)) {
+        fill_literal_optimization_data();
         return;
+    }
 
     // Rewrite fork loops as atomic groups
     // e.g. a*b -> (ATOMIC a*)b
     attempt_rewrite_loops_as_atomic_groups(blocks);
 
     fill_optimization_data(split_basic_blocks(parser_result.bytecode));
+    fill_literal_optimization_data();
 
     parser_result.bytecode.flatten();
 }
@@ -247,6 +250,113 @@ void Regex<Parser>::fill_optimization_data(BasicBlockList const& blocks)
     }
 }
 
+template<class Parser>
+void Regex<Parser>::fill_literal_optimization_data()
+{
+    auto& bytecode = parser_result.bytecode;
+    auto bytecode_size = bytecode.size();
+
+    // An instruction is executed by every match unless some jump or fork can skip ahead over it: jumping back only
+    // ever repeats instructions that were already executed on the way there. So first, find the skippable ranges.
+    Vector<i32> skips_starting_at;
+    skips_starting_at.resize(bytecode_size + 1);
+
+    auto state = MatchState::only_for_enumeration();
+    for (state.instruction_position = 0; state.instruction_position < bytecode_size;) {
+        auto& opcode = bytecode.get_opcode(state);
+        auto next_ip = state.instruction_position + opcode.size();
+        Optional<size_t> target;
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Jump:
+            target = next_ip + static_cast<OpCode_Jump const&>(opcode).offset();
+            break;
+        case OpCodeId::JumpNonEmpty:
+            target = next_ip + static_cast<OpCode_JumpNonEmpty const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            target = next_ip + static_cast<OpCode_ForkJump const&>(opcode).offset();
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            target = next_ip + static_cast<OpCode_ForkStay const&>(opcode).offset();
+            break;
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+        case OpCodeId::PopSaved:
+            // Lookarounds match input outside of the match (or not at all), so don't bother.
+            return;
+        default:
+            break;
+        }
+        if (target.has_value() && *target > next_ip) {
+            ++skips_starting_at[next_ip];
+            --skips_starting_at[min(*target, bytecode_size)];
+        }
+        state.instruction_position = next_ip;
+    }
+
+    // Then, collect the runs of single character compares that are always executed one after the other. The first one
+    // is the prefix of every match if nothing can come before it.
+    Vector<u32> literal_prefix;
+    Vector<u32> longest_literal;
+    Vector<u32> current_literal;
+    bool at_start = true;
+    i32 skips = 0;
+
+    auto end_literal = [&] {
+        if (at_start && !current_literal.is_empty())
+            literal_prefix = current_literal;
+        if (current_literal.size() > longest_literal.size())
+            longest_literal = current_literal;
+        current_literal.clear_with_capacity();
+        at_start = false;
+    };
+
+    for (state.instruction_position = 0; state.instruction_position < bytecode_size;) {
+        auto& opcode = bytecode.get_opcode(state);
+        skips += skips_starting_at[state.instruction_position];
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto flat_compares = static_cast<OpCode_Compare const&>(opcode).flat_compares();
+            if (skips == 0 && flat_compares.size() == 1 && flat_compares.first().type == CharacterCompareType::Char)
+                current_literal.append(flat_compares.first().value);
+            else
+                end_literal();
+            break;
+        }
+        case OpCodeId::Checkpoint:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+        case OpCodeId::ResetRepeat:
+            // These do not consume anything, so look through them.
+            break;
+        default:
+            end_literal();
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+    end_literal();
+
+    if (!literal_prefix.is_empty())
+        parser_result.optimization_data.literal_prefix = move(literal_prefix);
+    else
+        parser_result.optimization_data.required_literal = move(longest_literal);
+
+    if constexpr (REGEX_DEBUG) {
+        dbgln("; - literal prefix: {}", parser_result.optimization_data.literal_prefix);
+        dbgln("; - required literal: {}", parser_result.optimization_data.required_literal);
+    }
+}
+
 template<typename Parser>
 typename Regex<Parser>::BasicBlockList Regex<Parser>::split_basic_blocks(ByteCode const& bytecode)
 {
@@ -68,6 +68,10 @@ public:
             Vector<CharRange> starting_ranges;
             Vector<CharRange> starting_ranges_insensitive;
             bool only_start_of_line = false;
+            // If populated, every match starts with these code points.
+            Vector<u32> literal_prefix;
+            // If populated, every match contains these code points somewhere. Only filled in if there's no literal prefix.
+            Vector<u32> required_literal;
         } optimization_data {};
     };
 
@@ -55,12 +55,18 @@ void Request::set_buffered_request_finished_callback(BufferedRequestFinished on_
         m_internal_buffered_data->response_headers = headers;
         m_internal_buffered_data->response_code = move(response_code);
         m_internal_buffered_data->reason_phrase = reason_phrase;
+
+        // NOTE: The payload is collected into a single buffer, which we size up front if we know how large it will be.
+        //       The length may be that of an encoded body, so this is only a hint, and we don't trust it blindly.
+        static constexpr u64 maximum_preallocated_payload_size = 64 * MiB;
+
+        if (auto content_length = headers.get("Content-Length"sv); content_length.has_value()) {
+            if (auto length = content_length->to_number<u64>(); length.has_value())
+                (void)m_internal_buffered_data->payload.try_ensure_capacity(min(*length, maximum_preallocated_payload_size));
+        }
     };
 
     on_finish = [this, on_buffered_request_finished = move(on_buffered_request_finished)](auto total_size, auto& timing_info, auto network_error) {
-        auto output_buffer = ByteBuffer::create_uninitialized(m_internal_buffered_data->payload_stream.used_buffer_size()).release_value_but_fixme_should_propagate_errors();
-        m_internal_buffered_data->payload_stream.read_until_filled(output_buffer).release_value_but_fixme_should_propagate_errors();
-
         on_buffered_request_finished(
             total_size,
             timing_info,
@@ -68,12 +74,12 @@ void Request::set_buffered_request_finished_callback(BufferedRequestFinished on_
             m_internal_buffered_data->response_headers,
             m_internal_buffered_data->response_code,
             m_internal_buffered_data->reason_phrase,
-            output_buffer);
+            m_internal_buffered_data->payload);
     };
 
     set_up_internal_stream_data([this](auto read_bytes) {
         // FIXME: What do we do if this fails?
-        m_internal_buffered_data->payload_stream.write_until_depleted(read_bytes).release_value_but_fixme_should_propagate_errors();
+        m_internal_buffered_data->payload.try_append(read_bytes).release_value_but_fixme_should_propagate_errors();
     });
 }
 
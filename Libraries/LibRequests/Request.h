@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Badge.h>
+#include <AK/ByteBuffer.h>
 #include <AK/ByteString.h>
 #include <AK/Function.h>
 #include <AK/MemoryStream.h>
@@ -81,7 +82,7 @@ private:
     RequestFinished on_finish;
 
     struct InternalBufferedData {
-        AllocatingMemoryStream payload_stream;
+        ByteBuffer payload;
         HTTP::HeaderMap response_headers;
         Optional<u32> response_code;
         Optional<String> reason_phrase;
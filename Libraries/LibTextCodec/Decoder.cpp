@@ -336,6 +336,9 @@ StringView get_output_encoding(StringView encoding)
 
 bool Decoder::validate(StringView input)
 {
+    if (is_ascii_compatible())
+        input = input.substring_view(input.count_leading_ascii_characters());
+
     auto result = this->process(input, [](auto code_point) -> ErrorOr<void> {
         if (code_point == replacement_code_point)
             return Error::from_errno(EINVAL);
@@ -348,10 +351,44 @@ bool Decoder::validate(StringView input)
 ErrorOr<String> Decoder::to_utf8(StringView input)
 {
     StringBuilder builder(input.length());
+
+    // The decoder only has to look at the input from its first non-ASCII byte onwards, as everything before that decodes
+    // to itself.
+    if (is_ascii_compatible()) {
+        auto ascii_length = input.count_leading_ascii_characters();
+        TRY(builder.try_append(input.substring_view(0, ascii_length)));
+        input = input.substring_view(ascii_length);
+    }
+
     TRY(process(input, [&builder](u32 c) { return builder.try_append_code_point(c); }));
     return builder.to_string_without_validation();
 }
 
+// Decodes the input of a decoder that decodes every byte on its own, and ASCII bytes to themselves. Runs of ASCII bytes
+// are copied over in bulk, which makes up most of the input for the encodings that use these decoders.
+template<typename Callback>
+static ErrorOr<String> decode_single_bytes_to_utf8(StringView input, Callback decode_non_ascii_byte)
+{
+    StringBuilder builder(input.length());
+
+    while (!input.is_empty()) {
+        auto ascii_length = input.count_leading_ascii_characters();
+        TRY(builder.try_append(input.substring_view(0, ascii_length)));
+        input = input.substring_view(ascii_length);
+
+        size_t non_ascii_length = 0;
+        for (; non_ascii_length < input.length(); ++non_ascii_length) {
+            u8 const byte = input[non_ascii_length];
+            if (byte < 0x80)
+                break;
+            TRY(builder.try_append_code_point(decode_non_ascii_byte(byte)));
+        }
+        input = input.substring_view(non_ascii_length);
+    }
+
+    return builder.to_string_without_validation();
+}
+
 ErrorOr<void> UTF8Decoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
 {
     for (auto c : Utf8View(input)) {
@@ -408,6 +445,11 @@ ErrorOr<void> Latin1Decoder::process(StringView input, Function<ErrorOr<void>(u3
     return {};
 }
 
+ErrorOr<String> Latin1Decoder::to_utf8(StringView input)
+{
+    return decode_single_bytes_to_utf8(input, [](u8 byte) -> u32 { return byte; });
+}
+
 ErrorOr<void> PDFDocEncodingDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
 {
     // PDF 1.7 spec, Appendix D.2 "PDFDocEncoding Character Set"
@@ -479,6 +521,11 @@ ErrorOr<void> XUserDefinedDecoder::process(StringView input, Function<ErrorOr<vo
     return {};
 }
 
+ErrorOr<String> XUserDefinedDecoder::to_utf8(StringView input)
+{
+    return decode_single_bytes_to_utf8(input, [](u8 byte) -> u32 { return 0xF780 + byte - 0x80; });
+}
+
 // https://encoding.spec.whatwg.org/#single-byte-decoder
 template<Integral ArrayType>
 ErrorOr<void> SingleByteDecoder<ArrayType>::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
@@ -502,6 +549,12 @@ ErrorOr<void> SingleByteDecoder<ArrayType>::process(StringView input, Function<E
     return {};
 }
 
+template<Integral ArrayType>
+ErrorOr<String> SingleByteDecoder<ArrayType>::to_utf8(StringView input)
+{
+    return decode_single_bytes_to_utf8(input, [this](u8 byte) -> u32 { return m_translation_table[byte - 0x80]; });
+}
+
 // https://encoding.spec.whatwg.org/#index-gb18030-ranges-code-point
 static Optional<u32> index_gb18030_ranges_code_point(u32 pointer)
 {
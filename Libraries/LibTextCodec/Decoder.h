@@ -24,6 +24,9 @@ public:
 protected:
     virtual ~Decoder() = default;
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) = 0;
+
+    // Whether the decoder decodes ASCII bytes to the same code points while in its initial state, without leaving it.
+    virtual bool is_ascii_compatible() const { return false; }
 };
 
 class TEXTCODEC_API UTF8Decoder final : public Decoder {
@@ -60,8 +63,11 @@ public:
     }
 
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+    virtual ErrorOr<String> to_utf8(StringView) override;
 
 private:
+    virtual bool is_ascii_compatible() const override { return true; }
+
     Array<ArrayType, 128> m_translation_table;
 };
 
@@ -69,6 +75,7 @@ class TEXTCODEC_API Latin1Decoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
     virtual bool validate(StringView) override { return true; }
+    virtual ErrorOr<String> to_utf8(StringView) override;
 };
 
 class TEXTCODEC_API PDFDocEncodingDecoder final : public Decoder {
@@ -81,21 +88,31 @@ class TEXTCODEC_API XUserDefinedDecoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
     virtual bool validate(StringView) override { return true; }
+    virtual ErrorOr<String> to_utf8(StringView) override;
 };
 
 class TEXTCODEC_API GB18030Decoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+
+private:
+    virtual bool is_ascii_compatible() const override { return true; }
 };
 
 class TEXTCODEC_API Big5Decoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+
+private:
+    virtual bool is_ascii_compatible() const override { return true; }
 };
 
 class TEXTCODEC_API EUCJPDecoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+
+private:
+    virtual bool is_ascii_compatible() const override { return true; }
 };
 
 class TEXTCODEC_API ISO2022JPDecoder final : public Decoder {
@@ -106,11 +123,17 @@ public:
 class TEXTCODEC_API ShiftJISDecoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+
+private:
+    virtual bool is_ascii_compatible() const override { return true; }
 };
 
 class TEXTCODEC_API EUCKRDecoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+
+private:
+    virtual bool is_ascii_compatible() const override { return true; }
 };
 
 class TEXTCODEC_API ReplacementDecoder final : public Decoder {
@@ -17,6 +17,7 @@
 #include <LibCore/EventReceiver.h>
 #include <LibCore/Promise.h>
 #include <LibThreading/Forward.h>
+#include <LibThreading/ThreadPool.h>
 
 namespace Threading {
 
@@ -30,8 +31,7 @@ class BackgroundActionBase {
 private:
     BackgroundActionBase() = default;
 
-    static void enqueue_work(ESCAPING Function<void()>);
-    static Thread& background_thread();
+    static void enqueue_work(ESCAPING Function<void()>, TaskPriority);
 };
 
 template<typename Result>
@@ -55,7 +55,9 @@ public:
     bool is_canceled() const { return m_canceled; }
 
 private:
-    BackgroundAction(ESCAPING Function<ErrorOr<Result>(BackgroundAction&)> action, ESCAPING Function<ErrorOr<void>(Result)> on_complete, ESCAPING Optional<Function<void(Error)>> on_error = {})
+    // NOTE: Actions run on the global thread pool, so they may run concurrently with, and in a different order than,
+    //       other actions.
+    BackgroundAction(ESCAPING Function<ErrorOr<Result>(BackgroundAction&)> action, ESCAPING Function<ErrorOr<void>(Result)> on_complete, ESCAPING Optional<Function<void(Error)>> on_error = {}, TaskPriority priority = TaskPriority::Default)
         : m_action(move(action))
         , m_on_complete(move(on_complete))
     {
@@ -76,42 +78,44 @@ private:
         if (on_error.has_value())
             m_on_error = on_error.release_value();
 
-        enqueue_work([self = NonnullRefPtr(*this), promise = move(promise), origin_event_loop = &Core::EventLoop::current()]() mutable {
-            auto result = self->m_action(*self);
-
-            // The event loop cancels the promise when it exits.
-            self->m_canceled |= promise->is_rejected();
-
-            // All of our work was successful and we weren't cancelled; resolve the event loop's promise.
-            if (!self->m_canceled && !result.is_error()) {
-                self->m_result = result.release_value();
-
-                // If there is no completion callback, we don't rely on the user keeping around the event loop.
-                if (self->m_on_complete) {
-                    origin_event_loop->deferred_invoke([self, promise = move(promise)] {
-                        // Our promise's resolution function will never error.
-                        (void)promise->resolve(*self);
-                    });
-                    origin_event_loop->wake();
-                }
-            } else {
-                // We were either unsuccessful or cancelled (in which case there is no error).
-                auto error = Error::from_errno(ECANCELED);
-                if (result.is_error())
-                    error = result.release_error();
-
-                promise->reject(Error::from_errno(ECANCELED));
-
-                if (!self->m_canceled && self->m_on_error) {
-                    origin_event_loop->deferred_invoke([self, error = move(error)]() mutable {
+        enqueue_work(
+            [self = NonnullRefPtr(*this), promise = move(promise), origin_event_loop = &Core::EventLoop::current()]() mutable {
+                auto result = self->m_action(*self);
+
+                // The event loop cancels the promise when it exits.
+                self->m_canceled |= promise->is_rejected();
+
+                // All of our work was successful and we weren't cancelled; resolve the event loop's promise.
+                if (!self->m_canceled && !result.is_error()) {
+                    self->m_result = result.release_value();
+
+                    // If there is no completion callback, we don't rely on the user keeping around the event loop.
+                    if (self->m_on_complete) {
+                        origin_event_loop->deferred_invoke([self, promise = move(promise)] {
+                            // Our promise's resolution function will never error.
+                            (void)promise->resolve(*self);
+                        });
+                        origin_event_loop->wake();
+                    }
+                } else {
+                    // We were either unsuccessful or cancelled (in which case there is no error).
+                    auto error = Error::from_errno(ECANCELED);
+                    if (result.is_error())
+                        error = result.release_error();
+
+                    promise->reject(Error::from_errno(ECANCELED));
+
+                    if (!self->m_canceled && self->m_on_error) {
+                        origin_event_loop->deferred_invoke([self, error = move(error)]() mutable {
+                            self->m_on_error(move(error));
+                        });
+                        origin_event_loop->wake();
+                    } else if (self->m_on_error) {
                         self->m_on_error(move(error));
-                    });
-                    origin_event_loop->wake();
-                } else if (self->m_on_error) {
-                    self->m_on_error(move(error));
+                    }
                 }
-            }
-        });
+            },
+            priority);
     }
 
     Function<ErrorOr<Result>(BackgroundAction&)> m_action;
@@ -123,6 +127,7 @@ private:
     bool m_canceled { false };
 };
 
+// Stops the threads that background actions run on. Actions that have not been started yet are dropped.
 void quit_background_thread();
 
 }
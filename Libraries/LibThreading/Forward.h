@@ -8,7 +8,9 @@
 
 namespace Threading {
 
+class ForkJoinScope;
 class Thread;
+class ThreadPool;
 
 template<typename ErrorType>
 class WorkerThread;
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/Queue.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Parallel.h>
+
+namespace Threading {
+
+namespace Detail {
+
+// NOTE: Helpers may only start running after all tasks have been taken. The state is reference counted so that they
+//       can still find that out, but the task itself may not be used once the caller has returned.
+struct ParallelTasks : public AtomicRefCounted<ParallelTasks> {
+    ParallelTasks(size_t task_count, Function<void(size_t)> const& task)
+        : task_count(task_count)
+        , task(&task)
+    {
+    }
+
+    bool run_next_task()
+    {
+        auto task_index = next_task_index.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        if (task_index >= task_count)
+            return false;
+
+        (*task)(task_index);
+
+        if (finished_task_count.fetch_add(1, AK::MemoryOrder::memory_order_acq_rel) + 1 == task_count) {
+            MutexLocker locker { mutex };
+            all_tasks_finished.broadcast();
+        }
+
+        return true;
+    }
+
+    void wait_for_all_tasks()
+    {
+        MutexLocker locker { mutex };
+        while (finished_task_count.load(AK::MemoryOrder::memory_order_acquire) != task_count)
+            all_tasks_finished.wait();
+    }
+
+    size_t const task_count { 0 };
+    Function<void(size_t)> const* task { nullptr };
+
+    Atomic<size_t> next_task_index { 0 };
+    Atomic<size_t> finished_task_count { 0 };
+
+    Mutex mutex;
+    ConditionVariable all_tasks_finished { mutex };
+};
+
+void run_in_parallel(size_t task_count, Function<void(size_t)> const& task, TaskPriority priority)
+{
+    if (task_count == 0)
+        return;
+
+    auto& pool = ThreadPool::the();
+    auto helper_count = min(task_count - 1, pool.worker_count());
+
+    if (helper_count == 0) {
+        for (size_t i = 0; i < task_count; ++i)
+            task(i);
+        return;
+    }
+
+    auto tasks = adopt_ref(*new ParallelTasks(task_count, task));
+
+    for (size_t i = 0; i < helper_count; ++i) {
+        pool.submit([tasks] {
+            while (tasks->run_next_task())
+                ;
+        },
+            priority);
+    }
+
+    while (tasks->run_next_task())
+        ;
+
+    tasks->wait_for_all_tasks();
+}
+
+}
+
+struct ForkJoinScope::State : public AtomicRefCounted<State> {
+    bool run_next_task()
+    {
+        Function<void()> task;
+        {
+            MutexLocker locker { mutex };
+            if (unstarted_tasks.is_empty())
+                return false;
+            task = unstarted_tasks.dequeue();
+        }
+
+        task();
+
+        MutexLocker locker { mutex };
+        if (--unfinished_task_count == 0)
+            all_tasks_finished.broadcast();
+        return true;
+    }
+
+    Mutex mutex;
+    ConditionVariable all_tasks_finished { mutex };
+    Queue<Function<void()>> unstarted_tasks;
+    size_t unfinished_task_count { 0 };
+};
+
+ForkJoinScope::ForkJoinScope(TaskPriority priority)
+    : m_state(adopt_ref(*new State))
+    , m_priority(priority)
+{
+}
+
+ForkJoinScope::~ForkJoinScope()
+{
+    join();
+}
+
+void ForkJoinScope::fork(Function<void()> task)
+{
+    {
+        MutexLocker locker { m_state->mutex };
+        m_state->unstarted_tasks.enqueue(move(task));
+        ++m_state->unfinished_task_count;
+    }
+
+    // NOTE: Each helper runs whichever task is next, which may not be the one it was submitted for. If the joining
+    //       thread has run all tasks by the time a helper starts, the helper does nothing.
+    ThreadPool::the().submit([state = m_state] { (void)state->run_next_task(); }, m_priority);
+}
+
+void ForkJoinScope::join()
+{
+    while (m_state->run_next_task())
+        ;
+
+    MutexLocker locker { m_state->mutex };
+    while (m_state->unfinished_task_count != 0)
+        m_state->all_tasks_finished.wait();
+}
+
+}
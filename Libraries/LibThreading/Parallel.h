@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/QuickSort.h>
+#include <AK/Span.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+#include <LibThreading/ThreadPool.h>
+
+// Data-parallel primitives on top of the thread pool. All of them may be called from any thread, including from tasks
+// that are running on the pool: the calling thread works on the tasks itself while it waits for them to finish, so it
+// never waits for tasks that nobody is running.
+
+namespace Threading {
+
+namespace Detail {
+
+// Calls task(0) through task(task_count - 1), spreading the calls over the calling thread and the thread pool. Returns
+// once all of them have returned.
+void run_in_parallel(size_t task_count, Function<void(size_t)> const& task, TaskPriority);
+
+}
+
+// Runs each forked task on the thread pool or on the joining thread, and waits for all of them in join(). Tasks may
+// refer to state on the stack of the forking thread, as the scope always joins before it goes away.
+class ForkJoinScope {
+    AK_MAKE_NONCOPYABLE(ForkJoinScope);
+    AK_MAKE_NONMOVABLE(ForkJoinScope);
+
+public:
+    explicit ForkJoinScope(TaskPriority = TaskPriority::Default);
+    ~ForkJoinScope();
+
+    void fork(ESCAPING Function<void()>);
+    void join();
+
+private:
+    struct State;
+
+    NonnullRefPtr<State> m_state;
+    TaskPriority m_priority { TaskPriority::Default };
+};
+
+// Calls callback(chunk_begin, chunk_end) for consecutive chunks of [begin, end) that are grain_size long, except for
+// the last one. Chunks may be processed concurrently and in any order.
+template<typename Callback>
+void parallel_for(size_t begin, size_t end, size_t grain_size, Callback callback, TaskPriority priority = TaskPriority::Default)
+{
+    if (begin >= end)
+        return;
+
+    grain_size = max(grain_size, 1uz);
+    auto chunk_count = ceil_div(end - begin, grain_size);
+
+    if (chunk_count == 1) {
+        callback(begin, end);
+        return;
+    }
+
+    Function<void(size_t)> const task = [&](size_t chunk) {
+        auto chunk_begin = begin + (chunk * grain_size);
+        callback(chunk_begin, min(chunk_begin + grain_size, end));
+    };
+    Detail::run_in_parallel(chunk_count, task, priority);
+}
+
+// Calls callback(chunk) for consecutive subspans of values that are grain_size long, except for the last one.
+template<typename T, typename Callback>
+void parallel_for(Span<T> values, size_t grain_size, Callback callback, TaskPriority priority = TaskPriority::Default)
+{
+    parallel_for(
+        0, values.size(), grain_size, [&](size_t chunk_begin, size_t chunk_end) {
+            callback(values.slice(chunk_begin, chunk_end - chunk_begin));
+        },
+        priority);
+}
+
+// Computes map(chunk_begin, chunk_end) for chunks of [begin, end) like parallel_for(), and folds the results together
+// with combine(), in the order of the chunks. Starts out with identity, which is also the result for an empty range.
+template<typename T, typename Map, typename Combine>
+T parallel_reduce(size_t begin, size_t end, size_t grain_size, T identity, Map map, Combine combine, TaskPriority priority = TaskPriority::Default)
+{
+    if (begin >= end)
+        return identity;
+
+    grain_size = max(grain_size, 1uz);
+    auto chunk_count = ceil_div(end - begin, grain_size);
+
+    Vector<T> results;
+    results.ensure_capacity(chunk_count);
+    for (size_t i = 0; i < chunk_count; ++i)
+        results.unchecked_append(identity);
+
+    parallel_for(
+        begin, end, grain_size, [&](size_t chunk_begin, size_t chunk_end) {
+            results[(chunk_begin - begin) / grain_size] = map(chunk_begin, chunk_end);
+        },
+        priority);
+
+    auto result = move(identity);
+    for (auto& chunk_result : results)
+        result = combine(move(result), move(chunk_result));
+    return result;
+}
+
+// Sorts values by sorting chunks of them concurrently, and then merging the sorted chunks in parallel rounds. Like
+// quick_sort(), this is not a stable sort. The values have to be default-constructible for the merge buffer.
+template<typename T, typename LessThan>
+void parallel_sort(Span<T> values, LessThan less_than, size_t grain_size = 4096, TaskPriority priority = TaskPriority::Default)
+{
+    grain_size = max(grain_size, 2uz);
+
+    if (values.size() <= grain_size) {
+        quick_sort(values.begin(), values.end(), less_than);
+        return;
+    }
+
+    parallel_for(
+        values, grain_size, [&](Span<T> chunk) {
+            quick_sort(chunk.begin(), chunk.end(), less_than);
+        },
+        priority);
+
+    Vector<T> buffer;
+    buffer.resize(values.size());
+
+    Span<T> source = values;
+    Span<T> destination = buffer.span();
+
+    for (auto width = grain_size; width < values.size(); width *= 2) {
+        parallel_for(
+            0, ceil_div(values.size(), width * 2), 1, [&](size_t pair_begin, size_t pair_end) {
+                for (auto pair = pair_begin; pair < pair_end; ++pair) {
+                    auto left = pair * width * 2;
+                    auto middle = min(left + width, values.size());
+                    auto right = min(left + (width * 2), values.size());
+
+                    auto i = left;
+                    auto j = middle;
+                    auto k = left;
+
+                    while (i < middle && j < right) {
+                        if (less_than(source[j], source[i]))
+                            destination[k++] = move(source[j++]);
+                        else
+                            destination[k++] = move(source[i++]);
+                    }
+                    while (i < middle)
+                        destination[k++] = move(source[i++]);
+                    while (j < right)
+                        destination[k++] = move(source[j++]);
+                }
+            },
+            priority);
+
+        swap(source, destination);
+    }
+
+    if (source.data() != values.data()) {
+        parallel_for(
+            0, values.size(), grain_size, [&](size_t chunk_begin, size_t chunk_end) {
+                for (auto i = chunk_begin; i < chunk_end; ++i)
+                    values[i] = move(source[i]);
+            },
+            priority);
+    }
+}
+
+}
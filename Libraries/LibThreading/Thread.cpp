@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/Trace.h>
 #include <LibThreading/Thread.h>
 
 namespace Threading {
@@ -77,6 +78,9 @@ void Thread::start()
         [](void* arg) -> void* {
             auto self = adopt_ref(*static_cast<Thread*>(arg));
 
+            if (!self->m_thread_name.is_empty())
+                Core::Trace::set_thread_name(self->m_thread_name);
+
             auto exit_code = self->m_action();
 
             auto expected = Threading::ThreadState::Running;
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/System.h>
+#include <LibThreading/Thread.h>
+#include <LibThreading/ThreadPool.h>
+
+namespace Threading {
+
+static ThreadPool* s_the;
+static pthread_mutex_t s_the_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// The index of the worker running on the current thread, if any.
+static thread_local Optional<size_t> s_current_worker_index;
+
+ThreadPool& ThreadPool::the()
+{
+    pthread_mutex_lock(&s_the_mutex);
+    if (!s_the)
+        s_the = new ThreadPool(max(Core::System::hardware_concurrency(), 1u));
+    auto& pool = *s_the;
+    pthread_mutex_unlock(&s_the_mutex);
+
+    return pool;
+}
+
+void ThreadPool::shut_down()
+{
+    pthread_mutex_lock(&s_the_mutex);
+    auto* pool = exchange(s_the, nullptr);
+    pthread_mutex_unlock(&s_the_mutex);
+
+    delete pool;
+}
+
+ThreadPool::ThreadPool(size_t worker_count)
+{
+    m_workers.ensure_capacity(worker_count);
+    for (size_t i = 0; i < worker_count; ++i)
+        m_workers.unchecked_append(make<Worker>());
+
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto& worker = *m_workers[i];
+        worker.thread = Thread::construct([this, i] { return run_worker(i); }, "Background Thread"sv);
+        worker.thread->start();
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    stop_workers();
+}
+
+void ThreadPool::stop_workers()
+{
+    m_should_run.store(false, AK::MemoryOrder::memory_order_release);
+
+    m_sleep_mutex.lock();
+    m_sleep_condition.broadcast();
+    m_sleep_mutex.unlock();
+
+    for (auto& worker : m_workers) {
+        if (worker->thread->needs_to_be_joined())
+            MUST(worker->thread->join());
+    }
+}
+
+void ThreadPool::submit(Function<void()> task, TaskPriority priority)
+{
+    // NOTE: Tasks submitted by a task stay on its worker, unless another worker runs out of tasks and steals them.
+    auto worker_index = s_current_worker_index.value_or_lazy_evaluated([&] {
+        return m_next_worker_index.fetch_add(1, AK::MemoryOrder::memory_order_relaxed) % m_workers.size();
+    });
+
+    // NOTE: The count is updated before the task can be taken, so that it never drops below the number of queued tasks.
+    //       It is also updated before taking the lock that sleeping workers check it under, so they can't miss it.
+    m_pending_task_count.fetch_add(1, AK::MemoryOrder::memory_order_release);
+
+    auto& worker = *m_workers[worker_index];
+    {
+        MutexLocker locker { worker.mutex };
+        worker.tasks[to_underlying(priority)].enqueue(move(task));
+    }
+
+    m_sleep_mutex.lock();
+    m_sleep_condition.signal();
+    m_sleep_mutex.unlock();
+}
+
+Optional<Function<void()>> ThreadPool::take_task(size_t worker_index)
+{
+    auto try_take_task = [&](Worker& worker, size_t priority) -> Optional<Function<void()>> {
+        MutexLocker locker { worker.mutex };
+
+        auto& tasks = worker.tasks[priority];
+        if (tasks.is_empty())
+            return {};
+
+        m_pending_task_count.fetch_sub(1, AK::MemoryOrder::memory_order_acq_rel);
+        return tasks.dequeue();
+    };
+
+    for (size_t priority = 0; priority < priority_count; ++priority) {
+        if (auto task = try_take_task(*m_workers[worker_index], priority); task.has_value())
+            return task;
+
+        // Steal a task of the same priority from the other workers, starting with the next one over.
+        for (size_t offset = 1; offset < m_workers.size(); ++offset) {
+            auto victim_index = (worker_index + offset) % m_workers.size();
+            if (auto task = try_take_task(*m_workers[victim_index], priority); task.has_value())
+                return task;
+        }
+    }
+
+    return {};
+}
+
+intptr_t ThreadPool::run_worker(size_t worker_index)
+{
+    s_current_worker_index = worker_index;
+
+    while (m_should_run.load(AK::MemoryOrder::memory_order_acquire)) {
+        if (auto task = take_task(worker_index); task.has_value()) {
+            (*task)();
+            continue;
+        }
+
+        m_sleep_mutex.lock();
+        while (m_pending_task_count.load(AK::MemoryOrder::memory_order_acquire) == 0 && m_should_run.load(AK::MemoryOrder::memory_order_acquire))
+            m_sleep_condition.wait();
+        m_sleep_mutex.unlock();
+    }
+
+    s_current_worker_index.clear();
+    return 0;
+}
+
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Queue.h>
+#include <AK/Vector.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Forward.h>
+#include <LibThreading/Mutex.h>
+
+namespace Threading {
+
+enum class TaskPriority : u8 {
+    // Work that something the user is waiting on depends on, e.g. decoding images that are about to be displayed.
+    UserBlocking,
+    Default,
+    // Work that nobody is waiting on, e.g. cleaning up files.
+    Background,
+};
+
+// A pool of worker threads, one per core, for running short tasks off the main thread. Each worker has its own queues
+// of tasks, one per priority. Tasks are spread over the workers as they are submitted, and workers that run out of
+// tasks steal them from the other workers. Higher priority tasks are always picked before lower priority ones.
+//
+// Tasks may run concurrently with each other, and in any order within the same priority.
+class ThreadPool {
+    AK_MAKE_NONCOPYABLE(ThreadPool);
+    AK_MAKE_NONMOVABLE(ThreadPool);
+
+public:
+    static ThreadPool& the();
+
+    // Stops the worker threads of the global pool once they are done with the tasks they are running. Tasks that have
+    // not been started yet are dropped. The pool starts new worker threads if it is used again afterwards.
+    static void shut_down();
+
+    void submit(ESCAPING Function<void()>, TaskPriority = TaskPriority::Default);
+
+    size_t worker_count() const { return m_workers.size(); }
+
+private:
+    explicit ThreadPool(size_t worker_count);
+    ~ThreadPool();
+
+    static constexpr size_t priority_count = 3;
+
+    struct Worker {
+        Mutex mutex;
+        Array<Queue<Function<void()>>, priority_count> tasks;
+        RefPtr<Thread> thread;
+    };
+
+    intptr_t run_worker(size_t worker_index);
+    Optional<Function<void()>> take_task(size_t worker_index);
+    void stop_workers();
+
+    Vector<NonnullOwnPtr<Worker>> m_workers;
+    Atomic<size_t> m_next_worker_index { 0 };
+
+    Mutex m_sleep_mutex;
+    ConditionVariable m_sleep_condition { m_sleep_mutex };
+    Atomic<size_t> m_pending_task_count { 0 };
+    Atomic<bool> m_should_run { true };
+};
+
+}
@@ -718,11 +718,145 @@ static String remove_ascii_tab_or_newline(StringView input)
     return MUST(output.to_string());
 }
 
+// Parses input if it is an ASCII URL that is already in the form the URL serializer produces, and which either has a
+// special scheme and a domain (or, for "file", an empty host) without credentials, or has an opaque path. Parsing such
+// a URL does not change any of its components, so they are taken over as they are. Returns an empty Optional for any
+// other input, even if it is a valid URL, which the state machine of the basic URL parser then has to deal with.
+static Optional<URL> parse_canonical_url(StringView input)
+{
+    auto is_canonical_code_point = [](char code_point) {
+        return code_point > ' ' && code_point < 0x7f;
+    };
+    auto is_canonical_component = [&](StringView component, PercentEncodeSet percent_encode_set) {
+        return all_of(component, [&](char code_point) {
+            return is_canonical_code_point(code_point) && !code_point_is_in_percent_encode_set(code_point, percent_encode_set);
+        });
+    };
+
+    auto scheme_length = input.find(':');
+    if (!scheme_length.has_value() || *scheme_length == 0)
+        return {};
+
+    auto scheme = input.substring_view(0, *scheme_length);
+    if (!is_ascii_lower_alpha(scheme[0]))
+        return {};
+    if (!all_of(scheme, [](char code_point) { return is_ascii_lower_alpha(code_point) || is_ascii_digit(code_point) || code_point == '+' || code_point == '-' || code_point == '.'; }))
+        return {};
+
+    auto remaining = input.substring_view(*scheme_length + 1);
+    auto end_of_path = remaining.find_any_of("?#"sv).value_or(remaining.length());
+    auto path = remaining.substring_view(0, end_of_path);
+
+    URL url;
+    url.set_scheme(String::from_utf8_without_validation(scheme.bytes()));
+
+    Vector<String> paths;
+
+    auto is_special = is_special_scheme(scheme);
+
+    if (is_special) {
+        if (!path.starts_with("//"sv))
+            return {};
+        path = path.substring_view(2);
+
+        auto end_of_authority = path.find('/').value_or(path.length());
+        auto authority = path.substring_view(0, end_of_authority);
+        path = path.substring_view(end_of_authority);
+
+        if (scheme == "file"sv) {
+            if (!authority.is_empty())
+                return {};
+            url.set_host(String {});
+        } else {
+            auto end_of_host = authority.find(':').value_or(authority.length());
+            auto host = authority.substring_view(0, end_of_host);
+
+            if (host.is_empty())
+                return {};
+            if (!all_of(host, [](char code_point) { return is_ascii_lower_alpha(code_point) || is_ascii_digit(code_point) || code_point == '-' || code_point == '.' || code_point == '_'; }))
+                return {};
+            for (auto label : host.split_view('.')) {
+                if (label.starts_with("xn--"sv))
+                    return {};
+            }
+            if (ends_in_a_number_checker(host))
+                return {};
+
+            url.set_host(String::from_utf8_without_validation(host.bytes()));
+
+            if (end_of_host != authority.length()) {
+                auto port_string = authority.substring_view(end_of_host + 1);
+                if (port_string.is_empty() || port_string.length() > 5 || port_string.starts_with('0'))
+                    return {};
+
+                auto port = port_string.to_number<u16>();
+                if (!port.has_value() || port == default_port_for_scheme(scheme))
+                    return {};
+
+                url.set_port(port);
+            }
+        }
+
+        if (path.is_empty()) {
+            paths.append(String {});
+        } else {
+            for (auto segment : path.substring_view(1).split_view('/', SplitBehavior::KeepEmpty)) {
+                if (!is_canonical_component(segment, PercentEncodeSet::Path) || segment.contains('\\'))
+                    return {};
+                if (is_single_dot_path_segment(segment) || is_double_dot_path_segment(segment))
+                    return {};
+                if (scheme == "file"sv && paths.is_empty() && is_windows_drive_letter(segment) && !is_normalized_windows_drive_letter(segment))
+                    return {};
+
+                paths.append(String::from_utf8_without_validation(segment.bytes()));
+            }
+        }
+    } else {
+        if (path.starts_with('/') || !is_canonical_component(path, PercentEncodeSet::C0Control))
+            return {};
+
+        paths.append(String::from_utf8_without_validation(path.bytes()));
+        url.set_has_an_opaque_path(true);
+    }
+
+    url.set_raw_paths(move(paths));
+
+    remaining = remaining.substring_view(end_of_path);
+
+    if (remaining.starts_with('?')) {
+        auto end_of_query = remaining.find('#').value_or(remaining.length());
+        auto query = remaining.substring_view(1, end_of_query - 1);
+        if (!is_canonical_component(query, is_special ? PercentEncodeSet::SpecialQuery : PercentEncodeSet::Query))
+            return {};
+
+        url.set_query(String::from_utf8_without_validation(query.bytes()));
+        remaining = remaining.substring_view(end_of_query);
+    }
+
+    if (remaining.starts_with('#')) {
+        auto fragment = remaining.substring_view(1);
+        if (!is_canonical_component(fragment, PercentEncodeSet::Fragment))
+            return {};
+
+        url.set_fragment(String::from_utf8_without_validation(fragment.bytes()));
+    }
+
+    return url;
+}
+
 // https://url.spec.whatwg.org/#concept-basic-url-parser
 Optional<URL> Parser::basic_parse(StringView raw_input, Optional<URL const&> base_url, URL* url, Optional<State> state_override, Optional<StringView> encoding)
 {
     dbgln_if(URL_PARSER_DEBUG, "URL::Parser::basic_parse: Parsing '{}'", raw_input);
 
+    // OPTIMIZATION: Most of the URLs we parse are already serialized URLs, e.g. every URL we receive over IPC or resolve
+    //               again later on. Those can be parsed with a single scan over the input instead of running the state
+    //               machine below. The base URL is irrelevant for them, as they all start with a scheme.
+    if (!url && !state_override.has_value()) {
+        if (auto canonical_url = parse_canonical_url(raw_input); canonical_url.has_value())
+            return canonical_url.release_value();
+    }
+
     size_t start_index = 0;
     size_t end_index = raw_input.length();
 
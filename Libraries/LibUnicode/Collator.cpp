@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashMap.h>
 #include <LibUnicode/Collator.h>
 #include <LibUnicode/ICU.h>
 
@@ -204,6 +205,11 @@ private:
     NonnullOwnPtr<icu::Collator> m_collator;
 };
 
+// Creating an ICU collator loads the collation rules of its locale, which is slow. Collators are created very often, e.g.
+// by every call to String.prototype.localeCompare with explicit locales, so we keep an unmodified collator for each
+// locale around and clone it instead. Clones share the immutable rule data with the original.
+static HashMap<String, NonnullOwnPtr<icu::Collator>> s_collator_cache;
+
 NonnullOwnPtr<Collator> Collator::create(
     StringView locale,
     Usage usage,
@@ -219,9 +225,18 @@ NonnullOwnPtr<Collator> Collator::create(
     VERIFY(locale_data.has_value());
 
     auto locale_with_usage = apply_usage_to_locale(locale_data->locale(), usage, collation);
+    auto cache_key = StringView { locale_with_usage->getName(), strlen(locale_with_usage->getName()) };
 
-    auto collator = adopt_own(*icu::Collator::createInstance(*locale_with_usage, status));
-    VERIFY(icu_success(status));
+    auto cached_collator = s_collator_cache.get(cache_key);
+    if (!cached_collator.has_value()) {
+        auto collator = adopt_own(*icu::Collator::createInstance(*locale_with_usage, status));
+        VERIFY(icu_success(status));
+
+        cached_collator = collator.ptr();
+        s_collator_cache.set(MUST(String::from_utf8(cache_key)), move(collator));
+    }
+
+    auto collator = adopt_own(*cached_collator.value()->clone());
 
     auto set_attribute = [&](UColAttribute attribute, UColAttributeValue value) {
         collator->setAttribute(attribute, value, status);
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/HashMap.h>
 #include <AK/Utf16View.h>
 #include <AK/Utf32View.h>
 #include <LibUnicode/CharacterTypes.h>
@@ -223,28 +225,41 @@ NonnullOwnPtr<Segmenter> Segmenter::create(SegmenterGranularity segmenter_granul
     return Segmenter::create(default_locale(), segmenter_granularity);
 }
 
+// Creating an ICU break iterator loads the break rules of its locale, which is slow. Segmenters are created often, e.g.
+// by Intl.Segmenter and text editing, so we keep a break iterator for each locale and granularity around and clone it
+// instead. Clones share the immutable rule data with the original.
+static Array<HashMap<String, NonnullOwnPtr<icu::BreakIterator>>, 3> s_segmenter_cache;
+
 NonnullOwnPtr<Segmenter> Segmenter::create(StringView locale, SegmenterGranularity segmenter_granularity)
 {
-    UErrorCode status = U_ZERO_ERROR;
-
-    auto locale_data = LocaleData::for_locale(locale);
-    VERIFY(locale_data.has_value());
-
-    auto segmenter = adopt_own_if_nonnull([&]() {
-        switch (segmenter_granularity) {
-        case SegmenterGranularity::Grapheme:
-            return icu::BreakIterator::createCharacterInstance(locale_data->locale(), status);
-        case SegmenterGranularity::Sentence:
-            return icu::BreakIterator::createSentenceInstance(locale_data->locale(), status);
-        case SegmenterGranularity::Word:
-            return icu::BreakIterator::createWordInstance(locale_data->locale(), status);
-        }
-        VERIFY_NOT_REACHED();
-    }());
+    auto& cache = s_segmenter_cache[to_underlying(segmenter_granularity)];
 
-    VERIFY(icu_success(status));
+    auto cached_segmenter = cache.get(locale);
+    if (!cached_segmenter.has_value()) {
+        UErrorCode status = U_ZERO_ERROR;
+
+        auto locale_data = LocaleData::for_locale(locale);
+        VERIFY(locale_data.has_value());
+
+        auto segmenter = adopt_own_if_nonnull([&]() {
+            switch (segmenter_granularity) {
+            case SegmenterGranularity::Grapheme:
+                return icu::BreakIterator::createCharacterInstance(locale_data->locale(), status);
+            case SegmenterGranularity::Sentence:
+                return icu::BreakIterator::createSentenceInstance(locale_data->locale(), status);
+            case SegmenterGranularity::Word:
+                return icu::BreakIterator::createWordInstance(locale_data->locale(), status);
+            }
+            VERIFY_NOT_REACHED();
+        }());
+
+        VERIFY(icu_success(status));
+
+        cached_segmenter = segmenter.ptr();
+        cache.set(MUST(String::from_utf8(locale)), segmenter.release_nonnull());
+    }
 
-    return make<SegmenterImpl>(segmenter.release_nonnull(), segmenter_granularity);
+    return make<SegmenterImpl>(adopt_own(*cached_segmenter.value()->clone()), segmenter_granularity);
 }
 
 bool Segmenter::should_continue_beyond_word(Utf16View const& word)
@@ -5,6 +5,9 @@
  */
 
 #include <AK/Array.h>
+#include <AK/BinarySearch.h>
+#include <AK/HashMap.h>
+#include <AK/Math.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/QuickSort.h>
 #include <LibUnicode/ICU.h>
@@ -12,12 +15,25 @@
 
 #include <unicode/basictz.h>
 #include <unicode/timezone.h>
+#include <unicode/tztrans.h>
 #include <unicode/ucal.h>
 
 namespace Unicode {
 
 static Optional<String> cached_system_time_zone;
 
+// A span of time between two consecutive transitions of a time zone, during which its offset is constant.
+struct TimeZoneOffsetSpan {
+    UDate start { 0 }; // Inclusive.
+    UDate end { 0 };   // Exclusive.
+    TimeZoneOffset offset;
+};
+
+// Spans that have been looked up so far, sorted by start time. Most lookups (e.g. formatting many dates from the same
+// few years) land in a span we've already seen, which we can find with a binary search instead of asking ICU.
+static HashMap<String, Vector<TimeZoneOffsetSpan>> s_time_zone_offset_spans;
+static constexpr size_t MAX_CACHED_TIME_ZONE_OFFSET_SPANS = 4096;
+
 static String current_time_zone_impl(OwnPtr<icu::TimeZone> time_zone)
 {
     UErrorCode status = U_ZERO_ERROR;
@@ -55,6 +71,7 @@ String current_time_zone()
 void clear_system_time_zone_cache()
 {
     cached_system_time_zone.clear();
+    s_time_zone_offset_spans.clear();
 }
 
 ErrorOr<void> set_current_time_zone(StringView time_zone)
@@ -159,10 +176,46 @@ static UDate to_icu_time(UnixDateTime time)
     return clamp(static_cast<UDate>(time.milliseconds_since_epoch()), min_time, max_time);
 }
 
+static TimeZoneOffsetSpan const* find_cached_time_zone_offset_span(Vector<TimeZoneOffsetSpan> const& spans, UDate time, size_t* nearby_index = nullptr)
+{
+    return binary_search(spans, time, nearby_index, [](UDate time, TimeZoneOffsetSpan const& span) {
+        if (time < span.start)
+            return -1;
+        if (time >= span.end)
+            return 1;
+        return 0;
+    });
+}
+
+static void cache_time_zone_offset_span(Vector<TimeZoneOffsetSpan>& spans, TimeZoneOffsetSpan span)
+{
+    if (spans.size() >= MAX_CACHED_TIME_ZONE_OFFSET_SPANS)
+        spans.clear();
+
+    // Spans are delimited by the time zone's transitions, so they never overlap each other.
+    size_t index = 0;
+    find_cached_time_zone_offset_span(spans, span.start, &index);
+
+    while (index < spans.size() && spans[index].start < span.start)
+        ++index;
+    while (index > 0 && spans[index - 1].start > span.start)
+        --index;
+
+    spans.insert(index, span);
+}
+
 Optional<TimeZoneOffset> time_zone_offset(StringView time_zone, UnixDateTime time)
 {
     UErrorCode status = U_ZERO_ERROR;
 
+    auto icu_time = to_icu_time(time);
+
+    auto cached_spans = s_time_zone_offset_spans.get(time_zone);
+    if (cached_spans.has_value()) {
+        if (auto const* span = find_cached_time_zone_offset_span(*cached_spans, icu_time))
+            return span->offset;
+    }
+
     auto time_zone_data = TimeZoneData::for_time_zone(time_zone);
     if (!time_zone_data.has_value())
         return {};
@@ -170,16 +223,33 @@ Optional<TimeZoneOffset> time_zone_offset(StringView time_zone, UnixDateTime tim
     i32 raw_offset = 0;
     i32 dst_offset = 0;
 
-    auto icu_time = to_icu_time(time);
-
     time_zone_data->time_zone().getOffset(icu_time, 0, raw_offset, dst_offset, status);
     if (icu_failure(status))
         return {};
 
-    return TimeZoneOffset {
-        .offset = AK::Duration::from_milliseconds(raw_offset + dst_offset),
-        .in_dst = dst_offset == 0 ? TimeZoneOffset::InDST::No : TimeZoneOffset::InDST::Yes,
+    TimeZoneOffsetSpan span {
+        .start = -AK::Infinity<UDate>,
+        .end = AK::Infinity<UDate>,
+        .offset = {
+            .offset = AK::Duration::from_milliseconds(raw_offset + dst_offset),
+            .in_dst = dst_offset == 0 ? TimeZoneOffset::InDST::No : TimeZoneOffset::InDST::Yes,
+        },
     };
+
+    // The offset we just computed holds from the most recent transition at or before the requested time, up to (but
+    // not including) the next transition after it.
+    auto& basic_time_zone = as<icu::BasicTimeZone>(time_zone_data->time_zone());
+    icu::TimeZoneTransition transition;
+
+    if (basic_time_zone.getPreviousTransition(icu_time, true, transition))
+        span.start = transition.getTime();
+    if (basic_time_zone.getNextTransition(icu_time, false, transition))
+        span.end = transition.getTime();
+
+    auto& spans = s_time_zone_offset_spans.ensure(MUST(String::from_utf8(time_zone)));
+    cache_time_zone_offset_span(spans, span);
+
+    return span.offset;
 }
 
 Vector<TimeZoneOffset> disambiguated_time_zone_offsets(StringView time_zone, UnixDateTime time)
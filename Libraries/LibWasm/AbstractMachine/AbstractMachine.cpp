@@ -558,6 +558,7 @@ Result AbstractMachine::invoke(Interpreter& interpreter, FunctionAddress address
     Configuration configuration { m_store };
     if (m_should_limit_instruction_count)
         configuration.enable_instruction_count_limit();
+    configuration.set_profiler(m_profiler);
     return configuration.call(interpreter, address, move(arguments));
 }
 
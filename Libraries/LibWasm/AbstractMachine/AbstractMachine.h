@@ -718,6 +718,10 @@ public:
 
     void enable_instruction_count_limit() { m_should_limit_instruction_count = true; }
 
+    // Calls made through invoke() while a profiler is set are profiled by it. The profiler must outlive those calls.
+    void set_profiler(Profiler* profiler) { m_profiler = profiler; }
+    Profiler* profiler() const { return m_profiler; }
+
     void visit_external_resources(HostVisitOps const&);
 
 private:
@@ -751,6 +755,7 @@ private:
     StackInfo m_stack_info;
     HashTable<Interpreter*> m_active_interpreters;
     bool m_should_limit_instruction_count { false };
+    Profiler* m_profiler { nullptr };
 };
 
 class WASM_API Linker {
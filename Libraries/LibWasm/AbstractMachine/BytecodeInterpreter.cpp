@@ -19,6 +19,7 @@
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Operators.h>
+#include <LibWasm/AbstractMachine/Profiler.h>
 #include <LibWasm/Opcode.h>
 #include <LibWasm/Printer/Printer.h>
 #include <LibWasm/Types.h>
@@ -85,6 +86,19 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
     m_trap = Empty {};
     auto& expression = configuration.frame().expression();
     auto const should_limit_instruction_count = configuration.should_limit_instruction_count();
+
+    // Profiling needs to see every instruction, so it always goes through the dispatch loop rather than direct threading.
+    if (configuration.profiler()) [[unlikely]] {
+        if (!expression.compiled_instructions.dispatches.is_empty()) {
+            if (should_limit_instruction_count)
+                return interpret_impl<true, true, false, true>(configuration, expression);
+            return interpret_impl<true, false, false, true>(configuration, expression);
+        }
+        if (should_limit_instruction_count)
+            return interpret_impl<false, true, false, true>(configuration, expression);
+        return interpret_impl<false, false, false, true>(configuration, expression);
+    }
+
     if (!expression.compiled_instructions.dispatches.is_empty()) {
         if (expression.compiled_instructions.direct) {
             if (should_limit_instruction_count)
@@ -1039,6 +1053,36 @@ HANDLE_INSTRUCTION(synthetic_i32_add2local)
     TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
 }
 
+HANDLE_INSTRUCTION(synthetic_i32_sub2local)
+{
+    configuration.push_to_destination(Value(static_cast<i32>(Operators::Subtract {}(configuration.local(instruction->local_index()).to<u32>(), configuration.local(instruction->arguments().get<LocalIndex>()).to<u32>()))), addresses.destination);
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(synthetic_i32_mul2local)
+{
+    configuration.push_to_destination(Value(static_cast<i32>(Operators::Multiply {}(configuration.local(instruction->local_index()).to<u32>(), configuration.local(instruction->arguments().get<LocalIndex>()).to<u32>()))), addresses.destination);
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(synthetic_i32_and2local)
+{
+    configuration.push_to_destination(Value(Operators::BitAnd {}(configuration.local(instruction->local_index()).to<i32>(), configuration.local(instruction->arguments().get<LocalIndex>()).to<i32>())), addresses.destination);
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(synthetic_i32_or2local)
+{
+    configuration.push_to_destination(Value(Operators::BitOr {}(configuration.local(instruction->local_index()).to<i32>(), configuration.local(instruction->arguments().get<LocalIndex>()).to<i32>())), addresses.destination);
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
+HANDLE_INSTRUCTION(synthetic_i32_xor2local)
+{
+    configuration.push_to_destination(Value(Operators::BitXor {}(configuration.local(instruction->local_index()).to<i32>(), configuration.local(instruction->arguments().get<LocalIndex>()).to<i32>())), addresses.destination);
+    TAILCALL return continue_(HANDLER_PARAMS(DECOMPOSE_PARAMS_NAME_ONLY));
+}
+
 HANDLE_INSTRUCTION(synthetic_i32_addconstlocal)
 {
     configuration.push_to_destination(Value(static_cast<i32>(Operators::Add {}(configuration.local(instruction->local_index()).to<u32>(), instruction->arguments().unsafe_get<i32>()))), addresses.destination);
@@ -3790,7 +3834,7 @@ constexpr static auto handle_instruction(Args&&... a)
     return InstructionHandler<opcode>::template operator()<HasDynamicInsnLimit, Continue>(forward<Args>(a)...);
 }
 
-template<bool HasCompiledList, bool HasDynamicInsnLimit, bool HaveDirectThreadingInfo>
+template<bool HasCompiledList, bool HasDynamicInsnLimit, bool HaveDirectThreadingInfo, bool IsProfiling>
 FLATTEN void BytecodeInterpreter::interpret_impl(Configuration& configuration, Expression const& expression)
 {
     auto& instructions = expression.instructions();
@@ -3824,11 +3868,15 @@ FLATTEN void BytecodeInterpreter::interpret_impl(Configuration& configuration, E
         auto const instruction = HasCompiledList
             ? cc[current_ip_value].instruction
             : &instructions.data()[current_ip_value];
-        auto const opcode = (HasCompiledList && !HaveDirectThreadingInfo
+        // NOTE: A directly threaded list keeps handler pointers in place of opcodes, so the profiler asks the instruction.
+        auto const opcode = (HasCompiledList && !HaveDirectThreadingInfo && !IsProfiling
                 ? cc[current_ip_value].instruction_opcode
                 : instruction->opcode())
                                 .value();
 
+        if constexpr (IsProfiling)
+            configuration.profiler()->did_execute_instruction(OpCode { opcode });
+
 #define RUN_NEXT_INSTRUCTION() \
     {                          \
         ++current_ip_value;    \
@@ -3876,7 +3924,7 @@ bool BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
 {
     auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
     auto& address = configuration.frame().module().memories()[arg.memory_index.value()];
-    auto memory = configuration.store().get(address);
+    auto memory = configuration.store().unsafe_get(address);
     auto& entry = configuration.source_value(0, addresses.sources); // bounds checked by verifier.
     auto base = entry.to<i32>();
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + arg.offset;
@@ -3886,8 +3934,8 @@ bool BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         return true;
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
-    entry = Value(static_cast<PushType>(read_value<ReadType>(slice)));
+    ReadonlyBytes bytes { memory->data().data() + instance_address, sizeof(ReadType) };
+    entry = Value(static_cast<PushType>(read_value<ReadType>(bytes)));
     return false;
 }
 
@@ -3902,7 +3950,7 @@ bool BytecodeInterpreter::load_and_push_mxn(Configuration& configuration, Instru
 {
     auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
     auto& address = configuration.frame().module().memories()[arg.memory_index.value()];
-    auto memory = configuration.store().get(address);
+    auto memory = configuration.store().unsafe_get(address);
     auto& entry = configuration.source_value(0, addresses.sources); // bounds checked by verifier.
     auto base = entry.to<i32>();
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + arg.offset;
@@ -3931,7 +3979,7 @@ bool BytecodeInterpreter::load_and_push_lane_n(Configuration& configuration, Ins
 {
     auto memarg_and_lane = instruction.arguments().get<Instruction::MemoryAndLaneArgument>();
     auto& address = configuration.frame().module().memories()[memarg_and_lane.memory.memory_index.value()];
-    auto memory = configuration.store().get(address);
+    auto memory = configuration.store().unsafe_get(address);
     // bounds checked by verifier.
     auto vector = configuration.take_source(0, addresses.sources).to<u128>();
     auto base = configuration.take_source(1, addresses.sources).to<u32>();
@@ -3952,7 +4000,7 @@ bool BytecodeInterpreter::load_and_push_zero_n(Configuration& configuration, Ins
 {
     auto memarg_and_lane = instruction.arguments().get<Instruction::MemoryArgument>();
     auto& address = configuration.frame().module().memories()[memarg_and_lane.memory_index.value()];
-    auto memory = configuration.store().get(address);
+    auto memory = configuration.store().unsafe_get(address);
     // bounds checked by verifier.
     auto base = configuration.take_source(0, addresses.sources).to<u32>();
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + memarg_and_lane.offset;
@@ -3972,7 +4020,7 @@ bool BytecodeInterpreter::load_and_push_m_splat(Configuration& configuration, In
 {
     auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
     auto& address = configuration.frame().module().memories()[arg.memory_index.value()];
-    auto memory = configuration.store().get(address);
+    auto memory = configuration.store().unsafe_get(address);
     auto& entry = configuration.source_value(0, addresses.sources); // bounds checked by verifier.
     auto base = entry.to<i32>();
     u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + arg.offset;
@@ -4066,8 +4114,11 @@ Outcome BytecodeInterpreter::call_address(Configuration& configuration, Function
 
         final_outcome = Outcome::Return; // At this point we can only ever return (unless we succeed in tail-calling).
         if (prep_outcome.value().has_value()) {
+            Profiler::FunctionScope profiler_scope { configuration.profiler(), address };
             result = prep_outcome.value()->function()(configuration, args);
         } else {
+            if (auto* profiler = configuration.profiler()) [[unlikely]]
+                profiler->replace_function(address);
             configuration.ip() = 0;
             return static_cast<Outcome>(0); // Continue from IP 0 in the new frame.
         }
@@ -4147,8 +4198,10 @@ bool BytecodeInterpreter::store_value(Configuration& configuration, Instruction
 {
     auto& memarg = instruction.arguments().unsafe_get<Instruction::MemoryArgument>();
     dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> temporary({}b)", value, sizeof(StoreT));
-    auto base = configuration.take_source(address_source, addresses.sources).to<i32>();
-    return store_to_memory(configuration, memarg, { &value, sizeof(StoreT) }, base);
+    auto base = configuration.take_source(address_source, addresses.sources).to<u32>();
+    auto const& address = configuration.frame().module().memories().data()[memarg.memory_index.value()];
+    // NOTE: Storing the value itself rather than a span of its bytes lets the copy below be a single fixed-size move.
+    return store_to_memory(*configuration.store().unsafe_get(address), static_cast<u64>(base) + memarg.offset, value);
 }
 
 template<size_t N>
@@ -4165,7 +4218,7 @@ bool BytecodeInterpreter::pop_and_store_lane_n(Configuration& configuration, Ins
 bool BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruction::MemoryArgument const& arg, ReadonlyBytes data, u32 base)
 {
     auto const& address = configuration.frame().module().memories().data()[arg.memory_index.value()];
-    auto memory = configuration.store().get(address);
+    auto memory = configuration.store().unsafe_get(address);
     u64 instance_address = static_cast<u64>(base) + arg.offset;
     return store_to_memory(*memory, instance_address, data);
 }
@@ -4173,25 +4226,26 @@ bool BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruct
 template<typename T>
 bool BytecodeInterpreter::store_to_memory(MemoryInstance& memory, u64 address, T value)
 {
-    Checked addition { address };
     size_t data_size;
     if constexpr (IsSame<ReadonlyBytes, T>)
         data_size = value.size();
     else
         data_size = sizeof(T);
 
-    addition += data_size;
-    if (addition.has_overflow() || addition.value() > memory.size()) [[unlikely]] {
+    u64 end;
+    if (__builtin_add_overflow(address, data_size, &end) || end > memory.size()) [[unlikely]] {
         m_trap = Trap::from_string("Memory access out of bounds");
         dbgln_if(WASM_TRACE_DEBUG, "LibWasm: Memory access out of bounds (expected 0 <= {} and {} <= {})", address, address + data_size, memory.size());
         return true;
     }
 
+    // The access was bounds checked above, so there is no need to go through a checked slice of the memory.
     dbgln_if(WASM_TRACE_DEBUG, "temporary({}b) -> store({})", data_size, address);
+    auto* destination = memory.data().data() + address;
     if constexpr (IsSame<ReadonlyBytes, T>)
-        (void)value.copy_to(memory.data().bytes().slice(address, data_size));
+        __builtin_memmove(destination, value.data(), data_size);
     else
-        memcpy(memory.data().bytes().offset_pointer(address), &value, data_size);
+        __builtin_memcpy(destination, &value, sizeof(T));
     return false;
 }
 
@@ -4219,6 +4273,28 @@ double BytecodeInterpreter::read_value<double>(ReadonlyBytes data)
     return bit_cast<double>(read_value<u64>(data));
 }
 
+// Binary i32 operators that are fused with the two `local.get`s feeding them, as these make up much of the inner loops of
+// compute-heavy modules.
+static Optional<OpCode> fused_two_local_opcode(OpCode opcode)
+{
+    switch (opcode.value()) {
+    case Instructions::i32_add.value():
+        return Instructions::synthetic_i32_add2local;
+    case Instructions::i32_sub.value():
+        return Instructions::synthetic_i32_sub2local;
+    case Instructions::i32_mul.value():
+        return Instructions::synthetic_i32_mul2local;
+    case Instructions::i32_and.value():
+        return Instructions::synthetic_i32_and2local;
+    case Instructions::i32_or.value():
+        return Instructions::synthetic_i32_or2local;
+    case Instructions::i32_xor.value():
+        return Instructions::synthetic_i32_xor2local;
+    default:
+        return {};
+    }
+}
+
 CompiledInstructions try_compile_instructions(Expression const& expression, Span<FunctionType const> functions)
 {
     CompiledInstructions result;
@@ -4302,13 +4378,13 @@ CompiledInstructions try_compile_instructions(Expression const& expression, Span
             }
             break;
         case InsnPatternState::GetLocalx2:
-            if (instruction.opcode() == Instructions::i32_add) {
-                // `local.get a; local.get b; i32.add` -> `i32.add_2local a b`.
-                // Replace the previous two ops with noops, and add i32.add_2local.
+            if (auto fused_opcode = fused_two_local_opcode(instruction.opcode()); fused_opcode.has_value()) {
+                // `local.get a; local.get b; i32.add` -> `i32.add_2local a b`, and likewise for the other binary operators above.
+                // Replace the previous two ops with noops, and add the fused instruction.
                 result.dispatches[result.dispatches.size() - 1] = default_dispatch(nop);
                 result.dispatches[result.dispatches.size() - 2] = default_dispatch(nop);
                 result.extra_instruction_storage.append(Instruction {
-                    Instructions::synthetic_i32_add2local,
+                    *fused_opcode,
                     local_index_0,
                     local_index_1,
                 });
@@ -69,7 +69,7 @@ struct WASM_API BytecodeInterpreter final : public Interpreter {
         IndirectTailCall,
     };
 
-    template<bool HasCompiledList, bool HasDynamicInsnLimit, bool HaveDirectThreadingInfo>
+    template<bool HasCompiledList, bool HasDynamicInsnLimit, bool HaveDirectThreadingInfo, bool IsProfiling = false>
     void interpret_impl(Configuration&, Expression const&);
 
     InstructionPointer branch_to_label(Configuration&, LabelIndex);
@@ -7,6 +7,7 @@
 #include <AK/MemoryStream.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
+#include <LibWasm/AbstractMachine/Profiler.h>
 #include <LibWasm/Printer/Printer.h>
 
 namespace Wasm {
@@ -20,6 +21,7 @@ void Configuration::unwind_impl()
 
 Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Vector<Value> arguments)
 {
+    Profiler::FunctionScope profiler_scope { m_profiler, address };
     if (auto fn = TRY(prepare_call(address, arguments)); fn.has_value())
         return fn->function()(*this, arguments);
     m_ip = 0;
@@ -76,6 +76,9 @@ public:
     void enable_instruction_count_limit() { m_should_limit_instruction_count = true; }
     bool should_limit_instruction_count() const { return m_should_limit_instruction_count; }
 
+    void set_profiler(Profiler* profiler) { m_profiler = profiler; }
+    Profiler* profiler() const { return m_profiler; }
+
     void dump_stack();
 
     ALWAYS_INLINE FLATTEN void push_to_destination(Value value, Dispatch::RegisterOrStack destination)
@@ -125,6 +128,7 @@ private:
     size_t m_depth { 0 };
     u64 m_ip { 0 };
     bool m_should_limit_instruction_count { false };
+    Profiler* m_profiler { nullptr };
     Value* m_locals_base { nullptr };
 };
 
@@ -55,6 +55,22 @@ struct Identity {
     auto operator()(auto x) const { return x; }
 };
 
+// Applies an operator to all the lanes of a host vector at once, so that it compiles down to a single instruction (or
+// a short sequence of them) instead of a loop over the lanes. Operators without an `apply` for the vector type at hand
+// are applied one lane at a time. The specializations live at the end of this file.
+template<typename Op>
+struct NativeVectorOperator;
+
+template<SIMDVector V>
+using UnsignedVectorOf = NativeVectorType<sizeof(ElementOf<V>) * 8, vector_length<V>, MakeUnsigned>;
+
+template<SIMDVector V, SIMDVector Mask>
+ALWAYS_INLINE static V select_lanes(Mask mask, V if_true, V if_false)
+{
+    auto bits = bit_cast<V>(mask);
+    return (if_true & bits) | (if_false & ~bits);
+}
+
 struct Divide {
     template<typename Lhs, typename Rhs>
     auto operator()(Lhs lhs, Rhs rhs) const
@@ -342,6 +358,9 @@ struct VectorCmpOp {
         using ElementType = NativeIntegralType<128 / VectorSize>;
         auto result = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c1);
         auto other = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c2);
+        if constexpr (requires { NativeVectorOperator<Op>::apply(result, other); })
+            return bit_cast<u128>(NativeVectorOperator<Op>::apply(result, other));
+
         Op op;
         for (size_t i = 0; i < VectorSize; ++i) {
             SetSign<ElementType> lhs = result[i];
@@ -374,6 +393,9 @@ struct VectorFloatCmpOp {
     {
         auto first = bit_cast<NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>>(c1);
         auto other = bit_cast<NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>>(c2);
+        if constexpr (requires { NativeVectorOperator<Op>::apply(first, other); })
+            return bit_cast<u128>(NativeVectorOperator<Op>::apply(first, other));
+
         using ElementType = NativeIntegralType<128 / VectorSize>;
         Native128ByteVectorOf<ElementType, MakeUnsigned> result;
         Op op;
@@ -696,10 +718,11 @@ struct VectorIntegerBinaryOp {
         using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
         auto first = bit_cast<VectorType>(lhs);
         auto second = bit_cast<VectorType>(rhs);
+        if constexpr (requires { NativeVectorOperator<Op>::apply(first, second); })
+            return bit_cast<u128>(NativeVectorOperator<Op>::apply(first, second));
+
         VectorType result;
         Op op;
-
-        // FIXME: Find a way to not loop here
         for (size_t i = 0; i < VectorSize; ++i) {
             result[i] = op(first[i], second[i]);
         }
@@ -830,10 +853,11 @@ struct VectorIntegerUnaryOp {
     {
         using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
         auto value = bit_cast<VectorType>(lhs);
+        if constexpr (requires { NativeVectorOperator<Op>::apply(value); })
+            return bit_cast<u128>(NativeVectorOperator<Op>::apply(value));
+
         VectorType result;
         Op op;
-
-        // FIXME: Find a way to not loop here
         for (size_t i = 0; i < VectorSize; ++i) {
             result[i] = op(value[i]);
         }
@@ -865,6 +889,9 @@ struct VectorFloatBinaryOp {
         using VectorType = NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>;
         auto first = bit_cast<VectorType>(lhs);
         auto second = bit_cast<VectorType>(rhs);
+        if constexpr (requires { NativeVectorOperator<Op>::apply(first, second); })
+            return bit_cast<u128>(NativeVectorOperator<Op>::apply(first, second));
+
         VectorType result;
         Op op;
         for (size_t i = 0; i < VectorSize; ++i) {
@@ -892,6 +919,9 @@ struct VectorFloatUnaryOp {
     {
         using VectorType = NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>;
         auto value = bit_cast<VectorType>(lhs);
+        if constexpr (requires { NativeVectorOperator<Op>::apply(value); })
+            return bit_cast<u128>(NativeVectorOperator<Op>::apply(value));
+
         VectorType result;
         Op op;
         for (size_t i = 0; i < VectorSize; ++i) {
@@ -1191,4 +1221,93 @@ struct SaturatingOp {
     static StringView name() { return "saturating_op"sv; }
 };
 
+template<typename Op>
+struct NativeVectorOperator {
+};
+
+template<typename Op>
+requires(IsOneOf<Op, Equals, NotEquals, GreaterThan, LessThan, LessThanOrEquals, GreaterThanOrEquals>)
+struct NativeVectorOperator<Op> {
+    // Comparing two vectors yields a mask with all bits of the lanes that compared true set, which is what Wasm wants.
+    template<SIMDVector V>
+    static auto apply(V lhs, V rhs) { return Op {}(lhs, rhs); }
+};
+
+template<typename Op>
+requires(IsOneOf<Op, Add, Subtract, Multiply>)
+struct NativeVectorOperator<Op> {
+    template<SIMDVector V>
+    static V apply(V lhs, V rhs)
+    {
+        if constexpr (IsFloatingPoint<ElementOf<V>>) {
+            return Op {}(lhs, rhs);
+        } else {
+            // Integer lanes wrap around, which is only well-defined for unsigned lanes.
+            using Unsigned = UnsignedVectorOf<V>;
+            return bit_cast<V>(Op {}(bit_cast<Unsigned>(lhs), bit_cast<Unsigned>(rhs)));
+        }
+    }
+};
+
+template<>
+struct NativeVectorOperator<Divide> {
+    template<SIMDVector V>
+    requires(IsFloatingPoint<ElementOf<V>>)
+    static V apply(V lhs, V rhs) { return lhs / rhs; }
+};
+
+template<>
+struct NativeVectorOperator<Minimum> {
+    template<SIMDVector V>
+    requires(IsIntegral<ElementOf<V>>)
+    static V apply(V lhs, V rhs) { return select_lanes(lhs < rhs, lhs, rhs); }
+};
+
+template<>
+struct NativeVectorOperator<Maximum> {
+    template<SIMDVector V>
+    requires(IsIntegral<ElementOf<V>>)
+    static V apply(V lhs, V rhs) { return select_lanes(lhs > rhs, lhs, rhs); }
+};
+
+template<>
+struct NativeVectorOperator<Average> {
+    // (lhs + rhs + 1) / 2, without the intermediate sum overflowing the lane.
+    template<SIMDVector V>
+    requires(IsUnsigned<ElementOf<V>>)
+    static V apply(V lhs, V rhs) { return (lhs | rhs) - ((lhs ^ rhs) >> 1); }
+};
+
+template<>
+struct NativeVectorOperator<Negate> {
+    template<SIMDVector V>
+    static V apply(V value)
+    {
+        if constexpr (IsFloatingPoint<ElementOf<V>>)
+            return -value;
+        else
+            return bit_cast<V>(-bit_cast<UnsignedVectorOf<V>>(value));
+    }
+};
+
+template<typename ResultT, typename Op>
+requires(IsOneOf<Op, Add, Subtract>)
+struct NativeVectorOperator<SaturatingOp<ResultT, Op>> {
+    // Do the arithmetic in lanes twice as wide, where it can't overflow, then clamp and narrow it again.
+    template<SIMDVector V>
+    requires(IsSame<ElementOf<V>, ResultT> && sizeof(ResultT) <= 2)
+    static V apply(V lhs, V rhs)
+    {
+        using WideLane = Conditional<sizeof(ResultT) == 1, i16, i32>;
+        using Wide __attribute__((vector_size(vector_length<V> * sizeof(WideLane)))) = WideLane;
+        auto result = Op {}(__builtin_convertvector(lhs, Wide), __builtin_convertvector(rhs, Wide));
+
+        Wide minimum = Wide {} + static_cast<WideLane>(NumericLimits<ResultT>::min());
+        Wide maximum = Wide {} + static_cast<WideLane>(NumericLimits<ResultT>::max());
+        result = select_lanes(result < minimum, minimum, result);
+        result = select_lanes(result > maximum, maximum, result);
+        return __builtin_convertvector(result, V);
+    }
+};
+
 }
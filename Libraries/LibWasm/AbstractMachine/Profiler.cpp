@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <AK/QuickSort.h>
+#include <AK/Stream.h>
+#include <AK/StringBuilder.h>
+#include <LibWasm/AbstractMachine/Profiler.h>
+#include <LibWasm/Printer/Printer.h>
+
+namespace Wasm {
+
+Profiler::Profiler(AK::Duration interval)
+    : m_interval(interval)
+    , m_last_sample_time(MonotonicTime::now())
+{
+}
+
+void Profiler::enter_function(FunctionAddress address)
+{
+    m_stack.append(address);
+    ++m_function_statistics.ensure(address).calls;
+}
+
+void Profiler::leave_function()
+{
+    m_stack.take_last();
+}
+
+void Profiler::replace_function(FunctionAddress address)
+{
+    // A tail call replaces the caller's frame, so the callee takes its place on the stack.
+    if (m_stack.is_empty())
+        m_stack.append(address);
+    else
+        m_stack.last() = address;
+    ++m_function_statistics.ensure(address).calls;
+}
+
+ByteString Profiler::resolve_function_name(FunctionAddress address) const
+{
+    if (name_for_function) {
+        if (auto name = name_for_function(address); !name.is_empty())
+            return name;
+    }
+    return ByteString::formatted("wasm-function[{}]", address.value());
+}
+
+ByteString const& Profiler::function_name(FunctionAddress address)
+{
+    return m_function_names.ensure(address, [&] { return resolve_function_name(address); });
+}
+
+void Profiler::maybe_take_sample()
+{
+    auto now = MonotonicTime::now();
+    auto elapsed = now - m_last_sample_time;
+    if (elapsed < m_interval)
+        return;
+    m_last_sample_time = now;
+
+    // A sample stands in for all the intervals that passed since the previous one, so that long stretches
+    // between ticks (e.g. inside host functions) are not under-represented.
+    auto weight = static_cast<size_t>(elapsed.to_nanoseconds() / max<i64>(m_interval.to_nanoseconds(), 1));
+
+    StringBuilder builder;
+    HashTable<FunctionAddress> seen;
+    for (auto address : m_stack) {
+        if (!builder.is_empty())
+            builder.append(';');
+        builder.append(function_name(address));
+
+        // Recursive functions are only counted once per sample.
+        if (seen.set(address) == HashSetResult::InsertedNewEntry)
+            m_function_statistics.ensure(address).total_samples += weight;
+    }
+    if (!m_stack.is_empty())
+        m_function_statistics.ensure(m_stack.last()).self_samples += weight;
+
+    auto folded_frames = builder.to_byte_string();
+    if (on_sample)
+        on_sample(folded_frames, weight);
+
+    m_folded_stacks.ensure(move(folded_frames), [] { return 0; }) += weight;
+    m_sample_count += weight;
+}
+
+ByteString Profiler::folded_stacks() const
+{
+    Vector<ByteString const*> stacks;
+    stacks.ensure_capacity(m_folded_stacks.size());
+    for (auto const& it : m_folded_stacks)
+        stacks.append(&it.key);
+    quick_sort(stacks, [](auto const* a, auto const* b) { return a->view() < b->view(); });
+
+    StringBuilder builder;
+    for (auto const* stack : stacks)
+        builder.appendff("{} {}\n", *stack, *m_folded_stacks.get(*stack));
+    return builder.to_byte_string();
+}
+
+ErrorOr<void> Profiler::write_report(Stream& stream) const
+{
+    Vector<FunctionAddress> functions;
+    for (auto const& it : m_function_statistics)
+        functions.append(it.key);
+    quick_sort(functions, [&](auto a, auto b) {
+        auto const& lhs = *m_function_statistics.get(a);
+        auto const& rhs = *m_function_statistics.get(b);
+        if (lhs.self_samples != rhs.self_samples)
+            return lhs.self_samples > rhs.self_samples;
+        return lhs.calls > rhs.calls;
+    });
+
+    TRY(stream.write_formatted("Functions ({} samples of {}us):\n", m_sample_count, m_interval.to_microseconds()));
+    TRY(stream.write_formatted("{:>12} {:>12} {:>12}  name\n", "self"sv, "total"sv, "calls"sv));
+    for (auto address : functions) {
+        auto const& statistics = *m_function_statistics.get(address);
+        auto name = m_function_names.contains(address) ? *m_function_names.get(address) : resolve_function_name(address);
+        TRY(stream.write_formatted("{:>12} {:>12} {:>12}  {}\n", statistics.self_samples, statistics.total_samples, statistics.calls, name));
+    }
+
+    Vector<u64> opcodes;
+    u64 instruction_count = 0;
+    for (auto const& it : m_opcode_counts) {
+        opcodes.append(it.key);
+        instruction_count += it.value;
+    }
+    quick_sort(opcodes, [&](auto a, auto b) { return *m_opcode_counts.get(a) > *m_opcode_counts.get(b); });
+
+    TRY(stream.write_formatted("\nInstructions ({} executed):\n", instruction_count));
+    for (auto opcode : opcodes) {
+        auto count = *m_opcode_counts.get(opcode);
+        TRY(stream.write_formatted("{:>14} {:>6.2}%  {}\n", count, 100.0 * count / instruction_count, instruction_name(OpCode { opcode })));
+    }
+
+    TRY(stream.write_formatted("\nFolded stacks:\n{}", folded_stacks()));
+    return {};
+}
+
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/Export.h>
+
+namespace Wasm {
+
+// An opt-in profiler for the bytecode interpreter.
+//
+// While a profiler is attached to an AbstractMachine, every call is counted per function and every executed
+// instruction is counted per opcode. Like the JS sampling profiler, the interpreter ticks the profiler as it goes,
+// and the call stack is sampled whenever the sampling interval has elapsed. Samples are aggregated as folded stacks,
+// and can also be handed to the embedder so that it can prefix them with its own frames (e.g. the JS frames that
+// called into Wasm).
+class WASM_API Profiler {
+    AK_MAKE_NONCOPYABLE(Profiler);
+    AK_MAKE_NONMOVABLE(Profiler);
+
+public:
+    explicit Profiler(AK::Duration interval = AK::Duration::from_milliseconds(1));
+
+    struct FunctionStatistics {
+        u64 calls { 0 };
+        // Samples taken while the function was at the top of the stack, and while it was anywhere on the stack.
+        size_t self_samples { 0 };
+        size_t total_samples { 0 };
+    };
+
+    class FunctionScope {
+        AK_MAKE_NONCOPYABLE(FunctionScope);
+        AK_MAKE_NONMOVABLE(FunctionScope);
+
+    public:
+        FunctionScope(Profiler* profiler, FunctionAddress address)
+            : m_profiler(profiler)
+        {
+            if (m_profiler) [[unlikely]]
+                m_profiler->enter_function(address);
+        }
+
+        ~FunctionScope()
+        {
+            if (m_profiler) [[unlikely]]
+                m_profiler->leave_function();
+        }
+
+    private:
+        Profiler* m_profiler { nullptr };
+    };
+
+    // Returns the name a function is shown with, or an empty string to name it by its address.
+    Function<ByteString(FunctionAddress)> name_for_function;
+
+    // Called for every sample with its Wasm frames folded from outermost to innermost, and with the number of sampling
+    // intervals the sample stands for.
+    Function<void(StringView folded_frames, size_t weight)> on_sample;
+
+    void enter_function(FunctionAddress);
+    void leave_function();
+    void replace_function(FunctionAddress);
+
+    ALWAYS_INLINE void did_execute_instruction(OpCode opcode)
+    {
+        ++m_opcode_counts.ensure(opcode.value(), [] { return 0; });
+        if (++m_ticks_since_last_clock_check < ticks_per_clock_check)
+            return;
+        m_ticks_since_last_clock_check = 0;
+        maybe_take_sample();
+    }
+
+    size_t sample_count() const { return m_sample_count; }
+    HashMap<FunctionAddress, FunctionStatistics> const& function_statistics() const { return m_function_statistics; }
+    HashMap<u64, u64> const& opcode_counts() const { return m_opcode_counts; }
+
+    // Returns one line per distinct stack, in the form "outermost;...;innermost <sample count>".
+    ByteString folded_stacks() const;
+
+    // Writes the per-function statistics, the opcode histogram and the folded stacks in a human-readable form.
+    ErrorOr<void> write_report(Stream&) const;
+
+private:
+    static constexpr u32 ticks_per_clock_check = 256;
+
+    void maybe_take_sample();
+    ByteString resolve_function_name(FunctionAddress) const;
+    ByteString const& function_name(FunctionAddress);
+
+    AK::Duration m_interval;
+    MonotonicTime m_last_sample_time;
+    u32 m_ticks_since_last_clock_check { 0 };
+
+    Vector<FunctionAddress, 64> m_stack;
+    HashMap<FunctionAddress, ByteString> m_function_names;
+    HashMap<FunctionAddress, FunctionStatistics> m_function_statistics;
+    HashMap<u64, u64> m_opcode_counts;
+
+    size_t m_sample_count { 0 };
+    HashMap<ByteString, size_t> m_folded_stacks;
+};
+
+}
@@ -9,6 +9,7 @@
 #include <AK/TemporaryChange.h>
 #include <AK/Try.h>
 #include <LibWasm/AbstractMachine/Validator.h>
+#include <LibThreading/Parallel.h>
 #include <LibWasm/Printer/Printer.h>
 
 namespace Wasm {
@@ -247,29 +248,75 @@ ErrorOr<void, ValidationError> Validator::validate(TableSection const& section)
     return {};
 }
 
+// Function bodies are independent of each other, so large modules validate (and compile) them on the thread pool.
+static constexpr size_t minimum_function_count_for_parallel_validation = 64;
+static constexpr size_t parallel_validation_batch_size = 1024;
+
+ErrorOr<NonnullOwnPtr<Validator>, ValidationError> Validator::fork_for_function(size_t function_index, CodeSection::Func const& function) const
+{
+    TRY(validate(FunctionIndex { function_index }));
+    auto& function_type = m_context.functions[function_index];
+
+    auto function_validator = adopt_own(*new Validator(m_context));
+    function_validator->m_context.locals = {};
+    function_validator->m_context.locals.extend(function_type.parameters());
+    for (auto& local : function.locals()) {
+        for (size_t i = 0; i < local.n(); ++i)
+            function_validator->m_context.locals.append(local.type());
+    }
+
+    function_validator->m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+    function_validator->m_max_frame_size = max(function_validator->m_max_frame_size, function_validator->m_frames.size());
+    return function_validator;
+}
+
+ErrorOr<void, ValidationError> Validator::validate_function_body(size_t function_index, CodeSection::Func const& function)
+{
+    auto& function_type = m_context.functions[function_index];
+    auto results = TRY(validate(function.body(), function_type.results()));
+    if (results.result_types.size() != function_type.results().size())
+        return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+    return {};
+}
+
 ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
 {
-    size_t index = m_context.imported_function_count;
-    for (auto& entry : section.functions()) {
-        auto function_index = index++;
-        TRY(validate(FunctionIndex { function_index }));
-        auto& function_type = m_context.functions[function_index];
-        auto& function = entry.func();
-
-        auto function_validator = fork();
-        function_validator.m_context.locals = {};
-        function_validator.m_context.locals.extend(function_type.parameters());
-        for (auto& local : function.locals()) {
-            for (size_t i = 0; i < local.n(); ++i)
-                function_validator.m_context.locals.append(local.type());
+    auto const& functions = section.functions();
+    auto const first_function_index = m_context.imported_function_count;
+
+    if (functions.size() < minimum_function_count_for_parallel_validation) {
+        for (size_t i = 0; i < functions.size(); ++i) {
+            auto function_validator = TRY(fork_for_function(first_function_index + i, functions[i].func()));
+            TRY(function_validator->validate_function_body(first_function_index + i, functions[i].func()));
         }
+        return {};
+    }
 
-        function_validator.m_frames.empend(function_type, FrameKind::Function, (size_t)0);
-        function_validator.m_max_frame_size = max(function_validator.m_max_frame_size, function_validator.m_frames.size());
+    // NOTE: The forked validators share their context through non-atomic reference counts, so they are only ever created
+    //       and destroyed on this thread. Only the validation of the bodies themselves runs on the pool.
+    for (size_t batch_begin = 0; batch_begin < functions.size(); batch_begin += parallel_validation_batch_size) {
+        auto batch_size = min(parallel_validation_batch_size, functions.size() - batch_begin);
+
+        Vector<NonnullOwnPtr<Validator>> function_validators;
+        function_validators.ensure_capacity(batch_size);
+        for (size_t i = 0; i < batch_size; ++i)
+            function_validators.unchecked_append(TRY(fork_for_function(first_function_index + batch_begin + i, functions[batch_begin + i].func())));
+
+        Vector<Optional<ValidationError>> errors;
+        errors.resize(batch_size);
+        Threading::parallel_for(0, batch_size, 16, [&](size_t chunk_begin, size_t chunk_end) {
+            for (auto i = chunk_begin; i < chunk_end; ++i) {
+                auto result = function_validators[i]->validate_function_body(first_function_index + batch_begin + i, functions[batch_begin + i].func());
+                if (result.is_error())
+                    errors[i] = result.release_error();
+            }
+        });
 
-        auto results = TRY(function_validator.validate(function.body(), function_type.results()));
-        if (results.result_types.size() != function_type.results().size())
-            return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+        // Report the error of the first invalid function, as validating them one after another would have.
+        for (auto& error : errors) {
+            if (error.has_value())
+                return error.release_value();
+        }
     }
 
     return {};
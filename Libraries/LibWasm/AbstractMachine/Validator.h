@@ -8,6 +8,7 @@
 
 #include <AK/COWVector.h>
 #include <AK/Debug.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/RedBlackTree.h>
 #include <AK/SourceLocation.h>
 #include <AK/Tuple.h>
@@ -324,6 +325,9 @@ private:
     {
     }
 
+    ErrorOr<NonnullOwnPtr<Validator>, ValidationError> fork_for_function(size_t function_index, CodeSection::Func const&) const;
+    ErrorOr<void, ValidationError> validate_function_body(size_t function_index, CodeSection::Func const&);
+
     struct Errors {
         static ValidationError invalid(StringView name, SourceLocation location = SourceLocation::current())
         {
@@ -0,0 +1,137 @@
+// Runs the SIMD instructions that show up most in hot loops many times over, checking each result against a lane by
+// lane reference. The "hot loop" tests double as a micro-benchmark: their run time is dominated by the instruction.
+//
+// Each exported function applies one instruction to its accumulator `iterations` times:
+//   (func (param $acc v128) (param $operand v128) (param $iterations i32) (result v128)
+//     (block (loop
+//       (br_if 1 (i32.eqz (local.get $iterations)))
+//       (local.set $acc (<instruction> (local.get $acc) (local.get $operand)))
+//       (local.set $iterations (i32.sub (local.get $iterations) (i32.const 1)))
+//       (br 0)))
+//     (local.get $acc))
+
+const HOT_LOOP_ITERATIONS = 20000;
+
+const clamp = (value, min, max) => Math.min(Math.max(value, min), max);
+
+const instructions = {
+    "i8x16.add_sat_s": { opcode: 0x6f, lanes: Int8Array, apply: (a, b, i) => clamp(a[i] + b[i], -128, 127) },
+    "i8x16.add_sat_u": { opcode: 0x70, lanes: Uint8Array, apply: (a, b, i) => clamp(a[i] + b[i], 0, 255) },
+    "i8x16.sub_sat_s": { opcode: 0x72, lanes: Int8Array, apply: (a, b, i) => clamp(a[i] - b[i], -128, 127) },
+    "i8x16.sub_sat_u": { opcode: 0x73, lanes: Uint8Array, apply: (a, b, i) => clamp(a[i] - b[i], 0, 255) },
+    "i8x16.min_u": { opcode: 0x77, lanes: Uint8Array, apply: (a, b, i) => Math.min(a[i], b[i]) },
+    "i8x16.max_s": { opcode: 0x78, lanes: Int8Array, apply: (a, b, i) => Math.max(a[i], b[i]) },
+    "i8x16.avgr_u": { opcode: 0x7b, lanes: Uint8Array, apply: (a, b, i) => (a[i] + b[i] + 1) >> 1 },
+    "i8x16.eq": { opcode: 0x23, lanes: Int8Array, apply: (a, b, i) => (a[i] === b[i] ? -1 : 0) },
+    "i8x16.lt_s": { opcode: 0x25, lanes: Int8Array, apply: (a, b, i) => (a[i] < b[i] ? -1 : 0) },
+    "i8x16.swizzle": { opcode: 0x0e, lanes: Uint8Array, apply: (a, b, i) => (b[i] < 16 ? a[b[i]] : 0) },
+    "i16x8.add_sat_s": { opcode: 0x8f, lanes: Int16Array, apply: (a, b, i) => clamp(a[i] + b[i], -32768, 32767) },
+    "i16x8.sub_sat_u": { opcode: 0x93, lanes: Uint16Array, apply: (a, b, i) => clamp(a[i] - b[i], 0, 65535) },
+    "i16x8.mul": { opcode: 0x95, lanes: Int16Array, apply: (a, b, i) => Math.imul(a[i], b[i]) },
+    "i32x4.add": { opcode: 0xae, lanes: Int32Array, apply: (a, b, i) => a[i] + b[i] },
+    "i32x4.min_s": { opcode: 0xb6, lanes: Int32Array, apply: (a, b, i) => Math.min(a[i], b[i]) },
+    "f32x4.add": { opcode: 0xe4, lanes: Float32Array, apply: (a, b, i) => a[i] + b[i] },
+    "f32x4.mul": { opcode: 0xe6, lanes: Float32Array, apply: (a, b, i) => a[i] * b[i] },
+};
+
+function uleb128(value) {
+    const bytes = [];
+    do {
+        let byte = value & 0x7f;
+        value >>>= 7;
+        if (value !== 0) byte |= 0x80;
+        bytes.push(byte);
+    } while (value !== 0);
+    return bytes;
+}
+
+function section(id, contents) {
+    return [id, ...uleb128(contents.length), ...contents];
+}
+
+function encodeName(name) {
+    return [...uleb128(name.length), ...Array.from(name, c => c.charCodeAt(0))];
+}
+
+function buildModule(names) {
+    const types = section(1, [1, 0x60, 3, 0x7b, 0x7b, 0x7f, 1, 0x7b]);
+    const functions = section(3, [...uleb128(names.length), ...names.map(() => 0)]);
+    const exports = section(7, [
+        ...uleb128(names.length),
+        ...names.flatMap((name, index) => [...encodeName(name), 0x00, ...uleb128(index)]),
+    ]);
+    const bodies = names.flatMap(name => {
+        // prettier-ignore
+        const body = [
+            0x00,
+            0x02, 0x40, 0x03, 0x40,
+            0x20, 2, 0x45, 0x0d, 1,
+            0x20, 0, 0x20, 1, 0xfd, ...uleb128(instructions[name].opcode), 0x21, 0,
+            0x20, 2, 0x41, 1, 0x6b, 0x21, 2,
+            0x0c, 0,
+            0x0b, 0x0b,
+            0x20, 0,
+            0x0b,
+        ];
+        return [...uleb128(body.length), ...body];
+    });
+    const code = section(10, [...uleb128(names.length), ...bodies]);
+    return new Uint8Array([0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, ...types, ...functions, ...exports, ...code]);
+}
+
+function pseudoRandomBytes(seed) {
+    const bytes = new Uint8Array(16);
+    for (let i = 0; i < bytes.length; ++i) {
+        seed = (Math.imul(seed, 1103515245) + 12345) >>> 0;
+        bytes[i] = seed >>> 16;
+    }
+    return bytes;
+}
+
+function reference(instruction, accumulator, operand, iterations) {
+    const result = new instruction.lanes(accumulator.slice().buffer);
+    const other = new instruction.lanes(operand.slice().buffer);
+    for (let iteration = 0; iteration < iterations; ++iteration) {
+        const previous = result.slice();
+        for (let lane = 0; lane < result.length; ++lane) result[lane] = instruction.apply(previous, other, lane);
+    }
+    return new Uint8Array(result.buffer);
+}
+
+const names = Object.keys(instructions);
+const module = parseWebAssemblyModule(buildModule(names));
+
+function run(name, seed, iterations) {
+    const accumulator = pseudoRandomBytes(seed);
+    const operand = pseudoRandomBytes(seed * 31 + 7);
+    // Keep the float lanes finite and the swizzle indices mostly in range, so the loops don't settle immediately.
+    if (instructions[name].lanes === Float32Array) {
+        new Float32Array(accumulator.buffer).forEach((_, i, lanes) => (lanes[i] = (i + 1) * 0.75));
+        new Float32Array(operand.buffer).forEach((_, i, lanes) => (lanes[i] = 1.0001 - i * 0.0002));
+    } else if (name === "i8x16.swizzle") {
+        operand.forEach((byte, i) => (operand[i] = byte % 18));
+    }
+
+    const expected = reference(instructions[name], accumulator, operand, iterations);
+    const result = new Uint8Array(module.invoke(module.getExport(name), accumulator, operand, iterations));
+    expect(Array.from(result)).toEqual(Array.from(expected));
+}
+
+describe("SIMD instructions", () => {
+    for (const name of names) {
+        test(name, () => {
+            for (let seed = 1; seed <= 4; ++seed) {
+                run(name, seed, 1);
+                run(name, seed, 5);
+            }
+        });
+    }
+});
+
+describe("SIMD hot loops", () => {
+    for (const name of names) {
+        test(name, () => {
+            run(name, 42, HOT_LOOP_ITERATIONS);
+        });
+    }
+});
@@ -635,8 +635,15 @@ void AnimationEffect::visit_edges(JS::Cell::Visitor& visitor)
     visitor.visit(m_associated_animation);
 }
 
-static CSS::RequiredInvalidationAfterStyleChange compute_required_invalidation_for_animated_properties(HashMap<CSS::PropertyID, NonnullRefPtr<CSS::StyleValue const>> const& old_properties, HashMap<CSS::PropertyID, NonnullRefPtr<CSS::StyleValue const>> const& new_properties)
+static bool is_transform_property(CSS::PropertyID property_id)
 {
+    return AK::first_is_one_of(property_id, CSS::PropertyID::Transform, CSS::PropertyID::Translate, CSS::PropertyID::Rotate, CSS::PropertyID::Scale, CSS::PropertyID::TransformOrigin);
+}
+
+static CSS::RequiredInvalidationAfterStyleChange compute_required_invalidation_for_animated_properties(HashMap<CSS::PropertyID, NonnullRefPtr<CSS::StyleValue const>> const& old_properties, HashMap<CSS::PropertyID, NonnullRefPtr<CSS::StyleValue const>> const& new_properties, bool& only_opacity_and_transform_changed, bool& transform_changed)
+{
+    only_opacity_and_transform_changed = true;
+    transform_changed = false;
     CSS::RequiredInvalidationAfterStyleChange invalidation;
     auto old_and_new_properties = MUST(Bitmap::create(CSS::number_of_longhand_properties, 0));
     for (auto const& [property_id, _] : old_properties)
@@ -651,7 +658,14 @@ static CSS::RequiredInvalidationAfterStyleChange compute_required_invalidation_f
         auto const* new_value = new_properties.get(property_id).value_or({});
         if (!old_value && !new_value)
             continue;
-        invalidation |= compute_property_invalidation(property_id, old_value, new_value);
+        auto property_invalidation = compute_property_invalidation(property_id, old_value, new_value);
+        if (!property_invalidation.is_none()) {
+            if (is_transform_property(property_id))
+                transform_changed = true;
+            else if (property_id != CSS::PropertyID::Opacity)
+                only_opacity_and_transform_changed = false;
+        }
+        invalidation |= property_invalidation;
     }
     return invalidation;
 }
@@ -664,7 +678,9 @@ AnimationUpdateContext::~AnimationUpdateContext()
             continue;
         auto& element = it.key;
         GC::Ref<DOM::Element> target = element.element();
-        auto invalidation = compute_required_invalidation_for_animated_properties(it.value->animated_properties_before_update, style->animated_property_values());
+        bool only_opacity_and_transform_changed = false;
+        bool transform_changed = false;
+        auto invalidation = compute_required_invalidation_for_animated_properties(it.value->animated_properties_before_update, style->animated_property_values(), only_opacity_and_transform_changed, transform_changed);
 
         if (invalidation.is_none())
             continue;
@@ -674,6 +690,7 @@ AnimationUpdateContext::~AnimationUpdateContext()
             auto element_invalidation = element.recompute_inherited_style();
             if (element_invalidation.is_none())
                 return TraversalDecision::SkipChildrenAndContinue;
+            only_opacity_and_transform_changed = false;
             invalidation |= element_invalidation;
             return TraversalDecision::Continue;
         });
@@ -700,7 +717,18 @@ AnimationUpdateContext::~AnimationUpdateContext()
         if (invalidation.repaint) {
             if (target->paintable())
                 target->paintable()->set_needs_paint_only_properties_update(true);
-            element.document().set_needs_display();
+
+            // OPTIMIZATION: If only the opacity and/or transform of a stacking context changed, we can update them in the
+            //               display list that was already recorded instead of recording a new one.
+            bool const can_update_display_list_in_place = only_opacity_and_transform_changed
+                && !invalidation.relayout
+                && !invalidation.rebuild_layout_tree
+                && !invalidation.rebuild_stacking_context_tree
+                && !element.pseudo_element().has_value()
+                && target->paintable_box()
+                && element.document().update_opacity_in_cached_display_list(*target->paintable_box(), style->opacity())
+                && (!transform_changed || element.document().update_transform_in_cached_display_list(*target->paintable_box()));
+            element.document().set_needs_display(can_update_display_list_in_place ? InvalidateDisplayList::No : InvalidateDisplayList::Yes);
         }
         if (invalidation.rebuild_stacking_context_tree)
             element.document().invalidate_stacking_context_tree();
@@ -15,11 +15,18 @@ namespace Web::Bindings {
 
 GC_DEFINE_ALLOCATOR(Intrinsics);
 
+Intrinsics::Intrinsics(JS::Realm& realm)
+    : m_realm(realm)
+{
+    m_prototype_slots.resize(web_prototype_slot_count);
+}
+
 void Intrinsics::visit_edges(JS::Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_namespaces);
     visitor.visit(m_prototypes);
+    visitor.visit(m_prototype_slots);
     visitor.visit(m_constructors);
     visitor.visit(m_realm);
 }
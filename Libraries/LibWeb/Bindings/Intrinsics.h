@@ -9,33 +9,33 @@
 #include <AK/FlyString.h>
 #include <AK/Forward.h>
 #include <AK/HashMap.h>
+#include <AK/Vector.h>
 #include <LibGC/Heap.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Export.h>
 
-#define WEB_SET_PROTOTYPE_FOR_INTERFACE_WITH_CUSTOM_NAME(interface_class, interface_name)                      \
-    do {                                                                                                       \
-        static auto name = #interface_name##_fly_string;                                                       \
-        if (!shape().prototype()) {                                                                            \
-            set_prototype(&Bindings::ensure_web_prototype<Bindings::interface_class##Prototype>(realm, name)); \
-        }                                                                                                      \
+#define WEB_SET_PROTOTYPE_FOR_INTERFACE_WITH_CUSTOM_NAME(interface_class, interface_name)                \
+    do {                                                                                                 \
+        if (!shape().prototype()) {                                                                      \
+            set_prototype(&Bindings::ensure_web_prototype<Bindings::interface_class##Prototype>(realm)); \
+        }                                                                                                \
     } while (0)
 
 #define WEB_SET_PROTOTYPE_FOR_INTERFACE(interface_name) WEB_SET_PROTOTYPE_FOR_INTERFACE_WITH_CUSTOM_NAME(interface_name, interface_name)
 
 namespace Web::Bindings {
 
+// The number of prototype slots assigned by GenerateWindowOrWorkerInterfaces.
+WEB_API extern u32 const web_prototype_slot_count;
+
 class Intrinsics final : public JS::Cell {
     GC_CELL(Intrinsics, JS::Cell);
     GC_DECLARE_ALLOCATOR(Intrinsics);
 
 public:
-    Intrinsics(JS::Realm& realm)
-        : m_realm(realm)
-    {
-    }
+    explicit Intrinsics(JS::Realm& realm);
 
     template<typename NamespaceType>
     JS::Object& ensure_web_namespace(FlyString const& namespace_name)
@@ -57,6 +57,18 @@ public:
         return *m_prototypes.find(class_name)->value;
     }
 
+    // Every generated prototype class is assigned a slot of its own, so this only has to index into an array, instead of
+    // hashing the name of the interface like the above. This is used whenever a platform object is created.
+    template<typename PrototypeType>
+    JS::Object& ensure_web_prototype()
+    {
+        if (auto prototype = m_prototype_slots[PrototypeType::web_prototype_slot])
+            return *prototype;
+
+        create_web_prototype_and_constructor<PrototypeType>(*m_realm);
+        return *m_prototype_slots[PrototypeType::web_prototype_slot];
+    }
+
     template<typename PrototypeType>
     JS::NativeFunction& ensure_web_constructor(FlyString const& class_name)
     {
@@ -79,8 +91,16 @@ private:
     template<typename PrototypeType>
     void create_web_prototype_and_constructor(JS::Realm& realm);
 
+    template<typename PrototypeType>
+    void set_web_prototype(FlyString const& class_name, GC::Ref<PrototypeType> prototype)
+    {
+        m_prototypes.set(class_name, prototype);
+        m_prototype_slots[PrototypeType::web_prototype_slot] = prototype;
+    }
+
     HashMap<FlyString, GC::Ref<JS::Object>> m_namespaces;
     HashMap<FlyString, GC::Ref<JS::Object>> m_prototypes;
+    Vector<GC::Ptr<JS::Object>> m_prototype_slots;
     HashMap<FlyString, GC::Ptr<JS::NativeFunction>> m_constructors;
     GC::Ref<JS::Realm> m_realm;
 };
@@ -99,6 +119,12 @@ template<typename T>
     return host_defined_intrinsics(realm).ensure_web_prototype<T>(class_name);
 }
 
+template<typename T>
+[[nodiscard]] JS::Object& ensure_web_prototype(JS::Realm& realm)
+{
+    return host_defined_intrinsics(realm).ensure_web_prototype<T>();
+}
+
 template<typename T>
 [[nodiscard]] JS::NativeFunction& ensure_web_constructor(JS::Realm& realm, FlyString const& class_name)
 {
@@ -301,7 +301,7 @@ void CSSStyleSheet::for_each_effective_rule(TraversalOrder order, Function<void(
         m_rules->for_each_effective_rule(order, callback);
 }
 
-void CSSStyleSheet::for_each_effective_style_producing_rule(Function<void(CSSRule const&)> const& callback) const
+void CSSStyleSheet::for_each_effective_style_producing_rule(FunctionRef<void(CSSRule const&)> callback) const
 {
     for_each_effective_rule(TraversalOrder::Preorder, [&](CSSRule const& rule) {
         if (rule.type() == CSSRule::Type::Style || rule.type() == CSSRule::Type::NestedDeclarations)
@@ -309,7 +309,7 @@ void CSSStyleSheet::for_each_effective_style_producing_rule(Function<void(CSSRul
     });
 }
 
-void CSSStyleSheet::for_each_effective_keyframes_at_rule(Function<void(CSSKeyframesRule const&)> const& callback) const
+void CSSStyleSheet::for_each_effective_keyframes_at_rule(FunctionRef<void(CSSKeyframesRule const&)> callback) const
 {
     for_each_effective_rule(TraversalOrder::Preorder, [&](CSSRule const& rule) {
         if (rule.type() == CSSRule::Type::Keyframes)
@@ -46,10 +46,93 @@ namespace Web::CSS {
 
 GC_DEFINE_ALLOCATOR(ComputedProperties);
 
-ComputedProperties::ComputedProperties() = default;
+namespace {
+
+struct PropertyValueGroupLayout {
+    struct Slot {
+        bool is_inherited { false };
+        u16 index { 0 };
+    };
+    Array<Slot, number_of_longhand_properties> slots;
+    u16 inherited_count { 0 };
+    u16 non_inherited_count { 0 };
+};
+
+}
+
+static PropertyValueGroupLayout const& property_value_group_layout()
+{
+    static PropertyValueGroupLayout const layout = [] {
+        PropertyValueGroupLayout layout;
+        for (auto i = to_underlying(first_longhand_property_id); i <= to_underlying(last_longhand_property_id); ++i) {
+            auto& slot = layout.slots[i - to_underlying(first_longhand_property_id)];
+            slot.is_inherited = is_inherited_property(static_cast<PropertyID>(i));
+            slot.index = slot.is_inherited ? layout.inherited_count++ : layout.non_inherited_count++;
+        }
+        return layout;
+    }();
+    return layout;
+}
+
+ComputedProperties::ComputedProperties()
+    : m_inherited_property_values(adopt_ref(*new PropertyValueGroup(property_value_group_layout().inherited_count)))
+    , m_non_inherited_property_values(adopt_ref(*new PropertyValueGroup(property_value_group_layout().non_inherited_count)))
+{
+}
 
 ComputedProperties::~ComputedProperties() = default;
 
+RefPtr<StyleValue const> const& ComputedProperties::value_slot(PropertyID property_id) const
+{
+    auto slot = property_value_group_layout().slots[to_underlying(property_id) - to_underlying(first_longhand_property_id)];
+    auto const& group = slot.is_inherited ? m_inherited_property_values : m_non_inherited_property_values;
+    return group->values[slot.index];
+}
+
+RefPtr<StyleValue const>& ComputedProperties::mutable_value_slot(PropertyID property_id)
+{
+    auto slot = property_value_group_layout().slots[to_underlying(property_id) - to_underlying(first_longhand_property_id)];
+    auto& group = slot.is_inherited ? m_inherited_property_values : m_non_inherited_property_values;
+    if (group->ref_count() > 1)
+        group = adopt_ref(*new PropertyValueGroup(*group));
+    return group->values[slot.index];
+}
+
+void ComputedProperties::share_inherited_property_values_if_equal(ComputedProperties const& parent)
+{
+    if (m_inherited_property_values.ptr() == parent.m_inherited_property_values.ptr())
+        return;
+
+    // NOTE: Inherited values are copied from the parent as-is, so comparing pointers is enough to find the common case.
+    auto const& values = m_inherited_property_values->values;
+    auto const& parent_values = parent.m_inherited_property_values->values;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (values[i] != parent_values[i])
+            return;
+    }
+    m_inherited_property_values = parent.m_inherited_property_values;
+}
+
+GC::Ref<ComputedProperties> ComputedProperties::clone(GC::Heap& heap) const
+{
+    auto clone = heap.allocate<ComputedProperties>();
+    clone->m_animation_name_source = m_animation_name_source;
+    clone->m_transition_property_source = m_transition_property_source;
+    clone->m_inherited_property_values = m_inherited_property_values;
+    clone->m_non_inherited_property_values = m_non_inherited_property_values;
+    clone->m_property_important = m_property_important;
+    clone->m_property_inherited = m_property_inherited;
+    clone->m_animated_property_inherited = m_animated_property_inherited;
+    clone->m_animated_property_values = m_animated_property_values;
+    clone->m_display_before_box_type_transformation = m_display_before_box_type_transformation;
+    clone->m_math_depth = m_math_depth;
+    clone->m_font_list = m_font_list;
+    clone->m_first_available_computed_font = m_first_available_computed_font;
+    clone->m_line_height = m_line_height;
+    clone->m_attempted_pseudo_class_matches = m_attempted_pseudo_class_matches;
+    return clone;
+}
+
 void ComputedProperties::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
@@ -118,7 +201,9 @@ void ComputedProperties::set_property(PropertyID id, NonnullRefPtr<StyleValue co
 {
     VERIFY(id >= first_longhand_property_id && id <= last_longhand_property_id);
 
-    m_property_values[to_underlying(id) - to_underlying(first_longhand_property_id)] = move(value);
+    // NOTE: Avoid unsharing the property value group if the value didn't change.
+    if (value_slot(id) != value.ptr())
+        mutable_value_slot(id) = move(value);
     set_property_important(id, important);
     set_property_inherited(id, inherited);
 }
@@ -127,7 +212,7 @@ void ComputedProperties::revert_property(PropertyID id, ComputedProperties const
 {
     VERIFY(id >= first_longhand_property_id && id <= last_longhand_property_id);
 
-    m_property_values[to_underlying(id) - to_underlying(first_longhand_property_id)] = style_for_revert.m_property_values[to_underlying(id) - to_underlying(first_longhand_property_id)];
+    mutable_value_slot(id) = style_for_revert.value_slot(id);
     set_property_important(id, style_for_revert.is_property_important(id) ? Important::Yes : Important::No);
     set_property_inherited(id, style_for_revert.is_property_inherited(id) ? Inherited::Yes : Inherited::No);
 }
@@ -168,7 +253,7 @@ StyleValue const& ComputedProperties::property(PropertyID property_id, WithAnima
     }
 
     // By the time we call this method, all properties have values assigned.
-    return *m_property_values[to_underlying(property_id) - to_underlying(first_longhand_property_id)];
+    return *value_slot(property_id);
 }
 
 Variant<LengthPercentage, NormalGap> ComputedProperties::gap_value(PropertyID id) const
@@ -814,9 +899,13 @@ Positioning ComputedProperties::position() const
 
 bool ComputedProperties::operator==(ComputedProperties const& other) const
 {
-    for (size_t i = 0; i < m_property_values.size(); ++i) {
-        auto const& my_style = m_property_values[i];
-        auto const& other_style = other.m_property_values[i];
+    if (m_inherited_property_values.ptr() == other.m_inherited_property_values.ptr()
+        && m_non_inherited_property_values.ptr() == other.m_non_inherited_property_values.ptr())
+        return true;
+
+    for (auto i = to_underlying(first_longhand_property_id); i <= to_underlying(last_longhand_property_id); ++i) {
+        auto const& my_style = value_slot(static_cast<PropertyID>(i));
+        auto const& other_style = other.value_slot(static_cast<PropertyID>(i));
         if (!my_style) {
             if (other_style)
                 return false;
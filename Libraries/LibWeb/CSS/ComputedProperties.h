@@ -9,6 +9,7 @@
 
 #include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGC/Ptr.h>
 #include <LibGfx/Font/Font.h>
@@ -34,15 +35,21 @@ public:
 
     virtual ~ComputedProperties() override;
 
+    [[nodiscard]] GC::Ref<ComputedProperties> clone(GC::Heap&) const;
+
     template<typename Callback>
     inline void for_each_property(Callback callback) const
     {
-        for (size_t i = 0; i < m_property_values.size(); ++i) {
-            if (m_property_values[i])
-                callback(static_cast<PropertyID>(i + to_underlying(first_longhand_property_id)), *m_property_values[i]);
+        for (auto i = to_underlying(first_longhand_property_id); i <= to_underlying(last_longhand_property_id); ++i) {
+            auto property_id = static_cast<PropertyID>(i);
+            if (auto const& value = value_slot(property_id))
+                callback(property_id, *value);
         }
     }
 
+    // If all inherited property values are the same as the parent's, drop ours and share the parent's instead.
+    void share_inherited_property_values_if_equal(ComputedProperties const& parent);
+
     enum class Inherited {
         No,
         Yes
@@ -261,6 +268,11 @@ public:
         return m_attempted_pseudo_class_matches.get(pseudo_class);
     }
 
+    bool has_attempted_match_against_any_pseudo_class() const
+    {
+        return !m_attempted_pseudo_class_matches.is_empty();
+    }
+
     void set_attempted_pseudo_class_matches(PseudoClassBitmap const& results)
     {
         m_attempted_pseudo_class_matches = results;
@@ -274,10 +286,27 @@ private:
     Overflow overflow(PropertyID) const;
     Vector<ShadowData> shadow(PropertyID, Layout::Node const&) const;
 
+    // Property values are split into a group of inherited and a group of non-inherited properties. Each group is
+    // reference-counted and copied on write, so computed properties that were cloned or that only inherit from their
+    // parent don't need their own copy of every value.
+    struct PropertyValueGroup : public RefCounted<PropertyValueGroup> {
+        explicit PropertyValueGroup(size_t size) { values.resize(size); }
+        PropertyValueGroup(PropertyValueGroup const& other)
+            : values(other.values)
+        {
+        }
+
+        Vector<RefPtr<StyleValue const>> values;
+    };
+
+    RefPtr<StyleValue const> const& value_slot(PropertyID) const;
+    RefPtr<StyleValue const>& mutable_value_slot(PropertyID);
+
     GC::Ptr<CSSStyleDeclaration const> m_animation_name_source;
     GC::Ptr<CSSStyleDeclaration const> m_transition_property_source;
 
-    Array<RefPtr<StyleValue const>, number_of_longhand_properties> m_property_values;
+    NonnullRefPtr<PropertyValueGroup> m_inherited_property_values;
+    NonnullRefPtr<PropertyValueGroup> m_non_inherited_property_values;
     Array<u8, ceil_div(number_of_longhand_properties, 8uz)> m_property_important {};
     Array<u8, ceil_div(number_of_longhand_properties, 8uz)> m_property_inherited {};
     Array<u8, ceil_div(number_of_longhand_properties, 8uz)> m_animated_property_inherited {};
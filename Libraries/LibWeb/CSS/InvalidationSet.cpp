@@ -21,7 +21,7 @@ bool InvalidationSet::is_empty() const
     return !m_needs_invalidate_self && !m_needs_invalidate_whole_subtree && m_properties.is_empty();
 }
 
-void InvalidationSet::for_each_property(Function<IterationDecision(Property const&)> const& callback) const
+void InvalidationSet::for_each_property(FunctionRef<IterationDecision(Property const&)> callback) const
 {
     if (m_needs_invalidate_self) {
         if (callback({ Property::Type::InvalidateSelf }) == IterationDecision::Break)
@@ -9,6 +9,7 @@
 #include <AK/FlyString.h>
 #include <AK/Format.h>
 #include <AK/Forward.h>
+#include <AK/FunctionRef.h>
 #include <AK/HashTable.h>
 #include <AK/Traits.h>
 #include <LibWeb/CSS/PseudoClass.h>
@@ -52,7 +53,7 @@ public:
 
     bool is_empty() const;
     bool has_properties() const { return !m_properties.is_empty(); }
-    void for_each_property(Function<IterationDecision(Property const&)> const& callback) const;
+    void for_each_property(FunctionRef<IterationDecision(Property const&)> callback) const;
 
 private:
     bool m_needs_invalidate_self { false };
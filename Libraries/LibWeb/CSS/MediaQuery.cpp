@@ -306,6 +306,15 @@ bool MediaQuery::evaluate(DOM::Document const& document)
         VERIFY_NOT_REACHED();
     };
 
+    // OPTIMIZATION: Identical media queries are common, both within and across style sheets, so share their results
+    //               for as long as the document's media features stay the same.
+    if (!m_serialization.has_value())
+        m_serialization = to_string();
+    if (auto cached_result = document.cached_media_query_result(*m_serialization); cached_result.has_value()) {
+        m_matches = *cached_result;
+        return m_matches;
+    }
+
     MatchResult result = matches_media(m_media_type);
 
     if ((result != MatchResult::False) && m_media_condition)
@@ -315,6 +324,7 @@ bool MediaQuery::evaluate(DOM::Document const& document)
         result = negate(result);
 
     m_matches = result == MatchResult::True;
+    document.cache_media_query_result(*m_serialization, m_matches);
     return m_matches;
 }
 
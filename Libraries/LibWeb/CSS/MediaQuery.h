@@ -231,6 +231,9 @@ private:
 
     // Cached value, updated by evaluate()
     bool m_matches { false };
+
+    // Used as the key for sharing evaluation results between identical media queries.
+    mutable Optional<String> m_serialization;
 };
 
 String serialize_a_media_query_list(Vector<NonnullRefPtr<MediaQuery>> const&);
@@ -13,6 +13,7 @@
  */
 
 #include <AK/Debug.h>
+#include <AK/NeverDestroyed.h>
 #include <LibURL/Parser.h>
 #include <LibWeb/CSS/CSSMarginRule.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
@@ -183,6 +184,72 @@ GC::Ref<CSS::CSSStyleSheet> Parser::parse_as_css_stylesheet(Optional<::URL::URL>
     return CSSStyleSheet::create(realm(), rule_list, media_list, move(location));
 }
 
+// The rules produced by parsing a stylesheet only depend on its text, so they can be shared between documents.
+struct CachedStyleSheetRules : public RefCounted<CachedStyleSheetRules> {
+    CachedStyleSheetRules(Optional<::URL::URL> location, u32 source_hash, String source, Vector<Rule> rules)
+        : location(move(location))
+        , source_hash(source_hash)
+        , source(move(source))
+        , rules(move(rules))
+    {
+    }
+
+    Optional<::URL::URL> location;
+    u32 source_hash { 0 };
+    String source;
+    Vector<Rule> rules;
+};
+
+// NOTE: Small stylesheets (like most inline <style> elements) are cheap enough to parse that caching them isn't worth it.
+static constexpr size_t minimum_style_sheet_length_for_cache = 4 * KiB;
+static constexpr size_t max_cached_style_sheets = 16;
+
+// Ordered from least to most recently used.
+static Vector<NonnullRefPtr<CachedStyleSheetRules>>& cached_style_sheet_rules()
+{
+    static NeverDestroyed<Vector<NonnullRefPtr<CachedStyleSheetRules>>> cache;
+    return *cache;
+}
+
+GC::Ref<CSS::CSSStyleSheet> Parser::parse_as_css_stylesheet_using_cache(ParsingParams const& context, StringView input, Optional<::URL::URL> location, Vector<NonnullRefPtr<MediaQuery>> media_query_list)
+{
+    if (input.length() < minimum_style_sheet_length_for_cache)
+        return Parser::create(context, input).parse_as_css_stylesheet(move(location), move(media_query_list));
+
+    auto& cache = cached_style_sheet_rules();
+    auto source_hash = input.hash();
+
+    RefPtr<CachedStyleSheetRules> cached_rules;
+    for (size_t i = 0; i < cache.size(); ++i) {
+        auto& entry = cache[i];
+        if (entry->source_hash != source_hash || entry->location != location || entry->source != input)
+            continue;
+        cached_rules = entry;
+        cache.remove(i);
+        cache.append(*cached_rules);
+        break;
+    }
+
+    if (!cached_rules) {
+        auto parser = Parser::create(context, input);
+        auto style_sheet = parser.parse_a_stylesheet(parser.m_token_stream, location);
+        cached_rules = adopt_ref(*new CachedStyleSheetRules(location, source_hash, MUST(String::from_utf8(input)), move(style_sheet.rules)));
+        if (cache.size() >= max_cached_style_sheets)
+            cache.take_first();
+        cache.append(*cached_rules);
+    }
+
+    Parser parser { context, {} };
+    auto rule_list = CSSRuleList::create(parser.realm(), parser.convert_rules(cached_rules->rules));
+    auto media_list = MediaList::create(parser.realm(), move(media_query_list));
+    return CSSStyleSheet::create(parser.realm(), rule_list, media_list, move(location));
+}
+
+void Parser::clear_style_sheet_cache()
+{
+    cached_style_sheet_rules().clear();
+}
+
 RefPtr<Supports> Parser::parse_as_supports()
 {
     return parse_a_supports(m_token_stream);
@@ -120,6 +120,11 @@ public:
     GC::RootVector<GC::Ref<CSSRule>> convert_rules(Vector<Rule> const& raw_rules);
     GC::Ref<CSS::CSSStyleSheet> parse_as_css_stylesheet(Optional<::URL::URL> location, Vector<NonnullRefPtr<MediaQuery>> media_query_list = {});
 
+    // Like parse_as_css_stylesheet(), but reuses the rules of a large stylesheet with the same location and text
+    // that was parsed earlier in this process, so that only the conversion into CSSOM objects has to happen again.
+    static GC::Ref<CSS::CSSStyleSheet> parse_as_css_stylesheet_using_cache(ParsingParams const&, StringView input, Optional<::URL::URL> location, Vector<NonnullRefPtr<MediaQuery>> media_query_list = {});
+    static void clear_style_sheet_cache();
+
     struct PropertiesAndCustomProperties {
         Vector<StyleProperty> properties;
         OrderedHashMap<FlyString, StyleProperty> custom_properties;
@@ -5,7 +5,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
 #include <AK/Debug.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/SourceLocation.h>
 #include <AK/StringConversions.h>
 #include <AK/Vector.h>
@@ -25,6 +28,53 @@ static inline void log_parse_error(SourceLocation const& location = SourceLocati
     dbgln_if(CSS_TOKENIZER_DEBUG, "Parse error (css tokenization) {} ", location);
 }
 
+// Returns the length of the run of bytes at the start of the given bytes for which the predicate holds. The predicate
+// is applied to 16 bytes at a time, and must return a vector with all bits set in lanes where it holds.
+template<typename Predicate>
+static size_t length_of_byte_run(ReadonlyBytes bytes, Predicate predicate)
+{
+    using AK::SIMD::u8x16;
+    using AK::SIMD::u64x2;
+
+    size_t offset = 0;
+    for (; offset + sizeof(u8x16) <= bytes.size(); offset += sizeof(u8x16)) {
+        auto chunk = AK::SIMD::load_unaligned<u8x16>(bytes.offset_pointer(offset));
+        auto mask = bit_cast<u64x2>(predicate(chunk));
+        if ((mask[0] & mask[1]) == NumericLimits<u64>::max())
+            continue;
+        // Find the first lane where the predicate failed.
+        for (size_t lane = 0; lane < 2; ++lane) {
+            if (mask[lane] != NumericLimits<u64>::max())
+                return offset + lane * 8 + (count_trailing_zeroes(~mask[lane]) / 8);
+        }
+    }
+
+    // Do the remaining bytes one at a time, using a vector with just one byte in it.
+    for (; offset < bytes.size(); ++offset) {
+        u8x16 chunk {};
+        chunk[0] = bytes[offset];
+        if (predicate(chunk)[0] == 0)
+            return offset;
+    }
+    return offset;
+}
+
+static ALWAYS_INLINE auto is_ascii_ident_code_point(AK::SIMD::u8x16 chunk)
+{
+    auto lowercased = chunk | 0x20;
+    return ((lowercased >= 'a') & (lowercased <= 'z')) | ((chunk >= '0') & (chunk <= '9')) | (chunk == '_') | (chunk == '-');
+}
+
+static ALWAYS_INLINE auto is_ascii_whitespace(AK::SIMD::u8x16 chunk)
+{
+    return (chunk == ' ') | (chunk == '\t') | (chunk == '\n');
+}
+
+static ALWAYS_INLINE auto is_ascii_and_not_filterable(AK::SIMD::u8x16 chunk)
+{
+    return (chunk < 0x80) & (chunk != '\r') & (chunk != '\f') & (chunk != 0);
+}
+
 static inline bool is_eof(u32 code_point)
 {
     return code_point == TOKENIZER_EOF;
@@ -164,6 +214,11 @@ Vector<Token> Tokenizer::tokenize(StringView input, StringView encoding)
 
         auto decoded_input = MUST(decoder->to_utf8(input));
 
+        // OPTIMIZATION: If the input is all ASCII, we can check for filterable characters without decoding it.
+        auto decoded_bytes = decoded_input.bytes();
+        if (length_of_byte_run(decoded_bytes, is_ascii_and_not_filterable) == decoded_bytes.size())
+            return decoded_input;
+
         // OPTIMIZATION: If the input doesn't contain any filterable characters, we can skip the filtering
         bool const contains_filterable = [&] {
             for (auto code_point : decoded_input.code_points()) {
@@ -547,6 +602,10 @@ FlyString Tokenizer::consume_an_ident_sequence()
 
     // Repeatedly consume the next input code point from the stream:
     for (;;) {
+        // OPTIMIZATION: Consume runs of ASCII name code points in bulk.
+        if (auto run = consume_ascii_run(length_of_byte_run(remaining_input_bytes(), is_ascii_ident_code_point)); !run.is_empty())
+            result.append(run);
+
         auto input = next_code_point();
 
         if (is_eof(input))
@@ -703,6 +762,9 @@ void Tokenizer::consume_the_remnants_of_a_bad_url()
 
 void Tokenizer::consume_as_much_whitespace_as_possible()
 {
+    // OPTIMIZATION: Skip over runs of whitespace in bulk.
+    consume_ascii_run(length_of_byte_run(remaining_input_bytes(), is_ascii_whitespace));
+
     while (is_whitespace(peek_code_point())) {
         (void)next_code_point();
     }
@@ -877,6 +939,13 @@ Token Tokenizer::consume_string_token(u32 ending_code_point)
 
     // Repeatedly consume the next input code point from the stream:
     for (;;) {
+        // OPTIMIZATION: Consume runs of ASCII code points that need no special handling in bulk.
+        auto run_length = length_of_byte_run(remaining_input_bytes(), [ending_code_point](auto chunk) {
+            return (chunk < 0x80) & (chunk != '\n') & (chunk != '\\') & (chunk != static_cast<u8>(ending_code_point));
+        });
+        if (auto run = consume_ascii_run(run_length); !run.is_empty())
+            builder.append(run);
+
         auto input = next_code_point();
 
         // ending code point
@@ -959,6 +1028,9 @@ start:
         }
 
         (void)next_code_point();
+
+        // OPTIMIZATION: Skip ahead to the next asterisk in bulk.
+        consume_ascii_run(length_of_byte_run(remaining_input_bytes(), [](auto chunk) { return (chunk < 0x80) & (chunk != '*'); }));
     }
 }
 
@@ -1233,6 +1305,35 @@ size_t Tokenizer::current_byte_offset() const
     return m_utf8_iterator.ptr() - m_utf8_view.bytes();
 }
 
+ReadonlyBytes Tokenizer::remaining_input_bytes() const
+{
+    return m_decoded_input.bytes().slice(current_byte_offset());
+}
+
+StringView Tokenizer::consume_ascii_run(size_t length)
+{
+    if (length == 0)
+        return {};
+
+    auto start_byte_offset = current_byte_offset();
+    auto run = m_decoded_input.bytes_as_string_view().substring_view(start_byte_offset, length);
+
+    // NOTE: Keep the state as if the last code point of the run was consumed through next_code_point(), so that
+    //       it can still be reconsumed.
+    for (size_t i = 0; i < length; ++i) {
+        m_prev_position = m_position;
+        if (is_newline(run[i])) {
+            m_position.line++;
+            m_position.column = 0;
+        } else {
+            m_position.column++;
+        }
+    }
+    m_prev_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(start_byte_offset + length - 1);
+    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(start_byte_offset + length);
+    return run;
+}
+
 String Tokenizer::input_since(size_t offset) const
 {
     return MUST(m_decoded_input.substring_from_byte_offset_with_shared_superstring(offset, current_byte_offset() - offset));
@@ -72,6 +72,10 @@ private:
     size_t current_byte_offset() const;
     String input_since(size_t offset) const;
 
+    ReadonlyBytes remaining_input_bytes() const;
+    // Consumes the given number of ASCII bytes as code points and returns them.
+    StringView consume_ascii_run(size_t length);
+
     [[nodiscard]] u32 next_code_point();
     [[nodiscard]] u32 peek_code_point(size_t offset = 0) const;
     [[nodiscard]] U32Twin peek_twin() const;
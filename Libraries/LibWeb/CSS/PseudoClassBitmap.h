@@ -30,6 +30,8 @@ public:
         return (m_bits & (1LLU << index)) != 0;
     }
 
+    bool is_empty() const { return m_bits == 0; }
+
     void operator|=(PseudoClassBitmap const& other)
     {
         m_bits |= other.m_bits;
@@ -80,6 +80,7 @@
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/NamedNodeMap.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/Fetch/Infrastructure/FetchController.h>
 #include <LibWeb/Fetch/Response.h>
@@ -478,6 +479,26 @@ InvalidationSet StyleComputer::invalidation_set_for_properties(Vector<Invalidati
     return result;
 }
 
+bool StyleComputer::attribute_change_may_affect_selectors(FlyString const& attribute_name, Optional<String> const& old_value, Optional<String> const& new_value) const
+{
+    if (!m_style_invalidation_data)
+        return true;
+
+    auto usage = m_style_invalidation_data->attribute_value_usage.get(attribute_name.to_ascii_lowercase());
+    if (!usage.has_value())
+        return false;
+
+    // Adding or removing the attribute can always change which selectors match.
+    if (old_value.has_value() != new_value.has_value())
+        return true;
+    if (!old_value.has_value() || usage->depends_on_any_value)
+        return true;
+
+    // Only exact value matches care about the value, so the change matters if either value is one of them.
+    return usage->exact_values.contains(old_value->to_ascii_lowercase())
+        || usage->exact_values.contains(new_value->to_ascii_lowercase());
+}
+
 bool StyleComputer::invalidation_property_used_in_has_selector(InvalidationSet::Property const& property) const
 {
     if (!m_style_invalidation_data)
@@ -546,8 +567,11 @@ Vector<MatchingRule const*> StyleComputer::collect_matching_rules(DOM::AbstractE
             return;
 
         auto const& selector = rule_to_run.selector;
-        if (selector.can_use_ancestor_filter() && should_reject_with_ancestor_filter(selector))
+        if (selector.can_use_ancestor_filter() && should_reject_with_ancestor_filter(selector)) {
+            if (m_statistics)
+                ++m_statistics->rules_rejected_by_ancestor_filter;
             return;
+        }
 
         rules_to_run.unchecked_append(rule_to_run);
     };
@@ -617,9 +641,15 @@ Vector<MatchingRule const*> StyleComputer::collect_matching_rules(DOM::AbstractE
         ScopeGuard guard = [&] {
             attempted_pseudo_class_matches |= context.attempted_pseudo_class_matches;
         };
+        if (selector.is_slotted() && !abstract_element.element().assigned_slot_internal())
+            continue;
+
+        Optional<MonotonicTime> match_start_time;
+        if (m_statistics)
+            match_start_time = MonotonicTime::now();
+
+        bool matches = false;
         if (selector.is_slotted()) {
-            if (!abstract_element.element().assigned_slot_internal())
-                continue;
             // We're collecting rules for element, which is assigned to a slot.
             // For ::slotted() matching, slot should be used as a subject instead of element,
             // while element itself is saved in matching context, so selector engine could
@@ -627,9 +657,15 @@ Vector<MatchingRule const*> StyleComputer::collect_matching_rules(DOM::AbstractE
             auto const& slot = *abstract_element.element().assigned_slot_internal();
             context.slotted_element = &abstract_element.element();
             context.subject = &slot;
-            if (!SelectorEngine::matches(selector, slot, shadow_host_to_use, context, PseudoElement::Slotted))
-                continue;
-        } else if (!SelectorEngine::matches(selector, abstract_element.element(), shadow_host_to_use, context, abstract_element.pseudo_element()))
+            matches = SelectorEngine::matches(selector, slot, shadow_host_to_use, context, PseudoElement::Slotted);
+        } else {
+            matches = SelectorEngine::matches(selector, abstract_element.element(), shadow_host_to_use, context, abstract_element.pseudo_element());
+        }
+
+        if (m_statistics)
+            m_statistics->did_try_selector(selector, matches, MonotonicTime::now() - *match_start_time);
+
+        if (!matches)
             continue;
         matching_rules.append(&rule_to_run);
     }
@@ -2344,11 +2380,23 @@ GC::Ref<ComputedProperties> StyleComputer::create_document_style() const
 
 GC::Ref<ComputedProperties> StyleComputer::compute_style(DOM::AbstractElement abstract_element, Optional<bool&> did_change_custom_properties) const
 {
+    if (m_statistics) {
+        auto start_time = MonotonicTime::now();
+        auto style = compute_style_impl(abstract_element, ComputeStyleMode::Normal, did_change_custom_properties);
+        m_statistics->did_compute_style(abstract_element, MonotonicTime::now() - start_time);
+        return *style;
+    }
     return *compute_style_impl(abstract_element, ComputeStyleMode::Normal, did_change_custom_properties);
 }
 
 GC::Ptr<ComputedProperties> StyleComputer::compute_pseudo_element_style_if_needed(DOM::AbstractElement abstract_element, Optional<bool&> did_change_custom_properties) const
 {
+    if (m_statistics) {
+        auto start_time = MonotonicTime::now();
+        auto style = compute_style_impl(abstract_element, ComputeStyleMode::CreatePseudoElementStyleIfNeeded, did_change_custom_properties);
+        m_statistics->did_compute_style(abstract_element, MonotonicTime::now() - start_time);
+        return style;
+    }
     return compute_style_impl(abstract_element, ComputeStyleMode::CreatePseudoElementStyleIfNeeded, did_change_custom_properties);
 }
 
@@ -2381,6 +2429,11 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::AbstractEleme
 
     ScopeGuard guard { [&abstract_element]() { abstract_element.element().set_needs_style_update(false); } };
 
+    if (mode == ComputeStyleMode::Normal && !abstract_element.pseudo_element().has_value()) {
+        if (auto shared_style = share_style_with_sibling_if_possible(abstract_element.element(), did_change_custom_properties))
+            return shared_style;
+    }
+
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
     PseudoClassBitmap attempted_pseudo_class_matches;
@@ -2440,6 +2493,104 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::AbstractEleme
     return computed_properties;
 }
 
+// Style that doesn't depend on anything but the element's parent, its tag and its attributes can be shared with a
+// sibling that has the same tag and attributes, without running selector matching or the cascade again.
+static bool has_attributes_that_allow_sharing_style(DOM::Element const& element)
+{
+    // NOTE: IDs are unique, and inline style may be modified through CSSOM without touching the attribute.
+    if (element.id().has_value())
+        return false;
+    if (auto inline_style = element.inline_style(); inline_style && inline_style->length() > 0)
+        return false;
+    return true;
+}
+
+static bool can_ever_share_style(DOM::Element const& element)
+{
+    return !element.use_pseudo_element().has_value()
+        && !element.is_shadow_host()
+        && !element.assigned_slot_internal()
+        && !element.has_associated_animations()
+        && !element.cached_animation_name_animation({})
+        && has_attributes_that_allow_sharing_style(element);
+}
+
+static bool can_share_style_with(DOM::Element const& element, DOM::Element const& candidate)
+{
+    auto candidate_style = candidate.computed_properties();
+    if (!candidate_style || candidate.needs_style_update())
+        return false;
+
+    // The candidate's style must not have depended on anything that can differ between siblings. Since both elements
+    // are tested against the same rules, an empty set of attempted pseudo-class matches means that neither element's
+    // state nor its position among its siblings could have mattered.
+    if (candidate_style->has_attempted_match_against_any_pseudo_class()
+        || candidate.style_affected_by_structural_changes()
+        || candidate.affected_by_has_pseudo_class_in_subject_position()
+        || candidate.affected_by_has_pseudo_class_in_non_subject_position()
+        || candidate.affected_by_has_pseudo_class_with_relative_selector_that_has_sibling_combinator())
+        return false;
+
+    // Animations and transitions are started per element, so elements that have them never share.
+    if (candidate_style->animation_name_source() || candidate_style->transition_property_source())
+        return false;
+    if (auto element_style = element.computed_properties(); element_style && (element_style->animation_name_source() || element_style->transition_property_source()))
+        return false;
+
+    if (!can_ever_share_style(element) || !can_ever_share_style(candidate))
+        return false;
+
+    if (element.local_name() != candidate.local_name() || element.namespace_uri() != candidate.namespace_uri())
+        return false;
+
+    // NOTE: This covers the class list and the style attribute as well.
+    auto attributes = element.attributes();
+    auto candidate_attributes = candidate.attributes();
+    auto attribute_count = attributes ? attributes->length() : 0;
+    auto candidate_attribute_count = candidate_attributes ? candidate_attributes->length() : 0;
+    if (attribute_count != candidate_attribute_count)
+        return false;
+    for (u32 i = 0; i < attribute_count; ++i) {
+        auto const& attribute = *attributes->item(i);
+        auto const& candidate_attribute = *candidate_attributes->item(i);
+        if (attribute.local_name() != candidate_attribute.local_name()
+            || attribute.namespace_uri() != candidate_attribute.namespace_uri()
+            || attribute.value() != candidate_attribute.value())
+            return false;
+    }
+
+    return true;
+}
+
+GC::Ptr<ComputedProperties> StyleComputer::share_style_with_sibling_if_possible(DOM::Element& element, Optional<bool&> did_change_custom_properties) const
+{
+    // NOTE: We only look at a few preceding siblings, which is enough to catch long runs of identical list items,
+    //       table rows and the like without making unshareable elements noticeably more expensive.
+    static constexpr size_t max_style_sharing_candidates = 4;
+
+    if (!element.parent_element())
+        return {};
+
+    size_t candidates_checked = 0;
+    for (auto* candidate = element.previous_element_sibling(); candidate && candidates_checked < max_style_sharing_candidates; candidate = candidate->previous_element_sibling(), ++candidates_checked) {
+        if (!can_share_style_with(element, *candidate))
+            continue;
+
+        if (did_change_custom_properties.has_value() && element.custom_properties({}) != candidate->custom_properties({}))
+            *did_change_custom_properties = true;
+        element.set_custom_properties({}, candidate->custom_properties({}));
+        element.set_cascaded_properties({}, candidate->cascaded_properties({}));
+        if (candidate->style_uses_attr_css_function())
+            element.set_style_uses_attr_css_function();
+        if (candidate->style_uses_var_css_function())
+            element.set_style_uses_var_css_function();
+
+        // NOTE: The style is cloned, since computed properties get mutated per element (e.g. by animations).
+        return candidate->computed_properties()->clone(document().heap());
+    }
+    return {};
+}
+
 static bool is_monospace(StyleValue const& value)
 {
     if (value.to_keyword() == Keyword::Monospace)
@@ -2684,6 +2835,11 @@ GC::Ref<ComputedProperties> StyleComputer::compute_properties(DOM::AbstractEleme
         start_needed_transitions(*previous_style, computed_style, abstract_element);
     }
 
+    if (auto parent = abstract_element.element_to_inherit_style_from(); parent.has_value()) {
+        if (auto parent_style = parent->computed_properties())
+            computed_style->share_inherited_property_values_if_equal(*parent_style);
+    }
+
     return computed_style;
 }
 
@@ -2727,6 +2883,10 @@ static Optional<SimplifiedSelectorForBucketing> is_roundabout_selector_bucketabl
         return SimplifiedSelectorForBucketing { inner_simple_selector.type, inner_simple_selector.qualified_name().name.lowercase_name };
     }
 
+    if (inner_simple_selector.type == CSS::Selector::SimpleSelector::Type::Attribute) {
+        return SimplifiedSelectorForBucketing { inner_simple_selector.type, inner_simple_selector.attribute().qualified_name.name.lowercase_name };
+    }
+
     return {};
 }
 
@@ -3768,6 +3928,15 @@ static void for_each_element_hash(DOM::Element const& element, auto callback)
     });
 }
 
+void StyleComputer::set_collects_statistics(bool collects_statistics)
+{
+    if (!collects_statistics) {
+        m_statistics = nullptr;
+        return;
+    }
+    m_statistics = make<StyleStatistics>();
+}
+
 void StyleComputer::reset_ancestor_filter()
 {
     m_ancestor_filter->clear();
@@ -3873,11 +4042,16 @@ void RuleCache::add_rule(MatchingRule const& matching_rule, Optional<PseudoEleme
     } else if (contains_root_pseudo_class) {
         root_rules.append(matching_rule);
     } else {
+        // NOTE: Selectors like `:is/where([foo])` are bucketed as attribute selectors for `foo`.
         for (auto const& simple_selector : matching_rule.selector.compound_selectors().last().simple_selectors) {
             if (simple_selector.type == Selector::SimpleSelector::Type::Attribute) {
                 rules_by_attribute_name.ensure(simple_selector.attribute().qualified_name.name.lowercase_name).append(matching_rule);
                 return;
             }
+            if (auto simplified = is_roundabout_selector_bucketable_as_something_simpler(simple_selector); simplified.has_value() && simplified->type == Selector::SimpleSelector::Type::Attribute) {
+                rules_by_attribute_name.ensure(simplified->name).append(matching_rule);
+                return;
+            }
         }
         other_rules.append(matching_rule);
     }
@@ -3915,14 +4089,20 @@ void RuleCache::for_each_matching_rules(DOM::AbstractElement abstract_element, F
             return;
     }
 
-    IterationDecision decision = IterationDecision::Continue;
-    abstract_element.element().for_each_attribute([&](auto& name, auto&) {
-        if (auto it = rules_by_attribute_name.find(name); it != rules_by_attribute_name.end()) {
-            decision = callback(it->value);
-        }
-    });
-    if (decision == IterationDecision::Break)
-        return;
+    // OPTIMIZATION: Most elements have a few attributes that no selector is keyed on, so avoid looking up each of
+    //               them when there are no attribute buckets at all.
+    if (!rules_by_attribute_name.is_empty()) {
+        IterationDecision decision = IterationDecision::Continue;
+        abstract_element.element().for_each_attribute([&](auto& name, auto&) {
+            if (decision == IterationDecision::Break)
+                return;
+            if (auto it = rules_by_attribute_name.find(name); it != rules_by_attribute_name.end()) {
+                decision = callback(it->value);
+            }
+        });
+        if (decision == IterationDecision::Break)
+            return;
+    }
 
     (void)callback(other_rules);
 }
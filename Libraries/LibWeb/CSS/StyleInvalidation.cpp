@@ -66,6 +66,13 @@ RequiredInvalidationAfterStyleChange compute_property_invalidation(CSS::Property
         if (old_value_opacity != new_value_opacity && (old_value_opacity == 1 || new_value_opacity == 1)) {
             invalidation.rebuild_stacking_context_tree = true;
         }
+    } else if (AK::first_is_one_of(property_id, CSS::PropertyID::Transform, CSS::PropertyID::Translate, CSS::PropertyID::Rotate, CSS::PropertyID::Scale) && old_value && new_value) {
+        // OPTIMIZATION: Only a change from or to `none` decides whether the element creates a stacking context, so a
+        //               transform changing between two other values doesn't require a stacking context tree rebuild.
+        auto old_value_is_none = old_value->to_keyword() == CSS::Keyword::None;
+        auto new_value_is_none = new_value->to_keyword() == CSS::Keyword::None;
+        if (old_value_is_none != new_value_is_none)
+            invalidation.rebuild_stacking_context_tree = true;
     } else if (CSS::property_affects_stacking_context(property_id)) {
         invalidation.rebuild_stacking_context_tree = true;
     }
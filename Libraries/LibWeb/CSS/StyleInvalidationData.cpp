@@ -41,8 +41,29 @@ static void for_each_consecutive_simple_selector_group(Selector const& selector,
     }
 }
 
+static void collect_attribute_value_usage(Selector::SimpleSelector::Attribute const& attribute, StyleInvalidationData& style_invalidation_data)
+{
+    auto& usage = style_invalidation_data.attribute_value_usage.ensure(attribute.qualified_name.name.lowercase_name);
+    switch (attribute.match_type) {
+    case Selector::SimpleSelector::Attribute::MatchType::HasAttribute:
+        // Only the presence of the attribute matters, which is always considered.
+        break;
+    case Selector::SimpleSelector::Attribute::MatchType::ExactValueMatch:
+        usage.exact_values.set(attribute.value.to_ascii_lowercase());
+        break;
+    default:
+        usage.depends_on_any_value = true;
+        break;
+    }
+}
+
 static void collect_properties_used_in_has(Selector::SimpleSelector const& selector, StyleInvalidationData& style_invalidation_data, bool in_has)
 {
+    // NOTE: This visits every simple selector, including those nested in pseudo-class arguments, so it's also where we
+    //       note which attribute values are used by selectors.
+    if (selector.type == Selector::SimpleSelector::Type::Attribute)
+        collect_attribute_value_usage(selector.attribute(), style_invalidation_data);
+
     switch (selector.type) {
     case Selector::SimpleSelector::Type::Id: {
         if (in_has)
@@ -13,7 +13,15 @@
 namespace Web::CSS {
 
 struct StyleInvalidationData {
+    // Which values of an attribute selectors can distinguish. Attribute values are stored lowercased, so that
+    // comparing them never misses a case-insensitive match.
+    struct AttributeValueUsage {
+        bool depends_on_any_value { false };
+        HashTable<String> exact_values;
+    };
+
     HashMap<InvalidationSet::Property, InvalidationSet> descendant_invalidation_sets;
+    HashMap<FlyString, AttributeValueUsage> attribute_value_usage;
     HashTable<FlyString> ids_used_in_has_selectors;
     HashTable<FlyString> class_names_used_in_has_selectors;
     HashTable<FlyString> attribute_names_used_in_has_selectors;
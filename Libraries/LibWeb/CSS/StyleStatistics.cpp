@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <LibWeb/CSS/StyleStatistics.h>
+#include <LibWeb/DOM/AbstractElement.h>
+
+namespace Web::CSS {
+
+void StyleStatistics::did_try_selector(Selector const& selector, bool matched, AK::Duration time_spent)
+{
+    ++rules_tried;
+    if (matched)
+        ++rules_matched;
+
+    auto& statistics = selectors.ensure(&selector, [&] { return SelectorStatistics { .selector = selector }; });
+    ++statistics.times_tried;
+    if (matched)
+        ++statistics.times_matched;
+    statistics.time_spent += time_spent;
+}
+
+void StyleStatistics::did_compute_style(DOM::AbstractElement abstract_element, AK::Duration time_spent)
+{
+    ++elements_styled;
+    time_spent_computing_style += time_spent;
+    if (time_spent > longest_time_spent_on_one_element) {
+        longest_time_spent_on_one_element = time_spent;
+        slowest_element = abstract_element.debug_description();
+    }
+}
+
+static double to_milliseconds(AK::Duration duration)
+{
+    return static_cast<double>(duration.to_nanoseconds()) / 1'000'000.0;
+}
+
+String StyleStatistics::to_string(size_t max_selector_count) const
+{
+    StringBuilder builder;
+    builder.appendff("Elements styled: {} in {:.3}ms", elements_styled, to_milliseconds(time_spent_computing_style));
+    if (elements_styled > 0)
+        builder.appendff(" (slowest: {:.3}ms for {})", to_milliseconds(longest_time_spent_on_one_element), slowest_element);
+    builder.append('\n');
+    builder.appendff("Rules rejected by ancestor filter: {}\n", rules_rejected_by_ancestor_filter);
+    builder.appendff("Rules tried: {}\n", rules_tried);
+    builder.appendff("Rules matched: {}\n", rules_matched);
+
+    Vector<SelectorStatistics const*> sorted_selectors;
+    sorted_selectors.ensure_capacity(selectors.size());
+    for (auto const& it : selectors)
+        sorted_selectors.unchecked_append(&it.value);
+    quick_sort(sorted_selectors, [](auto const* a, auto const* b) {
+        if (a->time_spent != b->time_spent)
+            return a->time_spent > b->time_spent;
+        return a->times_tried > b->times_tried;
+    });
+
+    auto selector_count = min(max_selector_count, sorted_selectors.size());
+    builder.appendff("Most expensive selectors ({} of {}):\n", selector_count, sorted_selectors.size());
+    for (size_t i = 0; i < selector_count; ++i) {
+        auto const& statistics = *sorted_selectors[i];
+        builder.appendff("  {:.3}ms, tried {}, matched {}: {}\n", to_milliseconds(statistics.time_spent), statistics.times_tried, statistics.times_matched, statistics.selector->serialize());
+    }
+    return builder.to_string_without_validation();
+}
+
+}
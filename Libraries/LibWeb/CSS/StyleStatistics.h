@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <LibWeb/CSS/Selector.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::CSS {
+
+// Opt-in instrumentation of style computation, collected by the StyleComputer while enabled. This is meant to
+// find out which selectors make style recalculation slow on a given page.
+struct StyleStatistics {
+    struct SelectorStatistics {
+        NonnullRefPtr<Selector const> selector;
+        u64 times_tried { 0 };
+        u64 times_matched { 0 };
+        AK::Duration time_spent;
+    };
+
+    u64 elements_styled { 0 };
+    AK::Duration time_spent_computing_style;
+    AK::Duration longest_time_spent_on_one_element;
+    String slowest_element;
+
+    u64 rules_rejected_by_ancestor_filter { 0 };
+    u64 rules_tried { 0 };
+    u64 rules_matched { 0 };
+
+    HashMap<Selector const*, SelectorStatistics> selectors;
+
+    void did_try_selector(Selector const&, bool matched, AK::Duration time_spent);
+    void did_compute_style(DOM::AbstractElement, AK::Duration time_spent);
+
+    String to_string(size_t max_selector_count) const;
+};
+
+}
@@ -78,6 +78,26 @@ static Vector<Bindings::KeyUsage> usage_intersection(ReadonlySpan<Bindings::KeyU
 // Out of line to ensure this class has a key function
 AlgorithmMethods::~AlgorithmMethods() = default;
 
+WebIDL::ExceptionOr<ByteBuffer> byte_operation_result(JS::Realm& realm, ErrorOr<ByteBuffer> result)
+{
+    if (!result.is_error())
+        return result.release_value();
+
+    auto error = result.release_error();
+    if (error.is_errno() && error.code() == ENOMEM)
+        return realm.vm().throw_completion<JS::InternalError>(realm.vm().error_message(JS::VM::ErrorMessage::OutOfMemory));
+    return WebIDL::OperationError::create(realm, Utf16String::from_utf8(error.string_literal()));
+}
+
+WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> AlgorithmMethods::perform(WebIDL::ExceptionOr<Optional<ByteOperation>> operation, ReadonlyBytes input)
+{
+    auto maybe_operation = TRY(operation);
+    VERIFY(maybe_operation.has_value());
+
+    auto result = TRY(byte_operation_result(m_realm, (*maybe_operation)(input)));
+    return JS::ArrayBuffer::create(m_realm, move(result));
+}
+
 // https://w3c.github.io/webcrypto/#big-integer
 static ::Crypto::UnsignedBigInteger big_integer_from_api_big_integer(GC::Ptr<JS::Uint8Array> const& big_integer)
 {
@@ -604,6 +624,12 @@ JS::ThrowCompletionOr<NonnullOwnPtr<AlgorithmParams>> Ed448Params::from_value(JS
 
 // https://w3c.github.io/webcrypto/#rsa-oaep-operations
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> RSAOAEP::encrypt(AlgorithmParams const& params, GC::Ref<CryptoKey> key, ByteBuffer const& plaintext)
+{
+    return perform(encrypt_operation(params, key), plaintext);
+}
+
+// https://w3c.github.io/webcrypto/#rsa-oaep-operations
+WebIDL::ExceptionOr<Optional<ByteOperation>> RSAOAEP::encrypt_operation(AlgorithmParams const& params, GC::Ref<CryptoKey> key)
 {
     auto& realm = *m_realm;
     auto& vm = realm.vm();
@@ -637,20 +663,28 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> RSAOAEP::encrypt(AlgorithmParams c
     if (!hash_kind.has_value())
         return WebIDL::OperationError::create(realm, Utf16String::formatted("Invalid hash function '{}'", hash));
 
-    // 5. Let ciphertext be the value C that results from performing the operation.
-    auto rsa = ::Crypto::PK::RSA_OAEP_EME { *hash_kind, public_key };
-    rsa.set_label(label);
+    return ByteOperation { [hash_kind = *hash_kind, public_key = move(public_key), label](ReadonlyBytes plaintext) -> ErrorOr<ByteBuffer> {
+        // 5. Let ciphertext be the value C that results from performing the operation.
+        auto rsa = ::Crypto::PK::RSA_OAEP_EME { hash_kind, public_key };
+        rsa.set_label(label);
 
-    auto maybe_ciphertext = rsa.encrypt(plaintext);
-    if (maybe_ciphertext.is_error())
-        return WebIDL::OperationError::create(realm, "Failed to encrypt"_utf16);
+        auto maybe_ciphertext = rsa.encrypt(plaintext);
+        if (maybe_ciphertext.is_error())
+            return Error::from_string_literal("Failed to encrypt");
 
-    // 6. Return the result of creating an ArrayBuffer containing ciphertext.
-    return JS::ArrayBuffer::create(realm, maybe_ciphertext.release_value());
+        // 6. Return the result of creating an ArrayBuffer containing ciphertext.
+        return maybe_ciphertext.release_value();
+    } };
 }
 
 // https://w3c.github.io/webcrypto/#rsa-oaep-operations
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> RSAOAEP::decrypt(AlgorithmParams const& params, GC::Ref<CryptoKey> key, AK::ByteBuffer const& ciphertext)
+{
+    return perform(decrypt_operation(params, key), ciphertext);
+}
+
+// https://w3c.github.io/webcrypto/#rsa-oaep-operations
+WebIDL::ExceptionOr<Optional<ByteOperation>> RSAOAEP::decrypt_operation(AlgorithmParams const& params, GC::Ref<CryptoKey> key)
 {
     auto& realm = *m_realm;
     auto& vm = realm.vm();
@@ -684,16 +718,18 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> RSAOAEP::decrypt(AlgorithmParams c
     if (!hash_kind.has_value())
         return WebIDL::OperationError::create(realm, Utf16String::formatted("Invalid hash function '{}'", hash));
 
-    // 5. Let plaintext the value M that results from performing the operation.
-    auto rsa = ::Crypto::PK::RSA_OAEP_EME { *hash_kind, private_key };
-    rsa.set_label(label);
+    return ByteOperation { [hash_kind = *hash_kind, private_key = move(private_key), label](ReadonlyBytes ciphertext) -> ErrorOr<ByteBuffer> {
+        // 5. Let plaintext the value M that results from performing the operation.
+        auto rsa = ::Crypto::PK::RSA_OAEP_EME { hash_kind, private_key };
+        rsa.set_label(label);
 
-    auto maybe_plaintext = rsa.decrypt(ciphertext);
-    if (maybe_plaintext.is_error())
-        return WebIDL::OperationError::create(realm, "Failed to encrypt"_utf16);
+        auto maybe_plaintext = rsa.decrypt(ciphertext);
+        if (maybe_plaintext.is_error())
+            return Error::from_string_literal("Failed to encrypt");
 
-    // 6. Return the result of creating an ArrayBuffer containing plaintext.
-    return JS::ArrayBuffer::create(realm, maybe_plaintext.release_value());
+        // 6. Return the result of creating an ArrayBuffer containing plaintext.
+        return maybe_plaintext.release_value();
+    } };
 }
 
 // https://w3c.github.io/webcrypto/#rsa-oaep-operations
@@ -1267,6 +1303,12 @@ WebIDL::ExceptionOr<Variant<GC::Ref<CryptoKey>, GC::Ref<CryptoKeyPair>>> RSAPSS:
 
 // https://w3c.github.io/webcrypto/#rsa-pss-operations
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> RSAPSS::sign(AlgorithmParams const& params, GC::Ref<CryptoKey> key, ByteBuffer const& message)
+{
+    return perform(sign_operation(params, key), message);
+}
+
+// https://w3c.github.io/webcrypto/#rsa-pss-operations
+WebIDL::ExceptionOr<Optional<ByteOperation>> RSAPSS::sign_operation(AlgorithmParams const& params, GC::Ref<CryptoKey> key)
 {
     auto& realm = *m_realm;
     auto& vm = realm.vm();
@@ -1275,7 +1317,7 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> RSAPSS::sign(AlgorithmParams const
     if (key->type() != Bindings::KeyType::Private)
         return WebIDL::InvalidAccessError::create(realm, "Key is not a private key"_utf16);
 
-    auto const& private_key = key->handle().get<::Crypto::PK::RSAPrivateKey>();
+    auto private_key = key->handle().get<::Crypto::PK::RSAPrivateKey>();
     auto pss_params = static_cast<RsaPssParams const&>(params);
     auto hash = TRY(as<RsaHashedKeyAlgorithm>(*key->algorithm()).hash().name(vm));
 
@@ -1297,16 +1339,18 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> RSAPSS::sign(AlgorithmParams const
     if (!hash_kind.has_value())
         return WebIDL::OperationError::create(realm, Utf16String::formatted("Invalid hash function '{}'", hash));
 
-    // 5. Let signature be the signature, S, that results from performing the operation.
-    auto rsa = ::Crypto::PK::RSA_PSS_EMSA { *hash_kind, private_key };
-    rsa.set_salt_length(pss_params.salt_length);
+    return ByteOperation { [hash_kind = *hash_kind, private_key = move(private_key), salt_length = pss_params.salt_length](ReadonlyBytes message) -> ErrorOr<ByteBuffer> {
+        // 5. Let signature be the signature, S, that results from performing the operation.
+        auto rsa = ::Crypto::PK::RSA_PSS_EMSA { hash_kind, private_key };
+        rsa.set_salt_length(salt_length);
 
-    auto maybe_signature = rsa.sign(message);
-    if (maybe_signature.is_error())
-        return WebIDL::OperationError::create(realm, "Failed to sign message"_utf16);
+        auto maybe_signature = rsa.sign(message);
+        if (maybe_signature.is_error())
+            return Error::from_string_literal("Failed to sign message");
 
-    // 6. Return signature.
-    return JS::ArrayBuffer::create(realm, maybe_signature.release_value());
+        // 6. Return signature.
+        return maybe_signature.release_value();
+    } };
 }
 
 // https://w3c.github.io/webcrypto/#rsa-pss-operations
@@ -1849,7 +1893,13 @@ WebIDL::ExceptionOr<Variant<GC::Ref<CryptoKey>, GC::Ref<CryptoKeyPair>>> RSASSAP
 }
 
 // https://w3c.github.io/webcrypto/#rsassa-pkcs1-operations
-WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> RSASSAPKCS1::sign(AlgorithmParams const&, GC::Ref<CryptoKey> key, ByteBuffer const& message)
+WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> RSASSAPKCS1::sign(AlgorithmParams const& params, GC::Ref<CryptoKey> key, ByteBuffer const& message)
+{
+    return perform(sign_operation(params, key), message);
+}
+
+// https://w3c.github.io/webcrypto/#rsassa-pkcs1-operations
+WebIDL::ExceptionOr<Optional<ByteOperation>> RSASSAPKCS1::sign_operation(AlgorithmParams const&, GC::Ref<CryptoKey> key)
 {
     auto& realm = *m_realm;
     auto& vm = realm.vm();
@@ -1858,7 +1908,7 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> RSASSAPKCS1::sign(AlgorithmParams
     if (key->type() != Bindings::KeyType::Private)
         return WebIDL::InvalidAccessError::create(realm, "Key is not a private key"_utf16);
 
-    auto const& private_key = key->handle().get<::Crypto::PK::RSAPrivateKey>();
+    auto private_key = key->handle().get<::Crypto::PK::RSAPrivateKey>();
     auto hash = TRY(as<RsaHashedKeyAlgorithm>(*key->algorithm()).hash().name(vm));
 
     // 3. Perform the signature generation operation defined in Section 8.2 of [RFC3447] with the key represented by the [[handle]] internal slot
@@ -1878,15 +1928,17 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> RSASSAPKCS1::sign(AlgorithmParams
     if (!hash_kind.has_value())
         return WebIDL::OperationError::create(realm, Utf16String::formatted("Invalid hash function '{}'", hash));
 
-    // 5. Let signature be the signature, S, that results from performing the operation.
-    auto rsa = ::Crypto::PK::RSA_PKCS1_EMSA { *hash_kind, private_key };
+    return ByteOperation { [hash_kind = *hash_kind, private_key = move(private_key)](ReadonlyBytes message) -> ErrorOr<ByteBuffer> {
+        // 5. Let signature be the signature, S, that results from performing the operation.
+        auto rsa = ::Crypto::PK::RSA_PKCS1_EMSA { hash_kind, private_key };
 
-    auto maybe_signature = rsa.sign(message);
-    if (maybe_signature.is_error())
-        return WebIDL::OperationError::create(realm, "Failed to sign message"_utf16);
+        auto maybe_signature = rsa.sign(message);
+        if (maybe_signature.is_error())
+            return Error::from_string_literal("Failed to sign message");
 
-    // 6. Return signature.
-    return JS::ArrayBuffer::create(realm, maybe_signature.release_value());
+        // 6. Return signature.
+        return maybe_signature.release_value();
+    } };
 }
 
 // https://w3c.github.io/webcrypto/#rsassa-pkcs1-operations
@@ -2355,6 +2407,12 @@ WebIDL::ExceptionOr<GC::Ref<JS::Object>> RSASSAPKCS1::export_key(Bindings::KeyFo
 
 // https://w3c.github.io/webcrypto/#aes-cbc-operations
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> AesCbc::encrypt(AlgorithmParams const& params, GC::Ref<CryptoKey> key, ByteBuffer const& plaintext)
+{
+    return perform(encrypt_operation(params, key), plaintext);
+}
+
+// https://w3c.github.io/webcrypto/#aes-cbc-operations
+WebIDL::ExceptionOr<Optional<ByteOperation>> AesCbc::encrypt_operation(AlgorithmParams const& params, GC::Ref<CryptoKey> key)
 {
     auto const& normalized_algorithm = static_cast<AesCbcParams const&>(params);
 
@@ -2362,21 +2420,27 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> AesCbc::encrypt(AlgorithmParams co
     if (normalized_algorithm.iv.size() != 16)
         return WebIDL::OperationError::create(m_realm, "IV to AES-CBC must be exactly 16 bytes"_utf16);
 
-    // 2. Let paddedPlaintext be the result of adding padding octets to the contents of plaintext according to the procedure defined in Section 10.3 of [RFC2315], step 2, with a value of k of 16.
-    // 3. Let ciphertext be the result of performing the CBC Encryption operation described in Section 6.2 of [NIST-SP800-38A] using AES as the block cipher, the contents of the iv member of normalizedAlgorithm as the IV input parameter and paddedPlaintext as the input plaintext.
-    auto key_bytes = key->handle().get<ByteBuffer>();
-
-    ::Crypto::Cipher::AESCBCCipher cipher(key_bytes);
-    auto maybe_ciphertext = cipher.encrypt(plaintext, normalized_algorithm.iv);
-    if (maybe_ciphertext.is_error())
-        return WebIDL::OperationError::create(m_realm, "Failed to encrypt"_utf16);
-
-    // 4. Return the result of creating an ArrayBuffer containing ciphertext.
-    return JS::ArrayBuffer::create(m_realm, maybe_ciphertext.release_value());
+    return ByteOperation { [key_bytes = key->handle().get<ByteBuffer>(), iv = normalized_algorithm.iv](ReadonlyBytes plaintext) -> ErrorOr<ByteBuffer> {
+        // 2. Let paddedPlaintext be the result of adding padding octets to the contents of plaintext according to the procedure defined in Section 10.3 of [RFC2315], step 2, with a value of k of 16.
+        // 3. Let ciphertext be the result of performing the CBC Encryption operation described in Section 6.2 of [NIST-SP800-38A] using AES as the block cipher, the contents of the iv member of normalizedAlgorithm as the IV input parameter and paddedPlaintext as the input plaintext.
+        ::Crypto::Cipher::AESCBCCipher cipher(key_bytes);
+        auto maybe_ciphertext = cipher.encrypt(plaintext, iv);
+        if (maybe_ciphertext.is_error())
+            return Error::from_string_literal("Failed to encrypt");
+
+        // 4. Return the result of creating an ArrayBuffer containing ciphertext.
+        return maybe_ciphertext.release_value();
+    } };
 }
 
 // https://w3c.github.io/webcrypto/#aes-cbc-operations-decrypt
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> AesCbc::decrypt(AlgorithmParams const& params, GC::Ref<CryptoKey> key, ByteBuffer const& ciphertext)
+{
+    return perform(decrypt_operation(params, key), ciphertext);
+}
+
+// https://w3c.github.io/webcrypto/#aes-cbc-operations-decrypt
+WebIDL::ExceptionOr<Optional<ByteOperation>> AesCbc::decrypt_operation(AlgorithmParams const& params, GC::Ref<CryptoKey> key)
 {
     auto const& normalized_algorithm = static_cast<AesCbcParams const&>(params);
 
@@ -2384,21 +2448,23 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> AesCbc::decrypt(AlgorithmParams co
     if (normalized_algorithm.iv.size() != 16)
         return WebIDL::OperationError::create(m_realm, "IV to AES-CBC must be exactly 16 bytes"_utf16);
 
-    // 2. If the length of ciphertext is zero or is not a multiple of 16 bytes, then throw an OperationError.
-    if (ciphertext.is_empty() || ciphertext.size() % 16 != 0)
-        return WebIDL::OperationError::create(m_realm, "Ciphertext length must be a multiple of 16 bytes"_utf16);
-
-    // 3. Let paddedPlaintext be the result of performing the CBC Decryption operation described in Section 6.2 of [NIST-SP800-38A] using AES as the block cipher, the iv member of normalizedAlgorithm as the IV input parameter and ciphertext as the input ciphertext.
-    // 4. Let p be the value of the last octet of paddedPlaintext.
-    // 5. If p is zero or greater than 16, or if any of the last p octets of paddedPlaintext have a value which is not p, then throw an OperationError.
-    // 6. Let plaintext be the result of removing p octets from the end of paddedPlaintext.
-    ::Crypto::Cipher::AESCBCCipher cipher(key->handle().get<ByteBuffer>());
-    auto maybe_plaintext = cipher.decrypt(ciphertext, normalized_algorithm.iv);
-    if (maybe_plaintext.is_error())
-        return WebIDL::OperationError::create(m_realm, "Failed to decrypt"_utf16);
-
-    // 7. Return plaintext.
-    return JS::ArrayBuffer::create(m_realm, maybe_plaintext.release_value());
+    return ByteOperation { [key_bytes = key->handle().get<ByteBuffer>(), iv = normalized_algorithm.iv](ReadonlyBytes ciphertext) -> ErrorOr<ByteBuffer> {
+        // 2. If the length of ciphertext is zero or is not a multiple of 16 bytes, then throw an OperationError.
+        if (ciphertext.is_empty() || ciphertext.size() % 16 != 0)
+            return Error::from_string_literal("Ciphertext length must be a multiple of 16 bytes");
+
+        // 3. Let paddedPlaintext be the result of performing the CBC Decryption operation described in Section 6.2 of [NIST-SP800-38A] using AES as the block cipher, the iv member of normalizedAlgorithm as the IV input parameter and ciphertext as the input ciphertext.
+        // 4. Let p be the value of the last octet of paddedPlaintext.
+        // 5. If p is zero or greater than 16, or if any of the last p octets of paddedPlaintext have a value which is not p, then throw an OperationError.
+        // 6. Let plaintext be the result of removing p octets from the end of paddedPlaintext.
+        ::Crypto::Cipher::AESCBCCipher cipher(key_bytes);
+        auto maybe_plaintext = cipher.decrypt(ciphertext, iv);
+        if (maybe_plaintext.is_error())
+            return Error::from_string_literal("Failed to decrypt");
+
+        // 7. Return plaintext.
+        return maybe_plaintext.release_value();
+    } };
 }
 
 // https://w3c.github.io/webcrypto/#aes-cbc-operations
@@ -2889,6 +2955,11 @@ WebIDL::ExceptionOr<Variant<GC::Ref<CryptoKey>, GC::Ref<CryptoKeyPair>>> AesCtr:
 }
 
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> AesCtr::encrypt(AlgorithmParams const& params, GC::Ref<CryptoKey> key, ByteBuffer const& plaintext)
+{
+    return perform(encrypt_operation(params, key), plaintext);
+}
+
+WebIDL::ExceptionOr<Optional<ByteOperation>> AesCtr::encrypt_operation(AlgorithmParams const& params, GC::Ref<CryptoKey> key)
 {
     // 1. If the counter member of normalizedAlgorithm does not have length 16 bytes, then throw an OperationError.
     auto const& normalized_algorithm = static_cast<AesCtrParams const&>(params);
@@ -2901,21 +2972,28 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> AesCtr::encrypt(AlgorithmParams co
     if (length == 0 || length > 128)
         return WebIDL::OperationError::create(m_realm, "Invalid length"_utf16);
 
-    // 3. Let ciphertext be the result of performing the CTR Encryption operation described in Section 6.5 of [NIST-SP800-38A] using
-    //    AES as the block cipher,
-    //    the contents of the counter member of normalizedAlgorithm as the initial value of the counter block,
-    //    the length member of normalizedAlgorithm as the input parameter m to the standard counter block incrementing function defined in Appendix B.1 of [NIST-SP800-38A]
-    //    and the contents of plaintext as the input plaintext.
-    ::Crypto::Cipher::AESCTRCipher cipher(key->handle().get<ByteBuffer>());
-    auto maybe_ciphertext = cipher.encrypt(plaintext, counter);
-    if (maybe_ciphertext.is_error())
-        return WebIDL::OperationError::create(m_realm, "Encryption failed"_utf16);
-
-    // 4. Return the result of creating an ArrayBuffer containing plaintext.
-    return JS::ArrayBuffer::create(m_realm, maybe_ciphertext.release_value());
+    return ByteOperation { [key_bytes = key->handle().get<ByteBuffer>(), counter](ReadonlyBytes plaintext) -> ErrorOr<ByteBuffer> {
+        // 3. Let ciphertext be the result of performing the CTR Encryption operation described in Section 6.5 of [NIST-SP800-38A] using
+        //    AES as the block cipher,
+        //    the contents of the counter member of normalizedAlgorithm as the initial value of the counter block,
+        //    the length member of normalizedAlgorithm as the input parameter m to the standard counter block incrementing function defined in Appendix B.1 of [NIST-SP800-38A]
+        //    and the contents of plaintext as the input plaintext.
+        ::Crypto::Cipher::AESCTRCipher cipher(key_bytes);
+        auto maybe_ciphertext = cipher.encrypt(plaintext, counter);
+        if (maybe_ciphertext.is_error())
+            return Error::from_string_literal("Encryption failed");
+
+        // 4. Return the result of creating an ArrayBuffer containing plaintext.
+        return maybe_ciphertext.release_value();
+    } };
 }
 
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> AesCtr::decrypt(AlgorithmParams const& params, GC::Ref<CryptoKey> key, ByteBuffer const& ciphertext)
+{
+    return perform(decrypt_operation(params, key), ciphertext);
+}
+
+WebIDL::ExceptionOr<Optional<ByteOperation>> AesCtr::decrypt_operation(AlgorithmParams const& params, GC::Ref<CryptoKey> key)
 {
     // 1. If the counter member of normalizedAlgorithm does not have length 16 bytes, then throw an OperationError.
     auto const& normalized_algorithm = static_cast<AesCtrParams const&>(params);
@@ -2928,18 +3006,20 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> AesCtr::decrypt(AlgorithmParams co
     if (length == 0 || length > 128)
         return WebIDL::OperationError::create(m_realm, "Invalid length"_utf16);
 
-    // 3. Let plaintext be the result of performing the CTR Decryption operation described in Section 6.5 of [NIST-SP800-38A] using
-    //    AES as the block cipher,
-    //    the contents of the counter member of normalizedAlgorithm as the initial value of the counter block,
-    //    the length member of normalizedAlgorithm as the input parameter m to the standard counter block incrementing function defined in Appendix B.1 of [NIST-SP800-38A]
-    //    and the contents of ciphertext as the input ciphertext.
-    ::Crypto::Cipher::AESCTRCipher cipher(key->handle().get<ByteBuffer>());
-    auto maybe_plaintext = cipher.decrypt(ciphertext, counter);
-    if (maybe_plaintext.is_error())
-        return WebIDL::OperationError::create(m_realm, "Decryption failed"_utf16);
-
-    // 4. Return the result of creating an ArrayBuffer containing plaintext.
-    return JS::ArrayBuffer::create(m_realm, maybe_plaintext.release_value());
+    return ByteOperation { [key_bytes = key->handle().get<ByteBuffer>(), counter](ReadonlyBytes ciphertext) -> ErrorOr<ByteBuffer> {
+        // 3. Let plaintext be the result of performing the CTR Decryption operation described in Section 6.5 of [NIST-SP800-38A] using
+        //    AES as the block cipher,
+        //    the contents of the counter member of normalizedAlgorithm as the initial value of the counter block,
+        //    the length member of normalizedAlgorithm as the input parameter m to the standard counter block incrementing function defined in Appendix B.1 of [NIST-SP800-38A]
+        //    and the contents of ciphertext as the input ciphertext.
+        ::Crypto::Cipher::AESCTRCipher cipher(key_bytes);
+        auto maybe_plaintext = cipher.decrypt(ciphertext, counter);
+        if (maybe_plaintext.is_error())
+            return Error::from_string_literal("Decryption failed");
+
+        // 4. Return the result of creating an ArrayBuffer containing plaintext.
+        return maybe_plaintext.release_value();
+    } };
 }
 
 WebIDL::ExceptionOr<JS::Value> AesGcm::get_key_length(AlgorithmParams const& params)
@@ -3141,12 +3221,15 @@ WebIDL::ExceptionOr<GC::Ref<JS::Object>> AesGcm::export_key(Bindings::KeyFormat
 }
 
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> AesGcm::encrypt(AlgorithmParams const& params, GC::Ref<CryptoKey> key, ByteBuffer const& plaintext)
+{
+    return perform(encrypt_operation(params, key), plaintext);
+}
+
+WebIDL::ExceptionOr<Optional<ByteOperation>> AesGcm::encrypt_operation(AlgorithmParams const& params, GC::Ref<CryptoKey> key)
 {
     auto const& normalized_algorithm = static_cast<AesGcmParams const&>(params);
 
-    // 1. If plaintext has a length greater than 2^39 - 256 bytes, then throw an OperationError.
-    if (plaintext.size() > (1ULL << 39) - 256)
-        return WebIDL::OperationError::create(m_realm, "Invalid plaintext length"_utf16);
+    // NOTE: Step 1 is performed by the returned operation, as it depends on the plaintext.
 
     // 2. If the iv member of normalizedAlgorithm has a length greater than 2^64 - 1 bytes, then throw an OperationError.
     // NOTE: This is not possible
@@ -3171,28 +3254,39 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> AesGcm::encrypt(AlgorithmParams co
     // 5. Let additionalData be the contents of the additionalData member of normalizedAlgorithm if present or the empty octet string otherwise.
     auto additional_data = normalized_algorithm.additional_data.value_or(ByteBuffer {});
 
-    // 6. Let C and T be the outputs that result from performing the Authenticated Encryption Function described in Section 7.1 of [NIST-SP800-38D] using
-    //    AES as the block cipher,
-    //    the contents of the iv member of normalizedAlgorithm as the IV input parameter,
-    //    the contents of additionalData as the A input parameter,
-    //    tagLength as the t pre-requisite
-    //    and the contents of plaintext as the input plaintext.
-    ::Crypto::Cipher::AESGCMCipher cipher(key->handle().get<ByteBuffer>());
-    auto maybe_encrypted = cipher.encrypt(plaintext, normalized_algorithm.iv, additional_data, tag_length / 8);
-    if (maybe_encrypted.is_error()) {
-        return WebIDL::OperationError::create(m_realm, "Encryption failed"_utf16);
-    }
+    return ByteOperation { [key_bytes = key->handle().get<ByteBuffer>(), iv = normalized_algorithm.iv, additional_data = move(additional_data), tag_length](ReadonlyBytes plaintext) -> ErrorOr<ByteBuffer> {
+        // 1. If plaintext has a length greater than 2^39 - 256 bytes, then throw an OperationError.
+        if (plaintext.size() > (1ULL << 39) - 256)
+            return Error::from_string_literal("Invalid plaintext length");
+
+        // 6. Let C and T be the outputs that result from performing the Authenticated Encryption Function described in Section 7.1 of [NIST-SP800-38D] using
+        //    AES as the block cipher,
+        //    the contents of the iv member of normalizedAlgorithm as the IV input parameter,
+        //    the contents of additionalData as the A input parameter,
+        //    tagLength as the t pre-requisite
+        //    and the contents of plaintext as the input plaintext.
+        ::Crypto::Cipher::AESGCMCipher cipher(key_bytes);
+        auto maybe_encrypted = cipher.encrypt(plaintext, iv, additional_data, tag_length / 8);
+        if (maybe_encrypted.is_error()) {
+            return Error::from_string_literal("Encryption failed");
+        }
 
-    auto [ciphertext, tag] = maybe_encrypted.release_value();
+        auto [ciphertext, tag] = maybe_encrypted.release_value();
 
-    // 7. Let ciphertext be equal to C | T, where '|' denotes concatenation.
-    TRY_OR_THROW_OOM(m_realm->vm(), ciphertext.try_append(tag));
+        // 7. Let ciphertext be equal to C | T, where '|' denotes concatenation.
+        TRY(ciphertext.try_append(tag));
 
-    // 8. Return the result of creating an ArrayBuffer containing ciphertext.
-    return JS::ArrayBuffer::create(m_realm, ciphertext);
+        // 8. Return the result of creating an ArrayBuffer containing ciphertext.
+        return move(ciphertext);
+    } };
 }
 
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> AesGcm::decrypt(AlgorithmParams const& params, GC::Ref<CryptoKey> key, ByteBuffer const& ciphertext)
+{
+    return perform(decrypt_operation(params, key), ciphertext);
+}
+
+WebIDL::ExceptionOr<Optional<ByteOperation>> AesGcm::decrypt_operation(AlgorithmParams const& params, GC::Ref<CryptoKey> key)
 {
     auto const& normalized_algorithm = static_cast<AesGcmParams const&>(params);
 
@@ -3210,44 +3304,46 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> AesGcm::decrypt(AlgorithmParams co
     else
         return WebIDL::OperationError::create(m_realm, "Invalid tag length"_utf16);
 
-    // 2. If ciphertext has a length less than tagLength bits, then throw an OperationError.
-    if (ciphertext.size() < tag_length / 8)
-        return WebIDL::OperationError::create(m_realm, "Invalid ciphertext length"_utf16);
-
     // 3. If the iv member of normalizedAlgorithm has a length greater than 2^64 - 1 bytes, then throw an OperationError.
     // NOTE: This is not possible
 
     // 4. If the additionalData member of normalizedAlgorithm is present and has a length greater than 2^64 - 1 bytes, then throw an OperationError.
     // NOTE: This is not possible
 
-    // 5. Let tag be the last tagLength bits of ciphertext.
-    auto tag_bytes = tag_length / 8;
-    auto tag = TRY_OR_THROW_OOM(m_realm->vm(), ciphertext.slice(ciphertext.size() - tag_bytes, tag_bytes));
-
-    // 6. Let actualCiphertext be the result of removing the last tagLength bits from ciphertext.
-    auto actual_ciphertext = TRY_OR_THROW_OOM(m_realm->vm(), ciphertext.slice(0, ciphertext.size() - tag_bytes));
-
     // 7. Let additionalData be the contents of the additionalData member of normalizedAlgorithm if present or the empty octet string otherwise.
     auto additional_data = normalized_algorithm.additional_data.value_or(ByteBuffer {});
 
-    // 8. Perform the Authenticated Decryption Function described in Section 7.2 of [NIST-SP800-38D] using
-    //    AES as the block cipher,
-    //    the contents of the iv member of normalizedAlgorithm as the IV input parameter,
-    //    the contents of additionalData as the A input parameter,
-    //    tagLength as the t pre-requisite,
-    //    the contents of actualCiphertext as the input ciphertext, C
-    //    and the contents of tag as the authentication tag, T.
-    // If the result of the algorithm is the indication of inauthenticity, "FAIL": throw an OperationError
-    ::Crypto::Cipher::AESGCMCipher cipher(key->handle().get<ByteBuffer>());
-    auto maybe_plaintext = cipher.decrypt(actual_ciphertext.bytes(), normalized_algorithm.iv, additional_data, tag);
-    if (maybe_plaintext.is_error()) {
-        dbgln("FAILED: {}", maybe_plaintext.error());
-        return WebIDL::OperationError::create(m_realm, "Decryption failed"_utf16);
-    }
-
-    // Otherwise: Let plaintext be the output P of the Authenticated Decryption Function.
-    // 9. Return the result of creating an ArrayBuffer containing plaintext.
-    return JS::ArrayBuffer::create(m_realm, maybe_plaintext.release_value());
+    return ByteOperation { [key_bytes = key->handle().get<ByteBuffer>(), iv = normalized_algorithm.iv, additional_data = move(additional_data), tag_length](ReadonlyBytes ciphertext) -> ErrorOr<ByteBuffer> {
+        // 2. If ciphertext has a length less than tagLength bits, then throw an OperationError.
+        if (ciphertext.size() < tag_length / 8)
+            return Error::from_string_literal("Invalid ciphertext length");
+
+        // 5. Let tag be the last tagLength bits of ciphertext.
+        auto tag_bytes = tag_length / 8;
+        auto tag = ciphertext.slice(ciphertext.size() - tag_bytes, tag_bytes);
+
+        // 6. Let actualCiphertext be the result of removing the last tagLength bits from ciphertext.
+        auto actual_ciphertext = ciphertext.slice(0, ciphertext.size() - tag_bytes);
+
+        // 8. Perform the Authenticated Decryption Function described in Section 7.2 of [NIST-SP800-38D] using
+        //    AES as the block cipher,
+        //    the contents of the iv member of normalizedAlgorithm as the IV input parameter,
+        //    the contents of additionalData as the A input parameter,
+        //    tagLength as the t pre-requisite,
+        //    the contents of actualCiphertext as the input ciphertext, C
+        //    and the contents of tag as the authentication tag, T.
+        // If the result of the algorithm is the indication of inauthenticity, "FAIL": throw an OperationError
+        ::Crypto::Cipher::AESGCMCipher cipher(key_bytes);
+        auto maybe_plaintext = cipher.decrypt(actual_ciphertext, iv, additional_data, tag);
+        if (maybe_plaintext.is_error()) {
+            dbgln("FAILED: {}", maybe_plaintext.error());
+            return Error::from_string_literal("Decryption failed");
+        }
+
+        // Otherwise: Let plaintext be the output P of the Authenticated Decryption Function.
+        // 9. Return the result of creating an ArrayBuffer containing plaintext.
+        return maybe_plaintext.release_value();
+    } };
 }
 
 WebIDL::ExceptionOr<Variant<GC::Ref<CryptoKey>, GC::Ref<CryptoKeyPair>>> AesGcm::generate_key(AlgorithmParams const& params, bool extractable, Vector<Bindings::KeyUsage> const& key_usages)
@@ -3627,6 +3723,11 @@ WebIDL::ExceptionOr<GC::Ref<CryptoKey>> HKDF::import_key(AlgorithmParams const&,
 }
 
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> SHA::digest(AlgorithmParams const& algorithm, ByteBuffer const& data)
+{
+    return perform(digest_operation(algorithm), data);
+}
+
+WebIDL::ExceptionOr<Optional<ByteOperation>> SHA::digest_operation(AlgorithmParams const& algorithm)
 {
     auto& algorithm_name = algorithm.name;
 
@@ -3643,15 +3744,17 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> SHA::digest(AlgorithmParams const&
         return WebIDL::NotSupportedError::create(m_realm, Utf16String::formatted("Invalid hash function '{}'", algorithm_name));
     }
 
-    ::Crypto::Hash::Manager hash { hash_kind };
-    hash.update(data);
+    return ByteOperation { [hash_kind](ReadonlyBytes data) -> ErrorOr<ByteBuffer> {
+        ::Crypto::Hash::Manager hash { hash_kind };
+        hash.update(data);
 
-    auto digest = hash.digest();
-    auto result_buffer = ByteBuffer::copy(digest.immutable_data(), hash.digest_size());
-    if (result_buffer.is_error())
-        return WebIDL::OperationError::create(m_realm, "Failed to create result buffer"_utf16);
+        auto digest = hash.digest();
+        auto result_buffer = ByteBuffer::copy(digest.immutable_data(), hash.digest_size());
+        if (result_buffer.is_error())
+            return Error::from_string_literal("Failed to create result buffer");
 
-    return JS::ArrayBuffer::create(m_realm, result_buffer.release_value());
+        return result_buffer.release_value();
+    } };
 }
 
 // https://w3c.github.io/webcrypto/#ecdsa-operations
@@ -6743,6 +6846,12 @@ WebIDL::ExceptionOr<JS::Value> HKDF::get_key_length(AlgorithmParams const&)
 
 // https://w3c.github.io/webcrypto/#pbkdf2-operations
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> PBKDF2::derive_bits(AlgorithmParams const& params, GC::Ref<CryptoKey> key, Optional<u32> length_optional)
+{
+    return perform(derive_bits_operation(params, key, length_optional), {});
+}
+
+// https://w3c.github.io/webcrypto/#pbkdf2-operations
+WebIDL::ExceptionOr<Optional<ByteOperation>> PBKDF2::derive_bits_operation(AlgorithmParams const& params, GC::Ref<CryptoKey> key, Optional<u32> length_optional)
 {
     auto& realm = *m_realm;
     auto const& normalized_algorithm = static_cast<PBKDF2Params const&>(params);
@@ -6781,15 +6890,17 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> PBKDF2::derive_bits(AlgorithmParam
         return WebIDL::NotSupportedError::create(m_realm, Utf16String::formatted("Invalid hash function '{}'", hash_algorithm));
     }());
 
-    ::Crypto::Hash::PBKDF2 pbkdf2(hash_kind);
-    auto maybe_result = pbkdf2.derive_key(password, salt, iterations, derived_key_length_bytes);
+    return ByteOperation { [hash_kind, password = move(password), salt = move(salt), iterations, derived_key_length_bytes](ReadonlyBytes) -> ErrorOr<ByteBuffer> {
+        ::Crypto::Hash::PBKDF2 pbkdf2(hash_kind);
+        auto maybe_result = pbkdf2.derive_key(password, salt, iterations, derived_key_length_bytes);
 
-    // 5. If the key derivation operation fails, then throw an OperationError.
-    if (maybe_result.is_error())
-        return WebIDL::OperationError::create(realm, "Failed to derive key"_utf16);
+        // 5. If the key derivation operation fails, then throw an OperationError.
+        if (maybe_result.is_error())
+            return Error::from_string_literal("Failed to derive key");
 
-    // 6. Return result
-    return JS::ArrayBuffer::create(realm, maybe_result.release_value());
+        // 6. Return result
+        return maybe_result.release_value();
+    } };
 }
 
 // https://w3c.github.io/webcrypto/#pbkdf2-operations
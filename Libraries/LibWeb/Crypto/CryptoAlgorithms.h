@@ -9,6 +9,7 @@
 #pragma once
 
 #include <AK/EnumBits.h>
+#include <AK/Function.h>
 #include <AK/String.h>
 #include <LibCrypto/BigInt/UnsignedBigInteger.h>
 #include <LibGC/Ptr.h>
@@ -297,6 +298,12 @@ struct HmacKeyGenParams : public AlgorithmParams {
     static JS::ThrowCompletionOr<NonnullOwnPtr<AlgorithmParams>> from_value(JS::VM&, JS::Value);
 };
 
+// The part of an operation that is left once its parameters have been validated, and that only works on bytes. It
+// doesn't touch any JS objects, so it can be performed on any thread. Its errors are thrown as an OperationError.
+using ByteOperation = Function<ErrorOr<ByteBuffer>(ReadonlyBytes input)>;
+
+WebIDL::ExceptionOr<ByteBuffer> byte_operation_result(JS::Realm&, ErrorOr<ByteBuffer>);
+
 class AlgorithmMethods {
 public:
     virtual ~AlgorithmMethods();
@@ -361,6 +368,14 @@ public:
         return WebIDL::NotSupportedError::create(m_realm, "unwwrapKey is not supported"_utf16);
     }
 
+    // Algorithms whose operations can be expensive return them as a ByteOperation here, so that SubtleCrypto can perform
+    // them off the main thread. Errors other than an OperationError are thrown before the operation is returned.
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> encrypt_operation(AlgorithmParams const&, GC::Ref<CryptoKey>) { return OptionalNone {}; }
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> decrypt_operation(AlgorithmParams const&, GC::Ref<CryptoKey>) { return OptionalNone {}; }
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> sign_operation(AlgorithmParams const&, GC::Ref<CryptoKey>) { return OptionalNone {}; }
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> digest_operation(AlgorithmParams const&) { return OptionalNone {}; }
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> derive_bits_operation(AlgorithmParams const&, GC::Ref<CryptoKey>, Optional<u32>) { return OptionalNone {}; }
+
     static NonnullOwnPtr<AlgorithmMethods> create(JS::Realm& realm) { return adopt_own(*new AlgorithmMethods(realm)); }
 
 protected:
@@ -369,6 +384,9 @@ protected:
     {
     }
 
+    // Performs an operation returned by one of the *_operation() methods right away, on the calling thread.
+    WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> perform(WebIDL::ExceptionOr<Optional<ByteOperation>>, ReadonlyBytes input);
+
     GC::Ref<JS::Realm> m_realm;
 };
 
@@ -376,6 +394,8 @@ class RSAOAEP : public AlgorithmMethods {
 public:
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> encrypt(AlgorithmParams const&, GC::Ref<CryptoKey>, ByteBuffer const&) override;
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> decrypt(AlgorithmParams const&, GC::Ref<CryptoKey>, ByteBuffer const&) override;
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> encrypt_operation(AlgorithmParams const&, GC::Ref<CryptoKey>) override;
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> decrypt_operation(AlgorithmParams const&, GC::Ref<CryptoKey>) override;
 
     virtual WebIDL::ExceptionOr<Variant<GC::Ref<CryptoKey>, GC::Ref<CryptoKeyPair>>> generate_key(AlgorithmParams const&, bool, Vector<Bindings::KeyUsage> const&) override;
 
@@ -394,6 +414,7 @@ private:
 class RSAPSS : public AlgorithmMethods {
 public:
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> sign(AlgorithmParams const&, GC::Ref<CryptoKey>, ByteBuffer const&) override;
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> sign_operation(AlgorithmParams const&, GC::Ref<CryptoKey>) override;
     virtual WebIDL::ExceptionOr<JS::Value> verify(AlgorithmParams const&, GC::Ref<CryptoKey>, ByteBuffer const&, ByteBuffer const&) override;
 
     virtual WebIDL::ExceptionOr<Variant<GC::Ref<CryptoKey>, GC::Ref<CryptoKeyPair>>> generate_key(AlgorithmParams const&, bool, Vector<Bindings::KeyUsage> const&) override;
@@ -413,6 +434,7 @@ private:
 class RSASSAPKCS1 : public AlgorithmMethods {
 public:
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> sign(AlgorithmParams const&, GC::Ref<CryptoKey>, ByteBuffer const&) override;
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> sign_operation(AlgorithmParams const&, GC::Ref<CryptoKey>) override;
     virtual WebIDL::ExceptionOr<JS::Value> verify(AlgorithmParams const&, GC::Ref<CryptoKey>, ByteBuffer const&, ByteBuffer const&) override;
 
     virtual WebIDL::ExceptionOr<Variant<GC::Ref<CryptoKey>, GC::Ref<CryptoKeyPair>>> generate_key(AlgorithmParams const&, bool, Vector<Bindings::KeyUsage> const&) override;
@@ -433,6 +455,8 @@ class AesCbc : public AlgorithmMethods {
 public:
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> encrypt(AlgorithmParams const&, GC::Ref<CryptoKey>, ByteBuffer const&) override;
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> decrypt(AlgorithmParams const&, GC::Ref<CryptoKey>, ByteBuffer const&) override;
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> encrypt_operation(AlgorithmParams const&, GC::Ref<CryptoKey>) override;
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> decrypt_operation(AlgorithmParams const&, GC::Ref<CryptoKey>) override;
     virtual WebIDL::ExceptionOr<GC::Ref<CryptoKey>> import_key(AlgorithmParams const&, Bindings::KeyFormat, CryptoKey::InternalKeyData, bool, Vector<Bindings::KeyUsage> const&) override;
     virtual WebIDL::ExceptionOr<Variant<GC::Ref<CryptoKey>, GC::Ref<CryptoKeyPair>>> generate_key(AlgorithmParams const&, bool, Vector<Bindings::KeyUsage> const&) override;
     virtual WebIDL::ExceptionOr<GC::Ref<JS::Object>> export_key(Bindings::KeyFormat, GC::Ref<CryptoKey>) override;
@@ -455,6 +479,8 @@ public:
     virtual WebIDL::ExceptionOr<Variant<GC::Ref<CryptoKey>, GC::Ref<CryptoKeyPair>>> generate_key(AlgorithmParams const&, bool, Vector<Bindings::KeyUsage> const&) override;
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> encrypt(AlgorithmParams const&, GC::Ref<CryptoKey>, ByteBuffer const&) override;
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> decrypt(AlgorithmParams const&, GC::Ref<CryptoKey>, ByteBuffer const&) override;
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> encrypt_operation(AlgorithmParams const&, GC::Ref<CryptoKey>) override;
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> decrypt_operation(AlgorithmParams const&, GC::Ref<CryptoKey>) override;
 
     static NonnullOwnPtr<AlgorithmMethods> create(JS::Realm& realm) { return adopt_own(*new AesCtr(realm)); }
 
@@ -472,6 +498,8 @@ public:
     virtual WebIDL::ExceptionOr<GC::Ref<JS::Object>> export_key(Bindings::KeyFormat, GC::Ref<CryptoKey>) override;
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> encrypt(AlgorithmParams const&, GC::Ref<CryptoKey>, ByteBuffer const&) override;
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> decrypt(AlgorithmParams const&, GC::Ref<CryptoKey>, ByteBuffer const&) override;
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> encrypt_operation(AlgorithmParams const&, GC::Ref<CryptoKey>) override;
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> decrypt_operation(AlgorithmParams const&, GC::Ref<CryptoKey>) override;
     virtual WebIDL::ExceptionOr<Variant<GC::Ref<CryptoKey>, GC::Ref<CryptoKeyPair>>> generate_key(AlgorithmParams const&, bool, Vector<Bindings::KeyUsage> const&) override;
 
     static NonnullOwnPtr<AlgorithmMethods> create(JS::Realm& realm) { return adopt_own(*new AesGcm(realm)); }
@@ -520,6 +548,7 @@ class PBKDF2 : public AlgorithmMethods {
 public:
     virtual WebIDL::ExceptionOr<GC::Ref<CryptoKey>> import_key(AlgorithmParams const&, Bindings::KeyFormat, CryptoKey::InternalKeyData, bool, Vector<Bindings::KeyUsage> const&) override;
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> derive_bits(AlgorithmParams const&, GC::Ref<CryptoKey>, Optional<u32>) override;
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> derive_bits_operation(AlgorithmParams const&, GC::Ref<CryptoKey>, Optional<u32>) override;
     virtual WebIDL::ExceptionOr<JS::Value> get_key_length(AlgorithmParams const&) override;
 
     static NonnullOwnPtr<AlgorithmMethods> create(JS::Realm& realm) { return adopt_own(*new PBKDF2(realm)); }
@@ -534,6 +563,7 @@ private:
 class SHA : public AlgorithmMethods {
 public:
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> digest(AlgorithmParams const&, ByteBuffer const&) override;
+    virtual WebIDL::ExceptionOr<Optional<ByteOperation>> digest_operation(AlgorithmParams const&) override;
 
     static NonnullOwnPtr<AlgorithmMethods> create(JS::Realm& realm) { return adopt_own(*new SHA(realm)); }
 
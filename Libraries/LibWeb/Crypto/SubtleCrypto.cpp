@@ -7,16 +7,20 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <AK/Debug.h>
 #include <AK/QuickSort.h>
+#include <AK/Time.h>
 #include <LibCrypto/Hash/HashManager.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/JSONObject.h>
 #include <LibJS/Runtime/ValueInlines.h>
+#include <LibThreading/BackgroundAction.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Bindings/SubtleCryptoPrototype.h>
 #include <LibWeb/Crypto/KeyAlgorithms.h>
 #include <LibWeb/Crypto/SubtleCrypto.h>
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/WebIDL/AbstractOperations.h>
@@ -133,6 +137,68 @@ WebIDL::ExceptionOr<NormalizedAlgorithmAndParameter> normalize_an_algorithm(JS::
     return normalized_algorithm;
 }
 
+// How long the operations that were performed on the thread pool took, per operation and algorithm.
+struct BackgroundOperationTimings {
+    u64 count { 0 };
+    AK::Duration total_time;
+    AK::Duration max_time;
+};
+
+static HashMap<String, BackgroundOperationTimings>& background_operation_timings()
+{
+    static HashMap<String, BackgroundOperationTimings> timings;
+    return timings;
+}
+
+struct BackgroundOperationResult {
+    ErrorOr<ByteBuffer> result;
+    AK::Duration time_taken;
+};
+
+using BackgroundOperationCallback = GC::Function<void(WebIDL::ExceptionOr<ByteBuffer>)>;
+
+// Performs an operation on the thread pool, so that expensive operations don't block the event loop. The input is moved
+// to the thread pool instead of being copied, and on_complete is called with the result in a task queued on the crypto
+// task source.
+static void perform_in_background(JS::Realm& realm, StringView operation_name, String const& algorithm_name, ByteOperation operation, ByteBuffer input, GC::Ref<BackgroundOperationCallback> on_complete)
+{
+    auto start_time = MonotonicTime::now();
+
+    (void)Threading::BackgroundAction<BackgroundOperationResult>::construct(
+        [operation = move(operation), input = move(input)](auto&) -> ErrorOr<BackgroundOperationResult> {
+            auto start_time = MonotonicTime::now();
+            auto result = operation(input);
+            return BackgroundOperationResult { move(result), MonotonicTime::now() - start_time };
+        },
+        [realm = GC::make_root(realm), on_complete = GC::make_root(on_complete), name = MUST(String::formatted("{} {}", algorithm_name, operation_name)), start_time](BackgroundOperationResult result) mutable -> ErrorOr<void> {
+            auto& timings = background_operation_timings().ensure(name);
+            ++timings.count;
+            timings.total_time += result.time_taken;
+            timings.max_time = max(timings.max_time, result.time_taken);
+            dbgln_if(CRYPTO_DEBUG, "SubtleCrypto: {} took {}ms on the thread pool, {}ms in total (average of {} operations: {}ms, max: {}ms)",
+                name, result.time_taken.to_milliseconds(), (MonotonicTime::now() - start_time).to_milliseconds(),
+                timings.count, timings.total_time.to_milliseconds() / static_cast<i64>(timings.count), timings.max_time.to_milliseconds());
+
+            HTML::queue_global_task(HTML::Task::Source::Crypto, realm->global_object(), GC::create_function(realm->heap(), [&realm = *realm, on_complete = GC::Ref { *on_complete }, result = move(result.result)]() mutable {
+                HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+                on_complete->function()(byte_operation_result(realm, move(result)));
+            }));
+            return {};
+        });
+}
+
+// Returns a callback for perform_in_background() that resolves promise with an ArrayBuffer containing the result.
+static GC::Ref<BackgroundOperationCallback> resolve_with_array_buffer(JS::Realm& realm, GC::Ref<WebIDL::Promise> promise)
+{
+    return GC::create_function(realm.heap(), [&realm, promise](WebIDL::ExceptionOr<ByteBuffer> result) {
+        if (result.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), result.release_error()).release_value());
+            return;
+        }
+        WebIDL::resolve_promise(realm, promise, JS::ArrayBuffer::create(realm, result.release_value()));
+    });
+}
+
 // https://w3c.github.io/webcrypto/#dfn-SubtleCrypto-method-encrypt
 GC::Ref<WebIDL::Promise> SubtleCrypto::encrypt(AlgorithmIdentifier const& algorithm, GC::Ref<CryptoKey> key, GC::Root<WebIDL::BufferSource> const& data_parameter)
 {
@@ -160,7 +226,7 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::encrypt(AlgorithmIdentifier const& algori
 
     // 6. Return promise and perform the remaining steps in parallel.
 
-    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, normalized_algorithm = normalized_algorithm.release_value(), promise, key, data = move(data)]() -> void {
+    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, normalized_algorithm = normalized_algorithm.release_value(), promise, key, data = move(data)]() mutable -> void {
         HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
         // 7. If the following steps or referenced procedures say to throw an error, reject promise with the returned error and then terminate the algorithm.
 
@@ -177,6 +243,17 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::encrypt(AlgorithmIdentifier const& algori
         }
 
         // 10. Let ciphertext be the result of performing the encrypt operation specified by normalizedAlgorithm using algorithm and key and with data as plaintext.
+        auto operation = normalized_algorithm.methods->encrypt_operation(*normalized_algorithm.parameter, key);
+        if (operation.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), operation.release_error()).release_value());
+            return;
+        }
+        if (auto maybe_operation = operation.release_value(); maybe_operation.has_value()) {
+            // NOTE: promise is resolved with the result once the operation has been performed on the thread pool.
+            perform_in_background(realm, "encrypt"sv, normalized_algorithm.parameter->name, maybe_operation.release_value(), move(data), resolve_with_array_buffer(realm, promise));
+            return;
+        }
+
         auto cipher_text = normalized_algorithm.methods->encrypt(*normalized_algorithm.parameter, key, data);
         if (cipher_text.is_error()) {
             WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), cipher_text.release_error()).release_value());
@@ -217,7 +294,7 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::decrypt(AlgorithmIdentifier const& algori
 
     // 6. Return promise and perform the remaining steps in parallel.
 
-    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, normalized_algorithm = normalized_algorithm.release_value(), promise, key, data = move(data)]() -> void {
+    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, normalized_algorithm = normalized_algorithm.release_value(), promise, key, data = move(data)]() mutable -> void {
         HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
         // 7. If the following steps or referenced procedures say to throw an error, reject promise with the returned error and then terminate the algorithm.
 
@@ -234,6 +311,17 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::decrypt(AlgorithmIdentifier const& algori
         }
 
         // 10. Let plaintext be the result of performing the decrypt operation specified by normalizedAlgorithm using algorithm and key and with data as ciphertext.
+        auto operation = normalized_algorithm.methods->decrypt_operation(*normalized_algorithm.parameter, key);
+        if (operation.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), operation.release_error()).release_value());
+            return;
+        }
+        if (auto maybe_operation = operation.release_value(); maybe_operation.has_value()) {
+            // NOTE: promise is resolved with the result once the operation has been performed on the thread pool.
+            perform_in_background(realm, "decrypt"sv, normalized_algorithm.parameter->name, maybe_operation.release_value(), move(data), resolve_with_array_buffer(realm, promise));
+            return;
+        }
+
         auto plain_text = normalized_algorithm.methods->decrypt(*normalized_algorithm.parameter, key, data);
         if (plain_text.is_error()) {
             WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), plain_text.release_error()).release_value());
@@ -275,12 +363,23 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::digest(AlgorithmIdentifier const& algorit
     auto promise = WebIDL::create_promise(realm);
 
     // 6. Return promise and perform the remaining steps in parallel.
-    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, algorithm_object = normalized_algorithm.release_value(), promise, data_buffer = move(data_buffer)]() -> void {
+    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, algorithm_object = normalized_algorithm.release_value(), promise, data_buffer = move(data_buffer)]() mutable -> void {
         HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
         // 7. If the following steps or referenced procedures say to throw an error, reject promise with the returned error and then terminate the algorithm.
         // FIXME: Need spec reference to https://webidl.spec.whatwg.org/#reject
 
         // 8. Let result be the result of performing the digest operation specified by normalizedAlgorithm using algorithm, with data as message.
+        auto operation = algorithm_object.methods->digest_operation(*algorithm_object.parameter);
+        if (operation.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), operation.release_error()).release_value());
+            return;
+        }
+        if (auto maybe_operation = operation.release_value(); maybe_operation.has_value()) {
+            // NOTE: promise is resolved with the result once the operation has been performed on the thread pool.
+            perform_in_background(realm, "digest"sv, algorithm_object.parameter->name, maybe_operation.release_value(), move(data_buffer), resolve_with_array_buffer(realm, promise));
+            return;
+        }
+
         auto result = algorithm_object.methods->digest(*algorithm_object.parameter, data_buffer);
 
         if (result.is_exception()) {
@@ -504,7 +603,7 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::sign(AlgorithmIdentifier const& algorithm
 
     // 6. Return promise and perform the remaining steps in parallel.
 
-    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, normalized_algorithm = normalized_algorithm.release_value(), promise, key, data = move(data)]() -> void {
+    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, normalized_algorithm = normalized_algorithm.release_value(), promise, key, data = move(data)]() mutable -> void {
         HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
         // 7. If the following steps or referenced procedures say to throw an error, reject promise with the returned error and then terminate the algorithm.
 
@@ -521,6 +620,17 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::sign(AlgorithmIdentifier const& algorithm
         }
 
         // 10. Let result be the result of performing the sign operation specified by normalizedAlgorithm using key and algorithm and with data as message.
+        auto operation = normalized_algorithm.methods->sign_operation(*normalized_algorithm.parameter, key);
+        if (operation.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), operation.release_error()).release_value());
+            return;
+        }
+        if (auto maybe_operation = operation.release_value(); maybe_operation.has_value()) {
+            // NOTE: promise is resolved with the result once the operation has been performed on the thread pool.
+            perform_in_background(realm, "sign"sv, normalized_algorithm.parameter->name, maybe_operation.release_value(), move(data), resolve_with_array_buffer(realm, promise));
+            return;
+        }
+
         auto result = normalized_algorithm.methods->sign(*normalized_algorithm.parameter, key, data);
         if (result.is_error()) {
             WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), result.release_error()).release_value());
@@ -632,6 +742,17 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::derive_bits(AlgorithmIdentifier algorithm
         }
 
         // 9. Let result be the result of creating an ArrayBuffer containing the result of performing the derive bits operation specified by normalizedAlgorithm using baseKey, algorithm and length.
+        auto operation = normalized_algorithm.methods->derive_bits_operation(*normalized_algorithm.parameter, base_key, length_optional);
+        if (operation.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), operation.release_error()).release_value());
+            return;
+        }
+        if (auto maybe_operation = operation.release_value(); maybe_operation.has_value()) {
+            // NOTE: promise is resolved with the result once the operation has been performed on the thread pool.
+            perform_in_background(realm, "deriveBits"sv, normalized_algorithm.parameter->name, maybe_operation.release_value(), {}, resolve_with_array_buffer(realm, promise));
+            return;
+        }
+
         auto result = normalized_algorithm.methods->derive_bits(*normalized_algorithm.parameter, base_key, length_optional);
         if (result.is_error()) {
             WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), result.release_error()).release_value());
@@ -712,36 +833,56 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::derive_key(AlgorithmIdentifier algorithm,
             length = maybe_length.value();
         }
 
+        auto import_secret = [&realm, promise, normalized_derived_key_algorithm_import = move(normalized_derived_key_algorithm_import), extractable, key_usages = move(key_usages)](ByteBuffer const& secret) mutable {
+            // 15. Let result be the result of performing the import key operation specified by normalizedDerivedKeyAlgorithmImport using "raw" as format, secret as keyData, derivedKeyType as algorithm and using extractable and usages.
+            auto result_or_error = normalized_derived_key_algorithm_import.methods->import_key(*normalized_derived_key_algorithm_import.parameter, Bindings::KeyFormat::Raw, secret, extractable, key_usages);
+            if (result_or_error.is_error()) {
+                WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), result_or_error.release_error()).release_value());
+                return;
+            }
+            auto result = result_or_error.release_value();
+
+            // 16. If the [[type]] internal slot of result is "secret" or "private" and usages is empty, then throw a SyntaxError.
+            if ((result->type() == Bindings::KeyType::Secret || result->type() == Bindings::KeyType::Private) && key_usages.is_empty()) {
+                WebIDL::reject_promise(realm, promise, WebIDL::SyntaxError::create(realm, "usages must not be empty"_utf16));
+                return;
+            }
+
+            // 17. Set the [[extractable]] internal slot of result to extractable.
+            result->set_extractable(extractable);
+
+            // 18. Set the [[usages]] internal slot of result to the normalized value of usages.
+            normalize_key_usages(key_usages);
+            result->set_usages(key_usages);
+
+            // 19. Resolve promise with result.
+            WebIDL::resolve_promise(realm, promise, result);
+        };
+
         // 14. Let secret be the result of performing the derive bits operation specified by normalizedAlgorithm using key, algorithm and length.
-        auto secret = normalized_algorithm.methods->derive_bits(*normalized_algorithm.parameter, base_key, length);
-        if (secret.is_error()) {
-            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), secret.release_error()).release_value());
+        auto operation = normalized_algorithm.methods->derive_bits_operation(*normalized_algorithm.parameter, base_key, length);
+        if (operation.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), operation.release_error()).release_value());
             return;
         }
-
-        // 15. Let result be the result of performing the import key operation specified by normalizedDerivedKeyAlgorithmImport using "raw" as format, secret as keyData, derivedKeyType as algorithm and using extractable and usages.
-        auto result_or_error = normalized_derived_key_algorithm_import.methods->import_key(*normalized_derived_key_algorithm_import.parameter, Bindings::KeyFormat::Raw, secret.release_value()->buffer(), extractable, key_usages);
-        if (result_or_error.is_error()) {
-            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), result_or_error.release_error()).release_value());
+        if (auto maybe_operation = operation.release_value(); maybe_operation.has_value()) {
+            // NOTE: The derived key is imported once the operation has been performed on the thread pool.
+            perform_in_background(realm, "deriveKey"sv, normalized_algorithm.parameter->name, maybe_operation.release_value(), {}, GC::create_function(realm.heap(), [&realm, promise, import_secret = move(import_secret)](WebIDL::ExceptionOr<ByteBuffer> secret) mutable {
+                if (secret.is_error()) {
+                    WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), secret.release_error()).release_value());
+                    return;
+                }
+                import_secret(secret.value());
+            }));
             return;
         }
-        auto result = result_or_error.release_value();
 
-        // 16. If the [[type]] internal slot of result is "secret" or "private" and usages is empty, then throw a SyntaxError.
-        if ((result->type() == Bindings::KeyType::Secret || result->type() == Bindings::KeyType::Private) && key_usages.is_empty()) {
-            WebIDL::reject_promise(realm, promise, WebIDL::SyntaxError::create(realm, "usages must not be empty"_utf16));
+        auto secret = normalized_algorithm.methods->derive_bits(*normalized_algorithm.parameter, base_key, length);
+        if (secret.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), secret.release_error()).release_value());
             return;
         }
-
-        // 17. Set the [[extractable]] internal slot of result to extractable.
-        result->set_extractable(extractable);
-
-        // 18. Set the [[usages]] internal slot of result to the normalized value of usages.
-        normalize_key_usages(key_usages);
-        result->set_usages(key_usages);
-
-        // 19. Resolve promise with result.
-        WebIDL::resolve_promise(realm, promise, result);
+        import_secret(secret.value()->buffer());
     }));
 
     return promise;
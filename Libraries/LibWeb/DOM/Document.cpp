@@ -14,12 +14,17 @@
 #include <AK/Debug.h>
 #include <AK/GenericLexer.h>
 #include <AK/InsertionSort.h>
+#include <AK/JsonObject.h>
+#include <AK/MemoryAccounting.h>
 #include <AK/StringBuilder.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Time.h>
 #include <AK/Utf8View.h>
 #include <LibCore/Timer.h>
+#include <LibCore/Trace.h>
 #include <LibGC/RootVector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/PaintingSurface.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/FunctionObject.h>
 #include <LibJS/Runtime/NativeFunction.h>
@@ -39,6 +44,7 @@
 #include <LibWeb/CSS/CSSTransition.h>
 #include <LibWeb/CSS/ComputedProperties.h>
 #include <LibWeb/CSS/FontFaceSet.h>
+#include <LibWeb/CSS/MediaQuery.h>
 #include <LibWeb/CSS/MediaQueryList.h>
 #include <LibWeb/CSS/MediaQueryListEvent.h>
 #include <LibWeb/CSS/Parser/Parser.h>
@@ -122,6 +128,7 @@
 #include <LibWeb/HTML/HTMLTitleElement.h>
 #include <LibWeb/HTML/HashChangeEvent.h>
 #include <LibWeb/HTML/ListOfAvailableImages.h>
+#include <LibWeb/HTML/MapOfPreloadedResources.h>
 #include <LibWeb/HTML/Location.h>
 #include <LibWeb/HTML/MessageEvent.h>
 #include <LibWeb/HTML/MessagePort.h>
@@ -155,6 +162,8 @@
 #include <LibWeb/Namespace.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/DisplayListPlayerSkia.h>
+#include <LibWeb/Painting/StackingContext.h>
 #include <LibWeb/Painting/ViewportPaintable.h>
 #include <LibWeb/PermissionsPolicy/AutoplayAllowlist.h>
 #include <LibWeb/ResizeObserver/ResizeObserver.h>
@@ -511,6 +520,7 @@ void Document::initialize(JS::Realm& realm)
     m_selection = realm.create<Selection::Selection>(realm, *this);
 
     m_list_of_available_images = realm.create<HTML::ListOfAvailableImages>();
+    m_map_of_preloaded_resources = realm.create<HTML::MapOfPreloadedResources>();
 
     page().client().page_did_create_new_document(*this);
 }
@@ -595,6 +605,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
 
     visitor.visit(m_associated_animation_timelines);
     visitor.visit(m_list_of_available_images);
+    visitor.visit(m_map_of_preloaded_resources);
 
     for (auto* form_associated_element : m_form_associated_elements_with_form_attribute)
         visitor.visit(form_associated_element->form_associated_element_to_html_element());
@@ -1330,9 +1341,11 @@ void Document::update_layout(UpdateLayoutReason reason)
     if (navigable->container() && &navigable->container()->document() != this)
         navigable->container()->document().update_layout(reason);
 
+    AK::MemoryAccounting::ScopedCategory memory_accounting_category { AK::MemoryAccounting::Category::Layout };
+
     update_style();
 
-    if (m_layout_root && !m_layout_root->needs_layout_update())
+    if (m_layout_root && !m_layout_root->needs_layout_update() && !m_layout_root->descendant_needs_layout_update())
         return;
 
     // NOTE: If this is a document hosting <template> contents, layout is unnecessary.
@@ -1349,6 +1362,8 @@ void Document::update_layout(UpdateLayoutReason reason)
     auto viewport_rect = navigable->viewport_rect();
 
     auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    Optional<Core::TraceScope> phase_trace_scope;
+    phase_trace_scope.emplace("Layout tree build"sv);
 
     if (!m_layout_root || needs_layout_tree_update() || child_needs_layout_tree_update() || needs_full_layout_tree_update()) {
         Layout::TreeBuilder tree_builder;
@@ -1366,6 +1381,11 @@ void Document::update_layout(UpdateLayoutReason reason)
         }
     }
 
+    if (m_rendering_phase_timings.has_value())
+        m_rendering_phase_timings->layout_tree_build += timer.elapsed_time();
+    auto phase_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    phase_trace_scope.emplace("Layout"sv);
+
     m_layout_root->for_each_in_inclusive_subtree([&](auto& layout_node) {
         layout_node.recompute_containing_block({});
         return TraversalDecision::Continue;
@@ -1420,6 +1440,12 @@ void Document::update_layout(UpdateLayoutReason reason)
                 Layout::AvailableSize::make_definite(viewport_rect.height())));
     }
 
+    if (m_rendering_phase_timings.has_value()) {
+        m_rendering_phase_timings->layout += phase_timer.elapsed_time();
+        phase_timer.start();
+    }
+    phase_trace_scope.emplace("Paintable tree build"sv);
+
     layout_state.commit(*m_layout_root);
 
     // Broadcast the current viewport rect to any new paintables, so they know whether they're visible or not.
@@ -1455,6 +1481,10 @@ void Document::update_layout(UpdateLayoutReason reason)
         return TraversalDecision::Continue;
     });
 
+    if (m_rendering_phase_timings.has_value())
+        m_rendering_phase_timings->paintable_build += phase_timer.elapsed_time();
+    phase_trace_scope.clear();
+
     // Scrolling by zero offset will clamp scroll offset back to valid range if it was out of bounds
     // after the viewport size change.
     if (auto window = this->window())
@@ -1543,6 +1573,8 @@ void Document::update_style()
     if (!browsing_context())
         return;
 
+    AK::MemoryAccounting::ScopedCategory memory_accounting_category { AK::MemoryAccounting::Category::Style };
+
     update_animated_style_if_needed();
 
     // Associated with each top-level browsing context is a current transition generation that is incremented on each
@@ -1560,6 +1592,8 @@ void Document::update_style()
     if (m_created_for_appropriate_template_contents)
         return;
 
+    Core::TraceScope trace_scope("Style"sv);
+
     // Fetch the viewport rect once, instead of repeatedly, during style computation.
     style_computer().set_viewport_rect({}, viewport_rect());
 
@@ -1787,10 +1821,16 @@ void Document::invalidate_style_of_elements_affected_by_has()
     }
 
     auto nodes = move(m_pending_nodes_for_style_invalidation_due_to_presence_of_has);
+
+    // NOTE: Pending nodes often share most of their ancestors (e.g. many checkboxes in one form), and everything
+    //       above an ancestor we've already visited has been handled by an earlier walk.
+    HashTable<Node const*> visited_ancestors;
     for (auto const& node : nodes) {
         if (!node)
             continue;
         for (auto ancestor = node.ptr(); ancestor; ancestor = ancestor->parent_or_shadow_host()) {
+            if (visited_ancestors.set(ancestor) != HashSetResult::InsertedNewEntry)
+                break;
             if (!ancestor->is_element())
                 continue;
             auto& element = static_cast<Element&>(*ancestor);
@@ -1798,7 +1838,7 @@ void Document::invalidate_style_of_elements_affected_by_has()
 
             auto* parent = ancestor->parent_or_shadow_host();
             if (!parent)
-                return;
+                break;
 
             // If any ancestor's sibling was tested against selectors like ".a:has(+ .b)" or ".a:has(~ .b)"
             // its style might be affected by the change in descendant node.
@@ -3430,6 +3470,8 @@ void Document::evaluate_media_queries_and_report_changes()
         return;
     m_needs_media_query_evaluation = false;
 
+    invalidate_media_query_results_if_needed();
+
     // NOTE: Not in the spec, but we take this opportunity to prune null WeakPtrs.
     m_media_query_lists.remove_all_matching([](auto& it) {
         return !it;
@@ -3466,8 +3508,29 @@ void Document::evaluate_media_queries_and_report_changes()
     evaluate_media_rules();
 }
 
+void Document::invalidate_media_query_results_if_needed()
+{
+    // NOTE: Not every change to a media feature is reported via set_needs_media_query_evaluation(), so we compare
+    //       the current values of all media features with the ones the cached results were computed for.
+    StringBuilder builder;
+    if (auto window = this->window()) {
+        for (size_t i = 0; i < CSS::number_of_media_feature_ids; ++i) {
+            if (auto value = window->query_media_feature(static_cast<CSS::MediaFeatureID>(i)); value.has_value())
+                builder.append(value->to_string(CSS::SerializationMode::Normal));
+            builder.append('\n');
+        }
+    }
+    auto media_feature_values = builder.to_string_without_validation();
+    if (media_feature_values == m_media_feature_values_for_media_query_results)
+        return;
+    m_media_query_results.clear();
+    m_media_feature_values_for_media_query_results = move(media_feature_values);
+}
+
 void Document::evaluate_media_rules()
 {
+    invalidate_media_query_results_if_needed();
+
     bool any_media_queries_changed_match_state = false;
     for_each_active_css_style_sheet([&](CSS::CSSStyleSheet& style_sheet, auto) {
         if (style_sheet.evaluate_media_queries(*this))
@@ -4610,6 +4673,11 @@ HTML::ListOfAvailableImages const& Document::list_of_available_images() const
     return *m_list_of_available_images;
 }
 
+HTML::MapOfPreloadedResources& Document::map_of_preloaded_resources()
+{
+    return *m_map_of_preloaded_resources;
+}
+
 CSSPixelRect Document::viewport_rect() const
 {
     if (auto const navigable = this->navigable())
@@ -4732,10 +4800,11 @@ void Document::queue_an_intersection_observer_entry(IntersectionObserver::Inters
 }
 
 // https://www.w3.org/TR/intersection-observer/#compute-the-intersection
-static CSSPixelRect compute_intersection(GC::Ref<Element> target, IntersectionObserver::IntersectionObserver const& observer)
+static CSSPixelRect compute_intersection(CSSPixelRect const& target_bounding_box, IntersectionObserver::IntersectionObserver const& observer)
 {
     // 1. Let intersectionRect be the result of getting the bounding box for target.
-    auto intersection_rect = target->get_bounding_client_rect();
+    // NOTE: The caller has already computed this as targetRect, so we don't compute it a second time.
+    auto intersection_rect = target_bounding_box;
 
     // FIXME: 2. Let container be the containing block of target.
     // FIXME: 3. While container is not root:
@@ -4764,6 +4833,18 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
 {
     auto& realm = this->realm();
 
+    if (m_intersection_observers.is_empty())
+        return;
+
+    // NOTE: Make sure layout is up to date first, so that the geometry generations we compare below are final.
+    update_layout(UpdateLayoutReason::HTMLEventLoopRenderingUpdate);
+
+    // NOTE: Targets observed by several observers only need their bounding box computed once per run.
+    HashMap<Element const*, CSSPixelRect> target_bounding_boxes;
+    auto bounding_box_for = [&](Element const& target) {
+        return target_bounding_boxes.ensure(&target, [&] { return target.get_bounding_client_rect(); });
+    };
+
     // 1. Let observer list be a list of all IntersectionObservers whose root is in the DOM tree of document.
     //    For the top-level browsing context, this includes implicit root observers.
     // 2. For each observer in observer list:
@@ -4774,10 +4855,22 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
     for (auto& observer : intersection_observers) {
         // 1. Let rootBounds be observer’s root intersection rectangle.
         auto root_bounds = observer->root_intersection_rectangle();
+        auto root_bounds_changed = observer->previous_root_bounds() != root_bounds;
+        observer->set_previous_root_bounds({}, root_bounds);
 
         // 2. For each target in observer’s internal [[ObservationTargets]] slot, processed in the same order that
         //    observe() was called on each target:
         for (auto& target : observer->observation_targets()) {
+            auto& intersection_observer_registration = target->get_intersection_observer_registration({}, observer);
+
+            // OPTIMIZATION: If neither rootBounds nor anything that could have moved target changed since we last
+            //               processed it, the steps below would compute the same thresholdIndex and isIntersecting
+            //               as last time and not queue an entry, so we can skip them.
+            auto geometry_generation = target->document().geometry_generation();
+            if (!root_bounds_changed && intersection_observer_registration.previous_geometry_generation == geometry_generation)
+                continue;
+            intersection_observer_registration.previous_geometry_generation = geometry_generation;
+
             // 1. Let:
             // thresholdIndex be 0.
             size_t threshold_index = 0;
@@ -4805,11 +4898,11 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
             // NOTE: Check if target has a layout node is not in the spec but required to match other browsers.
             if (target->layout_node() && (!(observer->root().has<Empty>() && &target->document() == intersection_root_document.ptr()) || !(intersection_root.has<GC::Root<DOM::Element>>() && !target->is_descendant_of(*intersection_root.get<GC::Root<DOM::Element>>())))) {
                 // 4. Set targetRect to the DOMRectReadOnly obtained by getting the bounding box for target.
-                target_rect = target->get_bounding_client_rect();
+                target_rect = bounding_box_for(*target);
 
                 // 5. Let intersectionRect be the result of running the compute the intersection algorithm on target and
                 //    observer’s intersection root.
-                intersection_rect = compute_intersection(target, observer);
+                intersection_rect = compute_intersection(target_rect, observer);
 
                 // 6. Let targetArea be targetRect’s area.
                 auto target_area = target_rect.width() * target_rect.height();
@@ -4839,7 +4932,7 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
 
             // 11. Let intersectionObserverRegistration be the IntersectionObserverRegistration record in target’s
             //     internal [[RegisteredIntersectionObservers]] slot whose observer property is equal to observer.
-            auto& intersection_observer_registration = target->get_intersection_observer_registration({}, observer);
+            // NOTE: We looked this up at the start of the loop.
 
             // 12. Let previousThresholdIndex be the intersectionObserverRegistration’s previousThresholdIndex property.
             auto previous_threshold_index = intersection_observer_registration.previous_threshold_index;
@@ -5993,7 +6086,7 @@ WebIDL::ExceptionOr<void> Document::set_adopted_style_sheets(JS::Value new_value
     return {};
 }
 
-void Document::for_each_active_css_style_sheet(Function<void(CSS::CSSStyleSheet&, GC::Ptr<DOM::ShadowRoot>)>&& callback) const
+void Document::for_each_active_css_style_sheet(FunctionRef<void(CSS::CSSStyleSheet&, GC::Ptr<DOM::ShadowRoot>)> callback) const
 {
     if (m_style_sheets) {
         for (auto& style_sheet : m_style_sheets->sheets()) {
@@ -6222,6 +6315,8 @@ GC::Ptr<HTML::HTMLElement> Document::topmost_auto_or_hint_popover()
 
 void Document::set_needs_to_refresh_scroll_state(bool b)
 {
+    if (b)
+        ++m_geometry_generation;
     if (auto* paintable = this->paintable())
         paintable->set_needs_to_refresh_scroll_state(b);
 }
@@ -6437,10 +6532,10 @@ void Document::set_cached_navigable(GC::Ptr<HTML::Navigable> navigable)
 
 void Document::set_needs_display(InvalidateDisplayList should_invalidate_display_list)
 {
-    set_needs_display(viewport_rect(), should_invalidate_display_list);
+    set_needs_display({}, should_invalidate_display_list);
 }
 
-void Document::set_needs_display(CSSPixelRect const&, InvalidateDisplayList should_invalidate_display_list)
+void Document::set_needs_display(Optional<CSSPixelRect> const& damage_rect, InvalidateDisplayList should_invalidate_display_list)
 {
     // FIXME: Ignore updates outside the visible viewport rect.
     //        This requires accounting for fixed-position elements in the input rect, which we don't do yet.
@@ -6460,7 +6555,10 @@ void Document::set_needs_display(CSSPixelRect const&, InvalidateDisplayList shou
         return;
 
     if (navigable->is_traversable()) {
-        navigable->traversable_navigable()->set_needs_repaint();
+        if (damage_rect.has_value() && should_invalidate_display_list == InvalidateDisplayList::No)
+            navigable->traversable_navigable()->set_needs_repaint(*damage_rect);
+        else
+            navigable->traversable_navigable()->set_needs_repaint();
         Web::HTML::main_thread_event_loop().schedule();
         return;
     }
@@ -6472,6 +6570,39 @@ void Document::set_needs_display(CSSPixelRect const&, InvalidateDisplayList shou
 
 void Document::invalidate_display_list()
 {
+    ++m_display_list_generation;
+    m_cached_display_list.clear();
+
+    auto navigable = this->navigable();
+    if (!navigable)
+        return;
+
+    if (auto container = navigable->container()) {
+        container->document().invalidate_display_list();
+    }
+}
+
+void Document::invalidate_display_list(Painting::Paintable const& paintable)
+{
+    // The viewport stands in for changes affecting the whole document (e.g. the selection).
+    if (paintable.is_viewport_paintable()) {
+        invalidate_display_list();
+        return;
+    }
+
+    Painting::StackingContext const* stacking_context = nullptr;
+    for (auto const* ancestor = &paintable; ancestor && !stacking_context; ancestor = ancestor->parent()) {
+        if (auto const* paintable_box = as_if<Painting::PaintableBox>(*ancestor))
+            stacking_context = paintable_box->stacking_context();
+    }
+    if (!stacking_context) {
+        invalidate_display_list();
+        return;
+    }
+
+    // OPTIMIZATION: Only the stacking contexts painting this paintable have to be recorded again, all others replay
+    //               the commands they recorded for the previous display list.
+    stacking_context->invalidate_cached_commands();
     m_cached_display_list.clear();
 
     auto navigable = this->navigable();
@@ -6488,8 +6619,38 @@ RefPtr<Painting::DisplayList> Document::cached_display_list() const
     return m_cached_display_list;
 }
 
+bool Document::update_opacity_in_cached_display_list(Painting::PaintableBox const& paintable_box, float opacity)
+{
+    if (!m_cached_display_list)
+        return false;
+    if (!m_cached_display_list->update_stacking_context_opacity(paintable_box, opacity))
+        return false;
+    // The commands cached by the stacking context still have the old opacity.
+    if (auto const* stacking_context = paintable_box.stacking_context())
+        stacking_context->invalidate_cached_commands();
+    return true;
+}
+
+bool Document::update_transform_in_cached_display_list(Painting::PaintableBox& paintable_box)
+{
+    if (!m_cached_display_list)
+        return false;
+
+    // Only this box's transform is needed, so resolve its paint-only properties now instead of resolving them for the
+    // whole document.
+    paintable_box.resolve_paint_properties();
+    Painting::StackingContextTransform transform(paintable_box.transform_origin().to_type<float>(), paintable_box.transform(), m_cached_display_list->device_pixels_per_css_pixel());
+    if (!m_cached_display_list->update_stacking_context_transform(paintable_box, transform))
+        return false;
+    if (auto const* stacking_context = paintable_box.stacking_context())
+        stacking_context->invalidate_cached_commands();
+    return true;
+}
+
 RefPtr<Painting::DisplayList> Document::record_display_list(HTML::PaintConfig config)
 {
+    AK::MemoryAccounting::ScopedCategory memory_accounting_category { AK::MemoryAccounting::Category::Paint };
+
     auto update_visual_viewport_transform = [&](Painting::DisplayList& display_list) {
         auto transform = visual_viewport()->transform();
         auto matrix = transform.to_matrix();
@@ -6504,6 +6665,8 @@ RefPtr<Painting::DisplayList> Document::record_display_list(HTML::PaintConfig co
         return m_cached_display_list;
     }
 
+    Core::TraceScope trace_scope("Display list recording"sv);
+
     auto display_list = Painting::DisplayList::create(page().client().device_pixels_per_css_pixel());
     Painting::DisplayListRecorder display_list_recorder(display_list);
 
@@ -6548,6 +6711,7 @@ RefPtr<Painting::DisplayList> Document::record_display_list(HTML::PaintConfig co
     context.set_device_viewport_rect(viewport_rect);
     context.set_should_show_line_box_borders(config.should_show_line_box_borders);
     context.set_should_paint_overlay(config.paint_overlay);
+    context.set_should_reuse_stacking_context_commands(true);
 
     update_paint_and_hit_testing_properties_if_needed();
 
@@ -6561,6 +6725,20 @@ RefPtr<Painting::DisplayList> Document::record_display_list(HTML::PaintConfig co
         highlighted_node()->paintable()->paint_inspector_overlay(context);
     }
 
+    display_list->remove_commands_without_effect();
+
+    if (trace_scope.is_enabled()) {
+        HashMap<StringView, u64> command_counts;
+        for (auto const& item : display_list->commands()) {
+            auto name = item.command.visit([](auto const& command) { return command.command_name; });
+            command_counts.ensure(name, [] { return 0; })++;
+        }
+        JsonObject commands;
+        for (auto const& [name, count] : command_counts)
+            commands.set(name, count);
+        trace_scope.arguments().set("commands"sv, move(commands));
+    }
+
     m_cached_display_list = display_list;
     m_cached_display_list_paint_config = config;
 
@@ -6764,6 +6942,22 @@ ElementByIdMap& Document::element_by_id() const
     return *m_element_by_id;
 }
 
+Optional<CSS::SelectorList> Document::parse_selector_for_scripting(StringView selector_text) const
+{
+    // NOTE: This keeps the cache from growing without bounds for scripts that generate their selectors.
+    static constexpr size_t max_parsed_selectors_for_scripting = 256;
+
+    auto key = MUST(String::from_utf8(selector_text));
+    if (auto it = m_parsed_selectors_for_scripting.find(key); it != m_parsed_selectors_for_scripting.end())
+        return it->value;
+
+    auto selectors = parse_selector(CSS::Parser::ParsingParams { *this }, selector_text);
+    if (m_parsed_selectors_for_scripting.size() >= max_parsed_selectors_for_scripting)
+        m_parsed_selectors_for_scripting.clear();
+    m_parsed_selectors_for_scripting.set(move(key), selectors);
+    return selectors;
+}
+
 String Document::dump_display_list()
 {
     update_layout(UpdateLayoutReason::DumpDisplayList);
@@ -6773,6 +6967,107 @@ String Document::dump_display_list()
     return display_list->dump();
 }
 
+String Document::benchmark_rendering(u32 iterations)
+{
+    AK::Duration style;
+    AK::Duration display_list_record;
+    m_rendering_phase_timings = RenderingPhaseTimings {};
+
+    for (u32 i = 0; i < iterations; ++i) {
+        set_needs_full_style_update(true);
+        invalidate_layout_tree(InvalidateLayoutTreeReason::InternalsBenchmarkRendering);
+
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        update_style();
+        style += timer.elapsed_time();
+
+        update_layout(UpdateLayoutReason::InternalsBenchmarkRendering);
+
+        invalidate_display_list();
+        timer.start();
+        (void)record_display_list(HTML::PaintConfig {});
+        display_list_record += timer.elapsed_time();
+    }
+
+    auto timings = m_rendering_phase_timings.release_value();
+
+    JsonObject result;
+    result.set("iterations"sv, iterations);
+    auto add_phase = [&](StringView name, AK::Duration total) {
+        JsonObject phase;
+        auto total_ms = static_cast<double>(total.to_microseconds()) / 1000.0;
+        phase.set("total_ms"sv, total_ms);
+        phase.set("average_ms"sv, iterations ? total_ms / iterations : 0.0);
+        result.set(name, move(phase));
+    };
+    add_phase("style"sv, style);
+    add_phase("layout_tree_build"sv, timings.layout_tree_build);
+    add_phase("layout"sv, timings.layout);
+    add_phase("paintable_build"sv, timings.paintable_build);
+    add_phase("display_list_record"sv, display_list_record);
+    return result.serialized();
+}
+
+String Document::benchmark_rasterization(u32 iterations)
+{
+    update_layout(UpdateLayoutReason::InternalsBenchmarkRendering);
+
+    auto display_list = record_display_list(HTML::PaintConfig {});
+    if (!display_list)
+        return {};
+
+    auto device_viewport_size = page().css_to_device_rect(viewport_rect()).size().to_type<int>();
+    if (device_viewport_size.is_empty())
+        return {};
+    auto bitmap = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, device_viewport_size).release_value_but_fixme_should_propagate_errors();
+    auto painting_surface = Gfx::PaintingSurface::wrap_bitmap(*bitmap);
+
+    // NOTE: Only the scroll state of this document is captured, so nested navigables are painted unscrolled.
+    auto& document_paintable = *paintable();
+    document_paintable.refresh_scroll_state();
+    auto scroll_state_snapshot = document_paintable.scroll_state().snapshot();
+
+    // NOTE: The first playback fills the player's caches, so it is reported separately from the others.
+    Painting::DisplayListPlayerSkia player;
+    Optional<AK::Duration> first;
+    AK::Duration total;
+    Optional<AK::Duration> fastest;
+    Optional<AK::Duration> slowest;
+    for (u32 i = 0; i < iterations; ++i) {
+        Painting::ScrollStateSnapshotByDisplayList scroll_state_snapshot_by_display_list;
+        scroll_state_snapshot_by_display_list.set(*display_list, scroll_state_snapshot);
+
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        player.execute(*display_list, move(scroll_state_snapshot_by_display_list), painting_surface);
+        auto elapsed = timer.elapsed_time();
+
+        if (!first.has_value()) {
+            first = elapsed;
+            continue;
+        }
+        total += elapsed;
+        if (!fastest.has_value() || elapsed < *fastest)
+            fastest = elapsed;
+        if (!slowest.has_value() || elapsed > *slowest)
+            slowest = elapsed;
+    }
+
+    auto to_milliseconds = [](AK::Duration duration) {
+        return static_cast<double>(duration.to_microseconds()) / 1000.0;
+    };
+
+    JsonObject result;
+    result.set("iterations"sv, iterations);
+    result.set("commands"sv, display_list->commands().size());
+    result.set("width"sv, device_viewport_size.width());
+    result.set("height"sv, device_viewport_size.height());
+    result.set("first_ms"sv, to_milliseconds(first.value_or({})));
+    result.set("average_ms"sv, iterations > 1 ? to_milliseconds(total) / (iterations - 1) : 0.0);
+    result.set("fastest_ms"sv, to_milliseconds(fastest.value_or({})));
+    result.set("slowest_ms"sv, to_milliseconds(slowest.value_or({})));
+    return result.serialized();
+}
+
 Optional<Vector<CSS::Parser::ComponentValue>> Document::environment_variable_value(CSS::EnvironmentVariable environment_variable, Span<i64> indices) const
 {
     auto invalid = [] {
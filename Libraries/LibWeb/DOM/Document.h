@@ -10,9 +10,11 @@
 #pragma once
 
 #include <AK/Function.h>
+#include <AK/FunctionRef.h>
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <AK/String.h>
+#include <AK/Time.h>
 #include <AK/Vector.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/Forward.h>
@@ -61,6 +63,7 @@ enum class QuirksMode {
     X(DocumentRequestAnElementToBeRemovedFromTheTopLayer) \
     X(DocumentImmediatelyRemoveElementFromTheTopLayer)    \
     X(DocumentPendingTopLayerRemovalsProcessed)           \
+    X(InternalsBenchmarkRendering)                        \
     X(ShadowRootSetInnerHTML)
 
 enum class InvalidateLayoutTreeReason {
@@ -113,6 +116,7 @@ enum class InvalidateLayoutTreeReason {
     X(HTMLImageElementWidth)               \
     X(HTMLInputElementHeight)              \
     X(HTMLInputElementWidth)               \
+    X(InternalsBenchmarkRendering)         \
     X(InternalsHitTest)                    \
     X(MediaQueryListMatches)               \
     X(NodeNameOrDescription)               \
@@ -257,7 +261,7 @@ public:
     CSS::StyleSheetList& style_sheets();
     CSS::StyleSheetList const& style_sheets() const;
 
-    void for_each_active_css_style_sheet(Function<void(CSS::CSSStyleSheet&, GC::Ptr<DOM::ShadowRoot>)>&& callback) const;
+    void for_each_active_css_style_sheet(FunctionRef<void(CSS::CSSStyleSheet&, GC::Ptr<DOM::ShadowRoot>)> callback) const;
 
     CSS::StyleSheetList* style_sheets_for_bindings() { return &style_sheets(); }
 
@@ -549,7 +553,13 @@ public:
     void run_the_scroll_steps();
 
     void evaluate_media_queries_and_report_changes();
-    void set_needs_media_query_evaluation() { m_needs_media_query_evaluation = true; }
+    void set_needs_media_query_evaluation()
+    {
+        m_needs_media_query_evaluation = true;
+        m_media_query_results.clear();
+    }
+    Optional<bool> cached_media_query_result(String const& serialized_media_query) const { return m_media_query_results.get(serialized_media_query); }
+    void cache_media_query_result(String serialized_media_query, bool matches) const { m_media_query_results.set(move(serialized_media_query), matches); }
     void add_media_query_list(GC::Ref<CSS::MediaQueryList>);
 
     GC::Ref<CSS::VisualViewport> visual_viewport();
@@ -706,6 +716,8 @@ public:
     HTML::ListOfAvailableImages& list_of_available_images();
     HTML::ListOfAvailableImages const& list_of_available_images() const;
 
+    HTML::MapOfPreloadedResources& map_of_preloaded_resources();
+
     void register_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, IntersectionObserver::IntersectionObserver&);
     void unregister_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, IntersectionObserver::IntersectionObserver&);
 
@@ -776,7 +788,15 @@ public:
     GC::RootVector<GC::Ref<Element>> elements_from_point(double x, double y);
     GC::Ptr<Element const> scrolling_element() const;
 
-    void set_needs_to_resolve_paint_only_properties() { m_needs_to_resolve_paint_only_properties = true; }
+    void set_needs_to_resolve_paint_only_properties()
+    {
+        m_needs_to_resolve_paint_only_properties = true;
+        ++m_geometry_generation;
+    }
+
+    // Bumped whenever layout, paint-only properties or scroll offsets change, i.e. whenever the box geometry observed
+    // by IntersectionObserver and ResizeObserver may have changed.
+    u64 geometry_generation() const { return m_geometry_generation; }
     void set_needs_animated_style_update() { m_needs_animated_style_update = true; }
 
     virtual JS::Value named_item_value(FlyString const& name) const override;
@@ -844,12 +864,19 @@ public:
     void set_cached_navigable(GC::Ptr<HTML::Navigable>);
 
     void set_needs_display(InvalidateDisplayList = InvalidateDisplayList::Yes);
-    void set_needs_display(CSSPixelRect const&, InvalidateDisplayList = InvalidateDisplayList::Yes);
+    // The damage rect is in viewport coordinates. It's only used to limit repainting if the display list is not
+    // invalidated; otherwise, or without a damage rect, the whole viewport is repainted.
+    void set_needs_display(Optional<CSSPixelRect> const& damage_rect, InvalidateDisplayList = InvalidateDisplayList::Yes);
 
     RefPtr<Painting::DisplayList> cached_display_list() const;
+    [[nodiscard]] bool update_opacity_in_cached_display_list(Painting::PaintableBox const&, float opacity);
+    [[nodiscard]] bool update_transform_in_cached_display_list(Painting::PaintableBox&);
     RefPtr<Painting::DisplayList> record_display_list(HTML::PaintConfig);
 
     void invalidate_display_list();
+    // Like invalidate_display_list(), but only the stacking contexts painting the given paintable are recorded again.
+    void invalidate_display_list(Painting::Paintable const&);
+    u64 display_list_generation() const { return m_display_list_generation; }
 
     Unicode::Segmenter& grapheme_segmenter() const;
     Unicode::Segmenter& word_segmenter() const;
@@ -932,11 +959,23 @@ public:
 
     ElementByIdMap& element_by_id() const;
 
+    // Parses selectors passed to querySelector() and friends. The results, including failures, are cached by selector
+    // text, since scripts tend to use the same few selectors over and over.
+    Optional<CSS::SelectorList> parse_selector_for_scripting(StringView selector_text) const;
+
     auto& script_blocking_style_sheet_set() { return m_script_blocking_style_sheet_set; }
     auto const& script_blocking_style_sheet_set() const { return m_script_blocking_style_sheet_set; }
 
     String dump_display_list();
 
+    // Repeatedly rebuilds style, the layout tree, layout, paintables and the display list from scratch,
+    // and returns the time spent in each phase as a JSON object.
+    String benchmark_rendering(u32 iterations);
+
+    // Records the display list once and repeatedly plays it back onto a viewport-sized bitmap, and returns
+    // the time spent in playback as a JSON object.
+    String benchmark_rasterization(u32 iterations);
+
     StyleInvalidator& style_invalidator() { return m_style_invalidator; }
 
     Optional<Vector<CSS::Parser::ComponentValue>> environment_variable_value(CSS::EnvironmentVariable, Span<i64> indices = {}) const;
@@ -967,6 +1006,7 @@ private:
     void run_unloading_cleanup_steps();
 
     void evaluate_media_rules();
+    void invalidate_media_query_results_if_needed();
 
     enum class AddLineFeed {
         Yes,
@@ -1006,6 +1046,7 @@ private:
     GC::Ptr<HTML::BrowsingContext> m_browsing_context;
     URL::URL m_url;
     mutable OwnPtr<ElementByIdMap> m_element_by_id;
+    mutable HashMap<String, Optional<CSS::SelectorList>> m_parsed_selectors_for_scripting;
 
     GC::Ptr<HTML::Window> m_window;
 
@@ -1122,6 +1163,11 @@ private:
     bool m_needs_media_query_evaluation { false };
     Vector<GC::Weak<CSS::MediaQueryList>> m_media_query_lists;
 
+    // Results of media query evaluation, keyed by the serialized media query. These are only valid for as long as
+    // the values of all media features stay the same, see invalidate_media_query_results_if_needed().
+    mutable HashMap<String, bool> m_media_query_results;
+    String m_media_feature_values_for_media_query_results;
+
     bool m_needs_full_style_update { false };
     bool m_needs_full_layout_tree_update { false };
 
@@ -1192,6 +1238,9 @@ private:
     // https://html.spec.whatwg.org/multipage/images.html#list-of-available-images
     GC::Ptr<HTML::ListOfAvailableImages> m_list_of_available_images;
 
+    // https://html.spec.whatwg.org/multipage/links.html#map-of-preloaded-resources
+    GC::Ptr<HTML::MapOfPreloadedResources> m_map_of_preloaded_resources;
+
     GC::Ptr<CSS::VisualViewport> m_visual_viewport;
 
     // NOTE: Not in the spec per se, but Document must be able to access all IntersectionObservers whose root is in the document.
@@ -1245,6 +1294,7 @@ private:
     bool m_design_mode_enabled { false };
 
     bool m_needs_to_resolve_paint_only_properties { true };
+    u64 m_geometry_generation { 0 };
 
     mutable GC::Ptr<WebIDL::ObservableArray> m_adopted_style_sheets;
 
@@ -1289,7 +1339,16 @@ private:
     bool m_enable_cookies_on_file_domains { false };
 
     Optional<HTML::PaintConfig> m_cached_display_list_paint_config;
+
+    struct RenderingPhaseTimings {
+        AK::Duration layout_tree_build;
+        AK::Duration layout;
+        AK::Duration paintable_build;
+    };
+    Optional<RenderingPhaseTimings> m_rendering_phase_timings;
     RefPtr<Painting::DisplayList> m_cached_display_list;
+    // Bumped whenever the whole display list is invalidated, which drops the commands cached by all stacking contexts.
+    u64 m_display_list_generation { 0 };
 
     mutable OwnPtr<Unicode::Segmenter> m_grapheme_segmenter;
     mutable OwnPtr<Unicode::Segmenter> m_word_segmenter;
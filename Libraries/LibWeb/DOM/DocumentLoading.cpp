@@ -8,6 +8,7 @@
 
 #include <AK/Debug.h>
 #include <AK/LexicalPath.h>
+#include <AK/Utf8View.h>
 #include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/DOM/Document.h>
@@ -93,9 +94,10 @@ static WebIDL::ExceptionOr<GC::Ref<DOM::Document>> load_html_document(HTML::Navi
     else {
         // FIXME: Parse as we receive the document data, instead of waiting for the whole document to be fetched first.
         auto process_body = GC::create_function(document->heap(), [document, url = navigation_params.response->url().value(), mime_type = navigation_params.response->header_list()->extract_mime_type()](ByteBuffer data) {
-            Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(document->heap(), [document = document, data = move(data), url = url, mime_type] {
-                auto parser = HTML::HTMLParser::create_with_uncertain_encoding(document, data, mime_type);
-                parser->run(url);
+            Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(document->heap(), [document = document, data = move(data), url = url, mime_type]() mutable {
+                HTML::HTMLParser::create_with_uncertain_encoding_in_the_background(document, move(data), mime_type, GC::create_function(document->heap(), [url](GC::Ref<HTML::HTMLParser> parser) {
+                    parser->run(url);
+                }));
             }));
         });
 
@@ -111,6 +113,164 @@ static WebIDL::ExceptionOr<GC::Ref<DOM::Document>> load_html_document(HTML::Navi
     return document;
 }
 
+// Parses the body of an XML document as it arrives, so that large documents can be shown before all of them is loaded.
+class XMLDocumentBodyParser final : public JS::Cell {
+    GC_CELL(XMLDocumentBodyParser, JS::Cell);
+    GC_DECLARE_ALLOCATOR(XMLDocumentBodyParser);
+
+public:
+    void process_body_chunk(ByteBuffer);
+    void process_end_of_body();
+
+private:
+    XMLDocumentBodyParser(DOM::Document& document, Optional<String> content_encoding, MimeSniff::MimeType mime_type)
+        : m_document(document)
+        , m_content_encoding(move(content_encoding))
+        , m_mime_type(move(mime_type))
+        , m_builder(document)
+        , m_parser(m_builder, { .preserve_cdata = true, .preserve_comments = true, .resolve_external_resource = resolve_xml_resource })
+    {
+    }
+
+    virtual void visit_edges(Visitor&) override;
+
+    void determine_decoder();
+    void parse_received_utf8_data(bool at_end_of_body);
+    void fail(Utf16String error);
+
+    GC::Ref<DOM::Document> m_document;
+    Optional<String> m_content_encoding;
+    MimeSniff::MimeType m_mime_type;
+
+    Optional<TextCodec::Decoder&> m_decoder;
+    bool m_decoder_is_utf8 { false };
+
+    // The data that hasn't been handed to the parser yet.
+    ByteBuffer m_received_data;
+    bool m_has_parsed_data { false };
+    bool m_has_failed { false };
+
+    XMLDocumentBuilder m_builder;
+    XML::StreamingParser m_parser;
+};
+
+GC_DEFINE_ALLOCATOR(XMLDocumentBodyParser);
+
+void XMLDocumentBodyParser::visit_edges(Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_document);
+    m_builder.visit_edges(visitor);
+}
+
+void XMLDocumentBodyParser::process_body_chunk(ByteBuffer chunk)
+{
+    if (m_has_failed)
+        return;
+
+    if (m_received_data.try_append(chunk).is_error()) {
+        fail("Failed to decode XML document: Out of memory"_utf16);
+        return;
+    }
+
+    // The encoding sniffing algorithm looks at the first 1024 bytes of the document, so we wait for those before
+    // deciding on an encoding.
+    if (!m_decoder.has_value() && !m_content_encoding.has_value() && m_received_data.size() < 1024)
+        return;
+
+    determine_decoder();
+
+    // Only UTF-8 documents are parsed as they arrive, documents in other encodings are decoded once all of them has
+    // arrived.
+    if (m_decoder_is_utf8)
+        parse_received_utf8_data(false);
+}
+
+void XMLDocumentBodyParser::process_end_of_body()
+{
+    if (m_has_failed)
+        return;
+
+    determine_decoder();
+
+    if (m_decoder_is_utf8) {
+        parse_received_utf8_data(true);
+        if (m_has_failed)
+            return;
+    } else {
+        // Well-formed XML documents contain only properly encoded characters
+        if (!m_decoder->validate(m_received_data)) {
+            fail("XML Document contains improperly-encoded characters"_utf16);
+            return;
+        }
+        auto source = m_decoder->to_utf8(m_received_data);
+        if (source.is_error()) {
+            fail(Utf16String::formatted("Failed to decode XML document: {}", source.error()));
+            return;
+        }
+        m_parser.append(source.value());
+    }
+
+    auto result = m_parser.finish();
+    if (result.is_error()) {
+        // FIXME: Insert error message into the document.
+        dbgln("Failed to parse XML document: {}", result.error());
+        convert_to_xml_error_document(m_document, Utf16String::formatted("Failed to parse XML document: {}", result.error()));
+
+        // NOTE: XMLDocumentBuilder ensures that the `load` event gets fired. We don't need to do anything else here.
+    }
+}
+
+void XMLDocumentBodyParser::determine_decoder()
+{
+    if (m_decoder.has_value())
+        return;
+
+    // The actual HTTP headers and other metadata, not the headers as mutated or implied by the algorithms given in this specification,
+    // are the ones that must be used when determining the character encoding according to the rules given in the above specifications.
+    if (m_content_encoding.has_value())
+        m_decoder = TextCodec::decoder_for(*m_content_encoding);
+    if (!m_decoder.has_value()) {
+        auto encoding = HTML::run_encoding_sniffing_algorithm(m_document, m_received_data, m_mime_type);
+        m_decoder = TextCodec::decoder_for(encoding);
+    }
+    VERIFY(m_decoder.has_value());
+
+    m_decoder_is_utf8 = &m_decoder.value() == &TextCodec::decoder_for("utf-8"sv).value();
+}
+
+void XMLDocumentBodyParser::parse_received_utf8_data(bool at_end_of_body)
+{
+    size_t valid_length = 0;
+
+    // Well-formed XML documents contain only properly encoded characters. Until the end of the body, the data may end
+    // in the middle of a code point that the next chunk completes though.
+    if (!Utf8View { StringView { m_received_data } }.validate(valid_length)) {
+        if (at_end_of_body || m_received_data.size() - valid_length >= 4) {
+            fail("XML Document contains improperly-encoded characters"_utf16);
+            return;
+        }
+    }
+
+    auto valid_data = StringView { m_received_data.bytes().trim(valid_length) };
+    auto bom_handling = m_has_parsed_data ? String::WithBOMHandling::No : String::WithBOMHandling::Yes;
+    m_parser.append(String::from_utf8_with_replacement_character(valid_data, bom_handling));
+    m_has_parsed_data = true;
+
+    m_received_data = MUST(m_received_data.slice(valid_length, m_received_data.size() - valid_length));
+}
+
+void XMLDocumentBodyParser::fail(Utf16String error)
+{
+    // FIXME: Insert error message into the document.
+    dbgln("{}", error);
+    convert_to_xml_error_document(m_document, move(error));
+    m_has_failed = true;
+
+    // NOTE: This ensures that the `load` event gets fired for the frame loading this document.
+    m_document->completely_finish_loading();
+}
+
 // https://html.spec.whatwg.org/multipage/document-lifecycle.html#read-xml
 static WebIDL::ExceptionOr<GC::Ref<DOM::Document>> load_xml_document(HTML::NavigationParams const& navigation_params, MimeSniff::MimeType type)
 {
@@ -147,47 +307,14 @@ static WebIDL::ExceptionOr<GC::Ref<DOM::Document>> load_xml_document(HTML::Navig
     if (auto maybe_encoding = type.parameters().get("charset"sv); maybe_encoding.has_value())
         content_encoding = maybe_encoding.value();
 
-    auto process_body = GC::create_function(document->heap(), [document, url = navigation_params.response->url().value(), content_encoding = move(content_encoding), mime = type](ByteBuffer data) {
-        Optional<TextCodec::Decoder&> decoder;
-        // The actual HTTP headers and other metadata, not the headers as mutated or implied by the algorithms given in this specification,
-        // are the ones that must be used when determining the character encoding according to the rules given in the above specifications.
-        if (content_encoding.has_value())
-            decoder = TextCodec::decoder_for(*content_encoding);
-        if (!decoder.has_value()) {
-            auto encoding = HTML::run_encoding_sniffing_algorithm(document, data, mime);
-            decoder = TextCodec::decoder_for(encoding);
-        }
-        VERIFY(decoder.has_value());
-        // Well-formed XML documents contain only properly encoded characters
-        if (!decoder->validate(data)) {
-            // FIXME: Insert error message into the document.
-            dbgln("XML Document contains improperly-encoded characters");
-            convert_to_xml_error_document(document, "XML Document contains improperly-encoded characters"_utf16);
+    auto parser = document->heap().allocate<XMLDocumentBodyParser>(document, move(content_encoding), type);
 
-            // NOTE: This ensures that the `load` event gets fired for the frame loading this document.
-            document->completely_finish_loading();
-            return;
-        }
-        auto source = decoder->to_utf8(data);
-        if (source.is_error()) {
-            // FIXME: Insert error message into the document.
-            dbgln("Failed to decode XML document: {}", source.error());
-            convert_to_xml_error_document(document, Utf16String::formatted("Failed to decode XML document: {}", source.error()));
+    auto process_body_chunk = GC::create_function(document->heap(), [parser](ByteBuffer chunk) {
+        parser->process_body_chunk(move(chunk));
+    });
 
-            // NOTE: This ensures that the `load` event gets fired for the frame loading this document.
-            document->completely_finish_loading();
-            return;
-        }
-        XML::Parser parser(source.value(), { .preserve_cdata = true, .preserve_comments = true, .resolve_external_resource = resolve_xml_resource });
-        XMLDocumentBuilder builder { document };
-        auto result = parser.parse_with_listener(builder);
-        if (result.is_error()) {
-            // FIXME: Insert error message into the document.
-            dbgln("Failed to parse XML document: {}", result.error());
-            convert_to_xml_error_document(document, Utf16String::formatted("Failed to parse XML document: {}", result.error()));
-
-            // NOTE: XMLDocumentBuilder ensures that the `load` event gets fired. We don't need to do anything else here.
-        }
+    auto process_end_of_body = GC::create_function(document->heap(), [parser] {
+        parser->process_end_of_body();
     });
 
     auto process_body_error = GC::create_function(document->heap(), [](JS::Value) {
@@ -195,7 +322,7 @@ static WebIDL::ExceptionOr<GC::Ref<DOM::Document>> load_xml_document(HTML::Navig
     });
 
     auto& realm = document->realm();
-    navigation_params.response->body()->fully_read(realm, process_body, process_body_error, GC::Ref { realm.global_object() });
+    navigation_params.response->body()->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, GC::Ref { realm.global_object() });
 
     return document;
 }
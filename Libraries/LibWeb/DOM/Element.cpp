@@ -119,23 +119,23 @@ void Element::visit_edges(Cell::Visitor& visitor)
 
     visitor.visit(m_attributes);
     visitor.visit(m_inline_style);
-    visitor.visit(m_class_list);
     visitor.visit(m_shadow_root);
-    visitor.visit(m_custom_element_definition);
-    visitor.visit(m_custom_state_set);
     visitor.visit(m_cascaded_properties);
     visitor.visit(m_computed_properties);
-    visitor.visit(m_computed_style_map_cache);
-    visitor.visit(m_attribute_style_map);
+    if (m_rare_data) {
+        visitor.visit(m_rare_data->attribute_style_map);
+        visitor.visit(m_rare_data->class_list);
+        visitor.visit(m_rare_data->custom_element_definition);
+        visitor.visit(m_rare_data->custom_state_set);
+        for (auto& registered_intersection_observer : m_rare_data->registered_intersection_observers)
+            visitor.visit(registered_intersection_observer.observer);
+        visitor.visit(m_rare_data->computed_style_map_cache);
+    }
     if (m_pseudo_element_data) {
         for (auto& pseudo_element : *m_pseudo_element_data) {
             visitor.visit(pseudo_element.value);
         }
     }
-    if (m_registered_intersection_observers) {
-        for (auto& registered_intersection_observers : *m_registered_intersection_observers)
-            visitor.visit(registered_intersection_observers.observer);
-    }
     if (m_counters_set)
         m_counters_set->visit_edges(visitor);
 }
@@ -665,7 +665,7 @@ void Element::run_attribute_change_steps(FlyString const& local_name, Optional<S
 
     if (old_value != value) {
         invalidate_style_after_attribute_change(local_name, old_value, value);
-        document().bump_dom_tree_version();
+        bump_subtree_version();
     }
 }
 
@@ -851,6 +851,11 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_inherited_style()
     document().style_computer().compute_font(*computed_properties, abstract_element);
     document().style_computer().compute_property_values(*computed_properties, abstract_element);
 
+    if (auto parent = abstract_element.element_to_inherit_style_from(); parent.has_value()) {
+        if (auto parent_style = parent->computed_properties())
+            computed_properties->share_inherited_property_values_if_equal(*parent_style);
+    }
+
     for (auto [property_id, old_value] : old_values_with_relative_units) {
         auto const& new_value = computed_properties->property(static_cast<CSS::PropertyID>(property_id));
         invalidation |= CSS::compute_property_invalidation(static_cast<CSS::PropertyID>(property_id), old_value, new_value);
@@ -863,11 +868,19 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_inherited_style()
     return invalidation;
 }
 
+Element::RareData& Element::ensure_rare_data()
+{
+    if (!m_rare_data)
+        m_rare_data = make<RareData>();
+    return *m_rare_data;
+}
+
 DOMTokenList* Element::class_list()
 {
-    if (!m_class_list)
-        m_class_list = DOMTokenList::create(*this, HTML::AttributeNames::class_);
-    return m_class_list;
+    auto& rare_data = ensure_rare_data();
+    if (!rare_data.class_list)
+        rare_data.class_list = DOMTokenList::create(*this, HTML::AttributeNames::class_);
+    return rare_data.class_list;
 }
 
 // https://dom.spec.whatwg.org/#valid-shadow-host-name
@@ -895,9 +908,9 @@ WebIDL::ExceptionOr<void> Element::attach_a_shadow_root(Bindings::ShadowRootMode
         return WebIDL::NotSupportedError::create(realm(), "Element's local name is not a valid shadow host name"_utf16);
 
     // 3. If element’s local name is a valid custom element name, or element’s is value is not null, then:
-    if (HTML::is_valid_custom_element_name(local_name()) || m_is_value.has_value()) {
+    if (HTML::is_valid_custom_element_name(local_name()) || is_value().has_value()) {
         // 1. Let definition be the result of looking up a custom element definition given element’s node document, its namespace, its local name, and its is value.
-        auto definition = document().lookup_custom_element_definition(namespace_uri(), local_name(), m_is_value);
+        auto definition = document().lookup_custom_element_definition(namespace_uri(), local_name(), is_value());
 
         // 2. If definition is not null and definition’s disable shadow is true, then throw a "NotSupportedError" DOMException.
         if (definition && definition->disable_shadow())
@@ -983,7 +996,7 @@ GC::Ptr<ShadowRoot> Element::shadow_root_for_bindings() const
 WebIDL::ExceptionOr<bool> Element::matches(StringView selectors) const
 {
     // 1. Let s be the result of parse a selector from selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingParams(document()), selectors);
+    auto maybe_selectors = document().parse_selector_for_scripting(selectors);
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
@@ -1003,7 +1016,7 @@ WebIDL::ExceptionOr<bool> Element::matches(StringView selectors) const
 WebIDL::ExceptionOr<DOM::Element const*> Element::closest(StringView selectors) const
 {
     // 1. Let s be the result of parse a selector from selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingParams(document()), selectors);
+    auto maybe_selectors = document().parse_selector_for_scripting(selectors);
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
@@ -1121,16 +1134,17 @@ GC::Ref<CSS::CSSStyleProperties> Element::style_for_bindings()
 
 GC::Ref<CSS::StylePropertyMap> Element::attribute_style_map()
 {
-    if (!m_attribute_style_map)
-        m_attribute_style_map = CSS::StylePropertyMap::create(realm(), style_for_bindings());
-    return *m_attribute_style_map;
+    auto& rare_data = ensure_rare_data();
+    if (!rare_data.attribute_style_map)
+        rare_data.attribute_style_map = CSS::StylePropertyMap::create(realm(), style_for_bindings());
+    return *rare_data.attribute_style_map;
 }
 
 void Element::set_inline_style(GC::Ptr<CSS::CSSStyleProperties> style)
 {
     m_inline_style = style;
-    if (m_attribute_style_map)
-        m_attribute_style_map = nullptr;
+    if (m_rare_data)
+        m_rare_data->attribute_style_map = nullptr;
     set_needs_style_update(true);
 }
 
@@ -2541,7 +2555,10 @@ void Element::invalidate_style_after_attribute_change(FlyString const& attribute
         changed_properties.append({ .type = CSS::InvalidationSet::Property::Type::PseudoClass, .value = CSS::PseudoClass::Optional });
     }
 
-    changed_properties.append({ .type = CSS::InvalidationSet::Property::Type::Attribute, .value = attribute_name });
+    // NOTE: Changing an attribute's value to another value that no selector distinguishes can't change which attribute
+    //       selectors match, so we don't have to invalidate anything for the attribute itself.
+    if (document().style_computer().attribute_change_may_affect_selectors(attribute_name, old_value, new_value))
+        changed_properties.append({ .type = CSS::InvalidationSet::Property::Type::Attribute, .value = attribute_name });
     invalidate_style(StyleInvalidationReason::ElementAttributeChange, changed_properties, style_invalidation_options);
 }
 
@@ -2704,7 +2721,7 @@ void Element::enqueue_a_custom_element_upgrade_reaction(HTML::CustomElementDefin
 void Element::enqueue_a_custom_element_callback_reaction(FlyString const& callback_name, GC::RootVector<JS::Value> arguments)
 {
     // 1. Let definition be element's custom element definition.
-    auto& definition = m_custom_element_definition;
+    auto definition = custom_element_definition();
 
     // 2. Let callback be the value of the entry in definition's lifecycle callbacks with key callbackName.
     GC::Ptr<Web::WebIDL::CallbackType> callback;
@@ -2778,7 +2795,7 @@ JS::ThrowCompletionOr<void> Element::upgrade_element(GC::Ref<HTML::CustomElement
         return {};
 
     // 2. Set element's custom element definition to definition.
-    m_custom_element_definition = custom_element_definition;
+    ensure_rare_data().custom_element_definition = custom_element_definition;
 
     // 3. Set element's custom element state to "failed".
     set_custom_element_state(CustomElementState::Failed);
@@ -2840,11 +2857,11 @@ JS::ThrowCompletionOr<void> Element::upgrade_element(GC::Ref<HTML::CustomElement
     // Finally, if the above steps threw an exception, then:
     if (maybe_exception.is_throw_completion()) {
         // 1. Set element's custom element definition to null.
-        m_custom_element_definition = nullptr;
+        m_rare_data->custom_element_definition = nullptr;
 
         // 2. Empty element's custom element reaction queue.
-        if (m_custom_element_reaction_queue)
-            m_custom_element_reaction_queue->clear();
+        if (m_rare_data->custom_element_reaction_queue)
+            m_rare_data->custom_element_reaction_queue->clear();
 
         // 3. Rethrow the exception (thus terminating this algorithm).
         return maybe_exception.release_error();
@@ -2864,7 +2881,7 @@ JS::ThrowCompletionOr<void> Element::upgrade_element(GC::Ref<HTML::CustomElement
 void Element::try_to_upgrade()
 {
     // 1. Let definition be the result of looking up a custom element definition given element's node document, element's namespace, element's local name, and element's is value.
-    auto definition = document().lookup_custom_element_definition(namespace_uri(), local_name(), m_is_value);
+    auto definition = document().lookup_custom_element_definition(namespace_uri(), local_name(), is_value());
 
     // 2. If definition is not null, then enqueue a custom element upgrade reaction given element and definition.
     if (definition)
@@ -2903,10 +2920,11 @@ void Element::setup_custom_element_from_constructor(HTML::CustomElementDefinitio
     set_custom_element_state(CustomElementState::Custom);
 
     // 7.7. Set element's custom element definition to definition.
-    m_custom_element_definition = custom_element_definition;
+    auto& rare_data = ensure_rare_data();
+    rare_data.custom_element_definition = custom_element_definition;
 
     // 7.8. Set element's is value to is value.
-    m_is_value = is_value;
+    rare_data.is_value = is_value;
 }
 
 void Element::set_prefix(Optional<FlyString> value)
@@ -2938,7 +2956,7 @@ Optional<String> Element::locate_a_namespace_prefix(Optional<String> const& name
     return {};
 }
 
-void Element::for_each_attribute(Function<void(Attr const&)> callback) const
+void Element::for_each_attribute(FunctionRef<void(Attr const&)> callback) const
 {
     if (!m_attributes)
         return;
@@ -2946,7 +2964,7 @@ void Element::for_each_attribute(Function<void(Attr const&)> callback) const
         callback(*m_attributes->item(i));
 }
 
-void Element::for_each_attribute(Function<void(FlyString const&, String const&)> callback) const
+void Element::for_each_attribute(FunctionRef<void(FlyString const&, String const&)> callback) const
 {
     for_each_attribute([&callback](Attr const& attr) {
         callback(attr.name(), attr.value());
@@ -3279,11 +3297,20 @@ void Element::determine_proximity_to_the_viewport()
 
     // - The element is far away from the viewport: In this state, the element’s proximity to the viewport has been
     //   computed and is not close to the viewport.
-    m_proximity_to_the_viewport = ProximityToTheViewport::FarAwayFromTheViewport;
+    else
+        m_proximity_to_the_viewport = ProximityToTheViewport::FarAwayFromTheViewport;
 
     // - The element’s proximity to the viewport is not determined: In this state, the computation to determine the
     //   element’s proximity to the viewport has not been done since the last time the element was connected.
     // NOTE: This function is what does the computation to determine the element’s proximity to the viewport, so this is not the case.
+
+    // NOTE: Remember whether the element skips its contents, so painting doesn't have to re-evaluate whether the
+    //       element is relevant to the user. This is redetermined on every rendering update.
+    auto skips_contents = !is_relevant_to_the_user();
+    if (m_skips_its_contents_due_to_content_visibility_auto != skips_contents) {
+        m_skips_its_contents_due_to_content_visibility_auto = skips_contents;
+        paintable_box()->set_needs_display();
+    }
 }
 
 // https://drafts.csswg.org/css-contain/#relevant-to-the-user
@@ -3471,24 +3498,22 @@ bool Element::id_reference_exists(String const& id_reference) const
 
 void Element::register_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, IntersectionObserver::IntersectionObserverRegistration registration)
 {
-    if (!m_registered_intersection_observers)
-        m_registered_intersection_observers = make<Vector<IntersectionObserver::IntersectionObserverRegistration>>();
-    m_registered_intersection_observers->append(move(registration));
+    ensure_rare_data().registered_intersection_observers.append(move(registration));
 }
 
 void Element::unregister_intersection_observer(Badge<IntersectionObserver::IntersectionObserver>, GC::Ref<IntersectionObserver::IntersectionObserver> observer)
 {
-    if (!m_registered_intersection_observers)
+    if (!m_rare_data)
         return;
-    m_registered_intersection_observers->remove_first_matching([&observer](IntersectionObserver::IntersectionObserverRegistration const& entry) {
+    m_rare_data->registered_intersection_observers.remove_first_matching([&observer](IntersectionObserver::IntersectionObserverRegistration const& entry) {
         return entry.observer == observer;
     });
 }
 
 IntersectionObserver::IntersectionObserverRegistration& Element::get_intersection_observer_registration(Badge<DOM::Document>, IntersectionObserver::IntersectionObserver const& observer)
 {
-    VERIFY(m_registered_intersection_observers);
-    auto registration_iterator = m_registered_intersection_observers->find_if([&observer](IntersectionObserver::IntersectionObserverRegistration const& entry) {
+    VERIFY(m_rare_data);
+    auto registration_iterator = m_rare_data->registered_intersection_observers.find_if([&observer](IntersectionObserver::IntersectionObserverRegistration const& entry) {
         return entry.observer.ptr() == &observer;
     });
     VERIFY(!registration_iterator.is_end());
@@ -3824,8 +3849,8 @@ void Element::attribute_changed(FlyString const& local_name, Optional<String> co
                 m_classes.unchecked_append(FlyString::from_utf8(new_class).release_value_but_fixme_should_propagate_errors());
             }
         }
-        if (m_class_list)
-            m_class_list->associated_attribute_changed(value_or_empty);
+        if (m_rare_data && m_rare_data->class_list)
+            m_rare_data->class_list->associated_attribute_changed(value_or_empty);
     } else if (local_name == HTML::AttributeNames::style) {
         // https://drafts.csswg.org/cssom/#ref-for-cssstyledeclaration-updating-flag
         if (m_inline_style && m_inline_style->is_updating())
@@ -3869,18 +3894,26 @@ void Element::attribute_changed(FlyString const& local_name, Optional<String> co
 #undef __ENUMERATE_ARIA_ATTRIBUTE
 }
 
+Optional<String> const& Element::is_value() const
+{
+    static Optional<String> const no_is_value;
+    return m_rare_data ? m_rare_data->is_value : no_is_value;
+}
+
 auto Element::ensure_custom_element_reaction_queue() -> CustomElementReactionQueue&
 {
-    if (!m_custom_element_reaction_queue)
-        m_custom_element_reaction_queue = make<CustomElementReactionQueue>();
-    return *m_custom_element_reaction_queue;
+    auto& rare_data = ensure_rare_data();
+    if (!rare_data.custom_element_reaction_queue)
+        rare_data.custom_element_reaction_queue = make<CustomElementReactionQueue>();
+    return *rare_data.custom_element_reaction_queue;
 }
 
 HTML::CustomStateSet& Element::ensure_custom_state_set()
 {
-    if (!m_custom_state_set)
-        m_custom_state_set = HTML::CustomStateSet::create(realm(), *this);
-    return *m_custom_state_set;
+    auto& rare_data = ensure_rare_data();
+    if (!rare_data.custom_state_set)
+        rare_data.custom_state_set = HTML::CustomStateSet::create(realm(), *this);
+    return *rare_data.custom_state_set;
 }
 
 CSS::StyleSheetList& Element::document_or_shadow_root_style_sheets()
@@ -4177,12 +4210,13 @@ GC::Ref<CSS::StylePropertyMapReadOnly> Element::computed_style_map()
     //
     // NOTE: In practice, since the values are "hidden" behind a .get() method call, UAs can delay computing anything
     //    until a given property is actually requested.
-    if (m_computed_style_map_cache == nullptr) {
-        m_computed_style_map_cache = CSS::StylePropertyMapReadOnly::create_computed_style(realm(), AbstractElement { *this });
+    auto& rare_data = ensure_rare_data();
+    if (rare_data.computed_style_map_cache == nullptr) {
+        rare_data.computed_style_map_cache = CSS::StylePropertyMapReadOnly::create_computed_style(realm(), AbstractElement { *this });
     }
 
     // 2. Return this’s [[computedStyleMapCache]] internal slot.
-    return *m_computed_style_map_cache;
+    return *rare_data.computed_style_map_cache;
 }
 
 // The element to inherit style from.
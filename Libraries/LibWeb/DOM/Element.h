@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/FunctionRef.h>
 #include <AK/IterationDecision.h>
 #include <AK/Optional.h>
 #include <LibWeb/ARIA/ARIAMixin.h>
@@ -190,9 +191,9 @@ public:
     int client_height() const;
     [[nodiscard]] double current_css_zoom() const;
 
-    void for_each_attribute(Function<void(Attr const&)>) const;
+    void for_each_attribute(FunctionRef<void(Attr const&)>) const;
 
-    void for_each_attribute(Function<void(FlyString const&, String const&)>) const;
+    void for_each_attribute(FunctionRef<void(FlyString const&, String const&)>) const;
 
     bool has_class(FlyString const&, CaseSensitivity = CaseSensitivity::CaseSensitive) const;
     Vector<FlyString> const& class_names() const { return m_classes; }
@@ -368,11 +369,11 @@ public:
     void enqueue_a_custom_element_callback_reaction(FlyString const& callback_name, GC::RootVector<JS::Value> arguments);
 
     using CustomElementReactionQueue = Vector<Variant<CustomElementUpgradeReaction, CustomElementCallbackReaction>>;
-    CustomElementReactionQueue* custom_element_reaction_queue() { return m_custom_element_reaction_queue; }
-    CustomElementReactionQueue const* custom_element_reaction_queue() const { return m_custom_element_reaction_queue; }
+    CustomElementReactionQueue* custom_element_reaction_queue() { return m_rare_data ? m_rare_data->custom_element_reaction_queue.ptr() : nullptr; }
+    CustomElementReactionQueue const* custom_element_reaction_queue() const { return m_rare_data ? m_rare_data->custom_element_reaction_queue.ptr() : nullptr; }
     CustomElementReactionQueue& ensure_custom_element_reaction_queue();
 
-    HTML::CustomStateSet const* custom_state_set() const { return m_custom_state_set; }
+    HTML::CustomStateSet const* custom_state_set() const { return m_rare_data ? m_rare_data->custom_state_set.ptr() : nullptr; }
     HTML::CustomStateSet& ensure_custom_state_set();
 
     JS::ThrowCompletionOr<void> upgrade_element(GC::Ref<HTML::CustomElementDefinition> custom_element_definition);
@@ -381,8 +382,8 @@ public:
     bool is_defined() const;
     bool is_custom() const;
 
-    Optional<String> const& is_value() const { return m_is_value; }
-    void set_is_value(Optional<String> const& is) { m_is_value = is; }
+    Optional<String> const& is_value() const;
+    void set_is_value(Optional<String> const& is) { ensure_rare_data().is_value = is; }
 
     void set_custom_element_state(CustomElementState);
     void setup_custom_element_from_constructor(HTML::CustomElementDefinition& custom_element_definition, Optional<String> const& is_value);
@@ -448,6 +449,9 @@ public:
     void determine_proximity_to_the_viewport();
     bool is_relevant_to_the_user();
 
+    // Whether the element was not relevant to the user when its proximity to the viewport was last determined.
+    bool skips_its_contents_due_to_content_visibility_auto() const { return m_skips_its_contents_due_to_content_visibility_auto; }
+
     // https://drafts.csswg.org/css-contain-2/#skips-its-contents
     bool skips_its_contents();
 
@@ -595,8 +599,6 @@ private:
 
     GC::Ptr<NamedNodeMap> m_attributes;
     GC::Ptr<CSS::CSSStyleProperties> m_inline_style;
-    GC::Ptr<CSS::StylePropertyMap> m_attribute_style_map;
-    GC::Ptr<DOMTokenList> m_class_list;
     GC::Ptr<ShadowRoot> m_shadow_root;
 
     GC::Ptr<CSS::CascadedProperties> m_cascaded_properties;
@@ -615,31 +617,41 @@ private:
     Optional<FlyString> m_id;
     Optional<FlyString> m_name;
 
-    // https://html.spec.whatwg.org/multipage/custom-elements.html#custom-element-reaction-queue
-    // All elements have an associated custom element reaction queue, initially empty. Each item in the custom element reaction queue is of one of two types:
-    // NOTE: See the structs at the top of this header.
-    OwnPtr<CustomElementReactionQueue> m_custom_element_reaction_queue;
-
     // https://dom.spec.whatwg.org/#concept-element-custom-element-state
     CustomElementState m_custom_element_state { CustomElementState::Undefined };
 
-    // https://dom.spec.whatwg.org/#concept-element-custom-element-definition
-    GC::Ptr<HTML::CustomElementDefinition> m_custom_element_definition;
+    // NOTE: State that most elements never need. This is only allocated for the elements that do, which keeps the
+    //       footprint of all the others down.
+    struct RareData {
+        GC::Ptr<CSS::StylePropertyMap> attribute_style_map;
+        GC::Ptr<DOMTokenList> class_list;
+
+        // https://html.spec.whatwg.org/multipage/custom-elements.html#custom-element-reaction-queue
+        // All elements have an associated custom element reaction queue, initially empty. Each item in the custom element reaction queue is of one of two types:
+        // NOTE: See the structs at the top of this header.
+        OwnPtr<CustomElementReactionQueue> custom_element_reaction_queue;
 
-    // https://dom.spec.whatwg.org/#concept-element-is-value
-    Optional<String> m_is_value;
+        // https://dom.spec.whatwg.org/#concept-element-custom-element-definition
+        GC::Ptr<HTML::CustomElementDefinition> custom_element_definition;
 
-    // https://html.spec.whatwg.org/multipage/custom-elements.html#states-set
-    GC::Ptr<HTML::CustomStateSet> m_custom_state_set;
+        // https://dom.spec.whatwg.org/#concept-element-is-value
+        Optional<String> is_value;
 
-    // https://www.w3.org/TR/intersection-observer/#dom-element-registeredintersectionobservers-slot
-    // Element objects have an internal [[RegisteredIntersectionObservers]] slot, which is initialized to an empty list.
-    OwnPtr<Vector<IntersectionObserver::IntersectionObserverRegistration>> m_registered_intersection_observers;
+        // https://html.spec.whatwg.org/multipage/custom-elements.html#states-set
+        GC::Ptr<HTML::CustomStateSet> custom_state_set;
 
-    // https://drafts.css-houdini.org/css-typed-om-1/#dom-element-computedstylemapcache-slot
-    // Every Element has a [[computedStyleMapCache]] internal slot, initially set to null, which caches the result of
-    // the computedStyleMap() method when it is first called.
-    GC::Ptr<CSS::StylePropertyMapReadOnly> m_computed_style_map_cache;
+        // https://www.w3.org/TR/intersection-observer/#dom-element-registeredintersectionobservers-slot
+        // Element objects have an internal [[RegisteredIntersectionObservers]] slot, which is initialized to an empty list.
+        Vector<IntersectionObserver::IntersectionObserverRegistration> registered_intersection_observers;
+
+        // https://drafts.css-houdini.org/css-typed-om-1/#dom-element-computedstylemapcache-slot
+        // Every Element has a [[computedStyleMapCache]] internal slot, initially set to null, which caches the result of
+        // the computedStyleMap() method when it is first called.
+        GC::Ptr<CSS::StylePropertyMapReadOnly> computed_style_map_cache;
+    };
+    RareData& ensure_rare_data();
+    GC::Ptr<HTML::CustomElementDefinition> custom_element_definition() const { return m_rare_data ? m_rare_data->custom_element_definition : nullptr; }
+    OwnPtr<RareData> m_rare_data;
 
     CSSPixelPoint m_scroll_offset;
 
@@ -670,6 +682,7 @@ private:
 
     // https://drafts.csswg.org/css-contain/#proximity-to-the-viewport
     ProximityToTheViewport m_proximity_to_the_viewport { ProximityToTheViewport::NotDetermined };
+    bool m_skips_its_contents_due_to_content_visibility_auto { false };
 
     // https://drafts.csswg.org/css-view-transitions-1/#captured-in-a-view-transition
     bool m_captured_in_a_view_transition { false };
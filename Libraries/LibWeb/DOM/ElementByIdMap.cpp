@@ -38,4 +38,16 @@ void ElementByIdMap::remove(FlyString const& element_id, Element& element)
     });
 }
 
+Vector<GC::Ref<Element>> ElementByIdMap::get_all(FlyString const& element_id) const
+{
+    Vector<GC::Ref<Element>> elements;
+    if (auto elements_with_id = m_map.get(element_id); elements_with_id.has_value()) {
+        for (auto const& element : *elements_with_id) {
+            if (element)
+                elements.append(*element);
+        }
+    }
+    return elements;
+}
+
 }
@@ -16,6 +16,7 @@ public:
     void add(FlyString const& element_id, Element&);
     void remove(FlyString const& element_id, Element&);
     GC::Ptr<Element> get(FlyString const& element_id) const;
+    Vector<GC::Ref<Element>> get_all(FlyString const& element_id) const;
 
 private:
     HashMap<FlyString, Vector<GC::Weak<Element>>> m_map;
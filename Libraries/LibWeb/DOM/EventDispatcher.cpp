@@ -147,6 +147,10 @@ void EventDispatcher::invoke(Event::PathEntry& struct_, Event& event, Event::Pha
     // 5. Initialize event’s currentTarget attribute to struct’s invocation target.
     event.set_current_target(struct_.invocation_target.ptr());
 
+    // NOTE: Without any event listeners, the rest of these steps can't do anything, so we skip cloning the empty list.
+    if (!event.current_target()->has_event_listeners())
+        return;
+
     // 6. Let listeners be a clone of event’s currentTarget attribute value’s event listener list.
     // NOTE: This avoids event listeners added after this point from being run. Note that removal still has an effect due to the removed field.
     auto listeners = event.current_target()->event_listener_list();
@@ -190,9 +194,34 @@ bool EventDispatcher::dispatch(GC::Ref<EventTarget> target, Event& event, bool l
     return dispatch(target, event, legacy_target_override, legacy_output_did_listeners_throw);
 }
 
+// NOTE: Events that the user agent fires can't have been seen by any script before they're dispatched. If nothing listens for
+//       their type and dispatching them doesn't run activation behavior or involve shadow trees, the only thing dispatch
+//       would do is leave the event with targetOverride as its target, so we can skip building the event path.
+static bool can_skip_building_event_path(EventTarget const& target, Event& event)
+{
+    if (!event.is_trusted() || event.related_target() || !event.touch_target_list().is_empty())
+        return false;
+    if (is<UIEvents::MouseEvent>(event) && event.type() == HTML::EventNames::click)
+        return false;
+    if (event.type().is_one_of(HTML::EventNames::animationend, HTML::EventNames::animationiteration, HTML::EventNames::animationstart, HTML::EventNames::transitionend))
+        return false;
+    if (is<Node>(target) && static_cast<Node const&>(target).root().is_shadow_root())
+        return false;
+    return !EventTarget::has_event_listener_of_type_on_any_event_target(event.type());
+}
+
 // https://dom.spec.whatwg.org/#concept-event-dispatch
 bool EventDispatcher::dispatch(GC::Ref<EventTarget> target, Event& event, bool legacy_target_override, bool& legacy_output_did_listeners_throw)
 {
+    if (can_skip_building_event_path(*target, event)) {
+        event.set_target(legacy_target_override ? &as<HTML::Window>(*target).associated_document() : target.ptr());
+        event.set_phase(Event::Phase::None);
+        event.set_current_target(nullptr);
+        event.set_stop_propagation(false);
+        event.set_stop_immediate_propagation(false);
+        return !event.cancelled();
+    }
+
     // 1. Set event’s dispatch flag.
     event.set_dispatched(true);
 
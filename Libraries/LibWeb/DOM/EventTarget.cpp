@@ -48,6 +48,22 @@ namespace Web::DOM {
 
 GC_DEFINE_ALLOCATOR(EventTarget);
 
+// NOTE: This counts the event listeners of each type across all event targets.
+static HashMap<FlyString, size_t> s_event_listener_count_by_type;
+
+static void did_add_event_listener_of_type(FlyString const& type)
+{
+    s_event_listener_count_by_type.ensure(type, [] { return 0; })++;
+}
+
+static void did_remove_event_listener_of_type(FlyString const& type)
+{
+    auto it = s_event_listener_count_by_type.find(type);
+    VERIFY(it != s_event_listener_count_by_type.end());
+    if (--it->value == 0)
+        s_event_listener_count_by_type.remove(it);
+}
+
 EventTarget::EventTarget(JS::Realm& realm, MayInterfereWithIndexedPropertyAccess may_interfere_with_indexed_property_access)
     : PlatformObject(realm, may_interfere_with_indexed_property_access)
 {
@@ -82,6 +98,15 @@ void EventTarget::visit_edges(Cell::Visitor& visitor)
     }
 }
 
+void EventTarget::finalize()
+{
+    Base::finalize();
+    if (auto const* data = m_data.ptr()) {
+        for (auto const& listener : data->event_listener_list)
+            did_remove_event_listener_of_type(listener->type);
+    }
+}
+
 Vector<GC::Root<DOMEventListener>> EventTarget::event_listener_list()
 {
     Vector<GC::Root<DOMEventListener>> list;
@@ -227,8 +252,10 @@ void EventTarget::add_an_event_listener(DOMEventListener& listener)
             && entry->callback->callback().callback == listener.callback->callback().callback
             && entry->capture == listener.capture;
     });
-    if (it == event_listener_list.end())
+    if (it == event_listener_list.end()) {
         event_listener_list.append(listener);
+        did_add_event_listener_of_type(listener.type);
+    }
 
     // 6. If listener’s signal is not null, then add the following abort steps to it:
     if (listener.signal) {
@@ -280,7 +307,8 @@ void EventTarget::remove_an_event_listener(DOMEventListener& listener)
     // 2. Set listener’s removed to true and remove listener from eventTarget’s event listener list.
     listener.removed = true;
     VERIFY(m_data);
-    m_data->event_listener_list.remove_first_matching([&](auto& entry) { return entry.ptr() == &listener; });
+    if (m_data->event_listener_list.remove_first_matching([&](auto& entry) { return entry.ptr() == &listener; }))
+        did_remove_event_listener_of_type(listener.type);
 }
 
 // https://dom.spec.whatwg.org/#dom-eventtarget-dispatchevent
@@ -897,6 +925,11 @@ bool EventTarget::has_event_listeners() const
     return m_data && !m_data->event_listener_list.is_empty();
 }
 
+bool EventTarget::has_event_listener_of_type_on_any_event_target(FlyString const& type)
+{
+    return s_event_listener_count_by_type.contains(type);
+}
+
 bool EventTarget::has_activation_behavior() const
 {
     return false;
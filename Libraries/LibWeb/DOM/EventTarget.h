@@ -60,6 +60,10 @@ public:
     bool has_event_listener(FlyString const& type) const;
     bool has_event_listeners() const;
 
+    // Returns whether an event listener of the given type is registered with any event target at all. When there isn't
+    // one, dispatching an event of that type can't run any script.
+    static bool has_event_listener_of_type_on_any_event_target(FlyString const& type);
+
     virtual bool is_window_or_worker_global_scope_mixin() const { return false; }
 
 protected:
@@ -69,6 +73,7 @@ protected:
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override;
 
 private:
     struct Data {
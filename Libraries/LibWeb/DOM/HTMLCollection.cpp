@@ -54,7 +54,7 @@ void HTMLCollection::visit_edges(Cell::Visitor& visitor)
 
 void HTMLCollection::update_name_to_element_mappings_if_needed() const
 {
-    update_cache_if_needed();
+    cache_all_elements();
     if (m_cached_name_to_element_mappings)
         return;
     m_cached_name_to_element_mappings = make<OrderedHashMap<FlyString, GC::Ref<Element>>>();
@@ -74,33 +74,53 @@ void HTMLCollection::update_name_to_element_mappings_if_needed() const
     }
 }
 
-void HTMLCollection::update_cache_if_needed() const
+void HTMLCollection::invalidate_cache_if_needed() const
 {
-    // Nothing to do, the DOM hasn't updated since we last built the cache.
-    if (m_cached_dom_tree_version == root()->document().dom_tree_version())
+    // Nothing to do, the root's subtree hasn't changed since we started building the cache.
+    if (m_cached_subtree_version == m_root->subtree_version())
         return;
 
     m_cached_elements.clear();
+    m_cached_elements_are_complete = false;
     m_cached_name_to_element_mappings = nullptr;
-    if (m_scope == Scope::Descendants) {
-        m_root->for_each_in_subtree_of_type<Element>([&](auto& element) {
-            if (m_filter(element))
-                m_cached_elements.append(element);
-            return TraversalDecision::Continue;
-        });
-    } else {
-        m_root->for_each_child_of_type<Element>([&](auto& element) {
-            if (m_filter(element))
-                m_cached_elements.append(element);
-            return IterationDecision::Continue;
-        });
+    m_cached_subtree_version = m_root->subtree_version();
+}
+
+void HTMLCollection::cache_elements_up_to(size_t index) const
+{
+    invalidate_cache_if_needed();
+    if (m_cached_elements_are_complete || index < m_cached_elements.size())
+        return;
+
+    // NOTE: We pick up the traversal after the last element we've cached so far.
+    auto next_candidate = [&](Element* previous) -> Element* {
+        if (m_scope == Scope::Children)
+            return previous ? previous->next_element_sibling() : m_root->first_element_child().ptr();
+        auto* node = previous ? previous->next_in_pre_order(m_root.ptr()) : m_root->first_child();
+        while (node && !is<Element>(*node))
+            node = node->next_in_pre_order(m_root.ptr());
+        return static_cast<Element*>(node);
+    };
+
+    auto* candidate = next_candidate(m_cached_elements.is_empty() ? nullptr : m_cached_elements.last().ptr());
+    for (; candidate; candidate = next_candidate(candidate)) {
+        if (!m_filter(*candidate))
+            continue;
+        m_cached_elements.append(*candidate);
+        if (index < m_cached_elements.size())
+            return;
     }
-    m_cached_dom_tree_version = root()->document().dom_tree_version();
+    m_cached_elements_are_complete = true;
+}
+
+void HTMLCollection::cache_all_elements() const
+{
+    cache_elements_up_to(NumericLimits<size_t>::max());
 }
 
 GC::RootVector<GC::Ref<Element>> HTMLCollection::collect_matching_elements() const
 {
-    update_cache_if_needed();
+    cache_all_elements();
     GC::RootVector<GC::Ref<Element>> elements(heap());
     for (auto& element : m_cached_elements)
         elements.append(element);
@@ -111,7 +131,7 @@ GC::RootVector<GC::Ref<Element>> HTMLCollection::collect_matching_elements() con
 size_t HTMLCollection::length() const
 {
     // The length getter steps are to return the number of nodes represented by the collection.
-    update_cache_if_needed();
+    cache_all_elements();
     return m_cached_elements.size();
 }
 
@@ -119,7 +139,7 @@ size_t HTMLCollection::length() const
 Element* HTMLCollection::item(size_t index) const
 {
     // The item(index) method steps are to return the indexth element in the collection. If there is no indexth element in the collection, then the method must return null.
-    update_cache_if_needed();
+    cache_elements_up_to(index);
     if (index >= m_cached_elements.size())
         return nullptr;
     return m_cached_elements[index];
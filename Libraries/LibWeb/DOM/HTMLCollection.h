@@ -56,11 +56,15 @@ protected:
 private:
     virtual void visit_edges(Cell::Visitor&) override;
 
-    void update_cache_if_needed() const;
+    void invalidate_cache_if_needed() const;
+    void cache_elements_up_to(size_t index) const;
+    void cache_all_elements() const;
     void update_name_to_element_mappings_if_needed() const;
 
-    mutable u64 m_cached_dom_tree_version { 0 };
+    // NOTE: The elements are cached lazily in tree order, so that indexed access doesn't have to find all of them.
+    mutable Optional<u64> m_cached_subtree_version;
     mutable Vector<GC::Ref<Element>> m_cached_elements;
+    mutable bool m_cached_elements_are_complete { false };
     mutable OwnPtr<OrderedHashMap<FlyString, GC::Ref<Element>>> m_cached_name_to_element_mappings;
 
     GC::Ref<ParentNode> m_root;
@@ -33,25 +33,36 @@ void LiveNodeList::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_root);
+    visitor.visit(m_cached_nodes);
 }
 
-GC::RootVector<Node*> LiveNodeList::collection() const
+void LiveNodeList::cache_nodes_up_to(size_t index) const
 {
-    GC::RootVector<Node*> nodes(heap());
-    if (m_scope == Scope::Descendants) {
-        m_root->for_each_in_subtree([&](auto& node) {
-            if (m_filter(node))
-                nodes.append(const_cast<Node*>(&node));
-            return TraversalDecision::Continue;
-        });
-    } else {
-        m_root->for_each_child([&](auto& node) {
-            if (m_filter(node))
-                nodes.append(const_cast<Node*>(&node));
-            return IterationDecision::Continue;
-        });
+    if (m_cached_subtree_version != m_root->subtree_version()) {
+        m_cached_nodes.clear();
+        m_cached_nodes_are_complete = false;
+        m_cached_subtree_version = m_root->subtree_version();
+    }
+    if (m_cached_nodes_are_complete || index < m_cached_nodes.size())
+        return;
+
+    // NOTE: We pick up the traversal after the last node we've cached so far.
+    auto& root = const_cast<Node&>(*m_root);
+    auto next_candidate = [&](Node* previous) -> Node* {
+        if (m_scope == Scope::Children)
+            return previous ? previous->next_sibling() : root.first_child();
+        return previous ? previous->next_in_pre_order(&root) : root.first_child();
+    };
+
+    auto* candidate = next_candidate(m_cached_nodes.is_empty() ? nullptr : m_cached_nodes.last().ptr());
+    for (; candidate; candidate = next_candidate(candidate)) {
+        if (!m_filter(*candidate))
+            continue;
+        m_cached_nodes.append(*candidate);
+        if (index < m_cached_nodes.size())
+            return;
     }
-    return nodes;
+    m_cached_nodes_are_complete = true;
 }
 
 Node* LiveNodeList::first_matching(Function<bool(Node const&)> const& filter) const
@@ -80,17 +91,18 @@ Node* LiveNodeList::first_matching(Function<bool(Node const&)> const& filter) co
 // https://dom.spec.whatwg.org/#dom-nodelist-length
 u32 LiveNodeList::length() const
 {
-    return collection().size();
+    cache_nodes_up_to(NumericLimits<size_t>::max());
+    return m_cached_nodes.size();
 }
 
 // https://dom.spec.whatwg.org/#dom-nodelist-item
 Node const* LiveNodeList::item(u32 index) const
 {
     // The item(index) method must return the indexth node in the collection. If there is no indexth node in the collection, then the method must return null.
-    auto nodes = collection();
-    if (index >= nodes.size())
+    cache_nodes_up_to(index);
+    if (index >= m_cached_nodes.size())
         return nullptr;
-    return nodes[index];
+    return m_cached_nodes[index];
 }
 
 }
@@ -12,8 +12,6 @@
 
 namespace Web::DOM {
 
-// FIXME: Just like HTMLCollection, LiveNodeList currently does no caching.
-
 class LiveNodeList : public NodeList {
     WEB_PLATFORM_OBJECT(LiveNodeList, NodeList);
     GC_DECLARE_ALLOCATOR(LiveNodeList);
@@ -38,11 +36,16 @@ protected:
 private:
     virtual void visit_edges(Cell::Visitor&) override;
 
-    GC::RootVector<Node*> collection() const;
+    void cache_nodes_up_to(size_t index) const;
 
     GC::Ref<Node const> m_root;
     Function<bool(Node const&)> m_filter;
     Scope m_scope { Scope::Descendants };
+
+    // NOTE: Just like HTMLCollection, we cache the nodes lazily in tree order until the root's subtree changes.
+    mutable Optional<u64> m_cached_subtree_version;
+    mutable Vector<GC::Ref<Node>> m_cached_nodes;
+    mutable bool m_cached_nodes_are_complete { false };
 };
 
 }
@@ -9,6 +9,7 @@
 #include <LibWeb/Bindings/MutationObserverPrototype.h>
 #include <LibWeb/DOM/MutationObserver.h>
 #include <LibWeb/DOM/Node.h>
+#include <LibWeb/DOM/StaticNodeList.h>
 #include <LibWeb/HTML/Scripting/SimilarOriginWindowAgent.h>
 
 namespace Web::DOM {
@@ -52,7 +53,13 @@ void MutationObserver::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_callback);
-    visitor.visit(m_record_queue);
+    for (auto const& record : m_record_queue) {
+        visitor.visit(record.target);
+        visitor.visit(record.added_nodes);
+        visitor.visit(record.removed_nodes);
+        visitor.visit(record.previous_sibling);
+        visitor.visit(record.next_sibling);
+    }
 }
 
 // https://dom.spec.whatwg.org/#dom-mutationobserver-observe
@@ -151,8 +158,21 @@ Vector<GC::Root<MutationRecord>> MutationObserver::take_records()
 {
     // 1. Let records be a clone of this’s record queue.
     Vector<GC::Root<MutationRecord>> records;
-    for (auto& record : m_record_queue)
-        records.append(*record);
+    records.ensure_capacity(m_record_queue.size());
+    for (auto& record : m_record_queue) {
+        // NOTE: This is the realm the record would have been created in when it was queued.
+        auto& realm = record.target->realm();
+        auto to_node_list = [&](Vector<GC::Ref<Node>> const& nodes) {
+            Vector<GC::Root<Node>> rooted_nodes;
+            rooted_nodes.ensure_capacity(nodes.size());
+            for (auto const& node : nodes)
+                rooted_nodes.unchecked_append(*node);
+            return StaticNodeList::create(realm, move(rooted_nodes));
+        };
+        auto added_nodes = to_node_list(record.added_nodes);
+        auto removed_nodes = to_node_list(record.removed_nodes);
+        records.unchecked_append(MutationRecord::create(realm, record.type, *record.target, *added_nodes, *removed_nodes, record.previous_sibling.ptr(), record.next_sibling.ptr(), record.attribute_name, record.attribute_namespace, record.old_value));
+    }
 
     // 2. Empty this’s record queue.
     m_record_queue.clear();
@@ -43,9 +43,24 @@ public:
 
     WebIDL::CallbackType& callback() { return *m_callback; }
 
-    void enqueue_record(Badge<Node>, GC::Ref<MutationRecord> mutation_record)
+    // NOTE: Records are kept as plain data while they're queued, and the MutationRecord objects for them are only created
+    //       once they're taken from the queue. Large DOM updates queue lots of records, and this saves us from allocating
+    //       a MutationRecord and two NodeLists for each of them up front.
+    struct QueuedRecord {
+        FlyString type;
+        GC::Ref<Node> target;
+        Vector<GC::Ref<Node>> added_nodes;
+        Vector<GC::Ref<Node>> removed_nodes;
+        GC::Ptr<Node> previous_sibling;
+        GC::Ptr<Node> next_sibling;
+        Optional<String> attribute_name;
+        Optional<String> attribute_namespace;
+        Optional<String> old_value;
+    };
+
+    void enqueue_record(Badge<Node>, QueuedRecord record)
     {
-        m_record_queue.append(*mutation_record);
+        m_record_queue.append(move(record));
     }
 
 private:
@@ -64,7 +79,7 @@ private:
     Vector<GC::Weak<Node>> m_node_list;
 
     // https://dom.spec.whatwg.org/#concept-mo-queue
-    Vector<GC::Ref<MutationRecord>> m_record_queue;
+    Vector<QueuedRecord> m_record_queue;
 
     IntrusiveListNode<MutationObserver> m_list_node;
 
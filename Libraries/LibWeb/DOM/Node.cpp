@@ -231,7 +231,19 @@ void Node::set_text_content(Optional<Utf16String> const& maybe_content)
         set_needs_layout_tree_update(true, SetNeedsLayoutTreeUpdateReason::NodeSetTextContent);
     }
 
+    bump_subtree_version();
+}
+
+void Node::bump_subtree_version()
+{
     document().bump_dom_tree_version();
+
+    // NOTE: This counter is shared by all documents, so that a subtree version is never reused after a node gets
+    //       adopted into another document.
+    static u64 s_last_subtree_version = 0;
+    auto subtree_version = ++s_last_subtree_version;
+    for (auto* node = this; node; node = node->parent())
+        node->m_subtree_version = subtree_version;
 }
 
 // https://dom.spec.whatwg.org/#dom-node-normalize
@@ -802,7 +814,7 @@ void Node::insert_before(GC::Ref<Node> node, GC::Ptr<Node> child, bool suppress_
     //       an ordinal value (default from constructor).
     // FIXME: This will not work if the child or the parent is not an element. Is insert_before even possible in this situation?
 
-    document().bump_dom_tree_version();
+    bump_subtree_version();
 }
 
 // https://dom.spec.whatwg.org/#concept-node-pre-insert
@@ -1024,7 +1036,7 @@ void Node::remove(bool suppress_observers)
     // 17. Run the children changed steps for parent.
     parent->children_changed(nullptr);
 
-    document().bump_dom_tree_version();
+    parent->bump_subtree_version();
 }
 
 // https://dom.spec.whatwg.org/#concept-node-replace
@@ -1355,7 +1367,8 @@ WebIDL::ExceptionOr<void> Node::move_node(Node& new_parent, Node* child)
     // 26. Queue a tree mutation record for newParent with « node », « », newPreviousSibling, and child.
     new_parent.queue_tree_mutation_record({ *this }, {}, new_previous_sibling, child);
 
-    document().bump_dom_tree_version();
+    old_parent->bump_subtree_version();
+    new_parent.bump_subtree_version();
 
     return {};
 }
@@ -2556,14 +2569,30 @@ void Node::queue_mutation_record(FlyString const& type, Optional<FlyString> cons
     if (attribute_namespace.has_value())
         string_attribute_namespace = attribute_namespace->to_string();
 
-    auto added_nodes_list = StaticNodeList::create(realm(), move(added_nodes));
-    auto removed_nodes_list = StaticNodeList::create(realm(), move(removed_nodes));
+    auto to_refs = [](Vector<GC::Root<Node>> const& nodes) {
+        Vector<GC::Ref<Node>> refs;
+        refs.ensure_capacity(nodes.size());
+        for (auto const& node : nodes)
+            refs.unchecked_append(*node);
+        return refs;
+    };
 
     // 4. For each observer → mappedOldValue of interestedObservers:
     for (auto& interested_observer : interested_observers) {
         // 1. Let record be a new MutationRecord object with its type set to type, target set to target, attributeName set to name, attributeNamespace set to namespace, oldValue set to mappedOldValue,
         //    addedNodes set to addedNodes, removedNodes set to removedNodes, previousSibling set to previousSibling, and nextSibling set to nextSibling.
-        auto record = MutationRecord::create(realm(), type, *this, added_nodes_list, removed_nodes_list, previous_sibling, next_sibling, string_attribute_name, string_attribute_namespace, /* mappedOldValue */ interested_observer.value);
+        // NOTE: The MutationRecord object itself is created when the observer's record queue is taken.
+        MutationObserver::QueuedRecord record {
+            .type = type,
+            .target = *this,
+            .added_nodes = to_refs(added_nodes),
+            .removed_nodes = to_refs(removed_nodes),
+            .previous_sibling = previous_sibling,
+            .next_sibling = next_sibling,
+            .attribute_name = string_attribute_name,
+            .attribute_namespace = string_attribute_namespace,
+            .old_value = /* mappedOldValue */ interested_observer.value,
+        };
 
         // 2. Enqueue record to observer’s record queue.
         interested_observer.key->enqueue_record({}, move(record));
@@ -2573,8 +2602,11 @@ void Node::queue_mutation_record(FlyString const& type, Optional<FlyString> cons
     Bindings::queue_mutation_observer_microtask(document);
 
     // AD-HOC: Notify the UI if it is interested in DOM mutations (i.e. for DevTools).
-    if (page.listen_for_dom_mutations())
+    if (page.listen_for_dom_mutations()) {
+        auto added_nodes_list = StaticNodeList::create(realm(), move(added_nodes));
+        auto removed_nodes_list = StaticNodeList::create(realm(), move(removed_nodes));
         page.client().page_did_mutate_dom(type, *this, added_nodes_list, removed_nodes_list, previous_sibling, next_sibling, string_attribute_name);
+    }
 }
 
 // https://dom.spec.whatwg.org/#queue-a-tree-mutation-record
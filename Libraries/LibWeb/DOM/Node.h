@@ -73,6 +73,7 @@ enum class ShouldComputeRole {
     X(HTMLObjectElementUpdateLayoutAndChildObjects) \
     X(HTMLOptionElementSelectedChange)              \
     X(HTMLSelectElementSetIsOpen)                   \
+    X(InternalsBenchmarkRendering)                  \
     X(MediaListSetMediaText)                        \
     X(MediaListAppendMedium)                        \
     X(MediaListDeleteMedium)                        \
@@ -401,6 +402,14 @@ public:
     bool is_shadow_including_inclusive_ancestor_of(Node const&) const;
 
     [[nodiscard]] UniqueNodeID unique_id() const { return m_unique_id; }
+
+    // AD-HOC: Like Document::dom_tree_version(), but only changes when a node is added to or removed from this node's
+    //         subtree, or an attribute of an element in it changes. Caches of the nodes in a subtree use this.
+    u64 subtree_version() const { return m_subtree_version; }
+
+    // Bumps the document's DOM tree version along with the subtree version of this node and all of its ancestors.
+    void bump_subtree_version();
+
     static Node* from_unique_id(UniqueNodeID);
 
     WebIDL::ExceptionOr<String> serialize_fragment(HTML::RequireWellFormed, FragmentSerializationMode = FragmentSerializationMode::Inner) const;
@@ -492,6 +501,8 @@ protected:
 
     UniqueNodeID m_unique_id;
 
+    u64 m_subtree_version { 0 };
+
     // https://dom.spec.whatwg.org/#registered-observer-list
     // "Nodes have a strong reference to registered observers in their registered observer list." https://dom.spec.whatwg.org/#garbage-collection
     OwnPtr<Vector<GC::Ref<RegisteredObserver>>> m_registered_observer_list;
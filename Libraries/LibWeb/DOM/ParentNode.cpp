@@ -47,26 +47,104 @@ enum class ReturnMatches {
     First,
     All,
 };
+// NOTE: A single compound selector made up of these only looks at the element itself, so what it matches within a node
+//       can only change when that node's subtree changes.
+static bool matches_only_depend_on_the_subtree(CSS::SelectorList const& selectors)
+{
+    for (auto const& selector : selectors) {
+        if (selector->compound_selectors().size() != 1)
+            return false;
+        for (auto const& simple_selector : selector->compound_selectors().first().simple_selectors) {
+            switch (simple_selector.type) {
+            case CSS::Selector::SimpleSelector::Type::Universal:
+            case CSS::Selector::SimpleSelector::Type::TagName:
+            case CSS::Selector::SimpleSelector::Type::Id:
+            case CSS::Selector::SimpleSelector::Type::Class:
+            case CSS::Selector::SimpleSelector::Type::Attribute:
+                break;
+            default:
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static CSS::Selector::SimpleSelector const* single_simple_selector(CSS::SelectorList const& selectors)
+{
+    if (selectors.size() != 1 || selectors.first()->compound_selectors().size() != 1)
+        return nullptr;
+    auto const& simple_selectors = selectors.first()->compound_selectors().first().simple_selectors;
+    if (simple_selectors.size() != 1)
+        return nullptr;
+    return &simple_selectors.first();
+}
+
+// NOTE: For lone id selectors, we can look the matching elements up in the ElementByIdMap of connected documents and
+//       shadow roots instead of walking the tree.
+static Optional<Vector<GC::Ref<Element>>> elements_with_id_from_element_by_id_map(ParentNode const& node, CSS::SelectorList const& selectors, ReturnMatches return_matches)
+{
+    auto const* simple_selector = single_simple_selector(selectors);
+    if (!simple_selector || simple_selector->type != CSS::Selector::SimpleSelector::Type::Id || !node.is_connected())
+        return {};
+
+    ElementByIdMap* element_by_id_map = nullptr;
+    if (node.is_document())
+        element_by_id_map = &static_cast<Document const&>(node).element_by_id();
+    else if (node.is_shadow_root())
+        element_by_id_map = &static_cast<ShadowRoot const&>(node).element_by_id();
+    else
+        return {};
+
+    if (return_matches == ReturnMatches::First) {
+        Vector<GC::Ref<Element>> elements;
+        if (auto element = element_by_id_map->get(simple_selector->name()))
+            elements.append(*element);
+        return elements;
+    }
+    return element_by_id_map->get_all(simple_selector->name());
+}
+
 // https://dom.spec.whatwg.org/#scope-match-a-selectors-string
 static WebIDL::ExceptionOr<Variant<GC::Ptr<Element>, GC::Ref<NodeList>>> scope_match_a_selectors_string(ParentNode& node, StringView selector_text, ReturnMatches return_matches)
 {
     // To scope-match a selectors string selectors against a node, run these steps:
     // 1. Let s be the result of parse a selector selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingParams { node.document() }, selector_text);
+    auto maybe_selectors = node.document().parse_selector_for_scripting(selector_text);
 
     // 2. If s is failure, then throw a "SyntaxError" DOMException.
     if (!maybe_selectors.has_value())
         return WebIDL::SyntaxError::create(node.realm(), "Failed to parse selector"_utf16);
 
-    auto selectors = maybe_selectors.value();
+    auto selectors = maybe_selectors.release_value();
 
     // "Note: Support for namespaces within selectors is not planned and will not be added."
     if (contains_named_namespace(selectors))
         return WebIDL::SyntaxError::create(node.realm(), "Failed to parse selector"_utf16);
 
+    auto create_result = [&](auto const& elements) -> Variant<GC::Ptr<Element>, GC::Ref<NodeList>> {
+        if (return_matches == ReturnMatches::First)
+            return { elements.is_empty() ? GC::Ptr<Element> {} : GC::Ptr<Element> { elements.first() } };
+        Vector<GC::Root<Node>> results;
+        results.ensure_capacity(elements.size());
+        for (auto const& element : elements)
+            results.unchecked_append(*element);
+        return { StaticNodeList::create(node.realm(), move(results)) };
+    };
+
+    if (auto elements = elements_with_id_from_element_by_id_map(node, selectors, return_matches); elements.has_value())
+        return create_result(*elements);
+
+    // NOTE: The results of querySelectorAll() are reused for as long as they can't have changed.
+    auto can_reuse_results = return_matches == ReturnMatches::All && matches_only_depend_on_the_subtree(selectors);
+    if (can_reuse_results) {
+        if (auto const* cached_results = node.cached_query_selector_all_results_for(selector_text))
+            return create_result(*cached_results);
+    }
+
     // 3. Return the result of match a selector against a tree with s and node’s root using scoping root node.
     GC::Ptr<Element> single_result;
-    Vector<GC::Root<Node>> results;
+    Vector<GC::Ref<Element>> results;
     // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
     node.for_each_in_subtree_of_type<Element>([&](auto& element) {
         for (auto& selector : selectors) {
@@ -86,7 +164,10 @@ static WebIDL::ExceptionOr<Variant<GC::Ptr<Element>, GC::Ref<NodeList>>> scope_m
     if (return_matches == ReturnMatches::First)
         return { single_result };
 
-    return { StaticNodeList::create(node.realm(), move(results)) };
+    auto result = create_result(results);
+    if (can_reuse_results)
+        node.cache_query_selector_all_results(selector_text, move(results));
+    return result;
 }
 
 // https://dom.spec.whatwg.org/#dom-parentnode-queryselector
@@ -129,6 +210,27 @@ void ParentNode::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_children);
+    if (m_cached_query_selector_all_results)
+        visitor.visit(m_cached_query_selector_all_results->elements);
+}
+
+Vector<GC::Ref<Element>> const* ParentNode::cached_query_selector_all_results_for(StringView selector_text) const
+{
+    auto const& cached_results = m_cached_query_selector_all_results;
+    if (!cached_results || cached_results->selector_text != selector_text)
+        return nullptr;
+    if (cached_results->subtree_version != subtree_version() || cached_results->is_for_html_document != (document().document_type() == Document::Type::HTML))
+        return nullptr;
+    return &cached_results->elements;
+}
+
+void ParentNode::cache_query_selector_all_results(StringView selector_text, Vector<GC::Ref<Element>> elements)
+{
+    m_cached_query_selector_all_results = make<CachedQuerySelectorAllResults>(
+        MUST(String::from_utf8(selector_text)),
+        subtree_version(),
+        document().document_type() == Document::Type::HTML,
+        move(elements));
 }
 
 // https://dom.spec.whatwg.org/#dom-parentnode-children
@@ -143,9 +245,28 @@ GC::Ref<HTMLCollection> ParentNode::children()
     return *m_children;
 }
 
+ParentNode::CachedCollections& ParentNode::cached_collections()
+{
+    // NOTE: Which elements a tag name matches depends on whether we're in an HTML document, and nodes can be adopted.
+    auto is_for_html_document = document().document_type() == Document::Type::HTML;
+    if (!m_cached_collections || m_cached_collections->is_for_html_document != is_for_html_document)
+        m_cached_collections = make<CachedCollections>(is_for_html_document);
+    return *m_cached_collections;
+}
+
 // https://dom.spec.whatwg.org/#concept-getelementsbytagname
 // NOTE: This method is only exposed on Document and Element, but is in ParentNode to prevent code duplication.
 GC::Ref<HTMLCollection> ParentNode::get_elements_by_tag_name(FlyString const& qualified_name)
+{
+    auto& cached_collections = this->cached_collections();
+    if (auto collection = cached_collections.by_qualified_name.get(qualified_name); collection.has_value() && collection->ptr())
+        return *collection->ptr();
+    auto collection = get_elements_by_tag_name_impl(qualified_name);
+    cached_collections.by_qualified_name.set(qualified_name, collection);
+    return collection;
+}
+
+GC::Ref<HTMLCollection> ParentNode::get_elements_by_tag_name_impl(FlyString const& qualified_name)
 {
     // 1. If qualifiedName is "*" (U+002A), return a HTMLCollection rooted at root, whose filter matches only descendant elements.
     if (qualified_name == "*") {
@@ -262,14 +383,27 @@ WebIDL::ExceptionOr<void> ParentNode::move_before(GC::Ref<Node> node, GC::Ptr<No
 
 // https://dom.spec.whatwg.org/#dom-document-getelementsbyclassname
 GC::Ref<HTMLCollection> ParentNode::get_elements_by_class_name(StringView class_names)
+{
+    auto& cached_collections = this->cached_collections();
+    auto key = MUST(String::from_utf8(class_names));
+    if (auto collection = cached_collections.by_class_names.get(key); collection.has_value() && collection->ptr())
+        return *collection->ptr();
+    auto collection = get_elements_by_class_name_impl(class_names);
+    cached_collections.by_class_names.set(move(key), collection);
+    return collection;
+}
+
+GC::Ref<HTMLCollection> ParentNode::get_elements_by_class_name_impl(StringView class_names)
 {
     Vector<FlyString> list_of_class_names;
     for (auto& name : class_names.split_view_if(Infra::is_ascii_whitespace)) {
         list_of_class_names.append(FlyString::from_utf8(name).release_value_but_fixme_should_propagate_errors());
     }
-    return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [list_of_class_names = move(list_of_class_names), quirks_mode = document().in_quirks_mode()](Element const& element) {
+    // NOTE: The quirks mode is looked up when matching, since the collection may be handed out again later.
+    return HTMLCollection::create(*this, HTMLCollection::Scope::Descendants, [list_of_class_names = move(list_of_class_names)](Element const& element) {
+        auto case_sensitivity = element.document().in_quirks_mode() ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive;
         for (auto& name : list_of_class_names) {
-            if (!element.has_class(name, quirks_mode ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive))
+            if (!element.has_class(name, case_sensitivity))
                 return false;
         }
         return !list_of_class_names.is_empty();
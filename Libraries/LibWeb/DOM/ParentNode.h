@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
+#include <LibGC/Weak.h>
 #include <LibWeb/DOM/Node.h>
 #include <LibWeb/Export.h>
 
@@ -42,6 +44,9 @@ public:
 
     GC::Ptr<Element> get_element_by_id(FlyString const& id) const;
 
+    Vector<GC::Ref<Element>> const* cached_query_selector_all_results_for(StringView selector_text) const;
+    void cache_query_selector_all_results(StringView selector_text, Vector<GC::Ref<Element>>);
+
 protected:
     ParentNode(JS::Realm& realm, Document& document, NodeType type)
         : Node(realm, document, type)
@@ -56,7 +61,29 @@ protected:
     virtual void visit_edges(Cell::Visitor&) override;
 
 private:
+    GC::Ref<HTMLCollection> get_elements_by_tag_name_impl(FlyString const&);
+    GC::Ref<HTMLCollection> get_elements_by_class_name_impl(StringView);
+
     GC::Ptr<HTMLCollection> m_children;
+
+    // NOTE: getElementsByTagName() and getElementsByClassName() hand out the same collection for the same argument while
+    //       that collection is alive, so that code calling them over and over gets to reuse its cache.
+    struct CachedCollections {
+        bool is_for_html_document { false };
+        HashMap<FlyString, GC::Weak<HTMLCollection>> by_qualified_name;
+        HashMap<String, GC::Weak<HTMLCollection>> by_class_names;
+    };
+    CachedCollections& cached_collections();
+    OwnPtr<CachedCollections> m_cached_collections;
+
+    // NOTE: The results of the last querySelectorAll() call whose selectors only look at the elements themselves.
+    struct CachedQuerySelectorAllResults {
+        String selector_text;
+        u64 subtree_version { 0 };
+        bool is_for_html_document { false };
+        Vector<GC::Ref<Element>> elements;
+    };
+    OwnPtr<CachedQuerySelectorAllResults> m_cached_query_selector_all_results;
 };
 
 template<>
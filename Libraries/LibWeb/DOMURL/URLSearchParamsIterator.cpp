@@ -16,7 +16,7 @@ template<>
 void Intrinsics::create_web_prototype_and_constructor<URLSearchParamsIteratorPrototype>(JS::Realm& realm)
 {
     auto prototype = realm.create<URLSearchParamsIteratorPrototype>(realm);
-    m_prototypes.set("URLSearchParamsIterator"_fly_string, prototype);
+    set_web_prototype("URLSearchParamsIterator"_fly_string, prototype);
 }
 
 }
@@ -40,8 +40,15 @@ void FetchedDataReceiver::set_pending_promise(GC::Ref<WebIDL::Promise> promise)
     m_pending_promise = promise;
 
     if (!had_pending_promise && !m_buffer.is_empty()) {
-        on_data_received(m_buffer);
+        on_data_received(MUST(m_buffer.coalesce()));
         m_buffer.clear();
+    } else if (!m_unpulled_bytes.is_empty()) {
+        Infrastructure::queue_fetch_task(
+            m_fetch_params->controller(),
+            m_fetch_params->task_destination(),
+            GC::create_function(heap(), [this]() {
+                pull_bytes_into_stream({});
+            }));
     }
 }
 
@@ -65,25 +72,41 @@ void FetchedDataReceiver::on_data_received(ReadonlyBytes bytes)
         m_fetch_params->controller(),
         m_fetch_params->task_destination(),
         GC::create_function(heap(), [this, bytes = MUST(ByteBuffer::copy(bytes))]() mutable {
-            HTML::TemporaryExecutionContext execution_context { m_stream->realm(), HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
+            pull_bytes_into_stream(move(bytes));
+        }));
+}
 
-            // 1. Pull from bytes buffer into stream.
-            if (auto result = m_stream->pull_from_bytes(move(bytes)); result.is_error()) {
-                auto throw_completion = Bindings::exception_to_throw_completion(m_stream->vm(), result.release_error());
+void FetchedDataReceiver::pull_bytes_into_stream(ByteBuffer bytes)
+{
+    HTML::TemporaryExecutionContext execution_context { m_stream->realm(), HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
 
-                dbgln("FetchedDataReceiver: Stream error pulling bytes");
-                HTML::report_exception(throw_completion, m_stream->realm());
+    // Bytes that did not fit into an earlier BYOB request precede the bytes that were received since.
+    if (!m_unpulled_bytes.is_empty()) {
+        m_unpulled_bytes.append(bytes.bytes());
+        bytes = move(m_unpulled_bytes);
+    }
 
-                return;
-            }
+    if (!bytes.is_empty()) {
+        // 1. Pull from bytes buffer into stream.
+        if (auto result = m_stream->pull_from_bytes(bytes); result.is_error()) {
+            auto throw_completion = Bindings::exception_to_throw_completion(m_stream->vm(), result.release_error());
 
-            // 2. If stream is errored, then terminate fetchParams’s controller.
-            if (m_stream->is_errored())
-                m_fetch_params->controller()->terminate();
+            dbgln("FetchedDataReceiver: Stream error pulling bytes");
+            HTML::report_exception(throw_completion, m_stream->realm());
 
-            // 3. Resolve promise with undefined.
-            WebIDL::resolve_promise(m_stream->realm(), *m_pending_promise, JS::js_undefined());
-        }));
+            return;
+        }
+
+        // The remaining bytes are pulled once the stream pulls again.
+        m_unpulled_bytes = move(bytes);
+    }
+
+    // 2. If stream is errored, then terminate fetchParams’s controller.
+    if (m_stream->is_errored())
+        m_fetch_params->controller()->terminate();
+
+    // 3. Resolve promise with undefined.
+    WebIDL::resolve_promise(m_stream->realm(), *m_pending_promise, JS::js_undefined());
 }
 
 }
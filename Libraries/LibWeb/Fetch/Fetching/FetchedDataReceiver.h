@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/ByteBuffer.h>
+#include <AK/ChainedBuffer.h>
 #include <LibGC/CellAllocator.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibWeb/Forward.h>
@@ -28,10 +29,15 @@ private:
 
     virtual void visit_edges(Visitor& visitor) override;
 
+    void pull_bytes_into_stream(ByteBuffer);
+
     GC::Ref<Infrastructure::FetchParams const> m_fetch_params;
     GC::Ref<Streams::ReadableStream> m_stream;
     GC::Ptr<WebIDL::Promise> m_pending_promise;
-    ByteBuffer m_buffer;
+    ChainedBuffer m_buffer;
+
+    // The bytes that did not fit into the stream's BYOB request when they were pulled.
+    ByteBuffer m_unpulled_bytes;
 };
 
 }
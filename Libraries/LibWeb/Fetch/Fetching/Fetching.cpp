@@ -45,6 +45,7 @@
 #include <LibWeb/FileAPI/Blob.h>
 #include <LibWeb/FileAPI/BlobURLStore.h>
 #include <LibWeb/HTML/EventLoop/EventLoop.h>
+#include <LibWeb/HTML/MapOfPreloadedResources.h>
 #include <LibWeb/HTML/Navigable.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
@@ -155,11 +156,11 @@ WebIDL::ExceptionOr<GC::Ref<Infrastructure::FetchController>> fetch(JS::Realm& r
             fetch_params->set_preloaded_response_candidate(response);
         });
 
-        // FIXME: 3. Let foundPreloadedResource be the result of invoking consume a preloaded resource for request’s
+        // 3. Let foundPreloadedResource be the result of invoking consume a preloaded resource for request’s
         //    window, given request’s URL, request’s destination, request’s mode, request’s credentials mode,
         //    request’s integrity metadata, and onPreloadedResponseAvailable.
-        auto found_preloaded_resource = false;
-        (void)on_preloaded_response_available;
+        auto& window = as<HTML::Window>(request.client()->global_object());
+        auto found_preloaded_resource = HTML::consume_a_preloaded_resource(window, request.url(), request.destination(), request.mode(), request.credentials_mode(), request.integrity_metadata(), on_preloaded_response_available);
 
         // 4. If foundPreloadedResource is true and fetchParams’s preloaded response candidate is null, then set
         //    fetchParams’s preloaded response candidate to "pending".
@@ -294,6 +295,24 @@ void populate_request_from_client(JS::Realm const& realm, Infrastructure::Reques
     }
 }
 
+// The state of checking a response's body against a request's integrity metadata, while the body is being read.
+class IncrementalIntegrityCheck : public RefCounted<IncrementalIntegrityCheck> {
+public:
+    static NonnullRefPtr<IncrementalIntegrityCheck> create(SRI::IncrementalMetadataMatcher matcher)
+    {
+        return adopt_ref(*new IncrementalIntegrityCheck(move(matcher)));
+    }
+
+    SRI::IncrementalMetadataMatcher matcher;
+    ByteBuffer bytes;
+
+private:
+    explicit IncrementalIntegrityCheck(SRI::IncrementalMetadataMatcher matcher)
+        : matcher(move(matcher))
+    {
+    }
+};
+
 // https://fetch.spec.whatwg.org/#concept-main-fetch
 WebIDL::ExceptionOr<GC::Ptr<PendingResponse>> main_fetch(JS::Realm& realm, Infrastructure::FetchParams const& fetch_params, Recursive recursive)
 {
@@ -603,23 +622,47 @@ WebIDL::ExceptionOr<GC::Ptr<PendingResponse>> main_fetch(JS::Realm& realm, Infra
                     return;
                 }
 
+                // AD-HOC: Rather than fully reading response’s body and then applying the hash function to all of its
+                //         bytes, the body is read incrementally and each chunk is hashed as it arrives. The bytes are still
+                //         collected, as they may not be exposed before they are known to match, but into a single buffer
+                //         that is then handed to the new body, instead of being copied several times over.
+                auto matcher = SRI::IncrementalMetadataMatcher::create(request->integrity_metadata());
+                if (matcher.is_error()) {
+                    process_body_error->function()({});
+                    return;
+                }
+
+                auto integrity_check = IncrementalIntegrityCheck::create(matcher.release_value());
+                if (auto length = response->body()->length(); length.has_value())
+                    (void)integrity_check->bytes.try_ensure_capacity(*length);
+
                 // 3. Let processBody given bytes be these steps:
-                auto process_body = GC::create_function(vm.heap(), [&realm, request, response, &fetch_params, process_body_error](ByteBuffer bytes) {
+                auto process_body = [&realm, response, &fetch_params, process_body_error](ByteBuffer bytes, bool bytes_match) {
                     // 1. If bytes do not match request’s integrity metadata, then run processBodyError and abort these steps.
-                    if (!TRY_OR_IGNORE(SRI::do_bytes_match_metadata_list(bytes, request->integrity_metadata()))) {
+                    if (!bytes_match) {
                         process_body_error->function()({});
                         return;
                     }
 
                     // 2. Set response’s body to bytes as a body.
-                    response->set_body(Infrastructure::byte_sequence_as_body(realm, bytes));
+                    response->set_body(Infrastructure::byte_sequence_as_body(realm, move(bytes)));
 
                     // 3. Run fetch response handover given fetchParams and response.
                     fetch_response_handover(realm, fetch_params, *response);
+                };
+
+                auto process_body_chunk = GC::create_function(vm.heap(), [integrity_check](ByteBuffer chunk) {
+                    integrity_check->matcher.update(chunk);
+                    integrity_check->bytes.append(chunk);
+                });
+
+                auto process_end_of_body = GC::create_function(vm.heap(), [integrity_check, process_body = move(process_body)]() {
+                    auto bytes_match = integrity_check->matcher.matches();
+                    process_body(move(integrity_check->bytes), !bytes_match.is_error() && bytes_match.value());
                 });
 
                 // 4. Fully read response’s body given processBody and processBodyError.
-                response->body()->fully_read(realm, process_body, process_body_error, fetch_params.task_destination());
+                response->body()->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, fetch_params.task_destination());
             }
             // 23. Otherwise, run fetch response handover given fetchParams and response.
             else {
@@ -2291,6 +2334,42 @@ static void log_response(auto const& status_code, auto const& headers, auto cons
 }
 #endif
 
+// AD-HOC: RequestServer schedules network requests by priority, so that render-blocking resources don't have to compete
+//         for bandwidth with images and the like. Requests with an explicit priority keep it, all others get one based
+//         on what they are fetching.
+static RequestServer::RequestPriority request_priority_for_load_request(Infrastructure::Request const& request)
+{
+    switch (request.priority()) {
+    case Infrastructure::Request::Priority::High:
+        return RequestServer::RequestPriority::High;
+    case Infrastructure::Request::Priority::Low:
+        return RequestServer::RequestPriority::Low;
+    case Infrastructure::Request::Priority::Auto:
+        break;
+    }
+
+    if (!request.destination().has_value())
+        return RequestServer::RequestPriority::Normal;
+
+    switch (*request.destination()) {
+    case Infrastructure::Request::Destination::Document:
+    case Infrastructure::Request::Destination::Frame:
+    case Infrastructure::Request::Destination::IFrame:
+    case Infrastructure::Request::Destination::Font:
+    case Infrastructure::Request::Destination::Script:
+    case Infrastructure::Request::Destination::Style:
+        return RequestServer::RequestPriority::High;
+    case Infrastructure::Request::Destination::Audio:
+    case Infrastructure::Request::Destination::Image:
+    case Infrastructure::Request::Destination::Report:
+    case Infrastructure::Request::Destination::Track:
+    case Infrastructure::Request::Destination::Video:
+        return RequestServer::RequestPriority::Low;
+    default:
+        return RequestServer::RequestPriority::Normal;
+    }
+}
+
 // https://fetch.spec.whatwg.org/#concept-http-network-fetch
 // Drop-in replacement for 'HTTP-network fetch', but obviously non-standard :^)
 // It also handles file:// URLs since those can also go through ResourceLoader.
@@ -2317,6 +2396,7 @@ WebIDL::ExceptionOr<GC::Ref<PendingResponse>> nonstandard_resource_loader_file_o
     load_request.set_page(page);
     load_request.set_method(ByteString::copy(request->method()));
     load_request.set_store_set_cookie_headers(include_credentials == IncludeCredentials::Yes);
+    load_request.set_priority(request_priority_for_load_request(*request));
 
     for (auto const& header : *request->header_list())
         load_request.set_header(ByteString::copy(header.name), ByteString::copy(header.value));
@@ -2432,10 +2512,11 @@ WebIDL::ExceptionOr<GC::Ref<PendingResponse>> nonstandard_resource_loader_file_o
             }
         });
 
-        auto on_complete = GC::create_function(vm.heap(), [&vm, &realm, pending_response, stream](bool success, Requests::RequestTimingInfo const&, Optional<StringView> error_message) {
-            dbgln("FIXME: Implement on_complete timing info for unbuffered requests");
+        auto on_complete = GC::create_function(vm.heap(), [&vm, &realm, pending_response, stream, fetch_timing_info, cross_origin_isolated_capability](bool success, Requests::RequestTimingInfo const& timing_info, Optional<StringView> error_message) {
             HTML::TemporaryExecutionContext execution_context { realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
 
+            fetch_timing_info->update_final_timings(timing_info, cross_origin_isolated_capability);
+
             // 16.1.1.2. Otherwise, if the bytes transmission for response’s message body is done normally and stream is readable,
             //           then close stream, and abort these in-parallel steps.
             if (success) {
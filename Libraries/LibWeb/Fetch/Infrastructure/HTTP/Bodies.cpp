@@ -6,6 +6,7 @@
  */
 
 #include <LibJS/Runtime/PromiseCapability.h>
+#include <LibJS/Runtime/TypedArray.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Fetch/BodyInit.h>
@@ -13,6 +14,7 @@
 #include <LibWeb/Fetch/Infrastructure/IncrementalReadLoopReadRequest.h>
 #include <LibWeb/Fetch/Infrastructure/Task.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
+#include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/Streams/ReadableStream.h>
 
 namespace Web::Fetch::Infrastructure {
@@ -115,8 +117,7 @@ void Body::incrementally_read(ProcessBodyChunkCallback process_body_chunk, Proce
     auto reader = MUST(m_stream->get_a_reader());
 
     // 3. Perform the incrementally-read loop given reader, taskDestination, processBodyChunk, processEndOfBody, and processBodyError.
-    VERIFY(!task_destination.has<Empty>());
-    incrementally_read_loop(reader, task_destination.get<GC::Ref<JS::Object>>(), process_body_chunk, process_end_of_body, process_body_error);
+    incrementally_read_loop(reader, move(task_destination), process_body_chunk, process_end_of_body, process_body_error);
 }
 
 // https://fetch.spec.whatwg.org/#incrementally-read-loop
@@ -138,4 +139,34 @@ GC::Ref<Body> byte_sequence_as_body(JS::Realm& realm, ReadonlyBytes bytes)
     return body;
 }
 
+// https://fetch.spec.whatwg.org/#byte-sequence-as-a-body
+GC::Ref<Body> byte_sequence_as_body(JS::Realm& realm, ByteBuffer&& bytes)
+{
+    // NOTE: This is equivalent to safely extracting bytes, but takes ownership of bytes as the body's source instead of
+    //       copying them, so that only the copy that is enqueued into the body's stream is made. This matters for large
+    //       responses, which would otherwise be held in memory three times over.
+    HTML::TemporaryExecutionContext execution_context { realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
+
+    auto stream = realm.create<Streams::ReadableStream>(realm);
+    stream->set_up_with_byte_reading_support();
+
+    auto length = bytes.size();
+    auto chunk_bytes = MUST(ByteBuffer::copy(bytes));
+
+    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, stream, chunk_bytes = move(chunk_bytes)]() mutable {
+        HTML::TemporaryExecutionContext execution_context { realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
+
+        if (!chunk_bytes.is_empty() && !stream->is_errored()) {
+            auto array_buffer = JS::ArrayBuffer::create(stream->realm(), move(chunk_bytes));
+            auto chunk = JS::Uint8Array::create(stream->realm(), array_buffer->byte_length(), *array_buffer);
+
+            stream->enqueue(chunk).release_value_but_fixme_should_propagate_errors();
+        }
+
+        stream->close();
+    }));
+
+    return Body::create(realm.vm(), stream, move(bytes), length);
+}
+
 }
@@ -78,5 +78,6 @@ struct BodyWithType {
 };
 
 WEB_API GC::Ref<Body> byte_sequence_as_body(JS::Realm&, ReadonlyBytes);
+WEB_API GC::Ref<Body> byte_sequence_as_body(JS::Realm&, ByteBuffer&&);
 
 }
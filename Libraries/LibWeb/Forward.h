@@ -707,6 +707,7 @@ class ImageData;
 class ImageRequest;
 class ListOfAvailableImages;
 class Location;
+class MapOfPreloadedResources;
 class MediaError;
 class MessageChannel;
 class MessageEvent;
@@ -733,6 +734,7 @@ class PluginArray;
 class PopoverInvokerElement;
 class PromiseRejectionEvent;
 class RadioNodeList;
+class Scheduler;
 class SelectedFile;
 class SessionHistoryEntry;
 class SharedResourceRequest;
@@ -961,6 +963,7 @@ enum class ShouldAntiAlias : bool;
 
 struct BorderRadiiData;
 struct BorderRadiusData;
+struct DisplayListCommandWithScrollAndClip;
 struct LinearGradientData;
 
 }
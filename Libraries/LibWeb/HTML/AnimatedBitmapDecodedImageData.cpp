@@ -5,21 +5,46 @@
  */
 
 #include <LibGC/Heap.h>
+#include <LibGC/Weak.h>
 #include <LibGfx/Bitmap.h>
 #include <LibJS/Runtime/Realm.h>
 #include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
+#include <LibWeb/Platform/ImageCodecPlugin.h>
 
 namespace Web::HTML {
 
 GC_DEFINE_ALLOCATOR(AnimatedBitmapDecodedImageData);
 
+// How many frames we ask for at a time, and how many we keep around, when frames are decoded on demand.
+static constexpr size_t FRAMES_PER_REQUEST = 8;
+static constexpr size_t MAX_DECODED_FRAMES = 3 * FRAMES_PER_REQUEST;
+
 ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create(JS::Realm& realm, Vector<Frame>&& frames, size_t loop_count, bool animated)
 {
     return realm.create<AnimatedBitmapDecodedImageData>(move(frames), loop_count, animated);
 }
 
+ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create_with_frames_decoded_on_demand(JS::Realm& realm, Vector<Frame>&& first_frames, size_t frame_count, size_t loop_count, i64 animation_id, Gfx::ColorSpace color_space)
+{
+    VERIFY(!first_frames.is_empty());
+    VERIFY(first_frames.size() <= frame_count);
+
+    auto decoded_frame_count = first_frames.size();
+    TRY(first_frames.try_resize(frame_count));
+
+    auto image_data = realm.create<AnimatedBitmapDecodedImageData>(move(first_frames), loop_count, true);
+    image_data->m_on_demand_decoding = OnDemandDecoding {
+        .animation_id = animation_id,
+        .color_space = move(color_space),
+        .known_duration_count = decoded_frame_count,
+        .decoded_frame_count = decoded_frame_count,
+    };
+    return image_data;
+}
+
 AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& frames, size_t loop_count, bool animated)
     : m_frames(move(frames))
+    , m_size(m_frames.first().bitmap->size())
     , m_loop_count(loop_count)
     , m_animated(animated)
 {
@@ -27,33 +52,146 @@ AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& f
 
 AnimatedBitmapDecodedImageData::~AnimatedBitmapDecodedImageData() = default;
 
+void AnimatedBitmapDecodedImageData::finalize()
+{
+    Base::finalize();
+    if (m_on_demand_decoding.has_value())
+        Platform::ImageCodecPlugin::the().release_animation(m_on_demand_decoding->animation_id);
+}
+
 RefPtr<Gfx::ImmutableBitmap> AnimatedBitmapDecodedImageData::bitmap(size_t frame_index, Gfx::IntSize) const
 {
     if (frame_index >= m_frames.size())
         return nullptr;
-    return m_frames[frame_index].bitmap;
+    if (!m_on_demand_decoding.has_value())
+        return m_frames[frame_index].bitmap;
+
+    request_frames_ahead_of(frame_index);
+
+    // If the frame has not arrived yet, keep showing the one before it rather than flashing an empty box.
+    if (m_frames[frame_index].bitmap)
+        m_on_demand_decoding->last_displayed_frame_index = frame_index;
+    return m_frames[m_on_demand_decoding->last_displayed_frame_index].bitmap;
 }
 
 int AnimatedBitmapDecodedImageData::frame_duration(size_t frame_index) const
 {
     if (frame_index >= m_frames.size())
         return 0;
+    if (m_on_demand_decoding.has_value() && frame_index >= m_on_demand_decoding->known_duration_count)
+        return m_frames.first().duration;
     return m_frames[frame_index].duration;
 }
 
+void AnimatedBitmapDecodedImageData::request_frames_ahead_of(size_t frame_index) const
+{
+    auto& on_demand_decoding = *m_on_demand_decoding;
+    if (on_demand_decoding.has_pending_request)
+        return;
+
+    Optional<size_t> first_missing_frame_index;
+    for (size_t i = 0; i < FRAMES_PER_REQUEST; ++i) {
+        auto index = (frame_index + i) % m_frames.size();
+        if (!m_frames[index].bitmap) {
+            first_missing_frame_index = index;
+            break;
+        }
+    }
+    if (!first_missing_frame_index.has_value())
+        return;
+
+    on_demand_decoding.has_pending_request = true;
+    Platform::ImageCodecPlugin::the().request_animation_frames(
+        on_demand_decoding.animation_id, *first_missing_frame_index, FRAMES_PER_REQUEST,
+        [weak_this = GC::Weak<AnimatedBitmapDecodedImageData> { const_cast<AnimatedBitmapDecodedImageData&>(*this) }](size_t first_frame_index, Vector<Platform::Frame> platform_frames) {
+            if (!weak_this)
+                return;
+
+            Vector<Frame> frames;
+            frames.ensure_capacity(platform_frames.size());
+            for (auto& frame : platform_frames) {
+                frames.unchecked_append({
+                    .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap, Gfx::AlphaType::Premultiplied, weak_this->m_on_demand_decoding->color_space),
+                    .duration = static_cast<int>(frame.duration),
+                });
+            }
+            weak_this->did_decode_frames(first_frame_index, move(frames));
+        });
+}
+
+void AnimatedBitmapDecodedImageData::did_decode_frames(size_t first_frame_index, Vector<Frame>&& frames)
+{
+    auto& on_demand_decoding = *m_on_demand_decoding;
+
+    // If the decoder has nothing more to give us, stop asking. We keep showing the frames we have.
+    if (frames.is_empty())
+        return;
+    on_demand_decoding.has_pending_request = false;
+
+    for (size_t i = 0; i < frames.size() && first_frame_index + i < m_frames.size(); ++i) {
+        auto& frame = m_frames[first_frame_index + i];
+        if (!frame.bitmap)
+            ++on_demand_decoding.decoded_frame_count;
+        frame = move(frames[i]);
+    }
+    on_demand_decoding.known_duration_count = max(on_demand_decoding.known_duration_count, min(first_frame_index + frames.size(), m_frames.size()));
+
+    discard_frames_beyond_capacity();
+}
+
+void AnimatedBitmapDecodedImageData::discard_frames_beyond_capacity()
+{
+    auto& on_demand_decoding = *m_on_demand_decoding;
+    auto last_displayed_frame_index = on_demand_decoding.last_displayed_frame_index;
+
+    // The frames just behind the one on display are the ones we will need last.
+    while (on_demand_decoding.decoded_frame_count > MAX_DECODED_FRAMES) {
+        Optional<size_t> furthest_frame_index;
+        size_t furthest_distance = 0;
+        for (size_t i = 0; i < m_frames.size(); ++i) {
+            if (!m_frames[i].bitmap || i == last_displayed_frame_index)
+                continue;
+            auto distance = (i + m_frames.size() - last_displayed_frame_index) % m_frames.size();
+            if (distance > furthest_distance) {
+                furthest_frame_index = i;
+                furthest_distance = distance;
+            }
+        }
+        if (!furthest_frame_index.has_value())
+            break;
+
+        m_frames[*furthest_frame_index].bitmap = nullptr;
+        --on_demand_decoding.decoded_frame_count;
+    }
+}
+
+void AnimatedBitmapDecodedImageData::discard_frames_not_on_display()
+{
+    if (!m_on_demand_decoding.has_value())
+        return;
+
+    auto& on_demand_decoding = *m_on_demand_decoding;
+    for (size_t i = 0; i < m_frames.size(); ++i) {
+        if (i == on_demand_decoding.last_displayed_frame_index || !m_frames[i].bitmap)
+            continue;
+        m_frames[i].bitmap = nullptr;
+        --on_demand_decoding.decoded_frame_count;
+    }
+}
+
 Optional<CSSPixels> AnimatedBitmapDecodedImageData::intrinsic_width() const
 {
-    return m_frames.first().bitmap->width();
+    return m_size.width();
 }
 
 Optional<CSSPixels> AnimatedBitmapDecodedImageData::intrinsic_height() const
 {
-    return m_frames.first().bitmap->height();
+    return m_size.height();
 }
 
 Optional<CSSPixelFraction> AnimatedBitmapDecodedImageData::intrinsic_aspect_ratio() const
 {
-    return CSSPixels(m_frames.first().bitmap->width()) / CSSPixels(m_frames.first().bitmap->height());
+    return CSSPixels(m_size.width()) / CSSPixels(m_size.height());
 }
 
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <LibGfx/ColorSpace.h>
 #include <LibGfx/ImmutableBitmap.h>
 #include <LibWeb/HTML/DecodedImageData.h>
 
@@ -22,6 +23,11 @@ public:
     };
 
     static ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> create(JS::Realm&, Vector<Frame>&&, size_t loop_count, bool animated);
+
+    // Only the first frames have been decoded. The rest are requested from the ImageCodecPlugin as they are about to be
+    // displayed, and only a few of them are kept around at a time.
+    static ErrorOr<GC::Ref<AnimatedBitmapDecodedImageData>> create_with_frames_decoded_on_demand(JS::Realm&, Vector<Frame>&& first_frames, size_t frame_count, size_t loop_count, i64 animation_id, Gfx::ColorSpace);
+
     virtual ~AnimatedBitmapDecodedImageData() override;
 
     virtual RefPtr<Gfx::ImmutableBitmap> bitmap(size_t frame_index, Gfx::IntSize = {}) const override;
@@ -35,12 +41,34 @@ public:
     virtual Optional<CSSPixels> intrinsic_height() const override;
     virtual Optional<CSSPixelFraction> intrinsic_aspect_ratio() const override;
 
+    // Drops every decoded frame other than the one that was displayed last, if they can be decoded again later.
+    void discard_frames_not_on_display();
+
 private:
     AnimatedBitmapDecodedImageData(Vector<Frame>&&, size_t loop_count, bool animated);
 
+    virtual void finalize() override;
+
+    void request_frames_ahead_of(size_t frame_index) const;
+    void did_decode_frames(size_t first_frame_index, Vector<Frame>&&);
+    void discard_frames_beyond_capacity();
+
     Vector<Frame> m_frames;
+    Gfx::IntSize m_size;
     size_t m_loop_count { 0 };
     bool m_animated { false };
+
+    struct OnDemandDecoding {
+        i64 animation_id { 0 };
+        Gfx::ColorSpace color_space;
+
+        // Frames at or after this index have not been decoded yet, so their duration is unknown.
+        size_t known_duration_count { 0 };
+        size_t decoded_frame_count { 0 };
+        size_t last_displayed_frame_index { 0 };
+        bool has_pending_request { false };
+    };
+    mutable Optional<OnDemandDecoding> m_on_demand_decoding;
 };
 
 }
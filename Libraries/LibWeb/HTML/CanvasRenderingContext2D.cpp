@@ -101,9 +101,64 @@ Gfx::Path CanvasRenderingContext2D::rect_path(float x, float y, float width, flo
 
 void CanvasRenderingContext2D::fill_rect(float x, float y, float width, float height)
 {
+    if (try_batch_fill_rect(x, y, width, height))
+        return;
     fill_internal(rect_path(x, y, width, height), Gfx::WindingRule::EvenOdd);
 }
 
+bool CanvasRenderingContext2D::try_batch_fill_rect(float x, float y, float width, float height)
+{
+    if (!m_painter)
+        return false;
+
+    // Filling the union of the rects at once only gives the same result as filling them one by one if every pixel they
+    // cover is replaced by the same color, and none of them is partially covered by an anti-aliased edge.
+    auto const& state = drawing_state();
+    if (state.global_alpha != 1.0f
+        || state.current_compositing_and_blending_operator != Gfx::CompositingAndBlendingOperator::SourceOver
+        || state.filter.has_value()
+        || (state.shadow_color.alpha() > 0 && (state.shadow_blur != 0 || state.shadow_offset_x != 0 || state.shadow_offset_y != 0))
+        || !state.transform.is_identity_or_translation())
+        return false;
+
+    auto color = state.fill_style.as_color();
+    if (!color.has_value() || color->alpha() != 255)
+        return false;
+
+    if (width < 0) {
+        x += width;
+        width = -width;
+    }
+    if (height < 0) {
+        y += height;
+        height = -height;
+    }
+
+    auto is_pixel_aligned = [](float value) { return isfinite(value) && trunc(value) == value; };
+    auto translation = state.transform.translation();
+    if (!is_pixel_aligned(x + translation.x()) || !is_pixel_aligned(y + translation.y())
+        || !is_pixel_aligned(x + width + translation.x()) || !is_pixel_aligned(y + height + translation.y()))
+        return false;
+
+    if (m_batched_fill.has_value() && m_batched_fill->color != *color)
+        flush_batched_fill();
+    if (!m_batched_fill.has_value())
+        m_batched_fill = BatchedFill { .path = {}, .color = *color };
+
+    // All rects are added with the same orientation, so their union is filled under the nonzero winding rule.
+    m_batched_fill->path.append_path(rect_path(x, y, width, height));
+    did_draw({ x, y, width, height });
+    return true;
+}
+
+void CanvasRenderingContext2D::flush_batched_fill()
+{
+    if (!m_batched_fill.has_value())
+        return;
+    auto batched_fill = m_batched_fill.release_value();
+    m_painter->fill_path(batched_fill.path, batched_fill.color, Gfx::WindingRule::Nonzero);
+}
+
 // https://html.spec.whatwg.org/multipage/canvas.html#dom-context-2d-clearrect
 void CanvasRenderingContext2D::clear_rect(float x, float y, float width, float height)
 {
@@ -204,6 +259,8 @@ WebIDL::ExceptionOr<void> CanvasRenderingContext2D::draw_image_internal(CanvasIm
 
 void CanvasRenderingContext2D::did_draw(Gfx::FloatRect const&)
 {
+    m_readback_bitmap_is_valid = false;
+
     // FIXME: Make use of the rect to reduce the invalidated area when possible.
     if (!canvas_element().paintable())
         return;
@@ -228,6 +285,25 @@ void CanvasRenderingContext2D::set_size(Gfx::IntSize const& size)
     m_size = size;
     m_surface = nullptr;
     m_painter = nullptr;
+    m_batched_fill.clear();
+    m_readback_bitmap = nullptr;
+    m_readback_bitmap_is_valid = false;
+}
+
+// Reading pixels back from the surface is expensive when it lives on the GPU, so we keep the result around until the
+// canvas is drawn into again. Skia converts the pixels to the unpremultiplied RGBA that ImageData uses while reading
+// them back.
+ErrorOr<NonnullRefPtr<Gfx::Bitmap>> CanvasRenderingContext2D::read_back_surface(Gfx::PaintingSurface& surface) const
+{
+    if (m_readback_bitmap && m_readback_bitmap_is_valid)
+        return *m_readback_bitmap;
+
+    if (!m_readback_bitmap || m_readback_bitmap->size() != surface.size())
+        m_readback_bitmap = TRY(Gfx::Bitmap::create(Gfx::BitmapFormat::RGBA8888, Gfx::AlphaType::Unpremultiplied, surface.size()));
+
+    surface.read_into_bitmap(*m_readback_bitmap);
+    m_readback_bitmap_is_valid = true;
+    return *m_readback_bitmap;
 }
 
 void CanvasRenderingContext2D::allocate_painting_surface_if_needed()
@@ -238,11 +314,15 @@ void CanvasRenderingContext2D::allocate_painting_surface_if_needed()
     // FIXME: implement context attribute .color_space
     // FIXME: implement context attribute .color_type
     // FIXME: implement context attribute .desynchronized
-    // FIXME: implement context attribute .will_read_frequently
 
     auto color_type = m_context_attributes.alpha ? Gfx::BitmapFormat::BGRA8888 : Gfx::BitmapFormat::BGRx8888;
 
-    auto skia_backend_context = canvas_element().navigable()->traversable_navigable()->skia_backend_context();
+    // https://html.spec.whatwg.org/multipage/canvas.html#concept-canvas-will-read-frequently
+    // When the author asked for frequent readbacks, keep the canvas in memory instead of on the GPU so that getImageData()
+    // doesn't have to wait for the GPU and copy the pixels back every time.
+    RefPtr<Gfx::SkiaBackendContext> skia_backend_context;
+    if (!m_context_attributes.will_read_frequently)
+        skia_backend_context = canvas_element().navigable()->traversable_navigable()->skia_backend_context();
     m_surface = Gfx::PaintingSurface::create_with_size(skia_backend_context, canvas_element().bitmap_size_for_canvas(), color_type, Gfx::AlphaType::Premultiplied);
     m_painter = nullptr;
 
@@ -333,7 +413,7 @@ void CanvasRenderingContext2D::begin_path()
     path().clear();
 }
 
-static Gfx::Path::CapStyle to_gfx_cap(Bindings::CanvasLineCap const& cap_style)
+Gfx::Path::CapStyle to_gfx_cap(Bindings::CanvasLineCap const& cap_style)
 {
     switch (cap_style) {
     case Bindings::CanvasLineCap::Butt:
@@ -346,7 +426,7 @@ static Gfx::Path::CapStyle to_gfx_cap(Bindings::CanvasLineCap const& cap_style)
     VERIFY_NOT_REACHED();
 }
 
-static Gfx::Path::JoinStyle to_gfx_join(Bindings::CanvasLineJoin const& join_style)
+Gfx::Path::JoinStyle to_gfx_join(Bindings::CanvasLineJoin const& join_style)
 {
     switch (join_style) {
     case Bindings::CanvasLineJoin::Round:
@@ -399,7 +479,7 @@ void CanvasRenderingContext2D::stroke(Path2D const& path)
     stroke_internal(path.path());
 }
 
-static Gfx::WindingRule parse_fill_rule(StringView fill_rule)
+Gfx::WindingRule parse_fill_rule(StringView fill_rule)
 {
     if (fill_rule == "evenodd"sv)
         return Gfx::WindingRule::EvenOdd;
@@ -487,9 +567,14 @@ WebIDL::ExceptionOr<GC::Ptr<ImageData>> CanvasRenderingContext2D::get_image_data
     auto image_data = TRY(ImageData::create(realm(), abs_width, abs_height, settings));
 
     // NOTE: We don't attempt to create the underlying bitmap here; if it doesn't exist, it's like copying only transparent black pixels (which is a no-op).
-    if (!canvas_element().surface())
+    auto surface = canvas_element().surface();
+    if (!surface)
         return image_data;
-    auto const snapshot = Gfx::ImmutableBitmap::create_snapshot_from_painting_surface(*canvas_element().surface());
+
+    auto readback_bitmap_or_error = read_back_surface(*surface);
+    if (readback_bitmap_or_error.is_error())
+        return WebIDL::InvalidStateError::create(realm(), Utf16String::formatted("Error in allocating bitmap: {}", readback_bitmap_or_error.error()));
+    auto readback_bitmap = readback_bitmap_or_error.release_value();
 
     // 5. Let the source rectangle be the rectangle whose corners are the four points (sx, sy), (sx+sw, sy), (sx+sw, sy+sh), (sx, sy+sh).
     auto source_rect = Gfx::Rect { x, y, abs_width, abs_height };
@@ -500,17 +585,24 @@ WebIDL::ExceptionOr<GC::Ptr<ImageData>> CanvasRenderingContext2D::get_image_data
     if (width < 0 || height < 0) {
         source_rect = source_rect.translated(min(width, 0), min(height, 0));
     }
-    auto source_rect_intersected = source_rect.intersected(snapshot->rect());
+    auto source_rect_intersected = source_rect.intersected(readback_bitmap->rect());
 
     // 6. Set the pixel values of imageData to be the pixels of this's output bitmap in the area specified by the source rectangle in the bitmap's coordinate space units, converted from this's color space to imageData's colorSpace using 'relative-colorimetric' rendering intent.
     // NOTE: Internally we must use premultiplied alpha, but ImageData should hold unpremultiplied alpha. This conversion
-    //       might result in a loss of precision, but is according to spec.
+    //       might result in a loss of precision, but is according to spec. It already happened while reading back the
+    //       surface, so we only need to copy the pixels over here.
     //       See: https://html.spec.whatwg.org/multipage/canvas.html#premultiplied-alpha-and-the-2d-rendering-context
-    VERIFY(snapshot->alpha_type() == Gfx::AlphaType::Premultiplied);
-    VERIFY(image_data->bitmap().alpha_type() == Gfx::AlphaType::Unpremultiplied);
-
-    auto painter = Gfx::Painter::create(image_data->bitmap());
-    painter->draw_bitmap(image_data->bitmap().rect().to_type<float>(), *snapshot, source_rect_intersected, Gfx::ScalingMode::NearestNeighbor, {}, 1, Gfx::CompositingAndBlendingOperator::SourceOver);
+    auto& destination = image_data->bitmap();
+    VERIFY(destination.format() == readback_bitmap->format());
+    VERIFY(destination.alpha_type() == readback_bitmap->alpha_type());
+
+    auto destination_offset = source_rect_intersected.location() - source_rect.location();
+    auto row_size = static_cast<size_t>(source_rect_intersected.width()) * sizeof(u32);
+    for (int row = 0; row < source_rect_intersected.height(); ++row) {
+        auto const* source_row = readback_bitmap->scanline(source_rect_intersected.y() + row) + source_rect_intersected.x();
+        auto* destination_row = destination.scanline(destination_offset.y() + row) + destination_offset.x();
+        memcpy(destination_row, source_row, row_size);
+    }
 
     // 7. Set the pixels values of imageData for areas of the source rectangle that are outside of the output bitmap to transparent black.
     // NOTE: No-op, already done during creation.
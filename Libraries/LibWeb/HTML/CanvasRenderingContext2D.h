@@ -127,7 +127,11 @@ public:
 
     void set_size(Gfx::IntSize const&);
 
-    RefPtr<Gfx::PaintingSurface> surface() { return m_surface; }
+    RefPtr<Gfx::PaintingSurface> surface()
+    {
+        flush_batched_fill();
+        return m_surface;
+    }
     void allocate_painting_surface_if_needed();
 
 private:
@@ -147,6 +151,11 @@ private:
 
     void did_draw(Gfx::FloatRect const&);
 
+    ErrorOr<NonnullRefPtr<Gfx::Bitmap>> read_back_surface(Gfx::PaintingSurface&) const;
+
+    bool try_batch_fill_rect(float x, float y, float width, float height);
+    void flush_batched_fill();
+
     RefPtr<Gfx::FontCascadeList const> font_cascade_list();
 
     PreparedText prepare_text(Utf16String const&, float max_width = INFINITY);
@@ -165,6 +174,17 @@ private:
     GC::Ref<HTMLCanvasElement> m_element;
     OwnPtr<Gfx::Painter> m_painter;
 
+    // Consecutive fillRect() calls that paint the same opaque color onto whole pixels are collected into a single path,
+    // which is filled once something else draws into the canvas, changes the painter's state, or reads its surface.
+    struct BatchedFill {
+        Gfx::Path path;
+        Gfx::Color color;
+    };
+    Optional<BatchedFill> m_batched_fill;
+
+    mutable RefPtr<Gfx::Bitmap> m_readback_bitmap;
+    mutable bool m_readback_bitmap_is_valid { false };
+
     // https://html.spec.whatwg.org/multipage/canvas.html#concept-canvas-origin-clean
     bool m_origin_clean { true };
 
@@ -181,4 +201,8 @@ enum class CanvasImageSourceUsability {
 WebIDL::ExceptionOr<CanvasImageSourceUsability> check_usability_of_image(CanvasImageSource const&);
 bool image_is_not_origin_clean(CanvasImageSource const&);
 
+Gfx::Path::CapStyle to_gfx_cap(Bindings::CanvasLineCap const&);
+Gfx::Path::JoinStyle to_gfx_join(Bindings::CanvasLineJoin const&);
+Gfx::WindingRule parse_fill_rule(StringView fill_rule);
+
 }
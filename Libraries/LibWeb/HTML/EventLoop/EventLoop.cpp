@@ -6,6 +6,7 @@
  */
 
 #include <LibCore/EventLoop.h>
+#include <LibCore/Trace.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/CSS/FontFaceSet.h>
@@ -234,6 +235,10 @@ void EventLoop::queue_task_to_update_the_rendering()
 
     // OPTIMIZATION: If there are already rendering tasks in the queue, we don't need to queue another one.
     if (m_task_queue->has_rendering_tasks()) {
+        // The rendering task of the last rendering opportunity hasn't run yet, so the page is too busy to keep up with its
+        // frame rate. Updating the rendering is also where we process input events, so let it run ahead of any tasks that
+        // aren't user-blocking.
+        m_task_queue->raise_priority_of_tasks_with_source(Task::Source::Rendering, Task::Priority::UserBlocking);
         return;
     }
 
@@ -327,6 +332,8 @@ void EventLoop::update_the_rendering()
         m_running_rendering_task = false;
     };
 
+    Core::TraceScope trace_scope("Update the rendering"sv);
+
     process_input_events();
 
     // 1. Let frameTimestamp be eventLoop's last render opportunity time.
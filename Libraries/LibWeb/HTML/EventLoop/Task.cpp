@@ -20,14 +20,28 @@ static IDAllocator s_unique_task_source_allocator { static_cast<int>(Task::Sourc
     return next_task_id++;
 }
 
+static Task::Priority priority_for_source(Task::Source source)
+{
+    // Input is handled before other tasks, as delaying it is what makes a busy page feel unresponsive.
+    if (source == Task::Source::UserInteraction)
+        return Task::Priority::UserBlocking;
+    return Task::Priority::UserVisible;
+}
+
 GC::Ref<Task> Task::create(JS::VM& vm, Source source, GC::Ptr<DOM::Document const> document, GC::Ref<GC::Function<void()>> steps)
 {
-    return vm.heap().allocate<Task>(source, document, move(steps));
+    return vm.heap().allocate<Task>(source, priority_for_source(source), document, move(steps));
+}
+
+GC::Ref<Task> Task::create(JS::VM& vm, Source source, Priority priority, GC::Ptr<DOM::Document const> document, GC::Ref<GC::Function<void()>> steps)
+{
+    return vm.heap().allocate<Task>(source, priority, document, move(steps));
 }
 
-Task::Task(Source source, GC::Ptr<DOM::Document const> document, GC::Ref<GC::Function<void()>> steps)
+Task::Task(Source source, Priority priority, GC::Ptr<DOM::Document const> document, GC::Ref<GC::Function<void()>> steps)
     : m_id(allocate_task_id())
     , m_source(source)
+    , m_priority(priority)
     , m_steps(steps)
     , m_document(document)
 {
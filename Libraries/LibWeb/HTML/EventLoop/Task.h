@@ -84,18 +84,40 @@ public:
         // https://w3c.github.io/gamepad/#dfn-gamepad-task-source
         Gamepad,
 
+        // https://w3c.github.io/webcrypto/#dfn-crypto-task-source
+        Crypto,
+
+        // https://wicg.github.io/scheduling-apis/#posted-task-task-source
+        PostedTask,
+
         // !!! IMPORTANT: Keep this field last!
         // This serves as the base value of all unique task sources.
         // Some elements, such as the HTMLMediaElement, must have a unique task source per instance.
         UniqueTaskSourceStart
     };
 
+    // https://wicg.github.io/scheduling-apis/#sec-scheduling-tasks
+    // The event loop runs runnable tasks with a higher priority first. Tasks that aren't posted through the Scheduler API
+    // get a priority based on their source. Continuations of a priority, queued by scheduler.yield(), run before other
+    // tasks of the same priority.
+    enum class Priority : u8 {
+        Background,
+        BackgroundContinuation,
+        UserVisible,
+        UserVisibleContinuation,
+        UserBlocking,
+        UserBlockingContinuation,
+    };
+    static constexpr size_t priority_count = to_underlying(Priority::UserBlockingContinuation) + 1;
+
     static GC::Ref<Task> create(JS::VM&, Source, GC::Ptr<DOM::Document const>, GC::Ref<GC::Function<void()>> steps);
+    static GC::Ref<Task> create(JS::VM&, Source, Priority, GC::Ptr<DOM::Document const>, GC::Ref<GC::Function<void()>> steps);
 
     virtual ~Task() override;
 
     [[nodiscard]] TaskID id() const { return m_id; }
     Source source() const { return m_source; }
+    Priority priority() const { return m_priority; }
     void execute();
 
     DOM::Document const* document() const;
@@ -103,12 +125,15 @@ public:
     bool is_runnable() const;
 
 private:
-    Task(Source, GC::Ptr<DOM::Document const>, GC::Ref<GC::Function<void()>> steps);
+    friend class TaskQueue;
+
+    Task(Source, Priority, GC::Ptr<DOM::Document const>, GC::Ref<GC::Function<void()>> steps);
 
     virtual void visit_edges(Visitor&) override;
 
     TaskID m_id {};
     Source m_source { Source::Unspecified };
+    Priority m_priority { Priority::UserVisible };
     GC::Ref<GC::Function<void()>> m_steps;
     GC::Ptr<DOM::Document const> m_document;
 };
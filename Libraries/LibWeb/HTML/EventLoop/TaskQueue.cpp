@@ -29,19 +29,36 @@ void TaskQueue::visit_edges(Visitor& visitor)
 void TaskQueue::add(GC::Ref<Task> task)
 {
     m_tasks.append(task);
+    ++m_task_count_per_priority[to_underlying(task->priority())];
     m_event_loop->schedule();
 }
 
+GC::Ref<Task> TaskQueue::take(size_t index)
+{
+    auto task = m_tasks.take(index);
+    --m_task_count_per_priority[to_underlying(task->priority())];
+    return task;
+}
+
 GC::Ptr<Task> TaskQueue::take_first_runnable()
 {
     if (m_event_loop->execution_paused())
         return nullptr;
 
-    for (size_t i = 0; i < m_tasks.size(); ++i) {
-        if (m_event_loop->running_rendering_task() && m_tasks[i]->source() == Task::Source::Rendering)
+    // Take the first runnable task of the highest priority that has one. Tasks of the same source always have the same
+    // priority, so this keeps the tasks of each source in order.
+    for (size_t priority = Task::priority_count; priority-- > 0;) {
+        if (m_task_count_per_priority[priority] == 0)
             continue;
-        if (m_tasks[i]->is_runnable())
-            return m_tasks.take(i);
+
+        for (size_t i = 0; i < m_tasks.size(); ++i) {
+            if (to_underlying(m_tasks[i]->priority()) != priority)
+                continue;
+            if (m_event_loop->running_rendering_task() && m_tasks[i]->source() == Task::Source::Rendering)
+                continue;
+            if (m_tasks[i]->is_runnable())
+                return take(i);
+        }
     }
     return nullptr;
 }
@@ -63,7 +80,10 @@ bool TaskQueue::has_runnable_tasks() const
 void TaskQueue::remove_tasks_matching(Function<bool(HTML::Task const&)> filter)
 {
     m_tasks.remove_all_matching([&](auto& task) {
-        return filter(*task);
+        if (!filter(*task))
+            return false;
+        --m_task_count_per_priority[to_underlying(task->priority())];
+        return true;
     });
 }
 
@@ -75,8 +95,7 @@ GC::RootVector<GC::Ref<Task>> TaskQueue::take_tasks_matching(Function<bool(HTML:
         auto& task = m_tasks.at(i);
 
         if (filter(*task)) {
-            matching_tasks.append(task);
-            m_tasks.remove(i);
+            matching_tasks.append(take(i));
         } else {
             ++i;
         }
@@ -92,6 +111,17 @@ Task const* TaskQueue::last_added_task() const
     return m_tasks.last();
 }
 
+void TaskQueue::raise_priority_of_tasks_with_source(Task::Source source, Task::Priority priority)
+{
+    for (auto& task : m_tasks) {
+        if (task->source() != source || task->priority() >= priority)
+            continue;
+        --m_task_count_per_priority[to_underlying(task->priority())];
+        task->m_priority = priority;
+        ++m_task_count_per_priority[to_underlying(priority)];
+    }
+}
+
 bool TaskQueue::has_rendering_tasks() const
 {
     for (auto const& task : m_tasks) {
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Queue.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibWeb/HTML/EventLoop/Task.h>
@@ -33,20 +34,29 @@ public:
     {
         if (m_tasks.is_empty())
             return {};
-        return m_tasks.take_first();
+        return take(0);
     }
 
     void remove_tasks_matching(Function<bool(HTML::Task const&)>);
     GC::RootVector<GC::Ref<Task>> take_tasks_matching(Function<bool(HTML::Task const&)>);
 
+    // Raises the priority of the queued tasks of the given source, if it is lower.
+    void raise_priority_of_tasks_with_source(Task::Source, Task::Priority);
+
     Task const* last_added_task() const;
 
 private:
     virtual void visit_edges(Visitor&) override;
 
+    GC::Ref<HTML::Task> take(size_t index);
+
     GC::Ref<HTML::EventLoop> m_event_loop;
 
     Vector<GC::Ref<HTML::Task>> m_tasks;
+
+    // The number of queued tasks of each priority, so that finding the next task to run only has to look at the tasks of
+    // the highest priority, instead of all of them.
+    Array<size_t, Task::priority_count> m_task_count_per_priority {};
 };
 
 }
@@ -358,7 +358,7 @@ static Vector<Variant<Utf16String, RequiredLineBreakCount>> rendered_text_collec
     //    element. Soft hyphens should be preserved. [CSSTEXT]
 
     if (auto const* layout_text_node = as_if<Layout::TextNode>(layout_node)) {
-        Layout::TextNode::ChunkIterator iterator { *layout_text_node, false, false };
+        Layout::TextNode::ChunkIterator iterator { *layout_text_node, layout_text_node->text_for_rendering(), layout_text_node->grapheme_segmenter(), false, false };
         while (true) {
             auto chunk = iterator.next();
             if (!chunk.has_value())
@@ -213,9 +213,19 @@ RefPtr<Gfx::ImmutableBitmap> HTMLImageElement::current_image_bitmap_sized(Gfx::I
     return nullptr;
 }
 
-void HTMLImageElement::set_visible_in_viewport(bool)
+void HTMLImageElement::set_visible_in_viewport(bool visible_in_viewport)
 {
-    // FIXME: Loosen grip on image data when it's not visible, e.g via volatile memory.
+    if (m_visible_in_viewport == visible_in_viewport)
+        return;
+    m_visible_in_viewport = visible_in_viewport;
+
+    // Animations that are decoded on demand can give back the frames they are not showing, and decode them again once
+    // they are scrolled back into view.
+    // FIXME: Loosen grip on other image data when it's not visible, e.g via volatile memory.
+    if (!visible_in_viewport) {
+        if (auto* animated_image_data = as_if<AnimatedBitmapDecodedImageData>(m_current_request->image_data().ptr()))
+            animated_image_data->discard_frames_not_on_display();
+    }
 }
 
 // https://html.spec.whatwg.org/multipage/embedded-content.html#dom-img-width
@@ -762,10 +772,20 @@ after_step_7:
         // 23. Set request's priority to the current state of the element's fetchpriority attribute.
         request->set_priority(Fetch::Infrastructure::request_priority_from_string(get_attribute_value(HTML::AttributeNames::fetchpriority)).value_or(Fetch::Infrastructure::Request::Priority::Auto));
 
+        // AD-HOC: Images the page asked us to prioritize are usually large and prominent, so we show them while they
+        //         are still loading. Responses that are not buffered skip the resource cache, so we don't do this for
+        //         every image.
+        if (request->priority() == Fetch::Infrastructure::Request::Priority::High)
+            request->set_buffer_policy(Fetch::Infrastructure::Request::BufferPolicy::DoNotBufferResponse);
+
         // 25. If the will lazy load element steps given the img return true, then:
         if (will_lazy_load_element()) {
             // 1. Set the img's lazy load resumption steps to the rest of this algorithm starting with the step labeled fetch the image.
             set_lazy_load_resumption_steps([this, request, image_request]() {
+                // AD-HOC: The image is only fetched once it is about to scroll into view, so let it jump ahead of
+                //         images that are not.
+                if (request->priority() == Fetch::Infrastructure::Request::Priority::Auto)
+                    request->set_priority(Fetch::Infrastructure::Request::Priority::High);
                 image_request->fetch_image(realm(), request);
             });
 
@@ -847,6 +867,19 @@ void HTMLImageElement::add_callbacks_to_image_request(GC::Ref<ImageRequest> imag
                 dispatch_event(DOM::Event::create(realm(), HTML::EventNames::error));
 
             m_load_event_delayer.clear();
+        },
+        [this, image_request]() {
+            // AD-HOC: Show what has been decoded of an image that is still loading, as long as it isn't replacing an
+            //         image that is already on display. Per spec, this is "partially available".
+            if (image_request != m_current_request || image_request->state() == ImageRequest::State::CompletelyAvailable)
+                return;
+            VERIFY(image_request->shared_resource_request());
+            image_request->set_image_data(image_request->shared_resource_request()->image_data());
+            image_request->set_state(ImageRequest::State::PartiallyAvailable);
+
+            set_needs_style_update(true);
+            if (auto layout_node = this->layout_node())
+                layout_node->set_needs_layout_update(DOM::SetNeedsLayoutReason::HTMLImageElementUpdateTheImageData);
         });
 }
 
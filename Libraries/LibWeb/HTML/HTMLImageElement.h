@@ -142,6 +142,7 @@ private:
 
     RefPtr<Core::Timer> m_animation_timer;
     size_t m_current_frame_index { 0 };
+    bool m_visible_in_viewport { false };
     size_t m_loops_completed { 0 };
 
     Optional<DOM::DocumentLoadEventDelayer> m_load_event_delayer;
@@ -6,6 +6,7 @@
  */
 
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/ImmutableBitmap.h>
 #include <LibWeb/Bindings/HTMLVideoElementPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/CSS/ComputedProperties.h>
@@ -121,7 +122,7 @@ void HTMLVideoElement::set_video_track(GC::Ptr<HTML::VideoTrack> video_track)
     m_video_track = video_track;
 }
 
-void HTMLVideoElement::set_current_frame(Badge<VideoTrack>, RefPtr<Gfx::Bitmap> frame, double position)
+void HTMLVideoElement::set_current_frame(Badge<VideoTrack>, RefPtr<Gfx::ImmutableBitmap> frame, double position)
 {
     m_current_frame = { move(frame), position };
     if (paintable())
@@ -16,7 +16,7 @@
 namespace Web::HTML {
 
 struct VideoFrame {
-    RefPtr<Gfx::Bitmap> frame;
+    RefPtr<Gfx::ImmutableBitmap> frame;
     double position { 0.0 };
 };
 
@@ -38,12 +38,12 @@ public:
 
     void set_video_track(GC::Ptr<VideoTrack>);
 
-    void set_current_frame(Badge<VideoTrack>, RefPtr<Gfx::Bitmap> frame, double position);
+    void set_current_frame(Badge<VideoTrack>, RefPtr<Gfx::ImmutableBitmap> frame, double position);
     VideoFrame const& current_frame() const { return m_current_frame; }
     RefPtr<Gfx::Bitmap> const& poster_frame() const { return m_poster_frame; }
 
     // FIXME: This is a hack for images used as CanvasImageSource. Do something more elegant.
-    RefPtr<Gfx::Bitmap> bitmap() const
+    RefPtr<Gfx::ImmutableBitmap> bitmap() const
     {
         return current_frame().frame;
     }
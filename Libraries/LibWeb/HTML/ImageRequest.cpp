@@ -128,10 +128,10 @@ void ImageRequest::fetch_image(JS::Realm& realm, GC::Ref<Fetch::Infrastructure::
     m_shared_resource_request->fetch_resource(realm, request);
 }
 
-void ImageRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void ImageRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial_image)
 {
     VERIFY(m_shared_resource_request);
-    m_shared_resource_request->add_callbacks(move(on_finish), move(on_fail));
+    m_shared_resource_request->add_callbacks(move(on_finish), move(on_fail), move(on_partial_image));
 }
 
 }
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/Fetch/Fetching/Fetching.h>
+#include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/HTML/MapOfPreloadedResources.h>
+#include <LibWeb/HTML/Window.h>
+
+namespace Web::HTML {
+
+GC_DEFINE_ALLOCATOR(PreloadEntry);
+GC_DEFINE_ALLOCATOR(MapOfPreloadedResources);
+
+PreloadEntry::PreloadEntry(String integrity_metadata)
+    : m_integrity_metadata(move(integrity_metadata))
+{
+}
+
+void PreloadEntry::visit_edges(JS::Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_response);
+    visitor.visit(m_on_response_available);
+}
+
+u32 MapOfPreloadedResources::Key::hash() const
+{
+    u32 destination_hash = destination.has_value() ? to_underlying(*destination) + 1 : 0;
+    u32 modes_hash = pair_int_hash(to_underlying(mode), to_underlying(credentials_mode));
+    return pair_int_hash(Traits<URL::URL>::hash(url), pair_int_hash(destination_hash, modes_hash));
+}
+
+MapOfPreloadedResources::MapOfPreloadedResources() = default;
+MapOfPreloadedResources::~MapOfPreloadedResources() = default;
+
+GC::Ptr<PreloadEntry> MapOfPreloadedResources::get(Key const& key) const
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return nullptr;
+    return it->value;
+}
+
+void MapOfPreloadedResources::visit_edges(JS::Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    for (auto& it : m_entries)
+        visitor.visit(it.value);
+}
+
+// https://html.spec.whatwg.org/multipage/links.html#consume-a-preloaded-resource
+bool consume_a_preloaded_resource(Window& window, URL::URL const& url, Optional<Fetch::Infrastructure::Request::Destination> destination, Fetch::Infrastructure::Request::Mode mode, Fetch::Infrastructure::Request::CredentialsMode credentials_mode, String const& integrity_metadata, GC::Ref<PreloadEntry::OnResponseAvailable> on_response_available)
+{
+    // 1. Let key be a preload key whose URL is url, destination is destination, mode is mode, and credentials mode is
+    //    credentialsMode.
+    MapOfPreloadedResources::Key key { url, destination, mode, credentials_mode };
+
+    // 2. Let preloads be window's associated Document's map of preloaded resources.
+    auto& preloads = window.associated_document().map_of_preloaded_resources();
+
+    // 3. If key does not exist in preloads, then return false.
+    // 4. Let entry be preloads[key].
+    auto entry = preloads.get(key);
+    if (!entry)
+        return false;
+
+    // FIXME: 5. Let consumerIntegrityMetadata be the result of parsing integrityMetadata.
+    // FIXME: 6. Let preloadIntegrityMetadata be the result of parsing entry's integrity metadata.
+    // 7. If none of the following conditions apply:
+    //    - consumerIntegrityMetadata is no metadata;
+    //    - consumerIntegrityMetadata is equal to preloadIntegrityMetadata;
+    //    then return false.
+    // NOTE: Until we parse the metadata, we compare the unparsed strings instead.
+    if (!integrity_metadata.is_empty() && integrity_metadata != entry->integrity_metadata())
+        return false;
+
+    // 8. Remove preloads[key].
+    preloads.remove(key);
+
+    // 9. If entry's response is null, then set entry's on response available to onResponseAvailable.
+    if (!entry->response())
+        entry->set_on_response_available(on_response_available);
+    // 10. Otherwise, call onResponseAvailable with entry's response.
+    else
+        on_response_available->function()(*entry->response());
+
+    // 11. Return true.
+    return true;
+}
+
+// https://html.spec.whatwg.org/multipage/links.html#preload
+void preload(DOM::Document& document, GC::Ref<Fetch::Infrastructure::Request> request)
+{
+    auto& realm = document.realm();
+
+    // 11. Let key be a preload key whose URL is request's URL, destination is request's destination, mode is request's
+    //     mode, and credentials mode is request's credentials mode.
+    MapOfPreloadedResources::Key key { request->url(), request->destination(), request->mode(), request->credentials_mode() };
+
+    // 12. Let entry be a new preload entry whose integrity metadata is options's integrity.
+    auto entry = realm.create<PreloadEntry>(request->integrity_metadata());
+
+    // 15. Fetch request, with processResponseConsumeBody set to the following steps given a response response and
+    //     null, failure, or a byte sequence bytesOrNull:
+    Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
+    fetch_algorithms_input.process_response_consume_body = [&realm, entry](GC::Ref<Fetch::Infrastructure::Response> response, Fetch::Infrastructure::FetchAlgorithms::BodyBytes bytes_or_null) {
+        // 1. If bytesOrNull is a byte sequence, then set response's body to the first return value of safely
+        //    extracting bytesOrNull.
+        if (auto* bytes = bytes_or_null.get_pointer<ByteBuffer>())
+            response->set_body(Fetch::Infrastructure::byte_sequence_as_body(realm, *bytes));
+        // 2. Otherwise, set response to a network error.
+        else
+            response = Fetch::Infrastructure::Response::network_error(realm.vm(), "Unable to preload resource"_string);
+
+        // FIXME: 3. Let finalizeTiming be the following steps given a global object global: ...
+
+        // 4. If entry's on response available is null, then set entry's response to response; otherwise call entry's
+        //    on response available given response.
+        if (auto on_response_available = entry->on_response_available())
+            on_response_available->function()(response);
+        else
+            entry->set_response(response);
+    };
+
+    if (Fetch::Fetching::fetch(realm, request, Fetch::Infrastructure::FetchAlgorithms::create(realm.vm(), move(fetch_algorithms_input))).is_error())
+        return;
+
+    // 13. Set preloads[key] to entry.
+    // NOTE: We only do this once the fetch has started, since fetching otherwise finds the entry and waits on itself.
+    document.map_of_preloaded_resources().set(key, entry);
+}
+
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <LibGC/Function.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/links.html#preload-entry
+class PreloadEntry final : public JS::Cell {
+    GC_CELL(PreloadEntry, JS::Cell);
+    GC_DECLARE_ALLOCATOR(PreloadEntry);
+
+public:
+    using OnResponseAvailable = GC::Function<void(GC::Ref<Fetch::Infrastructure::Response>)>;
+
+    String const& integrity_metadata() const { return m_integrity_metadata; }
+
+    GC::Ptr<Fetch::Infrastructure::Response> response() const { return m_response; }
+    void set_response(GC::Ref<Fetch::Infrastructure::Response> response) { m_response = response; }
+
+    GC::Ptr<OnResponseAvailable> on_response_available() const { return m_on_response_available; }
+    void set_on_response_available(GC::Ref<OnResponseAvailable> on_response_available) { m_on_response_available = on_response_available; }
+
+private:
+    explicit PreloadEntry(String integrity_metadata);
+
+    virtual void visit_edges(JS::Cell::Visitor&) override;
+
+    // https://html.spec.whatwg.org/multipage/links.html#preload-integrity-metadata
+    String m_integrity_metadata;
+
+    // https://html.spec.whatwg.org/multipage/links.html#preload-response
+    GC::Ptr<Fetch::Infrastructure::Response> m_response;
+
+    // https://html.spec.whatwg.org/multipage/links.html#preload-on-response-available
+    GC::Ptr<OnResponseAvailable> m_on_response_available;
+};
+
+// https://html.spec.whatwg.org/multipage/links.html#map-of-preloaded-resources
+class MapOfPreloadedResources final : public JS::Cell {
+    GC_CELL(MapOfPreloadedResources, JS::Cell);
+    GC_DECLARE_ALLOCATOR(MapOfPreloadedResources);
+
+public:
+    // https://html.spec.whatwg.org/multipage/links.html#preload-key
+    struct Key {
+        URL::URL url;
+        Optional<Fetch::Infrastructure::Request::Destination> destination;
+        Fetch::Infrastructure::Request::Mode mode;
+        Fetch::Infrastructure::Request::CredentialsMode credentials_mode;
+
+        [[nodiscard]] bool operator==(Key const&) const = default;
+        [[nodiscard]] u32 hash() const;
+    };
+
+    MapOfPreloadedResources();
+    ~MapOfPreloadedResources();
+
+    bool contains(Key const& key) const { return m_entries.contains(key); }
+    GC::Ptr<PreloadEntry> get(Key const&) const;
+    void set(Key const& key, GC::Ref<PreloadEntry> entry) { m_entries.set(key, entry); }
+    void remove(Key const& key) { m_entries.remove(key); }
+
+    virtual void visit_edges(JS::Cell::Visitor&) override;
+
+private:
+    HashMap<Key, GC::Ref<PreloadEntry>> m_entries;
+};
+
+// https://html.spec.whatwg.org/multipage/links.html#consume-a-preloaded-resource
+bool consume_a_preloaded_resource(Window&, URL::URL const&, Optional<Fetch::Infrastructure::Request::Destination>, Fetch::Infrastructure::Request::Mode, Fetch::Infrastructure::Request::CredentialsMode, String const& integrity_metadata, GC::Ref<PreloadEntry::OnResponseAvailable>);
+
+// Fetches request ahead of time and makes the response available to the first matching fetch made for the document.
+// This follows the steps of https://html.spec.whatwg.org/multipage/links.html#preload, with request created by the caller.
+void preload(DOM::Document&, GC::Ref<Fetch::Infrastructure::Request>);
+
+}
+
+namespace AK {
+
+template<>
+struct Traits<Web::HTML::MapOfPreloadedResources::Key> : public DefaultTraits<Web::HTML::MapOfPreloadedResources::Key> {
+    static unsigned hash(Web::HTML::MapOfPreloadedResources::Key const& key) { return key.hash(); }
+};
+
+}
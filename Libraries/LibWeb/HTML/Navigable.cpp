@@ -2648,15 +2648,58 @@ void Navigable::paint_next_frame()
 
     auto viewport_rect = page().css_to_device_rect(this->viewport_rect()).to_type<int>();
     PaintConfig paint_config { .paint_overlay = true, .should_show_line_box_borders = m_should_show_line_box_borders, .canvas_fill_rect = Gfx::IntRect { {}, viewport_rect.size() } };
+    Optional<Gfx::IntRect> damage_rect;
+    if (auto document = active_document()) {
+        if (auto display_list = document->record_display_list(paint_config))
+            damage_rect = take_damage_rect_for_next_frame(*display_list, backing_store_id);
+    }
+
     auto page_client = &page().top_level_traversable()->page().client();
-    start_display_list_rendering(*painting_surface, paint_config, [page_client, viewport_rect, backing_store_id] {
-        if (!page_client)
-            return;
-        page_client->page_did_paint(viewport_rect, backing_store_id);
-    });
+    start_display_list_rendering(
+        *painting_surface, paint_config, [page_client, viewport_rect, backing_store_id] {
+            if (!page_client)
+                return;
+            page_client->page_did_paint(viewport_rect, backing_store_id);
+        },
+        damage_rect);
+}
+
+void Navigable::set_needs_repaint(CSSPixelRect const& damage_rect)
+{
+    m_needs_repaint = true;
+    if (m_needs_full_repaint)
+        return;
+    m_damage_rect = m_damage_rect.has_value() ? m_damage_rect->united(damage_rect) : damage_rect;
+}
+
+Optional<Gfx::IntRect> Navigable::take_damage_rect_for_next_frame(Painting::DisplayList& display_list, i32 backing_store_id)
+{
+    // The damage since the previous frame is only meaningful if it was painted from the same display list, since
+    // anything could have changed in a newly recorded one.
+    Optional<Gfx::IntRect> damage_rect_since_previous_frame;
+    if (!m_needs_full_repaint && m_damage_rect.has_value() && m_previous_frame_display_list == &display_list) {
+        if (auto document = active_document(); document && document->visual_viewport()->transform().is_identity()) {
+            // NOTE: Pad the damage rect a little, so that antialiased edges are repainted as well.
+            damage_rect_since_previous_frame = page().enclosing_device_rect(*m_damage_rect).to_type<int>().inflated(2, 2);
+        }
+    }
+    m_needs_full_repaint = false;
+    m_damage_rect.clear();
+
+    // We're painting into the backing store that holds the frame before the previous one, so everything that was
+    // damaged in either of the last two frames needs to be repainted.
+    Optional<Gfx::IntRect> damage_rect;
+    if (damage_rect_since_previous_frame.has_value() && m_previous_frame_damage_rect.has_value() && backing_store_id == m_frame_before_previous_backing_store_id)
+        damage_rect = damage_rect_since_previous_frame->united(*m_previous_frame_damage_rect);
+
+    m_previous_frame_display_list = display_list;
+    m_previous_frame_damage_rect = damage_rect_since_previous_frame;
+    m_frame_before_previous_backing_store_id = m_previous_frame_backing_store_id;
+    m_previous_frame_backing_store_id = backing_store_id;
+    return damage_rect;
 }
 
-void Navigable::start_display_list_rendering(Gfx::PaintingSurface& painting_surface, PaintConfig paint_config, Function<void()>&& callback)
+void Navigable::start_display_list_rendering(Gfx::PaintingSurface& painting_surface, PaintConfig paint_config, Function<void()>&& callback, Optional<Gfx::IntRect> damage_rect)
 {
     m_needs_repaint = false;
     auto document = active_document();
@@ -2692,7 +2735,7 @@ void Navigable::start_display_list_rendering(Gfx::PaintingSurface& painting_surf
         return TraversalDecision::Continue;
     });
 
-    m_rendering_thread.enqueue_rendering_task(*display_list, move(scroll_state_snapshot_by_display_list), painting_surface, move(callback));
+    m_rendering_thread.enqueue_rendering_task(*display_list, move(scroll_state_snapshot_by_display_list), painting_surface, damage_rect, move(callback));
 }
 
 RefPtr<Gfx::SkiaBackendContext> Navigable::skia_backend_context() const
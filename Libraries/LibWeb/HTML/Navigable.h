@@ -198,10 +198,16 @@ public:
     bool is_ready_to_paint() const;
     void ready_to_paint();
     void paint_next_frame();
-    void start_display_list_rendering(Gfx::PaintingSurface&, PaintConfig, Function<void()>&& callback);
+    void start_display_list_rendering(Gfx::PaintingSurface&, PaintConfig, Function<void()>&& callback, Optional<Gfx::IntRect> damage_rect = {});
 
     bool needs_repaint() const { return m_needs_repaint; }
-    void set_needs_repaint() { m_needs_repaint = true; }
+    void set_needs_repaint()
+    {
+        m_needs_repaint = true;
+        m_needs_full_repaint = true;
+    }
+    // The damage rect is in viewport coordinates.
+    void set_needs_repaint(CSSPixelRect const& damage_rect);
 
     [[nodiscard]] bool has_inclusive_ancestor_with_visibility_hidden() const;
 
@@ -240,6 +246,8 @@ private:
 
     void inform_the_navigation_api_about_aborting_navigation();
 
+    Optional<Gfx::IntRect> take_damage_rect_for_next_frame(Painting::DisplayList&, i32 backing_store_id);
+
     // https://html.spec.whatwg.org/multipage/document-sequences.html#nav-id
     String m_id;
 
@@ -278,6 +286,16 @@ private:
 
     bool m_is_svg_page { false };
     bool m_needs_repaint { true };
+
+    // Damage tracking for partial repaints of the backing stores. A frame can be painted partially if it's painted
+    // into the backing store that holds the frame before the previous one, and nothing but the damaged areas of the
+    // last two frames has changed since then.
+    bool m_needs_full_repaint { true };
+    Optional<CSSPixelRect> m_damage_rect;
+    RefPtr<Painting::DisplayList> m_previous_frame_display_list;
+    Optional<Gfx::IntRect> m_previous_frame_damage_rect;
+    i32 m_previous_frame_backing_store_id { -1 };
+    i32 m_frame_before_previous_backing_store_id { -1 };
     bool m_pending_set_browser_zoom_request { false };
     bool m_should_show_line_box_borders { false };
     i32 m_number_of_queued_rasterization_tasks { 0 };
@@ -11,6 +11,7 @@
 #include <LibUnicode/Segmenter.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Bindings/OffscreenCanvasRenderingContext2DPrototype.h>
+#include <LibWeb/HTML/CanvasRenderingContext2D.h>
 #include <LibWeb/HTML/HTMLCanvasElement.h>
 #include <LibWeb/HTML/HTMLImageElement.h>
 #include <LibWeb/HTML/ImageBitmap.h>
@@ -65,6 +66,8 @@ void OffscreenCanvasRenderingContext2D::set_size(Gfx::IntSize const& size)
     if (m_size == size)
         return;
     m_size = size;
+    m_painter = nullptr;
+    m_painter_bitmap = nullptr;
 }
 
 GC::Ref<OffscreenCanvas> OffscreenCanvasRenderingContext2D::canvas()
@@ -83,19 +86,41 @@ OffscreenCanvas const& OffscreenCanvasRenderingContext2D::canvas_element() const
     return *m_canvas;
 }
 
-void OffscreenCanvasRenderingContext2D::fill_rect(float, float, float, float)
+Gfx::Path OffscreenCanvasRenderingContext2D::rect_path(float x, float y, float width, float height)
 {
-    dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::fill_rect()");
+    auto top_left = Gfx::FloatPoint(x, y);
+    auto top_right = Gfx::FloatPoint(x + width, y);
+    auto bottom_left = Gfx::FloatPoint(x, y + height);
+    auto bottom_right = Gfx::FloatPoint(x + width, y + height);
+
+    Gfx::Path path;
+    path.move_to(top_left);
+    path.line_to(top_right);
+    path.line_to(bottom_right);
+    path.line_to(bottom_left);
+    path.line_to(top_left);
+    return path;
 }
 
-void OffscreenCanvasRenderingContext2D::clear_rect(float, float, float, float)
+void OffscreenCanvasRenderingContext2D::fill_rect(float x, float y, float width, float height)
 {
-    dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::clear_rect()");
+    fill_internal(rect_path(x, y, width, height), Gfx::WindingRule::EvenOdd);
 }
 
-void OffscreenCanvasRenderingContext2D::stroke_rect(float, float, float, float)
+// https://html.spec.whatwg.org/multipage/canvas.html#dom-context-2d-clearrect
+void OffscreenCanvasRenderingContext2D::clear_rect(float x, float y, float width, float height)
 {
-    dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::stroke_rect()");
+    // 1. If any of the arguments are infinite or NaN, then return.
+    if (!isfinite(x) || !isfinite(y) || !isfinite(width) || !isfinite(height))
+        return;
+
+    if (auto* painter = this->painter())
+        painter->clear_rect(Gfx::FloatRect(x, y, width, height), clear_color());
+}
+
+void OffscreenCanvasRenderingContext2D::stroke_rect(float x, float y, float width, float height)
+{
+    stroke_internal(rect_path(x, y, width, height));
 }
 
 WebIDL::ExceptionOr<void> OffscreenCanvasRenderingContext2D::draw_image_internal(CanvasImageSource const&, float, float, float, float, float, float, float, float)
@@ -106,17 +131,49 @@ WebIDL::ExceptionOr<void> OffscreenCanvasRenderingContext2D::draw_image_internal
 
 void OffscreenCanvasRenderingContext2D::begin_path()
 {
-    dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::begin_path()");
+    path().clear();
+}
+
+Gfx::Color OffscreenCanvasRenderingContext2D::clear_color() const
+{
+    return m_context_attributes.alpha ? Gfx::Color::Transparent : Gfx::Color::Black;
+}
+
+// FIXME: Paint shadows, like CanvasRenderingContext2D does.
+void OffscreenCanvasRenderingContext2D::stroke_internal(Gfx::Path const& path)
+{
+    auto* painter = this->painter();
+    if (!painter)
+        return;
+
+    auto& state = drawing_state();
+
+    auto dash_array = Vector<float> {};
+    dash_array.ensure_capacity(state.dash_list.size());
+    for (auto const& dash : state.dash_list)
+        dash_array.append(static_cast<float>(dash));
+
+    painter->stroke_path(path, state.stroke_style.to_gfx_paint_style(), state.filter, state.line_width, state.global_alpha, state.current_compositing_and_blending_operator, to_gfx_cap(state.line_cap), to_gfx_join(state.line_join), state.miter_limit, dash_array, state.line_dash_offset);
 }
 
 void OffscreenCanvasRenderingContext2D::stroke()
 {
-    dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::stroke()");
+    stroke_internal(path());
 }
 
-void OffscreenCanvasRenderingContext2D::stroke(Path2D const&)
+void OffscreenCanvasRenderingContext2D::stroke(Path2D const& path)
 {
-    dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::stroke(Path2D)");
+    stroke_internal(path.path());
+}
+
+void OffscreenCanvasRenderingContext2D::fill_internal(Gfx::Path const& path, Gfx::WindingRule winding_rule)
+{
+    auto* painter = this->painter();
+    if (!painter)
+        return;
+
+    auto& state = drawing_state();
+    painter->fill_path(path, state.fill_style.to_gfx_paint_style(), state.filter, state.global_alpha, state.current_compositing_and_blending_operator, winding_rule);
 }
 
 void OffscreenCanvasRenderingContext2D::fill_text(Utf16String const&, float, float, Optional<double>)
@@ -129,14 +186,14 @@ void OffscreenCanvasRenderingContext2D::stroke_text(Utf16String const&, float, f
     dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::stroke_text()");
 }
 
-void OffscreenCanvasRenderingContext2D::fill(StringView)
+void OffscreenCanvasRenderingContext2D::fill(StringView fill_rule)
 {
-    dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::fill(StringView)");
+    fill_internal(path(), parse_fill_rule(fill_rule));
 }
 
-void OffscreenCanvasRenderingContext2D::fill(Path2D&, StringView)
+void OffscreenCanvasRenderingContext2D::fill(Path2D& path, StringView fill_rule)
 {
-    dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::fill(Path2D&, StringView)");
+    fill_internal(path.path(), parse_fill_rule(fill_rule));
 }
 
 // https://html.spec.whatwg.org/multipage/canvas.html#dom-context-2d-createimagedata
@@ -167,9 +224,26 @@ WebIDL::ExceptionOr<void> OffscreenCanvasRenderingContext2D::put_image_data(Imag
     return {};
 }
 
+// https://html.spec.whatwg.org/multipage/canvas.html#reset-the-rendering-context-to-its-default-state
 void OffscreenCanvasRenderingContext2D::reset_to_default_state()
 {
-    dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::reset_to_default_state()");
+    auto* painter = this->painter();
+
+    // 1. Clear canvas's bitmap to transparent black.
+    if (painter)
+        painter->clear_rect(Gfx::FloatRect { {}, canvas_element().bitmap_size_for_canvas().to_type<float>() }, clear_color());
+
+    // 2. Empty the list of subpaths in context's current default path.
+    path().clear();
+
+    // 3. Clear the context's drawing state stack.
+    clear_drawing_state_stack();
+
+    // 4. Reset everything that drawing state consists of to their initial values.
+    reset_drawing_state();
+
+    if (painter)
+        painter->reset();
 }
 
 GC::Ref<TextMetrics> OffscreenCanvasRenderingContext2D::measure_text(Utf16String const&)
@@ -180,14 +254,23 @@ GC::Ref<TextMetrics> OffscreenCanvasRenderingContext2D::measure_text(Utf16String
     return metrics;
 }
 
-void OffscreenCanvasRenderingContext2D::clip(StringView)
+void OffscreenCanvasRenderingContext2D::clip_internal(Gfx::Path& path, Gfx::WindingRule winding_rule)
+{
+    auto* painter = this->painter();
+    if (!painter)
+        return;
+
+    painter->clip(path, winding_rule);
+}
+
+void OffscreenCanvasRenderingContext2D::clip(StringView fill_rule)
 {
-    dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::clip(StringView)");
+    clip_internal(path(), parse_fill_rule(fill_rule));
 }
 
-void OffscreenCanvasRenderingContext2D::clip(Path2D&, StringView)
+void OffscreenCanvasRenderingContext2D::clip(Path2D& path, StringView fill_rule)
 {
-    dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::clip(Path2D&, StringView)");
+    clip_internal(path.path(), parse_fill_rule(fill_rule));
 }
 
 bool OffscreenCanvasRenderingContext2D::is_point_in_path(double, double, StringView)
@@ -332,10 +415,20 @@ void OffscreenCanvasRenderingContext2D::set_global_composite_operation(String)
     dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::set_global_composite_operation()");
 }
 
-[[nodiscard]] Gfx::Painter* OffscreenCanvasRenderingContext2D::painter()
+Gfx::Painter* OffscreenCanvasRenderingContext2D::painter()
 {
-    dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::painter()");
-    return nullptr;
+    // NOTE: transferToImageBitmap() hands the bitmap we were drawing into to the ImageBitmap, and gives the canvas a
+    //       fresh one. Start drawing into that with the current transform.
+    auto bitmap = canvas_element().bitmap();
+    if (bitmap != m_painter_bitmap) {
+        m_painter = nullptr;
+        m_painter_bitmap = bitmap;
+    }
+    if (!m_painter && bitmap) {
+        m_painter = make<Gfx::PainterSkia>(Gfx::PaintingSurface::wrap_bitmap(*bitmap));
+        m_painter->set_transform(drawing_state().transform);
+    }
+    return m_painter.ptr();
 }
 
 }
@@ -135,14 +135,23 @@ private:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
-    virtual Gfx::Painter* painter_for_canvas_state() override
-    {
-        dbgln("(STUBBED) OffscreenCanvasRenderingContext2D::painter_for_canvas_state()");
-        return nullptr;
-    }
+    virtual Gfx::Painter* painter_for_canvas_state() override { return painter(); }
     virtual Gfx::Path& path_for_canvas_state() override { return path(); }
 
+    [[nodiscard]] Gfx::Path rect_path(float x, float y, float width, float height);
+
+    Gfx::Color clear_color() const;
+
+    void stroke_internal(Gfx::Path const&);
+    void fill_internal(Gfx::Path const&, Gfx::WindingRule);
+    void clip_internal(Gfx::Path&, Gfx::WindingRule);
+
     GC::Ref<OffscreenCanvas> m_canvas;
+
+    // The painter draws straight into the canvas's bitmap, and is recreated whenever the canvas replaces that bitmap.
+    RefPtr<Gfx::Bitmap> m_painter_bitmap;
+    OwnPtr<Gfx::Painter> m_painter;
+
     Gfx::IntSize m_size;
     CanvasRenderingContext2DSettings m_context_attributes;
 };
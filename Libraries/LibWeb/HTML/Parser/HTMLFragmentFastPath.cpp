@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Variant.h>
+#include <LibWeb/DOM/Attr.h>
+#include <LibWeb/DOM/Comment.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/ElementFactory.h>
+#include <LibWeb/DOM/Text.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/HTMLFormElement.h>
+#include <LibWeb/HTML/Parser/HTMLFragmentFastPath.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Namespace.h>
+
+namespace Web::HTML {
+
+// NOTE: For these, the parser's "in body" insertion mode closes an open p element before inserting them.
+static bool closes_a_p_element(FlyString const& tag_name)
+{
+    return tag_name.is_one_of(
+        TagNames::address, TagNames::article, TagNames::aside, TagNames::blockquote, TagNames::div, TagNames::footer,
+        TagNames::header, TagNames::main, TagNames::nav, TagNames::ol, TagNames::p, TagNames::section, TagNames::ul,
+        TagNames::li, TagNames::h1, TagNames::h2, TagNames::h3, TagNames::h4, TagNames::h5, TagNames::h6, TagNames::hr);
+}
+
+static bool is_heading(FlyString const& tag_name)
+{
+    return tag_name.is_one_of(TagNames::h1, TagNames::h2, TagNames::h3, TagNames::h4, TagNames::h5, TagNames::h6);
+}
+
+static bool is_supported_void_element(FlyString const& tag_name)
+{
+    return tag_name.is_one_of(TagNames::br, TagNames::hr, TagNames::img, TagNames::input, TagNames::wbr);
+}
+
+// NOTE: As long as their start and end tags are properly nested, the elements here are inserted by the "in body"
+//       insertion mode without touching anything besides the stack of open elements. That is also true for formatting
+//       elements, whose entries in the list of active formatting elements only come into play when they're misnested.
+static bool is_supported_element(FlyString const& tag_name)
+{
+    return closes_a_p_element(tag_name)
+        || is_supported_void_element(tag_name)
+        || tag_name.is_one_of(
+            TagNames::a, TagNames::abbr, TagNames::b, TagNames::bdi, TagNames::cite, TagNames::code, TagNames::data,
+            TagNames::dfn, TagNames::em, TagNames::i, TagNames::kbd, TagNames::label, TagNames::mark, TagNames::q,
+            TagNames::s, TagNames::samp, TagNames::small, TagNames::span, TagNames::strong, TagNames::sub, TagNames::sup,
+            TagNames::time, TagNames::u, TagNames::var);
+}
+
+static bool context_element_is_supported(DOM::Element const& context_element)
+{
+    if (context_element.namespace_uri() != Namespace::HTML)
+        return false;
+
+    // NOTE: These either make the tokenizer start out in a state other than the data state, or make resetting the
+    //       insertion mode appropriately pick an insertion mode other than "in body".
+    return !context_element.local_name().is_one_of(
+        TagNames::title, TagNames::textarea, TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed,
+        TagNames::noframes, TagNames::script, TagNames::noscript, TagNames::plaintext, TagNames::select, TagNames::td,
+        TagNames::th, TagNames::tr, TagNames::tbody, TagNames::thead, TagNames::tfoot, TagNames::caption,
+        TagNames::colgroup, TagNames::table, TagNames::template_, TagNames::head, TagNames::html, TagNames::frameset);
+}
+
+// Start tags, end tags and comments, with the text of each run of character tokens in between collected into a string.
+using FragmentPart = Variant<HTMLToken, Utf16String>;
+
+static Optional<Vector<FragmentPart>> tokenize_simple_fragment(StringView markup, bool has_form_element_pointer)
+{
+    Vector<FragmentPart> parts;
+    Vector<FlyString> open_elements;
+    StringBuilder text_builder { StringBuilder::Mode::UTF16 };
+
+    auto flush_text = [&] {
+        if (text_builder.is_empty())
+            return;
+        parts.append(text_builder.to_utf16_string());
+        text_builder.clear();
+    };
+
+    HTMLTokenizer tokenizer { markup, "utf-8"sv };
+    for (;;) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+
+        if (token->is_character()) {
+            // NOTE: The parser drops U+0000 NULL characters in the "in body" insertion mode.
+            if (token->code_point() == 0)
+                return {};
+            text_builder.append_code_point(token->code_point());
+            continue;
+        }
+
+        flush_text();
+
+        if (token->is_comment()) {
+            parts.append(token.release_value());
+            continue;
+        }
+
+        if (token->is_start_tag()) {
+            auto const& tag_name = token->tag_name();
+            if (!is_supported_element(tag_name) || token->has_attribute(AttributeNames::is))
+                return {};
+
+            // NOTE: These would have to be associated with the form element pointed to by the form element pointer.
+            if (has_form_element_pointer && tag_name.is_one_of(TagNames::img, TagNames::input))
+                return {};
+
+            // NOTE: Each of these cases makes the parser pop or rearrange open elements before inserting the new one.
+            if (closes_a_p_element(tag_name) && open_elements.contains_slow(TagNames::p))
+                return {};
+            if (tag_name == TagNames::li && open_elements.contains_slow(TagNames::li))
+                return {};
+            if (is_heading(tag_name) && !open_elements.is_empty() && is_heading(open_elements.last()))
+                return {};
+            if (tag_name == TagNames::a && open_elements.contains_slow(TagNames::a))
+                return {};
+
+            if (!is_supported_void_element(tag_name))
+                open_elements.append(tag_name);
+            parts.append(token.release_value());
+            continue;
+        }
+
+        if (token->is_end_tag()) {
+            // NOTE: Only end tags that close the current node are handled the same way by all the rules involved.
+            if (open_elements.is_empty() || open_elements.last() != token->tag_name())
+                return {};
+            open_elements.take_last();
+            parts.append(token.release_value());
+            continue;
+        }
+
+        // NOTE: The only tokens left are DOCTYPE tokens, which the parser ignores.
+        return {};
+    }
+    flush_text();
+
+    return parts;
+}
+
+static GC::Ref<DOM::Element> create_element_for(HTMLToken const& token, DOM::Document& document)
+{
+    auto element = MUST(DOM::create_element(document, token.tag_name(), Namespace::HTML));
+
+    // NOTE: This matches what HTMLParser::create_element_for() does for the elements we support.
+    if (token.had_duplicate_attribute())
+        element->set_had_duplicate_attribute_during_tokenization({});
+
+    token.for_each_attribute([&](auto const& attribute) {
+        DOM::QualifiedName qualified_name { attribute.local_name, attribute.prefix, attribute.namespace_ };
+        auto dom_attribute = document.realm().create<DOM::Attr>(document, move(qualified_name), attribute.value, element);
+        element->append_attribute(dom_attribute);
+        return IterationDecision::Continue;
+    });
+
+    return element;
+}
+
+Optional<Vector<GC::Root<DOM::Node>>> try_to_parse_html_fragment_without_a_parser(DOM::Element& context_element, StringView markup)
+{
+    if (!context_element_is_supported(context_element))
+        return {};
+
+    // NOTE: We only create nodes once we know the whole fragment is supported, so that giving up never leaves behind
+    //       elements that have already started doing things like fetching images.
+    auto has_form_element_pointer = context_element.first_ancestor_of_type<HTMLFormElement>() != nullptr;
+    auto parts = tokenize_simple_fragment(markup, has_form_element_pointer);
+    if (!parts.has_value())
+        return {};
+
+    // NOTE: The nodes are created in the context element's node document right away, which is where the HTML fragment
+    //       parsing algorithm would have adopted them into.
+    auto& document = context_element.document();
+    Vector<GC::Root<DOM::Node>> children;
+    Vector<GC::Ref<DOM::Element>> open_elements;
+
+    auto insert = [&](GC::Ref<DOM::Node> node) {
+        if (open_elements.is_empty())
+            children.append(GC::make_root(node));
+        else
+            MUST(open_elements.last()->append_child(node));
+    };
+
+    for (auto& part : *parts) {
+        part.visit(
+            [&](HTMLToken const& token) {
+                if (token.is_comment()) {
+                    insert(document.realm().create<DOM::Comment>(document, Utf16String::from_utf8(token.comment())));
+                    return;
+                }
+                if (token.is_end_tag()) {
+                    open_elements.take_last();
+                    return;
+                }
+                auto element = create_element_for(token, document);
+                insert(element);
+                if (!is_supported_void_element(token.tag_name()))
+                    open_elements.append(element);
+            },
+            [&](Utf16String& text) {
+                insert(document.realm().create<DOM::Text>(document, move(text)));
+            });
+    }
+
+    return children;
+}
+
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibGC/Root.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::HTML {
+
+// Builds the nodes for simple markup directly, without setting up a document and a parser for it. This covers markup
+// whose tree construction boils down to inserting elements, text and comments in the "in body" insertion mode, which
+// is what most markup passed to innerHTML and friends looks like. For anything else, this returns an empty Optional
+// before creating any nodes, and the HTML fragment parsing algorithm has to be run instead.
+Optional<Vector<GC::Root<DOM::Node>>> try_to_parse_html_fragment_without_a_parser(DOM::Element& context_element, StringView markup);
+
+}
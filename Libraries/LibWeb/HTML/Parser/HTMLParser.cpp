@@ -11,6 +11,7 @@
 #include <AK/SourceLocation.h>
 #include <AK/Utf32View.h>
 #include <LibTextCodec/Decoder.h>
+#include <LibThreading/BackgroundAction.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/CSS/StyleValues/LengthStyleValue.h>
@@ -37,8 +38,10 @@
 #include <LibWeb/HTML/HTMLTableElement.h>
 #include <LibWeb/HTML/HTMLTemplateElement.h>
 #include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
+#include <LibWeb/HTML/Parser/HTMLFragmentFastPath.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Parser/HTMLToken.h>
+#include <LibWeb/HTML/Parser/PreloadScanner.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
 #include <LibWeb/HTML/Scripting/SimilarOriginWindowAgent.h>
 #include <LibWeb/HTML/Window.h>
@@ -158,7 +161,12 @@ static bool is_html_integration_point(DOM::Element const& element)
 }
 
 HTMLParser::HTMLParser(DOM::Document& document, StringView input, StringView encoding)
-    : m_tokenizer(input, encoding)
+    : HTMLParser(document, HTMLTokenizer::decode_input(input, encoding), encoding)
+{
+}
+
+HTMLParser::HTMLParser(DOM::Document& document, HTMLTokenizer::DecodedInput decoded_input, StringView encoding)
+    : m_tokenizer(move(decoded_input))
     , m_scripting_enabled(document.is_scripting_enabled())
     , m_document(document)
 {
@@ -203,11 +211,63 @@ void HTMLParser::initialize(JS::Realm& realm)
 #endif
 }
 
+bool HTMLParser::should_yield_to_the_event_loop()
+{
+    if (++m_tokens_since_yield_check < tokens_between_yield_checks)
+        return false;
+    m_tokens_since_yield_check = 0;
+
+    // NOTE: We can only yield when no script is running, which also rules out document.write() and document.close().
+    //       The task we queue to resume parsing can only run while the document is fully active.
+    if (m_parsing_fragment || m_script_nesting_level > 0 || !vm().execution_context_stack().is_empty())
+        return false;
+    if (!m_document->browsing_context() || !m_document->is_fully_active())
+        return false;
+
+    return MonotonicTime::now_coarse() >= m_next_yield_time;
+}
+
+void HTMLParser::yield_to_the_event_loop()
+{
+    flush_character_insertions();
+
+    if (m_yield_count++ == 0)
+        dbgln_if(HTML_PARSER_DEBUG, "Yielding to the event loop for the first time after {}ms of parsing", (MonotonicTime::now_coarse() - *m_parse_start_time).to_milliseconds());
+
+    // NOTE: The rendering update is queued before the task that resumes parsing, so it runs first.
+    auto& event_loop = main_thread_event_loop();
+    event_loop.queue_task_to_update_the_rendering();
+
+    bool can_resume = false;
+    queue_global_task(Task::Source::DOMManipulation, *m_document, GC::create_function(heap(), [&can_resume] {
+        can_resume = true;
+    }));
+    event_loop.spin_until(GC::create_function(heap(), [&can_resume] {
+        return can_resume;
+    }));
+
+    m_time_between_yields = min(m_time_between_yields + m_time_between_yields, maximum_time_between_yields);
+    m_next_yield_time = MonotonicTime::now_coarse() + m_time_between_yields;
+}
+
 void HTMLParser::run(HTMLTokenizer::StopAtInsertionPoint stop_at_insertion_point)
 {
     m_stop_parsing = false;
 
+    if (!m_parse_start_time.has_value()) {
+        m_parse_start_time = MonotonicTime::now_coarse();
+        m_next_yield_time = *m_parse_start_time + m_time_between_yields;
+    }
+
     for (;;) {
+        if (stop_at_insertion_point == HTMLTokenizer::StopAtInsertionPoint::No && should_yield_to_the_event_loop()) {
+            yield_to_the_event_loop();
+
+            // NOTE: Script may have aborted us while we weren't looking, e.g. by calling document.open().
+            if (m_aborted)
+                break;
+        }
+
         auto optional_token = m_tokenizer.next_token(stop_at_insertion_point);
         if (!optional_token.has_value())
             break;
@@ -3308,7 +3368,14 @@ void HTMLParser::handle_text(HTMLToken& token)
                     // 2. Set the pending parsing-blocking script to null.
                     auto the_script = document().take_pending_parsing_blocking_script({});
 
-                    // FIXME: 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: Instead of a speculative parser, we run a preload scanner over the rest of the input, and
+                    //       only if we're actually about to wait for something below.
+                    bool will_wait = m_document->has_a_style_sheet_that_is_blocking_scripts() || !the_script->is_ready_to_be_parser_executed();
+                    if (will_wait && !m_has_run_preload_scanner) {
+                        m_has_run_preload_scanner = true;
+                        PreloadScanner { *m_document }.scan(m_tokenizer.unparsed_input());
+                    }
 
                     // 4. Block the tokenizer for this instance of the HTML parser, such that the event loop will not run tasks that invoke the tokenizer.
                     m_tokenizer.set_blocked(true);
@@ -3327,7 +3394,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     if (m_aborted)
                         return;
 
-                    // FIXME: 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: The preload scanner has already run to completion.
 
                     // 8. Unblock the tokenizer for this instance of the HTML parser, such that tasks that invoke the tokenizer can again be run.
                     m_tokenizer.set_blocked(false);
@@ -5013,6 +5081,10 @@ DOM::Document& HTMLParser::document()
 // https://html.spec.whatwg.org/multipage/parsing.html#parsing-html-fragments
 WebIDL::ExceptionOr<Vector<GC::Root<DOM::Node>>> HTMLParser::parse_html_fragment(DOM::Element& context_element, StringView markup, AllowDeclarativeShadowRoots allow_declarative_shadow_roots)
 {
+    // AD-HOC: Most fragments are simple enough to build their nodes without a document and parser of their own.
+    if (auto children = try_to_parse_html_fragment_without_a_parser(context_element, markup); children.has_value())
+        return children.release_value();
+
     // 1. Let document be a Document node whose type is "html".
     auto temp_document = DOM::Document::create_for_fragment_parsing(context_element.realm());
     temp_document->set_document_type(DOM::Document::Type::HTML);
@@ -5128,6 +5200,29 @@ GC::Ref<HTMLParser> HTMLParser::create_with_uncertain_encoding(DOM::Document& do
     return document.realm().create<HTMLParser>(document, input, encoding);
 }
 
+// NOTE: Below this size, decoding is quick enough that handing it off to another thread would only add latency.
+static constexpr size_t minimum_input_size_for_decoding_in_the_background = 256 * KiB;
+
+void HTMLParser::create_with_uncertain_encoding_in_the_background(DOM::Document& document, ByteBuffer input, Optional<MimeSniff::MimeType> maybe_mime_type, GC::Ref<GC::Function<void(GC::Ref<HTMLParser>)>> on_created)
+{
+    if (input.size() < minimum_input_size_for_decoding_in_the_background) {
+        on_created->function()(create_with_uncertain_encoding(document, input, move(maybe_mime_type)));
+        return;
+    }
+
+    auto encoding = document.has_encoding() ? document.encoding()->to_byte_string() : run_encoding_sniffing_algorithm(document, input, maybe_mime_type);
+    dbgln_if(HTML_PARSER_DEBUG, "Decoding {} bytes of input as '{}' in the background", input.size(), encoding);
+
+    (void)Threading::BackgroundAction<HTMLTokenizer::DecodedInput>::construct(
+        [input = move(input), encoding](auto&) -> ErrorOr<HTMLTokenizer::DecodedInput> {
+            return HTMLTokenizer::decode_input(input, encoding);
+        },
+        [document = GC::make_root(document), encoding, on_created = GC::make_root(on_created)](HTMLTokenizer::DecodedInput decoded_input) -> ErrorOr<void> {
+            on_created->function()(document->realm().create<HTMLParser>(*document, move(decoded_input), encoding));
+            return {};
+        });
+}
+
 GC::Ref<HTMLParser> HTMLParser::create(DOM::Document& document, StringView input, StringView encoding)
 {
     return document.realm().create<HTMLParser>(document, input, encoding);
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Time.h>
+#include <LibGC/Function.h>
 #include <LibGfx/Color.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibWeb/DOM/Node.h>
@@ -63,6 +65,9 @@ public:
 
     static GC::Ref<HTMLParser> create_for_scripting(DOM::Document&);
     static GC::Ref<HTMLParser> create_with_uncertain_encoding(DOM::Document&, ByteBuffer const& input, Optional<MimeSniff::MimeType> maybe_mime_type = {});
+    // Like create_with_uncertain_encoding(), but large inputs are decoded on a background thread, so that the event loop
+    // keeps going in the meantime. The callback is invoked with the parser once it has been created.
+    static void create_with_uncertain_encoding_in_the_background(DOM::Document&, ByteBuffer input, Optional<MimeSniff::MimeType>, GC::Ref<GC::Function<void(GC::Ref<HTMLParser>)>> on_created);
     static GC::Ref<HTMLParser> create(DOM::Document&, StringView input, StringView encoding);
 
     void run(HTMLTokenizer::StopAtInsertionPoint = HTMLTokenizer::StopAtInsertionPoint::No);
@@ -105,6 +110,7 @@ public:
 
 private:
     HTMLParser(DOM::Document&, StringView input, StringView encoding);
+    HTMLParser(DOM::Document&, HTMLTokenizer::DecodedInput, StringView encoding);
     HTMLParser(DOM::Document&);
 
     virtual void visit_edges(Cell::Visitor&) override;
@@ -216,6 +222,23 @@ private:
     bool m_stop_parsing { false };
     size_t m_script_nesting_level { 0 };
 
+    // NOTE: The whole input is available up front, so the preload scanner only needs to run once.
+    bool m_has_run_preload_scanner { false };
+
+    // NOTE: While parsing a document in a browsing context, we periodically yield to the event loop so that it gets to
+    //       render what we've parsed so far. The time between yields starts out short for a quick first paint, and
+    //       grows with each yield so that long documents don't spend most of their time rendering partial trees.
+    bool should_yield_to_the_event_loop();
+    void yield_to_the_event_loop();
+    Optional<MonotonicTime> m_parse_start_time;
+    MonotonicTime m_next_yield_time { MonotonicTime::now_coarse() };
+    AK::Duration m_time_between_yields { initial_time_between_yields };
+    size_t m_tokens_since_yield_check { 0 };
+    size_t m_yield_count { 0 };
+    static constexpr AK::Duration initial_time_between_yields = AK::Duration::from_milliseconds(8);
+    static constexpr AK::Duration maximum_time_between_yields = AK::Duration::from_milliseconds(256);
+    static constexpr size_t tokens_between_yield_checks = 256;
+
     JS::Realm& realm();
 
     GC::Ptr<DOM::Document> m_document;
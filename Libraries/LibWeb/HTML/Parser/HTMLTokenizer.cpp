@@ -5,9 +5,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/GenericShorthands.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/SourceLocation.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/HTML/Parser/Entities.h>
@@ -165,6 +168,18 @@ namespace Web::HTML {
 #define EMIT_CURRENT_CHARACTER \
     EMIT_CHARACTER(current_input_character.value());
 
+// NOTE: This also queues up character tokens for the code points after the current input character for which the
+//       predicate holds, so the state doesn't have to come back around for every code point of a run of plain text.
+#define EMIT_CURRENT_CHARACTER_AND_THE_REST_OF_ITS_RUN(predicate)                                                \
+    do {                                                                                                         \
+        create_new_token(HTMLToken::Type::Character);                                                            \
+        m_current_token.set_code_point(current_input_character.value());                                         \
+        m_queued_tokens.enqueue(move(m_current_token));                                                          \
+        auto position_before_run = nth_last_position(0);                                                         \
+        queue_character_tokens(consume_code_point_run(stop_at_insertion_point, predicate), position_before_run); \
+        return m_queued_tokens.dequeue();                                                                        \
+    } while (0)
+
 #define SWITCH_TO_AND_EMIT_CHARACTER(code_point, new_state) \
     do {                                                    \
         will_switch_to(State::new_state);                   \
@@ -193,6 +208,69 @@ static inline void log_parse_error(SourceLocation const& location = SourceLocati
     dbgln_if(TOKENIZER_TRACE_DEBUG, "Parse error (tokenization) {}", location);
 }
 
+// Returns the length of the run of code points at the start of the given code points for which the predicate holds. The
+// predicate is applied to 4 code points at a time, and must return a vector with all bits set in lanes where it holds.
+template<typename Predicate>
+static size_t length_of_code_point_run(ReadonlySpan<u32> code_points, Predicate predicate)
+{
+    using AK::SIMD::u32x4;
+    using AK::SIMD::u64x2;
+
+    size_t offset = 0;
+    for (; offset + 4 <= code_points.size(); offset += 4) {
+        auto chunk = AK::SIMD::load_unaligned<u32x4>(code_points.offset_pointer(offset));
+        auto mask = bit_cast<u64x2>(predicate(chunk));
+        if ((mask[0] & mask[1]) == NumericLimits<u64>::max())
+            continue;
+        // Find the first lane where the predicate failed.
+        for (size_t lane = 0; lane < 2; ++lane) {
+            if (mask[lane] != NumericLimits<u64>::max())
+                return offset + lane * 2 + (count_trailing_zeroes(~mask[lane]) / 32);
+        }
+    }
+
+    // Do the remaining code points one at a time, using a vector with just one code point in it.
+    for (; offset < code_points.size(); ++offset) {
+        u32x4 chunk {};
+        chunk[0] = code_points[offset];
+        if (predicate(chunk)[0] == 0)
+            return offset;
+    }
+    return offset;
+}
+
+// NOTE: Each of these matches the code points that the corresponding states treat as "anything else". U+000D CR is
+//       excluded as well, since next_code_point() has to normalize it into a newline.
+static ALWAYS_INLINE auto is_plain_data_code_point(AK::SIMD::u32x4 chunk)
+{
+    return (chunk != '<') & (chunk != '&') & (chunk != 0) & (chunk != '\r');
+}
+
+static ALWAYS_INLINE auto is_plain_double_quoted_attribute_value_code_point(AK::SIMD::u32x4 chunk)
+{
+    return (chunk != '"') & (chunk != '&') & (chunk != 0) & (chunk != '\r');
+}
+
+static ALWAYS_INLINE auto is_plain_single_quoted_attribute_value_code_point(AK::SIMD::u32x4 chunk)
+{
+    return (chunk != '\'') & (chunk != '&') & (chunk != 0) & (chunk != '\r');
+}
+
+static ALWAYS_INLINE auto is_plain_comment_code_point(AK::SIMD::u32x4 chunk)
+{
+    return (chunk != '<') & (chunk != '-') & (chunk != 0) & (chunk != '\r');
+}
+
+static void advance_position(HTMLToken::Position& position, u32 code_point)
+{
+    if (code_point == '\n') {
+        position.column = 0;
+        position.line++;
+    } else {
+        position.column++;
+    }
+}
+
 Optional<u32> HTMLTokenizer::next_code_point(StopAtInsertionPoint stop_at_insertion_point)
 {
     if (m_current_offset >= static_cast<ssize_t>(m_decoded_input.size()))
@@ -225,18 +303,47 @@ void HTMLTokenizer::skip(size_t count)
     for (size_t i = 0; i < count; ++i) {
         m_prev_offset = m_current_offset;
         auto code_point = m_decoded_input[m_current_offset];
-        if (!m_source_positions.is_empty()) {
-            if (code_point == '\n') {
-                m_source_positions.last().column = 0;
-                m_source_positions.last().line++;
-            } else {
-                m_source_positions.last().column++;
-            }
-        }
+        if (!m_source_positions.is_empty())
+            advance_position(m_source_positions.last(), code_point);
         ++m_current_offset;
     }
 }
 
+template<typename Predicate>
+ReadonlySpan<u32> HTMLTokenizer::consume_code_point_run(StopAtInsertionPoint stop_at_insertion_point, Predicate predicate)
+{
+    auto end = static_cast<ssize_t>(m_decoded_input.size());
+    if (stop_at_insertion_point == StopAtInsertionPoint::Yes && m_insertion_point.has_value())
+        end = min(end, *m_insertion_point);
+    if (m_current_offset >= end)
+        return {};
+
+    auto remaining_input = m_decoded_input.span().slice(m_current_offset, end - m_current_offset);
+    auto run = remaining_input.trim(length_of_code_point_run(remaining_input, predicate));
+    if (run.is_empty())
+        return {};
+
+    // NOTE: Like skip(), this adds a single source position for everything it consumes.
+    if (!m_source_positions.is_empty()) {
+        m_source_positions.append(m_source_positions.last());
+        for (auto code_point : run)
+            advance_position(m_source_positions.last(), code_point);
+    }
+    m_current_offset += run.size();
+    m_prev_offset = m_current_offset - 1;
+    return run;
+}
+
+void HTMLTokenizer::queue_character_tokens(ReadonlySpan<u32> code_points, HTMLToken::Position position)
+{
+    for (auto code_point : code_points) {
+        advance_position(position, code_point);
+        auto token = HTMLToken::make_character(code_point);
+        token.set_start_position({}, position);
+        m_queued_tokens.enqueue(move(token));
+    }
+}
+
 Optional<u32> HTMLTokenizer::peek_code_point(ssize_t offset, StopAtInsertionPoint stop_at_insertion_point) const
 {
     auto it = m_current_offset + offset;
@@ -302,7 +409,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_THE_REST_OF_ITS_RUN(is_plain_data_code_point);
                 }
             }
             END_STATE
@@ -1315,6 +1422,8 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    for (auto code_point : consume_code_point_run(stop_at_insertion_point, is_plain_double_quoted_attribute_value_code_point))
+                        m_current_builder.append_code_point(code_point);
                     continue;
                 }
             }
@@ -1347,6 +1456,8 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    for (auto code_point : consume_code_point_run(stop_at_insertion_point, is_plain_single_quoted_attribute_value_code_point))
+                        m_current_builder.append_code_point(code_point);
                     continue;
                 }
             }
@@ -1517,6 +1628,8 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    for (auto code_point : consume_code_point_run(stop_at_insertion_point, is_plain_comment_code_point))
+                        m_current_builder.append_code_point(code_point);
                     continue;
                 }
             }
@@ -1989,7 +2102,7 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    EMIT_CURRENT_CHARACTER_AND_THE_REST_OF_ITS_RUN(is_plain_data_code_point);
                 }
             }
             END_STATE
@@ -2882,14 +2995,28 @@ HTMLTokenizer::HTMLTokenizer()
     m_source_positions.empend(0u, 0u);
 }
 
-HTMLTokenizer::HTMLTokenizer(StringView input, ByteString const& encoding)
+HTMLTokenizer::DecodedInput HTMLTokenizer::decode_input(StringView input, StringView encoding)
 {
     auto decoder = TextCodec::decoder_for(encoding);
     VERIFY(decoder.has_value());
-    m_source = MUST(decoder->to_utf8(input));
-    m_decoded_input.ensure_capacity(m_source.bytes().size());
-    for (auto code_point : m_source.code_points())
-        m_decoded_input.append(code_point);
+
+    DecodedInput decoded_input;
+    decoded_input.source = MUST(decoder->to_utf8(input));
+    decoded_input.code_points.ensure_capacity(decoded_input.source.bytes().size());
+    for (auto code_point : decoded_input.source.code_points())
+        decoded_input.code_points.append(code_point);
+    return decoded_input;
+}
+
+HTMLTokenizer::HTMLTokenizer(StringView input, ByteString const& encoding)
+    : HTMLTokenizer(decode_input(input, encoding))
+{
+}
+
+HTMLTokenizer::HTMLTokenizer(DecodedInput decoded_input)
+{
+    m_source = move(decoded_input.source);
+    m_decoded_input = move(decoded_input.code_points);
     m_current_offset = 0;
     m_prev_offset = 0;
     m_source_positions.empend(0u, 0u);
@@ -2909,6 +3036,14 @@ void HTMLTokenizer::parser_did_run(Badge<HTMLParser>)
     }
 }
 
+String HTMLTokenizer::unparsed_input() const
+{
+    StringBuilder builder;
+    for (auto i = static_cast<size_t>(m_current_offset); i < m_decoded_input.size(); ++i)
+        builder.append_code_point(m_decoded_input[i]);
+    return builder.to_string_without_validation();
+}
+
 void HTMLTokenizer::insert_input_at_insertion_point(StringView input)
 {
     Vector<u32> new_decoded_input;
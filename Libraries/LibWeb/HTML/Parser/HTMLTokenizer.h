@@ -103,8 +103,16 @@ namespace Web::HTML {
 
 class WEB_API HTMLTokenizer {
 public:
+    // The input of a tokenizer, decoded up front. Decoding only looks at the bytes it's given, so it can happen on any thread.
+    struct DecodedInput {
+        String source;
+        Vector<u32> code_points;
+    };
+    static DecodedInput decode_input(StringView input, StringView encoding);
+
     explicit HTMLTokenizer();
     explicit HTMLTokenizer(StringView input, ByteString const& encoding);
+    explicit HTMLTokenizer(DecodedInput);
 
     enum class State {
 #define __ENUMERATE_TOKENIZER_STATE(state) state,
@@ -131,6 +139,9 @@ public:
 
     auto const& source() const { return m_source; }
 
+    // Returns the part of the input stream that hasn't been tokenized yet.
+    String unparsed_input() const;
+
     void insert_input_at_insertion_point(StringView input);
     void insert_eof();
     bool is_eof_inserted();
@@ -152,6 +163,11 @@ private:
     Optional<u32> next_code_point(StopAtInsertionPoint);
     Optional<u32> peek_code_point(ssize_t offset, StopAtInsertionPoint) const;
 
+    // Consumes the code points after the current input character for as long as the predicate holds for them, all at once.
+    template<typename Predicate>
+    ReadonlySpan<u32> consume_code_point_run(StopAtInsertionPoint, Predicate);
+    void queue_character_tokens(ReadonlySpan<u32>, HTMLToken::Position position_before);
+
     enum class ConsumeNextResult {
         Consumed,
         NotConsumed,
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOMURL/DOMURL.h>
+#include <LibWeb/Fetch/Infrastructure/URL.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/HTMLBaseElement.h>
+#include <LibWeb/HTML/MapOfPreloadedResources.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/HTML/Parser/PreloadScanner.h>
+#include <LibWeb/HTML/PotentialCORSRequest.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/Loader/ResourceLoader.h>
+#include <LibWeb/MimeSniff/MimeType.h>
+
+namespace Web::HTML {
+
+PreloadScanner::PreloadScanner(DOM::Document& document)
+    : m_document(document)
+    , m_base_url(document.base_url())
+    , m_has_seen_base_element_with_href(document.first_base_element_with_href_in_tree_order())
+{
+}
+
+void PreloadScanner::scan(StringView input)
+{
+    HTMLTokenizer tokenizer { input, "utf-8" };
+    for (;;) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+        if (!token->is_start_tag())
+            continue;
+
+        process_start_tag(*token);
+
+        // NOTE: Without a tree builder, nothing switches the tokenizer into the states for elements with special
+        //       contents. We do that here, so that markup inside of scripts and the like isn't mistaken for tags.
+        auto const& tag_name = token->tag_name();
+        if (tag_name == TagNames::script)
+            tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+        else if (tag_name.is_one_of(TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed, TagNames::noframes))
+            tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+        else if (tag_name == TagNames::noscript && m_document->is_scripting_enabled())
+            tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+        else if (tag_name.is_one_of(TagNames::textarea, TagNames::title))
+            tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+        else if (tag_name == TagNames::plaintext)
+            break;
+    }
+}
+
+void PreloadScanner::process_start_tag(HTMLToken const& token)
+{
+    auto const& tag_name = token.tag_name();
+
+    if (tag_name == TagNames::base) {
+        // NOTE: Only the first base element with an href attribute determines the document base URL.
+        auto href = token.attribute(AttributeNames::href);
+        if (!href.has_value() || m_has_seen_base_element_with_href)
+            return;
+        m_has_seen_base_element_with_href = true;
+        if (auto url = DOMURL::parse(*href, m_document->fallback_base_url()); url.has_value())
+            m_base_url = url.release_value();
+        return;
+    }
+
+    auto cors_setting = cors_setting_attribute_from_keyword(token.attribute(AttributeNames::crossorigin));
+
+    if (tag_name == TagNames::script) {
+        // NOTE: Module scripts are fetched with different request settings, so only classic scripts are preloaded.
+        auto src = token.attribute(AttributeNames::src);
+        if (!src.has_value() || src->is_empty() || token.attribute(AttributeNames::nomodule).has_value())
+            return;
+        if (auto type = token.attribute(AttributeNames::type); type.has_value() && !type->is_empty()) {
+            auto trimmed_type = MUST(type->trim(Infra::ASCII_WHITESPACE));
+            if (!MimeSniff::is_javascript_mime_type_essence_match(trimmed_type))
+                return;
+        }
+        preload(*src, Fetch::Infrastructure::Request::Destination::Script, cors_setting, token.attribute(AttributeNames::integrity), Fetch::Infrastructure::Request::InitiatorType::Script);
+        return;
+    }
+
+    if (tag_name == TagNames::link) {
+        auto href = token.attribute(AttributeNames::href);
+        if (!href.has_value() || href->is_empty())
+            return;
+        auto rel = token.attribute(AttributeNames::rel).value_or(String {}).to_ascii_lowercase();
+        auto link_types = rel.bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace);
+        if (link_types.contains_slow("preconnect"sv)) {
+            warm_up_connection(*href, ConnectionWarmup::Preconnect);
+            return;
+        }
+        if (link_types.contains_slow("dns-prefetch"sv)) {
+            warm_up_connection(*href, ConnectionWarmup::ResolveOnly);
+            return;
+        }
+        if (!link_types.contains_slow("stylesheet"sv) || link_types.contains_slow("alternate"sv) || token.attribute(AttributeNames::disabled).has_value())
+            return;
+        preload(*href, Fetch::Infrastructure::Request::Destination::Style, cors_setting, token.attribute(AttributeNames::integrity), Fetch::Infrastructure::Request::InitiatorType::CSS);
+        return;
+    }
+
+    if (tag_name == TagNames::img) {
+        // NOTE: Which srcset candidate gets used depends on layout, so we leave images with a srcset alone.
+        auto src = token.attribute(AttributeNames::src);
+        if (!src.has_value() || src->is_empty() || token.attribute(AttributeNames::srcset).has_value())
+            return;
+        if (auto loading = token.attribute(AttributeNames::loading); loading.has_value() && loading->equals_ignoring_ascii_case("lazy"sv))
+            return;
+        preload(*src, Fetch::Infrastructure::Request::Destination::Image, cors_setting, {}, Fetch::Infrastructure::Request::InitiatorType::IMG);
+        return;
+    }
+}
+
+void PreloadScanner::warm_up_connection(StringView url_string, ConnectionWarmup warmup)
+{
+    auto url = DOMURL::parse(url_string, m_base_url, m_document->encoding_or_default());
+    if (!url.has_value() || !Fetch::Infrastructure::is_http_or_https_scheme(url->scheme()))
+        return;
+
+    // NOTE: The link element does the same once the parser gets to it. RequestServer ignores the repeated hint.
+    if (warmup == ConnectionWarmup::Preconnect)
+        ResourceLoader::the().preconnect(*url);
+    else
+        ResourceLoader::the().prefetch_dns(*url);
+}
+
+void PreloadScanner::preload(StringView url_string, Optional<Fetch::Infrastructure::Request::Destination> destination, CORSSettingAttribute cors_setting, Optional<String> integrity_metadata, Fetch::Infrastructure::Request::InitiatorType initiator_type)
+{
+    auto url = DOMURL::parse(url_string, m_base_url, m_document->encoding_or_default());
+    if (!url.has_value() || !Fetch::Infrastructure::is_http_or_https_scheme(url->scheme()))
+        return;
+
+    // NOTE: These requests are set up like the ones made by the elements, so that their preload keys match.
+    auto request = create_potential_CORS_request(m_document->realm().vm(), *url, destination, cors_setting);
+    request->set_client(&m_document->relevant_settings_object());
+    request->set_initiator_type(initiator_type);
+    if (integrity_metadata.has_value())
+        request->set_integrity_metadata(integrity_metadata.release_value());
+
+    MapOfPreloadedResources::Key key { request->url(), request->destination(), request->mode(), request->credentials_mode() };
+    if (m_document->map_of_preloaded_resources().contains(key))
+        return;
+
+    HTML::preload(m_document, request);
+}
+
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibGC/Ptr.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/HTML/CORSSettingAttribute.h>
+#include <LibWeb/HTML/Parser/HTMLToken.h>
+
+namespace Web::HTML {
+
+// Tokenizes the input that a parser blocked on a script hasn't reached yet, and preloads the scripts, style sheets
+// and images it finds. Once the parser gets to their elements, their fetches pick up the preloaded responses
+// from the document's map of preloaded resources instead of going to the network again. Connections for preconnect
+// and dns-prefetch hints are warmed up as well.
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+class PreloadScanner {
+public:
+    explicit PreloadScanner(DOM::Document&);
+
+    void scan(StringView input);
+
+private:
+    void process_start_tag(HTMLToken const&);
+
+    enum class ConnectionWarmup {
+        ResolveOnly,
+        Preconnect,
+    };
+    void warm_up_connection(StringView url_string, ConnectionWarmup);
+    void preload(StringView url_string, Optional<Fetch::Infrastructure::Request::Destination>, CORSSettingAttribute, Optional<String> integrity_metadata, Fetch::Infrastructure::Request::InitiatorType);
+
+    GC::Ref<DOM::Document> m_document;
+    URL::URL m_base_url;
+    bool m_has_seen_base_element_with_href { false };
+};
+
+}
@@ -5,13 +5,22 @@
  */
 
 #include <LibCore/EventLoop.h>
+#include <LibCore/System.h>
+#include <LibCore/Trace.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/PaintingSurface.h>
 #include <LibThreading/Thread.h>
 #include <LibWeb/HTML/RenderingThread.h>
 #include <LibWeb/HTML/TraversableNavigable.h>
 #include <LibWeb/Painting/DisplayListPlayerSkia.h>
 
+#include <core/SkCanvas.h>
+
 namespace Web::HTML {
 
+static constexpr int minimum_band_height = 256;
+static constexpr size_t maximum_band_count = 8;
+
 RenderingThread::RenderingThread()
     : m_main_thread_event_loop(Core::EventLoop::current())
     , m_main_thread_exit_promise(Core::Promise<NonnullRefPtr<Core::EventReceiver>>::construct())
@@ -32,6 +41,14 @@ RenderingThread::~RenderingThread()
     if (m_thread) {
         (void)m_thread->join();
     }
+
+    {
+        Threading::MutexLocker const locker { m_band_job_mutex };
+        m_exit_band_workers = true;
+        m_band_job_ready_wake_condition.broadcast();
+    }
+    for (auto& worker : m_band_workers)
+        (void)worker->join();
 }
 
 void RenderingThread::start(DisplayListPlayerType display_list_player_type)
@@ -68,17 +85,121 @@ void RenderingThread::rendering_thread_loop()
             break;
         }
 
-        m_skia_player->execute(*task->display_list, move(task->scroll_state_snapshot_by_display_list), task->painting_surface);
+        if (Core::Trace::is_enabled())
+            Core::Trace::add_span("Rendering queue wait"sv, task->enqueue_time, MonotonicTime::now());
+
+        auto* bitmap = task->painting_surface->bitmap();
+        auto band_count = bitmap ? min(static_cast<size_t>(bitmap->height() / minimum_band_height), maximum_band_count) : 0;
+        {
+            Core::TraceScope trace_scope("Playback"sv);
+            if (band_count > 1 && can_rasterize_in_bands(*task)) {
+                if (trace_scope.is_enabled())
+                    trace_scope.arguments().set("bands"sv, band_count);
+                rasterize_in_bands(*task, *bitmap, band_count);
+            } else {
+                m_skia_player->execute(*task->display_list, move(task->scroll_state_snapshot_by_display_list), task->painting_surface, task->damage_rect);
+            }
+        }
         if (m_exit)
             break;
         task->callback();
     }
 }
 
-void RenderingThread::enqueue_rendering_task(NonnullRefPtr<Painting::DisplayList> display_list, Painting::ScrollStateSnapshotByDisplayList&& scroll_state_snapshot_by_display_list, NonnullRefPtr<Gfx::PaintingSurface> painting_surface, Function<void()>&& callback)
+bool RenderingThread::can_rasterize_in_bands(Task const& task) const
+{
+    // Commands that sample pixels painted by others would see seams at the edges of a band, and painting surfaces
+    // (canvases, nested navigables) can't be read from multiple threads at once.
+    for (auto const& item : task.display_list->commands()) {
+        auto const& command = item.command;
+        if (command.has<Painting::ApplyBackdropFilter>() || command.has<Painting::ApplyFilter>()
+            || command.has<Painting::DrawPaintingSurface>() || command.has<Painting::PaintNestedDisplayList>())
+            return false;
+    }
+    return true;
+}
+
+void RenderingThread::rasterize_in_bands(Task& task, Gfx::Bitmap& bitmap, size_t band_count)
+{
+    while (m_band_players.size() < band_count)
+        m_band_players.append(make<Painting::DisplayListPlayerSkia>());
+
+    auto worker_count = min(band_count - 1, static_cast<size_t>(max(Core::System::hardware_concurrency(), 2u) - 1));
+    while (m_band_workers.size() < worker_count) {
+        auto worker = Threading::Thread::construct([this] {
+            band_worker_loop();
+            return static_cast<intptr_t>(0);
+        },
+            "RasterBand"sv);
+        worker->start();
+        m_band_workers.append(move(worker));
+    }
+
+    // NOTE: Each band gets its own copy of the scroll state snapshots, made here before any of the bands are started.
+    Vector<Painting::ScrollStateSnapshotByDisplayList> scroll_state_snapshots;
+    scroll_state_snapshots.ensure_capacity(band_count);
+    for (size_t i = 0; i < band_count; ++i)
+        scroll_state_snapshots.unchecked_append(task.scroll_state_snapshot_by_display_list);
+
+    auto band_height = ceil_div(bitmap.height(), static_cast<int>(band_count));
+    auto rasterize_band = [&](size_t band_index) {
+        auto top = static_cast<int>(band_index) * band_height;
+        auto height = min(band_height, bitmap.height() - top);
+        if (task.damage_rect.has_value() && !task.damage_rect->intersects({ 0, top, bitmap.width(), height }))
+            return;
+
+        // The band's surface paints directly into its rows of the bitmap.
+        auto band_bitmap = MUST(Gfx::Bitmap::create_wrapper(bitmap.format(), bitmap.alpha_type(), { bitmap.width(), height }, bitmap.pitch(), bitmap.scanline_u8(top)));
+        auto band_surface = Gfx::PaintingSurface::wrap_bitmap(*band_bitmap);
+        band_surface->canvas().translate(0, -top);
+        m_band_players[band_index]->execute(*task.display_list, move(scroll_state_snapshots[band_index]), band_surface, task.damage_rect);
+    };
+
+    {
+        Threading::MutexLocker const locker { m_band_job_mutex };
+        for (size_t band_index = 1; band_index < band_count; ++band_index)
+            m_band_jobs.enqueue([&rasterize_band, band_index] { rasterize_band(band_index); });
+        m_unfinished_band_jobs = band_count - 1;
+        m_band_job_ready_wake_condition.broadcast();
+    }
+
+    rasterize_band(0);
+
+    {
+        Threading::MutexLocker const locker { m_band_job_mutex };
+        while (m_unfinished_band_jobs > 0)
+            m_band_jobs_finished_condition.wait();
+    }
+
+    Core::TraceScope trace_scope("Flush"sv);
+    task.painting_surface->flush();
+}
+
+void RenderingThread::band_worker_loop()
+{
+    while (true) {
+        Function<void()> job;
+        {
+            Threading::MutexLocker const locker { m_band_job_mutex };
+            while (m_band_jobs.is_empty() && !m_exit_band_workers)
+                m_band_job_ready_wake_condition.wait();
+            if (m_exit_band_workers)
+                return;
+            job = m_band_jobs.dequeue();
+        }
+
+        job();
+
+        Threading::MutexLocker const locker { m_band_job_mutex };
+        if (--m_unfinished_band_jobs == 0)
+            m_band_jobs_finished_condition.signal();
+    }
+}
+
+void RenderingThread::enqueue_rendering_task(NonnullRefPtr<Painting::DisplayList> display_list, Painting::ScrollStateSnapshotByDisplayList&& scroll_state_snapshot_by_display_list, NonnullRefPtr<Gfx::PaintingSurface> painting_surface, Optional<Gfx::IntRect> damage_rect, Function<void()>&& callback)
 {
     Threading::MutexLocker const locker { m_rendering_task_mutex };
-    m_rendering_tasks.enqueue(Task { move(display_list), move(scroll_state_snapshot_by_display_list), move(painting_surface), move(callback) });
+    m_rendering_tasks.enqueue(Task { move(display_list), move(scroll_state_snapshot_by_display_list), move(painting_surface), damage_rect, move(callback), MonotonicTime::now() });
     m_rendering_task_ready_wake_condition.signal();
 }
 
@@ -27,11 +27,16 @@ public:
 
     void start(DisplayListPlayerType);
     void set_skia_player(OwnPtr<Painting::DisplayListPlayerSkia>&& player);
-    void enqueue_rendering_task(NonnullRefPtr<Painting::DisplayList>, Painting::ScrollStateSnapshotByDisplayList&&, NonnullRefPtr<Gfx::PaintingSurface>, Function<void()>&& callback);
+    void enqueue_rendering_task(NonnullRefPtr<Painting::DisplayList>, Painting::ScrollStateSnapshotByDisplayList&&, NonnullRefPtr<Gfx::PaintingSurface>, Optional<Gfx::IntRect> damage_rect, Function<void()>&& callback);
 
 private:
     void rendering_thread_loop();
 
+    struct Task;
+    bool can_rasterize_in_bands(Task const&) const;
+    void rasterize_in_bands(Task&, Gfx::Bitmap&, size_t band_count);
+    void band_worker_loop();
+
     Core::EventLoop& m_main_thread_event_loop;
     DisplayListPlayerType m_display_list_player_type;
 
@@ -45,13 +50,26 @@ private:
         NonnullRefPtr<Painting::DisplayList> display_list;
         Painting::ScrollStateSnapshotByDisplayList scroll_state_snapshot_by_display_list;
         NonnullRefPtr<Gfx::PaintingSurface> painting_surface;
+        Optional<Gfx::IntRect> damage_rect;
         Function<void()> callback;
+        MonotonicTime enqueue_time;
     };
     // NOTE: Queue will only contain multiple items in case tasks were scheduled by screenshot requests.
     //       Otherwise, it will contain only one item at a time.
     Queue<Task> m_rendering_tasks;
     Threading::Mutex m_rendering_task_mutex;
     Threading::ConditionVariable m_rendering_task_ready_wake_condition { m_rendering_task_mutex };
+
+    // Large CPU-backed surfaces are split into horizontal bands, which are rasterized in parallel by the rendering
+    // thread and a set of band workers. Each band has its own player, since players are stateful.
+    Vector<NonnullOwnPtr<Painting::DisplayListPlayerSkia>> m_band_players;
+    Vector<NonnullRefPtr<Threading::Thread>> m_band_workers;
+    Queue<Function<void()>> m_band_jobs;
+    size_t m_unfinished_band_jobs { 0 };
+    bool m_exit_band_workers { false };
+    Threading::Mutex m_band_job_mutex;
+    Threading::ConditionVariable m_band_job_ready_wake_condition { m_band_job_mutex };
+    Threading::ConditionVariable m_band_jobs_finished_condition { m_band_job_mutex };
 };
 
 }
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/DOM/AbortSignal.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
+#include <LibWeb/HTML/Scheduler.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
+#include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
+#include <LibWeb/HTML/Window.h>
+#include <LibWeb/HTML/WindowOrWorkerGlobalScope.h>
+#include <LibWeb/WebIDL/AbstractOperations.h>
+#include <LibWeb/WebIDL/Promise.h>
+
+namespace Web::HTML {
+
+GC_DEFINE_ALLOCATOR(Scheduler);
+
+GC::Ref<Scheduler> Scheduler::create(JS::Realm& realm)
+{
+    return realm.create<Scheduler>(realm);
+}
+
+Scheduler::Scheduler(JS::Realm& realm)
+    : PlatformObject(realm)
+{
+}
+
+Scheduler::~Scheduler() = default;
+
+void Scheduler::initialize(JS::Realm& realm)
+{
+    WEB_SET_PROTOTYPE_FOR_INTERFACE(Scheduler);
+    Base::initialize(realm);
+}
+
+static Task::Priority to_task_priority(Bindings::TaskPriority priority)
+{
+    switch (priority) {
+    case Bindings::TaskPriority::UserBlocking:
+        return Task::Priority::UserBlocking;
+    case Bindings::TaskPriority::UserVisible:
+        return Task::Priority::UserVisible;
+    case Bindings::TaskPriority::Background:
+        return Task::Priority::Background;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static Task::Priority continuation_priority(Task::Priority priority)
+{
+    switch (priority) {
+    case Task::Priority::Background:
+    case Task::Priority::BackgroundContinuation:
+        return Task::Priority::BackgroundContinuation;
+    case Task::Priority::UserVisible:
+    case Task::Priority::UserVisibleContinuation:
+        return Task::Priority::UserVisibleContinuation;
+    case Task::Priority::UserBlocking:
+    case Task::Priority::UserBlockingContinuation:
+        return Task::Priority::UserBlockingContinuation;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+// https://wicg.github.io/scheduling-apis/#dom-scheduler-posttask
+GC::Ref<WebIDL::Promise> Scheduler::post_task(GC::Ref<WebIDL::CallbackType> callback, SchedulerPostTaskOptions const& options)
+{
+    auto& realm = this->realm();
+
+    // 1. Let result be a new promise.
+    auto result = WebIDL::create_promise(realm);
+
+    // 2. Let signal be options["signal"] if options["signal"] exists, or otherwise null.
+    auto signal = options.signal;
+
+    // 3. If signal is not null and it is aborted, then reject result with signal's abort reason and return result.
+    if (signal && signal->aborted()) {
+        WebIDL::reject_promise(realm, result, signal->reason());
+        return result;
+    }
+
+    // 4. Let priority be options["priority"] if options["priority"] exists, or otherwise "user-visible".
+    // NOTE: We don't implement TaskSignal, so the priority of a task can't change once it has been posted.
+    auto priority = to_task_priority(options.priority.value_or(Bindings::TaskPriority::UserVisible));
+
+    // 5. Queue a scheduler task given the priority, which runs the callback and settles result with its outcome.
+    queue_a_scheduler_task(priority, signal, options.delay, result, [this, priority, callback, result] {
+        auto& realm = this->realm();
+        TemporaryExecutionContext context { realm, TemporaryExecutionContext::CallbacksEnabled::Yes };
+
+        auto previous_task_priority = exchange(m_current_task_priority, priority);
+        auto completion = WebIDL::invoke_callback(*callback, {}, WebIDL::ExceptionBehavior::Rethrow, {});
+        m_current_task_priority = previous_task_priority;
+
+        if (completion.is_abrupt())
+            WebIDL::reject_promise(realm, result, completion.value());
+        else
+            WebIDL::resolve_promise(realm, result, completion.value());
+    });
+
+    // 6. Return result.
+    return result;
+}
+
+// https://wicg.github.io/scheduling-apis/#dom-scheduler-yield
+GC::Ref<WebIDL::Promise> Scheduler::yield()
+{
+    auto& realm = this->realm();
+
+    // 1. Let result be a new promise.
+    auto result = WebIDL::create_promise(realm);
+
+    // 2. Continue at the priority of the postTask() callback that yielded, or at "user-visible" otherwise. Continuation
+    //    tasks run before other tasks of the same priority, so yielding doesn't send the current work to the back of the
+    //    queue.
+    // FIXME: The scheduling state should be propagated across awaits, so that yielding after the first await of an async
+    //        postTask() callback continues at its priority as well.
+    auto priority = continuation_priority(m_current_task_priority.value_or(Task::Priority::UserVisible));
+
+    // 3. Queue a scheduler task given the priority, which resolves result.
+    queue_a_scheduler_task(priority, {}, 0, result, [this, result] {
+        auto& realm = this->realm();
+        TemporaryExecutionContext context { realm, TemporaryExecutionContext::CallbacksEnabled::Yes };
+        WebIDL::resolve_promise(realm, result, JS::js_undefined());
+    });
+
+    // 4. Return result.
+    return result;
+}
+
+// https://wicg.github.io/scheduling-apis/#queue-a-scheduler-task
+void Scheduler::queue_a_scheduler_task(Task::Priority priority, GC::Ptr<DOM::AbortSignal> signal, u64 delay, GC::Ref<WebIDL::Promise> result, Function<void()> steps)
+{
+    auto& realm = this->realm();
+    auto& global = relevant_global_object(*this);
+    auto& event_loop = *relevant_agent(global).event_loop;
+
+    // 1. Let document be global's associated Document, if global is a Window object; otherwise null.
+    GC::Ptr<DOM::Document const> document;
+    if (auto* window = as_if<Window>(global))
+        document = window->associated_document();
+
+    // 2. Create a task with the posted task task source and the given priority. Its ID is used to find it again if the
+    //    signal aborts while it is queued.
+    auto task = Task::create(realm.vm(), Task::Source::PostedTask, priority, document, GC::create_function(realm.heap(), move(steps)));
+    auto task_id = task->id();
+
+    // 3. If signal is not null, then add the following abort steps to it:
+    if (signal) {
+        signal->add_abort_algorithm([&realm, &event_loop, signal, task_id, result] {
+            // 1. Remove the task from its queue, if it hasn't run yet.
+            event_loop.task_queue().remove_tasks_matching([task_id](Task const& task) {
+                return task.id() == task_id;
+            });
+
+            // 2. Reject result with signal's abort reason.
+            // NOTE: This does nothing if the task has already run and settled result.
+            TemporaryExecutionContext context { realm, TemporaryExecutionContext::CallbacksEnabled::Yes };
+            WebIDL::reject_promise(realm, result, signal->reason());
+        });
+    }
+
+    // 4. If delay is greater than 0, then run steps after a timeout given global, delay, and the following steps, which
+    //    queue the task unless the signal has aborted in the meantime.
+    if (delay > 0) {
+        auto& window_or_worker = as<WindowOrWorkerGlobalScopeMixin>(global);
+        auto timeout = static_cast<i32>(min(delay, static_cast<u64>(NumericLimits<i32>::max())));
+        window_or_worker.run_steps_after_a_timeout(timeout, [&event_loop, signal, task] {
+            if (signal && signal->aborted())
+                return;
+            event_loop.task_queue().add(task);
+        });
+        return;
+    }
+
+    // 5. Otherwise, append the task to the event loop's task queue.
+    event_loop.task_queue().add(task);
+}
+
+}
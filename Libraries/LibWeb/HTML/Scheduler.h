@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibWeb/Bindings/PlatformObject.h>
+#include <LibWeb/Bindings/SchedulerPrototype.h>
+#include <LibWeb/HTML/EventLoop/Task.h>
+#include <LibWeb/WebIDL/Types.h>
+
+namespace Web::HTML {
+
+// https://wicg.github.io/scheduling-apis/#dictdef-schedulerposttaskoptions
+struct SchedulerPostTaskOptions {
+    GC::Ptr<DOM::AbortSignal> signal;
+    Optional<Bindings::TaskPriority> priority;
+    WebIDL::UnsignedLongLong delay { 0 };
+};
+
+// https://wicg.github.io/scheduling-apis/#scheduler
+class Scheduler final : public Bindings::PlatformObject {
+    WEB_PLATFORM_OBJECT(Scheduler, Bindings::PlatformObject);
+    GC_DECLARE_ALLOCATOR(Scheduler);
+
+public:
+    [[nodiscard]] static GC::Ref<Scheduler> create(JS::Realm&);
+
+    virtual ~Scheduler() override;
+
+    GC::Ref<WebIDL::Promise> post_task(GC::Ref<WebIDL::CallbackType> callback, SchedulerPostTaskOptions const& options);
+    GC::Ref<WebIDL::Promise> yield();
+
+private:
+    explicit Scheduler(JS::Realm&);
+
+    virtual void initialize(JS::Realm&) override;
+
+    void queue_a_scheduler_task(Task::Priority, GC::Ptr<DOM::AbortSignal>, u64 delay, GC::Ref<WebIDL::Promise>, Function<void()> steps);
+
+    // The priority of the postTask() callback that is currently running, if any. Tasks queued by yield() from within the
+    // callback continue at this priority.
+    Optional<Task::Priority> m_current_task_priority;
+};
+
+}
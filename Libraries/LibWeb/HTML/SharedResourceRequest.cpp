@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibGC/Weak.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/SkiaBackendContext.h>
 #include <LibWeb/Bindings/PrincipalHostDefined.h>
 #include <LibWeb/Fetch/Fetching/Fetching.h>
 #include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
@@ -14,6 +16,7 @@
 #include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
 #include <LibWeb/HTML/DecodedImageData.h>
 #include <LibWeb/HTML/SharedResourceRequest.h>
+#include <LibWeb/HTML/TraversableNavigable.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Platform/ImageCodecPlugin.h>
 #include <LibWeb/SVG/SVGDecodedImageData.h>
@@ -34,6 +37,25 @@ GC::Ref<SharedResourceRequest> SharedResourceRequest::get_or_create(JS::Realm& r
     return request;
 }
 
+static bool is_svg_image(StringView mime_type, URL::URL const& url)
+{
+    return mime_type == "image/svg+xml"sv || url.basename().ends_with(".svg"sv);
+}
+
+// Images are decoded in parallel, so the fetch priority decides which ones get a decoder thread first.
+static Threading::TaskPriority decode_priority_for_request_priority(Fetch::Infrastructure::Request::Priority priority)
+{
+    switch (priority) {
+    case Fetch::Infrastructure::Request::Priority::High:
+        return Threading::TaskPriority::UserBlocking;
+    case Fetch::Infrastructure::Request::Priority::Low:
+        return Threading::TaskPriority::Background;
+    case Fetch::Infrastructure::Request::Priority::Auto:
+        return Threading::TaskPriority::Default;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 SharedResourceRequest::SharedResourceRequest(GC::Ref<Page> page, URL::URL url, GC::Ref<DOM::Document> document)
     : m_page(page)
     , m_url(move(url))
@@ -48,6 +70,7 @@ void SharedResourceRequest::finalize()
     Base::finalize();
     auto& shared_resource_requests = m_document->shared_resource_requests();
     shared_resource_requests.remove(m_url);
+    end_incremental_decode();
 }
 
 void SharedResourceRequest::visit_edges(JS::Cell::Visitor& visitor)
@@ -59,6 +82,7 @@ void SharedResourceRequest::visit_edges(JS::Cell::Visitor& visitor)
     for (auto& callback : m_callbacks) {
         visitor.visit(callback.on_finish);
         visitor.visit(callback.on_fail);
+        visitor.visit(callback.on_partial_image);
     }
     visitor.visit(m_image_data);
 }
@@ -89,7 +113,7 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infr
         auto process_body = GC::create_function(heap(), [this, request, response](ByteBuffer data) {
             auto extracted_mime_type = response->header_list()->extract_mime_type();
             auto mime_type = extracted_mime_type.has_value() ? extracted_mime_type.value().essence().bytes_as_string_view() : StringView {};
-            handle_successful_fetch(request->url(), mime_type, move(data));
+            handle_successful_fetch(request->url(), mime_type, move(data), request->priority());
         });
         auto process_body_error = GC::create_function(heap(), [this](JS::Value) {
             handle_failed_fetch();
@@ -101,6 +125,16 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infr
             return;
         }
 
+        // Raster images that were not buffered are decoded while they load, so that they can be shown early.
+        if (request->buffer_policy() == Fetch::Infrastructure::Request::BufferPolicy::DoNotBufferResponse) {
+            auto extracted_mime_type = response->header_list()->extract_mime_type();
+            auto mime_type = extracted_mime_type.has_value() ? extracted_mime_type.value().essence() : String {};
+            if (!is_svg_image(mime_type, request->url())) {
+                read_body_incrementally(realm, request, response, move(mime_type));
+                return;
+            }
+        }
+
         response->body()->fully_read(realm, process_body, process_body_error, GC::Ref { realm.global_object() });
     };
 
@@ -115,7 +149,65 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infr
     set_fetch_controller(fetch_controller);
 }
 
-void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void SharedResourceRequest::read_body_incrementally(JS::Realm& realm, GC::Ref<Fetch::Infrastructure::Request> request, GC::Ref<Fetch::Infrastructure::Response> response, String mime_type)
+{
+    m_incremental_decode_id = Platform::ImageCodecPlugin::the().begin_incremental_decode(
+        decode_priority_for_request_priority(request->priority()),
+        [weak_this = GC::Weak<SharedResourceRequest> { *this }](NonnullRefPtr<Gfx::Bitmap> bitmap) {
+            if (weak_this)
+                weak_this->handle_partial_image(move(bitmap));
+        });
+
+    auto process_body_chunk = GC::create_function(heap(), [this](ByteBuffer chunk) {
+        if (m_received_data.try_append(chunk).is_error()) {
+            end_incremental_decode();
+            handle_failed_fetch();
+            return;
+        }
+        if (m_incremental_decode_id.has_value())
+            Platform::ImageCodecPlugin::the().append_incremental_decode_data(*m_incremental_decode_id, chunk);
+    });
+    auto process_end_of_body = GC::create_function(heap(), [this, request, mime_type = move(mime_type)] {
+        if (m_state != State::Fetching)
+            return;
+        // The complete image is decoded from scratch, there is nothing left for the incremental decoder to show.
+        end_incremental_decode();
+        handle_successful_fetch(request->url(), mime_type, exchange(m_received_data, {}), request->priority());
+    });
+    auto process_body_error = GC::create_function(heap(), [this](JS::Value) {
+        end_incremental_decode();
+        handle_failed_fetch();
+    });
+
+    response->body()->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, GC::Ref { realm.global_object() });
+}
+
+void SharedResourceRequest::handle_partial_image(NonnullRefPtr<Gfx::Bitmap> bitmap)
+{
+    if (m_state != State::Fetching)
+        return;
+
+    // The color profile of the image is only applied once it is complete.
+    Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+    frames.append({ .bitmap = Gfx::ImmutableBitmap::create(move(bitmap), Gfx::AlphaType::Premultiplied), .duration = 0 });
+    auto image_data = AnimatedBitmapDecodedImageData::create(m_document->realm(), move(frames), 0, false);
+    if (image_data.is_error())
+        return;
+    m_image_data = image_data.release_value();
+
+    for (auto& callback : m_callbacks) {
+        if (callback.on_partial_image)
+            callback.on_partial_image->function()();
+    }
+}
+
+void SharedResourceRequest::end_incremental_decode()
+{
+    if (auto decode_id = exchange(m_incremental_decode_id, {}); decode_id.has_value())
+        Platform::ImageCodecPlugin::the().end_incremental_decode(*decode_id);
+}
+
+void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial_image)
 {
     if (m_state == State::Finished) {
         if (on_finish)
@@ -134,18 +226,18 @@ void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<v
         callbacks.on_finish = GC::create_function(vm().heap(), move(on_finish));
     if (on_fail)
         callbacks.on_fail = GC::create_function(vm().heap(), move(on_fail));
+    if (on_partial_image)
+        callbacks.on_partial_image = GC::create_function(vm().heap(), move(on_partial_image));
 
     m_callbacks.append(move(callbacks));
 }
 
-void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string, StringView mime_type, ByteBuffer data)
+void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string, StringView mime_type, ByteBuffer data, Fetch::Infrastructure::Request::Priority priority)
 {
     // AD-HOC: At this point, things gets very ad-hoc.
     // FIXME: Bring this closer to spec.
 
-    bool const is_svg_image = mime_type == "image/svg+xml"sv || url_string.basename().ends_with(".svg"sv);
-
-    if (is_svg_image) {
+    if (is_svg_image(mime_type, url_string)) {
         auto result = SVG::SVGDecodedImageData::create(m_document->realm(), m_page, url_string, data);
         if (result.is_error()) {
             handle_failed_fetch();
@@ -164,7 +256,17 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
                 .duration = static_cast<int>(frame.duration),
             });
         }
-        strong_this->m_image_data = AnimatedBitmapDecodedImageData::create(strong_this->m_document->realm(), move(frames), result.loop_count, result.is_animated).release_value_but_fixme_should_propagate_errors();
+
+        // Start uploading still images to the GPU before the first frame that paints them.
+        if (!result.is_animated && frames.size() == 1) {
+            if (auto skia_backend_context = strong_this->m_page->top_level_traversable()->skia_backend_context())
+                skia_backend_context->prepare_texture_for_bitmap(*frames.first().bitmap);
+        }
+
+        if (result.animation_id.has_value())
+            strong_this->m_image_data = AnimatedBitmapDecodedImageData::create_with_frames_decoded_on_demand(strong_this->m_document->realm(), move(frames), result.frame_count, result.loop_count, *result.animation_id, result.color_space).release_value_but_fixme_should_propagate_errors();
+        else
+            strong_this->m_image_data = AnimatedBitmapDecodedImageData::create(strong_this->m_document->realm(), move(frames), result.loop_count, result.is_animated).release_value_but_fixme_should_propagate_errors();
         strong_this->handle_successful_resource_load();
         return {};
     };
@@ -173,12 +275,14 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
         strong_this->handle_failed_fetch();
     };
 
-    (void)Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode));
+    (void)Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode), Web::Platform::AnimationFrameDecoding::OnDemand, decode_priority_for_request_priority(priority));
 }
 
 void SharedResourceRequest::handle_failed_fetch()
 {
     m_state = State::Failed;
+    // Don't leave a preview of a partially loaded image around.
+    m_image_data = nullptr;
     for (auto& callback : m_callbacks) {
         if (callback.on_fail)
             callback.on_fail->function()();
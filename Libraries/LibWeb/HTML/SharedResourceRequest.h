@@ -10,6 +10,7 @@
 #include <LibGC/Ptr.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibURL/URL.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
 #include <LibWeb/Forward.h>
 
 namespace Web::HTML {
@@ -32,7 +33,8 @@ public:
 
     void fetch_resource(JS::Realm&, GC::Ref<Fetch::Infrastructure::Request>);
 
-    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail);
+    // on_partial_image is called whenever image_data() has been replaced by a preview of an image that is still loading.
+    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial_image = {});
 
     bool is_fetching() const;
     bool needs_fetching() const;
@@ -43,7 +45,11 @@ private:
     virtual void finalize() override;
     virtual void visit_edges(JS::Cell::Visitor&) override;
 
-    void handle_successful_fetch(URL::URL const&, StringView mime_type, ByteBuffer data);
+    void read_body_incrementally(JS::Realm&, GC::Ref<Fetch::Infrastructure::Request>, GC::Ref<Fetch::Infrastructure::Response>, String mime_type);
+    void handle_partial_image(NonnullRefPtr<Gfx::Bitmap>);
+    void end_incremental_decode();
+
+    void handle_successful_fetch(URL::URL const&, StringView mime_type, ByteBuffer data, Fetch::Infrastructure::Request::Priority);
     void handle_failed_fetch();
     void handle_successful_resource_load();
 
@@ -61,6 +67,7 @@ private:
     struct Callbacks {
         GC::Ptr<GC::Function<void()>> on_finish;
         GC::Ptr<GC::Function<void()>> on_fail;
+        GC::Ptr<GC::Function<void()>> on_partial_image;
     };
     Vector<Callbacks> m_callbacks;
 
@@ -69,6 +76,10 @@ private:
     GC::Ptr<Fetch::Infrastructure::FetchController> m_fetch_controller;
 
     GC::Ptr<DOM::Document> m_document;
+
+    // Only used when the response is not buffered, see read_body_incrementally().
+    ByteBuffer m_received_data;
+    Optional<i64> m_incremental_decode_id;
 };
 
 }
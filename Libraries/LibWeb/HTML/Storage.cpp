@@ -9,6 +9,7 @@
 #include <AK/String.h>
 #include <LibGC/RootVector.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Bindings/StoragePrototype.h>
 #include <LibWeb/HTML/Navigable.h>
 #include <LibWeb/HTML/Storage.h>
@@ -203,16 +204,52 @@ void Storage::broadcast(Optional<String> const& key, Optional<String> const& old
     //    global object to fire an event named storage at remoteStorage's relevant global object, using StorageEvent, with key initialized
     //    to key, oldValue initialized to oldValue, newValue initialized to newValue, url initialized to url, and storageArea initialized to
     //    remoteStorage.
-    for (auto remote_storage : remote_storages) {
-        queue_global_task(Task::Source::DOMManipulation, relevant_global, GC::create_function(heap(), [&realm, key, old_value, new_value, url, remote_storage] {
-            StorageEventInit init;
-            init.key = move(key);
-            init.old_value = move(old_value);
-            init.new_value = move(new_value);
-            init.url = move(url);
-            init.storage_area = remote_storage;
-            as<Window>(relevant_global_object(remote_storage)).dispatch_event(StorageEvent::create(realm, EventNames::storage, init));
-        }));
+    for (auto remote_storage : remote_storages)
+        queue_storage_event(realm, relevant_global, remote_storage, key, old_value, new_value, url);
+
+    // AD-HOC: Storage objects in other processes are reached through the browser process, when our local storage area
+    //         writes the change back to it.
+}
+
+void Storage::queue_storage_event(JS::Realm& realm, JS::Object& global, GC::Ref<Storage> remote_storage, Optional<String> key, Optional<String> old_value, Optional<String> new_value, String url)
+{
+    queue_global_task(Task::Source::DOMManipulation, global, GC::create_function(realm.heap(), [&realm, key = move(key), old_value = move(old_value), new_value = move(new_value), url = move(url), remote_storage] {
+        StorageEventInit init;
+        init.key = move(key);
+        init.old_value = move(old_value);
+        init.new_value = move(new_value);
+        init.url = move(url);
+        init.storage_area = remote_storage;
+        as<Window>(relevant_global_object(remote_storage)).dispatch_event(StorageEvent::create(realm, EventNames::storage, init));
+    }));
+}
+
+void Storage::apply_local_storage_changes_from_other_process(String const& storage_key, ReadonlySpan<StorageAPI::StorageItemChange> changes)
+{
+    auto area = StorageAPI::LocalStorageArea::existing(storage_key);
+    if (!area)
+        return;
+
+    // These are the Storage objects that broadcast() would have found in the process that made the changes.
+    GC::RootVector<GC::Ref<Storage>> remote_storages(Bindings::main_thread_vm().heap());
+    for (auto storage : all_storages()) {
+        auto const* bottle = as_if<StorageAPI::LocalStorageBottle>(*storage->m_storage_bottle);
+        if (bottle && &bottle->area() == area.ptr())
+            remote_storages.append(storage);
+    }
+
+    for (auto const& change : changes) {
+        Optional<String> old_value;
+        if (change.key.has_value())
+            old_value = area->items().get(*change.key).copy();
+
+        if (!area->apply_change_from_other_process(change))
+            continue;
+
+        for (auto remote_storage : remote_storages) {
+            auto& global = relevant_global_object(remote_storage);
+            queue_storage_event(remote_storage->realm(), global, remote_storage, change.key, old_value, change.value, change.url);
+        }
     }
 }
 
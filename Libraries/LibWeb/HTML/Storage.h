@@ -41,6 +41,10 @@ public:
 
     void dump() const;
 
+    // Updates the local storage of the storage key with changes that another process made, and fires storage events for
+    // the ones that took effect.
+    static void apply_local_storage_changes_from_other_process(String const& storage_key, ReadonlySpan<StorageAPI::StorageItemChange>);
+
 private:
     Storage(JS::Realm&, Type, GC::Ref<StorageAPI::StorageBottle>);
 
@@ -58,6 +62,7 @@ private:
 
     void reorder();
     void broadcast(Optional<String> const& key, Optional<String> const& old_value, Optional<String> const& new_value);
+    static void queue_storage_event(JS::Realm&, JS::Object& global, GC::Ref<Storage> remote_storage, Optional<String> key, Optional<String> old_value, Optional<String> new_value, String url);
 
     Type m_type {};
     GC::Ref<StorageAPI::StorageBottle> m_storage_bottle;
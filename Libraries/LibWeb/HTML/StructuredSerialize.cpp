@@ -100,6 +100,14 @@ enum class ValueTag : u8 {
     // TODO: Define many more types
 };
 
+// Objects in the same graph tend to share their property names, so each name is only written out in full once, and
+// referred to by the order in which it was first written afterwards. Array indices are written as numbers.
+enum class PropertyKeyTag : u8 {
+    Index,
+    String,
+    StringReference,
+};
+
 enum ErrorType {
     Error,
 #define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, ArrayType) \
@@ -253,22 +261,29 @@ public:
     Serializer(JS::VM& vm, SerializationMemory& memory, bool for_storage)
         : m_vm(vm)
         , m_memory(memory)
-        , m_next_id(memory.size())
         , m_for_storage(for_storage)
     {
     }
 
-    // https://html.spec.whatwg.org/multipage/structured-data.html#structuredserializeinternal
-    // https://whatpr.org/html/9893/structured-data.html#structuredserializeinternal
     WebIDL::ExceptionOr<SerializationRecord> serialize(JS::Value value)
     {
         TransferDataEncoder serialized;
+        TRY(serialize(value, serialized));
+        return serialized.take_buffer().take_data();
+    }
 
+private:
+    // https://html.spec.whatwg.org/multipage/structured-data.html#structuredserializeinternal
+    // https://whatpr.org/html/9893/structured-data.html#structuredserializeinternal
+    // NOTE: The values that value refers to are serialized in place, rather than into records of their own that would then
+    //       be copied into this one.
+    WebIDL::ExceptionOr<void> serialize(JS::Value value, TransferDataEncoder& serialized)
+    {
         // 2. If memory[value] exists, then return memory[value].
         if (m_memory.contains(value)) {
             serialized.encode(ValueTag::ObjectReference);
             serialized.encode(m_memory.get(value).value());
-            return serialized.take_buffer().take_data();
+            return {};
         }
 
         // 3. Let deep be false.
@@ -298,7 +313,7 @@ public:
         }
 
         if (return_primitive_type)
-            return serialized.take_buffer().take_data();
+            return {};
 
         // 5. If value is a Symbol, then throw a "DataCloneError" DOMException.
         if (value.is_symbol())
@@ -462,7 +477,9 @@ public:
         }
 
         // 25. Set memory[value] to serialized.
-        m_memory.set(make_root(value), m_next_id++);
+        // NOTE: Serializable objects may add to memory through serializers of their own, so the next ID is always taken
+        //       from the size of memory.
+        m_memory.set(make_root(value), m_memory.size());
 
         // 26. If deep is true, then:
         if (deep) {
@@ -488,10 +505,8 @@ public:
                 for (auto copied_value : copied_list) {
                     // 1. Let serializedKey be ? StructuredSerializeInternal(entry.[[Key]], forStorage, memory).
                     // 2. Let serializedValue be ? StructuredSerializeInternal(entry.[[Value]], forStorage, memory).
-                    auto serialized_value = TRY(structured_serialize_internal(m_vm, copied_value, m_for_storage, m_memory));
-
                     // 3. Append { [[Key]]: serializedKey, [[Value]]: serializedValue } to serialized.[[MapData]].
-                    serialized.append(move(serialized_value));
+                    TRY(serialize(copied_value, serialized));
                 }
             }
 
@@ -512,10 +527,8 @@ public:
                 // 3. For each entry of copiedList:
                 for (auto copied_value : copied_list) {
                     // 1. Let serializedEntry be ? StructuredSerializeInternal(entry, forStorage, memory).
-                    auto serialized_value = TRY(structured_serialize_internal(m_vm, copied_value, m_for_storage, m_memory));
-
                     // 2. Append serializedEntry to serialized.[[SetData]].
-                    serialized.append(move(serialized_value));
+                    TRY(serialize(copied_value, serialized));
                 }
             }
 
@@ -539,11 +552,9 @@ public:
                         auto input_value = TRY(object.internal_get(property_key, value));
 
                         // 2. Let outputValue be ? StructuredSerializeInternal(inputValue, forStorage, memory).
-                        auto output_value = TRY(structured_serialize_internal(m_vm, input_value, m_for_storage, m_memory));
-
                         // 3. Append { [[Key]]: key, [[Value]]: outputValue } to serialized.[[Properties]].
-                        serialized.encode(key.as_string().utf16_string());
-                        serialized.append(move(output_value));
+                        serialize_property_key(property_key, serialized);
+                        TRY(serialize(input_value, serialized));
 
                         ++property_count;
                     }
@@ -557,13 +568,32 @@ public:
         }
 
         // 27. Return serialized.
-        return serialized.take_buffer().take_data();
+        return {};
+    }
+
+    void serialize_property_key(JS::PropertyKey const& key, TransferDataEncoder& serialized)
+    {
+        if (key.is_number()) {
+            serialized.encode(PropertyKeyTag::Index);
+            serialized.encode(key.as_number());
+            return;
+        }
+
+        if (auto id = m_property_key_ids.get(key.as_string()); id.has_value()) {
+            serialized.encode(PropertyKeyTag::StringReference);
+            serialized.encode(*id);
+            return;
+        }
+
+        serialized.encode(PropertyKeyTag::String);
+        serialized.encode(key.as_string().to_utf16_string());
+
+        m_property_key_ids.set(key.as_string(), m_property_key_ids.size());
     }
 
-private:
     JS::VM& m_vm;
     SerializationMemory& m_memory; // JS value -> index
-    u32 m_next_id { 0 };
+    HashMap<Utf16FlyString, u32> m_property_key_ids;
     bool m_for_storage { false };
 };
 
@@ -889,7 +919,7 @@ public:
 
                 // 1. For each Record { [[Key]], [[Value]] } entry of serialized.[[Properties]]:
                 for (u64 i = 0u; i < length; ++i) {
-                    auto key = m_serialized.decode<Utf16String>();
+                    auto key = deserialize_property_key();
 
                     // 1. Let deserializedValue be ? StructuredDeserialize(entry.[[Value]], targetRealm, memory).
                     auto deserialized_value = TRY(deserialize());
@@ -915,6 +945,20 @@ public:
     }
 
 private:
+    JS::PropertyKey deserialize_property_key()
+    {
+        switch (m_serialized.decode<PropertyKeyTag>()) {
+        case PropertyKeyTag::Index:
+            return m_serialized.decode<u32>();
+        case PropertyKeyTag::String:
+            m_property_keys.append(m_serialized.decode<Utf16String>());
+            return m_property_keys.last();
+        case PropertyKeyTag::StringReference:
+            return m_property_keys[m_serialized.decode<u32>()];
+        }
+        VERIFY_NOT_REACHED();
+    }
+
     static bool is_serializable_interface_exposed_on_target_realm(SerializeType name, JS::Realm& realm)
     {
         auto const& intrinsics = Bindings::host_defined_intrinsics(realm);
@@ -996,6 +1040,7 @@ private:
     JS::VM& m_vm;
     TransferDataDecoder& m_serialized;
     GC::RootVector<JS::Value> m_memory;
+    Vector<Utf16FlyString> m_property_keys;
 };
 
 // https://html.spec.whatwg.org/multipage/structured-data.html#structuredserializewithtransfer
@@ -26,6 +26,7 @@
 #include <LibWeb/HTML/EventSource.h>
 #include <LibWeb/HTML/HTMLImageElement.h>
 #include <LibWeb/HTML/ImageBitmap.h>
+#include <LibWeb/HTML/Scheduler.h>
 #include <LibWeb/HTML/Scripting/ClassicScript.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
@@ -85,6 +86,7 @@ void WindowOrWorkerGlobalScopeMixin::visit_edges(JS::Cell::Visitor& visitor)
         entry.value.visit_edges(visitor);
     visitor.visit(m_registered_event_sources);
     visitor.visit(m_crypto);
+    visitor.visit(m_scheduler);
     visitor.visit(m_cache_storage);
     visitor.visit(m_resource_timing_secondary_buffer);
     visitor.visit(m_trusted_type_policy_factory);
@@ -1294,6 +1296,16 @@ GC::Ref<Crypto::Crypto> WindowOrWorkerGlobalScopeMixin::crypto()
     return GC::Ref { *m_crypto };
 }
 
+// https://wicg.github.io/scheduling-apis/#dom-windoworworkerglobalscope-scheduler
+GC::Ref<Scheduler> WindowOrWorkerGlobalScopeMixin::scheduler()
+{
+    auto& realm = this_impl().realm();
+
+    if (!m_scheduler)
+        m_scheduler = Scheduler::create(realm);
+    return GC::Ref { *m_scheduler };
+}
+
 // https://w3c.github.io/ServiceWorker/#cache-storage-interface
 GC::Ref<ServiceWorker::CacheStorage> WindowOrWorkerGlobalScopeMixin::caches()
 {
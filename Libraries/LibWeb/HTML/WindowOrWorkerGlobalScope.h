@@ -102,6 +102,8 @@ public:
 
     [[nodiscard]] GC::Ref<Crypto::Crypto> crypto();
 
+    [[nodiscard]] GC::Ref<Scheduler> scheduler();
+
     [[nodiscard]] GC::Ref<ServiceWorker::CacheStorage> caches();
 
     [[nodiscard]] GC::Ref<TrustedTypes::TrustedTypePolicyFactory> trusted_types();
@@ -152,6 +154,8 @@ private:
 
     GC::Ptr<Crypto::Crypto> m_crypto;
 
+    GC::Ptr<Scheduler> m_scheduler;
+
     GC::Ptr<ServiceWorker::CacheStorage> m_cache_storage;
 
     GC::Ptr<TrustedTypes::TrustedTypePolicyFactory> m_trusted_type_policy_factory;
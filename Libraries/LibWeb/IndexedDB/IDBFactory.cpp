@@ -198,30 +198,33 @@ GC::Ref<WebIDL::Promise> IDBFactory::databases()
 
         // 1. Let databases be the set of databases in storageKey.
         //    If this cannot be determined for any reason, then reject p with an appropriate error (e.g. an "UnknownError" DOMException) and terminate these steps.
-        auto databases = Database::for_key(storage_key);
+        // NOTE: Databases that were written to disk but haven't been opened in this process yet are included, with the
+        //       version they were written with. Databases that are open are more up to date.
+        auto databases = Database::persisted_versions_for_key(realm, storage_key);
+        for (auto const& database : Database::for_key(storage_key))
+            databases.set(database->name(), database->version());
 
         // 2. Let result be a new list.
-        auto result = MUST(JS::Array::create(realm, databases.size()));
+        auto result = MUST(JS::Array::create(realm, 0));
 
         // 3. For each db of databases:
-        for (u32 i = 0; i < databases.size(); ++i) {
-            auto& db = databases[i];
-
+        u32 i = 0;
+        for (auto const& [name, version] : databases) {
             // 1. If db’s version is 0, then continue.
-            if (db->version() == 0)
+            if (version == 0)
                 continue;
 
             // 2. Let info be a new IDBDatabaseInfo dictionary.
             auto info = JS::Object::create(realm, realm.intrinsics().object_prototype());
 
             // 3. Set info’s name dictionary member to db’s name.
-            MUST(info->create_data_property("name"_utf16_fly_string, JS::PrimitiveString::create(realm.vm(), db->name())));
+            MUST(info->create_data_property("name"_utf16_fly_string, JS::PrimitiveString::create(realm.vm(), name)));
 
             // 4. Set info’s version dictionary member to db’s version.
-            MUST(info->create_data_property("version"_utf16_fly_string, JS::Value(db->version())));
+            MUST(info->create_data_property("version"_utf16_fly_string, JS::Value(version)));
 
             // 4. Append info to result.
-            MUST(result->create_data_property_or_throw(i, info));
+            MUST(result->create_data_property_or_throw(i++, info));
         }
 
         // 4. Resolve p with result.
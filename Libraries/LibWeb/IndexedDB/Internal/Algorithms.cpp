@@ -96,7 +96,7 @@ void open_a_database_connection(JS::Realm& realm, StorageAPI::StorageKey storage
     queue.all_previous_requests_processed(realm.heap(), request, GC::create_function(realm.heap(), [&realm, storage_key = move(storage_key), name = move(name), maybe_version = move(maybe_version), request, on_complete] -> void {
         // 4. Let db be the database named name in storageKey, or null otherwise.
         GC::Ptr<Database> db;
-        auto maybe_db = Database::for_key_and_name(storage_key, name);
+        auto maybe_db = Database::for_key_and_name(realm, storage_key, name);
         if (maybe_db.has_value()) {
             db = maybe_db.value();
         }
@@ -499,7 +499,7 @@ void delete_a_database(JS::Realm& realm, StorageAPI::StorageKey storage_key, Str
 
     queue.all_previous_requests_processed(realm.heap(), request, GC::create_function(realm.heap(), [&realm, storage_key = move(storage_key), name = move(name), on_complete] -> void {
         // 4. Let db be the database named name in storageKey, if one exists. Otherwise, return 0 (zero).
-        auto maybe_db = Database::for_key_and_name(storage_key, name);
+        auto maybe_db = Database::for_key_and_name(realm, storage_key, name);
         if (!maybe_db.has_value()) {
             on_complete->function()(0);
             return;
@@ -557,7 +557,7 @@ void delete_a_database(JS::Realm& realm, StorageAPI::StorageKey storage_key, Str
                 auto version = db->version();
 
                 // 11. Delete db. If this fails for any reason, return an appropriate error (e.g. "QuotaExceededError" or "UnknownError" DOMException).
-                auto maybe_deleted = Database::delete_for_key_and_name(storage_key, name);
+                auto maybe_deleted = Database::delete_for_key_and_name(realm, storage_key, name);
                 if (maybe_deleted.is_error()) {
                     on_complete->function()(WebIDL::OperationError::create(realm, "Unable to delete database"_utf16));
                     return;
@@ -817,7 +817,11 @@ void commit_a_transaction(JS::Realm& realm, GC::Ref<IDBTransaction> transaction)
             if (transaction->state() != IDBTransaction::TransactionState::Committing)
                 return;
 
-            // FIXME: 3. Attempt to write any outstanding changes made by transaction to the database, considering transaction’s durability hint.
+            // 3. Attempt to write any outstanding changes made by transaction to the database, considering transaction’s durability hint.
+            // NOTE: The changes are handed to the browser process all at once, which writes them to disk in a single SQL transaction.
+            if (transaction->mode() != Bindings::IDBTransactionMode::Readonly)
+                transaction->connection()->associated_database()->write_pending_changes(transaction->realm());
+
             // FIXME: 4. If an error occurs while writing the changes to the database, then run abort a transaction with transaction and an appropriate type for the error, for example "QuotaExceededError" or "UnknownError" DOMException, and terminate these steps.
 
             // 5. Queue a database task to run these steps:
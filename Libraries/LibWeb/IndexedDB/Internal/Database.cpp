@@ -4,17 +4,32 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibWeb/Bindings/PrincipalHostDefined.h>
 #include <LibWeb/IndexedDB/IDBTransaction.h>
 #include <LibWeb/IndexedDB/Internal/ConnectionQueueHandler.h>
 #include <LibWeb/IndexedDB/Internal/Database.h>
 #include <LibWeb/IndexedDB/Internal/IDBDatabaseObserver.h>
+#include <LibWeb/IndexedDB/Internal/Index.h>
 #include <LibWeb/IndexedDB/Internal/RequestList.h>
+#include <LibWeb/Page/Page.h>
 
 namespace Web::IndexedDB {
 
 using IDBDatabaseMapping = HashMap<StorageAPI::StorageKey, HashMap<String, GC::Root<Database>>>;
 static IDBDatabaseMapping m_databases;
 
+static bool s_persistence_enabled { false };
+
+void Database::set_persistence_enabled(bool enabled)
+{
+    s_persistence_enabled = enabled;
+}
+
+bool Database::is_persistence_enabled()
+{
+    return s_persistence_enabled;
+}
+
 void Database::for_each_database(AK::Function<void(GC::Root<Database> const&)> const& visitor)
 {
     for (auto const& [key, mapping] : m_databases) {
@@ -29,9 +44,9 @@ GC_DEFINE_ALLOCATOR(Database::ConnectionCloseState);
 
 Database::~Database() = default;
 
-GC::Ref<Database> Database::create(JS::Realm& realm, String const& name)
+GC::Ref<Database> Database::create(JS::Realm& realm, StorageAPI::StorageKey const& storage_key, String const& name)
 {
-    return realm.create<Database>(realm, name);
+    return realm.create<Database>(realm, storage_key, name);
 }
 
 void Database::visit_edges(Visitor& visitor)
@@ -78,12 +93,102 @@ RequestList& ConnectionQueueHandler::for_key_and_name(StorageAPI::StorageKey con
     return new_connection->request_list;
 }
 
-Optional<GC::Root<Database> const&> Database::for_key_and_name(StorageAPI::StorageKey const& key, String const& name)
+Optional<GC::Root<Database> const&> Database::for_key_and_name(JS::Realm& realm, StorageAPI::StorageKey const& key, String const& name)
+{
+    auto& database_mapping = m_databases.ensure(key, [] {
+        return HashMap<String, GC::Root<Database>>();
+    });
+
+    if (auto database = database_mapping.get(name); database.has_value() || !s_persistence_enabled)
+        return database;
+
+    // AD-HOC: If the database isn't open in this process yet, it may have been written to disk earlier.
+    auto persisted_database = Bindings::principal_host_defined_page(realm).client().page_did_request_indexed_db_database(key.to_string(), name);
+    if (!persisted_database.has_value())
+        return {};
+
+    auto database = Database::create(realm, key, name);
+    database->load(realm, *persisted_database);
+
+    database_mapping.set(name, database);
+    return database_mapping.get(name);
+}
+
+HashMap<String, u64> Database::persisted_versions_for_key(JS::Realm& realm, StorageAPI::StorageKey const& key)
+{
+    if (!s_persistence_enabled)
+        return {};
+    return Bindings::principal_host_defined_page(realm).client().page_did_request_indexed_db_database_versions(key.to_string());
+}
+
+void Database::load(JS::Realm& realm, PersistedDatabase const& persisted_database)
+{
+    m_version = persisted_database.schema.version;
+
+    HashMap<u64, GC::Ref<ObjectStore>> object_stores;
+    HashMap<u64, GC::Ref<Index>> indexes;
+
+    for (auto const& persisted_object_store : persisted_database.schema.object_stores) {
+        auto object_store = ObjectStore::create(realm, *this, persisted_object_store.name, persisted_object_store.key_generator_current_number.has_value(), persisted_object_store.key_path);
+        object_store->set_id(persisted_object_store.id);
+        m_next_id = max(m_next_id, persisted_object_store.id + 1);
+
+        if (persisted_object_store.key_generator_current_number.has_value())
+            object_store->key_generator().set(*persisted_object_store.key_generator_current_number);
+
+        for (auto const& persisted_index : persisted_object_store.indexes) {
+            auto index = Index::create(realm, object_store, persisted_index.name, persisted_index.key_path, persisted_index.unique, persisted_index.multi_entry);
+            index->set_id(persisted_index.id);
+            m_next_id = max(m_next_id, persisted_index.id + 1);
+
+            indexes.set(persisted_index.id, index);
+        }
+
+        object_stores.set(persisted_object_store.id, object_store);
+    }
+
+    for (auto const& persisted_record : persisted_database.object_store_records) {
+        auto object_store = object_stores.get(persisted_record.object_store_id);
+        auto key = Key::decode(realm, persisted_record.key);
+
+        if (!object_store.has_value() || !key.has_value()) {
+            dbgln("IndexedDB: Ignoring corrupt record in database '{}'", m_name);
+            continue;
+        }
+
+        HTML::SerializationRecord value;
+        value.append(persisted_record.value.data(), persisted_record.value.size());
+        (*object_store)->append_persisted_record({ *key, move(value) });
+    }
+
+    for (auto const& persisted_record : persisted_database.index_records) {
+        auto index = indexes.get(persisted_record.index_id);
+        auto key = Key::decode(realm, persisted_record.key);
+        auto value = Key::decode(realm, persisted_record.value);
+
+        if (!index.has_value() || !key.has_value() || !value.has_value()) {
+            dbgln("IndexedDB: Ignoring corrupt index record in database '{}'", m_name);
+            continue;
+        }
+
+        (*index)->append_persisted_record({ *key, *value });
+    }
+}
+
+void Database::write_pending_changes(JS::Realm& realm)
 {
-    return m_databases.ensure(key, [] {
-                          return HashMap<String, GC::Root<Database>>();
-                      })
-        .get(name);
+    if (!s_persistence_enabled)
+        return;
+
+    PersistedDatabaseChanges changes;
+    changes.schema.version = m_version;
+
+    for (auto const& object_store : m_object_stores) {
+        changes.schema.object_stores.append(object_store->persisted_schema());
+        object_store->take_pending_changes(changes);
+    }
+
+    Bindings::principal_host_defined_page(realm).client().page_did_commit_indexed_db_transaction(m_storage_key.to_string(), m_name, changes);
 }
 
 ErrorOr<GC::Root<Database>> Database::create_for_key_and_name(JS::Realm& realm, StorageAPI::StorageKey const& key, String const& name)
@@ -92,7 +197,7 @@ ErrorOr<GC::Root<Database>> Database::create_for_key_and_name(JS::Realm& realm,
         return HashMap<String, GC::Root<Database>>();
     }));
 
-    auto value = Database::create(realm, name);
+    auto value = Database::create(realm, key, name);
 
     database_mapping.set(name, value);
     m_databases.set(key, database_mapping);
@@ -100,8 +205,11 @@ ErrorOr<GC::Root<Database>> Database::create_for_key_and_name(JS::Realm& realm,
     return value;
 }
 
-ErrorOr<void> Database::delete_for_key_and_name(StorageAPI::StorageKey const& key, String const& name)
+ErrorOr<void> Database::delete_for_key_and_name(JS::Realm& realm, StorageAPI::StorageKey const& key, String const& name)
 {
+    if (s_persistence_enabled)
+        Bindings::principal_host_defined_page(realm).client().page_did_delete_indexed_db_database(key.to_string(), name);
+
     // FIXME: Is a missing entry a failure?
     auto maybe_database_mapping = m_databases.get(key);
     if (!maybe_database_mapping.has_value())
@@ -11,6 +11,7 @@
 #include <LibWeb/IndexedDB/IDBDatabase.h>
 #include <LibWeb/IndexedDB/IDBRequest.h>
 #include <LibWeb/IndexedDB/Internal/ObjectStore.h>
+#include <LibWeb/IndexedDB/Internal/PersistedDatabase.h>
 #include <LibWeb/StorageAPI/StorageKey.h>
 
 namespace Web::IndexedDB {
@@ -24,6 +25,7 @@ public:
     void set_version(u64 version) { m_version = version; }
     u64 version() const { return m_version; }
     String name() const { return m_name; }
+    StorageAPI::StorageKey const& storage_key() const { return m_storage_key; }
 
     void set_upgrade_transaction(GC::Ptr<IDBTransaction> transaction) { m_upgrade_transaction = transaction; }
     [[nodiscard]] GC::Ptr<IDBTransaction> upgrade_transaction() { return m_upgrade_transaction; }
@@ -41,13 +43,25 @@ public:
     }
 
     [[nodiscard]] static Vector<GC::Root<Database>> for_key(StorageAPI::StorageKey const&);
-    [[nodiscard]] static Optional<GC::Root<Database> const&> for_key_and_name(StorageAPI::StorageKey const&, String const&);
+    [[nodiscard]] static Optional<GC::Root<Database> const&> for_key_and_name(JS::Realm&, StorageAPI::StorageKey const&, String const&);
     [[nodiscard]] static ErrorOr<GC::Root<Database>> create_for_key_and_name(JS::Realm&, StorageAPI::StorageKey const&, String const&);
-    [[nodiscard]] static ErrorOr<void> delete_for_key_and_name(StorageAPI::StorageKey const&, String const&);
+    [[nodiscard]] static ErrorOr<void> delete_for_key_and_name(JS::Realm&, StorageAPI::StorageKey const&, String const&);
+
+    // The versions of the databases in the storage key that have been written to disk, but may not have been opened yet.
+    [[nodiscard]] static HashMap<String, u64> persisted_versions_for_key(JS::Realm&, StorageAPI::StorageKey const&);
 
     static void for_each_database(AK::Function<void(GC::Root<Database> const&)> const& visitor);
 
-    [[nodiscard]] static GC::Ref<Database> create(JS::Realm&, String const&);
+    [[nodiscard]] static GC::Ref<Database> create(JS::Realm&, StorageAPI::StorageKey const&, String const&);
+
+    // When enabled, databases are read from and written to disk by the browser process, through the page client.
+    static void set_persistence_enabled(bool);
+    [[nodiscard]] static bool is_persistence_enabled();
+
+    u64 allocate_id() { return m_next_id++; }
+
+    // Hands the changes made to the database since the last call to the browser process, to be written to disk.
+    void write_pending_changes(JS::Realm&);
     virtual ~Database();
 
     void wait_for_connections_to_close(ReadonlySpan<GC::Root<IDBDatabase>> connections, GC::Ref<GC::Function<void()>> after_all);
@@ -55,8 +69,9 @@ public:
 protected:
     explicit Database(IDBDatabase& database);
 
-    explicit Database(JS::Realm& realm, String name)
+    explicit Database(JS::Realm& realm, StorageAPI::StorageKey storage_key, String name)
         : PlatformObject(realm)
+        , m_storage_key(move(storage_key))
         , m_name(move(name))
     {
     }
@@ -64,6 +79,8 @@ protected:
     virtual void visit_edges(Visitor&) override;
 
 private:
+    void load(JS::Realm&, PersistedDatabase const&);
+
     struct ConnectionCloseState final : public GC::Cell {
         GC_CELL(ConnectionCloseState, GC::Cell);
         GC_DECLARE_ALLOCATOR(ConnectionCloseState);
@@ -79,6 +96,9 @@ private:
     Vector<GC::Ref<IDBDatabase>> m_associated_connections;
     Vector<GC::Ref<ConnectionCloseState>> m_pending_connection_close_queue;
 
+    // AD-HOC: A database needs to know which storage key it belongs to, to be written to disk.
+    StorageAPI::StorageKey m_storage_key;
+
     // A database has a name which identifies it within a specific storage key.
     String m_name;
 
@@ -90,6 +110,9 @@ private:
 
     // A database has zero or more object stores which hold the data stored in the database.
     Vector<GC::Ref<ObjectStore>> m_object_stores;
+
+    // AD-HOC: The next id to give to an object store or index.
+    u64 m_next_id { 1 };
 };
 
 }
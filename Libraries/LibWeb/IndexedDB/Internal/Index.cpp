@@ -4,7 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/QuickSort.h>
+#include <LibWeb/IndexedDB/Internal/Database.h>
 #include <LibWeb/IndexedDB/Internal/Index.h>
 #include <LibWeb/IndexedDB/Internal/ObjectStore.h>
 
@@ -26,6 +26,7 @@ Index::Index(GC::Ref<ObjectStore> store, String const& name, KeyPath const& key_
     , m_multi_entry(multi_entry)
     , m_key_path(key_path)
 {
+    m_id = store->database()->allocate_id();
     store->index_set().set(name, *this);
 }
 
@@ -49,13 +50,40 @@ void Index::set_name(String name)
     m_name = move(name);
 }
 
-bool Index::has_record_with_key(GC::Ref<Key> key)
+// Returns the position of the first record that doesn't sort before the given key and value.
+static size_t lower_bound(ReadonlySpan<IndexRecord> records, GC::Ref<Key> key, GC::Ptr<Key> value = {})
 {
-    auto index = m_records.find_if([&key](auto const& record) {
-        return Key::equals(record.key, key);
-    });
+    size_t low = 0;
+    size_t high = records.size();
+
+    while (low < high) {
+        auto middle = low + (high - low) / 2;
+        auto comparison = Key::compare_two_keys(records[middle].key, key);
+        if (comparison == 0 && value)
+            comparison = Key::compare_two_keys(records[middle].value, *value);
+
+        if (comparison < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
 
-    return index != m_records.end();
+    return low;
+}
+
+static ByteBuffer encode_index_record(ReadonlyBytes key, ReadonlyBytes value)
+{
+    // Encoded keys know where they end, so the two can simply be put together.
+    auto encoded = MUST(ByteBuffer::create_uninitialized(key.size() + value.size()));
+    key.copy_to(encoded.bytes());
+    value.copy_to(encoded.bytes().slice(key.size()));
+    return encoded;
+}
+
+bool Index::has_record_with_key(GC::Ref<Key> key)
+{
+    auto position = lower_bound(m_records, key);
+    return position < m_records.size() && Key::equals(m_records[position].key, key);
 }
 
 // https://w3c.github.io/IndexedDB/#index-referenced-value
@@ -75,6 +103,11 @@ HTML::SerializationRecord Index::referenced_value(IndexRecord const& index_recor
 void Index::clear_records()
 {
     m_records.clear();
+
+    if (Database::is_persistence_enabled()) {
+        m_has_pending_clear = true;
+        m_pending_record_changes.clear();
+    }
 }
 
 Optional<IndexRecord&> Index::first_in_range(GC::Ref<IDBKeyRange> range)
@@ -124,23 +157,49 @@ u64 Index::count_records_in_range(GC::Ref<IDBKeyRange> range)
 
 void Index::store_a_record(IndexRecord const& record)
 {
-    m_records.append(record);
+    if (Database::is_persistence_enabled()) {
+        auto key = record.key->encode();
+        auto value = record.value->encode();
+        m_pending_record_changes.set(encode_index_record(key, value), { move(key), move(value), false });
+    }
 
     // NOTE: The record is stored in index’s list of records such that the list is sorted primarily on the records keys, and secondarily on the records values, in ascending order.
-    AK::quick_sort(m_records, [](auto const& a, auto const& b) {
-        auto key_comparison = Key::compare_two_keys(a.key, b.key);
-        if (key_comparison != 0)
-            return key_comparison < 0;
-
-        return Key::compare_two_keys(a.value, b.value) < 0;
-    });
+    m_records.insert(lower_bound(m_records, record.key, record.value), record);
 }
 
 void Index::remove_records_with_value_in_range(GC::Ref<IDBKeyRange> range)
 {
     m_records.remove_all_matching([&](auto const& record) {
-        return range->is_in_range(record.value);
+        if (!range->is_in_range(record.value))
+            return false;
+
+        if (Database::is_persistence_enabled()) {
+            auto key = record.key->encode();
+            auto value = record.value->encode();
+            m_pending_record_changes.set(encode_index_record(key, value), { move(key), move(value), true });
+        }
+        return true;
     });
 }
 
+PersistedIndex Index::persisted_schema() const
+{
+    return { .id = m_id, .name = m_name, .key_path = m_key_path, .unique = m_unique, .multi_entry = m_multi_entry };
+}
+
+void Index::take_pending_changes(PersistedDatabaseChanges& changes)
+{
+    if (exchange(m_has_pending_clear, false))
+        changes.cleared_indexes.append(m_id);
+
+    for (auto& [encoded_record, change] : m_pending_record_changes) {
+        PersistedIndexRecord record { m_id, move(change.key), move(change.value) };
+        if (change.removed)
+            changes.removed_index_records.append(move(record));
+        else
+            changes.stored_index_records.append(move(record));
+    }
+    m_pending_record_changes.clear();
+}
+
 }
@@ -26,6 +26,8 @@ public:
     [[nodiscard]] static GC::Ref<Index> create(JS::Realm&, GC::Ref<ObjectStore>, String const&, KeyPath const&, bool, bool);
     virtual ~Index();
 
+    u64 id() const { return m_id; }
+    void set_id(u64 id) { m_id = id; }
     void set_name(String name);
     [[nodiscard]] String name() const { return m_name; }
     [[nodiscard]] bool unique() const { return m_unique; }
@@ -45,6 +47,12 @@ public:
 
     HTML::SerializationRecord referenced_value(IndexRecord const& index_record) const;
 
+    // Records read back from disk are already sorted, and must not be written out again.
+    void append_persisted_record(IndexRecord const& record) { m_records.append(record); }
+
+    PersistedIndex persisted_schema() const;
+    void take_pending_changes(PersistedDatabaseChanges&);
+
 protected:
     virtual void visit_edges(Visitor&) override;
 
@@ -54,6 +62,10 @@ private:
     // An index [...] has a referenced object store.
     GC::Ref<ObjectStore> m_object_store;
 
+    // AD-HOC: An id that is unique within the database and never changes, which identifies the records of the index on
+    //         disk even after it is renamed.
+    u64 m_id { 0 };
+
     // The index has a list of records which hold the data stored in the index.
     Vector<IndexRecord> m_records;
 
@@ -68,6 +80,15 @@ private:
 
     // The keys are derived from the referenced object store’s values using a key path.
     KeyPath m_key_path;
+
+    // AD-HOC: Changes to the list of records that have not been written to disk yet, by their encoded key and value.
+    struct PendingRecordChange {
+        ByteBuffer key;
+        ByteBuffer value;
+        bool removed { false };
+    };
+    bool m_has_pending_clear { false };
+    HashMap<ByteBuffer, PendingRecordChange> m_pending_record_changes;
 };
 
 }
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Utf16String.h>
 #include <LibWeb/IndexedDB/Internal/Key.h>
 #include <LibWeb/Infra/ByteSequences.h>
 #include <LibWeb/Infra/Strings.h>
@@ -165,6 +166,203 @@ i8 Key::compare_two_keys(GC::Ref<Key> a, GC::Ref<Key> b)
     VERIFY_NOT_REACHED();
 }
 
+// Each encoded key starts with a tag for its type, ordered like the types are ordered by compare two keys.
+enum class EncodedKeyType : u8 {
+    Number = 0x10,
+    Date = 0x20,
+    String = 0x30,
+    Binary = 0x40,
+    Array = 0x50,
+};
+
+// Variable-length values end in two zero bytes, and zero bytes inside them are followed by 0xFF. This way, a value that is
+// a prefix of another one sorts before it.
+static constexpr u8 escaped_zero_byte = 0xFF;
+
+static void encode_double(ByteBuffer& buffer, double value)
+{
+    // -0 and 0 are equal keys, so they must have the same encoding.
+    if (value == 0)
+        value = 0;
+
+    // Flipping the sign bit of positive numbers, and all bits of negative numbers, makes their bit patterns sort as
+    // unsigned integers in the same order as the numbers.
+    auto bits = bit_cast<u64>(value);
+    bits = (bits & (1ull << 63)) ? ~bits : bits | (1ull << 63);
+
+    for (int shift = 56; shift >= 0; shift -= 8)
+        buffer.append(static_cast<u8>(bits >> shift));
+}
+
+static void encode_escaped_bytes(ByteBuffer& buffer, ReadonlyBytes bytes)
+{
+    for (auto byte : bytes) {
+        buffer.append(byte);
+        if (byte == 0)
+            buffer.append(escaped_zero_byte);
+    }
+
+    buffer.append(0);
+    buffer.append(0);
+}
+
+static void encode_key(ByteBuffer& buffer, Key& key)
+{
+    switch (key.type()) {
+    case Key::KeyType::Invalid:
+        VERIFY_NOT_REACHED();
+    case Key::KeyType::Number:
+        buffer.append(to_underlying(EncodedKeyType::Number));
+        encode_double(buffer, key.value_as_double());
+        break;
+    case Key::KeyType::Date:
+        buffer.append(to_underlying(EncodedKeyType::Date));
+        encode_double(buffer, key.value_as_double());
+        break;
+    case Key::KeyType::String: {
+        buffer.append(to_underlying(EncodedKeyType::String));
+
+        // Strings are compared by their UTF-16 code units, which sort the same as their big-endian bytes.
+        auto string = Utf16String::from_utf8(key.value_as_string());
+        auto view = string.utf16_view();
+
+        ByteBuffer code_units;
+        code_units.ensure_capacity(view.length_in_code_units() * 2);
+        for (size_t i = 0; i < view.length_in_code_units(); ++i) {
+            auto code_unit = view.code_unit_at(i);
+            code_units.append(static_cast<u8>(code_unit >> 8));
+            code_units.append(static_cast<u8>(code_unit));
+        }
+
+        encode_escaped_bytes(buffer, code_units);
+        break;
+    }
+    case Key::KeyType::Binary:
+        buffer.append(to_underlying(EncodedKeyType::Binary));
+        encode_escaped_bytes(buffer, key.value_as_byte_buffer());
+        break;
+    case Key::KeyType::Array:
+        // Subkeys never start with a zero byte, so the zero byte after the last one sorts shorter arrays first.
+        buffer.append(to_underlying(EncodedKeyType::Array));
+        for (auto const& subkey : key.subkeys())
+            encode_key(buffer, *subkey);
+        buffer.append(0);
+        break;
+    }
+}
+
+ByteBuffer Key::encode()
+{
+    ByteBuffer buffer;
+    encode_key(buffer, *this);
+    return buffer;
+}
+
+static Optional<double> decode_double(ReadonlyBytes& bytes)
+{
+    if (bytes.size() < sizeof(u64))
+        return {};
+
+    u64 bits = 0;
+    for (size_t i = 0; i < sizeof(u64); ++i)
+        bits = (bits << 8) | bytes[i];
+    bytes = bytes.slice(sizeof(u64));
+
+    bits = (bits & (1ull << 63)) ? bits & ~(1ull << 63) : ~bits;
+    return bit_cast<double>(bits);
+}
+
+static Optional<ByteBuffer> decode_escaped_bytes(ReadonlyBytes& bytes)
+{
+    ByteBuffer result;
+
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        if (bytes[i] != 0) {
+            result.append(bytes[i]);
+            continue;
+        }
+
+        if (i + 1 == bytes.size())
+            return {};
+
+        if (bytes[i + 1] == 0) {
+            bytes = bytes.slice(i + 2);
+            return result;
+        }
+
+        if (bytes[i + 1] != escaped_zero_byte)
+            return {};
+
+        result.append(0);
+        ++i;
+    }
+
+    return {};
+}
+
+static Optional<GC::Ref<Key>> decode_key(JS::Realm& realm, ReadonlyBytes& bytes)
+{
+    if (bytes.is_empty())
+        return {};
+
+    auto type = static_cast<EncodedKeyType>(bytes[0]);
+    bytes = bytes.slice(1);
+
+    switch (type) {
+    case EncodedKeyType::Number:
+    case EncodedKeyType::Date: {
+        auto value = decode_double(bytes);
+        if (!value.has_value())
+            return {};
+        return type == EncodedKeyType::Number ? Key::create_number(realm, *value) : Key::create_date(realm, *value);
+    }
+    case EncodedKeyType::String: {
+        auto code_units = decode_escaped_bytes(bytes);
+        if (!code_units.has_value() || code_units->size() % 2 != 0)
+            return {};
+
+        Vector<char16_t> string;
+        string.ensure_capacity(code_units->size() / 2);
+        for (size_t i = 0; i < code_units->size(); i += 2)
+            string.unchecked_append(static_cast<char16_t>((code_units->at(i) << 8) | code_units->at(i + 1)));
+
+        return Key::create_string(realm, Utf16View { string.data(), string.size() }.to_utf8_but_should_be_ported_to_utf16());
+    }
+    case EncodedKeyType::Binary: {
+        auto value = decode_escaped_bytes(bytes);
+        if (!value.has_value())
+            return {};
+        return Key::create_binary(realm, *value);
+    }
+    case EncodedKeyType::Array: {
+        Vector<GC::Root<Key>> subkeys;
+        while (true) {
+            if (bytes.is_empty())
+                return {};
+            if (bytes[0] == 0) {
+                bytes = bytes.slice(1);
+                return Key::create_array(realm, subkeys);
+            }
+
+            auto subkey = decode_key(realm, bytes);
+            if (!subkey.has_value())
+                return {};
+            subkeys.append(*subkey);
+        }
+    }
+    }
+
+    return {};
+}
+
+Optional<GC::Ref<Key>> Key::decode(JS::Realm& realm, ReadonlyBytes bytes)
+{
+    auto key = decode_key(realm, bytes);
+    if (!bytes.is_empty())
+        return {};
+    return key;
+}
+
 String Key::dump() const
 {
     return m_value.visit(
@@ -70,6 +70,11 @@ public:
     [[nodiscard]] static bool less_than(GC::Ref<Key> a, GC::Ref<Key> b) { return compare_two_keys(a, b) < 0; }
     [[nodiscard]] static bool greater_than(GC::Ref<Key> a, GC::Ref<Key> b) { return compare_two_keys(a, b) > 0; }
 
+    // Encodes the key as a byte sequence which compares byte by byte in the same order as the key compares to other keys,
+    // so that keys can be stored and sorted by something that knows nothing about them.
+    [[nodiscard]] ByteBuffer encode();
+    [[nodiscard]] static Optional<GC::Ref<Key>> decode(JS::Realm&, ReadonlyBytes);
+
     AK::String dump() const;
 
 private:
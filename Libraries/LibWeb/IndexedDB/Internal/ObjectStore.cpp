@@ -4,7 +4,6 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/QuickSort.h>
 #include <LibWeb/IndexedDB/IDBKeyRange.h>
 #include <LibWeb/IndexedDB/Internal/ObjectStore.h>
 
@@ -24,6 +23,7 @@ ObjectStore::ObjectStore(GC::Ref<Database> database, String name, bool auto_incr
     , m_name(move(name))
     , m_key_path(key_path)
 {
+    m_id = database->allocate_id();
     database->add_object_store(*this);
 
     if (auto_increment)
@@ -44,27 +44,45 @@ void ObjectStore::visit_edges(Visitor& visitor)
 void ObjectStore::remove_records_in_range(GC::Ref<IDBKeyRange> range)
 {
     m_records.remove_all_matching([&](auto const& record) {
-        return range->is_in_range(record.key);
+        if (!range->is_in_range(record.key))
+            return false;
+
+        if (Database::is_persistence_enabled())
+            m_pending_record_changes.set(record.key->encode(), {});
+        return true;
     });
 }
 
-bool ObjectStore::has_record_with_key(GC::Ref<Key> key)
+// Returns the position of the first record whose key is not less than the given key.
+static size_t lower_bound(ReadonlySpan<ObjectStoreRecord> records, GC::Ref<Key> key)
 {
-    auto index = m_records.find_if([&key](auto const& record) {
-        return Key::equals(key, record.key);
-    });
+    size_t low = 0;
+    size_t high = records.size();
+
+    while (low < high) {
+        auto middle = low + (high - low) / 2;
+        if (Key::less_than(records[middle].key, key))
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
 
-    return index != m_records.end();
+bool ObjectStore::has_record_with_key(GC::Ref<Key> key)
+{
+    auto position = lower_bound(m_records, key);
+    return position < m_records.size() && Key::equals(m_records[position].key, key);
 }
 
 void ObjectStore::store_a_record(ObjectStoreRecord const& record)
 {
-    m_records.append(record);
+    if (Database::is_persistence_enabled())
+        m_pending_record_changes.set(record.key->encode(), record.value);
 
     // NOTE: The record is stored in the object store’s list of records such that the list is sorted according to the key of the records in ascending order.
-    AK::quick_sort(m_records, [](auto const& a, auto const& b) {
-        return Key::compare_two_keys(a.key, b.key) < 0;
-    });
+    m_records.insert(lower_bound(m_records, record.key), record);
 }
 
 u64 ObjectStore::count_records_in_range(GC::Ref<IDBKeyRange> range)
@@ -87,6 +105,11 @@ Optional<ObjectStoreRecord&> ObjectStore::first_in_range(GC::Ref<IDBKeyRange> ra
 void ObjectStore::clear_records()
 {
     m_records.clear();
+
+    if (Database::is_persistence_enabled()) {
+        m_has_pending_clear = true;
+        m_pending_record_changes.clear();
+    }
 }
 
 GC::ConservativeVector<ObjectStoreRecord> ObjectStore::first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
@@ -117,4 +140,34 @@ GC::ConservativeVector<ObjectStoreRecord> ObjectStore::last_n_in_range(GC::Ref<I
     return records;
 }
 
+PersistedObjectStore ObjectStore::persisted_schema()
+{
+    PersistedObjectStore object_store { .id = m_id, .name = m_name, .key_path = m_key_path, .key_generator_current_number = {}, .indexes = {} };
+
+    if (m_key_generator.has_value())
+        object_store.key_generator_current_number = m_key_generator->current_number();
+
+    for (auto const& index : m_indexes)
+        object_store.indexes.append(index.value->persisted_schema());
+
+    return object_store;
+}
+
+void ObjectStore::take_pending_changes(PersistedDatabaseChanges& changes)
+{
+    if (exchange(m_has_pending_clear, false))
+        changes.cleared_object_stores.append(m_id);
+
+    for (auto const& [key, value] : m_pending_record_changes) {
+        if (value.has_value())
+            changes.stored_object_store_records.append({ m_id, key, MUST(ByteBuffer::copy(value->span())) });
+        else
+            changes.removed_object_store_records.append({ m_id, key, {} });
+    }
+    m_pending_record_changes.clear();
+
+    for (auto const& index : m_indexes)
+        index.value->take_pending_changes(changes);
+}
+
 }
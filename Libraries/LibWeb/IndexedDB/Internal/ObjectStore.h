@@ -19,6 +19,7 @@
 #include <LibWeb/IndexedDB/Internal/Database.h>
 #include <LibWeb/IndexedDB/Internal/Index.h>
 #include <LibWeb/IndexedDB/Internal/KeyGenerator.h>
+#include <LibWeb/IndexedDB/Internal/PersistedDatabase.h>
 
 namespace Web::IndexedDB {
 
@@ -33,6 +34,8 @@ public:
     [[nodiscard]] static GC::Ref<ObjectStore> create(JS::Realm&, GC::Ref<Database>, String, bool, Optional<KeyPath> const&);
     virtual ~ObjectStore();
 
+    u64 id() const { return m_id; }
+    void set_id(u64 id) { m_id = id; }
     String name() const { return m_name; }
     void set_name(String name) { m_name = move(name); }
     Optional<KeyPath> key_path() const { return m_key_path; }
@@ -54,6 +57,12 @@ public:
     GC::ConservativeVector<ObjectStoreRecord> first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
     GC::ConservativeVector<ObjectStoreRecord> last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
 
+    // Records read back from disk are already sorted, and must not be written out again.
+    void append_persisted_record(ObjectStoreRecord const& record) { m_records.append(record); }
+
+    PersistedObjectStore persisted_schema();
+    void take_pending_changes(PersistedDatabaseChanges&);
+
 protected:
     virtual void visit_edges(Visitor&) override;
 
@@ -63,6 +72,10 @@ private:
     // AD-HOC: An ObjectStore needs to know what Database it belongs to...
     GC::Ref<Database> m_database;
 
+    // AD-HOC: An id that is unique within the database and never changes, which identifies the records of the object
+    //         store on disk even after it is renamed.
+    u64 m_id { 0 };
+
     // AD-HOC: An Index has referenced ObjectStores, we also need the reverse mapping
     AK::HashMap<String, GC::Ref<Index>> m_indexes;
 
@@ -77,6 +90,11 @@ private:
 
     // An object store has a list of records
     Vector<ObjectStoreRecord> m_records;
+
+    // AD-HOC: Changes to the list of records that have not been written to disk yet, by encoded key. Removed records have
+    //         no value.
+    bool m_has_pending_clear { false };
+    HashMap<ByteBuffer, Optional<HTML::SerializationRecord>> m_pending_record_changes;
 };
 
 }
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibWeb/IndexedDB/Internal/PersistedDatabase.h>
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedIndex const& index)
+{
+    TRY(encoder.encode(index.id));
+    TRY(encoder.encode(index.name));
+    TRY(encoder.encode(index.key_path));
+    TRY(encoder.encode(index.unique));
+    TRY(encoder.encode(index.multi_entry));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedIndex> IPC::decode(Decoder& decoder)
+{
+    auto id = TRY(decoder.decode<u64>());
+    auto name = TRY(decoder.decode<String>());
+    auto key_path = TRY(decoder.decode<Web::IndexedDB::KeyPath>());
+    auto unique = TRY(decoder.decode<bool>());
+    auto multi_entry = TRY(decoder.decode<bool>());
+
+    return Web::IndexedDB::PersistedIndex { id, move(name), move(key_path), unique, multi_entry };
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedObjectStore const& object_store)
+{
+    TRY(encoder.encode(object_store.id));
+    TRY(encoder.encode(object_store.name));
+    TRY(encoder.encode(object_store.key_path));
+    TRY(encoder.encode(object_store.key_generator_current_number));
+    TRY(encoder.encode(object_store.indexes));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedObjectStore> IPC::decode(Decoder& decoder)
+{
+    auto id = TRY(decoder.decode<u64>());
+    auto name = TRY(decoder.decode<String>());
+    auto key_path = TRY(decoder.decode<Optional<Web::IndexedDB::KeyPath>>());
+    auto key_generator_current_number = TRY(decoder.decode<Optional<u64>>());
+    auto indexes = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedIndex>>());
+
+    return Web::IndexedDB::PersistedObjectStore { id, move(name), move(key_path), key_generator_current_number, move(indexes) };
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedDatabaseSchema const& schema)
+{
+    TRY(encoder.encode(schema.version));
+    TRY(encoder.encode(schema.object_stores));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedDatabaseSchema> IPC::decode(Decoder& decoder)
+{
+    auto version = TRY(decoder.decode<u64>());
+    auto object_stores = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedObjectStore>>());
+
+    return Web::IndexedDB::PersistedDatabaseSchema { version, move(object_stores) };
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedObjectStoreRecord const& record)
+{
+    TRY(encoder.encode(record.object_store_id));
+    TRY(encoder.encode(record.key));
+    TRY(encoder.encode(record.value));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedObjectStoreRecord> IPC::decode(Decoder& decoder)
+{
+    auto object_store_id = TRY(decoder.decode<u64>());
+    auto key = TRY(decoder.decode<ByteBuffer>());
+    auto value = TRY(decoder.decode<ByteBuffer>());
+
+    return Web::IndexedDB::PersistedObjectStoreRecord { object_store_id, move(key), move(value) };
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedIndexRecord const& record)
+{
+    TRY(encoder.encode(record.index_id));
+    TRY(encoder.encode(record.key));
+    TRY(encoder.encode(record.value));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedIndexRecord> IPC::decode(Decoder& decoder)
+{
+    auto index_id = TRY(decoder.decode<u64>());
+    auto key = TRY(decoder.decode<ByteBuffer>());
+    auto value = TRY(decoder.decode<ByteBuffer>());
+
+    return Web::IndexedDB::PersistedIndexRecord { index_id, move(key), move(value) };
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedDatabase const& database)
+{
+    TRY(encoder.encode(database.schema));
+    TRY(encoder.encode(database.object_store_records));
+    TRY(encoder.encode(database.index_records));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedDatabase> IPC::decode(Decoder& decoder)
+{
+    auto schema = TRY(decoder.decode<Web::IndexedDB::PersistedDatabaseSchema>());
+    auto object_store_records = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedObjectStoreRecord>>());
+    auto index_records = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedIndexRecord>>());
+
+    return Web::IndexedDB::PersistedDatabase { move(schema), move(object_store_records), move(index_records) };
+}
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::IndexedDB::PersistedDatabaseChanges const& changes)
+{
+    TRY(encoder.encode(changes.schema));
+    TRY(encoder.encode(changes.cleared_object_stores));
+    TRY(encoder.encode(changes.cleared_indexes));
+    TRY(encoder.encode(changes.stored_object_store_records));
+    TRY(encoder.encode(changes.removed_object_store_records));
+    TRY(encoder.encode(changes.stored_index_records));
+    TRY(encoder.encode(changes.removed_index_records));
+    return {};
+}
+
+template<>
+ErrorOr<Web::IndexedDB::PersistedDatabaseChanges> IPC::decode(Decoder& decoder)
+{
+    auto schema = TRY(decoder.decode<Web::IndexedDB::PersistedDatabaseSchema>());
+    auto cleared_object_stores = TRY(decoder.decode<Vector<u64>>());
+    auto cleared_indexes = TRY(decoder.decode<Vector<u64>>());
+    auto stored_object_store_records = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedObjectStoreRecord>>());
+    auto removed_object_store_records = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedObjectStoreRecord>>());
+    auto stored_index_records = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedIndexRecord>>());
+    auto removed_index_records = TRY(decoder.decode<Vector<Web::IndexedDB::PersistedIndexRecord>>());
+
+    return Web::IndexedDB::PersistedDatabaseChanges {
+        move(schema),
+        move(cleared_object_stores),
+        move(cleared_indexes),
+        move(stored_object_store_records),
+        move(removed_object_store_records),
+        move(stored_index_records),
+        move(removed_index_records),
+    };
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Variant.h>
+#include <AK/Vector.h>
+#include <LibIPC/Forward.h>
+#include <LibWeb/Export.h>
+
+// These describe databases as they are handed to and from the browser process, which writes them to disk. Keys are
+// encoded with Key::encode() and values are serialized, so that the browser process doesn't need to understand either.
+
+namespace Web::IndexedDB {
+
+using KeyPath = Variant<String, Vector<String>>;
+
+struct PersistedIndex {
+    u64 id { 0 };
+    String name;
+    KeyPath key_path;
+    bool unique { false };
+    bool multi_entry { false };
+};
+
+struct PersistedObjectStore {
+    u64 id { 0 };
+    String name;
+    Optional<KeyPath> key_path;
+    Optional<u64> key_generator_current_number;
+    Vector<PersistedIndex> indexes;
+};
+
+struct PersistedDatabaseSchema {
+    u64 version { 0 };
+    Vector<PersistedObjectStore> object_stores;
+};
+
+struct PersistedObjectStoreRecord {
+    u64 object_store_id { 0 };
+    ByteBuffer key;
+    ByteBuffer value;
+};
+
+struct PersistedIndexRecord {
+    u64 index_id { 0 };
+    ByteBuffer key;
+    ByteBuffer value;
+};
+
+struct PersistedDatabase {
+    PersistedDatabaseSchema schema;
+
+    // Sorted by their key (and for index records, then by their value).
+    Vector<PersistedObjectStoreRecord> object_store_records;
+    Vector<PersistedIndexRecord> index_records;
+};
+
+// The changes that a transaction made to a database. These are written out all at once when the transaction commits.
+struct PersistedDatabaseChanges {
+    PersistedDatabaseSchema schema;
+
+    // Clearing happens before any of the records below are stored or removed.
+    Vector<u64> cleared_object_stores;
+    Vector<u64> cleared_indexes;
+
+    Vector<PersistedObjectStoreRecord> stored_object_store_records;
+    Vector<PersistedObjectStoreRecord> removed_object_store_records;
+    Vector<PersistedIndexRecord> stored_index_records;
+    Vector<PersistedIndexRecord> removed_index_records;
+};
+
+}
+
+namespace IPC {
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedIndex const&);
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedIndex> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedObjectStore const&);
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedObjectStore> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedDatabaseSchema const&);
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedDatabaseSchema> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedObjectStoreRecord const&);
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedObjectStoreRecord> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedIndexRecord const&);
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedIndexRecord> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedDatabase const&);
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedDatabase> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::IndexedDB::PersistedDatabaseChanges const&);
+template<>
+WEB_API ErrorOr<Web::IndexedDB::PersistedDatabaseChanges> decode(Decoder&);
+
+}
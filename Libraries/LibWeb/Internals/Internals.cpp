@@ -13,6 +13,7 @@
 #include <LibWeb/ARIA/StateAndProperties.h>
 #include <LibWeb/Bindings/InternalsPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/EventTarget.h>
@@ -342,6 +343,29 @@ String Internals::dump_display_list()
     return window().associated_document().dump_display_list();
 }
 
+String Internals::benchmark_rendering(WebIDL::UnsignedLong iterations)
+{
+    return window().associated_document().benchmark_rendering(iterations);
+}
+
+String Internals::benchmark_rasterization(WebIDL::UnsignedLong iterations)
+{
+    return window().associated_document().benchmark_rasterization(iterations);
+}
+
+void Internals::set_style_statistics_enabled(bool enabled)
+{
+    window().associated_document().style_computer().set_collects_statistics(enabled);
+}
+
+String Internals::dump_style_statistics(WebIDL::UnsignedLong max_selector_count)
+{
+    auto const* statistics = window().associated_document().style_computer().statistics();
+    if (!statistics)
+        return "Style statistics are not enabled"_string;
+    return statistics->to_string(max_selector_count);
+}
+
 GC::Ptr<DOM::ShadowRoot> Internals::get_shadow_root(GC::Ref<DOM::Element> element)
 {
     return element->shadow_root();
@@ -68,6 +68,11 @@ public:
     bool headless();
 
     String dump_display_list();
+    String benchmark_rendering(WebIDL::UnsignedLong iterations);
+    String benchmark_rasterization(WebIDL::UnsignedLong iterations);
+
+    void set_style_statistics_enabled(bool);
+    String dump_style_statistics(WebIDL::UnsignedLong max_selector_count);
 
     GC::Ptr<DOM::ShadowRoot> get_shadow_root(GC::Ref<DOM::Element>);
 
@@ -36,6 +36,10 @@ struct IntersectionObserverRegistration {
     // https://www.w3.org/TR/intersection-observer/#dom-intersectionobserverregistration-previousisintersecting
     // [A] previousIsIntersecting property holding a boolean.
     bool previous_is_intersecting { false };
+
+    // AD-HOC: The geometry generation of the target's document when we last ran the update intersection observations
+    //         steps for this registration. Used to skip targets that can't have moved since.
+    Optional<u64> previous_geometry_generation;
 };
 
 // https://w3c.github.io/IntersectionObserver/#intersection-observer-interface
@@ -67,6 +71,9 @@ public:
 
     void queue_entry(Badge<DOM::Document>, GC::Ref<IntersectionObserverEntry>);
 
+    Optional<CSSPixelRect> const& previous_root_bounds() const { return m_previous_root_bounds; }
+    void set_previous_root_bounds(Badge<DOM::Document>, CSSPixelRect root_bounds) { m_previous_root_bounds = root_bounds; }
+
     WebIDL::CallbackType& callback() { return *m_callback; }
 
 private:
@@ -105,6 +112,9 @@ private:
     // https://www.w3.org/TR/intersection-observer/#dom-intersectionobserver-observationtargets-slot
     Vector<GC::Ref<DOM::Element>> m_observation_targets;
 
+    // AD-HOC: The root intersection rectangle from the last time the update intersection observations steps ran.
+    Optional<CSSPixelRect> m_previous_root_bounds;
+
     // AD-HOC: This is the document where we've registered the IntersectionObserver.
     GC::Weak<DOM::Document> m_document;
 };
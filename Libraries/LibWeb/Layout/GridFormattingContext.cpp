@@ -936,7 +936,6 @@ void GridFormattingContext::distribute_extra_space_across_spanned_tracks_growth_
 void GridFormattingContext::increase_sizes_to_accommodate_spanning_items_crossing_content_sized_tracks(GridDimension dimension, size_t span)
 {
     auto& available_size = dimension == GridDimension::Column ? m_available_space->width : m_available_space->height;
-    auto& tracks = dimension == GridDimension::Column ? m_grid_columns : m_grid_rows;
     for (auto& item : m_grid_items) {
         auto const item_span = item.span(dimension);
         if (item_span != span)
@@ -1003,10 +1002,7 @@ void GridFormattingContext::increase_sizes_to_accommodate_spanning_items_crossin
 
         // 4. If at this point any track’s growth limit is now less than its base size, increase its growth limit to
         //    match its base size.
-        for (auto& track : tracks) {
-            if (track.growth_limit.has_value() && track.growth_limit.value() < track.base_size)
-                track.growth_limit = track.base_size;
-        }
+        increase_growth_limits_below_base_size(dimension, spanned_tracks);
 
         // 5. For intrinsic maximums: Next increase the growth limit of tracks with an intrinsic max track sizing
         distribute_extra_space_across_spanned_tracks_growth_limit(item_min_content_contribution, spanned_tracks, [&](GridTrack const& track) {
@@ -1041,6 +1037,8 @@ void GridFormattingContext::increase_sizes_to_accommodate_spanning_items_crossin
                     auto fit_content_limit = track.max_track_sizing_function.css_size().to_px(grid_container(), available_size.to_px_or_zero());
                     if (track.growth_limit.value() > fit_content_limit)
                         track.growth_limit = fit_content_limit;
+                    if (track.growth_limit.value() < track.base_size)
+                        m_growth_limit_may_be_below_base_size = true;
                 }
             } else if (!track.growth_limit.has_value()) {
                 // If the affected size is an infinite growth limit, set it to the track’s base size plus the planned increase.
@@ -1055,7 +1053,6 @@ void GridFormattingContext::increase_sizes_to_accommodate_spanning_items_crossin
 
 void GridFormattingContext::increase_sizes_to_accommodate_spanning_items_crossing_flexible_tracks(GridDimension dimension)
 {
-    auto& tracks = dimension == GridDimension::Column ? m_grid_columns : m_grid_rows;
     auto const& available_size = dimension == GridDimension::Column ? m_available_space->width : m_available_space->height;
     for (auto& item : m_grid_items) {
         Vector<GridTrack&> spanned_tracks;
@@ -1084,11 +1081,30 @@ void GridFormattingContext::increase_sizes_to_accommodate_spanning_items_crossin
 
         // 4. If at this point any track’s growth limit is now less than its base size, increase its growth limit to
         //    match its base size.
-        for (auto& track : tracks) {
-            if (track.growth_limit.has_value() && track.growth_limit.value() < track.base_size)
-                track.growth_limit = track.base_size;
-        }
+        increase_growth_limits_below_base_size(dimension, spanned_tracks);
+    }
+}
+
+void GridFormattingContext::increase_growth_limits_below_base_size(GridDimension dimension, Vector<GridTrack&>& spanned_tracks)
+{
+    auto increase_growth_limit_if_below_base_size = [](GridTrack& track) {
+        if (track.growth_limit.has_value() && track.growth_limit.value() < track.base_size)
+            track.growth_limit = track.base_size;
+    };
+
+    // OPTIMIZATION: Base sizes only change for the tracks spanned by the item being considered, so unless a
+    //               fit-content() argument has limited a growth limit since we last looked, the other tracks
+    //               can't have a growth limit below their base size.
+    if (m_growth_limit_may_be_below_base_size) {
+        auto& tracks = dimension == GridDimension::Column ? m_grid_columns : m_grid_rows;
+        for (auto& track : tracks)
+            increase_growth_limit_if_below_base_size(track);
+        m_growth_limit_may_be_below_base_size = false;
+        return;
     }
+
+    for (auto& track : spanned_tracks)
+        increase_growth_limit_if_below_base_size(track);
 }
 
 void GridFormattingContext::maximize_tracks_using_available_size(AvailableSpace const& available_space, GridDimension dimension)
@@ -310,6 +310,9 @@ private:
     bool m_has_flexible_row_tracks { false };
     bool m_has_flexible_column_tracks { false };
 
+    // Set when a fit-content() argument limits a track's growth limit below its base size.
+    bool m_growth_limit_may_be_below_base_size { false };
+
     bool has_flexible_tracks(GridDimension dimension) const
     {
         return dimension == GridDimension::Column ? m_has_flexible_column_tracks : m_has_flexible_row_tracks;
@@ -376,6 +379,7 @@ private:
     void resolve_intrinsic_track_sizes(GridDimension);
     void increase_sizes_to_accommodate_spanning_items_crossing_content_sized_tracks(GridDimension, size_t span);
     void increase_sizes_to_accommodate_spanning_items_crossing_flexible_tracks(GridDimension);
+    void increase_growth_limits_below_base_size(GridDimension, Vector<GridTrack&>& spanned_tracks);
     void maximize_tracks_using_available_size(AvailableSpace const& available_space, GridDimension dimension);
     void maximize_tracks(GridDimension);
     void expand_flexible_tracks(GridDimension);
@@ -20,34 +20,34 @@ namespace Web::Layout {
 
 LayoutState::~LayoutState()
 {
+    for (auto& it : used_values_per_layout_node)
+        it.value->~UsedValues();
 }
 
-LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyle const& node)
+LayoutState::UsedValues& LayoutState::create_used_values(NodeWithStyle const& node) const
 {
-    if (auto* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
-        return *used_values;
-
     auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
 
-    auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
+    auto* memory = m_used_values_allocator.allocate(sizeof(UsedValues), alignof(UsedValues));
+    VERIFY(memory);
+    auto* new_used_values = new (memory) UsedValues;
     new_used_values->set_node(node, containing_block_used_values);
-    used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+    const_cast<LayoutState*>(this)->used_values_per_layout_node.set(node, new_used_values);
+    return *new_used_values;
+}
+
+LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyle const& node)
+{
+    if (auto* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
+        return *used_values;
+    return create_used_values(node);
 }
 
 LayoutState::UsedValues const& LayoutState::get(NodeWithStyle const& node) const
 {
     if (auto const* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
         return *used_values;
-
-    auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
-
-    auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
-    new_used_values->set_node(node, containing_block_used_values);
-    const_cast<LayoutState*>(this)->used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+    return create_used_values(node);
 }
 
 // https://drafts.csswg.org/css-overflow-3/#scrollable-overflow-region
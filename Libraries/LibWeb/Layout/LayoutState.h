@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/BumpAllocator.h>
 #include <AK/HashMap.h>
 #include <LibGfx/Path.h>
 #include <LibGfx/Point.h>
@@ -204,10 +205,15 @@ struct LayoutState {
     UsedValues& get_mutable(NodeWithStyle const&);
     UsedValues const& get(NodeWithStyle const&) const;
 
-    OrderedHashMap<GC::Ref<Layout::Node const>, NonnullOwnPtr<UsedValues>> used_values_per_layout_node;
+    OrderedHashMap<GC::Ref<Layout::Node const>, UsedValues*> used_values_per_layout_node;
 
 private:
+    UsedValues& create_used_values(NodeWithStyle const&) const;
+
     void resolve_relative_positions();
+
+    // NOTE: UsedValues are bump-allocated, since a LayoutState only ever adds them and drops them all at once.
+    mutable BumpAllocator<false, 64 * KiB> m_used_values_allocator;
 };
 
 inline CSSPixels clamp_to_max_dimension_value(CSSPixels value)
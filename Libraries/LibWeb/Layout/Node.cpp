@@ -1379,6 +1379,27 @@ void NodeWithStyleAndBoxModelMetrics::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_continuation_of_node);
 }
 
+// Returns true if changes inside the box can never affect its min-content or max-content contributions (or those of
+// its ancestors), i.e. a block-level scroll container with a fixed width and height.
+static bool size_is_independent_of_contents(Node const& node)
+{
+    auto const* box = as_if<Box>(node);
+    if (!box || box->is_anonymous() || box->is_viewport())
+        return false;
+
+    // NOTE: Inline-level boxes, flex items and grid items may export baselines that depend on their contents.
+    if (!box->display().is_block_outside() || box->is_flex_item() || box->is_grid_item())
+        return false;
+    if (box->display().is_table_inside() || box->display().is_internal_table())
+        return false;
+
+    if (!box->is_scroll_container())
+        return false;
+
+    auto const& computed_values = box->computed_values();
+    return computed_values.width().is_length() && computed_values.height().is_length();
+}
+
 void Node::set_needs_layout_update(DOM::SetNeedsLayoutReason reason)
 {
     if (m_needs_layout_update)
@@ -1405,6 +1426,20 @@ void Node::set_needs_layout_update(DOM::SetNeedsLayoutReason reason)
     for (auto* ancestor = parent(); ancestor; ancestor = ancestor->parent()) {
         if (ancestor->m_needs_layout_update)
             break;
+
+        // OPTIMIZATION: Nothing inside a box whose size is independent of its contents can affect the intrinsic
+        //               sizes of the box's ancestors. Drop this box's own cached intrinsic sizes and only mark it
+        //               and its ancestors as having a descendant in need of layout, so the caches above survive.
+        if (size_is_independent_of_contents(*ancestor)) {
+            as<Box>(*ancestor).reset_cached_intrinsic_sizes();
+            for (auto* node = ancestor; node; node = node->parent()) {
+                if (node->m_needs_layout_update || node->m_descendant_needs_layout_update)
+                    break;
+                node->m_descendant_needs_layout_update = true;
+            }
+            break;
+        }
+
         ancestor->m_needs_layout_update = true;
     }
 }
@@ -47,8 +47,13 @@ public:
     DOM::Element* pseudo_element_generator();
 
     bool needs_layout_update() const { return m_needs_layout_update; }
+    bool descendant_needs_layout_update() const { return m_descendant_needs_layout_update; }
     void set_needs_layout_update(DOM::SetNeedsLayoutReason);
-    void reset_needs_layout_update() { m_needs_layout_update = false; }
+    void reset_needs_layout_update()
+    {
+        m_needs_layout_update = false;
+        m_descendant_needs_layout_update = false;
+    }
 
     bool is_generated_for_pseudo_element() const { return m_generated_for.has_value(); }
     Optional<CSS::PseudoElement> generated_for_pseudo_element() const { return m_generated_for; }
@@ -231,6 +236,7 @@ private:
     bool m_has_been_wrapped_in_table_wrapper { false };
 
     bool m_needs_layout_update { false };
+    bool m_descendant_needs_layout_update { false };
 
     Optional<CSS::PseudoElement> m_generated_for;
 
@@ -101,26 +101,75 @@ void TableFormattingContext::compute_constrainedness()
 
 void TableFormattingContext::compute_cell_measures()
 {
-    // Implements https://www.w3.org/TR/css-tables-3/#computing-cell-measures.
+    // Implements the width part of https://www.w3.org/TR/css-tables-3/#computing-cell-measures.
     auto const& containing_block = m_state.get(*table_wrapper().containing_block());
 
     compute_constrainedness();
 
     for (auto& cell : m_cells) {
         auto const& computed_values = cell.box->computed_values();
-        CSSPixels padding_top = computed_values.padding().top().to_px_or_zero(cell.box, containing_block.content_height());
-        CSSPixels padding_bottom = computed_values.padding().bottom().to_px_or_zero(cell.box, containing_block.content_height());
+
+        // For fixed mode, according to https://www.w3.org/TR/css-tables-3/#computing-column-measures:
+        // The min-content and max-content width of cells is considered zero unless they are directly specified as a length-percentage,
+        // in which case they are resolved based on the table width (if it is definite, otherwise use 0).
+        // OPTIMIZATION: Don't measure the contents of such cells at all, as their measures would be ignored anyway.
+        auto width_is_specified_length_or_percentage = computed_values.width().is_length() || computed_values.width().is_percentage();
+        if (use_fixed_mode_layout() && !width_is_specified_length_or_percentage)
+            continue;
+
         CSSPixels padding_left = computed_values.padding().left().to_px_or_zero(cell.box, containing_block.content_width());
         CSSPixels padding_right = computed_values.padding().right().to_px_or_zero(cell.box, containing_block.content_width());
 
         auto const& cell_state = m_state.get(cell.box);
         auto use_collapsing_borders_model = cell_state.override_borders_data().has_value();
         // Implement the collapsing border model https://www.w3.org/TR/CSS22/tables.html#collapsing-borders.
-        CSSPixels border_top = use_collapsing_borders_model ? round(cell_state.border_top / 2) : computed_values.border_top().width;
-        CSSPixels border_bottom = use_collapsing_borders_model ? round(cell_state.border_bottom / 2) : computed_values.border_bottom().width;
         CSSPixels border_left = use_collapsing_borders_model ? round(cell_state.border_left / 2) : computed_values.border_left().width;
         CSSPixels border_right = use_collapsing_borders_model ? round(cell_state.border_right / 2) : computed_values.border_right().width;
 
+        auto min_content_width = calculate_min_content_width(cell.box);
+        auto max_content_width = calculate_max_content_width(cell.box);
+
+        // The outer min-content width of a table-cell is max(min-width, min-content width) adjusted by the cell intrinsic offsets.
+        auto min_width = computed_values.min_width().to_px(cell.box, containing_block.content_width());
+        auto cell_intrinsic_width_offsets = padding_left + padding_right + border_left + border_right;
+        cell.outer_min_width = max(min_width, min_content_width) + cell_intrinsic_width_offsets;
+
+        // The tables specification isn't explicit on how to use the width and max-width CSS properties in the outer max-content formulas.
+        // However, during this early phase we don't have enough information to resolve percentage sizes yet and the formulas for outer sizes
+        // in the specification give enough clues to pick defaults in a way that makes sense.
+        auto width = computed_values.width().is_length() ? computed_values.width().to_px(cell.box, containing_block.content_width()) : 0;
+        auto max_width = computed_values.max_width().is_length() ? computed_values.max_width().to_px(cell.box, containing_block.content_width()) : CSSPixels::max();
+        if (m_columns[cell.column_index].is_constrained) {
+            // The outer max-content width of a table-cell in a constrained column is
+            // max(min-width, width, min-content width, min(max-width, width)) adjusted by the cell intrinsic offsets.
+            // NB: min(max-width, width) doesn't have any effect here, we can simplify the expression to max(min-width, width, min-content width).
+            cell.outer_max_width = max(min_width, max(width, min_content_width)) + cell_intrinsic_width_offsets;
+        } else {
+            // The outer max-content width of a table-cell in a non-constrained column is
+            // max(min-width, width, min-content width, min(max-width, max-content width)) adjusted by the cell intrinsic offsets.
+            cell.outer_max_width = max(min_width, max(width, max(min_content_width, min(max_width, max_content_width)))) + cell_intrinsic_width_offsets;
+        }
+    }
+}
+
+void TableFormattingContext::compute_cell_height_measures()
+{
+    // Implements the height part of https://www.w3.org/TR/css-tables-3/#computing-cell-measures.
+    // NOTE: This is only needed once we get past the width calculation, so it's split out from compute_cell_measures()
+    //       to avoid measuring the height of every cell while computing the intrinsic width of the table.
+    auto const& containing_block = m_state.get(*table_wrapper().containing_block());
+
+    for (auto& cell : m_cells) {
+        auto const& computed_values = cell.box->computed_values();
+        CSSPixels padding_top = computed_values.padding().top().to_px_or_zero(cell.box, containing_block.content_height());
+        CSSPixels padding_bottom = computed_values.padding().bottom().to_px_or_zero(cell.box, containing_block.content_height());
+
+        auto const& cell_state = m_state.get(cell.box);
+        auto use_collapsing_borders_model = cell_state.override_borders_data().has_value();
+        // Implement the collapsing border model https://www.w3.org/TR/CSS22/tables.html#collapsing-borders.
+        CSSPixels border_top = use_collapsing_borders_model ? round(cell_state.border_top / 2) : computed_values.border_top().width;
+        CSSPixels border_bottom = use_collapsing_borders_model ? round(cell_state.border_bottom / 2) : computed_values.border_bottom().width;
+
         auto min_content_width = calculate_min_content_width(cell.box);
         auto max_content_width = calculate_max_content_width(cell.box);
         auto min_content_height = calculate_min_content_height(cell.box, max_content_width);
@@ -130,16 +179,6 @@ void TableFormattingContext::compute_cell_measures()
         auto min_height = computed_values.min_height().to_px(cell.box, containing_block.content_height());
         auto cell_intrinsic_height_offsets = padding_top + padding_bottom + border_top + border_bottom;
         cell.outer_min_height = max(min_height, min_content_height) + cell_intrinsic_height_offsets;
-        // The outer min-content width of a table-cell is max(min-width, min-content width) adjusted by the cell intrinsic offsets.
-        auto min_width = computed_values.min_width().to_px(cell.box, containing_block.content_width());
-        auto cell_intrinsic_width_offsets = padding_left + padding_right + border_left + border_right;
-        // For fixed mode, according to https://www.w3.org/TR/css-tables-3/#computing-column-measures:
-        // The min-content and max-content width of cells is considered zero unless they are directly specified as a length-percentage,
-        // in which case they are resolved based on the table width (if it is definite, otherwise use 0).
-        auto width_is_specified_length_or_percentage = computed_values.width().is_length() || computed_values.width().is_percentage();
-        if (!use_fixed_mode_layout() || width_is_specified_length_or_percentage) {
-            cell.outer_min_width = max(min_width, min_content_width) + cell_intrinsic_width_offsets;
-        }
 
         // The tables specification isn't explicit on how to use the height and max-height CSS properties in the outer max-content formulas.
         // However, during this early phase we don't have enough information to resolve percentage sizes yet and the formulas for outer sizes
@@ -156,23 +195,6 @@ void TableFormattingContext::compute_cell_measures()
             // max(min-height, height, min-content height, min(max-height, max-content height)) adjusted by the cell intrinsic offsets.
             cell.outer_max_height = max(min_height, max(height, max(min_content_height, min(max_height, max_content_height)))) + cell_intrinsic_height_offsets;
         }
-
-        // See the explanation for height and max_height above.
-        auto width = computed_values.width().is_length() ? computed_values.width().to_px(cell.box, containing_block.content_width()) : 0;
-        auto max_width = computed_values.max_width().is_length() ? computed_values.max_width().to_px(cell.box, containing_block.content_width()) : CSSPixels::max();
-        if (use_fixed_mode_layout() && !width_is_specified_length_or_percentage) {
-            continue;
-        }
-        if (m_columns[cell.column_index].is_constrained) {
-            // The outer max-content width of a table-cell in a constrained column is
-            // max(min-width, width, min-content width, min(max-width, width)) adjusted by the cell intrinsic offsets.
-            // NB: min(max-width, width) doesn't have any effect here, we can simplify the expression to max(min-width, width, min-content width).
-            cell.outer_max_width = max(min_width, max(width, min_content_width)) + cell_intrinsic_width_offsets;
-        } else {
-            // The outer max-content width of a table-cell in a non-constrained column is
-            // max(min-width, width, min-content width, min(max-width, max-content width)) adjusted by the cell intrinsic offsets.
-            cell.outer_max_width = max(min_width, max(width, max(min_content_width, min(max_width, max_content_width)))) + cell_intrinsic_width_offsets;
-        }
     }
 }
 
@@ -1629,14 +1651,6 @@ void TableFormattingContext::run_until_width_calculation(AvailableSpace const& a
     compute_outer_content_sizes();
     compute_table_measures<Column>();
 
-    // https://www.w3.org/TR/css-tables-3/#row-layout
-    // Since during row layout the specified heights of cells in the row were ignored and cells that were spanning more than one rows
-    // have not been sized correctly, their height will need to be eventually distributed to the set of rows they spanned. This is done
-    // by running the same algorithm as the column measurement, with the span=1 value being initialized (for min-content) with the largest
-    // of the resulting height of the previous row layout, the height specified on the corresponding table-row (if any), and the largest
-    // height specified on cells that span this row only (the algorithm starts by considering cells of span 2 on top of that assignment).
-    compute_table_measures<Row>();
-
     // Compute the width of the table.
     compute_table_width();
 }
@@ -1682,6 +1696,16 @@ void TableFormattingContext::run(AvailableSpace const& available_space)
         return;
     }
 
+    compute_cell_height_measures();
+
+    // https://www.w3.org/TR/css-tables-3/#row-layout
+    // Since during row layout the specified heights of cells in the row were ignored and cells that were spanning more than one rows
+    // have not been sized correctly, their height will need to be eventually distributed to the set of rows they spanned. This is done
+    // by running the same algorithm as the column measurement, with the span=1 value being initialized (for min-content) with the largest
+    // of the resulting height of the previous row layout, the height specified on the corresponding table-row (if any), and the largest
+    // height specified on cells that span this row only (the algorithm starts by considering cells of span 2 on top of that assignment).
+    compute_table_measures<Row>();
+
     // Distribute the width of the table among columns.
     distribute_width_to_columns();
 
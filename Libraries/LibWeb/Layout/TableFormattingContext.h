@@ -45,6 +45,7 @@ private:
     CSSPixels compute_capmin();
     void compute_constrainedness();
     void compute_cell_measures();
+    void compute_cell_height_measures();
     void compute_outer_content_sizes();
     template<class RowOrColumn>
     void initialize_table_measures();
@@ -296,6 +296,7 @@ void TextNode::invalidate_text_for_rendering()
 {
     m_text_for_rendering = {};
     m_grapheme_segmenter.clear();
+    m_cached_chunks.clear();
 }
 
 Utf16String const& TextNode::text_for_rendering() const
@@ -403,9 +404,38 @@ Unicode::Segmenter& TextNode::grapheme_segmenter() const
     return *m_grapheme_segmenter;
 }
 
+Vector<TextNode::Chunk> const& TextNode::cached_chunks(bool should_wrap_lines, bool should_respect_linebreaks) const
+{
+    auto const& font_cascade_list = computed_values().font_list();
+    auto should_collapse_whitespace = first_is_one_of(computed_values().white_space_collapse(), CSS::WhiteSpaceCollapse::Collapse, CSS::WhiteSpaceCollapse::PreserveBreaks);
+
+    if (m_cached_chunks.has_value()
+        && m_cached_chunks->font_cascade_list.ptr() == &font_cascade_list
+        && m_cached_chunks->should_wrap_lines == should_wrap_lines
+        && m_cached_chunks->should_respect_linebreaks == should_respect_linebreaks
+        && m_cached_chunks->should_collapse_whitespace == should_collapse_whitespace) {
+        return m_cached_chunks->chunks;
+    }
+
+    Vector<Chunk> chunks;
+    ChunkIterator iterator { *this, text_for_rendering(), grapheme_segmenter(), should_wrap_lines, should_respect_linebreaks };
+    while (auto chunk = iterator.next_without_peek())
+        chunks.append(chunk.release_value());
+
+    m_cached_chunks = CachedChunks {
+        .font_cascade_list = font_cascade_list,
+        .should_wrap_lines = should_wrap_lines,
+        .should_respect_linebreaks = should_respect_linebreaks,
+        .should_collapse_whitespace = should_collapse_whitespace,
+        .chunks = move(chunks),
+    };
+    return m_cached_chunks->chunks;
+}
+
 TextNode::ChunkIterator::ChunkIterator(TextNode const& text_node, bool should_wrap_lines, bool should_respect_linebreaks)
     : ChunkIterator(text_node, text_node.text_for_rendering(), text_node.grapheme_segmenter(), should_wrap_lines, should_respect_linebreaks)
 {
+    m_cached_chunks = &text_node.cached_chunks(should_wrap_lines, should_respect_linebreaks);
 }
 
 TextNode::ChunkIterator::ChunkIterator(TextNode const& text_node, Utf16View const& text,
@@ -462,6 +492,12 @@ static Gfx::GlyphRun::TextType text_type_for_code_point(u32 code_point)
 
 Optional<TextNode::Chunk> TextNode::ChunkIterator::next()
 {
+    if (m_cached_chunks) {
+        if (m_cached_chunk_index >= m_cached_chunks->size())
+            return {};
+        return m_cached_chunks->at(m_cached_chunk_index++);
+    }
+
     if (!m_peek_queue.is_empty())
         return m_peek_queue.take_first();
     return next_without_peek();
@@ -469,6 +505,12 @@ Optional<TextNode::Chunk> TextNode::ChunkIterator::next()
 
 Optional<TextNode::Chunk> TextNode::ChunkIterator::peek(size_t count)
 {
+    if (m_cached_chunks) {
+        if (m_cached_chunk_index + count >= m_cached_chunks->size())
+            return {};
+        return m_cached_chunks->at(m_cached_chunk_index + count);
+    }
+
     while (m_peek_queue.size() <= count) {
         auto next = next_without_peek();
         if (!next.has_value())
@@ -55,6 +55,8 @@ public:
         Chunk create_empty_chunk();
 
     private:
+        friend class TextNode;
+
         Optional<Chunk> next_without_peek();
         Optional<Chunk> try_commit_chunk(size_t start, size_t end, bool has_breaking_newline, bool has_breaking_tab, Gfx::Font const&, Gfx::GlyphRun::TextType) const;
 
@@ -68,6 +70,10 @@ public:
         size_t m_current_index { 0 };
 
         Vector<Chunk> m_peek_queue;
+
+        // If set, chunks are replayed from the text node's cache instead of being computed from m_view.
+        Vector<Chunk> const* m_cached_chunks { nullptr };
+        size_t m_cached_chunk_index { 0 };
     };
 
     void invalidate_text_for_rendering();
@@ -81,8 +87,21 @@ private:
 
     void compute_text_for_rendering();
 
+    Vector<Chunk> const& cached_chunks(bool should_wrap_lines, bool should_respect_linebreaks) const;
+
     Optional<Utf16String> m_text_for_rendering;
     mutable OwnPtr<Unicode::Segmenter> m_grapheme_segmenter;
+
+    // The chunks (and thus the break opportunities) only depend on the text and a few style values, so we keep them
+    // around between layouts instead of segmenting the text again every time.
+    struct CachedChunks {
+        RefPtr<Gfx::FontCascadeList const> font_cascade_list;
+        bool should_wrap_lines { false };
+        bool should_respect_linebreaks { false };
+        bool should_collapse_whitespace { false };
+        Vector<Chunk> chunks;
+    };
+    mutable Optional<CachedChunks> m_cached_chunks;
 };
 
 template<>
@@ -14,6 +14,7 @@
 #include <LibWeb/Export.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/Page/Page.h>
+#include <RequestServer/RequestPriority.h>
 
 namespace Web {
 
@@ -41,6 +42,9 @@ public:
     ByteBuffer const& body() const { return m_body; }
     void set_body(ByteBuffer body) { m_body = move(body); }
 
+    RequestServer::RequestPriority priority() const { return m_priority; }
+    void set_priority(RequestServer::RequestPriority priority) { m_priority = priority; }
+
     bool store_set_cookie_headers() const { return m_store_set_cookie_headers; }
     void set_store_set_cookie_headers(bool store_set_cookie_headers) { m_store_set_cookie_headers = store_set_cookie_headers; }
 
@@ -87,6 +91,7 @@ private:
     Core::ElapsedTimer m_load_timer;
     GC::Root<Page> m_page;
     bool m_main_resource { false };
+    RequestServer::RequestPriority m_priority { RequestServer::RequestPriority::Normal };
     bool m_store_set_cookie_headers { true };
 };
 
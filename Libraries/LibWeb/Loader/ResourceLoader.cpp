@@ -6,9 +6,12 @@
  */
 
 #include <AK/Debug.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
 #include <LibCore/Directory.h>
 #include <LibCore/MimeData.h>
 #include <LibCore/Resource.h>
+#include <LibCore/Version.h>
 #include <LibGC/Function.h>
 #include <LibHTTP/HttpResponse.h>
 #include <LibRequests/Request.h>
@@ -441,6 +444,7 @@ void ResourceLoader::load(LoadRequest& request, GC::Root<SuccessCallback> succes
 
         auto on_buffered_request_finished = [this, success_callback, error_callback, request, &protocol_request = *protocol_request](auto, auto const& timing_info, auto const& network_error, auto& response_headers, auto status_code, auto const& reason_phrase, ReadonlyBytes payload) mutable {
             handle_network_response_headers(request, response_headers);
+            record_network_request(request, status_code, reason_phrase, response_headers, payload.size(), timing_info);
 
             // NOTE: We finish the network request *after* invoking callbacks, otherwise a nested
             //       event loop inside a callback may cause this function object to be destroyed
@@ -509,17 +513,32 @@ void ResourceLoader::load_unbuffered(LoadRequest& request, GC::Root<OnHeadersRec
         return;
     }
 
-    auto protocol_headers_received = [this, on_headers_received, request](auto const& response_headers, auto status_code, auto const& reason_phrase) {
+    // NOTE: Unlike buffered requests, the response is only known to the callbacks piece by piece, so we keep track of it
+    //       here for the network log.
+    struct UnbufferedResponse : public RefCounted<UnbufferedResponse> {
+        Optional<u32> status_code;
+        Optional<String> reason_phrase;
+        HTTP::HeaderMap headers;
+        u64 decoded_body_size { 0 };
+    };
+    auto response = adopt_ref(*new UnbufferedResponse);
+
+    auto protocol_headers_received = [this, on_headers_received, request, response](auto const& response_headers, auto status_code, auto const& reason_phrase) {
         handle_network_response_headers(request, response_headers);
+        response->status_code = status_code;
+        response->reason_phrase = reason_phrase;
+        response->headers = response_headers;
         on_headers_received->function()(response_headers, move(status_code), reason_phrase);
     };
 
-    auto protocol_data_received = [on_data_received](auto data) {
+    auto protocol_data_received = [on_data_received, response](auto data) {
+        response->decoded_body_size += data.size();
         on_data_received->function()(data);
     };
 
-    auto protocol_complete = [this, on_complete, request, &protocol_request = *protocol_request](u64, Requests::RequestTimingInfo const& timing_info, Optional<Requests::NetworkError> const& network_error) {
+    auto protocol_complete = [this, on_complete, request, response, &protocol_request = *protocol_request](u64, Requests::RequestTimingInfo const& timing_info, Optional<Requests::NetworkError> const& network_error) {
         finish_network_request(protocol_request);
+        record_network_request(request, response->status_code, response->reason_phrase, response->headers, response->decoded_body_size, timing_info);
 
         if (!network_error.has_value()) {
             log_success(request);
@@ -552,7 +571,7 @@ RefPtr<Requests::Request> ResourceLoader::start_network_request(LoadRequest cons
         return nullptr;
     }
 
-    auto protocol_request = m_request_client->start_request(request.method(), request.url().value(), headers, request.body(), proxy);
+    auto protocol_request = m_request_client->start_request(request.method(), request.url().value(), headers, request.body(), proxy, request.priority());
     if (!protocol_request) {
         log_failure(request, "Failed to initiate load"sv);
         return nullptr;
@@ -604,6 +623,128 @@ void ResourceLoader::finish_network_request(NonnullRefPtr<Requests::Request> pro
     });
 }
 
+void ResourceLoader::record_network_request(LoadRequest const& request, Optional<u32> status_code, Optional<String> const& reason_phrase, HTTP::HeaderMap const& response_headers, u64 decoded_body_size, Requests::RequestTimingInfo const& timing_info)
+{
+    if (!m_network_log)
+        m_network_log = make<CircularQueue<NetworkLogEntry, MAXIMUM_NETWORK_LOG_ENTRIES>>();
+
+    HTTP::HeaderMap request_headers;
+    for (auto const& header : request.headers())
+        request_headers.set(header.key, header.value);
+
+    auto load_time = request.load_time();
+
+    m_network_log->enqueue(NetworkLogEntry {
+        .url = request.url().value(),
+        .method = request.method(),
+        .request_headers = move(request_headers),
+        .start_time = UnixDateTime::now() - load_time,
+        .load_time = load_time,
+        .status_code = status_code,
+        .reason_phrase = reason_phrase,
+        .response_headers = response_headers,
+        .decoded_body_size = decoded_body_size,
+        .timing_info = timing_info,
+    });
+}
+
+// http://www.softwareishard.com/blog/har-12-spec/
+void ResourceLoader::dump_network_log() const
+{
+    auto serialize_optional_header = [](HTTP::HeaderMap const& headers, StringView name) {
+        if (auto value = headers.get(name); value.has_value())
+            return String::from_utf8_with_replacement_character(*value);
+        return String {};
+    };
+
+    auto serialize_headers = [](HTTP::HeaderMap const& headers) {
+        JsonArray serialized_headers;
+        for (auto const& header : headers.headers()) {
+            JsonObject serialized_header;
+            serialized_header.set("name"sv, String::from_utf8_with_replacement_character(header.name));
+            serialized_header.set("value"sv, String::from_utf8_with_replacement_character(header.value));
+            serialized_headers.must_append(move(serialized_header));
+        }
+        return serialized_headers;
+    };
+
+    // NOTE: HAR timings are durations in milliseconds, with -1 for phases that do not apply to the request.
+    auto duration_between = [](i64 start_microseconds, i64 end_microseconds) -> double {
+        if (end_microseconds < start_microseconds)
+            return -1;
+        return static_cast<double>(end_microseconds - start_microseconds) / 1000.0;
+    };
+
+    JsonArray entries;
+
+    if (m_network_log) {
+        for (auto const& entry : *m_network_log) {
+            auto const& timing_info = entry.timing_info;
+            auto http_version = Requests::alpn_http_version_to_fly_string(timing_info.http_version_alpn_identifier);
+
+            JsonObject request;
+            request.set("method"sv, String::from_utf8_with_replacement_character(entry.method));
+            request.set("url"sv, entry.url.serialize());
+            request.set("httpVersion"sv, http_version.to_string());
+            request.set("cookies"sv, JsonArray {});
+            request.set("headers"sv, serialize_headers(entry.request_headers));
+            request.set("queryString"sv, JsonArray {});
+            request.set("headersSize"sv, -1);
+            request.set("bodySize"sv, -1);
+
+            JsonObject content;
+            content.set("size"sv, entry.decoded_body_size);
+            content.set("mimeType"sv, serialize_optional_header(entry.response_headers, "Content-Type"sv));
+
+            JsonObject response;
+            response.set("status"sv, entry.status_code.value_or(0));
+            response.set("statusText"sv, entry.reason_phrase.value_or({}));
+            response.set("httpVersion"sv, http_version.to_string());
+            response.set("cookies"sv, JsonArray {});
+            response.set("headers"sv, serialize_headers(entry.response_headers));
+            response.set("content"sv, move(content));
+            response.set("redirectURL"sv, serialize_optional_header(entry.response_headers, "Location"sv));
+            response.set("headersSize"sv, -1);
+            response.set("bodySize"sv, timing_info.encoded_body_size);
+
+            auto has_secure_connection = timing_info.secure_connect_start_microseconds != 0;
+
+            JsonObject timings;
+            timings.set("blocked"sv, duration_between(timing_info.domain_lookup_end_microseconds, timing_info.connect_start_microseconds));
+            timings.set("dns"sv, duration_between(timing_info.domain_lookup_start_microseconds, timing_info.domain_lookup_end_microseconds));
+            timings.set("connect"sv, duration_between(timing_info.connect_start_microseconds, timing_info.connect_end_microseconds));
+            timings.set("ssl"sv, has_secure_connection ? duration_between(timing_info.secure_connect_start_microseconds, timing_info.connect_end_microseconds) : -1);
+            timings.set("send"sv, duration_between(timing_info.connect_end_microseconds, timing_info.request_start_microseconds));
+            timings.set("wait"sv, duration_between(timing_info.request_start_microseconds, timing_info.response_start_microseconds));
+            timings.set("receive"sv, duration_between(timing_info.response_start_microseconds, timing_info.response_end_microseconds));
+
+            JsonObject serialized_entry;
+            serialized_entry.set("startedDateTime"sv, MUST(entry.start_time.to_string("%Y-%m-%dT%H:%M:%SZ"sv, UnixDateTime::LocalTime::No)));
+            serialized_entry.set("time"sv, static_cast<double>(entry.load_time.to_microseconds()) / 1000.0);
+            serialized_entry.set("request"sv, move(request));
+            serialized_entry.set("response"sv, move(response));
+            serialized_entry.set("cache"sv, JsonObject {});
+            serialized_entry.set("timings"sv, move(timings));
+
+            entries.must_append(move(serialized_entry));
+        }
+    }
+
+    JsonObject creator;
+    creator.set("name"sv, "Ladybird"sv);
+    creator.set("version"sv, Core::Version::read_long_version_string());
+
+    JsonObject log;
+    log.set("version"sv, "1.2"sv);
+    log.set("creator"sv, move(creator));
+    log.set("entries"sv, move(entries));
+
+    JsonObject har;
+    har.set("log"sv, move(log));
+
+    dbgln("{}", har.serialized());
+}
+
 void ResourceLoader::clear_cache()
 {
     dbgln_if(CACHE_DEBUG, "Clearing {} items from ResourceLoader cache", s_resource_cache.size());
@@ -8,10 +8,14 @@
 #pragma once
 
 #include <AK/ByteString.h>
+#include <AK/CircularQueue.h>
 #include <AK/Function.h>
 #include <AK/HashTable.h>
+#include <AK/Time.h>
 #include <LibCore/EventReceiver.h>
+#include <LibHTTP/HeaderMap.h>
 #include <LibRequests/Forward.h>
+#include <LibRequests/RequestTimingInfo.h>
 #include <LibURL/URL.h>
 #include <LibWeb/Export.h>
 #include <LibWeb/Loader/Resource.h>
@@ -72,6 +76,9 @@ public:
     void clear_cache();
     void evict_from_cache(LoadRequest const&);
 
+    // Prints the most recent network requests and their timings as an HTTP Archive (HAR).
+    void dump_network_log() const;
+
     GC::Heap& heap() { return m_heap; }
 
 private:
@@ -80,6 +87,26 @@ private:
     RefPtr<Requests::Request> start_network_request(LoadRequest const&);
     void handle_network_response_headers(LoadRequest const&, HTTP::HeaderMap const&);
     void finish_network_request(NonnullRefPtr<Requests::Request>);
+    void record_network_request(LoadRequest const&, Optional<u32> status_code, Optional<String> const& reason_phrase, HTTP::HeaderMap const& response_headers, u64 decoded_body_size, Requests::RequestTimingInfo const&);
+
+    struct NetworkLogEntry {
+        URL::URL url;
+        ByteString method;
+        HTTP::HeaderMap request_headers;
+
+        UnixDateTime start_time;
+        AK::Duration load_time;
+
+        Optional<u32> status_code;
+        Optional<String> reason_phrase;
+        HTTP::HeaderMap response_headers;
+        u64 decoded_body_size { 0 };
+
+        Requests::RequestTimingInfo timing_info;
+    };
+
+    static constexpr size_t MAXIMUM_NETWORK_LOG_ENTRIES = 512;
+    OwnPtr<CircularQueue<NetworkLogEntry, MAXIMUM_NETWORK_LOG_ENTRIES>> m_network_log;
 
     int m_pending_loads { 0 };
 
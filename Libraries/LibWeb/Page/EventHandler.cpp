@@ -25,6 +25,7 @@
 #include <LibWeb/HTML/Navigator.h>
 #include <LibWeb/Layout/Label.h>
 #include <LibWeb/Layout/Viewport.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Page/DragAndDropEventHandler.h>
 #include <LibWeb/Page/EventHandler.h>
 #include <LibWeb/Page/Page.h>
@@ -876,6 +877,11 @@ EventResult EventHandler::handle_mousemove(CSSPixelPoint visual_viewport_positio
         if (is_hovering_link) {
             page.set_is_hovering_link(true);
             page.client().page_did_hover_link(*document.encoding_parse_url(hovered_link_element->href()));
+
+            // NOTE: Hovering over a link is a good hint that it is about to be followed, so we get a head start on
+            //       setting up a connection to its origin. Connections to the document's own origin are warm already.
+            if (auto url = document.encoding_parse_url(hovered_link_element->href()); url.has_value() && url->scheme().is_one_of("http"sv, "https"sv) && !url->origin().is_same_origin(document.origin()))
+                ResourceLoader::the().preconnect(*url);
         } else if (page.is_hovering_link()) {
             page.set_is_hovering_link(false);
             page.client().page_did_unhover_link();
@@ -34,13 +34,14 @@
 #include <LibWeb/HTML/SelectItem.h>
 #include <LibWeb/HTML/TokenizedFeatures.h>
 #include <LibWeb/HTML/WebViewHints.h>
+#include <LibWeb/IndexedDB/Internal/PersistedDatabase.h>
 #include <LibWeb/Loader/FileRequest.h>
 #include <LibWeb/Page/EventResult.h>
 #include <LibWeb/Page/InputEvent.h>
 #include <LibWeb/PixelUnits.h>
 #include <LibWeb/StorageAPI/StorageEndpoint.h>
+#include <LibWeb/StorageAPI/StorageItemChange.h>
 #include <LibWeb/UIEvents/KeyCode.h>
-#include <LibWebView/StorageOperationError.h>
 
 namespace Web {
 
@@ -363,11 +364,12 @@ public:
     virtual void page_did_set_cookie(URL::URL const&, Cookie::ParsedCookie const&, Cookie::Source) { }
     virtual void page_did_update_cookie(Web::Cookie::Cookie const&) { }
     virtual void page_did_expire_cookies_with_time_offset(AK::Duration) { }
-    virtual Optional<String> page_did_request_storage_item([[maybe_unused]] Web::StorageAPI::StorageEndpointType storage_endpoint, [[maybe_unused]] String const& storage_key, [[maybe_unused]] String const& bottle_key) { return {}; }
-    virtual WebView::StorageOperationError page_did_set_storage_item([[maybe_unused]] Web::StorageAPI::StorageEndpointType storage_endpoint, [[maybe_unused]] String const& storage_key, [[maybe_unused]] String const& bottle_key, [[maybe_unused]] String const& value) { return WebView::StorageOperationError::None; }
-    virtual void page_did_remove_storage_item([[maybe_unused]] Web::StorageAPI::StorageEndpointType storage_endpoint, [[maybe_unused]] String const& storage_key, [[maybe_unused]] String const& bottle_key) { }
-    virtual Vector<String> page_did_request_storage_keys([[maybe_unused]] Web::StorageAPI::StorageEndpointType storage_endpoint, [[maybe_unused]] String const& storage_key) { return {}; }
-    virtual void page_did_clear_storage([[maybe_unused]] Web::StorageAPI::StorageEndpointType storage_endpoint, [[maybe_unused]] String const& storage_key) { }
+    virtual HashMap<String, String> page_did_request_storage_items([[maybe_unused]] Web::StorageAPI::StorageEndpointType storage_endpoint, [[maybe_unused]] String const& storage_key) { return {}; }
+    virtual void page_did_update_storage_items([[maybe_unused]] Web::StorageAPI::StorageEndpointType storage_endpoint, [[maybe_unused]] String const& storage_key, [[maybe_unused]] Vector<Web::StorageAPI::StorageItemChange> const& changes) { }
+    virtual Optional<IndexedDB::PersistedDatabase> page_did_request_indexed_db_database([[maybe_unused]] String const& storage_key, [[maybe_unused]] String const& name) { return {}; }
+    virtual HashMap<String, u64> page_did_request_indexed_db_database_versions([[maybe_unused]] String const& storage_key) { return {}; }
+    virtual void page_did_commit_indexed_db_transaction([[maybe_unused]] String const& storage_key, [[maybe_unused]] String const& name, [[maybe_unused]] IndexedDB::PersistedDatabaseChanges const& changes) { }
+    virtual void page_did_delete_indexed_db_database([[maybe_unused]] String const& storage_key, [[maybe_unused]] String const& name) { }
     virtual void page_did_update_resource_count(i32) { }
     struct NewWebViewResult {
         GC::Ptr<Page> page;
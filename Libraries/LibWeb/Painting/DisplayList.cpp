@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <AK/TemporaryChange.h>
+#include <LibCore/Trace.h>
 #include <LibWeb/Painting/DevicePixelConverter.h>
 #include <LibWeb/Painting/DisplayList.h>
 
@@ -15,6 +17,120 @@ void DisplayList::append(DisplayListCommand&& command, Optional<i32> scroll_fram
     m_commands.append({ scroll_frame_id, clip_frame, move(command) });
 }
 
+bool DisplayList::update_stacking_context_opacity(PaintableBox const& paintable_box, float opacity)
+{
+    auto index = m_stacking_context_command_index_by_paintable_box.get(&paintable_box);
+    if (!index.has_value())
+        return false;
+    m_commands[*index].command.get<PushStackingContext>().opacity = opacity;
+    return true;
+}
+
+bool DisplayList::update_stacking_context_transform(PaintableBox const& paintable_box, StackingContextTransform const& transform)
+{
+    auto index = m_stacking_context_command_index_by_paintable_box.get(&paintable_box);
+    if (!index.has_value())
+        return false;
+    auto& push_stacking_context = m_commands[*index].command.get<PushStackingContext>();
+    if (push_stacking_context.transform.is_identity() || transform.is_identity())
+        return false;
+    push_stacking_context.transform = transform;
+    return true;
+}
+
+void DisplayList::remove_commands_without_effect()
+{
+    auto nesting_level_change = [](DisplayListCommand const& command) {
+        return command.visit([](auto const& command) {
+            if constexpr (requires { command.nesting_level_change; })
+                return command.nesting_level_change;
+            return 0;
+        });
+    };
+
+    // Opens a group that has no effect if nothing visible is painted in it.
+    auto can_be_removed_when_empty = [](DisplayListCommand const& command) {
+        if (auto const* push_stacking_context = command.get_pointer<PushStackingContext>())
+            return push_stacking_context->compositing_and_blending_operator == Gfx::CompositingAndBlendingOperator::Normal;
+        return command.has<Save>() || command.has<SaveLayer>() || command.has<ApplyOpacity>();
+    };
+
+    // Only changes the state of the enclosing group, which is dropped again when the group ends.
+    auto only_changes_state = [](DisplayListCommand const& command) {
+        return command.has<Translate>()
+            || command.has<AddClipRect>()
+            || command.has<AddRoundedRectClip>()
+            || command.has<AddMask>()
+            || command.has<ApplyTransform>()
+            || command.has<ApplyMaskBitmap>();
+    };
+
+    struct Group {
+        size_t first_command_index { 0 };
+        bool has_visible_effect { false };
+    };
+    Vector<Group> groups;
+    Vector<bool> is_removed;
+    is_removed.resize(m_commands.size());
+    size_t removed_command_count = 0;
+
+    for (size_t index = 0; index < m_commands.size(); ++index) {
+        auto const& command = m_commands[index].command;
+        auto change = nesting_level_change(command);
+        if (change > 0) {
+            groups.append({ index, false });
+            continue;
+        }
+        if (change < 0) {
+            auto group = groups.take_last();
+            auto const& first_command = m_commands[group.first_command_index].command;
+            if (!group.has_visible_effect && group.first_command_index > VISUAL_VIEWPORT_TRANSFORM_INDEX && can_be_removed_when_empty(first_command)) {
+                for (auto removed_index = group.first_command_index; removed_index <= index; ++removed_index) {
+                    if (!is_removed[removed_index]) {
+                        is_removed[removed_index] = true;
+                        ++removed_command_count;
+                    }
+                }
+            } else if (!groups.is_empty()) {
+                groups.last().has_visible_effect = true;
+            }
+            continue;
+        }
+        if (!only_changes_state(command) && !groups.is_empty())
+            groups.last().has_visible_effect = true;
+    }
+
+    dbgln_if(LIBWEB_DISPLAY_LIST_DEBUG, "DisplayList: Removed {} of {} commands without effect", removed_command_count, m_commands.size());
+    if (removed_command_count == 0)
+        return;
+
+    Vector<size_t> new_index_by_old_index;
+    new_index_by_old_index.resize(m_commands.size());
+    AK::SegmentedVector<DisplayListCommandWithScrollAndClip, 512> commands;
+    Vector<size_t> push_stacking_context_indices;
+    for (size_t index = 0; index < m_commands.size(); ++index) {
+        if (is_removed[index])
+            continue;
+        new_index_by_old_index[index] = commands.size();
+        commands.append(move(m_commands[index]));
+        auto& command = commands[commands.size() - 1].command;
+        if (command.has<PushStackingContext>()) {
+            push_stacking_context_indices.append(commands.size() - 1);
+        } else if (command.has<PopStackingContext>()) {
+            auto push_index = push_stacking_context_indices.take_last();
+            commands[push_index].command.get<PushStackingContext>().matching_pop_index = commands.size() - 1;
+        }
+    }
+
+    m_stacking_context_command_index_by_paintable_box.remove_all_matching([&](auto const&, size_t index) {
+        return is_removed[index];
+    });
+    for (auto& it : m_stacking_context_command_index_by_paintable_box)
+        it.value = new_index_by_old_index[it.value];
+
+    m_commands = move(commands);
+}
+
 String DisplayList::dump() const
 {
     StringBuilder builder;
@@ -66,14 +182,14 @@ static bool command_is_clip_or_mask(DisplayListCommand const& command)
         });
 }
 
-void DisplayListPlayer::execute(DisplayList& display_list, ScrollStateSnapshotByDisplayList&& scroll_state_snapshot_by_display_list, RefPtr<Gfx::PaintingSurface> surface)
+void DisplayListPlayer::execute(DisplayList& display_list, ScrollStateSnapshotByDisplayList&& scroll_state_snapshot_by_display_list, RefPtr<Gfx::PaintingSurface> surface, Optional<Gfx::IntRect> damage_rect)
 {
     TemporaryChange change { m_scroll_state_snapshots_by_display_list, move(scroll_state_snapshot_by_display_list) };
     if (surface) {
         surface->lock_context();
     }
     auto scroll_state_snapshot = m_scroll_state_snapshots_by_display_list.get(display_list).value_or({});
-    execute_impl(display_list, scroll_state_snapshot, surface);
+    execute_impl(display_list, scroll_state_snapshot, surface, damage_rect);
     if (surface) {
         surface->unlock_context();
     }
@@ -109,7 +225,7 @@ void DisplayListPlayer::remove_clip_frame(ClipFrame const& clip_frame)
     restore({});
 }
 
-void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnapshot const& scroll_state, RefPtr<Gfx::PaintingSurface> surface)
+void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnapshot const& scroll_state, RefPtr<Gfx::PaintingSurface> surface, Optional<Gfx::IntRect> damage_rect)
 {
     if (surface)
         m_surfaces.append(*surface);
@@ -125,6 +241,13 @@ void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnaps
 
     VERIFY(!m_surfaces.is_empty());
 
+    // NOTE: Clipping to the damage rect is enough to skip everything outside of it, since commands that would be
+    //       fully clipped by the painter are culled below.
+    if (damage_rect.has_value()) {
+        save({});
+        add_clip_rect({ .rect = *damage_rect });
+    }
+
     auto translate_command_by_scroll = [&](auto& command, int scroll_frame_id) {
         auto cumulative_offset = scroll_state.cumulative_offset_for_frame_with_id(scroll_frame_id);
         auto scroll_offset = cumulative_offset.to_type<double>().scaled(device_pixels_per_css_pixel).to_type<int>();
@@ -147,6 +270,24 @@ void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnaps
         return bounding_rect;
     };
 
+    // Unites the bounding rects of the commands painted into the filter's layer. Returns nothing if any of them (including
+    // nested saves and clips) doesn't have one.
+    auto compute_filter_content_bounds = [&](size_t apply_filter_index) -> Optional<Gfx::IntRect> {
+        Gfx::IntRect bounding_rect;
+        for (auto index = apply_filter_index + 1; index < commands.size(); ++index) {
+            auto [scroll_frame_id, clip_frame, command] = commands[index];
+            if (command.has<Restore>())
+                return bounding_rect;
+            if (scroll_frame_id.has_value())
+                translate_command_by_scroll(command, scroll_frame_id.value());
+            auto command_bounding_rect = command_bounding_rectangle(command);
+            if (!command_bounding_rect.has_value())
+                return {};
+            bounding_rect.unite(*command_bounding_rect);
+        }
+        return {};
+    };
+
     Vector<RefPtr<ClipFrame const>> clip_frames_stack;
     clip_frames_stack.append({});
     for (size_t command_index = 0; command_index < commands.size(); command_index++) {
@@ -199,6 +340,11 @@ void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnaps
             }
         }
 
+        // OPTIMIZATION: Without bounds, the filter's layer is as large as the clip, and the filter is applied to all of
+        //               it. Bounding it by its content makes filtering small elements a lot cheaper.
+        if (command.has<ApplyFilter>())
+            command.get<ApplyFilter>().content_bounds = compute_filter_content_bounds(command_index);
+
         if (bounding_rect.has_value() && (bounding_rect->is_empty() || would_be_fully_clipped_by_painter(*bounding_rect))) {
             // Any clip or mask that's located outside of the visible region is equivalent to a simple clip-rect,
             // so replace it with one to avoid doing unnecessary work.
@@ -268,8 +414,13 @@ void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnaps
         }
     }
 
-    if (surface)
+    if (damage_rect.has_value())
+        restore({});
+
+    if (surface) {
+        Core::TraceScope trace_scope("Flush"sv);
         flush();
+    }
 }
 
 }
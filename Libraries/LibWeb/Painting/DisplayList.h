@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/SegmentedVector.h>
 #include <LibGfx/Color.h>
@@ -26,11 +27,12 @@ class DisplayListPlayer {
 public:
     virtual ~DisplayListPlayer() = default;
 
-    void execute(DisplayList&, ScrollStateSnapshotByDisplayList&&, RefPtr<Gfx::PaintingSurface>);
+    // If a damage rect is given, only the pixels inside of it are repainted, and the rest of the surface is left untouched.
+    void execute(DisplayList&, ScrollStateSnapshotByDisplayList&&, RefPtr<Gfx::PaintingSurface>, Optional<Gfx::IntRect> damage_rect = {});
 
 protected:
     Gfx::PaintingSurface& surface() const { return m_surfaces.last(); }
-    void execute_impl(DisplayList&, ScrollStateSnapshot const& scroll_state, RefPtr<Gfx::PaintingSurface>);
+    void execute_impl(DisplayList&, ScrollStateSnapshot const& scroll_state, RefPtr<Gfx::PaintingSurface>, Optional<Gfx::IntRect> damage_rect = {});
 
     ScrollStateSnapshotByDisplayList m_scroll_state_snapshots_by_display_list;
 
@@ -79,6 +81,12 @@ private:
     Vector<NonnullRefPtr<Gfx::PaintingSurface>, 1> m_surfaces;
 };
 
+struct DisplayListCommandWithScrollAndClip {
+    Optional<i32> scroll_frame_id;
+    RefPtr<ClipFrame const> clip_frame;
+    DisplayListCommand command;
+};
+
 class DisplayList : public AtomicRefCounted<DisplayList> {
 public:
     static NonnullRefPtr<DisplayList> create(double device_pixels_per_css_pixel)
@@ -88,12 +96,6 @@ public:
 
     void append(DisplayListCommand&& command, Optional<i32> scroll_frame_id, RefPtr<ClipFrame const>);
 
-    struct DisplayListCommandWithScrollAndClip {
-        Optional<i32> scroll_frame_id;
-        RefPtr<ClipFrame const> clip_frame;
-        DisplayListCommand command;
-    };
-
     auto& commands(Badge<DisplayListRecorder>) { return m_commands; }
     auto const& commands() const { return m_commands; }
     double device_pixels_per_css_pixel() const { return m_device_pixels_per_css_pixel; }
@@ -112,6 +114,18 @@ public:
     static constexpr size_t VISUAL_VIEWPORT_TRANSFORM_INDEX = 1;
     void set_visual_viewport_transform(Gfx::FloatMatrix4x4 t) { m_commands[VISUAL_VIEWPORT_TRANSFORM_INDEX].command.get<ApplyTransform>().matrix = t; }
 
+    void set_stacking_context_command_index(Badge<DisplayListRecorder>, PaintableBox const& paintable_box, size_t index) { m_stacking_context_command_index_by_paintable_box.set(&paintable_box, index); }
+    // Updates the opacity of the stacking context recorded for the given paintable box without re-recording the
+    // display list. Returns false if no stacking context was recorded for it.
+    bool update_stacking_context_opacity(PaintableBox const&, float opacity);
+    // Same for the transform. Only a non-identity transform can replace another one, since the recorded commands
+    // differ depending on whether the stacking context is transformed at all.
+    bool update_stacking_context_transform(PaintableBox const&, StackingContextTransform const&);
+
+    // Removes groups of commands that can't have any visible effect, such as a Save followed by a clip and a Restore.
+    // Has to be called while the recorder's outermost Save is still unmatched.
+    void remove_commands_without_effect();
+
 private:
     DisplayList(double device_pixels_per_css_pixel)
         : m_device_pixels_per_css_pixel(device_pixels_per_css_pixel)
@@ -121,6 +135,7 @@ private:
     AK::SegmentedVector<DisplayListCommandWithScrollAndClip, 512> m_commands;
     double m_device_pixels_per_css_pixel;
     Optional<Gfx::FloatMatrix4x4> m_visual_viewport_transform;
+    HashMap<PaintableBox const*, size_t> m_stacking_context_command_index_by_paintable_box;
 };
 
 }
@@ -37,6 +37,8 @@ namespace Web::Painting {
 class DisplayList;
 
 struct DrawGlyphRun {
+    static constexpr StringView command_name = "DrawGlyphRun"sv;
+
     NonnullRefPtr<Gfx::GlyphRun const> glyph_run;
     double scale { 1 };
     Gfx::IntRect rect;
@@ -51,6 +53,8 @@ struct DrawGlyphRun {
 };
 
 struct FillRect {
+    static constexpr StringView command_name = "FillRect"sv;
+
     Gfx::IntRect rect;
     Color color;
 
@@ -60,6 +64,8 @@ struct FillRect {
 };
 
 struct DrawPaintingSurface {
+    static constexpr StringView command_name = "DrawPaintingSurface"sv;
+
     Gfx::IntRect dst_rect;
     NonnullRefPtr<Gfx::PaintingSurface const> surface;
     Gfx::IntRect src_rect;
@@ -71,6 +77,8 @@ struct DrawPaintingSurface {
 };
 
 struct DrawScaledImmutableBitmap {
+    static constexpr StringView command_name = "DrawScaledImmutableBitmap"sv;
+
     Gfx::IntRect dst_rect;
     Gfx::IntRect clip_rect;
     NonnullRefPtr<Gfx::ImmutableBitmap const> bitmap;
@@ -86,6 +94,8 @@ struct DrawScaledImmutableBitmap {
 };
 
 struct DrawRepeatedImmutableBitmap {
+    static constexpr StringView command_name = "DrawRepeatedImmutableBitmap"sv;
+
     struct Repeat {
         bool x { false };
         bool y { false };
@@ -102,24 +112,29 @@ struct DrawRepeatedImmutableBitmap {
 };
 
 struct Save {
+    static constexpr StringView command_name = "Save"sv;
     static constexpr int nesting_level_change = 1;
 
     void dump(StringBuilder&) const;
 };
 
 struct SaveLayer {
+    static constexpr StringView command_name = "SaveLayer"sv;
     static constexpr int nesting_level_change = 1;
 
     void dump(StringBuilder&) const;
 };
 
 struct Restore {
+    static constexpr StringView command_name = "Restore"sv;
     static constexpr int nesting_level_change = -1;
 
     void dump(StringBuilder&) const;
 };
 
 struct Translate {
+    static constexpr StringView command_name = "Translate"sv;
+
     Gfx::IntPoint delta;
 
     void translate_by(Gfx::IntPoint const& offset) { delta.translate_by(offset); }
@@ -127,6 +142,8 @@ struct Translate {
 };
 
 struct AddClipRect {
+    static constexpr StringView command_name = "AddClipRect"sv;
+
     Gfx::IntRect rect;
 
     [[nodiscard]] Gfx::IntRect bounding_rect() const { return rect; }
@@ -136,6 +153,7 @@ struct AddClipRect {
 };
 
 struct PushStackingContext {
+    static constexpr StringView command_name = "PushStackingContext"sv;
     static constexpr int nesting_level_change = 1;
 
     float opacity;
@@ -160,12 +178,15 @@ struct PushStackingContext {
 };
 
 struct PopStackingContext {
+    static constexpr StringView command_name = "PopStackingContext"sv;
     static constexpr int nesting_level_change = -1;
 
     void dump(StringBuilder&) const;
 };
 
 struct PaintLinearGradient {
+    static constexpr StringView command_name = "PaintLinearGradient"sv;
+
     Gfx::IntRect gradient_rect;
     LinearGradientData linear_gradient_data;
 
@@ -179,6 +200,8 @@ struct PaintLinearGradient {
 };
 
 struct PaintOuterBoxShadow {
+    static constexpr StringView command_name = "PaintOuterBoxShadow"sv;
+
     PaintBoxShadowParams box_shadow_params;
 
     [[nodiscard]] Gfx::IntRect bounding_rect() const;
@@ -187,6 +210,8 @@ struct PaintOuterBoxShadow {
 };
 
 struct PaintInnerBoxShadow {
+    static constexpr StringView command_name = "PaintInnerBoxShadow"sv;
+
     PaintBoxShadowParams box_shadow_params;
 
     [[nodiscard]] Gfx::IntRect bounding_rect() const;
@@ -195,6 +220,8 @@ struct PaintInnerBoxShadow {
 };
 
 struct PaintTextShadow {
+    static constexpr StringView command_name = "PaintTextShadow"sv;
+
     NonnullRefPtr<Gfx::GlyphRun const> glyph_run;
     double glyph_run_scale { 1 };
     Gfx::IntRect shadow_bounding_rect;
@@ -209,6 +236,8 @@ struct PaintTextShadow {
 };
 
 struct FillRectWithRoundedCorners {
+    static constexpr StringView command_name = "FillRectWithRoundedCorners"sv;
+
     Gfx::IntRect rect;
     Color color;
     CornerRadii corner_radii;
@@ -219,6 +248,8 @@ struct FillRectWithRoundedCorners {
 };
 
 struct FillPath {
+    static constexpr StringView command_name = "FillPath"sv;
+
     Gfx::IntRect path_bounding_rect;
     Gfx::Path path;
     float opacity { 1.0f };
@@ -237,6 +268,8 @@ struct FillPath {
 };
 
 struct StrokePath {
+    static constexpr StringView command_name = "StrokePath"sv;
+
     Gfx::Path::CapStyle cap_style;
     Gfx::Path::JoinStyle join_style;
     float miter_limit;
@@ -260,6 +293,8 @@ struct StrokePath {
 };
 
 struct DrawEllipse {
+    static constexpr StringView command_name = "DrawEllipse"sv;
+
     Gfx::IntRect rect;
     Color color;
     int thickness;
@@ -274,6 +309,8 @@ struct DrawEllipse {
 };
 
 struct FillEllipse {
+    static constexpr StringView command_name = "FillEllipse"sv;
+
     Gfx::IntRect rect;
     Color color;
 
@@ -287,6 +324,8 @@ struct FillEllipse {
 };
 
 struct DrawLine {
+    static constexpr StringView command_name = "DrawLine"sv;
+
     Color color;
     Gfx::IntPoint from;
     Gfx::IntPoint to;
@@ -303,6 +342,8 @@ struct DrawLine {
 };
 
 struct ApplyBackdropFilter {
+    static constexpr StringView command_name = "ApplyBackdropFilter"sv;
+
     Gfx::IntRect backdrop_region;
     BorderRadiiData border_radii_data;
     Optional<Gfx::Filter> backdrop_filter;
@@ -317,6 +358,8 @@ struct ApplyBackdropFilter {
 };
 
 struct DrawRect {
+    static constexpr StringView command_name = "DrawRect"sv;
+
     Gfx::IntRect rect;
     Color color;
     bool rough;
@@ -328,6 +371,8 @@ struct DrawRect {
 };
 
 struct PaintRadialGradient {
+    static constexpr StringView command_name = "PaintRadialGradient"sv;
+
     Gfx::IntRect rect;
     RadialGradientData radial_gradient_data;
     Gfx::IntPoint center;
@@ -340,6 +385,8 @@ struct PaintRadialGradient {
 };
 
 struct PaintConicGradient {
+    static constexpr StringView command_name = "PaintConicGradient"sv;
+
     Gfx::IntRect rect;
     ConicGradientData conic_gradient_data;
     Gfx::IntPoint position;
@@ -351,6 +398,8 @@ struct PaintConicGradient {
 };
 
 struct AddRoundedRectClip {
+    static constexpr StringView command_name = "AddRoundedRectClip"sv;
+
     CornerRadii corner_radii;
     Gfx::IntRect border_rect;
     CornerClip corner_clip;
@@ -363,6 +412,8 @@ struct AddRoundedRectClip {
 };
 
 struct AddMask {
+    static constexpr StringView command_name = "AddMask"sv;
+
     RefPtr<DisplayList> display_list;
     Gfx::IntRect rect;
 
@@ -378,6 +429,8 @@ struct AddMask {
 };
 
 struct PaintNestedDisplayList {
+    static constexpr StringView command_name = "PaintNestedDisplayList"sv;
+
     RefPtr<DisplayList> display_list;
     Gfx::IntRect rect;
 
@@ -391,6 +444,8 @@ struct PaintNestedDisplayList {
 };
 
 struct PaintScrollBar {
+    static constexpr StringView command_name = "PaintScrollBar"sv;
+
     int scroll_frame_id { 0 };
     Gfx::IntRect gutter_rect;
     Gfx::IntRect thumb_rect;
@@ -408,6 +463,8 @@ struct PaintScrollBar {
 };
 
 struct ApplyOpacity {
+    static constexpr StringView command_name = "ApplyOpacity"sv;
+
     // Implementation of this item does saveLayer(), so we need to increment the nesting level.
     static constexpr int nesting_level_change = 1;
 
@@ -416,6 +473,8 @@ struct ApplyOpacity {
 };
 
 struct ApplyCompositeAndBlendingOperator {
+    static constexpr StringView command_name = "ApplyCompositeAndBlendingOperator"sv;
+
     // Implementation of this item does saveLayer(), so we need to increment the nesting level.
     static constexpr int nesting_level_change = 1;
 
@@ -424,14 +483,20 @@ struct ApplyCompositeAndBlendingOperator {
 };
 
 struct ApplyFilter {
+    static constexpr StringView command_name = "ApplyFilter"sv;
+
     // Implementation of this item does saveLayer(), so we need to increment the nesting level.
     static constexpr int nesting_level_change = 1;
 
     Gfx::Filter filter;
+    // Bounds of everything painted until the matching Restore, if they can be computed. Filled in during playback.
+    Optional<Gfx::IntRect> content_bounds {};
     void dump(StringBuilder&) const;
 };
 
 struct ApplyTransform {
+    static constexpr StringView command_name = "ApplyTransform"sv;
+
     Gfx::FloatPoint origin;
     Gfx::FloatMatrix4x4 matrix;
 
@@ -443,6 +508,8 @@ struct ApplyTransform {
 };
 
 struct ApplyMaskBitmap {
+    static constexpr StringView command_name = "ApplyMaskBitmap"sv;
+
     Gfx::IntPoint origin;
     NonnullRefPtr<Gfx::ImmutableBitmap const> bitmap;
     Gfx::Bitmap::MaskKind kind;
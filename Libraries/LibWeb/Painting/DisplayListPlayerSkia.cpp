@@ -9,11 +9,13 @@
 #include <core/SkBlurTypes.h>
 #include <core/SkCanvas.h>
 #include <core/SkFont.h>
+#include <core/SkImage.h>
 #include <core/SkMaskFilter.h>
 #include <core/SkPath.h>
 #include <core/SkPathEffect.h>
 #include <core/SkRRect.h>
 #include <core/SkSurface.h>
+#include <core/SkTextBlob.h>
 #include <effects/SkDashPathEffect.h>
 #include <effects/SkGradientShader.h>
 #include <effects/SkImageFilters.h>
@@ -22,6 +24,8 @@
 #include <gpu/ganesh/SkSurfaceGanesh.h>
 #include <pathops/SkPathOps.h>
 
+#include <AK/BitCast.h>
+#include <AK/HashMap.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/PainterSkia.h>
 #include <LibGfx/PathSkia.h>
@@ -74,13 +78,45 @@ static SkMatrix to_skia_matrix(Gfx::AffineTransform const& affine_transform)
 
 void DisplayListPlayerSkia::flush()
 {
-    if (m_context)
+    if (m_context) {
         m_context->flush_and_submit(&surface().sk_surface());
+        m_context->upload_prepared_textures();
+    }
     surface().flush();
 }
 
+SkImage const* DisplayListPlayerSkia::image_for_bitmap(Gfx::ImmutableBitmap const& bitmap) const
+{
+    if (m_context)
+        return m_context->texture_for_bitmap(bitmap);
+    return bitmap.sk_image();
+}
+
 void DisplayListPlayerSkia::draw_glyph_run(DrawGlyphRun const& command)
 {
+    SkPaint paint;
+    paint.setColor(to_skia_color(command.color));
+
+    auto& canvas = surface().canvas();
+
+    // OPTIMIZATION: Draw the text blob cached on the glyph run, so that it doesn't have to be built again for every
+    //               frame and Skia can reuse whatever it has cached for it.
+    if (auto* text_blob = command.glyph_run->cached_text_blob(command.scale)) {
+        switch (command.orientation) {
+        case Gfx::Orientation::Horizontal:
+            canvas.drawTextBlob(text_blob, command.translation.x(), command.translation.y(), paint);
+            break;
+        case Gfx::Orientation::Vertical:
+            canvas.save();
+            canvas.translate(command.rect.width(), 0);
+            canvas.rotate(90, command.rect.top_left().x(), command.rect.top_left().y());
+            canvas.drawTextBlob(text_blob, command.translation.x(), command.translation.y(), paint);
+            canvas.restore();
+            break;
+        }
+        return;
+    }
+
     auto const& gfx_font = command.glyph_run->font();
     auto sk_font = gfx_font.skia_font(command.scale);
 
@@ -99,10 +135,6 @@ void DisplayListPlayerSkia::draw_glyph_run(DrawGlyphRun const& command)
         positions.append(to_skia_point(point));
     }
 
-    SkPaint paint;
-    paint.setColor(to_skia_color(command.color));
-
-    auto& canvas = surface().canvas();
     switch (command.orientation) {
     case Gfx::Orientation::Horizontal:
         canvas.drawGlyphs(glyphs.size(), glyphs.data(), positions.data(), to_skia_point(command.translation), sk_font, paint);
@@ -146,7 +178,7 @@ void DisplayListPlayerSkia::draw_scaled_immutable_bitmap(DrawScaledImmutableBitm
     SkPaint paint;
     canvas.save();
     canvas.clipRect(clip_rect);
-    canvas.drawImageRect(command.bitmap->sk_image(), dst_rect, to_skia_sampling_options(command.scaling_mode), &paint);
+    canvas.drawImageRect(image_for_bitmap(*command.bitmap), dst_rect, to_skia_sampling_options(command.scaling_mode), &paint);
     canvas.restore();
 }
 
@@ -161,7 +193,7 @@ void DisplayListPlayerSkia::draw_repeated_immutable_bitmap(DrawRepeatedImmutable
 
     auto tile_mode_x = command.repeat.x ? SkTileMode::kRepeat : SkTileMode::kDecal;
     auto tile_mode_y = command.repeat.y ? SkTileMode::kRepeat : SkTileMode::kDecal;
-    auto shader = command.bitmap->sk_image()->makeShader(tile_mode_x, tile_mode_y, sampling_options, matrix);
+    auto shader = image_for_bitmap(*command.bitmap)->makeShader(tile_mode_x, tile_mode_y, sampling_options, matrix);
 
     SkPaint paint;
     paint.setShader(shader);
@@ -460,6 +492,97 @@ static void add_spread_distance_to_border_radius(int& border_radius, int spread_
     }
 }
 
+struct OuterBoxShadowKey {
+    Gfx::IntSize size;
+    CornerRadii corner_radii;
+    int blur_radius { 0 };
+    Gfx::Color color;
+
+    bool operator==(OuterBoxShadowKey const& other) const
+    {
+        auto corner_radius_equals = [](CornerRadius const& a, CornerRadius const& b) {
+            return a.horizontal_radius == b.horizontal_radius && a.vertical_radius == b.vertical_radius;
+        };
+        return size == other.size
+            && corner_radius_equals(corner_radii.top_left, other.corner_radii.top_left)
+            && corner_radius_equals(corner_radii.top_right, other.corner_radii.top_right)
+            && corner_radius_equals(corner_radii.bottom_right, other.corner_radii.bottom_right)
+            && corner_radius_equals(corner_radii.bottom_left, other.corner_radii.bottom_left)
+            && blur_radius == other.blur_radius
+            && color == other.color;
+    }
+};
+
+struct OuterBoxShadowKeyTraits : public DefaultTraits<OuterBoxShadowKey> {
+    static unsigned hash(OuterBoxShadowKey const& key)
+    {
+        auto hash = pair_int_hash(key.size.width(), key.size.height());
+        for (auto const* corner_radius : { &key.corner_radii.top_left, &key.corner_radii.top_right, &key.corner_radii.bottom_right, &key.corner_radii.bottom_left })
+            hash = pair_int_hash(hash, pair_int_hash(corner_radius->horizontal_radius, corner_radius->vertical_radius));
+        hash = pair_int_hash(hash, key.blur_radius);
+        return pair_int_hash(hash, key.color.value());
+    }
+};
+
+// Blurring is by far the most expensive part of painting a shadow, and pages tend to repeat the same shadow on many
+// boxes of the same size. So we keep the blurred shadows around and only draw them at the right position.
+struct DisplayListPlayerSkia::CachedShadows {
+    static constexpr size_t max_byte_size_per_shadow = 4 * MiB;
+    static constexpr size_t max_total_byte_size = 16 * MiB;
+
+    struct Shadow {
+        sk_sp<SkImage> image;
+        int margin { 0 };
+        size_t byte_size { 0 };
+        u64 last_use { 0 };
+    };
+
+    Shadow const* outer_box_shadow(RefPtr<Gfx::SkiaBackendContext> const&, OuterBoxShadowKey const&, SkPaint const&);
+
+    HashMap<OuterBoxShadowKey, Shadow, OuterBoxShadowKeyTraits> outer_box_shadows;
+    size_t total_byte_size { 0 };
+    u64 use_counter { 0 };
+};
+
+DisplayListPlayerSkia::CachedShadows& DisplayListPlayerSkia::cached_shadows()
+{
+    if (!m_cached_shadows)
+        m_cached_shadows = make<DisplayListPlayerSkia::CachedShadows>();
+    return *m_cached_shadows;
+}
+
+DisplayListPlayerSkia::CachedShadows::Shadow const* DisplayListPlayerSkia::CachedShadows::outer_box_shadow(RefPtr<Gfx::SkiaBackendContext> const& context, OuterBoxShadowKey const& key, SkPaint const& paint)
+{
+    if (auto it = outer_box_shadows.find(key); it != outer_box_shadows.end()) {
+        it->value.last_use = ++use_counter;
+        return &it->value;
+    }
+
+    // The blur with a sigma of half the blur radius fades out completely within three sigmas.
+    auto margin = (key.blur_radius * 3 + 1) / 2 + 1;
+    Gfx::IntSize image_size { key.size.width() + 2 * margin, key.size.height() + 2 * margin };
+    auto byte_size = static_cast<size_t>(image_size.width()) * image_size.height() * 4;
+    if (byte_size > max_byte_size_per_shadow)
+        return nullptr;
+
+    auto shadow_surface = Gfx::PaintingSurface::create_with_size(context, image_size, Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied);
+    shadow_surface->canvas().drawRRect(to_skia_rrect(Gfx::IntRect { { margin, margin }, key.size }, key.corner_radii), paint);
+
+    while (total_byte_size + byte_size > max_total_byte_size && !outer_box_shadows.is_empty()) {
+        auto least_recently_used = outer_box_shadows.begin();
+        for (auto it = outer_box_shadows.begin(); it != outer_box_shadows.end(); ++it) {
+            if (it->value.last_use < least_recently_used->value.last_use)
+                least_recently_used = it;
+        }
+        total_byte_size -= least_recently_used->value.byte_size;
+        outer_box_shadows.remove(least_recently_used);
+    }
+
+    total_byte_size += byte_size;
+    outer_box_shadows.set(key, Shadow { shadow_surface->sk_surface().makeImageSnapshot(), margin, byte_size, ++use_counter });
+    return &outer_box_shadows.find(key)->value;
+}
+
 void DisplayListPlayerSkia::paint_outer_box_shadow(PaintOuterBoxShadow const& command)
 {
     auto const& outer_box_shadow_params = command.box_shadow_params;
@@ -493,6 +616,19 @@ void DisplayListPlayerSkia::paint_outer_box_shadow(PaintOuterBoxShadow const& co
     paint.setAntiAlias(true);
     paint.setColor(to_skia_color(color));
     paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, blur_radius / 2));
+
+    // The blurred shadow can only be reused if it ends up on the same device pixels as drawing it directly would.
+    auto const& matrix = canvas.getTotalMatrix();
+    auto is_integer_translation = matrix.isTranslate() && matrix.getTranslateX() == floorf(matrix.getTranslateX()) && matrix.getTranslateY() == floorf(matrix.getTranslateY());
+    if (blur_radius > 0 && !shadow_rect.is_empty() && is_integer_translation) {
+        OuterBoxShadowKey key { shadow_rect.size(), corner_radii, blur_radius, color };
+        if (auto const* shadow = cached_shadows().outer_box_shadow(m_context, key, paint)) {
+            canvas.drawImage(shadow->image, shadow_rect.x() - shadow->margin, shadow_rect.y() - shadow->margin);
+            canvas.restore();
+            return;
+        }
+    }
+
     auto shadow_rounded_rect = to_skia_rrect(shadow_rect, corner_radii);
     canvas.drawRRect(shadow_rounded_rect, paint);
     canvas.restore();
@@ -647,6 +783,172 @@ static SkPaint paint_style_to_skia_paint(Painting::SVGGradientPaintStyle const&
     return paint;
 }
 
+// Icon-heavy pages draw the same small shapes over and over, e.g. when an SVG symbol is <use>d for every row of a
+// list. We rasterize those once and only draw the result at the right position afterwards. The path geometry is
+// relative to the device pixel grid, so the scale it is drawn at is part of the key.
+struct PathRasterKey {
+    Vector<i32> geometry;
+    Gfx::Color color;
+    SkPathFillType fill_type { SkPathFillType::kWinding };
+    bool anti_alias { true };
+    float stroke_width { 0 };
+    SkPaint::Cap stroke_cap { SkPaint::kButt_Cap };
+    SkPaint::Join stroke_join { SkPaint::kMiter_Join };
+    float stroke_miter { 0 };
+
+    bool operator==(PathRasterKey const&) const = default;
+};
+
+struct PathRasterKeyTraits : public DefaultTraits<PathRasterKey> {
+    static unsigned hash(PathRasterKey const& key)
+    {
+        auto hash = pair_int_hash(key.color.value(), (to_underlying(key.fill_type) << 1) | key.anti_alias);
+        hash = pair_int_hash(hash, pair_int_hash(bit_cast<u32>(key.stroke_width), bit_cast<u32>(key.stroke_miter)));
+        hash = pair_int_hash(hash, (key.stroke_cap << 4) | key.stroke_join);
+        for (auto value : key.geometry)
+            hash = pair_int_hash(hash, value);
+        return hash;
+    }
+};
+
+struct DisplayListPlayerSkia::CachedPaths {
+    static constexpr int max_path_size = 64;
+    static constexpr int max_point_count = 256;
+    static constexpr size_t max_total_byte_size = 4 * MiB;
+    static constexpr size_t max_path_count = 4096;
+
+    // Points are rounded to this fraction of a device pixel, so that the same shape positioned at different whole
+    // pixels is recognized even though its coordinates went through a slightly different floating point computation.
+    static constexpr float subpixel_precision = 64;
+
+    struct RasterizedPath {
+        sk_sp<SkImage> image;
+        size_t byte_size { 0 };
+        u32 use_count { 0 };
+        u64 last_use { 0 };
+    };
+
+    // Returns the rasterized path if it has been drawn before, or nullptr if it should be drawn directly.
+    SkImage const* rasterized_path(RefPtr<Gfx::SkiaBackendContext> const&, PathRasterKey&&, Gfx::IntSize, SkPath const& path_at_origin, SkPaint const&);
+
+    HashMap<PathRasterKey, RasterizedPath, PathRasterKeyTraits> paths;
+    size_t total_byte_size { 0 };
+    u64 use_counter { 0 };
+};
+
+DisplayListPlayerSkia::CachedPaths& DisplayListPlayerSkia::cached_paths()
+{
+    if (!m_cached_paths)
+        m_cached_paths = make<DisplayListPlayerSkia::CachedPaths>();
+    return *m_cached_paths;
+}
+
+SkImage const* DisplayListPlayerSkia::CachedPaths::rasterized_path(RefPtr<Gfx::SkiaBackendContext> const& context, PathRasterKey&& key, Gfx::IntSize size, SkPath const& path_at_origin, SkPaint const& paint)
+{
+    auto it = paths.find(key);
+    if (it == paths.end()) {
+        // Shapes that are drawn only once are not worth an extra surface, so we wait until we see them again.
+        while (paths.size() >= max_path_count || total_byte_size > max_total_byte_size) {
+            auto least_recently_used = paths.begin();
+            for (auto candidate = paths.begin(); candidate != paths.end(); ++candidate) {
+                if (candidate->value.last_use < least_recently_used->value.last_use)
+                    least_recently_used = candidate;
+            }
+            total_byte_size -= least_recently_used->value.byte_size;
+            paths.remove(least_recently_used);
+        }
+        paths.set(move(key), RasterizedPath { .use_count = 1, .last_use = ++use_counter });
+        return nullptr;
+    }
+
+    auto& rasterized_path = it->value;
+    rasterized_path.last_use = ++use_counter;
+    ++rasterized_path.use_count;
+    if (!rasterized_path.image) {
+        auto path_surface = Gfx::PaintingSurface::create_with_size(context, size, Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied);
+        path_surface->canvas().drawPath(path_at_origin, paint);
+        rasterized_path.image = path_surface->sk_surface().makeImageSnapshot();
+        rasterized_path.byte_size = static_cast<size_t>(size.width()) * size.height() * 4;
+        total_byte_size += rasterized_path.byte_size;
+    }
+    return rasterized_path.image.get();
+}
+
+bool DisplayListPlayerSkia::draw_path_from_cache(SkPath const& path, SkPaint const& paint, Gfx::Color color)
+{
+    if (path.countPoints() > CachedPaths::max_point_count)
+        return false;
+
+    // The rasterized path can only be reused if it ends up on the same device pixels as drawing it directly would.
+    auto& canvas = surface().canvas();
+    auto const& matrix = canvas.getTotalMatrix();
+    if (!matrix.isTranslate() || matrix.getTranslateX() != floorf(matrix.getTranslateX()) || matrix.getTranslateY() != floorf(matrix.getTranslateY()))
+        return false;
+
+    SkRect storage;
+    auto const& bounds = paint.canComputeFastBounds() ? paint.computeFastBounds(path.getBounds(), &storage) : path.getBounds();
+    if (!bounds.isFinite() || bounds.isEmpty() || bounds.width() > CachedPaths::max_path_size || bounds.height() > CachedPaths::max_path_size)
+        return false;
+
+    // Leave a pixel of room for anti-aliasing on every side.
+    auto origin_x = floorf(bounds.left()) - 1;
+    auto origin_y = floorf(bounds.top()) - 1;
+    Gfx::IntSize size { static_cast<int>(ceilf(bounds.right()) - origin_x) + 1, static_cast<int>(ceilf(bounds.bottom()) - origin_y) + 1 };
+
+    PathRasterKey key {
+        .color = color,
+        .fill_type = path.getFillType(),
+        .anti_alias = paint.isAntiAlias(),
+    };
+    if (paint.getStyle() != SkPaint::kFill_Style) {
+        key.stroke_width = paint.getStrokeWidth();
+        key.stroke_cap = paint.getStrokeCap();
+        key.stroke_join = paint.getStrokeJoin();
+        key.stroke_miter = paint.getStrokeMiter();
+    }
+
+    key.geometry.ensure_capacity(path.countVerbs() + path.countPoints() * 2);
+    auto append_point = [&](SkPoint point) {
+        key.geometry.append(static_cast<i32>(roundf((point.x() - origin_x) * CachedPaths::subpixel_precision)));
+        key.geometry.append(static_cast<i32>(roundf((point.y() - origin_y) * CachedPaths::subpixel_precision)));
+    };
+    SkPath::Iter iterator(path, false);
+    SkPoint points[4];
+    for (auto verb = iterator.next(points); verb != SkPath::kDone_Verb; verb = iterator.next(points)) {
+        key.geometry.append(verb);
+        switch (verb) {
+        case SkPath::kMove_Verb:
+            append_point(points[0]);
+            break;
+        case SkPath::kLine_Verb:
+            append_point(points[1]);
+            break;
+        case SkPath::kConic_Verb:
+            key.geometry.append(bit_cast<i32>(iterator.conicWeight()));
+            [[fallthrough]];
+        case SkPath::kQuad_Verb:
+            append_point(points[1]);
+            append_point(points[2]);
+            break;
+        case SkPath::kCubic_Verb:
+            append_point(points[1]);
+            append_point(points[2]);
+            append_point(points[3]);
+            break;
+        default:
+            break;
+        }
+    }
+
+    auto path_at_origin = path.makeOffset(-origin_x, -origin_y);
+    auto const* image = cached_paths().rasterized_path(m_context, move(key), size, path_at_origin, paint);
+    if (!image)
+        return false;
+
+    canvas.drawImage(image, origin_x, origin_y);
+    return true;
+}
+
 void DisplayListPlayerSkia::fill_path(FillPath const& command)
 {
     auto path = to_skia_path(command.path);
@@ -662,6 +964,8 @@ void DisplayListPlayerSkia::fill_path(FillPath const& command)
         paint.setColor(to_skia_color(color));
     }
     paint.setAntiAlias(command.should_anti_alias == ShouldAntiAlias::Yes);
+    if (command.paint_style_or_color.has<Color>() && draw_path_from_cache(path, paint, command.paint_style_or_color.get<Color>()))
+        return;
     surface().canvas().drawPath(path, paint);
 }
 
@@ -684,6 +988,8 @@ void DisplayListPlayerSkia::stroke_path(StrokePath const& command)
     paint.setStrokeJoin(to_skia_join(command.join_style));
     paint.setStrokeMiter(command.miter_limit);
     paint.setPathEffect(SkDashPathEffect::Make(command.dash_array.data(), command.dash_array.size(), command.dash_offset));
+    if (command.paint_style_or_color.has<Color>() && command.dash_array.is_empty() && draw_path_from_cache(path, paint, command.paint_style_or_color.get<Color>()))
+        return;
     surface().canvas().drawPath(path, paint);
 }
 
@@ -954,7 +1260,12 @@ void DisplayListPlayerSkia::apply_filters(ApplyFilter const& command)
     SkPaint paint;
     paint.setImageFilter(image_filter);
     auto& canvas = surface().canvas();
-    canvas.saveLayer(nullptr, &paint);
+    if (command.content_bounds.has_value()) {
+        auto bounds = to_skia_rect(command.content_bounds.value());
+        canvas.saveLayer(bounds, &paint);
+    } else {
+        canvas.saveLayer(nullptr, &paint);
+    }
 }
 
 void DisplayListPlayerSkia::apply_transform(ApplyTransform const& command)
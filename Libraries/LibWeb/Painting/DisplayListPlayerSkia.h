@@ -12,6 +12,9 @@
 #include <LibWeb/Painting/DisplayListRecorder.h>
 
 class GrDirectContext;
+class SkImage;
+class SkPaint;
+class SkPath;
 
 namespace Web::Painting {
 
@@ -61,11 +64,22 @@ private:
 
     bool would_be_fully_clipped_by_painter(Gfx::IntRect) const override;
 
+    SkImage const* image_for_bitmap(Gfx::ImmutableBitmap const&) const;
+    bool draw_path_from_cache(SkPath const&, SkPaint const&, Gfx::Color);
+
     RefPtr<Gfx::SkiaBackendContext> m_context;
 
     struct CachedRuntimeEffects;
     OwnPtr<CachedRuntimeEffects> m_cached_runtime_effects;
     CachedRuntimeEffects& cached_runtime_effects();
+
+    struct CachedShadows;
+    OwnPtr<CachedShadows> m_cached_shadows;
+    CachedShadows& cached_shadows();
+
+    struct CachedPaths;
+    OwnPtr<CachedPaths> m_cached_paths;
+    CachedPaths& cached_paths();
 };
 
 }
@@ -322,6 +322,8 @@ void DisplayListRecorder::push_stacking_context(PushStackingContextParams params
         .bounding_rect = params.bounding_rect });
     m_clip_frame_stack.append({});
     m_push_sc_index_stack.append(m_display_list.commands().size() - 1);
+    if (params.paintable_box)
+        m_display_list.set_stacking_context_command_index({}, *params.paintable_box, m_display_list.commands().size() - 1);
 }
 
 static bool command_has_bounding_rectangle(DisplayListCommand const& command)
@@ -355,6 +357,41 @@ void DisplayListRecorder::pop_stacking_context()
     }
 }
 
+void DisplayListRecorder::append_recorded_command(DisplayListCommandWithScrollAndClip const& recorded_command, PaintableBox const* stacking_context_paintable_box)
+{
+    auto command = recorded_command.command;
+    m_display_list.append(move(command), recorded_command.scroll_frame_id, recorded_command.clip_frame);
+    auto index = m_display_list.commands().size() - 1;
+    auto& appended_command = m_display_list.commands({})[index].command;
+    if (appended_command.has<PushStackingContext>()) {
+        m_push_sc_index_stack.append(index);
+        if (stacking_context_paintable_box)
+            m_display_list.set_stacking_context_command_index({}, *stacking_context_paintable_box, index);
+    } else if (appended_command.has<PopStackingContext>()) {
+        auto push_index = m_push_sc_index_stack.take_last();
+        m_display_list.commands({})[push_index].command.get<PushStackingContext>().matching_pop_index = index;
+    }
+}
+
+size_t DisplayListRecorder::command_count() const
+{
+    return m_display_list.commands().size();
+}
+
+Optional<i32> DisplayListRecorder::current_scroll_frame_id() const
+{
+    if (m_scroll_frame_id_stack.is_empty())
+        return {};
+    return m_scroll_frame_id_stack.last();
+}
+
+RefPtr<ClipFrame const> DisplayListRecorder::current_clip_frame() const
+{
+    if (m_clip_frame_stack.is_empty())
+        return {};
+    return m_clip_frame_stack.last();
+}
+
 void DisplayListRecorder::apply_backdrop_filter(Gfx::IntRect const& backdrop_region, BorderRadiiData const& border_radii_data, Gfx::Filter const& backdrop_filter)
 {
     if (backdrop_region.is_empty())
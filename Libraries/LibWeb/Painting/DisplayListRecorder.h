@@ -112,6 +112,7 @@ public:
         StackingContextTransform transform;
         Optional<Gfx::Path> clip_path = {};
         Optional<Gfx::IntRect> bounding_rect {};
+        PaintableBox const* paintable_box { nullptr };
 
         bool has_effect() const { return opacity != 1.0f || compositing_and_blending_operator != Gfx::CompositingAndBlendingOperator::Normal || isolate || clip_path.has_value() || !transform.is_identity(); }
     };
@@ -141,6 +142,15 @@ public:
     void apply_transform(Gfx::FloatPoint origin, Gfx::FloatMatrix4x4);
     void apply_mask_bitmap(Gfx::IntPoint origin, Gfx::ImmutableBitmap const&, Gfx::Bitmap::MaskKind);
 
+    // Appends a command that was recorded earlier, keeping its scroll frame and clip frame. Stacking contexts are
+    // matched up with their pops again, so the replayed range has to be balanced.
+    void append_recorded_command(DisplayListCommandWithScrollAndClip const&, PaintableBox const* stacking_context_paintable_box = nullptr);
+
+    DisplayList const& display_list() const { return m_display_list; }
+    size_t command_count() const;
+    Optional<i32> current_scroll_frame_id() const;
+    RefPtr<ClipFrame const> current_clip_frame() const;
+
     DisplayListRecorder(DisplayList&);
     ~DisplayListRecorder();
 
@@ -30,6 +30,11 @@ public:
     bool should_paint_overlay() const { return m_should_paint_overlay; }
     void set_should_paint_overlay(bool should_paint_overlay) { m_should_paint_overlay = should_paint_overlay; }
 
+    // Only set while recording a document's own display list. Other recordings (masks, clip paths, ...) use their
+    // own state, so they must neither replay nor populate the commands cached on stacking contexts.
+    bool should_reuse_stacking_context_commands() const { return m_should_reuse_stacking_context_commands; }
+    void set_should_reuse_stacking_context_commands(bool value) { m_should_reuse_stacking_context_commands = value; }
+
     DevicePixelRect device_viewport_rect() const { return m_device_viewport_rect; }
     void set_device_viewport_rect(DevicePixelRect const& rect) { m_device_viewport_rect = rect; }
     CSSPixelRect css_viewport_rect() const;
@@ -88,6 +93,7 @@ private:
     Painting::DevicePixelConverter m_device_pixel_converter;
     DevicePixelRect m_device_viewport_rect;
     bool m_should_show_line_box_borders { false };
+    bool m_should_reuse_stacking_context_commands { false };
     bool m_should_paint_overlay { true };
     bool m_draw_svg_geometry_for_clip_path { false };
     Gfx::AffineTransform m_svg_transform;
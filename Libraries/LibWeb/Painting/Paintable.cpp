@@ -210,7 +210,7 @@ void Paintable::set_needs_display(InvalidateDisplayList should_invalidate_displa
 {
     auto& document = const_cast<DOM::Document&>(this->document());
     if (should_invalidate_display_list == InvalidateDisplayList::Yes)
-        document.invalidate_display_list();
+        document.invalidate_display_list(*this);
 
     auto* containing_block = this->containing_block();
     if (!containing_block)
@@ -218,9 +218,10 @@ void Paintable::set_needs_display(InvalidateDisplayList should_invalidate_displa
 
     if (!is<Painting::PaintableWithLines>(*containing_block))
         return;
-    for (auto const& fragment : static_cast<Painting::PaintableWithLines const&>(*containing_block).fragments()) {
-        document.set_needs_display(fragment.absolute_rect(), InvalidateDisplayList::No);
-    };
+    // FIXME: Only repaint the fragments of the containing block. Their absolute rects would have to be mapped to the
+    //        viewport first, taking scrolling and transforms into account.
+    if (!static_cast<Painting::PaintableWithLines const&>(*containing_block).fragments().is_empty())
+        document.set_needs_display(InvalidateDisplayList::No);
 }
 
 CSSPixelPoint Paintable::box_type_agnostic_position() const
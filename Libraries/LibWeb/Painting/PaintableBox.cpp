@@ -1400,9 +1400,39 @@ TraversalDecision PaintableWithLines::hit_test(CSSPixelPoint position, HitTestTy
     return TraversalDecision::Continue;
 }
 
+// Returns the area of the viewport this box paints into, if it can be determined from its absolute paint rect.
+static Optional<CSSPixelRect> paint_rect_in_viewport(PaintableBox const& paintable_box)
+{
+    // Anything that moves this box around independently of scrolling, or that spreads its pixels out, would have to be
+    // accounted for. Instead, we let such boxes damage the whole viewport.
+    for (Paintable const* paintable = &paintable_box; paintable; paintable = paintable->parent()) {
+        if (paintable->is_fixed_position() || paintable->is_sticky_position() || paintable->is_svg_paintable() || paintable->is_svg_svg_paintable())
+            return {};
+        auto const* box = as_if<PaintableBox>(*paintable);
+        if (!box)
+            continue;
+        auto const& computed_values = box->computed_values();
+        if (box->has_css_transform() || computed_values.filter().has_filters() || computed_values.backdrop_filter().has_filters())
+            return {};
+    }
+
+    auto rect = paintable_box.absolute_paint_rect();
+    rect.translate_by(paintable_box.cumulative_offset_of_enclosing_scroll_frame());
+    return rect;
+}
+
 void PaintableBox::set_needs_display(InvalidateDisplayList should_invalidate_display_list)
 {
-    document().set_needs_display(absolute_rect(), should_invalidate_display_list);
+    if (should_invalidate_display_list == InvalidateDisplayList::No && !is_viewport_paintable()) {
+        document().set_needs_display(paint_rect_in_viewport(*this), should_invalidate_display_list);
+        return;
+    }
+    if (should_invalidate_display_list == InvalidateDisplayList::Yes) {
+        document().invalidate_display_list(*this);
+        document().set_needs_display(InvalidateDisplayList::No);
+        return;
+    }
+    document().set_needs_display(should_invalidate_display_list);
 }
 
 Optional<CSSPixelRect> PaintableBox::get_masking_area() const
@@ -12,6 +12,8 @@
 #include <LibGfx/AffineTransform.h>
 #include <LibGfx/Matrix4x4.h>
 #include <LibGfx/Rect.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/Element.h>
 #include <LibWeb/Layout/ReplacedBox.h>
 #include <LibWeb/Layout/Viewport.h>
 #include <LibWeb/Painting/Blending.h>
@@ -200,7 +202,21 @@ void StackingContext::paint_child(DisplayListRecordingContext& context, Stacking
 {
     VERIFY(!child.paintable_box().is_svg_paintable());
     const_cast<StackingContext&>(child).set_last_paint_generation_id(context.paint_generation_id());
+    auto first_command_index = context.display_list_recorder().command_count();
     child.paint(context);
+    if (child.m_parent)
+        child.m_parent->m_recorded_children.append({ &child, first_command_index, context.display_list_recorder().command_count() });
+}
+
+// https://drafts.csswg.org/css-contain-2/#skips-its-contents
+static bool skips_painting_its_contents(PaintableBox const& paintable_box)
+{
+    if (paintable_box.computed_values().content_visibility() != CSS::ContentVisibility::Auto)
+        return false;
+    if (paintable_box.layout_node().is_generated_for_pseudo_element())
+        return false;
+    auto const* element = as_if<DOM::Element>(paintable_box.dom_node().ptr());
+    return element && element->skips_its_contents_due_to_content_visibility_auto();
 }
 
 void StackingContext::paint_internal(DisplayListRecordingContext& context) const
@@ -233,6 +249,13 @@ void StackingContext::paint_internal(DisplayListRecordingContext& context) const
     paint_node(paintable_box(), context, PaintPhase::Background);
     paint_node(paintable_box(), context, PaintPhase::Border);
 
+    // OPTIMIZATION: content-visibility: auto gives the element paint containment, so all of its descendants are painted
+    //               as part of this stacking context. While the element skips its contents, none of them are recorded.
+    if (skips_painting_its_contents(paintable_box())) {
+        paint_node(paintable_box(), context, PaintPhase::Outline);
+        return;
+    }
+
     // Stacking contexts formed by positioned descendants with negative z-indices (excluding 0) in z-index order
     // (most negative first) then tree order. (step 3)
     // Here, we treat non-positioned stacking contexts as if they were positioned, because CSS 2.0 spec does not
@@ -297,6 +320,19 @@ void StackingContext::paint(DisplayListRecordingContext& context) const
     if (opacity == 0.0f)
         return;
 
+    // OPTIMIZATION: Nothing painted by this stacking context has changed since it was last recorded, so its commands
+    //               can be appended again as they are.
+    auto& recorder = context.display_list_recorder();
+    auto scroll_frame_id = recorder.current_scroll_frame_id();
+    auto clip_frame = recorder.current_clip_frame();
+    auto should_reuse_commands = context.should_reuse_stacking_context_commands() && context.svg_transform().is_identity();
+    if (should_reuse_commands && replay_cached_commands(context))
+        return;
+
+    auto first_command_index = recorder.command_count();
+    Optional<size_t> stacking_context_command_index;
+    m_recorded_children.clear();
+
     TemporaryChange save_nesting_level(context.display_list_recorder().m_save_nesting_level, 0);
     ScopeGuard verify_save_and_restore_are_balanced([&] {
         VERIFY(context.display_list_recorder().m_save_nesting_level == 0);
@@ -315,6 +351,7 @@ void StackingContext::paint(DisplayListRecordingContext& context) const
         .compositing_and_blending_operator = compositing_and_blending_operator,
         .isolate = paintable_box().computed_values().isolation() == CSS::Isolation::Isolate,
         .transform = StackingContextTransform(transform_origin, transform_matrix, to_device_pixels_scale),
+        .paintable_box = &paintable_box(),
     };
 
     auto const& computed_values = paintable_box().computed_values();
@@ -342,6 +379,7 @@ void StackingContext::paint(DisplayListRecordingContext& context) const
     bool needs_to_save_state = mask_image || paintable_box().get_masking_area().has_value();
 
     if (push_stacking_context_params.has_effect()) {
+        stacking_context_command_index = recorder.command_count();
         context.display_list_recorder().push_stacking_context(push_stacking_context_params);
     } else if (needs_to_save_state) {
         context.display_list_recorder().save();
@@ -380,6 +418,85 @@ void StackingContext::paint(DisplayListRecordingContext& context) const
     paintable_box().reset_scroll_offset(context);
     if (!transform_matrix.is_identity())
         paintable_box().clear_clip_overflow_rect(context, PaintPhase::Foreground);
+
+    if (should_reuse_commands)
+        cache_recorded_commands(context, first_command_index, stacking_context_command_index, scroll_frame_id, move(clip_frame));
+}
+
+bool StackingContext::replay_cached_commands(DisplayListRecordingContext& context) const
+{
+    if (!m_cached_commands.has_value())
+        return false;
+
+    auto& recorder = context.display_list_recorder();
+    auto const& cached_commands = *m_cached_commands;
+    if (cached_commands.display_list_generation != paintable_box().document().display_list_generation()
+        || cached_commands.scroll_frame_id != recorder.current_scroll_frame_id()
+        || cached_commands.clip_frame != recorder.current_clip_frame()
+        || cached_commands.device_pixels_per_css_pixel != context.device_pixels_per_css_pixel()
+        || cached_commands.should_show_line_box_borders != context.should_show_line_box_borders()
+        || cached_commands.should_paint_overlay != context.should_paint_overlay()) {
+        m_cached_commands.clear();
+        return false;
+    }
+
+    m_recorded_children.clear();
+    for (size_t i = 0; i < cached_commands.items.size(); ++i) {
+        cached_commands.items[i].visit(
+            [&](DisplayListCommandWithScrollAndClip const& command) {
+                auto const* stacking_context_paintable_box = cached_commands.stacking_context_command_item_index == i ? &paintable_box() : nullptr;
+                recorder.append_recorded_command(command, stacking_context_paintable_box);
+            },
+            [&](StackingContext const* child) {
+                paint_child(context, *child);
+            });
+    }
+    return true;
+}
+
+void StackingContext::cache_recorded_commands(DisplayListRecordingContext& context, size_t first_command_index, Optional<size_t> stacking_context_command_index, Optional<i32> scroll_frame_id, RefPtr<ClipFrame const> clip_frame) const
+{
+    auto const& recorder = context.display_list_recorder();
+    auto const& commands = recorder.display_list().commands();
+    auto end_command_index = recorder.command_count();
+
+    CachedCommands cached_commands {
+        .display_list_generation = paintable_box().document().display_list_generation(),
+        .scroll_frame_id = scroll_frame_id,
+        .clip_frame = move(clip_frame),
+        .device_pixels_per_css_pixel = context.device_pixels_per_css_pixel(),
+        .should_show_line_box_borders = context.should_show_line_box_borders(),
+        .should_paint_overlay = context.should_paint_overlay(),
+        .items = {},
+        .stacking_context_command_item_index = {},
+    };
+    cached_commands.items.ensure_capacity(end_command_index - first_command_index);
+
+    size_t child_index = 0;
+    for (auto command_index = first_command_index; command_index < end_command_index;) {
+        if (child_index < m_recorded_children.size() && m_recorded_children[child_index].first_command_index == command_index) {
+            // The child's commands are cached by the child itself.
+            cached_commands.items.append(m_recorded_children[child_index].stacking_context);
+            command_index = m_recorded_children[child_index].end_command_index;
+            ++child_index;
+            continue;
+        }
+        if (command_index == stacking_context_command_index)
+            cached_commands.stacking_context_command_item_index = cached_commands.items.size();
+        cached_commands.items.append(commands[command_index]);
+        ++command_index;
+    }
+    for (; child_index < m_recorded_children.size(); ++child_index)
+        cached_commands.items.append(m_recorded_children[child_index].stacking_context);
+
+    m_recorded_children.clear();
+    m_cached_commands = move(cached_commands);
+}
+
+void StackingContext::invalidate_cached_commands() const
+{
+    for (auto const* stacking_context = this; stacking_context; stacking_context = stacking_context->parent())
+        stacking_context->m_cached_commands.clear();
 }
 
 TraversalDecision StackingContext::hit_test(CSSPixelPoint position, HitTestType type, Function<TraversalDecision(HitTestResult)> const& callback) const
@@ -6,9 +6,11 @@
 
 #pragma once
 
+#include <AK/Variant.h>
 #include <AK/Vector.h>
 #include <LibGfx/Matrix4x4.h>
 #include <LibWeb/Export.h>
+#include <LibWeb/Painting/DisplayList.h>
 #include <LibWeb/Painting/Paintable.h>
 
 namespace Web::Painting {
@@ -47,6 +49,10 @@ public:
 
     void set_last_paint_generation_id(u64 generation_id);
 
+    // Drops the commands cached for this stacking context and all of its ancestors, so that they are recorded again
+    // the next time the display list is recorded. Other stacking contexts keep replaying their cached commands.
+    void invalidate_cached_commands() const;
+
 private:
     GC::Ref<PaintableBox> m_paintable;
     StackingContext* const m_parent { nullptr };
@@ -57,8 +63,31 @@ private:
     Vector<GC::Ref<PaintableBox const>> m_positioned_descendants_and_stacking_contexts_with_stack_level_0;
     Vector<GC::Ref<PaintableBox const>> m_non_positioned_floating_descendants;
 
+    // The commands this stacking context recorded itself. Child stacking contexts are not part of them, but are painted
+    // again in their place when replaying, so every command is only kept by a single stacking context.
+    struct CachedCommands {
+        u64 display_list_generation { 0 };
+        Optional<i32> scroll_frame_id;
+        RefPtr<ClipFrame const> clip_frame;
+        double device_pixels_per_css_pixel { 1 };
+        bool should_show_line_box_borders { false };
+        bool should_paint_overlay { false };
+        Vector<Variant<DisplayListCommandWithScrollAndClip, StackingContext const*>> items;
+        Optional<size_t> stacking_context_command_item_index;
+    };
+    mutable Optional<CachedCommands> m_cached_commands;
+
+    struct RecordedChild {
+        StackingContext const* stacking_context { nullptr };
+        size_t first_command_index { 0 };
+        size_t end_command_index { 0 };
+    };
+    mutable Vector<RecordedChild> m_recorded_children;
+
     static void paint_child(DisplayListRecordingContext&, StackingContext const&);
     void paint_internal(DisplayListRecordingContext&) const;
+    [[nodiscard]] bool replay_cached_commands(DisplayListRecordingContext&) const;
+    void cache_recorded_commands(DisplayListRecordingContext&, size_t first_command_index, Optional<size_t> stacking_context_command_index, Optional<i32> scroll_frame_id, RefPtr<ClipFrame const> clip_frame) const;
 };
 
 }
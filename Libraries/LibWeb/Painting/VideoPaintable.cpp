@@ -125,10 +125,10 @@ void VideoPaintable::paint(DisplayListRecordingContext& context, PaintPhase phas
         return Representation::VideoFrame;
     }();
 
-    auto paint_frame = [&](auto const& frame) {
-        auto scaling_mode = to_gfx_scaling_mode(computed_values().image_rendering(), frame->rect(), video_rect.to_type<int>());
+    auto paint_frame = [&](Gfx::ImmutableBitmap const& frame) {
+        auto scaling_mode = to_gfx_scaling_mode(computed_values().image_rendering(), frame.rect(), video_rect.to_type<int>());
         auto dst_rect = video_rect.to_type<int>();
-        context.display_list_recorder().draw_scaled_immutable_bitmap(dst_rect, dst_rect, Gfx::ImmutableBitmap::create(*frame), scaling_mode);
+        context.display_list_recorder().draw_scaled_immutable_bitmap(dst_rect, dst_rect, frame, scaling_mode);
     };
 
     auto paint_transparent_black = [&]() {
@@ -149,14 +149,14 @@ void VideoPaintable::paint(DisplayListRecordingContext& context, PaintPhase phas
     switch (representation) {
     case Representation::VideoFrame:
         if (current_frame.frame)
-            paint_frame(current_frame.frame);
+            paint_frame(*current_frame.frame);
         if (paint_user_agent_controls)
             paint_loaded_video_controls();
         break;
 
     case Representation::PosterFrame:
         VERIFY(poster_frame);
-        paint_frame(poster_frame);
+        paint_frame(Gfx::ImmutableBitmap::create(*poster_frame));
         if (paint_user_agent_controls)
             paint_placeholder_video_controls(context, video_rect, mouse_position);
         break;
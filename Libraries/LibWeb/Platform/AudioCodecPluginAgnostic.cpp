@@ -4,7 +4,6 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/MemoryStream.h>
 #include <AK/String.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/EventLoop.h>
@@ -55,16 +54,14 @@ ErrorOr<NonnullOwnPtr<AudioCodecPluginAgnostic>> AudioCodecPluginAgnostic::creat
             auto samples = samples_result.release_value();
             VERIFY(samples.size() <= sample_count);
 
-            FixedMemoryStream writing_stream { buffer };
-
-            for (auto& sample : samples) {
-                MUST(writing_stream.write_value(sample.left));
-                MUST(writing_stream.write_value(sample.right));
-            }
+            // Samples are pairs of floats, which is already the interleaved stereo layout that the stream expects.
+            static_assert(sizeof(Audio::Sample) == 2 * sizeof(float));
+            auto sample_bytes = ReadonlyBytes { samples.data(), samples.size() * sizeof(Audio::Sample) };
+            sample_bytes.copy_to(buffer);
 
             // FIXME: Check if we have loaded samples past the current known duration, and if so, update it
             //        and notify the media element.
-            return buffer.trim(writing_stream.offset());
+            return buffer.trim(sample_bytes.size());
         }));
 
     output->set_underrun_callback([&plugin = *plugin, loader, output]() {
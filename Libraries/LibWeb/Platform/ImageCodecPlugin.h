@@ -12,6 +12,7 @@
 #include <LibCore/Promise.h>
 #include <LibGfx/ColorSpace.h>
 #include <LibGfx/Forward.h>
+#include <LibThreading/ThreadPool.h>
 #include <LibWeb/Export.h>
 
 namespace Web::Platform {
@@ -24,8 +25,17 @@ struct Frame {
 struct DecodedImage {
     bool is_animated { false };
     u32 loop_count { 0 };
+    size_t frame_count { 0 };
     Vector<Frame> frames;
     Gfx::ColorSpace color_space;
+
+    // Set if only the first frames were decoded, see ImageCodecPlugin::request_animation_frames().
+    Optional<i64> animation_id;
+};
+
+enum class AnimationFrameDecoding {
+    AllUpFront,
+    OnDemand,
 };
 
 class WEB_API ImageCodecPlugin {
@@ -35,7 +45,19 @@ public:
 
     virtual ~ImageCodecPlugin();
 
-    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
+    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected, AnimationFrameDecoding = AnimationFrameDecoding::AllUpFront, Threading::TaskPriority = Threading::TaskPriority::Default) = 0;
+
+    // For animations that were decoded with AnimationFrameDecoding::OnDemand. on_frames_decoded receives fewer than
+    // count frames if the animation ends or a frame fails to decode. Only one request per animation may be in flight.
+    virtual void request_animation_frames(i64 animation_id, size_t first_frame_index, size_t count, ESCAPING Function<void(size_t first_frame_index, Vector<Frame>)> on_frames_decoded) = 0;
+    virtual void release_animation(i64 animation_id) = 0;
+
+    // Decodes an image while its data is still arriving, so that it can be shown early. on_partial_image is called with
+    // what has been decoded so far, until end_incremental_decode() is called. The complete image should still be
+    // decoded with decode_image(). Returns an empty Optional if the image can't be decoded this way.
+    virtual Optional<i64> begin_incremental_decode(Threading::TaskPriority, ESCAPING Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image) = 0;
+    virtual void append_incremental_decode_data(i64 decode_id, ReadonlyBytes) = 0;
+    virtual void end_incremental_decode(i64 decode_id) = 0;
 };
 
 }
@@ -6,6 +6,7 @@
 
 #include <LibGC/Heap.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/Painting/PaintableBox.h>
 #include <LibWeb/ResizeObserver/ResizeObservation.h>
@@ -39,6 +40,11 @@ void ResizeObservation::visit_edges(JS::Cell::Visitor& visitor)
 // https://drafts.csswg.org/resize-observer-1/#dom-resizeobservation-isactive
 bool ResizeObservation::is_active()
 {
+    // OPTIMIZATION: Nothing that could resize target has happened since we last found this observation inactive.
+    auto geometry_generation = m_target->document().geometry_generation();
+    if (m_inactive_at_geometry_generation == geometry_generation)
+        return false;
+
     // 1. Set currentSize by calculate box size given target and observedBox.
     auto current_size = ResizeObserverSize::calculate_box_size(m_realm, m_target, m_observed_box);
 
@@ -48,6 +54,7 @@ bool ResizeObservation::is_active()
         return true;
 
     // 3. Return false.
+    m_inactive_at_geometry_generation = geometry_generation;
     return false;
 }
 
@@ -36,6 +36,10 @@ private:
     GC::Ref<DOM::Element> m_target;
     Bindings::ResizeObserverBoxOptions m_observed_box;
     Vector<GC::Ref<ResizeObserverSize>> m_last_reported_sizes;
+
+    // The geometry generation of the target's document at which is_active() last found this observation inactive.
+    // Until that changes, the target's box sizes can't have changed either.
+    Optional<u64> m_inactive_at_geometry_generation;
 };
 
 }
@@ -157,27 +157,63 @@ ErrorOr<Vector<Metadata>> get_strongest_metadata_from_set(Vector<Metadata> const
 
 // https://w3c.github.io/webappsec-subresource-integrity/#does-response-match-metadatalist
 ErrorOr<bool> do_bytes_match_metadata_list(ByteBuffer const& bytes, StringView metadata_list)
+{
+    auto matcher = TRY(IncrementalMetadataMatcher::create(metadata_list));
+    matcher.update(bytes);
+    return matcher.matches();
+}
+
+static Crypto::Hash::HashKind hash_kind_for_algorithm(StringView algorithm)
+{
+    if (algorithm == "sha256"sv)
+        return Crypto::Hash::HashKind::SHA256;
+    if (algorithm == "sha384"sv)
+        return Crypto::Hash::HashKind::SHA384;
+    if (algorithm == "sha512"sv)
+        return Crypto::Hash::HashKind::SHA512;
+    VERIFY_NOT_REACHED();
+}
+
+// https://w3c.github.io/webappsec-subresource-integrity/#does-response-match-metadatalist
+ErrorOr<IncrementalMetadataMatcher> IncrementalMetadataMatcher::create(StringView metadata_list)
 {
     // 1. Let parsedMetadata be the result of parsing metadataList.
     auto parsed_metadata = TRY(parse_metadata(metadata_list));
 
     // 2. If parsedMetadata is empty set, return true.
     if (parsed_metadata.is_empty())
-        return true;
+        return IncrementalMetadataMatcher { {}, nullptr };
 
     // 3. Let metadata be the result of getting the strongest metadata from parsedMetadata.
     auto metadata = TRY(get_strongest_metadata_from_set(parsed_metadata));
 
+    // NOTE: The strongest metadata all use the same algorithm, so the bytes only need to be hashed once.
+    auto hash = make<Crypto::Hash::Manager>(hash_kind_for_algorithm(metadata.first().algorithm));
+    return IncrementalMetadataMatcher { move(metadata), move(hash) };
+}
+
+void IncrementalMetadataMatcher::update(ReadonlyBytes bytes)
+{
+    if (m_hash)
+        m_hash->update(bytes);
+}
+
+ErrorOr<bool> IncrementalMetadataMatcher::matches()
+{
+    if (!m_hash)
+        return true;
+
+    auto digest = m_hash->digest();
+    auto actual_value = TRY(encode_base64(digest.bytes()));
+
     // 4. For each item in metadata:
-    for (auto const& item : metadata) {
+    for (auto const& item : m_metadata) {
         // 1. Let algorithm be the item["alg"].
-        auto& algorithm = item.algorithm;
-
         // 2. Let expectedValue be the item["val"].
         auto& expected_value = item.base64_value;
 
         // 3. Let actualValue be the result of applying algorithm to bytes.
-        auto actual_value = TRY(apply_algorithm_to_bytes(algorithm, bytes));
+        // NOTE: This is the same for every item, and was computed above from the bytes passed to update().
 
         // 4. If actualValue is a case-sensitive match for expectedValue, return true.
         if (actual_value == expected_value)
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/OwnPtr.h>
 #include <AK/String.h>
+#include <LibCrypto/Hash/HashManager.h>
 #include <LibWeb/Export.h>
 
 namespace Web::SRI {
@@ -23,4 +25,28 @@ WEB_API ErrorOr<Vector<Metadata>> parse_metadata(StringView metadata);
 ErrorOr<Vector<Metadata>> get_strongest_metadata_from_set(Vector<Metadata> const& set);
 WEB_API ErrorOr<bool> do_bytes_match_metadata_list(ByteBuffer const& bytes, StringView metadata_list);
 
+// Matches bytes against a metadata list as they become available, so that they never have to be hashed all at once.
+class WEB_API IncrementalMetadataMatcher {
+public:
+    static ErrorOr<IncrementalMetadataMatcher> create(StringView metadata_list);
+
+    void update(ReadonlyBytes);
+
+    // Returns whether all the bytes passed to update() match the metadata list.
+    ErrorOr<bool> matches();
+
+private:
+    IncrementalMetadataMatcher(Vector<Metadata> metadata, OwnPtr<Crypto::Hash::Manager> hash)
+        : m_metadata(move(metadata))
+        , m_hash(move(hash))
+    {
+    }
+
+    // The strongest metadata of the list, which all share the same algorithm.
+    Vector<Metadata> m_metadata;
+
+    // Null if the metadata list contains no metadata for supported algorithms, in which case any bytes match.
+    OwnPtr<Crypto::Hash::Manager> m_hash;
+};
+
 }
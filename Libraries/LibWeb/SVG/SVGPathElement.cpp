@@ -31,13 +31,18 @@ void SVGPathElement::attribute_changed(FlyString const& name, Optional<String> c
 {
     Base::attribute_changed(name, old_value, value, namespace_);
 
-    if (name == "d")
+    if (name == "d") {
         m_path = AttributeParser::parse_path_data(value.value_or(String {}));
+        m_gfx_path.clear();
+    }
 }
 
 Gfx::Path SVGPathElement::get_path(CSSPixelSize)
 {
-    return m_path.to_gfx_path();
+    // The path data does not depend on the viewport, so there is no need to build it again on every layout.
+    if (!m_gfx_path.has_value())
+        m_gfx_path = m_path.to_gfx_path();
+    return *m_gfx_path;
 }
 
 }
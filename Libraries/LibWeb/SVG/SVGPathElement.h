@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <LibGfx/Path.h>
 #include <LibWeb/SVG/Path.h>
 #include <LibWeb/SVG/SVGGeometryElement.h>
 
@@ -28,6 +29,7 @@ private:
     virtual void initialize(JS::Realm&) override;
 
     Path m_path {};
+    Optional<Gfx::Path> m_gfx_path;
 };
 
 }
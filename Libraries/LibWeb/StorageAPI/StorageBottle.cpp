@@ -5,9 +5,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/TraversableNavigable.h>
 #include <LibWeb/HTML/Window.h>
+#include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/StorageAPI/StorageBottle.h>
 #include <LibWeb/StorageAPI/StorageEndpoint.h>
 #include <LibWeb/StorageAPI/StorageShed.h>
@@ -91,47 +93,208 @@ GC::Ptr<StorageBottle> obtain_a_session_storage_bottle_map(HTML::EnvironmentSett
     return obtain_a_storage_bottle_map(StorageType::Session, environment, identifier);
 }
 
-GC::Ref<StorageBottle> StorageBottle::create(GC::Heap& heap, GC::Ref<Page> page, StorageType type, StorageKey key, Optional<u64> quota)
+GC::Ref<StorageBottle> StorageBottle::create(GC::Heap& heap, GC::Ref<Page>, StorageType type, StorageKey, Optional<u64> quota)
 {
-    if (type == StorageType::Local)
-        return LocalStorageBottle::create(heap, page, key, quota);
+    // NOTE: Local storage bottles are constructed directly, see obtain_a_storage_bottle_map().
+    VERIFY(type == StorageType::Session);
     return SessionStorageBottle::create(heap, quota);
 }
 
+static HashMap<String, LocalStorageArea*>& all_local_storage_areas()
+{
+    static HashMap<String, LocalStorageArea*> areas;
+    return areas;
+}
+
+NonnullRefPtr<LocalStorageArea> LocalStorageArea::obtain(Page& page, String const& storage_key)
+{
+    if (auto area = existing(storage_key))
+        return area.release_nonnull();
+
+    auto items = page.client().page_did_request_storage_items(StorageEndpointType::LocalStorage, storage_key);
+
+    OrderedHashMap<String, String> ordered_items;
+    ordered_items.ensure_capacity(items.size());
+    for (auto const& [key, value] : items)
+        ordered_items.set(key, value);
+
+    return adopt_ref(*new LocalStorageArea(storage_key, move(ordered_items)));
+}
+
+RefPtr<LocalStorageArea> LocalStorageArea::existing(String const& storage_key)
+{
+    return all_local_storage_areas().get(storage_key).value_or(nullptr);
+}
+
+LocalStorageArea::LocalStorageArea(String storage_key, OrderedHashMap<String, String> items)
+    : m_storage_key(move(storage_key))
+    , m_items(move(items))
+{
+    for (auto const& [key, value] : m_items)
+        m_size_in_bytes += key.bytes().size() + value.bytes().size();
+
+    all_local_storage_areas().set(m_storage_key, this);
+}
+
+LocalStorageArea::~LocalStorageArea()
+{
+    // NOTE: A scheduled write back holds a reference to the area, so there are no pending changes left here.
+    VERIFY(m_pending_changes.is_empty());
+    all_local_storage_areas().remove(m_storage_key);
+}
+
+void LocalStorageArea::set_item(String const& key, String const& value)
+{
+    if (auto old_value = m_items.get(key); old_value.has_value())
+        m_size_in_bytes -= key.bytes().size() + old_value->bytes().size();
+
+    m_items.set(key, value);
+    m_size_in_bytes += key.bytes().size() + value.bytes().size();
+}
+
+void LocalStorageArea::remove_item(String const& key)
+{
+    if (auto old_value = m_items.take(key); old_value.has_value())
+        m_size_in_bytes -= key.bytes().size() + old_value->bytes().size();
+}
+
+WebView::StorageOperationError LocalStorageArea::set(Page& page, String const& key, String const& value, Optional<u64> quota, String url)
+{
+    if (quota.has_value()) {
+        auto current_size = m_size_in_bytes;
+        if (auto old_value = m_items.get(key); old_value.has_value())
+            current_size -= key.bytes().size() + old_value->bytes().size();
+
+        auto new_size = key.bytes().size() + value.bytes().size();
+        if (current_size + new_size > *quota)
+            return WebView::StorageOperationError::QuotaExceededError;
+    }
+
+    set_item(key, value);
+    append_pending_change(page, { key, value, move(url) });
+    return WebView::StorageOperationError::None;
+}
+
+void LocalStorageArea::remove(Page& page, String const& key, String url)
+{
+    remove_item(key);
+    append_pending_change(page, { key, {}, move(url) });
+}
+
+void LocalStorageArea::clear(Page& page, String url)
+{
+    m_items.clear();
+    m_size_in_bytes = 0;
+
+    // Nothing that was changed before the clear matters anymore.
+    m_pending_changes.clear_with_capacity();
+    m_keys_with_pending_changes.clear_with_capacity();
+    m_has_pending_clear = true;
+
+    append_pending_change(page, { {}, {}, move(url) });
+}
+
+bool LocalStorageArea::apply_change_from_other_process(StorageItemChange const& change)
+{
+    // Our own changes are written back after this one, so they are the ones that end up on disk.
+    if (m_has_pending_clear)
+        return false;
+
+    if (!change.key.has_value()) {
+        Vector<String> keys_to_remove;
+        for (auto const& [key, value] : m_items) {
+            if (!m_keys_with_pending_changes.contains(key))
+                keys_to_remove.append(key);
+        }
+        for (auto const& key : keys_to_remove)
+            remove_item(key);
+        return true;
+    }
+
+    if (m_keys_with_pending_changes.contains(*change.key))
+        return false;
+
+    if (change.value.has_value())
+        set_item(*change.key, *change.value);
+    else
+        remove_item(*change.key);
+    return true;
+}
+
+void LocalStorageArea::append_pending_change(Page& page, StorageItemChange change)
+{
+    if (change.key.has_value())
+        m_keys_with_pending_changes.set(*change.key);
+
+    m_pending_changes.append(move(change));
+
+    if (m_has_scheduled_write_back)
+        return;
+    m_has_scheduled_write_back = true;
+
+    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(page.heap(), [area = NonnullRefPtr { *this }, page = GC::Ref { page }] {
+        area->write_back_pending_changes(*page);
+    }));
+}
+
+void LocalStorageArea::write_back_pending_changes(Page& page)
+{
+    auto changes = move(m_pending_changes);
+    m_keys_with_pending_changes.clear();
+    m_has_pending_clear = false;
+    m_has_scheduled_write_back = false;
+
+    page.client().page_did_update_storage_items(StorageEndpointType::LocalStorage, m_storage_key, changes);
+}
+
+LocalStorageBottle::LocalStorageBottle(GC::Ref<DOM::Document> document, StorageKey key, Optional<u64> quota)
+    : StorageBottle(quota)
+    , m_document(document)
+    , m_area(LocalStorageArea::obtain(document->page(), key.to_string()))
+{
+}
+
 void LocalStorageBottle::visit_edges(GC::Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
-    visitor.visit(m_page);
+    visitor.visit(m_document);
+}
+
+String LocalStorageBottle::url() const
+{
+    return m_document->url().serialize();
 }
 
 size_t LocalStorageBottle::size() const
 {
-    return m_page->client().page_did_request_storage_keys(Web::StorageAPI::StorageEndpointType::LocalStorage, m_storage_key.to_string()).size();
+    return m_area->items().size();
 }
 
 Vector<String> LocalStorageBottle::keys() const
 {
-    return m_page->client().page_did_request_storage_keys(Web::StorageAPI::StorageEndpointType::LocalStorage, m_storage_key.to_string());
+    return m_area->items().keys();
 }
 
 Optional<String> LocalStorageBottle::get(String const& key) const
 {
-    return m_page->client().page_did_request_storage_item(Web::StorageAPI::StorageEndpointType::LocalStorage, m_storage_key.to_string(), key);
+    if (auto value = m_area->items().get(key); value.has_value())
+        return value.value();
+    return OptionalNone {};
 }
 
 WebView::StorageOperationError LocalStorageBottle::set(String const& key, String const& value)
 {
-    return m_page->client().page_did_set_storage_item(Web::StorageAPI::StorageEndpointType::LocalStorage, m_storage_key.to_string(), key, value);
+    return m_area->set(m_document->page(), key, value, m_quota, url());
 }
 
 void LocalStorageBottle::clear()
 {
-    m_page->client().page_did_clear_storage(Web::StorageAPI::StorageEndpointType::LocalStorage, m_storage_key.to_string());
+    m_area->clear(m_document->page(), url());
 }
 
 void LocalStorageBottle::remove(String const& key)
 {
-    m_page->client().page_did_remove_storage_item(Web::StorageAPI::StorageEndpointType::LocalStorage, m_storage_key.to_string(), key);
+    m_area->remove(m_document->page(), key, url());
 }
 
 size_t SessionStorageBottle::size() const
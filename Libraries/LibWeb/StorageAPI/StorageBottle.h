@@ -8,11 +8,14 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/RefCounted.h>
 #include <AK/String.h>
 #include <LibGC/Ptr.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/StorageAPI/StorageEndpoint.h>
+#include <LibWeb/StorageAPI/StorageItemChange.h>
 #include <LibWeb/StorageAPI/StorageKey.h>
 #include <LibWeb/StorageAPI/StorageType.h>
 #include <LibWebView/StorageOperationError.h>
@@ -49,16 +52,58 @@ protected:
     Optional<u64> m_quota;
 };
 
+// The items of local storage for a storage key, shared by all of its local storage bottles in this process. They are
+// loaded from the browser process all at once when the area is first obtained, after which reads never leave this
+// process. Changes are collected, and written back to the browser process in a single message once the current task is
+// done, which also passes them on to other WebContent processes.
+class LocalStorageArea final : public RefCounted<LocalStorageArea> {
+public:
+    static NonnullRefPtr<LocalStorageArea> obtain(Page&, String const& storage_key);
+    static RefPtr<LocalStorageArea> existing(String const& storage_key);
+
+    ~LocalStorageArea();
+
+    OrderedHashMap<String, String> const& items() const { return m_items; }
+
+    WebView::StorageOperationError set(Page&, String const& key, String const& value, Optional<u64> quota, String url);
+    void remove(Page&, String const& key, String url);
+    void clear(Page&, String url);
+
+    // Applies a change that another process made, unless a change of ours that hasn't been written back yet would
+    // overwrite it anyway. Returns whether the change was applied.
+    bool apply_change_from_other_process(StorageItemChange const&);
+
+private:
+    LocalStorageArea(String storage_key, OrderedHashMap<String, String> items);
+
+    void set_item(String const& key, String const& value);
+    void remove_item(String const& key);
+
+    void append_pending_change(Page&, StorageItemChange);
+    void write_back_pending_changes(Page&);
+
+    String m_storage_key;
+    OrderedHashMap<String, String> m_items;
+    size_t m_size_in_bytes { 0 };
+
+    Vector<StorageItemChange> m_pending_changes;
+    HashTable<String> m_keys_with_pending_changes;
+    bool m_has_pending_clear { false };
+    bool m_has_scheduled_write_back { false };
+};
+
 class LocalStorageBottle final : public StorageBottle {
     GC_CELL(LocalStorageBottle, StorageBottle);
     GC_DECLARE_ALLOCATOR(LocalStorageBottle);
 
 public:
-    static GC::Ref<LocalStorageBottle> create(GC::Heap& heap, GC::Ref<Page> page, StorageKey key, Optional<u64> quota)
+    static GC::Ref<LocalStorageBottle> create(GC::Heap& heap, GC::Ref<DOM::Document> document, StorageKey key, Optional<u64> quota)
     {
-        return heap.allocate<LocalStorageBottle>(page, key, quota);
+        return heap.allocate<LocalStorageBottle>(document, key, quota);
     }
 
+    LocalStorageArea const& area() const { return m_area; }
+
     virtual size_t size() const override;
     virtual Vector<String> keys() const override;
     virtual Optional<String> get(String const&) const override;
@@ -69,15 +114,12 @@ public:
     virtual void visit_edges(GC::Cell::Visitor& visitor) override;
 
 private:
-    explicit LocalStorageBottle(GC::Ref<Page> page, StorageKey key, Optional<u64> quota)
-        : StorageBottle(quota)
-        , m_page(move(page))
-        , m_storage_key(move(key))
-    {
-    }
+    LocalStorageBottle(GC::Ref<DOM::Document>, StorageKey, Optional<u64> quota);
+
+    String url() const;
 
-    GC::Ref<Page> m_page;
-    StorageKey m_storage_key;
+    GC::Ref<DOM::Document> m_document;
+    NonnullRefPtr<LocalStorageArea> m_area;
 };
 
 class SessionStorageBottle final : public StorageBottle {
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibWeb/StorageAPI/StorageItemChange.h>
+
+template<>
+ErrorOr<void> IPC::encode(Encoder& encoder, Web::StorageAPI::StorageItemChange const& change)
+{
+    TRY(encoder.encode(change.key));
+    TRY(encoder.encode(change.value));
+    TRY(encoder.encode(change.url));
+    return {};
+}
+
+template<>
+ErrorOr<Web::StorageAPI::StorageItemChange> IPC::decode(Decoder& decoder)
+{
+    auto key = TRY(decoder.decode<Optional<String>>());
+    auto value = TRY(decoder.decode<Optional<String>>());
+    auto url = TRY(decoder.decode<String>());
+
+    return Web::StorageAPI::StorageItemChange { move(key), move(value), move(url) };
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <LibIPC/Forward.h>
+#include <LibWeb/Export.h>
+
+namespace Web::StorageAPI {
+
+// A change made to a local storage bottle, as it is sent to the browser process to be written to disk and to be passed
+// on to other WebContent processes. A change without a key clears the bottle, and a change without a value removes the
+// key from it.
+struct StorageItemChange {
+    Optional<String> key;
+    Optional<String> value;
+
+    // The URL of the document that made the change, for the storage events fired in other processes.
+    String url;
+};
+
+}
+
+namespace IPC {
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::StorageAPI::StorageItemChange const&);
+
+template<>
+WEB_API ErrorOr<Web::StorageAPI::StorageItemChange> decode(Decoder&);
+
+}
@@ -279,7 +279,7 @@ WebIDL::ExceptionOr<GC::Ref<ReadableStreamDefaultReader>> ReadableStream::get_a_
 }
 
 // https://streams.spec.whatwg.org/#readablestream-pull-from-bytes
-WebIDL::ExceptionOr<void> ReadableStream::pull_from_bytes(ByteBuffer bytes)
+WebIDL::ExceptionOr<void> ReadableStream::pull_from_bytes(ByteBuffer& bytes)
 {
     auto& realm = this->realm();
 
@@ -301,24 +301,29 @@ WebIDL::ExceptionOr<void> ReadableStream::pull_from_bytes(ByteBuffer bytes)
     auto pull_size = min(available, desired_size);
 
     // 6. Let pulled be the first pullSize bytes of bytes.
-    auto pulled = pull_size == available ? move(bytes) : MUST(bytes.slice(0, pull_size));
-
     // 7. Remove the first pullSize bytes from bytes.
-    if (pull_size != available)
-        bytes = MUST(bytes.slice(pull_size, available - pull_size));
+    // NOTE: We write the pulled bytes straight into the BYOB request view, and only copy the bytes that remain. Without
+    //       a BYOB request, all bytes are pulled, and their buffer becomes the chunk's ArrayBuffer without a copy.
 
     // 8. If stream’s current BYOB request view is non-null, then:
     if (auto byob_view = current_byob_request_view()) {
         // 1. Write pulled into stream’s current BYOB request view.
-        byob_view->write(pulled);
+        byob_view->write(bytes.bytes().trim(pull_size));
+
+        if (pull_size == available)
+            bytes.clear();
+        else
+            bytes = MUST(ByteBuffer::copy(bytes.bytes().slice(pull_size)));
 
         // 2. Perform ? ReadableByteStreamControllerRespond(stream.[[controller]], pullSize).
         TRY(readable_byte_stream_controller_respond(controller, pull_size));
     }
     // 9. Otherwise,
     else {
+        VERIFY(pull_size == available);
+
         // 1. Set view to the result of creating a Uint8Array from pulled in stream’s relevant Realm.
-        auto array_buffer = JS::ArrayBuffer::create(realm, move(pulled));
+        auto array_buffer = JS::ArrayBuffer::create(realm, move(bytes));
         auto view = JS::Uint8Array::create(realm, array_buffer->byte_length(), *array_buffer);
 
         // 2. Perform ? ReadableByteStreamControllerEnqueue(stream.[[controller]], view).
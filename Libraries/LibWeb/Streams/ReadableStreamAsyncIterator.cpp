@@ -17,7 +17,7 @@ template<>
 void Intrinsics::create_web_prototype_and_constructor<ReadableStreamAsyncIteratorPrototype>(JS::Realm& realm)
 {
     auto prototype = realm.create<ReadableStreamAsyncIteratorPrototype>(realm);
-    m_prototypes.set("ReadableStreamAsyncIterator"_fly_string, prototype);
+    set_web_prototype("ReadableStreamAsyncIterator"_fly_string, prototype);
 }
 
 }
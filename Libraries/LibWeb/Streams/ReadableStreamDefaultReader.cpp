@@ -111,7 +111,8 @@ void ReadLoopReadRequest::on_chunk(JS::Value chunk)
 void ReadLoopReadRequest::on_close()
 {
     // 1. Call successSteps with bytes.
-    m_success_steps->function()(move(m_bytes));
+    // NOTE: The chunks are only copied into a single buffer here, instead of every time the buffer would have to grow.
+    m_success_steps->function()(MUST(m_bytes.coalesce()));
 }
 
 // error steps, given e
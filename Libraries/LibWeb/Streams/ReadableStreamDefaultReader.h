@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/ChainedBuffer.h>
 #include <AK/Function.h>
 #include <AK/SinglyLinkedList.h>
 #include <LibJS/Forward.h>
@@ -62,7 +63,7 @@ private:
 
     GC::Ref<JS::Realm> m_realm;
     GC::Ref<ReadableStreamDefaultReader> m_reader;
-    ByteBuffer m_bytes;
+    ChainedBuffer m_bytes;
     GC::Ref<SuccessSteps> m_success_steps;
     GC::Ref<FailureSteps> m_failure_steps;
     GC::Ptr<ChunkSteps> m_chunk_steps;
@@ -100,11 +100,58 @@ void ReadableStreamPipeTo::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_reader);
     visitor.visit(m_writer);
     visitor.visit(m_signal);
-    visitor.visit(m_pending_writes);
+    visitor.visit(m_read_request);
+    visitor.visit(m_write_chunk_and_continue);
+    visitor.visit(m_read_chunk);
+    visitor.visit(m_check_for_error_and_close_states);
+    visitor.visit(m_last_write);
     visitor.visit(m_unwritten_chunks);
 }
 
 void ReadableStreamPipeTo::process()
+{
+    m_read_chunk = GC::create_function(heap(), [this](JS::Value) -> WebIDL::ExceptionOr<JS::Value> {
+        read_chunk();
+        return JS::js_undefined();
+    });
+
+    m_check_for_error_and_close_states = GC::create_function(heap(), [this](JS::Value) -> WebIDL::ExceptionOr<JS::Value> {
+        check_for_error_and_close_states();
+        return JS::js_undefined();
+    });
+
+    m_write_chunk_and_continue = GC::create_function(heap(), [this]() {
+        HTML::TemporaryExecutionContext execution_context { m_realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
+        write_chunk();
+        read_chunk_when_writer_is_ready();
+    });
+
+    auto on_chunk = GC::create_function(heap(), [this](JS::Value chunk) {
+        m_unwritten_chunks.append(chunk);
+
+        if (check_for_error_and_close_states())
+            return;
+
+        HTML::queue_a_microtask(nullptr, *m_write_chunk_and_continue);
+    });
+
+    auto on_complete = GC::create_function(heap(), [this]() {
+        if (!check_for_error_and_close_states())
+            finish();
+    });
+
+    m_read_request = heap().allocate<ReadableStreamPipeToReadRequest>(on_chunk, on_complete, *m_check_for_error_and_close_states);
+
+    // Either stream may be closed or errored while we wait on a read or a write, which must shut the pipe down.
+    if (auto promise = m_reader->closed())
+        WebIDL::react_to_promise(*promise, m_check_for_error_and_close_states, m_check_for_error_and_close_states);
+    if (auto promise = m_writer->closed())
+        WebIDL::react_to_promise(*promise, m_check_for_error_and_close_states, m_check_for_error_and_close_states);
+
+    read_chunk_when_writer_is_ready();
+}
+
+void ReadableStreamPipeTo::read_chunk_when_writer_is_ready()
 {
     if (check_for_error_and_close_states())
         return;
@@ -116,20 +163,8 @@ void ReadableStreamPipeTo::process()
         return;
     }
 
-    auto when_ready = GC::create_function(m_realm->heap(), [this](JS::Value) -> WebIDL::ExceptionOr<JS::Value> {
-        read_chunk();
-        return JS::js_undefined();
-    });
-
-    auto shutdown = GC::create_function(heap(), [this](JS::Value) -> WebIDL::ExceptionOr<JS::Value> {
-        check_for_error_and_close_states();
-        return JS::js_undefined();
-    });
-
     if (ready_promise)
-        WebIDL::react_to_promise(*ready_promise, when_ready, shutdown);
-    if (auto promise = m_reader->closed())
-        WebIDL::react_to_promise(*promise, shutdown, shutdown);
+        WebIDL::react_to_promise(*ready_promise, m_read_chunk, m_check_for_error_and_close_states);
 }
 
 void ReadableStreamPipeTo::set_abort_signal(GC::Ref<DOM::AbortSignal> signal, DOM::AbortSignal::AbortSignal::AbortAlgorithmID signal_id)
@@ -217,34 +252,7 @@ void ReadableStreamPipeTo::read_chunk()
     if (check_for_error_and_close_states())
         return;
 
-    auto on_chunk = GC::create_function(heap(), [this](JS::Value chunk) {
-        m_unwritten_chunks.append(chunk);
-
-        if (check_for_error_and_close_states())
-            return;
-
-        HTML::queue_a_microtask(nullptr, GC::create_function(m_realm->heap(), [this]() {
-            HTML::TemporaryExecutionContext execution_context { m_realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
-            write_chunk();
-            process();
-        }));
-    });
-
-    auto on_complete = GC::create_function(heap(), [this]() {
-        if (!check_for_error_and_close_states())
-            finish();
-    });
-
-    auto shutdown = GC::create_function(heap(), [this](JS::Value) -> WebIDL::ExceptionOr<JS::Value> {
-        check_for_error_and_close_states();
-        return JS::js_undefined();
-    });
-
-    auto read_request = heap().allocate<ReadableStreamPipeToReadRequest>(on_chunk, on_complete, shutdown);
-    readable_stream_default_reader_read(m_reader, read_request);
-
-    if (auto promise = m_writer->closed())
-        WebIDL::react_to_promise(*promise, shutdown, shutdown);
+    readable_stream_default_reader_read(m_reader, *m_read_request);
 }
 
 void ReadableStreamPipeTo::write_chunk()
@@ -258,7 +266,7 @@ void ReadableStreamPipeTo::write_chunk()
     auto promise = writable_stream_default_writer_write(m_writer, m_unwritten_chunks.take_first());
     WebIDL::mark_promise_as_handled(promise);
 
-    m_pending_writes.append(promise);
+    m_last_write = promise;
 }
 
 void ReadableStreamPipeTo::write_unwritten_chunks()
@@ -270,14 +278,18 @@ void ReadableStreamPipeTo::write_unwritten_chunks()
 void ReadableStreamPipeTo::wait_for_pending_writes_to_complete(Function<void()> on_complete)
 {
     auto handler = GC::create_function(heap(), [this, on_complete = move(on_complete)]() {
-        m_pending_writes.clear();
+        m_last_write = nullptr;
         on_complete();
     });
 
     auto success_steps = [handler](Vector<JS::Value> const&) { handler->function()(); };
     auto failure_steps = [handler](JS::Value) { handler->function()(); };
 
-    WebIDL::wait_for_all(m_realm, m_pending_writes, move(success_steps), move(failure_steps));
+    Vector<GC::Ref<WebIDL::Promise>> pending_writes;
+    if (m_last_write)
+        pending_writes.append(*m_last_write);
+
+    WebIDL::wait_for_all(m_realm, pending_writes, move(success_steps), move(failure_steps));
 }
 
 // https://streams.spec.whatwg.org/#rs-pipeTo-finalize
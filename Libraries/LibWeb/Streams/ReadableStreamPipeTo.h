@@ -15,6 +15,8 @@
 
 namespace Web::Streams::Detail {
 
+class ReadableStreamPipeToReadRequest;
+
 // https://streams.spec.whatwg.org/#ref-for-in-parallel
 class ReadableStreamPipeTo final : public JS::Cell {
     GC_CELL(ReadableStreamPipeTo, JS::Cell);
@@ -42,6 +44,7 @@ private:
 
     virtual void visit_edges(Cell::Visitor& visitor) override;
 
+    void read_chunk_when_writer_is_ready();
     void read_chunk();
     void write_chunk();
 
@@ -68,7 +71,17 @@ private:
     GC::Ptr<DOM::AbortSignal> m_signal;
     DOM::AbortSignal::AbortAlgorithmID m_signal_id { 0 };
 
-    Vector<GC::Ref<WebIDL::Promise>> m_pending_writes;
+    // The pipe reads and writes one chunk after another for as long as it runs, so the objects that it needs for each
+    // chunk are only created once.
+    using PromiseReaction = GC::Function<WebIDL::ExceptionOr<JS::Value>(JS::Value)>;
+    GC::Ptr<ReadableStreamPipeToReadRequest> m_read_request;
+    GC::Ptr<GC::Function<void()>> m_write_chunk_and_continue;
+    GC::Ptr<PromiseReaction> m_read_chunk;
+    GC::Ptr<PromiseReaction> m_check_for_error_and_close_states;
+
+    // The writes to a writable stream settle in the order they were made, so waiting for the last one to settle is the
+    // same as waiting for all of them.
+    GC::Ptr<WebIDL::Promise> m_last_write;
     Vector<JS::Value, 1> m_unwritten_chunks;
 
     bool m_prevent_close { false };
@@ -9,6 +9,7 @@
 #include <AK/MemoryStream.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibCrypto/Hash/SHA2.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -17,6 +18,7 @@
 #include <LibJS/Runtime/Iterator.h>
 #include <LibJS/Runtime/NativeFunction.h>
 #include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Runtime/ValueInlines.h>
 #include <LibWasm/AbstractMachine/Validator.h>
@@ -419,22 +421,78 @@ JS::ThrowCompletionOr<NonnullOwnPtr<Wasm::ModuleInstance>> instantiate_module(JS
 
 // // https://webassembly.github.io/spec/js-api/#compile-a-webassembly-module
 // https://webassembly.github.io/content-security-policy/js-api/#compile-a-webassembly-module
+// Validated modules do not depend on the realm that compiled them, so a page that compiles the same bytes again (or
+// another page in this process that uses the same module) can skip parsing, validating and lowering them.
+struct CompiledModuleCacheEntry {
+    ByteBuffer digest;
+    size_t byte_size { 0 };
+    NonnullRefPtr<CompiledWebAssemblyModule> module;
+};
+
+static constexpr size_t MAXIMUM_COMPILED_MODULE_CACHE_ENTRIES = 16;
+static constexpr size_t MAXIMUM_COMPILED_MODULE_CACHE_SIZE = 64 * MiB;
+
+// Most recently used entries are at the end.
+static Vector<CompiledModuleCacheEntry>& compiled_module_cache()
+{
+    static Vector<CompiledModuleCacheEntry> s_cache;
+    return s_cache;
+}
+
+static RefPtr<CompiledWebAssemblyModule> take_cached_compiled_module(ReadonlyBytes digest)
+{
+    auto& cache = compiled_module_cache();
+    auto index = cache.find_first_index_if([&](auto const& entry) { return entry.digest.bytes() == digest; });
+    if (!index.has_value())
+        return nullptr;
+
+    auto entry = cache.take(*index);
+    auto module = entry.module;
+    cache.append(move(entry));
+    return module;
+}
+
+static void add_compiled_module_to_cache(ByteBuffer digest, size_t byte_size, NonnullRefPtr<CompiledWebAssemblyModule> module)
+{
+    if (byte_size > MAXIMUM_COMPILED_MODULE_CACHE_SIZE)
+        return;
+
+    auto& cache = compiled_module_cache();
+    auto total_size = byte_size;
+    for (auto const& entry : cache)
+        total_size += entry.byte_size;
+
+    while (!cache.is_empty() && (cache.size() >= MAXIMUM_COMPILED_MODULE_CACHE_ENTRIES || total_size > MAXIMUM_COMPILED_MODULE_CACHE_SIZE))
+        total_size -= cache.take_first().byte_size;
+
+    cache.append({ move(digest), byte_size, move(module) });
+}
+
 JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webassembly_module(JS::VM& vm, ByteBuffer data)
 {
     TRY(host_ensure_can_compile_wasm_bytes(vm));
 
+    auto& cache = get_cache(*vm.current_realm());
+
+    auto digest = ::Crypto::Hash::SHA256::hash(data);
+    if (auto compiled_module = take_cached_compiled_module(digest.bytes())) {
+        cache.add_compiled_module(*compiled_module);
+        return compiled_module.release_nonnull();
+    }
+
     FixedMemoryStream stream { data.bytes() };
     auto module_result = Wasm::Module::parse(stream);
     if (module_result.is_error()) {
         return vm.throw_completion<CompileError>(Wasm::parse_error_to_byte_string(module_result.error()));
     }
 
-    auto& cache = get_cache(*vm.current_realm());
     if (auto validation_result = cache.abstract_machine().validate(module_result.value()); validation_result.is_error()) {
         return vm.throw_completion<CompileError>(validation_result.error().error_string);
     }
     auto compiled_module = make_ref_counted<CompiledWebAssemblyModule>(module_result.release_value());
     cache.add_compiled_module(compiled_module);
+    if (auto digest_bytes = ByteBuffer::copy(digest.bytes()); !digest_bytes.is_error())
+        add_compiled_module_to_cache(digest_bytes.release_value(), data.size(), compiled_module);
     return compiled_module;
 }
 
@@ -506,6 +564,34 @@ ExportedWasmFunction::ExportedWasmFunction(Utf16FlyString name, AK::Function<JS:
 {
 }
 
+void WebAssemblyCache::update_profiler(JS::VM& vm)
+{
+    if (!vm.sampling_profiler()) {
+        if (m_profiler) {
+            m_abstract_machine.set_profiler(nullptr);
+            m_profiler = nullptr;
+        }
+        return;
+    }
+    if (m_profiler)
+        return;
+
+    m_profiler = make<Wasm::Profiler>();
+    m_profiler->name_for_function = [this](Wasm::FunctionAddress address) -> ByteString {
+        if (auto function = m_function_instances.get(address); function.has_value() && *function)
+            return MUST((*function)->name().view().to_byte_string());
+        if (auto* function = m_abstract_machine.store().get(address); function && function->has<Wasm::HostFunction>())
+            return function->get<Wasm::HostFunction>().name();
+        return {};
+    };
+    // The samples are taken by the Wasm profiler, but land in the JS one on top of the JS frames that called into Wasm.
+    m_profiler->on_sample = [&vm](StringView folded_frames, size_t weight) {
+        if (auto* sampling_profiler = vm.sampling_profiler())
+            sampling_profiler->add_sample(vm, folded_frames, weight);
+    };
+    m_abstract_machine.set_profiler(m_profiler.ptr());
+}
+
 JS::NativeFunction* create_native_function(JS::VM& vm, Wasm::FunctionAddress address, Utf16FlyString name, Instance* instance)
 {
     auto& realm = *vm.current_realm();
@@ -530,6 +616,7 @@ JS::NativeFunction* create_native_function(JS::VM& vm, Wasm::FunctionAddress add
                 values.append(TRY(to_webassembly_value(vm, vm.argument(index++), type)));
 
             auto& cache = get_cache(realm);
+            cache.update_profiler(vm);
             auto result = cache.abstract_machine().invoke(address, move(values));
             // FIXME: Use the convoluted mapping of errors defined in the spec.
             if (result.is_trap()) {
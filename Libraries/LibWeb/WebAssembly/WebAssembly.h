@@ -15,6 +15,7 @@
 #include <LibJS/Runtime/PrototypeObject.h>
 #include <LibJS/Runtime/Value.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/Profiler.h>
 #include <LibWeb/Export.h>
 #include <LibWeb/Forward.h>
 
@@ -71,6 +72,10 @@ public:
     HashTable<GC::Ptr<JS::Object>> const& imported_objects() const { return m_imported_objects; }
     Wasm::AbstractMachine& abstract_machine() { return m_abstract_machine; }
 
+    // Attaches a profiler to the abstract machine while the VM's sampling profiler runs, so that calls into Wasm show
+    // up in its samples, and detaches it once the sampling profiler has stopped.
+    void update_profiler(JS::VM&);
+
 private:
     HashMap<Wasm::FunctionAddress, GC::Ptr<JS::NativeFunction>> m_function_instances;
     HashMap<Wasm::ExternAddress, JS::Value> m_extern_values;
@@ -80,6 +85,7 @@ private:
     Vector<NonnullRefPtr<CompiledWebAssemblyModule>> m_compiled_modules;
     HashTable<GC::Ptr<JS::Object>> m_imported_objects;
     Wasm::AbstractMachine m_abstract_machine;
+    OwnPtr<Wasm::Profiler> m_profiler;
 };
 
 class ExportedWasmFunction final : public JS::NativeFunction {
@@ -60,14 +60,15 @@ WebIDL::ExceptionOr<GC::Ref<AudioContext>> AudioContext::construct_impl(JS::Real
 
         // 2. Set the internal latency of context according to contextOptions.latencyHint, as described in latencyHint.
         switch (context_options->latency_hint) {
+        // FIXME: Determine optimal settings for each category, these are only the latencies we ask the audio output for.
         case Bindings::AudioContextLatencyCategory::Balanced:
-            // FIXME: Determine optimal settings for balanced.
+            context->m_target_latency_ms = 50;
             break;
         case Bindings::AudioContextLatencyCategory::Interactive:
-            // FIXME: Determine optimal settings for interactive.
+            context->m_target_latency_ms = 20;
             break;
         case Bindings::AudioContextLatencyCategory::Playback:
-            // FIXME: Determine optimal settings for playback.
+            context->m_target_latency_ms = 100;
             break;
         default:
             VERIFY_NOT_REACHED();
@@ -94,6 +95,7 @@ WebIDL::ExceptionOr<GC::Ref<AudioContext>> AudioContext::construct_impl(JS::Real
 
         // 2. Set this [[rendering thread state]] to running on the AudioContext.
         context->set_rendering_state(Bindings::AudioContextState::Running);
+        context->start_rendering_audio_graph();
 
         // 3. Queue a media element task to execute the following steps:
         context->queue_a_media_element_task(GC::create_function(context->heap(), [&realm, context]() {
@@ -253,7 +255,10 @@ WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> AudioContext::suspend()
     // 7. Queue a control message to suspend the AudioContext.
     // FIXME: Implement control message queue to run following steps on the rendering thread
 
-    // FIXME: 7.1: Attempt to release system resources.
+    // 7.1: Attempt to release system resources.
+    m_rendering_audio_graph = false;
+    if (m_renderer)
+        m_renderer->suspend();
 
     // 7.2: Set the [[rendering thread state]] on the AudioContext to suspended.
     set_rendering_state(Bindings::AudioContextState::Suspended);
@@ -306,7 +311,10 @@ WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> AudioContext::close()
     // 5. Queue a control message to close the AudioContext.
     // FIXME: Implement control message queue to run following steps on the rendering thread
 
-    // FIXME: 5.1: Attempt to release system resources.
+    // 5.1: Attempt to release system resources.
+    m_rendering_audio_graph = false;
+    if (m_renderer)
+        m_renderer->suspend();
 
     // 5.2: Set the [[rendering thread state]] to "suspended".
     set_rendering_state(Bindings::AudioContextState::Suspended);
@@ -338,8 +346,53 @@ WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> AudioContext::close()
 // FIXME: Actually implement the rendering thread
 bool AudioContext::start_rendering_audio_graph()
 {
-    bool render_result = true;
-    return render_result;
+    m_rendering_audio_graph = true;
+    if (auto result = update_audio_renderer(); result.is_error()) {
+        dbgln("AudioContext: Failed to start rendering: {}", result.error());
+        return false;
+    }
+
+    if (m_renderer)
+        m_renderer->resume();
+    return true;
+}
+
+void AudioContext::update_render_graph()
+{
+    if (!m_rendering_audio_graph)
+        return;
+
+    if (auto result = update_audio_renderer(); result.is_error())
+        dbgln("AudioContext: Failed to update the rendered audio graph: {}", result.error());
+}
+
+ErrorOr<void> AudioContext::update_audio_renderer()
+{
+    // Don't open an audio output until there is something connected to the destination that could be heard.
+    if (!m_renderer && m_destination->input_connections().is_empty())
+        return {};
+
+    auto graph = TRY(RenderGraph::create(*m_destination));
+
+    if (!m_renderer) {
+        m_renderer = TRY(AudioRenderer::create(sample_rate(), static_cast<u8>(m_destination->channel_count()), m_target_latency_ms));
+        m_renderer->set_graph(move(graph));
+        m_renderer->resume();
+        return {};
+    }
+
+    m_renderer->set_graph(move(graph));
+    return {};
+}
+
+// https://webaudio.github.io/web-audio-api/#dom-baseaudiocontext-currenttime
+double AudioContext::current_time() const
+{
+    // This is the time in seconds of the sample frame immediately following the last sample-frame in the block of audio
+    // most recently processed by the context's rendering graph.
+    if (m_renderer)
+        return m_renderer->current_time();
+    return Base::current_time();
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audiocontext-createmediaelementsource
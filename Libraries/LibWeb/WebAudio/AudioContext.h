@@ -8,6 +8,7 @@
 
 #include <LibWeb/Bindings/AudioContextPrototype.h>
 #include <LibWeb/HighResolutionTime/DOMHighResTimeStamp.h>
+#include <LibWeb/WebAudio/AudioRenderer.h>
 #include <LibWeb/WebAudio/BaseAudioContext.h>
 #include <LibWeb/WebAudio/MediaElementAudioSourceNode.h>
 
@@ -42,6 +43,8 @@ public:
 
     WebIDL::ExceptionOr<GC::Ref<MediaElementAudioSourceNode>> create_media_element_source(GC::Ptr<HTML::HTMLMediaElement>);
 
+    virtual double current_time() const override;
+
 private:
     explicit AudioContext(JS::Realm& realm)
         : BaseAudioContext(realm)
@@ -51,6 +54,9 @@ private:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    virtual void update_render_graph() override;
+    ErrorOr<void> update_audio_renderer();
+
     double m_base_latency { 0 };
     double m_output_latency { 0 };
 
@@ -59,6 +65,10 @@ private:
     bool m_suspended_by_user = false;
 
     bool start_rendering_audio_graph();
+
+    u32 m_target_latency_ms { 20 };
+    bool m_rendering_audio_graph { false };
+    RefPtr<AudioRenderer> m_renderer;
 };
 
 }
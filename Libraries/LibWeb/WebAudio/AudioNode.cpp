@@ -83,6 +83,7 @@ WebIDL::ExceptionOr<GC::Ref<AudioNode>> AudioNode::connect(GC::Ref<AudioNode> de
     // Connect destination_node input to node's output.
     destination_node->m_input_connections.append(input_connection);
 
+    m_context->render_graph_did_change();
     return destination_node;
 }
 
@@ -129,6 +130,7 @@ void AudioNode::disconnect()
     }
 
     m_param_connections.clear();
+    m_context->render_graph_did_change();
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-output
@@ -156,6 +158,7 @@ WebIDL::ExceptionOr<void> AudioNode::disconnect(WebIDL::UnsignedLong output)
         return connection.output == output;
     });
 
+    m_context->render_graph_did_change();
     return {};
 }
 
@@ -180,6 +183,7 @@ WebIDL::ExceptionOr<void> AudioNode::disconnect(GC::Ref<AudioNode> destination_n
         return WebIDL::InvalidAccessError::create(realm(), Utf16String::formatted("No connection to given AudioNode"));
     }
 
+    m_context->render_graph_did_change();
     return {};
 }
 
@@ -210,6 +214,7 @@ WebIDL::ExceptionOr<void> AudioNode::disconnect(GC::Ref<AudioNode> destination_n
         return WebIDL::InvalidAccessError::create(realm(), Utf16String::formatted("No connection from output {} to given AudioNode", output));
     }
 
+    m_context->render_graph_did_change();
     return {};
 }
 
@@ -246,6 +251,7 @@ WebIDL::ExceptionOr<void> AudioNode::disconnect(GC::Ref<AudioNode> destination_n
         return WebIDL::InvalidAccessError::create(realm(), Utf16String::formatted("No connection from output {} to input {} of given AudioNode", output, input));
     }
 
+    m_context->render_graph_did_change();
     return {};
 }
 
@@ -297,6 +303,7 @@ WebIDL::ExceptionOr<void> AudioNode::set_channel_count(WebIDL::UnsignedLong chan
         return WebIDL::NotSupportedError::create(realm(), "Invalid channel count"_utf16);
 
     m_channel_count = channel_count;
+    m_context->render_graph_did_change();
     return {};
 }
 
@@ -304,6 +311,7 @@ WebIDL::ExceptionOr<void> AudioNode::set_channel_count(WebIDL::UnsignedLong chan
 WebIDL::ExceptionOr<void> AudioNode::set_channel_count_mode(Bindings::ChannelCountMode channel_count_mode)
 {
     m_channel_count_mode = channel_count_mode;
+    m_context->render_graph_did_change();
     return {};
 }
 
@@ -317,6 +325,7 @@ Bindings::ChannelCountMode AudioNode::channel_count_mode()
 WebIDL::ExceptionOr<void> AudioNode::set_channel_interpretation(Bindings::ChannelInterpretation channel_interpretation)
 {
     m_channel_interpretation = channel_interpretation;
+    m_context->render_graph_did_change();
     return {};
 }
 
@@ -326,6 +335,14 @@ Bindings::ChannelInterpretation AudioNode::channel_interpretation()
     return m_channel_interpretation;
 }
 
+NonnullRefPtr<RenderNode> AudioNode::render_node()
+{
+    // FIXME: Nodes that don't have a render node of their own yet output their input unchanged.
+    if (!m_default_render_node)
+        m_default_render_node = adopt_ref(*new PassThroughRenderNode);
+    return *m_default_render_node;
+}
+
 void AudioNode::initialize(JS::Realm& realm)
 {
     WEB_SET_PROTOTYPE_FOR_INTERFACE(AudioNode);
@@ -12,6 +12,7 @@
 #include <LibWeb/Bindings/AudioNodePrototype.h>
 #include <LibWeb/Bindings/PlatformObject.h>
 #include <LibWeb/DOM/EventTarget.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
 #include <LibWeb/WebIDL/Types.h>
 
 namespace Web::WebAudio {
@@ -86,6 +87,11 @@ public:
 
     WebIDL::ExceptionOr<void> initialize_audio_node_options(AudioNodeOptions const& given_options, AudioNodeDefaultOptions const& default_options);
 
+    Vector<AudioNodeConnection> const& input_connections() const { return m_input_connections; }
+
+    // The object that processes the audio of this node on the rendering thread.
+    virtual NonnullRefPtr<RenderNode> render_node();
+
 protected:
     AudioNode(JS::Realm&, GC::Ref<BaseAudioContext>, WebIDL::UnsignedLong channel_count = 2);
 
@@ -103,6 +109,8 @@ private:
     Vector<AudioNodeConnection> m_output_connections;
     // Connections from this node's outputs into AudioParams.
     Vector<AudioParamConnection> m_param_connections;
+
+    RefPtr<RenderNode> m_default_render_node;
 };
 
 }
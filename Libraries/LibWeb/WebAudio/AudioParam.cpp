@@ -23,6 +23,7 @@ AudioParam::AudioParam(JS::Realm& realm, GC::Ref<BaseAudioContext> context, floa
     , m_max_value(max_value)
     , m_automation_rate(automation_rate)
     , m_fixed_automation_rate(fixed_automation_rate)
+    , m_render_param(RenderParam::create(default_value, min_value, max_value, automation_rate))
 {
 }
 
@@ -46,6 +47,7 @@ float AudioParam::value() const
 void AudioParam::set_value(float value)
 {
     m_current_value = value;
+    m_render_param->set_value(value);
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audioparam-automationrate
@@ -61,6 +63,7 @@ WebIDL::ExceptionOr<void> AudioParam::set_automation_rate(Bindings::AutomationRa
         return WebIDL::InvalidStateError::create(realm(), "Automation rate cannot be changed"_utf16);
 
     m_automation_rate = automation_rate;
+    m_render_param->set_automation_rate(automation_rate);
     return {};
 }
 
@@ -85,27 +88,40 @@ float AudioParam::max_value() const
 // https://webaudio.github.io/web-audio-api/#dom-audioparam-setvalueattime
 WebIDL::ExceptionOr<GC::Ref<AudioParam>> AudioParam::set_value_at_time(float value, double start_time)
 {
-    (void)value;
-    (void)start_time;
-    dbgln("FIXME: Implement AudioParam::set_value_at_time");
+    // If startTime is negative, a RangeError exception MUST be thrown.
+    if (start_time < 0)
+        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::RangeError, "Start time must not be negative"sv };
+
+    if (!m_render_param->set_value_at_time(value, start_time))
+        dbgln("AudioParam: Dropping automation event, too many events are waiting to be rendered");
     return GC::Ref { *this };
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audioparam-linearramptovalueattime
 WebIDL::ExceptionOr<GC::Ref<AudioParam>> AudioParam::linear_ramp_to_value_at_time(float value, double end_time)
 {
-    (void)value;
-    (void)end_time;
-    dbgln("FIXME: Implement AudioParam::linear_ramp_to_value_at_time");
+    // If endTime is negative, a RangeError exception MUST be thrown.
+    if (end_time < 0)
+        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::RangeError, "End time must not be negative"sv };
+
+    if (!m_render_param->linear_ramp_to_value_at_time(value, end_time))
+        dbgln("AudioParam: Dropping automation event, too many events are waiting to be rendered");
     return GC::Ref { *this };
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audioparam-exponentialramptovalueattime
 WebIDL::ExceptionOr<GC::Ref<AudioParam>> AudioParam::exponential_ramp_to_value_at_time(float value, double end_time)
 {
-    (void)value;
-    (void)end_time;
-    dbgln("FIXME: Implement AudioParam::exponential_ramp_to_value_at_time");
+    // If this value is equal to 0, a RangeError exception MUST be thrown.
+    if (value == 0)
+        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::RangeError, "Value must not be zero"sv };
+
+    // If endTime is negative, a RangeError exception MUST be thrown.
+    if (end_time < 0)
+        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::RangeError, "End time must not be negative"sv };
+
+    if (!m_render_param->exponential_ramp_to_value_at_time(value, end_time))
+        dbgln("AudioParam: Dropping automation event, too many events are waiting to be rendered");
     return GC::Ref { *this };
 }
 
@@ -132,8 +148,12 @@ WebIDL::ExceptionOr<GC::Ref<AudioParam>> AudioParam::set_value_curve_at_time(Spa
 // https://webaudio.github.io/web-audio-api/#dom-audioparam-cancelscheduledvalues
 WebIDL::ExceptionOr<GC::Ref<AudioParam>> AudioParam::cancel_scheduled_values(double cancel_time)
 {
-    (void)cancel_time;
-    dbgln("FIXME: Implement AudioParam::cancel_scheduled_values");
+    // If cancelTime is negative, a RangeError exception MUST be thrown.
+    if (cancel_time < 0)
+        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::RangeError, "Cancel time must not be negative"sv };
+
+    if (!m_render_param->cancel_scheduled_values(cancel_time))
+        dbgln("AudioParam: Dropping automation event, too many events are waiting to be rendered");
     return GC::Ref { *this };
 }
 
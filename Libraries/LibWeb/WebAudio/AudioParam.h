@@ -9,6 +9,7 @@
 #include <LibJS/Forward.h>
 #include <LibWeb/Bindings/AudioParamPrototype.h>
 #include <LibWeb/Bindings/PlatformObject.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
 
 namespace Web::WebAudio {
 
@@ -46,6 +47,8 @@ public:
     WebIDL::ExceptionOr<GC::Ref<AudioParam>> cancel_scheduled_values(double cancel_time);
     WebIDL::ExceptionOr<GC::Ref<AudioParam>> cancel_and_hold_at_time(double cancel_time);
 
+    NonnullRefPtr<RenderParam> render_param() const { return m_render_param; }
+
 private:
     AudioParam(JS::Realm&, GC::Ref<BaseAudioContext>, float default_value, float min_value, float max_value, Bindings::AutomationRate, FixedAutomationRate = FixedAutomationRate::No);
 
@@ -63,6 +66,8 @@ private:
 
     FixedAutomationRate m_fixed_automation_rate { FixedAutomationRate::No };
 
+    NonnullRefPtr<RenderParam> m_render_param;
+
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 };
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/WebAudio/AudioRenderer.h>
+
+namespace Web::WebAudio {
+
+ErrorOr<NonnullRefPtr<AudioRenderer>> AudioRenderer::create(float sample_rate, u8 channel_count, u32 target_latency_ms)
+{
+    auto interleaved_quantum = TRY(FixedArray<float>::create(render_quantum_size * channel_count));
+    auto renderer = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) AudioRenderer(sample_rate, channel_count, move(interleaved_quantum))));
+
+    // The stream is owned by the renderer, so it can't call the renderer after it has been destroyed.
+    renderer->m_stream = TRY(Audio::PlaybackStream::create(
+        Audio::OutputState::Suspended, static_cast<u32>(sample_rate), channel_count, target_latency_ms,
+        [&renderer = *renderer](Bytes buffer, Audio::PcmSampleFormat format, size_t sample_count) -> ReadonlyBytes {
+            VERIFY(format == Audio::PcmSampleFormat::Float32);
+            return renderer.render(buffer, sample_count);
+        }));
+
+    return renderer;
+}
+
+AudioRenderer::AudioRenderer(float sample_rate, u8 channel_count, FixedArray<float> interleaved_quantum)
+    : m_sample_rate(sample_rate)
+    , m_channel_count(channel_count)
+    , m_interleaved_quantum(move(interleaved_quantum))
+{
+}
+
+AudioRenderer::~AudioRenderer()
+{
+    // Destroy the stream first, so that nothing is rendering anymore when the graphs are destroyed.
+    m_stream = nullptr;
+
+    delete m_graph;
+    delete m_pending_graph.exchange(nullptr);
+    destroy_retired_graphs();
+}
+
+void AudioRenderer::destroy_retired_graphs()
+{
+    auto* graph = m_retired_graphs.exchange(nullptr, AK::memory_order_acquire);
+    while (graph) {
+        auto* next = graph->next_retired_graph;
+        delete graph;
+        graph = next;
+    }
+}
+
+void AudioRenderer::set_graph(NonnullOwnPtr<RenderGraph> graph)
+{
+    destroy_retired_graphs();
+
+    // If the rendering thread hasn't picked up the previous graph yet, it never will.
+    delete m_pending_graph.exchange(graph.leak_ptr(), AK::memory_order_acq_rel);
+}
+
+void AudioRenderer::resume()
+{
+    m_stream->resume();
+}
+
+void AudioRenderer::suspend()
+{
+    m_stream->discard_buffer_and_suspend();
+}
+
+double AudioRenderer::current_time() const
+{
+    return static_cast<double>(m_rendered_frames.load(AK::memory_order_acquire)) / m_sample_rate;
+}
+
+ReadonlyBytes AudioRenderer::render(Bytes buffer, size_t frame_count)
+{
+    if (auto* new_graph = m_pending_graph.exchange(nullptr, AK::memory_order_acq_rel)) {
+        if (auto* old_graph = exchange(m_graph, new_graph)) {
+            old_graph->next_retired_graph = m_retired_graphs.load(AK::memory_order_relaxed);
+            while (!m_retired_graphs.compare_exchange_strong(old_graph->next_retired_graph, old_graph, AK::memory_order_release))
+                ;
+        }
+    }
+
+    auto* output = reinterpret_cast<float*>(buffer.data());
+    frame_count = min(frame_count, buffer.size() / (sizeof(float) * m_channel_count));
+
+    // The stream may ask for any number of frames, so a rendered quantum can be split between requests.
+    size_t frames_written = 0;
+    while (frames_written < frame_count) {
+        if (m_interleaved_quantum_offset == render_quantum_size) {
+            render_quantum();
+            m_interleaved_quantum_offset = 0;
+        }
+
+        auto frames = min(render_quantum_size - m_interleaved_quantum_offset, frame_count - frames_written);
+        auto source = m_interleaved_quantum.span().slice(m_interleaved_quantum_offset * m_channel_count, frames * m_channel_count);
+        source.copy_to({ output + frames_written * m_channel_count, frames * m_channel_count });
+
+        m_interleaved_quantum_offset += frames;
+        frames_written += frames;
+    }
+
+    return buffer.trim(frames_written * m_channel_count * sizeof(float));
+}
+
+void AudioRenderer::render_quantum()
+{
+    RenderContext context {
+        .frame = m_rendered_frames.load(AK::memory_order_relaxed),
+        .sample_rate = m_sample_rate,
+    };
+
+    if (!m_graph) {
+        m_interleaved_quantum.span().fill(0);
+    } else {
+        m_graph->render(context);
+
+        // A mono output is played on all channels of the stream, otherwise channels are matched up by their index.
+        auto const& output = m_graph->output();
+        for (size_t channel = 0; channel < m_channel_count; ++channel) {
+            if (output.channel_count() != 1 && channel >= output.channel_count()) {
+                for (size_t frame = 0; frame < render_quantum_size; ++frame)
+                    m_interleaved_quantum[frame * m_channel_count + channel] = 0;
+                continue;
+            }
+
+            auto samples = output.channel(output.channel_count() == 1 ? 0 : channel);
+            for (size_t frame = 0; frame < render_quantum_size; ++frame)
+                m_interleaved_quantum[frame * m_channel_count + channel] = samples[frame];
+        }
+    }
+
+    m_rendered_frames.store(context.frame + render_quantum_size, AK::memory_order_release);
+}
+
+}
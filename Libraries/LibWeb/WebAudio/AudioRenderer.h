@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/FixedArray.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibMedia/Audio/PlaybackStream.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
+
+namespace Web::WebAudio {
+
+// Renders the audio graph of an AudioContext into an audio output stream. Rendering happens one render quantum at a
+// time on the thread that the stream requests its data on, which acts as the rendering thread of the context.
+//
+// The control thread hands new snapshots of the graph to the rendering thread without ever blocking it: the rendering
+// thread picks up the latest snapshot at the start of each request, and old snapshots are handed back to be destroyed
+// on the control thread, so that the rendering thread doesn't allocate or free any memory.
+class AudioRenderer final : public AtomicRefCounted<AudioRenderer> {
+public:
+    static ErrorOr<NonnullRefPtr<AudioRenderer>> create(float sample_rate, u8 channel_count, u32 target_latency_ms);
+
+    ~AudioRenderer();
+
+    // These must only be called on the control thread.
+    void set_graph(NonnullOwnPtr<RenderGraph>);
+    void resume();
+    void suspend();
+
+    // The time of the next sample frame to be rendered, in seconds.
+    double current_time() const;
+
+private:
+    AudioRenderer(float sample_rate, u8 channel_count, FixedArray<float> interleaved_quantum);
+
+    ReadonlyBytes render(Bytes buffer, size_t frame_count);
+    void render_quantum();
+    void destroy_retired_graphs();
+
+    float m_sample_rate { 0 };
+    u8 m_channel_count { 0 };
+    RefPtr<Audio::PlaybackStream> m_stream;
+
+    Atomic<RenderGraph*> m_pending_graph { nullptr };
+    // A list of the retired graphs, linked through RenderGraph::next_retired_graph.
+    Atomic<RenderGraph*> m_retired_graphs { nullptr };
+    Atomic<u64> m_rendered_frames { 0 };
+
+    // These are only used by the rendering thread.
+    RenderGraph* m_graph { nullptr };
+    FixedArray<float> m_interleaved_quantum;
+    size_t m_interleaved_quantum_offset { render_quantum_size };
+};
+
+}
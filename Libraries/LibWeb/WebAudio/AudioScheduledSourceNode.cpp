@@ -47,10 +47,14 @@ WebIDL::ExceptionOr<void> AudioScheduledSourceNode::start(double when)
     // 3. Set the internal slot [[source started]] on this AudioScheduledSourceNode to true.
     set_source_started(true);
 
-    // FIXME: 4. Queue a control message to start the AudioScheduledSourceNode, including the parameter values in the message.
+    // 4. Queue a control message to start the AudioScheduledSourceNode, including the parameter values in the message.
+    if (auto render_node = scheduled_source_render_node())
+        render_node->start(when);
+    else
+        dbgln("FIXME: Implement AudioScheduledSourceNode::start for {}", class_name());
+
     // FIXME: 5. Send a control message to the associated AudioContext to start running its rendering thread only when all the following conditions are met:
 
-    dbgln("FIXME: Implement AudioScheduledSourceNode::start");
     return {};
 }
 
@@ -66,9 +70,12 @@ WebIDL::ExceptionOr<void> AudioScheduledSourceNode::stop(double when)
     if (when < 0)
         return WebIDL::SimpleException { WebIDL::SimpleExceptionType::RangeError, "when must not be negative"sv };
 
-    // FIXME: 3. Queue a control message to stop the AudioScheduledSourceNode, including the parameter values in the message.
+    // 3. Queue a control message to stop the AudioScheduledSourceNode, including the parameter values in the message.
+    if (auto render_node = scheduled_source_render_node())
+        render_node->stop(when);
+    else
+        dbgln("FIXME: Implement AudioScheduledSourceNode::stop for {}", class_name());
 
-    dbgln("FIXME: Implement AudioScheduledSourceNode::stop");
     return {};
 }
 
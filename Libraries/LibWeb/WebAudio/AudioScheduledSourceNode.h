@@ -30,6 +30,9 @@ protected:
     bool source_started() const { return m_source_started; }
     void set_source_started(bool started) { m_source_started = started; }
 
+    // The render node that starts and stops playing at the times given to start() and stop().
+    virtual RefPtr<ScheduledSourceRenderNode> scheduled_source_render_node() { return nullptr; }
+
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
@@ -209,6 +209,19 @@ WebIDL::ExceptionOr<void> BaseAudioContext::verify_audio_options_inside_nominal_
     return {};
 }
 
+void BaseAudioContext::render_graph_did_change()
+{
+    // Changes usually come in batches, such as when a graph is first set up, so only update the graph once they're done.
+    if (m_render_graph_update_queued)
+        return;
+    m_render_graph_update_queued = true;
+
+    queue_a_media_element_task(GC::create_function(heap(), [this] {
+        m_render_graph_update_queued = false;
+        update_render_graph();
+    }));
+}
+
 void BaseAudioContext::queue_a_media_element_task(GC::Ref<GC::Function<void()>> steps)
 {
     auto task = HTML::Task::create(vm(), m_media_element_event_task_source.source, HTML::current_principal_settings_object().responsible_document(), steps);
@@ -48,7 +48,7 @@ public:
 
     GC::Ref<AudioDestinationNode> destination() const { return *m_destination; }
     float sample_rate() const { return m_sample_rate; }
-    double current_time() const { return m_current_time; }
+    virtual double current_time() const { return m_current_time; }
     GC::Ref<AudioListener> listener() const { return m_listener; }
     Bindings::AudioContextState state() const { return m_control_thread_state; }
 
@@ -58,6 +58,9 @@ public:
     void set_onstatechange(WebIDL::CallbackType*);
     WebIDL::CallbackType* onstatechange();
 
+    // Called whenever a change to the nodes of this context may change how its audio graph is rendered.
+    void render_graph_did_change();
+
     void set_sample_rate(float sample_rate) { m_sample_rate = sample_rate; }
     void set_control_state(Bindings::AudioContextState state) { m_control_thread_state = state; }
     void set_rendering_state(Bindings::AudioContextState state) { m_rendering_thread_state = state; }
@@ -89,6 +92,9 @@ protected:
 
     void queue_a_media_element_task(GC::Ref<GC::Function<void()>>);
 
+    // Hands a new snapshot of the audio graph to the rendering thread, if there is one.
+    virtual void update_render_graph() { }
+
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
@@ -110,6 +116,8 @@ private:
     Bindings::AudioContextState m_rendering_thread_state = Bindings::AudioContextState::Suspended;
 
     HTML::UniqueTaskSource m_media_element_event_task_source {};
+
+    bool m_render_graph_update_queued { false };
 };
 
 }
@@ -24,6 +24,7 @@ BiquadFilterNode::BiquadFilterNode(JS::Realm& realm, GC::Ref<BaseAudioContext> c
     , m_detune(AudioParam::create(realm, context, options.detune, -1200 * AK::log2(NumericLimits<float>::max()), 1200 * AK::log2(NumericLimits<float>::max()), Bindings::AutomationRate::ARate))
     , m_q(AudioParam::create(realm, context, options.q, NumericLimits<float>::lowest(), NumericLimits<float>::max(), Bindings::AutomationRate::ARate))
     , m_gain(AudioParam::create(realm, context, options.gain, NumericLimits<float>::lowest(), 40 * AK::log10(NumericLimits<float>::max()), Bindings::AutomationRate::ARate))
+    , m_render_node(adopt_ref(*new BiquadFilterRenderNode(options.type, m_frequency->render_param(), m_detune->render_param(), m_q->render_param(), m_gain->render_param())))
 {
 }
 
@@ -33,6 +34,7 @@ BiquadFilterNode::~BiquadFilterNode() = default;
 void BiquadFilterNode::set_type(Bindings::BiquadFilterType type)
 {
     m_type = type;
+    m_render_node->set_type(type);
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-biquadfilternode-type
@@ -38,6 +38,8 @@ public:
     GC::Ref<AudioParam> detune() const;
     GC::Ref<AudioParam> q() const;
     GC::Ref<AudioParam> gain() const;
+    virtual NonnullRefPtr<RenderNode> render_node() override { return m_render_node; }
+
     WebIDL::ExceptionOr<void> get_frequency_response(GC::Root<WebIDL::BufferSource> const&, GC::Root<WebIDL::BufferSource> const&, GC::Root<WebIDL::BufferSource> const&);
 
     static WebIDL::ExceptionOr<GC::Ref<BiquadFilterNode>> create(JS::Realm&, GC::Ref<BaseAudioContext>, BiquadFilterOptions const& = {});
@@ -63,6 +65,8 @@ private:
 
     // https://webaudio.github.io/web-audio-api/#dom-biquadfilternode-gain
     GC::Ref<AudioParam> m_gain;
+
+    NonnullRefPtr<BiquadFilterRenderNode> m_render_node;
 };
 
 }
@@ -32,6 +32,8 @@ public:
 
     GC::Ref<AudioParam const> gain() const { return m_gain; }
 
+    virtual NonnullRefPtr<RenderNode> render_node() override { return m_render_node; }
+
 protected:
     GainNode(JS::Realm&, GC::Ref<BaseAudioContext>, GainOptions const& = {});
 
@@ -41,6 +43,8 @@ protected:
 private:
     // https://webaudio.github.io/web-audio-api/#dom-gainnode-gain
     GC::Ref<AudioParam> m_gain;
+
+    NonnullRefPtr<GainRenderNode> m_render_node;
 };
 
 }
@@ -4,11 +4,18 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibThreading/BackgroundAction.h>
+#include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/HTML/EventNames.h>
+#include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/HTML/Window.h>
+#include <LibWeb/WebAudio/AudioBuffer.h>
 #include <LibWeb/WebAudio/AudioDestinationNode.h>
 #include <LibWeb/WebAudio/OfflineAudioContext.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
+#include <LibWeb/WebIDL/DOMException.h>
+#include <LibWeb/WebIDL/Promise.h>
 
 namespace Web::WebAudio {
 
@@ -23,7 +30,7 @@ WebIDL::ExceptionOr<GC::Ref<OfflineAudioContext>> OfflineAudioContext::construct
     TRY(verify_audio_options_inside_nominal_range(realm, context_options.number_of_channels, context_options.length, context_options.sample_rate));
 
     // Let c be a new OfflineAudioContext object. Initialize c as follows:
-    auto c = realm.create<OfflineAudioContext>(realm, context_options.length, context_options.sample_rate);
+    auto c = realm.create<OfflineAudioContext>(realm, context_options.number_of_channels, context_options.length, context_options.sample_rate);
 
     // 1. Set the [[control thread state]] for c to "suspended".
     c->set_control_state(Bindings::AudioContextState::Suspended);
@@ -58,7 +65,113 @@ OfflineAudioContext::~OfflineAudioContext() = default;
 // https://webaudio.github.io/web-audio-api/#dom-offlineaudiocontext-startrendering
 WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> OfflineAudioContext::start_rendering()
 {
-    return WebIDL::NotSupportedError::create(realm(), "FIXME: Implement OfflineAudioContext::start_rendering"_utf16);
+    auto& realm = this->realm();
+
+    // 1. If this's relevant global object's associated Document is not fully active then return a promise rejected with
+    //    "InvalidStateError" DOMException.
+    auto const& associated_document = as<HTML::Window>(HTML::relevant_global_object(*this)).associated_document();
+    if (!associated_document.is_fully_active())
+        return WebIDL::InvalidStateError::create(realm, "Document is not fully active"_utf16);
+
+    // 2. If the [[rendering started]] slot on the OfflineAudioContext is true, return a rejected promise with
+    //    InvalidStateError, and abort these steps.
+    if (m_rendering_started)
+        return WebIDL::InvalidStateError::create(realm, "Rendering has already been started"_utf16);
+
+    // 3. Set the [[rendering started]] slot of the OfflineAudioContext to true.
+    m_rendering_started = true;
+
+    // 4. Let promise be a new promise.
+    auto promise = WebIDL::create_promise(realm);
+
+    // 5. Create a new AudioBuffer, with a number of channels, length and sample rate equal respectively to the
+    //    numberOfChannels, length and sampleRate values passed to this instance's constructor in the contextOptions
+    //    parameter. Assign this buffer to an internal slot [[rendered buffer]] in the OfflineAudioContext.
+    auto buffer_or_exception = AudioBuffer::create(realm, m_number_of_channels, m_length, sample_rate());
+
+    // 6. If an exception was thrown during the preceding AudioBuffer constructor call, reject promise with this exception.
+    if (buffer_or_exception.is_exception()) {
+        auto exception = Bindings::exception_to_throw_completion(realm.vm(), buffer_or_exception.release_error());
+        WebIDL::reject_promise(realm, promise, exception.release_value());
+        return promise;
+    }
+
+    // 7. Otherwise, in the case that the buffer was successfully constructed, begin offline rendering.
+    m_rendered_buffer = buffer_or_exception.release_value();
+    begin_offline_rendering(promise);
+
+    // 8. Append promise to [[pending promises]].
+    m_pending_promises.append(promise);
+
+    // 9. Return promise.
+    return promise;
+}
+
+// https://webaudio.github.io/web-audio-api/#begin-offline-rendering
+void OfflineAudioContext::begin_offline_rendering(GC::Ref<WebIDL::Promise> promise)
+{
+    set_control_state(Bindings::AudioContextState::Running);
+    set_rendering_state(Bindings::AudioContextState::Running);
+
+    // The following steps MUST happen on a rendering thread that is created for the occasion.
+    // NOTE: Nothing is waiting for the output of an offline context, so it is rendered as fast as possible, with the
+    //       independent parts of the graph rendered in parallel.
+    auto on_rendering_finished = [this, promise](GC::Ptr<WebIDL::DOMException> exception) {
+        // 4. Once the rendering is complete, queue a media element task to execute the following steps:
+        queue_a_media_element_task(GC::create_function(heap(), [this, promise, exception]() {
+            auto& realm = this->realm();
+            HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+
+            m_pending_promises.remove_first_matching([&](auto& pending_promise) { return pending_promise == promise; });
+            set_control_state(Bindings::AudioContextState::Closed);
+            set_rendering_state(Bindings::AudioContextState::Closed);
+
+            if (exception) {
+                WebIDL::reject_promise(realm, promise, exception);
+                return;
+            }
+
+            // 1. Resolve the promise created by startRendering() with [[rendered buffer]].
+            WebIDL::resolve_promise(realm, promise, m_rendered_buffer);
+
+            // 2. Queue a media element task to fire an event named complete using an instance of OfflineAudioCompletionEvent
+            //    whose renderedBuffer property is set to [[rendered buffer]].
+            // FIXME: Fire an OfflineAudioCompletionEvent once it is implemented.
+            queue_a_media_element_task(GC::create_function(heap(), [this]() {
+                dispatch_event(DOM::Event::create(this->realm(), HTML::EventNames::complete));
+            }));
+
+            queue_a_media_element_task(GC::create_function(heap(), [this]() {
+                dispatch_event(DOM::Event::create(this->realm(), HTML::EventNames::statechange));
+            }));
+        }));
+    };
+
+    // 1. Given the current connections and scheduled changes, start rendering length sample-frames of audio into
+    //    [[rendered buffer]].
+    // FIXME: 2. For every render quantum, check and suspend rendering if necessary.
+    // FIXME: 3. If a suspended context is resumed, continue to render the buffer.
+    auto graph_or_error = RenderGraph::create(*m_destination);
+    if (graph_or_error.is_error()) {
+        on_rendering_finished(WebIDL::OperationError::create(realm(), Utf16String::formatted("Failed to render audio: {}", graph_or_error.error())));
+        return;
+    }
+
+    (void)Threading::BackgroundAction<Vector<FixedArray<float>>>::construct(
+        [graph = graph_or_error.release_value(), sample_rate = sample_rate(), length = m_length](auto&) -> ErrorOr<Vector<FixedArray<float>>> {
+            return graph->render_offline(sample_rate, length);
+        },
+        [self = GC::make_root(this), on_rendering_finished](Vector<FixedArray<float>> channels) -> ErrorOr<void> {
+            for (size_t channel = 0; channel < min<size_t>(channels.size(), self->m_rendered_buffer->number_of_channels()); ++channel) {
+                auto channel_data = MUST(self->m_rendered_buffer->get_channel_data(channel));
+                channels[channel].span().copy_to(channel_data->data());
+            }
+            on_rendering_finished(nullptr);
+            return {};
+        },
+        [self = GC::make_root(this), on_rendering_finished](Error error) {
+            on_rendering_finished(WebIDL::OperationError::create(self->realm(), Utf16String::formatted("Failed to render audio: {}", error)));
+        });
 }
 
 WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> OfflineAudioContext::resume()
@@ -91,8 +204,9 @@ void OfflineAudioContext::set_oncomplete(GC::Ptr<WebIDL::CallbackType> value)
     set_event_handler_attribute(HTML::EventNames::complete, value);
 }
 
-OfflineAudioContext::OfflineAudioContext(JS::Realm& realm, WebIDL::UnsignedLong length, float sample_rate)
+OfflineAudioContext::OfflineAudioContext(JS::Realm& realm, WebIDL::UnsignedLong number_of_channels, WebIDL::UnsignedLong length, float sample_rate)
     : BaseAudioContext(realm, sample_rate)
+    , m_number_of_channels(number_of_channels)
     , m_length(length)
 {
 }
@@ -106,6 +220,7 @@ void OfflineAudioContext::initialize(JS::Realm& realm)
 void OfflineAudioContext::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
+    visitor.visit(m_rendered_buffer);
 }
 
 }
@@ -52,6 +52,7 @@ OscillatorNode::OscillatorNode(JS::Realm& realm, GC::Ref<BaseAudioContext> conte
     , m_type(options.type)
     , m_frequency(AudioParam::create(realm, context, options.frequency, -context->nyquist_frequency(), context->nyquist_frequency(), Bindings::AutomationRate::ARate))
     , m_detune(AudioParam::create(realm, context, options.detune, -1200 * AK::log2(NumericLimits<float>::max()), 1200 * AK::log2(NumericLimits<float>::max()), Bindings::AutomationRate::ARate))
+    , m_render_node(adopt_ref(*new OscillatorRenderNode(options.type, m_frequency->render_param(), m_detune->render_param())))
 {
 }
 
@@ -71,6 +72,7 @@ WebIDL::ExceptionOr<void> OscillatorNode::set_type(Bindings::OscillatorType type
     set_periodic_wave(nullptr);
 
     m_type = type;
+    m_render_node->set_type(type);
     return {};
 }
 
@@ -79,6 +81,7 @@ void OscillatorNode::set_periodic_wave(GC::Ptr<PeriodicWave> periodic_wave)
 {
     m_periodic_wave = periodic_wave;
     m_type = Bindings::OscillatorType::Custom;
+    m_render_node->set_type(m_type);
 }
 
 void OscillatorNode::initialize(JS::Realm& realm)
@@ -41,12 +41,16 @@ public:
     WebIDL::UnsignedLong number_of_inputs() override { return 0; }
     WebIDL::UnsignedLong number_of_outputs() override { return 1; }
 
+    virtual NonnullRefPtr<RenderNode> render_node() override { return m_render_node; }
+
 protected:
     OscillatorNode(JS::Realm&, GC::Ref<BaseAudioContext>, OscillatorOptions const& = {});
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    virtual RefPtr<ScheduledSourceRenderNode> scheduled_source_render_node() override { return m_render_node; }
+
 private:
     // https://webaudio.github.io/web-audio-api/#dom-oscillatornode-type
     Bindings::OscillatorType m_type { Bindings::OscillatorType::Sine };
@@ -58,6 +62,8 @@ private:
     GC::Ref<AudioParam> m_detune;
 
     GC::Ptr<PeriodicWave> m_periodic_wave;
+
+    NonnullRefPtr<OscillatorRenderNode> m_render_node;
 };
 
 }
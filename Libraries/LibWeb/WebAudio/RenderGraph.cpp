@@ -0,0 +1,731 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/Math.h>
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
+#include <LibThreading/Parallel.h>
+#include <LibWeb/WebAudio/AudioNode.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
+
+// See the comment in AK/SIMDMath.h for why this is needed.
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace Web::WebAudio {
+
+using AK::SIMD::f32x4;
+using AK::SIMD::load_unaligned;
+using AK::SIMD::store_unaligned;
+
+static_assert(render_quantum_size % 4 == 0);
+
+static void copy_samples(Span<float> destination, ReadonlySpan<float> source)
+{
+    source.copy_to(destination);
+}
+
+static void add_samples(Span<float> destination, ReadonlySpan<float> source)
+{
+    for (size_t i = 0; i < render_quantum_size; i += 4) {
+        auto sum = load_unaligned<f32x4>(&destination[i]) + load_unaligned<f32x4>(&source[i]);
+        store_unaligned(&destination[i], sum);
+    }
+}
+
+static void add_scaled_samples(Span<float> destination, ReadonlySpan<float> source, float scale)
+{
+    for (size_t i = 0; i < render_quantum_size; i += 4) {
+        auto sum = load_unaligned<f32x4>(&destination[i]) + load_unaligned<f32x4>(&source[i]) * scale;
+        store_unaligned(&destination[i], sum);
+    }
+}
+
+static void multiply_samples(Span<float> destination, ReadonlySpan<float> source, float scale)
+{
+    for (size_t i = 0; i < render_quantum_size; i += 4)
+        store_unaligned(&destination[i], load_unaligned<f32x4>(&source[i]) * scale);
+}
+
+static void multiply_samples(Span<float> destination, ReadonlySpan<float> source, ReadonlySpan<float> scales)
+{
+    for (size_t i = 0; i < render_quantum_size; i += 4)
+        store_unaligned(&destination[i], load_unaligned<f32x4>(&source[i]) * load_unaligned<f32x4>(&scales[i]));
+}
+
+static void clamp_samples(Span<float> samples, float min, float max)
+{
+    for (size_t i = 0; i < samples.size(); i += 4)
+        store_unaligned(&samples[i], AK::SIMD::clamp(load_unaligned<f32x4>(&samples[i]), min, max));
+}
+
+ErrorOr<AudioBus> AudioBus::create(size_t channel_count)
+{
+    VERIFY(channel_count > 0 && channel_count <= max_render_channel_count);
+
+    AudioBus bus;
+    bus.m_channel_count = channel_count;
+    bus.m_samples = TRY(FixedArray<float>::create(channel_count * render_quantum_size));
+    return bus;
+}
+
+void AudioBus::zero()
+{
+    m_samples.span().fill(0);
+}
+
+// https://webaudio.github.io/web-audio-api/#channel-up-mixing-and-down-mixing
+void AudioBus::sum_from(AudioBus const& source, Bindings::ChannelInterpretation interpretation)
+{
+    auto source_channel_count = source.channel_count();
+
+    if (interpretation == Bindings::ChannelInterpretation::Speakers && source_channel_count != m_channel_count) {
+        // Mono up-mix:
+        //     output.L = input.M;
+        //     output.R = input.M;
+        if (source_channel_count == 1 && m_channel_count == 2) {
+            add_samples(channel(0), source.channel(0));
+            add_samples(channel(1), source.channel(0));
+            return;
+        }
+
+        // Stereo down-mix:
+        //     output.M = 0.5 * (input.L + input.R);
+        if (source_channel_count == 2 && m_channel_count == 1) {
+            add_scaled_samples(channel(0), source.channel(0), 0.5f);
+            add_scaled_samples(channel(0), source.channel(1), 0.5f);
+            return;
+        }
+
+        // FIXME: Mix between the quad and 5.1 speaker layouts as well. Until then, they are mixed as discrete channels.
+    }
+
+    // Fill each output channel with its input counterpart, that is the input channel with the same index. Channels with
+    // no corresponding input channels are left silent, and input channels without output channels are dropped.
+    for (size_t channel_index = 0; channel_index < min(source_channel_count, m_channel_count); ++channel_index)
+        add_samples(channel(channel_index), source.channel(channel_index));
+}
+
+NonnullRefPtr<RenderParam> RenderParam::create(float default_value, float min_value, float max_value, Bindings::AutomationRate automation_rate)
+{
+    return adopt_ref(*new RenderParam(default_value, min_value, max_value, automation_rate));
+}
+
+RenderParam::RenderParam(float default_value, float min_value, float max_value, Bindings::AutomationRate automation_rate)
+    : m_min_value(min_value)
+    , m_max_value(max_value)
+    , m_automation_rate(automation_rate)
+    , m_current_value(default_value)
+{
+    m_timeline.ensure_capacity(event_queue_size);
+    m_values.fill(default_value);
+}
+
+bool RenderParam::enqueue(Event event)
+{
+    // This is only ever called on the control thread, which is the only producer.
+    auto tail = m_event_queue_tail.load(AK::memory_order_relaxed);
+    auto head = m_event_queue_head.load(AK::memory_order_acquire);
+    if (tail - head == event_queue_size)
+        return false;
+
+    m_event_queue[tail % event_queue_size] = event;
+    m_event_queue_tail.store(tail + 1, AK::memory_order_release);
+    return true;
+}
+
+void RenderParam::set_value(float value)
+{
+    m_pending_value.store(value, AK::memory_order_relaxed);
+    m_has_pending_value.store(true, AK::memory_order_release);
+}
+
+bool RenderParam::set_value_at_time(float value, double time)
+{
+    return enqueue({ EventType::SetValue, value, time });
+}
+
+bool RenderParam::linear_ramp_to_value_at_time(float value, double time)
+{
+    return enqueue({ EventType::LinearRamp, value, time });
+}
+
+bool RenderParam::exponential_ramp_to_value_at_time(float value, double time)
+{
+    return enqueue({ EventType::ExponentialRamp, value, time });
+}
+
+bool RenderParam::cancel_scheduled_values(double time)
+{
+    return enqueue({ EventType::Cancel, 0, time });
+}
+
+void RenderParam::insert_event(Event event)
+{
+    // Dropping the event is the only thing we can do without allocating on the audio thread.
+    if (m_timeline.size() == m_timeline.capacity())
+        return;
+
+    // Events with the same time are kept in the order they were scheduled in.
+    auto index = m_timeline.size();
+    while (index > 0 && m_timeline[index - 1].time > event.time)
+        --index;
+    m_timeline.insert(index, event);
+}
+
+void RenderParam::dequeue_events(RenderContext const& context)
+{
+    auto head = m_event_queue_head.load(AK::memory_order_relaxed);
+    auto tail = m_event_queue_tail.load(AK::memory_order_acquire);
+
+    for (; head != tail; ++head) {
+        auto event = m_event_queue[head % event_queue_size];
+
+        switch (event.type) {
+        case EventType::SetValue:
+            insert_event(event);
+            break;
+        case EventType::LinearRamp:
+        case EventType::ExponentialRamp:
+            // A ramp starts at the event before it. If there is none, it starts at the current value at the time it was
+            // scheduled.
+            if (m_timeline.is_empty() || m_timeline.first().time > context.time())
+                insert_event({ EventType::SetValue, m_current_value, context.time() });
+            insert_event(event);
+            break;
+        case EventType::Cancel:
+            // https://webaudio.github.io/web-audio-api/#dom-audioparam-cancelscheduledvalues
+            // Cancels all scheduled parameter changes with times greater than or equal to cancelTime.
+            m_timeline.remove_all_matching([&](auto const& scheduled_event) {
+                return scheduled_event.time >= event.time;
+            });
+            break;
+        }
+    }
+
+    m_event_queue_head.store(head, AK::memory_order_release);
+
+    // https://webaudio.github.io/web-audio-api/#dom-audioparam-value
+    // Setting this attribute has the effect of assigning the requested value to the [[current value]] slot, and calling
+    // the setValueAtTime() method with the current AudioContext's currentTime and [[current value]].
+    if (m_has_pending_value.exchange(false, AK::memory_order_acquire)) {
+        m_current_value = m_pending_value.load(AK::memory_order_relaxed);
+        insert_event({ EventType::SetValue, m_current_value, context.time() });
+    }
+}
+
+// https://webaudio.github.io/web-audio-api/#computation-of-value
+float RenderParam::value_at_time(double time, size_t& event_index) const
+{
+    // The index always points at the first event after the time, and only moves forward as the time does.
+    while (event_index < m_timeline.size() && m_timeline[event_index].time <= time)
+        ++event_index;
+
+    if (event_index < m_timeline.size() && event_index > 0) {
+        auto const& previous = m_timeline[event_index - 1];
+        auto const& next = m_timeline[event_index];
+        auto fraction = (time - previous.time) / (next.time - previous.time);
+
+        // https://webaudio.github.io/web-audio-api/#dom-audioparam-linearramptovalueattime
+        // v(t) = V0 + (V1 - V0) * ((t - T0) / (T1 - T0))
+        if (next.type == EventType::LinearRamp)
+            return static_cast<float>(previous.value + (next.value - previous.value) * fraction);
+
+        // https://webaudio.github.io/web-audio-api/#dom-audioparam-exponentialramptovalueattime
+        // v(t) = V0 * (V1 / V0) ^ ((t - T0) / (T1 - T0))
+        // If V0 and V1 have opposite signs or if V0 is zero, then v(t) = V0 for T0 <= t < T1.
+        if (next.type == EventType::ExponentialRamp) {
+            if (previous.value == 0 || (previous.value < 0) != (next.value < 0))
+                return previous.value;
+            return static_cast<float>(previous.value * AK::pow(static_cast<double>(next.value / previous.value), fraction));
+        }
+    }
+
+    if (event_index > 0)
+        return m_timeline[event_index - 1].value;
+    return m_current_value;
+}
+
+bool RenderParam::is_constant_between(double start_time, double end_time) const
+{
+    // The value changes if a ramp towards the first event after the start is in progress, or if that event happens
+    // before the end.
+    for (auto const& event : m_timeline) {
+        if (event.time <= start_time)
+            continue;
+        return event.type == EventType::SetValue && event.time >= end_time;
+    }
+    return true;
+}
+
+ReadonlySpan<float> RenderParam::compute_values(RenderContext const& context)
+{
+    dequeue_events(context);
+
+    // Events before the last one that has started don't affect the value anymore. That last one does stay around, as it
+    // is where a ramp scheduled after it starts from.
+    auto start_time = context.time();
+    size_t finished_events = 0;
+    while (finished_events + 1 < m_timeline.size() && m_timeline[finished_events + 1].time <= start_time)
+        ++finished_events;
+    m_timeline.remove(0, finished_events);
+
+    size_t event_index = 0;
+    auto end_time = context.time_of_frame(render_quantum_size);
+
+    // https://webaudio.github.io/web-audio-api/#k-rate
+    // A k-rate AudioParam uses the same initial audio parameter value for the whole render quantum.
+    if (m_automation_rate.load(AK::memory_order_relaxed) == Bindings::AutomationRate::KRate || is_constant_between(start_time, end_time)) {
+        m_current_value = value_at_time(start_time, event_index);
+        m_values[0] = clamp(m_current_value, m_min_value, m_max_value);
+        return m_values.span().trim(1);
+    }
+
+    // https://webaudio.github.io/web-audio-api/#a-rate
+    // An a-rate AudioParam takes the current audio parameter value for each sample frame of the audio signal.
+    for (size_t i = 0; i < render_quantum_size; ++i)
+        m_values[i] = value_at_time(context.time_of_frame(i), event_index);
+    m_current_value = m_values[render_quantum_size - 1];
+    clamp_samples(m_values.span(), m_min_value, m_max_value);
+    return m_values.span();
+}
+
+void PassThroughRenderNode::process(RenderContext const&, AudioBus const& input, AudioBus& output)
+{
+    for (size_t channel = 0; channel < output.channel_count(); ++channel)
+        copy_samples(output.channel(channel), input.channel(channel));
+}
+
+// https://webaudio.github.io/web-audio-api/#GainNode
+void GainRenderNode::process(RenderContext const& context, AudioBus const& input, AudioBus& output)
+{
+    // Each sample of each channel of the input data of the GainNode MUST be multiplied by the computedValue of the gain
+    // AudioParam.
+    auto gains = m_gain->compute_values(context);
+    for (size_t channel = 0; channel < output.channel_count(); ++channel) {
+        if (gains.size() == 1)
+            multiply_samples(output.channel(channel), input.channel(channel), gains[0]);
+        else
+            multiply_samples(output.channel(channel), input.channel(channel), gains);
+    }
+}
+
+ScheduledSourceRenderNode::PlayingFrames ScheduledSourceRenderNode::playing_frames(RenderContext const& context) const
+{
+    auto frame_at_time = [&](double time) -> size_t {
+        // Allow for rounding errors when converting the time to a frame, so that times that fall on a frame play from it.
+        auto frame = AK::ceil(time * context.sample_rate - static_cast<double>(context.frame) - 1e-6);
+        if (frame <= 0)
+            return 0;
+        if (frame >= render_quantum_size)
+            return render_quantum_size;
+        return static_cast<size_t>(frame);
+    };
+
+    auto start = frame_at_time(m_start_time.load(AK::memory_order_acquire));
+    auto end = max(start, frame_at_time(m_stop_time.load(AK::memory_order_acquire)));
+    return { start, end };
+}
+
+// Computes sin(2πx) for x in [-0.25, 0.25] with a Taylor polynomial. Its error is below 2e-6 in that range.
+static f32x4 sin_two_pi_quarter_range(f32x4 x)
+{
+    auto angle = x * static_cast<float>(2 * AK::Pi<double>);
+    auto angle_squared = angle * angle;
+    auto result = angle_squared * (1.0f / 362880.0f) - 1.0f / 5040.0f;
+    result = angle_squared * result + 1.0f / 120.0f;
+    result = angle_squared * result - 1.0f / 6.0f;
+    result = angle_squared * result + 1.0f;
+    return angle * result;
+}
+
+static f32x4 absolute_value(f32x4 value)
+{
+    return value < 0.0f ? -value : value;
+}
+
+// https://webaudio.github.io/web-audio-api/#OscillatorNode
+void OscillatorRenderNode::process(RenderContext const& context, AudioBus const&, AudioBus& output)
+{
+    auto samples = output.channel(0);
+    auto [start, end] = playing_frames(context);
+    if (start == end) {
+        samples.fill(0);
+        return;
+    }
+
+    auto frequencies = m_frequency->compute_values(context);
+    auto detunes = m_detune->compute_values(context);
+
+    // computedOscFrequency(t) = frequency(t) * pow(2, detune(t) / 1200)
+    auto nyquist_frequency = context.sample_rate / 2;
+    auto phase_increment_at = [&](size_t index) {
+        auto frequency = frequencies[frequencies.size() == 1 ? 0 : index];
+        auto detune = detunes[detunes.size() == 1 ? 0 : index];
+        auto computed_frequency = frequency * AK::exp2(detune / 1200.0f);
+        return clamp(computed_frequency, -nyquist_frequency, nyquist_frequency) / context.sample_rate;
+    };
+
+    // Accumulating the phase is inherently serial, but it is cheap compared to computing the waveform from it, which is
+    // done four frames at a time below.
+    auto constant_phase_increment = frequencies.size() == 1 && detunes.size() == 1 ? phase_increment_at(0) : 0.0f;
+    for (size_t i = start; i < end; ++i) {
+        m_phases[i] = static_cast<float>(m_phase);
+        m_phase += constant_phase_increment != 0 ? constant_phase_increment : phase_increment_at(i);
+        m_phase -= AK::floor(m_phase);
+    }
+
+    auto type = m_type.load(AK::memory_order_relaxed);
+    for (size_t i = 0; i < render_quantum_size; i += 4) {
+        auto phase = load_unaligned<f32x4>(&m_phases[i]);
+
+        // Map the phase from [0, 1) to [-0.5, 0.5), and fold it into [0, 0.25], with its sign put back afterwards. This
+        // covers a quarter of a period, which is all that is needed for the sine and triangle waveforms.
+        auto signed_phase = phase >= 0.5f ? phase - 1.0f : phase;
+        auto folded_phase = 0.25f - absolute_value(absolute_value(signed_phase) - 0.25f);
+        auto sign = signed_phase < 0.0f ? f32x4 { -1, -1, -1, -1 } : f32x4 { 1, 1, 1, 1 };
+
+        f32x4 waveform;
+        switch (type) {
+        case Bindings::OscillatorType::Square:
+            waveform = phase < 0.5f ? f32x4 { 1, 1, 1, 1 } : f32x4 { -1, -1, -1, -1 };
+            break;
+        case Bindings::OscillatorType::Sawtooth:
+            waveform = signed_phase * 2.0f;
+            break;
+        case Bindings::OscillatorType::Triangle:
+            waveform = sign * folded_phase * 4.0f;
+            break;
+        case Bindings::OscillatorType::Sine:
+        // FIXME: Render the PeriodicWave of custom oscillators.
+        case Bindings::OscillatorType::Custom:
+            waveform = sign * sin_two_pi_quarter_range(folded_phase);
+            break;
+        }
+        store_unaligned(&samples[i], waveform);
+    }
+
+    // FIXME: The waveforms should be band-limited to avoid aliasing.
+    samples.trim(start).fill(0);
+    samples.slice(end).fill(0);
+}
+
+// https://webaudio.github.io/web-audio-api/#filters-characteristics
+void BiquadFilterRenderNode::process(RenderContext const& context, AudioBus const& input, AudioBus& output)
+{
+    // FIXME: The coefficients are only computed once per render quantum, as if all of the parameters were k-rate.
+    auto frequency = m_frequency->compute_values(context)[0];
+    auto detune = m_detune->compute_values(context)[0];
+    auto q = m_q->compute_values(context)[0];
+    auto gain = m_gain->compute_values(context)[0];
+
+    // The computed frequency is kept slightly within (0, nyquist) so that none of the coefficients become degenerate.
+    auto computed_frequency = static_cast<double>(frequency) * AK::exp2(static_cast<double>(detune) / 1200.0);
+    auto nyquist_frequency = static_cast<double>(context.sample_rate) / 2;
+    computed_frequency = clamp(computed_frequency, 1e-6 * nyquist_frequency, (1 - 1e-6) * nyquist_frequency);
+
+    auto A = AK::pow(10.0, static_cast<double>(gain) / 40);
+    auto omega = 2 * AK::Pi<double> * computed_frequency / context.sample_rate;
+    auto cos_omega = AK::cos(omega);
+    auto sin_omega = AK::sin(omega);
+    auto alpha_q = sin_omega / (2 * max(static_cast<double>(q), 1e-4));
+    auto alpha_q_db = sin_omega / (2 * AK::pow(10.0, static_cast<double>(q) / 20));
+    // The shelf slope S is always 1, which simplifies (A + 1/A) * (1/S - 1) + 2 to 2.
+    auto alpha_s = sin_omega / 2 * AK::sqrt(2.0);
+    auto two_sqrt_a_alpha = 2 * AK::sqrt(A) * alpha_s;
+
+    double b0, b1, b2, a0, a1, a2;
+    switch (m_type.load(AK::memory_order_relaxed)) {
+    case Bindings::BiquadFilterType::Lowpass:
+        b0 = (1 - cos_omega) / 2;
+        b1 = 1 - cos_omega;
+        b2 = (1 - cos_omega) / 2;
+        a0 = 1 + alpha_q_db;
+        a1 = -2 * cos_omega;
+        a2 = 1 - alpha_q_db;
+        break;
+    case Bindings::BiquadFilterType::Highpass:
+        b0 = (1 + cos_omega) / 2;
+        b1 = -(1 + cos_omega);
+        b2 = (1 + cos_omega) / 2;
+        a0 = 1 + alpha_q_db;
+        a1 = -2 * cos_omega;
+        a2 = 1 - alpha_q_db;
+        break;
+    case Bindings::BiquadFilterType::Bandpass:
+        b0 = alpha_q;
+        b1 = 0;
+        b2 = -alpha_q;
+        a0 = 1 + alpha_q;
+        a1 = -2 * cos_omega;
+        a2 = 1 - alpha_q;
+        break;
+    case Bindings::BiquadFilterType::Notch:
+        b0 = 1;
+        b1 = -2 * cos_omega;
+        b2 = 1;
+        a0 = 1 + alpha_q;
+        a1 = -2 * cos_omega;
+        a2 = 1 - alpha_q;
+        break;
+    case Bindings::BiquadFilterType::Allpass:
+        b0 = 1 - alpha_q;
+        b1 = -2 * cos_omega;
+        b2 = 1 + alpha_q;
+        a0 = 1 + alpha_q;
+        a1 = -2 * cos_omega;
+        a2 = 1 - alpha_q;
+        break;
+    case Bindings::BiquadFilterType::Peaking:
+        b0 = 1 + alpha_q * A;
+        b1 = -2 * cos_omega;
+        b2 = 1 - alpha_q * A;
+        a0 = 1 + alpha_q / A;
+        a1 = -2 * cos_omega;
+        a2 = 1 - alpha_q / A;
+        break;
+    case Bindings::BiquadFilterType::Lowshelf:
+        b0 = A * ((A + 1) - (A - 1) * cos_omega + two_sqrt_a_alpha);
+        b1 = 2 * A * ((A - 1) - (A + 1) * cos_omega);
+        b2 = A * ((A + 1) - (A - 1) * cos_omega - two_sqrt_a_alpha);
+        a0 = (A + 1) + (A - 1) * cos_omega + two_sqrt_a_alpha;
+        a1 = -2 * ((A - 1) + (A + 1) * cos_omega);
+        a2 = (A + 1) + (A - 1) * cos_omega - two_sqrt_a_alpha;
+        break;
+    case Bindings::BiquadFilterType::Highshelf:
+        b0 = A * ((A + 1) + (A - 1) * cos_omega + two_sqrt_a_alpha);
+        b1 = -2 * A * ((A - 1) + (A + 1) * cos_omega);
+        b2 = A * ((A + 1) + (A - 1) * cos_omega - two_sqrt_a_alpha);
+        a0 = (A + 1) - (A - 1) * cos_omega + two_sqrt_a_alpha;
+        a1 = 2 * ((A - 1) - (A + 1) * cos_omega);
+        a2 = (A + 1) - (A - 1) * cos_omega - two_sqrt_a_alpha;
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+    auto normalized_b0 = static_cast<float>(b0 / a0);
+    auto normalized_b1 = static_cast<float>(b1 / a0);
+    auto normalized_b2 = static_cast<float>(b2 / a0);
+    auto normalized_a1 = static_cast<float>(a1 / a0);
+    auto normalized_a2 = static_cast<float>(a2 / a0);
+
+    // Each output sample depends on the previous ones, so the filter runs one sample at a time.
+    for (size_t channel = 0; channel < output.channel_count(); ++channel) {
+        auto input_samples = input.channel(channel);
+        auto output_samples = output.channel(channel);
+        auto& state1 = m_state[channel][0];
+        auto& state2 = m_state[channel][1];
+
+        for (size_t i = 0; i < render_quantum_size; ++i) {
+            auto x = input_samples[i];
+            auto y = normalized_b0 * x + state1;
+            state1 = normalized_b1 * x - normalized_a1 * y + state2;
+            state2 = normalized_b2 * x - normalized_a2 * y;
+            output_samples[i] = y;
+        }
+    }
+}
+
+ErrorOr<NonnullOwnPtr<RenderGraph>> RenderGraph::create(AudioNode& destination)
+{
+    // Order the nodes that the destination depends on so that each one comes after all of its inputs. A connection that
+    // would close a cycle is left out, which mutes it.
+    // FIXME: Cycles that contain a DelayNode are allowed, and should be rendered with the delay breaking the cycle.
+    Vector<AudioNode*> nodes;
+    HashMap<AudioNode*, size_t> node_indices;
+    HashTable<AudioNode*> visiting;
+
+    auto visit = [&](auto& self, AudioNode& node) -> ErrorOr<void> {
+        if (node_indices.contains(&node) || visiting.contains(&node))
+            return {};
+
+        TRY(visiting.try_set(&node));
+        for (auto const& connection : node.input_connections())
+            TRY(self(self, *connection.destination_node));
+        visiting.remove(&node);
+
+        TRY(node_indices.try_set(&node, nodes.size()));
+        TRY(nodes.try_append(&node));
+        return {};
+    };
+    TRY(visit(visit, destination));
+
+    Vector<Entry> entries;
+    TRY(entries.try_ensure_capacity(nodes.size()));
+
+    for (size_t index = 0; index < nodes.size(); ++index) {
+        auto& node = *nodes[index];
+
+        // FIXME: Connect the other inputs and outputs of nodes that have more than one.
+        Vector<size_t> inputs;
+        size_t input_channel_count = 0;
+        for (auto const& connection : node.input_connections()) {
+            if (connection.input != 0 || connection.output != 0)
+                continue;
+            auto input_index = node_indices.get(connection.destination_node.ptr());
+            if (!input_index.has_value() || input_index.value() >= index)
+                continue;
+            TRY(inputs.try_append(input_index.value()));
+            input_channel_count = max(input_channel_count, entries[input_index.value()].output.channel_count());
+        }
+
+        // https://webaudio.github.io/web-audio-api/#channel-up-mixing-and-down-mixing
+        // An input with no connections has a single silent channel.
+        if (input_channel_count == 0)
+            input_channel_count = 1;
+
+        switch (node.channel_count_mode()) {
+        case Bindings::ChannelCountMode::Max:
+            break;
+        case Bindings::ChannelCountMode::ClampedMax:
+            input_channel_count = min<size_t>(input_channel_count, node.channel_count());
+            break;
+        case Bindings::ChannelCountMode::Explicit:
+            input_channel_count = node.channel_count();
+            break;
+        }
+        input_channel_count = min(input_channel_count, max_render_channel_count);
+
+        auto render_node = node.render_node();
+        auto output_channel_count = render_node->output_channel_count(input_channel_count);
+
+        entries.unchecked_append({
+            .node = move(render_node),
+            .inputs = move(inputs),
+            .channel_interpretation = node.channel_interpretation(),
+            .input = TRY(AudioBus::create(input_channel_count)),
+            .output = TRY(AudioBus::create(output_channel_count)),
+        });
+    }
+
+    // Group the nodes other than the destination into partitions, by joining each node with the nodes it takes input from.
+    auto destination_index = entries.size() - 1;
+    Vector<size_t> roots;
+    TRY(roots.try_ensure_capacity(destination_index));
+    for (size_t index = 0; index < destination_index; ++index)
+        roots.unchecked_append(index);
+
+    auto find_root = [&](size_t index) {
+        while (roots[index] != index)
+            index = roots[index] = roots[roots[index]];
+        return index;
+    };
+    for (size_t index = 0; index < destination_index; ++index) {
+        for (auto input_index : entries[index].inputs)
+            roots[find_root(input_index)] = find_root(index);
+    }
+
+    // The entries of each partition stay in the order of the graph, so each node still comes after all of its inputs.
+    Vector<Partition> partitions;
+    Vector<Optional<size_t>> partition_indices;
+    TRY(partition_indices.try_resize(destination_index));
+    for (size_t index = 0; index < destination_index; ++index) {
+        auto& partition_index = partition_indices[find_root(index)];
+        if (!partition_index.has_value()) {
+            partition_index = partitions.size();
+            TRY(partitions.try_append({}));
+        }
+        TRY(partitions[partition_index.value()].entries.try_append(index));
+    }
+    for (auto input_index : entries[destination_index].inputs)
+        TRY(partitions[partition_indices[find_root(input_index)].value()].destination_inputs.try_append(input_index));
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) RenderGraph(move(entries), move(partitions)));
+}
+
+void RenderGraph::render(RenderContext const& context)
+{
+    auto& destination = m_entries.last();
+
+    destination.input.zero();
+    for (auto const& partition : m_partitions)
+        render_partition(context, partition, destination.input);
+
+    destination.node->process(context, destination.input, destination.output);
+}
+
+void RenderGraph::render_partition(RenderContext const& context, Partition const& partition, AudioBus& destination_input)
+{
+    for (auto index : partition.entries) {
+        auto& entry = m_entries[index];
+
+        entry.input.zero();
+        for (auto input_index : entry.inputs)
+            entry.input.sum_from(m_entries[input_index].output, entry.channel_interpretation);
+
+        entry.node->process(context, entry.input, entry.output);
+    }
+
+    for (auto index : partition.destination_inputs)
+        destination_input.sum_from(m_entries[index].output, m_entries.last().channel_interpretation);
+}
+
+ErrorOr<Vector<FixedArray<float>>> RenderGraph::render_offline(float sample_rate, size_t length)
+{
+    // Each partition renders a whole block of quanta before the partitions are mixed together at the destination, so that
+    // the threads rendering them only have to synchronize once per block instead of once per quantum.
+    static constexpr size_t quanta_per_block = 64;
+
+    auto& destination = m_entries.last();
+
+    Vector<FixedArray<float>> channels;
+    TRY(channels.try_ensure_capacity(destination.output.channel_count()));
+    for (size_t channel = 0; channel < destination.output.channel_count(); ++channel)
+        channels.unchecked_append(TRY(FixedArray<float>::create(length)));
+
+    // The contribution of each partition to the input of the destination, for each quantum of a block.
+    Vector<Vector<AudioBus>> partition_outputs;
+    TRY(partition_outputs.try_ensure_capacity(quanta_per_block));
+    for (size_t quantum = 0; quantum < quanta_per_block; ++quantum) {
+        Vector<AudioBus> buses;
+        TRY(buses.try_ensure_capacity(m_partitions.size()));
+        for (size_t partition = 0; partition < m_partitions.size(); ++partition)
+            buses.unchecked_append(TRY(AudioBus::create(destination.input.channel_count())));
+        partition_outputs.unchecked_append(move(buses));
+    }
+
+    auto quantum_count = ceil_div(length, render_quantum_size);
+    for (size_t block_start = 0; block_start < quantum_count; block_start += quanta_per_block) {
+        auto block_size = min(quanta_per_block, quantum_count - block_start);
+        auto context_for_quantum = [&](size_t quantum) {
+            return RenderContext {
+                .frame = static_cast<u64>(block_start + quantum) * render_quantum_size,
+                .sample_rate = sample_rate,
+            };
+        };
+
+        Threading::parallel_for(0, m_partitions.size(), 1, [&](size_t partition_begin, size_t partition_end) {
+            for (auto partition = partition_begin; partition < partition_end; ++partition) {
+                for (size_t quantum = 0; quantum < block_size; ++quantum) {
+                    auto& output = partition_outputs[quantum][partition];
+                    output.zero();
+                    render_partition(context_for_quantum(quantum), m_partitions[partition], output);
+                }
+            }
+        });
+
+        for (size_t quantum = 0; quantum < block_size; ++quantum) {
+            auto context = context_for_quantum(quantum);
+
+            // The partitions have already been mixed to the channel count of the destination's input.
+            destination.input.zero();
+            for (auto const& output : partition_outputs[quantum])
+                destination.input.sum_from(output, Bindings::ChannelInterpretation::Discrete);
+            destination.node->process(context, destination.input, destination.output);
+
+            auto frame = (block_start + quantum) * render_quantum_size;
+            auto frame_count = min(render_quantum_size, length - frame);
+            for (size_t channel = 0; channel < channels.size(); ++channel)
+                destination.output.channel(channel).trim(frame_count).copy_to(channels[channel].span().slice(frame, frame_count));
+        }
+    }
+
+    return channels;
+}
+
+}
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/FixedArray.h>
+#include <AK/Math.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefPtr.h>
+#include <AK/Vector.h>
+#include <LibWeb/Bindings/AudioNodePrototype.h>
+#include <LibWeb/Bindings/BiquadFilterNodePrototype.h>
+#include <LibWeb/Bindings/OscillatorNodePrototype.h>
+#include <LibWeb/Forward.h>
+
+// Everything in this file is used to render an audio graph on the audio thread. The AudioNodes and AudioParams of the
+// control thread each own an object in here, and share it with the audio thread. Values that the control thread may
+// change while rendering are atomics, everything else is only touched by the audio thread once the object has been
+// handed to it.
+
+namespace Web::WebAudio {
+
+// https://webaudio.github.io/web-audio-api/#render-quantum
+static constexpr size_t render_quantum_size = 128;
+
+// https://webaudio.github.io/web-audio-api/#dom-baseaudiocontext-createbuffer-numberofchannels
+static constexpr size_t max_render_channel_count = 32;
+
+using RenderQuantum = Array<float, render_quantum_size>;
+
+struct RenderContext {
+    u64 frame { 0 };
+    float sample_rate { 0 };
+
+    double time() const { return static_cast<double>(frame) / sample_rate; }
+    double time_of_frame(size_t index) const { return static_cast<double>(frame + index) / sample_rate; }
+};
+
+// The channels of one input or output of a node for a single render quantum.
+class AudioBus {
+public:
+    static ErrorOr<AudioBus> create(size_t channel_count);
+
+    size_t channel_count() const { return m_channel_count; }
+
+    Span<float> channel(size_t index) { return m_samples.span().slice(index * render_quantum_size, render_quantum_size); }
+    ReadonlySpan<float> channel(size_t index) const { return m_samples.span().slice(index * render_quantum_size, render_quantum_size); }
+
+    void zero();
+
+    // https://webaudio.github.io/web-audio-api/#channel-up-mixing-and-down-mixing
+    void sum_from(AudioBus const&, Bindings::ChannelInterpretation);
+
+private:
+    size_t m_channel_count { 0 };
+    FixedArray<float> m_samples;
+};
+
+// The audio thread's side of an AudioParam.
+class RenderParam final : public AtomicRefCounted<RenderParam> {
+public:
+    static NonnullRefPtr<RenderParam> create(float default_value, float min_value, float max_value, Bindings::AutomationRate);
+
+    // These are called on the control thread, and never block. The automation functions return false if the event could
+    // not be queued because the audio thread has fallen too far behind, or isn't rendering.
+    void set_value(float);
+    bool set_value_at_time(float value, double time);
+    bool linear_ramp_to_value_at_time(float value, double time);
+    bool exponential_ramp_to_value_at_time(float value, double time);
+    bool cancel_scheduled_values(double time);
+    void set_automation_rate(Bindings::AutomationRate rate) { m_automation_rate.store(rate, AK::memory_order_relaxed); }
+
+    // Computes the values of the parameter for the current render quantum, and returns them. If the value doesn't change
+    // over the quantum, only the first value is written and the returned span contains only that value.
+    ReadonlySpan<float> compute_values(RenderContext const&);
+
+private:
+    enum class EventType : u8 {
+        SetValue,
+        LinearRamp,
+        ExponentialRamp,
+        Cancel,
+    };
+
+    struct Event {
+        EventType type { EventType::SetValue };
+        float value { 0 };
+        double time { 0 };
+    };
+
+    RenderParam(float default_value, float min_value, float max_value, Bindings::AutomationRate);
+
+    bool enqueue(Event);
+    void dequeue_events(RenderContext const&);
+    void insert_event(Event);
+    float value_at_time(double time, size_t& event_index) const;
+    bool is_constant_between(double start_time, double end_time) const;
+
+    float m_min_value { 0 };
+    float m_max_value { 0 };
+    Atomic<Bindings::AutomationRate> m_automation_rate;
+
+    // A single-producer single-consumer queue of events from the control thread.
+    static constexpr size_t event_queue_size = 128;
+    Array<Event, event_queue_size> m_event_queue;
+    Atomic<size_t> m_event_queue_head { 0 };
+    Atomic<size_t> m_event_queue_tail { 0 };
+
+    // Values set through the value attribute replace each other, so only the last one is kept instead of being queued.
+    Atomic<float> m_pending_value { 0 };
+    Atomic<bool> m_has_pending_value { false };
+
+    // https://webaudio.github.io/web-audio-api/#dom-audioparam-current-value-slot
+    float m_current_value { 0 };
+    // The automation events of the parameter, sorted by time. Its capacity is reserved up front so that the audio thread
+    // never allocates, events that don't fit are dropped.
+    Vector<Event> m_timeline;
+    RenderQuantum m_values;
+};
+
+class RenderNode : public AtomicRefCounted<RenderNode> {
+public:
+    virtual ~RenderNode() = default;
+
+    // Returns the number of channels the node outputs, given the number of channels of its input after mixing.
+    virtual size_t output_channel_count(size_t input_channel_count) const { return input_channel_count; }
+
+    virtual void process(RenderContext const&, AudioBus const& input, AudioBus& output) = 0;
+};
+
+// Outputs its input unchanged, for nodes that have no processing of their own yet.
+class PassThroughRenderNode final : public RenderNode {
+public:
+    virtual void process(RenderContext const&, AudioBus const& input, AudioBus& output) override;
+};
+
+// https://webaudio.github.io/web-audio-api/#GainNode
+class GainRenderNode final : public RenderNode {
+public:
+    explicit GainRenderNode(NonnullRefPtr<RenderParam> gain)
+        : m_gain(move(gain))
+    {
+    }
+
+    virtual void process(RenderContext const&, AudioBus const& input, AudioBus& output) override;
+
+private:
+    NonnullRefPtr<RenderParam> m_gain;
+};
+
+// https://webaudio.github.io/web-audio-api/#AudioScheduledSourceNode
+class ScheduledSourceRenderNode : public RenderNode {
+public:
+    void start(double when) { m_start_time.store(when, AK::memory_order_release); }
+    void stop(double when) { m_stop_time.store(when, AK::memory_order_release); }
+
+    virtual size_t output_channel_count(size_t) const override { return 1; }
+
+protected:
+    // Returns the range of frames of the current render quantum during which the source is playing.
+    struct PlayingFrames {
+        size_t start { 0 };
+        size_t end { 0 };
+    };
+    PlayingFrames playing_frames(RenderContext const&) const;
+
+private:
+    Atomic<double> m_start_time { AK::Infinity<double> };
+    Atomic<double> m_stop_time { AK::Infinity<double> };
+};
+
+// https://webaudio.github.io/web-audio-api/#OscillatorNode
+class OscillatorRenderNode final : public ScheduledSourceRenderNode {
+public:
+    OscillatorRenderNode(Bindings::OscillatorType type, NonnullRefPtr<RenderParam> frequency, NonnullRefPtr<RenderParam> detune)
+        : m_type(type)
+        , m_frequency(move(frequency))
+        , m_detune(move(detune))
+    {
+    }
+
+    void set_type(Bindings::OscillatorType type) { m_type.store(type, AK::memory_order_relaxed); }
+
+    virtual void process(RenderContext const&, AudioBus const& input, AudioBus& output) override;
+
+private:
+    Atomic<Bindings::OscillatorType> m_type;
+    NonnullRefPtr<RenderParam> m_frequency;
+    NonnullRefPtr<RenderParam> m_detune;
+
+    // The phase of the oscillator, in periods.
+    double m_phase { 0 };
+    RenderQuantum m_phases;
+};
+
+// https://webaudio.github.io/web-audio-api/#BiquadFilterNode
+class BiquadFilterRenderNode final : public RenderNode {
+public:
+    BiquadFilterRenderNode(Bindings::BiquadFilterType type, NonnullRefPtr<RenderParam> frequency, NonnullRefPtr<RenderParam> detune, NonnullRefPtr<RenderParam> q, NonnullRefPtr<RenderParam> gain)
+        : m_type(type)
+        , m_frequency(move(frequency))
+        , m_detune(move(detune))
+        , m_q(move(q))
+        , m_gain(move(gain))
+    {
+    }
+
+    void set_type(Bindings::BiquadFilterType type) { m_type.store(type, AK::memory_order_relaxed); }
+
+    virtual void process(RenderContext const&, AudioBus const& input, AudioBus& output) override;
+
+private:
+    Atomic<Bindings::BiquadFilterType> m_type;
+    NonnullRefPtr<RenderParam> m_frequency;
+    NonnullRefPtr<RenderParam> m_detune;
+    NonnullRefPtr<RenderParam> m_q;
+    NonnullRefPtr<RenderParam> m_gain;
+
+    // The state of the transposed direct form II filter of each channel.
+    Array<Array<float, 2>, max_render_channel_count> m_state {};
+};
+
+// A snapshot of the nodes that contribute to the output of an AudioContext, in the order they need to be processed in.
+// It is built on the control thread whenever the graph changes, and then handed to the audio thread.
+class RenderGraph {
+public:
+    static ErrorOr<NonnullOwnPtr<RenderGraph>> create(AudioNode& destination);
+
+    void render(RenderContext const&);
+
+    // Renders the first length frames of the destination's output as fast as possible, for an OfflineAudioContext, and
+    // returns one buffer of samples for each of its channels. Parts of the graph that only meet at the destination are
+    // rendered in parallel.
+    ErrorOr<Vector<FixedArray<float>>> render_offline(float sample_rate, size_t length);
+
+    // The output of the destination node for the last rendered quantum.
+    AudioBus const& output() const { return m_entries.last().output; }
+
+    // Used by the AudioRenderer to hand graphs that it no longer renders back to the control thread.
+    RenderGraph* next_retired_graph { nullptr };
+
+private:
+    struct Entry {
+        NonnullRefPtr<RenderNode> node;
+        Vector<size_t> inputs;
+        Bindings::ChannelInterpretation channel_interpretation;
+        AudioBus input;
+        AudioBus output;
+    };
+
+    // A set of nodes that doesn't share any node with the rest of the graph, other than the destination. Partitions can be
+    // rendered independently of each other, and their outputs are only summed up at the input of the destination.
+    struct Partition {
+        Vector<size_t> entries;
+        Vector<size_t> destination_inputs;
+    };
+
+    RenderGraph(Vector<Entry> entries, Vector<Partition> partitions)
+        : m_entries(move(entries))
+        , m_partitions(move(partitions))
+    {
+    }
+
+    void render_partition(RenderContext const&, Partition const&, AudioBus& destination_input);
+
+    // The destination is always the last entry.
+    Vector<Entry> m_entries;
+    Vector<Partition> m_partitions;
+};
+
+}
@@ -4,7 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Base64.h>
+#include <LibGC/Root.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/ImageFormats/PNGWriter.h>
+#include <LibThreading/BackgroundAction.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/ElementFactory.h>
 #include <LibWeb/HTML/BrowsingContext.h>
@@ -72,27 +76,44 @@ ErrorOr<GC::Ref<HTML::HTMLCanvasElement>, WebDriver::Error> draw_bounding_box_fr
 }
 
 // https://w3c.github.io/webdriver/#dfn-encoding-a-canvas-as-base64
-Response encode_canvas_element(HTML::HTMLCanvasElement& canvas)
+void encode_canvas_element(HTML::HTMLCanvasElement& canvas, GC::Ref<GC::Function<void(Response)>> on_complete)
 {
     // FIXME: 1. If the canvas element’s bitmap’s origin-clean flag is set to false, return error with error code unable to capture screen.
 
     // 2. If the canvas element’s bitmap has no pixels (i.e. either its horizontal dimension or vertical dimension is zero) then return error with error code unable to capture screen.
-    if (canvas.surface()->size().is_empty())
-        return Error::from_code(ErrorCode::UnableToCaptureScreen, "Captured screenshot is empty"sv);
-
-    // 3. Let file be a serialization of the canvas element’s bitmap as a file, using "image/png" as an argument.
-    // 4. Let data url be a data: URL representing file. [RFC2397]
-    auto data_url = canvas.to_data_url("image/png"sv, JS::js_undefined());
-
-    // 5. Let index be the index of "," in data url.
-    auto index = data_url.find_byte_offset(',');
-    VERIFY(index.has_value());
-
-    // 6. Let encoded string be a substring of data url using (index + 1) as the start argument.
-    auto encoded_string = MUST(data_url.substring_from_byte_offset(*index + 1));
-
-    // 7. Return success with data encoded string.
-    return JsonValue { move(encoded_string) };
+    if (canvas.surface()->size().is_empty()) {
+        on_complete->function()(Error::from_code(ErrorCode::UnableToCaptureScreen, "Captured screenshot is empty"sv));
+        return;
+    }
+
+    auto bitmap = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, canvas.surface()->size());
+    if (bitmap.is_error()) {
+        on_complete->function()(Error::from_code(ErrorCode::UnableToCaptureScreen, "Failed to allocate screenshot bitmap"sv));
+        return;
+    }
+    canvas.surface()->read_into_bitmap(*bitmap.value());
+
+    // NOTE: Screenshots are only decoded once by the WebDriver client, so we encode them with the fastest compression,
+    //       and off the main thread.
+    (void)Threading::BackgroundAction<String>::construct(
+        [bitmap = bitmap.release_value()](auto&) -> ErrorOr<String> {
+            // 3. Let file be a serialization of the canvas element’s bitmap as a file, using "image/png" as an argument.
+            auto file = TRY(Gfx::PNGWriter::encode(*bitmap, { .compression_level = Compress::GenericZlibCompressionLevel::Fastest }));
+
+            // 4. Let data url be a data: URL representing file. [RFC2397]
+            // 5. Let index be the index of "," in data url.
+            // 6. Let encoded string be a substring of data url using (index + 1) as the start argument.
+            // NOTE: That substring is the Base64 encoding of file, so we don't need to create the data URL.
+            return encode_base64(file);
+        },
+        [on_complete = GC::make_root(on_complete)](String encoded_string) -> ErrorOr<void> {
+            // 7. Return success with data encoded string.
+            on_complete->function()(JsonValue { move(encoded_string) });
+            return {};
+        },
+        [on_complete = GC::make_root(on_complete)](AK::Error error) {
+            on_complete->function()(Error::from_code(ErrorCode::UnableToCaptureScreen, MUST(String::formatted("Failed to encode screenshot: {}", error))));
+        });
 }
 
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <LibGC/Function.h>
 #include <LibGC/Ptr.h>
 #include <LibGfx/Rect.h>
 #include <LibWeb/Export.h>
@@ -15,6 +16,6 @@
 namespace Web::WebDriver {
 
 WEB_API ErrorOr<GC::Ref<HTML::HTMLCanvasElement>, WebDriver::Error> draw_bounding_box_from_the_framebuffer(HTML::BrowsingContext&, DOM::Element&, Gfx::IntRect);
-WEB_API Response encode_canvas_element(HTML::HTMLCanvasElement&);
+WEB_API void encode_canvas_element(HTML::HTMLCanvasElement&, GC::Ref<GC::Function<void(Response)>> on_complete);
 
 }
@@ -1996,6 +1996,9 @@ void WebGL2RenderingContextImpl::detach_shader(GC::Root<WebGLProgram> program, G
 
 void WebGL2RenderingContextImpl::disable(WebIDL::UnsignedLong cap)
 {
+    if (!update_shadowed_capability_state(cap, false))
+        return;
+
     m_context->make_current();
     glDisable(cap);
 }
@@ -2025,6 +2028,9 @@ void WebGL2RenderingContextImpl::draw_elements(WebIDL::UnsignedLong mode, WebIDL
 
 void WebGL2RenderingContextImpl::enable(WebIDL::UnsignedLong cap)
 {
+    if (!update_shadowed_capability_state(cap, true))
+        return;
+
     m_context->make_current();
     glEnable(cap);
 }
@@ -2244,11 +2250,8 @@ JS::Value WebGL2RenderingContextImpl::get_parameter(WebIDL::UnsignedLong pname)
             return JS::js_null();
         return JS::Value(m_array_buffer_binding);
     }
-    case GL_BLEND: {
-        GLboolean result { GL_FALSE };
-        glGetBooleanvRobustANGLE(GL_BLEND, 1, nullptr, &result);
-        return JS::Value(result == GL_TRUE);
-    }
+    case GL_BLEND:
+        return JS::Value(shadowed_capability_state(GL_BLEND).value());
     case GL_BLEND_COLOR: {
         Array<GLfloat, 4> result;
         result.fill(0);
@@ -2302,11 +2305,8 @@ JS::Value WebGL2RenderingContextImpl::get_parameter(WebIDL::UnsignedLong pname)
         auto array_buffer = JS::ArrayBuffer::create(m_realm, move(byte_buffer));
         return JS::Float32Array::create(m_realm, 4, array_buffer);
     }
-    case GL_CULL_FACE: {
-        GLboolean result { GL_FALSE };
-        glGetBooleanvRobustANGLE(GL_CULL_FACE, 1, nullptr, &result);
-        return JS::Value(result == GL_TRUE);
-    }
+    case GL_CULL_FACE:
+        return JS::Value(shadowed_capability_state(GL_CULL_FACE).value());
     case GL_CULL_FACE_MODE: {
         GLint result { 0 };
         glGetIntegervRobustANGLE(GL_CULL_FACE_MODE, 1, nullptr, &result);
@@ -2341,21 +2341,15 @@ JS::Value WebGL2RenderingContextImpl::get_parameter(WebIDL::UnsignedLong pname)
         auto array_buffer = JS::ArrayBuffer::create(m_realm, move(byte_buffer));
         return JS::Float32Array::create(m_realm, 2, array_buffer);
     }
-    case GL_DEPTH_TEST: {
-        GLboolean result { GL_FALSE };
-        glGetBooleanvRobustANGLE(GL_DEPTH_TEST, 1, nullptr, &result);
-        return JS::Value(result == GL_TRUE);
-    }
+    case GL_DEPTH_TEST:
+        return JS::Value(shadowed_capability_state(GL_DEPTH_TEST).value());
     case GL_DEPTH_WRITEMASK: {
         GLboolean result { GL_FALSE };
         glGetBooleanvRobustANGLE(GL_DEPTH_WRITEMASK, 1, nullptr, &result);
         return JS::Value(result == GL_TRUE);
     }
-    case GL_DITHER: {
-        GLboolean result { GL_FALSE };
-        glGetBooleanvRobustANGLE(GL_DITHER, 1, nullptr, &result);
-        return JS::Value(result == GL_TRUE);
-    }
+    case GL_DITHER:
+        return JS::Value(shadowed_capability_state(GL_DITHER).value());
     case GL_ELEMENT_ARRAY_BUFFER_BINDING: {
         if (!m_element_array_buffer_binding)
             return JS::js_null();
@@ -2465,11 +2459,8 @@ JS::Value WebGL2RenderingContextImpl::get_parameter(WebIDL::UnsignedLong pname)
         glGetFloatvRobustANGLE(GL_POLYGON_OFFSET_FACTOR, 1, nullptr, &result);
         return JS::Value(result);
     }
-    case GL_POLYGON_OFFSET_FILL: {
-        GLboolean result { GL_FALSE };
-        glGetBooleanvRobustANGLE(GL_POLYGON_OFFSET_FILL, 1, nullptr, &result);
-        return JS::Value(result == GL_TRUE);
-    }
+    case GL_POLYGON_OFFSET_FILL:
+        return JS::Value(shadowed_capability_state(GL_POLYGON_OFFSET_FILL).value());
     case GL_POLYGON_OFFSET_UNITS: {
         GLfloat result { 0.0f };
         glGetFloatvRobustANGLE(GL_POLYGON_OFFSET_UNITS, 1, nullptr, &result);
@@ -2489,21 +2480,15 @@ JS::Value WebGL2RenderingContextImpl::get_parameter(WebIDL::UnsignedLong pname)
         auto result = reinterpret_cast<char const*>(glGetString(GL_RENDERER));
         return JS::PrimitiveString::create(m_realm->vm(), ByteString { result });
     }
-    case GL_SAMPLE_ALPHA_TO_COVERAGE: {
-        GLboolean result { GL_FALSE };
-        glGetBooleanvRobustANGLE(GL_SAMPLE_ALPHA_TO_COVERAGE, 1, nullptr, &result);
-        return JS::Value(result == GL_TRUE);
-    }
+    case GL_SAMPLE_ALPHA_TO_COVERAGE:
+        return JS::Value(shadowed_capability_state(GL_SAMPLE_ALPHA_TO_COVERAGE).value());
     case GL_SAMPLE_BUFFERS: {
         GLint result { 0 };
         glGetIntegervRobustANGLE(GL_SAMPLE_BUFFERS, 1, nullptr, &result);
         return JS::Value(result);
     }
-    case GL_SAMPLE_COVERAGE: {
-        GLboolean result { GL_FALSE };
-        glGetBooleanvRobustANGLE(GL_SAMPLE_COVERAGE, 1, nullptr, &result);
-        return JS::Value(result == GL_TRUE);
-    }
+    case GL_SAMPLE_COVERAGE:
+        return JS::Value(shadowed_capability_state(GL_SAMPLE_COVERAGE).value());
     case GL_SAMPLE_COVERAGE_INVERT: {
         GLboolean result { GL_FALSE };
         glGetBooleanvRobustANGLE(GL_SAMPLE_COVERAGE_INVERT, 1, nullptr, &result);
@@ -2528,11 +2513,8 @@ JS::Value WebGL2RenderingContextImpl::get_parameter(WebIDL::UnsignedLong pname)
         auto array_buffer = JS::ArrayBuffer::create(m_realm, move(byte_buffer));
         return JS::Int32Array::create(m_realm, 4, array_buffer);
     }
-    case GL_SCISSOR_TEST: {
-        GLboolean result { GL_FALSE };
-        glGetBooleanvRobustANGLE(GL_SCISSOR_TEST, 1, nullptr, &result);
-        return JS::Value(result == GL_TRUE);
-    }
+    case GL_SCISSOR_TEST:
+        return JS::Value(shadowed_capability_state(GL_SCISSOR_TEST).value());
     case GL_SHADING_LANGUAGE_VERSION: {
         auto result = reinterpret_cast<char const*>(glGetString(GL_SHADING_LANGUAGE_VERSION));
         return JS::PrimitiveString::create(m_realm->vm(), ByteString { result });
@@ -2607,11 +2589,8 @@ JS::Value WebGL2RenderingContextImpl::get_parameter(WebIDL::UnsignedLong pname)
         glGetIntegervRobustANGLE(GL_STENCIL_REF, 1, nullptr, &result);
         return JS::Value(result);
     }
-    case GL_STENCIL_TEST: {
-        GLboolean result { GL_FALSE };
-        glGetBooleanvRobustANGLE(GL_STENCIL_TEST, 1, nullptr, &result);
-        return JS::Value(result == GL_TRUE);
-    }
+    case GL_STENCIL_TEST:
+        return JS::Value(shadowed_capability_state(GL_STENCIL_TEST).value());
     case GL_STENCIL_VALUE_MASK: {
         GLint result { 0 };
         glGetIntegervRobustANGLE(GL_STENCIL_VALUE_MASK, 1, nullptr, &result);
@@ -3038,6 +3017,9 @@ bool WebGL2RenderingContextImpl::is_buffer(GC::Root<WebGLBuffer> buffer)
 
 bool WebGL2RenderingContextImpl::is_enabled(WebIDL::UnsignedLong cap)
 {
+    if (auto state = shadowed_capability_state(cap); state.has_value())
+        return state.value();
+
     m_context->make_current();
     return glIsEnabled(cap);
 }
@@ -135,7 +135,7 @@ Optional<WebGLRenderingContextBase::ConvertedTexture> WebGLRenderingContextBase:
             return Gfx::ImmutableBitmap::create(*source->bitmap());
         },
         [](GC::Root<HTML::HTMLVideoElement> const& source) -> RefPtr<Gfx::ImmutableBitmap> {
-            return Gfx::ImmutableBitmap::create(*source->bitmap());
+            return source->bitmap();
         },
         [](GC::Root<HTML::ImageBitmap> const& source) -> RefPtr<Gfx::ImmutableBitmap> {
             return Gfx::ImmutableBitmap::create(*source->bitmap());
@@ -192,4 +192,43 @@ Optional<WebGLRenderingContextBase::ConvertedTexture> WebGLRenderingContextBase:
     };
 }
 
+static bool is_shadowed_capability(WebIDL::UnsignedLong cap)
+{
+    switch (cap) {
+    case GL_BLEND:
+    case GL_CULL_FACE:
+    case GL_DEPTH_TEST:
+    case GL_DITHER:
+    case GL_POLYGON_OFFSET_FILL:
+    case GL_SAMPLE_ALPHA_TO_COVERAGE:
+    case GL_SAMPLE_COVERAGE:
+    case GL_SCISSOR_TEST:
+    case GL_STENCIL_TEST:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Optional<bool> WebGLRenderingContextBase::shadowed_capability_state(WebIDL::UnsignedLong cap)
+{
+    if (!is_shadowed_capability(cap))
+        return {};
+
+    return m_capability_states.ensure(cap, [&] {
+        context().make_current();
+        return glIsEnabled(cap) == GL_TRUE;
+    });
+}
+
+bool WebGLRenderingContextBase::update_shadowed_capability_state(WebIDL::UnsignedLong cap, bool enabled)
+{
+    if (!is_shadowed_capability(cap))
+        return true;
+
+    auto previous_state = m_capability_states.get(cap);
+    m_capability_states.set(cap, enabled);
+    return previous_state != enabled;
+}
+
 }
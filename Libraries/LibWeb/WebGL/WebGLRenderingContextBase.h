@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <LibJS/Runtime/DataView.h>
 #include <LibJS/Runtime/TypedArray.h>
 #include <LibWeb/Forward.h>
@@ -112,11 +113,22 @@ public:
     Optional<ConvertedTexture> read_and_pixel_convert_texture_image_source(TexImageSource const& source, WebIDL::UnsignedLong format, WebIDL::UnsignedLong type, Optional<int> destination_width = OptionalNone {}, Optional<int> destination_height = OptionalNone {});
 
 protected:
+    // The states of the capabilities that are toggled with enable() and disable() are kept on our side, so that querying
+    // them and setting them to the state they already are in doesn't need to call into the driver. Each capability's
+    // state is read from the driver the first time it is needed.
+    // Returns an empty Optional for capabilities that aren't shadowed.
+    Optional<bool> shadowed_capability_state(WebIDL::UnsignedLong cap);
+    // Returns whether the state of the capability changed, and the driver needs to be told about it.
+    bool update_shadowed_capability_state(WebIDL::UnsignedLong cap, bool enabled);
+
     // UNPACK_FLIP_Y_WEBGL of type boolean
     //      If set, then during any subsequent calls to texImage2D or texSubImage2D, the source data is flipped along
     //      the vertical axis, so that conceptually the last row is the first one transferred. The initial value is false.
     //      Any non-zero value is interpreted as true.
     bool m_unpack_flip_y { false };
+
+private:
+    HashMap<WebIDL::UnsignedLong, bool> m_capability_states;
 };
 
 }
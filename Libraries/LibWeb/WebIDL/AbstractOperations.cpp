@@ -7,6 +7,7 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <AK/Checked.h>
 #include <AK/Enumerate.h>
 #include <AK/NumericLimits.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -457,6 +458,11 @@ double integer_part(double n)
 template<Integral T>
 JS::ThrowCompletionOr<T> convert_to_int(JS::VM& vm, JS::Value value, EnforceRange enforce_range, Clamp clamp)
 {
+    // OPTIMIZATION: Every step below leaves an integer that is within the range of T unchanged, so we can skip the
+    //               conversion to a double and back for the common case of passing such an integer.
+    if (value.is_int32() && AK::is_within_range<T>(value.as_i32()))
+        return static_cast<T>(value.as_i32());
+
     double upper_bound = 0;
     double lower_bound = 0;
 
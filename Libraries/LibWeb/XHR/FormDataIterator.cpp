@@ -17,7 +17,7 @@ template<>
 void Intrinsics::create_web_prototype_and_constructor<FormDataIteratorPrototype>(JS::Realm& realm)
 {
     auto prototype = realm.create<FormDataIteratorPrototype>(realm);
-    m_prototypes.set("FormDataIterator"_fly_string, prototype);
+    set_web_prototype("FormDataIterator"_fly_string, prototype);
 }
 
 }
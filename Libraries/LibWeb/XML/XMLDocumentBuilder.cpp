@@ -64,6 +64,12 @@ XMLDocumentBuilder::XMLDocumentBuilder(DOM::Document& document, XMLScriptingSupp
     m_namespace_stack.append({ {}, 1 });
 }
 
+void XMLDocumentBuilder::visit_edges(JS::Cell::Visitor& visitor)
+{
+    visitor.visit(m_document);
+    visitor.visit(m_current_node);
+}
+
 ErrorOr<void> XMLDocumentBuilder::set_source(ByteString source)
 {
     m_document->set_source(TRY(String::from_byte_string(source)));
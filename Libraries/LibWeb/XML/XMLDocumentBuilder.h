@@ -29,6 +29,8 @@ public:
 
     bool has_error() const { return m_has_error; }
 
+    void visit_edges(JS::Cell::Visitor&);
+
 private:
     virtual ErrorOr<void> set_source(ByteString) override;
     virtual void set_doctype(XML::Doctype) override;
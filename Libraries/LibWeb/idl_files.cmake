@@ -279,6 +279,7 @@ libweb_js_bindings(HTML/PluginArray)
 libweb_js_bindings(HTML/PopStateEvent)
 libweb_js_bindings(HTML/PromiseRejectionEvent)
 libweb_js_bindings(HTML/RadioNodeList)
+libweb_js_bindings(HTML/Scheduler)
 libweb_js_bindings(HTML/ShadowRealmGlobalScope GLOBAL)
 libweb_js_bindings(HTML/SharedWorker)
 libweb_js_bindings(HTML/SharedWorkerGlobalScope GLOBAL)
@@ -29,6 +29,10 @@ public:
 
     virtual bool handshake_complete_when_connected() const { return false; }
 
+    // If the handshake is done by the implementation, this returns the value of the Sec-WebSocket-Extensions header
+    // that the server responded with.
+    virtual Optional<ByteString> server_handshake_extensions() const { return {}; }
+
     Function<void()> on_connected;
     Function<void()> on_connection_error;
     Function<void()> on_ready_to_read;
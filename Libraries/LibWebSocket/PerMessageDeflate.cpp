@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <LibWebSocket/PerMessageDeflate.h>
+
+#include <zlib.h>
+
+namespace WebSocket {
+
+// The last four octets of an empty stored block, which end every message after a sync flush.
+static constexpr Array<u8, 4> empty_stored_block_tail { 0x00, 0x00, 0xff, 0xff };
+
+static Error zlib_error(int result)
+{
+    if (result == Z_MEM_ERROR)
+        return Error::from_errno(ENOMEM);
+    if (result == Z_DATA_ERROR)
+        return Error::from_string_literal("Invalid DEFLATE data");
+    return Error::from_string_literal("zlib error");
+}
+
+static ErrorOr<z_stream*> new_deflate_stream(int window_bits)
+{
+    auto* stream = new (nothrow) z_stream {};
+    if (!stream)
+        return Error::from_errno(ENOMEM);
+    if (auto result = deflateInit2(stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -window_bits, 8, Z_DEFAULT_STRATEGY); result != Z_OK) {
+        delete stream;
+        return zlib_error(result);
+    }
+    return stream;
+}
+
+static ErrorOr<z_stream*> new_inflate_stream(int window_bits)
+{
+    auto* stream = new (nothrow) z_stream {};
+    if (!stream)
+        return Error::from_errno(ENOMEM);
+    if (auto result = inflateInit2(stream, -window_bits); result != Z_OK) {
+        delete stream;
+        return zlib_error(result);
+    }
+    return stream;
+}
+
+static ErrorOr<u8> parse_max_window_bits(Optional<StringView> value)
+{
+    if (!value.has_value())
+        return Error::from_string_literal("Missing value for max_window_bits");
+
+    // Section 7.1.2.1: The value may be a quoted-string.
+    auto bits_string = *value;
+    if (bits_string.length() >= 2 && bits_string.starts_with('"') && bits_string.ends_with('"'))
+        bits_string = bits_string.substring_view(1, bits_string.length() - 2);
+
+    auto bits = bits_string.to_number<u8>(TrimWhitespace::No);
+    if (!bits.has_value() || *bits < 8 || *bits > 15)
+        return Error::from_string_literal("Invalid value for max_window_bits");
+    return *bits;
+}
+
+ErrorOr<PerMessageDeflate::Parameters> PerMessageDeflate::parse_response(StringView extension)
+{
+    auto parts = extension.split_view(';', SplitBehavior::KeepEmpty);
+    if (parts.is_empty() || !parts[0].trim_whitespace().equals_ignoring_ascii_case(extension_name))
+        return Error::from_string_literal("Not a permessage-deflate extension");
+
+    Parameters parameters;
+    Vector<StringView, 4> seen_names;
+
+    for (auto part : parts.span().slice(1)) {
+        auto name = part;
+        Optional<StringView> value;
+        if (auto equals = part.find('='); equals.has_value()) {
+            name = part.substring_view(0, *equals);
+            value = part.substring_view(*equals + 1).trim_whitespace();
+        }
+        name = name.trim_whitespace();
+
+        // Section 7: A server MUST decline an extension negotiation offer if it has a parameter that appears more than
+        // once, and so the client must not accept such a response either.
+        for (auto seen_name : seen_names) {
+            if (seen_name.equals_ignoring_ascii_case(name))
+                return Error::from_string_literal("Duplicate permessage-deflate parameter");
+        }
+        seen_names.append(name);
+
+        if (name.equals_ignoring_ascii_case("server_no_context_takeover"sv)) {
+            if (value.has_value())
+                return Error::from_string_literal("Unexpected value for server_no_context_takeover");
+            parameters.server_no_context_takeover = true;
+        } else if (name.equals_ignoring_ascii_case("client_no_context_takeover"sv)) {
+            if (value.has_value())
+                return Error::from_string_literal("Unexpected value for client_no_context_takeover");
+            parameters.client_no_context_takeover = true;
+        } else if (name.equals_ignoring_ascii_case("server_max_window_bits"sv)) {
+            parameters.server_max_window_bits = TRY(parse_max_window_bits(value));
+        } else if (name.equals_ignoring_ascii_case("client_max_window_bits"sv)) {
+            // Section 7.1.2.2: The response may only contain this parameter because our offer did, and it must have a value.
+            parameters.client_max_window_bits = TRY(parse_max_window_bits(value));
+        } else {
+            return Error::from_string_literal("Unknown permessage-deflate parameter");
+        }
+    }
+
+    return parameters;
+}
+
+ErrorOr<NonnullOwnPtr<PerMessageDeflate>> PerMessageDeflate::create(Parameters parameters)
+{
+    auto per_message_deflate = TRY(adopt_nonnull_own_or_enomem(new (nothrow) PerMessageDeflate(parameters)));
+
+    // zlib can't write raw DEFLATE streams with a window of 256 bytes, see can_compress().
+    if (parameters.client_max_window_bits > 8)
+        per_message_deflate->m_deflate = TRY(new_deflate_stream(parameters.client_max_window_bits));
+
+    // Inflating with the largest window handles any window the server may use.
+    per_message_deflate->m_inflate = TRY(new_inflate_stream(MAX_WBITS));
+
+    return per_message_deflate;
+}
+
+PerMessageDeflate::PerMessageDeflate(Parameters parameters)
+    : m_parameters(parameters)
+{
+}
+
+PerMessageDeflate::~PerMessageDeflate()
+{
+    if (m_deflate) {
+        deflateEnd(m_deflate);
+        delete m_deflate;
+    }
+    if (m_inflate) {
+        inflateEnd(m_inflate);
+        delete m_inflate;
+    }
+}
+
+// Section 7.2.1
+ErrorOr<ByteBuffer> PerMessageDeflate::compress(ReadonlyBytes payload)
+{
+    VERIFY(can_compress());
+    if (payload.size() > NumericLimits<uInt>::max())
+        return Error::from_errno(EMSGSIZE);
+
+    // 1. Compress all the octets of the payload of the message using DEFLATE.
+    // 2. If the resulting data does not end with an empty DEFLATE block with no compression (the "BTYPE" bits are set
+    //    to 00), append an empty DEFLATE block with no compression to the tail end.
+    m_deflate->next_in = const_cast<u8*>(payload.data());
+    m_deflate->avail_in = payload.size();
+
+    ByteBuffer output;
+    do {
+        auto chunk = TRY(output.get_bytes_for_writing(deflateBound(m_deflate, m_deflate->avail_in) + empty_stored_block_tail.size() + 1));
+        m_deflate->next_out = chunk.data();
+        m_deflate->avail_out = chunk.size();
+
+        auto result = deflate(m_deflate, Z_SYNC_FLUSH);
+        if (result != Z_OK && result != Z_BUF_ERROR)
+            return zlib_error(result);
+
+        output.trim(output.size() - m_deflate->avail_out, false);
+    } while (m_deflate->avail_out == 0);
+
+    // 3. Remove 4 octets (that are 0x00 0x00 0xff 0xff) from the tail end.
+    VERIFY(output.bytes().ends_with(empty_stored_block_tail.span()));
+    output.trim(output.size() - empty_stored_block_tail.size(), false);
+
+    if (m_parameters.client_no_context_takeover)
+        deflateReset(m_deflate);
+
+    return output;
+}
+
+// Section 7.2.2
+ErrorOr<ByteBuffer> PerMessageDeflate::decompress(ReadonlyBytes payload)
+{
+    if (payload.size() > NumericLimits<uInt>::max())
+        return Error::from_errno(EMSGSIZE);
+
+    // 1. Append 4 octets of 0x00 0x00 0xff 0xff to the tail end of the payload of the message.
+    // 2. Decompress the resulting data using DEFLATE.
+    ByteBuffer output;
+    bool reached_final_block = false;
+
+    for (auto input : { payload, empty_stored_block_tail.span() }) {
+        m_inflate->next_in = const_cast<u8*>(input.data());
+        m_inflate->avail_in = input.size();
+
+        do {
+            auto chunk = TRY(output.get_bytes_for_writing(max(static_cast<size_t>(m_inflate->avail_in) * 2, 4096uz)));
+            m_inflate->next_out = chunk.data();
+            m_inflate->avail_out = chunk.size();
+
+            auto result = inflate(m_inflate, Z_SYNC_FLUSH);
+            if (result != Z_OK && result != Z_BUF_ERROR && result != Z_STREAM_END)
+                return zlib_error(result);
+
+            output.trim(output.size() - m_inflate->avail_out, false);
+
+            // Section 7.2.3.3: The server may end a message with a block that has the "BFINAL" bit set, after which
+            // the DEFLATE stream is over, and the next message starts a new one.
+            if (result == Z_STREAM_END) {
+                reached_final_block = true;
+                break;
+            }
+        } while (m_inflate->avail_in > 0 || m_inflate->avail_out == 0);
+
+        if (reached_final_block)
+            break;
+    }
+
+    if (reached_final_block || m_parameters.server_no_context_takeover)
+        inflateReset(m_inflate);
+
+    return output;
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/StringView.h>
+
+extern "C" {
+typedef struct z_stream_s z_stream;
+}
+
+namespace WebSocket {
+
+// The permessage-deflate extension, as defined by RFC 7692. Messages are compressed with one DEFLATE stream per
+// direction, which is kept around between messages unless the peer asked us not to ("context takeover").
+class PerMessageDeflate {
+    AK_MAKE_NONCOPYABLE(PerMessageDeflate);
+    AK_MAKE_NONMOVABLE(PerMessageDeflate);
+
+public:
+    static constexpr StringView extension_name = "permessage-deflate"sv;
+
+    // The extension offer sent in the client handshake.
+    static constexpr StringView client_offer = "permessage-deflate; client_max_window_bits"sv;
+
+    // Section 7.1
+    struct Parameters {
+        bool server_no_context_takeover { false };
+        bool client_no_context_takeover { false };
+        u8 server_max_window_bits { 15 };
+        u8 client_max_window_bits { 15 };
+    };
+
+    // Parses one element of the Sec-WebSocket-Extensions header of the server handshake that accepted our offer.
+    static ErrorOr<Parameters> parse_response(StringView extension);
+
+    static ErrorOr<NonnullOwnPtr<PerMessageDeflate>> create(Parameters);
+    ~PerMessageDeflate();
+
+    // zlib can't produce raw DEFLATE streams with a window of 256 bytes, so if the server limits us to that, our
+    // messages are sent uncompressed, which the extension allows.
+    bool can_compress() const { return m_deflate != nullptr; }
+
+    ErrorOr<ByteBuffer> compress(ReadonlyBytes payload);
+    ErrorOr<ByteBuffer> decompress(ReadonlyBytes payload);
+
+private:
+    explicit PerMessageDeflate(Parameters);
+
+    Parameters m_parameters;
+    z_stream* m_deflate { nullptr };
+    z_stream* m_inflate { nullptr };
+};
+
+}
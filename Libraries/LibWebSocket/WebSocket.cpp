@@ -7,6 +7,8 @@
 
 #include <AK/Base64.h>
 #include <AK/Random.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <LibCrypto/Hash/HashManager.h>
 #include <LibCrypto/SecureRandom.h>
 #include <LibWebSocket/Impl/WebSocketImplSerenity.h>
@@ -17,6 +19,26 @@ namespace WebSocket {
 // Note : The websocket protocol is defined by RFC 6455, found at https://tools.ietf.org/html/rfc6455
 // In this file, section numbers will refer to the RFC 6455
 
+// Section 5.3: Applies the masking key to the input, 16 octets at a time where possible.
+static void apply_masking_key(ReadonlyBytes input, Bytes output, u8 const (&masking_key)[4])
+{
+    using AK::SIMD::u8x16;
+
+    VERIFY(output.size() >= input.size());
+
+    u8x16 repeated_masking_key;
+    for (size_t i = 0; i < sizeof(u8x16); ++i)
+        repeated_masking_key[i] = masking_key[i % 4];
+
+    size_t offset = 0;
+    for (; offset + sizeof(u8x16) <= input.size(); offset += sizeof(u8x16)) {
+        auto chunk = AK::SIMD::load_unaligned<u8x16>(input.offset_pointer(offset));
+        AK::SIMD::store_unaligned(output.offset_pointer(offset), chunk ^ repeated_masking_key);
+    }
+    for (; offset < input.size(); ++offset)
+        output[offset] = input[offset] ^ masking_key[offset % 4];
+}
+
 NonnullRefPtr<WebSocket> WebSocket::create(ConnectionInfo connection, RefPtr<WebSocketImpl> impl)
 {
     return adopt_ref(*new WebSocket(move(connection), move(impl)));
@@ -35,6 +57,11 @@ void WebSocket::start()
     if (!m_impl)
         m_impl = adopt_ref(*new WebSocketImplSerenity);
 
+    // RFC 7692: Offer to compress messages with the permessage-deflate extension.
+    auto extensions = m_connection.extensions();
+    extensions.append(PerMessageDeflate::client_offer);
+    m_connection.set_extensions(move(extensions));
+
     m_impl->on_connection_error = [this] {
         dbgln("WebSocket: Connection error (underlying socket)");
         fatal_error(WebSocket::Error::CouldNotEstablishConnection);
@@ -43,6 +70,8 @@ void WebSocket::start()
         if (m_state != WebSocket::InternalState::EstablishingProtocolConnection)
             return;
         if (m_impl->handshake_complete_when_connected()) {
+            if (auto extensions = m_impl->server_handshake_extensions(); extensions.has_value() && !negotiate_extensions(*extensions))
+                return;
             set_state(WebSocket::InternalState::Open);
             notify_open();
         } else {
@@ -89,10 +118,16 @@ void WebSocket::send(Message const& message)
     // Calling send on a socket that is not opened is not allowed
     VERIFY(m_state == WebSocket::InternalState::Open);
     VERIFY(m_impl);
-    if (message.is_text())
-        send_frame(WebSocket::OpCode::Text, message.data(), true);
-    else
-        send_frame(WebSocket::OpCode::Binary, message.data(), true);
+    auto op_code = message.is_text() ? WebSocket::OpCode::Text : WebSocket::OpCode::Binary;
+
+    // RFC 7692 section 6: Compressed messages are sent with the RSV1 bit set.
+    if (m_per_message_deflate && m_per_message_deflate->can_compress()) {
+        auto compressed_payload = m_per_message_deflate->compress(message.data()).release_value_but_fixme_should_propagate_errors();
+        send_frame(op_code, compressed_payload, true, true);
+        return;
+    }
+
+    send_frame(op_code, message.data(), true);
 }
 
 void WebSocket::close(u16 code, ByteString const& message)
@@ -167,7 +202,9 @@ void WebSocket::drain_read()
         do {
             if (auto maybe_error = read_frame(); maybe_error.is_error())
                 break;
-        } while (!m_buffered_data.is_empty());
+        } while (m_buffered_data_offset < m_buffered_data.size());
+        m_buffered_data.remove(0, m_buffered_data_offset);
+        m_buffered_data_offset = 0;
     } break;
     case InternalState::Closed:
     case InternalState::Errored: {
@@ -365,20 +402,8 @@ void WebSocket::read_server_handshake()
 
         if (header_name.equals_ignoring_ascii_case("Sec-WebSocket-Extensions"sv)) {
             // 5. |Sec-WebSocket-Extensions| should not contain an extension that doesn't appear in m_connection->extensions()
-            auto server_extensions = parts[1].split(',');
-            for (auto const& extension : server_extensions) {
-                auto trimmed_extension = extension.trim_whitespace();
-                bool found_extension = false;
-                for (auto const& supported_extension : m_connection.extensions()) {
-                    if (trimmed_extension.equals_ignoring_ascii_case(supported_extension)) {
-                        found_extension = true;
-                    }
-                }
-                if (!found_extension) {
-                    fail_opening_handshake(ByteString::formatted("Server HTTP Handshake Header |Sec-WebSocket-Extensions| contains '{}', which is not supported by the client. Failing connection.", trimmed_extension));
-                    return;
-                }
-            }
+            if (!negotiate_extensions(parts[1]))
+                return;
             continue;
         }
 
@@ -404,13 +429,55 @@ void WebSocket::read_server_handshake()
     // If needed, we will keep reading the header on the next drain_read call
 }
 
+// Section 9.1
+bool WebSocket::negotiate_extensions(StringView server_extensions)
+{
+    auto fail_opening_handshake = [&](ByteString const& reason) {
+        fail_connection(to_underlying(CloseStatusCode::AbnormalClosure), WebSocket::Error::ConnectionUpgradeFailed, reason);
+        return false;
+    };
+
+    for (auto extension : server_extensions.split_view(',')) {
+        extension = extension.trim_whitespace();
+        auto extension_name = extension.substring_view(0, extension.find(';').value_or(extension.length())).trim_whitespace();
+
+        if (extension_name.equals_ignoring_ascii_case(PerMessageDeflate::extension_name)) {
+            // RFC 7692 section 5.1: The server accepts at most one of the offers of an extension.
+            if (m_per_message_deflate)
+                return fail_opening_handshake("Server HTTP Handshake Header |Sec-WebSocket-Extensions| accepts permessage-deflate more than once. Failing connection.");
+
+            auto parameters = PerMessageDeflate::parse_response(extension);
+            if (parameters.is_error())
+                return fail_opening_handshake(ByteString::formatted("Server HTTP Handshake Header |Sec-WebSocket-Extensions| contains '{}', which is invalid: {}. Failing connection.", extension, parameters.error()));
+
+            auto per_message_deflate = PerMessageDeflate::create(parameters.value());
+            if (per_message_deflate.is_error())
+                return fail_opening_handshake(ByteString::formatted("Failed to set up permessage-deflate: {}", per_message_deflate.error()));
+
+            m_per_message_deflate = per_message_deflate.release_value();
+            continue;
+        }
+
+        bool found_extension = false;
+        for (auto const& supported_extension : m_connection.extensions()) {
+            if (extension.equals_ignoring_ascii_case(supported_extension)) {
+                found_extension = true;
+            }
+        }
+        if (!found_extension)
+            return fail_opening_handshake(ByteString::formatted("Server HTTP Handshake Header |Sec-WebSocket-Extensions| contains '{}', which is not supported by the client. Failing connection.", extension));
+    }
+
+    return true;
+}
+
 ErrorOr<void> WebSocket::read_frame()
 {
     VERIFY(m_impl);
     VERIFY(m_state == WebSocket::InternalState::Open || m_state == WebSocket::InternalState::Closing);
 
-    size_t cursor = 0;
-    auto get_buffered_bytes = [&](size_t count) -> ReadonlyBytes {
+    size_t cursor = m_buffered_data_offset;
+    auto get_buffered_bytes = [&](size_t count) -> Optional<ReadonlyBytes> {
         if (cursor + count > m_buffered_data.size())
             return {};
         auto bytes = m_buffered_data.span().slice(cursor, count);
@@ -418,27 +485,38 @@ ErrorOr<void> WebSocket::read_frame()
         return bytes;
     };
 
-    auto head_bytes = get_buffered_bytes(2);
-    if (head_bytes.is_null() || head_bytes.is_empty()) {
+    auto maybe_head_bytes = get_buffered_bytes(2);
+    if (!maybe_head_bytes.has_value()) {
         // The connection got closed.
         set_state(WebSocket::InternalState::Closed);
         notify_close(m_last_close_code, m_last_close_message, true);
         discard_connection();
         return AK::Error::from_errno(ECONNABORTED);
     }
+    auto head_bytes = *maybe_head_bytes;
 
     auto op_code = (WebSocket::OpCode)(head_bytes[0] & 0x0f);
     bool is_final_frame = head_bytes[0] & 0x80;
+    bool is_compressed = head_bytes[0] & 0x40;
     bool is_masked = head_bytes[1] & 0x80;
 
+    // RFC 7692 section 6: The RSV1 bit is only set on the first frame of a compressed message, and only if the
+    // permessage-deflate extension is in use.
+    bool is_control_frame = to_underlying(op_code) & 0x8;
+    if (is_compressed && (!m_per_message_deflate || is_control_frame || op_code == WebSocket::OpCode::Continuation)) {
+        fail_connection(to_underlying(CloseStatusCode::ProtocolError), WebSocket::Error::ServerClosedSocket, "Server sent a frame with an unexpected RSV1 bit");
+        return AK::Error::from_errno(EINVAL);
+    }
+
     // Parse the payload length.
     size_t payload_length;
     auto payload_length_bits = head_bytes[1] & 0x7f;
     if (payload_length_bits == 127) {
         // A code of 127 means that the next 8 bytes contains the payload length
-        auto actual_bytes = get_buffered_bytes(8);
-        if (actual_bytes.is_null())
+        auto maybe_actual_bytes = get_buffered_bytes(8);
+        if (!maybe_actual_bytes.has_value())
             return AK::Error::from_errno(EAGAIN);
+        auto actual_bytes = *maybe_actual_bytes;
         u64 full_payload_length = (u64)((u64)(actual_bytes[0] & 0xff) << 56)
             | (u64)((u64)(actual_bytes[1] & 0xff) << 48)
             | (u64)((u64)(actual_bytes[2] & 0xff) << 40)
@@ -451,9 +529,10 @@ ErrorOr<void> WebSocket::read_frame()
         payload_length = (size_t)full_payload_length;
     } else if (payload_length_bits == 126) {
         // A code of 126 means that the next 2 bytes contains the payload length
-        auto actual_bytes = get_buffered_bytes(2);
-        if (actual_bytes.is_null())
+        auto maybe_actual_bytes = get_buffered_bytes(2);
+        if (!maybe_actual_bytes.has_value())
             return AK::Error::from_errno(EAGAIN);
+        auto actual_bytes = *maybe_actual_bytes;
         payload_length = (size_t)((size_t)(actual_bytes[0] & 0xff) << 8)
             | (size_t)((size_t)(actual_bytes[1] & 0xff) << 0);
     } else {
@@ -469,39 +548,26 @@ ErrorOr<void> WebSocket::read_frame()
     u8 masking_key[4];
     if (is_masked) {
         auto masking_key_data = get_buffered_bytes(4);
-        if (masking_key_data.is_null())
+        if (!masking_key_data.has_value())
             return AK::Error::from_errno(EAGAIN);
-        masking_key[0] = masking_key_data[0];
-        masking_key[1] = masking_key_data[1];
-        masking_key[2] = masking_key_data[2];
-        masking_key[3] = masking_key_data[3];
+        masking_key[0] = (*masking_key_data)[0];
+        masking_key[1] = (*masking_key_data)[1];
+        masking_key[2] = (*masking_key_data)[2];
+        masking_key[3] = (*masking_key_data)[3];
     }
 
-    auto payload = ByteBuffer::create_uninitialized(payload_length).release_value_but_fixme_should_propagate_errors(); // FIXME: Handle possible OOM situation.
-    u64 read_length = 0;
-    while (read_length < payload_length) {
-        auto payload_part = get_buffered_bytes(payload_length - read_length);
-        if (payload_part.is_null())
-            return AK::Error::from_errno(EAGAIN);
-        // We read at most "actual_length - read" bytes, so this is safe to do.
-        payload.overwrite(read_length, payload_part.data(), payload_part.size());
-        read_length += payload_part.size();
-    }
+    auto payload_data = get_buffered_bytes(payload_length);
+    if (!payload_data.has_value())
+        return AK::Error::from_errno(EAGAIN);
 
-    if (cursor == m_buffered_data.size()) {
-        m_buffered_data.clear();
-    } else {
-        Vector<u8> new_buffered_data;
-        new_buffered_data.append(m_buffered_data.data() + cursor, m_buffered_data.size() - cursor);
-        m_buffered_data = move(new_buffered_data);
-    }
+    // Unmask the payload while copying it out of the buffered data.
+    auto payload = ByteBuffer::create_uninitialized(payload_length).release_value_but_fixme_should_propagate_errors(); // FIXME: Handle possible OOM situation.
+    if (is_masked)
+        apply_masking_key(*payload_data, payload.bytes(), masking_key);
+    else
+        payload.overwrite(0, payload_data->data(), payload_length);
 
-    if (is_masked) {
-        // Unmask the payload
-        for (size_t i = 0; i < payload.size(); ++i) {
-            payload[i] = payload[i] ^ (masking_key[i % 4]);
-        }
-    }
+    m_buffered_data_offset = cursor;
 
     if (op_code == WebSocket::OpCode::ConnectionClose) {
         if (payload.size() > 1) {
@@ -527,8 +593,11 @@ ErrorOr<void> WebSocket::read_frame()
         if (op_code != WebSocket::OpCode::Continuation) {
             // First fragmented message
             m_initial_fragment_opcode = op_code;
+            m_fragmented_message_is_compressed = is_compressed;
+            m_fragmented_data_buffer = move(payload);
+            return {};
         }
-        // First and next fragmented message
+        // Next fragmented message
         m_fragmented_data_buffer.append(payload.data(), payload_length);
         return {};
     }
@@ -536,10 +605,18 @@ ErrorOr<void> WebSocket::read_frame()
         // Last fragmented message
         m_fragmented_data_buffer.append(payload.data(), payload_length);
         op_code = m_initial_fragment_opcode;
-        payload.clear();
-        payload.append(m_fragmented_data_buffer.data(), m_fragmented_data_buffer.size());
+        is_compressed = m_fragmented_message_is_compressed;
+        payload = move(m_fragmented_data_buffer);
         m_fragmented_data_buffer.clear();
     }
+    if (is_compressed) {
+        auto decompressed_payload = m_per_message_deflate->decompress(payload);
+        if (decompressed_payload.is_error()) {
+            fail_connection(to_underlying(CloseStatusCode::InvalidPayload), WebSocket::Error::ServerClosedSocket, ByteString::formatted("Failed to decompress message: {}", decompressed_payload.error()));
+            return decompressed_payload.release_error();
+        }
+        payload = decompressed_payload.release_value();
+    }
     if (op_code == WebSocket::OpCode::Text) {
         notify_message(Message(move(payload), true));
         return {};
@@ -552,7 +629,7 @@ ErrorOr<void> WebSocket::read_frame()
     return {};
 }
 
-void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, bool is_final)
+void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, bool is_final, bool is_compressed)
 {
     VERIFY(m_impl);
     VERIFY(m_state == WebSocket::InternalState::Open);
@@ -560,7 +637,7 @@ void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, boo
     ByteBuffer buf = MUST(ByteBuffer::create_uninitialized(1 + 9 + 4 + payload.size()));
     size_t offset = 0;
 
-    u8 frame_head[1] = { (u8)((is_final ? 0x80 : 0x00) | ((u8)(op_code) & 0xf)) };
+    u8 frame_head[1] = { (u8)((is_final ? 0x80 : 0x00) | (is_compressed ? 0x40 : 0x00) | ((u8)(op_code) & 0xf)) };
     buf.overwrite(offset, frame_head, 1);
     offset += 1;
     // Section 5.1 : a client MUST mask all frames that it sends to the server
@@ -624,14 +701,8 @@ void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, boo
         Crypto::fill_with_secure_random(masking_key);
         buf.overwrite(offset, masking_key, 4);
         offset += 4;
-        // don't try to send empty payload
-        if (payload.size() == 0)
-            return;
         // Mask the payload
-        auto masked_payload = buf.span().slice(offset, payload.size());
-        for (size_t i = 0; i < payload.size(); ++i) {
-            masked_payload[i] = payload[i] ^ (masking_key[i % 4]);
-        }
+        apply_masking_key(payload, buf.span().slice(offset, payload.size()), masking_key);
         offset += payload.size();
     } else if (payload.size() > 0) {
         buf.overwrite(offset, payload.data(), payload.size());
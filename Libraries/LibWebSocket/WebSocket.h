@@ -7,11 +7,13 @@
 
 #pragma once
 
+#include <AK/OwnPtr.h>
 #include <AK/Span.h>
 #include <LibCore/EventReceiver.h>
 #include <LibWebSocket/ConnectionInfo.h>
 #include <LibWebSocket/Impl/WebSocketImpl.h>
 #include <LibWebSocket/Message.h>
+#include <LibWebSocket/PerMessageDeflate.h>
 
 namespace WebSocket {
 
@@ -88,9 +90,10 @@ private:
 
     void send_client_handshake();
     void read_server_handshake();
+    bool negotiate_extensions(StringView server_extensions);
 
     ErrorOr<void> read_frame();
-    void send_frame(OpCode, ReadonlyBytes, bool is_final);
+    void send_frame(OpCode, ReadonlyBytes, bool is_final, bool is_compressed = false);
 
     void notify_open();
     void notify_close(u16 code, ByteString reason, bool was_clean);
@@ -133,9 +136,16 @@ private:
     ConnectionInfo m_connection;
     RefPtr<WebSocketImpl> m_impl;
 
+    // Frames are read from the front of the buffered data, which is only compacted once all complete frames have been
+    // read, rather than after every frame.
     Vector<u8> m_buffered_data;
+    size_t m_buffered_data_offset { 0 };
+
     ByteBuffer m_fragmented_data_buffer;
     WebSocket::OpCode m_initial_fragment_opcode;
+    bool m_fragmented_message_is_compressed { false };
+
+    OwnPtr<PerMessageDeflate> m_per_message_deflate;
 };
 
 }
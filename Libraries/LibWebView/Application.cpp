@@ -7,9 +7,12 @@
 #include <AK/Debug.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/Environment.h>
+#include <LibCore/File.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibCore/TimeZoneWatcher.h>
+#include <LibCore/Timer.h>
+#include <LibCore/Trace.h>
 #include <LibDatabase/Database.h>
 #include <LibDevTools/DevToolsServer.h>
 #include <LibFileSystem/FileSystem.h>
@@ -18,6 +21,7 @@
 #include <LibWeb/Loader/UserAgent.h>
 #include <LibWebView/Application.h>
 #include <LibWebView/CookieJar.h>
+#include <LibWebView/HeadlessBatch.h>
 #include <LibWebView/HeadlessWebView.h>
 #include <LibWebView/HelperProcess.h>
 #include <LibWebView/Menu.h>
@@ -66,6 +70,16 @@ Application::~Application()
     // Explicitly delete the settings observer first, as the observer destructor will refer to Application::the().
     m_settings_observer.clear();
 
+    if (Core::Trace::is_enabled()) {
+        Core::Trace::flush();
+        m_traced_process_ids.prepend(Core::System::getpid());
+
+        if (auto result = Core::Trace::merge_process_traces(m_traced_process_ids); result.is_error())
+            warnln("Unable to merge trace files: {}", result.error());
+        else
+            outln("Trace written to {}", *Core::Trace::path());
+    }
+
     s_the = nullptr;
 }
 
@@ -96,6 +110,9 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     Vector<ByteString> raw_urls;
     Vector<ByteString> certificates;
     Optional<HeadlessMode> headless_mode;
+    Optional<StringView> url_list_path;
+    Optional<StringView> headless_output_directory;
+    Optional<size_t> headless_concurrency;
     Optional<int> window_width;
     Optional<int> window_height;
     bool new_window = false;
@@ -119,6 +136,7 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     bool enable_idl_tracing = false;
     bool disable_http_cache = false;
     bool enable_http_disk_cache = false;
+    Optional<u64> http_disk_cache_size_limit;
     bool disable_content_filter = false;
     bool enable_autoplay = false;
     bool expose_internals_object = false;
@@ -126,6 +144,9 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     bool force_fontconfig = false;
     bool collect_garbage_on_every_allocation = false;
     bool disable_scrollbar_painting = false;
+    Optional<size_t> web_content_process_pool_size;
+    Optional<size_t> web_worker_process_pool_size;
+    Optional<u64> memory_pressure_threshold;
 
     Core::ArgsParser args_parser;
     args_parser.set_general_help("The Ladybird web browser :^)");
@@ -151,6 +172,9 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
         },
     });
 
+    args_parser.add_option(url_list_path, "Path to a file of URLs to open, one per line", "url-list", 0, "path");
+    args_parser.add_option(headless_output_directory, "Directory to write the screenshots or dumps of each page to when loading multiple pages in headless mode (default: current directory)", "headless-output-directory", 0, "path");
+    args_parser.add_option(headless_concurrency, "Number of WebContent processes to load pages in concurrently when loading multiple pages in headless mode (default: 1)", "headless-concurrency", 0, "count");
     args_parser.add_option(window_width, "Set viewport width in pixels (default: 800) (currently only supported for headless mode)", "window-width", 0, "pixels");
     args_parser.add_option(window_height, "Set viewport height in pixels (default: 600) (currently only supported for headless mode)", "window-height", 0, "pixels");
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
@@ -168,6 +192,7 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     args_parser.add_option(enable_idl_tracing, "Enable IDL tracing", "enable-idl-tracing");
     args_parser.add_option(disable_http_cache, "Disable HTTP cache", "disable-http-cache");
     args_parser.add_option(enable_http_disk_cache, "Enable HTTP disk cache", "enable-http-disk-cache");
+    args_parser.add_option(http_disk_cache_size_limit, "Maximum size of the HTTP disk cache in MiB", "http-disk-cache-size-limit", 0, "size");
     args_parser.add_option(disable_content_filter, "Disable content filter", "disable-content-filter");
     args_parser.add_option(enable_autoplay, "Enable multimedia autoplay", "enable-autoplay");
     args_parser.add_option(expose_internals_object, "Expose internals object", "expose-internals-object");
@@ -180,6 +205,9 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     args_parser.add_option(use_dns_over_tls, "Use DNS over TLS", "dot");
     args_parser.add_option(validate_dnssec_locally, "Validate DNSSEC locally", "dnssec");
     args_parser.add_option(default_time_zone, "Default time zone", "default-time-zone", 0, "time-zone-id");
+    args_parser.add_option(web_content_process_pool_size, "Number of WebContent processes to launch ahead of time for new tabs and navigations (default: 1)", "web-content-process-pool-size", 0, "count");
+    args_parser.add_option(web_worker_process_pool_size, "Number of WebWorker processes to launch ahead of time for dedicated workers (default: 1)", "web-worker-process-pool-size", 0, "count");
+    args_parser.add_option(memory_pressure_threshold, "Memory usage in MiB past which caches are dropped and hidden tabs are discarded, or 0 to disable (default: half of physical memory)", "memory-pressure-threshold", 0, "size");
 
     args_parser.add_option(Core::ArgsParser::Option {
         .argument_mode = Core::ArgsParser::OptionArgumentMode::Optional,
@@ -210,6 +238,17 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     create_platform_arguments(args_parser);
     args_parser.parse(m_arguments);
 
+    if (url_list_path.has_value()) {
+        auto file = TRY(Core::File::open(*url_list_path, Core::File::OpenMode::Read));
+        auto contents = TRY(file->read_until_eof());
+
+        for (auto line : StringView { contents }.lines()) {
+            line = line.trim_whitespace();
+            if (!line.is_empty() && !line.starts_with('#'))
+                raw_urls.append(line);
+        }
+    }
+
     // Our persisted SQL storage assumes it runs in a singleton process. If we have multiple UI processes accessing
     // the same underlying database, one of them is likely to fail.
     if (force_new_process)
@@ -250,6 +289,13 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
         .enable_content_filter = disable_content_filter ? EnableContentFilter::No : EnableContentFilter::Yes,
     };
 
+    if (headless_output_directory.has_value())
+        m_browser_options.headless_output_directory = *headless_output_directory;
+    else if (headless_mode.has_value() && (url_list_path.has_value() || m_browser_options.urls.size() > 1))
+        m_browser_options.headless_output_directory = "."sv;
+    if (headless_concurrency.has_value())
+        m_browser_options.headless_concurrency = *headless_concurrency;
+
     if (window_width.has_value())
         m_browser_options.window_width = *window_width;
     if (window_height.has_value())
@@ -258,9 +304,20 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     if (webdriver_content_ipc_path.has_value())
         m_browser_options.webdriver_content_ipc_path = *webdriver_content_ipc_path;
 
+    if (web_content_process_pool_size.has_value())
+        m_browser_options.web_content_process_pool_size = *web_content_process_pool_size;
+    if (web_worker_process_pool_size.has_value())
+        m_browser_options.web_worker_process_pool_size = *web_worker_process_pool_size;
+
+    if (memory_pressure_threshold.has_value())
+        m_browser_options.memory_pressure_threshold = *memory_pressure_threshold * MiB;
+    else if (!headless_mode.has_value())
+        m_browser_options.memory_pressure_threshold = Core::System::physical_memory_bytes() / 2;
+
     m_request_server_options = {
         .certificates = move(certificates),
         .enable_http_disk_cache = enable_http_disk_cache ? EnableHTTPDiskCache::Yes : EnableHTTPDiskCache::No,
+        .http_disk_cache_size_limit = http_disk_cache_size_limit,
     };
 
     m_web_content_options = {
@@ -308,19 +365,23 @@ static ErrorOr<NonnullRefPtr<WebContentClient>> create_web_content_client(Option
 
 ErrorOr<NonnullRefPtr<WebContentClient>> Application::launch_web_content_process(ViewImplementation& view)
 {
-    if (m_spare_web_content_process) {
-        auto web_content_client = m_spare_web_content_process.release_nonnull();
-        launch_spare_web_content_process();
+    if (!m_web_content_process_pool.is_empty()) {
+        // The oldest process is the one most likely to have finished initializing.
+        auto web_content_client = m_web_content_process_pool.take_first();
+        fill_web_content_process_pool();
+
+        if (auto process = find_process(web_content_client->pid()); process.has_value())
+            process->set_title({});
 
         web_content_client->assign_view({}, view);
         return web_content_client;
     }
 
-    launch_spare_web_content_process();
+    fill_web_content_process_pool();
     return create_web_content_client(view);
 }
 
-void Application::launch_spare_web_content_process()
+void Application::fill_web_content_process_pool()
 {
     // Disable spare processes when debugging WebContent. Otherwise, it breaks running `gdb attach -p $(pidof WebContent)`.
     if (browser_options().debug_helper_process == ProcessType::WebContent)
@@ -329,12 +390,19 @@ void Application::launch_spare_web_content_process()
     if (browser_options().profile_helper_process == ProcessType::WebContent)
         return;
 
-    if (m_has_queued_task_to_launch_spare_web_content_process)
+    if (m_web_content_process_pool.size() >= browser_options().web_content_process_pool_size)
+        return;
+
+    if (m_has_queued_task_to_fill_web_content_process_pool)
         return;
-    m_has_queued_task_to_launch_spare_web_content_process = true;
+    m_has_queued_task_to_fill_web_content_process_pool = true;
 
+    // Processes are launched one per event loop iteration, so that filling a large pool doesn't hold up the UI.
     Core::deferred_invoke([this]() {
-        m_has_queued_task_to_launch_spare_web_content_process = false;
+        m_has_queued_task_to_fill_web_content_process_pool = false;
+
+        if (m_web_content_process_pool.size() >= browser_options().web_content_process_pool_size)
+            return;
 
         auto web_content_client = create_web_content_client({});
         if (web_content_client.is_error()) {
@@ -342,13 +410,119 @@ void Application::launch_spare_web_content_process()
             return;
         }
 
-        m_spare_web_content_process = web_content_client.release_value();
+        if (auto process = find_process(web_content_client.value()->pid()); process.has_value())
+            process->set_title("(spare)"_utf16);
+
+        m_web_content_process_pool.append(web_content_client.release_value());
+        fill_web_content_process_pool();
+    });
+}
+
+ErrorOr<NonnullRefPtr<Web::HTML::WebWorkerClient>> Application::launch_web_worker_process(Web::Bindings::AgentType type)
+{
+    // Shared and service workers are rare enough that they are always launched on demand.
+    if (type != Web::Bindings::AgentType::DedicatedWorker)
+        return WebView::launch_web_worker_process(type);
+
+    if (!m_web_worker_process_pool.is_empty()) {
+        auto web_worker_client = m_web_worker_process_pool.take_first();
+        fill_web_worker_process_pool();
+
+        if (auto process = find_process(web_worker_client->pid()); process.has_value())
+            process->set_title({});
+
+        return web_worker_client;
+    }
+
+    fill_web_worker_process_pool();
+    return WebView::launch_web_worker_process(type);
+}
+
+void Application::fill_web_worker_process_pool()
+{
+    if (browser_options().debug_helper_process == ProcessType::WebWorker)
+        return;
+    if (browser_options().profile_helper_process == ProcessType::WebWorker)
+        return;
+
+    if (m_web_worker_process_pool.size() >= browser_options().web_worker_process_pool_size)
+        return;
+
+    if (m_has_queued_task_to_fill_web_worker_process_pool)
+        return;
+    m_has_queued_task_to_fill_web_worker_process_pool = true;
+
+    Core::deferred_invoke([this]() {
+        m_has_queued_task_to_fill_web_worker_process_pool = false;
+
+        if (m_web_worker_process_pool.size() >= browser_options().web_worker_process_pool_size)
+            return;
+
+        auto web_worker_client = WebView::launch_web_worker_process(Web::Bindings::AgentType::DedicatedWorker);
+        if (web_worker_client.is_error()) {
+            dbgln("Unable to create spare web worker client: {}", web_worker_client.error());
+            return;
+        }
 
-        if (auto process = find_process(m_spare_web_content_process->pid()); process.has_value())
+        if (auto process = find_process(web_worker_client.value()->pid()); process.has_value())
             process->set_title("(spare)"_utf16);
+
+        m_web_worker_process_pool.append(web_worker_client.release_value());
+        fill_web_worker_process_pool();
     });
 }
 
+void Application::check_memory_pressure()
+{
+    m_process_manager->update_all_process_statistics();
+    auto memory_usage = m_process_manager->total_memory_usage_bytes();
+
+    if (memory_usage < browser_options().memory_pressure_threshold) {
+        m_memory_pressure_level.clear();
+        return;
+    }
+
+    if (m_memory_pressure_level == MemoryPressureLevel::Critical) {
+        // Dropping caches and collecting garbage wasn't enough, so give up on one of the tabs the user isn't looking at.
+        discard_least_recently_visible_view();
+        return;
+    }
+
+    m_memory_pressure_level = m_memory_pressure_level.has_value() ? MemoryPressureLevel::Critical : MemoryPressureLevel::Moderate;
+
+    dbgln("Memory usage of {} MiB exceeds the threshold of {} MiB, asking processes to release memory",
+        memory_usage / MiB, browser_options().memory_pressure_threshold / MiB);
+
+    WebContentClient::for_each_client([&](WebContentClient& client) {
+        client.async_handle_memory_pressure(*m_memory_pressure_level);
+        return IterationDecision::Continue;
+    });
+
+    if (m_image_decoder_client)
+        m_image_decoder_client->async_purge_decoded_image_cache();
+}
+
+void Application::discard_least_recently_visible_view()
+{
+    ViewImplementation* least_recently_visible_view = nullptr;
+
+    ViewImplementation::for_each_view([&](ViewImplementation& view) {
+        if (!view.can_be_discarded())
+            return IterationDecision::Continue;
+        if (!least_recently_visible_view || view.last_visible_time() < least_recently_visible_view->last_visible_time())
+            least_recently_visible_view = &view;
+        return IterationDecision::Continue;
+    });
+
+    if (!least_recently_visible_view) {
+        dbgln("Memory usage exceeds the threshold, but there are no hidden tabs left to discard");
+        return;
+    }
+
+    dbgln("Discarding hidden tab {} to release memory", least_recently_visible_view->url());
+    least_recently_visible_view->discard();
+}
+
 ErrorOr<void> Application::launch_services()
 {
     m_settings_observer = make<ApplicationSettingsObserver>();
@@ -358,13 +532,27 @@ ErrorOr<void> Application::launch_services()
         process_did_exit(move(process));
     };
 
+    if (m_browser_options.memory_pressure_threshold != 0) {
+        static constexpr int memory_pressure_check_interval_ms = 10'000;
+
+        m_memory_pressure_timer = Core::Timer::create_repeating(memory_pressure_check_interval_ms, [this] {
+            check_memory_pressure();
+        });
+        m_memory_pressure_timer->start();
+    }
+
     if (m_browser_options.disable_sql_database == DisableSQLDatabase::No) {
         // FIXME: Move this to a generic "Ladybird data directory" helper.
         auto database_path = ByteString::formatted("{}/Ladybird", Core::StandardPaths::user_data_directory());
 
-        m_database = TRY(Database::Database::create(database_path, "Ladybird"sv));
+        m_database = TRY(Database::Database::create(database_path, "Ladybird"sv, Database::ExecutionMode::Asynchronous));
         m_cookie_jar = TRY(CookieJar::create(*m_database));
         m_storage_jar = TRY(StorageJar::create(*m_database));
+        m_indexed_db_storage = TRY(IndexedDBStorage::create(*m_database));
+
+        // Each WebContent process keeps the databases it has opened in memory, and sends the changes of each committed
+        // transaction to us to be written to disk.
+        m_web_content_options.persist_indexed_db = PersistIndexedDB::Yes;
     } else {
         m_cookie_jar = CookieJar::create();
         m_storage_jar = StorageJar::create();
@@ -515,17 +703,29 @@ static void load_page_for_info_and_exit(Core::EventLoop& event_loop, HeadlessWeb
 ErrorOr<int> Application::execute()
 {
     OwnPtr<HeadlessWebView> view;
+    OwnPtr<HeadlessBatch> batch;
     RefPtr<Core::Timer> screenshot_timer;
 
     if (m_browser_options.headless_mode.has_value()) {
         auto theme_path = LexicalPath::join(WebView::s_ladybird_resource_root, "themes"sv, "Default.ini"sv);
         auto theme = TRY(Gfx::load_system_theme(theme_path.string()));
+        Web::DevicePixelSize window_size { m_browser_options.window_width, m_browser_options.window_height };
+
+        if (m_browser_options.headless_output_directory.has_value() && !m_browser_options.webdriver_content_ipc_path.has_value()) {
+            batch = TRY(HeadlessBatch::create(move(theme), window_size, *m_browser_options.headless_mode, m_browser_options.urls, m_browser_options.headless_concurrency, *m_browser_options.headless_output_directory));
+            batch->on_finish = [this](int exit_code) {
+                m_event_loop->quit(exit_code);
+            };
+            batch->start();
+
+            return m_event_loop->exec();
+        }
 
-        view = HeadlessWebView::create(move(theme), { m_browser_options.window_width, m_browser_options.window_height });
+        view = HeadlessWebView::create(move(theme), window_size);
 
         if (!m_browser_options.webdriver_content_ipc_path.has_value()) {
             if (m_browser_options.urls.size() != 1)
-                return Error::from_string_literal("Headless mode currently only supports exactly one URL");
+                return Error::from_string_literal("Headless mode only supports exactly one URL without an output directory");
 
             switch (*m_browser_options.headless_mode) {
             case HeadlessMode::Screenshot:
@@ -553,6 +753,8 @@ NonnullOwnPtr<Core::EventLoop> Application::create_platform_event_loop()
 
 void Application::add_child_process(WebView::Process&& process)
 {
+    if (Core::Trace::is_enabled())
+        m_traced_process_ids.append(process.pid());
     m_process_manager->add_process(move(process));
 }
 
@@ -592,6 +794,11 @@ void Application::process_did_exit(Process&& process)
         }
         break;
     case ProcessType::WebContent:
+        if (m_web_content_process_pool.remove_first_matching([&](auto const& client) { return client->pid() == process.pid(); })) {
+            dbgln_if(WEBVIEW_PROCESS_DEBUG, "Replace spare WebContent process");
+            fill_web_content_process_pool();
+            break;
+        }
         if (auto client = process.client<WebContentClient>(); client.has_value()) {
             dbgln_if(WEBVIEW_PROCESS_DEBUG, "Restart WebContent process");
             if (auto on_web_content_process_crash = move(client->on_web_content_process_crash))
@@ -599,6 +806,11 @@ void Application::process_did_exit(Process&& process)
         }
         break;
     case ProcessType::WebWorker:
+        if (m_web_worker_process_pool.remove_first_matching([&](auto const& client) { return client->pid() == process.pid(); })) {
+            dbgln_if(WEBVIEW_PROCESS_DEBUG, "Replace spare WebWorker process");
+            fill_web_worker_process_pool();
+            break;
+        }
         dbgln_if(WEBVIEW_PROCESS_DEBUG, "WebWorker {} died, not sure what to do.", process.pid());
         break;
     case ProcessType::Browser:
@@ -817,6 +1029,7 @@ void Application::initialize_actions()
     m_debug_menu->add_action(Action::create("Dump CSS Errors"sv, ActionID::DumpCSSErrors, debug_request("dump-all-css-errors"sv)));
     m_debug_menu->add_action(Action::create("Dump Cookies"sv, ActionID::DumpCookies, [this]() { m_cookie_jar->dump_cookies(); }));
     m_debug_menu->add_action(Action::create("Dump Local Storage"sv, ActionID::DumpLocalStorage, debug_request("dump-local-storage"sv)));
+    m_debug_menu->add_action(Action::create("Dump Network Log"sv, ActionID::DumpNetworkLog, debug_request("dump-network-log"sv)));
     m_debug_menu->add_action(Action::create("Dump GC graph"sv, ActionID::DumpGCGraph, [this]() {
         if (auto view = active_web_view(); view.has_value()) {
             auto gc_graph_path = view->dump_gc_graph();
@@ -24,7 +24,10 @@
 #include <LibWeb/CSS/PreferredMotion.h>
 #include <LibWeb/Clipboard/SystemClipboard.h>
 #include <LibWeb/HTML/ActivateTab.h>
+#include <LibWeb/Worker/WebWorkerClient.h>
 #include <LibWebView/Forward.h>
+#include <LibWebView/IndexedDBStorage.h>
+#include <LibWebView/MemoryPressure.h>
 #include <LibWebView/Options.h>
 #include <LibWebView/Process.h>
 #include <LibWebView/ProcessManager.h>
@@ -56,10 +59,12 @@ public:
 
     static CookieJar& cookie_jar() { return *the().m_cookie_jar; }
     static StorageJar& storage_jar() { return *the().m_storage_jar; }
+    static IndexedDBStorage* indexed_db_storage() { return the().m_indexed_db_storage.ptr(); }
 
     static ProcessManager& process_manager() { return *the().m_process_manager; }
 
     ErrorOr<NonnullRefPtr<WebContentClient>> launch_web_content_process(ViewImplementation&);
+    ErrorOr<NonnullRefPtr<Web::HTML::WebWorkerClient>> launch_web_worker_process(Web::Bindings::AgentType);
 
     virtual Optional<ViewImplementation&> active_web_view() const { return {}; }
     virtual Optional<ViewImplementation&> open_blank_new_tab(Web::HTML::ActivateTab) const { return {}; }
@@ -130,7 +135,10 @@ protected:
 
 private:
     ErrorOr<void> launch_services();
-    void launch_spare_web_content_process();
+    void fill_web_content_process_pool();
+    void fill_web_worker_process_pool();
+    void check_memory_pressure();
+    void discard_least_recently_visible_view();
     ErrorOr<void> launch_request_server();
     ErrorOr<void> launch_image_decoder_server();
     ErrorOr<void> launch_devtools_server();
@@ -182,18 +190,33 @@ private:
     RefPtr<Requests::RequestClient> m_request_server_client;
     RefPtr<ImageDecoderClient::Client> m_image_decoder_client;
 
-    RefPtr<WebContentClient> m_spare_web_content_process;
-    bool m_has_queued_task_to_launch_spare_web_content_process { false };
+    // Spare WebContent processes that have been launched ahead of time, to be handed to new views as they need them.
+    Vector<NonnullRefPtr<WebContentClient>> m_web_content_process_pool;
+    bool m_has_queued_task_to_fill_web_content_process_pool { false };
+
+    // Spare WebWorker processes for dedicated workers. Pages tend to start several workers at once, so the pool is only
+    // filled once the first worker has been requested.
+    Vector<NonnullRefPtr<Web::HTML::WebWorkerClient>> m_web_worker_process_pool;
+    bool m_has_queued_task_to_fill_web_worker_process_pool { false };
+
+    // While our processes use more memory than allowed, each check escalates from dropping caches, to collecting garbage,
+    // to discarding hidden tabs one at a time.
+    RefPtr<Core::Timer> m_memory_pressure_timer;
+    Optional<MemoryPressureLevel> m_memory_pressure_level;
 
     RefPtr<Database::Database> m_database;
     OwnPtr<CookieJar> m_cookie_jar;
     OwnPtr<StorageJar> m_storage_jar;
+    OwnPtr<IndexedDBStorage> m_indexed_db_storage;
 
     OwnPtr<Core::TimeZoneWatcher> m_time_zone_watcher;
 
     OwnPtr<Core::EventLoop> m_event_loop;
     OwnPtr<ProcessManager> m_process_manager;
 
+    // The processes whose traces are merged into the trace of the browser when it exits, if tracing is enabled.
+    Vector<pid_t> m_traced_process_ids;
+
     RefPtr<Action> m_reload_action;
     RefPtr<Action> m_copy_selection_action;
     RefPtr<Action> m_paste_action;
@@ -69,11 +69,16 @@ CookieJar::CookieJar(Optional<PersistedStorage> persisted_storage)
     m_persisted_storage->synchronization_timer = Core::Timer::create_repeating(
         static_cast<int>(DATABASE_SYNCHRONIZATION_TIMER.to_milliseconds()),
         [this]() {
+            auto& database = m_persisted_storage->database;
+            database.begin_transaction();
+
             for (auto const& it : m_transient_storage.take_dirty_cookies())
                 m_persisted_storage->insert_cookie(it.value);
 
             auto now = m_transient_storage.purge_expired_cookies();
-            m_persisted_storage->database.execute_statement(m_persisted_storage->statements.expire_cookie, {}, now);
+            database.execute_statement(m_persisted_storage->statements.expire_cookie, {}, now);
+
+            database.commit_transaction();
         });
     m_persisted_storage->synchronization_timer->start();
 }
@@ -510,7 +515,7 @@ Vector<Web::Cookie::Cookie> CookieJar::get_matching_cookies(URL::URL const& url,
     // 1. Let cookie-list be the set of cookies from the cookie store that meets all of the following requirements:
     Vector<Web::Cookie::Cookie> cookie_list;
 
-    m_transient_storage.for_each_cookie([&](Web::Cookie::Cookie& cookie) {
+    m_transient_storage.for_each_cookie_for_domain(canonicalized_domain, [&](Web::Cookie::Cookie& cookie) {
         // * Either:
         //     The cookie's host-only-flag is true and the canonicalized host of the retrieval's URI is identical to
         //     the cookie's domain.
@@ -583,7 +588,13 @@ Vector<Web::Cookie::Cookie> CookieJar::get_matching_cookies(URL::URL const& url,
 
 void CookieJar::TransientStorage::set_cookies(Cookies cookies)
 {
-    m_cookies = move(cookies);
+    m_cookies.clear();
+    m_size = 0;
+    m_expiry_queue.clear();
+
+    for (auto const& [key, cookie] : cookies)
+        add_cookie(key, cookie);
+
     purge_expired_cookies();
 }
 
@@ -601,9 +612,9 @@ void CookieJar::TransientStorage::set_cookie(CookieStorageKey key, Web::Cookie::
     auto now = UnixDateTime::now();
     // AD-HOC: Skip adding immediately-expiring cookies (i.e., only allow updating to immediately-expiring) to prevent firing deletion events for them
     // Spec issue: https://github.com/whatwg/cookiestore/issues/282
-    if (cookie.expiry_time < now && !m_cookies.contains(key))
+    if (cookie.expiry_time < now && !get_cookie(key).has_value())
         return;
-    m_cookies.set(key, cookie);
+    add_cookie(key, cookie);
     // We skip notifying about updating expired cookies, as they will be notified as being expired immediately after instead
     if (cookie.expiry_time >= now)
         notify_cookies_changed({ cookie });
@@ -612,7 +623,35 @@ void CookieJar::TransientStorage::set_cookie(CookieStorageKey key, Web::Cookie::
 
 Optional<Web::Cookie::Cookie const&> CookieJar::TransientStorage::get_cookie(CookieStorageKey const& key)
 {
-    return m_cookies.get(key);
+    auto cookies = m_cookies.find(key.domain);
+    if (cookies == m_cookies.end())
+        return {};
+
+    return cookies->value.get(key);
+}
+
+void CookieJar::TransientStorage::add_cookie(CookieStorageKey const& key, Web::Cookie::Cookie const& cookie)
+{
+    auto& cookies = m_cookies.ensure(key.domain);
+    if (cookies.set(key, cookie) == HashSetResult::InsertedNewEntry)
+        ++m_size;
+
+    m_expiry_queue.insert(cookie.expiry_time, key);
+
+    // Cookies that are updated often, such as those that track the last visit to a site, would otherwise leave an ever
+    // growing number of stale entries behind.
+    if (m_expiry_queue.size() > (m_size * 2) + 64)
+        rebuild_expiry_queue();
+}
+
+void CookieJar::TransientStorage::rebuild_expiry_queue()
+{
+    m_expiry_queue.clear();
+
+    for (auto const& cookies : m_cookies) {
+        for (auto const& [key, cookie] : cookies.value)
+            m_expiry_queue.insert(cookie.expiry_time, key);
+    }
 }
 
 UnixDateTime CookieJar::TransientStorage::purge_expired_cookies(Optional<AK::Duration> offset)
@@ -625,27 +664,53 @@ UnixDateTime CookieJar::TransientStorage::purge_expired_cookies(Optional<AK::Dur
             cookie.value.expiry_time -= *offset;
     }
 
-    auto is_expired = [&](auto const&, auto const& cookie) { return cookie.expiry_time < now; };
-    auto removed_entries = m_cookies.take_all_matching(is_expired);
-    if (!removed_entries.is_empty()) {
-        Vector<Web::Cookie::Cookie> removed_cookies;
-        removed_cookies.ensure_capacity(removed_entries.size());
-        for (auto const& entry : removed_entries)
-            removed_cookies.unchecked_append(move(entry.value));
-        notify_cookies_changed(move(removed_cookies));
+    Vector<Web::Cookie::Cookie> removed_cookies;
+
+    while (!m_expiry_queue.is_empty() && m_expiry_queue.peek_min_key() < now) {
+        auto key = m_expiry_queue.pop_min();
+
+        auto cookies = m_cookies.find(key.domain);
+        if (cookies == m_cookies.end())
+            continue;
+
+        // The cookie may have been removed or updated to expire later since this entry was queued.
+        auto cookie = cookies->value.find(key);
+        if (cookie == cookies->value.end() || cookie->value.expiry_time >= now)
+            continue;
+
+        removed_cookies.append(move(cookie->value));
+        cookies->value.remove(cookie);
+        --m_size;
+
+        if (cookies->value.is_empty())
+            m_cookies.remove(cookies);
     }
 
+    if (!removed_cookies.is_empty())
+        notify_cookies_changed(move(removed_cookies));
+
     return now;
 }
 
 void CookieJar::TransientStorage::expire_and_purge_all_cookies()
 {
-    for (auto& [key, value] : m_cookies) {
-        value.expiry_time = UnixDateTime::earliest();
-        set_cookie(key, value);
+    Vector<Web::Cookie::Cookie> removed_cookies;
+    removed_cookies.ensure_capacity(m_size);
+
+    for (auto& cookies : m_cookies) {
+        for (auto& [key, cookie] : cookies.value) {
+            cookie.expiry_time = UnixDateTime::earliest();
+            m_dirty_cookies.set(key, cookie);
+            removed_cookies.unchecked_append(move(cookie));
+        }
     }
 
-    purge_expired_cookies();
+    m_cookies.clear();
+    m_size = 0;
+    m_expiry_queue.clear();
+
+    if (!removed_cookies.is_empty())
+        notify_cookies_changed(move(removed_cookies));
 }
 
 void CookieJar::PersistedStorage::insert_cookie(Web::Cookie::Cookie const& cookie)
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/BinaryHeap.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
 #include <AK/Optional.h>
@@ -44,7 +45,7 @@ class WEBVIEW_API CookieJar {
         void set_cookie(CookieStorageKey, Web::Cookie::Cookie);
         Optional<Web::Cookie::Cookie const&> get_cookie(CookieStorageKey const&);
 
-        size_t size() const { return m_cookies.size(); }
+        size_t size() const { return m_size; }
 
         UnixDateTime purge_expired_cookies(Optional<AK::Duration> offset = {});
         void expire_and_purge_all_cookies();
@@ -53,23 +54,66 @@ class WEBVIEW_API CookieJar {
 
         template<typename Callback>
         void for_each_cookie(Callback callback)
+        {
+            for (auto& it : m_cookies) {
+                if (for_each_cookie_in(it.value, callback) == IterationDecision::Break)
+                    return;
+            }
+        }
+
+        // Visits the cookies whose domain is either the given domain or one of its parent domains, which are the only
+        // cookies that may match a request to that domain.
+        template<typename Callback>
+        void for_each_cookie_for_domain(StringView canonicalized_domain, Callback callback)
+        {
+            for (auto domain = canonicalized_domain;;) {
+                auto it = m_cookies.find(domain.hash(), [&](auto& entry) { return entry.key == domain; });
+
+                if (it != m_cookies.end()) {
+                    if (for_each_cookie_in(it->value, callback) == IterationDecision::Break)
+                        return;
+                }
+
+                auto index = domain.find('.');
+                if (!index.has_value())
+                    return;
+
+                domain = domain.substring_view(*index + 1);
+            }
+        }
+
+    private:
+        template<typename Callback>
+        static IterationDecision for_each_cookie_in(Cookies& cookies, Callback& callback)
         {
             using ReturnType = InvokeResult<Callback, Web::Cookie::Cookie&>;
 
-            for (auto& it : m_cookies) {
+            for (auto& it : cookies) {
                 if constexpr (IsSame<ReturnType, IterationDecision>) {
                     if (callback(it.value) == IterationDecision::Break)
-                        return;
+                        return IterationDecision::Break;
                 } else {
                     static_assert(IsSame<ReturnType, void>);
                     callback(it.value);
                 }
             }
+
+            return IterationDecision::Continue;
         }
 
-    private:
-        Cookies m_cookies;
+        void add_cookie(CookieStorageKey const&, Web::Cookie::Cookie const&);
+        void rebuild_expiry_queue();
+
+        // Cookies are grouped by their domain, so that retrieving the cookies for a request does not need to visit the
+        // cookies of unrelated domains.
+        HashMap<String, Cookies> m_cookies;
+        size_t m_size { 0 };
+
         Cookies m_dirty_cookies;
+
+        // The cookies ordered by their expiry time. Updating a cookie leaves its previous entry behind, which is skipped
+        // once it reaches the front of the queue.
+        BinaryHeap<UnixDateTime, CookieStorageKey, 0> m_expiry_queue;
     };
 
     struct WEBVIEW_API PersistedStorage {
@@ -231,8 +231,8 @@ bool EventLoopImplementationQt::was_exit_requested() const
 
 void EventLoopImplementationQt::post_event(Core::EventReceiver& receiver, NonnullOwnPtr<Core::Event>&& event)
 {
-    m_thread_event_queue.post_event(receiver, move(event));
-    if (&m_thread_event_queue != &Core::ThreadEventQueue::current())
+    auto should_wake = m_thread_event_queue.post_event(receiver, move(event));
+    if (should_wake == Core::ThreadEventQueue::ShouldWake::Yes && &m_thread_event_queue != &Core::ThreadEventQueue::current())
         wake();
 }
 
@@ -16,6 +16,8 @@ class Action;
 class Application;
 class Autocomplete;
 class CookieJar;
+class HeadlessBatch;
+class IndexedDBStorage;
 class Menu;
 class OutOfProcessWebView;
 class ProcessManager;
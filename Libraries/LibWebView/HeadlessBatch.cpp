@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/AllOf.h>
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
+#include <LibCore/Directory.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/Promise.h>
+#include <LibCore/Timer.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/ImageFormats/PNGWriter.h>
+#include <LibGfx/ShareableBitmap.h>
+#include <LibWebView/HeadlessBatch.h>
+#include <LibWebView/HeadlessWebView.h>
+
+namespace WebView {
+
+// Pages that don't finish loading and capturing within this time are counted as failed, so that a single page that
+// never finishes loading does not hold up the rest of the batch.
+static constexpr int page_timeout_ms = 30'000;
+
+class HeadlessBatchWebView final : public HeadlessWebView {
+public:
+    static NonnullOwnPtr<HeadlessBatchWebView> create(Core::AnonymousBuffer theme, Web::DevicePixelSize viewport_size)
+    {
+        auto view = adopt_own(*new HeadlessBatchWebView(move(theme), viewport_size));
+        view->initialize_client(CreateNewClient::Yes);
+
+        return view;
+    }
+
+    // Unlike ViewImplementation::take_screenshot, this hands us the bitmap instead of saving it to the downloads directory.
+    NonnullRefPtr<Core::Promise<RefPtr<Gfx::Bitmap const>>> take_screenshot()
+    {
+        // A screenshot of a page that timed out may still be pending. It is of no use anymore, so drop it in favor of this
+        // one.
+        if (auto pending_screenshot = move(m_pending_screenshot))
+            pending_screenshot->reject(Error::from_string_literal("Screenshot was superseded"));
+
+        m_pending_screenshot = Core::Promise<RefPtr<Gfx::Bitmap const>>::construct();
+        client().async_take_document_screenshot(m_client_state.page_index);
+
+        return *m_pending_screenshot;
+    }
+
+private:
+    HeadlessBatchWebView(Core::AnonymousBuffer theme, Web::DevicePixelSize viewport_size)
+        : HeadlessWebView(move(theme), viewport_size)
+    {
+    }
+
+    virtual void did_receive_screenshot(Badge<WebContentClient>, Gfx::ShareableBitmap const& screenshot) override
+    {
+        if (auto pending_screenshot = move(m_pending_screenshot))
+            pending_screenshot->resolve(screenshot.bitmap());
+    }
+
+    RefPtr<Core::Promise<RefPtr<Gfx::Bitmap const>>> m_pending_screenshot;
+};
+
+struct HeadlessBatch::Worker {
+    NonnullOwnPtr<HeadlessBatchWebView> view;
+    NonnullRefPtr<Core::Timer> timeout_timer;
+
+    Optional<size_t> page_index;
+    URL::URL url;
+    MonotonicTime start_time { MonotonicTime::now() };
+    bool is_capturing { false };
+};
+
+ErrorOr<NonnullOwnPtr<HeadlessBatch>> HeadlessBatch::create(Core::AnonymousBuffer theme, Web::DevicePixelSize viewport_size, HeadlessMode mode, Vector<URL::URL> urls, size_t concurrency, ByteString output_directory)
+{
+    VERIFY(mode != HeadlessMode::Test);
+
+    if (concurrency == 0)
+        return Error::from_string_literal("Headless batch concurrency must be at least 1");
+
+    TRY(Core::Directory::create(output_directory, Core::Directory::CreateDirectories::Yes));
+
+    auto batch = adopt_own(*new HeadlessBatch(mode, move(urls), move(output_directory)));
+
+    // There is no use in spawning more processes than there are pages to load.
+    concurrency = min(concurrency, batch->m_urls.size());
+    TRY(batch->m_workers.try_ensure_capacity(concurrency));
+
+    for (size_t i = 0; i < concurrency; ++i) {
+        auto view = HeadlessBatchWebView::create(theme, viewport_size);
+
+        // Nobody looks at the pages of a text or layout dump, so let WebContent skip their rendering updates and animation
+        // frames entirely. The dumps update layout on demand. Screenshots are painted by a rendering update, so their views
+        // have to stay visible.
+        if (mode != HeadlessMode::Screenshot)
+            view->set_system_visibility_state(Web::HTML::VisibilityState::Hidden);
+
+        auto worker = adopt_own(*new Worker { move(view), Core::Timer::create_single_shot(page_timeout_ms, nullptr) });
+        auto& worker_ref = *worker;
+
+        worker->view->on_url_change = [&worker_ref](URL::URL const& url) {
+            if (worker_ref.page_index.has_value())
+                worker_ref.url = url;
+        };
+        worker->view->on_load_finish = [batch = batch.ptr(), &worker_ref](URL::URL const& url) {
+            if (!worker_ref.page_index.has_value() || worker_ref.is_capturing)
+                return;
+            if (!worker_ref.url.equals(url, URL::ExcludeFragment::Yes))
+                return;
+            batch->capture_page(worker_ref);
+        };
+        worker->timeout_timer->on_timeout = [batch = batch.ptr(), &worker_ref]() {
+            batch->finish_page(worker_ref, Error::from_string_literal("Timed out"));
+        };
+
+        batch->m_workers.unchecked_append(move(worker));
+    }
+
+    return batch;
+}
+
+HeadlessBatch::HeadlessBatch(HeadlessMode mode, Vector<URL::URL> urls, ByteString output_directory)
+    : m_mode(mode)
+    , m_urls(move(urls))
+    , m_output_directory(move(output_directory))
+{
+}
+
+HeadlessBatch::~HeadlessBatch() = default;
+
+void HeadlessBatch::start()
+{
+    outln("Loading {} pages in {} WebContent processes", m_urls.size(), m_workers.size());
+
+    m_start_time = MonotonicTime::now();
+    m_page_durations.ensure_capacity(m_urls.size());
+
+    for (auto& worker : m_workers)
+        load_next_page(*worker);
+}
+
+void HeadlessBatch::load_next_page(Worker& worker)
+{
+    if (m_next_page_index == m_urls.size()) {
+        worker.page_index.clear();
+
+        if (all_of(m_workers, [](auto const& worker) { return !worker->page_index.has_value(); }))
+            finish();
+        return;
+    }
+
+    auto page_index = m_next_page_index++;
+
+    worker.page_index = page_index;
+    worker.url = m_urls[page_index];
+    worker.start_time = MonotonicTime::now();
+    worker.is_capturing = false;
+
+    worker.timeout_timer->restart();
+    worker.view->load(worker.url);
+}
+
+void HeadlessBatch::capture_page(Worker& worker)
+{
+    auto page_index = *worker.page_index;
+    worker.is_capturing = true;
+
+    // Responses for a page that has since timed out are ignored, the worker has moved on to another page by then.
+    auto is_current_page = [&worker, page_index]() {
+        return worker.page_index == page_index && worker.is_capturing;
+    };
+
+    auto on_rejected = [this, &worker, is_current_page](Error& error) {
+        if (is_current_page())
+            finish_page(worker, move(error));
+    };
+
+    switch (m_mode) {
+    case HeadlessMode::Screenshot:
+        worker.view->take_screenshot()
+            ->when_resolved([this, &worker, page_index, is_current_page](RefPtr<Gfx::Bitmap const> const& bitmap) {
+                if (!is_current_page())
+                    return;
+                if (!bitmap) {
+                    finish_page(worker, Error::from_string_literal("Failed to take a screenshot"));
+                    return;
+                }
+                finish_page(worker, write_screenshot(page_index, *bitmap));
+            })
+            .when_rejected(move(on_rejected));
+        break;
+
+    case HeadlessMode::LayoutTree:
+    case HeadlessMode::Text: {
+        auto type = m_mode == HeadlessMode::Text ? PageInfoType::Text : PageInfoType::LayoutTree | PageInfoType::PaintTree;
+
+        worker.view->request_internal_page_info(type)
+            ->when_resolved([this, &worker, page_index, is_current_page](String const& text) {
+                if (!is_current_page())
+                    return;
+                finish_page(worker, write_dump(page_index, text));
+            })
+            .when_rejected(move(on_rejected));
+        break;
+    }
+
+    case HeadlessMode::Test:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+void HeadlessBatch::finish_page(Worker& worker, ErrorOr<void> result)
+{
+    auto page_index = *worker.page_index;
+    auto duration = MonotonicTime::now() - worker.start_time;
+
+    worker.timeout_timer->stop();
+    worker.is_capturing = false;
+
+    if (result.is_error()) {
+        ++m_failure_count;
+        warnln("[{}/{}] {} failed after {}ms: {}", page_index + 1, m_urls.size(), m_urls[page_index], duration.to_milliseconds(), result.error());
+    } else {
+        m_page_durations.append(duration);
+        outln("[{}/{}] {} ({}ms)", page_index + 1, m_urls.size(), m_urls[page_index], duration.to_milliseconds());
+    }
+
+    // Don't start the next navigation from within the callbacks of the view that is about to navigate.
+    Core::deferred_invoke([this, &worker]() {
+        load_next_page(worker);
+    });
+}
+
+void HeadlessBatch::finish()
+{
+    auto elapsed = MonotonicTime::now() - m_start_time;
+    auto pages_per_second = static_cast<double>(m_page_durations.size()) * 1000.0 / static_cast<double>(max<i64>(elapsed.to_milliseconds(), 1));
+
+    outln("Rendered {} of {} pages in {}ms ({:.2} pages/s)", m_page_durations.size(), m_urls.size(), elapsed.to_milliseconds(), pages_per_second);
+
+    if (!m_page_durations.is_empty()) {
+        quick_sort(m_page_durations);
+        outln("Per-page timings: p50 {}ms, p99 {}ms, max {}ms",
+            page_duration_percentile(50).to_milliseconds(),
+            page_duration_percentile(99).to_milliseconds(),
+            m_page_durations.last().to_milliseconds());
+    }
+
+    if (on_finish)
+        on_finish(m_failure_count == 0 ? 0 : 1);
+}
+
+ErrorOr<void> HeadlessBatch::write_screenshot(size_t page_index, Gfx::Bitmap const& bitmap) const
+{
+    auto path = LexicalPath::join(m_output_directory, ByteString::formatted("{:05}.png", page_index));
+
+    auto encoded = TRY(Gfx::PNGWriter::encode(bitmap, { .compression_level = Compress::GenericZlibCompressionLevel::Fastest }));
+
+    auto file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
+    TRY(file->write_until_depleted(encoded));
+
+    return {};
+}
+
+ErrorOr<void> HeadlessBatch::write_dump(size_t page_index, StringView text) const
+{
+    auto path = LexicalPath::join(m_output_directory, ByteString::formatted("{:05}.txt", page_index));
+
+    auto file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
+    TRY(file->write_until_depleted(text.bytes()));
+
+    return {};
+}
+
+// Uses the nearest-rank method, on the sorted durations of the pages that were rendered successfully.
+AK::Duration HeadlessBatch::page_duration_percentile(size_t percentile) const
+{
+    VERIFY(!m_page_durations.is_empty());
+
+    auto rank = (m_page_durations.size() * percentile + 99) / 100;
+    return m_page_durations[max<size_t>(rank, 1) - 1];
+}
+
+}
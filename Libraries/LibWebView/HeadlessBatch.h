@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Function.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/AnonymousBuffer.h>
+#include <LibCore/Forward.h>
+#include <LibGfx/Forward.h>
+#include <LibURL/URL.h>
+#include <LibWeb/PixelUnits.h>
+#include <LibWebView/Forward.h>
+#include <LibWebView/Options.h>
+
+namespace WebView {
+
+// Loads a list of URLs in a fixed number of headless views, and writes a screenshot or dump of every page to an output
+// directory. Each view keeps its WebContent process from one page to the next, so the cost of spawning and initializing
+// a process is only paid once per view rather than once per page.
+class WEBVIEW_API HeadlessBatch {
+    AK_MAKE_NONCOPYABLE(HeadlessBatch);
+    AK_MAKE_NONMOVABLE(HeadlessBatch);
+
+public:
+    static ErrorOr<NonnullOwnPtr<HeadlessBatch>> create(Core::AnonymousBuffer theme, Web::DevicePixelSize viewport_size, HeadlessMode, Vector<URL::URL> urls, size_t concurrency, ByteString output_directory);
+    ~HeadlessBatch();
+
+    void start();
+
+    // Invoked once every page has been handled, with the exit code of the batch.
+    Function<void(int)> on_finish;
+
+private:
+    struct Worker;
+
+    HeadlessBatch(HeadlessMode, Vector<URL::URL> urls, ByteString output_directory);
+
+    void load_next_page(Worker&);
+    void capture_page(Worker&);
+    void finish_page(Worker&, ErrorOr<void>);
+    void finish();
+
+    ErrorOr<void> write_screenshot(size_t page_index, Gfx::Bitmap const&) const;
+    ErrorOr<void> write_dump(size_t page_index, StringView) const;
+
+    AK::Duration page_duration_percentile(size_t percentile) const;
+
+    HeadlessMode m_mode;
+    Vector<URL::URL> m_urls;
+    ByteString m_output_directory;
+
+    Vector<NonnullOwnPtr<Worker>> m_workers;
+    size_t m_next_page_index { 0 };
+
+    MonotonicTime m_start_time;
+    Vector<AK::Duration> m_page_durations;
+    size_t m_failure_count { 0 };
+};
+
+}
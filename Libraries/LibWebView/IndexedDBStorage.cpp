@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <LibDatabase/Database.h>
+#include <LibWebView/IndexedDBStorage.h>
+
+namespace WebView {
+
+using namespace Web::IndexedDB;
+
+ErrorOr<NonnullOwnPtr<IndexedDBStorage>> IndexedDBStorage::create(Database::Database& database)
+{
+    Statements statements {};
+
+    auto create_databases_table = TRY(database.prepare_statement(R"#(
+        CREATE TABLE IF NOT EXISTS IndexedDBDatabases (
+            storage_key TEXT,
+            name TEXT,
+            version INTEGER,
+            schema TEXT,
+            PRIMARY KEY(storage_key, name)
+        );)#"sv));
+    database.execute_statement(create_databases_table, {});
+
+    auto create_object_store_records_table = TRY(database.prepare_statement(R"#(
+        CREATE TABLE IF NOT EXISTS IndexedDBObjectStoreRecords (
+            storage_key TEXT,
+            database TEXT,
+            object_store INTEGER,
+            key BLOB,
+            value BLOB,
+            PRIMARY KEY(storage_key, database, object_store, key)
+        ) WITHOUT ROWID;)#"sv));
+    database.execute_statement(create_object_store_records_table, {});
+
+    auto create_index_records_table = TRY(database.prepare_statement(R"#(
+        CREATE TABLE IF NOT EXISTS IndexedDBIndexRecords (
+            storage_key TEXT,
+            database TEXT,
+            idx INTEGER,
+            key BLOB,
+            value BLOB,
+            PRIMARY KEY(storage_key, database, idx, key, value)
+        ) WITHOUT ROWID;)#"sv));
+    database.execute_statement(create_index_records_table, {});
+
+    statements.get_database = TRY(database.prepare_statement("SELECT version, schema FROM IndexedDBDatabases WHERE storage_key = ? AND name = ?;"sv));
+    statements.get_database_versions = TRY(database.prepare_statement("SELECT name, version FROM IndexedDBDatabases WHERE storage_key = ?;"sv));
+    statements.set_database = TRY(database.prepare_statement("INSERT OR REPLACE INTO IndexedDBDatabases VALUES (?, ?, ?, ?);"sv));
+    statements.delete_database = TRY(database.prepare_statement("DELETE FROM IndexedDBDatabases WHERE storage_key = ? AND name = ?;"sv));
+
+    statements.get_object_store_records = TRY(database.prepare_statement("SELECT object_store, key, value FROM IndexedDBObjectStoreRecords WHERE storage_key = ? AND database = ? ORDER BY object_store, key;"sv));
+    statements.set_object_store_record = TRY(database.prepare_statement("INSERT OR REPLACE INTO IndexedDBObjectStoreRecords VALUES (?, ?, ?, ?, ?);"sv));
+    statements.delete_object_store_record = TRY(database.prepare_statement("DELETE FROM IndexedDBObjectStoreRecords WHERE storage_key = ? AND database = ? AND object_store = ? AND key = ?;"sv));
+    statements.clear_object_store = TRY(database.prepare_statement("DELETE FROM IndexedDBObjectStoreRecords WHERE storage_key = ? AND database = ? AND object_store = ?;"sv));
+    statements.delete_object_store_records_for_database = TRY(database.prepare_statement("DELETE FROM IndexedDBObjectStoreRecords WHERE storage_key = ? AND database = ?;"sv));
+
+    statements.get_index_records = TRY(database.prepare_statement("SELECT idx, key, value FROM IndexedDBIndexRecords WHERE storage_key = ? AND database = ? ORDER BY idx, key, value;"sv));
+    statements.set_index_record = TRY(database.prepare_statement("INSERT OR REPLACE INTO IndexedDBIndexRecords VALUES (?, ?, ?, ?, ?);"sv));
+    statements.delete_index_record = TRY(database.prepare_statement("DELETE FROM IndexedDBIndexRecords WHERE storage_key = ? AND database = ? AND idx = ? AND key = ? AND value = ?;"sv));
+    statements.clear_index = TRY(database.prepare_statement("DELETE FROM IndexedDBIndexRecords WHERE storage_key = ? AND database = ? AND idx = ?;"sv));
+    statements.delete_index_records_for_database = TRY(database.prepare_statement("DELETE FROM IndexedDBIndexRecords WHERE storage_key = ? AND database = ?;"sv));
+
+    return adopt_own(*new IndexedDBStorage { database, statements });
+}
+
+IndexedDBStorage::IndexedDBStorage(Database::Database& database, Statements statements)
+    : m_database(database)
+    , m_statements(statements)
+{
+}
+
+IndexedDBStorage::~IndexedDBStorage() = default;
+
+static JsonValue serialize_key_path(KeyPath const& key_path)
+{
+    return key_path.visit(
+        [](String const& path) -> JsonValue { return path; },
+        [](Vector<String> const& paths) -> JsonValue {
+            JsonArray array;
+            for (auto const& path : paths)
+                array.must_append(path);
+            return array;
+        });
+}
+
+static Optional<KeyPath> parse_key_path(JsonValue const& value)
+{
+    if (value.is_string())
+        return KeyPath { value.as_string() };
+
+    if (value.is_array()) {
+        Vector<String> paths;
+        for (auto const& path : value.as_array().values()) {
+            if (!path.is_string())
+                return {};
+            paths.append(path.as_string());
+        }
+        return KeyPath { move(paths) };
+    }
+
+    return {};
+}
+
+static String serialize_schema(PersistedDatabaseSchema const& schema)
+{
+    JsonArray object_stores;
+
+    for (auto const& object_store : schema.object_stores) {
+        JsonArray indexes;
+
+        for (auto const& index : object_store.indexes) {
+            JsonObject serialized_index;
+            serialized_index.set("id"sv, index.id);
+            serialized_index.set("name"sv, index.name);
+            serialized_index.set("key_path"sv, serialize_key_path(index.key_path));
+            serialized_index.set("unique"sv, index.unique);
+            serialized_index.set("multi_entry"sv, index.multi_entry);
+            indexes.must_append(move(serialized_index));
+        }
+
+        JsonObject serialized_object_store;
+        serialized_object_store.set("id"sv, object_store.id);
+        serialized_object_store.set("name"sv, object_store.name);
+        if (object_store.key_path.has_value())
+            serialized_object_store.set("key_path"sv, serialize_key_path(*object_store.key_path));
+        if (object_store.key_generator_current_number.has_value())
+            serialized_object_store.set("key_generator_current_number"sv, *object_store.key_generator_current_number);
+        serialized_object_store.set("indexes"sv, move(indexes));
+        object_stores.must_append(move(serialized_object_store));
+    }
+
+    JsonObject serialized_schema;
+    serialized_schema.set("object_stores"sv, move(object_stores));
+    return serialized_schema.serialized();
+}
+
+static Optional<Vector<PersistedObjectStore>> parse_object_stores(StringView serialized_schema)
+{
+    auto json = JsonValue::from_string(serialized_schema);
+    if (json.is_error() || !json.value().is_object())
+        return {};
+
+    auto object_stores = json.value().as_object().get_array("object_stores"sv);
+    if (!object_stores.has_value())
+        return {};
+
+    Vector<PersistedObjectStore> result;
+
+    for (auto const& value : object_stores->values()) {
+        if (!value.is_object())
+            return {};
+        auto const& serialized_object_store = value.as_object();
+
+        auto id = serialized_object_store.get_u64("id"sv);
+        auto name = serialized_object_store.get_string("name"sv);
+        auto indexes = serialized_object_store.get_array("indexes"sv);
+        if (!id.has_value() || !name.has_value() || !indexes.has_value())
+            return {};
+
+        PersistedObjectStore object_store { .id = *id, .name = *name };
+
+        if (auto key_path = serialized_object_store.get("key_path"sv); key_path.has_value()) {
+            object_store.key_path = parse_key_path(*key_path);
+            if (!object_store.key_path.has_value())
+                return {};
+        }
+
+        object_store.key_generator_current_number = serialized_object_store.get_u64("key_generator_current_number"sv);
+
+        for (auto const& index_value : indexes->values()) {
+            if (!index_value.is_object())
+                return {};
+            auto const& serialized_index = index_value.as_object();
+
+            auto index_id = serialized_index.get_u64("id"sv);
+            auto index_name = serialized_index.get_string("name"sv);
+            auto key_path = serialized_index.get("key_path"sv);
+            if (!index_id.has_value() || !index_name.has_value() || !key_path.has_value())
+                return {};
+
+            auto parsed_key_path = parse_key_path(*key_path);
+            if (!parsed_key_path.has_value())
+                return {};
+
+            object_store.indexes.append({
+                .id = *index_id,
+                .name = *index_name,
+                .key_path = parsed_key_path.release_value(),
+                .unique = serialized_index.get_bool("unique"sv).value_or(false),
+                .multi_entry = serialized_index.get_bool("multi_entry"sv).value_or(false),
+            });
+        }
+
+        result.append(move(object_store));
+    }
+
+    return result;
+}
+
+Optional<PersistedDatabaseSchema> IndexedDBStorage::load_schema(String const& storage_key, String const& name)
+{
+    Optional<PersistedDatabaseSchema> schema;
+
+    m_database.execute_statement(
+        m_statements.get_database,
+        [&](auto statement_id) {
+            auto version = m_database.result_column<u64>(statement_id, 0);
+            auto serialized_schema = m_database.result_column<String>(statement_id, 1);
+
+            auto object_stores = parse_object_stores(serialized_schema);
+            if (!object_stores.has_value()) {
+                dbgln("IndexedDBStorage: Ignoring corrupt schema of database '{}' for {}", name, storage_key);
+                return;
+            }
+
+            schema = PersistedDatabaseSchema { .version = version, .object_stores = object_stores.release_value() };
+        },
+        storage_key,
+        name);
+
+    return schema;
+}
+
+Optional<PersistedDatabase> IndexedDBStorage::load_database(String const& storage_key, String const& name)
+{
+    auto schema = load_schema(storage_key, name);
+    if (!schema.has_value())
+        return {};
+
+    PersistedDatabase database { .schema = schema.release_value() };
+
+    m_database.execute_statement(
+        m_statements.get_object_store_records,
+        [&](auto statement_id) {
+            database.object_store_records.append({
+                .object_store_id = m_database.result_column<u64>(statement_id, 0),
+                .key = m_database.result_column<ByteBuffer>(statement_id, 1),
+                .value = m_database.result_column<ByteBuffer>(statement_id, 2),
+            });
+        },
+        storage_key,
+        name);
+
+    m_database.execute_statement(
+        m_statements.get_index_records,
+        [&](auto statement_id) {
+            database.index_records.append({
+                .index_id = m_database.result_column<u64>(statement_id, 0),
+                .key = m_database.result_column<ByteBuffer>(statement_id, 1),
+                .value = m_database.result_column<ByteBuffer>(statement_id, 2),
+            });
+        },
+        storage_key,
+        name);
+
+    return database;
+}
+
+HashMap<String, u64> IndexedDBStorage::database_versions(String const& storage_key)
+{
+    HashMap<String, u64> versions;
+
+    m_database.execute_statement(
+        m_statements.get_database_versions,
+        [&](auto statement_id) {
+            versions.set(m_database.result_column<String>(statement_id, 0), m_database.result_column<u64>(statement_id, 1));
+        },
+        storage_key);
+
+    return versions;
+}
+
+void IndexedDBStorage::commit_changes(String const& storage_key, String const& name, PersistedDatabaseChanges const& changes)
+{
+    // All changes of a transaction are written in a single SQL transaction, so that they reach the disk all at once.
+    m_database.begin_transaction();
+
+    // Object stores and indexes that were deleted by the transaction are no longer part of the schema, so their records
+    // have to be removed as well.
+    if (auto old_schema = load_schema(storage_key, name); old_schema.has_value()) {
+        for (auto const& old_object_store : old_schema->object_stores) {
+            auto new_object_store = changes.schema.object_stores.find_if([&](auto const& object_store) { return object_store.id == old_object_store.id; });
+            if (new_object_store.is_end())
+                m_database.execute_statement(m_statements.clear_object_store, {}, storage_key, name, old_object_store.id);
+
+            for (auto const& old_index : old_object_store.indexes) {
+                auto is_index_alive = !new_object_store.is_end() && new_object_store->indexes.find_if([&](auto const& index) { return index.id == old_index.id; }) != new_object_store->indexes.end();
+                if (!is_index_alive)
+                    m_database.execute_statement(m_statements.clear_index, {}, storage_key, name, old_index.id);
+            }
+        }
+    }
+
+    m_database.execute_statement(m_statements.set_database, {}, storage_key, name, changes.schema.version, serialize_schema(changes.schema));
+
+    for (auto object_store_id : changes.cleared_object_stores)
+        m_database.execute_statement(m_statements.clear_object_store, {}, storage_key, name, object_store_id);
+    for (auto index_id : changes.cleared_indexes)
+        m_database.execute_statement(m_statements.clear_index, {}, storage_key, name, index_id);
+
+    for (auto const& record : changes.removed_object_store_records)
+        m_database.execute_statement(m_statements.delete_object_store_record, {}, storage_key, name, record.object_store_id, record.key);
+    for (auto const& record : changes.stored_object_store_records)
+        m_database.execute_statement(m_statements.set_object_store_record, {}, storage_key, name, record.object_store_id, record.key, record.value);
+
+    for (auto const& record : changes.removed_index_records)
+        m_database.execute_statement(m_statements.delete_index_record, {}, storage_key, name, record.index_id, record.key, record.value);
+    for (auto const& record : changes.stored_index_records)
+        m_database.execute_statement(m_statements.set_index_record, {}, storage_key, name, record.index_id, record.key, record.value);
+
+    m_database.commit_transaction();
+}
+
+void IndexedDBStorage::delete_database(String const& storage_key, String const& name)
+{
+    m_database.begin_transaction();
+    m_database.execute_statement(m_statements.delete_object_store_records_for_database, {}, storage_key, name);
+    m_database.execute_statement(m_statements.delete_index_records_for_database, {}, storage_key, name);
+    m_database.execute_statement(m_statements.delete_database, {}, storage_key, name);
+    m_database.commit_transaction();
+}
+
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <LibDatabase/Forward.h>
+#include <LibWeb/IndexedDB/Internal/PersistedDatabase.h>
+#include <LibWebView/Forward.h>
+
+namespace WebView {
+
+// Stores the IndexedDB databases of all origins on disk. Keys arrive already encoded such that comparing them bytewise
+// sorts them in the order of the IndexedDB key comparison, so SQLite's indices keep records in the order that cursors
+// iterate them in.
+class WEBVIEW_API IndexedDBStorage {
+    AK_MAKE_NONCOPYABLE(IndexedDBStorage);
+    AK_MAKE_NONMOVABLE(IndexedDBStorage);
+
+public:
+    static ErrorOr<NonnullOwnPtr<IndexedDBStorage>> create(Database::Database&);
+    ~IndexedDBStorage();
+
+    Optional<Web::IndexedDB::PersistedDatabase> load_database(String const& storage_key, String const& name);
+    HashMap<String, u64> database_versions(String const& storage_key);
+
+    void commit_changes(String const& storage_key, String const& name, Web::IndexedDB::PersistedDatabaseChanges const&);
+    void delete_database(String const& storage_key, String const& name);
+
+private:
+    struct Statements {
+        Database::StatementID get_database { 0 };
+        Database::StatementID get_database_versions { 0 };
+        Database::StatementID set_database { 0 };
+        Database::StatementID delete_database { 0 };
+
+        Database::StatementID get_object_store_records { 0 };
+        Database::StatementID set_object_store_record { 0 };
+        Database::StatementID delete_object_store_record { 0 };
+        Database::StatementID clear_object_store { 0 };
+        Database::StatementID delete_object_store_records_for_database { 0 };
+
+        Database::StatementID get_index_records { 0 };
+        Database::StatementID set_index_record { 0 };
+        Database::StatementID delete_index_record { 0 };
+        Database::StatementID clear_index { 0 };
+        Database::StatementID delete_index_records_for_database { 0 };
+    };
+
+    IndexedDBStorage(Database::Database&, Statements);
+
+    Optional<Web::IndexedDB::PersistedDatabaseSchema> load_schema(String const& storage_key, String const& name);
+
+    Database::Database& m_database;
+    Statements m_statements;
+};
+
+}
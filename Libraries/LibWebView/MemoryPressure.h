@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace WebView {
+
+// How hard a WebContent process should try to release memory, from least to most.
+enum class MemoryPressureLevel : u8 {
+    // Drop caches that are cheap to rebuild.
+    Moderate,
+    // Also collect garbage.
+    Critical,
+};
+
+}
@@ -78,6 +78,7 @@ enum class ActionID {
     DumpCSSErrors,
     DumpCookies,
     DumpLocalStorage,
+    DumpNetworkLog,
     DumpGCGraph,
     ShowLineBoxBorders,
     CollectGarbage,
@@ -77,6 +77,10 @@ struct BrowserOptions {
     Vector<URL::URL> urls;
     Vector<ByteString> raw_urls;
     Optional<HeadlessMode> headless_mode;
+    // Set when more than one page is loaded in headless mode. Screenshots and dumps are then written to this directory
+    // instead of being printed.
+    Optional<ByteString> headless_output_directory;
+    size_t headless_concurrency { 1 };
     int window_width { 800 };
     int window_height { 600 };
     NewWindow new_window { NewWindow::No };
@@ -90,6 +94,10 @@ struct BrowserOptions {
     Optional<DNSSettings> dns_settings {};
     Optional<u16> devtools_port;
     EnableContentFilter enable_content_filter { EnableContentFilter::Yes };
+    size_t web_content_process_pool_size { 1 };
+    size_t web_worker_process_pool_size { 1 };
+    // The combined memory usage of all of our processes past which they are asked to release memory. Zero disables this.
+    u64 memory_pressure_threshold { 0 };
 };
 
 enum class EnableHTTPDiskCache {
@@ -100,6 +108,7 @@ enum class EnableHTTPDiskCache {
 struct RequestServerOptions {
     Vector<ByteString> certificates;
     EnableHTTPDiskCache enable_http_disk_cache { EnableHTTPDiskCache::No };
+    Optional<u64> http_disk_cache_size_limit;
 };
 
 enum class IsLayoutTestMode {
@@ -122,6 +131,11 @@ enum class EnableHTTPCache {
     Yes,
 };
 
+enum class PersistIndexedDB {
+    No,
+    Yes,
+};
+
 enum class DisableSiteIsolation {
     No,
     Yes,
@@ -162,6 +176,7 @@ struct WebContentOptions {
     DisableSiteIsolation disable_site_isolation { DisableSiteIsolation::No };
     EnableIDLTracing enable_idl_tracing { EnableIDLTracing::No };
     EnableHTTPCache enable_http_cache { EnableHTTPCache::No };
+    PersistIndexedDB persist_indexed_db { PersistIndexedDB::No };
     ExposeInternalsObject expose_internals_object { ExposeInternalsObject::No };
     ForceCPUPainting force_cpu_painting { ForceCPUPainting::No };
     ForceFontconfig force_fontconfig { ForceFontconfig::No };
@@ -16,6 +16,8 @@ enum class PageInfoType {
     PaintTree = 1 << 3,
     GCGraph = 1 << 4,
     StackingContextTree = 1 << 5,
+    GCStatistics = 1 << 6,
+    GCHeapSnapshot = 1 << 7,
 };
 
 AK_ENUM_BITWISE_OPERATORS(PageInfoType);
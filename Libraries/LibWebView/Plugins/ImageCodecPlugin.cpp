@@ -31,7 +31,7 @@ void ImageCodecPlugin::set_client(NonnullRefPtr<ImageDecoderClient::Client> clie
 
 ImageCodecPlugin::~ImageCodecPlugin() = default;
 
-NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Web::Platform::AnimationFrameDecoding animation_frame_decoding, Threading::TaskPriority priority)
 {
     auto promise = Core::Promise<Web::Platform::DecodedImage>::construct();
     if (on_resolved)
@@ -46,23 +46,82 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::deco
 
     auto image_decoder_promise = m_client->decode_image(
         bytes,
-        [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
+        [this, promise, client = m_client->make_weak_ptr<ImageDecoderClient::Client>()](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
             // FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
             Web::Platform::DecodedImage decoded_image;
             decoded_image.is_animated = result.is_animated;
             decoded_image.loop_count = result.loop_count;
+            decoded_image.frame_count = result.frame_count;
             for (auto& frame : result.frames) {
                 decoded_image.frames.empend(move(frame.bitmap), frame.duration);
             }
             decoded_image.color_space = move(result.color_space);
+            if (result.animation_id.has_value()) {
+                auto animation_id = m_next_animation_id++;
+                m_animations.set(animation_id, { client, *result.animation_id });
+                decoded_image.animation_id = animation_id;
+            }
             promise->resolve(move(decoded_image));
             return {};
         },
         [promise](auto& error) {
             promise->reject(Error::copy(error));
-        });
+        },
+        {}, {},
+        animation_frame_decoding == Web::Platform::AnimationFrameDecoding::OnDemand ? ImageDecoderClient::AnimationFrameDecoding::OnDemand : ImageDecoderClient::AnimationFrameDecoding::AllUpFront,
+        priority);
 
     return promise;
 }
 
+void ImageCodecPlugin::request_animation_frames(i64 animation_id, size_t first_frame_index, size_t count, Function<void(size_t, Vector<Web::Platform::Frame>)> on_frames_decoded)
+{
+    auto animation = m_animations.get(animation_id);
+    if (!animation.has_value() || !animation->client)
+        return;
+
+    animation->client->request_animation_frames(animation->image_id, first_frame_index, count, [on_frames_decoded = move(on_frames_decoded)](u32 first_frame_index, Vector<ImageDecoderClient::Frame> frames) {
+        Vector<Web::Platform::Frame> platform_frames;
+        platform_frames.ensure_capacity(frames.size());
+        for (auto& frame : frames)
+            platform_frames.unchecked_append({ move(frame.bitmap), frame.duration });
+        on_frames_decoded(first_frame_index, move(platform_frames));
+    });
+}
+
+void ImageCodecPlugin::release_animation(i64 animation_id)
+{
+    auto animation = m_animations.take(animation_id);
+    if (animation.has_value() && animation->client)
+        animation->client->release_animation(animation->image_id);
+}
+
+Optional<i64> ImageCodecPlugin::begin_incremental_decode(Threading::TaskPriority priority, Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image)
+{
+    if (!m_client)
+        return {};
+
+    auto image_id = m_client->begin_incremental_decode(priority, move(on_partial_image));
+    if (!image_id.has_value())
+        return {};
+
+    auto decode_id = m_next_incremental_decode_id++;
+    m_incremental_decodes.set(decode_id, { m_client->make_weak_ptr<ImageDecoderClient::Client>(), *image_id });
+    return decode_id;
+}
+
+void ImageCodecPlugin::append_incremental_decode_data(i64 decode_id, ReadonlyBytes data)
+{
+    auto incremental_decode = m_incremental_decodes.get(decode_id);
+    if (incremental_decode.has_value() && incremental_decode->client)
+        incremental_decode->client->append_incremental_decode_data(incremental_decode->image_id, data);
+}
+
+void ImageCodecPlugin::end_incremental_decode(i64 decode_id)
+{
+    auto incremental_decode = m_incremental_decodes.take(decode_id);
+    if (incremental_decode.has_value() && incremental_decode->client)
+        incremental_decode->client->end_incremental_decode(incremental_decode->image_id);
+}
+
 }
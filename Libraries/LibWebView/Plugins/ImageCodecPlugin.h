@@ -18,12 +18,33 @@ public:
     explicit ImageCodecPlugin(NonnullRefPtr<ImageDecoderClient::Client>);
     virtual ~ImageCodecPlugin() override;
 
-    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected) override;
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Web::Platform::AnimationFrameDecoding, Threading::TaskPriority) override;
+    virtual void request_animation_frames(i64 animation_id, size_t first_frame_index, size_t count, Function<void(size_t first_frame_index, Vector<Web::Platform::Frame>)> on_frames_decoded) override;
+    virtual void release_animation(i64 animation_id) override;
+    virtual Optional<i64> begin_incremental_decode(Threading::TaskPriority, Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image) override;
+    virtual void append_incremental_decode_data(i64 decode_id, ReadonlyBytes) override;
+    virtual void end_incremental_decode(i64 decode_id) override;
 
     void set_client(NonnullRefPtr<ImageDecoderClient::Client>);
 
 private:
     RefPtr<ImageDecoderClient::Client> m_client;
+
+    // Animations stay with the ImageDecoder process that decoded them, even if we have been given a new one since.
+    struct Animation {
+        WeakPtr<ImageDecoderClient::Client> client;
+        i64 image_id { 0 };
+    };
+    HashMap<i64, Animation> m_animations;
+    i64 m_next_animation_id { 0 };
+
+    // Same for images that are decoded incrementally.
+    struct IncrementalDecode {
+        WeakPtr<ImageDecoderClient::Client> client;
+        i64 image_id { 0 };
+    };
+    HashMap<i64, IncrementalDecode> m_incremental_decodes;
+    i64 m_next_incremental_decode_id { 0 };
 };
 
 }
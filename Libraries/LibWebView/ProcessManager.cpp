@@ -126,6 +126,18 @@ void ProcessManager::update_all_process_statistics()
     (void)update_process_statistics(m_statistics);
 }
 
+u64 ProcessManager::total_memory_usage_bytes()
+{
+    Threading::MutexLocker locker { m_lock };
+    u64 total = 0;
+
+    m_statistics.for_each_process([&](auto const& process) {
+        total += process.memory_usage_bytes;
+    });
+
+    return total;
+}
+
 JsonValue ProcessManager::serialize_json()
 {
     Threading::MutexLocker locker { m_lock };
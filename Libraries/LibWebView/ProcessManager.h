@@ -35,6 +35,7 @@ public:
 #endif
 
     void update_all_process_statistics();
+    u64 total_memory_usage_bytes();
     JsonValue serialize_json();
 
     Function<void(Process&&)> on_process_exited;
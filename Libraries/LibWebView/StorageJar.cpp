@@ -30,9 +30,8 @@ ErrorOr<NonnullOwnPtr<StorageJar>> StorageJar::create(Database::Database& databa
 
     statements.set_item = TRY(database.prepare_statement("INSERT OR REPLACE INTO WebStorage VALUES (?, ?, ?, ?);"sv));
     statements.delete_item = TRY(database.prepare_statement("DELETE FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ? AND bottle_key = ?;"sv));
-    statements.get_item = TRY(database.prepare_statement("SELECT bottle_value FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ? AND bottle_key = ?;"sv));
     statements.clear = TRY(database.prepare_statement("DELETE FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ?;"sv));
-    statements.get_keys = TRY(database.prepare_statement("SELECT bottle_key FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ?;"sv));
+    statements.get_items = TRY(database.prepare_statement("SELECT bottle_key, bottle_value FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ?;"sv));
     statements.calculate_size_excluding_key = TRY(database.prepare_statement("SELECT SUM(LENGTH(bottle_key) + LENGTH(bottle_value)) FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ? AND bottle_key != ?;"sv));
 
     return adopt_own(*new StorageJar { PersistedStorage { database, statements } });
@@ -50,12 +49,11 @@ StorageJar::StorageJar(Optional<PersistedStorage> persisted_storage)
 
 StorageJar::~StorageJar() = default;
 
-Optional<String> StorageJar::get_item(StorageEndpointType storage_endpoint, String const& storage_key, String const& bottle_key)
+HashMap<String, String> StorageJar::get_items(StorageEndpointType storage_endpoint, String const& storage_key)
 {
-    StorageLocation storage_location { storage_endpoint, storage_key, bottle_key };
     if (m_persisted_storage.has_value())
-        return m_persisted_storage->get_item(storage_location);
-    return m_transient_storage.get_item(storage_location);
+        return m_persisted_storage->get_items(storage_endpoint, storage_key);
+    return m_transient_storage.get_items(storage_endpoint, storage_key);
 }
 
 StorageOperationError StorageJar::set_item(StorageEndpointType storage_endpoint, String const& storage_key, String const& bottle_key, String const& bottle_value)
@@ -85,11 +83,23 @@ void StorageJar::clear_storage_key(StorageEndpointType storage_endpoint, String
     }
 }
 
-Vector<String> StorageJar::get_all_keys(StorageEndpointType storage_endpoint, String const& storage_key)
+void StorageJar::apply_changes(StorageEndpointType storage_endpoint, String const& storage_key, ReadonlySpan<Web::StorageAPI::StorageItemChange> changes)
 {
+    // All changes are written in a single SQL transaction, rather than each in a transaction of its own.
+    if (m_persisted_storage.has_value())
+        m_persisted_storage->database.begin_transaction();
+
+    for (auto const& change : changes) {
+        if (!change.key.has_value())
+            clear_storage_key(storage_endpoint, storage_key);
+        else if (!change.value.has_value())
+            remove_item(storage_endpoint, storage_key, *change.key);
+        else if (set_item(storage_endpoint, storage_key, *change.key, *change.value) != StorageOperationError::None)
+            dbgln("StorageJar: Dropping change to '{}' for {}, as it would exceed the quota", *change.key, storage_key);
+    }
+
     if (m_persisted_storage.has_value())
-        return m_persisted_storage->get_keys(storage_endpoint, storage_key);
-    return m_transient_storage.get_keys(storage_endpoint, storage_key);
+        m_persisted_storage->database.commit_transaction();
 }
 
 StorageOperationError StorageJar::PersistedStorage::set_item(StorageLocation const& key, String const& value)
@@ -130,20 +140,6 @@ void StorageJar::PersistedStorage::delete_item(StorageLocation const& key)
         key.bottle_key);
 }
 
-Optional<String> StorageJar::PersistedStorage::get_item(StorageLocation const& key)
-{
-    Optional<String> result;
-    database.execute_statement(
-        statements.get_item,
-        [&](auto statement_id) {
-            result = database.result_column<String>(statement_id, 0);
-        },
-        static_cast<int>(to_underlying(key.storage_endpoint)),
-        key.storage_key,
-        key.bottle_key);
-    return result;
-}
-
 void StorageJar::PersistedStorage::clear(StorageEndpointType storage_endpoint, String const& storage_key)
 {
     database.execute_statement(
@@ -153,17 +149,17 @@ void StorageJar::PersistedStorage::clear(StorageEndpointType storage_endpoint, S
         storage_key);
 }
 
-Vector<String> StorageJar::PersistedStorage::get_keys(StorageEndpointType storage_endpoint, String const& storage_key)
+HashMap<String, String> StorageJar::PersistedStorage::get_items(StorageEndpointType storage_endpoint, String const& storage_key)
 {
-    Vector<String> keys;
+    HashMap<String, String> items;
     database.execute_statement(
-        statements.get_keys,
+        statements.get_items,
         [&](auto statement_id) {
-            keys.append(database.result_column<String>(statement_id, 0));
+            items.set(database.result_column<String>(statement_id, 0), database.result_column<String>(statement_id, 1));
         },
         static_cast<int>(to_underlying(storage_endpoint)),
         storage_key);
-    return keys;
+    return items;
 }
 
 StorageOperationError StorageJar::TransientStorage::set_item(StorageLocation const& key, String const& value)
@@ -185,13 +181,6 @@ StorageOperationError StorageJar::TransientStorage::set_item(StorageLocation con
     return StorageOperationError::None;
 }
 
-Optional<String> StorageJar::TransientStorage::get_item(StorageLocation const& key)
-{
-    if (auto value = m_storage_items.get(key); value.has_value())
-        return value.value();
-    return OptionalNone {};
-}
-
 void StorageJar::TransientStorage::delete_item(StorageLocation const& key)
 {
     m_storage_items.remove(key);
@@ -210,14 +199,14 @@ void StorageJar::TransientStorage::clear(StorageEndpointType storage_endpoint, S
     }
 }
 
-Vector<String> StorageJar::TransientStorage::get_keys(StorageEndpointType storage_endpoint, String const& storage_key)
+HashMap<String, String> StorageJar::TransientStorage::get_items(StorageEndpointType storage_endpoint, String const& storage_key)
 {
-    Vector<String> keys;
+    HashMap<String, String> items;
     for (auto const& [key, value] : m_storage_items) {
         if (key.storage_endpoint == storage_endpoint && key.storage_key == storage_key)
-            keys.append(key.bottle_key);
+            items.set(key.bottle_key, value);
     }
-    return keys;
+    return items;
 }
 
 }
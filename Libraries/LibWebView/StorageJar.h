@@ -11,6 +11,7 @@
 #include <AK/Traits.h>
 #include <LibDatabase/Forward.h>
 #include <LibWeb/StorageAPI/StorageEndpoint.h>
+#include <LibWeb/StorageAPI/StorageItemChange.h>
 #include <LibWebView/Forward.h>
 #include <LibWebView/StorageOperationError.h>
 
@@ -36,29 +37,29 @@ public:
 
     ~StorageJar();
 
-    Optional<String> get_item(StorageEndpointType storage_endpoint, String const& storage_key, String const& bottle_key);
+    HashMap<String, String> get_items(StorageEndpointType storage_endpoint, String const& storage_key);
     StorageOperationError set_item(StorageEndpointType storage_endpoint, String const& storage_key, String const& bottle_key, String const& bottle_value);
     void remove_item(StorageEndpointType storage_endpoint, String const& storage_key, String const& key);
     void clear_storage_key(StorageEndpointType storage_endpoint, String const& storage_key);
-    Vector<String> get_all_keys(StorageEndpointType storage_endpoint, String const& storage_key);
+
+    // Applies the changes that a WebContent process collected in its own copy of the storage items, in order.
+    void apply_changes(StorageEndpointType storage_endpoint, String const& storage_key, ReadonlySpan<Web::StorageAPI::StorageItemChange> changes);
 
 private:
     struct Statements {
         Database::StatementID set_item { 0 };
         Database::StatementID delete_item { 0 };
-        Database::StatementID get_item { 0 };
         Database::StatementID clear { 0 };
-        Database::StatementID get_keys { 0 };
+        Database::StatementID get_items { 0 };
         Database::StatementID calculate_size_excluding_key { 0 };
     };
 
     class TransientStorage {
     public:
         StorageOperationError set_item(StorageLocation const& key, String const& value);
-        Optional<String> get_item(StorageLocation const& key);
         void delete_item(StorageLocation const& key);
         void clear(StorageEndpointType storage_endpoint, String const& storage_key);
-        Vector<String> get_keys(StorageEndpointType storage_endpoint, String const& storage_key);
+        HashMap<String, String> get_items(StorageEndpointType storage_endpoint, String const& storage_key);
 
     private:
         HashMap<StorageLocation, String> m_storage_items;
@@ -66,10 +67,9 @@ private:
 
     struct PersistedStorage {
         StorageOperationError set_item(StorageLocation const& key, String const& value);
-        Optional<String> get_item(StorageLocation const& key);
         void delete_item(StorageLocation const& key);
         void clear(StorageEndpointType storage_endpoint, String const& storage_key);
-        Vector<String> get_keys(StorageEndpointType storage_endpoint, String const& storage_key);
+        HashMap<String, String> get_items(StorageEndpointType storage_endpoint, String const& storage_key);
 
         Database::Database& database;
         Statements statements;
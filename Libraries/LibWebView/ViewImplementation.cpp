@@ -146,12 +146,47 @@ void ViewImplementation::did_update_window_rect()
 
 void ViewImplementation::set_system_visibility_state(Web::HTML::VisibilityState visibility_state)
 {
+    if (m_system_visibility_state == Web::HTML::VisibilityState::Visible || visibility_state == Web::HTML::VisibilityState::Visible)
+        m_last_visible_time = MonotonicTime::now_coarse();
+
     m_system_visibility_state = visibility_state;
     client().async_set_system_visibility_state(m_client_state.page_index, m_system_visibility_state);
+
+    if (m_system_visibility_state == Web::HTML::VisibilityState::Visible && m_discarded_url.has_value())
+        load(m_discarded_url.release_value());
+}
+
+bool ViewImplementation::can_be_discarded() const
+{
+    if (is_discarded() || !m_client_state.client)
+        return false;
+    if (m_system_visibility_state == Web::HTML::VisibilityState::Visible)
+        return false;
+    if (m_audio_play_state == Web::HTML::AudioPlayState::Playing)
+        return false;
+
+    // Popups may share their opener's process, which we would take down with us.
+    return client().view_count() == 1;
+}
+
+void ViewImplementation::discard()
+{
+    VERIFY(can_be_discarded());
+    m_discarded_url = m_url;
+
+    client().async_close_server();
+
+    initialize_client();
+    VERIFY(m_client_state.client);
+
+    // Don't keep a stale backup bitmap around.
+    m_backup_bitmap = nullptr;
+    handle_resize();
 }
 
 void ViewImplementation::load(URL::URL const& url)
 {
+    m_discarded_url.clear();
     m_url = url;
     client().async_load_url(page_id(), url);
 }
@@ -689,7 +724,7 @@ static ErrorOr<LexicalPath> save_screenshot(Gfx::Bitmap const* bitmap)
     auto file = AK::UnixDateTime::now().to_byte_string("screenshot-%Y-%m-%d-%H-%M-%S.png"sv);
     auto path = TRY(Application::the().path_for_downloaded_file(file));
 
-    auto encoded = TRY(Gfx::PNGWriter::encode(*bitmap));
+    auto encoded = TRY(Gfx::PNGWriter::encode(*bitmap, { .compression_level = Compress::GenericZlibCompressionLevel::Fastest }));
 
     auto dump_file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
     TRY(dump_file->write_until_depleted(encoded));
@@ -876,7 +911,8 @@ void ViewImplementation::initialize_context_menus()
         if (!bitmap.is_valid())
             return;
 
-        auto encoded = Gfx::PNGWriter::encode(*bitmap.bitmap());
+        // The clipboard only holds on to the image until it is pasted somewhere, so favor speed over size.
+        auto encoded = Gfx::PNGWriter::encode(*bitmap.bitmap(), { .compression_level = Compress::GenericZlibCompressionLevel::VeryFast });
         if (encoded.is_error())
             return;
 
@@ -13,6 +13,7 @@
 #include <AK/LexicalPath.h>
 #include <AK/Queue.h>
 #include <AK/String.h>
+#include <AK/Time.h>
 #include <AK/Utf16String.h>
 #include <LibCore/Forward.h>
 #include <LibCore/Promise.h>
@@ -60,6 +61,13 @@ public:
     void did_update_window_rect();
 
     void set_system_visibility_state(Web::HTML::VisibilityState);
+    MonotonicTime last_visible_time() const { return m_last_visible_time; }
+
+    // Replaces the WebContent process of a hidden view with a fresh one, to give back the memory used by its page. The
+    // page is loaded again (without its session history) the next time the view becomes visible.
+    bool can_be_discarded() const;
+    void discard();
+    bool is_discarded() const { return m_discarded_url.has_value(); }
 
     void load(URL::URL const&);
     void load_html(StringView);
@@ -341,6 +349,8 @@ protected:
     RefPtr<Core::Promise<String>> m_pending_info_request;
 
     Web::HTML::VisibilityState m_system_visibility_state { Web::HTML::VisibilityState::Hidden };
+    MonotonicTime m_last_visible_time { MonotonicTime::now_coarse() };
+    Optional<URL::URL> m_discarded_url;
 
     Web::HTML::AudioPlayState m_audio_play_state { Web::HTML::AudioPlayState::Paused };
     size_t m_number_of_elements_playing_audio { 0 };
@@ -8,6 +8,7 @@
 #include <LibWebView/Application.h>
 #include <LibWebView/CookieJar.h>
 #include <LibWebView/HelperProcess.h>
+#include <LibWebView/IndexedDBStorage.h>
 #include <LibWebView/SourceHighlighter.h>
 #include <LibWebView/ViewImplementation.h>
 #include <LibWebView/WebContentClient.h>
@@ -27,9 +28,8 @@ Optional<ViewImplementation&> WebContentClient::view_for_pid_and_page_id(pid_t p
 }
 
 WebContentClient::WebContentClient(NonnullOwnPtr<IPC::Transport> transport, ViewImplementation& view)
-    : IPC::ConnectionToServer<WebContentClientEndpoint, WebContentServerEndpoint>(*this, move(transport))
+    : WebContentClient(move(transport))
 {
-    s_clients.set(this);
     m_views.set(0, &view);
 }
 
@@ -37,6 +37,10 @@ WebContentClient::WebContentClient(NonnullOwnPtr<IPC::Transport> transport)
     : IPC::ConnectionToServer<WebContentClientEndpoint, WebContentServerEndpoint>(*this, move(transport))
 {
     s_clients.set(this);
+
+    // Input events make up most of what we send to WebContent, and are small and frequent.
+    if (auto result = this->transport().send_messages_through_shared_memory(); result.is_error())
+        dbgln("WebContentClient: Unable to send messages through shared memory: {}", result.error());
 }
 
 WebContentClient::~WebContentClient()
@@ -510,29 +514,47 @@ void WebContentClient::did_expire_cookies_with_time_offset(AK::Duration offset)
     Application::cookie_jar().expire_cookies_with_time_offset(offset);
 }
 
-Messages::WebContentClient::DidRequestStorageItemResponse WebContentClient::did_request_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key)
+Messages::WebContentClient::DidRequestStorageItemsResponse WebContentClient::did_request_storage_items(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key)
 {
-    return Application::storage_jar().get_item(storage_endpoint, storage_key, bottle_key);
+    return Application::storage_jar().get_items(storage_endpoint, storage_key);
+}
+
+void WebContentClient::did_update_storage_items(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Vector<Web::StorageAPI::StorageItemChange> changes)
+{
+    Application::storage_jar().apply_changes(storage_endpoint, storage_key, changes);
+
+    // Other processes keep their own copy of the storage items, which we keep up to date for them.
+    for_each_client([&](WebContentClient& client) {
+        if (&client != this && client.is_open())
+            client.async_storage_items_changed(storage_endpoint, storage_key, changes);
+        return IterationDecision::Continue;
+    });
 }
 
-Messages::WebContentClient::DidSetStorageItemResponse WebContentClient::did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key, String value)
+Messages::WebContentClient::DidRequestIndexedDbDatabaseResponse WebContentClient::did_request_indexed_db_database(String storage_key, String name)
 {
-    return Application::storage_jar().set_item(storage_endpoint, storage_key, bottle_key, value);
+    if (auto* storage = Application::indexed_db_storage())
+        return storage->load_database(storage_key, name);
+    return OptionalNone {};
 }
 
-void WebContentClient::did_remove_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key)
+Messages::WebContentClient::DidRequestIndexedDbDatabaseVersionsResponse WebContentClient::did_request_indexed_db_database_versions(String storage_key)
 {
-    Application::storage_jar().remove_item(storage_endpoint, storage_key, bottle_key);
+    if (auto* storage = Application::indexed_db_storage())
+        return storage->database_versions(storage_key);
+    return HashMap<String, u64> {};
 }
 
-Messages::WebContentClient::DidRequestStorageKeysResponse WebContentClient::did_request_storage_keys(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key)
+void WebContentClient::did_commit_indexed_db_transaction(String storage_key, String name, Web::IndexedDB::PersistedDatabaseChanges changes)
 {
-    return Application::storage_jar().get_all_keys(storage_endpoint, storage_key);
+    if (auto* storage = Application::indexed_db_storage())
+        storage->commit_changes(storage_key, name, changes);
 }
 
-void WebContentClient::did_clear_storage(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key)
+void WebContentClient::did_delete_indexed_db_database(String storage_key, String name)
 {
-    Application::storage_jar().clear_storage_key(storage_endpoint, storage_key);
+    if (auto* storage = Application::indexed_db_storage())
+        storage->delete_database(storage_key, name);
 }
 
 Messages::WebContentClient::DidRequestNewWebViewResponse WebContentClient::did_request_new_web_view(u64 page_id, Web::HTML::ActivateTab activate_tab, Web::HTML::WebViewHints hints, Optional<u64> page_index)
@@ -700,7 +722,7 @@ void WebContentClient::did_allocate_backing_stores(u64 page_id, i32 front_bitmap
 Messages::WebContentClient::RequestWorkerAgentResponse WebContentClient::request_worker_agent(u64 page_id, Web::Bindings::AgentType worker_type)
 {
     if (auto view = view_for_page_id(page_id); view.has_value()) {
-        auto worker_client = MUST(WebView::launch_web_worker_process(worker_type));
+        auto worker_client = MUST(Application::the().launch_web_worker_process(worker_type));
         return worker_client->clone_transport();
     }
 
@@ -48,6 +48,7 @@ public:
     void assign_view(Badge<Application>, ViewImplementation&);
     void register_view(u64 page_id, ViewImplementation&);
     void unregister_view(u64 page_id);
+    size_t view_count() const { return m_views.size(); }
 
     void web_ui_disconnected(Badge<WebUI>);
 
@@ -108,11 +109,12 @@ private:
     virtual void did_set_cookie(URL::URL, Web::Cookie::ParsedCookie, Web::Cookie::Source) override;
     virtual void did_update_cookie(Web::Cookie::Cookie) override;
     virtual void did_expire_cookies_with_time_offset(AK::Duration) override;
-    virtual Messages::WebContentClient::DidRequestStorageItemResponse did_request_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key) override;
-    virtual Messages::WebContentClient::DidSetStorageItemResponse did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key, String value) override;
-    virtual void did_remove_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key) override;
-    virtual Messages::WebContentClient::DidRequestStorageKeysResponse did_request_storage_keys(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key) override;
-    virtual void did_clear_storage(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key) override;
+    virtual Messages::WebContentClient::DidRequestStorageItemsResponse did_request_storage_items(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key) override;
+    virtual void did_update_storage_items(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Vector<Web::StorageAPI::StorageItemChange> changes) override;
+    virtual Messages::WebContentClient::DidRequestIndexedDbDatabaseResponse did_request_indexed_db_database(String storage_key, String name) override;
+    virtual Messages::WebContentClient::DidRequestIndexedDbDatabaseVersionsResponse did_request_indexed_db_database_versions(String storage_key) override;
+    virtual void did_commit_indexed_db_transaction(String storage_key, String name, Web::IndexedDB::PersistedDatabaseChanges changes) override;
+    virtual void did_delete_indexed_db_database(String storage_key, String name) override;
     virtual Messages::WebContentClient::DidRequestNewWebViewResponse did_request_new_web_view(u64 page_id, Web::HTML::ActivateTab, Web::HTML::WebViewHints, Optional<u64> page_index) override;
     virtual void did_request_activate_tab(u64 page_id) override;
     virtual void did_close_browsing_context(u64 page_id) override;
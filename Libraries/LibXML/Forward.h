@@ -9,6 +9,7 @@
 namespace XML {
 
 class Parser;
+class StreamingParser;
 class Document;
 struct Node;
 struct Attribute;
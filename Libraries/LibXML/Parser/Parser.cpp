@@ -177,7 +177,13 @@ void Parser::leave_node()
         m_listener->element_end(element.name);
     }
 
-    m_entered_node = m_entered_node->parent;
+    auto* parent = m_entered_node->parent;
+
+    // The listener has been told everything about the element, so there is no need to keep it around.
+    if (m_listener && parent)
+        parent->content.get<Node::Element>().children.take_last();
+
+    m_entered_node = parent;
 }
 
 ErrorOr<Document, ParseError> Parser::parse()
@@ -1847,4 +1853,137 @@ ErrorOr<ByteString, ParseError> Parser::resolve_reference(EntityReference const&
     }
 }
 
+// Passes the events of one pass of a StreamingParser on to its listener, skipping the ones that an earlier pass has
+// already delivered.
+class StreamingParserEventFilter final : public Listener {
+public:
+    StreamingParserEventFilter(Listener& listener, size_t& delivered_event_count, bool hold_back_unstable_events)
+        : m_listener(listener)
+        , m_delivered_event_count(delivered_event_count)
+        , m_hold_back_unstable_events(hold_back_unstable_events)
+    {
+    }
+
+    virtual void set_doctype(Doctype doctype) override
+    {
+        deliver([&] { m_listener.set_doctype(move(doctype)); });
+    }
+
+    virtual void element_start(Name const& name, OrderedHashMap<Name, ByteString> const& attributes) override
+    {
+        deliver([&] { m_listener.element_start(name, attributes); });
+    }
+
+    virtual void element_end(Name const& name) override
+    {
+        hold_back_or_deliver([this, name] { m_listener.element_end(name); });
+    }
+
+    virtual void text(StringView text) override
+    {
+        hold_back_or_deliver([this, text = ByteString { text }] { m_listener.text(text); });
+    }
+
+    virtual void cdata_section(StringView text) override
+    {
+        deliver([&] { m_listener.cdata_section(text); });
+    }
+
+    virtual void processing_instruction(StringView target, StringView data) override
+    {
+        deliver([&] { m_listener.processing_instruction(target, data); });
+    }
+
+    virtual void comment(StringView text) override
+    {
+        deliver([&] { m_listener.comment(text); });
+    }
+
+private:
+    template<typename Callback>
+    void deliver(Callback&& callback)
+    {
+        if (m_event_index++ < m_delivered_event_count)
+            return;
+
+        // Whatever was held back is followed by this event, so the parser did not run out of input while parsing it.
+        for (auto& held_back_event : m_held_back_events)
+            held_back_event();
+        m_delivered_event_count += m_held_back_events.size();
+        m_held_back_events.clear();
+
+        callback();
+        ++m_delivered_event_count;
+    }
+
+    void hold_back_or_deliver(Function<void()> callback)
+    {
+        if (!m_hold_back_unstable_events) {
+            deliver(callback);
+            return;
+        }
+
+        if (m_event_index++ < m_delivered_event_count)
+            return;
+        m_held_back_events.append(move(callback));
+    }
+
+    Listener& m_listener;
+    size_t& m_delivered_event_count;
+    bool m_hold_back_unstable_events { false };
+    size_t m_event_index { 0 };
+    Vector<Function<void()>> m_held_back_events;
+};
+
+StreamingParser::StreamingParser(Listener& listener, Parser::Options options)
+    : m_listener(listener)
+    , m_options(move(options))
+{
+}
+
+void StreamingParser::append(StringView chunk)
+{
+    m_source.append(chunk);
+
+    if (m_source.length() >= m_parsed_length * 2)
+        (void)parse(Pass::Partial);
+}
+
+ErrorOr<void, ParseError> StreamingParser::finish()
+{
+    if (auto const maybe_source_error = m_listener.set_source(m_source.to_byte_string()); maybe_source_error.is_error())
+        return ParseError { {}, Expectation { maybe_source_error.error().string_literal() } };
+
+    auto result = parse(Pass::Final);
+    if (result.is_error())
+        m_listener.error(result.error());
+    m_listener.document_end();
+    return result;
+}
+
+ErrorOr<void, ParseError> StreamingParser::parse(Pass pass)
+{
+    if (!m_has_started) {
+        m_listener.document_start();
+        m_has_started = true;
+    }
+
+    Parser::Options options {
+        .preserve_cdata = m_options.preserve_cdata,
+        .preserve_comments = m_options.preserve_comments,
+        .treat_errors_as_fatal = m_options.treat_errors_as_fatal,
+    };
+    if (m_options.resolve_external_resource) {
+        options.resolve_external_resource = [this](SystemID const& system_id, Optional<PublicID> const& public_id) {
+            return m_options.resolve_external_resource(system_id, public_id);
+        };
+    }
+
+    m_parsed_length = m_source.length();
+
+    Parser parser { m_source.string_view(), move(options) };
+    StreamingParserEventFilter filter { m_listener, m_delivered_event_count, pass == Pass::Partial };
+    return parser.parse_with_listener(filter);
+}
+
 }
@@ -13,6 +13,7 @@
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <AK/SourceLocation.h>
+#include <AK/StringBuilder.h>
 #include <AK/TemporaryChange.h>
 #include <LibXML/DOM/Document.h>
 #include <LibXML/DOM/DocumentTypeDeclaration.h>
@@ -228,6 +229,37 @@ private:
     Optional<Doctype> m_doctype;
 };
 
+// Parses a document whose source arrives in chunks, and hands the parts of it that are complete to a listener as soon
+// as possible, e.g. so that a large document can be shown before all of it has been downloaded.
+//
+// The Parser can't stop and resume in the middle of a document, so all of the source that has arrived so far is parsed
+// again whenever it has doubled in size, which keeps the total work linear in the size of the document. Only events
+// that weren't delivered by an earlier pass are passed on, and events that could still change once more of the source
+// arrives (text, and the element ends that the parser emits when it runs out of input) are held back until a later pass.
+class XML_API StreamingParser {
+public:
+    StreamingParser(Listener&, Parser::Options = {});
+
+    // The source has to be UTF-8, and chunks must not end in the middle of a code point.
+    void append(StringView chunk);
+
+    ErrorOr<void, ParseError> finish();
+
+private:
+    enum class Pass {
+        Partial,
+        Final,
+    };
+    ErrorOr<void, ParseError> parse(Pass);
+
+    Listener& m_listener;
+    Parser::Options m_options;
+    StringBuilder m_source;
+    size_t m_parsed_length { 0 };
+    size_t m_delivered_event_count { 0 };
+    bool m_has_started { false };
+};
+
 }
 
 template<>
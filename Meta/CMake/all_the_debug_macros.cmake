@@ -15,6 +15,7 @@ set(EDITOR_DEBUG ON)
 set(EMOJI_DEBUG ON)
 set(FILE_WATCHER_DEBUG ON)
 set(FLAC_ENCODER_DEBUG ON)
+set(FUNCTION_DEBUG ON)
 set(GENERATE_DEBUG ON)
 set(GHASH_PROCESS_DEBUG ON)
 set(GIF_DEBUG ON)
@@ -31,10 +32,12 @@ set(IMAGE_DECODER_DEBUG ON)
 set(IMAGE_LOADER_DEBUG ON)
 set(JOB_DEBUG ON)
 set(JS_BYTECODE_DEBUG ON)
+set(JS_BYTECODE_STATISTICS_DEBUG ON)
 set(JS_MODULE_DEBUG ON)
 set(LEXER_DEBUG ON)
 set(LIBWEB_CSS_ANIMATION_DEBUG ON)
 set(LIBWEB_CSS_DEBUG ON)
+set(LIBWEB_DISPLAY_LIST_DEBUG ON)
 set(LIBWEB_WASM_DEBUG ON)
 set(LINE_EDITOR_DEBUG ON)
 set(LZW_DEBUG ON)
@@ -21,6 +21,10 @@ if (LINUX)
     add_cxx_compile_definitions(_FILE_OFFSET_BITS=64)
 endif()
 
+if (ENABLE_MEMORY_ACCOUNTING)
+    add_cxx_compile_definitions(AK_ENABLE_MEMORY_ACCOUNTING)
+endif()
+
 if (APPLE)
     list(APPEND CMAKE_PREFIX_PATH /opt/homebrew)
 endif()
@@ -251,6 +251,14 @@ Vector<Endpoint> parse(ByteBuffer const& file_contents)
             assert_specific('(');
             parse_parameters(message.outputs, message.name);
             assert_specific(')');
+
+            // NOTE: Dropping a synchronous message would leave its sender waiting for a response forever.
+            for (auto const& parameter : message.inputs) {
+                if (parameter.attributes.contains_slow("CoalescingKey"sv)) {
+                    warnln("Synchronous message {} can't have a coalescing key", message.name);
+                    VERIFY_NOT_REACHED();
+                }
+            }
         }
 
         consume_whitespace();
@@ -491,6 +499,27 @@ public:)~~~");
     message_generator.appendln(R"~~~();
     })~~~");
 
+    Vector<ByteString> coalescing_key_comparisons;
+    for (auto const& parameter : parameters) {
+        if (parameter.attributes.contains_slow("CoalescingKey"sv))
+            coalescing_key_comparisons.append(ByteString::formatted("m_{0} == other.m_{0}", parameter.name));
+    }
+
+    if (!coalescing_key_comparisons.is_empty()) {
+        message_generator.set("message.coalescing_key_comparison", ByteString::join(" && "sv, coalescing_key_comparisons));
+        message_generator.appendln(R"~~~(
+    virtual bool is_coalescable() const override { return true; }
+
+    virtual bool supersedes(IPC::Message const& message) const override
+    {
+        if (message.endpoint_magic() != ENDPOINT_MAGIC || message.message_id() != message_id())
+            return false;
+
+        auto const& other = static_cast<@message.pascal_name@ const&>(message);
+        return @message.coalescing_key_comparison@;
+    })~~~");
+    }
+
     for (auto const& parameter : parameters) {
         auto parameter_generator = message_generator.fork();
         parameter_generator.set("parameter.type", parameter.type);
@@ -780,6 +809,31 @@ public:
         VERIFY_NOT_REACHED();
     }
 
+    static StringView message_name(i32 message_id)
+    {
+        switch (message_id) {)~~~");
+
+    for (auto const& message : endpoint.messages) {
+        auto do_message_name = [&](ByteString const& name) {
+            auto message_generator = generator.fork();
+
+            message_generator.set("message.pascal_name", pascal_case(name));
+
+            message_generator.append(R"~~~(
+        case (int)Messages::@endpoint.name@::MessageID::@message.pascal_name@:
+            return "@endpoint.name@::@message.pascal_name@"sv;)~~~");
+        };
+
+        do_message_name(message.name);
+        if (message.is_synchronous)
+            do_message_name(message.response_name());
+    }
+
+    generator.appendln(R"~~~(
+        default:
+            return {};
+        }
+    }
 };
 
 class @endpoint.name@Stub : public IPC::Stub {
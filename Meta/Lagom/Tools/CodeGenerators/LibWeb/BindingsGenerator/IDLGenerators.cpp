@@ -2816,7 +2816,7 @@ static void generate_html_constructor(SourceGenerator& generator, IDL::Construct
 
                 // 2. Set prototype to the interface prototype object for interface in targetRealm.
                 VERIFY(target_realm);
-                prototype = &Bindings::ensure_web_prototype<@prototype_class@>(*target_realm, "@name@"_fly_string);
+                prototype = &Bindings::ensure_web_prototype<@prototype_class@>(*target_realm);
             }
 
             // 9. Set instance.[[Prototype]] to prototype.
@@ -2843,7 +2843,7 @@ static void generate_html_constructor(SourceGenerator& generator, IDL::Construct
 
         // 2. Set prototype to the interface prototype object of realm whose interface is the same as the interface of the active function object.
         VERIFY(function_realm);
-        prototype = &Bindings::ensure_web_prototype<@prototype_class@>(*function_realm, "@name@"_fly_string);
+        prototype = &Bindings::ensure_web_prototype<@prototype_class@>(*function_realm);
     }
 
     VERIFY(prototype.is_object());
@@ -2902,7 +2902,7 @@ JS::ThrowCompletionOr<GC::Ref<JS::Object>> @constructor_class@::construct@overlo
 
         // 2. Set prototype to the interface prototype object for interface in targetRealm.
         VERIFY(target_realm);
-        prototype = &Bindings::ensure_web_prototype<@prototype_class@>(*target_realm, "@namespaced_name@"_fly_string);
+        prototype = &Bindings::ensure_web_prototype<@prototype_class@>(*target_realm);
     }
 
     // 4. Let instance be MakeBasicObject( « [[Prototype]], [[Extensible]], [[Realm]], [[PrimaryInterface]] »).
@@ -3641,7 +3641,7 @@ void @class_name@::initialize(JS::Realm& realm)
         } else {
             generator.append(R"~~~(
 
-    @set_prototype@(&ensure_web_prototype<@prototype_base_class@>(realm, "@parent_name@"_fly_string));
+    @set_prototype@(&ensure_web_prototype<@prototype_base_class@>(realm));
 
 )~~~");
         }
@@ -3998,6 +3998,11 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.getter_callback@)
 
         // https://html.spec.whatwg.org/multipage/common-dom-interfaces.html#reflecting-content-attributes-in-idl-attributes
         if (attribute.extended_attributes.contains("Reflect")) {
+            // NOTE: The name of the content attribute is only created once, instead of every time the attribute is accessed.
+            attribute_generator.append(R"~~~(
+    static auto content_attribute = "@attribute.reflect_name@"_fly_string;
+)~~~");
+
             if (attribute.type->name() == "DOMString") {
                 if (!attribute.type->is_nullable()) {
                     // If a reflected IDL attribute has the type DOMString:
@@ -4008,7 +4013,7 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.getter_callback@)
 
                     // 2. Let contentAttributeValue be the result of running this's get the content attribute.
                     attribute_generator.append(R"~~~(
-    auto contentAttributeValue = impl->attribute("@attribute.reflect_name@"_fly_string);
+    auto contentAttributeValue = impl->attribute(content_attribute);
 )~~~");
 
                     // 3. Let attributeDefinition be the attribute definition of element's content attribute whose namespace is null
@@ -4044,7 +4049,7 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.getter_callback@)
         did_set_to_missing_value = true;
     }
 
-    Array valid_values { @valid_enum_values@ };
+    static Array const valid_values { @valid_enum_values@ };
 
     auto has_keyword = false;
     for (auto const& value : valid_values) {
@@ -4072,7 +4077,7 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.getter_callback@)
                     // 2. Let contentAttributeValue be the result of running this's get the content attribute.
 
                     attribute_generator.append(R"~~~(
-    auto content_attribute_value = impl->attribute("@attribute.reflect_name@"_fly_string);
+    auto content_attribute_value = impl->attribute(content_attribute);
 )~~~");
 
                     // 3. Let attributeDefinition be the attribute definition of element's content attribute whose namespace is null
@@ -4086,7 +4091,7 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.getter_callback@)
                         // NOTE: We run step 4 here to have a field to assign to
                         // 4. Return the canonical keyword for the state of attributeDefinition that contentAttributeValue corresponds to.
                         attribute_generator.append(R"~~~(
-    auto retval = impl->attribute("@attribute.reflect_name@"_fly_string);
+    auto retval = impl->attribute(content_attribute);
 )~~~");
 
                         // 1. Assert: the reflected IDL attribute is limited to only known values.
@@ -4104,7 +4109,7 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.getter_callback@)
                         attribute_generator.set("valid_enum_values", MUST(String::join(", "sv, valid_enumerations.values.values(), "\"{}\"_string"sv)));
 
                         attribute_generator.append(R"~~~(
-    Array valid_values { @valid_enum_values@ };
+    static Array const valid_values { @valid_enum_values@ };
     )~~~");
                         if (invalid_value_default.has_value()) {
                             attribute_generator.append(R"~~~(
@@ -4151,7 +4156,7 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.getter_callback@)
                 // 1. Let contentAttributeValue be the result of running this's get the content attribute.
                 // 2. If contentAttributeValue is null, then return false
                 attribute_generator.append(R"~~~(
-    auto retval = impl->has_attribute("@attribute.reflect_name@"_fly_string);
+    auto retval = impl->has_attribute(content_attribute);
 )~~~");
             }
             // If a reflected IDL attribute has the type long:
@@ -4164,7 +4169,7 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.getter_callback@)
                 //    2. If parsedValue is not an error and is within the long range, then return parsedValue.
                 attribute_generator.append(R"~~~(
     i32 retval = 0;
-    auto content_attribute_value = impl->get_attribute("@attribute.reflect_name@"_fly_string);
+    auto content_attribute_value = impl->get_attribute(content_attribute);
     if (content_attribute_value.has_value()) {
         auto maybe_parsed_value = Web::HTML::parse_integer(*content_attribute_value);
         if (maybe_parsed_value.has_value())
@@ -4189,7 +4194,7 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.getter_callback@)
                 //              FIXME: 2. Return maximum.
                 attribute_generator.append(R"~~~(
     u32 retval = 0;
-    auto content_attribute_value = impl->get_attribute("@attribute.reflect_name@"_fly_string);
+    auto content_attribute_value = impl->get_attribute(content_attribute);
     u32 minimum = 0;
     u32 maximum = 2147483647;
     if (content_attribute_value.has_value()) {
@@ -4210,7 +4215,7 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.getter_callback@)
                 // NOTE: this is "impl" above
                 // 2. Let contentAttributeValue be the result of running this's get the content attribute.
                 attribute_generator.append(R"~~~(
-    auto content_attribute_value = impl->attribute("@attribute.reflect_name@"_fly_string);
+    auto content_attribute_value = impl->attribute(content_attribute);
 )~~~");
                 // 3. Let attributeDefinition be the attribute definition of element's content attribute whose namespace is null and local name is the reflected content attribute name.
                 // NOTE: this is "attribute" above
@@ -4243,8 +4248,6 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.getter_callback@)
             else if (attribute.type->is_nullable() && attribute.type->name() == "Element") {
                 // The getter steps are to return the result of running this's get the attr-associated element.
                 attribute_generator.append(R"~~~(
-    static auto content_attribute = "@attribute.reflect_name@"_fly_string;
-
     auto retval = impl->get_the_attribute_associated_element(content_attribute, TRY(throw_dom_exception_if_needed(vm, [&] { return impl->@attribute.cpp_name@(); })));
 )~~~");
             }
@@ -4256,13 +4259,11 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.getter_callback@)
 
                 // 1. Let elements be the result of running this's get the attr-associated elements.
                 attribute_generator.append(R"~~~(
-    static auto content_attribute = "@attribute.reflect_name@"_fly_string;
-
     auto retval = impl->get_the_attribute_associated_elements(content_attribute, TRY(throw_dom_exception_if_needed(vm, [&] { return impl->@attribute.cpp_name@(); })));
 )~~~");
             } else {
                 attribute_generator.append(R"~~~(
-    auto retval = impl->get_attribute_value("@attribute.reflect_name@"_fly_string);
+    auto retval = impl->get_attribute_value(content_attribute);
 )~~~");
             }
 
@@ -4390,12 +4391,16 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.setter_callback@)
             generate_to_cpp(generator, attribute, "value", "", "cpp_value", interface, attribute.extended_attributes.contains("LegacyNullToEmptyString"));
 
             if (attribute.extended_attributes.contains("Reflect")) {
+                attribute_generator.append(R"~~~(
+    static auto content_attribute = "@attribute.reflect_name@"_fly_string;
+)~~~");
+
                 if (attribute.type->name() == "boolean") {
                     attribute_generator.append(R"~~~(
     if (!cpp_value)
-        impl->remove_attribute("@attribute.reflect_name@"_fly_string);
+        impl->remove_attribute(content_attribute);
     else
-        MUST(impl->set_attribute("@attribute.reflect_name@"_fly_string, String {}));
+        MUST(impl->set_attribute(content_attribute, String {}));
 )~~~");
                 } else if (attribute.type->name() == "unsigned long") {
                     // The setter steps are:
@@ -4411,11 +4416,11 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.setter_callback@)
     u32 new_value = minimum;
     if (cpp_value >= minimum && cpp_value <= 2147483647)
         new_value = cpp_value;
-    MUST(impl->set_attribute("@attribute.reflect_name@"_fly_string, String::number(new_value)));
+    MUST(impl->set_attribute(content_attribute, String::number(new_value)));
 )~~~");
                 } else if (attribute.type->is_integer() && !attribute.type->is_nullable()) {
                     attribute_generator.append(R"~~~(
-    MUST(impl->set_attribute("@attribute.reflect_name@"_fly_string, String::number(cpp_value)));
+    MUST(impl->set_attribute(content_attribute, String::number(cpp_value)));
 )~~~");
                 }
                 // If a reflected IDL attribute has the type T?, where T is either Element or an interface that inherits
@@ -4428,8 +4433,6 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.setter_callback@)
                     //     2. Run this's delete the content attribute.
                     //     3. Return.
                     attribute_generator.append(R"~~~(
-    static auto content_attribute = "@attribute.reflect_name@"_fly_string;
-
     if (!cpp_value) {
         TRY(throw_dom_exception_if_needed(vm, [&] { return impl->set_@attribute.cpp_name@({}); }));
         impl->remove_attribute(content_attribute);
@@ -4454,8 +4457,6 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.setter_callback@)
                     //     2. Run this's delete the content attribute.
                     //     3. Return.
                     attribute_generator.append(R"~~~(
-    static auto content_attribute = "@attribute.reflect_name@"_fly_string;
-
     if (!cpp_value.has_value()) {
         TRY(throw_dom_exception_if_needed(vm, [&] { return impl->set_@attribute.cpp_name@({}); }));
         impl->remove_attribute(content_attribute);
@@ -4485,13 +4486,13 @@ JS_DEFINE_NATIVE_FUNCTION(@class_name@::@attribute.setter_callback@)
                 } else if (attribute.type->is_nullable()) {
                     attribute_generator.append(R"~~~(
     if (!cpp_value.has_value())
-        impl->remove_attribute("@attribute.reflect_name@"_fly_string);
+        impl->remove_attribute(content_attribute);
     else
-        MUST(impl->set_attribute("@attribute.reflect_name@"_fly_string, cpp_value.value()));
+        MUST(impl->set_attribute(content_attribute, cpp_value.value()));
 )~~~");
                 } else {
                     attribute_generator.append(R"~~~(
-MUST(impl->set_attribute("@attribute.reflect_name@"_fly_string, cpp_value));
+MUST(impl->set_attribute(content_attribute, cpp_value));
 )~~~");
                 }
 
@@ -5288,7 +5289,7 @@ void @constructor_class@::initialize(JS::Realm& realm)
     generator.append(R"~~~(
     define_direct_property(vm.names.length, JS::Value(@constructor.length@), JS::Attribute::Configurable);
     define_direct_property(vm.names.name, JS::PrimitiveString::create(vm, "@name@"_string), JS::Attribute::Configurable);
-    define_direct_property(vm.names.prototype, &ensure_web_prototype<@prototype_class@>(realm, "@namespaced_name@"_fly_string), 0);
+    define_direct_property(vm.names.prototype, &ensure_web_prototype<@prototype_class@>(realm), 0);
 
 )~~~");
 
@@ -5382,6 +5383,7 @@ void generate_prototype_header(IDL::Interface const& interface, StringBuilder& b
 #pragma once
 
 #include <LibJS/Runtime/Object.h>
+#include <LibWeb/Export.h>
 
 namespace Web::Bindings {
 
@@ -5389,6 +5391,9 @@ class @prototype_class@ : public JS::Object {
     JS_OBJECT(@prototype_class@, JS::Object);
     GC_DECLARE_ALLOCATOR(@prototype_class@);
 public:
+    // Assigned by GenerateWindowOrWorkerInterfaces, see Intrinsics::ensure_web_prototype().
+    WEB_API static u32 const web_prototype_slot;
+
     static void define_unforgeable_attributes(JS::Realm&, JS::Object&);
 
     explicit @prototype_class@(JS::Realm&);
@@ -5581,6 +5586,7 @@ void generate_iterator_prototype_header(IDL::Interface const& interface, StringB
 #pragma once
 
 #include <LibJS/Runtime/Object.h>
+#include <LibWeb/Export.h>
 
 namespace Web::Bindings {
 
@@ -5588,6 +5594,9 @@ class @prototype_class@ : public JS::Object {
     JS_OBJECT(@prototype_class@, JS::Object);
     GC_DECLARE_ALLOCATOR(@prototype_class@);
 public:
+    // Assigned by GenerateWindowOrWorkerInterfaces, see Intrinsics::ensure_web_prototype().
+    WEB_API static u32 const web_prototype_slot;
+
     explicit @prototype_class@(JS::Realm&);
     virtual void initialize(JS::Realm&) override;
     virtual ~@prototype_class@() override;
@@ -5684,6 +5693,7 @@ void generate_async_iterator_prototype_header(IDL::Interface const& interface, S
 #pragma once
 
 #include <LibJS/Runtime/Object.h>
+#include <LibWeb/Export.h>
 
 namespace Web::Bindings {
 
@@ -5692,6 +5702,9 @@ class @prototype_class@ : public JS::Object {
     GC_DECLARE_ALLOCATOR(@prototype_class@);
 
 public:
+    // Assigned by GenerateWindowOrWorkerInterfaces, see Intrinsics::ensure_web_prototype().
+    WEB_API static u32 const web_prototype_slot;
+
     explicit @prototype_class@(JS::Realm&);
     virtual void initialize(JS::Realm&) override;
     virtual ~@prototype_class@() override;
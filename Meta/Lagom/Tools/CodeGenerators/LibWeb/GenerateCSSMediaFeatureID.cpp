@@ -44,6 +44,7 @@ ErrorOr<void> generate_header_file(JsonObject& media_feature_data, Core::File& f
     SourceGenerator generator { builder };
 
     generator.set("media_feature_id_underlying_type", underlying_type_for_enum(media_feature_data.size()));
+    generator.set("media_feature_id_count", String::number(media_feature_data.size()));
 
     generator.append(R"~~~(#pragma once
 
@@ -73,6 +74,8 @@ enum class MediaFeatureID : @media_feature_id_underlying_type@ {)~~~");
     generator.append(R"~~~(
 };
 
+constexpr size_t number_of_media_feature_ids = @media_feature_id_count@;
+
 Optional<MediaFeatureID> media_feature_id_from_string(StringView);
 StringView string_from_media_feature_id(MediaFeatureID);
 
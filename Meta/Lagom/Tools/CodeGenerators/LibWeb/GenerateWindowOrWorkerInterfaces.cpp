@@ -102,12 +102,50 @@ static ErrorOr<void> generate_intrinsic_definitions(StringView output_path, Inte
                 gen.append(R"~~~(
 #include <LibWeb/Bindings/@legacy_constructor_class@.h>)~~~");
             }
+
+            gen.set("interface_name", interface.name);
+            if (interface.pair_iterator_types.has_value()) {
+                gen.append(R"~~~(
+#include <LibWeb/Bindings/@interface_name@IteratorPrototype.h>)~~~");
+            }
+            if (interface.async_value_iterator_type.has_value()) {
+                gen.append(R"~~~(
+#include <LibWeb/Bindings/@interface_name@AsyncIteratorPrototype.h>)~~~");
+            }
         }
     }
 
     generator.append(R"~~~(
 
 namespace Web::Bindings {
+)~~~");
+
+    // Give every prototype class a slot of its own in the intrinsics of a realm, so that looking them up doesn't have to
+    // hash the name of their interface.
+    u32 prototype_slot_count = 0;
+    auto add_prototype_slot = [&](StringView prototype_class) {
+        auto gen = generator.fork();
+        gen.set("prototype_class", prototype_class);
+        gen.set("prototype_slot", String::number(prototype_slot_count++));
+        gen.append(R"~~~(
+u32 const @prototype_class@::web_prototype_slot = @prototype_slot@;)~~~");
+    };
+
+    for (auto& interface : interface_sets.intrinsics) {
+        if (interface.is_namespace)
+            continue;
+
+        add_prototype_slot(interface.prototype_class);
+        if (interface.pair_iterator_types.has_value())
+            add_prototype_slot(ByteString::formatted("{}IteratorPrototype", interface.name));
+        if (interface.async_value_iterator_type.has_value())
+            add_prototype_slot(ByteString::formatted("{}AsyncIteratorPrototype", interface.name));
+    }
+
+    generator.set("prototype_slot_count", String::number(prototype_slot_count));
+    generator.append(R"~~~(
+
+u32 const web_prototype_slot_count = @prototype_slot_count@;
 )~~~");
 
     auto add_namespace = [&](SourceGenerator& gen, StringView name, StringView namespace_class) {
@@ -227,7 +265,7 @@ WEB_API void Intrinsics::create_web_prototype_and_constructor<@prototype_class@>
         }
         gen.append(R"~~~(
     auto prototype = realm.create<@prototype_class@>(realm);
-    m_prototypes.set("@interface_name@"_fly_string, prototype);
+    set_web_prototype("@interface_name@"_fly_string, prototype);
 
     auto constructor = realm.create<@constructor_class@>(realm);
     m_constructors.set("@interface_name@"_fly_string, constructor);
@@ -7,7 +7,9 @@
 #include <AK/Debug.h>
 #include <AK/IDAllocator.h>
 #include <ImageDecoder/ConnectionFromClient.h>
+#include <ImageDecoder/DecodedImageCache.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
+#include <LibCore/Trace.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
@@ -17,6 +19,9 @@ namespace ImageDecoder {
 static HashMap<int, RefPtr<ConnectionFromClient>> s_connections;
 static IDAllocator s_client_ids;
 
+// Animations with more frames than this are decoded on demand, if the client asks for it.
+static constexpr u32 FRAMES_DECODED_UP_FRONT = 8;
+
 ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transport)
     : IPC::ConnectionFromClient<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint>(*this, move(transport), s_client_ids.allocate())
 {
@@ -30,6 +35,16 @@ void ConnectionFromClient::die()
     }
     m_pending_jobs.clear();
 
+    for (auto& [_, job] : m_pending_frames_jobs)
+        job->cancel();
+    m_pending_frames_jobs.clear();
+    m_animations.clear();
+
+    for (auto& [_, job] : m_pending_partial_image_jobs)
+        job->cancel();
+    m_pending_partial_image_jobs.clear();
+    m_incremental_decodes.clear();
+
     auto client_id = this->client_id();
     s_connections.remove(client_id);
     s_client_ids.deallocate(client_id);
@@ -69,6 +84,17 @@ ErrorOr<IPC::File> ConnectionFromClient::connect_new_client()
     return IPC::File::adopt_fd(socket_fds[1]);
 }
 
+Messages::ImageDecoderServer::GetDecodedImageCacheStatisticsResponse ConnectionFromClient::get_decoded_image_cache_statistics()
+{
+    auto statistics = DecodedImageCache::the().statistics();
+    return { statistics.hits, statistics.misses, statistics.evictions, statistics.entry_count, statistics.size_in_bytes };
+}
+
+void ConnectionFromClient::purge_decoded_image_cache()
+{
+    DecodedImageCache::the().evict_entries_beyond(0);
+}
+
 Messages::ImageDecoderServer::ConnectNewClientsResponse ConnectionFromClient::connect_new_clients(size_t count)
 {
     Vector<IPC::File> files;
@@ -84,11 +110,21 @@ Messages::ImageDecoderServer::ConnectNewClientsResponse ConnectionFromClient::co
     return files;
 }
 
-static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, Vector<RefPtr<Gfx::Bitmap>>& bitmaps, Vector<u32>& durations)
+template<typename Job>
+static ErrorOr<ConnectionFromClient::DecodedFrames> decode_frames_with_decoder(Job const& job, Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, size_t first_frame_index, size_t count)
 {
-    bitmaps.ensure_capacity(decoder.frame_count());
-    durations.ensure_capacity(decoder.frame_count());
-    for (size_t i = 0; i < decoder.frame_count(); ++i) {
+    auto end_frame_index = min(first_frame_index + count, decoder.frame_count());
+    if (first_frame_index >= end_frame_index)
+        return {};
+
+    Vector<RefPtr<Gfx::Bitmap>> bitmaps;
+    Vector<u32> durations;
+    bitmaps.ensure_capacity(end_frame_index - first_frame_index);
+    durations.ensure_capacity(end_frame_index - first_frame_index);
+    for (size_t i = first_frame_index; i < end_frame_index; ++i) {
+        if (job.is_canceled())
+            return Error::from_errno(ECANCELED);
+
         auto frame_or_error = decoder.frame(i, ideal_size);
         if (frame_or_error.is_error()) {
             bitmaps.unchecked_append({});
@@ -99,11 +135,34 @@ static void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder
             durations.unchecked_append(frame.duration);
         }
     }
+    return ConnectionFromClient::DecodedFrames { Gfx::BitmapSequence { move(bitmaps) }, move(durations) };
 }
 
-static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type)
+template<typename Job>
+static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Job const& job, Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type, bool decode_frames_on_demand)
 {
-    auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() }, known_mime_type));
+    // Jobs that were canceled while waiting in the queue don't need to do anything.
+    if (job.is_canceled())
+        return Error::from_errno(ECANCELED);
+
+    Core::TraceScope trace_scope("Decode image"sv);
+    if (trace_scope.is_enabled())
+        trace_scope.arguments().set("size"sv, encoded_buffer.size());
+
+    ReadonlyBytes encoded_data { encoded_buffer.data<u8>(), encoded_buffer.size() };
+
+    // Other clients are likely to have shown the same image already, e.g. a site's logo in every one of its tabs.
+    auto cache_key = DecodedImageCacheKey::create(encoded_data, ideal_size, known_mime_type);
+    if (auto entry = DecodedImageCache::the().find_entry(cache_key)) {
+        ConnectionFromClient::DecodeResult result;
+        result.frame_count = 1;
+        result.scale = entry->scale();
+        result.color_profile = entry->color_profile();
+        result.still_bitmap = entry->bitmap();
+        return result;
+    }
+
+    auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(encoded_data, known_mime_type));
 
     if (!decoder)
         return Error::from_string_literal("Could not find suitable image decoder plugin for data");
@@ -114,14 +173,13 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
     ConnectionFromClient::DecodeResult result;
     result.is_animated = decoder->is_animated();
     result.loop_count = decoder->loop_count();
+    result.frame_count = decoder->frame_count();
 
     if (auto maybe_icc_data = decoder->color_space(); !maybe_icc_data.is_error())
         result.color_profile = maybe_icc_data.value();
     else
         dbgln("Invalid color profile: {}", maybe_icc_data.error());
 
-    Vector<RefPtr<Gfx::Bitmap>> bitmaps;
-
     if (auto maybe_metadata = decoder->metadata(); maybe_metadata.has_value() && is<Gfx::ExifMetadata>(*maybe_metadata)) {
         auto const& exif = static_cast<Gfx::ExifMetadata const&>(maybe_metadata.value());
         if (exif.x_resolution().has_value() && exif.y_resolution().has_value()) {
@@ -134,35 +192,71 @@ static ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core:
         }
     }
 
-    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), bitmaps, result.durations);
+    // Keep the decoder around for animations that are too large to decode up front, so that the client can ask for the
+    // rest of the frames as it needs them.
+    auto frames_to_decode = result.frame_count;
+    if (decode_frames_on_demand && result.is_animated && result.frame_count > FRAMES_DECODED_UP_FRONT) {
+        frames_to_decode = FRAMES_DECODED_UP_FRONT;
+        result.animation = adopt_ref(*new ConnectionFromClient::Animation(encoded_buffer, decoder.release_nonnull(), ideal_size));
+    }
+
+    result.frames = TRY(decode_frames_with_decoder(job, result.animation ? *result.animation->decoder : *decoder, ideal_size, 0, frames_to_decode));
 
-    if (bitmaps.is_empty())
+    if (result.frames.bitmaps.bitmaps.is_empty())
         return Error::from_string_literal("Could not decode image");
 
-    result.bitmaps = Gfx::BitmapSequence { move(bitmaps) };
+    // Clients may map a still image read-only, so it has to be in the alpha type they would otherwise convert it to.
+    if (!result.is_animated && result.frame_count == 1 && result.frames.bitmaps.bitmaps.first()) {
+        auto const& bitmap = *result.frames.bitmaps.bitmaps.first();
+        if (DecodedImageCache::can_hold_entry_of_size(bitmap.size_in_bytes())) {
+            auto shared_bitmap = TRY(bitmap.to_bitmap_backed_by_anonymous_buffer());
+            shared_bitmap->set_alpha_type_destructive(Gfx::AlphaType::Premultiplied);
+            DecodedImageCache::the().create_entry(move(cache_key), DecodedImageCacheEntry::create(shared_bitmap, result.scale, result.color_profile));
+            result.still_bitmap = move(shared_bitmap);
+            result.frames = {};
+        }
+    }
 
     return result;
 }
 
-NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image_job(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image_job(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, bool decode_frames_on_demand, Threading::TaskPriority priority)
 {
     return Job::construct(
-        [encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type)](auto&) -> ErrorOr<DecodeResult> {
-            return TRY(decode_image_to_details(encoded_buffer, ideal_size, mime_type));
+        [encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type), decode_frames_on_demand](auto& job) -> ErrorOr<DecodeResult> {
+            return TRY(decode_image_to_details(job, encoded_buffer, ideal_size, mime_type, decode_frames_on_demand));
         },
         [strong_this = NonnullRefPtr(*this), image_id](DecodeResult result) -> ErrorOr<void> {
-            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, move(result.bitmaps), move(result.durations), result.scale, move(result.color_profile));
+            if (result.animation)
+                strong_this->m_animations.set(image_id, result.animation.release_nonnull());
+            if (result.still_bitmap)
+                strong_this->async_did_decode_still_image(image_id, Gfx::ShareableBitmap { result.still_bitmap.release_nonnull(), Gfx::ShareableBitmap::ConstructWithKnownGoodBitmap, Gfx::ShareableBitmap::Access::ReadOnly }, result.scale, move(result.color_profile));
+            else
+                strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, result.frame_count, move(result.frames.bitmaps), move(result.frames.durations), result.scale, move(result.color_profile));
             strong_this->m_pending_jobs.remove(image_id);
             return {};
         },
         [strong_this = NonnullRefPtr(*this), image_id](Error error) -> void {
+            // Canceled jobs report back from the background thread, and nobody is waiting for them anymore.
+            if (error.is_errno() && error.code() == ECANCELED)
+                return;
             if (strong_this->is_open())
                 strong_this->async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", error)));
             strong_this->m_pending_jobs.remove(image_id);
-        });
+        },
+        priority);
 }
 
-Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+static Threading::TaskPriority validated_priority(Threading::TaskPriority priority)
+{
+    if (to_underlying(priority) > to_underlying(Threading::TaskPriority::Background)) {
+        dbgln("Invalid decoding priority {}", to_underlying(priority));
+        return Threading::TaskPriority::Default;
+    }
+    return priority;
+}
+
+Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, bool decode_frames_on_demand, Threading::TaskPriority priority)
 {
     auto image_id = m_next_image_id++;
 
@@ -172,7 +266,7 @@ Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_i
         return image_id;
     }
 
-    m_pending_jobs.set(image_id, make_decode_image_job(image_id, move(encoded_buffer), ideal_size, move(mime_type)));
+    m_pending_jobs.set(image_id, make_decode_image_job(image_id, move(encoded_buffer), ideal_size, move(mime_type), decode_frames_on_demand, validated_priority(priority)));
 
     return image_id;
 }
@@ -184,4 +278,146 @@ void ConnectionFromClient::cancel_decoding(i64 image_id)
     }
 }
 
+Messages::ImageDecoderServer::BeginIncrementalDecodeResponse ConnectionFromClient::begin_incremental_decode(Threading::TaskPriority priority)
+{
+    auto image_id = m_next_image_id++;
+    m_incremental_decodes.set(image_id, adopt_ref(*new IncrementalDecode(validated_priority(priority))));
+    return image_id;
+}
+
+void ConnectionFromClient::append_incremental_decode_data(i64 image_id, ByteBuffer data)
+{
+    auto incremental_decode = m_incremental_decodes.get(image_id);
+    if (!incremental_decode.has_value())
+        return;
+
+    {
+        Threading::MutexLocker locker((*incremental_decode)->mutex);
+        if (auto result = (*incremental_decode)->pending_data.try_append(data); result.is_error()) {
+            dbgln("Failed to queue incremental decode data: {}", result.error());
+            end_incremental_decode(image_id);
+            return;
+        }
+    }
+
+    if (!m_pending_partial_image_jobs.contains(image_id))
+        start_partial_image_job(image_id, *incremental_decode);
+}
+
+void ConnectionFromClient::start_partial_image_job(i64 image_id, NonnullRefPtr<IncrementalDecode> incremental_decode)
+{
+    auto priority = incremental_decode->priority;
+    auto job = PartialImageJob::construct(
+        [incremental_decode](auto& job) -> ErrorOr<RefPtr<Gfx::Bitmap>> {
+            if (job.is_canceled())
+                return Error::from_errno(ECANCELED);
+
+            ByteBuffer data;
+            {
+                Threading::MutexLocker locker(incremental_decode->mutex);
+                data = exchange(incremental_decode->pending_data, {});
+            }
+
+            auto& decode = *incremental_decode;
+            if (!decode.decoder) {
+                TRY(decode.initial_data.try_append(data));
+                if (decode.initial_data.size() < Gfx::ImageDecoder::INCREMENTAL_SNIFF_BYTES)
+                    return RefPtr<Gfx::Bitmap> {};
+
+                decode.decoder = TRY(Gfx::ImageDecoder::try_create_incremental_for_initial_bytes(decode.initial_data));
+                if (!decode.decoder)
+                    return Error::from_string_literal("Image format can't be decoded incrementally");
+                data = exchange(decode.initial_data, {});
+            }
+
+            // Only send a new image when there is something new to see.
+            auto previous_progress = decode.decoder->progress();
+            TRY(decode.decoder->append(data));
+            if (decode.decoder->progress() == previous_progress)
+                return RefPtr<Gfx::Bitmap> {};
+            return TRY(decode.decoder->partial_bitmap());
+        },
+        [strong_this = NonnullRefPtr(*this), image_id, incremental_decode](RefPtr<Gfx::Bitmap> bitmap) -> ErrorOr<void> {
+            strong_this->m_pending_partial_image_jobs.remove(image_id);
+            if (!strong_this->m_incremental_decodes.contains(image_id))
+                return {};
+
+            if (bitmap) {
+                Vector<RefPtr<Gfx::Bitmap>> bitmaps;
+                bitmaps.append(move(bitmap));
+                strong_this->async_did_decode_partial_image(image_id, Gfx::BitmapSequence { move(bitmaps) });
+            }
+
+            // Pick up whatever arrived while we were decoding.
+            bool has_pending_data = false;
+            {
+                Threading::MutexLocker locker(incremental_decode->mutex);
+                has_pending_data = !incremental_decode->pending_data.is_empty();
+            }
+            if (has_pending_data)
+                strong_this->start_partial_image_job(image_id, incremental_decode);
+            return {};
+        },
+        [strong_this = NonnullRefPtr(*this), image_id](Error error) -> void {
+            // Canceled jobs report back from the background thread, and nobody is waiting for them anymore.
+            if (error.is_errno() && error.code() == ECANCELED)
+                return;
+
+            // The client will still get the complete image once all of its data has arrived, just not before that.
+            dbgln_if(IMAGE_DECODER_DEBUG, "Incremental decode of image {} stopped: {}", image_id, error);
+            strong_this->m_pending_partial_image_jobs.remove(image_id);
+            strong_this->m_incremental_decodes.remove(image_id);
+        },
+        priority);
+    m_pending_partial_image_jobs.set(image_id, move(job));
+}
+
+void ConnectionFromClient::end_incremental_decode(i64 image_id)
+{
+    if (auto job = m_pending_partial_image_jobs.take(image_id); job.has_value())
+        job.value()->cancel();
+    m_incremental_decodes.remove(image_id);
+}
+
+void ConnectionFromClient::request_animation_frames(i64 image_id, u32 first_frame_index, u32 count)
+{
+    auto animation = m_animations.get(image_id);
+    if (!animation.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "No animation with ID {}", image_id);
+        async_did_decode_animation_frames(image_id, first_frame_index, {}, {});
+        return;
+    }
+
+    auto job = FramesJob::construct(
+        [animation = *animation, first_frame_index, count](auto& job) -> ErrorOr<DecodedFrames> {
+            Threading::MutexLocker locker(animation->mutex);
+            return decode_frames_with_decoder(job, *animation->decoder, animation->ideal_size, first_frame_index, count);
+        },
+        [strong_this = NonnullRefPtr(*this), image_id, first_frame_index](DecodedFrames frames) -> ErrorOr<void> {
+            strong_this->async_did_decode_animation_frames(image_id, first_frame_index, move(frames.bitmaps), move(frames.durations));
+            strong_this->m_pending_frames_jobs.remove(image_id);
+            return {};
+        },
+        [strong_this = NonnullRefPtr(*this), image_id, first_frame_index](Error error) -> void {
+            // Canceled jobs report back from the background thread, and nobody is waiting for them anymore.
+            if (error.is_errno() && error.code() == ECANCELED)
+                return;
+            if (strong_this->is_open()) {
+                dbgln("Failed to decode animation frames: {}", error);
+                strong_this->async_did_decode_animation_frames(image_id, first_frame_index, {}, {});
+            }
+            strong_this->m_pending_frames_jobs.remove(image_id);
+        },
+        // The client asks for frames shortly before it needs to display them.
+        Threading::TaskPriority::UserBlocking);
+    m_pending_frames_jobs.set(image_id, move(job));
+}
+
+void ConnectionFromClient::release_animation(i64 image_id)
+{
+    if (auto job = m_pending_frames_jobs.take(image_id); job.has_value())
+        job.value()->cancel();
+    m_animations.remove(image_id);
+}
+
 }
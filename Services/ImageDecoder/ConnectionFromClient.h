@@ -6,14 +6,18 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/HashMap.h>
 #include <ImageDecoder/Forward.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibGfx/BitmapSequence.h>
 #include <LibGfx/ColorSpace.h>
+#include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibThreading/BackgroundAction.h>
+#include <LibThreading/Mutex.h>
 
 namespace ImageDecoder {
 
@@ -26,31 +30,91 @@ public:
 
     virtual void die() override;
 
+    // An animated image whose frames are decoded as the client asks for them. The decoder reads from encoded_data,
+    // and may only be used by one job at a time.
+    struct Animation : public RefCounted<Animation> {
+        Core::AnonymousBuffer encoded_data;
+        NonnullRefPtr<Gfx::ImageDecoder> decoder;
+        Optional<Gfx::IntSize> ideal_size;
+        Threading::Mutex mutex;
+
+        Animation(Core::AnonymousBuffer encoded_data, NonnullRefPtr<Gfx::ImageDecoder> decoder, Optional<Gfx::IntSize> ideal_size)
+            : encoded_data(move(encoded_data))
+            , decoder(move(decoder))
+            , ideal_size(move(ideal_size))
+        {
+        }
+    };
+
+    // An image that is decoded while its data is still arriving, so that the client can show it early. Only one job
+    // at a time decodes it; data that arrives in the meantime is queued up for the next one.
+    struct IncrementalDecode : public RefCounted<IncrementalDecode> {
+        Threading::TaskPriority priority;
+
+        Threading::Mutex mutex;
+        ByteBuffer pending_data;
+
+        // Only used by the job.
+        ByteBuffer initial_data;
+        OwnPtr<Gfx::IncrementalImageDecoderPlugin> decoder;
+
+        explicit IncrementalDecode(Threading::TaskPriority priority)
+            : priority(priority)
+        {
+        }
+    };
+
+    struct DecodedFrames {
+        Gfx::BitmapSequence bitmaps;
+        Vector<u32> durations;
+    };
+
     struct DecodeResult {
         bool is_animated = false;
         u32 loop_count = 0;
+        u32 frame_count = 0;
         Gfx::FloatPoint scale { 1, 1 };
-        Gfx::BitmapSequence bitmaps;
-        Vector<u32> durations;
+        DecodedFrames frames;
         Gfx::ColorSpace color_profile;
+        RefPtr<Animation> animation;
+
+        // Still images are shared with other clients through the DecodedImageCache rather than copied into frames.
+        RefPtr<Gfx::Bitmap> still_bitmap;
     };
 
 private:
     using Job = Threading::BackgroundAction<DecodeResult>;
+    using FramesJob = Threading::BackgroundAction<DecodedFrames>;
+    using PartialImageJob = Threading::BackgroundAction<RefPtr<Gfx::Bitmap>>;
 
     explicit ConnectionFromClient(NonnullOwnPtr<IPC::Transport>);
 
-    virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type) override;
+    virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, bool decode_frames_on_demand, Threading::TaskPriority) override;
     virtual void cancel_decoding(i64 image_id) override;
+    virtual Messages::ImageDecoderServer::BeginIncrementalDecodeResponse begin_incremental_decode(Threading::TaskPriority) override;
+    virtual void append_incremental_decode_data(i64 image_id, ByteBuffer data) override;
+    virtual void end_incremental_decode(i64 image_id) override;
+    virtual void request_animation_frames(i64 image_id, u32 first_frame_index, u32 count) override;
+    virtual void release_animation(i64 image_id) override;
+    virtual Messages::ImageDecoderServer::GetDecodedImageCacheStatisticsResponse get_decoded_image_cache_statistics() override;
+    virtual void purge_decoded_image_cache() override;
     virtual Messages::ImageDecoderServer::ConnectNewClientsResponse connect_new_clients(size_t count) override;
     virtual Messages::ImageDecoderServer::InitTransportResponse init_transport(int peer_pid) override;
 
     ErrorOr<IPC::File> connect_new_client();
 
-    NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
+    NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, bool decode_frames_on_demand, Threading::TaskPriority);
+
+    void start_partial_image_job(i64 image_id, NonnullRefPtr<IncrementalDecode>);
 
     i64 m_next_image_id { 0 };
     HashMap<i64, NonnullRefPtr<Job>> m_pending_jobs;
+
+    HashMap<i64, NonnullRefPtr<Animation>> m_animations;
+    HashMap<i64, NonnullRefPtr<FramesJob>> m_pending_frames_jobs;
+
+    HashMap<i64, NonnullRefPtr<IncrementalDecode>> m_incremental_decodes;
+    HashMap<i64, NonnullRefPtr<PartialImageJob>> m_pending_partial_image_jobs;
 };
 
 }
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteReader.h>
+#include <AK/NeverDestroyed.h>
+#include <ImageDecoder/DecodedImageCache.h>
+
+namespace ImageDecoder {
+
+DecodedImageCacheKey DecodedImageCacheKey::create(ReadonlyBytes encoded_data, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+{
+    return {
+        .content_hash = Crypto::Hash::SHA256::hash(encoded_data),
+        .ideal_size = ideal_size,
+        .mime_type = move(mime_type),
+    };
+}
+
+u64 DecodedImageCacheKey::hash() const
+{
+    // The content hash is already uniformly distributed, so any part of it will do.
+    u64 hash = ByteReader::load64(content_hash.immutable_data());
+    if (ideal_size.has_value())
+        hash = pair_int_hash(hash, Traits<Gfx::IntSize>::hash(*ideal_size));
+    if (mime_type.has_value())
+        hash = pair_int_hash(hash, mime_type->hash());
+    return hash;
+}
+
+NonnullRefPtr<DecodedImageCacheEntry> DecodedImageCacheEntry::create(NonnullRefPtr<Gfx::Bitmap> bitmap, Gfx::FloatPoint scale, Gfx::ColorSpace color_profile)
+{
+    return adopt_ref(*new DecodedImageCacheEntry { move(bitmap), scale, move(color_profile) });
+}
+
+DecodedImageCacheEntry::DecodedImageCacheEntry(NonnullRefPtr<Gfx::Bitmap> bitmap, Gfx::FloatPoint scale, Gfx::ColorSpace color_profile)
+    : m_bitmap(move(bitmap))
+    , m_scale(scale)
+    , m_color_profile(move(color_profile))
+{
+    VERIFY(m_bitmap->anonymous_buffer().is_valid());
+    VERIFY(m_bitmap->alpha_type() == Gfx::AlphaType::Premultiplied);
+}
+
+DecodedImageCache& DecodedImageCache::the()
+{
+    static NeverDestroyed<DecodedImageCache> s_the;
+    return *s_the;
+}
+
+RefPtr<DecodedImageCacheEntry const> DecodedImageCache::find_entry(DecodedImageCacheKey const& key)
+{
+    Threading::MutexLocker locker(m_mutex);
+
+    auto entry = m_entries.get(key.hash());
+    if (!entry.has_value() || (*entry)->m_key != key) {
+        ++m_statistics.misses;
+        return {};
+    }
+
+    // Move the entry to the most recently used end of the list.
+    m_lru_list.remove(**entry);
+    m_lru_list.append(**entry);
+
+    ++m_statistics.hits;
+    return *entry;
+}
+
+void DecodedImageCache::create_entry(DecodedImageCacheKey key, NonnullRefPtr<DecodedImageCacheEntry> entry)
+{
+    if (!can_hold_entry_of_size(entry->size()))
+        return;
+
+    Threading::MutexLocker locker(m_mutex);
+
+    auto hash = key.hash();
+    if (auto existing_entry = m_entries.get(hash); existing_entry.has_value())
+        remove_entry(**existing_entry);
+
+    while (m_size + entry->size() > MAXIMUM_SIZE) {
+        remove_entry(*m_lru_list.first());
+        ++m_statistics.evictions;
+    }
+
+    entry->m_key = move(key);
+    m_size += entry->size();
+
+    m_lru_list.append(*entry);
+    m_entries.set(hash, move(entry));
+}
+
+void DecodedImageCache::evict_entries_beyond(size_t size)
+{
+    Threading::MutexLocker locker(m_mutex);
+
+    while (m_size > size) {
+        remove_entry(*m_lru_list.first());
+        ++m_statistics.evictions;
+    }
+}
+
+void DecodedImageCache::remove_entry(DecodedImageCacheEntry& entry)
+{
+    m_lru_list.remove(entry);
+    m_size -= entry.size();
+    m_entries.remove(entry.m_key->hash());
+}
+
+DecodedImageCache::Statistics DecodedImageCache::statistics() const
+{
+    Threading::MutexLocker locker(m_mutex);
+
+    auto statistics = m_statistics;
+    statistics.entry_count = m_entries.size();
+    statistics.size_in_bytes = m_size;
+    return statistics;
+}
+
+}
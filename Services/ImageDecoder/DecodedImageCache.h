@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/RefCounted.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/ColorSpace.h>
+#include <LibGfx/Point.h>
+#include <LibGfx/Size.h>
+#include <LibThreading/Mutex.h>
+
+namespace ImageDecoder {
+
+struct DecodedImageCacheKey {
+    // A cryptographic hash, since a collision would show one site's image on another.
+    Crypto::Hash::SHA256::DigestType content_hash;
+    Optional<Gfx::IntSize> ideal_size;
+    Optional<ByteString> mime_type;
+
+    static DecodedImageCacheKey create(ReadonlyBytes encoded_data, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
+
+    bool operator==(DecodedImageCacheKey const&) const = default;
+    u64 hash() const;
+};
+
+class DecodedImageCacheEntry : public RefCounted<DecodedImageCacheEntry> {
+public:
+    // The bitmap must be backed by an anonymous buffer, and premultiplied so that nobody needs to convert it in place.
+    static NonnullRefPtr<DecodedImageCacheEntry> create(NonnullRefPtr<Gfx::Bitmap>, Gfx::FloatPoint scale, Gfx::ColorSpace color_profile);
+
+    NonnullRefPtr<Gfx::Bitmap> const& bitmap() const { return m_bitmap; }
+    Gfx::FloatPoint scale() const { return m_scale; }
+    Gfx::ColorSpace const& color_profile() const { return m_color_profile; }
+
+    size_t size() const { return m_bitmap->size_in_bytes(); }
+
+private:
+    friend class DecodedImageCache;
+
+    DecodedImageCacheEntry(NonnullRefPtr<Gfx::Bitmap>, Gfx::FloatPoint scale, Gfx::ColorSpace color_profile);
+
+    NonnullRefPtr<Gfx::Bitmap> m_bitmap;
+    Gfx::FloatPoint m_scale;
+    Gfx::ColorSpace m_color_profile;
+
+    Optional<DecodedImageCacheKey> m_key;
+    IntrusiveListNode<DecodedImageCacheEntry> m_list_node;
+};
+
+// A bounded, least-recently-used set of decoded still images, shared by every client of the ImageDecoder process. Their
+// bitmaps live in shared memory that is handed out to clients read-only, so an image that is shown by several
+// WebContent processes is decoded and stored only once. It is used from decoding jobs, so it is thread-safe.
+class DecodedImageCache {
+    AK_MAKE_NONCOPYABLE(DecodedImageCache);
+    AK_MAKE_NONMOVABLE(DecodedImageCache);
+
+public:
+    static constexpr size_t MAXIMUM_ENTRY_SIZE = 32 * MiB;
+    static constexpr size_t MAXIMUM_SIZE = 128 * MiB;
+
+    struct Statistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+        u64 entry_count { 0 };
+        u64 size_in_bytes { 0 };
+    };
+
+    static DecodedImageCache& the();
+
+    static bool can_hold_entry_of_size(size_t size) { return size <= MAXIMUM_ENTRY_SIZE; }
+
+    RefPtr<DecodedImageCacheEntry const> find_entry(DecodedImageCacheKey const&);
+    void create_entry(DecodedImageCacheKey, NonnullRefPtr<DecodedImageCacheEntry>);
+
+    // Drops entries until the cache is no larger than the given size, e.g. when the system is low on memory. Clients
+    // keep the bitmaps they were given.
+    void evict_entries_beyond(size_t size);
+
+    Statistics statistics() const;
+
+private:
+    DecodedImageCache() = default;
+
+    void remove_entry(DecodedImageCacheEntry&);
+
+    mutable Threading::Mutex m_mutex;
+
+    HashMap<u64, NonnullRefPtr<DecodedImageCacheEntry>> m_entries;
+    IntrusiveList<&DecodedImageCacheEntry::m_list_node> m_lru_list;
+    size_t m_size { 0 };
+
+    Statistics m_statistics;
+};
+
+}
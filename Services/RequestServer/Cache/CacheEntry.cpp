@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ConstrainedStream.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonArraySerializer.h>
 #include <AK/JsonObject.h>
@@ -20,10 +21,7 @@
 
 namespace RequestServer {
 
-static LexicalPath path_for_cache_key(LexicalPath const& cache_directory, u64 cache_key)
-{
-    return cache_directory.append(MUST(String::formatted("{:016x}", cache_key)));
-}
+static constexpr size_t DECOMPRESSED_DATA_BUFFER_SIZE = 64 * KiB;
 
 ErrorOr<CacheHeader> CacheHeader::read_from_stream(Stream& stream)
 {
@@ -37,6 +35,7 @@ ErrorOr<CacheHeader> CacheHeader::read_from_stream(Stream& stream)
     header.reason_phrase_hash = TRY(stream.read_value<u32>());
     header.headers_size = TRY(stream.read_value<u32>());
     header.headers_hash = TRY(stream.read_value<u32>());
+    header.data_encoding = static_cast<CacheDataEncoding>(TRY(stream.read_value<u32>()));
     return header;
 }
 
@@ -51,6 +50,7 @@ ErrorOr<void> CacheHeader::write_to_stream(Stream& stream) const
     TRY(stream.write_value(reason_phrase_hash));
     TRY(stream.write_value(headers_size));
     TRY(stream.write_value(headers_hash));
+    TRY(stream.write_value(to_underlying(data_encoding)));
     return {};
 }
 
@@ -69,6 +69,27 @@ ErrorOr<CacheFooter> CacheFooter::read_from_stream(Stream& stream)
     return footer;
 }
 
+static ErrorOr<ByteString> serialize_headers_for_storage(HTTP::HeaderMap const& headers, HTTP::HeaderMap& stored_headers)
+{
+    StringBuilder builder;
+    auto headers_serializer = TRY(JsonArraySerializer<>::try_create(builder));
+
+    for (auto const& header : headers.headers()) {
+        if (is_header_exempted_from_storage(header.name))
+            continue;
+
+        auto header_serializer = TRY(headers_serializer.add_object());
+        TRY(header_serializer.add("name"sv, header.name));
+        TRY(header_serializer.add("value"sv, header.value));
+        TRY(header_serializer.finish());
+
+        stored_headers.set(header.name, header.value);
+    }
+
+    TRY(headers_serializer.finish());
+    return builder.to_byte_string();
+}
+
 CacheEntry::CacheEntry(DiskCache& disk_cache, CacheIndex& index, u64 cache_key, String url, LexicalPath path, CacheHeader cache_header)
     : m_disk_cache(disk_cache)
     , m_index(index)
@@ -83,6 +104,7 @@ void CacheEntry::remove()
 {
     (void)FileSystem::remove(m_path.string(), FileSystem::RecursionMode::Disallowed);
     m_index.remove_entry(m_cache_key);
+    m_disk_cache.memory_cache().remove_entry(m_cache_key);
 }
 
 void CacheEntry::close_and_destory_cache_entry()
@@ -98,22 +120,11 @@ ErrorOr<NonnullOwnPtr<CacheEntryWriter>> CacheEntryWriter::create(DiskCache& dis
     auto file = TRY(Core::OutputBufferedFile::create(move(unbuffered_file)));
 
     CacheHeader cache_header;
+    HTTP::HeaderMap stored_headers;
+    OwnPtr<Compress::ZlibCompressor> compressor;
 
     auto result = [&]() -> ErrorOr<void> {
-        StringBuilder builder;
-        auto headers_serializer = TRY(JsonArraySerializer<>::try_create(builder));
-
-        for (auto const& header : headers.headers()) {
-            if (is_header_exempted_from_storage(header.name))
-                continue;
-
-            auto header_serializer = TRY(headers_serializer.add_object());
-            TRY(header_serializer.add("name"sv, header.name));
-            TRY(header_serializer.add("value"sv, header.value));
-            TRY(header_serializer.finish());
-        }
-
-        TRY(headers_serializer.finish());
+        auto serialized_headers = TRY(serialize_headers_for_storage(headers, stored_headers));
 
         cache_header.url_size = url.byte_count();
         cache_header.url_hash = url.hash();
@@ -122,9 +133,8 @@ ErrorOr<NonnullOwnPtr<CacheEntryWriter>> CacheEntryWriter::create(DiskCache& dis
         cache_header.reason_phrase_size = reason_phrase.has_value() ? reason_phrase->byte_count() : 0;
         cache_header.reason_phrase_hash = reason_phrase.has_value() ? reason_phrase->hash() : 0;
 
-        auto serialized_headers = builder.string_view();
         cache_header.headers_size = serialized_headers.length();
-        cache_header.headers_hash = serialized_headers.hash();
+        cache_header.headers_hash = serialized_headers.view().hash();
 
         TRY(file->write_value(cache_header));
         TRY(file->write_until_depleted(url));
@@ -132,6 +142,11 @@ ErrorOr<NonnullOwnPtr<CacheEntryWriter>> CacheEntryWriter::create(DiskCache& dis
             TRY(file->write_until_depleted(*reason_phrase));
         TRY(file->write_until_depleted(serialized_headers));
 
+        if (should_compress_for_storage(headers)) {
+            cache_header.data_encoding = CacheDataEncoding::Zlib;
+            compressor = TRY(Compress::ZlibCompressor::create(MaybeOwned<Stream> { *file }, Compress::GenericZlibCompressionLevel::Fastest));
+        }
+
         return {};
     }();
 
@@ -140,12 +155,19 @@ ErrorOr<NonnullOwnPtr<CacheEntryWriter>> CacheEntryWriter::create(DiskCache& dis
         return result.release_error();
     }
 
-    return adopt_own(*new CacheEntryWriter { disk_cache, index, cache_key, move(url), path, move(file), cache_header, request_time });
+    auto data_offset = sizeof(CacheHeader) + cache_header.url_size + cache_header.reason_phrase_size + cache_header.headers_size;
+
+    return adopt_own(*new CacheEntryWriter { disk_cache, index, cache_key, move(url), path, move(file), move(compressor), cache_header, move(reason_phrase), move(stored_headers), request_time, data_offset });
 }
 
-CacheEntryWriter::CacheEntryWriter(DiskCache& disk_cache, CacheIndex& index, u64 cache_key, String url, LexicalPath path, NonnullOwnPtr<Core::OutputBufferedFile> file, CacheHeader cache_header, UnixDateTime request_time)
+CacheEntryWriter::CacheEntryWriter(DiskCache& disk_cache, CacheIndex& index, u64 cache_key, String url, LexicalPath path, NonnullOwnPtr<Core::OutputBufferedFile> file, OwnPtr<Compress::ZlibCompressor> compressor, CacheHeader cache_header, Optional<String> reason_phrase, HTTP::HeaderMap headers, UnixDateTime request_time, u64 data_offset)
     : CacheEntry(disk_cache, index, cache_key, move(url), move(path), cache_header)
     , m_file(move(file))
+    , m_compressor(move(compressor))
+    , m_data_offset(data_offset)
+    , m_reason_phrase(move(reason_phrase))
+    , m_headers(move(headers))
+    , m_data_for_memory_cache(ChainedBuffer {})
     , m_request_time(request_time)
     , m_response_time(UnixDateTime::now())
 {
@@ -158,7 +180,9 @@ ErrorOr<void> CacheEntryWriter::write_data(ReadonlyBytes data)
         return Error::from_string_literal("Cache entry has been deleted");
     }
 
-    if (auto result = m_file->write_until_depleted(data); result.is_error()) {
+    auto result = m_compressor ? m_compressor->write_until_depleted(data) : m_file->write_until_depleted(data);
+
+    if (result.is_error()) {
         dbgln("\033[31;1mUnable to write to cache entry for{}\033[0m {}: {}", m_url, result.error());
 
         remove();
@@ -167,7 +191,12 @@ ErrorOr<void> CacheEntryWriter::write_data(ReadonlyBytes data)
         return result.release_error();
     }
 
-    m_cache_footer.data_size += data.size();
+    m_decoded_data_size += data.size();
+
+    if (m_data_for_memory_cache.has_value()) {
+        if (!MemoryCache::can_hold_entry_of_size(m_decoded_data_size) || m_data_for_memory_cache->try_append(data).is_error())
+            m_data_for_memory_cache.clear();
+    }
 
     // FIXME: Update the crc.
 
@@ -182,7 +211,17 @@ ErrorOr<void> CacheEntryWriter::flush()
     if (m_marked_for_deletion)
         return Error::from_string_literal("Cache entry has been deleted");
 
-    if (auto result = m_file->write_value(m_cache_footer); result.is_error()) {
+    auto result = [&]() -> ErrorOr<void> {
+        if (m_compressor)
+            TRY(m_compressor->finish());
+
+        m_cache_footer.data_size = TRY(m_file->tell()) - m_data_offset;
+        TRY(m_file->write_value(m_cache_footer));
+
+        return {};
+    }();
+
+    if (result.is_error()) {
         dbgln("\033[31;1mUnable to flush cache entry for{}\033[0m {}: {}", m_url, result.error());
         remove();
 
@@ -191,7 +230,15 @@ ErrorOr<void> CacheEntryWriter::flush()
 
     m_index.create_entry(m_cache_key, m_url, m_cache_footer.data_size, m_request_time, m_response_time);
 
-    dbgln("\033[34;1mFinished caching\033[0m {} ({} bytes)", m_url, m_cache_footer.data_size);
+    // NOTE: Responses that have to be revalidated before each use are never served from the memory cache.
+    if (m_data_for_memory_cache.has_value() && !must_revalidate_before_use(m_headers)) {
+        if (auto data = m_data_for_memory_cache->coalesce(); !data.is_error()) {
+            auto memory_cache_entry = MemoryCacheEntry::create(m_cache_header.status_code, move(m_reason_phrase), move(m_headers), data.release_value(), m_request_time, m_response_time);
+            m_disk_cache.memory_cache().create_entry(m_cache_key, move(memory_cache_entry));
+        }
+    }
+
+    dbgln("\033[34;1mFinished caching\033[0m {} ({} bytes, {} bytes on disk)", m_url, m_decoded_data_size, m_cache_footer.data_size);
     return {};
 }
 
@@ -215,6 +262,8 @@ ErrorOr<NonnullOwnPtr<CacheEntryReader>> CacheEntryReader::create(DiskCache& dis
             return Error::from_string_literal("Magic value mismatch");
         if (cache_header.version != CacheHeader::CACHE_VERSION)
             return Error::from_string_literal("Version mismatch");
+        if (cache_header.data_encoding != CacheDataEncoding::Identity && cache_header.data_encoding != CacheDataEncoding::Zlib)
+            return Error::from_string_literal("Unknown data encoding");
 
         url = TRY(String::from_stream(*file, cache_header.url_size));
         if (url.hash() != cache_header.url_hash)
@@ -261,7 +310,22 @@ ErrorOr<NonnullOwnPtr<CacheEntryReader>> CacheEntryReader::create(DiskCache& dis
     return adopt_own(*new CacheEntryReader { disk_cache, index, cache_key, move(url), move(path), move(file), fd, cache_header, move(reason_phrase), move(headers), data_offset, data_size });
 }
 
-CacheEntryReader::CacheEntryReader(DiskCache& disk_cache, CacheIndex& index, u64 cache_key, String url, LexicalPath path, NonnullOwnPtr<Core::File> file, int fd, CacheHeader cache_header, Optional<String> reason_phrase, HTTP::HeaderMap header_map, u64 data_offset, u64 data_size)
+NonnullOwnPtr<CacheEntryReader> CacheEntryReader::create(DiskCache& disk_cache, CacheIndex& index, u64 cache_key, String url, NonnullRefPtr<MemoryCacheEntry const> memory_cache_entry)
+{
+    auto path = path_for_cache_key(disk_cache.cache_directory(), cache_key);
+
+    CacheHeader cache_header;
+    cache_header.status_code = memory_cache_entry->status_code();
+
+    auto data_size = memory_cache_entry->data().size();
+
+    auto cache_entry = adopt_own(*new CacheEntryReader { disk_cache, index, cache_key, move(url), move(path), nullptr, -1, cache_header, memory_cache_entry->reason_phrase(), memory_cache_entry->headers(), 0, data_size });
+    cache_entry->m_memory_cache_entry = move(memory_cache_entry);
+
+    return cache_entry;
+}
+
+CacheEntryReader::CacheEntryReader(DiskCache& disk_cache, CacheIndex& index, u64 cache_key, String url, LexicalPath path, OwnPtr<Core::File> file, int fd, CacheHeader cache_header, Optional<String> reason_phrase, HTTP::HeaderMap header_map, u64 data_offset, u64 data_size)
     : CacheEntry(disk_cache, index, cache_key, move(url), move(path), cache_header)
     , m_file(move(file))
     , m_fd(fd)
@@ -272,11 +336,110 @@ CacheEntryReader::CacheEntryReader(DiskCache& disk_cache, CacheIndex& index, u64
 {
 }
 
+ErrorOr<void> CacheEntryReader::load_into_memory_cache(UnixDateTime request_time, UnixDateTime response_time)
+{
+    VERIFY(m_file);
+    VERIFY(!m_memory_cache_entry);
+
+    ByteBuffer data;
+
+    if (m_cache_header.data_encoding == CacheDataEncoding::Zlib) {
+        auto decompressor = TRY(create_decompressor());
+        data = TRY(decompressor->read_until_eof());
+    } else {
+        data = TRY(ByteBuffer::create_uninitialized(m_data_size));
+
+        TRY(m_file->seek(m_data_offset, SeekMode::SetPosition));
+        TRY(m_file->read_until_filled(data));
+    }
+
+    TRY(read_and_validate_footer());
+
+    auto memory_cache_entry = MemoryCacheEntry::create(status_code(), m_reason_phrase, m_headers, move(data), request_time, response_time);
+    m_disk_cache.memory_cache().create_entry(m_cache_key, memory_cache_entry);
+
+    m_memory_cache_entry = move(memory_cache_entry);
+    return {};
+}
+
+ErrorOr<void> CacheEntryReader::update_headers(HTTP::HeaderMap const& response_headers)
+{
+    VERIFY(m_file);
+    VERIFY(!m_memory_cache_entry);
+
+    TRY(read_and_validate_footer());
+
+    HTTP::HeaderMap stored_headers;
+    auto serialized_headers = TRY(serialize_headers_for_storage(update_stored_headers(m_headers, response_headers), stored_headers));
+
+    auto cache_header = m_cache_header;
+    cache_header.headers_size = serialized_headers.length();
+    cache_header.headers_hash = serialized_headers.view().hash();
+
+    // NOTE: The updated entry is written to a separate file which then replaces the entry's file, so that the entry is
+    //       never seen in a partially written state. Files named like this are not in the index, and are removed as
+    //       orphans if we don't get to replace the entry's file with them.
+    auto temporary_path = m_path.parent().append(MUST(String::formatted("tmp-{}", m_path.basename())));
+
+    auto result = [&]() -> ErrorOr<void> {
+        auto unbuffered_file = TRY(Core::File::open(temporary_path.string(), Core::File::OpenMode::Write));
+        auto file = TRY(Core::OutputBufferedFile::create(move(unbuffered_file)));
+
+        TRY(file->write_value(cache_header));
+        TRY(file->write_until_depleted(m_url));
+        if (m_reason_phrase.has_value())
+            TRY(file->write_until_depleted(*m_reason_phrase));
+        TRY(file->write_until_depleted(serialized_headers));
+
+        TRY(m_file->seek(m_data_offset, SeekMode::SetPosition));
+        ConstrainedStream data_stream { MaybeOwned<Stream> { *m_file }, m_data_size };
+
+        auto buffer = TRY(ByteBuffer::create_uninitialized(min(m_data_size, DECOMPRESSED_DATA_BUFFER_SIZE)));
+
+        while (data_stream.remaining() != 0) {
+            auto data = TRY(data_stream.read_some(buffer));
+            if (data.is_empty())
+                return Error::from_string_literal("Unexpected end of cache entry data");
+
+            TRY(file->write_until_depleted(data));
+        }
+
+        TRY(file->write_value(m_cache_footer));
+        TRY(file->flush_buffer());
+
+        TRY(Core::System::rename(temporary_path.string(), m_path.string()));
+        return {};
+    }();
+
+    if (result.is_error()) {
+        (void)FileSystem::remove(temporary_path.string(), FileSystem::RecursionMode::Disallowed);
+        return result.release_error();
+    }
+
+    return {};
+}
+
+void CacheEntryReader::close()
+{
+    close_and_destory_cache_entry();
+}
+
 void CacheEntryReader::pipe_to(int pipe_fd, Function<void(u64)> on_complete, Function<void(u64)> on_error)
 {
     VERIFY(m_pipe_fd == -1);
     m_pipe_fd = pipe_fd;
 
+#if defined(AK_OS_LINUX)
+    // NOTE: Each transfer moves at most as much data as fits into the pipe. For large entries, we grow the pipe so that
+    //       the body can be moved in fewer splice() calls and event loop iterations. This is best-effort, as the kernel
+    //       limits how large unprivileged processes may make their pipes.
+    static constexpr u64 DEFAULT_PIPE_SIZE = 64 * KiB;
+    static constexpr u64 MAXIMUM_PIPE_SIZE = 1 * MiB;
+
+    if (m_data_size > DEFAULT_PIPE_SIZE)
+        (void)Core::System::fcntl(m_pipe_fd, F_SETPIPE_SZ, static_cast<int>(min(m_data_size, MAXIMUM_PIPE_SIZE)));
+#endif
+
     m_on_pipe_complete = move(on_complete);
     m_on_pipe_error = move(on_error);
 
@@ -285,6 +448,23 @@ void CacheEntryReader::pipe_to(int pipe_fd, Function<void(u64)> on_complete, Fun
         return;
     }
 
+    if (!m_memory_cache_entry && m_cache_header.data_encoding == CacheDataEncoding::Zlib) {
+        auto decompressor = create_decompressor();
+        if (decompressor.is_error()) {
+            pipe_error(decompressor.release_error());
+            return;
+        }
+
+        auto buffer = ByteBuffer::create_uninitialized(DECOMPRESSED_DATA_BUFFER_SIZE);
+        if (buffer.is_error()) {
+            pipe_error(buffer.release_error());
+            return;
+        }
+
+        m_decompressor = decompressor.release_value();
+        m_decompressed_data_buffer = buffer.release_value();
+    }
+
     m_pipe_write_notifier = Core::Notifier::construct(m_pipe_fd, Core::NotificationType::Write);
     m_pipe_write_notifier->set_enabled(false);
 
@@ -296,32 +476,84 @@ void CacheEntryReader::pipe_to(int pipe_fd, Function<void(u64)> on_complete, Fun
     pipe_without_blocking();
 }
 
+ErrorOr<NonnullOwnPtr<Compress::ZlibDecompressor>> CacheEntryReader::create_decompressor()
+{
+    VERIFY(m_file);
+    TRY(m_file->seek(m_data_offset, SeekMode::SetPosition));
+
+    // NOTE: The compressed data is followed by the footer, which must not be fed to the decompressor.
+    auto data_stream = TRY(try_make<ConstrainedStream>(MaybeOwned<Stream> { *m_file }, m_data_size));
+    return Compress::ZlibDecompressor::create(move(data_stream));
+}
+
+bool CacheEntryReader::has_piped_all_data() const
+{
+    if (m_decompressor)
+        return m_decompressor->is_eof() && m_pending_decompressed_data.is_empty();
+
+    // NOTE: Compressed entries that were loaded into the memory cache are served in their decompressed form.
+    if (m_memory_cache_entry)
+        return m_bytes_piped == m_memory_cache_entry->data().size();
+
+    return m_bytes_piped == m_data_size;
+}
+
 void CacheEntryReader::pipe_without_blocking()
 {
-    if (m_marked_for_deletion) {
-        pipe_error(Error::from_string_literal("Cache entry has been deleted"));
-        return;
-    }
+    while (true) {
+        if (m_marked_for_deletion) {
+            pipe_error(Error::from_string_literal("Cache entry has been deleted"));
+            return;
+        }
 
-    auto result = Core::System::transfer_file_through_pipe(m_fd, m_pipe_fd, m_data_offset + m_bytes_piped, m_data_size - m_bytes_piped);
+        if (has_piped_all_data()) {
+            pipe_complete();
+            return;
+        }
 
-    if (result.is_error()) {
-        if (result.error().code() != EAGAIN && result.error().code() != EWOULDBLOCK)
-            pipe_error(result.release_error());
-        else
-            m_pipe_write_notifier->set_enabled(true);
+        auto result = [&]() -> ErrorOr<size_t> {
+            if (m_memory_cache_entry)
+                return TRY(Core::System::write(m_pipe_fd, m_memory_cache_entry->data().slice(m_bytes_piped)));
+            if (m_decompressor)
+                return pipe_decompressed_data_without_blocking();
+            return Core::System::transfer_file_through_pipe(m_fd, m_pipe_fd, m_data_offset + m_bytes_piped, m_data_size - m_bytes_piped);
+        }();
+
+        if (result.is_error()) {
+            if (result.error().code() != EAGAIN && result.error().code() != EWOULDBLOCK)
+                pipe_error(result.release_error());
+            else
+                m_pipe_write_notifier->set_enabled(true);
+
+            return;
+        }
 
-        return;
-    }
+        if (result.value() == 0) {
+            if (has_piped_all_data())
+                continue;
 
-    m_bytes_piped += result.value();
+            pipe_error(Error::from_string_literal("Unexpected end of cache entry data"));
+            return;
+        }
 
-    if (m_bytes_piped == m_data_size) {
-        pipe_complete();
-        return;
+        m_bytes_piped += result.value();
     }
+}
 
-    pipe_without_blocking();
+ErrorOr<size_t> CacheEntryReader::pipe_decompressed_data_without_blocking()
+{
+    // NOTE: The pipe may not accept everything we decompress at once, so we hold on to whatever is left over until the
+    //       pipe is writable again.
+    while (m_pending_decompressed_data.is_empty() && !m_decompressor->is_eof())
+        m_pending_decompressed_data = TRY(m_decompressor->read_some(m_decompressed_data_buffer));
+
+    if (m_pending_decompressed_data.is_empty())
+        return 0;
+
+    auto bytes_written = TRY(Core::System::write(m_pipe_fd, m_pending_decompressed_data));
+    m_pending_decompressed_data = m_pending_decompressed_data.slice(bytes_written);
+
+    return bytes_written;
 }
 
 void CacheEntryReader::pipe_complete()
@@ -358,6 +590,10 @@ void CacheEntryReader::pipe_error(Error error)
 
 ErrorOr<void> CacheEntryReader::read_and_validate_footer()
 {
+    // NOTE: Entries in the memory cache were validated when they were written to or read from disk.
+    if (m_memory_cache_entry)
+        return {};
+
     TRY(m_file->seek(m_data_offset + m_data_size, SeekMode::SetPosition));
     m_cache_footer = TRY(m_file->read_value<CacheFooter>());
 
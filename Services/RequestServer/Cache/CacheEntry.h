@@ -6,23 +6,43 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
+#include <AK/ChainedBuffer.h>
 #include <AK/Error.h>
 #include <AK/LexicalPath.h>
 #include <AK/Optional.h>
 #include <AK/String.h>
 #include <AK/Types.h>
+#include <LibCompress/Zlib.h>
 #include <LibCore/File.h>
 #include <LibHTTP/HeaderMap.h>
+#include <RequestServer/Cache/MemoryCache.h>
 #include <RequestServer/Forward.h>
 
 namespace RequestServer {
 
+enum class CacheDataEncoding : u32 {
+    Identity,
+    Zlib,
+};
+
+// https://httpwg.org/specs/rfc9111.html#validation.model
+enum class CacheRevalidation {
+    NotNeeded,
+
+    // The entry is stale, but may be used while it is revalidated in the background (see RFC 5861).
+    InBackground,
+
+    // The entry must be revalidated with the origin server before it may be used.
+    Required,
+};
+
 struct [[gnu::packed]] CacheHeader {
     static ErrorOr<CacheHeader> read_from_stream(Stream&);
     ErrorOr<void> write_to_stream(Stream&) const;
 
     static constexpr auto CACHE_MAGIC = 0xcafef00du;
-    static constexpr auto CACHE_VERSION = 1;
+    static constexpr auto CACHE_VERSION = 2;
 
     u32 magic { CACHE_MAGIC };
     u32 version { CACHE_VERSION };
@@ -36,6 +56,8 @@ struct [[gnu::packed]] CacheHeader {
 
     u32 headers_size { 0 };
     u32 headers_hash { 0 };
+
+    CacheDataEncoding data_encoding { CacheDataEncoding::Identity };
 };
 
 struct [[gnu::packed]] CacheFooter {
@@ -51,6 +73,9 @@ struct [[gnu::packed]] CacheFooter {
 // on disk is:
 //
 //     [CacheHeader][URL][ReasonPhrase][HttpHeaders][Data][CacheFooter]
+//
+// Bodies that compress well are stored zlib-compressed, as indicated by the header's data encoding. The footer's data
+// size is always the size of the data as stored on disk. Compressed bodies are decompressed as they are served.
 class CacheEntry {
 public:
     virtual ~CacheEntry() = default;
@@ -87,9 +112,18 @@ public:
     ErrorOr<void> flush();
 
 private:
-    CacheEntryWriter(DiskCache&, CacheIndex&, u64 cache_key, String url, LexicalPath, NonnullOwnPtr<Core::OutputBufferedFile>, CacheHeader, UnixDateTime request_time);
+    CacheEntryWriter(DiskCache&, CacheIndex&, u64 cache_key, String url, LexicalPath, NonnullOwnPtr<Core::OutputBufferedFile>, OwnPtr<Compress::ZlibCompressor>, CacheHeader, Optional<String> reason_phrase, HTTP::HeaderMap, UnixDateTime request_time, u64 data_offset);
 
     NonnullOwnPtr<Core::OutputBufferedFile> m_file;
+    OwnPtr<Compress::ZlibCompressor> m_compressor;
+
+    u64 const m_data_offset { 0 };
+    u64 m_decoded_data_size { 0 };
+
+    // The response is also kept in memory while it is small enough to be added to the memory cache once it is complete.
+    Optional<String> m_reason_phrase;
+    HTTP::HeaderMap m_headers;
+    Optional<ChainedBuffer> m_data_for_memory_cache;
 
     UnixDateTime m_request_time;
     UnixDateTime m_response_time;
@@ -98,26 +132,52 @@ private:
 class CacheEntryReader : public CacheEntry {
 public:
     static ErrorOr<NonnullOwnPtr<CacheEntryReader>> create(DiskCache&, CacheIndex&, u64 cache_key, u64 data_size);
+    static NonnullOwnPtr<CacheEntryReader> create(DiskCache&, CacheIndex&, u64 cache_key, String url, NonnullRefPtr<MemoryCacheEntry const>);
     virtual ~CacheEntryReader() override = default;
 
+    // Reads the response body from disk and adds the response to the memory cache. The body is then piped from memory.
+    ErrorOr<void> load_into_memory_cache(UnixDateTime request_time, UnixDateTime response_time);
+
+    // Replaces the entry's file with one that has the stored headers updated with those of a response that revalidated
+    // the entry. The body is carried over as it is stored. This reader keeps reading from the file it was opened with.
+    ErrorOr<void> update_headers(HTTP::HeaderMap const& response_headers);
+
     void pipe_to(int pipe_fd, Function<void(u64 bytes_piped)> on_complete, Function<void(u64 bytes_piped)> on_error);
 
+    // Closes the entry without piping its body anywhere, e.g. because it has to be revalidated first.
+    void close();
+
+    CacheRevalidation revalidation() const { return m_revalidation; }
+    void set_revalidation(Badge<DiskCache>, CacheRevalidation revalidation) { m_revalidation = revalidation; }
+
     u32 status_code() const { return m_cache_header.status_code; }
     Optional<String> const& reason_phrase() const { return m_reason_phrase; }
     HTTP::HeaderMap const& headers() const { return m_headers; }
 
 private:
-    CacheEntryReader(DiskCache&, CacheIndex&, u64 cache_key, String url, LexicalPath, NonnullOwnPtr<Core::File>, int fd, CacheHeader, Optional<String> reason_phrase, HTTP::HeaderMap, u64 data_offset, u64 data_size);
+    CacheEntryReader(DiskCache&, CacheIndex&, u64 cache_key, String url, LexicalPath, OwnPtr<Core::File>, int fd, CacheHeader, Optional<String> reason_phrase, HTTP::HeaderMap, u64 data_offset, u64 data_size);
+
+    ErrorOr<NonnullOwnPtr<Compress::ZlibDecompressor>> create_decompressor();
 
+    bool has_piped_all_data() const;
     void pipe_without_blocking();
+    ErrorOr<size_t> pipe_decompressed_data_without_blocking();
     void pipe_complete();
     void pipe_error(Error);
 
     ErrorOr<void> read_and_validate_footer();
 
-    NonnullOwnPtr<Core::File> m_file;
+    OwnPtr<Core::File> m_file;
     int m_fd { -1 };
 
+    // Set if the response body is served from the memory cache rather than from the file.
+    RefPtr<MemoryCacheEntry const> m_memory_cache_entry;
+
+    // Set while a compressed response body is being piped from the file.
+    OwnPtr<Compress::ZlibDecompressor> m_decompressor;
+    ByteBuffer m_decompressed_data_buffer;
+    ReadonlyBytes m_pending_decompressed_data;
+
     RefPtr<Core::Notifier> m_pipe_write_notifier;
     int m_pipe_fd { -1 };
 
@@ -130,6 +190,8 @@ private:
 
     u64 const m_data_offset { 0 };
     u64 const m_data_size { 0 };
+
+    CacheRevalidation m_revalidation { CacheRevalidation::NotNeeded };
 };
 
 }
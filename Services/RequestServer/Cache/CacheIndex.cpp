@@ -26,15 +26,27 @@ ErrorOr<CacheIndex> CacheIndex::create(Database::Database& database)
     statements.insert_entry = TRY(database.prepare_statement("INSERT OR REPLACE INTO CacheIndex VALUES (?, ?, ?, ?, ?, ?);"sv));
     statements.remove_entry = TRY(database.prepare_statement("DELETE FROM CacheIndex WHERE cache_key = ?;"sv));
     statements.remove_all_entries = TRY(database.prepare_statement("DELETE FROM CacheIndex;"sv));
+    statements.remove_entries_accessed_before = TRY(database.prepare_statement("DELETE FROM CacheIndex WHERE last_access_time <= ?;"sv));
     statements.select_entry = TRY(database.prepare_statement("SELECT * FROM CacheIndex WHERE cache_key = ?;"sv));
+    statements.select_entries_by_last_access_time = TRY(database.prepare_statement("SELECT cache_key, data_size, last_access_time FROM CacheIndex ORDER BY last_access_time ASC;"sv));
+    statements.select_cache_keys = TRY(database.prepare_statement("SELECT cache_key FROM CacheIndex;"sv));
+    statements.select_total_data_size = TRY(database.prepare_statement("SELECT COALESCE(SUM(data_size), 0) FROM CacheIndex;"sv));
     statements.update_last_access_time = TRY(database.prepare_statement("UPDATE CacheIndex SET last_access_time = ? WHERE cache_key = ?;"sv));
+    statements.update_response_time = TRY(database.prepare_statement("UPDATE CacheIndex SET request_time = ?, response_time = ?, last_access_time = ? WHERE cache_key = ?;"sv));
+    statements.vacuum = TRY(database.prepare_statement("VACUUM;"sv));
 
-    return CacheIndex { database, statements };
+    u64 total_data_size = 0;
+    database.execute_statement(statements.select_total_data_size, [&](auto statement_id) {
+        total_data_size = database.result_column<u64>(statement_id, 0);
+    });
+
+    return CacheIndex { database, statements, total_data_size };
 }
 
-CacheIndex::CacheIndex(Database::Database& database, Statements statements)
+CacheIndex::CacheIndex(Database::Database& database, Statements statements, u64 total_data_size)
     : m_database(database)
     , m_statements(statements)
+    , m_estimated_total_data_size(total_data_size)
 {
 }
 
@@ -53,18 +65,88 @@ void CacheIndex::create_entry(u64 cache_key, String url, u64 data_size, UnixDate
 
     m_database.execute_statement(m_statements.insert_entry, {}, entry.cache_key, entry.url, entry.data_size, entry.request_time, entry.response_time, entry.last_access_time);
     m_entries.set(cache_key, move(entry));
+
+    m_estimated_total_data_size += data_size;
 }
 
 void CacheIndex::remove_entry(u64 cache_key)
 {
     m_database.execute_statement(m_statements.remove_entry, {}, cache_key);
-    m_entries.remove(cache_key);
+
+    if (auto entry = m_entries.take(cache_key); entry.has_value())
+        m_estimated_total_data_size -= min(entry->data_size, m_estimated_total_data_size);
 }
 
 void CacheIndex::remove_all_entries()
 {
     m_database.execute_statement(m_statements.remove_all_entries, {});
     m_entries.clear();
+
+    m_estimated_total_data_size = 0;
+}
+
+Vector<u64> CacheIndex::remove_least_recently_used_entries(u64 maximum_total_data_size, u64 target_total_data_size)
+{
+    struct EntrySize {
+        u64 cache_key { 0 };
+        u64 data_size { 0 };
+        UnixDateTime last_access_time;
+    };
+    Vector<EntrySize> entries;
+    u64 total_data_size = 0;
+
+    m_database.execute_statement(m_statements.select_entries_by_last_access_time, [&](auto statement_id) {
+        int column = 0;
+
+        auto cache_key = m_database.result_column<u64>(statement_id, column++);
+        auto data_size = m_database.result_column<u64>(statement_id, column++);
+        auto last_access_time = m_database.result_column<UnixDateTime>(statement_id, column++);
+
+        entries.append({ cache_key, data_size, last_access_time });
+        total_data_size += data_size;
+    });
+
+    m_estimated_total_data_size = total_data_size;
+
+    if (total_data_size <= maximum_total_data_size)
+        return {};
+
+    Vector<u64> removed_cache_keys;
+    Optional<UnixDateTime> removed_last_access_time;
+
+    for (auto const& entry : entries) {
+        // NOTE: We remove all entries accessed up to some point in time at once, so entries accessed at the same time
+        //       as the last one we need to remove have to be removed as well.
+        if (total_data_size <= target_total_data_size && entry.last_access_time != *removed_last_access_time)
+            break;
+
+        removed_cache_keys.append(entry.cache_key);
+        removed_last_access_time = entry.last_access_time;
+        total_data_size -= entry.data_size;
+
+        m_entries.remove(entry.cache_key);
+    }
+
+    m_database.execute_statement(m_statements.remove_entries_accessed_before, {}, *removed_last_access_time);
+    m_estimated_total_data_size = total_data_size;
+
+    return removed_cache_keys;
+}
+
+HashTable<u64> CacheIndex::all_cache_keys()
+{
+    HashTable<u64> cache_keys;
+
+    m_database.execute_statement(m_statements.select_cache_keys, [&](auto statement_id) {
+        cache_keys.set(m_database.result_column<u64>(statement_id, 0));
+    });
+
+    return cache_keys;
+}
+
+void CacheIndex::vacuum()
+{
+    m_database.execute_statement(m_statements.vacuum, {});
 }
 
 void CacheIndex::update_last_access_time(u64 cache_key)
@@ -79,6 +161,20 @@ void CacheIndex::update_last_access_time(u64 cache_key)
     entry->last_access_time = now;
 }
 
+void CacheIndex::update_response_time(u64 cache_key, UnixDateTime request_time, UnixDateTime response_time)
+{
+    auto entry = m_entries.get(cache_key);
+    if (!entry.has_value())
+        return;
+
+    auto now = UnixDateTime::now();
+
+    m_database.execute_statement(m_statements.update_response_time, {}, request_time, response_time, now, cache_key);
+    entry->request_time = request_time;
+    entry->response_time = response_time;
+    entry->last_access_time = now;
+}
+
 Optional<CacheIndex::Entry&> CacheIndex::find_entry(u64 cache_key)
 {
     if (auto entry = m_entries.get(cache_key); entry.has_value())
@@ -8,6 +8,7 @@
 
 #include <AK/Error.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/Time.h>
 #include <AK/Types.h>
 #include <LibDatabase/Database.h>
@@ -38,22 +39,43 @@ public:
     Optional<Entry&> find_entry(u64 cache_key);
 
     void update_last_access_time(u64 cache_key);
+    void update_response_time(u64 cache_key, UnixDateTime request_time, UnixDateTime response_time);
+
+    // This is an upper bound of the size of all entries. It is exact after entries have been evicted.
+    u64 estimated_total_data_size() const { return m_estimated_total_data_size; }
+
+    // If the entries take up more than the maximum size, removes the least recently used entries until they take up at
+    // most the target size. The entries are removed from the index with a single statement, and their cache keys are
+    // returned so that the caller may remove their files.
+    Vector<u64> remove_least_recently_used_entries(u64 maximum_total_data_size, u64 target_total_data_size);
+
+    HashTable<u64> all_cache_keys();
+
+    void vacuum();
 
 private:
     struct Statements {
         Database::StatementID insert_entry { 0 };
         Database::StatementID remove_entry { 0 };
         Database::StatementID remove_all_entries { 0 };
+        Database::StatementID remove_entries_accessed_before { 0 };
         Database::StatementID select_entry { 0 };
+        Database::StatementID select_entries_by_last_access_time { 0 };
+        Database::StatementID select_cache_keys { 0 };
+        Database::StatementID select_total_data_size { 0 };
         Database::StatementID update_last_access_time { 0 };
+        Database::StatementID update_response_time { 0 };
+        Database::StatementID vacuum { 0 };
     };
 
-    CacheIndex(Database::Database&, Statements);
+    CacheIndex(Database::Database&, Statements, u64 total_data_size);
 
     Database::Database& m_database;
     Statements m_statements;
 
     HashMap<u32, Entry> m_entries;
+
+    u64 m_estimated_total_data_size { 0 };
 };
 
 }
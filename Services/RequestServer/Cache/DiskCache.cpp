@@ -5,8 +5,11 @@
  */
 
 #include <LibCore/DirIterator.h>
+#include <LibCore/EventLoop.h>
 #include <LibCore/StandardPaths.h>
+#include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
+#include <LibThreading/BackgroundAction.h>
 #include <LibURL/URL.h>
 #include <RequestServer/Cache/DiskCache.h>
 #include <RequestServer/Cache/Utilities.h>
@@ -15,20 +18,29 @@ namespace RequestServer {
 
 static constexpr auto INDEX_DATABASE = "INDEX"sv;
 
-ErrorOr<DiskCache> DiskCache::create()
+// Once evicting entries, we go a bit below the maximum size, so that we don't have to evict again for every new entry.
+static constexpr u64 EVICTION_TARGET_SIZE_PERCENTAGE = 90;
+
+static constexpr auto MINIMUM_TIME_BETWEEN_INDEX_VACUUMS = AK::Duration::from_seconds(60 * 60);
+
+ErrorOr<DiskCache> DiskCache::create(u64 maximum_size)
 {
     auto cache_directory = LexicalPath::join(Core::StandardPaths::cache_directory(), "Ladybird"sv, "Cache"sv);
 
-    auto database = TRY(Database::Database::create(cache_directory.string(), INDEX_DATABASE));
+    auto database = TRY(Database::Database::create(cache_directory.string(), INDEX_DATABASE, Database::ExecutionMode::Asynchronous));
     auto index = TRY(CacheIndex::create(database));
 
-    return DiskCache { move(database), move(cache_directory), move(index) };
+    auto memory_cache = make<MemoryCache>();
+
+    return DiskCache { move(database), move(cache_directory), move(index), move(memory_cache), maximum_size };
 }
 
-DiskCache::DiskCache(NonnullRefPtr<Database::Database> database, LexicalPath cache_directory, CacheIndex index)
+DiskCache::DiskCache(NonnullRefPtr<Database::Database> database, LexicalPath cache_directory, CacheIndex index, NonnullOwnPtr<MemoryCache> memory_cache, u64 maximum_size)
     : m_database(move(database))
     , m_cache_directory(move(cache_directory))
     , m_index(move(index))
+    , m_memory_cache(move(memory_cache))
+    , m_maximum_size(maximum_size)
 {
 }
 
@@ -37,12 +49,24 @@ Optional<CacheEntryWriter&> DiskCache::create_entry(URL::URL const& url, StringV
     if (!is_cacheable(method, status_code, headers))
         return {};
 
-    if (auto freshness = calculate_freshness_lifetime(headers); freshness.is_negative() || freshness.is_zero())
+    // NOTE: Responses which are stale right away are still worth storing if they can be revalidated.
+    if (auto freshness = calculate_freshness_lifetime(headers); (freshness.is_negative() || freshness.is_zero()) && !has_validators(headers))
         return {};
 
     auto serialized_url = serialize_url_for_cache_storage(url);
     auto cache_key = create_cache_key(serialized_url, method);
 
+    if (m_cache_keys_pending_removal.contains(cache_key))
+        return {};
+
+    // NOTE: The entry being replaced may still be read from, e.g. while a stale response is served and revalidated in
+    //       the background. Its file is unlinked rather than truncated, so that readers may continue to use it.
+    if (m_index.find_entry(cache_key).has_value()) {
+        (void)FileSystem::remove(path_for_cache_key(m_cache_directory, cache_key).string(), FileSystem::RecursionMode::Disallowed);
+        m_index.remove_entry(cache_key);
+        m_memory_cache->remove_entry(cache_key);
+    }
+
     auto cache_entry = CacheEntryWriter::create(*this, m_index, cache_key, move(serialized_url), status_code, move(reason_phrase), headers, request_time);
     if (cache_entry.is_error()) {
         dbgln("\033[31;1mUnable to create cache entry for\033[0m {}: {}", url, cache_entry.error());
@@ -62,6 +86,17 @@ Optional<CacheEntryReader&> DiskCache::open_entry(URL::URL const& url, StringVie
     auto serialized_url = serialize_url_for_cache_storage(url);
     auto cache_key = create_cache_key(serialized_url, method);
 
+    if (auto memory_cache_entry = m_memory_cache->find_entry(cache_key)) {
+        dbgln("\033[32;1mOpened memory cache entry for\033[0m {} ({} bytes)", url, memory_cache_entry->data().size());
+
+        auto cache_entry = CacheEntryReader::create(*this, m_index, cache_key, move(serialized_url), memory_cache_entry.release_nonnull());
+
+        auto address = reinterpret_cast<FlatPtr>(cache_entry.ptr());
+        m_open_cache_entries.set(address, move(cache_entry));
+
+        return static_cast<CacheEntryReader&>(**m_open_cache_entries.get(address));
+    }
+
     auto index_entry = m_index.find_entry(cache_key);
     if (!index_entry.has_value()) {
         dbgln("\033[35;1mNo disk cache entry for\033[0m {}", url);
@@ -75,16 +110,50 @@ Optional<CacheEntryReader&> DiskCache::open_entry(URL::URL const& url, StringVie
         return {};
     }
 
-    auto freshness_lifetime = calculate_freshness_lifetime(cache_entry.value()->headers());
-    auto current_age = calculate_age(cache_entry.value()->headers(), index_entry->request_time, index_entry->response_time);
+    auto const& headers = cache_entry.value()->headers();
+    auto freshness_lifetime = calculate_freshness_lifetime(headers);
+    auto current_age = calculate_age(headers, index_entry->request_time, index_entry->response_time);
+
+    auto revalidation = [&]() -> Optional<CacheRevalidation> {
+        if (must_revalidate_before_use(headers)) {
+            if (has_validators(headers))
+                return CacheRevalidation::Required;
+            return {};
+        }
+
+        if (is_response_fresh(freshness_lifetime, current_age))
+            return CacheRevalidation::NotNeeded;
 
-    if (!is_response_fresh(freshness_lifetime, current_age)) {
+        if (may_serve_stale_while_revalidating(headers, freshness_lifetime, current_age)) {
+            // NOTE: If the entry is already being revalidated, we just serve it as is.
+            if (m_cache_keys_being_revalidated.set(cache_key) == HashSetResult::InsertedNewEntry)
+                return CacheRevalidation::InBackground;
+            return CacheRevalidation::NotNeeded;
+        }
+
+        if (has_validators(headers))
+            return CacheRevalidation::Required;
+        return {};
+    }();
+
+    if (!revalidation.has_value()) {
         dbgln("\033[33;1mCache entry expired for\033[0m {} (lifetime={}s age={}s)", url, freshness_lifetime.to_seconds(), current_age.to_seconds());
         cache_entry.value()->remove();
         return {};
     }
 
-    dbgln("\033[32;1mOpened disk cache entry for\033[0m {} (lifetime={}s age={}s) ({} bytes)", url, freshness_lifetime.to_seconds(), current_age.to_seconds(), index_entry->data_size);
+    if (*revalidation == CacheRevalidation::NotNeeded)
+        dbgln("\033[32;1mOpened disk cache entry for\033[0m {} (lifetime={}s age={}s) ({} bytes)", url, freshness_lifetime.to_seconds(), current_age.to_seconds(), index_entry->data_size);
+    else
+        dbgln("\033[33;1mOpened disk cache entry which needs revalidation for\033[0m {} (lifetime={}s age={}s) ({} bytes)", url, freshness_lifetime.to_seconds(), current_age.to_seconds(), index_entry->data_size);
+
+    cache_entry.value()->set_revalidation({}, *revalidation);
+
+    // NOTE: Only fresh responses are added to the memory cache, as it does not know how to revalidate entries.
+    if (*revalidation == CacheRevalidation::NotNeeded && MemoryCache::can_hold_entry_of_size(index_entry->data_size)) {
+        if (auto result = cache_entry.value()->load_into_memory_cache(index_entry->request_time, index_entry->response_time); result.is_error())
+            dbgln("\033[31;1mUnable to load cache entry into memory for\033[0m {}: {}", url, result.error());
+    }
 
     auto address = reinterpret_cast<FlatPtr>(cache_entry.value().ptr());
     m_open_cache_entries.set(address, cache_entry.release_value());
@@ -92,12 +161,50 @@ Optional<CacheEntryReader&> DiskCache::open_entry(URL::URL const& url, StringVie
     return static_cast<CacheEntryReader&>(**m_open_cache_entries.get(address));
 }
 
+bool DiskCache::update_entry_after_revalidation(URL::URL const& url, StringView method, HTTP::HeaderMap const& response_headers, UnixDateTime request_time)
+{
+    auto serialized_url = serialize_url_for_cache_storage(url);
+    auto cache_key = create_cache_key(serialized_url, method);
+
+    auto index_entry = m_index.find_entry(cache_key);
+    if (!index_entry.has_value())
+        return false;
+
+    auto cache_entry = CacheEntryReader::create(*this, m_index, cache_key, index_entry->data_size);
+    if (cache_entry.is_error()) {
+        dbgln("\033[31;1mUnable to open cache entry for\033[0m {}: {}", url, cache_entry.error());
+        m_index.remove_entry(cache_key);
+        return false;
+    }
+
+    if (auto result = cache_entry.value()->update_headers(response_headers); result.is_error()) {
+        dbgln("\033[31;1mUnable to update cache entry for\033[0m {}: {}", url, result.error());
+        cache_entry.value()->remove();
+        return false;
+    }
+
+    m_index.update_response_time(cache_key, request_time, UnixDateTime::now());
+    m_memory_cache->remove_entry(cache_key);
+
+    dbgln("\033[32;1mRevalidated disk cache entry for\033[0m {}", url);
+    return true;
+}
+
+void DiskCache::finished_revalidating_entry_in_background(URL::URL const& url, StringView method)
+{
+    auto serialized_url = serialize_url_for_cache_storage(url);
+    auto cache_key = create_cache_key(serialized_url, method);
+
+    m_cache_keys_being_revalidated.remove(cache_key);
+}
+
 void DiskCache::clear_cache()
 {
     for (auto& [_, cache_entry] : m_open_cache_entries)
         cache_entry->mark_for_deletion({});
 
     m_index.remove_all_entries();
+    m_memory_cache->remove_all_entries();
 
     Core::DirIterator it { m_cache_directory.string(), Core::DirIterator::SkipDots };
     size_t cache_entries { 0 };
@@ -114,10 +221,119 @@ void DiskCache::clear_cache()
     dbgln("Cleared {} disk cache entries", cache_entries);
 }
 
+void DiskCache::remove_orphaned_cache_files()
+{
+    auto cache_keys = m_index.all_cache_keys();
+    auto scan_start_time = UnixDateTime::now();
+
+    (void)Threading::BackgroundAction<size_t>::construct(
+        [cache_directory = m_cache_directory.string(), cache_keys = move(cache_keys), scan_start_time](auto&) -> ErrorOr<size_t> {
+            Core::DirIterator it { cache_directory, Core::DirIterator::SkipDots };
+            size_t removed_files { 0 };
+
+            while (it.has_next()) {
+                auto path = it.next_full_path();
+
+                LexicalPath lexical_path { path };
+                auto title = lexical_path.title();
+                if (title == INDEX_DATABASE)
+                    continue;
+
+                if (auto cache_key = title.to_number<u64>(TrimWhitespace::No, 16); cache_key.has_value() && cache_keys.contains(*cache_key))
+                    continue;
+
+                // NOTE: Files created after we looked at the index may belong to entries that are still being written.
+                auto stat = Core::System::stat(path);
+                if (stat.is_error() || stat.value().st_mtime >= scan_start_time.seconds_since_epoch())
+                    continue;
+
+                if (!FileSystem::remove(path, FileSystem::RecursionMode::Disallowed).is_error())
+                    ++removed_files;
+            }
+
+            return removed_files;
+        },
+        [this](size_t removed_files) -> ErrorOr<void> {
+            if (removed_files != 0) {
+                dbgln("Removed {} orphaned disk cache files", removed_files);
+                vacuum_index_if_needed();
+            }
+            return {};
+        },
+        {}, Threading::TaskPriority::Background);
+}
+
 void DiskCache::cache_entry_closed(Badge<CacheEntry>, CacheEntry const& cache_entry)
 {
     auto address = reinterpret_cast<FlatPtr>(&cache_entry);
     m_open_cache_entries.remove(address);
+
+    if (m_index.estimated_total_data_size() > m_maximum_size)
+        schedule_eviction();
+}
+
+void DiskCache::schedule_eviction()
+{
+    if (m_eviction_scheduled)
+        return;
+    m_eviction_scheduled = true;
+
+    Core::deferred_invoke([this]() {
+        m_eviction_scheduled = false;
+        evict_least_recently_used_entries();
+    });
+}
+
+void DiskCache::evict_least_recently_used_entries()
+{
+    auto target_size = m_maximum_size / 100 * EVICTION_TARGET_SIZE_PERCENTAGE;
+
+    auto cache_keys = m_index.remove_least_recently_used_entries(m_maximum_size, target_size);
+    if (cache_keys.is_empty())
+        return;
+
+    dbgln("\033[33;1mEvicting {} disk cache entries\033[0m (size limit={} bytes)", cache_keys.size(), m_maximum_size);
+
+    for (auto cache_key : cache_keys)
+        m_memory_cache->remove_entry(cache_key);
+
+    remove_cache_files_in_the_background(move(cache_keys));
+}
+
+void DiskCache::remove_cache_files_in_the_background(Vector<u64> cache_keys)
+{
+    Vector<ByteString> paths;
+    paths.ensure_capacity(cache_keys.size());
+
+    for (auto cache_key : cache_keys) {
+        m_cache_keys_pending_removal.set(cache_key);
+        paths.unchecked_append(path_for_cache_key(m_cache_directory, cache_key).string());
+    }
+
+    (void)Threading::BackgroundAction<size_t>::construct(
+        [paths = move(paths)](auto&) -> ErrorOr<size_t> {
+            for (auto const& path : paths)
+                (void)FileSystem::remove(path, FileSystem::RecursionMode::Disallowed);
+            return paths.size();
+        },
+        [this, cache_keys = move(cache_keys)](size_t) -> ErrorOr<void> {
+            for (auto cache_key : cache_keys)
+                m_cache_keys_pending_removal.remove(cache_key);
+
+            vacuum_index_if_needed();
+            return {};
+        },
+        {}, Threading::TaskPriority::Background);
+}
+
+void DiskCache::vacuum_index_if_needed()
+{
+    auto now = MonotonicTime::now();
+    if (m_last_vacuum_time.has_value() && now - *m_last_vacuum_time < MINIMUM_TIME_BETWEEN_INDEX_VACUUMS)
+        return;
+
+    m_last_vacuum_time = now;
+    m_index.vacuum();
 }
 
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Error.h>
+#include <AK/HashTable.h>
 #include <AK/LexicalPath.h>
 #include <AK/Optional.h>
 #include <AK/StringView.h>
@@ -17,23 +18,42 @@
 #include <LibURL/Forward.h>
 #include <RequestServer/Cache/CacheEntry.h>
 #include <RequestServer/Cache/CacheIndex.h>
+#include <RequestServer/Cache/MemoryCache.h>
 
 namespace RequestServer {
 
 class DiskCache {
 public:
-    static ErrorOr<DiskCache> create();
+    static constexpr u64 DEFAULT_MAXIMUM_SIZE = 1 * GiB;
+
+    static ErrorOr<DiskCache> create(u64 maximum_size = DEFAULT_MAXIMUM_SIZE);
 
     Optional<CacheEntryWriter&> create_entry(URL::URL const&, StringView method, u32 status_code, Optional<String> reason_phrase, HTTP::HeaderMap const&, UnixDateTime request_time);
     Optional<CacheEntryReader&> open_entry(URL::URL const&, StringView method);
     void clear_cache();
 
+    // Updates the entry's stored headers and age after the origin server validated it with a 304 response.
+    bool update_entry_after_revalidation(URL::URL const&, StringView method, HTTP::HeaderMap const& response_headers, UnixDateTime request_time);
+    void finished_revalidating_entry_in_background(URL::URL const&, StringView method);
+
+    // Removes files in the cache directory that do not belong to any entry in the index, e.g. because the process exited
+    // before it was done writing or evicting entries. The files are removed on a background thread.
+    void remove_orphaned_cache_files();
+
     LexicalPath const& cache_directory() { return m_cache_directory; }
 
+    MemoryCache& memory_cache() { return *m_memory_cache; }
+    MemoryCache const& memory_cache() const { return *m_memory_cache; }
+
     void cache_entry_closed(Badge<CacheEntry>, CacheEntry const&);
 
 private:
-    DiskCache(NonnullRefPtr<Database::Database>, LexicalPath cache_directory, CacheIndex);
+    DiskCache(NonnullRefPtr<Database::Database>, LexicalPath cache_directory, CacheIndex, NonnullOwnPtr<MemoryCache>, u64 maximum_size);
+
+    void schedule_eviction();
+    void evict_least_recently_used_entries();
+    void remove_cache_files_in_the_background(Vector<u64> cache_keys);
+    void vacuum_index_if_needed();
 
     NonnullRefPtr<Database::Database> m_database;
 
@@ -41,6 +61,19 @@ private:
 
     LexicalPath m_cache_directory;
     CacheIndex m_index;
+
+    NonnullOwnPtr<MemoryCache> m_memory_cache;
+
+    u64 m_maximum_size { 0 };
+    bool m_eviction_scheduled { false };
+
+    // New entries are not created for these until the files of their evicted entries have been removed.
+    HashTable<u64> m_cache_keys_pending_removal;
+
+    // Stale entries are only revalidated in the background by one request at a time.
+    HashTable<u64> m_cache_keys_being_revalidated;
+
+    Optional<MonotonicTime> m_last_vacuum_time;
 };
 
 }
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <RequestServer/Cache/MemoryCache.h>
+#include <RequestServer/Cache/Utilities.h>
+
+namespace RequestServer {
+
+NonnullRefPtr<MemoryCacheEntry> MemoryCacheEntry::create(u32 status_code, Optional<String> reason_phrase, HTTP::HeaderMap headers, ByteBuffer data, UnixDateTime request_time, UnixDateTime response_time)
+{
+    return adopt_ref(*new MemoryCacheEntry { status_code, move(reason_phrase), move(headers), move(data), request_time, response_time });
+}
+
+MemoryCacheEntry::MemoryCacheEntry(u32 status_code, Optional<String> reason_phrase, HTTP::HeaderMap headers, ByteBuffer data, UnixDateTime request_time, UnixDateTime response_time)
+    : m_status_code(status_code)
+    , m_reason_phrase(move(reason_phrase))
+    , m_headers(move(headers))
+    , m_data(move(data))
+    , m_request_time(request_time)
+    , m_response_time(response_time)
+{
+    m_size = m_data.size();
+    if (m_reason_phrase.has_value())
+        m_size += m_reason_phrase->byte_count();
+    for (auto const& header : m_headers.headers())
+        m_size += header.name.length() + header.value.length();
+}
+
+MemoryCache::~MemoryCache()
+{
+    remove_all_entries();
+}
+
+RefPtr<MemoryCacheEntry const> MemoryCache::find_entry(u64 cache_key)
+{
+    auto entry = m_entries.get(cache_key);
+    if (!entry.has_value()) {
+        ++m_statistics.misses;
+        return {};
+    }
+
+    auto freshness_lifetime = calculate_freshness_lifetime((*entry)->headers());
+    auto current_age = calculate_age((*entry)->headers(), (*entry)->request_time(), (*entry)->response_time());
+
+    if (!is_response_fresh(freshness_lifetime, current_age)) {
+        remove_entry(**entry);
+        ++m_statistics.misses;
+        return {};
+    }
+
+    // Move the entry to the most recently used end of the list.
+    m_lru_list.remove(**entry);
+    m_lru_list.append(**entry);
+
+    ++m_statistics.hits;
+    return *entry;
+}
+
+void MemoryCache::create_entry(u64 cache_key, NonnullRefPtr<MemoryCacheEntry> entry)
+{
+    if (!can_hold_entry_of_size(entry->size()))
+        return;
+
+    remove_entry(cache_key);
+    evict_entries_to_fit(entry->size());
+
+    entry->m_cache_key = cache_key;
+    m_size += entry->size();
+
+    m_lru_list.append(*entry);
+    m_entries.set(cache_key, move(entry));
+}
+
+void MemoryCache::remove_entry(u64 cache_key)
+{
+    if (auto entry = m_entries.get(cache_key); entry.has_value())
+        remove_entry(**entry);
+}
+
+void MemoryCache::remove_entry(MemoryCacheEntry& entry)
+{
+    m_lru_list.remove(entry);
+    m_size -= entry.size();
+
+    // NOTE: Readers serving this entry hold their own reference to it, so it stays alive until they are done.
+    m_entries.remove(entry.m_cache_key);
+}
+
+void MemoryCache::remove_all_entries()
+{
+    m_lru_list.clear();
+    m_entries.clear();
+    m_size = 0;
+}
+
+void MemoryCache::evict_entries_to_fit(size_t size)
+{
+    while (m_size + size > MAXIMUM_SIZE) {
+        auto* entry = m_lru_list.first();
+        VERIFY(entry);
+
+        remove_entry(*entry);
+        ++m_statistics.evictions;
+    }
+}
+
+}
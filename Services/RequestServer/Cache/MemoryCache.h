@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/RefCounted.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+#include <LibHTTP/HeaderMap.h>
+
+namespace RequestServer {
+
+class MemoryCacheEntry : public RefCounted<MemoryCacheEntry> {
+public:
+    static NonnullRefPtr<MemoryCacheEntry> create(u32 status_code, Optional<String> reason_phrase, HTTP::HeaderMap, ByteBuffer data, UnixDateTime request_time, UnixDateTime response_time);
+
+    u32 status_code() const { return m_status_code; }
+    Optional<String> const& reason_phrase() const { return m_reason_phrase; }
+    HTTP::HeaderMap const& headers() const { return m_headers; }
+    ReadonlyBytes data() const { return m_data; }
+
+    UnixDateTime request_time() const { return m_request_time; }
+    UnixDateTime response_time() const { return m_response_time; }
+
+    size_t size() const { return m_size; }
+
+private:
+    friend class MemoryCache;
+
+    MemoryCacheEntry(u32 status_code, Optional<String> reason_phrase, HTTP::HeaderMap, ByteBuffer data, UnixDateTime request_time, UnixDateTime response_time);
+
+    u32 m_status_code { 0 };
+    Optional<String> m_reason_phrase;
+    HTTP::HeaderMap m_headers;
+    ByteBuffer m_data;
+
+    UnixDateTime m_request_time;
+    UnixDateTime m_response_time;
+
+    size_t m_size { 0 };
+
+    u64 m_cache_key { 0 };
+    IntrusiveListNode<MemoryCacheEntry> m_list_node;
+};
+
+// The memory cache is a bounded, least-recently-used set of small cache entries that sits in front of the disk cache.
+// Entries are added once they have been written to or read from disk in full, so that hits on hot resources can be
+// served without a trip to the cache index or to the file system.
+class MemoryCache {
+    AK_MAKE_NONCOPYABLE(MemoryCache);
+    AK_MAKE_NONMOVABLE(MemoryCache);
+
+public:
+    static constexpr size_t MAXIMUM_ENTRY_SIZE = 256 * KiB;
+    static constexpr size_t MAXIMUM_SIZE = 16 * MiB;
+
+    struct Statistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+    };
+
+    MemoryCache() = default;
+    ~MemoryCache();
+
+    static bool can_hold_entry_of_size(u64 data_size) { return data_size <= MAXIMUM_ENTRY_SIZE; }
+
+    // Returns the entry for the given cache key if it is still fresh. Expired entries are dropped.
+    RefPtr<MemoryCacheEntry const> find_entry(u64 cache_key);
+
+    void create_entry(u64 cache_key, NonnullRefPtr<MemoryCacheEntry>);
+    void remove_entry(u64 cache_key);
+    void remove_all_entries();
+
+    Statistics const& statistics() const { return m_statistics; }
+    size_t entry_count() const { return m_entries.size(); }
+    size_t size() const { return m_size; }
+
+private:
+    void evict_entries_to_fit(size_t size);
+    void remove_entry(MemoryCacheEntry&);
+
+    HashMap<u64, NonnullRefPtr<MemoryCacheEntry>> m_entries;
+
+    // Ordered from the least recently used entry to the most recently used one.
+    IntrusiveList<&MemoryCacheEntry::m_list_node> m_lru_list;
+
+    size_t m_size { 0 };
+    Statistics m_statistics;
+};
+
+}
@@ -70,6 +70,11 @@ u64 create_cache_key(StringView url, StringView method)
     return result;
 }
 
+LexicalPath path_for_cache_key(LexicalPath const& cache_directory, u64 cache_key)
+{
+    return cache_directory.append(MUST(String::formatted("{:016x}", cache_key)));
+}
+
 // https://httpwg.org/specs/rfc9111.html#response.cacheability
 bool is_cacheable(StringView method, u32 status_code, HTTP::HeaderMap const& headers)
 {
@@ -109,11 +114,9 @@ bool is_cacheable(StringView method, u32 status_code, HTTP::HeaderMap const& hea
     //     - a cache extension that allows it to be cached (see Section 5.2.3); or
     //     - a status code that is defined as heuristically cacheable (see Section 4.2.2).
 
-    // FIXME: Implement cache revalidation.
-    if (cache_control->contains("no-cache"sv, CaseSensitivity::CaseInsensitive))
-        return false;
-    if (cache_control->contains("revalidate"sv, CaseSensitivity::CaseInsensitive))
-        return false;
+    // NOTE: Responses that have to be revalidated are only useful to us if we are able to revalidate them.
+    if (cache_control->contains("no-cache"sv, CaseSensitivity::CaseInsensitive) || cache_control->contains("revalidate"sv, CaseSensitivity::CaseInsensitive))
+        return has_validators(headers);
 
     return true;
 }
@@ -146,6 +149,29 @@ bool is_header_exempted_from_storage(StringView name)
     );
 }
 
+bool should_compress_for_storage(HTTP::HeaderMap const& headers)
+{
+    // NOTE: We only compress bodies that are known to compress well. Images, media, and fonts are typically compressed
+    //       already, and compressing them again would only cost time when the response is stored and served.
+    auto content_type = headers.get("Content-Type"sv);
+    if (!content_type.has_value())
+        return false;
+
+    auto essence = content_type->view().find_first_split_view(';').trim_whitespace();
+
+    if (essence.starts_with("text/"sv, CaseSensitivity::CaseInsensitive))
+        return true;
+    if (essence.ends_with("+json"sv, CaseSensitivity::CaseInsensitive) || essence.ends_with("+xml"sv, CaseSensitivity::CaseInsensitive))
+        return true;
+
+    return essence.is_one_of_ignoring_ascii_case(
+        "application/javascript"sv,
+        "application/json"sv,
+        "application/wasm"sv,
+        "application/xml"sv,
+        "image/svg+xml"sv);
+}
+
 // https://httpwg.org/specs/rfc9111.html#calculating.freshness.lifetime
 AK::Duration calculate_freshness_lifetime(HTTP::HeaderMap const& headers)
 {
@@ -217,4 +243,95 @@ bool is_response_fresh(AK::Duration freshness_lifetime, AK::Duration current_age
     return freshness_lifetime > current_age;
 }
 
+// https://httpwg.org/specs/rfc9110.html#response.validator
+bool has_validators(HTTP::HeaderMap const& headers)
+{
+    return headers.contains("ETag"sv) || headers.contains("Last-Modified"sv);
+}
+
+// https://httpwg.org/specs/rfc9111.html#cache-response-directive.no-cache
+bool must_revalidate_before_use(HTTP::HeaderMap const& headers)
+{
+    // The no-cache response directive, in its unqualified form (without an argument), indicates that the response MUST
+    // NOT be used to satisfy any other request without forwarding it for validation and receiving a successful response.
+    auto cache_control = headers.get("Cache-Control"sv);
+    if (!cache_control.has_value())
+        return false;
+
+    return cache_control->contains("no-cache"sv, CaseSensitivity::CaseInsensitive);
+}
+
+// https://www.rfc-editor.org/rfc/rfc5861#section-3
+bool may_serve_stale_while_revalidating(HTTP::HeaderMap const& headers, AK::Duration freshness_lifetime, AK::Duration current_age)
+{
+    auto cache_control = headers.get("Cache-Control"sv);
+    if (!cache_control.has_value())
+        return false;
+
+    // NOTE: Stale responses must not be served at all if the must-revalidate or proxy-revalidate directives are present.
+    if (cache_control->contains("revalidate"sv, CaseSensitivity::CaseInsensitive) || cache_control->contains("no-cache"sv, CaseSensitivity::CaseInsensitive))
+        return false;
+
+    // When present in an HTTP response, the stale-while-revalidate Cache-Control extension indicates that caches MAY
+    // serve the response in which it appears after it becomes stale, up to the indicated number of seconds.
+    auto stale_while_revalidate = extract_cache_control_directive(*cache_control, "stale-while-revalidate"sv);
+    if (!stale_while_revalidate.has_value())
+        return false;
+
+    auto seconds = stale_while_revalidate->to_number<i64>();
+    if (!seconds.has_value())
+        return false;
+
+    return current_age < freshness_lifetime + AK::Duration::from_seconds(*seconds);
+}
+
+// https://httpwg.org/specs/rfc9111.html#validation.sent
+HTTP::HeaderMap create_conditional_request_headers(HTTP::HeaderMap const& request_headers, HTTP::HeaderMap const& stored_headers)
+{
+    auto conditional_request_headers = request_headers;
+
+    // When generating a conditional request for validation, a cache:
+    // * MUST send the relevant entity tags (using If-Match, If-None-Match, or If-Range) if the entity tags were provided
+    //   in the stored response(s) being validated.
+    if (auto etag = stored_headers.get("ETag"sv); etag.has_value())
+        conditional_request_headers.set("If-None-Match"sv, *etag);
+
+    // * SHOULD send the Last-Modified value (using If-Modified-Since) if the request is not for a subrange, a single
+    //   stored response is being validated, and that response contains a Last-Modified value.
+    if (auto last_modified = stored_headers.get("Last-Modified"sv); last_modified.has_value())
+        conditional_request_headers.set("If-Modified-Since"sv, *last_modified);
+
+    return conditional_request_headers;
+}
+
+// https://httpwg.org/specs/rfc9111.html#update
+HTTP::HeaderMap update_stored_headers(HTTP::HeaderMap const& stored_headers, HTTP::HeaderMap const& response_headers)
+{
+    // When doing so, the cache MUST add each header field in the provided response to the stored response, replacing
+    // field values that are already present, with the following exceptions:
+    auto is_excepted = [](StringView name) {
+        // * Header fields excepted from storage in Section 3.1,
+        // * Header fields that the cache's stored response depends upon, as described below,
+        // * Header fields that are automatically processed and removed by the recipient, as described below, and
+        // * The Content-Length header field.
+        return is_header_exempted_from_storage(name)
+            || name.equals_ignoring_ascii_case("Content-Encoding"sv)
+            || name.equals_ignoring_ascii_case("Content-Length"sv);
+    };
+
+    HTTP::HeaderMap updated_headers;
+
+    for (auto const& header : stored_headers.headers()) {
+        if (!response_headers.contains(header.name) || is_excepted(header.name))
+            updated_headers.set(header.name, header.value);
+    }
+
+    for (auto const& header : response_headers.headers()) {
+        if (!is_excepted(header.name))
+            updated_headers.set(header.name, header.value);
+    }
+
+    return updated_headers;
+}
+
 }
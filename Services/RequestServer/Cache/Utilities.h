@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/LexicalPath.h>
 #include <AK/StringView.h>
 #include <AK/Time.h>
 #include <AK/Types.h>
@@ -16,12 +17,20 @@ namespace RequestServer {
 
 String serialize_url_for_cache_storage(URL::URL const&);
 u64 create_cache_key(StringView url, StringView method);
+LexicalPath path_for_cache_key(LexicalPath const& cache_directory, u64 cache_key);
 
 bool is_cacheable(StringView method, u32 status_code, HTTP::HeaderMap const&);
 bool is_header_exempted_from_storage(StringView name);
+bool should_compress_for_storage(HTTP::HeaderMap const&);
 
 AK::Duration calculate_freshness_lifetime(HTTP::HeaderMap const&);
 AK::Duration calculate_age(HTTP::HeaderMap const&, UnixDateTime request_time, UnixDateTime response_time);
 bool is_response_fresh(AK::Duration freshness_lifetime, AK::Duration current_age);
 
+bool has_validators(HTTP::HeaderMap const&);
+bool must_revalidate_before_use(HTTP::HeaderMap const&);
+bool may_serve_stale_while_revalidating(HTTP::HeaderMap const&, AK::Duration freshness_lifetime, AK::Duration current_age);
+HTTP::HeaderMap create_conditional_request_headers(HTTP::HeaderMap const& request_headers, HTTP::HeaderMap const& stored_headers);
+HTTP::HeaderMap update_stored_headers(HTTP::HeaderMap const& stored_headers, HTTP::HeaderMap const& response_headers);
+
 }
@@ -13,6 +13,7 @@
 #include <LibCore/Proxy.h>
 #include <LibCore/Socket.h>
 #include <LibCore/StandardPaths.h>
+#include <LibCore/Trace.h>
 #include <LibRequests/NetworkError.h>
 #include <LibRequests/RequestTimingInfo.h>
 #include <LibRequests/WebSocket.h>
@@ -21,6 +22,7 @@
 #include <LibWebSocket/ConnectionInfo.h>
 #include <LibWebSocket/Message.h>
 #include <RequestServer/Cache/DiskCache.h>
+#include <RequestServer/Cache/Utilities.h>
 #include <RequestServer/ConnectionFromClient.h>
 #include <RequestServer/RequestClientEndpoint.h>
 
@@ -37,6 +39,15 @@ ByteString g_default_certificate_path;
 static HashMap<int, RefPtr<ConnectionFromClient>> s_connections;
 static IDAllocator s_client_ids;
 static long s_connect_timeout_seconds = 90L;
+
+// NOTE: This matches the limit of other browsers. curl queues transfers to a host beyond this limit.
+static long s_maximum_connections_per_host = 6L;
+
+// NOTE: This matches the default of CURLOPT_MAXAGE_CONN, after which curl no longer reuses an idle connection.
+static constexpr auto s_warm_connection_idle_timeout = AK::Duration::from_seconds(118);
+
+// While high priority requests are in flight, only this many low priority requests are allowed to be in flight as well.
+static constexpr size_t s_maximum_low_priority_requests_while_high_priority_requests_are_in_flight = 1;
 static struct {
     Optional<Core::SocketAddress> server_address;
     Optional<ByteString> server_hostname;
@@ -118,6 +129,8 @@ struct ConnectionFromClient::ActiveRequest : public Weakable<ActiveRequest> {
     WeakPtr<ConnectionFromClient> client;
     int writer_fd { 0 };
     bool is_connect_only { false };
+    bool is_transferring { false };
+    RequestPriority priority { RequestPriority::Normal };
     size_t downloaded_so_far { 0 };
     URL::URL url;
     ByteString method;
@@ -138,6 +151,20 @@ struct ConnectionFromClient::ActiveRequest : public Weakable<ActiveRequest> {
     Optional<CacheEntryWriter&> cache_entry;
     UnixDateTime request_start_time;
 
+    // These are used to place curl's timings, which are relative to the start of the transfer, on the timeline of the
+    // request as a whole. Our own DNS lookup happens before curl ever sees the request.
+    MonotonicTime request_received_time { MonotonicTime::now() };
+    MonotonicTime dns_lookup_start_time { request_received_time };
+    MonotonicTime dns_lookup_end_time { request_received_time };
+    MonotonicTime transfer_start_time { request_received_time };
+
+    Optional<RevalidateCacheEntry> revalidation;
+
+    // Set once the response has been validated by a 304 response, and the cache entry is piped to the client instead.
+    bool served_from_cache { false };
+
+    bool is_background_revalidation() const { return revalidation.has_value() && revalidation->in_background; }
+
     ActiveRequest(ConnectionFromClient& client, CURLM* multi, CURL* easy, i32 request_id, int writer_fd)
         : multi(multi)
         , easy(easy)
@@ -199,28 +226,42 @@ struct ConnectionFromClient::ActiveRequest : public Weakable<ActiveRequest> {
             }
         }
 
+        // The body of a 304 response is meaningless, the client receives the body of the cache entry instead.
+        if (served_from_cache) {
+            MUST(send_buffer.discard(available_bytes));
+            return {};
+        }
+
         Vector<u8> bytes_to_send;
         bytes_to_send.resize(available_bytes);
         send_buffer.peek_some(bytes_to_send);
 
-        auto result = Core::System::write(this->writer_fd, bytes_to_send);
-        if (result.is_error()) {
-            if (result.error().code() != EAGAIN) {
-                return result.release_error();
+        size_t bytes_written = 0;
+
+        // NOTE: Nobody is reading the response to a background revalidation, it only ends up in the cache.
+        if (is_background_revalidation()) {
+            bytes_written = bytes_to_send.size();
+        } else {
+            auto result = Core::System::write(this->writer_fd, bytes_to_send);
+            if (result.is_error()) {
+                if (result.error().code() != EAGAIN) {
+                    return result.release_error();
+                }
+                write_notifier->set_enabled(true);
+                return {};
             }
-            write_notifier->set_enabled(true);
-            return {};
+            bytes_written = result.value();
         }
 
         if (cache_entry.has_value()) {
-            auto bytes_sent = bytes_to_send.span().slice(0, result.value());
+            auto bytes_sent = bytes_to_send.span().slice(0, bytes_written);
 
             if (cache_entry->write_data(bytes_sent).is_error())
                 cache_entry.clear();
         }
 
-        bytes_transferred_to_client += result.value();
-        MUST(send_buffer.discard(result.value()));
+        bytes_transferred_to_client += bytes_written;
+        MUST(send_buffer.discard(bytes_written));
 
         write_notifier->set_enabled(!send_buffer.is_eof());
         if (send_buffer.is_eof() && done_fetching)
@@ -254,6 +295,9 @@ struct ConnectionFromClient::ActiveRequest : public Weakable<ActiveRequest> {
 
         if (cache_entry.has_value())
             (void)cache_entry->flush();
+
+        if (is_background_revalidation() && g_disk_cache.has_value())
+            g_disk_cache->finished_revalidating_entry_in_background(url, method);
     }
 
     void flush_headers_if_needed()
@@ -265,12 +309,50 @@ struct ConnectionFromClient::ActiveRequest : public Weakable<ActiveRequest> {
             return;
         got_all_headers = true;
 
-        client->async_headers_became_available(request_id, headers, *http_status_code, reason_phrase);
+        if (revalidation.has_value() && *http_status_code == 304) {
+            if (handle_not_modified_response())
+                return;
+        }
+
+        if (!is_background_revalidation())
+            client->async_headers_became_available(request_id, headers, *http_status_code, reason_phrase);
 
         if (g_disk_cache.has_value())
             cache_entry = g_disk_cache->create_entry(url, method, *http_status_code, reason_phrase, headers, request_start_time);
     }
 
+    // https://httpwg.org/specs/rfc9111.html#validation.response
+    bool handle_not_modified_response()
+    {
+        if (!g_disk_cache.has_value())
+            return false;
+
+        if (!g_disk_cache->update_entry_after_revalidation(url, method, headers, request_start_time)) {
+            dbgln("Warning: Unable to update cache entry for {} after revalidation, passing the 304 response along", url);
+            return false;
+        }
+
+        if (is_background_revalidation())
+            return true;
+
+        auto cache_entry = g_disk_cache->open_entry(url, method);
+        if (!cache_entry.has_value())
+            return false;
+
+        // NOTE: The entry was just validated, so it is served no matter what it would otherwise require.
+        if (cache_entry->revalidation() == CacheRevalidation::InBackground)
+            g_disk_cache->finished_revalidating_entry_in_background(url, method);
+
+        served_from_cache = true;
+
+        // The cache entry takes over writing to the client from here on.
+        auto fd = exchange(writer_fd, 0);
+        write_notifier->close();
+
+        client->pipe_cache_entry_to_client(*cache_entry, request_id, fd, request_received_time, method, url, move(revalidation->original_request_headers), {}, revalidation->proxy_data, priority);
+        return true;
+    }
+
     long acquire_http_status_code() const
     {
         long code = 0;
@@ -393,6 +475,10 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transpo
 {
     s_connections.set(client_id(), *this);
 
+    // Request updates are small, and there are a lot of them while pages load.
+    if (auto result = this->transport().send_messages_through_shared_memory(); result.is_error())
+        dbgln("RequestServer: Unable to send messages through shared memory: {}", result.error());
+
     m_alt_svc_cache_path = ByteString::formatted("{}/Ladybird/alt-svc-cache.txt", Core::StandardPaths::user_data_directory());
 
     m_curl_multi = curl_multi_init();
@@ -405,6 +491,7 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transpo
     set_option(CURLMOPT_SOCKETDATA, this);
     set_option(CURLMOPT_TIMERFUNCTION, &on_timeout_callback);
     set_option(CURLMOPT_TIMERDATA, this);
+    set_option(CURLMOPT_MAX_HOST_CONNECTIONS, s_maximum_connections_per_host);
 
     m_timer = Core::Timer::create_single_shot(0, [this] {
         auto result = curl_multi_socket_action(m_curl_multi, CURL_SOCKET_TIMEOUT, 0, nullptr);
@@ -530,69 +617,181 @@ void ConnectionFromClient::set_use_system_dns()
 }
 
 #ifdef AK_OS_WINDOWS
-void ConnectionFromClient::start_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData)
+void ConnectionFromClient::start_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, RequestPriority)
 {
     VERIFY(0 && "RequestServer::ConnectionFromClient::start_request is not implemented");
 }
 
-void ConnectionFromClient::issue_network_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, Optional<ResumeRequestForFailedCacheEntry>)
+void ConnectionFromClient::issue_network_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, RequestPriority, Optional<ResumeRequestForFailedCacheEntry>, Optional<RevalidateCacheEntry>)
 {
     VERIFY(0 && "RequestServer::ConnectionFromClient::issue_network_request is not implemented");
 }
+
+void ConnectionFromClient::pipe_cache_entry_to_client(CacheEntryReader&, i32, int, MonotonicTime, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, RequestPriority)
+{
+    VERIFY(0 && "RequestServer::ConnectionFromClient::pipe_cache_entry_to_client is not implemented");
+}
+
+void ConnectionFromClient::revalidate_cache_entry_in_background(CacheEntryReader const&, ByteString, URL::URL, HTTP::HeaderMap const&, Core::ProxyData)
+{
+    VERIFY(0 && "RequestServer::ConnectionFromClient::revalidate_cache_entry_in_background is not implemented");
+}
 #else
-void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data)
+void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data, RequestPriority priority)
 {
     dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: start_request({}, {})", request_id, url);
 
+    auto request_received_time = MonotonicTime::now();
+
     if (g_disk_cache.has_value()) {
         if (auto cache_entry = g_disk_cache->open_entry(url, method); cache_entry.has_value()) {
+            auto revalidation = cache_entry->revalidation();
+
+            // NOTE: If the client is validating a response it has stored itself, we leave the validation up to it.
+            auto request_is_conditional = request_headers.contains("If-None-Match"sv) || request_headers.contains("If-Modified-Since"sv);
+
+            if (revalidation == CacheRevalidation::Required || (revalidation == CacheRevalidation::InBackground && request_is_conditional)) {
+                if (revalidation == CacheRevalidation::InBackground)
+                    g_disk_cache->finished_revalidating_entry_in_background(url, method);
+
+                if (request_is_conditional) {
+                    cache_entry->close();
+                    issue_network_request(request_id, move(method), move(url), move(request_headers), move(request_body), proxy_data, priority);
+                    return;
+                }
+
+                auto conditional_request_headers = create_conditional_request_headers(request_headers, cache_entry->headers());
+                cache_entry->close();
+
+                RevalidateCacheEntry revalidate_cache_entry {
+                    .original_request_headers = move(request_headers),
+                    .proxy_data = proxy_data,
+                    .in_background = false,
+                };
+
+                issue_network_request(request_id, move(method), move(url), move(conditional_request_headers), move(request_body), proxy_data, priority, {}, move(revalidate_cache_entry));
+                return;
+            }
+
+            // The stale response is served right away, while a conditional request updates the entry for later use.
+            if (revalidation == CacheRevalidation::InBackground)
+                revalidate_cache_entry_in_background(*cache_entry, method, url, request_headers, proxy_data);
+
             auto fds = MUST(Core::System::pipe2(O_NONBLOCK));
             auto writer_fd = fds[1];
             auto reader_fd = fds[0];
 
             async_request_started(request_id, IPC::File::adopt_fd(reader_fd));
-            async_headers_became_available(request_id, cache_entry->headers(), cache_entry->status_code(), cache_entry->reason_phrase());
-
-            cache_entry->pipe_to(
-                writer_fd,
-                [this, request_id, writer_fd](auto bytes_sent) {
-                    // FIXME: Implement timing info for cache hits.
-                    async_request_finished(request_id, bytes_sent, {}, {});
-                    MUST(Core::System::close(writer_fd));
-                },
-                [this, request_id, writer_fd, method = move(method), url = move(url), request_headers = move(request_headers), request_body = move(request_body), proxy_data](auto bytes_sent) mutable {
-                    // FIXME: We should really also have a way to validate the data once CacheEntry is storing its crc.
-                    ResumeRequestForFailedCacheEntry resume_request {
-                        .start_offset = bytes_sent,
-                        .writer_fd = writer_fd,
-                    };
-
-                    issue_network_request(request_id, move(method), move(url), move(request_headers), move(request_body), proxy_data, resume_request);
-                });
+            pipe_cache_entry_to_client(*cache_entry, request_id, writer_fd, request_received_time, move(method), move(url), move(request_headers), move(request_body), proxy_data, priority);
 
             return;
         }
     }
 
-    issue_network_request(request_id, move(method), move(url), move(request_headers), move(request_body), proxy_data);
+    issue_network_request(request_id, move(method), move(url), move(request_headers), move(request_body), proxy_data, priority);
+}
+
+void ConnectionFromClient::pipe_cache_entry_to_client(CacheEntryReader& cache_entry, i32 request_id, int writer_fd, MonotonicTime request_received_time, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data, RequestPriority priority)
+{
+    // NOTE: For cache hits, the time between receiving the request and starting the response is the cache lookup.
+    auto response_start_time = MonotonicTime::now();
+
+    async_headers_became_available(request_id, cache_entry.headers(), cache_entry.status_code(), cache_entry.reason_phrase());
+
+    cache_entry.pipe_to(
+        writer_fd,
+        [this, request_id, writer_fd, request_received_time, response_start_time](auto bytes_sent) {
+            auto response_end_time = MonotonicTime::now();
+
+            Requests::RequestTimingInfo timing_info {
+                .response_start_microseconds = (response_start_time - request_received_time).to_microseconds(),
+                .response_end_microseconds = (response_end_time - request_received_time).to_microseconds(),
+            };
+
+            async_request_finished(request_id, bytes_sent, timing_info, {});
+            MUST(Core::System::close(writer_fd));
+        },
+        [this, request_id, writer_fd, method = move(method), url = move(url), request_headers = move(request_headers), request_body = move(request_body), proxy_data, priority](auto bytes_sent) mutable {
+            // FIXME: We should really also have a way to validate the data once CacheEntry is storing its crc.
+            ResumeRequestForFailedCacheEntry resume_request {
+                .start_offset = bytes_sent,
+                .writer_fd = writer_fd,
+            };
+
+            issue_network_request(request_id, move(method), move(url), move(request_headers), move(request_body), proxy_data, priority, resume_request);
+        });
+}
+
+void ConnectionFromClient::revalidate_cache_entry_in_background(CacheEntryReader const& cache_entry, ByteString method, URL::URL url, HTTP::HeaderMap const& request_headers, Core::ProxyData proxy_data)
+{
+    auto request_id = m_next_background_request_id--;
+    if (m_next_background_request_id == NumericLimits<i32>::min())
+        m_next_background_request_id = -1;
+
+    dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: Revalidating cache entry for {} in the background ({})", url, request_id);
+
+    auto conditional_request_headers = create_conditional_request_headers(request_headers, cache_entry.headers());
+
+    RevalidateCacheEntry revalidate_cache_entry {
+        .original_request_headers = request_headers,
+        .proxy_data = proxy_data,
+        .in_background = true,
+    };
+
+    issue_network_request(request_id, move(method), move(url), move(conditional_request_headers), {}, proxy_data, RequestPriority::Low, {}, move(revalidate_cache_entry));
+}
+
+static long stream_weight_for_priority(RequestPriority priority)
+{
+    // NOTE: These are HTTP/2 stream weights, which range from 1 to 256. curl uses 16 by default.
+    switch (priority) {
+    case RequestPriority::Low:
+        return 1L;
+    case RequestPriority::Normal:
+        return 16L;
+    case RequestPriority::High:
+        return 256L;
+    }
+    VERIFY_NOT_REACHED();
 }
 
-void ConnectionFromClient::issue_network_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data, Optional<ResumeRequestForFailedCacheEntry> resume_request)
+void ConnectionFromClient::issue_network_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data, RequestPriority priority, Optional<ResumeRequestForFailedCacheEntry> resume_request, Optional<RevalidateCacheEntry> revalidate_cache_entry)
 {
     auto host = url.serialized_host().to_byte_string();
+    auto is_background_revalidation = revalidate_cache_entry.has_value() && revalidate_cache_entry->in_background;
+    auto dns_lookup_start_time = MonotonicTime::now();
+
+    auto fail_background_revalidation = [url, method]() {
+        if (g_disk_cache.has_value())
+            g_disk_cache->finished_revalidating_entry_in_background(url, method);
+    };
 
     m_resolver->dns.lookup(host, DNS::Messages::Class::IN, { DNS::Messages::ResourceType::A, DNS::Messages::ResourceType::AAAA }, { .validate_dnssec_locally = g_dns_info.validate_dnssec_locally })
-        ->when_rejected([this, request_id, resume_request](auto const& error) {
+        ->when_rejected([this, request_id, resume_request, is_background_revalidation, fail_background_revalidation](auto const& error) {
             dbgln("StartRequest: DNS lookup failed: {}", error);
+
+            if (is_background_revalidation) {
+                fail_background_revalidation();
+                return;
+            }
+
             // FIXME: Implement timing info for DNS lookup failure.
             async_request_finished(request_id, 0, {}, Requests::NetworkError::UnableToResolveHost);
 
             if (resume_request.has_value())
                 MUST(Core::System::close(resume_request->writer_fd));
         })
-        .when_resolved([this, request_id, host = move(host), url = move(url), method = move(method), request_body = move(request_body), request_headers = move(request_headers), proxy_data, resume_request](auto const& dns_result) mutable {
+        .when_resolved([this, request_id, host = move(host), url = move(url), method = move(method), request_body = move(request_body), request_headers = move(request_headers), proxy_data, priority, resume_request, revalidate_cache_entry = move(revalidate_cache_entry), is_background_revalidation, fail_background_revalidation, dns_lookup_start_time](auto const& dns_result) mutable {
+            auto dns_lookup_end_time = MonotonicTime::now();
+
             if (dns_result->is_empty() || !dns_result->has_cached_addresses()) {
                 dbgln("StartRequest: DNS lookup failed for '{}'", host);
+
+                if (is_background_revalidation) {
+                    fail_background_revalidation();
+                    return;
+                }
+
                 // FIXME: Implement timing info for DNS lookup failure.
                 async_request_finished(request_id, 0, {}, Requests::NetworkError::UnableToResolveHost);
                 return;
@@ -603,6 +802,8 @@ void ConnectionFromClient::issue_network_request(i32 request_id, ByteString meth
             auto* easy = curl_easy_init();
             if (!easy) {
                 dbgln("StartRequest: Failed to initialize curl easy handle");
+                if (is_background_revalidation)
+                    fail_background_revalidation();
                 return;
             }
 
@@ -610,6 +811,8 @@ void ConnectionFromClient::issue_network_request(i32 request_id, ByteString meth
 
             if (resume_request.has_value()) {
                 writer_fd = resume_request->writer_fd;
+            } else if (is_background_revalidation) {
+                writer_fd = -1;
             } else {
                 auto fds_or_error = Core::System::pipe2(O_NONBLOCK);
                 if (fds_or_error.is_error()) {
@@ -627,6 +830,11 @@ void ConnectionFromClient::issue_network_request(i32 request_id, ByteString meth
             auto request = make<ActiveRequest>(*this, m_curl_multi, easy, request_id, writer_fd);
             request->url = url;
             request->method = method;
+            request->priority = priority;
+            request->revalidation = move(revalidate_cache_entry);
+            request->request_received_time = dns_lookup_start_time;
+            request->dns_lookup_start_time = dns_lookup_start_time;
+            request->dns_lookup_end_time = dns_lookup_end_time;
 
             auto set_option = [easy](auto option, auto value) {
                 auto result = curl_easy_setopt(easy, option, value);
@@ -645,6 +853,7 @@ void ConnectionFromClient::issue_network_request(i32 request_id, ByteString meth
             set_option(CURLOPT_CONNECTTIMEOUT, s_connect_timeout_seconds);
             set_option(CURLOPT_PIPEWAIT, 1L);
             set_option(CURLOPT_ALTSVC, m_alt_svc_cache_path.characters());
+            set_option(CURLOPT_STREAM_WEIGHT, stream_weight_for_priority(priority));
 
             set_option(CURLOPT_CUSTOMREQUEST, method.characters());
             set_option(CURLOPT_FOLLOWLOCATION, 0);
@@ -713,14 +922,69 @@ void ConnectionFromClient::issue_network_request(i32 request_id, ByteString meth
             } else
                 VERIFY_NOT_REACHED();
 
-            auto result = curl_multi_add_handle(m_curl_multi, easy);
-            VERIFY(result == CURLM_OK);
-
+            auto& active_request = *request;
             m_active_requests.set(request_id, move(request));
+            Core::Trace::add_counter("Active requests"sv, m_active_requests.size());
+
+            if (priority == RequestPriority::Low && should_delay_low_priority_request()) {
+                dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: Delaying low priority request {} for {}", request_id, url);
+                m_delayed_low_priority_requests.append(request_id);
+                return;
+            }
+
+            start_transfer(active_request);
         });
 }
 #endif
 
+void ConnectionFromClient::start_transfer(ActiveRequest& request)
+{
+    VERIFY(!request.is_transferring);
+    request.is_transferring = true;
+    request.transfer_start_time = MonotonicTime::now();
+
+    auto result = curl_multi_add_handle(m_curl_multi, request.easy);
+    VERIFY(result == CURLM_OK);
+}
+
+bool ConnectionFromClient::should_delay_low_priority_request() const
+{
+    size_t high_priority_requests_in_flight = 0;
+    size_t low_priority_requests_in_flight = 0;
+
+    for (auto const& [_, request] : m_active_requests) {
+        if (!request->is_transferring || request->done_fetching)
+            continue;
+
+        if (request->priority == RequestPriority::High)
+            ++high_priority_requests_in_flight;
+        else if (request->priority == RequestPriority::Low)
+            ++low_priority_requests_in_flight;
+    }
+
+    return high_priority_requests_in_flight != 0
+        && low_priority_requests_in_flight >= s_maximum_low_priority_requests_while_high_priority_requests_are_in_flight;
+}
+
+void ConnectionFromClient::start_delayed_low_priority_requests()
+{
+    while (!m_delayed_low_priority_requests.is_empty()) {
+        auto request = m_active_requests.get(m_delayed_low_priority_requests.first());
+
+        // The request has been stopped while it was waiting.
+        if (!request.has_value()) {
+            m_delayed_low_priority_requests.take_first();
+            continue;
+        }
+
+        if (should_delay_low_priority_request())
+            return;
+
+        m_delayed_low_priority_requests.take_first();
+        start_transfer(**request);
+    }
+}
+
 static Requests::NetworkError map_curl_code_to_network_error(CURLcode const& code)
 {
     switch (code) {
@@ -747,7 +1011,9 @@ static Requests::NetworkError map_curl_code_to_network_error(CURLcode const& cod
     }
 }
 
-static Requests::RequestTimingInfo get_timing_info_from_curl_easy_handle(CURL* easy_handle)
+// The DNS lookup timings and the transfer start time are relative to the time we received the request, and curl's timings
+// are relative to the start of the transfer.
+static Requests::RequestTimingInfo get_timing_info_from_curl_easy_handle(CURL* easy_handle, AK::Duration dns_lookup_start, AK::Duration dns_lookup_end, AK::Duration transfer_start)
 {
     /*
      *   curl_easy_perform()
@@ -770,7 +1036,7 @@ static Requests::RequestTimingInfo get_timing_info_from_curl_easy_handle(CURL* e
         return time_value;
     };
 
-    auto queue_time = get_timing_info(CURLINFO_QUEUE_TIME_T);
+    // NOTE: Each of curl's timings is the time from the start of the transfer until the respective phase was complete.
     auto domain_lookup_time = get_timing_info(CURLINFO_NAMELOOKUP_TIME_T);
     auto connect_time = get_timing_info(CURLINFO_CONNECT_TIME_T);
     auto secure_connect_time = get_timing_info(CURLINFO_APPCONNECT_TIME_T);
@@ -802,15 +1068,23 @@ static Requests::RequestTimingInfo get_timing_info_from_curl_easy_handle(CURL* e
         break;
     }
 
+    auto transfer_start_time = transfer_start.to_microseconds();
+
+    // NOTE: Connections that are reused have no connect timings, and connections without TLS have no secure connect
+    //       timings. For those, the respective phase takes no time at all.
+    auto connect_start_time = transfer_start_time + domain_lookup_time;
+    auto connect_end_time = transfer_start_time + max(domain_lookup_time, max(connect_time, secure_connect_time));
+    auto secure_connect_start_time = secure_connect_time != 0 ? transfer_start_time + connect_time : 0;
+
     return Requests::RequestTimingInfo {
-        .domain_lookup_start_microseconds = queue_time,
-        .domain_lookup_end_microseconds = queue_time + domain_lookup_time,
-        .connect_start_microseconds = queue_time + domain_lookup_time,
-        .connect_end_microseconds = queue_time + domain_lookup_time + connect_time + secure_connect_time,
-        .secure_connect_start_microseconds = queue_time + domain_lookup_time + connect_time,
-        .request_start_microseconds = queue_time + domain_lookup_time + connect_time + secure_connect_time + request_start_time,
-        .response_start_microseconds = queue_time + domain_lookup_time + connect_time + secure_connect_time + response_start_time,
-        .response_end_microseconds = queue_time + domain_lookup_time + connect_time + secure_connect_time + response_end_time,
+        .domain_lookup_start_microseconds = dns_lookup_start.to_microseconds(),
+        .domain_lookup_end_microseconds = dns_lookup_end.to_microseconds(),
+        .connect_start_microseconds = connect_start_time,
+        .connect_end_microseconds = connect_end_time,
+        .secure_connect_start_microseconds = secure_connect_start_time,
+        .request_start_microseconds = transfer_start_time + request_start_time,
+        .response_start_microseconds = transfer_start_time + response_start_time,
+        .response_end_microseconds = transfer_start_time + response_end_time,
         .encoded_body_size = encoded_body_size,
         .http_version_alpn_identifier = http_version_alpn,
     };
@@ -842,8 +1116,17 @@ void ConnectionFromClient::check_active_requests()
 
         auto* request = static_cast<ActiveRequest*>(application_private);
 
+        if (msg->data.result == CURLE_OK)
+            did_use_connection_to(request->url);
+        else
+            did_fail_to_connect_to(request->url);
+
         if (!request->is_connect_only) {
-            auto timing_info = get_timing_info_from_curl_easy_handle(msg->easy_handle);
+            auto timing_info = get_timing_info_from_curl_easy_handle(
+                msg->easy_handle,
+                request->dns_lookup_start_time - request->request_received_time,
+                request->dns_lookup_end_time - request->request_received_time,
+                request->transfer_start_time - request->request_received_time);
             request->flush_headers_if_needed();
 
             auto result_code = msg->data.result;
@@ -866,11 +1149,15 @@ void ConnectionFromClient::check_active_requests()
                 }
             }
 
-            async_request_finished(request->request_id, request->downloaded_so_far, timing_info, network_error);
+            if (!request->is_background_revalidation() && !request->served_from_cache)
+                async_request_finished(request->request_id, request->downloaded_so_far, timing_info, network_error);
         }
 
         request->notify_about_fetching_completion();
     }
+
+    Core::Trace::add_counter("Active requests"sv, m_active_requests.size());
+    start_delayed_low_priority_requests();
 }
 
 Messages::RequestServer::StopRequestResponse ConnectionFromClient::stop_request(i32 request_id)
@@ -881,6 +1168,7 @@ Messages::RequestServer::StopRequestResponse ConnectionFromClient::stop_request(
         return false;
     }
 
+    start_delayed_low_priority_requests();
     return true;
 }
 
@@ -892,9 +1180,45 @@ Messages::RequestServer::SetCertificateResponse ConnectionFromClient::set_certif
     TODO();
 }
 
+static ByteString connection_key_for_url(URL::URL const& url)
+{
+    return ByteString::formatted("{}://{}:{}", url.scheme(), url.serialized_host(), url.port_or_default());
+}
+
+bool ConnectionFromClient::has_warm_connection_to(URL::URL const& url) const
+{
+    auto last_used = m_warm_connections.get(connection_key_for_url(url));
+    return last_used.has_value() && MonotonicTime::now() - *last_used < s_warm_connection_idle_timeout;
+}
+
+void ConnectionFromClient::did_use_connection_to(URL::URL const& url)
+{
+    auto now = MonotonicTime::now();
+
+    m_warm_connections.remove_all_matching([&](auto const&, MonotonicTime last_used) {
+        return now - last_used >= s_warm_connection_idle_timeout;
+    });
+
+    m_warm_connections.set(connection_key_for_url(url), now);
+}
+
+void ConnectionFromClient::did_fail_to_connect_to(URL::URL const& url)
+{
+    m_warm_connections.remove(connection_key_for_url(url));
+}
+
 void ConnectionFromClient::ensure_connection(URL::URL url, ::RequestServer::CacheLevel cache_level)
 {
     if (cache_level == CacheLevel::CreateConnection) {
+        if (has_warm_connection_to(url)) {
+            dbgln_if(REQUESTSERVER_DEBUG, "EnsureConnection: Already connected to {}", url);
+            return;
+        }
+
+        // NOTE: We consider the connection warm as soon as it is being set up, so that repeated hints don't create more
+        //       connections to the same origin.
+        did_use_connection_to(url);
+
         auto* easy = curl_easy_init();
         if (!easy) {
             dbgln("EnsureConnection: Failed to initialize curl easy handle");
@@ -950,6 +1274,23 @@ void ConnectionFromClient::clear_cache()
         g_disk_cache->clear_cache();
 }
 
+Messages::RequestServer::GetMemoryCacheStatisticsResponse ConnectionFromClient::get_memory_cache_statistics()
+{
+    if (!g_disk_cache.has_value())
+        return { 0, 0, 0, 0, 0 };
+
+    auto const& memory_cache = g_disk_cache->memory_cache();
+    auto const& statistics = memory_cache.statistics();
+
+    return { statistics.hits, statistics.misses, statistics.evictions, memory_cache.entry_count(), memory_cache.size() };
+}
+
+Messages::RequestServer::GetDnsCacheStatisticsResponse ConnectionFromClient::get_dns_cache_statistics()
+{
+    auto statistics = m_resolver->dns.cache_statistics();
+    return { statistics.hits, statistics.stale_hits, statistics.negative_hits, statistics.misses, statistics.entry_count };
+}
+
 void ConnectionFromClient::websocket_connect(i64 websocket_id, URL::URL url, ByteString origin, Vector<ByteString> protocols, Vector<ByteString> extensions, HTTP::HeaderMap additional_request_headers)
 {
     auto host = url.serialized_host().to_byte_string();
@@ -7,9 +7,11 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/Time.h>
 #include <LibDNS/Resolver.h>
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibWebSocket/WebSocket.h>
+#include <RequestServer/Forward.h>
 #include <RequestServer/RequestClientEndpoint.h>
 #include <RequestServer/RequestServerEndpoint.h>
 
@@ -44,12 +46,14 @@ private:
     virtual Messages::RequestServer::IsSupportedProtocolResponse is_supported_protocol(ByteString) override;
     virtual void set_dns_server(ByteString host_or_address, u16 port, bool use_tls, bool validate_dnssec_locally) override;
     virtual void set_use_system_dns() override;
-    virtual void start_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData) override;
+    virtual void start_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, ::RequestServer::RequestPriority) override;
     virtual Messages::RequestServer::StopRequestResponse stop_request(i32) override;
     virtual Messages::RequestServer::SetCertificateResponse set_certificate(i32, ByteString, ByteString) override;
     virtual void ensure_connection(URL::URL url, ::RequestServer::CacheLevel cache_level) override;
 
     virtual void clear_cache() override;
+    virtual Messages::RequestServer::GetMemoryCacheStatisticsResponse get_memory_cache_statistics() override;
+    virtual Messages::RequestServer::GetDnsCacheStatisticsResponse get_dns_cache_statistics() override;
 
     virtual void websocket_connect(i64 websocket_id, URL::URL, ByteString, Vector<ByteString>, Vector<ByteString>, HTTP::HeaderMap) override;
     virtual void websocket_send(i64 websocket_id, bool, ByteBuffer) override;
@@ -60,7 +64,20 @@ private:
         size_t start_offset { 0 };
         int writer_fd { 0 };
     };
-    void issue_network_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, Optional<ResumeRequestForFailedCacheEntry> = {});
+    struct RevalidateCacheEntry {
+        HTTP::HeaderMap original_request_headers;
+        Core::ProxyData proxy_data;
+
+        // Background revalidations update the cache entry without a client waiting for the response.
+        bool in_background { false };
+    };
+    void issue_network_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, RequestPriority, Optional<ResumeRequestForFailedCacheEntry> = {}, Optional<RevalidateCacheEntry> = {});
+
+    void pipe_cache_entry_to_client(CacheEntryReader&, i32 request_id, int writer_fd, MonotonicTime request_received_time, ByteString method, URL::URL, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData, RequestPriority);
+    void revalidate_cache_entry_in_background(CacheEntryReader const&, ByteString method, URL::URL, HTTP::HeaderMap const& request_headers, Core::ProxyData);
+
+    // Background revalidations are tracked like any other request, with IDs that cannot clash with those of the client.
+    i32 m_next_background_request_id { -1 };
 
     HashMap<i32, RefPtr<WebSocket::WebSocket>> m_websockets;
 
@@ -76,7 +93,22 @@ private:
 
     HashMap<i32, NonnullOwnPtr<ActiveRequest>> m_active_requests;
 
+    void start_transfer(ActiveRequest&);
+    bool should_delay_low_priority_request() const;
+    void start_delayed_low_priority_requests();
+
+    // Low priority requests that wait for high priority requests to finish before they are handed to curl.
+    Vector<i32> m_delayed_low_priority_requests;
+
     void check_active_requests();
+
+    // Origins that we have had a connection to recently, which curl keeps around for reuse until it has been idle for
+    // too long. This lets us ignore preconnect hints for origins that we are already connected to.
+    bool has_warm_connection_to(URL::URL const&) const;
+    void did_use_connection_to(URL::URL const&);
+    void did_fail_to_connect_to(URL::URL const&);
+    HashMap<ByteString, MonotonicTime> m_warm_connections;
+
     void* m_curl_multi { nullptr };
     RefPtr<Core::Timer> m_timer;
     HashMap<int, NonnullRefPtr<Core::Notifier>> m_read_notifiers;
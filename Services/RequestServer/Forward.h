@@ -13,5 +13,7 @@ class CacheEntryReader;
 class CacheEntryWriter;
 class CacheIndex;
 class DiskCache;
+class MemoryCache;
+class MemoryCacheEntry;
 
 }
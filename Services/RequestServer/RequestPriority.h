@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+namespace RequestServer {
+
+enum class RequestPriority {
+    Low,
+    Normal,
+    High,
+};
+
+}
@@ -200,6 +200,24 @@ void WebSocketImplCurl::read_from_socket()
         on_ready_to_read();
 }
 
+Optional<ByteString> WebSocketImplCurl::server_handshake_extensions() const
+{
+    // Curl leaves the Sec-WebSocket-Extensions header to us in raw mode, so that LibWebSocket can negotiate the
+    // extensions it implements itself.
+    curl_header* header = nullptr;
+    if (curl_easy_header(m_easy_handle, "Sec-WebSocket-Extensions", 0, CURLH_HEADER, -1, &header) != CURLHE_OK)
+        return {};
+
+    StringBuilder builder;
+    builder.append(StringView { header->value, strlen(header->value) });
+    for (size_t index = 1; index < header->amount; ++index) {
+        if (curl_easy_header(m_easy_handle, "Sec-WebSocket-Extensions", index, CURLH_HEADER, -1, &header) != CURLHE_OK)
+            break;
+        builder.appendff(", {}", StringView { header->value, strlen(header->value) });
+    }
+    return builder.to_byte_string();
+}
+
 bool WebSocketImplCurl::did_connect()
 {
     curl_socket_t socket_fd = CURL_SOCKET_BAD;
@@ -31,6 +31,7 @@ public:
     virtual void discard_connection() override;
 
     virtual bool handshake_complete_when_connected() const override { return true; }
+    virtual Optional<ByteString> server_handshake_extensions() const override;
 
     bool did_connect();
 
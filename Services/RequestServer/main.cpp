@@ -35,12 +35,14 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     Vector<ByteString> certificates;
     StringView mach_server_name;
     bool enable_http_disk_cache = false;
+    Optional<u64> http_disk_cache_size_limit;
     bool wait_for_debugger = false;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
     args_parser.add_option(enable_http_disk_cache, "Enable HTTP disk cache", "enable-http-disk-cache");
+    args_parser.add_option(http_disk_cache_size_limit, "Maximum size of the HTTP disk cache in MiB", "http-disk-cache-size-limit", 0, "size");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
     args_parser.parse(arguments);
 
@@ -59,10 +61,14 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
 #endif
 
     if (enable_http_disk_cache) {
-        if (auto cache = RequestServer::DiskCache::create(); cache.is_error())
+        auto maximum_size = http_disk_cache_size_limit.has_value() ? *http_disk_cache_size_limit * MiB : RequestServer::DiskCache::DEFAULT_MAXIMUM_SIZE;
+
+        if (auto cache = RequestServer::DiskCache::create(maximum_size); cache.is_error()) {
             warnln("Unable to create disk cache: {}", cache.error());
-        else
+        } else {
             RequestServer::g_disk_cache = cache.release_value();
+            RequestServer::g_disk_cache->remove_orphaned_cache_files();
+        }
     }
 
     auto client = TRY(IPC::take_over_accepted_client_from_system_server<RequestServer::ConnectionFromClient>());
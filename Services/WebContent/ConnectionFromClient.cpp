@@ -10,12 +10,17 @@
  */
 
 #include <AK/JsonObject.h>
+#include <AK/MemoryAccounting.h>
 #include <AK/QuickSort.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/EventLoopImplementation.h>
 #include <LibGC/Heap.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/FontDatabase.h>
+#include <LibGfx/SkiaBackendContext.h>
 #include <LibGfx/SystemTheme.h>
+#include <LibIPC/Statistics.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/Date.h>
 #include <LibUnicode/TimeZone.h>
@@ -23,6 +28,7 @@
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/CSS/ComputedProperties.h>
 #include <LibWeb/CSS/Parser/ErrorReporter.h>
+#include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/CookieStore/CookieStore.h>
 #include <LibWeb/DOM/Attr.h>
@@ -62,6 +68,9 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transpo
     : IPC::ConnectionFromClient<WebContentClientEndpoint, WebContentServerEndpoint>(*this, move(transport), 1)
     , m_page_host(PageHost::create(*this))
 {
+    // Paint notifications and the like make up most of what we send to the UI process, and are small and frequent.
+    if (auto result = this->transport().send_messages_through_shared_memory(); result.is_error())
+        dbgln("WebContent: Unable to send messages through shared memory: {}", result.error());
 }
 
 ConnectionFromClient::~ConnectionFromClient() = default;
@@ -364,11 +373,75 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString request, ByteSt
         return;
     }
 
+    if (request == "style-statistics") {
+        // NOTE: "on" starts collecting style statistics for the top-level document, "off" stops, and "dump"
+        //       followed by an optional number of selectors prints everything collected so far.
+        if (auto* doc = page->page().top_level_browsing_context().active_document()) {
+            auto& style_computer = doc->style_computer();
+            if (argument == "on" || argument == "off") {
+                style_computer.set_collects_statistics(argument == "on");
+            } else if (argument.starts_with("dump"sv)) {
+                if (auto const* statistics = style_computer.statistics()) {
+                    auto max_selector_count = argument.substring_view(4).trim_whitespace().to_number<size_t>();
+                    dbgln("{}", statistics->to_string(max_selector_count.value_or(20)));
+                } else {
+                    dbgln("Style statistics are not enabled");
+                }
+            }
+        }
+        return;
+    }
+
     if (request == "dump-all-css-errors") {
         Web::CSS::Parser::ErrorReporter::the().dump();
         return;
     }
 
+    if (request == "dump-network-log") {
+        Web::ResourceLoader::the().dump_network_log();
+        return;
+    }
+
+    if (request == "dump-timer-statistics") {
+        auto statistics = Core::EventLoop::timer_statistics();
+        dbgln("Timers: {} scheduled, {} fired, {} event loop wakeups", statistics.timer_count, statistics.fired_timer_count, statistics.wakeup_count);
+        return;
+    }
+
+    if (request == "dump-texture-cache-statistics") {
+        if (auto skia_backend_context = page->page().top_level_traversable()->skia_backend_context()) {
+            auto statistics = skia_backend_context->texture_cache_statistics();
+            dbgln("Texture cache: {} hits, {} misses, {} evictions, {} textures using {} bytes", statistics.hits, statistics.misses, statistics.evictions, statistics.entry_count, statistics.size_in_bytes);
+        } else {
+            dbgln("Texture cache is unused without GPU painting");
+        }
+        return;
+    }
+
+    if (request == "dump-ipc-statistics") {
+        if (auto* statistics = IPC::Statistics::the()) {
+            if (auto result = statistics->dump(); result.is_error())
+                dbgln("Unable to dump IPC statistics: {}", result.error());
+        } else {
+            dbgln("IPC statistics are disabled, set LADYBIRD_IPC_STATISTICS to enable them");
+        }
+        return;
+    }
+
+    if (request == "dump-memory-usage") {
+        if constexpr (AK::MemoryAccounting::is_enabled) {
+            dbgln("Memory used by AK containers:");
+            for (size_t i = 0; i < AK::MemoryAccounting::category_count; ++i) {
+                auto category = static_cast<AK::MemoryAccounting::Category>(i);
+                auto usage = AK::MemoryAccounting::usage(category);
+                dbgln("    {:20}: {} live bytes, {} allocations", AK::MemoryAccounting::category_name(category), usage.live_bytes, usage.allocation_count);
+            }
+        } else {
+            dbgln("Memory accounting is disabled, build with ENABLE_MEMORY_ACCOUNTING to enable it");
+        }
+        return;
+    }
+
     if (request == "collect-garbage") {
         // NOTE: We use deferred_invoke here to ensure that GC runs with as little on the stack as possible.
         Core::deferred_invoke([] {
@@ -1003,6 +1076,18 @@ static void append_gc_graph(StringBuilder& builder)
     gc_graph.serialize(builder);
 }
 
+static void append_gc_heap_snapshot(StringBuilder& builder)
+{
+    auto gc_heap_snapshot = Web::Bindings::main_thread_vm().heap().dump_heap_snapshot();
+    gc_heap_snapshot.serialize(builder);
+}
+
+static void append_gc_statistics(StringBuilder& builder)
+{
+    auto gc_statistics = Web::Bindings::main_thread_vm().heap().dump_statistics();
+    gc_statistics.serialize(builder);
+}
+
 void ConnectionFromClient::request_internal_page_info(u64 page_id, WebView::PageInfoType type)
 {
     auto page = this->page(page_id);
@@ -1041,6 +1126,18 @@ void ConnectionFromClient::request_internal_page_info(u64 page_id, WebView::Page
         append_gc_graph(builder);
     }
 
+    if (has_flag(type, WebView::PageInfoType::GCStatistics)) {
+        if (!builder.is_empty())
+            builder.append("\n"sv);
+        append_gc_statistics(builder);
+    }
+
+    if (has_flag(type, WebView::PageInfoType::GCHeapSnapshot)) {
+        if (!builder.is_empty())
+            builder.append("\n"sv);
+        append_gc_heap_snapshot(builder);
+    }
+
     async_did_get_internal_page_info(page_id, type, MUST(builder.to_string()));
 }
 
@@ -1224,6 +1321,10 @@ void ConnectionFromClient::set_system_visibility_state(u64 page_id, Web::HTML::V
 {
     if (auto page = this->page(page_id); page.has_value())
         page->page().top_level_traversable()->set_system_visibility_state(visibility_state);
+
+    // Timers of pages that nobody can see don't need to be precise, so we let them fire in batches to wake up less.
+    static constexpr auto background_timer_slack = AK::Duration::from_seconds(1);
+    Core::EventLoop::set_timer_slack(m_page_host->has_visible_page() ? AK::Duration::zero() : background_timer_slack);
 }
 
 void ConnectionFromClient::reset_zoom(u64 page_id)
@@ -1337,6 +1438,20 @@ void ConnectionFromClient::system_time_zone_changed()
     Unicode::clear_system_time_zone_cache();
 }
 
+void ConnectionFromClient::handle_memory_pressure(WebView::MemoryPressureLevel level)
+{
+    Gfx::Font::clear_all_shaping_caches();
+    Web::CSS::Parser::Parser::clear_style_sheet_cache();
+    Web::ResourceLoader::the().clear_cache();
+
+    if (level == WebView::MemoryPressureLevel::Critical) {
+        // NOTE: We use deferred_invoke here to ensure that GC runs with as little on the stack as possible.
+        Core::deferred_invoke([] {
+            Web::Bindings::main_thread_vm().heap().collect_garbage(GC::Heap::CollectionType::CollectGarbage, true);
+        });
+    }
+}
+
 void ConnectionFromClient::cookies_changed(Vector<Web::Cookie::Cookie> cookies)
 {
     for (auto& navigable : Web::HTML::all_navigables()) {
@@ -1347,4 +1462,11 @@ void ConnectionFromClient::cookies_changed(Vector<Web::Cookie::Cookie> cookies)
     }
 }
 
+void ConnectionFromClient::storage_items_changed(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, Vector<Web::StorageAPI::StorageItemChange> changes)
+{
+    if (storage_endpoint != Web::StorageAPI::StorageEndpointType::LocalStorage)
+        return;
+    Web::HTML::Storage::apply_local_storage_changes_from_other_process(storage_key, changes);
+}
+
 }
@@ -160,7 +160,9 @@ private:
     virtual void paste(u64 page_id, Utf16String text) override;
 
     virtual void system_time_zone_changed() override;
+    virtual void handle_memory_pressure(WebView::MemoryPressureLevel) override;
     virtual void cookies_changed(Vector<Web::Cookie::Cookie>) override;
+    virtual void storage_items_changed(Web::StorageAPI::StorageEndpointType, String, Vector<Web::StorageAPI::StorageItemChange>) override;
 
     NonnullOwnPtr<PageHost> m_page_host;
 
@@ -17,7 +17,6 @@
 #include <LibWeb/PixelUnits.h>
 #include <LibWeb/StorageAPI/StorageEndpoint.h>
 #include <LibWebView/Forward.h>
-#include <LibWebView/StorageOperationError.h>
 #include <WebContent/Forward.h>
 
 namespace WebContent {
@@ -150,11 +149,12 @@ private:
     virtual void page_did_set_cookie(URL::URL const&, Web::Cookie::ParsedCookie const&, Web::Cookie::Source) override;
     virtual void page_did_update_cookie(Web::Cookie::Cookie const&) override;
     virtual void page_did_expire_cookies_with_time_offset(AK::Duration) override;
-    virtual Optional<String> page_did_request_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, String const& bottle_key) override;
-    virtual WebView::StorageOperationError page_did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, String const& bottle_key, String const& value) override;
-    virtual void page_did_remove_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, String const& bottle_key) override;
-    virtual Vector<String> page_did_request_storage_keys(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key) override;
-    virtual void page_did_clear_storage(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key) override;
+    virtual HashMap<String, String> page_did_request_storage_items(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key) override;
+    virtual void page_did_update_storage_items(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, Vector<Web::StorageAPI::StorageItemChange> const& changes) override;
+    virtual Optional<Web::IndexedDB::PersistedDatabase> page_did_request_indexed_db_database(String const& storage_key, String const& name) override;
+    virtual HashMap<String, u64> page_did_request_indexed_db_database_versions(String const& storage_key) override;
+    virtual void page_did_commit_indexed_db_transaction(String const& storage_key, String const& name, Web::IndexedDB::PersistedDatabaseChanges const& changes) override;
+    virtual void page_did_delete_indexed_db_database(String const& storage_key, String const& name) override;
     virtual void page_did_update_resource_count(i32) override;
     virtual NewWebViewResult page_did_request_new_web_view(Web::HTML::ActivateTab, Web::HTML::WebViewHints, Web::HTML::TokenizedFeature::NoOpener) override;
     virtual void page_did_request_activate_tab() override;
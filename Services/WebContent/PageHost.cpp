@@ -41,6 +41,16 @@ Optional<PageClient&> PageHost::page(u64 index)
     });
 }
 
+bool PageHost::has_visible_page() const
+{
+    for (auto const& it : m_pages) {
+        auto& page = it.value->page();
+        if (page.top_level_traversable_is_initialized() && page.top_level_traversable()->system_visibility_state() == Web::HTML::VisibilityState::Visible)
+            return true;
+    }
+    return false;
+}
+
 PageHost::~PageHost() = default;
 
 }
@@ -28,6 +28,8 @@ public:
     PageClient& create_page();
     void remove_page(Badge<PageClient>, u64 index);
 
+    bool has_visible_page() const;
+
     ConnectionFromClient& client() const { return m_client; }
 
 private:
@@ -22,6 +22,7 @@
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/Fetch/Fetching/Fetching.h>
 #include <LibWeb/HTML/Window.h>
+#include <LibWeb/IndexedDB/Internal/Database.h>
 #include <LibWeb/Internals/Internals.h>
 #include <LibWeb/Loader/ContentFilter.h>
 #include <LibWeb/Loader/GeneratedPagesLoader.h>
@@ -102,6 +103,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     bool disable_site_isolation = false;
     bool enable_idl_tracing = false;
     bool enable_http_cache = false;
+    bool persist_indexed_db = false;
     bool force_cpu_painting = false;
     bool force_fontconfig = false;
     bool collect_garbage_on_every_allocation = false;
@@ -125,6 +127,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     args_parser.add_option(disable_site_isolation, "Disable site isolation", "disable-site-isolation");
     args_parser.add_option(enable_idl_tracing, "Enable IDL tracing", "enable-idl-tracing");
     args_parser.add_option(enable_http_cache, "Enable HTTP cache", "enable-http-cache");
+    args_parser.add_option(persist_indexed_db, "Persist IndexedDB databases through the browser process", "persist-indexed-db");
     args_parser.add_option(force_cpu_painting, "Force CPU painting", "force-cpu-painting");
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
     args_parser.add_option(collect_garbage_on_every_allocation, "Collect garbage after every JS heap allocation", "collect-garbage-on-every-allocation");
@@ -167,6 +170,9 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     if (disable_site_isolation)
         WebView::disable_site_isolation();
 
+    if (persist_indexed_db)
+        Web::IndexedDB::Database::set_persistence_enabled(true);
+
     if (enable_http_cache) {
 
         Web::Fetch::Fetching::set_http_cache_enabled(true);
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Arena.h>
+#include <AK/ByteString.h>
+#include <AK/Vector.h>
+
+TEST_CASE(make_trivial_objects)
+{
+    Arena arena;
+    auto& a = arena.make<int>(1);
+    auto& b = arena.make<u64>(2u);
+    auto& c = arena.make<char>('c');
+    EXPECT_EQ(a, 1);
+    EXPECT_EQ(b, 2u);
+    EXPECT_EQ(c, 'c');
+    EXPECT_EQ(reinterpret_cast<FlatPtr>(&b) % alignof(u64), 0u);
+}
+
+struct Tracked {
+    Tracked(Vector<int>& destroyed, int id)
+        : destroyed(destroyed)
+        , id(id)
+    {
+    }
+    ~Tracked() { destroyed.append(id); }
+
+    Vector<int>& destroyed;
+    int id { 0 };
+};
+
+TEST_CASE(destructors_run_in_reverse_order)
+{
+    Vector<int> destroyed;
+    {
+        Arena arena;
+        arena.make<Tracked>(destroyed, 1);
+        arena.make<Tracked>(destroyed, 2);
+        arena.make<Tracked>(destroyed, 3);
+        EXPECT(destroyed.is_empty());
+    }
+    EXPECT_EQ(destroyed, (Vector<int> { 3, 2, 1 }));
+}
+
+TEST_CASE(clear_destroys_objects_and_reuses_memory)
+{
+    Vector<int> destroyed;
+    Arena arena;
+    for (int i = 0; i < 10000; ++i)
+        arena.make<Tracked>(destroyed, i);
+    EXPECT(arena.bytes_allocated() >= 10000 * sizeof(Tracked));
+
+    arena.clear();
+    EXPECT_EQ(destroyed.size(), 10000u);
+    EXPECT_EQ(destroyed.first(), 9999);
+    EXPECT_EQ(arena.bytes_allocated(), 0u);
+
+    auto& value = arena.make<int>(42);
+    EXPECT_EQ(value, 42);
+    EXPECT_EQ(destroyed.size(), 10000u);
+}
+
+TEST_CASE(large_allocations)
+{
+    Arena arena;
+    auto span = arena.make_span<u32>(1'000'000);
+    EXPECT_EQ(span.size(), 1'000'000u);
+    EXPECT_EQ(span[0], 0u);
+    EXPECT_EQ(span[999'999], 0u);
+    span[999'999] = 1;
+    EXPECT_EQ(arena.make<int>(7), 7);
+    EXPECT(arena.make_span<int>(0).is_empty());
+}
+
+TEST_CASE(copy_string)
+{
+    Arena arena;
+    StringView copy;
+    {
+        auto original = ByteString("Well hello friends!"sv);
+        copy = arena.copy_string(original);
+    }
+    EXPECT_EQ(copy, "Well hello friends!"sv);
+    EXPECT(arena.copy_string({}).is_empty());
+}
+
+TEST_CASE(arena_vector)
+{
+    Arena arena;
+    ArenaVector<int> vector(arena);
+    EXPECT(vector.is_empty());
+    for (int i = 0; i < 1000; ++i)
+        vector.append(i);
+    EXPECT_EQ(vector.size(), 1000u);
+    EXPECT_EQ(vector[0], 0);
+    EXPECT_EQ(vector.last(), 999);
+
+    int sum = 0;
+    for (auto value : vector)
+        sum += value;
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+}
+
+TEST_CASE(arena_vector_destroys_elements)
+{
+    Vector<int> destroyed;
+    Arena arena;
+    {
+        auto& vector = arena.make<ArenaVector<Tracked>>(arena);
+        vector.append(destroyed, 1);
+        vector.append(destroyed, 2);
+        EXPECT(destroyed.is_empty());
+    }
+    arena.clear();
+    EXPECT_EQ(destroyed, (Vector<int> { 2, 1 }));
+}
+
+TEST_CASE(arena_string_builder)
+{
+    Arena arena;
+    ArenaStringBuilder builder(arena);
+    builder.append("Hello"sv);
+    builder.append(',');
+    builder.append(" friends!"sv);
+    EXPECT_EQ(builder.length(), 15u);
+    EXPECT_EQ(builder.string_view(), "Hello, friends!"sv);
+}
@@ -7,6 +7,8 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/Base64.h>
+#include <AK/ByteString.h>
+#include <AK/StringBuilder.h>
 #include <string.h>
 
 TEST_CASE(test_decode)
@@ -188,3 +190,42 @@ TEST_CASE(test_urlencode_omit_padding)
 
     encode_equal("hello!!world"sv, "aGVsbG8hIXdvcmxk"sv);
 }
+
+static ByteBuffer const& benchmark_bytes()
+{
+    static auto bytes = [] {
+        auto bytes = MUST(ByteBuffer::create_uninitialized(8 * MiB));
+        for (size_t i = 0; i < bytes.size(); ++i)
+            bytes[i] = static_cast<u8>(i * 2654435761u >> 24);
+        return bytes;
+    }();
+    return bytes;
+}
+
+BENCHMARK_CASE(encode_8_mib)
+{
+    for (size_t i = 0; i < 10; ++i)
+        EXPECT_EQ(MUST(encode_base64(benchmark_bytes())).bytes().size(), 4 * ((8 * MiB + 2) / 3));
+}
+
+BENCHMARK_CASE(decode_8_mib)
+{
+    auto encoded = MUST(encode_base64(benchmark_bytes()));
+    for (size_t i = 0; i < 10; ++i)
+        EXPECT_EQ(TRY_OR_FAIL(decode_base64(encoded)), benchmark_bytes());
+}
+
+BENCHMARK_CASE(decode_8_mib_with_whitespace)
+{
+    // Forgiving-base64 allows ASCII whitespace anywhere, like the line breaks in MIME-encoded data.
+    auto encoded = MUST(encode_base64(benchmark_bytes()));
+    StringBuilder builder;
+    auto view = encoded.bytes_as_string_view();
+    for (size_t offset = 0; offset < view.length(); offset += 76) {
+        builder.append(view.substring_view(offset, min<size_t>(76, view.length() - offset)));
+        builder.append("\r\n"sv);
+    }
+    auto with_line_breaks = builder.to_byte_string();
+    for (size_t i = 0; i < 10; ++i)
+        EXPECT_EQ(TRY_OR_FAIL(decode_base64(with_line_breaks)), benchmark_bytes());
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ChainedBuffer.h>
+#include <AK/Vector.h>
+
+static ByteBuffer make_test_data(size_t size)
+{
+    auto data = MUST(ByteBuffer::create_uninitialized(size));
+    for (size_t i = 0; i < size; ++i)
+        data[i] = static_cast<u8>(i * 7);
+    return data;
+}
+
+TEST_CASE(append_in_small_pieces)
+{
+    auto data = make_test_data(100'000);
+
+    ChainedBuffer buffer;
+    EXPECT(buffer.is_empty());
+    for (size_t offset = 0; offset < data.size(); offset += 1000)
+        buffer.append(data.bytes().slice(offset, min<size_t>(1000, data.size() - offset)));
+
+    EXPECT_EQ(buffer.size(), data.size());
+    EXPECT(buffer.chunk_count() < data.size() / 1000);
+    for (size_t i = 0; i < data.size(); i += 997)
+        EXPECT_EQ(buffer[i], data[i]);
+    EXPECT_EQ(MUST(buffer.coalesce()), data);
+}
+
+TEST_CASE(large_append_gets_a_single_chunk)
+{
+    auto data = make_test_data(ChainedBuffer::chunk_size * 3);
+
+    ChainedBuffer buffer;
+    buffer.append(data);
+    EXPECT_EQ(buffer.chunk_count(), 1u);
+    EXPECT_EQ(MUST(buffer.coalesce()), data);
+}
+
+TEST_CASE(slices_share_chunks)
+{
+    auto data = make_test_data(50'000);
+
+    ChainedBuffer buffer;
+    for (size_t offset = 0; offset < data.size(); offset += 5000)
+        buffer.append(data.bytes().slice(offset, 5000));
+
+    auto slice = buffer.slice(12'345, 20'000);
+    EXPECT_EQ(slice.size(), 20'000u);
+    EXPECT_EQ(MUST(slice.coalesce()).bytes(), data.bytes().slice(12'345, 20'000));
+
+    // Appending to a slice or to the buffer itself must not change what the other one sees.
+    auto tail = buffer.slice(buffer.size() - 10);
+    slice.append("abc"sv.bytes());
+    buffer.append("def"sv.bytes());
+    tail.append("ghi"sv.bytes());
+
+    EXPECT_EQ(slice[20'000], 'a');
+    EXPECT_EQ(buffer[50'000], 'd');
+    EXPECT_EQ(tail[10], 'g');
+    EXPECT_EQ(MUST(buffer.coalesce()).bytes().trim(data.size()), data.bytes());
+}
+
+TEST_CASE(discard)
+{
+    auto data = make_test_data(50'000);
+
+    ChainedBuffer buffer;
+    for (size_t offset = 0; offset < data.size(); offset += 5000)
+        buffer.append(data.bytes().slice(offset, 5000));
+
+    buffer.discard(20'001);
+    EXPECT_EQ(buffer.size(), 29'999u);
+    EXPECT_EQ(MUST(buffer.coalesce()).bytes(), data.bytes().slice(20'001));
+
+    buffer.discard(buffer.size());
+    EXPECT(buffer.is_empty());
+    EXPECT_EQ(buffer.chunk_count(), 0u);
+}
+
+TEST_CASE(append_buffer_to_itself)
+{
+    ChainedBuffer buffer;
+    buffer.append("well"sv.bytes());
+    buffer.append(buffer);
+    EXPECT_EQ(MUST(buffer.coalesce()).bytes(), "wellwell"sv.bytes());
+}
+
+TEST_CASE(stream)
+{
+    auto data = make_test_data(100'000);
+
+    ChainedBufferStream stream;
+    MUST(stream.write_until_depleted(data));
+    EXPECT_EQ(stream.buffer().size(), data.size());
+
+    auto read = MUST(ByteBuffer::create_uninitialized(data.size()));
+    MUST(stream.read_until_filled(read));
+    EXPECT_EQ(read, data);
+    EXPECT(stream.is_eof());
+}
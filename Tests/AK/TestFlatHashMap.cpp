@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteString.h>
+#include <AK/FlatHashMap.h>
+#include <AK/HashMap.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+
+TEST_CASE(construct)
+{
+    using IntIntMap = FlatHashMap<int, int>;
+    EXPECT(IntIntMap().is_empty());
+    EXPECT_EQ(IntIntMap().size(), 0u);
+    EXPECT(!IntIntMap().contains(1));
+}
+
+TEST_CASE(construct_from_initializer_list)
+{
+    FlatHashMap<int, ByteString> number_to_string {
+        { 1, "One" },
+        { 2, "Two" },
+        { 3, "Three" },
+    };
+    EXPECT_EQ(number_to_string.size(), 3u);
+    EXPECT_EQ(number_to_string.get(2).value(), "Two");
+}
+
+TEST_CASE(set_get_remove)
+{
+    FlatHashMap<int, ByteString> number_to_string;
+    EXPECT_EQ(number_to_string.set(1, "One"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(number_to_string.set(2, "Two"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(number_to_string.set(2, "Deux"), AK::HashSetResult::ReplacedExistingEntry);
+    EXPECT_EQ(number_to_string.set(2, "Zwei", AK::HashSetExistingEntryBehavior::Keep), AK::HashSetResult::KeptExistingEntry);
+    EXPECT_EQ(number_to_string.size(), 2u);
+    EXPECT_EQ(number_to_string.get(2).value(), "Deux");
+
+    EXPECT(number_to_string.remove(1));
+    EXPECT(!number_to_string.remove(1));
+    EXPECT(!number_to_string.get(1).has_value());
+    EXPECT_EQ(number_to_string.take(2), "Deux");
+    EXPECT(number_to_string.is_empty());
+}
+
+TEST_CASE(range_loop)
+{
+    FlatHashMap<int, int> squares;
+    for (int i = 0; i < 100; ++i)
+        squares.set(i, i * i);
+
+    int loop_counter = 0;
+    for (auto& it : squares) {
+        EXPECT_EQ(it.value, it.key * it.key);
+        ++loop_counter;
+    }
+    EXPECT_EQ(loop_counter, 100);
+}
+
+TEST_CASE(ensure)
+{
+    FlatHashMap<int, int> map;
+    map.ensure(1) = 10;
+    EXPECT_EQ(map.ensure(1), 10);
+
+    size_t callback_calls = 0;
+    auto& value = map.ensure(2, [&] {
+        ++callback_calls;
+        return 20;
+    });
+    EXPECT_EQ(value, 20);
+    map.ensure(2, [&] {
+        ++callback_calls;
+        return 30;
+    });
+    EXPECT_EQ(callback_calls, 1u);
+    EXPECT_EQ(map.get(2).value(), 20);
+}
+
+TEST_CASE(hash_compatible_lookups)
+{
+    FlatHashMap<String, int> map;
+    map.set("one"_string, 1);
+    map.set("two"_string, 2);
+    EXPECT(map.contains("one"sv));
+    EXPECT_EQ(map.get("two"sv).value(), 2);
+    EXPECT(map.remove("one"sv));
+    EXPECT(!map.contains("one"_string));
+}
+
+TEST_CASE(many_entries)
+{
+    FlatHashMap<int, int> map;
+    for (int i = 0; i < 10'000; ++i)
+        map.set(i, -i);
+    EXPECT_EQ(map.size(), 10'000u);
+    for (int i = 0; i < 10'000; i += 2)
+        EXPECT(map.remove(i));
+    EXPECT_EQ(map.size(), 5'000u);
+    for (int i = 0; i < 10'000; ++i)
+        EXPECT_EQ(map.contains(i), i % 2 == 1);
+    EXPECT(map.remove_all_matching([](int key, int) { return key < 5'000; }));
+    EXPECT_EQ(map.size(), 2'500u);
+}
+
+TEST_CASE(churn_does_not_grow)
+{
+    // Removing entries must not leave behind tombstones that make the table grow forever.
+    FlatHashMap<int, int> map;
+    for (int i = 0; i < 1'000; ++i)
+        map.set(i, i);
+    auto capacity = map.capacity();
+    for (int i = 1'000; i < 100'000; ++i) {
+        map.remove(i - 1'000);
+        map.set(i, i);
+    }
+    EXPECT_EQ(map.size(), 1'000u);
+    EXPECT_EQ(map.capacity(), capacity);
+}
+
+TEST_CASE(clear_with_capacity)
+{
+    FlatHashMap<int, ByteString> map;
+    for (int i = 0; i < 100; ++i)
+        map.set(i, ByteString::number(i));
+    auto capacity = map.capacity();
+    map.clear_with_capacity();
+    EXPECT(map.is_empty());
+    EXPECT_EQ(map.capacity(), capacity);
+    map.set(5, "five");
+    EXPECT_EQ(map.get(5).value(), "five");
+}
+
+TEST_CASE(set_of_strings)
+{
+    FlatHashSet<ByteString> set;
+    set.set("a");
+    set.set("b");
+    set.set("a");
+    EXPECT_EQ(set.size(), 2u);
+    EXPECT(set.contains("a"));
+    EXPECT(set.remove("a"));
+    EXPECT(!set.contains("a"));
+
+    auto copy = set;
+    EXPECT(copy.contains("b"));
+    EXPECT_EQ(copy.take("b"), "b");
+    EXPECT(set.contains("b"));
+}
+
+// The benchmarks below print how FlatHashMap compares to HashMap on lookups, misses and insertions, for small tables
+// like the ones in Shape and for large tables like the FlyString table.
+
+template<typename Map>
+static AK::Duration time_lookups(size_t entry_count, size_t lookup_count, bool hit)
+{
+    Map map;
+    for (size_t i = 0; i < entry_count; ++i)
+        map.set(ByteString::formatted("key{}", i), i);
+
+    Vector<ByteString> keys;
+    for (size_t i = 0; i < entry_count; ++i)
+        keys.append(ByteString::formatted(hit ? "key{}" : "absent{}", i));
+
+    size_t found = 0;
+    auto start = MonotonicTime::now();
+    for (size_t i = 0; i < lookup_count; ++i)
+        found += map.contains(keys[i % entry_count]) ? 1 : 0;
+    auto elapsed = MonotonicTime::now() - start;
+    EXPECT_EQ(found, hit ? lookup_count : 0);
+    return elapsed;
+}
+
+template<typename Map>
+static AK::Duration time_insertions(size_t entry_count)
+{
+    auto start = MonotonicTime::now();
+    Map map;
+    for (size_t i = 0; i < entry_count; ++i)
+        map.set(i * 2654435761u, i);
+    auto elapsed = MonotonicTime::now() - start;
+    EXPECT_EQ(map.size(), entry_count);
+    return elapsed;
+}
+
+BENCHMARK_CASE(compare_with_hash_map)
+{
+    static constexpr size_t lookup_count = 1'000'000;
+
+    outln("{:<24} {:>14} {:>14}", "workload"sv, "HashMap (ms)"sv, "FlatHashMap (ms)"sv);
+    for (size_t entry_count : { 16uz, 1'000uz, 100'000uz }) {
+        for (bool hit : { true, false }) {
+            auto hash_map = time_lookups<HashMap<ByteString, size_t>>(entry_count, lookup_count, hit);
+            auto flat_hash_map = time_lookups<FlatHashMap<ByteString, size_t>>(entry_count, lookup_count, hit);
+            outln("{:<24} {:>14} {:>14}", ByteString::formatted("{} {} entries", hit ? "hits in" : "misses in", entry_count), hash_map.to_milliseconds(), flat_hash_map.to_milliseconds());
+        }
+    }
+
+    auto hash_map = time_insertions<HashMap<size_t, size_t>>(lookup_count);
+    auto flat_hash_map = time_insertions<FlatHashMap<size_t, size_t>>(lookup_count);
+    outln("{:<24} {:>14} {:>14}", "1000000 insertions"sv, hash_map.to_milliseconds(), flat_hash_map.to_milliseconds());
+}
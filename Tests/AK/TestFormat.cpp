@@ -73,6 +73,23 @@ TEST_CASE(everything)
     EXPECT_EQ(ByteString::formatted("{{{:04}/{}/{0:8}/{1}", 42u, "foo"), "{0042/foo/      42/foo");
 }
 
+TEST_CASE(literal_and_runtime_format_strings)
+{
+    // Literal format strings are split up at compile time, others are parsed when formatting. Both must agree.
+    EXPECT_EQ(ByteString::formatted("a{{b}}c{}d", 1), ByteString::formatted("a{{b}}c{}d"sv, 1));
+    EXPECT_EQ(ByteString::formatted("{1:>{0}}|{0:x}", 4, "ab"), ByteString::formatted("{1:>{0}}|{0:x}"sv, 4, "ab"));
+    EXPECT_EQ(ByteString::formatted("{}{{{}}}", "x", 'y'), ByteString::formatted("{}{{{}}}"sv, "x", 'y'));
+    EXPECT_EQ(ByteString::formatted(""), ByteString::formatted(""sv));
+
+    // More replacement fields than arguments, which doesn't fit into what is split up at compile time.
+    EXPECT_EQ(ByteString::formatted("{0}-{0}-{0}", 7), "7-7-7");
+
+    StringBuilder builder;
+    builder.appendff("{:*^7}", "mid");
+    builder.appendff("{:#x}"sv, 255);
+    EXPECT_EQ(builder.to_byte_string(), "**mid**0xff");
+}
+
 TEST_CASE(string_builder)
 {
     StringBuilder builder;
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Function.h>
+#include <AK/FunctionRef.h>
+#include <AK/Vector.h>
+
+static int sum_of(size_t count, FunctionRef<int(size_t)> callback)
+{
+    int sum = 0;
+    for (size_t i = 0; i < count; ++i)
+        sum += callback(i);
+    return sum;
+}
+
+TEST_CASE(call_lambda)
+{
+    int factor = 3;
+    EXPECT_EQ(sum_of(4, [&](size_t i) { return static_cast<int>(i) * factor; }), 18);
+
+    auto identity = [](size_t i) { return static_cast<int>(i); };
+    EXPECT_EQ(sum_of(5, identity), 10);
+}
+
+TEST_CASE(mutable_lambda_keeps_its_state)
+{
+    int calls = 0;
+    auto counter = [calls]() mutable { return ++calls; };
+    FunctionRef<int()> ref = counter;
+    EXPECT_EQ(ref(), 1);
+    EXPECT_EQ(ref(), 2);
+    EXPECT_EQ(counter(), 3);
+}
+
+TEST_CASE(call_function)
+{
+    Function<int(size_t)> function = [](size_t i) { return static_cast<int>(i) + 1; };
+    EXPECT_EQ(sum_of(3, function), 6);
+}
+
+TEST_CASE(pass_arguments_through)
+{
+    Vector<int> moved_into;
+    auto lambda = [&](Vector<int>&& vector) { moved_into = move(vector); };
+    FunctionRef<void(Vector<int>&&)> take = lambda;
+    Vector<int> vector { 1, 2, 3 };
+    take(move(vector));
+    EXPECT_EQ(moved_into, (Vector<int> { 1, 2, 3 }));
+}
+
+TEST_CASE(function_with_larger_inline_capacity)
+{
+    u64 a = 1, b = 2, c = 3, d = 4, e = 5;
+    Function<u64(), 8 * sizeof(void*)> function = [a, b, c, d, e] { return a + b + c + d + e; };
+    EXPECT_EQ(function.raw_capture_range().size(), 5 * sizeof(u64));
+
+    auto moved = move(function);
+    EXPECT(!function);
+    EXPECT_EQ(moved(), 15u);
+}
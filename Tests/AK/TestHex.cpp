@@ -59,3 +59,66 @@ TEST_CASE(should_constexpr_decode_hex_digit)
     static_assert(14u == decode_hex_digit('E'));
     static_assert(15u == decode_hex_digit('F'));
 }
+
+TEST_CASE(should_encode_and_decode_hex)
+{
+    EXPECT_EQ(encode_hex({}), ""sv);
+    EXPECT_EQ(encode_hex("\x01\xab\xff"sv.bytes()), "01abff"sv);
+    EXPECT_EQ(StringView { TRY_OR_FAIL(decode_hex("01abff"sv)) }, "\x01\xab\xff"sv);
+    EXPECT_EQ(StringView { TRY_OR_FAIL(decode_hex("01ABFF"sv)) }, "\x01\xab\xff"sv);
+
+    // Long enough to go through the vectorized path, with a remainder.
+    ByteBuffer bytes;
+    for (size_t i = 0; i < 1000; ++i)
+        bytes.append(static_cast<u8>(i * 7));
+
+    auto hex = encode_hex(bytes);
+    EXPECT_EQ(hex.length(), 2000u);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        EXPECT_EQ(decode_hex_digit(hex[i * 2]), bytes[i] >> 4);
+        EXPECT_EQ(decode_hex_digit(hex[i * 2 + 1]), bytes[i] & 0xf);
+    }
+    EXPECT_EQ(TRY_OR_FAIL(decode_hex(hex)), bytes);
+    EXPECT_EQ(TRY_OR_FAIL(decode_hex(hex.to_uppercase())), bytes);
+}
+
+TEST_CASE(should_fail_to_decode_invalid_hex)
+{
+    EXPECT(decode_hex("0"sv).is_error());
+    EXPECT(decode_hex("0g"sv).is_error());
+
+    auto hex = ByteString::repeated('a', 100);
+    for (size_t i = 0; i < hex.length(); ++i) {
+        for (auto invalid : "/:@G`g \x80"sv) {
+            auto copy = ByteString::create_and_overwrite(hex.length(), [&](Bytes buffer) {
+                hex.bytes().copy_to(buffer);
+                buffer[i] = invalid;
+            });
+            EXPECT(decode_hex(copy).is_error());
+        }
+    }
+}
+
+static ByteBuffer const& benchmark_bytes()
+{
+    static auto bytes = [] {
+        auto bytes = MUST(ByteBuffer::create_uninitialized(8 * MiB));
+        for (size_t i = 0; i < bytes.size(); ++i)
+            bytes[i] = static_cast<u8>(i * 2654435761u >> 24);
+        return bytes;
+    }();
+    return bytes;
+}
+
+BENCHMARK_CASE(encode_hex_8_mib)
+{
+    for (size_t i = 0; i < 10; ++i)
+        EXPECT_EQ(encode_hex(benchmark_bytes()).length(), 16 * MiB);
+}
+
+BENCHMARK_CASE(decode_hex_8_mib)
+{
+    auto hex = encode_hex(benchmark_bytes());
+    for (size_t i = 0; i < 10; ++i)
+        EXPECT_EQ(TRY_OR_FAIL(decode_hex(hex)).size(), 8 * MiB);
+}
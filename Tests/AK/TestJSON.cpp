@@ -6,6 +6,7 @@
 
 #include <LibTest/TestCase.h>
 
+#include <AK/JsonCursor.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
 #include <AK/StringBuilder.h>
@@ -639,3 +640,50 @@ TEST_CASE(json_object_move_from_value)
     EXPECT_EQ(array2->at(0).as_bool(), false);
     EXPECT_EQ(array2->at(1).as_string(), "string"sv);
 }
+
+TEST_CASE(json_cursor)
+{
+    auto document = R"({ "name": "Form1", "esc\"aped": "a\nb", "widgets": [ { "x": 155, "nested": [[1], { "}": "]" }] }, true, null, -1.5e3 ], "last": false })"sv;
+    auto cursor = MUST(JsonCursor::create(document));
+    EXPECT(cursor.is_object());
+    EXPECT_EQ(MUST(cursor.size()), 4u);
+
+    auto name = MUST(cursor.get("name"sv));
+    EXPECT_EQ(name->as_string_view().value(), "Form1"sv);
+    EXPECT_EQ(MUST(name->to_string()), "Form1"sv);
+
+    auto escaped = MUST(cursor.get("esc\"aped"sv));
+    EXPECT(!escaped->as_string_view().has_value());
+    EXPECT_EQ(MUST(escaped->to_string()), "a\nb"sv);
+
+    auto widgets = MUST(cursor.get("widgets"sv));
+    EXPECT(widgets->is_array());
+    EXPECT_EQ(MUST(widgets->size()), 4u);
+    EXPECT_EQ(MUST(MUST(MUST(widgets->at(0))->get("x"sv))->to_integer<int>()), 155);
+    EXPECT_EQ(MUST(MUST(widgets->at(1))->to_bool()), true);
+    EXPECT(MUST(widgets->at(2))->is_null());
+    EXPECT_EQ(MUST(MUST(widgets->at(3))->to_double()), -1500.0);
+    EXPECT(!MUST(widgets->at(4)).has_value());
+
+    auto nested = MUST(MUST(MUST(widgets->at(0))->get("nested"sv))->materialize());
+    EXPECT_EQ(nested.serialized(), "[[1],{\"}\":\"]\"}]"sv);
+
+    EXPECT(!MUST(cursor.get("missing"sv)).has_value());
+}
+
+TEST_CASE(json_cursor_errors)
+{
+    EXPECT(JsonCursor::create("{"sv).is_error());
+    EXPECT(JsonCursor::create("\"abc"sv).is_error());
+    EXPECT(JsonCursor::create("[1, {]}"sv).is_error());
+    EXPECT(JsonCursor::create("[1, 2] 3"sv).is_error());
+    EXPECT(JsonCursor::create("nope"sv).is_error());
+
+    // Errors inside values are only found once they are looked at.
+    auto cursor = MUST(JsonCursor::create(R"({ "a" 1, "b": [1, ] })"sv));
+    EXPECT(cursor.get("a"sv).is_error());
+    auto array = MUST(JsonCursor::create("[1, ]"sv));
+    EXPECT(array.size().is_error());
+    auto number = MUST(JsonCursor::create("12a"sv));
+    EXPECT(number.to_integer<int>().is_error());
+}
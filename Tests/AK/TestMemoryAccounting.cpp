@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/HashTable.h>
+#include <AK/MemoryAccounting.h>
+#include <AK/Vector.h>
+
+using namespace AK::MemoryAccounting;
+
+TEST_CASE(scoped_category_restores_previous_category)
+{
+    auto outer_category = current_category();
+    {
+        ScopedCategory style { Category::Style };
+        if constexpr (is_enabled)
+            EXPECT_EQ(current_category(), Category::Style);
+        {
+            ScopedCategory layout { Category::Layout };
+            if constexpr (is_enabled)
+                EXPECT_EQ(current_category(), Category::Layout);
+        }
+        if constexpr (is_enabled)
+            EXPECT_EQ(current_category(), Category::Style);
+    }
+    EXPECT_EQ(current_category(), outer_category);
+}
+
+TEST_CASE(containers_are_accounted_to_current_category)
+{
+    if constexpr (!is_enabled)
+        return;
+
+    auto before = usage(Category::Paint);
+    {
+        ScopedCategory paint { Category::Paint };
+
+        Vector<int> vector;
+        vector.resize(1000);
+        HashTable<int> table;
+        for (int i = 0; i < 100; ++i)
+            table.set(i);
+
+        auto during = usage(Category::Paint);
+        EXPECT(during.live_bytes >= before.live_bytes + static_cast<i64>(1000 * sizeof(int)));
+        EXPECT(during.allocation_count > before.allocation_count);
+    }
+    EXPECT_EQ(usage(Category::Paint).live_bytes, before.live_bytes);
+}
+
+TEST_CASE(category_names)
+{
+    EXPECT_EQ(category_name(Category::Uncategorized), "Uncategorized"sv);
+    EXPECT_EQ(category_name(Category::JSHeapExternal), "JS heap (external)"sv);
+}
@@ -217,6 +217,19 @@ TEST_CASE(constexpr_stuff)
 #undef do_test
 }
 
+TEST_CASE(count_leading_ascii_characters)
+{
+    EXPECT_EQ(""sv.count_leading_ascii_characters(), 0u);
+    EXPECT_EQ("abc"sv.count_leading_ascii_characters(), 3u);
+    EXPECT_EQ("\xc3\xa4bc"sv.count_leading_ascii_characters(), 0u);
+    EXPECT_EQ("ab\xc3\xa4"sv.count_leading_ascii_characters(), 2u);
+
+    auto long_string = ByteString::repeated('a', 100);
+    EXPECT_EQ(long_string.view().count_leading_ascii_characters(), 100u);
+    auto long_string_with_non_ascii_tail = ByteString::formatted("{}\xff", long_string);
+    EXPECT_EQ(long_string_with_non_ascii_tail.view().count_leading_ascii_characters(), 100u);
+}
+
 TEST_CASE(case_insensitive_hash)
 {
     auto string1 = "abcdef"sv;
@@ -835,6 +835,41 @@ TEST_CASE(find_code_unit_offset)
     EXPECT(!view.find_code_unit_offset(u"baz"sv).has_value());
 }
 
+TEST_CASE(mixed_storage)
+{
+    // Long enough to compare more than one block of code units at a time.
+    static constexpr Utf16View ascii { "The quick brown fox jumps over the lazy dog, and then some more."sv };
+    static constexpr Utf16View utf16 { u"The quick brown fox jumps over the lazy dog, and then some more."sv };
+    static constexpr Utf16View different_utf16 { u"The quick brown fox jumps over the lazy dog, and then some mörë."sv };
+
+    EXPECT(ascii.has_ascii_storage());
+    EXPECT(!utf16.has_ascii_storage());
+
+    EXPECT_EQ(ascii, utf16);
+    EXPECT_EQ(utf16, ascii);
+    EXPECT_NE(ascii, different_utf16);
+    EXPECT_NE(ascii.substring_view(1), utf16.substring_view(0, utf16.length_in_code_units() - 1));
+
+    EXPECT_EQ(ascii <=> utf16, 0);
+    EXPECT(ascii < different_utf16);
+    EXPECT(different_utf16 > ascii);
+    EXPECT(ascii.is_code_unit_less_than(different_utf16));
+    EXPECT(!different_utf16.is_code_unit_less_than(ascii));
+    EXPECT(ascii.substring_view(0, 10).is_code_unit_less_than(utf16));
+
+    EXPECT_EQ(35u, ascii.find_code_unit_offset(u"lazy"sv).value());
+    EXPECT_EQ(35u, utf16.find_code_unit_offset(Utf16View { "lazy"sv }).value());
+    EXPECT_EQ(32u, ascii.find_code_unit_offset(u"he"sv, 2).value());
+    EXPECT_EQ(59u, utf16.find_code_unit_offset(Utf16View { "more."sv }).value());
+    EXPECT(!ascii.find_code_unit_offset(u"mörë"sv).has_value());
+    EXPECT(!utf16.find_code_unit_offset(Utf16View { "lazy"sv }, 36).has_value());
+    EXPECT(!different_utf16.find_code_unit_offset(Utf16View { "more"sv }).has_value());
+
+    auto conversion_result = Utf16String::from_utf8("😀foo😀bar"sv);
+    Utf16View const emoji { conversion_result };
+    EXPECT_EQ(7u, emoji.find_code_unit_offset(Utf16View { "bar"sv }).value());
+}
+
 TEST_CASE(find_code_unit_offset_ignoring_case)
 {
     auto conversion_result = Utf16String::from_utf8("😀Foo😀Bar"sv);
@@ -60,6 +60,92 @@ TEST_CASE(invalid_canonical_code)
     EXPECT(Compress::CanonicalCode::from_bytes(code).is_error());
 }
 
+// A code with lengths from 1 up to 15 bits, so that symbols are decoded through both levels of the lookup tables.
+static Vector<u8> long_canonical_code_lengths()
+{
+    Vector<u8> code_lengths;
+    for (u8 code_length = 1; code_length <= 15; ++code_length) {
+        code_lengths.append(code_length);
+        if (code_length == 15)
+            code_lengths.append(code_length);
+    }
+    // Shuffle the symbols around, so that long codes don't all belong to the highest symbols.
+    for (size_t i = 0; i < code_lengths.size(); i += 2)
+        swap(code_lengths[i], code_lengths[code_lengths.size() - i - 1]);
+    return code_lengths;
+}
+
+// Prefixes are peeked from the stream before the code length is known, so there have to be enough bits left after the
+// last symbol for them, unless the end of the stream is what's being tested.
+static ByteBuffer write_symbols(Compress::CanonicalCode const& huffman, ReadonlySpan<u32> symbols, size_t trailing_zero_bits = 16)
+{
+    AllocatingMemoryStream output_stream;
+    {
+        LittleEndianOutputBitStream bit_stream { MaybeOwned<Stream>(output_stream) };
+        for (auto symbol : symbols)
+            MUST(huffman.write_symbol(bit_stream, symbol));
+        MUST(bit_stream.write_bits(0u, trailing_zero_bits));
+        MUST(bit_stream.align_to_byte_boundary());
+        MUST(bit_stream.flush_buffer_to_stream());
+    }
+    return MUST(output_stream.read_until_eof());
+}
+
+TEST_CASE(canonical_code_long_codes)
+{
+    auto const code_lengths = long_canonical_code_lengths();
+    auto const huffman = TRY_OR_FAIL(Compress::CanonicalCode::from_bytes(code_lengths));
+
+    Vector<u32> symbols;
+    for (size_t i = 0; i < 4096; ++i)
+        symbols.append(get_random_uniform(code_lengths.size()));
+
+    auto const encoded = write_symbols(huffman, symbols);
+    auto memory_stream = MUST(try_make<FixedMemoryStream>(encoded.bytes()));
+    LittleEndianInputBitStream bit_stream { move(memory_stream) };
+
+    for (auto symbol : symbols)
+        EXPECT_EQ(MUST(huffman.read_symbol(bit_stream)), symbol);
+}
+
+TEST_CASE(canonical_code_long_code_at_end_of_stream)
+{
+    auto const code_lengths = long_canonical_code_lengths();
+    auto const huffman = TRY_OR_FAIL(Compress::CanonicalCode::from_bytes(code_lengths));
+
+    // The 9-bit code shares its subtable with the 15-bit codes, but it ends the stream right after the 7-bit code.
+    Array<u32, 2> const symbols {
+        static_cast<u32>(code_lengths.find_first_index(7).value()),
+        static_cast<u32>(code_lengths.find_first_index(9).value()),
+    };
+    auto const encoded = write_symbols(huffman, symbols, 0);
+    EXPECT_EQ(encoded.size(), 2u);
+    auto memory_stream = MUST(try_make<FixedMemoryStream>(encoded.bytes()));
+    LittleEndianInputBitStream bit_stream { move(memory_stream) };
+
+    for (auto symbol : symbols)
+        EXPECT_EQ(MUST(huffman.read_symbol(bit_stream)), symbol);
+}
+
+BENCHMARK_CASE(canonical_code_read_long_symbols)
+{
+    auto const code_lengths = long_canonical_code_lengths();
+    auto const huffman = MUST(Compress::CanonicalCode::from_bytes(code_lengths));
+
+    // Make every symbol equally likely, so that most of them are longer than the prefix table.
+    Vector<u32> symbols;
+    for (size_t i = 0; i < 1'000'000; ++i)
+        symbols.append(get_random_uniform(code_lengths.size()));
+    auto const encoded = write_symbols(huffman, symbols);
+
+    for (size_t i = 0; i < 10; ++i) {
+        auto memory_stream = MUST(try_make<FixedMemoryStream>(encoded.bytes()));
+        LittleEndianInputBitStream bit_stream { move(memory_stream) };
+        for (size_t j = 0; j < symbols.size(); ++j)
+            EXPECT_EQ(MUST(huffman.read_symbol(bit_stream)), symbols[j]);
+    }
+}
+
 TEST_CASE(deflate_decompress_compressed_block)
 {
     Array<u8, 28> const compressed {
@@ -149,6 +235,48 @@ TEST_CASE(deflate_round_trip_compress_large)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(deflate_round_trip_compress_in_parallel)
+{
+    // Repeat a random pattern, so that matches reach back across the blocks that are compressed in parallel.
+    auto pattern = TRY_OR_FAIL(ByteBuffer::create_uninitialized(20 * KiB));
+    fill_with_random(pattern);
+    auto original = TRY_OR_FAIL(ByteBuffer::create_uninitialized(3 * MiB));
+    for (size_t offset = 0; offset < original.size(); offset += pattern.size())
+        original.overwrite(offset, pattern.data(), min(pattern.size(), original.size() - offset));
+
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::GenericZlibCompressionLevel::Fastest));
+    EXPECT(compressed.size() < 64 * KiB);
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+
+    // Large writes are compressed in parallel, and small ones by the stream itself, which must pick up where the other
+    // left off.
+    AllocatingMemoryStream output_stream;
+    auto compressor = TRY_OR_FAIL(Compress::DeflateCompressor::create(MaybeOwned<Stream> { output_stream }));
+    for (size_t size : Array<size_t, 4> { 1000, 1 * MiB, 77, 1 * MiB + 5 })
+        TRY_OR_FAIL(compressor->write_until_depleted(original.bytes().slice(0, size)));
+    TRY_OR_FAIL(compressor->finish());
+
+    compressed = TRY_OR_FAIL(output_stream.read_until_eof());
+    uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT_EQ(uncompressed.size(), 1000 + 1 * MiB + 77 + 1 * MiB + 5);
+    EXPECT(uncompressed.bytes().slice(0, 1000) == original.bytes().slice(0, 1000));
+    EXPECT(uncompressed.bytes().slice(1000, 1 * MiB) == original.bytes().slice(0, 1 * MiB));
+    EXPECT(uncompressed.bytes().slice(1000 + 1 * MiB, 77) == original.bytes().slice(0, 77));
+    EXPECT(uncompressed.bytes().slice(1000 + 1 * MiB + 77) == original.bytes().slice(0, 1 * MiB + 5));
+}
+
+TEST_CASE(deflate_round_trip_compress_very_fast)
+{
+    auto original = TRY_OR_FAIL(ByteBuffer::create_zeroed(64 * KiB));
+    fill_with_random(original.bytes().trim(1024));
+
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::GenericZlibCompressionLevel::VeryFast));
+    EXPECT(compressed.size() < 2 * KiB);
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
 TEST_CASE(deflate_compress_literals)
 {
     // This byte array is known to not produce any back references with our lz77 implementation even at the highest compression settings
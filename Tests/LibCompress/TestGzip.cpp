@@ -91,6 +91,17 @@ TEST_CASE(gzip_round_trip)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(gzip_round_trip_compress_in_parallel)
+{
+    // Large enough to be compressed in parallel, which means that the checksum has to be combined from each block.
+    auto original = TRY_OR_FAIL(ByteBuffer::create_zeroed(3 * MiB));
+    fill_with_random(original.bytes().slice(MiB, 2 * MiB));
+
+    auto compressed = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(original, Compress::GenericZlibCompressionLevel::Fastest));
+    auto uncompressed = TRY_OR_FAIL(Compress::GzipDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
 TEST_CASE(gzip_truncated_uncompressed_block)
 {
     Array<u8, 38> const compressed {
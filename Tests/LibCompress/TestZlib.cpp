@@ -7,6 +7,7 @@
 #include <AK/ByteBuffer.h>
 #include <AK/MaybeOwned.h>
 #include <AK/MemoryStream.h>
+#include <AK/Random.h>
 #include <LibCompress/Zlib.h>
 #include <LibTest/TestCase.h>
 
@@ -77,6 +78,30 @@ TEST_CASE(zlib_round_trip_simple_fastest)
     EXPECT(decompressed.bytes() == (ReadonlyBytes { uncompressed, sizeof(uncompressed) - 1 }));
 }
 
+TEST_CASE(zlib_round_trip_simple_very_fast)
+{
+    u8 const uncompressed[] = "This is a simple text file :)";
+
+    auto const freshly_pressed = TRY_OR_FAIL(Compress::ZlibCompressor::compress_all({ uncompressed, sizeof(uncompressed) - 1 }, Compress::GenericZlibCompressionLevel::VeryFast));
+    EXPECT(freshly_pressed.span().slice(0, 2) == ReadonlyBytes { { 0x78, 0x01 } });
+
+    auto const decompressed = TRY_OR_FAIL(Compress::ZlibDecompressor::decompress_all(freshly_pressed));
+    EXPECT(decompressed.bytes() == (ReadonlyBytes { uncompressed, sizeof(uncompressed) - 1 }));
+}
+
+TEST_CASE(zlib_round_trip_compress_in_parallel)
+{
+    // Large enough to be compressed in parallel, which means that the checksum has to be combined from each block.
+    auto original = TRY_OR_FAIL(ByteBuffer::create_zeroed(3 * MiB));
+    fill_with_random(original.bytes().slice(0, 2 * MiB));
+
+    auto const freshly_pressed = TRY_OR_FAIL(Compress::ZlibCompressor::compress_all(original, Compress::GenericZlibCompressionLevel::Fastest));
+    EXPECT(freshly_pressed.span().slice(0, 2) == ReadonlyBytes { { 0x78, 0x01 } });
+
+    auto const decompressed = TRY_OR_FAIL(Compress::ZlibDecompressor::decompress_all(freshly_pressed));
+    EXPECT(decompressed == original);
+}
+
 TEST_CASE(zlib_decompress_with_missing_end_bits)
 {
     // This test case has been extracted from compressed PNG data of `/res/icons/16x16/app-masterword.png`.
@@ -5,7 +5,12 @@
  */
 
 #include <LibCore/EventLoop.h>
+#include <LibCore/EventLoopImplementation.h>
+#include <LibCore/Notifier.h>
+#include <LibCore/System.h>
+#include <LibCore/Timer.h>
 #include <LibTest/TestCase.h>
+#include <sys/resource.h>
 
 TEST_CASE(test_poll_for_events)
 {
@@ -13,3 +18,100 @@ TEST_CASE(test_poll_for_events)
 
     event_loop.pump(Core::EventLoop::WaitMode::PollForEvents);
 }
+
+TEST_CASE(test_notifiers_sharing_a_file_descriptor)
+{
+    Core::EventLoop event_loop;
+
+    auto fds = MUST(Core::System::pipe2(O_CLOEXEC));
+    auto read_notifier = Core::Notifier::construct(fds[0], Core::Notifier::Type::Read);
+    auto other_read_notifier = Core::Notifier::construct(fds[0], Core::Notifier::Type::Read);
+
+    int first_activations = 0;
+    int second_activations = 0;
+    read_notifier->on_activation = [&] { ++first_activations; };
+    other_read_notifier->on_activation = [&] { ++second_activations; };
+
+    MUST(Core::System::write(fds[1], "x"sv.bytes()));
+    event_loop.pump(Core::EventLoop::WaitMode::PollForEvents);
+    EXPECT_EQ(first_activations, 1);
+    EXPECT_EQ(second_activations, 1);
+
+    // Disabling one of them must not stop the other one from being notified.
+    other_read_notifier->set_enabled(false);
+    event_loop.pump(Core::EventLoop::WaitMode::PollForEvents);
+    EXPECT_EQ(first_activations, 2);
+    EXPECT_EQ(second_activations, 1);
+
+    read_notifier->set_enabled(false);
+    MUST(Core::System::close(fds[0]));
+    MUST(Core::System::close(fds[1]));
+}
+
+BENCHMARK_CASE(wake_up_with_many_idle_notifiers)
+{
+    static constexpr size_t idle_pipe_count = 5000;
+    static constexpr size_t wakeup_count = 10'000;
+
+    // Each pipe takes up two file descriptors, so we need to be allowed more than the usual soft limit.
+    MUST(Core::System::set_resource_limits(RLIMIT_NOFILE, (idle_pipe_count + 64) * 2));
+    auto limits = MUST(Core::System::get_resource_limits(RLIMIT_NOFILE));
+    auto pipe_count = min(idle_pipe_count, (limits.rlim_cur - 64) / 2);
+
+    Core::EventLoop event_loop;
+
+    Vector<Array<int, 2>> idle_pipes;
+    Vector<NonnullRefPtr<Core::Notifier>> idle_notifiers;
+    for (size_t i = 0; i < pipe_count; ++i) {
+        auto fds = MUST(Core::System::pipe2(O_CLOEXEC));
+        idle_pipes.append(fds);
+        idle_notifiers.append(Core::Notifier::construct(fds[0], Core::Notifier::Type::Read));
+    }
+
+    auto active_pipe = MUST(Core::System::pipe2(O_CLOEXEC));
+    auto active_notifier = Core::Notifier::construct(active_pipe[0], Core::Notifier::Type::Read);
+
+    size_t activations = 0;
+    active_notifier->on_activation = [&] {
+        u8 byte;
+        MUST(Core::System::read(active_pipe[0], { &byte, 1 }));
+        ++activations;
+    };
+
+    for (size_t i = 0; i < wakeup_count; ++i) {
+        MUST(Core::System::write(active_pipe[1], "x"sv.bytes()));
+        event_loop.pump(Core::EventLoop::WaitMode::WaitForEvents);
+    }
+    EXPECT_EQ(activations, wakeup_count);
+
+    active_notifier->set_enabled(false);
+    for (auto& notifier : idle_notifiers)
+        notifier->set_enabled(false);
+
+    for (auto const& fds : idle_pipes) {
+        MUST(Core::System::close(fds[0]));
+        MUST(Core::System::close(fds[1]));
+    }
+    MUST(Core::System::close(active_pipe[0]));
+    MUST(Core::System::close(active_pipe[1]));
+}
+
+TEST_CASE(test_timer_statistics)
+{
+    Core::EventLoop event_loop;
+
+    auto statistics_before = Core::EventLoop::timer_statistics();
+
+    auto fired = false;
+    auto timer = Core::Timer::create_single_shot(1, [&] { fired = true; });
+    timer->start();
+    EXPECT_EQ(Core::EventLoop::timer_statistics().timer_count, statistics_before.timer_count + 1);
+
+    while (!fired)
+        event_loop.pump(Core::EventLoop::WaitMode::WaitForEvents);
+
+    auto statistics_after = Core::EventLoop::timer_statistics();
+    EXPECT_EQ(statistics_after.timer_count, statistics_before.timer_count);
+    EXPECT_EQ(statistics_after.fired_timer_count, statistics_before.fired_timer_count + 1);
+    EXPECT(statistics_after.wakeup_count > statistics_before.wakeup_count);
+}
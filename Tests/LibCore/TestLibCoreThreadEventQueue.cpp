@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/Vector.h>
+#include <LibCore/EventLoop.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+
+static void post_from_threads(size_t thread_count, IGNORE_USE_IN_ESCAPING_LAMBDA size_t posts_per_thread, IGNORE_USE_IN_ESCAPING_LAMBDA Function<void(size_t thread_index, size_t post_index)> callback)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA auto& loop = Core::EventLoop::current();
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> processed_count = 0;
+    auto total_count = thread_count * posts_per_thread;
+
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t thread_index = 0; thread_index < thread_count; ++thread_index) {
+        threads.append(Threading::Thread::construct([&, thread_index] {
+            for (size_t post_index = 0; post_index < posts_per_thread; ++post_index) {
+                loop.deferred_invoke([&, thread_index, post_index] {
+                    callback(thread_index, post_index);
+                    ++processed_count;
+                });
+            }
+            return 0;
+        }));
+    }
+
+    for (auto& thread : threads)
+        thread->start();
+
+    loop.spin_until([&] { return processed_count == total_count; });
+
+    for (auto& thread : threads)
+        MUST(thread->join());
+}
+
+TEST_CASE(events_from_many_threads_are_processed_in_order)
+{
+    Core::EventLoop loop;
+
+    static constexpr size_t thread_count = 4;
+    static constexpr size_t posts_per_thread = 10'000;
+
+    Vector<size_t> next_post_index;
+    next_post_index.resize(thread_count);
+
+    post_from_threads(thread_count, posts_per_thread, [&](size_t thread_index, size_t post_index) {
+        EXPECT_EQ(post_index, next_post_index[thread_index]);
+        ++next_post_index[thread_index];
+    });
+
+    for (auto post_index : next_post_index)
+        EXPECT_EQ(post_index, posts_per_thread);
+}
+
+TEST_CASE(events_posted_while_processing_are_processed)
+{
+    Core::EventLoop loop;
+
+    size_t processed_count = 0;
+    loop.deferred_invoke([&] {
+        ++processed_count;
+        loop.deferred_invoke([&] { ++processed_count; });
+    });
+
+    loop.spin_until([&] { return processed_count == 2; });
+    EXPECT_EQ(processed_count, 2u);
+}
+
+BENCHMARK_CASE(post_from_many_threads)
+{
+    Core::EventLoop loop;
+
+    post_from_threads(8, 100'000, [](size_t, size_t) {});
+}
@@ -240,6 +240,52 @@ TEST_CASE(test_SHA256_hash_split_into_blocks)
     EXPECT(memcmp(result, digest.data, Crypto::Hash::SHA256::digest_size()) == 0);
 }
 
+TEST_CASE(test_SHA256_hash_many)
+{
+    // Cover every padding case around the block boundaries, as well as inputs that are hashed one at a time.
+    Vector<ByteBuffer> buffers;
+    for (size_t size = 0; size <= 300; ++size)
+        buffers.append(MUST(ByteBuffer::create_zeroed(size)));
+    buffers.append(MUST(ByteBuffer::create_zeroed(1024)));
+    buffers.append(MUST(ByteBuffer::create_zeroed(1025)));
+    buffers.append(MUST(ByteBuffer::create_zeroed(100'000)));
+
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        for (size_t j = 0; j < buffers[i].size(); ++j)
+            buffers[i][j] = static_cast<u8>(i * 31 + j);
+    }
+
+    Vector<ReadonlyBytes> inputs;
+    // Hash the inputs in reverse, so that they are not already sorted by size.
+    for (size_t i = buffers.size(); i > 0; --i)
+        inputs.append(buffers[i - 1]);
+
+    auto digests = Crypto::Hash::SHA256::hash_many(inputs);
+    EXPECT_EQ(digests.size(), inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        auto expected = Crypto::Hash::SHA256::hash(inputs[i].data(), inputs[i].size());
+        EXPECT_EQ(digests[i].bytes(), expected.bytes());
+    }
+
+    EXPECT(Crypto::Hash::SHA256::hash_many({}).is_empty());
+}
+
+BENCHMARK_CASE(bench_SHA256_hash_many_small_inputs)
+{
+    Vector<ByteBuffer> buffers;
+    for (size_t i = 0; i < 100'000; ++i)
+        buffers.append(MUST(ByteBuffer::create_zeroed(32 + i % 64)));
+
+    Vector<ReadonlyBytes> inputs;
+    for (auto const& buffer : buffers)
+        inputs.append(buffer);
+
+    for (size_t i = 0; i < 10; ++i) {
+        auto digests = Crypto::Hash::SHA256::hash_many(inputs);
+        EXPECT_EQ(digests.size(), inputs.size());
+    }
+}
+
 TEST_CASE(test_SHA384_name)
 {
     auto sha = Crypto::Hash::SHA384::create();
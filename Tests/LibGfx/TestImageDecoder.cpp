@@ -302,6 +302,95 @@ TEST_CASE(test_jpeg_rgb_components)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 592, 800 }));
 }
 
+TEST_CASE(test_jpeg_ideal_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/several_scans.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+
+    // 592x800 decodes at 1/4 scale to 148x200, the smallest DCT scale that covers 100x100.
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 100, 100 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(148, 200));
+    EXPECT_EQ(plugin_decoder->size(), Gfx::IntSize(592, 800));
+
+    // Asking for more detail than the first decode produced decodes again.
+    frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 250, 400 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(296, 400));
+
+    frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(592, 800));
+
+    // ImageDecoder scales the rest of the way.
+    auto decoder = TRY_OR_FAIL(Gfx::ImageDecoder::try_create_for_raw_bytes(file->bytes()));
+    frame = TRY_OR_FAIL(decoder->frame(0, Gfx::IntSize { 100, 100 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(100, 136));
+}
+
+struct IncrementalDecodeResult {
+    NonnullRefPtr<Gfx::Bitmap> bitmap;
+    size_t progress_before_last_chunk { 0 };
+};
+
+static ErrorOr<IncrementalDecodeResult> decode_incrementally(ReadonlyBytes data, size_t chunk_size)
+{
+    auto decoder = TRY(Gfx::ImageDecoder::try_create_incremental_for_initial_bytes(data));
+    if (!decoder)
+        return Error::from_string_literal("No incremental decoder for this format");
+
+    size_t progress_before_last_chunk = 0;
+    for (size_t offset = 0; offset < data.size(); offset += chunk_size) {
+        progress_before_last_chunk = decoder->progress();
+        TRY(decoder->append(data.slice(offset, min(chunk_size, data.size() - offset))));
+    }
+
+    auto bitmap = TRY(decoder->partial_bitmap());
+    if (!bitmap)
+        return Error::from_string_literal("Incremental decode did not produce a bitmap");
+    return IncrementalDecodeResult { bitmap.release_nonnull(), progress_before_last_chunk };
+}
+
+static void expect_same_pixels(Gfx::Bitmap const& a, Gfx::Bitmap const& b)
+{
+    EXPECT_EQ(a.size(), b.size());
+    if (a.size() != b.size())
+        return;
+
+    size_t differing_pixel_count = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            if (a.get_pixel(x, y) != b.get_pixel(x, y))
+                ++differing_pixel_count;
+        }
+    }
+    EXPECT_EQ(differing_pixel_count, 0u);
+}
+
+TEST_CASE(test_jpeg_incremental)
+{
+    {
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/rgb24.jpg"sv)));
+        auto result = TRY_OR_FAIL(decode_incrementally(file->bytes(), 256));
+        EXPECT(result.progress_before_last_chunk > 0);
+
+        auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+        auto frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+        expect_same_pixels(*result.bitmap, *frame.image);
+    }
+
+    {
+        // JPEGs with several scans show each scan once it is complete.
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/several_scans.jpg"sv)));
+        auto result = TRY_OR_FAIL(decode_incrementally(file->bytes(), 1024));
+        EXPECT(result.progress_before_last_chunk > 0);
+        EXPECT_EQ(result.bitmap->size(), Gfx::IntSize(592, 800));
+        EXPECT_EQ(result.bitmap->get_pixel(0, 799).alpha(), 255);
+    }
+
+    {
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/buggie-cmyk.jpg"sv)));
+        EXPECT(decode_incrementally(file->bytes(), 1024).is_error());
+    }
+}
+
 TEST_CASE(test_jpeg_ycck)
 {
     Array test_inputs = {
@@ -451,6 +540,24 @@ TEST_CASE(test_png)
     TRY_OR_FAIL(expect_single_frame(*plugin_decoder));
 }
 
+TEST_CASE(test_png_incremental)
+{
+    {
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+        auto result = TRY_OR_FAIL(decode_incrementally(file->bytes(), 512));
+        EXPECT(result.progress_before_last_chunk > 0);
+
+        auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+        auto frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+        expect_same_pixels(*result.bitmap, *frame.image);
+    }
+
+    {
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/apng-blend.png"sv)));
+        EXPECT(decode_incrementally(file->bytes(), 512).is_error());
+    }
+}
+
 TEST_CASE(test_apng)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/apng-1-frame.png"sv)));
@@ -800,6 +907,37 @@ TEST_CASE(test_webp_simple_lossy)
     EXPECT_EQ(frame.image->get_pixel(198, 202), Gfx::Color(0x7a, 0xaa, 0xd5, 255));
 }
 
+TEST_CASE(test_webp_ideal_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("webp/simple-vp8.webp"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::WebPImageDecoderPlugin::create(file->bytes()));
+
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 60, 30 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(60, 60));
+    EXPECT_EQ(plugin_decoder->size(), Gfx::IntSize(240, 240));
+
+    // Images are never scaled up.
+    frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 480, 480 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(240, 240));
+}
+
+TEST_CASE(test_webp_incremental)
+{
+    {
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("webp/simple-vp8l.webp"sv)));
+        auto result = TRY_OR_FAIL(decode_incrementally(file->bytes(), 64));
+
+        auto plugin_decoder = TRY_OR_FAIL(Gfx::WebPImageDecoderPlugin::create(file->bytes()));
+        auto frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+        expect_same_pixels(*result.bitmap, *frame.image);
+    }
+
+    {
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("webp/extended-lossless-animated.webp"sv)));
+        EXPECT(decode_incrementally(file->bytes(), 64).is_error());
+    }
+}
+
 TEST_CASE(test_webp_simple_lossless)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("webp/simple-vp8l.webp"sv)));
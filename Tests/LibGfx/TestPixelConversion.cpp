@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibGfx/PixelConversion.h>
+#include <LibTest/TestCase.h>
+
+// Every combination of a color channel and alpha, with a length that isn't a multiple of the vector size.
+static Vector<ARGB32> all_channel_and_alpha_combinations()
+{
+    Vector<ARGB32> pixels;
+    for (u32 alpha = 0; alpha < 256; ++alpha) {
+        for (u32 value = 0; value < 256; ++value)
+            pixels.append((alpha << 24) | (value << 16) | ((255 - value) << 8) | (value ^ alpha));
+    }
+    pixels.append(0x80ff8040);
+    return pixels;
+}
+
+TEST_CASE(premultiply_alpha)
+{
+    auto pixels = all_channel_and_alpha_combinations();
+    auto expected = pixels;
+    for (auto& pixel : expected)
+        pixel = Color::from_argb(pixel).to_premultiplied().value();
+
+    Gfx::premultiply_alpha(pixels);
+    EXPECT_EQ(pixels, expected);
+}
+
+TEST_CASE(unpremultiply_alpha)
+{
+    auto pixels = all_channel_and_alpha_combinations();
+    auto expected = pixels;
+    for (auto& pixel : expected)
+        pixel = Color::from_argb(pixel).to_unpremultiplied().value();
+
+    Gfx::unpremultiply_alpha(pixels);
+    EXPECT_EQ(pixels, expected);
+}
+
+TEST_CASE(convert_cmyk_to_bgrx)
+{
+    Vector<Gfx::CMYK> cmyk_pixels;
+    for (u32 k = 0; k < 256; ++k) {
+        for (u32 value = 0; value < 256; ++value)
+            cmyk_pixels.append({ static_cast<u8>(value), static_cast<u8>(255 - value), static_cast<u8>(value ^ k), static_cast<u8>(k) });
+    }
+    cmyk_pixels.append({ 10, 20, 30, 40 });
+
+    Vector<ARGB32> expected;
+    for (auto const& cmyk : cmyk_pixels) {
+        u8 k = 255 - cmyk.k;
+        expected.append(Color((255 - cmyk.c) * k / 255, (255 - cmyk.m) * k / 255, (255 - cmyk.y) * k / 255).value());
+    }
+
+    Vector<ARGB32> pixels;
+    pixels.resize(cmyk_pixels.size());
+    Gfx::convert_cmyk_to_bgrx(cmyk_pixels, pixels);
+    EXPECT_EQ(pixels, expected);
+}
@@ -43,3 +43,11 @@ TEST_CASE(malformed_woff2)
         EXPECT(font_or_error.is_error());
     }
 }
+
+TEST_CASE(same_font_file_is_decompressed_once)
+{
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("woff2/incorrect_sfnt_size.woff2"sv)));
+    auto first_font = TRY_OR_FAIL(WOFF2::try_load_from_bytes(file->bytes()));
+    auto second_font = TRY_OR_FAIL(WOFF2::try_load_from_bytes(file->bytes()));
+    EXPECT_EQ(first_font.ptr(), second_font.ptr());
+}
@@ -0,0 +1,108 @@
+// Tokenizes, parses and evaluates arithmetic expressions, like the front end of a small language.
+
+function tokenize(source) {
+    const tokens = [];
+    let i = 0;
+    while (i < source.length) {
+        const character = source[i];
+        if (character === " ") {
+            ++i;
+        } else if (character >= "0" && character <= "9") {
+            let end = i;
+            while (end < source.length && source[end] >= "0" && source[end] <= "9") ++end;
+            tokens.push({ type: "number", value: Number(source.slice(i, end)) });
+            i = end;
+        } else if (character >= "a" && character <= "z") {
+            let end = i;
+            while (end < source.length && source[end] >= "a" && source[end] <= "z") ++end;
+            tokens.push({ type: "identifier", value: source.slice(i, end) });
+            i = end;
+        } else {
+            tokens.push({ type: "operator", value: character });
+            ++i;
+        }
+    }
+    return tokens;
+}
+
+class Parser {
+    constructor(tokens) {
+        this.tokens = tokens;
+        this.position = 0;
+    }
+
+    peek() {
+        return this.tokens[this.position];
+    }
+
+    consume() {
+        return this.tokens[this.position++];
+    }
+
+    parseExpression() {
+        let left = this.parseTerm();
+        while (this.peek() && (this.peek().value === "+" || this.peek().value === "-")) {
+            const operator = this.consume().value;
+            left = { type: "binary", operator, left, right: this.parseTerm() };
+        }
+        return left;
+    }
+
+    parseTerm() {
+        let left = this.parseFactor();
+        while (this.peek() && (this.peek().value === "*" || this.peek().value === "%")) {
+            const operator = this.consume().value;
+            left = { type: "binary", operator, left, right: this.parseFactor() };
+        }
+        return left;
+    }
+
+    parseFactor() {
+        const token = this.consume();
+        if (token.type === "number") return { type: "literal", value: token.value };
+        if (token.type === "identifier") return { type: "variable", name: token.value };
+        const expression = this.parseExpression();
+        this.consume();
+        return expression;
+    }
+}
+
+function evaluate(node, variables) {
+    switch (node.type) {
+        case "literal":
+            return node.value;
+        case "variable":
+            return variables.get(node.name);
+        case "binary": {
+            const left = evaluate(node.left, variables);
+            const right = evaluate(node.right, variables);
+            switch (node.operator) {
+                case "+":
+                    return left + right;
+                case "-":
+                    return left - right;
+                case "*":
+                    return left * right;
+                case "%":
+                    return left % right;
+            }
+        }
+    }
+    throw new Error(`Unknown node ${node.type}`);
+}
+
+const sources = ["(a + b) * (c - 3) % 1000", "a * a + b * b - c * c", "((a + 1) * (b + 2) * (c + 3)) % 97 + a"];
+let total = 0;
+for (let iteration = 0; iteration < 2000; ++iteration) {
+    const variables = new Map([
+        ["a", iteration % 31],
+        ["b", iteration % 17],
+        ["c", iteration % 11],
+    ]);
+    for (const source of sources) {
+        const tree = new Parser(tokenize(source)).parseExpression();
+        total += evaluate(tree, variables);
+    }
+}
+
+if (total !== 929700) throw new Error(`Unexpected result ${total}`);
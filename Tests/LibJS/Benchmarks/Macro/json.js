@@ -0,0 +1,30 @@
+// Serializes and parses a document resembling the response of a web API, and walks the result.
+
+function createDocument(size) {
+    const items = [];
+    for (let i = 0; i < size; ++i) {
+        items.push({
+            id: i,
+            name: `Item ${i}`,
+            price: (i * 37) % 1000 / 10,
+            tags: ["alpha", "beta", "gamma"].slice(0, (i % 3) + 1),
+            available: i % 2 === 0,
+            dimensions: { width: i % 13, height: i % 17, depth: null },
+        });
+    }
+    return { total: size, page: 1, items };
+}
+
+const document = createDocument(2000);
+let availableCount = 0;
+let tagCount = 0;
+for (let iteration = 0; iteration < 10; ++iteration) {
+    const text = JSON.stringify(document);
+    const parsed = JSON.parse(text, (key, value) => (key === "price" ? Math.round(value) : value));
+    for (const item of parsed.items) {
+        if (item.available) ++availableCount;
+        tagCount += item.tags.length;
+    }
+}
+
+if (availableCount !== 10000 || tagCount !== 39990) throw new Error(`Unexpected result ${availableCount} ${tagCount}`);
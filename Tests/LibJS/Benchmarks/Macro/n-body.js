@@ -0,0 +1,90 @@
+// Simulates the orbits of the Jovian planets, after the n-body benchmark of the Computer Language Benchmarks Game.
+
+const solarMass = 4 * Math.PI * Math.PI;
+const daysPerYear = 365.24;
+
+class Body {
+    constructor(x, y, z, vx, vy, vz, mass) {
+        this.x = x;
+        this.y = y;
+        this.z = z;
+        this.vx = vx * daysPerYear;
+        this.vy = vy * daysPerYear;
+        this.vz = vz * daysPerYear;
+        this.mass = mass * solarMass;
+    }
+}
+
+function createBodies() {
+    return [
+        new Body(0, 0, 0, 0, 0, 0, 1),
+        new Body(4.84143144246472090e00, -1.16032004402742839e00, -1.03622044471123109e-01, 1.66007664274403694e-03, 7.69901118419740425e-03, -6.90460016972063023e-05, 9.54791938424326609e-04),
+        new Body(8.34336671824457987e00, 4.12479856412430479e00, -4.03523417114321381e-01, -2.76742510726862411e-03, 4.99852801234917238e-03, 2.30417297573763929e-05, 2.85885980666130812e-04),
+        new Body(1.28943695621391310e01, -1.51111514016986312e01, -2.23307578892655734e-01, 2.96460137564761618e-03, 2.37847173959480950e-03, -2.96589568540237556e-05, 4.36624404335156298e-05),
+        new Body(1.53796971148509165e01, -2.59193146099879641e01, 1.79258772950371181e-01, 2.68067772490389322e-03, 1.62824170038242295e-03, -9.51592254519715870e-05, 5.15138902046611451e-05),
+    ];
+}
+
+function offsetMomentum(bodies) {
+    let px = 0;
+    let py = 0;
+    let pz = 0;
+    for (const body of bodies) {
+        px += body.vx * body.mass;
+        py += body.vy * body.mass;
+        pz += body.vz * body.mass;
+    }
+    bodies[0].vx = -px / solarMass;
+    bodies[0].vy = -py / solarMass;
+    bodies[0].vz = -pz / solarMass;
+}
+
+function advance(bodies, dt) {
+    for (let i = 0; i < bodies.length; ++i) {
+        const a = bodies[i];
+        for (let j = i + 1; j < bodies.length; ++j) {
+            const b = bodies[j];
+            const dx = a.x - b.x;
+            const dy = a.y - b.y;
+            const dz = a.z - b.z;
+            const distanceSquared = dx * dx + dy * dy + dz * dz;
+            const magnitude = dt / (distanceSquared * Math.sqrt(distanceSquared));
+            a.vx -= dx * b.mass * magnitude;
+            a.vy -= dy * b.mass * magnitude;
+            a.vz -= dz * b.mass * magnitude;
+            b.vx += dx * a.mass * magnitude;
+            b.vy += dy * a.mass * magnitude;
+            b.vz += dz * a.mass * magnitude;
+        }
+    }
+    for (const body of bodies) {
+        body.x += dt * body.vx;
+        body.y += dt * body.vy;
+        body.z += dt * body.vz;
+    }
+}
+
+function energy(bodies) {
+    let result = 0;
+    for (let i = 0; i < bodies.length; ++i) {
+        const a = bodies[i];
+        result += 0.5 * a.mass * (a.vx * a.vx + a.vy * a.vy + a.vz * a.vz);
+        for (let j = i + 1; j < bodies.length; ++j) {
+            const b = bodies[j];
+            const dx = a.x - b.x;
+            const dy = a.y - b.y;
+            const dz = a.z - b.z;
+            result -= (a.mass * b.mass) / Math.sqrt(dx * dx + dy * dy + dz * dz);
+        }
+    }
+    return result;
+}
+
+const bodies = createBodies();
+offsetMomentum(bodies);
+const initialEnergy = energy(bodies);
+for (let i = 0; i < 50000; ++i) advance(bodies, 0.01);
+const finalEnergy = energy(bodies);
+
+if (initialEnergy.toFixed(9) !== "-0.169075164" || finalEnergy.toFixed(9) !== "-0.169078071")
+    throw new Error(`Unexpected result ${initialEnergy} ${finalEnergy}`);
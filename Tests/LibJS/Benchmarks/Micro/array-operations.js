@@ -0,0 +1,23 @@
+// Fills, transforms and sorts arrays.
+
+let seed = 42;
+function random() {
+    seed = (seed * 1103515245 + 12345) % 2147483648;
+    return seed;
+}
+
+let checksum = 0;
+for (let iteration = 0; iteration < 20; ++iteration) {
+    const numbers = [];
+    for (let i = 0; i < 5000; ++i) numbers.push(random() % 10000);
+
+    const doubled = numbers.map(value => value * 2).filter(value => value % 3 !== 0);
+    doubled.sort((a, b) => a - b);
+
+    for (let i = 1; i < doubled.length; ++i) {
+        if (doubled[i - 1] > doubled[i]) throw new Error("Array is not sorted");
+    }
+    checksum += doubled.reduce((total, value) => total + value, 0) % 1000;
+}
+
+if (checksum <= 0) throw new Error(`Unexpected result ${checksum}`);
@@ -0,0 +1,27 @@
+// Calls small functions, methods and closures.
+
+function add(a, b) {
+    return a + b;
+}
+
+const object = {
+    total: 0,
+    increment(value) {
+        this.total += value;
+    },
+};
+
+function makeCounter() {
+    let count = 0;
+    return () => ++count;
+}
+
+const counter = makeCounter();
+let sum = 0;
+for (let i = 0; i < 500000; ++i) {
+    sum = add(sum, i & 7);
+    object.increment(1);
+    counter();
+}
+
+if (sum !== 1750000 || object.total !== 500000 || counter() !== 500001) throw new Error("Unexpected result");
@@ -0,0 +1,16 @@
+// Reads a property from objects of many different shapes at the same site, so that the inline cache gives up on it.
+
+const objects = [];
+for (let i = 0; i < 64; ++i) {
+    const object = {};
+    object[`unique${i}`] = i;
+    object.value = i;
+    objects.push(object);
+}
+
+let sum = 0;
+for (let iteration = 0; iteration < 20000; ++iteration) {
+    for (let i = 0; i < objects.length; ++i) sum += objects[i].value;
+}
+
+if (sum !== 40320000) throw new Error(`Unexpected result ${sum}`);
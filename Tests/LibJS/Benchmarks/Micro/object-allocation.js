@@ -0,0 +1,11 @@
+// Allocates many short-lived objects and arrays, which mostly measures the allocator and the garbage collector.
+
+let live = null;
+let total = 0;
+for (let i = 0; i < 200000; ++i) {
+    const object = { index: i, values: [i, i + 1, i + 2], next: null };
+    if (i % 1000 === 0) live = object;
+    total += object.values.length;
+}
+
+if (total !== 600000 || live.index !== 199000) throw new Error("Unexpected result");
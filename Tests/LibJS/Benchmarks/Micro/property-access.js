@@ -0,0 +1,22 @@
+// Reads and writes properties of objects that all share one shape, which should always hit the inline caches.
+
+class Point {
+    constructor(x, y) {
+        this.x = x;
+        this.y = y;
+    }
+}
+
+const points = [];
+for (let i = 0; i < 1000; ++i) points.push(new Point(i, i * 2));
+
+let sum = 0;
+for (let iteration = 0; iteration < 500; ++iteration) {
+    for (let i = 0; i < points.length; ++i) {
+        const point = points[i];
+        sum += point.x + point.y;
+        point.x = point.y - i;
+    }
+}
+
+if (sum !== 749250000) throw new Error(`Unexpected result ${sum}`);
@@ -0,0 +1,16 @@
+// Builds strings by concatenation, template literals and joining, and then searches them.
+
+let result = "";
+for (let i = 0; i < 20000; ++i) result += `${i % 10}`;
+
+const parts = [];
+for (let i = 0; i < 20000; ++i) parts.push(String.fromCharCode(97 + (i % 26)));
+const joined = parts.join("");
+
+let matches = 0;
+for (let i = 0; i < 200; ++i) {
+    if (result.indexOf("0123456789", i) !== -1) ++matches;
+    if (joined.includes("xyz")) ++matches;
+}
+
+if (result.length !== 20000 || joined.length !== 20000 || matches !== 400) throw new Error("Unexpected result");
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BuiltinWrappers.h>
+#include <LibCore/File.h>
 #include <LibTest/TestCase.h>
 
 #include <LibMedia/Containers/Matroska/Reader.h>
@@ -23,3 +25,87 @@ TEST_CASE(master_elements_containing_crc32)
     MUST(matroska_reader.seek_to_random_access_point(iterator, AK::Duration::from_seconds(7)));
     MUST(iterator.next_block());
 }
+
+// Hides the Cues of a file from the reader, by turning the Cues element into a Void element of the same size, and its
+// SeekHead entry into one for an unknown element.
+static ByteBuffer read_file_without_cues(StringView path)
+{
+    auto file = MUST(Core::File::open(path, Core::File::OpenMode::Read));
+    auto data = MUST(file->read_until_eof());
+
+    static constexpr u8 cues_id[] = { 0x1C, 0x53, 0xBB, 0x6B };
+    for (size_t i = 3; i + 5 <= data.size(); i++) {
+        if (__builtin_memcmp(data.data() + i, cues_id, sizeof(cues_id)) != 0)
+            continue;
+
+        // SeekID element with a size of 4.
+        if (data[i - 3] == 0x53 && data[i - 2] == 0xAB && data[i - 1] == 0x84) {
+            data[i + 3] = 0x6A;
+            continue;
+        }
+
+        size_t size_length = count_leading_zeroes(data[i + 4]) + 1;
+        VERIFY(size_length + 3 <= 8 && i + 4 + size_length <= data.size());
+        u64 size = data[i + 4] & (0xFF >> size_length);
+        for (size_t j = 1; j < size_length; j++)
+            size = (size << 8) | data[i + 4 + j];
+
+        // Write the same size with three more octets, to make up for the shorter ID.
+        data[i] = 0xEC;
+        auto new_size_length = size_length + 3;
+        u64 encoded_size = (1ull << (7 * new_size_length)) | size;
+        for (size_t j = 0; j < new_size_length; j++)
+            data[i + 1 + j] = static_cast<u8>(encoded_size >> (8 * (new_size_length - 1 - j)));
+    }
+    return data;
+}
+
+TEST_CASE(seek_without_cues)
+{
+    auto data = read_file_without_cues("master_elements_containing_crc32.mkv"sv);
+    auto matroska_reader = MUST(Media::Matroska::Reader::from_data(data));
+    u64 video_track = 0;
+    MUST(matroska_reader.for_each_track_of_type(Media::Matroska::TrackEntry::TrackType::Video, [&](Media::Matroska::TrackEntry const& track_entry) -> Media::DecoderErrorOr<IterationDecision> {
+        video_track = track_entry.track_number();
+        return IterationDecision::Break;
+    }));
+    EXPECT(!MUST(matroska_reader.has_cues_for_track(video_track)));
+
+    // Seeking forward before anything was read has to search for the keyframe.
+    auto iterator = MUST(matroska_reader.create_sample_iterator(video_track));
+    auto seeked_iterator = MUST(matroska_reader.seek_to_random_access_point(iterator, AK::Duration::from_milliseconds(500)));
+    EXPECT(seeked_iterator.last_timestamp().has_value());
+
+    // Read the whole file, which indexes all of its keyframes.
+    Vector<AK::Duration> keyframe_timestamps;
+    AK::Duration last_timestamp;
+    while (true) {
+        auto block_or_error = iterator.next_block();
+        if (block_or_error.is_error()) {
+            EXPECT_EQ(block_or_error.error().category(), Media::DecoderErrorCategory::EndOfStream);
+            break;
+        }
+        auto block = block_or_error.release_value();
+        if (block.only_keyframes())
+            keyframe_timestamps.append(block.timestamp());
+        last_timestamp = block.timestamp();
+    }
+    EXPECT(keyframe_timestamps.size() > 1);
+
+    // Any seek should now land on the last keyframe at or before the timestamp.
+    for (auto timestamp = AK::Duration::zero(); timestamp < last_timestamp; timestamp += AK::Duration::from_milliseconds(100)) {
+        Optional<AK::Duration> expected_timestamp;
+        for (auto keyframe_timestamp : keyframe_timestamps) {
+            if (keyframe_timestamp <= timestamp)
+                expected_timestamp = keyframe_timestamp;
+        }
+        if (!expected_timestamp.has_value())
+            continue;
+
+        auto keyframe_iterator = MUST(matroska_reader.seek_to_random_access_point(MUST(matroska_reader.create_sample_iterator(video_track)), timestamp));
+        EXPECT_EQ(keyframe_iterator.last_timestamp().value(), expected_timestamp.value());
+        auto block = MUST(keyframe_iterator.next_block());
+        EXPECT_EQ(block.timestamp(), expected_timestamp.value());
+        EXPECT(block.only_keyframes());
+    }
+}
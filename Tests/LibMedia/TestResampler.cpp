@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <AK/Vector.h>
+#include <LibMedia/Audio/Resampler.h>
+#include <LibTest/TestCase.h>
+
+// Resamples a sine wave in chunks of varying sizes, and returns the largest difference from the ideal output, skipping
+// the start of the output that the filter takes to settle.
+static float resample_sine(u32 input_sample_rate, u32 output_sample_rate, double frequency)
+{
+    static constexpr u8 channel_count = 2;
+    auto resampler = MUST(Audio::Resampler::create(input_sample_rate, output_sample_rate, channel_count));
+
+    size_t input_frame = 0;
+    size_t output_frame = 0;
+    float max_error = 0;
+
+    for (size_t chunk = 0; chunk < 64; ++chunk) {
+        auto output_frame_count = 37 + ((chunk * 97) % 300);
+        auto input_frame_count = resampler->input_frames_needed(output_frame_count);
+
+        Vector<float> input;
+        for (size_t frame = 0; frame < input_frame_count; ++frame, ++input_frame) {
+            auto value = static_cast<float>(AK::sin(2 * AK::Pi<double> * frequency * static_cast<double>(input_frame) / input_sample_rate));
+            input.append(value);
+            input.append(-value);
+        }
+
+        Vector<float> output;
+        output.resize(output_frame_count * channel_count);
+        MUST(resampler->process(input, output));
+
+        for (size_t frame = 0; frame < output_frame_count; ++frame, ++output_frame) {
+            if (output_frame < output_sample_rate / 100)
+                continue;
+            auto expected = static_cast<float>(AK::sin(2 * AK::Pi<double> * frequency * static_cast<double>(output_frame) / output_sample_rate));
+            max_error = max(max_error, AK::fabs(output[frame * channel_count] - expected));
+            max_error = max(max_error, AK::fabs(output[(frame * channel_count) + 1] + expected));
+        }
+    }
+
+    return max_error;
+}
+
+TEST_CASE(resample_between_common_rates)
+{
+    EXPECT(resample_sine(44100, 48000, 1000) < 0.001f);
+    EXPECT(resample_sine(48000, 44100, 1000) < 0.001f);
+    EXPECT(resample_sine(22050, 48000, 5000) < 0.001f);
+    EXPECT(resample_sine(96000, 48000, 10000) < 0.001f);
+    EXPECT(resample_sine(8000, 48000, 440) < 0.001f);
+}
+
+TEST_CASE(resample_between_rates_with_a_large_denominator)
+{
+    EXPECT(resample_sine(44100, 47999, 1000) < 0.001f);
+}
+
+TEST_CASE(resampling_removes_frequencies_above_the_output_nyquist_frequency)
+{
+    auto resampler = MUST(Audio::Resampler::create(48000, 16000, 1));
+
+    Vector<float> input;
+    input.resize(resampler->input_frames_needed(1600));
+    for (size_t frame = 0; frame < input.size(); ++frame)
+        input[frame] = static_cast<float>(AK::sin(2 * AK::Pi<double> * 12000 * static_cast<double>(frame) / 48000));
+
+    Vector<float> output;
+    output.resize(1600);
+    MUST(resampler->process(input, output));
+
+    float peak = 0;
+    for (size_t frame = 160; frame < output.size(); ++frame)
+        peak = max(peak, AK::fabs(output[frame]));
+    EXPECT(peak < 0.001f);
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/ByteBuffer.h>
+#include <AK/Vector.h>
+#include <LibMedia/Audio/SampleFormats.h>
+#include <LibTest/TestCase.h>
+
+static constexpr Array<float, 11> test_samples { -1.5f, -1.0f, -0.75f, -0.5f, -0.001f, 0.0f, 0.001f, 0.25f, 0.5f, 1.0f, 2.0f };
+
+static void expect_round_trip(Audio::PcmSampleFormat format, float tolerance)
+{
+    auto bytes_per_sample = Audio::pcm_bits_per_sample(format) / 8;
+    auto bytes = MUST(ByteBuffer::create_zeroed(test_samples.size() * bytes_per_sample));
+    Audio::convert_samples_from_float(test_samples.span(), format, bytes);
+
+    Vector<float> result;
+    result.resize(test_samples.size());
+    Audio::convert_samples_to_float(format, bytes, result);
+
+    auto is_float_format = format == Audio::PcmSampleFormat::Float32 || format == Audio::PcmSampleFormat::Float64;
+    for (size_t i = 0; i < test_samples.size(); ++i) {
+        auto expected = is_float_format ? test_samples[i] : clamp(test_samples[i], -1.0f, 1.0f);
+        EXPECT_APPROXIMATE_WITH_ERROR(result[i], expected, tolerance);
+    }
+}
+
+TEST_CASE(round_trip_through_each_format)
+{
+    expect_round_trip(Audio::PcmSampleFormat::Uint8, 1.0f / 64);
+    expect_round_trip(Audio::PcmSampleFormat::Int16, 1.0f / 16384);
+    expect_round_trip(Audio::PcmSampleFormat::Int24, 1.0f / 4194304);
+    expect_round_trip(Audio::PcmSampleFormat::Int32, 1e-6f);
+    expect_round_trip(Audio::PcmSampleFormat::Float32, 0);
+    expect_round_trip(Audio::PcmSampleFormat::Float64, 0);
+}
+
+TEST_CASE(integer_samples_cover_the_full_range)
+{
+    Array<i16, 9> int16_samples { NumericLimits<i16>::min(), -16384, -1, 0, 1, 16384, NumericLimits<i16>::max(), 0, -8192 };
+    Array<float, 9> floats {};
+    Audio::convert_samples_to_float(Audio::PcmSampleFormat::Int16, ReadonlyBytes { int16_samples.data(), sizeof(int16_samples) }, floats);
+    EXPECT_EQ(floats[0], -1.0f);
+    EXPECT_EQ(floats[1], -0.5f);
+    EXPECT_EQ(floats[5], 0.5f);
+    EXPECT_EQ(floats[8], -0.25f);
+
+    // 0x800000, 0x400000 and 0x7fffff as little-endian 24-bit samples.
+    Array<u8, 21> int24_samples { 0x00, 0x00, 0x80, 0x00, 0x00, 0x40, 0xff, 0xff, 0x7f, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0xc0, 0x01, 0x00, 0x00 };
+    Array<float, 7> int24_floats {};
+    Audio::convert_samples_to_float(Audio::PcmSampleFormat::Int24, int24_samples, int24_floats);
+    EXPECT_EQ(int24_floats[0], -1.0f);
+    EXPECT_EQ(int24_floats[1], 0.5f);
+    EXPECT_APPROXIMATE(int24_floats[2], 1.0f);
+    EXPECT_EQ(int24_floats[3], 0.0f);
+    EXPECT_EQ(int24_floats[4], -1.0f / 8388608);
+    EXPECT_EQ(int24_floats[5], -0.5f);
+    EXPECT_EQ(int24_floats[6], 1.0f / 8388608);
+}
+
+TEST_CASE(float_samples_are_rounded_and_clipped)
+{
+    Array<float, 10> floats { 2.0f, 1.0f, 0.5f, 1.4f / 32767, 1.6f / 32767, -1.4f / 32767, -1.6f / 32767, -0.5f, -1.0f, -2.0f };
+    Array<i16, 10> int16_samples {};
+    Audio::convert_samples_from_float(floats, Audio::PcmSampleFormat::Int16, Bytes { int16_samples.data(), sizeof(int16_samples) });
+    Array<i16, 10> expected_samples { 32767, 32767, 16384, 1, 2, -1, -2, -16384, -32767, -32767 };
+    for (size_t i = 0; i < int16_samples.size(); ++i)
+        EXPECT_EQ(int16_samples[i], expected_samples[i]);
+}
+
+TEST_CASE(interleave_and_deinterleave)
+{
+    for (size_t channel_count = 1; channel_count <= 3; ++channel_count) {
+        static constexpr size_t frame_count = 13;
+
+        Vector<Vector<float>> channels;
+        for (size_t channel = 0; channel < channel_count; ++channel) {
+            Vector<float> samples;
+            for (size_t frame = 0; frame < frame_count; ++frame)
+                samples.append(static_cast<float>((channel * 100) + frame));
+            channels.append(move(samples));
+        }
+
+        Vector<ReadonlySpan<float>> channel_spans;
+        for (auto const& channel : channels)
+            channel_spans.append(channel.span());
+
+        Vector<float> interleaved;
+        interleaved.resize(frame_count * channel_count);
+        Audio::interleave_samples(channel_spans, interleaved);
+        for (size_t frame = 0; frame < frame_count; ++frame) {
+            for (size_t channel = 0; channel < channel_count; ++channel)
+                EXPECT_EQ(interleaved[(frame * channel_count) + channel], channels[channel][frame]);
+        }
+
+        Vector<Vector<float>> deinterleaved;
+        Vector<Span<float>> deinterleaved_spans;
+        deinterleaved.resize(channel_count);
+        for (auto& channel : deinterleaved) {
+            channel.resize(frame_count);
+            deinterleaved_spans.append(channel.span());
+        }
+        Audio::deinterleave_samples(interleaved, deinterleaved_spans);
+        for (size_t channel = 0; channel < channel_count; ++channel)
+            EXPECT(deinterleaved[channel].span() == channels[channel].span());
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h> // import first, to prevent warning of VERIFY* redefinition
+
+#include <AK/StringBuilder.h>
+#include <AK/Time.h>
+#include <LibRegex/Regex.h>
+
+// Patterns as they are used by popular JS libraries, each run over a representative input. Besides timing the whole
+// run, this reports the time it takes to compile each pattern, the matching throughput, and the number of operations
+// the matcher went through, so that regressions can be pinned down to a pattern.
+
+struct CorpusEntry {
+    StringView name;
+    StringView pattern;
+    ECMAScriptFlags flags;
+    // Repeated to make up the input.
+    StringView input_chunk;
+    // Whether to match every line on its own, like validating user input does, rather than searching the whole input.
+    bool per_line { false };
+};
+
+static constexpr auto global = static_cast<ECMAScriptFlags>(regex::AllFlags::Global);
+
+static CorpusEntry const s_corpus[] {
+    {
+        "url"sv,
+        "^(([^:/?#]+):)?(//([^/?#]*))?([^?#]*)(\\?([^#]*))?(#(.*))?$"sv,
+        {},
+        "https://example.com/path/to/page?query=1&other=two#fragment\nhttp://ladybird.org/\nmailto:someone@example.com\n"sv,
+        true,
+    },
+    {
+        "template"sv,
+        "\\{\\{\\s*([\\w.]+)\\s*\\}\\}"sv,
+        global,
+        "<li class=\"item\"><a href=\"{{ item.url }}\">{{item.title}}</a> by {{ item.author.name }}</li>\n"sv,
+    },
+    {
+        "tokenizer"sv,
+        "[A-Za-z_$][\\w$]*|\\d+(?:\\.\\d+)?|\"(?:[^\"\\\\]|\\\\.)*\"|\\S"sv,
+        global,
+        "function add(a, b) { return a + b * 2.5; } const name = \"hello \\\"world\\\"\"; if (x >= 10) call(name);\n"sv,
+    },
+    {
+        "email"sv,
+        "^[a-zA-Z0-9.!#$%&'*+/=?^_`{|}~-]+@[a-zA-Z0-9](?:[a-zA-Z0-9-]{0,61}[a-zA-Z0-9])?(?:\\.[a-zA-Z0-9](?:[a-zA-Z0-9-]{0,61}[a-zA-Z0-9])?)*$"sv,
+        {},
+        "someone@example.com\nfirst.last+tag@mail.example.org\nnot an email\nbroken@\n"sv,
+        true,
+    },
+    {
+        "phone"sv,
+        "\\(?\\d{3}\\)?[-. ]?\\d{3}[-. ]?\\d{4}"sv,
+        global,
+        "Call us at (555) 123-4567 or 555.765.4321, fax 555 000 1111. Order #12345 ships in 3 days.\n"sv,
+    },
+    {
+        "log-search"sv,
+        "error: (\\w+) at line (\\d+)"sv,
+        global,
+        "[info] started worker 3\n[debug] cache hit for /index.html\n[warn] slow response: 512ms\n[error] error: timeout at line 42\n"sv,
+    },
+    {
+        "trim"sv,
+        "^[\\s\\uFEFF\\xA0]+|[\\s\\uFEFF\\xA0]+$"sv,
+        global,
+        "   some text that needs trimming   \n"sv,
+        true,
+    },
+};
+
+static constexpr size_t input_size = 256 * KiB;
+
+static ByteString make_input(StringView chunk)
+{
+    StringBuilder builder;
+    while (builder.length() < input_size)
+        builder.append(chunk);
+    return builder.to_byte_string();
+}
+
+BENCHMARK_CASE(real_world_patterns)
+{
+    outln("{:<12} {:>12} {:>12} {:>10} {:>14} {:>8}", "pattern"sv, "parse (us)"sv, "compile (us)"sv, "MiB/s"sv, "operations"sv, "matches"sv);
+
+    for (auto const& entry : s_corpus) {
+        auto input = make_input(entry.input_chunk);
+
+        auto start = MonotonicTime::now();
+        auto parse_result = Regex<ECMA262>::parse_pattern(entry.pattern, entry.flags);
+        auto parse_time = MonotonicTime::now() - start;
+        EXPECT_EQ(parse_result.error, regex::Error::NoError);
+
+        // Includes parsing again, as well as the optimization passes.
+        start = MonotonicTime::now();
+        Regex<ECMA262> re(entry.pattern, entry.flags);
+        auto compile_time = MonotonicTime::now() - start;
+
+        size_t operations = 0;
+        size_t matches = 0;
+        start = MonotonicTime::now();
+        if (entry.per_line) {
+            for (auto line : input.view().lines()) {
+                auto result = re.match(line);
+                operations += result.operations;
+                matches += result.success ? 1 : 0;
+            }
+        } else {
+            auto result = re.match(input.view());
+            operations = result.operations;
+            matches = result.matches.size();
+        }
+        auto match_time = MonotonicTime::now() - start;
+        EXPECT(matches > 0);
+
+        auto seconds = max<i64>(match_time.to_nanoseconds(), 1) / 1e9;
+        auto throughput = static_cast<double>(input.length()) / MiB / seconds;
+        outln("{:<12} {:>12} {:>12} {:>10.1} {:>14} {:>8}", entry.name, parse_time.to_microseconds(), compile_time.to_microseconds(), throughput, operations, matches);
+    }
+}
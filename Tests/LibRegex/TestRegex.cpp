@@ -1469,3 +1469,95 @@ TEST_CASE(backreference_to_undefined_capture_groups)
         EXPECT(result2.capture_group_matches.first()[1].view.is_null());
     }
 }
+
+TEST_CASE(match_without_backtracking)
+{
+    {
+        // Captures come out as the backtracking matcher would leave them.
+        Regex<ECMA262> re("(a+?|a(b)?)(b*)c"sv, (ECMAScriptFlags)regex::AllFlags::Global);
+        auto result = re.match("xxaabbc\nabc\nac"sv);
+
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 3u);
+        EXPECT_EQ(result.matches[0].view.to_byte_string(), "aabbc"sv);
+        EXPECT_EQ(result.capture_group_matches[0][0].view.to_byte_string(), "aa"sv);
+        EXPECT(result.capture_group_matches[0][1].view.is_null());
+        EXPECT_EQ(result.capture_group_matches[0][2].view.to_byte_string(), "bb"sv);
+        EXPECT_EQ(result.matches[1].view.to_byte_string(), "abc"sv);
+        EXPECT_EQ(result.capture_group_matches[1][0].view.to_byte_string(), "a"sv);
+        EXPECT_EQ(result.capture_group_matches[1][2].view.to_byte_string(), "b"sv);
+        EXPECT_EQ(result.matches[2].view.to_byte_string(), "ac"sv);
+        EXPECT_EQ(result.capture_group_matches[2][0].view.to_byte_string(), "a"sv);
+    }
+
+    {
+        // Word boundaries and line anchors are evaluated per position.
+        Regex<ECMA262> re("^\\w+\\b error$"sv, (ECMAScriptFlags)regex::AllFlags::Global | ECMAScriptFlags::Multiline);
+        auto result = re.match("disk error\nnet warning\nfan error"sv);
+
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 2u);
+        EXPECT_EQ(result.matches[0].view.to_byte_string(), "disk error"sv);
+        EXPECT_EQ(result.matches[1].view.to_byte_string(), "fan error"sv);
+    }
+
+    {
+        // Exponential for a backtracking matcher, linear for the automaton.
+        Regex<ECMA262> re("(a|aa)*c"sv);
+        auto result = re.search(g_lots_of_a_s.bytes_as_string_view().substring_view(0, 2000));
+        EXPECT_EQ(result.success, false);
+    }
+}
+
+TEST_CASE(literal_prefiltering)
+{
+    struct _test {
+        StringView pattern;
+        StringView subject;
+        Vector<StringView> matches;
+    };
+
+    _test const tests[] {
+        { "error: \\d+"sv, "ok\nerror: 12\nwarning: 3\nerror: 4"sv, { "error: 12"sv, "error: 4"sv } },
+        { "(?:ab)+c"sv, "xabababc abc ab"sv, { "abababc"sv, "abc"sv } },
+        { "\\d+ms"sv, "took 12ms, then 345ms"sv, { "12ms"sv, "345ms"sv } },
+        { "(?:foo)?bar"sv, "xxbar foobar"sv, { "bar"sv, "foobar"sv } },
+        { "a(?:bc)*d"sv, "ad abcd abcbcd"sv, { "ad"sv, "abcd"sv, "abcbcd"sv } },
+        { "foo|bar"sv, "bar foo"sv, { "bar"sv, "foo"sv } },
+        { "x(?=yz)"sv, "xy xyz"sv, { "x"sv } },
+        { "needle"sv, "haystack"sv, {} },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.pattern, (ECMAScriptFlags)regex::AllFlags::Global);
+        auto result = re.match(test.subject);
+        EXPECT_EQ(result.success, !test.matches.is_empty());
+        EXPECT_EQ(result.matches.size(), test.matches.size());
+        for (size_t i = 0; i < min(result.matches.size(), test.matches.size()); ++i)
+            EXPECT_EQ(result.matches[i].view.to_byte_string(), test.matches[i]);
+    }
+
+    {
+        // A literal prefix does not move a sticky match.
+        Regex<ECMA262> re("abc"sv, ECMAScriptFlags::Sticky);
+        EXPECT_EQ(re.match("xabc"sv).success, false);
+        EXPECT_EQ(re.match("abc"sv).success, true);
+    }
+}
+
+TEST_CASE(compiled_pattern_cache)
+{
+    auto statistics_before = Regex<ECMA262>::cache_statistics();
+
+    auto pattern = "compiled_pattern_cache_(\\d+)"sv;
+    auto parse_result = Regex<ECMA262>::parse_pattern(pattern);
+    Regex<ECMA262> from_parse_result(move(parse_result), pattern);
+    Regex<ECMA262> from_pattern(pattern);
+
+    auto statistics_after = Regex<ECMA262>::cache_statistics();
+    EXPECT_EQ(statistics_after.misses, statistics_before.misses + 1);
+    EXPECT_EQ(statistics_after.hits, statistics_before.hits + 1);
+
+    EXPECT(from_parse_result.has_match("compiled_pattern_cache_42"sv));
+    EXPECT(from_pattern.has_match("compiled_pattern_cache_42"sv));
+}
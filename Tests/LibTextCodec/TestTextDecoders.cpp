@@ -48,3 +48,25 @@ TEST_CASE(test_utf16le_decode)
     auto utf8 = MUST(decoder.to_utf8(test_string));
     EXPECT_EQ(utf8, "säk😀"sv);
 }
+
+TEST_CASE(test_ascii_runs_in_legacy_encodings)
+{
+    auto long_ascii_run = ByteString::repeated('a', 100);
+
+    auto& windows_1252_decoder = TextCodec::decoder_for("windows-1252"sv).value();
+    auto windows_1252_input = ByteString::formatted("{}\x80{}\x93\x94b", long_ascii_run, long_ascii_run);
+    auto windows_1252_output = MUST(windows_1252_decoder.to_utf8(windows_1252_input));
+    EXPECT_EQ(windows_1252_output, MUST(String::formatted("{}€{}“”b", long_ascii_run, long_ascii_run)));
+
+    auto& latin1_decoder = TextCodec::decoder_for_exact_name("ISO-8859-1"sv).value();
+    EXPECT_EQ(MUST(latin1_decoder.to_utf8("a\xe4\xf6b"sv)), "aäöb"sv);
+
+    // The trail byte of a Shift_JIS character can be an ASCII byte, so only the ASCII bytes before the first lead byte
+    // can be skipped.
+    auto& shift_jis_decoder = TextCodec::decoder_for("Shift_JIS"sv).value();
+    auto shift_jis_input = ByteString::formatted("{}\x82\x60{}\x81", long_ascii_run, long_ascii_run);
+    auto shift_jis_output = MUST(shift_jis_decoder.to_utf8(shift_jis_input));
+    EXPECT_EQ(shift_jis_output, MUST(String::formatted("{}Ａ{}\uFFFD", long_ascii_run, long_ascii_run)));
+    EXPECT(!shift_jis_decoder.validate(shift_jis_input));
+    EXPECT(shift_jis_decoder.validate(long_ascii_run));
+}
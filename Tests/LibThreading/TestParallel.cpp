@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/ByteString.h>
+#include <AK/FlyString.h>
+#include <AK/QuickSort.h>
+#include <AK/Random.h>
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Parallel.h>
+
+TEST_CASE(parallel_for_visits_every_index_once)
+{
+    static constexpr size_t count = 10'000;
+
+    // NOTE: Chunks never overlap, so each element is only ever touched by one thread.
+    Vector<u32> visits;
+    visits.resize(count);
+
+    Threading::parallel_for(0, count, 64, [&](size_t begin, size_t end) {
+        EXPECT(begin < end);
+        EXPECT(end - begin <= 64);
+
+        for (auto i = begin; i < end; ++i)
+            ++visits[i];
+    });
+
+    for (auto const& visit_count : visits)
+        EXPECT_EQ(visit_count, 1u);
+}
+
+TEST_CASE(parallel_for_over_empty_range)
+{
+    auto calls = 0;
+    Threading::parallel_for(5, 5, 1, [&](size_t, size_t) { ++calls; });
+    EXPECT_EQ(calls, 0);
+}
+
+TEST_CASE(parallel_for_over_span)
+{
+    Vector<int> values;
+    for (int i = 0; i < 1000; ++i)
+        values.append(i);
+
+    Threading::parallel_for(values.span(), 100, [](Span<int> chunk) {
+        for (auto& value : chunk)
+            value *= 2;
+    });
+
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(values[i], i * 2);
+}
+
+TEST_CASE(parallel_reduce_sum)
+{
+    auto sum = Threading::parallel_reduce(
+        1, 100'001, 1000, u64 { 0 },
+        [](size_t begin, size_t end) {
+            u64 chunk_sum = 0;
+            for (auto i = begin; i < end; ++i)
+                chunk_sum += i;
+            return chunk_sum;
+        },
+        [](u64 a, u64 b) { return a + b; });
+
+    EXPECT_EQ(sum, 5'000'050'000ull);
+}
+
+TEST_CASE(parallel_reduce_combines_in_order)
+{
+    auto digits = Threading::parallel_reduce(
+        0, 10, 1, ByteString {},
+        [](size_t begin, size_t) { return ByteString::number(begin); },
+        [](ByteString a, ByteString b) { return ByteString::formatted("{}{}", a, b); });
+
+    EXPECT_EQ(digits, "0123456789"sv);
+}
+
+TEST_CASE(parallel_sort_matches_quick_sort)
+{
+    static constexpr size_t count = 100'000;
+
+    Vector<u32> values;
+    values.ensure_capacity(count);
+    for (size_t i = 0; i < count; ++i)
+        values.unchecked_append(get_random<u32>());
+
+    auto expected = values;
+    quick_sort(expected);
+
+    Threading::parallel_sort(values.span(), [](u32 a, u32 b) { return a < b; }, 1000);
+    EXPECT_EQ(values, expected);
+}
+
+TEST_CASE(parallel_sort_of_small_input)
+{
+    Vector<int> values { 3, 1, 2 };
+    Threading::parallel_sort(values.span(), [](int a, int b) { return a < b; });
+    EXPECT_EQ(values, (Vector<int> { 1, 2, 3 }));
+}
+
+TEST_CASE(fork_join_scope_runs_all_tasks)
+{
+    static constexpr size_t task_count = 100;
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> tasks_run { 0 };
+
+    {
+        Threading::ForkJoinScope scope;
+        for (size_t i = 0; i < task_count; ++i)
+            scope.fork([&tasks_run] { tasks_run.fetch_add(1); });
+        scope.join();
+
+        EXPECT_EQ(tasks_run.load(), task_count);
+
+        // A scope can be used again after joining, and joins again when it goes away.
+        scope.fork([&tasks_run] { tasks_run.fetch_add(1); });
+    }
+
+    EXPECT_EQ(tasks_run.load(), task_count + 1);
+}
+
+TEST_CASE(nested_parallel_work)
+{
+    static constexpr size_t outer_count = 32;
+    static constexpr size_t inner_count = 1000;
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> total { 0 };
+
+    // Every worker may end up waiting on nested work here, which only finishes if waiting threads help out.
+    Threading::ForkJoinScope scope;
+    for (size_t i = 0; i < outer_count; ++i) {
+        scope.fork([&total] {
+            auto sum = Threading::parallel_reduce(
+                0, inner_count, 10, size_t { 0 },
+                [](size_t begin, size_t end) { return end - begin; },
+                [](size_t a, size_t b) { return a + b; });
+            total.fetch_add(sum);
+        });
+    }
+    scope.join();
+
+    EXPECT_EQ(total.load(), outer_count * inner_count);
+}
+
+TEST_CASE(fly_strings_can_be_interned_from_any_thread)
+{
+    static constexpr size_t count = 20'000;
+    static constexpr size_t distinct_strings = 100;
+
+    // Every thread interns the same strings, and drops them again, so all threads race on the same table entries.
+    Vector<FlyString> interned;
+    interned.resize(count);
+    Threading::parallel_for(0, count, 50, [&](size_t begin, size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            auto string = MUST(String::formatted("a long enough fly string #{}", i % distinct_strings));
+            interned[i] = FlyString { string };
+            FlyString temporary { MUST(String::formatted("a temporary fly string #{}", i % distinct_strings)) };
+            EXPECT(temporary.bytes_as_string_view().starts_with("a temporary"sv));
+        }
+    });
+
+    for (size_t i = 0; i < count; ++i)
+        EXPECT_EQ(interned[i], interned[i % distinct_strings]);
+    EXPECT_EQ(FlyString::number_of_fly_strings(), distinct_strings);
+
+    interned.clear();
+    EXPECT_EQ(FlyString::number_of_fly_strings(), 0u);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/ThreadPool.h>
+
+static void wait_until(Function<bool()> condition)
+{
+    for (auto i = 0; i < 500; ++i) {
+        if (condition())
+            return;
+
+        (void)Core::System::sleep_ms(10);
+    }
+
+    FAIL("Timed out waiting for tasks to run");
+}
+
+TEST_CASE(runs_all_submitted_tasks)
+{
+    static constexpr size_t task_count = 1000;
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> tasks_run { 0 };
+
+    auto& pool = Threading::ThreadPool::the();
+    EXPECT(pool.worker_count() >= 1);
+
+    for (size_t i = 0; i < task_count; ++i) {
+        auto priority = static_cast<Threading::TaskPriority>(i % 3);
+        pool.submit([&tasks_run] { tasks_run.fetch_add(1); }, priority);
+    }
+
+    wait_until([&] { return tasks_run.load() == task_count; });
+    EXPECT_EQ(tasks_run.load(), task_count);
+}
+
+TEST_CASE(runs_tasks_submitted_by_tasks)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> tasks_run { 0 };
+
+    Threading::ThreadPool::the().submit([&tasks_run] {
+        for (size_t i = 0; i < 10; ++i)
+            Threading::ThreadPool::the().submit([&tasks_run] { tasks_run.fetch_add(1); });
+    });
+
+    wait_until([&] { return tasks_run.load() == 10; });
+    EXPECT_EQ(tasks_run.load(), 10u);
+}
+
+TEST_CASE(can_be_used_again_after_shutting_down)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> task_ran { false };
+
+    Threading::ThreadPool::shut_down();
+    Threading::ThreadPool::the().submit([&task_ran] { task_ran.store(true); });
+
+    wait_until([&] { return task_ran.load(); });
+    EXPECT(task_ran.load());
+}
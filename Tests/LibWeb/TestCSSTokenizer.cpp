@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWeb/CSS/Parser/Tokenizer.h>
+
+namespace Web::CSS::Parser {
+
+TEST_CASE(long_ident_with_escapes_and_non_ascii)
+{
+    auto tokens = Tokenizer::tokenize("a-very-long-identifier-name\\41 bc-ünïcode-and-more-ascii "sv, "utf-8"sv);
+    EXPECT_EQ(tokens.size(), 3u);
+    EXPECT(tokens[0].is(Token::Type::Ident));
+    EXPECT_EQ(tokens[0].ident(), "a-very-long-identifier-nameAbc-ünïcode-and-more-ascii"sv);
+    EXPECT(tokens[1].is(Token::Type::Whitespace));
+    EXPECT(tokens[2].is(Token::Type::EndOfFile));
+}
+
+TEST_CASE(long_string_with_escapes)
+{
+    auto tokens = Tokenizer::tokenize("\"a string that is longer than sixteen bytes, with 'quotes' and \\\"escapes\\\"\""sv, "utf-8"sv);
+    EXPECT_EQ(tokens.size(), 2u);
+    EXPECT(tokens[0].is(Token::Type::String));
+    EXPECT_EQ(tokens[0].string(), "a string that is longer than sixteen bytes, with 'quotes' and \"escapes\""sv);
+
+    tokens = Tokenizer::tokenize("'a string that ends with a newline before its closing quote\n'"sv, "utf-8"sv);
+    EXPECT(tokens[0].is(Token::Type::BadString));
+}
+
+TEST_CASE(positions_after_comments_and_whitespace)
+{
+    auto tokens = Tokenizer::tokenize("/* a comment that spans\nmore than one line ** */\n\n    \n  foo"sv, "utf-8"sv);
+    EXPECT_EQ(tokens.size(), 3u);
+    EXPECT(tokens[0].is(Token::Type::Whitespace));
+    EXPECT(tokens[1].is(Token::Type::Ident));
+    EXPECT_EQ(tokens[1].ident(), "foo"sv);
+    EXPECT_EQ(tokens[1].start_position().line, 4u);
+    EXPECT_EQ(tokens[1].start_position().column, 2u);
+    EXPECT_EQ(tokens[1].end_position().column, 5u);
+}
+
+}
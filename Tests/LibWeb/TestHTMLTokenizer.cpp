@@ -128,6 +128,20 @@ TEST_CASE(basic_with_text)
     END_ENUMERATION();
 }
 
+TEST_CASE(text_with_newlines_and_null_characters)
+{
+    auto tokens = run_tokenizer("<p>Some text\r\nwith a &amp; and a \0 in it</p>"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p, 1u, 2u);
+    for (auto c : "Some text\nwith a & and a \0 in it"sv) {
+        EXPECT_CHARACTER_TOKEN(c);
+    }
+    EXPECT_EQ(current_token->start_position().line, 1u);
+    EXPECT_END_TAG_TOKEN(p, 28u, 29u);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
 TEST_CASE(unquoted_attributes)
 {
     auto tokens = run_tokenizer("<p foo=bar>"sv);
@@ -161,6 +175,17 @@ TEST_CASE(double_quoted_attributes)
     END_ENUMERATION();
 }
 
+TEST_CASE(long_quoted_attribute_values)
+{
+    auto tokens = run_tokenizer("<p foo=\"a long attribute value\">"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p, 1u, 31u);
+    EXPECT_TAG_TOKEN_ATTRIBUTE_COUNT(1);
+    EXPECT_TAG_TOKEN_ATTRIBUTE(foo, "a long attribute value", 3u, 6u, 7u, 31u);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
 TEST_CASE(valueless_attribute)
 {
     auto tokens = run_tokenizer("<p foo>"sv);
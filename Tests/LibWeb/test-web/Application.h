@@ -39,6 +39,7 @@ public:
     bool dump_gc_graph { false };
 
     bool test_dry_run { false };
+    bool run_benchmarks { false };
     bool rebaseline { false };
     bool shuffle { false };
 
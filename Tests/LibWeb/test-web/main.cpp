@@ -152,6 +152,24 @@ static ErrorOr<void> collect_crash_tests(Application const& app, Vector<Test>& t
     return {};
 }
 
+static ErrorOr<void> collect_benchmarks(Application const& app, Vector<Test>& tests, StringView path)
+{
+    Core::DirIterator it(path, Core::DirIterator::Flags::SkipDots);
+    while (it.has_next()) {
+        auto name = it.next_path();
+        if (!is_valid_test_name(name))
+            continue;
+
+        auto input_path = TRY(FileSystem::real_path(ByteString::formatted("{}/{}", path, name)));
+        auto relative_path = LexicalPath::relative_path(input_path, app.test_root_path).release_value();
+
+        // Benchmarks have no expectation, so their output (the timings) is printed instead of being compared.
+        tests.append({ TestMode::Text, input_path, {}, move(relative_path) });
+    }
+
+    return {};
+}
+
 static void clear_test_callbacks(TestWebView& view)
 {
     view.on_load_finish = {};
@@ -591,11 +609,15 @@ static ErrorOr<int> run_tests(Core::AnonymousBuffer const& theme, Web::DevicePix
     if (app.test_globs.is_empty())
         app.test_globs.append("*"sv);
 
-    TRY(collect_dump_tests(app, tests, ByteString::formatted("{}/Layout", app.test_root_path), "."sv, TestMode::Layout));
-    TRY(collect_dump_tests(app, tests, ByteString::formatted("{}/Text", app.test_root_path), "."sv, TestMode::Text));
-    TRY(collect_ref_tests(app, tests, ByteString::formatted("{}/Ref", app.test_root_path), "."sv));
-    TRY(collect_crash_tests(app, tests, ByteString::formatted("{}/Crash", app.test_root_path), "."sv));
-    TRY(collect_ref_tests(app, tests, ByteString::formatted("{}/Screenshot", app.test_root_path), "."sv));
+    if (app.run_benchmarks) {
+        TRY(collect_benchmarks(app, tests, ByteString::formatted("{}/Benchmarks", app.test_root_path)));
+    } else {
+        TRY(collect_dump_tests(app, tests, ByteString::formatted("{}/Layout", app.test_root_path), "."sv, TestMode::Layout));
+        TRY(collect_dump_tests(app, tests, ByteString::formatted("{}/Text", app.test_root_path), "."sv, TestMode::Text));
+        TRY(collect_ref_tests(app, tests, ByteString::formatted("{}/Ref", app.test_root_path), "."sv));
+        TRY(collect_crash_tests(app, tests, ByteString::formatted("{}/Crash", app.test_root_path), "."sv));
+        TRY(collect_ref_tests(app, tests, ByteString::formatted("{}/Screenshot", app.test_root_path), "."sv));
+    }
 
     tests.remove_all_matching([&](auto const& test) {
         static constexpr Array support_file_patterns {
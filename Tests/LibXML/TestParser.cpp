@@ -45,3 +45,62 @@ TEST_CASE(unicode_name)
     XML::Parser parser("<div 中文=\"\"></div>"sv);
     TRY_OR_FAIL(parser.parse());
 }
+
+struct RecordingListener final : public XML::Listener {
+    virtual void element_start(XML::Name const& name, OrderedHashMap<XML::Name, ByteString> const& attributes) override
+    {
+        StringBuilder builder;
+        builder.appendff("<{}", name);
+        for (auto const& [attribute_name, value] : attributes)
+            builder.appendff(" {}=\"{}\"", attribute_name, value);
+        builder.append('>');
+        events.append(builder.to_byte_string());
+    }
+    virtual void element_end(XML::Name const& name) override { events.append(ByteString::formatted("</{}>", name)); }
+    virtual void text(StringView text) override
+    {
+        // Adjacent text is merged, as the boundaries between text events depend on where the source was split up.
+        if (!events.is_empty() && events.last().starts_with("text:"sv))
+            events.last() = ByteString::formatted("{}{}", events.last(), text);
+        else
+            events.append(ByteString::formatted("text:{}", text));
+    }
+    virtual void comment(StringView text) override { events.append(ByteString::formatted("<!--{}-->", text)); }
+    virtual void processing_instruction(StringView target, StringView data) override { events.append(ByteString::formatted("<?{} {}?>", target, data)); }
+    virtual void document_end() override { events.append("end"); }
+
+    Vector<ByteString> events;
+};
+
+TEST_CASE(streaming_parser)
+{
+    constexpr auto source = "<?xml version=\"1.0\"?><!-- comment --><svg xmlns=\"http://www.w3.org/2000/svg\"><g id=\"a\">some &amp; text<rect width=\"10\"/></g><?pi data?><g id=\"b\"><circle r=\"5\"/></g></svg>"sv;
+
+    RecordingListener expected_listener;
+    XML::Parser parser(source, { .preserve_comments = true });
+    TRY_OR_FAIL(parser.parse_with_listener(expected_listener));
+
+    for (size_t chunk_size : { 1uz, 3uz, 7uz, 64uz, source.length() }) {
+        RecordingListener listener;
+        XML::StreamingParser streaming_parser(listener, { .preserve_comments = true });
+
+        for (size_t offset = 0; offset < source.length(); offset += chunk_size)
+            streaming_parser.append(source.substring_view(offset, min(chunk_size, source.length() - offset)));
+        TRY_OR_FAIL(streaming_parser.finish());
+
+        EXPECT_EQ(listener.events, expected_listener.events);
+    }
+}
+
+TEST_CASE(streaming_parser_delivers_complete_parts_early)
+{
+    RecordingListener listener;
+    XML::StreamingParser streaming_parser(listener);
+
+    streaming_parser.append("<svg><g><rect/>tex"sv);
+    EXPECT_EQ(listener.events, (Vector<ByteString> { "<svg>", "<g>", "<rect>" }));
+
+    streaming_parser.append("t</g></svg>"sv);
+    TRY_OR_FAIL(streaming_parser.finish());
+    EXPECT_EQ(listener.events, (Vector<ByteString> { "<svg>", "<g>", "<rect>", "</rect>", "text:text", "</g>", "</svg>", "end" }));
+}
@@ -199,9 +199,9 @@ void ALooperEventLoopImplementation::wake()
 
 void ALooperEventLoopImplementation::post_event(Core::EventReceiver& receiver, NonnullOwnPtr<Core::Event>&& event)
 {
-    m_thread_event_queue.post_event(receiver, move(event));
+    auto should_wake = m_thread_event_queue.post_event(receiver, move(event));
 
-    if (&m_thread_event_queue != &Core::ThreadEventQueue::current())
+    if (should_wake == Core::ThreadEventQueue::ShouldWake::Yes && &m_thread_event_queue != &Core::ThreadEventQueue::current())
         wake();
 }
 
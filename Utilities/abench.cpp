@@ -4,63 +4,329 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
 #include <AK/NumericLimits.h>
+#include <AK/QuickSort.h>
 #include <AK/Types.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/DirIterator.h>
 #include <LibCore/ElapsedTimer.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/Timer.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibMain/Main.h>
 #include <LibMedia/Audio/Loader.h>
+#include <LibMedia/PlaybackManager.h>
 #include <stdio.h>
+#include <sys/resource.h>
 
 // The Kernel has problems with large anonymous buffers, so let's limit sample reads ourselves.
 static constexpr size_t MAX_CHUNK_SIZE = 1 * MiB / 2;
 
-ErrorOr<int> ladybird_main(Main::Arguments arguments)
+// The CPU time used by all threads of the process so far, which includes the decoding threads of the PlaybackManager.
+static AK::Duration process_cpu_time()
 {
-    StringView path {};
-    int sample_count = -1;
+    rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) < 0)
+        return {};
+    return AK::Duration::from_timeval(usage.ru_utime) + AK::Duration::from_timeval(usage.ru_stime);
+}
 
-    Core::ArgsParser args_parser;
-    args_parser.set_general_help("Benchmark audio loading");
-    args_parser.add_positional_argument(path, "Path to audio file", "path");
-    args_parser.add_option(sample_count, "How many samples to load at maximum", "sample-count", 's', "samples");
-    args_parser.parse(arguments);
+// The high-water mark of the whole process so far, so it never goes down from one file to the next.
+static u64 peak_resident_set_size_in_bytes()
+{
+    rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) < 0)
+        return 0;
+#if defined(AK_OS_MACOS)
+    return usage.ru_maxrss;
+#else
+    return static_cast<u64>(usage.ru_maxrss) * KiB;
+#endif
+}
 
-    auto maybe_loader = Audio::Loader::create(path);
-    if (maybe_loader.is_error()) {
-        warnln("Failed to load audio file: {}", maybe_loader.error());
-        return 1;
+static double cpu_usage_percentage(AK::Duration cpu_time, AK::Duration wall_time)
+{
+    auto wall_seconds = wall_time.to_seconds_f64();
+    return wall_seconds > 0 ? cpu_time.to_seconds_f64() / wall_seconds * 100 : 0.0;
+}
+
+static ErrorOr<Vector<ByteString>> collect_corpus(Vector<StringView> const& paths)
+{
+    Vector<ByteString> corpus;
+    for (auto path : paths) {
+        if (!FileSystem::is_directory(path)) {
+            TRY(corpus.try_append(ByteString { path }));
+            continue;
+        }
+
+        Vector<ByteString> directory_files;
+        Core::DirIterator iterator(path, Core::DirIterator::SkipDots);
+        while (iterator.has_next())
+            TRY(directory_files.try_append(iterator.next_full_path()));
+        if (iterator.has_error())
+            return iterator.error();
+
+        quick_sort(directory_files);
+        TRY(corpus.try_extend(move(directory_files)));
     }
+    return corpus;
+}
+
+static ErrorOr<Optional<JsonObject>> benchmark_audio(StringView path, int sample_count)
+{
+    auto maybe_loader = Audio::Loader::create(path);
+    if (maybe_loader.is_error())
+        return OptionalNone {};
     auto loader = maybe_loader.release_value();
 
+    auto cpu_time_before = process_cpu_time();
     Core::ElapsedTimer sample_timer { Core::TimerType::Precise };
-    i64 total_loader_time = 0;
+    AK::Duration total_loader_time;
     int remaining_samples = sample_count > 0 ? sample_count : NumericLimits<int>::max();
-    unsigned total_loaded_samples = 0;
-
-    for (;;) {
-        if (remaining_samples > 0) {
-            sample_timer = sample_timer.start_new();
-            auto samples = loader->get_more_samples(min(MAX_CHUNK_SIZE, remaining_samples));
-            total_loader_time += sample_timer.elapsed_milliseconds();
-            if (!samples.is_error()) {
-                remaining_samples -= samples.value().size();
-                total_loaded_samples += samples.value().size();
-                if (samples.value().size() == 0)
-                    break;
-            } else {
-                warnln("Error while loading audio: {}", samples.error());
-                return 1;
-            }
-        } else
+    u64 total_loaded_samples = 0;
+
+    while (remaining_samples > 0) {
+        sample_timer = sample_timer.start_new();
+        auto samples = loader->get_more_samples(min(MAX_CHUNK_SIZE, remaining_samples));
+        total_loader_time += sample_timer.elapsed_time();
+        if (samples.is_error()) {
+            warnln("Error while loading audio from {}: {}", path, samples.error());
+            return OptionalNone {};
+        }
+        if (samples.value().size() == 0)
+            break;
+        remaining_samples -= samples.value().size();
+        total_loaded_samples += samples.value().size();
+    }
+    auto cpu_time = process_cpu_time() - cpu_time_before;
+
+    auto decode_seconds = total_loader_time.to_seconds_f64();
+    auto media_seconds = static_cast<double>(total_loaded_samples) / static_cast<double>(loader->sample_rate());
+    auto realtime_factor = decode_seconds > 0 ? media_seconds / decode_seconds : 0.0;
+
+    outln("    Audio ({}, {} Hz, {} channels): {} samples in {:.3} s, {:.1}x realtime, {:.1}% CPU",
+        loader->format_name(), loader->sample_rate(), loader->num_channels(), total_loaded_samples, decode_seconds, realtime_factor, cpu_usage_percentage(cpu_time, total_loader_time));
+
+    JsonObject result;
+    result.set("format"sv, loader->format_name());
+    result.set("sample_rate"sv, loader->sample_rate());
+    result.set("channels"sv, loader->num_channels());
+    result.set("samples"sv, total_loaded_samples);
+    result.set("decode_time_ms"sv, total_loader_time.to_milliseconds());
+    result.set("realtime_factor"sv, realtime_factor);
+    result.set("cpu_percentage"sv, cpu_usage_percentage(cpu_time, total_loader_time));
+    return result;
+}
+
+enum class PlaybackSpeed {
+    Unthrottled,
+    Realtime,
+};
+
+struct PlaybackResult {
+    u64 width { 0 };
+    u64 height { 0 };
+    u64 frames { 0 };
+    u64 dropped_frames { 0 };
+    AK::Duration media_time;
+    AK::Duration wall_time;
+    AK::Duration cpu_time;
+};
+
+// Plays the video track of the data through the same pipeline as media elements do, which decodes on a thread of its
+// own and converts frames for display, without actually displaying them.
+static Optional<PlaybackResult> play_video(Core::EventLoop& event_loop, ReadonlyBytes data, PlaybackSpeed speed, Media::HardwareAcceleration hardware_acceleration, Optional<AK::Duration> time_limit)
+{
+    auto playback_manager_or_error = Media::PlaybackManager::from_data(data, hardware_acceleration);
+    if (playback_manager_or_error.is_error())
+        return {};
+    auto playback_manager = playback_manager_or_error.release_value();
+    playback_manager->set_unthrottled_presentation(speed == PlaybackSpeed::Unthrottled);
+
+    PlaybackResult result;
+    auto const& video_data = playback_manager->selected_video_track().video_data();
+    result.width = video_data.pixel_width;
+    result.height = video_data.pixel_height;
+
+    bool has_started = false;
+    bool has_failed = false;
+    MonotonicTime start_time = MonotonicTime::now();
+    AK::Duration cpu_time_at_start;
+
+    RefPtr<Core::Timer> time_limit_timer;
+    if (time_limit.has_value()) {
+        time_limit_timer = Core::Timer::create_single_shot(static_cast<int>(time_limit->to_milliseconds()), [&] {
+            event_loop.quit(0);
+        });
+    }
+
+    auto start_timer = Core::Timer::create_single_shot(0, [&] {
+        start_time = MonotonicTime::now();
+        cpu_time_at_start = process_cpu_time();
+        if (time_limit_timer)
+            time_limit_timer->start();
+        playback_manager->resume_playback();
+    });
+
+    playback_manager->on_video_frame = [&](auto) {
+        ++result.frames;
+    };
+    playback_manager->on_playback_state_change = [&] {
+        switch (playback_manager->get_state()) {
+        case Media::PlaybackState::Paused:
+            // The PlaybackManager starts out by seeking to the start, and pauses once it has buffered the first frames.
+            if (has_started)
+                break;
+            has_started = true;
+            start_timer->start();
             break;
+        case Media::PlaybackState::Stopped:
+            event_loop.quit(0);
+            break;
+        default:
+            break;
+        }
+    };
+    playback_manager->on_decoder_error = [&](Media::DecoderError error) {
+        warnln("Error while playing video: {}", error);
+        has_failed = true;
+        event_loop.quit(0);
+    };
+    playback_manager->on_fatal_playback_error = [&](Error error) {
+        warnln("Error while playing video: {}", error);
+        has_failed = true;
+        event_loop.quit(0);
+    };
+
+    event_loop.exec();
+    if (time_limit_timer)
+        time_limit_timer->stop();
+
+    if (has_failed || !has_started)
+        return {};
+
+    result.wall_time = MonotonicTime::now() - start_time;
+    result.cpu_time = process_cpu_time() - cpu_time_at_start;
+    result.dropped_frames = playback_manager->number_of_skipped_frames();
+    result.media_time = playback_manager->current_playback_time();
+    return result;
+}
+
+static JsonObject playback_result_to_json(PlaybackResult const& result)
+{
+    auto wall_seconds = result.wall_time.to_seconds_f64();
+
+    JsonObject object;
+    object.set("frames"sv, result.frames);
+    object.set("dropped_frames"sv, result.dropped_frames);
+    object.set("media_time_ms"sv, result.media_time.to_milliseconds());
+    object.set("wall_time_ms"sv, result.wall_time.to_milliseconds());
+    object.set("frames_per_second"sv, wall_seconds > 0 ? static_cast<double>(result.frames) / wall_seconds : 0.0);
+    object.set("realtime_factor"sv, wall_seconds > 0 ? result.media_time.to_seconds_f64() / wall_seconds : 0.0);
+    object.set("cpu_percentage"sv, cpu_usage_percentage(result.cpu_time, result.wall_time));
+    return object;
+}
+
+static Optional<JsonObject> benchmark_video(Core::EventLoop& event_loop, ReadonlyBytes data, Media::HardwareAcceleration hardware_acceleration, AK::Duration realtime_duration)
+{
+    auto unthrottled = play_video(event_loop, data, PlaybackSpeed::Unthrottled, hardware_acceleration, {});
+    if (!unthrottled.has_value())
+        return {};
+
+    auto wall_seconds = unthrottled->wall_time.to_seconds_f64();
+    outln("    Video ({}x{}): {} frames in {:.3} s at maximum speed, {:.1} frames/s, {:.1}x realtime, {:.1}% CPU",
+        unthrottled->width, unthrottled->height, unthrottled->frames, wall_seconds,
+        wall_seconds > 0 ? static_cast<double>(unthrottled->frames) / wall_seconds : 0.0,
+        wall_seconds > 0 ? unthrottled->media_time.to_seconds_f64() / wall_seconds : 0.0,
+        cpu_usage_percentage(unthrottled->cpu_time, unthrottled->wall_time));
+
+    JsonObject result;
+    result.set("width"sv, unthrottled->width);
+    result.set("height"sv, unthrottled->height);
+    result.set("unthrottled"sv, playback_result_to_json(*unthrottled));
+
+    if (realtime_duration > AK::Duration::zero()) {
+        auto realtime = play_video(event_loop, data, PlaybackSpeed::Realtime, hardware_acceleration, realtime_duration);
+        if (realtime.has_value()) {
+            outln("    Video at 1x: {} frames in {:.3} s, {} dropped, {:.1}% CPU",
+                realtime->frames, realtime->wall_time.to_seconds_f64(), realtime->dropped_frames, cpu_usage_percentage(realtime->cpu_time, realtime->wall_time));
+            result.set("realtime"sv, playback_result_to_json(*realtime));
+        }
     }
 
-    auto time_per_sample = static_cast<double>(total_loader_time) / static_cast<double>(total_loaded_samples) * 1000.;
-    auto playback_time_per_sample = (1. / static_cast<double>(loader->sample_rate())) * 1000'000.;
+    return result;
+}
 
-    outln("Loaded {:10d} samples in {:06.3f} s, {:9.3f} µs/sample, {:6.1f}% speed (realtime {:9.3f} µs/sample)", total_loaded_samples, static_cast<double>(total_loader_time) / 1000., time_per_sample, playback_time_per_sample / time_per_sample * 100., playback_time_per_sample);
+ErrorOr<int> ladybird_main(Main::Arguments arguments)
+{
+    Vector<StringView> paths;
+    int sample_count = -1;
+    bool hardware_decoding = false;
+    double realtime_seconds = 10;
+    StringView output_path;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Benchmark decoding and playing audio and video files");
+    args_parser.add_positional_argument(paths, "Paths to media files, or directories of them", "paths");
+    args_parser.add_option(sample_count, "How many audio samples to load at maximum", "sample-count", 's', "samples");
+    args_parser.add_option(hardware_decoding, "Decode video in hardware where the platform supports it", "hardware-decoding", {});
+    args_parser.add_option(realtime_seconds, "How long to play videos at normal speed to count dropped frames, or 0 to skip it (default: 10)", "realtime-duration", 'r', "seconds");
+    args_parser.add_option(output_path, "Path to write the results to as JSON", "output", 'o', "FILE");
+    args_parser.parse(arguments);
+
+    auto corpus = TRY(collect_corpus(paths));
+    auto hardware_acceleration = hardware_decoding ? Media::HardwareAcceleration::Preferred : Media::HardwareAcceleration::Disabled;
+    auto realtime_duration = AK::Duration::from_milliseconds(static_cast<i64>(max(realtime_seconds, 0.0) * 1000));
+
+    Core::EventLoop event_loop;
+    JsonArray files;
+    bool has_failed = false;
+
+    for (auto const& path : corpus) {
+        outln("{}:", path);
+
+        JsonObject file_result;
+        file_result.set("path"sv, path);
+
+        auto audio = TRY(benchmark_audio(path, sample_count));
+        if (audio.has_value())
+            file_result.set("audio"sv, *audio);
+
+        auto mapped_file_or_error = Core::MappedFile::map(path);
+        if (mapped_file_or_error.is_error()) {
+            warnln("Failed to map {}: {}", path, mapped_file_or_error.error());
+            has_failed = true;
+            continue;
+        }
+        auto video = benchmark_video(event_loop, mapped_file_or_error.value()->bytes(), hardware_acceleration, realtime_duration);
+        if (video.has_value())
+            file_result.set("video"sv, *video);
+
+        if (!audio.has_value() && !video.has_value()) {
+            warnln("    No audio or video could be decoded");
+            has_failed = true;
+        }
+
+        auto peak_memory = peak_resident_set_size_in_bytes();
+        outln("    Peak memory: {} MiB", peak_memory / MiB);
+        file_result.set("peak_rss_bytes"sv, peak_memory);
+
+        TRY(files.append(move(file_result)));
+    }
+
+    if (!output_path.is_empty()) {
+        JsonObject report;
+        report.set("hardware_decoding"sv, hardware_decoding);
+        report.set("timestamp_ms"sv, UnixDateTime::now().milliseconds_since_epoch());
+        report.set("files"sv, move(files));
+
+        auto file = TRY(Core::File::open(output_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted(ByteString::formatted("{}\n", report.serialized())));
+    }
 
-    return 0;
+    return has_failed ? 1 : 0;
 }
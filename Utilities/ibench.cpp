@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/HashMap.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/MimeData.h>
+#include <LibGfx/ImageFormats/ImageDecoder.h>
+#include <LibMain/Main.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+#include <sys/resource.h>
+
+struct CorpusFile {
+    ByteString path;
+    ByteString format;
+    NonnullOwnPtr<Core::MappedFile> file;
+};
+
+struct FormatResult {
+    u64 files { 0 };
+    u64 failures { 0 };
+    u64 frames { 0 };
+    u64 pixels { 0 };
+    AK::Duration decode_time;
+    AK::Duration total_time_to_first_frame;
+    AK::Duration max_time_to_first_frame;
+};
+
+static ByteString format_for_file(StringView path, ReadonlyBytes bytes)
+{
+    if (auto mime_type = Core::guess_mime_type_based_on_sniffed_bytes(bytes); mime_type.has_value())
+        return *mime_type;
+    return Core::guess_mime_type_based_on_filename(path);
+}
+
+static ErrorOr<Vector<CorpusFile>> load_corpus(StringView directory)
+{
+    Vector<CorpusFile> corpus;
+    Core::DirIterator iterator(directory, Core::DirIterator::SkipDots);
+    while (iterator.has_next()) {
+        auto path = iterator.next_full_path();
+        auto file_or_error = Core::MappedFile::map(path);
+        if (file_or_error.is_error()) {
+            warnln("Skipping {}: {}", path, file_or_error.error());
+            continue;
+        }
+        auto file = file_or_error.release_value();
+        auto format = format_for_file(path, file->bytes());
+        TRY(corpus.try_append({ move(path), move(format), move(file) }));
+    }
+    if (iterator.has_error())
+        return iterator.error();
+
+    quick_sort(corpus, [](auto const& a, auto const& b) { return a.path < b.path; });
+    return corpus;
+}
+
+static ErrorOr<Optional<Gfx::IntSize>> parse_ideal_size(StringView string)
+{
+    if (string == "natural"sv)
+        return OptionalNone {};
+
+    auto parts = string.split_view('x');
+    if (parts.size() != 2)
+        return Error::from_string_literal("Ideal sizes must look like WIDTHxHEIGHT or be 'natural'");
+    auto width = parts[0].to_number<int>();
+    auto height = parts[1].to_number<int>();
+    if (!width.has_value() || !height.has_value() || *width <= 0 || *height <= 0)
+        return Error::from_string_literal("Ideal sizes must be positive");
+    return Gfx::IntSize { *width, *height };
+}
+
+// The high-water mark of the whole process so far, so it never goes down from one run to the next.
+static u64 peak_resident_set_size_in_bytes()
+{
+    rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) < 0)
+        return 0;
+#if defined(AK_OS_MACOS)
+    return usage.ru_maxrss;
+#else
+    return static_cast<u64>(usage.ru_maxrss) * KiB;
+#endif
+}
+
+static void decode_file(CorpusFile const& corpus_file, Optional<Gfx::IntSize> ideal_size, FormatResult& result)
+{
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    ++result.files;
+
+    auto decoder_or_error = Gfx::ImageDecoder::try_create_for_raw_bytes(corpus_file.file->bytes());
+    if (decoder_or_error.is_error() || !decoder_or_error.value()) {
+        ++result.failures;
+        return;
+    }
+    auto decoder = decoder_or_error.release_value();
+
+    for (size_t index = 0; index < decoder->frame_count(); ++index) {
+        auto frame_or_error = decoder->frame(index, ideal_size);
+        if (frame_or_error.is_error()) {
+            ++result.failures;
+            break;
+        }
+        if (index == 0) {
+            auto time_to_first_frame = timer.elapsed_time();
+            result.total_time_to_first_frame += time_to_first_frame;
+            result.max_time_to_first_frame = max(result.max_time_to_first_frame, time_to_first_frame);
+        }
+        auto const& bitmap = frame_or_error.value().image;
+        ++result.frames;
+        result.pixels += static_cast<u64>(bitmap->width()) * bitmap->height();
+    }
+
+    result.decode_time += timer.elapsed_time();
+}
+
+static HashMap<ByteString, FormatResult> run(Vector<CorpusFile> const& corpus, Optional<Gfx::IntSize> ideal_size, size_t thread_count, size_t iterations, AK::Duration& wall_time)
+{
+    HashMap<ByteString, FormatResult> results;
+    Threading::Mutex results_mutex;
+    Atomic<size_t> next_job = 0;
+    auto job_count = corpus.size() * iterations;
+
+    auto work = [&]() -> intptr_t {
+        HashMap<ByteString, FormatResult> thread_results;
+        for (auto job = next_job++; job < job_count; job = next_job++) {
+            auto const& corpus_file = corpus[job % corpus.size()];
+            decode_file(corpus_file, ideal_size, thread_results.ensure(corpus_file.format));
+        }
+
+        Threading::MutexLocker locker(results_mutex);
+        for (auto const& [format, thread_result] : thread_results) {
+            auto& result = results.ensure(format);
+            result.files += thread_result.files;
+            result.failures += thread_result.failures;
+            result.frames += thread_result.frames;
+            result.pixels += thread_result.pixels;
+            result.decode_time += thread_result.decode_time;
+            result.total_time_to_first_frame += thread_result.total_time_to_first_frame;
+            result.max_time_to_first_frame = max(result.max_time_to_first_frame, thread_result.max_time_to_first_frame);
+        }
+        return 0;
+    };
+
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    if (thread_count <= 1) {
+        work();
+    } else {
+        Vector<NonnullRefPtr<Threading::Thread>> threads;
+        for (size_t i = 0; i < thread_count; ++i) {
+            threads.append(Threading::Thread::construct(work, "ibench"sv));
+            threads.last()->start();
+        }
+        for (auto& thread : threads)
+            (void)thread->join();
+    }
+    wall_time = timer.elapsed_time();
+
+    return results;
+}
+
+static JsonObject result_to_json(FormatResult const& result)
+{
+    auto decode_seconds = static_cast<double>(result.decode_time.to_microseconds()) / 1'000'000;
+    auto decoded_files = result.files - result.failures;
+
+    JsonObject object;
+    object.set("files"sv, result.files);
+    object.set("failures"sv, result.failures);
+    object.set("frames"sv, result.frames);
+    object.set("megapixels"sv, static_cast<double>(result.pixels) / 1'000'000);
+    object.set("decode_time_ms"sv, result.decode_time.to_milliseconds());
+    object.set("megapixels_per_second"sv, decode_seconds > 0 ? static_cast<double>(result.pixels) / 1'000'000 / decode_seconds : 0.0);
+    object.set("mean_time_to_first_frame_us"sv, decoded_files > 0 ? result.total_time_to_first_frame.to_microseconds() / static_cast<i64>(decoded_files) : 0);
+    object.set("max_time_to_first_frame_us"sv, result.max_time_to_first_frame.to_microseconds());
+    return object;
+}
+
+ErrorOr<int> ladybird_main(Main::Arguments arguments)
+{
+    StringView corpus_path;
+    Vector<ByteString> ideal_size_strings;
+    Vector<size_t> thread_counts;
+    size_t iterations = 1;
+    StringView output_path;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Benchmark image decoding over a directory of images, and report the results per format as JSON.");
+    args_parser.add_positional_argument(corpus_path, "Directory of images to decode", "DIRECTORY");
+    args_parser.add_option(ideal_size_strings, "Size to decode at, as WIDTHxHEIGHT or 'natural' (may be repeated, default: natural)", "ideal-size", 's', "SIZE");
+    args_parser.add_option(thread_counts, "Comma-separated numbers of decoding threads to run with (default: 1)", "threads", 't', "COUNTS");
+    args_parser.add_option(iterations, "How many times to decode every image per run (default: 1)", "iterations", 'n', "COUNT");
+    args_parser.add_option(output_path, "Path to write the JSON results to (default: standard output)", "output", 'o', "FILE");
+    args_parser.parse(arguments);
+
+    Vector<Optional<Gfx::IntSize>> ideal_sizes;
+    for (auto const& string : ideal_size_strings)
+        ideal_sizes.append(TRY(parse_ideal_size(string)));
+    if (ideal_sizes.is_empty())
+        ideal_sizes.append(OptionalNone {});
+    if (thread_counts.is_empty())
+        thread_counts.append(1);
+    iterations = max(iterations, 1uz);
+
+    auto corpus = TRY(load_corpus(corpus_path));
+    if (corpus.is_empty())
+        return Error::from_string_literal("The corpus directory does not contain any files");
+
+    JsonArray runs;
+    for (auto const& ideal_size : ideal_sizes) {
+        for (auto thread_count : thread_counts) {
+            AK::Duration wall_time;
+            auto results = run(corpus, ideal_size, thread_count, iterations, wall_time);
+
+            JsonObject formats;
+            u64 total_pixels = 0;
+            for (auto const& [format, result] : results) {
+                formats.set(format, result_to_json(result));
+                total_pixels += result.pixels;
+            }
+
+            auto wall_seconds = static_cast<double>(wall_time.to_microseconds()) / 1'000'000;
+
+            JsonObject run_object;
+            run_object.set("ideal_size"sv, ideal_size.has_value() ? ByteString::formatted("{}x{}", ideal_size->width(), ideal_size->height()) : ByteString { "natural"sv });
+            run_object.set("threads"sv, thread_count);
+            run_object.set("iterations"sv, iterations);
+            run_object.set("wall_time_ms"sv, wall_time.to_milliseconds());
+            run_object.set("megapixels_per_second"sv, wall_seconds > 0 ? static_cast<double>(total_pixels) / 1'000'000 / wall_seconds : 0.0);
+            run_object.set("peak_rss_bytes"sv, peak_resident_set_size_in_bytes());
+            run_object.set("formats"sv, move(formats));
+            runs.must_append(move(run_object));
+        }
+    }
+
+    JsonObject report;
+    report.set("corpus"sv, LexicalPath::canonicalized_path(ByteString { corpus_path }));
+    report.set("file_count"sv, corpus.size());
+    report.set("timestamp_ms"sv, UnixDateTime::now().milliseconds_since_epoch());
+    report.set("runs"sv, move(runs));
+
+    auto serialized = report.serialized();
+    if (output_path.is_empty()) {
+        outln("{}", serialized);
+    } else {
+        auto file = TRY(Core::File::open(output_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted(ByteString::formatted("{}\n", serialized)));
+    }
+    return 0;
+}
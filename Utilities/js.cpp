@@ -7,9 +7,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
+#include <AK/Math.h>
 #include <AK/NeverDestroyed.h>
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/ConfigFile.h>
@@ -810,6 +815,177 @@ static ErrorOr<int> run_repl(bool gc_on_every_allocation, bool syntax_highlight)
 
 #endif
 
+struct BenchmarkRun {
+    AK::Duration time;
+    size_t garbage_collections { 0 };
+    AK::Duration garbage_collection_pause_time;
+    JS::Bytecode::Statistics bytecode_statistics;
+};
+
+// Runs the source once in a realm of its own, so that no run sees the state that the ones before it left behind.
+static ErrorOr<Optional<BenchmarkRun>> run_benchmark_once(StringView source, StringView source_name, bool use_test262_global)
+{
+    OwnPtr<JS::ExecutionContext> root_execution_context;
+    if (use_test262_global)
+        root_execution_context = JS::create_simple_execution_context<JS::Test262::GlobalObject>(*g_vm);
+    else
+        root_execution_context = JS::create_simple_execution_context<ScriptObject>(*g_vm);
+
+    auto& realm = *root_execution_context->realm;
+    auto& console_object = *realm.intrinsics().console_object();
+    auto console_client = g_vm->heap().allocate<ReplConsoleClient>(console_object.console());
+    console_object.console().set_client(console_client);
+
+    auto& heap = g_vm->heap();
+    auto collection_statistics_before = heap.collection_statistics();
+    auto bytecode_statistics_before = JS::Bytecode::g_statistics;
+    auto start_time = MonotonicTime::now();
+
+    auto did_succeed = TRY(parse_and_run(realm, source, source_name));
+
+    auto end_time = MonotonicTime::now();
+    auto const& collection_statistics = heap.collection_statistics();
+    auto const& bytecode_statistics = JS::Bytecode::g_statistics;
+
+    g_vm->pop_execution_context();
+    g_last_value = GC::make_root(JS::js_undefined());
+
+    if (!did_succeed)
+        return OptionalNone {};
+
+    BenchmarkRun run;
+    run.time = end_time - start_time;
+    run.garbage_collections = collection_statistics.collection_count - collection_statistics_before.collection_count;
+    run.garbage_collection_pause_time = collection_statistics.total_pause_time - collection_statistics_before.total_pause_time;
+    run.bytecode_statistics.executed_instructions = bytecode_statistics.executed_instructions - bytecode_statistics_before.executed_instructions;
+    run.bytecode_statistics.property_lookup_cache_hits = bytecode_statistics.property_lookup_cache_hits - bytecode_statistics_before.property_lookup_cache_hits;
+    run.bytecode_statistics.megamorphic_property_lookup_cache_hits = bytecode_statistics.megamorphic_property_lookup_cache_hits - bytecode_statistics_before.megamorphic_property_lookup_cache_hits;
+    run.bytecode_statistics.property_lookup_cache_misses = bytecode_statistics.property_lookup_cache_misses - bytecode_statistics_before.property_lookup_cache_misses;
+    return run;
+}
+
+static double duration_in_milliseconds(AK::Duration duration)
+{
+    return static_cast<double>(duration.to_nanoseconds()) / 1'000'000.0;
+}
+
+static ErrorOr<int> run_benchmark(StringView source, StringView source_name, bool use_test262_global, size_t warmup_runs, size_t runs, StringView json_output_path)
+{
+    if (runs == 0) {
+        warnln("The number of benchmark runs must be at least 1");
+        return 1;
+    }
+
+    Vector<BenchmarkRun> measured_runs;
+    TRY(measured_runs.try_ensure_capacity(runs));
+
+    for (size_t i = 0; i < warmup_runs + runs; ++i) {
+        auto run = TRY(run_benchmark_once(source, source_name, use_test262_global));
+        if (!run.has_value())
+            return 1;
+
+        if (i >= warmup_runs)
+            measured_runs.unchecked_append(run.release_value());
+
+        // Start every run with a heap that holds nothing but what is still reachable from the previous ones.
+        g_vm->heap().collect_garbage();
+    }
+
+    Vector<double> times;
+    TRY(times.try_ensure_capacity(runs));
+    double total_garbage_collections = 0;
+    double total_garbage_collection_pause_time = 0;
+    JS::Bytecode::Statistics total_bytecode_statistics;
+
+    for (auto const& run : measured_runs) {
+        times.unchecked_append(duration_in_milliseconds(run.time));
+        total_garbage_collections += run.garbage_collections;
+        total_garbage_collection_pause_time += duration_in_milliseconds(run.garbage_collection_pause_time);
+        total_bytecode_statistics.executed_instructions += run.bytecode_statistics.executed_instructions;
+        total_bytecode_statistics.property_lookup_cache_hits += run.bytecode_statistics.property_lookup_cache_hits;
+        total_bytecode_statistics.megamorphic_property_lookup_cache_hits += run.bytecode_statistics.megamorphic_property_lookup_cache_hits;
+        total_bytecode_statistics.property_lookup_cache_misses += run.bytecode_statistics.property_lookup_cache_misses;
+    }
+
+    double mean = 0;
+    for (auto time : times)
+        mean += time;
+    mean /= runs;
+
+    double variance = 0;
+    for (auto time : times)
+        variance += (time - mean) * (time - mean);
+    auto standard_deviation = runs > 1 ? AK::sqrt(variance / (runs - 1)) : 0.0;
+
+    auto sorted_times = times;
+    quick_sort(sorted_times);
+    auto median = runs % 2 == 1
+        ? sorted_times[runs / 2]
+        : (sorted_times[runs / 2 - 1] + sorted_times[runs / 2]) / 2;
+
+    outln("{}: {} runs after {} warmup runs", source_name, runs, warmup_runs);
+    outln("    Time:                 mean {:.3} ms, median {:.3} ms, stddev {:.3} ms, min {:.3} ms, max {:.3} ms",
+        mean, median, standard_deviation, sorted_times.first(), sorted_times.last());
+    outln("    Garbage collection:   {:.1} collections per run, {:.3} ms paused per run",
+        total_garbage_collections / runs, total_garbage_collection_pause_time / runs);
+
+    auto property_lookups = total_bytecode_statistics.property_lookup_cache_hits
+        + total_bytecode_statistics.megamorphic_property_lookup_cache_hits
+        + total_bytecode_statistics.property_lookup_cache_misses;
+    auto rate_of = [&](u64 count) {
+        return property_lookups == 0 ? 0.0 : static_cast<double>(count) / static_cast<double>(property_lookups);
+    };
+
+    if constexpr (JS_BYTECODE_STATISTICS_DEBUG) {
+        outln("    Instructions:         {} per run", total_bytecode_statistics.executed_instructions / runs);
+        outln("    Property lookups:     {} per run, {:.1}% inline cache hits, {:.1}% megamorphic cache hits",
+            property_lookups / runs,
+            rate_of(total_bytecode_statistics.property_lookup_cache_hits) * 100,
+            rate_of(total_bytecode_statistics.megamorphic_property_lookup_cache_hits) * 100);
+    } else {
+        outln("    Instruction counts and inline cache hit rates require building with JS_BYTECODE_STATISTICS_DEBUG");
+    }
+
+    if (json_output_path.is_empty())
+        return 0;
+
+    JsonArray samples;
+    for (auto time : times)
+        TRY(samples.append(time));
+
+    JsonObject time;
+    time.set("mean_ms"sv, mean);
+    time.set("median_ms"sv, median);
+    time.set("stddev_ms"sv, standard_deviation);
+    time.set("min_ms"sv, sorted_times.first());
+    time.set("max_ms"sv, sorted_times.last());
+    time.set("samples_ms"sv, move(samples));
+
+    JsonObject garbage_collection;
+    garbage_collection.set("collections_per_run"sv, total_garbage_collections / runs);
+    garbage_collection.set("pause_time_ms_per_run"sv, total_garbage_collection_pause_time / runs);
+
+    JsonObject result;
+    result.set("source"sv, source_name);
+    result.set("runs"sv, runs);
+    result.set("warmup_runs"sv, warmup_runs);
+    result.set("time"sv, move(time));
+    result.set("garbage_collection"sv, move(garbage_collection));
+
+    if constexpr (JS_BYTECODE_STATISTICS_DEBUG) {
+        JsonObject bytecode;
+        bytecode.set("instructions_per_run"sv, total_bytecode_statistics.executed_instructions / runs);
+        bytecode.set("property_lookups_per_run"sv, property_lookups / runs);
+        bytecode.set("inline_cache_hit_rate"sv, rate_of(total_bytecode_statistics.property_lookup_cache_hits));
+        bytecode.set("megamorphic_cache_hit_rate"sv, rate_of(total_bytecode_statistics.megamorphic_property_lookup_cache_hits));
+        result.set("bytecode"sv, move(bytecode));
+    }
+
+    auto file = TRY(Core::File::open(json_output_path, Core::File::OpenMode::Write));
+    TRY(file->write_until_depleted(result.serialized()));
+    return 0;
+}
+
 ErrorOr<int> ladybird_main(Main::Arguments arguments)
 {
     bool gc_on_every_allocation = false;
@@ -817,6 +993,11 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     bool disable_debug_printing = false;
     bool use_test262_global = false;
     StringView evaluate_script;
+    StringView heap_snapshot_path;
+    bool benchmark = false;
+    size_t benchmark_runs = 10;
+    size_t benchmark_warmup_runs = 3;
+    StringView benchmark_json_output_path;
     Vector<StringView> script_paths;
 
     Core::ArgsParser args_parser;
@@ -833,6 +1014,11 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
     args_parser.add_option(use_test262_global, "Use test262 global ($262)", "use-test262-global", {});
+    args_parser.add_option(heap_snapshot_path, "Write a heap snapshot (.heapsnapshot) after running the script", "heap-snapshot", {}, "path");
+    args_parser.add_option(benchmark, "Run the script repeatedly, each time in a new realm, and report how long it took", "bench", {});
+    args_parser.add_option(benchmark_runs, "Number of measured benchmark runs (default: 10)", "bench-runs", {}, "count");
+    args_parser.add_option(benchmark_warmup_runs, "Number of benchmark runs before measuring (default: 3)", "bench-warmup-runs", {}, "count");
+    args_parser.add_option(benchmark_json_output_path, "Write the benchmark results as JSON to a file", "bench-json", {}, "path");
     args_parser.add_positional_argument(script_paths, "Path to script files", "scripts", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -874,16 +1060,6 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
         return run_repl(gc_on_every_allocation, syntax_highlight);
 #endif
     } else {
-        OwnPtr<JS::ExecutionContext> root_execution_context;
-        if (use_test262_global)
-            root_execution_context = JS::create_simple_execution_context<JS::Test262::GlobalObject>(*g_vm);
-        else
-            root_execution_context = JS::create_simple_execution_context<ScriptObject>(*g_vm);
-
-        auto& realm = *root_execution_context->realm;
-        auto& console_object = *realm.intrinsics().console_object();
-        ReplConsoleClient console_client(console_object.console());
-        console_object.console().set_client(console_client);
         g_vm->heap().set_should_collect_on_every_allocation(gc_on_every_allocation);
 
         StringBuilder builder;
@@ -915,10 +1091,30 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
             source_name = "eval"sv;
         }
 
+        if (benchmark)
+            return run_benchmark(builder.string_view(), source_name, use_test262_global, benchmark_warmup_runs, benchmark_runs, benchmark_json_output_path);
+
+        OwnPtr<JS::ExecutionContext> root_execution_context;
+        if (use_test262_global)
+            root_execution_context = JS::create_simple_execution_context<JS::Test262::GlobalObject>(*g_vm);
+        else
+            root_execution_context = JS::create_simple_execution_context<ScriptObject>(*g_vm);
+
+        auto& realm = *root_execution_context->realm;
+        auto& console_object = *realm.intrinsics().console_object();
+        ReplConsoleClient console_client(console_object.console());
+        console_object.console().set_client(console_client);
+
         // We resolve modules as if it is the first file
 
         if (!TRY(parse_and_run(realm, builder.string_view(), source_name)))
             return 1;
+
+        if (!heap_snapshot_path.is_empty()) {
+            auto heap_snapshot = g_vm->heap().dump_heap_snapshot();
+            auto file = TRY(Core::File::open(heap_snapshot_path, Core::File::OpenMode::Write));
+            TRY(file->write_until_depleted(heap_snapshot.serialized()));
+        }
     }
 
     return s_exit_code;
@@ -27,6 +27,7 @@
 #include <LibMain/Main.h>
 #include <LibWasm/AbstractMachine/AbstractMachine.h>
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/AbstractMachine/Profiler.h>
 #include <LibWasm/Printer/Printer.h>
 #include <LibWasm/Types.h>
 #if !defined(AK_OS_WINDOWS)
@@ -302,6 +303,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     bool print_compiled = false;
     bool attempt_instantiate = false;
     bool export_all_imports = false;
+    bool profile = false;
     [[maybe_unused]] bool wasi = false;
     Optional<u64> specific_function_address;
     ByteString exported_function_to_execute;
@@ -324,6 +326,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     parser.add_option(attempt_instantiate, "Attempt to instantiate the module", "instantiate", 'i');
     parser.add_option(exported_function_to_execute, "Attempt to execute the named exported function from the module (implies -i)", "execute", 'e', "name");
     parser.add_option(export_all_imports, "Export noop functions corresponding to imports", "export-noop");
+    parser.add_option(profile, "Profile the executed function, and print per-function and per-instruction statistics to stderr", "profile");
 #if !defined(AK_OS_WINDOWS)
     parser.add_option(wasi, "Enable WASI", "wasi", 'w');
 #endif
@@ -856,7 +859,27 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
                 outln();
             }
 
+            Wasm::Profiler profiler;
+            if (profile) {
+                profiler.name_for_function = [&](Wasm::FunctionAddress address) -> ByteString {
+                    for (auto& entry : module_instance->exports()) {
+                        if (auto export_address = entry.value().get_pointer<Wasm::FunctionAddress>(); export_address && *export_address == address)
+                            return entry.name();
+                    }
+                    if (auto* function = machine.store().get(address); function && function->has<Wasm::HostFunction>())
+                        return function->get<Wasm::HostFunction>().name();
+                    return {};
+                };
+                machine.set_profiler(&profiler);
+            }
+
             auto result = machine.invoke(g_interpreter, run_address.value(), move(values));
+
+            if (profile) {
+                machine.set_profiler(nullptr);
+                auto standard_error = TRY(Core::File::standard_error());
+                TRY(profiler.write_report(*standard_error));
+            }
             if (result.is_trap()) {
                 auto trap_reason = result.trap().format();
                 if (trap_reason.starts_with("exit:"sv))